@@ -93,51 +93,77 @@ void SystemInterface_GLFW::GetClipboardText(Rml::String& text)
 	}
 }
 
-bool RmlGLFW::ProcessKeyCallback(Rml::Context* context, int key, int action, int mods)
+// Applies the input added by the given function on the context right away. The batch is reused for every event, so that its memory is only
+// allocated once.
+template <typename Func>
+static bool ProcessInputImmediately(Rml::Context* context, Func&& add_input)
 {
 	if (!context)
 		return true;
 
-	bool result = true;
+	static Rml::InputBatch batch;
+	batch.Clear();
+	add_input(batch);
+	return context->ProcessInputBatch(batch);
+}
+
+bool RmlGLFW::ProcessKeyCallback(Rml::Context* context, int key, int action, int mods)
+{
+	return ProcessInputImmediately(context, [&](Rml::InputBatch& batch) { ProcessKeyCallback(batch, key, action, mods); });
+}
+
+bool RmlGLFW::ProcessCharCallback(Rml::Context* context, unsigned int codepoint)
+{
+	return ProcessInputImmediately(context, [&](Rml::InputBatch& batch) { ProcessCharCallback(batch, codepoint); });
+}
+
+bool RmlGLFW::ProcessCursorEnterCallback(Rml::Context* context, int entered)
+{
+	return ProcessInputImmediately(context, [&](Rml::InputBatch& batch) { ProcessCursorEnterCallback(batch, entered); });
+}
+
+bool RmlGLFW::ProcessCursorPosCallback(Rml::Context* context, GLFWwindow* window, double xpos, double ypos, int mods)
+{
+	return ProcessInputImmediately(context, [&](Rml::InputBatch& batch) { ProcessCursorPosCallback(batch, window, xpos, ypos, mods); });
+}
+
+bool RmlGLFW::ProcessMouseButtonCallback(Rml::Context* context, int button, int action, int mods)
+{
+	return ProcessInputImmediately(context, [&](Rml::InputBatch& batch) { ProcessMouseButtonCallback(batch, button, action, mods); });
+}
+
+bool RmlGLFW::ProcessScrollCallback(Rml::Context* context, double yoffset, int mods)
+{
+	return ProcessInputImmediately(context, [&](Rml::InputBatch& batch) { ProcessScrollCallback(batch, yoffset, mods); });
+}
 
+void RmlGLFW::ProcessKeyCallback(Rml::InputBatch& batch, int key, int action, int mods)
+{
 	switch (action)
 	{
 	case GLFW_PRESS:
 	case GLFW_REPEAT:
-		result = context->ProcessKeyDown(RmlGLFW::ConvertKey(key), RmlGLFW::ConvertKeyModifiers(mods));
+		batch.KeyDown(RmlGLFW::ConvertKey(key), RmlGLFW::ConvertKeyModifiers(mods));
 		if (key == GLFW_KEY_ENTER || key == GLFW_KEY_KP_ENTER)
-			result &= context->ProcessTextInput('\n');
+			batch.TextInput("\n");
 		break;
-	case GLFW_RELEASE: result = context->ProcessKeyUp(RmlGLFW::ConvertKey(key), RmlGLFW::ConvertKeyModifiers(mods)); break;
+	case GLFW_RELEASE: batch.KeyUp(RmlGLFW::ConvertKey(key), RmlGLFW::ConvertKeyModifiers(mods)); break;
 	}
-
-	return result;
 }
-bool RmlGLFW::ProcessCharCallback(Rml::Context* context, unsigned int codepoint)
-{
-	if (!context)
-		return true;
 
-	bool result = context->ProcessTextInput((Rml::Character)codepoint);
-	return result;
+void RmlGLFW::ProcessCharCallback(Rml::InputBatch& batch, unsigned int codepoint)
+{
+	batch.TextInput((Rml::Character)codepoint);
 }
 
-bool RmlGLFW::ProcessCursorEnterCallback(Rml::Context* context, int entered)
+void RmlGLFW::ProcessCursorEnterCallback(Rml::InputBatch& batch, int entered)
 {
-	if (!context)
-		return true;
-
-	bool result = true;
 	if (!entered)
-		result = context->ProcessMouseLeave();
-	return result;
+		batch.MouseLeave();
 }
 
-bool RmlGLFW::ProcessCursorPosCallback(Rml::Context* context, GLFWwindow* window, double xpos, double ypos, int mods)
+void RmlGLFW::ProcessCursorPosCallback(Rml::InputBatch& batch, GLFWwindow* window, double xpos, double ypos, int mods)
 {
-	if (!context)
-		return true;
-
 	using Rml::Vector2i;
 	using Vector2d = Rml::Vector2<double>;
 
@@ -149,32 +175,21 @@ bool RmlGLFW::ProcessCursorPosCallback(Rml::Context* context, GLFWwindow* window
 	const Vector2d mouse_pos = Vector2d(xpos, ypos) * (Vector2d(framebuffer_size) / Vector2d(window_size));
 	const Vector2i mouse_pos_round = {int(Rml::Math::Round(mouse_pos.x)), int(Rml::Math::Round(mouse_pos.y))};
 
-	bool result = context->ProcessMouseMove(mouse_pos_round.x, mouse_pos_round.y, RmlGLFW::ConvertKeyModifiers(mods));
-	return result;
+	batch.MouseMove(mouse_pos_round.x, mouse_pos_round.y, RmlGLFW::ConvertKeyModifiers(mods));
 }
 
-bool RmlGLFW::ProcessMouseButtonCallback(Rml::Context* context, int button, int action, int mods)
+void RmlGLFW::ProcessMouseButtonCallback(Rml::InputBatch& batch, int button, int action, int mods)
 {
-	if (!context)
-		return true;
-
-	bool result = true;
-
 	switch (action)
 	{
-	case GLFW_PRESS: result = context->ProcessMouseButtonDown(button, RmlGLFW::ConvertKeyModifiers(mods)); break;
-	case GLFW_RELEASE: result = context->ProcessMouseButtonUp(button, RmlGLFW::ConvertKeyModifiers(mods)); break;
+	case GLFW_PRESS: batch.MouseButtonDown(button, RmlGLFW::ConvertKeyModifiers(mods)); break;
+	case GLFW_RELEASE: batch.MouseButtonUp(button, RmlGLFW::ConvertKeyModifiers(mods)); break;
 	}
-	return result;
 }
 
-bool RmlGLFW::ProcessScrollCallback(Rml::Context* context, double yoffset, int mods)
+void RmlGLFW::ProcessScrollCallback(Rml::InputBatch& batch, double yoffset, int mods)
 {
-	if (!context)
-		return true;
-
-	bool result = context->ProcessMouseWheel(-float(yoffset), RmlGLFW::ConvertKeyModifiers(mods));
-	return result;
+	batch.MouseWheel(Rml::Vector2f(0.f, -float(yoffset)), RmlGLFW::ConvertKeyModifiers(mods));
 }
 
 void RmlGLFW::ProcessFramebufferSizeCallback(Rml::Context* context, int width, int height)
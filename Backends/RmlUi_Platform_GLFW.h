@@ -1,6 +1,7 @@
 #pragma once
 
 #include <RmlUi/Core/Input.h>
+#include <RmlUi/Core/InputBatch.h>
 #include <RmlUi/Core/SystemInterface.h>
 #include <RmlUi/Core/Types.h>
 #include <GLFW/glfw3.h>
@@ -50,6 +51,15 @@ bool ProcessScrollCallback(Rml::Context* context, double yoffset, int mods);
 void ProcessFramebufferSizeCallback(Rml::Context* context, int width, int height);
 void ProcessContentScaleCallback(Rml::Context* context, float xscale);
 
+// Alternatively, these input callbacks add the input to a batch instead, which can then be applied on the context all at once using
+// Context::ProcessInputBatch(), such as once per frame.
+void ProcessKeyCallback(Rml::InputBatch& batch, int key, int action, int mods);
+void ProcessCharCallback(Rml::InputBatch& batch, unsigned int codepoint);
+void ProcessCursorEnterCallback(Rml::InputBatch& batch, int entered);
+void ProcessCursorPosCallback(Rml::InputBatch& batch, GLFWwindow* window, double xpos, double ypos, int mods);
+void ProcessMouseButtonCallback(Rml::InputBatch& batch, int button, int action, int mods);
+void ProcessScrollCallback(Rml::InputBatch& batch, double yoffset, int mods);
+
 // Converts the GLFW key to RmlUi key.
 Rml::Input::KeyIdentifier ConvertKey(int glfw_key);
 
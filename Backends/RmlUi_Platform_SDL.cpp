@@ -4,10 +4,10 @@
 #include <RmlUi/Core/StringUtilities.h>
 #include <RmlUi/Core/SystemInterface.h>
 
-static Rml::TouchList TouchEventToTouchList(SDL_Event& ev, Rml::Context* context, SDL_FingerID finger_id)
+static Rml::Touch TouchEventToTouch(SDL_Event& ev, Rml::Context* context, SDL_FingerID finger_id)
 {
 	const Rml::Vector2f position = Rml::Vector2f{ev.tfinger.x, ev.tfinger.y} * Rml::Vector2f{context->GetDimensions()};
-	return {Rml::Touch{static_cast<Rml::TouchId>(finger_id), position}};
+	return Rml::Touch{static_cast<Rml::TouchId>(finger_id), position};
 }
 
 SystemInterface_SDL::SystemInterface_SDL()
@@ -126,6 +126,15 @@ void SystemInterface_SDL::DeactivateKeyboard()
 }
 
 bool RmlSDL::InputEventHandler(Rml::Context* context, SDL_Window* window, SDL_Event& ev)
+{
+	// The batch is reused for every event, so that its memory is only allocated once.
+	static Rml::InputBatch batch;
+	batch.Clear();
+	InputEventHandler(batch, context, window, ev);
+	return context->ProcessInputBatch(batch);
+}
+
+void RmlSDL::InputEventHandler(Rml::InputBatch& batch, Rml::Context* context, SDL_Window* window, SDL_Event& ev)
 {
 #if SDL_MAJOR_VERSION >= 3
 	#define RMLSDL_WINDOW_EVENTS_BEGIN
@@ -179,69 +188,64 @@ bool RmlSDL::InputEventHandler(Rml::Context* context, SDL_Window* window, SDL_Ev
 	constexpr auto rmlsdl_false = SDL_FALSE;
 #endif
 
-	bool result = true;
-
 	switch (ev.type)
 	{
 #ifndef RMLUI_BACKEND_SIMULATE_TOUCH
 	case event_mouse_motion:
 	{
 		const float pixel_density = GetPixelDensity(window);
-		result = context->ProcessMouseMove(int(ev.motion.x * pixel_density), int(ev.motion.y * pixel_density), GetKeyModifierState());
+		batch.MouseMove(int(ev.motion.x * pixel_density), int(ev.motion.y * pixel_density), GetKeyModifierState());
 	}
 	break;
 	case event_mouse_down:
 	{
-		result = context->ProcessMouseButtonDown(ConvertMouseButton(ev.button.button), GetKeyModifierState());
+		batch.MouseButtonDown(ConvertMouseButton(ev.button.button), GetKeyModifierState());
 		SDL_CaptureMouse(rmlsdl_true);
 	}
 	break;
 	case event_mouse_up:
 	{
 		SDL_CaptureMouse(rmlsdl_false);
-		result = context->ProcessMouseButtonUp(ConvertMouseButton(ev.button.button), GetKeyModifierState());
+		batch.MouseButtonUp(ConvertMouseButton(ev.button.button), GetKeyModifierState());
 	}
 	break;
 #endif
 
 	case event_mouse_wheel:
 	{
-		result = context->ProcessMouseWheel(float(-ev.wheel.y), GetKeyModifierState());
+		batch.MouseWheel(Rml::Vector2f(0.f, float(-ev.wheel.y)), GetKeyModifierState());
 	}
 	break;
 	case event_key_down:
 	{
-		result = context->ProcessKeyDown(ConvertKey(GetKey(ev)), GetKeyModifierState());
+		batch.KeyDown(ConvertKey(GetKey(ev)), GetKeyModifierState());
 		if (GetKey(ev) == SDLK_RETURN || GetKey(ev) == SDLK_KP_ENTER)
-			result &= context->ProcessTextInput('\n');
+			batch.TextInput("\n");
 	}
 	break;
 	case event_key_up:
 	{
-		result = context->ProcessKeyUp(ConvertKey(GetKey(ev)), GetKeyModifierState());
+		batch.KeyUp(ConvertKey(GetKey(ev)), GetKeyModifierState());
 	}
 	break;
 	case event_text_input:
 	{
-		result = context->ProcessTextInput(Rml::String(&ev.text.text[0]));
+		batch.TextInput(&ev.text.text[0]);
 	}
 	break;
 	case event_finger_down:
 	{
-		const Rml::TouchList touches = TouchEventToTouchList(ev, context, GetFingerId(ev));
-		result = context->ProcessTouchStart(touches, GetKeyModifierState());
+		batch.TouchStart(TouchEventToTouch(ev, context, GetFingerId(ev)), GetKeyModifierState());
 	}
 	break;
 	case event_finger_motion:
 	{
-		const Rml::TouchList touches = TouchEventToTouchList(ev, context, GetFingerId(ev));
-		result = context->ProcessTouchMove(touches, GetKeyModifierState());
+		batch.TouchMove(TouchEventToTouch(ev, context, GetFingerId(ev)), GetKeyModifierState());
 	}
 	break;
 	case event_finger_up:
 	{
-		const Rml::TouchList touches = TouchEventToTouchList(ev, context, GetFingerId(ev));
-		result = context->ProcessTouchEnd(touches, GetKeyModifierState());
+		batch.TouchEnd(TouchEventToTouch(ev, context, GetFingerId(ev)), GetKeyModifierState());
 	}
 	break;
 
@@ -255,7 +259,7 @@ bool RmlSDL::InputEventHandler(Rml::Context* context, SDL_Window* window, SDL_Ev
 	break;
 	case event_window_leave:
 	{
-		context->ProcessMouseLeave();
+		batch.MouseLeave();
 	}
 	break;
 
@@ -272,8 +276,6 @@ bool RmlSDL::InputEventHandler(Rml::Context* context, SDL_Window* window, SDL_Ev
 
 	default: break;
 	}
-
-	return result;
 }
 
 Rml::Input::KeyIdentifier RmlSDL::ConvertKey(int sdlkey)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <RmlUi/Core/Input.h>
+#include <RmlUi/Core/InputBatch.h>
 #include <RmlUi/Core/SystemInterface.h>
 #include <RmlUi/Core/Types.h>
 
@@ -50,6 +51,10 @@ namespace RmlSDL {
 // @return True if the event is still propagating, false if it was handled by the context.
 bool InputEventHandler(Rml::Context* context, SDL_Window* window, SDL_Event& ev);
 
+// Adds the input of the given SDL event to the batch, to be applied on the context later on using Context::ProcessInputBatch(), such as once
+// per frame. Window events, such as resizing, are applied on the context right away.
+void InputEventHandler(Rml::InputBatch& batch, Rml::Context* context, SDL_Window* window, SDL_Event& ev);
+
 // Converts the SDL key to RmlUi key.
 Rml::Input::KeyIdentifier ConvertKey(int sdl_key);
 
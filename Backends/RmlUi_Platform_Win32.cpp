@@ -208,6 +208,17 @@ bool RmlWin32::WindowProcedure(Rml::Context* context, TextInputMethodEditor_Win3
 	if (!context)
 		return true;
 
+	// The batch is reused for every message, so that its memory is only allocated once.
+	static Rml::InputBatch batch;
+	batch.Clear();
+	bool result = WindowProcedure(batch, text_input_method_editor, window_handle, message, w_param, l_param);
+	result &= context->ProcessInputBatch(batch);
+	return result;
+}
+
+bool RmlWin32::WindowProcedure(Rml::InputBatch& batch, TextInputMethodEditor_Win32& text_input_method_editor, HWND window_handle,
+	UINT message, WPARAM w_param, LPARAM l_param)
+{
 	static bool tracking_mouse_leave = false;
 
 	// If the user tries to interact with the window by using the mouse in any way, end the
@@ -221,20 +232,19 @@ bool RmlWin32::WindowProcedure(Rml::Context* context, TextInputMethodEditor_Win3
 	switch (message)
 	{
 	case WM_LBUTTONDOWN:
-		result = context->ProcessMouseButtonDown(0, RmlWin32::GetKeyModifierState());
+		batch.MouseButtonDown(0, RmlWin32::GetKeyModifierState());
 		SetCapture(window_handle);
 		break;
 	case WM_LBUTTONUP:
 		ReleaseCapture();
-		result = context->ProcessMouseButtonUp(0, RmlWin32::GetKeyModifierState());
+		batch.MouseButtonUp(0, RmlWin32::GetKeyModifierState());
 		break;
-	case WM_RBUTTONDOWN: result = context->ProcessMouseButtonDown(1, RmlWin32::GetKeyModifierState()); break;
-	case WM_RBUTTONUP: result = context->ProcessMouseButtonUp(1, RmlWin32::GetKeyModifierState()); break;
-	case WM_MBUTTONDOWN: result = context->ProcessMouseButtonDown(2, RmlWin32::GetKeyModifierState()); break;
-	case WM_MBUTTONUP: result = context->ProcessMouseButtonUp(2, RmlWin32::GetKeyModifierState()); break;
+	case WM_RBUTTONDOWN: batch.MouseButtonDown(1, RmlWin32::GetKeyModifierState()); break;
+	case WM_RBUTTONUP: batch.MouseButtonUp(1, RmlWin32::GetKeyModifierState()); break;
+	case WM_MBUTTONDOWN: batch.MouseButtonDown(2, RmlWin32::GetKeyModifierState()); break;
+	case WM_MBUTTONUP: batch.MouseButtonUp(2, RmlWin32::GetKeyModifierState()); break;
 	case WM_MOUSEMOVE:
-		result = context->ProcessMouseMove(static_cast<int>((short)LOWORD(l_param)), static_cast<int>((short)HIWORD(l_param)),
-			RmlWin32::GetKeyModifierState());
+		batch.MouseMove(static_cast<int>((short)LOWORD(l_param)), static_cast<int>((short)HIWORD(l_param)), RmlWin32::GetKeyModifierState());
 
 		if (!tracking_mouse_leave)
 		{
@@ -246,15 +256,15 @@ bool RmlWin32::WindowProcedure(Rml::Context* context, TextInputMethodEditor_Win3
 		}
 		break;
 	case WM_MOUSEWHEEL:
-		result = context->ProcessMouseWheel(static_cast<float>((short)HIWORD(w_param)) / static_cast<float>(-WHEEL_DELTA),
+		batch.MouseWheel(Rml::Vector2f(0.f, static_cast<float>((short)HIWORD(w_param)) / static_cast<float>(-WHEEL_DELTA)),
 			RmlWin32::GetKeyModifierState());
 		break;
 	case WM_MOUSELEAVE:
-		result = context->ProcessMouseLeave();
+		batch.MouseLeave();
 		tracking_mouse_leave = false;
 		break;
-	case WM_KEYDOWN: result = context->ProcessKeyDown(RmlWin32::ConvertKey((int)w_param), RmlWin32::GetKeyModifierState()); break;
-	case WM_KEYUP: result = context->ProcessKeyUp(RmlWin32::ConvertKey((int)w_param), RmlWin32::GetKeyModifierState()); break;
+	case WM_KEYDOWN: batch.KeyDown(RmlWin32::ConvertKey((int)w_param), RmlWin32::GetKeyModifierState()); break;
+	case WM_KEYUP: batch.KeyUp(RmlWin32::ConvertKey((int)w_param), RmlWin32::GetKeyModifierState()); break;
 	case WM_CHAR:
 	{
 		static wchar_t first_u16_code_unit = 0;
@@ -286,7 +296,7 @@ bool RmlWin32::WindowProcedure(Rml::Context* context, TextInputMethodEditor_Win3
 
 			// Only send through printable characters.
 			if (((char32_t)character >= 32 || character == (Rml::Character)'\n') && character != (Rml::Character)127)
-				result = context->ProcessTextInput(character);
+				batch.TextInput(character);
 		}
 	}
 	break;
@@ -2,6 +2,7 @@
 
 #include "RmlUi_Include_Windows.h"
 #include <RmlUi/Core/Input.h>
+#include <RmlUi/Core/InputBatch.h>
 #include <RmlUi/Core/StringUtilities.h>
 #include <RmlUi/Core/SystemInterface.h>
 #include <RmlUi/Core/TextInputHandler.h>
@@ -58,6 +59,12 @@ std::wstring ConvertToUTF16(const Rml::String& str);
 bool WindowProcedure(Rml::Context* context, TextInputMethodEditor_Win32& text_input_method_editor, HWND window_handle, UINT message, WPARAM w_param,
 	LPARAM l_param);
 
+// Window event handler which adds the input to a batch, to be applied on the context later on using Context::ProcessInputBatch(), such as once
+// per frame. Messages of the input method editor are still handled right away.
+// @return False if the message was captured by the input method editor, otherwise true.
+bool WindowProcedure(Rml::InputBatch& batch, TextInputMethodEditor_Win32& text_input_method_editor, HWND window_handle, UINT message,
+	WPARAM w_param, LPARAM l_param);
+
 // Converts the key from Win32 key code to RmlUi key.
 Rml::Input::KeyIdentifier ConvertKey(int win32_key_code);
 
@@ -201,6 +201,15 @@ struct TGAHeader {
 #pragma pack()
 
 Rml::TextureHandle RenderInterface_GL2::LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source)
+{
+	Rml::Vector<Rml::byte> data;
+	if (!LoadTextureData(data, texture_dimensions, source))
+		return {};
+
+	return GenerateTexture(data, texture_dimensions);
+}
+
+bool RenderInterface_GL2::LoadTextureData(Rml::Vector<Rml::byte>& out_data, Rml::Vector2i& out_dimensions, const Rml::String& source)
 {
 	Rml::FileInterface* file_interface = Rml::GetFileInterface();
 	Rml::FileHandle file_handle = file_interface->Open(source);
@@ -244,9 +253,15 @@ Rml::TextureHandle RenderInterface_GL2::LoadTexture(Rml::Vector2i& texture_dimen
 		return false;
 	}
 
+	if (buffer_size < sizeof(TGAHeader) + size_t(header.width * header.height * color_mode))
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Texture file size is smaller than its image data, file is not a valid TGA image.");
+		return false;
+	}
+
 	const byte* image_src = buffer.get() + sizeof(TGAHeader);
-	Rml::UniquePtr<byte[]> image_dest_buffer(new byte[image_size]);
-	byte* image_dest = image_dest_buffer.get();
+	out_data.resize(image_size);
+	byte* image_dest = out_data.data();
 	const bool top_to_bottom_order = ((header.imageDescriptor & 32) != 0);
 
 	// Targa is BGR, swap to RGB, flip Y axis as necessary, and convert to premultiplied alpha.
@@ -274,10 +289,10 @@ Rml::TextureHandle RenderInterface_GL2::LoadTexture(Rml::Vector2i& texture_dimen
 		}
 	}
 
-	texture_dimensions.x = header.width;
-	texture_dimensions.y = header.height;
+	out_dimensions.x = header.width;
+	out_dimensions.y = header.height;
 
-	return GenerateTexture({image_dest, image_size}, texture_dimensions);
+	return true;
 }
 
 Rml::TextureHandle RenderInterface_GL2::GenerateTexture(Rml::Span<const Rml::byte> source, Rml::Vector2i source_dimensions)
@@ -304,6 +319,15 @@ Rml::TextureHandle RenderInterface_GL2::GenerateTexture(Rml::Span<const Rml::byt
 	return (Rml::TextureHandle)texture_id;
 }
 
+bool RenderInterface_GL2::UpdateTexture(Rml::TextureHandle texture_handle, Rml::Rectanglei region, Rml::Span<const Rml::byte> source)
+{
+	RMLUI_ASSERT(source.data() && source.size() == size_t(region.Width() * region.Height() * 4));
+
+	glBindTexture(GL_TEXTURE_2D, (GLuint)texture_handle);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, region.Left(), region.Top(), region.Width(), region.Height(), GL_RGBA, GL_UNSIGNED_BYTE, source.data());
+	return true;
+}
+
 void RenderInterface_GL2::ReleaseTexture(Rml::TextureHandle texture_handle)
 {
 	glDeleteTextures(1, (GLuint*)&texture_handle);
@@ -23,7 +23,9 @@ public:
 	void RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture) override;
 
 	Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	bool LoadTextureData(Rml::Vector<Rml::byte>& out_data, Rml::Vector2i& out_dimensions, const Rml::String& source) override;
 	Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source, Rml::Vector2i source_dimensions) override;
+	bool UpdateTexture(Rml::TextureHandle texture_handle, Rml::Rectanglei region, Rml::Span<const Rml::byte> source) override;
 	void ReleaseTexture(Rml::TextureHandle texture_handle) override;
 
 	void EnableScissorRegion(bool enable) override;
@@ -8,6 +8,8 @@
 #include <RmlUi/Core/Platform.h>
 #include <RmlUi/Core/SystemInterface.h>
 #include <algorithm>
+#include <chrono>
+#include <future>
 #include <string.h>
 
 #if defined RMLUI_PLATFORM_WIN32_NATIVE
@@ -40,6 +42,7 @@
 #define MAX_NUM_STOPS 16
 #define BLUR_SIZE 7
 #define BLUR_NUM_WEIGHTS ((BLUR_SIZE + 1) / 2)
+#define MAX_NUM_TRANSFORMS 32
 
 #define RMLUI_STRINGIFY_IMPL(x) #x
 #define RMLUI_STRINGIFY(x) RMLUI_STRINGIFY_IMPL(x)
@@ -54,6 +57,7 @@ uniform mat4 _transform;
 in vec2 inPosition;
 in vec4 inColor0;
 in vec2 inTexCoord0;
+in vec2 inInstanceTranslation;
 
 out vec2 fragTexCoord;
 out vec4 fragColor;
@@ -62,12 +66,31 @@ void main() {
 	fragTexCoord = inTexCoord0;
 	fragColor = inColor0;
 
-	vec2 translatedPos = inPosition + _translate;
+	vec2 translatedPos = inPosition + _translate + inInstanceTranslation;
 	vec4 outPos = _transform * vec4(translatedPos, 0.0, 1.0);
 
     gl_Position = outPos;
 }
 )";
+static const char* shader_vert_transformed =
+	RMLUI_SHADER_HEADER "\n#define MAX_NUM_TRANSFORMS " RMLUI_STRINGIFY(MAX_NUM_TRANSFORMS) R"(
+uniform mat4 _transforms[MAX_NUM_TRANSFORMS];
+
+in vec2 inPosition;
+in vec4 inColor0;
+in vec2 inTexCoord0;
+in float inTransformIndex;
+
+out vec2 fragTexCoord;
+out vec4 fragColor;
+
+void main() {
+	fragTexCoord = inTexCoord0;
+	fragColor = inColor0;
+
+	gl_Position = _transforms[int(inTransformIndex)] * vec4(inPosition, 0.0, 1.0);
+}
+)";
 static const char* shader_frag_texture = RMLUI_SHADER_HEADER R"(
 uniform sampler2D _tex;
 in vec2 fragTexCoord;
@@ -154,6 +177,92 @@ void main() {
 }
 )";
 
+static const char* shader_frag_rounded_box = RMLUI_SHADER_HEADER R"(
+uniform vec2 _dimensions;
+uniform vec4 _radius;          // top-left, top-right, bottom-right, bottom-left
+uniform vec4 _border_widths;   // top, right, bottom, left
+uniform vec4 _color;           // background color
+uniform vec4 _border_colors[4]; // top, right, bottom, left
+
+in vec2 fragTexCoord;
+in vec4 fragColor;
+out vec4 finalColor;
+
+// Signed distance from the point 'p' to the rounded box at 'position' with size 'size', negative inside the box.
+float rounded_box_distance(vec2 p, vec2 position, vec2 size, vec4 radius) {
+	vec2 half_size = 0.5 * size;
+	vec2 q = p - position - half_size;
+	vec2 r_top_bottom = (q.x < 0.0 ? vec2(radius.x, radius.w) : vec2(radius.y, radius.z));
+	float r = (q.y < 0.0 ? r_top_bottom.x : r_top_bottom.y);
+	vec2 d = abs(q) - half_size + r;
+	return min(max(d.x, d.y), 0.0) + length(max(d, 0.0)) - r;
+}
+
+void main() {
+	vec2 p = fragTexCoord;
+	vec4 w = _border_widths;
+
+	float outer_coverage = clamp(0.5 - rounded_box_distance(p, vec2(0.0), _dimensions, _radius), 0.0, 1.0);
+
+	vec2 inner_size = _dimensions - vec2(w.y + w.w, w.x + w.z);
+	vec4 inner_radius = max(_radius - vec4(max(w.w, w.x), max(w.x, w.y), max(w.z, w.y), max(w.z, w.w)), vec4(0.0));
+	float inner_coverage = 0.0;
+	if (inner_size.x > 0.0 && inner_size.y > 0.0)
+		inner_coverage = clamp(0.5 - rounded_box_distance(p, vec2(w.w, w.x), inner_size, inner_radius), 0.0, 1.0);
+	inner_coverage = min(inner_coverage, outer_coverage);
+
+	// Pick the border side closest to the point relative to its width, this places the color transitions along the corner diagonals.
+	vec4 edge_distance = vec4(p.y, _dimensions.x - p.x, _dimensions.y - p.y, p.x) / max(w, vec4(0.0001));
+	int side = 0;
+	for (int i = 1; i < 4; i++)
+		if (edge_distance[i] < edge_distance[side])
+			side = i;
+
+	finalColor = fragColor * (_color * inner_coverage + _border_colors[side] * (outer_coverage - inner_coverage));
+}
+)";
+
+// Renders the area inside the rounded box to the clip mask, using the same shape as the background of the rounded box shader.
+static const char* shader_frag_rounded_box_clip = RMLUI_SHADER_HEADER R"(
+uniform vec2 _dimensions;
+uniform vec4 _radius; // top-left, top-right, bottom-right, bottom-left
+
+in vec2 fragTexCoord;
+in vec4 fragColor;
+out vec4 finalColor;
+
+float rounded_box_distance(vec2 p, vec2 position, vec2 size, vec4 radius) {
+	vec2 half_size = 0.5 * size;
+	vec2 q = p - position - half_size;
+	vec2 r_top_bottom = (q.x < 0.0 ? vec2(radius.x, radius.w) : vec2(radius.y, radius.z));
+	float r = (q.y < 0.0 ? r_top_bottom.x : r_top_bottom.y);
+	vec2 d = abs(q) - half_size + r;
+	return min(max(d.x, d.y), 0.0) + length(max(d, 0.0)) - r;
+}
+
+void main() {
+	if (rounded_box_distance(fragTexCoord, vec2(0.0), _dimensions, _radius) > 0.0)
+		discard;
+	finalColor = fragColor;
+}
+)";
+
+// Samples a signed distance field where an alpha of 0.5 is the glyph edge, grown by the outline width and softened by the blur width.
+static const char* shader_frag_distance_field_text = RMLUI_SHADER_HEADER R"(
+uniform sampler2D _tex;
+uniform vec3 _distance_field; // spread, outline width, blur width
+
+in vec2 fragTexCoord;
+in vec4 fragColor;
+out vec4 finalColor;
+
+void main() {
+	float d = (texture(_tex, fragTexCoord).a * (255.0 / 128.0) - 1.0) * _distance_field.x + _distance_field.y;
+	float w = 0.5 * fwidth(d) + _distance_field.z;
+	finalColor = fragColor * smoothstep(-w, w, d);
+}
+)";
+
 // "Creation" by Danilo Guanabara, based on: https://www.shadertoy.com/view/XsXXDn
 static const char* shader_frag_creation = RMLUI_SHADER_HEADER R"(
 uniform float _value;
@@ -290,16 +399,22 @@ enum class ProgramId {
 	Color,
 	Texture,
 	Gradient,
+	RoundedBox,
+	RoundedBoxClip,
+	DistanceFieldText,
 	Creation,
 	Passthrough,
 	ColorMatrix,
 	BlendMask,
 	Blur,
 	DropShadow,
+	ColorTransformed,
+	TextureTransformed,
 	Count,
 };
 enum class VertShaderId {
 	Main,
+	Transformed,
 	Passthrough,
 	Blur,
 	Count,
@@ -308,6 +423,9 @@ enum class FragShaderId {
 	Color,
 	Texture,
 	Gradient,
+	RoundedBox,
+	RoundedBoxClip,
+	DistanceFieldText,
 	Creation,
 	Passthrough,
 	ColorMatrix,
@@ -335,6 +453,11 @@ enum class UniformId {
 	NumStops,
 	Value,
 	Dimensions,
+	Radius,
+	BorderWidths,
+	BorderColors,
+	DistanceField,
+	Transforms,
 	Count,
 };
 
@@ -342,10 +465,13 @@ namespace Gfx {
 
 static const char* const program_uniform_names[(size_t)UniformId::Count] = {"_translate", "_transform", "_tex", "_color", "_color_matrix",
 	"_texelOffset", "_texCoordMin", "_texCoordMax", "_texMask", "_weights[0]", "_func", "_p", "_v", "_stop_colors[0]", "_stop_positions[0]",
-	"_num_stops", "_value", "_dimensions"};
+	"_num_stops", "_value", "_dimensions", "_radius", "_border_widths", "_border_colors[0]", "_distance_field", "_transforms[0]"};
 
-enum class VertexAttribute { Position, Color0, TexCoord0, Count };
-static const char* const vertex_attribute_names[(size_t)VertexAttribute::Count] = {"inPosition", "inColor0", "inTexCoord0"};
+// The instance translation is only enabled as an array for instanced draws, other draws use its constant value of zero. The transform
+// index is only enabled as an array for geometry compiled with transform indices.
+enum class VertexAttribute { Position, Color0, TexCoord0, InstanceTranslation, TransformIndex, Count };
+static const char* const vertex_attribute_names[(size_t)VertexAttribute::Count] = {"inPosition", "inColor0", "inTexCoord0",
+	"inInstanceTranslation", "inTransformIndex"};
 
 struct VertShaderDefinition {
 	VertShaderId id;
@@ -367,30 +493,39 @@ struct ProgramDefinition {
 // clang-format off
 static const VertShaderDefinition vert_shader_definitions[] = {
 	{VertShaderId::Main,        "main",         shader_vert_main},
+	{VertShaderId::Transformed, "transformed",  shader_vert_transformed},
 	{VertShaderId::Passthrough, "passthrough",  shader_vert_passthrough},
 	{VertShaderId::Blur,        "blur",         shader_vert_blur},
 };
 static const FragShaderDefinition frag_shader_definitions[] = {
-	{FragShaderId::Color,       "color",        shader_frag_color},
-	{FragShaderId::Texture,     "texture",      shader_frag_texture},
-	{FragShaderId::Gradient,    "gradient",     shader_frag_gradient},
-	{FragShaderId::Creation,    "creation",     shader_frag_creation},
-	{FragShaderId::Passthrough, "passthrough",  shader_frag_passthrough},
-	{FragShaderId::ColorMatrix, "color_matrix", shader_frag_color_matrix},
-	{FragShaderId::BlendMask,   "blend_mask",   shader_frag_blend_mask},
-	{FragShaderId::Blur,        "blur",         shader_frag_blur},
-	{FragShaderId::DropShadow,  "drop_shadow",  shader_frag_drop_shadow},
+	{FragShaderId::Color,             "color",               shader_frag_color},
+	{FragShaderId::Texture,           "texture",             shader_frag_texture},
+	{FragShaderId::Gradient,          "gradient",            shader_frag_gradient},
+	{FragShaderId::RoundedBox,        "rounded_box",         shader_frag_rounded_box},
+	{FragShaderId::RoundedBoxClip,    "rounded_box_clip",    shader_frag_rounded_box_clip},
+	{FragShaderId::DistanceFieldText, "distance_field_text", shader_frag_distance_field_text},
+	{FragShaderId::Creation,          "creation",            shader_frag_creation},
+	{FragShaderId::Passthrough,       "passthrough",         shader_frag_passthrough},
+	{FragShaderId::ColorMatrix,       "color_matrix",        shader_frag_color_matrix},
+	{FragShaderId::BlendMask,         "blend_mask",          shader_frag_blend_mask},
+	{FragShaderId::Blur,              "blur",                shader_frag_blur},
+	{FragShaderId::DropShadow,        "drop_shadow",         shader_frag_drop_shadow},
 };
 static const ProgramDefinition program_definitions[] = {
-	{ProgramId::Color,       "color",        VertShaderId::Main,        FragShaderId::Color},
-	{ProgramId::Texture,     "texture",      VertShaderId::Main,        FragShaderId::Texture},
-	{ProgramId::Gradient,    "gradient",     VertShaderId::Main,        FragShaderId::Gradient},
-	{ProgramId::Creation,    "creation",     VertShaderId::Main,        FragShaderId::Creation},
-	{ProgramId::Passthrough, "passthrough",  VertShaderId::Passthrough, FragShaderId::Passthrough},
-	{ProgramId::ColorMatrix, "color_matrix", VertShaderId::Passthrough, FragShaderId::ColorMatrix},
-	{ProgramId::BlendMask,   "blend_mask",   VertShaderId::Passthrough, FragShaderId::BlendMask},
-	{ProgramId::Blur,        "blur",         VertShaderId::Blur,        FragShaderId::Blur},
-	{ProgramId::DropShadow,  "drop_shadow",  VertShaderId::Passthrough, FragShaderId::DropShadow},
+	{ProgramId::Color,              "color",               VertShaderId::Main,        FragShaderId::Color},
+	{ProgramId::Texture,            "texture",             VertShaderId::Main,        FragShaderId::Texture},
+	{ProgramId::Gradient,           "gradient",            VertShaderId::Main,        FragShaderId::Gradient},
+	{ProgramId::RoundedBox,         "rounded_box",         VertShaderId::Main,        FragShaderId::RoundedBox},
+	{ProgramId::RoundedBoxClip,     "rounded_box_clip",    VertShaderId::Main,        FragShaderId::RoundedBoxClip},
+	{ProgramId::DistanceFieldText,  "distance_field_text", VertShaderId::Main,        FragShaderId::DistanceFieldText},
+	{ProgramId::Creation,           "creation",            VertShaderId::Main,        FragShaderId::Creation},
+	{ProgramId::Passthrough,        "passthrough",         VertShaderId::Passthrough, FragShaderId::Passthrough},
+	{ProgramId::ColorMatrix,        "color_matrix",        VertShaderId::Passthrough, FragShaderId::ColorMatrix},
+	{ProgramId::BlendMask,          "blend_mask",          VertShaderId::Passthrough, FragShaderId::BlendMask},
+	{ProgramId::Blur,               "blur",                VertShaderId::Blur,        FragShaderId::Blur},
+	{ProgramId::DropShadow,         "drop_shadow",         VertShaderId::Passthrough, FragShaderId::DropShadow},
+	{ProgramId::ColorTransformed,   "color_transformed",   VertShaderId::Transformed, FragShaderId::Color},
+	{ProgramId::TextureTransformed, "texture_transformed", VertShaderId::Transformed, FragShaderId::Texture},
 };
 // clang-format on
 
@@ -447,6 +582,9 @@ struct CompiledGeometryData {
 	GLuint vbo;
 	GLuint ibo;
 	GLsizei draw_count;
+	GLenum index_type;
+	// Holds the transform index of each vertex, only for geometry compiled with transform indices.
+	GLuint transform_vbo = 0;
 };
 
 struct FramebufferData {
@@ -788,12 +926,32 @@ RenderInterface_GL3::RenderInterface_GL3()
 
 RenderInterface_GL3::~RenderInterface_GL3()
 {
+	// Wait for any textures still being decoded.
+	pending_textures.clear();
+
 	if (fullscreen_quad_geometry)
 	{
 		RenderInterface_GL3::ReleaseGeometry(fullscreen_quad_geometry);
 		fullscreen_quad_geometry = {};
 	}
 
+	for (const FullscreenQuadVariant& variant : fullscreen_quad_variants)
+		RenderInterface_GL3::ReleaseGeometry(variant.geometry);
+	fullscreen_quad_variants.clear();
+
+	if (instance_buffer)
+	{
+		glDeleteBuffers(1, &instance_buffer);
+		instance_buffer = 0;
+	}
+
+	if (quad_index_buffer)
+	{
+		glDeleteBuffers(1, &quad_index_buffer);
+		quad_index_buffer = 0;
+		quad_index_buffer_capacity = 0;
+	}
+
 	if (program_data)
 	{
 		Gfx::DestroyShaders(*program_data);
@@ -889,8 +1047,15 @@ void RenderInterface_GL3::BeginFrame()
 
 	UseProgram(ProgramId::None);
 	program_transform_dirty.set();
+	program_translation_dirty.set();
+	program_uniform_source.fill(nullptr);
 	scissor_state = Rml::Rectanglei::MakeInvalid();
 
+	// The client may have bound its own vertex array since the last frame.
+	glBindVertexArray(0);
+	bound_vertex_array = 0;
+	glVertexAttrib2f((GLuint)Gfx::VertexAttribute::InstanceTranslation, 0.f, 0.f);
+
 	Gfx::CheckGLError("BeginFrame");
 }
 
@@ -918,7 +1083,10 @@ void RenderInterface_GL3::EndFrame()
 
 	render_layers.EndFrame();
 
-	// Restore GL state.
+	// Restore GL state. Vertex arrays and textures are left bound between draws, unbind them for the client.
+	BindVertexArray(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
 	if (glstate_backup.enable_cull_face)
 		glEnable(GL_CULL_FACE);
 	else
@@ -977,17 +1145,11 @@ void RenderInterface_GL3::Clear()
 	glClear(GL_COLOR_BUFFER_BIT);
 }
 
-Rml::CompiledGeometryHandle RenderInterface_GL3::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
+// Creates and binds a vertex array object with a vertex buffer holding the given vertices.
+static void CreateVertexArray(Rml::Span<const Rml::Vertex> vertices, GLenum draw_usage, GLuint& vao, GLuint& vbo)
 {
-	constexpr GLenum draw_usage = GL_STATIC_DRAW;
-
-	GLuint vao = 0;
-	GLuint vbo = 0;
-	GLuint ibo = 0;
-
 	glGenVertexArrays(1, &vao);
 	glGenBuffers(1, &vbo);
-	glGenBuffers(1, &ibo);
 	glBindVertexArray(vao);
 
 	glBindBuffer(GL_ARRAY_BUFFER, vbo);
@@ -1004,12 +1166,36 @@ Rml::CompiledGeometryHandle RenderInterface_GL3::CompileGeometry(Rml::Span<const
 	glEnableVertexAttribArray((GLuint)Gfx::VertexAttribute::TexCoord0);
 	glVertexAttribPointer((GLuint)Gfx::VertexAttribute::TexCoord0, 2, GL_FLOAT, GL_FALSE, sizeof(Rml::Vertex),
 		(const GLvoid*)(offsetof(Rml::Vertex, tex_coord)));
+}
 
+Rml::CompiledGeometryHandle RenderInterface_GL3::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
+{
+	constexpr GLenum draw_usage = GL_STATIC_DRAW;
+
+	GLuint vao = 0;
+	GLuint vbo = 0;
+	GLuint ibo = 0;
+
+	CreateVertexArray(vertices, draw_usage, vao, vbo);
+	glGenBuffers(1, &ibo);
+
+	// Most meshes, such as text and boxes, have few enough vertices to be indexed with 16-bit indices, which halves the index data.
+	GLenum index_type = GL_UNSIGNED_INT;
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(int) * indices.size(), (const void*)indices.data(), draw_usage);
+	if (vertices.size() <= 0x10000)
+	{
+		index_type = GL_UNSIGNED_SHORT;
+		index_conversion_buffer.assign(indices.begin(), indices.end());
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * indices.size(), (const void*)index_conversion_buffer.data(), draw_usage);
+	}
+	else
+	{
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(int) * indices.size(), (const void*)indices.data(), draw_usage);
+	}
 
 	glBindVertexArray(0);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	bound_vertex_array = 0;
 
 	Gfx::CheckGLError("CompileGeometry");
 
@@ -1018,6 +1204,57 @@ Rml::CompiledGeometryHandle RenderInterface_GL3::CompileGeometry(Rml::Span<const
 	geometry->vbo = vbo;
 	geometry->ibo = ibo;
 	geometry->draw_count = (GLsizei)indices.size();
+	geometry->index_type = index_type;
+
+	return (Rml::CompiledGeometryHandle)geometry;
+}
+
+Rml::CompiledGeometryHandle RenderInterface_GL3::CompileQuadGeometry(Rml::Span<const Rml::Vertex> vertices)
+{
+	const size_t num_quads = vertices.size() / 4;
+
+	GLuint vao = 0;
+	GLuint vbo = 0;
+	CreateVertexArray(vertices, GL_STATIC_DRAW, vao, vbo);
+
+	// All quad geometry shares a single index buffer, grown to fit the largest mesh. Growing it keeps the existing indices in place, so the
+	// vertex arrays compiled earlier remain valid.
+	if (!quad_index_buffer)
+		glGenBuffers(1, &quad_index_buffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quad_index_buffer);
+
+	if (num_quads > quad_index_buffer_capacity)
+	{
+		quad_index_buffer_capacity = Rml::Math::Max(num_quads, Rml::Math::Max(quad_index_buffer_capacity * 2, size_t(256)));
+
+		Rml::Vector<GLuint> indices(quad_index_buffer_capacity * 6);
+		for (size_t i = 0; i < quad_index_buffer_capacity; i++)
+		{
+			const GLuint v0 = GLuint(i * 4);
+			GLuint* quad_indices = indices.data() + i * 6;
+			quad_indices[0] = v0;
+			quad_indices[1] = v0 + 3;
+			quad_indices[2] = v0 + 1;
+			quad_indices[3] = v0 + 1;
+			quad_indices[4] = v0 + 3;
+			quad_indices[5] = v0 + 2;
+		}
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * indices.size(), (const void*)indices.data(), GL_STATIC_DRAW);
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	bound_vertex_array = 0;
+
+	Gfx::CheckGLError("CompileQuadGeometry");
+
+	// The index buffer is not owned by the geometry, so it is not released with it.
+	Gfx::CompiledGeometryData* geometry = new Gfx::CompiledGeometryData;
+	geometry->vao = vao;
+	geometry->vbo = vbo;
+	geometry->ibo = 0;
+	geometry->draw_count = (GLsizei)(num_quads * 6);
+	geometry->index_type = GL_UNSIGNED_INT;
 
 	return (Rml::CompiledGeometryHandle)geometry;
 }
@@ -1039,27 +1276,122 @@ void RenderInterface_GL3::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml
 	}
 	else
 	{
+		// The color program doesn't sample any texture, so the bound texture is left unchanged.
 		UseProgram(ProgramId::Color);
-		glBindTexture(GL_TEXTURE_2D, 0);
 		SubmitTransformUniform(translation);
 	}
 
-	glBindVertexArray(geometry->vao);
-	glDrawElements(GL_TRIANGLES, geometry->draw_count, GL_UNSIGNED_INT, (const GLvoid*)0);
-
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	BindVertexArray(geometry->vao);
+	glDrawElements(GL_TRIANGLES, geometry->draw_count, geometry->index_type, (const GLvoid*)0);
 
 	Gfx::CheckGLError("RenderCompiledGeometry");
 }
 
+bool RenderInterface_GL3::RenderGeometryInstanced(Rml::CompiledGeometryHandle handle, Rml::Span<const Rml::Vector2f> translations,
+	Rml::TextureHandle texture)
+{
+	Gfx::CompiledGeometryData* geometry = (Gfx::CompiledGeometryData*)handle;
+
+	if (texture)
+	{
+		UseProgram(ProgramId::Texture);
+		if (texture != TextureEnableWithoutBinding)
+			glBindTexture(GL_TEXTURE_2D, (GLuint)texture);
+	}
+	else
+	{
+		UseProgram(ProgramId::Color);
+	}
+	SubmitTransformUniform(Rml::Vector2f(0.f));
+
+	if (!instance_buffer)
+		glGenBuffers(1, &instance_buffer);
+
+	BindVertexArray(geometry->vao);
+	glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(Rml::Vector2f) * translations.size(), (const void*)translations.data(), GL_STREAM_DRAW);
+
+	const GLuint attribute = (GLuint)Gfx::VertexAttribute::InstanceTranslation;
+	glEnableVertexAttribArray(attribute);
+	glVertexAttribPointer(attribute, 2, GL_FLOAT, GL_FALSE, sizeof(Rml::Vector2f), (const GLvoid*)0);
+	glVertexAttribDivisor(attribute, 1);
+
+	glDrawElementsInstanced(GL_TRIANGLES, geometry->draw_count, geometry->index_type, (const GLvoid*)0, (GLsizei)translations.size());
+
+	glDisableVertexAttribArray(attribute);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	Gfx::CheckGLError("RenderGeometryInstanced");
+	return true;
+}
+
+Rml::CompiledGeometryHandle RenderInterface_GL3::CompileTransformedGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices,
+	Rml::Span<const int> transform_indices)
+{
+	static_assert(MAX_NUM_TRANSFORMS == Rml::RenderInterface::MaxBatchTransforms, "Shader transform count must match the render interface.");
+
+	Rml::CompiledGeometryHandle handle = CompileGeometry(vertices, indices);
+	Gfx::CompiledGeometryData* geometry = (Gfx::CompiledGeometryData*)handle;
+
+	// The indices are small integers, thus they are represented exactly as floats, which avoids the need for integer vertex attributes.
+	Rml::Vector<float> transform_index_data(transform_indices.begin(), transform_indices.end());
+
+	BindVertexArray(geometry->vao);
+	glGenBuffers(1, &geometry->transform_vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, geometry->transform_vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * transform_index_data.size(), (const void*)transform_index_data.data(), GL_STATIC_DRAW);
+
+	const GLuint attribute = (GLuint)Gfx::VertexAttribute::TransformIndex;
+	glEnableVertexAttribArray(attribute);
+	glVertexAttribPointer(attribute, 1, GL_FLOAT, GL_FALSE, sizeof(float), (const GLvoid*)0);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	Gfx::CheckGLError("CompileTransformedGeometry");
+	return handle;
+}
+
+void RenderInterface_GL3::RenderTransformedGeometry(Rml::CompiledGeometryHandle handle, Rml::Span<const Rml::Matrix4f> transforms,
+	Rml::TextureHandle texture)
+{
+	Gfx::CompiledGeometryData* geometry = (Gfx::CompiledGeometryData*)handle;
+	RMLUI_ASSERT(geometry->transform_vbo && transforms.size() <= MAX_NUM_TRANSFORMS);
+
+	if (texture)
+	{
+		UseProgram(ProgramId::TextureTransformed);
+		if (texture != TextureEnableWithoutBinding)
+			glBindTexture(GL_TEXTURE_2D, (GLuint)texture);
+	}
+	else
+	{
+		UseProgram(ProgramId::ColorTransformed);
+	}
+
+	Rml::Matrix4f projected_transforms[MAX_NUM_TRANSFORMS];
+	for (size_t i = 0; i < transforms.size(); i++)
+		projected_transforms[i] = projection * transforms[i];
+	glUniformMatrix4fv(GetUniformLocation(UniformId::Transforms), (GLsizei)transforms.size(), false, projected_transforms[0].data());
+
+	BindVertexArray(geometry->vao);
+	glDrawElements(GL_TRIANGLES, geometry->draw_count, geometry->index_type, (const GLvoid*)0);
+
+	Gfx::CheckGLError("RenderTransformedGeometry");
+}
+
 void RenderInterface_GL3::ReleaseGeometry(Rml::CompiledGeometryHandle handle)
 {
 	Gfx::CompiledGeometryData* geometry = (Gfx::CompiledGeometryData*)handle;
 
+	// Deleting the bound vertex array reverts the binding to zero.
+	if (geometry->vao == bound_vertex_array)
+		bound_vertex_array = 0;
+
 	glDeleteVertexArrays(1, &geometry->vao);
 	glDeleteBuffers(1, &geometry->vbo);
 	glDeleteBuffers(1, &geometry->ibo);
+	if (geometry->transform_vbo)
+		glDeleteBuffers(1, &geometry->transform_vbo);
 
 	delete geometry;
 }
@@ -1123,6 +1455,13 @@ void RenderInterface_GL3::EnableClipMask(bool enable)
 }
 
 void RenderInterface_GL3::RenderToClipMask(Rml::ClipMaskOperation operation, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation)
+{
+	const int stencil_test_value = BeginRenderToClipMask(operation);
+	RenderGeometry(geometry, translation, {});
+	EndRenderToClipMask(stencil_test_value);
+}
+
+int RenderInterface_GL3::BeginRenderToClipMask(Rml::ClipMaskOperation operation)
 {
 	RMLUI_ASSERT(glIsEnabled(GL_STENCIL_TEST));
 	using Rml::ClipMaskOperation;
@@ -1159,8 +1498,11 @@ void RenderInterface_GL3::RenderToClipMask(Rml::ClipMaskOperation operation, Rml
 	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
 	glStencilFunc(GL_ALWAYS, stencil_write_value, GLuint(-1));
 
-	RenderGeometry(geometry, translation, {});
+	return stencil_test_value;
+}
 
+void RenderInterface_GL3::EndRenderToClipMask(int stencil_test_value)
+{
 	// Restore state
 	// @performance Cache state so we don't toggle it unnecessarily.
 	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
@@ -1168,6 +1510,27 @@ void RenderInterface_GL3::RenderToClipMask(Rml::ClipMaskOperation operation, Rml
 	glStencilFunc(GL_EQUAL, stencil_test_value, GLuint(-1));
 }
 
+bool RenderInterface_GL3::PopClipMask(Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation)
+{
+	RMLUI_ASSERT(glIsEnabled(GL_STENCIL_TEST));
+
+	// Intersections increment the stencil values covered by their geometry, thus decrementing the same values restores the previous mask.
+	GLint stencil_test_value = 1;
+	glGetIntegerv(GL_STENCIL_REF, &stencil_test_value);
+	RMLUI_ASSERT(stencil_test_value > 1);
+
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+	glStencilOp(GL_KEEP, GL_KEEP, GL_DECR);
+	glStencilFunc(GL_ALWAYS, 0, GLuint(-1));
+
+	RenderGeometry(geometry, translation, {});
+
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+	glStencilFunc(GL_EQUAL, stencil_test_value - 1, GLuint(-1));
+	return true;
+}
+
 // Set to byte packing, or the compiler will expand our struct, which means it won't read correctly from file
 #pragma pack(1)
 struct TGAHeader {
@@ -1188,6 +1551,52 @@ struct TGAHeader {
 #pragma pack()
 
 Rml::TextureHandle RenderInterface_GL3::LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source)
+{
+	Rml::Vector<Rml::byte> data;
+	if (!LoadTextureData(data, texture_dimensions, source))
+		return {};
+
+	return GenerateTexture(data, texture_dimensions);
+}
+
+struct RenderInterface_GL3::PendingTexture {
+	Rml::Vector<Rml::byte> data;
+	Rml::Vector2i dimensions;
+	// Declared last so that it is destroyed first, waiting for the worker before the data it writes to is destroyed.
+	std::future<bool> result;
+};
+
+Rml::TextureHandle RenderInterface_GL3::LoadTextureAsync(Rml::Vector2i& texture_dimensions, const Rml::String& source, bool& loading)
+{
+	// Decode the texture on a worker thread, thus the file interface must be safe to use from other threads. The decoded data is uploaded here
+	// on the main thread, once RmlUi polls the texture after the worker has finished.
+	auto it = pending_textures.find(source);
+	if (it == pending_textures.end())
+	{
+		auto pending = Rml::MakeUnique<PendingTexture>();
+		PendingTexture* pending_ptr = pending.get();
+		pending->result = std::async(std::launch::async,
+			[this, pending_ptr, source]() { return RenderInterface_GL3::LoadTextureData(pending_ptr->data, pending_ptr->dimensions, source); });
+		it = pending_textures.emplace(source, std::move(pending)).first;
+	}
+
+	PendingTexture& pending = *it->second;
+	loading = (pending.result.wait_for(std::chrono::seconds(0)) != std::future_status::ready);
+	if (loading)
+		return {};
+
+	Rml::TextureHandle texture_handle = {};
+	if (pending.result.get())
+	{
+		texture_dimensions = pending.dimensions;
+		texture_handle = GenerateTexture(pending.data, pending.dimensions);
+	}
+
+	pending_textures.erase(it);
+	return texture_handle;
+}
+
+bool RenderInterface_GL3::LoadTextureData(Rml::Vector<Rml::byte>& out_data, Rml::Vector2i& out_dimensions, const Rml::String& source)
 {
 	Rml::FileInterface* file_interface = Rml::GetFileInterface();
 	Rml::FileHandle file_handle = file_interface->Open(source);
@@ -1231,9 +1640,15 @@ Rml::TextureHandle RenderInterface_GL3::LoadTexture(Rml::Vector2i& texture_dimen
 		return false;
 	}
 
+	if (buffer_size < sizeof(TGAHeader) + size_t(header.width * header.height * color_mode))
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Texture file size is smaller than its image data, file is not a valid TGA image.");
+		return false;
+	}
+
 	const byte* image_src = buffer.get() + sizeof(TGAHeader);
-	Rml::UniquePtr<byte[]> image_dest_buffer(new byte[image_size]);
-	byte* image_dest = image_dest_buffer.get();
+	out_data.resize(image_size);
+	byte* image_dest = out_data.data();
 	const bool top_to_bottom_order = ((header.imageDescriptor & 32) != 0);
 
 	// Targa is BGR, swap to RGB, flip Y axis as necessary, and convert to premultiplied alpha.
@@ -1261,10 +1676,10 @@ Rml::TextureHandle RenderInterface_GL3::LoadTexture(Rml::Vector2i& texture_dimen
 		}
 	}
 
-	texture_dimensions.x = header.width;
-	texture_dimensions.y = header.height;
+	out_dimensions.x = header.width;
+	out_dimensions.y = header.height;
 
-	return GenerateTexture({image_dest, image_size}, texture_dimensions);
+	return true;
 }
 
 Rml::TextureHandle RenderInterface_GL3::GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions)
@@ -1280,6 +1695,18 @@ Rml::TextureHandle RenderInterface_GL3::GenerateTexture(Rml::Span<const Rml::byt
 	return (Rml::TextureHandle)texture_id;
 }
 
+bool RenderInterface_GL3::UpdateTexture(Rml::TextureHandle texture_handle, Rml::Rectanglei region, Rml::Span<const Rml::byte> source)
+{
+	RMLUI_ASSERT(source.data() && source.size() == size_t(region.Width() * region.Height() * 4));
+
+	glBindTexture(GL_TEXTURE_2D, (GLuint)texture_handle);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, region.Left(), region.Top(), region.Width(), region.Height(), GL_RGBA, GL_UNSIGNED_BYTE, source.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	Gfx::CheckGLError("UpdateTexture");
+	return true;
+}
+
 void RenderInterface_GL3::DrawFullscreenQuad()
 {
 	RenderGeometry(fullscreen_quad_geometry, {}, RenderInterface_GL3::TexturePostprocess);
@@ -1287,16 +1714,35 @@ void RenderInterface_GL3::DrawFullscreenQuad()
 
 void RenderInterface_GL3::DrawFullscreenQuad(Rml::Vector2f uv_offset, Rml::Vector2f uv_scaling)
 {
-	Rml::Mesh mesh;
-	Rml::MeshUtilities::GenerateQuad(mesh, Rml::Vector2f(-1), Rml::Vector2f(2), {});
-	if (uv_offset != Rml::Vector2f() || uv_scaling != Rml::Vector2f(1.f))
+	if (uv_offset == Rml::Vector2f() && uv_scaling == Rml::Vector2f(1.f))
 	{
+		DrawFullscreenQuad();
+		return;
+	}
+
+	// The filters request the same few variants every frame, keep the latest ones around instead of compiling them each time.
+	auto it = std::find_if(fullscreen_quad_variants.begin(), fullscreen_quad_variants.end(), [&](const FullscreenQuadVariant& variant) {
+		return variant.uv_offset == uv_offset && variant.uv_scaling == uv_scaling;
+	});
+
+	if (it == fullscreen_quad_variants.end())
+	{
+		if (fullscreen_quad_variants.size() >= MaxNumFullscreenQuadVariants)
+		{
+			ReleaseGeometry(fullscreen_quad_variants.front().geometry);
+			fullscreen_quad_variants.erase(fullscreen_quad_variants.begin());
+		}
+
+		Rml::Mesh mesh;
+		Rml::MeshUtilities::GenerateQuad(mesh, Rml::Vector2f(-1), Rml::Vector2f(2), {});
 		for (Rml::Vertex& vertex : mesh.vertices)
 			vertex.tex_coord = (vertex.tex_coord * uv_scaling) + uv_offset;
+
+		fullscreen_quad_variants.push_back(FullscreenQuadVariant{uv_offset, uv_scaling, CompileGeometry(mesh.vertices, mesh.indices)});
+		it = fullscreen_quad_variants.end() - 1;
 	}
-	const Rml::CompiledGeometryHandle geometry = CompileGeometry(mesh.vertices, mesh.indices);
-	RenderGeometry(geometry, {}, RenderInterface_GL3::TexturePostprocess);
-	ReleaseGeometry(geometry);
+
+	RenderGeometry(it->geometry, {}, RenderInterface_GL3::TexturePostprocess);
 }
 
 static Rml::Colourf ConvertToColorf(Rml::ColourbPremultiplied c0)
@@ -1387,8 +1833,11 @@ void RenderInterface_GL3::RenderBlur(float sigma, const Gfx::FramebufferData& so
 
 	glViewport(0, 0, source_destination.width, source_destination.height);
 
-	// Ensure texture data end up in the temp buffer. Depending on the last downscaling, we might need to move it from the source_destination buffer.
-	const bool transfer_to_temp_buffer = (pass_level % 2 == 0);
+	// Without downscaling, the blur passes read directly from the source and the second pass writes the result back into it, thereby
+	// skipping both the transfer and the upscaling steps. Otherwise, ensure texture data end up in the temp buffer. Depending on the
+	// last downscaling, we might need to move it from the source_destination buffer.
+	const bool blur_in_place = (pass_level == 0);
+	const bool transfer_to_temp_buffer = (!blur_in_place && pass_level % 2 == 0);
 	if (transfer_to_temp_buffer)
 	{
 		Gfx::BindTexture(source_destination);
@@ -1408,51 +1857,61 @@ void RenderInterface_GL3::RenderBlur(float sigma, const Gfx::FramebufferData& so
 		glUniform2f(texel_offset_location, texel_offset.x, texel_offset.y);
 	};
 
+	const Gfx::FramebufferData& vertical_source = (blur_in_place ? source_destination : temp);
+	const Gfx::FramebufferData& vertical_destination = (blur_in_place ? temp : source_destination);
+
 	// Blur render pass - vertical.
-	Gfx::BindTexture(temp);
-	glBindFramebuffer(GL_FRAMEBUFFER, source_destination.framebuffer);
+	Gfx::BindTexture(vertical_source);
+	glBindFramebuffer(GL_FRAMEBUFFER, vertical_destination.framebuffer);
 
-	SetTexelOffset({0.f, 1.f}, temp.height);
+	SetTexelOffset({0.f, 1.f}, vertical_source.height);
 	DrawFullscreenQuad();
 
 	// Blur render pass - horizontal.
-	Gfx::BindTexture(source_destination);
-	glBindFramebuffer(GL_FRAMEBUFFER, temp.framebuffer);
-
-	// Add a 1px transparent border around the blur region by first clearing with a padded scissor. This helps prevent
-	// artifacts when upscaling the blur result in the later step. On Intel and AMD, we have observed that during
-	// blitting with linear filtering, pixels outside the 'src' region can be blended into the output. On the other
-	// hand, it looks like Nvidia clamps the pixels to the source edge, which is what we really want. Regardless, we
-	// work around the issue with this extra step.
-	SetScissor(scissor.Extend(1), true);
-	glClear(GL_COLOR_BUFFER_BIT);
-	SetScissor(scissor, true);
+	Gfx::BindTexture(vertical_destination);
+	glBindFramebuffer(GL_FRAMEBUFFER, vertical_source.framebuffer);
+
+	if (!blur_in_place)
+	{
+		// Add a 1px transparent border around the blur region by first clearing with a padded scissor. This helps prevent
+		// artifacts when upscaling the blur result in the later step. On Intel and AMD, we have observed that during
+		// blitting with linear filtering, pixels outside the 'src' region can be blended into the output. On the other
+		// hand, it looks like Nvidia clamps the pixels to the source edge, which is what we really want. Regardless, we
+		// work around the issue with this extra step.
+		SetScissor(scissor.Extend(1), true);
+		glClear(GL_COLOR_BUFFER_BIT);
+		SetScissor(scissor, true);
+	}
 
-	SetTexelOffset({1.f, 0.f}, source_destination.width);
+	SetTexelOffset({1.f, 0.f}, vertical_destination.width);
 	DrawFullscreenQuad();
 
-	// Blit the blurred image to the scissor region with upscaling.
-	SetScissor(window_flipped, true);
-	glBindFramebuffer(GL_READ_FRAMEBUFFER, temp.framebuffer);
-	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, source_destination.framebuffer);
-
-	const Rml::Vector2i src_min = scissor.p0;
-	const Rml::Vector2i src_max = scissor.p1;
-	const Rml::Vector2i dst_min = window_flipped.p0;
-	const Rml::Vector2i dst_max = window_flipped.p1;
-	glBlitFramebuffer(src_min.x, src_min.y, src_max.x, src_max.y, dst_min.x, dst_min.y, dst_max.x, dst_max.y, GL_COLOR_BUFFER_BIT, GL_LINEAR);
-
-	// The above upscale blit might be jittery at low resolutions (large pass levels). This is especially noticeable when moving an element with
-	// backdrop blur around or when trying to click/hover an element within a blurred region since it may be rendered at an offset. For more stable
-	// and accurate rendering we next upscale the blur image by an exact power-of-two. However, this may not fill the edges completely so we need to
-	// do the above first. Note that this strategy may sometimes result in visible seams. Alternatively, we could try to enlarge the window to the
-	// next power-of-two size and then downsample and blur that.
-	const Rml::Vector2i target_min = src_min * (1 << pass_level);
-	const Rml::Vector2i target_max = src_max * (1 << pass_level);
-	if (target_min != dst_min || target_max != dst_max)
-	{
-		glBlitFramebuffer(src_min.x, src_min.y, src_max.x, src_max.y, target_min.x, target_min.y, target_max.x, target_max.y, GL_COLOR_BUFFER_BIT,
+	if (!blur_in_place)
+	{
+		// Blit the blurred image to the scissor region with upscaling.
+		SetScissor(window_flipped, true);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, temp.framebuffer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, source_destination.framebuffer);
+
+		const Rml::Vector2i src_min = scissor.p0;
+		const Rml::Vector2i src_max = scissor.p1;
+		const Rml::Vector2i dst_min = window_flipped.p0;
+		const Rml::Vector2i dst_max = window_flipped.p1;
+		glBlitFramebuffer(src_min.x, src_min.y, src_max.x, src_max.y, dst_min.x, dst_min.y, dst_max.x, dst_max.y, GL_COLOR_BUFFER_BIT,
 			GL_LINEAR);
+
+		// The above upscale blit might be jittery at low resolutions (large pass levels). This is especially noticeable when moving an element
+		// with backdrop blur around or when trying to click/hover an element within a blurred region since it may be rendered at an offset. For
+		// more stable and accurate rendering we next upscale the blur image by an exact power-of-two. However, this may not fill the edges
+		// completely so we need to do the above first. Note that this strategy may sometimes result in visible seams. Alternatively, we could
+		// try to enlarge the window to the next power-of-two size and then downsample and blur that.
+		const Rml::Vector2i target_min = src_min * (1 << pass_level);
+		const Rml::Vector2i target_max = src_max * (1 << pass_level);
+		if (target_min != dst_min || target_max != dst_max)
+		{
+			glBlitFramebuffer(src_min.x, src_min.y, src_max.x, src_max.y, target_min.x, target_min.y, target_max.x, target_max.y,
+				GL_COLOR_BUFFER_BIT, GL_LINEAR);
+		}
 	}
 
 	// Restore render state.
@@ -1607,7 +2066,7 @@ void RenderInterface_GL3::ReleaseFilter(Rml::CompiledFilterHandle filter)
 	delete reinterpret_cast<CompiledFilter*>(filter);
 }
 
-enum class CompiledShaderType { Invalid = 0, Gradient, Creation };
+enum class CompiledShaderType { Invalid = 0, Gradient, RoundedBox, DistanceFieldText, Creation };
 struct CompiledShader {
 	CompiledShaderType type;
 
@@ -1618,10 +2077,24 @@ struct CompiledShader {
 	Rml::Vector<float> stop_positions;
 	Rml::Vector<Rml::Colourf> stop_colors;
 
-	// Shader
+	// Rounded box
+	Rml::Vector4f radius;
+	Rml::Vector4f border_widths;
+	Rml::Colourf background_color;
+	Rml::Colourf border_colors[4];
+
+	// Distance field text: spread, outline width, blur width
+	Rml::Vector3f distance_field;
+
+	// Shader, rounded box
 	Rml::Vector2f dimensions;
 };
 
+bool RenderInterface_GL3::SupportsShader(const Rml::String& name)
+{
+	return name == "rounded-box" || name == "rounded-box-clip-mask" || name == "distance-field-text";
+}
+
 Rml::CompiledShaderHandle RenderInterface_GL3::CompileShader(const Rml::String& name, const Rml::Dictionary& parameters)
 {
 	auto ApplyColorStopList = [](CompiledShader& shader, const Rml::Dictionary& shader_parameters) {
@@ -1671,6 +2144,23 @@ Rml::CompiledShaderHandle RenderInterface_GL3::CompileShader(const Rml::String&
 		shader.v = {Rml::Math::Cos(angle), Rml::Math::Sin(angle)};
 		ApplyColorStopList(shader, parameters);
 	}
+	else if (name == "rounded-box")
+	{
+		shader.type = CompiledShaderType::RoundedBox;
+		shader.dimensions = Rml::Get(parameters, "dimensions", Rml::Vector2f(0.f));
+		shader.radius = Rml::Get(parameters, "radius", Rml::Vector4f(0.f));
+		shader.border_widths = Rml::Get(parameters, "border_widths", Rml::Vector4f(0.f));
+		shader.background_color = Rml::Get(parameters, "background_color", Rml::Colourf(0.f, 0.f));
+		const char* border_color_names[4] = {"border_top_color", "border_right_color", "border_bottom_color", "border_left_color"};
+		for (int i = 0; i < 4; i++)
+			shader.border_colors[i] = Rml::Get(parameters, border_color_names[i], Rml::Colourf(0.f, 0.f));
+	}
+	else if (name == "distance-field-text")
+	{
+		shader.type = CompiledShaderType::DistanceFieldText;
+		shader.distance_field = {Rml::Get(parameters, "spread", 1.f), Rml::Get(parameters, "outline_width", 0.f),
+			Rml::Get(parameters, "blur_width", 0.f)};
+	}
 	else if (name == "shader")
 	{
 		const Rml::String value = Rml::Get(parameters, "value", Rml::String());
@@ -1689,7 +2179,7 @@ Rml::CompiledShaderHandle RenderInterface_GL3::CompileShader(const Rml::String&
 }
 
 void RenderInterface_GL3::RenderShader(Rml::CompiledShaderHandle shader_handle, Rml::CompiledGeometryHandle geometry_handle,
-	Rml::Vector2f translation, Rml::TextureHandle /*texture*/)
+	Rml::Vector2f translation, Rml::TextureHandle texture)
 {
 	RMLUI_ASSERT(shader_handle && geometry_handle);
 	const CompiledShader& shader = *reinterpret_cast<CompiledShader*>(shader_handle);
@@ -1704,17 +2194,51 @@ void RenderInterface_GL3::RenderShader(Rml::CompiledShaderHandle shader_handle,
 		const int num_stops = (int)shader.stop_positions.size();
 
 		UseProgram(ProgramId::Gradient);
-		glUniform1i(GetUniformLocation(UniformId::Func), static_cast<int>(shader.gradient_function));
-		glUniform2f(GetUniformLocation(UniformId::P), shader.p.x, shader.p.y);
-		glUniform2f(GetUniformLocation(UniformId::V), shader.v.x, shader.v.y);
-		glUniform1i(GetUniformLocation(UniformId::NumStops), num_stops);
-		glUniform1fv(GetUniformLocation(UniformId::StopPositions), num_stops, shader.stop_positions.data());
-		glUniform4fv(GetUniformLocation(UniformId::StopColors), num_stops, shader.stop_colors[0]);
+		if (SetProgramUniformSource(&shader))
+		{
+			glUniform1i(GetUniformLocation(UniformId::Func), static_cast<int>(shader.gradient_function));
+			glUniform2f(GetUniformLocation(UniformId::P), shader.p.x, shader.p.y);
+			glUniform2f(GetUniformLocation(UniformId::V), shader.v.x, shader.v.y);
+			glUniform1i(GetUniformLocation(UniformId::NumStops), num_stops);
+			glUniform1fv(GetUniformLocation(UniformId::StopPositions), num_stops, shader.stop_positions.data());
+			glUniform4fv(GetUniformLocation(UniformId::StopColors), num_stops, shader.stop_colors[0]);
+		}
+
+		SubmitTransformUniform(translation);
+		BindVertexArray(geometry.vao);
+		glDrawElements(GL_TRIANGLES, geometry.draw_count, geometry.index_type, (const GLvoid*)0);
+	}
+	break;
+	case CompiledShaderType::RoundedBox:
+	{
+		UseProgram(ProgramId::RoundedBox);
+		if (SetProgramUniformSource(&shader))
+		{
+			glUniform2f(GetUniformLocation(UniformId::Dimensions), shader.dimensions.x, shader.dimensions.y);
+			glUniform4f(GetUniformLocation(UniformId::Radius), shader.radius.x, shader.radius.y, shader.radius.z, shader.radius.w);
+			glUniform4f(GetUniformLocation(UniformId::BorderWidths), shader.border_widths.x, shader.border_widths.y, shader.border_widths.z,
+				shader.border_widths.w);
+			glUniform4fv(GetUniformLocation(UniformId::Color), 1, shader.background_color);
+			glUniform4fv(GetUniformLocation(UniformId::BorderColors), 4, shader.border_colors[0]);
+		}
 
 		SubmitTransformUniform(translation);
-		glBindVertexArray(geometry.vao);
-		glDrawElements(GL_TRIANGLES, geometry.draw_count, GL_UNSIGNED_INT, (const GLvoid*)0);
-		glBindVertexArray(0);
+		BindVertexArray(geometry.vao);
+		glDrawElements(GL_TRIANGLES, geometry.draw_count, geometry.index_type, (const GLvoid*)0);
+	}
+	break;
+	case CompiledShaderType::DistanceFieldText:
+	{
+		UseProgram(ProgramId::DistanceFieldText);
+		if (SetProgramUniformSource(&shader))
+			glUniform3f(GetUniformLocation(UniformId::DistanceField), shader.distance_field.x, shader.distance_field.y, shader.distance_field.z);
+
+		SubmitTransformUniform(translation);
+		if (texture && texture != TextureEnableWithoutBinding)
+			glBindTexture(GL_TEXTURE_2D, (GLuint)texture);
+
+		BindVertexArray(geometry.vao);
+		glDrawElements(GL_TRIANGLES, geometry.draw_count, geometry.index_type, (const GLvoid*)0);
 	}
 	break;
 	case CompiledShaderType::Creation:
@@ -1726,9 +2250,8 @@ void RenderInterface_GL3::RenderShader(Rml::CompiledShaderHandle shader_handle,
 		glUniform2f(GetUniformLocation(UniformId::Dimensions), shader.dimensions.x, shader.dimensions.y);
 
 		SubmitTransformUniform(translation);
-		glBindVertexArray(geometry.vao);
-		glDrawElements(GL_TRIANGLES, geometry.draw_count, GL_UNSIGNED_INT, (const GLvoid*)0);
-		glBindVertexArray(0);
+		BindVertexArray(geometry.vao);
+		glDrawElements(GL_TRIANGLES, geometry.draw_count, geometry.index_type, (const GLvoid*)0);
 	}
 	break;
 	case CompiledShaderType::Invalid:
@@ -1741,8 +2264,45 @@ void RenderInterface_GL3::RenderShader(Rml::CompiledShaderHandle shader_handle,
 	Gfx::CheckGLError("RenderShader");
 }
 
+void RenderInterface_GL3::RenderShaderToClipMask(Rml::ClipMaskOperation mask_operation, Rml::CompiledShaderHandle shader_handle,
+	Rml::CompiledGeometryHandle geometry_handle, Rml::Vector2f translation)
+{
+	RMLUI_ASSERT(shader_handle && geometry_handle);
+	const CompiledShader& shader = *reinterpret_cast<CompiledShader*>(shader_handle);
+	const Gfx::CompiledGeometryData& geometry = *reinterpret_cast<Gfx::CompiledGeometryData*>(geometry_handle);
+	if (shader.type != CompiledShaderType::RoundedBox)
+	{
+		Rml::Log::Message(Rml::Log::LT_WARNING, "Unhandled clip mask shader %d.", (int)shader.type);
+		return;
+	}
+
+	const int stencil_test_value = BeginRenderToClipMask(mask_operation);
+
+	UseProgram(ProgramId::RoundedBoxClip);
+	if (SetProgramUniformSource(&shader))
+	{
+		glUniform2f(GetUniformLocation(UniformId::Dimensions), shader.dimensions.x, shader.dimensions.y);
+		glUniform4f(GetUniformLocation(UniformId::Radius), shader.radius.x, shader.radius.y, shader.radius.z, shader.radius.w);
+	}
+
+	SubmitTransformUniform(translation);
+	BindVertexArray(geometry.vao);
+	glDrawElements(GL_TRIANGLES, geometry.draw_count, geometry.index_type, (const GLvoid*)0);
+
+	EndRenderToClipMask(stencil_test_value);
+
+	Gfx::CheckGLError("RenderShaderToClipMask");
+}
+
 void RenderInterface_GL3::ReleaseShader(Rml::CompiledShaderHandle shader_handle)
 {
+	// A new shader may be allocated at the same address, make sure its uniforms are submitted.
+	for (const void*& source : program_uniform_source)
+	{
+		if (source == reinterpret_cast<const void*>(shader_handle))
+			source = nullptr;
+	}
+
 	delete reinterpret_cast<CompiledShader*>(shader_handle);
 }
 
@@ -2025,11 +2585,35 @@ void RenderInterface_GL3::SubmitTransformUniform(Rml::Vector2f translation)
 		program_transform_dirty.set(program_index, false);
 	}
 
-	glUniform2fv(GetUniformLocation(UniformId::Translate), 1, &translation.x);
+	if (program_translation_dirty.test(program_index) || program_translation[program_index] != translation)
+	{
+		glUniform2fv(GetUniformLocation(UniformId::Translate), 1, &translation.x);
+		program_translation[program_index] = translation;
+		program_translation_dirty.set(program_index, false);
+	}
 
 	Gfx::CheckGLError("SubmitTransformUniform");
 }
 
+bool RenderInterface_GL3::SetProgramUniformSource(const void* source)
+{
+	const void*& active_source = program_uniform_source[(size_t)active_program];
+	if (active_source == source)
+		return false;
+
+	active_source = source;
+	return true;
+}
+
+void RenderInterface_GL3::BindVertexArray(unsigned int vertex_array)
+{
+	if (bound_vertex_array != vertex_array)
+	{
+		glBindVertexArray(vertex_array);
+		bound_vertex_array = vertex_array;
+	}
+}
+
 RenderInterface_GL3::RenderLayerStack::RenderLayerStack()
 {
 	fb_postprocess.resize(4);
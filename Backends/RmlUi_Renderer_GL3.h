@@ -36,9 +36,19 @@ public:
 	Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices) override;
 	void RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture) override;
 	void ReleaseGeometry(Rml::CompiledGeometryHandle handle) override;
+	bool RenderGeometryInstanced(Rml::CompiledGeometryHandle handle, Rml::Span<const Rml::Vector2f> translations,
+		Rml::TextureHandle texture) override;
+	Rml::CompiledGeometryHandle CompileQuadGeometry(Rml::Span<const Rml::Vertex> vertices) override;
+	Rml::CompiledGeometryHandle CompileTransformedGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices,
+		Rml::Span<const int> transform_indices) override;
+	void RenderTransformedGeometry(Rml::CompiledGeometryHandle handle, Rml::Span<const Rml::Matrix4f> transforms,
+		Rml::TextureHandle texture) override;
 
 	Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	Rml::TextureHandle LoadTextureAsync(Rml::Vector2i& texture_dimensions, const Rml::String& source, bool& loading) override;
+	bool LoadTextureData(Rml::Vector<Rml::byte>& out_data, Rml::Vector2i& out_dimensions, const Rml::String& source) override;
 	Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions) override;
+	bool UpdateTexture(Rml::TextureHandle texture_handle, Rml::Rectanglei region, Rml::Span<const Rml::byte> source) override;
 	void ReleaseTexture(Rml::TextureHandle texture_handle) override;
 
 	void EnableScissorRegion(bool enable) override;
@@ -46,6 +56,9 @@ public:
 
 	void EnableClipMask(bool enable) override;
 	void RenderToClipMask(Rml::ClipMaskOperation mask_operation, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation) override;
+	bool PopClipMask(Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation) override;
+	void RenderShaderToClipMask(Rml::ClipMaskOperation mask_operation, Rml::CompiledShaderHandle shader_handle,
+		Rml::CompiledGeometryHandle geometry_handle, Rml::Vector2f translation) override;
 
 	void SetTransform(const Rml::Matrix4f* transform) override;
 
@@ -61,6 +74,7 @@ public:
 	Rml::CompiledFilterHandle CompileFilter(const Rml::String& name, const Rml::Dictionary& parameters) override;
 	void ReleaseFilter(Rml::CompiledFilterHandle filter) override;
 
+	bool SupportsShader(const Rml::String& name) override;
 	Rml::CompiledShaderHandle CompileShader(const Rml::String& name, const Rml::Dictionary& parameters) override;
 	void RenderShader(Rml::CompiledShaderHandle shader_handle, Rml::CompiledGeometryHandle geometry_handle, Rml::Vector2f translation,
 		Rml::TextureHandle texture) override;
@@ -80,12 +94,19 @@ private:
 	void UseProgram(ProgramId program_id);
 	int GetUniformLocation(UniformId uniform_id) const;
 	void SubmitTransformUniform(Rml::Vector2f translation);
+	// Returns true if the uniforms of the given source, such as a compiled shader, need to be submitted to the active program.
+	bool SetProgramUniformSource(const void* source);
+	void BindVertexArray(unsigned int vertex_array);
 
 	void BlitLayerToPostprocessPrimary(Rml::LayerHandle layer_handle);
 	void RenderFilters(Rml::Span<const Rml::CompiledFilterHandle> filter_handles);
 
 	void SetScissor(Rml::Rectanglei region, bool vertically_flip = false);
 
+	// Prepares the stencil state for rendering to the clip mask, returns the stencil value to test against afterwards.
+	int BeginRenderToClipMask(Rml::ClipMaskOperation mask_operation);
+	void EndRenderToClipMask(int stencil_test_value);
+
 	void DrawFullscreenQuad();
 	void DrawFullscreenQuad(Rml::Vector2f uv_offset, Rml::Vector2f uv_scaling = Rml::Vector2f(1.f));
 
@@ -93,11 +114,15 @@ private:
 
 	static constexpr size_t MaxNumPrograms = 32;
 	std::bitset<MaxNumPrograms> program_transform_dirty;
+	std::bitset<MaxNumPrograms> program_translation_dirty;
+	Rml::Array<Rml::Vector2f, MaxNumPrograms> program_translation;
+	Rml::Array<const void*, MaxNumPrograms> program_uniform_source = {};
 
 	Rml::Matrix4f transform;
 	Rml::Matrix4f projection;
 
 	ProgramId active_program = {};
+	unsigned int bound_vertex_array = 0;
 	Rml::Rectanglei scissor_state;
 
 	int viewport_width = 0;
@@ -107,8 +132,28 @@ private:
 
 	Rml::CompiledGeometryHandle fullscreen_quad_geometry = {};
 
+	// Fullscreen quads with modified texture coordinates, by least recently compiled first.
+	struct FullscreenQuadVariant {
+		Rml::Vector2f uv_offset;
+		Rml::Vector2f uv_scaling;
+		Rml::CompiledGeometryHandle geometry;
+	};
+	static constexpr size_t MaxNumFullscreenQuadVariants = 8;
+	Rml::Vector<FullscreenQuadVariant> fullscreen_quad_variants;
+	// Holds the per-instance translations of the latest instanced draw.
+	unsigned int instance_buffer = 0;
+	// Indices converted to 16-bit during geometry compilation, retained to reuse its memory.
+	Rml::Vector<uint16_t> index_conversion_buffer;
+	// Index buffer shared by all quad geometry, with room for the given number of quads.
+	unsigned int quad_index_buffer = 0;
+	size_t quad_index_buffer_capacity = 0;
+
 	Rml::UniquePtr<const Gfx::ProgramData> program_data;
 
+	// Textures being decoded on worker threads during asynchronous texture loading, by source.
+	struct PendingTexture;
+	Rml::UnorderedMap<Rml::String, Rml::UniquePtr<PendingTexture>> pending_textures;
+
 	/*
 	    Manages render targets, including the layer stack and postprocessing framebuffers.
 
@@ -46,49 +46,76 @@ void RenderInterface_SDL::BeginFrame()
 	SDL_SetRenderDrawBlendMode(renderer, blend_mode);
 }
 
-void RenderInterface_SDL::EndFrame() {}
+void RenderInterface_SDL::EndFrame()
+{
+	FlushBatch();
+}
 
 Rml::CompiledGeometryHandle RenderInterface_SDL::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
 {
-	GeometryView* data = new GeometryView{vertices, indices};
-	return reinterpret_cast<Rml::CompiledGeometryHandle>(data);
+	CompiledGeometry* geometry = new CompiledGeometry{Rml::Vector<SDL_Vertex>(vertices.size()), indices};
+
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		SDL_Vertex& sdl_vertex = geometry->vertices[i];
+		sdl_vertex.position = {vertices[i].position.x, vertices[i].position.y};
+		sdl_vertex.tex_coord = {vertices[i].tex_coord.x, vertices[i].tex_coord.y};
+
+		const auto& color = vertices[i].colour;
+#if SDL_MAJOR_VERSION >= 3
+		sdl_vertex.color = {color.red / 255.f, color.green / 255.f, color.blue / 255.f, color.alpha / 255.f};
+#else
+		sdl_vertex.color = {color.red, color.green, color.blue, color.alpha};
+#endif
+	}
+
+	return reinterpret_cast<Rml::CompiledGeometryHandle>(geometry);
 }
 
 void RenderInterface_SDL::ReleaseGeometry(Rml::CompiledGeometryHandle geometry)
 {
-	delete reinterpret_cast<GeometryView*>(geometry);
+	delete reinterpret_cast<CompiledGeometry*>(geometry);
 }
 
 void RenderInterface_SDL::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture)
 {
-	const GeometryView* geometry = reinterpret_cast<GeometryView*>(handle);
-	const Rml::Vertex* vertices = geometry->vertices.data();
-	const size_t num_vertices = geometry->vertices.size();
-	const int* indices = geometry->indices.data();
-	const size_t num_indices = geometry->indices.size();
-
-	Rml::UniquePtr<SDL_Vertex[]> sdl_vertices{new SDL_Vertex[num_vertices]};
+	const CompiledGeometry* geometry = reinterpret_cast<CompiledGeometry*>(handle);
+	SDL_Texture* sdl_texture = (SDL_Texture*)texture;
 
-	for (size_t i = 0; i < num_vertices; i++)
+	if (sdl_texture != batch_texture)
 	{
-		sdl_vertices[i].position = {vertices[i].position.x + translation.x, vertices[i].position.y + translation.y};
-		sdl_vertices[i].tex_coord = {vertices[i].tex_coord.x, vertices[i].tex_coord.y};
+		FlushBatch();
+		batch_texture = sdl_texture;
+	}
 
-		const auto& color = vertices[i].colour;
-#if SDL_MAJOR_VERSION >= 3
-		sdl_vertices[i].color = {color.red / 255.f, color.green / 255.f, color.blue / 255.f, color.alpha / 255.f};
-#else
-		sdl_vertices[i].color = {color.red, color.green, color.blue, color.alpha};
-#endif
+	const int base_vertex = (int)batch_vertices.size();
+	for (SDL_Vertex vertex : geometry->vertices)
+	{
+		vertex.position.x += translation.x;
+		vertex.position.y += translation.y;
+		batch_vertices.push_back(vertex);
 	}
 
-	SDL_Texture* sdl_texture = (SDL_Texture*)texture;
+	for (int index : geometry->indices)
+		batch_indices.push_back(base_vertex + index);
+}
+
+void RenderInterface_SDL::FlushBatch()
+{
+	if (!batch_indices.empty())
+	{
+		SDL_RenderGeometry(renderer, batch_texture, batch_vertices.data(), (int)batch_vertices.size(), batch_indices.data(),
+			(int)batch_indices.size());
+	}
 
-	SDL_RenderGeometry(renderer, sdl_texture, sdl_vertices.get(), (int)num_vertices, indices, (int)num_indices);
+	batch_vertices.clear();
+	batch_indices.clear();
 }
 
 void RenderInterface_SDL::EnableScissorRegion(bool enable)
 {
+	FlushBatch();
+
 	if (enable)
 		SetRenderClipRect(renderer, &rect_scissor);
 	else
@@ -99,6 +126,9 @@ void RenderInterface_SDL::EnableScissorRegion(bool enable)
 
 void RenderInterface_SDL::SetScissorRegion(Rml::Rectanglei region)
 {
+	if (scissor_region_enabled)
+		FlushBatch();
+
 	rect_scissor.x = region.Left();
 	rect_scissor.y = region.Top();
 	rect_scissor.w = region.Width();
@@ -175,6 +205,73 @@ Rml::TextureHandle RenderInterface_SDL::LoadTexture(Rml::Vector2i& texture_dimen
 	return (Rml::TextureHandle)texture;
 }
 
+bool RenderInterface_SDL::LoadTextureData(Rml::Vector<Rml::byte>& out_data, Rml::Vector2i& out_dimensions, const Rml::String& source)
+{
+	Rml::FileInterface* file_interface = Rml::GetFileInterface();
+	Rml::FileHandle file_handle = file_interface->Open(source);
+	if (!file_handle)
+		return false;
+
+	file_interface->Seek(file_handle, 0, SEEK_END);
+	size_t buffer_size = file_interface->Tell(file_handle);
+	file_interface->Seek(file_handle, 0, SEEK_SET);
+
+	using Rml::byte;
+	Rml::UniquePtr<byte[]> buffer(new byte[buffer_size]);
+	file_interface->Read(buffer.get(), buffer_size, file_handle);
+	file_interface->Close(file_handle);
+
+	const size_t i_ext = source.rfind('.');
+	Rml::String extension = (i_ext == Rml::String::npos ? Rml::String() : source.substr(i_ext + 1));
+
+#if SDL_MAJOR_VERSION >= 3
+	auto CreateSurface = [&]() { return IMG_LoadTyped_IO(SDL_IOFromMem(buffer.get(), int(buffer_size)), 1, extension.c_str()); };
+	auto GetSurfaceFormat = [](SDL_Surface* surface) { return surface->format; };
+	auto ConvertSurface = [](SDL_Surface* surface, SDL_PixelFormat format) { return SDL_ConvertSurface(surface, format); };
+	auto DestroySurface = [](SDL_Surface* surface) { SDL_DestroySurface(surface); };
+#else
+	auto CreateSurface = [&]() { return IMG_LoadTyped_RW(SDL_RWFromMem(buffer.get(), int(buffer_size)), 1, extension.c_str()); };
+	auto GetSurfaceFormat = [](SDL_Surface* surface) { return surface->format->format; };
+	auto ConvertSurface = [](SDL_Surface* surface, Uint32 format) { return SDL_ConvertSurfaceFormat(surface, format, 0); };
+	auto DestroySurface = [](SDL_Surface* surface) { SDL_FreeSurface(surface); };
+#endif
+
+	SDL_Surface* surface = CreateSurface();
+	if (!surface)
+		return false;
+
+	// Unlike LoadTexture, the data must be in the same format as for GenerateTexture.
+	if (GetSurfaceFormat(surface) != SDL_PIXELFORMAT_RGBA32)
+	{
+		SDL_Surface* converted_surface = ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+		DestroySurface(surface);
+		if (!converted_surface)
+			return false;
+
+		surface = converted_surface;
+	}
+
+	// Copy the rows without their padding, and convert colors to premultiplied alpha.
+	const size_t row_byte_size = size_t(surface->w) * 4;
+	out_data.resize(row_byte_size * size_t(surface->h));
+	for (int y = 0; y < surface->h; y++)
+	{
+		const byte* row = static_cast<const byte*>(surface->pixels) + y * surface->pitch;
+		byte* out_row = out_data.data() + y * row_byte_size;
+		for (size_t i = 0; i < row_byte_size; i += 4)
+		{
+			const byte alpha = row[i + 3];
+			for (size_t j = 0; j < 3; ++j)
+				out_row[i + j] = byte(int(row[i + j]) * int(alpha) / 255);
+			out_row[i + 3] = alpha;
+		}
+	}
+
+	out_dimensions = Rml::Vector2i(surface->w, surface->h);
+	DestroySurface(surface);
+	return true;
+}
+
 Rml::TextureHandle RenderInterface_SDL::GenerateTexture(Rml::Span<const Rml::byte> source, Rml::Vector2i source_dimensions)
 {
 	RMLUI_ASSERT(source.data() && source.size() == size_t(source_dimensions.x * source_dimensions.y * 4));
@@ -203,5 +300,11 @@ Rml::TextureHandle RenderInterface_SDL::GenerateTexture(Rml::Span<const Rml::byt
 
 void RenderInterface_SDL::ReleaseTexture(Rml::TextureHandle texture_handle)
 {
+	if ((SDL_Texture*)texture_handle == batch_texture)
+	{
+		FlushBatch();
+		batch_texture = nullptr;
+	}
+
 	SDL_DestroyTexture((SDL_Texture*)texture_handle);
 }
@@ -16,6 +16,7 @@ public:
 
 	// Sets up OpenGL states for taking rendering commands from RmlUi.
 	void BeginFrame();
+	// Submits any remaining batched geometry, call before presenting the frame.
 	void EndFrame();
 
 	// -- Inherited from Rml::RenderInterface --
@@ -25,6 +26,7 @@ public:
 	void RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture) override;
 
 	Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	bool LoadTextureData(Rml::Vector<Rml::byte>& out_data, Rml::Vector2i& out_dimensions, const Rml::String& source) override;
 	Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source, Rml::Vector2i source_dimensions) override;
 	void ReleaseTexture(Rml::TextureHandle texture_handle) override;
 
@@ -32,12 +34,19 @@ public:
 	void SetScissorRegion(Rml::Rectanglei region) override;
 
 private:
-	struct GeometryView {
-		Rml::Span<const Rml::Vertex> vertices;
+	// Geometry is converted to SDL vertices once during compilation.
+	struct CompiledGeometry {
+		Rml::Vector<SDL_Vertex> vertices;
 		Rml::Span<const int> indices;
 	};
 
+	// Consecutive geometry with the same texture and scissor region is merged, and submitted in a single call.
+	void FlushBatch();
+
 	SDL_Renderer* renderer;
+	Rml::Vector<SDL_Vertex> batch_vertices;
+	Rml::Vector<int> batch_indices;
+	SDL_Texture* batch_texture = nullptr;
 	SDL_BlendMode blend_mode = {};
 	SDL_Rect rect_scissor = {};
 	bool scissor_region_enabled = false;
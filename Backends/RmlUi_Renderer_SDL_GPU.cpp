@@ -152,7 +152,8 @@ void RenderInterface_SDL_GPU::CreatePipelines()
 }
 
 RenderInterface_SDL_GPU::RenderInterface_SDL_GPU(SDL_GPUDevice* device, SDL_Window* window) :
-	device(device), window(window), copy_pass(nullptr), render_pass(nullptr)
+	device(device), window(window), command_buffer(nullptr), render_pass(nullptr), copy_pass(nullptr), upload_transfer_buffer(nullptr),
+	upload_transfer_buffer_capacity(0)
 {
 	CreatePipelines();
 
@@ -173,15 +174,19 @@ RenderInterface_SDL_GPU::RenderInterface_SDL_GPU(SDL_GPUDevice* device, SDL_Wind
 
 void RenderInterface_SDL_GPU::Shutdown()
 {
+	pending_uploads.clear();
+	upload_data.clear();
 	for (Rml::UniquePtr<Command>& command : commands)
 	{
 		command->Update(*this);
 	}
 	for (Rml::UniquePtr<Buffer>& buffer : buffers)
 	{
-		SDL_ReleaseGPUTransferBuffer(device, buffer->transfer_buffer);
 		SDL_ReleaseGPUBuffer(device, buffer->buffer);
 	}
+	SDL_ReleaseGPUTransferBuffer(device, upload_transfer_buffer);
+	upload_transfer_buffer = nullptr;
+	upload_transfer_buffer_capacity = 0;
 	SDL_ReleaseGPUSampler(device, linear_sampler);
 	SDL_ReleaseGPUGraphicsPipeline(device, color_pipeline);
 	SDL_ReleaseGPUGraphicsPipeline(device, texture_pipeline);
@@ -200,6 +205,9 @@ void RenderInterface_SDL_GPU::BeginFrame(SDL_GPUCommandBuffer* command_buffer, S
 
 void RenderInterface_SDL_GPU::EndFrame()
 {
+	// Upload all data staged since the last frame before any of it is drawn or released.
+	FlushUploads();
+
 	for (Rml::UniquePtr<Command>& command : commands)
 	{
 		command->Update(*this);
@@ -238,6 +246,92 @@ bool RenderInterface_SDL_GPU::BeginCopyPass()
 	return true;
 }
 
+uint32_t RenderInterface_SDL_GPU::StageUpload(const void* data, uint32_t size, uint32_t alignment)
+{
+	const uint32_t offset = static_cast<uint32_t>((upload_data.size() + alignment - 1) / alignment * alignment);
+	upload_data.resize(offset + size);
+	std::memcpy(upload_data.data() + offset, data, size);
+	return offset;
+}
+
+bool RenderInterface_SDL_GPU::FlushUploads()
+{
+	if (pending_uploads.empty())
+	{
+		upload_data.clear();
+		return true;
+	}
+
+	const uint32_t upload_size = static_cast<uint32_t>(upload_data.size());
+	if (upload_size > upload_transfer_buffer_capacity)
+	{
+		SDL_ReleaseGPUTransferBuffer(device, upload_transfer_buffer);
+
+		// Grow geometrically so that the staging buffer is rarely recreated.
+		const uint32_t capacity = Rml::Math::Max(upload_size, upload_transfer_buffer_capacity * 2);
+		SDL_GPUTransferBufferCreateInfo info{};
+		info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+		info.size = capacity;
+		upload_transfer_buffer = SDL_CreateGPUTransferBuffer(device, &info);
+		upload_transfer_buffer_capacity = (upload_transfer_buffer ? capacity : 0);
+	}
+
+	bool result = false;
+	if (!upload_transfer_buffer)
+	{
+		Log::Message(Log::LT_ERROR, "Failed to create transfer buffer: %s", SDL_GetError());
+	}
+	else if (void* dst = SDL_MapGPUTransferBuffer(device, upload_transfer_buffer, true))
+	{
+		// The transfer buffer is cycled when mapped, thus uploads from previous frames still in flight are left intact.
+		std::memcpy(dst, upload_data.data(), upload_size);
+		SDL_UnmapGPUTransferBuffer(device, upload_transfer_buffer);
+
+		if (BeginCopyPass())
+		{
+			for (const PendingUpload& upload : pending_uploads)
+			{
+				if (upload.buffer)
+				{
+					SDL_GPUTransferBufferLocation location{};
+					location.transfer_buffer = upload_transfer_buffer;
+					location.offset = upload.offset;
+
+					SDL_GPUBufferRegion region{};
+					region.buffer = upload.buffer;
+					region.size = upload.size;
+
+					// Pooled buffers may be reused while a previous frame still reads from them, let SDL cycle them in that case.
+					SDL_UploadToGPUBuffer(copy_pass, &location, &region, true);
+				}
+				else
+				{
+					SDL_GPUTextureTransferInfo transfer_info{};
+					transfer_info.transfer_buffer = upload_transfer_buffer;
+					transfer_info.offset = upload.offset;
+
+					SDL_GPUTextureRegion region{};
+					region.texture = upload.texture;
+					region.w = upload.width;
+					region.h = upload.height;
+					region.d = 1;
+
+					SDL_UploadToGPUTexture(copy_pass, &transfer_info, &region, false);
+				}
+			}
+			result = true;
+		}
+	}
+	else
+	{
+		Log::Message(Log::LT_ERROR, "Failed to map transfer buffer: %s", SDL_GetError());
+	}
+
+	pending_uploads.clear();
+	upload_data.clear();
+	return result;
+}
+
 bool RenderInterface_SDL_GPU::BeginRenderPass()
 {
 	if (render_pass)
@@ -264,11 +358,6 @@ bool RenderInterface_SDL_GPU::BeginRenderPass()
 
 CompiledGeometryHandle RenderInterface_SDL_GPU::CompileGeometry(Span<const Vertex> vertices, Span<const int> indices)
 {
-	if (!BeginCopyPass())
-	{
-		return 0;
-	}
-
 	uint32_t vertex_size = static_cast<int>(vertices.size() * sizeof(Vertex));
 	uint32_t index_size = static_cast<int>(indices.size() * sizeof(int));
 
@@ -282,32 +371,17 @@ CompiledGeometryHandle RenderInterface_SDL_GPU::CompileGeometry(Span<const Verte
 		return 0;
 	}
 
-	void* vertex_data = SDL_MapGPUTransferBuffer(device, geometry->vertex_buffer->transfer_buffer, true);
-	void* index_data = SDL_MapGPUTransferBuffer(device, geometry->index_buffer->transfer_buffer, true);
-	if (!vertex_data || !index_data)
-	{
-		Log::Message(Log::LT_ERROR, "Failed to map transfer buffer(s): %s", SDL_GetError());
-		delete geometry;
-		return 0;
-	}
-
-	std::memcpy(vertex_data, vertices.data(), vertex_size);
-	std::memcpy(index_data, indices.data(), index_size);
-	SDL_UnmapGPUTransferBuffer(device, geometry->vertex_buffer->transfer_buffer);
-	SDL_UnmapGPUTransferBuffer(device, geometry->index_buffer->transfer_buffer);
+	// Stage the data, it is uploaded together with all other uploads of the frame in a single copy pass.
+	PendingUpload upload{};
+	upload.offset = StageUpload(vertices.data(), vertex_size, UploadBufferAlignment);
+	upload.size = vertex_size;
+	upload.buffer = geometry->vertex_buffer->buffer;
+	pending_uploads.push_back(upload);
 
-	SDL_GPUTransferBufferLocation location{};
-	SDL_GPUBufferRegion region{};
-
-	location.transfer_buffer = geometry->vertex_buffer->transfer_buffer;
-	region.buffer = geometry->vertex_buffer->buffer;
-	region.size = vertex_size;
-	SDL_UploadToGPUBuffer(copy_pass, &location, &region, false);
-
-	location.transfer_buffer = geometry->index_buffer->transfer_buffer;
-	region.buffer = geometry->index_buffer->buffer;
-	region.size = index_size;
-	SDL_UploadToGPUBuffer(copy_pass, &location, &region, false);
+	upload.offset = StageUpload(indices.data(), index_size, UploadBufferAlignment);
+	upload.size = index_size;
+	upload.buffer = geometry->index_buffer->buffer;
+	pending_uploads.push_back(upload);
 
 	geometry->num_indices = static_cast<int>(indices.size());
 	geometry->vertex_buffer->in_use = true;
@@ -404,19 +478,29 @@ void RenderInterface_SDL_GPU::SetScissorRegion(Rectanglei region)
 }
 
 TextureHandle RenderInterface_SDL_GPU::LoadTexture(Vector2i& texture_dimensions, const String& source)
+{
+	Vector<byte> data;
+	if (!LoadTextureData(data, texture_dimensions, source))
+	{
+		return 0;
+	}
+
+	return GenerateTexture(data, texture_dimensions);
+}
+
+bool RenderInterface_SDL_GPU::LoadTextureData(Vector<byte>& out_data, Vector2i& out_dimensions, const String& source)
 {
 	Rml::FileInterface* file_interface = Rml::GetFileInterface();
 	Rml::FileHandle file_handle = file_interface->Open(source);
 	if (!file_handle)
 	{
-		return 0;
+		return false;
 	}
 
 	file_interface->Seek(file_handle, 0, SEEK_END);
 	size_t buffer_size = file_interface->Tell(file_handle);
 	file_interface->Seek(file_handle, 0, SEEK_SET);
 
-	using Rml::byte;
 	Rml::UniquePtr<byte[]> buffer(new byte[buffer_size]);
 	file_interface->Read(buffer.get(), buffer_size, file_handle);
 	file_interface->Close(file_handle);
@@ -427,70 +511,48 @@ TextureHandle RenderInterface_SDL_GPU::LoadTexture(Vector2i& texture_dimensions,
 	SDL_Surface* surface = IMG_LoadTyped_IO(SDL_IOFromMem(buffer.get(), int(buffer_size)), 1, extension.c_str());
 	if (!surface)
 	{
-		return 0;
+		return false;
 	}
 
-	texture_dimensions = {surface->w, surface->h};
-
 	if (surface->format != SDL_PIXELFORMAT_RGBA32)
 	{
 		SDL_Surface* converted_surface = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
 		SDL_DestroySurface(surface);
 		if (!converted_surface)
 		{
-			return 0;
+			return false;
 		}
 
 		surface = converted_surface;
 	}
 
-	// Convert colors to premultiplied alpha, which is necessary for correct alpha compositing.
-	const size_t pixels_byte_size = surface->w * surface->h * 4;
-	byte* pixels = static_cast<byte*>(surface->pixels);
-	for (size_t i = 0; i < pixels_byte_size; i += 4)
+	// Copy the rows without their padding, and convert colors to premultiplied alpha which is necessary for correct alpha compositing.
+	const size_t row_byte_size = size_t(surface->w) * 4;
+	out_data.resize(row_byte_size * size_t(surface->h));
+	for (int y = 0; y < surface->h; y++)
 	{
-		const byte alpha = pixels[i + 3];
-		for (size_t j = 0; j < 3; ++j)
+		const byte* row = static_cast<const byte*>(surface->pixels) + y * surface->pitch;
+		byte* out_row = out_data.data() + y * row_byte_size;
+		for (size_t i = 0; i < row_byte_size; i += 4)
 		{
-			pixels[i + j] = byte(int(pixels[i + j]) * int(alpha) / 255);
+			const byte alpha = row[i + 3];
+			for (size_t j = 0; j < 3; ++j)
+			{
+				out_row[i + j] = byte(int(row[i + j]) * int(alpha) / 255);
+			}
+			out_row[i + 3] = alpha;
 		}
 	}
 
-	Span<const byte> data{static_cast<const byte*>(surface->pixels), static_cast<size_t>(surface->pitch * surface->h)};
-	texture_dimensions = {surface->w, surface->h};
-
-	TextureHandle handle = GenerateTexture(data, texture_dimensions);
+	out_dimensions = {surface->w, surface->h};
 
 	SDL_DestroySurface(surface);
 
-	return handle;
+	return true;
 }
 
 TextureHandle RenderInterface_SDL_GPU::GenerateTexture(Span<const byte> source, Vector2i source_dimensions)
 {
-	SDL_GPUTransferBuffer* transfer_buffer;
-	{
-		SDL_GPUTransferBufferCreateInfo info{};
-		info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-		info.size = source_dimensions.x * source_dimensions.y * 4;
-		transfer_buffer = SDL_CreateGPUTransferBuffer(device, &info);
-		if (!transfer_buffer)
-		{
-			Log::Message(Log::LT_ERROR, "Failed to create transfer buffer: %s", SDL_GetError());
-			return 0;
-		}
-	}
-
-	void* dst = SDL_MapGPUTransferBuffer(device, transfer_buffer, false);
-	if (!dst)
-	{
-		SDL_Log("Failed to map transfer buffer: %s", SDL_GetError());
-		return 0;
-	}
-
-	std::memcpy(dst, source.data(), source_dimensions.x * source_dimensions.y * 4);
-	SDL_UnmapGPUTransferBuffer(device, transfer_buffer);
-
 	SDL_GPUTexture* texture;
 	{
 		SDL_GPUTextureCreateInfo info{};
@@ -509,38 +571,16 @@ TextureHandle RenderInterface_SDL_GPU::GenerateTexture(Span<const byte> source,
 		}
 	}
 
-	SDL_GPUTextureTransferInfo transfer_info{};
-	SDL_GPUTextureRegion region{};
-	transfer_info.transfer_buffer = transfer_buffer;
-	region.texture = texture;
-	region.w = source_dimensions.x;
-	region.h = source_dimensions.y;
-	region.d = 1;
-
-	// We can get calls out outside of Begin/End Frame so always acquire a command buffer here
-	SDL_GPUCommandBuffer* command_buffer = SDL_AcquireGPUCommandBuffer(device);
-	if (!command_buffer)
-	{
-		Log::Message(Log::LT_ERROR, "Failed to acquire command buffer: %s", SDL_GetError());
-		SDL_ReleaseGPUTransferBuffer(device, transfer_buffer);
-		SDL_ReleaseGPUTexture(device, texture);
-		return 0;
-	}
-
-	SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass(command_buffer);
-	if (!copy_pass)
-	{
-		Log::Message(Log::LT_ERROR, "Failed to begin copy pass: %s", SDL_GetError());
-		SDL_ReleaseGPUTransferBuffer(device, transfer_buffer);
-		SDL_ReleaseGPUTexture(device, texture);
-		SDL_CancelGPUCommandBuffer(command_buffer);
-		return 0;
-	}
-
-	SDL_UploadToGPUTexture(copy_pass, &transfer_info, &region, false);
-	SDL_ReleaseGPUTransferBuffer(device, transfer_buffer);
-	SDL_EndGPUCopyPass(copy_pass);
-	SDL_SubmitGPUCommandBuffer(command_buffer);
+	// We can get calls outside of Begin/End Frame, the pixels are staged and uploaded at the end of the next frame before any command can
+	// draw the texture.
+	const uint32_t size = static_cast<uint32_t>(source_dimensions.x * source_dimensions.y * 4);
+	PendingUpload upload{};
+	upload.offset = StageUpload(source.data(), size, UploadTextureAlignment);
+	upload.size = size;
+	upload.texture = texture;
+	upload.width = static_cast<uint32_t>(source_dimensions.x);
+	upload.height = static_cast<uint32_t>(source_dimensions.y);
+	pending_uploads.push_back(upload);
 
 	return reinterpret_cast<TextureHandle>(texture);
 }
@@ -603,23 +643,15 @@ RenderInterface_SDL_GPU::Buffer* RenderInterface_SDL_GPU::RequestBuffer(int capa
 	}
 
 	Rml::UniquePtr<Buffer> buffer = Rml::MakeUnique<Buffer>();
-	{
-		SDL_GPUTransferBufferCreateInfo info{};
-		info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-		info.size = capacity;
-		buffer->transfer_buffer = SDL_CreateGPUTransferBuffer(device, &info);
-	}
 	{
 		SDL_GPUBufferCreateInfo info{};
 		info.usage = usage;
 		info.size = capacity;
 		buffer->buffer = SDL_CreateGPUBuffer(device, &info);
 	}
-	if (!buffer->transfer_buffer || !buffer->buffer)
+	if (!buffer->buffer)
 	{
-		Log::Message(Log::LT_ERROR, "Failed to create buffer(s): %s", SDL_GetError());
-		SDL_ReleaseGPUTransferBuffer(device, buffer->transfer_buffer);
-		SDL_ReleaseGPUBuffer(device, buffer->buffer);
+		Log::Message(Log::LT_ERROR, "Failed to create buffer: %s", SDL_GetError());
 		return {};
 	}
 	buffer->usage = usage;
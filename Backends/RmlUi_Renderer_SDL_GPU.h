@@ -14,6 +14,7 @@ public:
 	void ReleaseGeometry(Rml::CompiledGeometryHandle geometry) override;
 	void RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture) override;
 	Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	bool LoadTextureData(Rml::Vector<Rml::byte>& out_data, Rml::Vector2i& out_dimensions, const Rml::String& source) override;
 	Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source, Rml::Vector2i source_dimensions) override;
 	void ReleaseTexture(Rml::TextureHandle texture_handle) override;
 	void EnableScissorRegion(bool enable) override;
@@ -95,7 +96,6 @@ private:
 	friend struct SetTransformCommand;
 
 	struct Buffer {
-		SDL_GPUTransferBuffer* transfer_buffer;
 		SDL_GPUBuffer* buffer;
 		SDL_GPUBufferUsageFlags usage;
 		int capacity;
@@ -114,8 +114,29 @@ private:
 	// Sorted vertex/index buffers by capacities
 	Rml::Vector<Rml::UniquePtr<Buffer>> buffers;
 
+	// Data staged for upload to either a buffer or a texture, located at 'offset' in the staged upload data.
+	struct PendingUpload {
+		uint32_t offset;
+		uint32_t size;
+		SDL_GPUBuffer* buffer;
+		SDL_GPUTexture* texture;
+		uint32_t width;
+		uint32_t height;
+	};
+
+	static constexpr uint32_t UploadBufferAlignment = 16;
+	static constexpr uint32_t UploadTextureAlignment = 512;
+
+	// All uploads since the last flush, copied through a single transfer buffer in one copy pass per frame
+	Rml::Vector<Rml::byte> upload_data;
+	Rml::Vector<PendingUpload> pending_uploads;
+	SDL_GPUTransferBuffer* upload_transfer_buffer;
+	uint32_t upload_transfer_buffer_capacity;
+
 	void CreatePipelines();
 	bool BeginCopyPass();
 	bool BeginRenderPass();
+	uint32_t StageUpload(const void* data, uint32_t size, uint32_t alignment);
+	bool FlushUploads();
 	Buffer* RequestBuffer(int capacity, SDL_GPUBufferUsageFlags usage);
 };
@@ -59,13 +59,14 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL MyDebugReportCallback(VkDebugUtilsMessageS
 
 RenderInterface_VK::RenderInterface_VK() :
 	m_is_transform_enabled{false}, m_is_apply_to_regular_geometry_stencil{false}, m_is_use_scissor_specified{false}, m_is_use_stencil_pipeline{false},
-	m_width{}, m_height{}, m_queue_index_present{}, m_queue_index_graphics{}, m_queue_index_compute{}, m_semaphore_index{},
-	m_semaphore_index_previous{}, m_image_index{}, m_p_instance{}, m_p_device{}, m_p_physical_device{}, m_p_surface{}, m_p_swapchain{},
+	m_width{}, m_height{}, m_queue_index_present{}, m_queue_index_graphics{}, m_queue_index_compute{}, m_queue_index_transfer{}, m_semaphore_index{},
+	m_image_index{}, m_p_instance{}, m_p_device{}, m_p_physical_device{}, m_p_surface{}, m_p_swapchain{},
 	m_p_allocator{}, m_p_current_command_buffer{}, m_p_descriptor_set_layout_vertex_transform{}, m_p_descriptor_set_layout_texture{},
 	m_p_pipeline_layout{}, m_p_pipeline_with_textures{}, m_p_pipeline_without_textures{},
 	m_p_pipeline_stencil_for_region_where_geometry_will_be_drawn{}, m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_with_textures{},
 	m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_without_textures{}, m_p_descriptor_set{}, m_p_render_pass{},
 	m_p_sampler_linear{}, m_scissor{}, m_scissor_original{}, m_viewport{}, m_p_queue_present{}, m_p_queue_graphics{}, m_p_queue_compute{},
+	m_p_queue_transfer{},
 #ifdef RMLUI_VK_DEBUG
 	m_debug_messenger{},
 #endif
@@ -96,13 +97,27 @@ Rml::CompiledGeometryHandle RenderInterface_VK::CompileGeometry(Rml::Span<const
 
 	memcpy(pCopyDataToBuffer, pData, sizeof(Rml::Vertex) * vertices.size());
 
-	status = m_memory_pool.Alloc_IndexBuffer((uint32_t)indices.size(), sizeof(int), reinterpret_cast<void**>(&pCopyDataToBuffer),
+	// Most meshes, such as text and boxes, have few enough vertices to be indexed with 16-bit indices, which halves the index data.
+	const bool use_16bit_indices = (vertices.size() <= 0x10000);
+	const uint32_t index_size = (use_16bit_indices ? sizeof(uint16_t) : sizeof(int));
+
+	status = m_memory_pool.Alloc_IndexBuffer((uint32_t)indices.size(), index_size, reinterpret_cast<void**>(&pCopyDataToBuffer),
 		&p_geometry_handle->m_p_index, &p_geometry_handle->m_p_index_allocation);
 	RMLUI_VK_ASSERTMSG(status, "failed to AllocIndexBuffer");
 
-	memcpy(pCopyDataToBuffer, indices.data(), sizeof(int) * indices.size());
+	if (use_16bit_indices)
+	{
+		uint16_t* p_indices = reinterpret_cast<uint16_t*>(pCopyDataToBuffer);
+		for (size_t i = 0; i < indices.size(); i++)
+			p_indices[i] = static_cast<uint16_t>(indices[i]);
+	}
+	else
+	{
+		memcpy(pCopyDataToBuffer, indices.data(), sizeof(int) * indices.size());
+	}
 
 	p_geometry_handle->m_num_indices = (int)indices.size();
+	p_geometry_handle->m_index_type = (use_16bit_indices ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
 
 	return Rml::CompiledGeometryHandle(p_geometry_handle);
 }
@@ -152,99 +167,72 @@ void RenderInterface_VK::RenderGeometry(Rml::CompiledGeometryHandle geometry, Rm
 		"you can't have here an invalid pointer of VkDescriptorSet. Two reason might be. 1. - you didn't allocate it "
 		"at all or 2. - Somehing is wrong with allocation and somehow it was corrupted by something.");
 
-	shader_vertex_user_data_t* p_data = nullptr;
-
-	if (p_casted_compiled_geometry->m_p_shader_allocation == nullptr)
-	{
-		// it means it was freed in ReleaseCompiledGeometry method
-		bool status = m_memory_pool.Alloc_GeneralBuffer(sizeof(m_user_data_for_vertex_shader), reinterpret_cast<void**>(&p_data),
-			&p_casted_compiled_geometry->m_p_shader, &p_casted_compiled_geometry->m_p_shader_allocation);
-		RMLUI_VK_ASSERTMSG(status, "failed to allocate VkDescriptorBufferInfo for uniform data to shaders");
-	}
-	else
+	// The uniform data usually changes with every draw, so it is placed in the ring of the active frame rather than being owned by the
+	// geometry. Thereby, data still being read by frames in flight is never overwritten. Consecutive draws with the same transform and
+	// translation, such as the layers of a text element, share the previously written data.
+	bound_state_t& bound = m_bound_state;
+	if (!bound.m_is_uniform_valid || bound.m_uniform_data.m_transform != m_user_data_for_vertex_shader.m_transform ||
+		bound.m_uniform_data.m_translate != m_user_data_for_vertex_shader.m_translate)
 	{
-		// it means our state is dirty and we need to update data, but it is not right in terms of architecture, for real better experience would
-		// be great to free all "compiled" geometries and "re-build" them in one general way, but here I got only three callings for
-		// font-face-layer textures (load_document example) and that shit. So better to think how to make it right, if it is fine okay, if it is
-		// not okay and like we really expect that ReleaseCompiledGeometry for all objects that needs to be rebuilt so better to implement that,
-		// but still it is a big architectural thing (or at least you need to do something big commits here to implement a such feature), so my
-		// implementation doesn't break anything what we had, but still it looks strange. If I get callings for releasing maybe I need to use it
-		// for all objects not separately????? Otherwise it is better to provide method for resizing (or some kind of "resizing" callback) for
-		// recalculating all geometry IDK, so it means you pass the existed geometry that wasn't pass to ReleaseCompiledGeometry, but from another
-		// hand you need to re-build compiled geometry again so we have two kinds of geometry one is compiled and never changes and one is dynamic
-		// and it goes through pipeline InitializationOfProgram...->Compile->Render->Release->Compile->Render->Release...
+		shader_vertex_user_data_t* p_data = nullptr;
+		VkDescriptorBufferInfo info_uniform = {};
 
-		m_memory_pool.Free_GeometryHandle_ShaderDataOnly(p_casted_compiled_geometry);
-		bool status = m_memory_pool.Alloc_GeneralBuffer(sizeof(m_user_data_for_vertex_shader), reinterpret_cast<void**>(&p_data),
-			&p_casted_compiled_geometry->m_p_shader, &p_casted_compiled_geometry->m_p_shader_allocation);
-		RMLUI_VK_ASSERTMSG(status, "failed to allocate VkDescriptorBufferInfo for uniform data to shaders");
-	}
+		bool status = m_memory_pool.Alloc_FrameUniformBuffer(sizeof(m_user_data_for_vertex_shader), reinterpret_cast<void**>(&p_data), &info_uniform);
+		RMLUI_VK_ASSERTMSG(status && p_data, "failed to allocate VkDescriptorBufferInfo for uniform data to shaders");
 
-	if (p_data)
-	{
 		p_data->m_transform = m_user_data_for_vertex_shader.m_transform;
 		p_data->m_translate = m_user_data_for_vertex_shader.m_translate;
-	}
-	else
-	{
-		RMLUI_VK_ASSERTMSG(p_data, "you can't reach this zone, it means something bad");
-	}
 
-	const uint32_t pDescriptorOffsets = static_cast<uint32_t>(p_casted_compiled_geometry->m_p_shader.offset);
+		const uint32_t pDescriptorOffsets = static_cast<uint32_t>(info_uniform.offset);
 
-	VkDescriptorSet p_texture_descriptor_set = nullptr;
+		// All pipelines share the same layout, thus the texture set bound at index 1 is left undisturbed.
+		vkCmdBindDescriptorSets(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_p_pipeline_layout, 0, 1, &p_current_descriptor_set,
+			1, &pDescriptorOffsets);
 
-	if (p_texture)
-	{
-		p_texture_descriptor_set = p_texture->m_p_vk_descriptor_set;
+		bound.m_uniform_data = m_user_data_for_vertex_shader;
+		bound.m_is_uniform_valid = true;
 	}
 
-	VkDescriptorSet p_sets[] = {p_current_descriptor_set, p_texture_descriptor_set};
-	int real_size_of_sets = 2;
-
-	if (p_texture == nullptr)
-		real_size_of_sets = 1;
-
-	vkCmdBindDescriptorSets(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_p_pipeline_layout, 0, real_size_of_sets, p_sets, 1,
-		&pDescriptorOffsets);
+	if (p_texture && p_texture->m_p_vk_descriptor_set != bound.m_p_texture_descriptor_set)
+	{
+		vkCmdBindDescriptorSets(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_p_pipeline_layout, 1, 1,
+			&p_texture->m_p_vk_descriptor_set, 0, nullptr);
+		bound.m_p_texture_descriptor_set = p_texture->m_p_vk_descriptor_set;
+	}
 
+	VkPipeline p_pipeline = nullptr;
 	if (m_is_use_stencil_pipeline)
 	{
-		vkCmdBindPipeline(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_p_pipeline_stencil_for_region_where_geometry_will_be_drawn);
+		p_pipeline = m_p_pipeline_stencil_for_region_where_geometry_will_be_drawn;
+	}
+	else if (p_texture)
+	{
+		p_pipeline = (m_is_apply_to_regular_geometry_stencil ? m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_with_textures
+															 : m_p_pipeline_with_textures);
 	}
 	else
 	{
-		if (p_texture)
-		{
-			if (m_is_apply_to_regular_geometry_stencil)
-			{
-				vkCmdBindPipeline(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-					m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_with_textures);
-			}
-			else
-			{
-				vkCmdBindPipeline(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_p_pipeline_with_textures);
-			}
-		}
-		else
-		{
-			if (m_is_apply_to_regular_geometry_stencil)
-			{
-				vkCmdBindPipeline(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-					m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_without_textures);
-			}
-			else
-			{
-				vkCmdBindPipeline(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_p_pipeline_without_textures);
-			}
-		}
+		p_pipeline = (m_is_apply_to_regular_geometry_stencil ? m_p_pipeline_stencil_for_regular_geometry_that_applied_to_region_without_textures
+															 : m_p_pipeline_without_textures);
 	}
 
-	vkCmdBindVertexBuffers(m_p_current_command_buffer, 0, 1, &p_casted_compiled_geometry->m_p_vertex.buffer,
-		&p_casted_compiled_geometry->m_p_vertex.offset);
+	if (p_pipeline != bound.m_p_pipeline)
+	{
+		vkCmdBindPipeline(m_p_current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, p_pipeline);
+		bound.m_p_pipeline = p_pipeline;
+	}
+
+	// Released geometry is only deleted once the frame has finished, so the handle can't be reused for other geometry within the frame.
+	if (p_casted_compiled_geometry != bound.m_p_geometry)
+	{
+		vkCmdBindVertexBuffers(m_p_current_command_buffer, 0, 1, &p_casted_compiled_geometry->m_p_vertex.buffer,
+			&p_casted_compiled_geometry->m_p_vertex.offset);
 
-	vkCmdBindIndexBuffer(m_p_current_command_buffer, p_casted_compiled_geometry->m_p_index.buffer, p_casted_compiled_geometry->m_p_index.offset,
-		VK_INDEX_TYPE_UINT32);
+		vkCmdBindIndexBuffer(m_p_current_command_buffer, p_casted_compiled_geometry->m_p_index.buffer,
+			p_casted_compiled_geometry->m_p_index.offset, p_casted_compiled_geometry->m_index_type);
+
+		bound.m_p_geometry = p_casted_compiled_geometry;
+	}
 
 	vkCmdDrawIndexed(m_p_current_command_buffer, p_casted_compiled_geometry->m_num_indices, 1, 0, 0, 0);
 }
@@ -255,7 +243,8 @@ void RenderInterface_VK::ReleaseGeometry(Rml::CompiledGeometryHandle geometry)
 
 	geometry_handle_t* p_casted_geometry = reinterpret_cast<geometry_handle_t*>(geometry);
 
-	m_pending_for_deletion_geometries.push_back(p_casted_geometry);
+	// The geometry may still be read by frames in flight, delete it once the current frame has finished executing.
+	m_pending_for_deletion_geometries_by_frames[m_semaphore_index].push_back(p_casted_geometry);
 }
 
 void RenderInterface_VK::EnableScissorRegion(bool enable)
@@ -377,6 +366,15 @@ struct TGAHeader {
 #pragma pack()
 
 Rml::TextureHandle RenderInterface_VK::LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source)
+{
+	Rml::Vector<Rml::byte> data;
+	if (!LoadTextureData(data, texture_dimensions, source))
+		return {};
+
+	return GenerateTexture(data, texture_dimensions);
+}
+
+bool RenderInterface_VK::LoadTextureData(Rml::Vector<Rml::byte>& out_data, Rml::Vector2i& out_dimensions, const Rml::String& source)
 {
 	Rml::FileInterface* file_interface = Rml::GetFileInterface();
 	Rml::FileHandle file_handle = file_interface->Open(source);
@@ -420,9 +418,15 @@ Rml::TextureHandle RenderInterface_VK::LoadTexture(Rml::Vector2i& texture_dimens
 		return false;
 	}
 
+	if (buffer_size < sizeof(TGAHeader) + size_t(header.width * header.height * color_mode))
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Texture file size is smaller than its image data, file is not a valid TGA image.");
+		return false;
+	}
+
 	const byte* image_src = buffer.get() + sizeof(TGAHeader);
-	Rml::UniquePtr<byte[]> image_dest_buffer(new byte[image_size]);
-	byte* image_dest = image_dest_buffer.get();
+	out_data.resize(image_size);
+	byte* image_dest = out_data.data();
 	const bool top_to_bottom_order = ((header.imageDescriptor & 32) != 0);
 
 	// Targa is BGR, swap to RGB, flip Y axis as necessary, and convert to premultiplied alpha.
@@ -450,10 +454,10 @@ Rml::TextureHandle RenderInterface_VK::LoadTexture(Rml::Vector2i& texture_dimens
 		}
 	}
 
-	texture_dimensions.x = header.width;
-	texture_dimensions.y = header.height;
+	out_dimensions.x = header.width;
+	out_dimensions.y = header.height;
 
-	return GenerateTexture({image_dest, image_size}, texture_dimensions);
+	return true;
 }
 
 Rml::TextureHandle RenderInterface_VK::GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions)
@@ -496,13 +500,6 @@ Rml::TextureHandle RenderInterface_VK::CreateTexture(Rml::Span<const Rml::byte>
 	VkDeviceSize image_size = source.size();
 	VkFormat format = VkFormat::VK_FORMAT_R8G8B8A8_UNORM;
 
-	buffer_data_t cpu_buffer = CreateResource_StagingBuffer(image_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
-
-	void* data;
-	vmaMapMemory(m_p_allocator, cpu_buffer.m_p_vma_allocation, &data);
-	memcpy(data, source.data(), static_cast<size_t>(image_size));
-	vmaUnmapMemory(m_p_allocator, cpu_buffer.m_p_vma_allocation);
-
 	VkExtent3D extent_image = {};
 	extent_image.width = static_cast<uint32_t>(width);
 	extent_image.height = static_cast<uint32_t>(height);
@@ -522,6 +519,15 @@ Rml::TextureHandle RenderInterface_VK::CreateTexture(Rml::Span<const Rml::byte>
 	info.tiling = VK_IMAGE_TILING_OPTIMAL;
 	info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 
+	// @ the image is written on the transfer queue and read on the graphics queue, sharing it between both avoids transferring its ownership
+	const uint32_t p_queue_family_indices[] = {m_queue_index_graphics, m_queue_index_transfer};
+	if (m_queue_index_transfer != m_queue_index_graphics)
+	{
+		info.sharingMode = VK_SHARING_MODE_CONCURRENT;
+		info.queueFamilyIndexCount = 2;
+		info.pQueueFamilyIndices = p_queue_family_indices;
+	}
+
 	VmaAllocationCreateInfo info_allocation = {};
 	info_allocation.usage = VMA_MEMORY_USAGE_GPU_ONLY;
 
@@ -556,8 +562,9 @@ Rml::TextureHandle RenderInterface_VK::CreateTexture(Rml::Span<const Rml::byte>
 	 * operations before they exeecute fully otherwise you will get some errors or write/read concurrent state and all other stuff, vulkan validation
 	 * will notify you :) (in most cases)
 	 *
-	 * BUT you need always sync what you have done when you called your vkQueueSubmit function, so it is wait method, but generally you can create
-	 * another queue and isolate all stuff tbh
+	 * BUT you need always sync what you have done when you called your vkQueueSubmit function. Here the uploads are recorded into one batch per
+	 * frame, which is submitted right before the frame, on a dedicated transfer queue if the device has one. The frame waits for the batch through
+	 * a semaphore, so neither the CPU nor the graphics queue stalls on each texture
 	 *
 	 * So understing these principles you understand how to work with API and your GPU
 	 *
@@ -572,7 +579,13 @@ Rml::TextureHandle RenderInterface_VK::CreateTexture(Rml::Span<const Rml::byte>
 	 * In our case we want to see in our pixel shader so we need to change transfer into this flag VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, because we
 	 * want to copy so it means some transfer thing, but after we say it goes to pixel after our copying operation
 	 */
-	m_upload_manager.UploadToGPU([p_image, extent_image, cpu_buffer](VkCommandBuffer p_cmd) {
+	VkCommandBuffer p_cmd = BeginUpload();
+	const UploadResourceManager::staging_region_t staging = m_upload_manager.Stage(source.data(), image_size);
+
+	// @ a dedicated transfer queue doesn't support the fragment shader stage, then the semaphore of the upload makes the image visible instead
+	const bool is_graphics_queue = m_upload_manager.IsGraphicsQueue();
+
+	{
 		VkImageSubresourceRange range = {};
 		range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
 		range.baseMipLevel = 0;
@@ -592,7 +605,7 @@ Rml::TextureHandle RenderInterface_VK::CreateTexture(Rml::Span<const Rml::byte>
 		vkCmdPipelineBarrier(p_cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &info_barrier);
 
 		VkBufferImageCopy region = {};
-		region.bufferOffset = 0;
+		region.bufferOffset = staging.m_offset;
 		region.bufferRowLength = 0;
 		region.bufferImageHeight = 0;
 
@@ -602,7 +615,7 @@ Rml::TextureHandle RenderInterface_VK::CreateTexture(Rml::Span<const Rml::byte>
 		region.imageSubresource.layerCount = 1;
 		region.imageExtent = extent_image;
 
-		vkCmdCopyBufferToImage(p_cmd, cpu_buffer.m_p_vk_buffer, p_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+		vkCmdCopyBufferToImage(p_cmd, staging.m_p_vk_buffer, p_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 
 		VkImageMemoryBarrier info_barrier_shader_read = {};
 		info_barrier_shader_read.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -612,13 +625,14 @@ Rml::TextureHandle RenderInterface_VK::CreateTexture(Rml::Span<const Rml::byte>
 		info_barrier_shader_read.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
 		info_barrier_shader_read.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 		info_barrier_shader_read.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		info_barrier_shader_read.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		info_barrier_shader_read.dstAccessMask = is_graphics_queue ? VK_ACCESS_SHADER_READ_BIT : 0;
 
-		vkCmdPipelineBarrier(p_cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1,
+		vkCmdPipelineBarrier(p_cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+			is_graphics_queue ? VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1,
 			&info_barrier_shader_read);
-	});
+	}
 
-	DestroyResource_StagingBuffer(cpu_buffer);
+	m_textures_pending_upload.push_back(p_texture);
 
 	VkImageViewCreateInfo info_image_view = {};
 	info_image_view.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -648,7 +662,17 @@ void RenderInterface_VK::ReleaseTexture(Rml::TextureHandle texture_handle)
 
 	if (p_texture)
 	{
-		m_pending_for_deletion_textures_by_frames[m_semaphore_index_previous].push_back(p_texture);
+		// The upload batch referencing the texture may not have been submitted yet, then it must outlive the frame submitting the batch.
+		auto it = std::find(m_textures_pending_upload.begin(), m_textures_pending_upload.end(), p_texture);
+		if (it != m_textures_pending_upload.end())
+		{
+			m_textures_pending_upload.erase(it);
+			m_textures_released_before_upload.push_back(p_texture);
+		}
+		else
+		{
+			m_pending_for_deletion_textures_by_frames[m_semaphore_index].push_back(p_texture);
+		}
 	}
 }
 
@@ -663,10 +687,12 @@ void RenderInterface_VK::BeginFrame()
 	Wait();
 
 	Update_PendingForDeletion_Textures_By_Frames();
-	Update_PendingForDeletion_Geometries();
+	Update_PendingForDeletion_Geometries_By_Frames();
 
+	m_memory_pool.OnBeginFrame(m_semaphore_index);
 	m_command_buffer_ring.OnBeginFrame();
 	m_p_current_command_buffer = m_command_buffer_ring.GetCommandBufferForActiveFrame(CommandBufferName::Primary);
+	m_bound_state = {};
 
 	VkCommandBufferBeginInfo info = {};
 
@@ -868,19 +894,23 @@ void RenderInterface_VK::Initialize_Device() noexcept
 
 	float queue_priorities[1] = {0.0f};
 
-	VkDeviceQueueCreateInfo info_queue[2] = {};
+	VkDeviceQueueCreateInfo info_queue[3] = {};
+	uint32_t queue_count = 0;
 
-	info_queue[0].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-	info_queue[0].pNext = nullptr;
-	info_queue[0].queueCount = 1;
-	info_queue[0].pQueuePriorities = queue_priorities;
-	info_queue[0].queueFamilyIndex = m_queue_index_graphics;
+	for (uint32_t queue_family_index : {m_queue_index_graphics, m_queue_index_compute, m_queue_index_transfer})
+	{
+		const bool is_created = std::any_of(info_queue, info_queue + queue_count,
+			[&](const VkDeviceQueueCreateInfo& info) { return info.queueFamilyIndex == queue_family_index; });
+		if (is_created || queue_family_index == uint32_t(-1))
+			continue;
 
-	info_queue[1].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-	info_queue[1].pNext = nullptr;
-	info_queue[1].queueCount = 1;
-	info_queue[1].pQueuePriorities = queue_priorities;
-	info_queue[1].queueFamilyIndex = m_queue_index_compute;
+		info_queue[queue_count].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+		info_queue[queue_count].pNext = nullptr;
+		info_queue[queue_count].queueCount = 1;
+		info_queue[queue_count].pQueuePriorities = queue_priorities;
+		info_queue[queue_count].queueFamilyIndex = queue_family_index;
+		queue_count += 1;
+	}
 
 	VkPhysicalDeviceFeatures features_physical_device = {};
 
@@ -907,7 +937,7 @@ void RenderInterface_VK::Initialize_Device() noexcept
 
 	info_device.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 	info_device.pNext = &features_physical_device2;
-	info_device.queueCreateInfoCount = m_queue_index_compute != m_queue_index_graphics ? 2 : 1;
+	info_device.queueCreateInfoCount = queue_count;
 	info_device.pQueueCreateInfos = info_queue;
 	info_device.enabledExtensionCount = static_cast<uint32_t>(device_extension_names.size());
 	info_device.ppEnabledExtensionNames = info_device.enabledExtensionCount ? device_extension_names.data() : nullptr;
@@ -1076,9 +1106,23 @@ void RenderInterface_VK::Initialize_QueueIndecies() noexcept
 		}
 	}
 
+	// A queue family which supports transfers only is usually a dedicated copy engine, uploads on it run alongside the rendering.
+	m_queue_index_transfer = m_queue_index_graphics;
+
+	for (uint32_t i = 0; i < queue_family_count; ++i)
+	{
+		const VkQueueFlags flags = queue_props[i].queueFlags;
+
+		if ((flags & VK_QUEUE_TRANSFER_BIT) != 0 && (flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0)
+		{
+			m_queue_index_transfer = i;
+			break;
+		}
+	}
+
 #ifdef RMLUI_VK_DEBUG
-	Rml::Log::Message(Rml::Log::LT_DEBUG, "[Vulkan] User family queues indecies: Graphics[%d] Present[%d] Compute[%d]", m_queue_index_graphics,
-		m_queue_index_present, m_queue_index_compute);
+	Rml::Log::Message(Rml::Log::LT_DEBUG, "[Vulkan] User family queues indecies: Graphics[%d] Present[%d] Compute[%d] Transfer[%d]",
+		m_queue_index_graphics, m_queue_index_present, m_queue_index_compute, m_queue_index_transfer);
 #endif
 }
 
@@ -1103,6 +1147,15 @@ void RenderInterface_VK::Initialize_Queues() noexcept
 	{
 		vkGetDeviceQueue(m_p_device, m_queue_index_compute, 0, &m_p_queue_compute);
 	}
+
+	if (m_queue_index_transfer == m_queue_index_graphics)
+	{
+		m_p_queue_transfer = m_p_queue_graphics;
+	}
+	else
+	{
+		vkGetDeviceQueue(m_p_device, m_queue_index_transfer, 0, &m_p_queue_transfer);
+	}
 }
 
 void RenderInterface_VK::Initialize_SyncPrimitives() noexcept
@@ -1148,9 +1201,12 @@ void RenderInterface_VK::Initialize_Resources(const VkPhysicalDeviceProperties&
 	m_command_buffer_ring.Initialize(m_p_device, m_queue_index_graphics);
 
 	const VkDeviceSize min_buffer_alignment = physical_device_properties.limits.minUniformBufferOffsetAlignment;
-	m_memory_pool.Initialize(kVideoMemoryForAllocation, min_buffer_alignment, m_p_allocator, m_p_device);
+	m_memory_pool.Initialize(kVideoMemoryForAllocation, kVideoMemoryForUniformsPerFrame, min_buffer_alignment, m_p_allocator, m_p_device);
 
-	m_upload_manager.Initialize(m_p_device, m_p_queue_graphics, m_queue_index_graphics);
+	// Staged texels must be aligned to the texel size of four bytes, and preferably to the optimal offset of the device.
+	const VkDeviceSize staging_alignment = Rml::Math::Max(physical_device_properties.limits.optimalBufferCopyOffsetAlignment, VkDeviceSize(16));
+	m_upload_manager.Initialize(m_p_device, m_p_allocator, m_p_queue_transfer, m_queue_index_transfer,
+		m_queue_index_transfer == m_queue_index_graphics, staging_alignment);
 	m_manager_descriptors.Initialize(m_p_device, 100, 100, 10, 10);
 
 	CreateShaders();
@@ -1228,6 +1284,12 @@ void RenderInterface_VK::Destroy_Resources() noexcept
 	m_command_buffer_ring.Shutdown();
 	m_upload_manager.Shutdown();
 
+	// The device is idle, any textures waiting for an unsubmitted upload can be destroyed with the rest.
+	m_pending_for_deletion_textures_by_frames[m_semaphore_index].insert(m_pending_for_deletion_textures_by_frames[m_semaphore_index].end(),
+		m_textures_released_before_upload.begin(), m_textures_released_before_upload.end());
+	m_textures_released_before_upload.clear();
+	m_textures_pending_upload.clear();
+
 	if (m_p_descriptor_set)
 	{
 		m_manager_descriptors.Free_Descriptors(m_p_device, &m_p_descriptor_set);
@@ -2339,46 +2401,6 @@ void RenderInterface_VK::CreateResourcesDependentOnSize(const VkExtent2D& real_r
 	Create_Pipelines();
 }
 
-RenderInterface_VK::buffer_data_t RenderInterface_VK::CreateResource_StagingBuffer(VkDeviceSize size, VkBufferUsageFlags flags) noexcept
-{
-	VkBufferCreateInfo info = {};
-	info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-	info.pNext = nullptr;
-	info.size = size;
-	info.usage = flags;
-
-	VmaAllocationCreateInfo info_allocation = {};
-	info_allocation.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-
-	VkBuffer p_buffer = nullptr;
-	VmaAllocation p_allocation = nullptr;
-	VmaAllocationInfo info_stats = {};
-
-	VkResult status = vmaCreateBuffer(m_p_allocator, &info, &info_allocation, &p_buffer, &p_allocation, &info_stats);
-	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vmaCreateBuffer");
-
-#ifdef RMLUI_VK_DEBUG
-	Rml::Log::Message(Rml::Log::LT_DEBUG, "Allocated buffer [%s]", FormatByteSize(info_stats.size).c_str());
-#endif
-
-	buffer_data_t result = {};
-	result.m_p_vk_buffer = p_buffer;
-	result.m_p_vma_allocation = p_allocation;
-
-	return result;
-}
-
-void RenderInterface_VK::DestroyResource_StagingBuffer(const buffer_data_t& data) noexcept
-{
-	if (m_p_allocator)
-	{
-		if (data.m_p_vk_buffer && data.m_p_vma_allocation)
-		{
-			vmaDestroyBuffer(m_p_allocator, data.m_p_vk_buffer, data.m_p_vma_allocation);
-		}
-	}
-}
-
 void RenderInterface_VK::Destroy_Textures() noexcept
 {
 	for (auto& textures : m_pending_for_deletion_textures_by_frames)
@@ -2395,7 +2417,17 @@ void RenderInterface_VK::Destroy_Textures() noexcept
 
 void RenderInterface_VK::Destroy_Geometries() noexcept
 {
-	Update_PendingForDeletion_Geometries();
+	for (auto& geometries : m_pending_for_deletion_geometries_by_frames)
+	{
+		for (geometry_handle_t* p_geometry_handle : geometries)
+		{
+			m_memory_pool.Free_GeometryHandle(p_geometry_handle);
+			delete p_geometry_handle;
+		}
+
+		geometries.clear();
+	}
+
 	m_memory_pool.Shutdown();
 }
 
@@ -2578,60 +2610,91 @@ void RenderInterface_VK::Wait() noexcept
 
 	constexpr uint64_t kMaxUint64 = std::numeric_limits<uint64_t>::max();
 
-	auto status =
-		vkAcquireNextImageKHR(m_p_device, m_p_swapchain, kMaxUint64, m_semaphores_image_available[m_semaphore_index], nullptr, &m_image_index);
-	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkAcquireNextImageKHR (see status)");
-
-	m_semaphore_index_previous = m_semaphore_index;
 	m_semaphore_index = ((m_semaphore_index + 1) % kSwapchainBackBufferCount);
 
-	status = vkWaitForFences(m_p_device, 1, &m_executed_fences[m_semaphore_index_previous], VK_TRUE, kMaxUint64);
+	// Only wait for the frame which last used this slot, kSwapchainBackBufferCount frames ago, so that the following frames may still be
+	// executing. Afterwards, the command buffers, semaphores, uniform data, and pending resources of this slot can be reused.
+	auto status = vkWaitForFences(m_p_device, 1, &m_executed_fences[m_semaphore_index], VK_TRUE, kMaxUint64);
 	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkWaitForFences (see status)");
 
-	status = vkResetFences(m_p_device, 1, &m_executed_fences[m_semaphore_index_previous]);
+	status =
+		vkAcquireNextImageKHR(m_p_device, m_p_swapchain, kMaxUint64, m_semaphores_image_available[m_semaphore_index], nullptr, &m_image_index);
+	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkAcquireNextImageKHR (see status)");
+
+	status = vkResetFences(m_p_device, 1, &m_executed_fences[m_semaphore_index]);
 	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkResetFences (see status)");
 }
 
 void RenderInterface_VK::Update_PendingForDeletion_Textures_By_Frames() noexcept
 {
-	auto& textures_for_previous_frame = m_pending_for_deletion_textures_by_frames[m_semaphore_index_previous];
+	auto& textures_for_finished_frame = m_pending_for_deletion_textures_by_frames[m_semaphore_index];
 
-	for (texture_data_t* p_data : textures_for_previous_frame)
+	for (texture_data_t* p_data : textures_for_finished_frame)
 	{
 		Destroy_Texture(*p_data);
 		delete p_data;
 	}
 
-	textures_for_previous_frame.clear();
+	textures_for_finished_frame.clear();
 }
 
-void RenderInterface_VK::Update_PendingForDeletion_Geometries() noexcept
+void RenderInterface_VK::Update_PendingForDeletion_Geometries_By_Frames() noexcept
 {
-	for (geometry_handle_t* p_geometry_handle : m_pending_for_deletion_geometries)
+	auto& geometries_for_finished_frame = m_pending_for_deletion_geometries_by_frames[m_semaphore_index];
+
+	for (geometry_handle_t* p_geometry_handle : geometries_for_finished_frame)
 	{
 		m_memory_pool.Free_GeometryHandle(p_geometry_handle);
 		delete p_geometry_handle;
 	}
 
-	m_pending_for_deletion_geometries.clear();
+	geometries_for_finished_frame.clear();
+}
+
+VkCommandBuffer RenderInterface_VK::BeginUpload() noexcept
+{
+	uint32_t frame_index = m_semaphore_index;
+
+	// Uploads made between frames are submitted with the next frame, which reuses the slot of an earlier frame. Wait for that frame here,
+	// like at the beginning of the next frame, before reusing the upload resources of the slot.
+	if (!m_upload_manager.IsRecording() && !m_p_current_command_buffer)
+	{
+		constexpr uint64_t kMaxUint64 = std::numeric_limits<uint64_t>::max();
+
+		frame_index = ((m_semaphore_index + 1) % kSwapchainBackBufferCount);
+
+		auto status = vkWaitForFences(m_p_device, 1, &m_executed_fences[frame_index], VK_TRUE, kMaxUint64);
+		RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkWaitForFences (see status)");
+	}
+
+	return m_upload_manager.Begin(frame_index);
 }
 
 void RenderInterface_VK::Submit() noexcept
 {
-	const VkSemaphore p_semaphores_wait[] = {m_semaphores_image_available[m_semaphore_index_previous]};
+	// Submit the uploads of this frame first, the frame waits for them before reading any textures.
+	const VkSemaphore p_semaphore_upload = m_upload_manager.Submit();
+
+	// Textures released before their upload was submitted are destroyed once this frame has been executed.
+	auto& textures_for_frame = m_pending_for_deletion_textures_by_frames[m_semaphore_index];
+	textures_for_frame.insert(textures_for_frame.end(), m_textures_released_before_upload.begin(), m_textures_released_before_upload.end());
+	m_textures_released_before_upload.clear();
+	m_textures_pending_upload.clear();
+
+	const VkSemaphore p_semaphores_wait[] = {m_semaphores_image_available[m_semaphore_index], p_semaphore_upload};
 	const VkSemaphore p_semaphores_signal[] = {m_semaphores_finished_render[m_semaphore_index]};
 
 	VkFence p_fence = m_executed_fences[m_semaphore_index];
 
-	VkPipelineStageFlags submit_wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	const VkPipelineStageFlags p_submit_wait_stages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT};
 
 	VkSubmitInfo info = {};
 
 	info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 	info.pNext = nullptr;
-	info.waitSemaphoreCount = 1;
+	info.waitSemaphoreCount = p_semaphore_upload ? 2 : 1;
 	info.pWaitSemaphores = p_semaphores_wait;
-	info.pWaitDstStageMask = &submit_wait_stage;
+	info.pWaitDstStageMask = p_submit_wait_stages;
 	info.signalSemaphoreCount = 1;
 	info.pSignalSemaphores = p_semaphores_signal;
 	info.commandBufferCount = 1;
@@ -2691,6 +2754,193 @@ VkFormat RenderInterface_VK::Get_SupportedDepthFormat()
 	return VkFormat::VK_FORMAT_UNDEFINED;
 }
 
+void RenderInterface_VK::UploadResourceManager::Initialize(VkDevice p_device, VmaAllocator p_allocator, VkQueue p_queue,
+	uint32_t queue_family_index, bool is_graphics_queue, VkDeviceSize staging_alignment) noexcept
+{
+	RMLUI_VK_ASSERTMSG(p_queue, "you have to pass a valid VkQueue");
+	RMLUI_VK_ASSERTMSG(p_device, "you have to pass a valid VkDevice for creation resources");
+	RMLUI_VK_ASSERTMSG(p_allocator, "you have to pass a valid VmaAllocator for the staging memory");
+
+	m_p_device = p_device;
+	m_p_allocator = p_allocator;
+	m_p_queue = p_queue;
+	m_is_graphics_queue = is_graphics_queue;
+	m_staging_alignment = staging_alignment;
+	m_p_recording_batch = nullptr;
+
+	for (batch_t& batch : m_batches)
+	{
+		batch = {};
+
+		VkCommandPoolCreateInfo info_pool = {};
+		info_pool.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		info_pool.pNext = nullptr;
+		info_pool.queueFamilyIndex = queue_family_index;
+		info_pool.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+		VkResult status = vkCreateCommandPool(m_p_device, &info_pool, nullptr, &batch.m_p_command_pool);
+		RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkCreateCommandPool");
+
+		VkCommandBufferAllocateInfo info_buffer = {};
+		info_buffer.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		info_buffer.pNext = nullptr;
+		info_buffer.commandPool = batch.m_p_command_pool;
+		info_buffer.commandBufferCount = 1;
+		info_buffer.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+
+		status = vkAllocateCommandBuffers(m_p_device, &info_buffer, &batch.m_p_command_buffer);
+		RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkAllocateCommandBuffers");
+
+		VkSemaphoreCreateInfo info_semaphore = {};
+		info_semaphore.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		info_semaphore.pNext = nullptr;
+		info_semaphore.flags = 0;
+
+		status = vkCreateSemaphore(m_p_device, &info_semaphore, nullptr, &batch.m_p_semaphore);
+		RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkCreateSemaphore");
+	}
+}
+
+void RenderInterface_VK::UploadResourceManager::Shutdown() noexcept
+{
+	for (batch_t& batch : m_batches)
+	{
+		Destroy_StagingBuffer(batch.m_staging);
+		for (staging_buffer_t& buffer : batch.m_outgrown_staging)
+			Destroy_StagingBuffer(buffer);
+
+		vkDestroySemaphore(m_p_device, batch.m_p_semaphore, nullptr);
+		vkDestroyCommandPool(m_p_device, batch.m_p_command_pool, nullptr);
+		batch = {};
+	}
+
+	m_p_recording_batch = nullptr;
+}
+
+VkCommandBuffer RenderInterface_VK::UploadResourceManager::Begin(uint32_t frame_index) noexcept
+{
+	if (m_p_recording_batch)
+		return m_p_recording_batch->m_p_command_buffer;
+
+	RMLUI_VK_ASSERTMSG(frame_index < kSwapchainBackBufferCount, "invalid frame index");
+	batch_t& batch = m_batches[frame_index];
+
+	vkResetCommandPool(m_p_device, batch.m_p_command_pool, 0);
+
+	for (staging_buffer_t& buffer : batch.m_outgrown_staging)
+		Destroy_StagingBuffer(buffer);
+	batch.m_outgrown_staging.clear();
+	batch.m_staging_offset = 0;
+
+	VkCommandBufferBeginInfo info = {};
+	info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	info.pNext = nullptr;
+	info.pInheritanceInfo = nullptr;
+	info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+	VkResult status = vkBeginCommandBuffer(batch.m_p_command_buffer, &info);
+	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkBeginCommandBuffer");
+
+	m_p_recording_batch = &batch;
+	return batch.m_p_command_buffer;
+}
+
+RenderInterface_VK::UploadResourceManager::staging_region_t RenderInterface_VK::UploadResourceManager::Stage(const void* p_data,
+	VkDeviceSize size) noexcept
+{
+	RMLUI_VK_ASSERTMSG(m_p_recording_batch, "you must begin the upload batch before staging data");
+	batch_t& batch = *m_p_recording_batch;
+
+	VkDeviceSize offset = (batch.m_staging_offset + m_staging_alignment - 1) / m_staging_alignment * m_staging_alignment;
+
+	if (!batch.m_staging.m_p_vk_buffer || offset + size > batch.m_staging.m_capacity)
+	{
+		// The copies recorded so far still read from the outgrown buffer, keep it until the batch has been executed. The slot keeps the
+		// larger buffer from now on, so that the ring settles at the largest amount of uploads made in a single frame.
+		if (batch.m_staging.m_p_vk_buffer)
+			batch.m_outgrown_staging.push_back(batch.m_staging);
+
+		const VkDeviceSize capacity = Rml::Math::Max(Rml::Math::Max(batch.m_staging.m_capacity * 2, size), kStagingMemoryForUploadsPerFrame);
+		batch.m_staging = Create_StagingBuffer(capacity);
+		offset = 0;
+	}
+
+	memcpy(static_cast<unsigned char*>(batch.m_staging.m_p_data) + offset, p_data, static_cast<size_t>(size));
+	batch.m_staging_offset = offset + size;
+
+	return staging_region_t{batch.m_staging.m_p_vk_buffer, offset};
+}
+
+VkSemaphore RenderInterface_VK::UploadResourceManager::Submit() noexcept
+{
+	if (!m_p_recording_batch)
+		return nullptr;
+
+	batch_t& batch = *m_p_recording_batch;
+	m_p_recording_batch = nullptr;
+
+	// Non-coherent staging memory must be flushed before the device reads it.
+	vmaFlushAllocation(m_p_allocator, batch.m_staging.m_p_vma_allocation, 0, VK_WHOLE_SIZE);
+	for (const staging_buffer_t& buffer : batch.m_outgrown_staging)
+		vmaFlushAllocation(m_p_allocator, buffer.m_p_vma_allocation, 0, VK_WHOLE_SIZE);
+
+	VkResult status = vkEndCommandBuffer(batch.m_p_command_buffer);
+	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkEndCommandBuffer");
+
+	VkSubmitInfo info = {};
+	info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	info.pNext = nullptr;
+	info.waitSemaphoreCount = 0;
+	info.pWaitSemaphores = nullptr;
+	info.pWaitDstStageMask = nullptr;
+	info.signalSemaphoreCount = 1;
+	info.pSignalSemaphores = &batch.m_p_semaphore;
+	info.commandBufferCount = 1;
+	info.pCommandBuffers = &batch.m_p_command_buffer;
+
+	status = vkQueueSubmit(m_p_queue, 1, &info, nullptr);
+	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkQueueSubmit");
+
+	return batch.m_p_semaphore;
+}
+
+RenderInterface_VK::UploadResourceManager::staging_buffer_t RenderInterface_VK::UploadResourceManager::Create_StagingBuffer(
+	VkDeviceSize size) noexcept
+{
+	VkBufferCreateInfo info = {};
+	info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	info.pNext = nullptr;
+	info.size = size;
+	info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+	VmaAllocationCreateInfo info_allocation = {};
+	info_allocation.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+	info_allocation.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+	staging_buffer_t result = {};
+	VmaAllocationInfo info_stats = {};
+
+	VkResult status = vmaCreateBuffer(m_p_allocator, &info, &info_allocation, &result.m_p_vk_buffer, &result.m_p_vma_allocation, &info_stats);
+	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vmaCreateBuffer");
+
+#ifdef RMLUI_VK_DEBUG
+	Rml::Log::Message(Rml::Log::LT_DEBUG, "Allocated staging buffer for uploads [%s]", FormatByteSize(info_stats.size).c_str());
+#endif
+
+	result.m_p_data = info_stats.pMappedData;
+	result.m_capacity = size;
+
+	return result;
+}
+
+void RenderInterface_VK::UploadResourceManager::Destroy_StagingBuffer(staging_buffer_t& buffer) noexcept
+{
+	if (buffer.m_p_vk_buffer && buffer.m_p_vma_allocation)
+		vmaDestroyBuffer(m_p_allocator, buffer.m_p_vk_buffer, buffer.m_p_vma_allocation);
+
+	buffer = {};
+}
+
 RenderInterface_VK::CommandBufferRing::CommandBufferRing() : m_p_device{}, m_frame_index{}, m_p_current_frame{}, m_frames{} {}
 
 void RenderInterface_VK::CommandBufferRing::Initialize(VkDevice p_device, uint32_t queue_index_graphics) noexcept
@@ -2777,16 +3027,17 @@ VkCommandBuffer RenderInterface_VK::CommandBufferRing::GetCommandBufferForActive
 }
 
 RenderInterface_VK::MemoryPool::MemoryPool() :
-	m_memory_total_size{}, m_device_min_uniform_alignment{}, m_p_data{}, m_p_buffer{}, m_p_buffer_alloc{}, m_p_device{}, m_p_vk_allocator{},
-	m_p_block{}
+	m_frame_uniforms{}, m_p_current_frame_uniforms{}, m_frame_uniform_size{}, m_memory_total_size{}, m_device_min_uniform_alignment{}, m_p_data{},
+	m_p_buffer{}, m_p_buffer_alloc{}, m_p_device{}, m_p_vk_allocator{}, m_p_block{}
 {}
 
 RenderInterface_VK::MemoryPool::~MemoryPool() {}
 
-void RenderInterface_VK::MemoryPool::Initialize(VkDeviceSize byte_size, VkDeviceSize device_min_uniform_alignment, VmaAllocator p_allocator,
-	VkDevice p_device) noexcept
+void RenderInterface_VK::MemoryPool::Initialize(VkDeviceSize byte_size, VkDeviceSize frame_uniform_byte_size,
+	VkDeviceSize device_min_uniform_alignment, VmaAllocator p_allocator, VkDevice p_device) noexcept
 {
 	RMLUI_VK_ASSERTMSG(byte_size > 0, "size must be valid");
+	RMLUI_VK_ASSERTMSG(frame_uniform_byte_size > 0, "size must be valid");
 	RMLUI_VK_ASSERTMSG(device_min_uniform_alignment > 0, "uniform alignment must be valid");
 	RMLUI_VK_ASSERTMSG(p_device, "you must pass a valid VkDevice");
 	RMLUI_VK_ASSERTMSG(p_allocator, "you must pass a valid VmaAllocator");
@@ -2799,7 +3050,9 @@ void RenderInterface_VK::MemoryPool::Initialize(VkDeviceSize byte_size, VkDevice
 	Rml::Log::Message(Rml::Log::LT_DEBUG, "[Vulkan][Debug] the alignment for uniform buffer is: %zu", m_device_min_uniform_alignment);
 #endif
 
-	m_memory_total_size = AlignUp<VkDeviceSize>(static_cast<VkDeviceSize>(byte_size), m_device_min_uniform_alignment);
+	m_frame_uniform_size = AlignUp<VkDeviceSize>(frame_uniform_byte_size, m_device_min_uniform_alignment);
+	m_memory_total_size = AlignUp<VkDeviceSize>(static_cast<VkDeviceSize>(byte_size), m_device_min_uniform_alignment) +
+		m_frame_uniform_size * kSwapchainBackBufferCount;
 
 	VkBufferCreateInfo info = {};
 	info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -2834,6 +3087,20 @@ void RenderInterface_VK::MemoryPool::Initialize(VkDeviceSize byte_size, VkDevice
 	status = vmaMapMemory(m_p_vk_allocator, m_p_buffer_alloc, (void**)&m_p_data);
 
 	RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vmaMapMemory");
+
+	// The buffer stays mapped for its whole lifetime, thus writing the uniform rings never requires any synchronization with the queue.
+	for (frame_uniforms_t& frame : m_frame_uniforms)
+	{
+		VmaVirtualAllocationCreateInfo info_frame = {};
+		info_frame.size = m_frame_uniform_size;
+		info_frame.alignment = m_device_min_uniform_alignment;
+
+		status = vmaVirtualAllocate(m_p_block, &info_frame, &frame.m_p_allocation, &frame.m_offset);
+
+		RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vmaVirtualAllocate uniform ring of frame");
+	}
+
+	m_p_current_frame_uniforms = &m_frame_uniforms[0];
 }
 
 void RenderInterface_VK::MemoryPool::Shutdown() noexcept
@@ -2846,6 +3113,14 @@ void RenderInterface_VK::MemoryPool::Shutdown() noexcept
 	Rml::Log::Message(Rml::Log::LT_DEBUG, "[Vulkan][Debug] Destroyed memory pool [%s]", FormatByteSize(m_memory_total_size).c_str());
 #endif
 
+	for (frame_uniforms_t& frame : m_frame_uniforms)
+	{
+		Free_FrameUniforms(frame);
+		vmaVirtualFree(m_p_block, frame.m_p_allocation);
+		frame = {};
+	}
+	m_p_current_frame_uniforms = nullptr;
+
 	vmaUnmapMemory(m_p_vk_allocator, m_p_buffer_alloc);
 	vmaDestroyVirtualBlock(m_p_block);
 	vmaDestroyBuffer(m_p_vk_allocator, m_p_buffer, m_p_buffer_alloc);
@@ -2882,6 +3157,54 @@ bool RenderInterface_VK::MemoryPool::Alloc_GeneralBuffer(VkDeviceSize size, void
 	return true;
 }
 
+bool RenderInterface_VK::MemoryPool::Alloc_FrameUniformBuffer(VkDeviceSize size, void** p_data, VkDescriptorBufferInfo* p_out) noexcept
+{
+	RMLUI_VK_ASSERTMSG(p_out, "you must pass a valid pointer");
+	RMLUI_VK_ASSERTMSG(m_p_current_frame_uniforms, "you must initialize the memory pool before allocating frame data");
+
+	frame_uniforms_t& frame = *m_p_current_frame_uniforms;
+	size = AlignUp<VkDeviceSize>(static_cast<VkDeviceSize>(size), m_device_min_uniform_alignment);
+
+	if (frame.m_used_size + size > m_frame_uniform_size)
+	{
+		// The ring is exhausted for this frame, keep the allocation around until the frame comes around again.
+		VmaVirtualAllocation p_alloc = nullptr;
+		if (!Alloc_GeneralBuffer(size, p_data, p_out, &p_alloc))
+			return false;
+
+		frame.m_overflow_allocations.push_back(p_alloc);
+		return true;
+	}
+
+	const VkDeviceSize offset_memory = frame.m_offset + frame.m_used_size;
+	frame.m_used_size += size;
+
+	*p_data = (void*)(m_p_data + offset_memory);
+
+	p_out->buffer = m_p_buffer;
+	p_out->offset = offset_memory;
+	p_out->range = size;
+
+	return true;
+}
+
+void RenderInterface_VK::MemoryPool::OnBeginFrame(uint32_t frame_index) noexcept
+{
+	RMLUI_VK_ASSERTMSG(frame_index < kSwapchainBackBufferCount, "frame index is out of range");
+
+	m_p_current_frame_uniforms = &m_frame_uniforms[frame_index];
+	Free_FrameUniforms(*m_p_current_frame_uniforms);
+}
+
+void RenderInterface_VK::MemoryPool::Free_FrameUniforms(frame_uniforms_t& frame) noexcept
+{
+	for (VmaVirtualAllocation p_alloc : frame.m_overflow_allocations)
+		vmaVirtualFree(m_p_block, p_alloc);
+
+	frame.m_overflow_allocations.clear();
+	frame.m_used_size = 0;
+}
+
 bool RenderInterface_VK::MemoryPool::Alloc_VertexBuffer(uint32_t number_of_elements, uint32_t stride_in_bytes, void** p_data,
 	VkDescriptorBufferInfo* p_out, VmaVirtualAllocation* p_alloc) noexcept
 {
@@ -2978,40 +3301,16 @@ void RenderInterface_VK::MemoryPool::Free_GeometryHandle(geometry_handle_t* p_va
 		"you must pass a VALID pointer to geometry_handle_t, otherwise something is wrong and debug your code");
 	RMLUI_VK_ASSERTMSG(p_valid_geometry_handle->m_p_vertex_allocation, "you must have a VALID pointer of VmaAllocation for vertex buffer");
 	RMLUI_VK_ASSERTMSG(p_valid_geometry_handle->m_p_index_allocation, "you must have a VALID pointer of VmaAllocation for index buffer");
-
-	// TODO: The following assertion is disabled for now. The shader allocation pointer is only set once the geometry
-	// handle is rendered with. However, currently the Vulkan renderer does not handle all draw calls from RmlUi, so
-	// this pointer may never be set if the geometry was only used in a unsupported draw calls. This can then trigger
-	// the following assertion. The free call below gracefully handles zero pointers so this should be safe regardless.
-	// RMLUI_VK_ASSERTMSG(p_valid_geometry_handle->m_p_shader_allocation,
-	//		"you must have a VALID pointer of VmaAllocation for shader operations (like uniforms and etc)");
-
 	RMLUI_VK_ASSERTMSG(m_p_block, "you have to allocate the virtual block before do this operation...");
 
 	vmaVirtualFree(m_p_block, p_valid_geometry_handle->m_p_vertex_allocation);
 	vmaVirtualFree(m_p_block, p_valid_geometry_handle->m_p_index_allocation);
-	vmaVirtualFree(m_p_block, p_valid_geometry_handle->m_p_shader_allocation);
 
 	p_valid_geometry_handle->m_p_vertex_allocation = nullptr;
-	p_valid_geometry_handle->m_p_shader_allocation = nullptr;
 	p_valid_geometry_handle->m_p_index_allocation = nullptr;
 	p_valid_geometry_handle->m_num_indices = 0;
 }
 
-void RenderInterface_VK::MemoryPool::Free_GeometryHandle_ShaderDataOnly(geometry_handle_t* p_valid_geometry_handle) noexcept
-{
-	RMLUI_VK_ASSERTMSG(p_valid_geometry_handle,
-		"you must pass a VALID pointer to geometry_handle_t, otherwise something is wrong and debug your code");
-	RMLUI_VK_ASSERTMSG(p_valid_geometry_handle->m_p_vertex_allocation, "you must have a VALID pointer of VmaAllocation for vertex buffer");
-	RMLUI_VK_ASSERTMSG(p_valid_geometry_handle->m_p_index_allocation, "you must have a VALID pointer of VmaAllocation for index buffer");
-	RMLUI_VK_ASSERTMSG(p_valid_geometry_handle->m_p_shader_allocation,
-		"you must have a VALID pointer of VmaAllocation for shader operations (like uniforms and etc)");
-	RMLUI_VK_ASSERTMSG(m_p_block, "you have to allocate the virtual block before do this operation...");
-
-	vmaVirtualFree(m_p_block, p_valid_geometry_handle->m_p_shader_allocation);
-	p_valid_geometry_handle->m_p_shader_allocation = nullptr;
-}
-
 #define GLAD_VULKAN_IMPLEMENTATION
 #define VMA_IMPLEMENTATION
 #include "RmlUi_Include_Vulkan.h"
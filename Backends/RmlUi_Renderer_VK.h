@@ -25,6 +25,8 @@ class RenderInterface_VK : public Rml::RenderInterface {
 public:
 	static constexpr uint32_t kSwapchainBackBufferCount = 3;
 	static constexpr VkDeviceSize kVideoMemoryForAllocation = 4 * 1024 * 1024; // [bytes]
+	static constexpr VkDeviceSize kVideoMemoryForUniformsPerFrame = 256 * 1024; // [bytes]
+	static constexpr VkDeviceSize kStagingMemoryForUploadsPerFrame = 1024 * 1024; // [bytes]
 
 	RenderInterface_VK();
 	~RenderInterface_VK();
@@ -52,6 +54,7 @@ public:
 
 	/// Called by RmlUi when a texture is required by the library.
 	Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	bool LoadTextureData(Rml::Vector<Rml::byte>& out_data, Rml::Vector2i& out_dimensions, const Rml::String& source) override;
 	/// Called by RmlUi when a texture is required to be built from an internally-generated sequence of pixels.
 	Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions) override;
 	/// Called by RmlUi when a loaded texture is no longer required.
@@ -85,155 +88,83 @@ private:
 
 	struct geometry_handle_t {
 		int m_num_indices;
+		VkIndexType m_index_type;
 
 		VkDescriptorBufferInfo m_p_vertex;
 		VkDescriptorBufferInfo m_p_index;
-		VkDescriptorBufferInfo m_p_shader;
 
 		// @ this is for freeing our logical blocks for VMA
 		// see https://gpuopen-librariesandsdks.github.io/VulkanMemoryAllocator/html/virtual_allocator.html
 		VmaVirtualAllocation m_p_vertex_allocation;
 		VmaVirtualAllocation m_p_index_allocation;
-		VmaVirtualAllocation m_p_shader_allocation;
 	};
 
-	struct buffer_data_t {
-		VkBuffer m_p_vk_buffer;
-		VmaAllocation m_p_vma_allocation;
+	// @ state bound to the current command buffer, used to skip redundant binding commands between draws
+	struct bound_state_t {
+		VkPipeline m_p_pipeline;
+		VkDescriptorSet m_p_texture_descriptor_set;
+		const geometry_handle_t* m_p_geometry;
+		bool m_is_uniform_valid;
+		shader_vertex_user_data_t m_uniform_data;
 	};
 
+	// @ records texture uploads into one batch per frame, copying the pixels into a staging ring with one region per frame slot, the batch is
+	// submitted together with the frame and the frame waits for it through a semaphore
 	class UploadResourceManager {
 	public:
-		UploadResourceManager() : m_p_device{}, m_p_fence{}, m_p_command_buffer{}, m_p_command_pool{}, m_p_graphics_queue{} {}
-		~UploadResourceManager() {}
-
-		void Initialize(VkDevice p_device, VkQueue p_queue, uint32_t queue_family_index)
-		{
-			RMLUI_VK_ASSERTMSG(p_queue, "you have to pass a valid VkQueue");
-			RMLUI_VK_ASSERTMSG(p_device, "you have to pass a valid VkDevice for creation resources");
-
-			m_p_device = p_device;
-			m_p_graphics_queue = p_queue;
-
-			Create_All(queue_family_index);
-		}
-
-		void Shutdown()
-		{
-			vkDestroyFence(m_p_device, m_p_fence, nullptr);
-			vkDestroyCommandPool(m_p_device, m_p_command_pool, nullptr);
-		}
-
-		template <typename Func>
-		void UploadToGPU(Func&& p_user_commands) noexcept
-		{
-			RMLUI_VK_ASSERTMSG(m_p_command_buffer, "you didn't initialize VkCommandBuffer");
-
-			VkCommandBufferBeginInfo info_command = {};
-
-			info_command.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-			info_command.pNext = nullptr;
-			info_command.pInheritanceInfo = nullptr;
-			info_command.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-			VkResult status = vkBeginCommandBuffer(m_p_command_buffer, &info_command);
-
-			RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkBeginCommandBuffer");
+		struct staging_region_t {
+			VkBuffer m_p_vk_buffer;
+			VkDeviceSize m_offset;
+		};
 
-			p_user_commands(m_p_command_buffer);
+		UploadResourceManager() : m_p_device{}, m_p_allocator{}, m_p_queue{}, m_is_graphics_queue{}, m_staging_alignment{}, m_p_recording_batch{} {}
+		~UploadResourceManager() {}
 
-			status = vkEndCommandBuffer(m_p_command_buffer);
+		void Initialize(VkDevice p_device, VmaAllocator p_allocator, VkQueue p_queue, uint32_t queue_family_index, bool is_graphics_queue,
+			VkDeviceSize staging_alignment) noexcept;
+		void Shutdown() noexcept;
 
-			RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "faield to vkEndCommandBuffer");
+		// @ false when uploading on a dedicated transfer queue, which doesn't support the shader stages in its barriers
+		bool IsGraphicsQueue() const noexcept { return m_is_graphics_queue; }
+		bool IsRecording() const noexcept { return m_p_recording_batch != nullptr; }
 
-			Submit();
-			Wait();
-		}
+		// @ starts recording the batch of the given frame slot unless it is already recording, the previous submission of this slot must have
+		// been completed
+		VkCommandBuffer Begin(uint32_t frame_index) noexcept;
+		// @ copies the data into the staging memory of the recording batch
+		staging_region_t Stage(const void* p_data, VkDeviceSize size) noexcept;
+		// @ submits the recording batch, returns the semaphore to wait for before using the uploaded resources, or nullptr if nothing was
+		// recorded
+		VkSemaphore Submit() noexcept;
 
 	private:
-		void Create_Fence() noexcept
-		{
-			VkFenceCreateInfo info = {};
-			info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-			info.pNext = nullptr;
-			info.flags = 0;
-
-			VkResult status = vkCreateFence(m_p_device, &info, nullptr, &m_p_fence);
-
-			RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkCreateFence");
-		}
-
-		void Create_CommandBuffer() noexcept
-		{
-			RMLUI_VK_ASSERTMSG(m_p_command_pool, "you have to initialize VkCommandPool before calling this method!");
-
-			VkCommandBufferAllocateInfo info = {};
-			info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-			info.pNext = nullptr;
-			info.commandPool = m_p_command_pool;
-			info.commandBufferCount = 1;
-			info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-
-			VkResult status = vkAllocateCommandBuffers(m_p_device, &info, &m_p_command_buffer);
-
-			RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkAllocateCommandBuffers");
-		}
-
-		void Create_CommandPool(uint32_t queue_family_index) noexcept
-		{
-			VkCommandPoolCreateInfo info = {};
-
-			info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-			info.pNext = nullptr;
-			info.queueFamilyIndex = queue_family_index;
-			info.flags = 0;
-
-			VkResult status = vkCreateCommandPool(m_p_device, &info, nullptr, &m_p_command_pool);
-
-			RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkCreateCommandPool");
-		}
-
-		void Create_All(uint32_t queue_family_index) noexcept
-		{
-			Create_Fence();
-			Create_CommandPool(queue_family_index);
-			Create_CommandBuffer();
-		}
-
-		void Wait() noexcept
-		{
-			RMLUI_VK_ASSERTMSG(m_p_fence, "you must initialize your VkFence");
-
-			vkWaitForFences(m_p_device, 1, &m_p_fence, VK_TRUE, UINT64_MAX);
-			vkResetFences(m_p_device, 1, &m_p_fence);
-			vkResetCommandPool(m_p_device, m_p_command_pool, 0);
-		}
-
-		void Submit() noexcept
-		{
-			VkSubmitInfo info = {};
-
-			info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-			info.pNext = nullptr;
-			info.waitSemaphoreCount = 0;
-			info.signalSemaphoreCount = 0;
-			info.pSignalSemaphores = nullptr;
-			info.pWaitSemaphores = nullptr;
-			info.pWaitDstStageMask = nullptr;
-			info.pCommandBuffers = &m_p_command_buffer;
-			info.commandBufferCount = 1;
+		struct staging_buffer_t {
+			VkBuffer m_p_vk_buffer;
+			VmaAllocation m_p_vma_allocation;
+			void* m_p_data;
+			VkDeviceSize m_capacity;
+		};
 
-			auto status = vkQueueSubmit(m_p_graphics_queue, 1, &info, m_p_fence);
+		struct batch_t {
+			VkCommandPool m_p_command_pool;
+			VkCommandBuffer m_p_command_buffer;
+			VkSemaphore m_p_semaphore;
+			staging_buffer_t m_staging;
+			VkDeviceSize m_staging_offset;
+			// @ buffers outgrown by the uploads of this batch, released once the slot is reused
+			Rml::Vector<staging_buffer_t> m_outgrown_staging;
+		};
 
-			RMLUI_VK_ASSERTMSG(status == VkResult::VK_SUCCESS, "failed to vkQueueSubmit");
-		}
+		staging_buffer_t Create_StagingBuffer(VkDeviceSize size) noexcept;
+		void Destroy_StagingBuffer(staging_buffer_t& buffer) noexcept;
 
-	private:
 		VkDevice m_p_device;
-		VkFence m_p_fence;
-		VkCommandBuffer m_p_command_buffer;
-		VkCommandPool m_p_command_pool;
-		VkQueue m_p_graphics_queue;
+		VmaAllocator m_p_allocator;
+		VkQueue m_p_queue;
+		bool m_is_graphics_queue;
+		VkDeviceSize m_staging_alignment;
+		batch_t* m_p_recording_batch;
+		Rml::Array<batch_t, kSwapchainBackBufferCount> m_batches;
 	};
 
 	// @ main manager for "allocating" vertex, index, uniform stuff
@@ -242,14 +173,20 @@ private:
 		MemoryPool();
 		~MemoryPool();
 
-		void Initialize(VkDeviceSize byte_size, VkDeviceSize device_min_uniform_alignment, VmaAllocator p_allocator, VkDevice p_device) noexcept;
+		void Initialize(VkDeviceSize byte_size, VkDeviceSize frame_uniform_byte_size, VkDeviceSize device_min_uniform_alignment,
+			VmaAllocator p_allocator, VkDevice p_device) noexcept;
 		void Shutdown() noexcept;
 
+		// Resets the uniform ring of the given frame, must only be called once the GPU has finished executing its previous use.
+		void OnBeginFrame(uint32_t frame_index) noexcept;
+
 		bool Alloc_GeneralBuffer(VkDeviceSize size, void** p_data, VkDescriptorBufferInfo* p_out, VmaVirtualAllocation* p_alloc) noexcept;
 		bool Alloc_VertexBuffer(uint32_t number_of_elements, uint32_t stride_in_bytes, void** p_data, VkDescriptorBufferInfo* p_out,
 			VmaVirtualAllocation* p_alloc) noexcept;
 		bool Alloc_IndexBuffer(uint32_t number_of_elements, uint32_t stride_in_bytes, void** p_data, VkDescriptorBufferInfo* p_out,
 			VmaVirtualAllocation* p_alloc) noexcept;
+		// Allocates transient data from the uniform ring of the active frame, it is only valid until that frame is begun again.
+		bool Alloc_FrameUniformBuffer(VkDeviceSize size, void** p_data, VkDescriptorBufferInfo* p_out) noexcept;
 
 		void SetDescriptorSet(uint32_t binding_index, uint32_t size, VkDescriptorType descriptor_type, VkDescriptorSet p_set) noexcept;
 		void SetDescriptorSet(uint32_t binding_index, VkDescriptorBufferInfo* p_info, VkDescriptorType descriptor_type,
@@ -258,9 +195,21 @@ private:
 			VkDescriptorSet p_set) noexcept;
 
 		void Free_GeometryHandle(geometry_handle_t* p_valid_geometry_handle) noexcept;
-		void Free_GeometryHandle_ShaderDataOnly(geometry_handle_t* p_valid_geometry_handle) noexcept;
 
 	private:
+		// @ a linear region of the pool reserved for each buffered frame, allocations beyond its size fall back to the general allocator
+		struct frame_uniforms_t {
+			VmaVirtualAllocation m_p_allocation;
+			VkDeviceSize m_offset;
+			VkDeviceSize m_used_size;
+			Rml::Vector<VmaVirtualAllocation> m_overflow_allocations;
+		};
+
+		void Free_FrameUniforms(frame_uniforms_t& frame) noexcept;
+
+		Rml::Array<frame_uniforms_t, kSwapchainBackBufferCount> m_frame_uniforms;
+		frame_uniforms_t* m_p_current_frame_uniforms;
+		VkDeviceSize m_frame_uniform_size;
 		VkDeviceSize m_memory_total_size;
 		VkDeviceSize m_device_min_uniform_alignment;
 		char* m_p_data;
@@ -462,9 +411,6 @@ private:
 
 	void CreateResourcesDependentOnSize(const VkExtent2D& real_render_image_size) noexcept;
 
-	buffer_data_t CreateResource_StagingBuffer(VkDeviceSize size, VkBufferUsageFlags flags) noexcept;
-	void DestroyResource_StagingBuffer(const buffer_data_t& data) noexcept;
-
 	void Destroy_Textures() noexcept;
 	void Destroy_Geometries() noexcept;
 
@@ -482,7 +428,9 @@ private:
 	void Wait() noexcept;
 
 	void Update_PendingForDeletion_Textures_By_Frames() noexcept;
-	void Update_PendingForDeletion_Geometries() noexcept;
+	void Update_PendingForDeletion_Geometries_By_Frames() noexcept;
+
+	VkCommandBuffer BeginUpload() noexcept;
 
 	void Submit() noexcept;
 	void Present() noexcept;
@@ -501,8 +449,8 @@ private:
 	uint32_t m_queue_index_present;
 	uint32_t m_queue_index_graphics;
 	uint32_t m_queue_index_compute;
+	uint32_t m_queue_index_transfer;
 	uint32_t m_semaphore_index;
-	uint32_t m_semaphore_index_previous;
 	uint32_t m_image_index;
 
 	VkInstance m_p_instance;
@@ -534,6 +482,7 @@ private:
 	VkQueue m_p_queue_present;
 	VkQueue m_p_queue_graphics;
 	VkQueue m_p_queue_compute;
+	VkQueue m_p_queue_transfer;
 
 #ifdef RMLUI_VK_DEBUG
 	VkDebugUtilsMessengerEXT m_debug_messenger;
@@ -541,6 +490,7 @@ private:
 
 	VkSurfaceFormatKHR m_swapchain_format;
 	shader_vertex_user_data_t m_user_data_for_vertex_shader;
+	bound_state_t m_bound_state;
 	texture_data_t m_texture_depthstencil;
 
 	Rml::Matrix4f m_projection;
@@ -553,8 +503,12 @@ private:
 	Rml::Vector<VkShaderModule> m_shaders;
 	Rml::Array<Rml::Vector<texture_data_t*>, kSwapchainBackBufferCount> m_pending_for_deletion_textures_by_frames;
 
-	// vma handles that thing, so there's no need for frame splitting
-	Rml::Vector<geometry_handle_t*> m_pending_for_deletion_geometries;
+	Rml::Array<Rml::Vector<geometry_handle_t*>, kSwapchainBackBufferCount> m_pending_for_deletion_geometries_by_frames;
+
+	// @ textures uploaded by the batch which is still recording, and those of them already released, which can only be destroyed after the
+	// batch has been executed
+	Rml::Vector<texture_data_t*> m_textures_pending_upload;
+	Rml::Vector<texture_data_t*> m_textures_released_before_upload;
 
 	CommandBufferRing m_command_buffer_ring;
 	MemoryPool m_memory_pool;
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "Core/Animation.h"
+#include "Core/ArchiveBuilder.h"
+#include "Core/ArchiveFileInterface.h"
 #include "Core/Box.h"
 #include "Core/CallbackTexture.h"
 #include "Core/CompiledFilterShader.h"
+#include "Core/CompiledSelector.h"
 #include "Core/ComputedValues.h"
 #include "Core/Context.h"
 #include "Core/ContextInstancer.h"
@@ -33,16 +36,22 @@
 #include "Core/FontEffectInstancer.h"
 #include "Core/FontEngineInterface.h"
 #include "Core/FontGlyph.h"
+#include "Core/FrameStatistics.h"
 #include "Core/Geometry.h"
 #include "Core/Header.h"
 #include "Core/ID.h"
 #include "Core/Input.h"
+#include "Core/InputBatch.h"
 #include "Core/Log.h"
 #include "Core/Math.h"
+#include "Core/MemoryInterface.h"
+#include "Core/MemoryStatistics.h"
 #include "Core/Mesh.h"
 #include "Core/MeshUtilities.h"
 #include "Core/NumericValue.h"
 #include "Core/Plugin.h"
+#include "Core/Profiler.h"
+#include "Core/ProfilingInterface.h"
 #include "Core/PropertiesIteratorView.h"
 #include "Core/Property.h"
 #include "Core/PropertyDefinition.h"
@@ -50,15 +59,18 @@
 #include "Core/PropertyIdSet.h"
 #include "Core/PropertyParser.h"
 #include "Core/PropertySpecification.h"
+#include "Core/RenderCommandList.h"
 #include "Core/RenderInterface.h"
 #include "Core/RenderManager.h"
 #include "Core/Spritesheet.h"
+#include "Core/StartupStatistics.h"
 #include "Core/StringUtilities.h"
 #include "Core/StyleSheet.h"
 #include "Core/StyleSheetContainer.h"
 #include "Core/StyleSheetSpecification.h"
 #include "Core/StyleTypes.h"
 #include "Core/SystemInterface.h"
+#include "Core/TaskInterface.h"
 #include "Core/TextShapingContext.h"
 #include "Core/Texture.h"
 #include "Core/Transform.h"
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Header.h"
+#include "Types.h"
+
+namespace Rml {
+
+/**
+    Packs files into a resource archive, which can be loaded by the ArchiveFileInterface.
+
+    Archives are typically built as part of the asset pipeline, see the 'rmlui_archive_tool' target. The archive is only valid on platforms
+    with the same endianness as the one it was built on.
+ */
+class RMLUICORE_API ArchiveBuilder {
+public:
+	ArchiveBuilder();
+	~ArchiveBuilder();
+
+	/// Adds a file to the archive, replacing any previously added file with the same path.
+	/// @param path The path of the file, relative to the mount path of the archive when it is loaded.
+	/// @param data The contents of the file.
+	/// @param compress Compress the file contents with LZ4, they are stored uncompressed if that does not reduce their size.
+	void AddFile(const String& path, Span<const byte> data, bool compress);
+
+	/// Returns the number of files added to the archive.
+	size_t GetNumFiles() const;
+
+	/// Builds the archive from all added files.
+	/// @param[out] out_data The binary archive data.
+	/// @return True on success, false if the archive could not be built, such as when it would be too large.
+	bool Build(Vector<byte>& out_data) const;
+
+private:
+	struct File {
+		String path;
+		Vector<byte> data; // The stored data, compressed if 'compressed' is set.
+		size_t size;
+		bool compressed;
+	};
+	Vector<File> files;
+};
+
+} // namespace Rml
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "FileInterface.h"
+#include "Header.h"
+#include "Types.h"
+
+namespace Rml {
+
+/**
+    A file interface serving files from resource archives built by the ArchiveBuilder.
+
+    Files are found by their hashed path, without any lookups on the file system. Uncompressed files are used in place, while compressed
+    files are decompressed when opened. Any files not found in the archives are opened through the fallback interface instead. The interface
+    should be installed through Rml::SetFileInterface() before initializing RmlUi.
+ */
+class RMLUICORE_API ArchiveFileInterface : public FileInterface {
+public:
+	/// @param fallback_interface The interface used to read archive files from paths, and to open files not found in any archive. If
+	/// nullptr, the default file interface of the library is used where available.
+	explicit ArchiveFileInterface(FileInterface* fallback_interface = nullptr);
+	virtual ~ArchiveFileInterface();
+
+	/// Adds an archive read from the given path using the fallback interface.
+	/// @param archive_path The path of the archive file.
+	/// @param mount_path The path where the files of the archive are located, prepended to the paths stored in the archive.
+	/// @return True if the archive was loaded successfully.
+	bool AddArchive(const String& archive_path, const String& mount_path = String());
+	/// Adds an archive from memory, which must remain valid for the lifetime of this interface.
+	/// @param data The binary archive data.
+	/// @param mount_path The path where the files of the archive are located, prepended to the paths stored in the archive.
+	/// @return True if the archive was loaded successfully.
+	bool AddArchive(Span<const byte> data, const String& mount_path = String());
+
+	/// Returns true if the given path is found in any of the archives.
+	bool Contains(const String& path) const;
+
+	FileHandle Open(const String& path) override;
+	void Close(FileHandle file) override;
+	size_t Read(void* buffer, size_t size, FileHandle file) override;
+	bool Seek(FileHandle file, long offset, int origin) override;
+	size_t Tell(FileHandle file) override;
+	size_t Length(FileHandle file) override;
+
+	/// Maps files in the archives without copying them, unless they are compressed.
+	bool MapFile(const String& path, Span<const byte>& out_data, FileMappingHandle& out_handle) override;
+	void UnmapFile(FileMappingHandle handle) override;
+
+private:
+	struct Archive;
+	struct ArchiveFile;
+	struct ArchiveMapping;
+
+	// Finds the file with the given path in the archives, returns false if it is not found.
+	bool FindFile(const String& path, const Archive*& out_archive, size_t& out_entry_index) const;
+	// Retrieves the contents of an archived file, decompressing them into the buffer if necessary.
+	bool GetContents(const Archive& archive, size_t entry_index, Span<const byte>& out_data, UniquePtr<byte[]>& out_buffer) const;
+
+	FileInterface* fallback_interface;
+	UniquePtr<FileInterface> default_interface;
+
+	Vector<UniquePtr<Archive>> archives;
+};
+
+} // namespace Rml
@@ -2,6 +2,7 @@
 
 #include "Dictionary.h"
 #include "Header.h"
+#include "StringUtilities.h"
 #include "Types.h"
 
 namespace Rml {
@@ -12,6 +13,21 @@ using XMLAttributes = Dictionary;
 
 enum class XMLDataType { Text, CDATA, InnerXML };
 
+/**
+    A single event handled during an XML parse, used to replay a parse without tokenizing the source again.
+ */
+struct XMLParseEvent {
+	enum class Type { ElementStart, ElementEnd, Data };
+	Type type;
+	XMLDataType data_type;
+	int line_number;
+	int line_number_open_tag;
+	// The tag name for element events, or the data contents for data events.
+	String value;
+	XMLAttributes attributes;
+};
+using XMLParseEventList = Vector<XMLParseEvent>;
+
 class RMLUICORE_API BaseXMLParser {
 public:
 	BaseXMLParser();
@@ -38,6 +54,22 @@ public:
 	/// interesting phenomena are encountered.
 	void Parse(Stream* stream);
 
+	/// Begins parsing the given stream in steps, each continued by a call to ParseNext(), instead of parsing all of it at once.
+	/// @param[in] stream The stream to parse, which must be kept alive until the parse has finished.
+	void ParseBegin(Stream* stream);
+	/// Continues the parse begun by ParseBegin(), calling the handlers for up to the given number of tags.
+	/// @param[in] max_tags The maximum number of tags to read during this step, including closing tags and comments.
+	/// @return True if the parse has finished, otherwise it should be continued by another call.
+	bool ParseNext(int max_tags);
+
+	/// Records all events submitted to the handlers during the following parses.
+	/// @param[in] events The list to append the events to, or nullptr to stop recording.
+	void SetRecordEvents(XMLParseEventList* events);
+	/// Calls the handlers with events previously recorded during a parse, equivalent to parsing the original source again.
+	/// @param[in] events The recorded events.
+	/// @param[in] source_url The URL of the original source.
+	void Replay(const XMLParseEventList& events, const URL& source_url);
+
 	/// Get the line number in the stream.
 	/// @return The line currently being processed in the XML stream.
 	int GetLineNumber() const;
@@ -56,7 +88,10 @@ protected:
 
 private:
 	const URL* source_url = nullptr;
-	String xml_source;
+	XMLParseEventList* record_events = nullptr;
+	// The source being parsed, either a view directly into the stream contents, or into the buffer below.
+	StringView xml_source;
+	String xml_source_buffer;
 	size_t xml_index = 0;
 
 	void Next();
@@ -68,7 +103,9 @@ private:
 	void HandleDataInternal(const String& data, XMLDataType type);
 
 	void ReadHeader();
-	void ReadBody();
+	// Reads the next tag of the body along with any preceding data, returns false when the end of the body has been reached.
+	bool ReadBodyTag();
+	void ParseEnd();
 	bool ReadOpenTag();
 
 	bool ReadCloseTag(size_t xml_index_tag);
@@ -10,6 +10,9 @@ enum class BoxDirection { Vertical, Horizontal };
 /**
     Stores a box with four sized areas; content, padding, a border and margin. See
     http://www.w3.org/TR/REC-CSS2/box.html#box-dimensions for a diagram.
+
+    Most boxes have no padding, borders or margins, such as those of text elements. The edges are only allocated once any of them are set to
+    a non-zero size, otherwise the box only stores its content size.
  */
 
 class RMLUICORE_API Box {
@@ -23,6 +26,11 @@ public:
 	explicit Box(Vector2f content);
 	~Box();
 
+	Box(const Box& other);
+	Box(Box&& other) noexcept;
+	Box& operator=(const Box& other);
+	Box& operator=(Box&& other) noexcept;
+
 	/// Returns the top-left position of one of the box's areas, relative to the top-left of the border area. This
 	/// means the position of the margin area is likely to be negative.
 	/// @param area[in] The desired area.
@@ -68,6 +76,9 @@ public:
 	/// @param area The area to use.
 	Vector2f GetFrameSize(BoxArea area) const;
 
+	/// Returns false if the box is known to have no padding, borders and margins, in which case all edges are zero.
+	bool HasEdges() const { return edges != nullptr; }
+
 	/// Compares the size of the content area and the other area edges.
 	/// @return True if the boxes represent the same area.
 	bool operator==(const Box& rhs) const;
@@ -76,8 +87,11 @@ public:
 	bool operator!=(const Box& rhs) const;
 
 private:
+	const float* GetEdges() const;
+
 	Vector2f content;
-	float area_edges[num_areas][num_edges] = {};
+	// The sizes of the area edges, indexed by area and then edge, or null when all edges are zero.
+	float* edges = nullptr;
 };
 
 } // namespace Rml
@@ -29,6 +29,12 @@ public:
 
 	operator Texture() const;
 
+	/// Replaces a region of the texture with new pixel data, if the texture has already been generated.
+	/// @param[in] region The region of the texture to replace, in pixels.
+	/// @param[in] source Texture data in 8-bit RGBA (premultiplied) format, tightly packed to the size of the region.
+	/// @return True on success, false if the render interface does not support texture updates.
+	bool UpdateTexture(Rectanglei region, Span<const byte> source) const;
+
 	void Release();
 
 private:
@@ -88,6 +94,12 @@ public:
 
 	Texture GetTexture(RenderManager& render_manager) const;
 
+	/// Replaces a region of the texture in every render manager it has been generated for.
+	/// @param[in] region The region of the texture to replace, in pixels.
+	/// @param[in] source Texture data in 8-bit RGBA (premultiplied) format, tightly packed to the size of the region.
+	/// @return True on success, false if any render interface does not support texture updates.
+	bool UpdateTexture(Rectanglei region, Span<const byte> source) const;
+
 private:
 	CallbackTextureFunction callback;
 	mutable SmallUnorderedMap<RenderManager*, CallbackTexture> textures;
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Header.h"
+#include "Types.h"
+
+namespace Rml {
+
+class StyleSheetNode;
+
+/**
+    A selector parsed once for repeated element queries.
+
+    Queries taking a selector string parse the string during every call. Instead, a compiled selector can be passed to the queries of any
+    element, such as Element::QuerySelectorAll(), to skip the parsing.
+ */
+class RMLUICORE_API CompiledSelector {
+public:
+	CompiledSelector();
+	/// Parses the selector or comma-separated selectors.
+	explicit CompiledSelector(const String& selectors);
+	~CompiledSelector();
+
+	CompiledSelector(CompiledSelector&& other) noexcept;
+	CompiledSelector& operator=(CompiledSelector&& other) noexcept;
+	CompiledSelector(const CompiledSelector&) = delete;
+	CompiledSelector& operator=(const CompiledSelector&) = delete;
+
+	/// Returns false if the selector is empty, in which case queries do not match any elements.
+	explicit operator bool() const { return !leaf_nodes.empty(); }
+
+	/// Returns the source string of the selector.
+	const String& GetSource() const { return source; }
+
+private:
+	String source;
+	UniquePtr<StyleSheetNode> root_node;
+	Vector<StyleSheetNode*> leaf_nodes;
+
+	friend class Element;
+};
+
+} // namespace Rml
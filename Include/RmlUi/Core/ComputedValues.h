@@ -8,6 +8,9 @@
 #include <cfloat>
 
 namespace Rml {
+
+struct ComputedPropertyData;
+
 namespace Style {
 
 	/*
@@ -136,6 +139,7 @@ namespace Style {
 			flex_basis_type(LengthPercentageAuto::Auto), row_gap_type(LengthPercentage::Length), column_gap_type(LengthPercentage::Length),
 
 			vertical_align_type(VerticalAlign::Baseline), drag(Drag::None), tab_index(TabIndex::None), overscroll_behavior(OverscrollBehavior::Auto),
+			render_cache(RenderCache::None),
 
 			has_mask_image(false), has_filter(false), has_backdrop_filter(false), has_box_shadow(false), text_overflow(TextOverflow::Clip)
 		{}
@@ -154,6 +158,7 @@ namespace Style {
 		Drag drag : 3;
 		TabIndex tab_index : 1;
 		OverscrollBehavior overscroll_behavior : 1;
+		RenderCache render_cache : 2;
 
 		bool has_mask_image : 1;
 		bool has_filter : 1;
@@ -184,9 +189,16 @@ namespace Style {
 		float scrollbar_margin = 0.f;
 	};
 
-	class ComputedValues : NonCopyMoveable {
+	/**
+	    The computed values of an element.
+
+	    The inherited and rare values are kept in groups which are shared between elements until written to. Children share the inherited group
+	    of their parent, and elements without any rare properties share the rare group of the default values. Writing a different value to a
+	    shared group first makes a private copy of it, thus the sharing is not observable through the accessors.
+	 */
+	class RMLUICORE_API ComputedValues : NonCopyMoveable {
 	public:
-		explicit ComputedValues(Element* element) : element(element) {}
+		explicit ComputedValues(Element* element);
 
 		// clang-format off
 
@@ -228,43 +240,43 @@ namespace Style {
 		// -- Inherited --
 		String         font_family()      const;
 		String         cursor()           const;
-		FontFaceHandle font_face_handle() const { return inherited.font_face_handle; }
-		float          font_size()        const { return inherited.font_size; }
+		FontFaceHandle font_face_handle() const { return inherited->font_face_handle; }
+		float          font_size()        const { return inherited->font_size; }
 		float          letter_spacing()   const;
-		bool           has_font_effect()  const { return inherited.has_font_effect; }
-		FontStyle      font_style()       const { return inherited.font_style; }
-		FontWeight     font_weight()      const { return inherited.font_weight; }
-		FontKerning    font_kerning()     const { return inherited.font_kerning; }
-		PointerEvents  pointer_events()   const { return inherited.pointer_events; }
-		Focus          focus()            const { return inherited.focus; }
-		TextAlign      text_align()       const { return inherited.text_align; }
-		TextDecoration text_decoration()  const { return inherited.text_decoration; }
-		TextTransform  text_transform()   const { return inherited.text_transform; }
-		WhiteSpace     white_space()      const { return inherited.white_space; }
-		WordBreak      word_break()       const { return inherited.word_break; }
-		Colourb        color()            const { return inherited.color; }
-		float          opacity()          const { return inherited.opacity; }
-		LineHeight     line_height()      const { return LineHeight(inherited.line_height, inherited.line_height_inherit_type, inherited.line_height_inherit); }
-		const String&  language()         const { return inherited.language; }
-		Direction      direction()        const { return inherited.direction; }
+		bool           has_font_effect()  const { return inherited->has_font_effect; }
+		FontStyle      font_style()       const { return inherited->font_style; }
+		FontWeight     font_weight()      const { return inherited->font_weight; }
+		FontKerning    font_kerning()     const { return inherited->font_kerning; }
+		PointerEvents  pointer_events()   const { return inherited->pointer_events; }
+		Focus          focus()            const { return inherited->focus; }
+		TextAlign      text_align()       const { return inherited->text_align; }
+		TextDecoration text_decoration()  const { return inherited->text_decoration; }
+		TextTransform  text_transform()   const { return inherited->text_transform; }
+		WhiteSpace     white_space()      const { return inherited->white_space; }
+		WordBreak      word_break()       const { return inherited->word_break; }
+		Colourb        color()            const { return inherited->color; }
+		float          opacity()          const { return inherited->opacity; }
+		LineHeight     line_height()      const { return LineHeight(inherited->line_height, inherited->line_height_inherit_type, inherited->line_height_inherit); }
+		const String&  language()         const { return inherited->language; }
+		Direction      direction()        const { return inherited->direction; }
 
 		// -- Rare --
-		MinWidth          min_width()                  const { return LengthPercentage(rare.min_width_type, rare.min_width); }
-		MaxWidth          max_width()                  const { return LengthPercentage(rare.max_width_type, rare.max_width); }
-		MinHeight         min_height()                 const { return LengthPercentage(rare.min_height_type, rare.min_height); }
-		MaxHeight         max_height()                 const { return LengthPercentage(rare.max_height_type, rare.max_height); }
-		VerticalAlign     vertical_align()             const { return VerticalAlign(rare.vertical_align_type, rare.vertical_align_length); }
+		MinWidth          min_width()                  const { return LengthPercentage(rare->min_width_type, rare->min_width); }
+		MaxWidth          max_width()                  const { return LengthPercentage(rare->max_width_type, rare->max_width); }
+		MinHeight         min_height()                 const { return LengthPercentage(rare->min_height_type, rare->min_height); }
+		MaxHeight         max_height()                 const { return LengthPercentage(rare->max_height_type, rare->max_height); }
+		VerticalAlign     vertical_align()             const { return VerticalAlign(rare->vertical_align_type, rare->vertical_align_length); }
 		const             AnimationList* animation()   const;
 		const             TransitionList* transition() const;
-		float             perspective()                const { return rare.perspective; }
-		PerspectiveOrigin perspective_origin_x()       const { return LengthPercentage(rare.perspective_origin_x_type, rare.perspective_origin_x); }
-		PerspectiveOrigin perspective_origin_y()       const { return LengthPercentage(rare.perspective_origin_y_type, rare.perspective_origin_y); }
+		float             perspective()                const { return rare->perspective; }
+		PerspectiveOrigin perspective_origin_x()       const { return LengthPercentage(rare->perspective_origin_x_type, rare->perspective_origin_x); }
+		PerspectiveOrigin perspective_origin_y()       const { return LengthPercentage(rare->perspective_origin_y_type, rare->perspective_origin_y); }
 		TransformPtr      transform()                  const { return GetLocalProperty(PropertyId::Transform, TransformPtr()); }
-		TransformOrigin   transform_origin_x()         const { return LengthPercentage(rare.transform_origin_x_type, rare.transform_origin_x); }
-		TransformOrigin   transform_origin_y()         const { return LengthPercentage(rare.transform_origin_y_type, rare.transform_origin_y); }
-		float             transform_origin_z()         const { return rare.transform_origin_z; }
-		bool              has_local_transform()        const { return rare.has_local_transform; }
-		bool              has_local_perspective()      const { return rare.has_local_perspective; }
+		TransformOrigin   transform_origin_x()         const { return LengthPercentage(rare->transform_origin_x_type, rare->transform_origin_x); }
+		TransformOrigin   transform_origin_y()         const { return LengthPercentage(rare->transform_origin_y_type, rare->transform_origin_y); }
+		float             transform_origin_z()         const { return rare->transform_origin_z; }
+		bool              has_local_transform()        const { return rare->has_local_transform; }
+		bool              has_local_perspective()      const { return rare->has_local_perspective; }
 		AlignContent      align_content()              const { return GetLocalPropertyKeyword(PropertyId::AlignContent, AlignContent::Stretch); }
 		AlignItems        align_items()                const { return GetLocalPropertyKeyword(PropertyId::AlignItems, AlignItems::Stretch); }
 		AlignSelf         align_self()                 const { return GetLocalPropertyKeyword(PropertyId::AlignSelf, AlignSelf::Auto); }
@@ -273,27 +285,28 @@ namespace Style {
 		JustifyContent    justify_content()            const { return GetLocalPropertyKeyword(PropertyId::JustifyContent, JustifyContent::FlexStart); }
 		float             flex_grow()                  const { return GetLocalProperty(PropertyId::FlexGrow, 0.f); }
 		float             flex_shrink()                const { return GetLocalProperty(PropertyId::FlexShrink, 1.f); }
-		FlexBasis         flex_basis()                 const { return LengthPercentageAuto(rare.flex_basis_type, rare.flex_basis); }
-		float             border_top_left_radius()     const { return (float)rare.border_top_left_radius; }
-		float             border_top_right_radius()    const { return (float)rare.border_top_right_radius; }
-		float             border_bottom_right_radius() const { return (float)rare.border_bottom_right_radius; }
-		float             border_bottom_left_radius()  const { return (float)rare.border_bottom_left_radius; }
-		CornerSizes       border_radius()              const { return {(float)rare.border_top_left_radius,     (float)rare.border_top_right_radius,
-		                                                               (float)rare.border_bottom_right_radius, (float)rare.border_bottom_left_radius}; }
-		TextOverflow      text_overflow()              const { return rare.text_overflow; }
+		FlexBasis         flex_basis()                 const { return LengthPercentageAuto(rare->flex_basis_type, rare->flex_basis); }
+		float             border_top_left_radius()     const { return (float)rare->border_top_left_radius; }
+		float             border_top_right_radius()    const { return (float)rare->border_top_right_radius; }
+		float             border_bottom_right_radius() const { return (float)rare->border_bottom_right_radius; }
+		float             border_bottom_left_radius()  const { return (float)rare->border_bottom_left_radius; }
+		CornerSizes       border_radius()              const { return {(float)rare->border_top_left_radius,     (float)rare->border_top_right_radius,
+		                                                               (float)rare->border_bottom_right_radius, (float)rare->border_bottom_left_radius}; }
+		TextOverflow      text_overflow()              const { return rare->text_overflow; }
 		String            text_overflow_string()       const { return GetLocalProperty(PropertyId::TextOverflow, String());; }
-		Clip              clip()                       const { return rare.clip; }
-		Drag              drag()                       const { return rare.drag; }
-		TabIndex          tab_index()                  const { return rare.tab_index; }
-		Colourb           image_color()                const { return rare.image_color; }
-		LengthPercentage  row_gap()                    const { return LengthPercentage(rare.row_gap_type, rare.row_gap); }
-		LengthPercentage  column_gap()                 const { return LengthPercentage(rare.column_gap_type, rare.column_gap); }
-		OverscrollBehavior overscroll_behavior()       const { return rare.overscroll_behavior; }
-		float             scrollbar_margin()           const { return rare.scrollbar_margin; }
-		bool              has_mask_image()             const { return rare.has_mask_image; }
-		bool              has_filter()                 const { return rare.has_filter; }
-		bool              has_backdrop_filter()        const { return rare.has_backdrop_filter; }
-		bool              has_box_shadow()             const { return rare.has_box_shadow; }
+		Clip              clip()                       const { return rare->clip; }
+		Drag              drag()                       const { return rare->drag; }
+		TabIndex          tab_index()                  const { return rare->tab_index; }
+		Colourb           image_color()                const { return rare->image_color; }
+		LengthPercentage  row_gap()                    const { return LengthPercentage(rare->row_gap_type, rare->row_gap); }
+		LengthPercentage  column_gap()                 const { return LengthPercentage(rare->column_gap_type, rare->column_gap); }
+		OverscrollBehavior overscroll_behavior()       const { return rare->overscroll_behavior; }
+		float             scrollbar_margin()           const { return rare->scrollbar_margin; }
+		RenderCache       render_cache()               const { return rare->render_cache; }
+		bool              has_mask_image()             const { return rare->has_mask_image; }
+		bool              has_filter()                 const { return rare->has_filter; }
+		bool              has_backdrop_filter()        const { return rare->has_backdrop_filter; }
+		bool              has_box_shadow()             const { return rare->has_box_shadow; }
 
 		// -- Assignment --
 		// Common
@@ -331,57 +344,59 @@ namespace Style {
 		void border_left_color  (Colourb value)              { common.border_left_color   = value; }
 		void has_decorator      (bool value)                 { common.has_decorator       = value; }
 		// Inherited
-		void font_face_handle  (FontFaceHandle value) { inherited.font_face_handle   = value; }
-		void font_size         (float value)          { inherited.font_size          = value; }
-		void has_letter_spacing(bool value)           { inherited.has_letter_spacing = value; }
-		void has_font_effect   (bool value)           { inherited.has_font_effect    = value; }
-		void font_style        (FontStyle value)      { inherited.font_style         = value; }
-		void font_weight       (FontWeight value)     { inherited.font_weight        = value; }
-		void font_kerning      (FontKerning value)    { inherited.font_kerning       = value; }
-		void pointer_events    (PointerEvents value)  { inherited.pointer_events     = value; }
-		void focus             (Focus value)          { inherited.focus              = value; }
-		void text_align        (TextAlign value)      { inherited.text_align         = value; }
-		void text_decoration   (TextDecoration value) { inherited.text_decoration    = value; }
-		void text_transform    (TextTransform value)  { inherited.text_transform     = value; }
-		void white_space       (WhiteSpace value)     { inherited.white_space        = value; }
-		void word_break        (WordBreak value)      { inherited.word_break         = value; }
-		void color             (Colourb value)        { inherited.color              = value; }
-		void opacity           (float value)          { inherited.opacity            = value; }
-		void line_height       (LineHeight value)     { inherited.line_height = value.value; inherited.line_height_inherit_type = value.inherit_type; inherited.line_height_inherit = value.inherit_value;  }
-		void language          (const String& value)  { inherited.language           = value; }
-		void direction         (Direction value)      { inherited.direction          = value; }
+		void font_face_handle  (FontFaceHandle value) { if (inherited->font_face_handle != value) MutableInherited().font_face_handle = value; }
+		void font_size         (float value)          { if (inherited->font_size != value) MutableInherited().font_size = value; }
+		void has_letter_spacing(bool value)           { if (inherited->has_letter_spacing != value) MutableInherited().has_letter_spacing = value; }
+		void has_font_effect   (bool value)           { if (inherited->has_font_effect != value) MutableInherited().has_font_effect = value; }
+		void font_style        (FontStyle value)      { if (inherited->font_style != value) MutableInherited().font_style = value; }
+		void font_weight       (FontWeight value)     { if (inherited->font_weight != value) MutableInherited().font_weight = value; }
+		void font_kerning      (FontKerning value)    { if (inherited->font_kerning != value) MutableInherited().font_kerning = value; }
+		void pointer_events    (PointerEvents value)  { if (inherited->pointer_events != value) MutableInherited().pointer_events = value; }
+		void focus             (Focus value)          { if (inherited->focus != value) MutableInherited().focus = value; }
+		void text_align        (TextAlign value)      { if (inherited->text_align != value) MutableInherited().text_align = value; }
+		void text_decoration   (TextDecoration value) { if (inherited->text_decoration != value) MutableInherited().text_decoration = value; }
+		void text_transform    (TextTransform value)  { if (inherited->text_transform != value) MutableInherited().text_transform = value; }
+		void white_space       (WhiteSpace value)     { if (inherited->white_space != value) MutableInherited().white_space = value; }
+		void word_break        (WordBreak value)      { if (inherited->word_break != value) MutableInherited().word_break = value; }
+		void color             (Colourb value)        { if (inherited->color != value) MutableInherited().color = value; }
+		void opacity           (float value)          { if (inherited->opacity != value) MutableInherited().opacity = value; }
+		void line_height       (LineHeight value)     { if (inherited->line_height != value.value || inherited->line_height_inherit_type != value.inherit_type || inherited->line_height_inherit != value.inherit_value) {
+		                                                    InheritedValues& v = MutableInherited(); v.line_height = value.value; v.line_height_inherit_type = value.inherit_type; v.line_height_inherit = value.inherit_value; } }
+		void language          (const String& value)  { if (inherited->language != value) MutableInherited().language = value; }
+		void direction         (Direction value)      { if (inherited->direction != value) MutableInherited().direction = value; }
 		// Rare
-		void min_width                 (MinWidth value)          { rare.min_width_type             = value.type; rare.min_width                  = value.value; }
-		void max_width                 (MaxWidth value)          { rare.max_width_type             = value.type; rare.max_width                  = value.value; }
-		void min_height                (MinHeight value)         { rare.min_height_type            = value.type; rare.min_height                 = value.value; }
-		void max_height                (MaxHeight value)         { rare.max_height_type            = value.type; rare.max_height                 = value.value; }
-		void vertical_align            (VerticalAlign value)     { rare.vertical_align_type        = value.type; rare.vertical_align_length      = value.value; }
-		void perspective_origin_x      (PerspectiveOrigin value) { rare.perspective_origin_x_type  = value.type; rare.perspective_origin_x       = value.value; }
-		void perspective_origin_y      (PerspectiveOrigin value) { rare.perspective_origin_y_type  = value.type; rare.perspective_origin_y       = value.value; }
-		void transform_origin_x        (TransformOrigin value)   { rare.transform_origin_x_type    = value.type; rare.transform_origin_x         = value.value; }
-		void transform_origin_y        (TransformOrigin value)   { rare.transform_origin_y_type    = value.type; rare.transform_origin_y         = value.value; }
-		void row_gap                   (LengthPercentage value)  { rare.row_gap_type               = value.type; rare.row_gap                    = value.value; }
-		void column_gap                (LengthPercentage value)  { rare.column_gap_type            = value.type; rare.column_gap                 = value.value; }
-		void flex_basis                (FlexBasis value)         { rare.flex_basis_type            = value.type; rare.flex_basis                 = value.value; }
-		void transform_origin_z        (float value)             { rare.transform_origin_z         = value; }
-		void perspective               (float value)             { rare.perspective                = value; }
-		void has_local_perspective     (bool value)              { rare.has_local_perspective      = value; }
-		void has_local_transform       (bool value)              { rare.has_local_transform        = value; }
-		void border_top_left_radius    (float value)             { rare.border_top_left_radius     = (int16_t)value; }
-		void border_top_right_radius   (float value)             { rare.border_top_right_radius    = (int16_t)value; }
-		void border_bottom_right_radius(float value)             { rare.border_bottom_right_radius = (int16_t)value; }
-		void border_bottom_left_radius (float value)             { rare.border_bottom_left_radius  = (int16_t)value; }
-		void text_overflow             (TextOverflow value)      { rare.text_overflow              = value; }
-		void clip                      (Clip value)              { rare.clip                       = value; }
-		void drag                      (Drag value)              { rare.drag                       = value; }
-		void tab_index                 (TabIndex value)          { rare.tab_index                  = value; }
-		void image_color               (Colourb value)           { rare.image_color                = value; }
-		void overscroll_behavior       (OverscrollBehavior value){ rare.overscroll_behavior        = value; }
-		void scrollbar_margin          (float value)             { rare.scrollbar_margin           = value; }
-		void has_mask_image            (bool value)              { rare.has_mask_image             = value; }
-		void has_filter                (bool value)              { rare.has_filter                 = value; }
-		void has_backdrop_filter       (bool value)              { rare.has_backdrop_filter        = value; }
-		void has_box_shadow            (bool value)              { rare.has_box_shadow             = value; }
+		void min_width                 (MinWidth value)          { RareValues& v = MutableRare(); v.min_width_type = value.type; v.min_width = value.value; }
+		void max_width                 (MaxWidth value)          { RareValues& v = MutableRare(); v.max_width_type = value.type; v.max_width = value.value; }
+		void min_height                (MinHeight value)         { RareValues& v = MutableRare(); v.min_height_type = value.type; v.min_height = value.value; }
+		void max_height                (MaxHeight value)         { RareValues& v = MutableRare(); v.max_height_type = value.type; v.max_height = value.value; }
+		void vertical_align            (VerticalAlign value)     { RareValues& v = MutableRare(); v.vertical_align_type = value.type; v.vertical_align_length = value.value; }
+		void perspective_origin_x      (PerspectiveOrigin value) { RareValues& v = MutableRare(); v.perspective_origin_x_type = value.type; v.perspective_origin_x = value.value; }
+		void perspective_origin_y      (PerspectiveOrigin value) { RareValues& v = MutableRare(); v.perspective_origin_y_type = value.type; v.perspective_origin_y = value.value; }
+		void transform_origin_x        (TransformOrigin value)   { RareValues& v = MutableRare(); v.transform_origin_x_type = value.type; v.transform_origin_x = value.value; }
+		void transform_origin_y        (TransformOrigin value)   { RareValues& v = MutableRare(); v.transform_origin_y_type = value.type; v.transform_origin_y = value.value; }
+		void row_gap                   (LengthPercentage value)  { RareValues& v = MutableRare(); v.row_gap_type = value.type; v.row_gap = value.value; }
+		void column_gap                (LengthPercentage value)  { RareValues& v = MutableRare(); v.column_gap_type = value.type; v.column_gap = value.value; }
+		void flex_basis                (FlexBasis value)         { RareValues& v = MutableRare(); v.flex_basis_type = value.type; v.flex_basis = value.value; }
+		void transform_origin_z        (float value)             { if (rare->transform_origin_z != value) MutableRare().transform_origin_z = value; }
+		void perspective               (float value)             { if (rare->perspective != value) MutableRare().perspective = value; }
+		void has_local_perspective     (bool value)              { if (rare->has_local_perspective != value) MutableRare().has_local_perspective = value; }
+		void has_local_transform       (bool value)              { if (rare->has_local_transform != value) MutableRare().has_local_transform = value; }
+		void border_top_left_radius    (float value)             { if (rare->border_top_left_radius != (int16_t)value) MutableRare().border_top_left_radius = (int16_t)value; }
+		void border_top_right_radius   (float value)             { if (rare->border_top_right_radius != (int16_t)value) MutableRare().border_top_right_radius = (int16_t)value; }
+		void border_bottom_right_radius(float value)             { if (rare->border_bottom_right_radius != (int16_t)value) MutableRare().border_bottom_right_radius = (int16_t)value; }
+		void border_bottom_left_radius (float value)             { if (rare->border_bottom_left_radius != (int16_t)value) MutableRare().border_bottom_left_radius = (int16_t)value; }
+		void text_overflow             (TextOverflow value)      { if (rare->text_overflow != value) MutableRare().text_overflow = value; }
+		void clip                      (Clip value)              { if (rare->clip != value) MutableRare().clip = value; }
+		void drag                      (Drag value)              { if (rare->drag != value) MutableRare().drag = value; }
+		void tab_index                 (TabIndex value)          { if (rare->tab_index != value) MutableRare().tab_index = value; }
+		void image_color               (Colourb value)           { if (rare->image_color != value) MutableRare().image_color = value; }
+		void overscroll_behavior       (OverscrollBehavior value){ if (rare->overscroll_behavior != value) MutableRare().overscroll_behavior = value; }
+		void scrollbar_margin          (float value)             { if (rare->scrollbar_margin != value) MutableRare().scrollbar_margin = value; }
+		void render_cache              (RenderCache value)       { if (rare->render_cache != value) MutableRare().render_cache = value; }
+		void has_mask_image            (bool value)              { if (rare->has_mask_image != value) MutableRare().has_mask_image = value; }
+		void has_filter                (bool value)              { if (rare->has_filter != value) MutableRare().has_filter = value; }
+		void has_backdrop_filter       (bool value)              { if (rare->has_backdrop_filter != value) MutableRare().has_backdrop_filter = value; }
+		void has_box_shadow            (bool value)              { if (rare->has_box_shadow != value) MutableRare().has_box_shadow = value; }
 
 		// clang-format on
 
@@ -393,7 +408,16 @@ namespace Style {
 		}
 		void CopyInherited(const ComputedValues& parent) { inherited = parent.inherited; }
 
+		// Returns true if the inherited values are shared with the given values, such as those of the parent element.
+		bool SharesInheritedValues(const ComputedValues& other) const { return inherited == other.inherited; }
+
 	private:
+		// Constructs the default values, owning the only groups which are not copied from other computed values.
+		ComputedValues();
+
+		InheritedValues& MutableInherited();
+		RareValues& MutableRare();
+
 		template <typename T>
 		inline T GetLocalPropertyKeyword(PropertyId id, T default_value) const
 		{
@@ -412,8 +436,10 @@ namespace Style {
 		Element* element = nullptr;
 
 		CommonValues common;
-		InheritedValues inherited;
-		RareValues rare;
+		SharedPtr<InheritedValues> inherited;
+		SharedPtr<RareValues> rare;
+
+		friend struct Rml::ComputedPropertyData;
 	};
 
 } // namespace Style
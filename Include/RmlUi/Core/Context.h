@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FrameStatistics.h"
 #include "Header.h"
 #include "Input.h"
 #include "ScriptInterface.h"
@@ -13,12 +14,16 @@ class Stream;
 class ContextInstancer;
 class ElementDocument;
 class EventListener;
+class FrameStatisticsAccess;
+class InputBatch;
 class DataModel;
 class DataModelConstructor;
 class DataTypeRegister;
 class ScrollController;
 class RenderManager;
 class TextInputHandler;
+class XMLParser;
+struct ContextMemoryStats;
 enum class EventId : uint16_t;
 
 /**
@@ -48,6 +53,8 @@ public:
 
 	/// Changes the ratio of the 'dp' unit to the 'px' unit.
 	/// @param[in] dp_ratio The new density-independent pixel ratio of the context.
+	/// @note Styles and layout are updated during the next update. Decorators and filters may be regenerated during later updates when an update
+	/// budget is set, meanwhile their current look is shown scaled to the new ratio, see SetUpdateBudget().
 	void SetDensityIndependentPixelRatio(float dp_ratio);
 	/// Returns the ratio of the 'dp' unit to the 'px' unit.
 	/// @return The current density-independent pixel ratio of the context.
@@ -57,8 +64,36 @@ public:
 	/// This must be called before Context::Render, but after any elements have been changed, added, or removed.
 	bool Update();
 	/// Renders all visible elements in the context's documents.
+	/// @note With partial redraws enabled, only the dirty region is redrawn, and nothing is rendered without any visual changes.
 	bool Render();
 
+	/// Updates several contexts at once, equivalent to calling Update() on each of them in order, except that the layout of all their documents
+	/// is formatted together. This spreads the layout of many small contexts over the layout threads, see Rml::SetLayoutThreadCount().
+	/// @param[in] contexts The contexts to update.
+	/// @return True on success.
+	static bool UpdateContexts(Span<Context* const> contexts);
+	/// Renders several contexts in order, equivalent to calling Render() on each of them.
+	/// @param[in] contexts The contexts to render.
+	/// @return True on success.
+	static bool RenderContexts(Span<Context* const> contexts);
+
+	/// Returns the region of the context that has changed since the previous call to Render(), as found by the most recent call to Update().
+	/// Backends which preserve the framebuffer between frames only need to clear and redraw this region.
+	/// @return The dirty region in window coordinates, or an empty rectangle if nothing needs to be redrawn.
+	/// @note Backends presenting from several framebuffers in turn need to redraw the union of the dirty regions since the framebuffer was last
+	/// drawn. Such a region can be applied with RenderManager::SetRenderRegion() before calling Render().
+	Rectanglei GetDirtyRegion() const;
+	/// Returns true if the most recent call to Update() found any visual change since the previous call to Render(), such as changes to the
+	/// style, layout, geometry, animations, or scrolling of elements, or the blinking of a text cursor.
+	/// @return False if rendering would produce the same output as the previous frame. Then the application can skip Render() and present the
+	/// previous frame again, and combined with GetNextUpdateDelay() also skip updates until input arrives or the delay expires.
+	bool HasVisualChanges() const;
+	/// Enables partial redraws, where Render() only redraws the dirty region of the context and renders nothing when the region is empty.
+	/// @param[in] enable True to restrict rendering to the dirty region, false to render the whole context (default).
+	void SetPartialRedraw(bool enable);
+	/// Returns true if partial redraws are enabled.
+	bool IsPartialRedraw() const;
+
 	/// Creates a new, empty document and places it into this context.
 	/// @param[in] instancer_name The name of the instancer used to create the document.
 	/// @return The new document, or nullptr if no document could be created.
@@ -77,6 +112,58 @@ public:
 	/// @param[in] source_url Optional string used to set the document's source URL, or naming the document for log messages.
 	/// @return The loaded document, or nullptr if no document was loaded.
 	ElementDocument* LoadDocumentFromMemory(const String& document_rml, const String& source_url = "[document from memory]");
+	/// Queue a document to be loaded into the context during a later call to Update(), instead of loading it immediately.
+	/// @param[in] document_path The path to the document to load, see LoadDocument().
+	/// @param[in] on_loaded Optional callback invoked with the loaded document once it has been loaded, or nullptr if no document was loaded.
+	/// @note Queued documents are loaded in order at the start of Update(), as many as fit within the budget set by SetDocumentLoadBudget().
+	/// When a task interface is installed, the document is parsed through it in the meantime, leaving only its elements to be instanced
+	/// during the update.
+	void LoadDocumentAsync(const String& document_path, Function<void(ElementDocument*)> on_loaded = nullptr);
+	/// Load a document progressively, parsing and instancing its elements in steps during the following calls to Update().
+	/// @param[in] document_path The path to the document to load, see LoadDocument().
+	/// @param[in] on_loaded Optional callback invoked with the document once all of it has been loaded.
+	/// @return The document being loaded, or nullptr if the document could not be opened.
+	/// @note The document is added to the context right away, but like any loaded document it stays hidden until shown. It can be shown once
+	/// loaded, such as from the callback, or at any earlier point to display its contents as they are loaded. The steps share the budget set
+	/// by SetDocumentLoadBudget() with queued documents, and the 'load' event is dispatched once the document has been fully loaded.
+	ElementDocument* LoadDocumentProgressive(const String& document_path, Function<void(ElementDocument*)> on_loaded = nullptr);
+	/// Load a document without showing it, then close it again, so that its templates, style sheets, font faces, and textures are cached
+	/// for when the document is loaded later on.
+	/// @param[in] document_path The path to the document to preload, see LoadDocument().
+	/// @return True if the document was loaded.
+	/// @note The document is loaded as usual, including its 'load' event and scripts, and closed again before returning.
+	bool PreloadDocument(const String& document_path);
+	/// Queue a document to be preloaded during a later call to Update(), see PreloadDocument().
+	/// @param[in] document_path The path to the document to preload.
+	/// @note Preloaded documents share the queue and budget with documents queued by LoadDocumentAsync().
+	void PreloadDocumentAsync(const String& document_path);
+	/// Set the time budget for loading queued documents during each call to Update().
+	/// @param[in] budget_seconds The time after which no further queued documents are loaded during the current update. At least one queued
+	/// document is always loaded per update, unless it is still being parsed through the task interface.
+	void SetDocumentLoadBudget(double budget_seconds);
+	/// Leave the styles of elements within 'display: none' subtrees unresolved during updates, until the subtree is displayed again.
+	/// @param[in] defer True to skip the hidden subtrees during updates, in which case their computed values are resolved on demand.
+	/// @note Animations and transitions within hidden subtrees are paused while deferred.
+	void SetDeferHiddenStyles(bool defer);
+	/// Returns whether the styles of hidden subtrees are deferred, see SetDeferHiddenStyles().
+	bool GetDeferHiddenStyles() const;
+	/// Leave the layout of hidden documents unformatted during updates, until the document is shown again.
+	/// @param[in] defer True to skip formatting hidden documents, false to keep their layout up to date (the default).
+	/// @note Hiding and showing a document then retains its layout, which is only formatted again when shown if the document or the viewport
+	/// changed in the meantime. Layout queries of elements within hidden documents may be out of date while deferred.
+	void SetDeferHiddenLayout(bool defer);
+	/// Returns whether the layout of hidden documents is deferred, see SetDeferHiddenLayout().
+	bool GetDeferHiddenLayout() const;
+	/// Set a time budget for each call to Update(), after which non-critical work is deferred to the following updates.
+	/// @param[in] budget_seconds The time budget measured from the start of the update, or zero to disable the budget (the default).
+	/// @note Deferred work includes the instancing of lazy contents, updates of data models set to low priority, the regeneration of decorators and
+	/// filters after a change of the dp ratio, and the loading of queued and progressive documents. The next update is requested while any work is
+	/// deferred, see RequestNextUpdate().
+	void SetUpdateBudget(double budget_seconds);
+	/// Returns true if the update budget has been used up during the current update, see SetUpdateBudget().
+	bool IsUpdateBudgetExceeded() const;
+	/// Returns the number of documents queued by LoadDocumentAsync() or PreloadDocumentAsync() which have not yet been loaded.
+	int GetNumQueuedDocuments() const;
 	/// Unload the given document.
 	/// @param[in] document The document to unload.
 	/// @note The destruction of the document is deferred until the next call to Context::Update().
@@ -91,6 +178,8 @@ public:
 	void EnableMouseCursor(bool enable);
 
 	/// Activate or deactivate a media theme. Themes can be used in RCSS media queries.
+	/// @note Style sheets of the documents are recompiled during the next call to Update(), thus several themes can be toggled at once without
+	/// restyling the documents for each intermediate state.
 	/// @param theme_name[in] The name of the theme to (de)activate.
 	/// @param activate True to activate the given theme, false to deactivate.
 	void ActivateTheme(const String& theme_name, bool activate);
@@ -229,6 +318,31 @@ public:
 	/// @return True if no touch points are interacting with any elements in the context, otherwise false.
 	bool ProcessTouchCancel(const TouchList& touches);
 
+	/// Process a batch of input events in order, such as all the input received by the platform layer during a frame.
+	/// @param[in] batch The input events to process.
+	/// @return True if none of the events were consumed by the context, otherwise false.
+	/// @note The input is processed just like through the individual 'Process...()' functions, including input coalescing when enabled.
+	bool ProcessInputBatch(const InputBatch& batch);
+
+	/// Enable or disable coalescing of high-frequency input.
+	/// When enabled, mouse movements, mouse wheel movements, and touch movements are queued and merged with directly following input of the
+	/// same kind, then processed at the start of the next call to Update(). Any other input processes the queue first, thus the order of
+	/// input is preserved, such as presses and releases always happening at the latest mouse position.
+	/// @param[in] enable True to enable input coalescing, false to process all input immediately. Disabling processes any queued input.
+	/// @note While enabled, the queued functions return whether the mouse is interacting with any elements before the input is processed.
+	void SetInputCoalescing(bool enable);
+	/// Returns true if input coalescing is enabled.
+	bool IsInputCoalescing() const;
+
+	/// Enable or disable input processing.
+	/// When disabled, all 'Process...()' input functions are ignored and return true, and any ongoing interaction such as hover and active state
+	/// is released. This suits contexts that only display content, such as widgets placed in the game world, which are updated and rendered but
+	/// never interacted with.
+	/// @param[in] enable True to process input, which is the default, false to ignore all input.
+	void SetInputEnabled(bool enable);
+	/// Returns true if input processing is enabled.
+	bool IsInputEnabled() const;
+
 	/// Returns a hint on whether the mouse is currently interacting with any elements in this context, based on previously submitted
 	/// 'ProcessMouse...()' commands.
 	/// @note Interaction is determined irrespective of background and opacity. See the RCSS property 'pointer-events' to disable interaction for
@@ -244,6 +358,23 @@ public:
 	/// Retrieves the render manager which can be used to submit changes to the render state.
 	RenderManager& GetRenderManager();
 
+	/// Returns counters of the work performed by the context during its most recently completed frame. A frame ends with every call to Render(),
+	/// and covers all work since the previous call, including the update and any changes made by the application or by events in between.
+	const FrameStatistics& GetFrameStatistics() const;
+	/// Enable or disable recording the invalidations of each element, see FrameStatistics::element_invalidations.
+	/// @note Intended for diagnostics, such as to find elements which are restyled or formatted again every frame.
+	void SetElementInvalidationTracking(bool enable);
+	/// Returns true if the invalidations of each element are recorded.
+	bool IsElementInvalidationTracking() const;
+	/// Enable or disable recording the work performed by each data model, see FrameStatistics::data_models.
+	/// @note Measures the time of every data expression evaluated, intended for diagnostics.
+	void SetDataModelProfiling(bool enable);
+	/// Returns true if the work performed by each data model is recorded.
+	bool IsDataModelProfiling() const;
+	/// Returns the approximate memory usage of the documents and data models in this context.
+	/// @note Visits every element of the context, intended for diagnostics rather than to be called every frame.
+	ContextMemoryStats GetMemoryStats() const;
+
 	/// Retrieves the text input handler.
 	TextInputHandler* GetTextInputHandler() const;
 
@@ -304,21 +435,91 @@ private:
 	RenderManager* render_manager;
 
 	SmallUnorderedSet<String> active_themes;
+	// True when the active themes have changed since the media queries of the documents were last updated.
+	bool themes_dirty = false;
 
 	ContextInstancer* instancer;
 
 	using ElementSet = SmallOrderedSet<Element*>;
 	using ElementList = Vector<Element*>;
-	// Set of elements that are currently in hover state.
-	ElementSet hover_chain;
+	// Elements that are currently in hover state, ordered from the hover element up to the root.
+	ElementList hover_chain;
 	// List of elements that are currently in active state.
 	ElementList active_chain;
 	// History of windows that have had focus
 	ElementList document_focus_history;
+	// Elements with running animations or transitions, advanced directly at the start of every update. Elements removed from the context are
+	// pruned after the update.
+	Vector<ObserverPtr<Element>> animated_elements;
 
 	// Documents that have been unloaded from the context but not yet released.
 	OwnedElementList unloaded_documents;
 
+	// Window area changed since the previous update, accumulated from the elements.
+	Rectanglef dirty_region = Rectanglef::MakeInvalid();
+	// Render bounds of the elements with filters, which spread changes within their bounds, collected during the update.
+	Vector<Rectanglef> filter_regions;
+	// The region to redraw during the next render, invalid if nothing needs to be redrawn.
+	Rectanglei redraw_region = Rectanglei::MakeInvalid();
+	bool partial_redraw = false;
+
+	// Counters of the most recently completed frame.
+	FrameStatistics frame_statistics;
+	// Counters of the documents released during the current frame.
+	DocumentFrameStatistics released_document_statistics;
+	// Counters of the render manager at the end of the previous frame.
+	RenderStats previous_render_stats;
+
+	bool element_invalidation_tracking = false;
+	// The invalidations of each element during the current frame, while tracking is enabled.
+	UnorderedMap<const Element*, ElementInvalidations> element_invalidations;
+
+	bool data_model_profiling = false;
+
+	// A queued document being parsed in the background, see ParseQueuedDocument().
+	struct ParsedDocument;
+	struct QueuedDocument {
+		String document_path;
+		Function<void(ElementDocument*)> on_loaded;
+		bool preload;
+		// The parse submitted through the task interface, or nullptr to load the document from its path instead.
+		SharedPtr<ParsedDocument> parsed_document;
+	};
+	// Documents queued for loading during the next updates, along with their time budget per update.
+	Vector<QueuedDocument> queued_documents;
+	struct ProgressiveDocument {
+		UniquePtr<Stream> stream;
+		UniquePtr<XMLParser> parser;
+		ObserverPtr<Element> document;
+		Function<void(ElementDocument*)> on_loaded;
+	};
+	// Documents being loaded in steps during the next updates, sharing the time budget with the queued documents.
+	Vector<ProgressiveDocument> progressive_documents;
+	double document_load_budget = 0.005;
+
+	bool defer_hidden_styles = false;
+	bool defer_hidden_layout = false;
+
+	double update_budget = 0;
+	// The time at which the budget of the current update is used up, or negative when there is no budget or outside of updates.
+	double update_deadline = -1;
+
+	// Incremented by any change to the geometry or stacking context of our elements, invalidating the hit test indices of the elements.
+	uint64_t hit_test_generation = 1;
+
+	struct QueuedInput {
+		enum class Type { MouseMove, MouseWheel, TouchMove };
+		Type type;
+		int key_modifier_state;
+		Vector2i mouse_position;
+		Vector2f wheel_delta;
+		TouchList touches;
+	};
+	// High-frequency input queued for processing during the next update, when input coalescing is enabled.
+	Vector<QueuedInput> queued_input;
+	bool input_coalescing = false;
+	bool input_enabled = true;
+
 	// Root of the element tree.
 	ElementPtr root;
 	// The element that currently has input focus.
@@ -374,9 +575,15 @@ private:
 	// The element currently being dragged over. This is equivalent to hover, but only set while an element is being
 	// dragged, and excludes the dragged element.
 	Element* drag_hover;
-	// Set of elements that are currently being dragged over; this differs from the hover state as the dragged element
-	// itself can't be part of it.
-	ElementSet drag_hover_chain;
+	// Elements that are currently being dragged over, ordered like the hover chain; this differs from the hover state as the
+	// dragged element itself can't be part of it.
+	ElementList drag_hover_chain;
+
+	// Event parameters and element containers retained between input events, so that their memory can be reused.
+	Vector<Dictionary> event_parameters_pool;
+	Vector<ElementSet> element_set_pool;
+	Vector<ElementList> element_list_pool;
+	Vector<Vector<ObserverPtr<Element>>> observer_list_pool;
 
 	UnorderedMap<String, UniquePtr<DataModel>> data_models;
 
@@ -425,6 +632,44 @@ private:
 	// Releases all unloaded documents pending destruction.
 	void ReleaseUnloadedDocuments();
 
+	// Adds the given area to the region to be redrawn.
+	void AddDirtyRegion(Rectanglef region);
+	// Adds the render bounds of an element with filters, so that any changes within them are expanded to the whole bounds.
+	void AddFilterRegion(Rectanglef region);
+	// Marks the whole context to be redrawn.
+	void DirtyEntireRegion();
+	// Adds the region changed during the update to the region to be redrawn.
+	void UpdateRedrawRegion();
+
+	// Collects the counters of the frame that just ended, and resets them for the next frame.
+	void EndFrameStatistics();
+
+	// Submits a task to read the elements of a queued document on another thread, when a task interface is installed.
+	void ParseQueuedDocument(QueuedDocument& queued_document);
+	// Reads the linked style sheets of a parsed document which are not yet cached, and submits a task to parse them.
+	// @return True if a task was submitted.
+	bool ParseLinkedStyleSheets(const SharedPtr<ParsedDocument>& parsed_document);
+	// Instances the elements of a document parsed in the background and adds it to the context.
+	ElementDocument* LoadParsedDocument(ParsedDocument& parsed_document);
+	// Loads queued documents, then continues loading progressive documents, until the time budget is exceeded.
+	void LoadQueuedDocuments();
+	// Dispatches the 'load' event of a document once all of it has been instanced, and brings it up to date.
+	void FinishDocumentLoad(ElementDocument* document);
+
+	// Queues the input, merging it into the last queued input if they are of the same kind.
+	void QueueInput(QueuedInput&& input);
+	// Processes all queued input in order.
+	void ProcessQueuedInput();
+
+	// The steps of Update(), split around the layout so that the layout of several contexts can be formatted together.
+	void UpdateBeforeLayout();
+	// Advances the animations of all animated elements, or prunes the elements without any remaining animations.
+	void AdvanceAnimations();
+	void PruneAnimatedElements();
+	void CollectDirtyLayouts(ElementList& layout_documents, ElementList& layout_boundaries);
+	static void FormatDirtyLayouts(const ElementList& layout_documents, const ElementList& layout_boundaries);
+	void UpdateAfterLayout();
+
 	// Helper method to lookup TouchState by touch id.
 	TouchState* LookupTouch(TouchId identifier);
 	/// Process single touch movement for this context.
@@ -446,8 +691,12 @@ private:
 
 	// Sends the specified event to all elements in new_items that don't appear in old_items.
 	static void SendEvents(const ElementSet& old_items, const ElementSet& new_items, EventId id, const Dictionary& parameters);
+	// Sends the 'out' event to the elements only in the old chain, then the 'over' event to the elements only in the new chain. The chains
+	// are ordered from leaf to root, so that their shared ancestors are found as a common suffix in linear time.
+	void SendChainEvents(const ElementList& old_chain, const ElementList& new_chain, EventId out_id, EventId over_id, const Dictionary& parameters);
 
 	friend class Rml::Element;
+	friend class Rml::FrameStatisticsAccess;
 };
 
 } // namespace Rml
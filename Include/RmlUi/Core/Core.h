@@ -11,9 +11,14 @@ class Plugin;
 class Context;
 class FileInterface;
 class FontEngineInterface;
+class MemoryInterface;
+class ProfilingInterface;
 class RenderInterface;
 class SystemInterface;
+class TaskInterface;
 class TextInputHandler;
+struct MemoryStatistics;
+struct StartupStatistics;
 enum class DefaultActionPhase;
 
 /**
@@ -37,6 +42,15 @@ RMLUICORE_API void SetSystemInterface(SystemInterface* system_interface);
 /// Returns RmlUi's system interface.
 RMLUICORE_API SystemInterface* GetSystemInterface();
 
+/// Sets the interface through which the core library allocates its memory. This is not required to be called, but if it
+/// is, it must be called before Initialise() and before any other use of the library.
+/// @param[in] memory_interface A non-owning pointer to the application-specified memory interface.
+/// @lifetime The interface must be kept alive until the program exits, as some memory pools are only released during
+/// static destruction.
+RMLUICORE_API void SetMemoryInterface(MemoryInterface* memory_interface);
+/// Returns RmlUi's memory interface, or nullptr if none is set.
+RMLUICORE_API MemoryInterface* GetMemoryInterface();
+
 /// Sets the interface through which all rendering requests are made. This is not required to be called, but if it is,
 /// it must be called before Initialise(). If no render interface is specified, then all contexts must specify a render
 /// interface when created.
@@ -70,6 +84,49 @@ RMLUICORE_API void SetTextInputHandler(TextInputHandler* text_input_handler);
 /// Returns RmlUi's default implementation of a text input handler.
 RMLUICORE_API TextInputHandler* GetTextInputHandler();
 
+/// Sets the interface through which RmlUi runs work on the application's threads, instead of starting its own threads. This is not
+/// required to be called, but if it is, it must be called before Initialise().
+/// @param[in] task_interface A non-owning pointer to the application-specified implementation of a task interface.
+/// @lifetime The instance must be kept alive until after the call to Rml::Shutdown.
+RMLUICORE_API void SetTaskInterface(TaskInterface* task_interface);
+/// Returns RmlUi's task interface, or nullptr if none is installed.
+RMLUICORE_API TaskInterface* GetTaskInterface();
+
+/// Sets the interface receiving the profiling zones of RmlUi, only used when RmlUi is built with RMLUI_CUSTOM_PROFILING. This is not
+/// required to be called, but if it is, it must be called before Initialise().
+/// @param[in] profiling_interface A non-owning pointer to the application-specified implementation of a profiling interface.
+/// @lifetime The instance must be kept alive until after the call to Rml::Shutdown.
+RMLUICORE_API void SetProfilingInterface(ProfilingInterface* profiling_interface);
+/// Returns RmlUi's profiling interface, or nullptr if none is installed.
+RMLUICORE_API ProfilingInterface* GetProfilingInterface();
+
+/// Sets the number of elements allocated at once by the memory pools for elements, text elements, and their per-element style and
+/// layout data. The pools are allocated during initialisation and grow by this number whenever exhausted, after which released
+/// elements are recycled. This is not required to be called, but if it is, it must be called before Initialise().
+/// @param[in] num_elements The number of elements per pool allocation, or zero to use the default sizes.
+RMLUICORE_API void SetElementPoolSize(int num_elements);
+/// Sets the number of worker threads used to format documents concurrently. When several documents of a context need to be formatted
+/// in the same update, their layouts are calculated in parallel, while the results are still applied to the elements on the calling
+/// thread. This is not required to be called, but if it is, it must be called before Initialise().
+/// @param[in] num_threads The number of worker threads, or zero to format all documents on the calling thread (the default).
+/// @note When a task interface is installed, the layouts are calculated through it instead, as long as the number of threads is non-zero.
+/// @note Measuring text and replaced elements is serialized between the threads, as the font engine interface is not required to be thread-safe.
+RMLUICORE_API void SetLayoutThreadCount(int num_threads);
+/// Enables the rendering of plugin content in the background, such as SVG rasterization and Lottie frames. This is not required to be
+/// called, but if it is, it must be called before Initialise().
+/// @param[in] enable True to render in the background, or false to render on the calling thread when the content is needed (the default).
+/// @note The content is rendered through the task interface when installed, otherwise on a worker thread started by each plugin.
+RMLUICORE_API void SetBackgroundRendering(bool enable);
+
+/// Sets the number of strings whose translations are cached. Then, SystemInterface::TranslateString() is only called the first time each
+/// string is translated, until the translations are invalidated. The cache is disabled by default.
+/// @param[in] max_strings The maximum number of cached translations, or zero to disable the cache.
+RMLUICORE_API void SetTranslationCacheSize(int max_strings);
+/// Invalidates the cached translations, such that all strings are translated again through the system interface. Call this whenever the
+/// translations change, such as when switching the language.
+/// @note Existing text is not translated again, only newly instanced text and updated data views are affected.
+RMLUICORE_API void InvalidateTranslations();
+
 /// Creates a new element context.
 /// @param[in] name The new name of the context. This must be unique.
 /// @param[in] dimensions The initial dimensions of the new context.
@@ -79,6 +136,11 @@ RMLUICORE_API TextInputHandler* GetTextInputHandler();
 ///           Rml::Shutdown. Alternatively, the render interface can be destroyed after all contexts it belongs to have been
 ///           destroyed, and a subsequent call has been made to Rml::ReleaseRenderManagers.
 /// @return A non-owning pointer to the new context, or nullptr if the context could not be created.
+/// @note All contexts share the resources that are immutable once loaded: style sheets and their compiled combinations, templates, font faces,
+///       and the textures and geometry of contexts using the same render interface. Thus, many small contexts displaying the same documents are
+///       cheap to create. The shared resources are not synchronized, so all contexts must be updated and rendered from the same thread.
+///       Contexts that are only displayed, and never interacted with, can disable input with Context::SetInputEnabled(), and many contexts
+///       can be updated together with Context::UpdateContexts().
 RMLUICORE_API Context* CreateContext(const String& name, Vector2i dimensions, RenderInterface* render_interface = nullptr,
 	TextInputHandler* text_input_handler = nullptr);
 /// Removes and destroys a context.
@@ -120,6 +182,28 @@ RMLUICORE_API bool LoadFontFace(const String& file_path, bool fallback_face = fa
 RMLUICORE_API bool LoadFontFace(Span<const byte> data, const String& family, Style::FontStyle style,
 	Style::FontWeight weight = Style::FontWeight::Auto, bool fallback_face = false, int face_index = 0);
 
+/// Loads and caches a style sheet, so that documents linking to it later do not need to parse it.
+/// @param[in] path The path to the style sheet, as it is referenced by the documents.
+/// @return True if the style sheet was loaded.
+RMLUICORE_API bool PreloadStyleSheet(const String& path);
+/// Loads and caches several style sheets, parsing them concurrently when a task interface is installed.
+/// @param[in] paths The paths to the style sheets, as they are referenced by the documents.
+/// @return True if all the style sheets were loaded.
+RMLUICORE_API bool PreloadStyleSheets(const StringList& paths);
+/// Loads and caches a template, so that documents using it later do not need to parse it.
+/// @param[in] path The path to the template file.
+/// @return True if the template was loaded.
+RMLUICORE_API bool PreloadTemplate(const String& path);
+/// Generates the glyphs for the given characters of a font face, so that text using them does not need to rasterize them when it is first shown.
+/// @param[in] family The family of the font face.
+/// @param[in] style The style of the font face.
+/// @param[in] weight The weight of the font face.
+/// @param[in] size The size of the font face, in pixels.
+/// @param[in] characters The UTF-8 encoded characters to generate glyphs for.
+/// @return True if the font engine provided a font face for the given parameters.
+/// @note Documents and textures are preloaded by Context::PreloadDocument and RenderManager::PreloadTexture.
+RMLUICORE_API bool PreloadFontGlyphs(const String& family, Style::FontStyle style, Style::FontWeight weight, int size, const String& characters);
+
 /// Registers a generic RmlUi plugin.
 RMLUICORE_API void RegisterPlugin(Plugin* plugin);
 
@@ -151,9 +235,38 @@ RMLUICORE_API void ReleaseCompiledGeometry(RenderInterface* render_interface = n
 /// Releases unused font textures and rendered glyphs to free up memory, and regenerates actively used fonts.
 /// @note Invalidates all existing FontFaceHandles returned from the font engine.
 RMLUICORE_API void ReleaseFontResources();
+/// Releases font faces not used by any element, least recently used first, until the font textures and glyphs fit within the given budget.
+/// @param[in] budget_bytes The memory budget of the font engine, zero releases all font faces not in use.
+/// @note Unlike ReleaseFontResources, this keeps the font faces used by elements valid, and does not require documents to be updated.
+/// @note Memory statistics can be retrieved from FontEngineInterface::GetFontResourceStats.
+RMLUICORE_API void ReleaseUnusedFontResources(size_t budget_bytes = 0);
+/// Enables or disables rendering text from signed distance fields, so that all sizes of a font face share the same glyph textures.
+/// @param[in] enable True to render text from distance fields, false to rasterize the glyphs at each font size.
+/// @return True if the mode was applied, false if the font engine or any render interface does not support distance field text.
+/// @note Enabling requires the render interfaces to support the "distance-field-text" shader, see RenderInterface::SupportsShader.
+/// @note Invalidates all existing FontFaceHandles returned from the font engine.
+RMLUICORE_API bool SetFontDistanceFieldMode(bool enable);
+/// Serializes the glyphs and metrics of the fonts currently in use, so that they can be restored on a later run without rasterizing them again.
+/// @param[out] out_data The serialized font data, to be stored by the application.
+/// @return True if the font engine supports caching and the data was written, false otherwise.
+/// @note The data is only valid for the same version of RmlUi and the same font files.
+RMLUICORE_API bool SaveFontCache(Vector<byte>& out_data);
+/// Loads font data previously returned by SaveFontCache. Matching font faces are initialized from this data as they are first used.
+/// @param[in] data The serialized font data.
+/// @return True if the data was accepted, false if it is invalid, out of date, or caching is not supported by the font engine. Any
+///         previously accepted data is kept when the data is rejected.
+/// @note Should be called after initialization, before any documents are loaded.
+RMLUICORE_API bool LoadFontCache(Span<const byte> data);
 /// Releases render managers that are not used by any contexts.
 /// @note Any resources referring to the render manager in user space must be cleared first, including callback textures and compiled geometry.
 /// @note Also releases font resources, which invalidates all existing FontFaceHandles returned from the font engine.
 RMLUICORE_API void ReleaseRenderManagers();
 
+/// Returns the approximate memory usage of RmlUi, broken down by context and subsystem.
+/// @note Visits every element of every context, intended for diagnostics rather than to be called every frame.
+RMLUICORE_API MemoryStatistics GetMemoryStatistics();
+
+/// Returns the timing breakdown of the startup of RmlUi, from initialisation until the first document is loaded.
+RMLUICORE_API const StartupStatistics& GetStartupStatistics();
+
 } // namespace Rml
@@ -17,8 +17,22 @@ public:
 
 	bool IsVariableDirty(const String& variable_name);
 	void DirtyVariable(const String& variable_name);
+	// Dirty a single element of an array variable. Only views which depend on the given element, or on the array as a whole, are updated.
+	// @note Use this for elements which are modified or appended in-place. When elements are inserted or removed before the end of the
+	// array, the following elements shift their index, in which case the whole variable should be dirtied instead.
+	void DirtyVariable(const String& variable_name, int index);
 	void DirtyAllVariables();
 
+	// Watch a variable for changes, so that it no longer needs to be dirtied manually. The values of the variable are compared to their values
+	// from the previous update, and the variable is dirtied whenever they differ. Arrays are dirtied as a whole when their size changes, and
+	// otherwise by index for each changed element.
+	// @note All the scalar values of the variable are retrieved and compared on every update, consider dirtying large variables manually instead.
+	void WatchVariable(const String& variable_name);
+
+	// Set the model to low priority, so that its updates are deferred to later updates while the update budget of the context is used up.
+	// @note See Context::SetUpdateBudget().
+	void SetLowPriority(bool low_priority);
+
 	explicit operator bool() { return model; }
 
 private:
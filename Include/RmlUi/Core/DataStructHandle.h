@@ -99,6 +99,21 @@ private:
 	template <typename MemberType>
 	bool CreateMemberObjectDefinition(const String& name, MemberType Object::*member_ptr);
 
+	// Arithmetic and string members are accessed directly, other members through the definition of their type.
+	template <typename MemberType, typename std::enable_if_t<Detail::is_direct_data_scalar<MemberType>::value, int> = 0>
+	UniquePtr<VariableDefinition> MakeMemberObjectDefinition(MemberType Object::*member_ptr)
+	{
+		return Rml::MakeUnique<MemberScalarObjectDefinition<Object, MemberType>>(member_ptr);
+	}
+	template <typename MemberType, typename std::enable_if_t<!Detail::is_direct_data_scalar<MemberType>::value, int> = 0>
+	UniquePtr<VariableDefinition> MakeMemberObjectDefinition(MemberType Object::*member_ptr)
+	{
+		VariableDefinition* underlying_definition = type_register->GetDefinition<MemberType>();
+		if (!underlying_definition)
+			return nullptr;
+		return Rml::MakeUnique<MemberObjectDefinition<Object, MemberType>>(underlying_definition, member_ptr);
+	}
+
 	template <typename BasicReturnType, typename MemberType>
 	bool CreateMemberGetFuncDefinition(const String& name, MemberType Object::*member_get_func_ptr);
 
@@ -122,10 +137,10 @@ bool StructHandle<Object>::CreateMemberObjectDefinition(const String& name, Memb
 		"Illegal data member getter function signature. Make sure it takes no arguments and is not const qualified.");
 	static_assert(!std::is_const<MemberType>::value, "Data member objects cannot be const qualified.");
 
-	VariableDefinition* underlying_definition = type_register->GetDefinition<MemberType>();
-	if (!underlying_definition)
+	UniquePtr<VariableDefinition> definition = MakeMemberObjectDefinition(member_ptr);
+	if (!definition)
 		return false;
-	struct_definition->AddMember(name, Rml::MakeUnique<MemberObjectDefinition<Object, MemberType>>(underlying_definition, member_ptr));
+	struct_definition->AddMember(name, std::move(definition));
 	return true;
 }
 
@@ -33,6 +33,7 @@ template <typename Object, typename AssignType>
 using MemberSetterFunc = void (Object::*)(AssignType);
 
 using DirtyVariables = SmallUnorderedSet<String>;
+using DirtyVariableIndices = SmallUnorderedMap<String, SmallUnorderedSet<int>>;
 
 struct DataAddressEntry {
 	DataAddressEntry(String name) : name(std::move(name)), index(-1) {}
@@ -42,6 +43,13 @@ struct DataAddressEntry {
 };
 using DataAddress = Vector<DataAddressEntry>;
 
+struct DataVariableDependency {
+	String name;
+	// The index into the top-level array variable which the dependency is limited to, or -1 if it depends on the whole variable.
+	int index = -1;
+};
+using DataVariableDependencyList = Vector<DataVariableDependency>;
+
 template <class T>
 struct PointerTraits {
 	using is_pointer = std::false_type;
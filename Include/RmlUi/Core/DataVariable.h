@@ -26,6 +26,8 @@ public:
 
 	bool Get(Variant& variant) const;
 	bool Set(const Variant& variant);
+	// Retrieves the value converted to a string, same as getting it as a variant and then converting it.
+	bool GetString(String& out_string) const;
 	int Size() const;
 	DataVariable Child(const DataAddressEntry& address) const;
 	DataVariableType Type() const;
@@ -50,6 +52,8 @@ public:
 
 	virtual bool Get(void* ptr, Variant& variant);
 	virtual bool Set(void* ptr, const Variant& variant);
+	// Can be overridden to retrieve the value directly as a string, by default the value is retrieved as a variant and then converted.
+	virtual bool GetString(void* ptr, String& out_string);
 
 	virtual int Size(void* ptr);
 	virtual DataVariable Child(void* ptr, const DataAddressEntry& address);
@@ -66,6 +70,27 @@ private:
 // Literal data variable constructor
 RMLUICORE_API DataVariable MakeLiteralIntVariable(int value);
 
+namespace Detail {
+	// Converts scalar values to strings, strings are copied directly without going through a variant.
+	inline void ScalarToString(const String& value, String& out_string)
+	{
+		out_string = value;
+	}
+	template <typename T>
+	inline void ScalarToString(const T& value, String& out_string)
+	{
+		Variant variant;
+		variant = value;
+		out_string = variant.Get<String>();
+	}
+
+	// Scalars which are always read and written directly, they cannot be given custom definitions.
+	template <typename T>
+	struct is_direct_data_scalar {
+		static constexpr bool value = std::is_arithmetic<T>::value || std::is_same<T, String>::value;
+	};
+} // namespace Detail
+
 template <typename T>
 class ScalarDefinition final : public VariableDefinition {
 public:
@@ -77,6 +102,11 @@ public:
 		return true;
 	}
 	bool Set(void* ptr, const Variant& variant) override { return variant.GetInto<T>(*static_cast<T*>(ptr)); }
+	bool GetString(void* ptr, String& out_string) override
+	{
+		Detail::ScalarToString(*static_cast<const T*>(ptr), out_string);
+		return true;
+	}
 };
 
 class RMLUICORE_API FuncDefinition final : public VariableDefinition {
@@ -172,6 +202,7 @@ public:
 
 	bool Get(void* ptr, Variant& variant) override;
 	bool Set(void* ptr, const Variant& variant) override;
+	bool GetString(void* ptr, String& out_string) override;
 	int Size(void* ptr) override;
 	DataVariable Child(void* ptr, const DataAddressEntry& address) override;
 
@@ -205,6 +236,37 @@ private:
 	MemberType Object::* member_ptr;
 };
 
+// Member objects of arithmetic and string types, which are read and written directly instead of through their underlying definition.
+template <typename Object, typename MemberType>
+class MemberScalarObjectDefinition final : public VariableDefinition {
+public:
+	MemberScalarObjectDefinition(MemberType Object::* member_ptr) : VariableDefinition(DataVariableType::Scalar), member_ptr(member_ptr) {}
+
+	bool Get(void* ptr, Variant& variant) override
+	{
+		if (!ptr)
+			return false;
+		variant = static_cast<const Object*>(ptr)->*member_ptr;
+		return true;
+	}
+	bool Set(void* ptr, const Variant& variant) override
+	{
+		if (!ptr)
+			return false;
+		return variant.GetInto<MemberType>(static_cast<Object*>(ptr)->*member_ptr);
+	}
+	bool GetString(void* ptr, String& out_string) override
+	{
+		if (!ptr)
+			return false;
+		Detail::ScalarToString(static_cast<const Object*>(ptr)->*member_ptr, out_string);
+		return true;
+	}
+
+private:
+	MemberType Object::* member_ptr;
+};
+
 template <typename Object, typename MemberType, typename BasicReturnType>
 class MemberGetFuncDefinition final : public BasePointerDefinition {
 public:
@@ -34,11 +34,23 @@ public:
 	/// @param[in] element_data The element data handle to release.
 	virtual void ReleaseElementData(DecoratorDataHandle element_data) const = 0;
 
+	/// Called before generating element data, to allow elements to share the data instead of generating it for each element.
+	/// @param[in] element The element being decorated.
+	/// @param[in] paint_area Determines the element's area to be painted by the decorator.
+	/// @param[out] out_key A hash of everything the element data depends on, such as the size of the paint area and any properties used.
+	/// @return True if the element data only depends on the element through the key. Then elements with equal keys share the same data.
+	/// @note The default implementation returns false, generating separate data for each element.
+	virtual bool GetElementDataKey(Element* element, BoxArea paint_area, size_t& out_key) const;
+
 	/// Called to render the decorator on an element.
 	/// @param[in] element The element to render the decorator on.
 	/// @param[in] element_data The handle to the data generated by the decorator for the element.
 	virtual void RenderElement(Element* element, DecoratorDataHandle element_data) const = 0;
 
+	/// Returns true while any of the decorator's textures are being loaded asynchronously. The element data is generated again once they have
+	/// been loaded, as it may depend on their dimensions.
+	bool IsTextureLoading() const;
+
 	/// Value specifying an invalid or non-existent Decorator data handle.
 	/// @note This value will prevent the decorator from being rendered on the given element.
 	static const DecoratorDataHandle INVALID_DECORATORDATAHANDLE = 0;
@@ -99,6 +111,10 @@ private:
 	RenderManager& render_manager;
 	const StyleSheet& style_sheet;
 	const PropertySource* property_source;
+	// If set, records the sprites looked up and their results, with a null sprite sheet for sprites which were not found.
+	Vector<Pair<String, Sprite>>* sprite_lookups = nullptr;
+
+	friend class Rml::StyleSheet;
 };
 
 } // namespace Rml
@@ -16,16 +16,23 @@
 
 namespace Rml {
 
+class CompiledSelector;
 class Context;
 class DataModel;
+class DataViewFor;
 class Decorator;
 class ElementInstancer;
 class EventDispatcher;
 class EventListener;
 class ElementBackgroundBorder;
 class ElementDefinition;
+class ElementBatchUpdate;
 class ElementDocument;
+class ElementHitTestIndex;
+class ElementQueryIndex;
+class ElementRenderCache;
 class ElementScroll;
+class ElementScrollLayer;
 class ElementStyle;
 class LayoutEngine;
 class ContainerBox;
@@ -37,8 +44,10 @@ class RenderManager;
 class StyleSheet;
 class StyleSheetContainer;
 class TransformState;
+struct ElementClipCache;
 struct ElementMeta;
 struct StackingContextChild;
+enum class SelectorDependency : uint8_t;
 
 /**
     A generic element in the DOM tree.
@@ -153,6 +162,8 @@ public:
 	/// Checks if a given point in screen coordinates lies within the bordered area of this element.
 	/// @param[in] point The point to test.
 	/// @return True if the element is within this element, false otherwise.
+	/// @note During hit testing, this is only called for points within the element's border boxes, or its descendants' boxes if it has a
+	/// local stacking context.
 	virtual bool IsPointWithinElement(Vector2f point);
 
 	/// Returns the visibility of the element.
@@ -180,6 +191,22 @@ public:
 	/// @param[in] property The parsed property to set.
 	/// @return True if the property was set successfully, false otherwise.
 	bool SetProperty(PropertyId id, const Property& property);
+	/// Sets a local numeric property override on the element, such as a length, without parsing a string.
+	/// @param[in] id The id of the property to set.
+	/// @param[in] value The numeric value.
+	/// @param[in] unit The unit of the value, which must be accepted by the property.
+	/// @return True if the property was set successfully, false if the property does not accept the unit.
+	/// @note Setting a property to its current local value does nothing, so only changed properties need to be updated.
+	bool SetLength(PropertyId id, float value, Unit unit = Unit::PX);
+	/// Sets a local colour property override on the element without parsing a string.
+	/// @param[in] id The id of the property to set.
+	/// @param[in] colour The colour, in non-premultiplied alpha.
+	/// @return True if the property was set successfully, false if the property does not accept colours.
+	bool SetColour(PropertyId id, Colourb colour);
+	/// Sets the local 'transform' property override on the element without parsing a string.
+	/// @param[in] transform The transform, or nullptr for no transform.
+	/// @return True if the property was set successfully.
+	bool SetTransform(TransformPtr transform);
 	/// Removes a local property override on the element; its value will revert to that defined in the style sheet.
 	/// @param[in] name The name of the local property definition to remove.
 	void RemoveProperty(const String& name);
@@ -539,15 +566,23 @@ public:
 	/// @return The first matching element during a depth-first traversal.
 	/// @performance Prefer GetElementById/TagName/ClassName whenever possible.
 	Element* QuerySelector(const String& selector);
+	/// Returns the first descendent element matching the compiled selector, see QuerySelector(const String&).
+	/// @performance Avoids parsing the selector on every call.
+	Element* QuerySelector(const CompiledSelector& selector);
 	/// Returns all descendent elements matching the RCSS selector query.
 	/// @param[out] elements The list of matching elements.
 	/// @param[in] selector The selector or comma-separated selectors to match against.
 	/// @performance Prefer GetElementById/TagName/ClassName whenever possible.
 	void QuerySelectorAll(ElementList& elements, const String& selector);
+	/// Returns all descendent elements matching the compiled selector, see QuerySelectorAll(ElementList&, const String&).
+	/// @performance Avoids parsing the selector on every call.
+	void QuerySelectorAll(ElementList& elements, const CompiledSelector& selector);
 	/// Checks if the element matches the given RCSS selector query.
 	/// @param[in] selector The selector or comma-separated selectors to match against.
 	/// @return True if the element matches the given RCSS selector query, false otherwise.
 	bool Matches(const String& selector);
+	/// Checks if the element matches the compiled selector.
+	bool Matches(const CompiledSelector& selector);
 	/// Checks if the provided element is a descendant of the current element.
 	/// @param[in] element The element to test with.
 	/// @return True if the provided element is a descendant of this element, false otherwise.
@@ -587,8 +622,16 @@ public:
 	/// Return the computed values of the element's properties. These values are updated as appropriate on every Context::Update.
 	const ComputedValues& GetComputedValues() const;
 
+	/// Invalidates the cached rendering of this element and of any ancestors, see the 'render-cache' property, and marks the area covered by
+	/// the element as dirty in its context, see Context::GetDirtyRegion(). This is done automatically when properties, layout, attributes,
+	/// text, or children change. Custom elements must call this whenever they render something different for any other reason.
+	void DirtyRenderCache();
+
 protected:
 	void Update(float dp_ratio, Vector2f vp_dimensions);
+	/// Generates the geometry of this element and its descendants ahead of rendering, after layout has been updated. Adds the area covered by
+	/// any changed elements to the dirty region of the given context.
+	void PrepareRender(Context* context);
 	void Render();
 
 	/// Updates definition, computed values, and runs OnPropertyChange on this element.
@@ -601,6 +644,8 @@ protected:
 	virtual void OnUpdate();
 	/// Called during render after backgrounds, borders, decorators, but before children, are rendered.
 	virtual void OnRender();
+	/// Called at the end of the update loop for visible elements, after layout. Any geometry needed for rendering can be generated here.
+	virtual void OnPrepareRender();
 	/// Called during update if the element size has been changed.
 	virtual void OnResize();
 	/// Called during a layout operation, when the element is being positioned and sized.
@@ -646,10 +691,12 @@ protected:
 	enum class DirtyNodes { Self, SelfAndSiblings };
 	// Dirty the element style definition, including all descendants of the specified nodes.
 	void DirtyDefinition(DirtyNodes dirty_nodes);
+	// Dirty the element style definition of the given nodes relative to this element.
+	void DirtyDefinition(SelectorDependency dependency);
 
 	void SetOwnerDocument(ElementDocument* document);
 
-	void OnStyleSheetChangeRecursive();
+	void OnStyleSheetChangeRecursive(const StyleSheetContainer& style_sheet_container);
 
 	void Release() override;
 
@@ -658,20 +705,46 @@ private:
 
 	void SetDataModel(DataModel* new_data_model);
 
+	// Moves a DOM child in front of another DOM child. Unlike removing and inserting it again, the child stays attached to the document
+	// along with its data bindings.
+	void MoveChildBefore(Element* child, Element* adjacent_element);
+
 	void DirtyAbsoluteOffset();
-	void DirtyAbsoluteOffsetRecursive();
 	void UpdateAbsoluteOffsetAndRenderBoxData();
 	void UpdateOffset();
+	/// Submits this element's clipping region to the render manager, reusing the retained state from a previous frame when nothing
+	/// affecting clipping has changed since.
+	/// @return False if the element is not attached to a context, true otherwise.
+	bool ApplyClippingRegion();
+	/// Returns the retained clipping state of this element, resolving it again if anything affecting clipping has changed.
+	ElementClipCache& GetValidClipCache();
+	/// Invalidates the retained clipping state of this element and its descendants.
+	void DirtyClipCache();
+	/// Invalidates the hit test indices of our context, after the geometry of this element or its descendants has changed.
+	void DirtyHitTestIndices();
 	void SetBaseline(float baseline);
 
 	void BuildLocalStackingContext();
 	void AddChildrenToStackingContext(Vector<StackingContextChild>& stacking_children);
 	void AddToStackingContext(Vector<StackingContextChild>& stacking_children, bool is_flex_item, bool is_non_dom_element);
 	void DirtyStackingContext();
+	// Stores the attribute value, updating any existing value in place, and notifies the element of the change.
+	void SetAttributeVariant(const String& name, Variant&& value);
+	// Calls OnAttributeChange() with only the given attribute, the value is empty if the attribute was removed.
+	void NotifyAttributeChange(const String& name, Variant&& value);
+
+	// Propagates the changes collected during the outermost batch update, see ElementBatchUpdate.
+	static void FlushBatchUpdate();
 
 	void UpdateDefinition();
 
 	void DirtyTransformState(bool perspective_dirty, bool transform_dirty);
+
+	// Adds the area covered by this element when last rendered to the dirty region of its context, and updates the area during the next
+	// prepare phase.
+	void DirtyRenderBounds();
+	// Dirties the render bounds of this element and all its descendants, for changes that affect the rendering of the whole subtree.
+	void DirtyRenderBoundsRecursive();
 	void UpdateTransformState();
 
 	void OnDpRatioChangeRecursive();
@@ -700,30 +773,65 @@ private:
 
 	/// Advances the animations (including transitions) forward in time.
 	void AdvanceAnimations();
+	/// Adds the element to the animated elements of its context, if it has any animations and is not already added.
+	void RegisterAnimations();
 
-	// State flags are packed together for compact data layout.
-	bool local_stacking_context;
-	bool local_stacking_context_forced;
-	bool stacking_context_dirty;
-	bool computed_values_are_default_initialized;
+	/// Returns true if the element, including its stacking context, is entirely outside the region it is rendered to.
+	bool IsOutsideRenderRegion(RenderManager& render_manager);
 
-	bool visible; // True if the element is visible and active.
+	/// Marks the element and its descendants as skipped by style updates.
+	void SkipStyleUpdates();
+	/// Resolves the properties of an element skipped by style updates, along with those of its skipped ancestors.
+	void UpdateSkippedStyle();
 
-	bool offset_fixed;
-	bool absolute_offset_dirty;
+	/// Instances the contents of a lazy element once neither it nor any of its ancestors have 'display: none'.
+	void UpdateLazyContents();
+
+	// The state read while walking the element tree during updates, layout, rendering, and dirty propagation is kept together at the start of
+	// the element, so that the walks touch as few cache lines as possible. State flags are packed into bit fields for the same reason.
+	bool local_stacking_context : 1;
+	bool local_stacking_context_forced : 1;
+	bool stacking_context_dirty : 1;
+	bool computed_values_are_default_initialized : 1;
+
+	bool visible : 1; // True if the element is visible and active.
+
+	bool offset_fixed : 1;
+	bool absolute_offset_dirty : 1;
 	bool rounded_main_padding_size_dirty : 1;
 
-	bool dirty_definition : 1; // Implies dirty child definitions as well.
-	bool dirty_child_definitions : 1;
+	bool dirty_definition : 1;
+	bool dirty_child_definitions : 1; // Implies dirty definitions of all descendants.
+
+	bool dirty_layout : 1;
+	bool dirty_child_layout : 1; // Set on all ancestors of an element with dirty layout, up to and including its document.
 
 	bool dirty_animation : 1;
 	bool dirty_transition : 1;
 	bool dirty_transform : 1;
+	bool dirty_local_transform : 1; // Implies dirty transform, set when our own transform properties or box change, but not our ancestors.
 	bool dirty_perspective : 1;
+	bool dirty_render_bounds : 1;
+
+	bool lazy_contents : 1; // Set while the contents of an element with the 'lazy' attribute have not yet been instanced.
+	bool skipped_style : 1; // Set on all descendants of 'display: none' elements while deferred, see Context::SetDeferHiddenStyles().
+	bool animations_registered : 1; // Set while the element is part of the animated elements of its context.
 
-	OwnedElementList children;
 	int num_non_dom_children;
 
+	// Parent element.
+	Element* parent;
+	// The owning document
+	ElementDocument* owner_document;
+
+	ElementMeta* meta;
+
+	OwnedElementList children;
+
+	ElementList stacking_context;
+
+	ElementAnimationList animations;
+
 	// Defines which box area to use for clipping; this is usually padding, but may be content.
 	BoxArea clip_area;
 
@@ -736,12 +844,8 @@ private:
 	// Instancer that created us, used for destruction.
 	ElementInstancer* instancer;
 
-	// Parent element.
-	Element* parent;
 	// Currently focused child object
 	Element* focus;
-	// The owning document
-	ElementDocument* owner_document;
 
 	// Active data model for this element.
 	DataModel* data_model;
@@ -754,6 +858,10 @@ private:
 	Vector2f relative_offset_position; // the offset of a relatively positioned element
 
 	Vector2f absolute_offset;
+	// Generation at which the absolute offset was last validated against our ancestors, and generation of the latest change to the offsets of
+	// this element or its ancestors that affects our descendants. Used for lazily updating absolute offsets.
+	uint64_t absolute_offset_validated_generation;
+	uint64_t absolute_offset_changed_generation;
 	Vector2f rounded_main_padding_size;
 
 	// The offset this element adds to its logical children due to scrolling content.
@@ -774,14 +882,8 @@ private:
 	float baseline;
 	float z_index;
 
-	ElementList stacking_context;
-
 	UniquePtr<TransformState> transform_state;
 
-	ElementAnimationList animations;
-
-	ElementMeta* meta;
-
 	friend class Rml::Context;
 	friend class Rml::ElementStyle;
 	friend class Rml::ContainerBox;
@@ -789,7 +891,28 @@ private:
 	friend class Rml::ReplacedBox;
 	friend class Rml::LayoutEngine;
 	friend class Rml::ElementScroll;
+	friend class Rml::ElementBackgroundBorder;
+	friend class Rml::ElementHitTestIndex;
+	friend class Rml::ElementQueryIndex;
+	friend class Rml::ElementRenderCache;
+	friend class Rml::ElementScrollLayer;
+	friend class Rml::ElementBatchUpdate;
+	friend class Rml::DataViewFor;
 	friend RMLUICORE_API void Rml::ReleaseFontResources();
+	friend RMLUICORE_API bool Rml::SetFontDistanceFieldMode(bool);
+};
+
+/**
+    Defers the propagation of changes through the element tree while in scope, such as while adding or removing a large number of elements.
+
+    Changes to elements, such as to their children, attributes, and properties, flag their ancestors for layout and rendering. Within a batch,
+    the changed elements are collected instead, and their ancestors are flagged once when the outermost batch ends. This avoids walking up the
+    same ancestors for every change. Batches can be nested. The batch must end before the next update of the context.
+ */
+class RMLUICORE_API ElementBatchUpdate : NonCopyMoveable {
+public:
+	ElementBatchUpdate();
+	~ElementBatchUpdate();
 };
 
 } // namespace Rml
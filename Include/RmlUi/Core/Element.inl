@@ -15,11 +15,7 @@ T Element::GetProperty(const String& name)
 template <typename T>
 void Element::SetAttribute(const String& name, const T& value)
 {
-	Variant variant(value);
-	attributes[name] = variant;
-	ElementAttributes changed_attributes;
-	changed_attributes.emplace(name, std::move(variant));
-	OnAttributeChange(changed_attributes);
+	SetAttributeVariant(name, Variant(value));
 }
 
 template <typename T>
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "Element.h"
+#include "FrameStatistics.h"
 
 namespace Rml {
 
 class Context;
+class FrameStatisticsAccess;
 class Stream;
 class DocumentHeader;
 class ElementText;
@@ -61,6 +63,7 @@ public:
 	const StyleSheet* GetStyleSheet() const override;
 	/// Reload the document's style sheet from source files.
 	/// Styles will be reloaded from <style> tags and external style sheets, but not inline 'style' attributes.
+	/// Only the external style sheets whose files changed are parsed again, and only elements matched by changed rules are restyled.
 	/// @note The source url originally used to load the document must still be a valid RML document.
 	void ReloadStyleSheet();
 
@@ -149,6 +152,10 @@ private:
 
 	/// Updates the layout if necessary.
 	void UpdateLayout();
+	/// Returns the size of the containing block the document is formatted against.
+	Vector2f GetLayoutContainingBlock();
+	/// Returns true if the layout of the document depends on the size of its containing block, that is, the viewport.
+	bool IsLayoutDependentOnViewport() const;
 
 	/// Updates the position of the document based on the style properties.
 	void UpdatePosition();
@@ -168,8 +175,12 @@ private:
 	bool layout_dirty;
 	bool position_dirty;
 
+	// Work performed on the elements of this document since the end of the context's previous render.
+	DocumentFrameStatistics frame_statistics;
+
 	friend class Rml::Context;
 	friend class Rml::Factory;
+	friend class Rml::FrameStatisticsAccess;
 };
 
 } // namespace Rml
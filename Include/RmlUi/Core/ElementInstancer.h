@@ -2,6 +2,7 @@
 
 #include "Element.h"
 #include "Header.h"
+#include "MemoryInterface.h"
 #include "Profiling.h"
 #include "Traits.h"
 #include "Types.h"
@@ -9,6 +10,7 @@
 namespace Rml {
 
 class Element;
+struct MemoryPoolStats;
 
 /**
     An element instancer provides a method for allocating
@@ -64,31 +66,56 @@ public:
 };
 
 /**
-    Generic Instancer that creates the provided element type using new and delete. This instancer
-    is typically used for specialized element types.
+    Generic Instancer that creates the provided element type on the heap. This instancer is
+    typically used for specialized element types. The memory of released elements is kept in a
+    free list and reused for new elements, up to a limited number of elements.
  */
 
 template <typename T>
 class ElementInstancerGeneric : public ElementInstancer {
 public:
-	virtual ~ElementInstancerGeneric() {}
+	virtual ~ElementInstancerGeneric()
+	{
+		for (void* memory : free_list)
+			Detail::Deallocate(memory, sizeof(T), alignof(T));
+	}
 
 	ElementPtr InstanceElement(Element* /*parent*/, const String& tag, const XMLAttributes& /*attributes*/) override
 	{
 		RMLUI_ZoneScopedN("ElementGenericInstance");
-		return ElementPtr(new T(tag));
+		void* memory = nullptr;
+		if (free_list.empty())
+		{
+			memory = Detail::Allocate(sizeof(T), alignof(T));
+		}
+		else
+		{
+			memory = free_list.back();
+			free_list.pop_back();
+		}
+		return ElementPtr(new (memory) T(tag));
 	}
 
 	void ReleaseElement(Element* element) override
 	{
 		RMLUI_ZoneScopedN("ElementGenericRelease");
-		delete element;
+		T* object = static_cast<T*>(element);
+		object->~T();
+		if (free_list.size() < max_free_list_size)
+			free_list.push_back(object);
+		else
+			Detail::Deallocate(object, sizeof(T), alignof(T));
 	}
+
+private:
+	static constexpr size_t max_free_list_size = 256;
+	Vector<void*> free_list;
 };
 
 namespace Detail {
-	void InitializeElementInstancerPools();
+	void InitializeElementInstancerPools(int pool_size);
 	void ShutdownElementInstancerPools();
+	void GetElementInstancerPoolStats(Vector<MemoryPoolStats>& out_pools);
 } // namespace Detail
 
 } // namespace Rml
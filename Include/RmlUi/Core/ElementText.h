@@ -45,7 +45,8 @@ public:
 	/// Prevents the element from dirtying its document's layout when its text is changed.
 	void SuppressAutoLayout();
 
-	// Used to store the position and length of each line we have geometry for.
+	// Used to store the position and length of each line we have geometry for. For long texts, geometry is only generated for lines near the
+	// visible area, the width of any other lines is left as zero.
 	struct Line {
 		Line(String text, Vector2f position) : text(std::move(text)), position(position), width(0) {}
 		String text;
@@ -59,6 +60,7 @@ public:
 	const LineList& GetLines() const { return lines; }
 
 protected:
+	void OnPrepareRender() override;
 	void OnRender() override;
 
 	void OnPropertyChange(const PropertyIdSet& properties) override;
@@ -71,6 +73,8 @@ private:
 
 	// Clears and regenerates all of the text's geometry.
 	void GenerateGeometry(RenderManager& render_manager, FontFaceHandle font_face_handle);
+	// Returns the vertical range of the element's clipping region relative to its absolute offset, or false if the range cannot be determined.
+	bool GetVisibleRange(float& out_top, float& out_bottom);
 	// Generates any geometry necessary for rendering decoration (underline, strike-through, etc).
 	void GenerateDecoration(Mesh& mesh, FontFaceHandle font_face_handle);
 
@@ -81,6 +85,7 @@ private:
 	struct TexturedGeometry {
 		Geometry geometry;
 		Texture texture;
+		SharedPtr<const CompiledShader> shader;
 	};
 	Vector<TexturedGeometry> geometry;
 
@@ -94,6 +99,11 @@ private:
 
 	bool geometry_dirty : 1;
 
+	// True if geometry was only generated for the lines within the culling range, relative to the element's absolute offset.
+	bool geometry_culled : 1;
+	float geometry_culling_top;
+	float geometry_culling_bottom;
+
 	bool dirty_layout_on_change : 1;
 
 	// What the decoration type is that we have generated.
@@ -105,6 +115,10 @@ private:
 
 	bool font_effects_dirty;
 	FontEffectsHandle font_effects_handle;
+
+	// The text split into tokens at its break opportunities, built once per text change and reused by every call to GenerateLine.
+	struct TokenCache;
+	UniquePtr<TokenCache> token_cache;
 };
 
 } // namespace Rml
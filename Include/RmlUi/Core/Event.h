@@ -10,6 +10,7 @@ namespace Rml {
 class Factory;
 class Element;
 class EventInstancer;
+class EventInstancerDefault;
 struct EventSpecification;
 
 enum class EventPhase { None, Capture = 1, Target = 2, Bubble = 4 };
@@ -94,6 +95,11 @@ protected:
 	Element* current_element = nullptr;
 
 private:
+	/// Reinitializes a released event for reuse, retaining the memory of its parameters.
+	void Reinitialize(Element* target, EventId id, const String& type, const Dictionary& parameters, bool interruptible);
+	/// Reads the mouse position from the parameters, if available.
+	void InitializeMousePosition();
+
 	/// Project the mouse coordinates to the current element to enable
 	/// interacting with transformed elements.
 	void ProjectMouse(Element* element);
@@ -116,6 +122,7 @@ private:
 	EventInstancer* instancer = nullptr;
 
 	friend class Rml::Factory;
+	friend class Rml::EventInstancerDefault;
 };
 
 } // namespace Rml
@@ -75,6 +75,14 @@ public:
 	/// @param[in] text The text to instance the element (or elements) from.
 	/// @return True if the string was parsed without error, false otherwise.
 	static bool InstanceElementText(Element* parent, const String& text);
+	/// Instances a text element containing a string, caching the parse so that the same string can be instanced repeatedly without parsing it again.
+	/// @param[in] parent The element any instanced elements will be parented to.
+	/// @param[in] text The text to instance the element (or elements) from.
+	/// @param[in,out] parse_events The parse events of the text, recorded during the first call and replayed on later calls. Must only be
+	/// used with the same text.
+	/// @return True if the string was parsed without error, false otherwise.
+	/// @note The text is only translated during the first call when it contains RML.
+	static bool InstanceElementText(Element* parent, const String& text, XMLParseEventList& parse_events);
 	/// Instances an element tree based on the stream.
 	/// @param[in] parent The element the stream elements will be added to.
 	/// @param[in] stream The stream to read the element RML from.
@@ -128,6 +136,8 @@ public:
 	/// Creates a style sheet from a Stream.
 	/// @param[in] stream A pointer to the stream containing the style sheet's contents.
 	/// @return A pointer to the newly created style sheet.
+	/// @note Parsed style sheets are cached by their source URL and contents, instancing the same contents again does not parse them. The cache
+	/// is released by ClearStyleSheetCache().
 	static SharedPtr<StyleSheetContainer> InstanceStyleSheetStream(Stream* stream);
 	/// Clears the style sheet cache. This will force style sheets to be reloaded.
 	static void ClearStyleSheetCache();
@@ -56,6 +56,17 @@ public:
 	/// @param out_data The string contents of the file.
 	/// @return True on success.
 	virtual bool LoadFile(const String& path, String& out_data);
+
+	/// Maps a file into memory for read-only access, so that its contents can be used without copying them.
+	/// The default implementation does not support mapping, then files are read through the functions above instead.
+	/// @param path The path to the file to map.
+	/// @param[out] out_data The contents of the file, which must remain valid until the mapping is released.
+	/// @param[out] out_handle A handle owning the mapping, to be passed to UnmapFile() when the contents are no longer used.
+	/// @return True if the file was mapped, false if mapping is not supported for this file.
+	virtual bool MapFile(const String& path, Span<const byte>& out_data, FileMappingHandle& out_handle);
+	/// Releases a mapping previously made through MapFile().
+	/// @param handle The handle of the mapping.
+	virtual void UnmapFile(FileMappingHandle handle);
 };
 
 } // namespace Rml
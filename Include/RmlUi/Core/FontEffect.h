@@ -31,8 +31,18 @@ public:
 	/// @param[in] destination_dimensions The dimensions of the glyph's area on its texture.
 	/// @param[in] destination_stride The stride of the glyph's texture.
 	/// @param[in] glyph The glyph the effect is being asked to generate an effect texture for.
+	/// @note When a task interface is installed, this may be called concurrently from several threads for different glyphs of the same texture.
 	virtual void GenerateGlyphTexture(byte* destination_data, Vector2i destination_dimensions, int destination_stride, const FontGlyph& glyph) const;
 
+	/// Requests the parameters for rendering the effect from the distance field of the text, used in place of the effect's glyph textures when
+	/// the font engine renders text from distance fields.
+	/// @param[out] outline_width The distance the glyph shapes are expanded by, in pixels.
+	/// @param[out] blur_width The width of the smooth transition along the edge of the expanded shapes, in pixels.
+	/// @param[out] offset The offset of the effect relative to the text, in pixels.
+	/// @return True if the effect can be rendered this way, false to skip the effect when rendering from distance fields. The default
+	/// implementation returns false.
+	virtual bool GetDistanceFieldParameters(float& outline_width, float& blur_width, Vector2f& offset) const;
+
 	/// Sets the colour of the effect's geometry.
 	void SetColour(Colourb colour);
 	/// Returns the effect's colour.
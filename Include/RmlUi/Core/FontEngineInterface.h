@@ -9,6 +9,15 @@
 
 namespace Rml {
 
+/**
+    Memory statistics of the resources held by a font engine.
+ */
+struct FontResourceStats {
+	int num_face_handles = 0; // Number of sized font faces.
+	size_t texture_bytes = 0; // Size of the textures generated for rendering text [bytes].
+	size_t glyph_bytes = 0;   // Size of the rasterized glyph bitmaps [bytes].
+};
+
 /**
     The abstract base class for an application-specific font engine implementation.
 
@@ -76,6 +85,16 @@ public:
 	virtual int GetStringWidth(FontFaceHandle handle, StringView string, const TextShapingContext& text_shaping_context,
 		Character prior_character = Character::Null);
 
+	/// Called by RmlUi when it wants to retrieve the width of every prefix of a string, such as when breaking a word across lines.
+	/// @param[in] handle The font handle.
+	/// @param[in] string The string to measure.
+	/// @param[in] text_shaping_context Additional parameters that provide context for text shaping.
+	/// @param[in] prior_character The optionally-specified character that immediately precedes the string.
+	/// @param[out] out_prefix_widths The width of the string up to and including each of its code points, one entry per code point.
+	/// @note The default implementation measures each prefix separately using GetStringWidth.
+	virtual void GetStringPrefixWidths(FontFaceHandle handle, StringView string, const TextShapingContext& text_shaping_context,
+		Character prior_character, Vector<int>& out_prefix_widths);
+
 	/// Called by RmlUi when it wants to retrieve the meshes required to render a single line of text.
 	/// @param[in] render_manager The render manager responsible for rendering the string.
 	/// @param[in] face_handle The font handle.
@@ -99,6 +118,32 @@ public:
 	/// Called by RmlUi when it wants to garbage collect memory used by fonts.
 	/// @note All existing FontFaceHandles and FontEffectsHandles are considered invalid after this call.
 	virtual void ReleaseFontResources();
+
+	/// Called by RmlUi when it wants to release font resources which are not currently in use.
+	/// @param[in] used_handles The font face handles currently used by elements, these must remain valid.
+	/// @param[in] budget_bytes Font faces not in use should be released, least recently used first, until the resources of the font engine fit
+	/// within this size.
+	virtual void ReleaseUnusedFontResources(const UnorderedSet<FontFaceHandle>& used_handles, size_t budget_bytes);
+
+	/// Returns memory statistics of the resources held by the font engine.
+	virtual FontResourceStats GetFontResourceStats();
+
+	/// Called by RmlUi when the application wants text to be rendered from signed distance fields, using the "distance-field-text" shader
+	/// of the render interface. This lets all sizes of a font face share the same glyph textures.
+	/// @param[in] enable True to render text from distance fields, false to render rasterized glyphs at each size.
+	/// @return True if the mode was applied, false if distance fields are not supported by the font engine.
+	/// @note All existing FontFaceHandles and FontEffectsHandles are considered invalid after this call.
+	virtual bool SetDistanceFieldMode(bool enable);
+
+	/// Called by RmlUi when the application wants to store the glyphs and metrics of the fonts currently in use, to be loaded on a later run.
+	/// @param[out] out_data The serialized font data.
+	/// @return True if the font engine supports caching and the data was written, false otherwise.
+	virtual bool SaveFontCache(Vector<byte>& out_data);
+
+	/// Called by RmlUi when the application provides font data previously returned by SaveFontCache.
+	/// @param[in] data The serialized font data.
+	/// @return True if the data was accepted, false if it is invalid, out of date, or caching is not supported.
+	virtual bool LoadFontCache(Span<const byte> data);
 };
 
 } // namespace Rml
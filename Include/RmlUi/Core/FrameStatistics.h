@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Types.h"
+
+namespace Rml {
+
+/**
+    Counters of the work performed on the elements of a single document.
+ */
+struct DocumentFrameStatistics {
+	int num_definition_updates = 0;         // Number of elements whose style definition was updated.
+	int num_computed_values = 0;            // Number of elements whose dirty properties were computed.
+	int num_layout_formats = 0;             // Number of layout engine invocations, each formatting an element or a dirty layout boundary.
+	int num_layout_boxes = 0;               // Number of element boxes set by the layout engine.
+	int num_layout_measures = 0;            // Number of text and replaced elements measured, not counting sizes retained from earlier layouts.
+	int num_text_geometry_rebuilds = 0;     // Number of times the geometry of a text element was generated.
+	int num_background_border_rebuilds = 0; // Number of times the background and border geometry of an element was generated.
+	int num_culled_elements = 0;            // Number of elements not rendered for being outside their clipping region or the viewport.
+};
+
+inline DocumentFrameStatistics& operator+=(DocumentFrameStatistics& a, const DocumentFrameStatistics& b)
+{
+	a.num_definition_updates += b.num_definition_updates;
+	a.num_computed_values += b.num_computed_values;
+	a.num_layout_formats += b.num_layout_formats;
+	a.num_layout_boxes += b.num_layout_boxes;
+	a.num_layout_measures += b.num_layout_measures;
+	a.num_text_geometry_rebuilds += b.num_text_geometry_rebuilds;
+	a.num_background_border_rebuilds += b.num_background_border_rebuilds;
+	a.num_culled_elements += b.num_culled_elements;
+	return a;
+}
+
+/**
+    Number of times a single element was invalidated during a frame.
+ */
+struct ElementInvalidations {
+	int num_definition_updates = 0;       // Number of times the style definition of the element was updated.
+	int num_layout_dirties = 0;           // Number of times the layout of the element was dirtied.
+	int num_geometry_rebuilds = 0;        // Number of times the background, border, or text geometry of the element was generated.
+	int num_stacking_context_dirties = 0; // Number of times the stacking context of the element was dirtied.
+};
+
+/**
+    Counters of the work performed by a single data model during a frame.
+ */
+struct DataModelStatistics {
+	int num_updates = 0;                                 // Number of times the model was updated.
+	double update_time = 0;                              // Time spent updating the model, including its views and expressions, in seconds.
+	int num_dirty_variables = 0;                         // Number of dirty variables and dirty elements of array variables during the updates.
+	int num_view_updates = 0;                            // Number of views updated.
+	SmallUnorderedMap<String, int> view_updates_by_type; // Number of views updated by their type name, such as 'if' or 'for'.
+	int num_expression_runs = 0;                         // Number of data expressions evaluated.
+	double expression_time = 0;                          // Time spent evaluating data expressions, in seconds.
+	int num_for_rows_inserted = 0;                       // Number of rows inserted by 'data-for' views.
+	int num_for_rows_removed = 0;                        // Number of rows removed by 'data-for' views.
+	int num_for_rows_moved = 0;                          // Number of rows moved to another position by keyed 'data-for' views.
+};
+
+/**
+    Cumulative counters of the work submitted to the render interface by a render manager.
+ */
+struct RenderStats {
+	uint64_t num_draw_calls = 0;          // Number of geometry draws, including shaders, instanced and batched geometry.
+	uint64_t num_texture_uploads = 0;     // Number of textures generated, loaded, or updated through the render interface.
+	uint64_t compiled_geometry_bytes = 0; // Size of the vertices and indices compiled through the render interface [bytes].
+};
+
+/**
+    Counters of the work performed by a context during a frame, that is, since the end of its previous call to Context::Render().
+ */
+struct FrameStatistics {
+	struct Document {
+		String source_url; // Empty if the document was not loaded from a file.
+		String id;
+		DocumentFrameStatistics statistics;
+	};
+
+	// Sum of the counters of all documents, including documents unloaded during the frame.
+	DocumentFrameStatistics total;
+	// The counters of each document in the context at the end of the frame, in document order.
+	Vector<Document> documents;
+
+	// Work submitted to the render interface by the context's render manager during the frame. This includes work by other contexts sharing the
+	// same render manager, if any of them were updated or rendered in the meantime.
+	int num_draw_calls = 0;
+	int num_texture_uploads = 0;
+	size_t compiled_geometry_bytes = 0;
+
+	// The invalidations of each element during the frame, only recorded while enabled by Context::SetElementInvalidationTracking(). The
+	// elements may have been destroyed since, thus they should only be used to look up the counters of elements found otherwise.
+	UnorderedMap<const Element*, ElementInvalidations> element_invalidations;
+
+	// The work performed by each data model during the frame by model name, only recorded while enabled by Context::SetDataModelProfiling().
+	UnorderedMap<String, DataModelStatistics> data_models;
+};
+
+} // namespace Rml
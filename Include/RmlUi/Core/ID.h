@@ -128,6 +128,7 @@ enum class PropertyId : uint8_t {
 	Opacity,
 	PointerEvents,
 	Focus,
+	RenderCache,
 
 	Decorator,
 	MaskImage,
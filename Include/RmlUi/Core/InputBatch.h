@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Header.h"
+#include "Input.h"
+#include "Types.h"
+
+namespace Rml {
+
+/**
+    A compact buffer of input events, filled by the platform layer while polling events, and then processed all at once using
+    Context::ProcessInputBatch().
+
+    Directly following mouse movements, mouse wheel movements, touch movements, and text input are merged as they are added. The buffer keeps
+    its memory when cleared, thus it can be filled anew every frame without allocating.
+ */
+class RMLUICORE_API InputBatch {
+public:
+	enum class Type : uint8_t {
+		KeyDown,
+		KeyUp,
+		TextInput,
+		MouseMove,
+		MouseButtonDown,
+		MouseButtonUp,
+		MouseWheel,
+		MouseLeave,
+		TouchStart,
+		TouchMove,
+		TouchEnd,
+		TouchCancel,
+	};
+
+	struct Event {
+		Type type;
+		int key_modifier_state;
+		// The key identifier or mouse button index, or the offset into the text or touch buffer, depending on the type.
+		int index;
+		// The number of bytes of text or the number of touches.
+		int count;
+		// The mouse position or the mouse wheel delta.
+		Vector2f value;
+	};
+
+	void KeyDown(Input::KeyIdentifier key_identifier, int key_modifier_state);
+	void KeyUp(Input::KeyIdentifier key_identifier, int key_modifier_state);
+	/// Adds text input, either a single Unicode character or a null-terminated UTF-8 string.
+	void TextInput(Character character);
+	void TextInput(const char* utf8_string);
+
+	void MouseMove(int x, int y, int key_modifier_state);
+	void MouseButtonDown(int button_index, int key_modifier_state);
+	void MouseButtonUp(int button_index, int key_modifier_state);
+	void MouseWheel(Vector2f wheel_delta, int key_modifier_state);
+	void MouseLeave();
+
+	void TouchStart(const Touch& touch, int key_modifier_state);
+	void TouchMove(const Touch& touch, int key_modifier_state);
+	void TouchEnd(const Touch& touch, int key_modifier_state);
+	void TouchCancel(const Touch& touch);
+
+	/// Removes all events while keeping the allocated memory.
+	void Clear();
+	bool IsEmpty() const { return events.empty(); }
+
+	const Vector<Event>& GetEvents() const { return events; }
+	/// Returns the text of a text input event.
+	StringView GetText(const Event& event) const;
+	/// Returns the touches of a touch event.
+	Span<const Touch> GetTouches(const Event& event) const;
+
+private:
+	Event* GetMergeableEvent(Type type, int key_modifier_state);
+	void AddEvent(Type type, int key_modifier_state, int index, int count = 0, Vector2f value = {});
+	void AddTouch(Type type, const Touch& touch, int key_modifier_state);
+
+	Vector<Event> events;
+	String text;
+	TouchList touches;
+};
+
+} // namespace Rml
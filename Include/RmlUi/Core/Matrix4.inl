@@ -1,5 +1,49 @@
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define RMLUI_MATRIX4_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+	#include <arm_neon.h>
+	#define RMLUI_MATRIX4_NEON
+#endif
+
 namespace Rml {
 
+namespace Detail {
+	// Returns the sum of the given vectors, each scaled by the corresponding component of the weights. Matrix products reduce to this
+	// operation when the vectors are stored along the direction of the result, such as the columns of column-major matrices.
+	template <typename Component>
+	inline Vector4<Component> LinearCombination(const Vector4<Component> (&vectors)[4], const Vector4<Component>& weights) noexcept
+	{
+		return vectors[0] * weights.x + vectors[1] * weights.y + vectors[2] * weights.z + vectors[3] * weights.w;
+	}
+
+#if defined(RMLUI_MATRIX4_SSE2)
+	inline Vector4<float> LinearCombination(const Vector4<float> (&vectors)[4], const Vector4<float>& weights) noexcept
+	{
+		const __m128 w = _mm_loadu_ps(&weights.x);
+		__m128 sum = _mm_mul_ps(_mm_loadu_ps(&vectors[0].x), _mm_shuffle_ps(w, w, _MM_SHUFFLE(0, 0, 0, 0)));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&vectors[1].x), _mm_shuffle_ps(w, w, _MM_SHUFFLE(1, 1, 1, 1))));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&vectors[2].x), _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 2, 2))));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&vectors[3].x), _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 3, 3))));
+		Vector4<float> result;
+		_mm_storeu_ps(&result.x, sum);
+		return result;
+	}
+#elif defined(RMLUI_MATRIX4_NEON)
+	inline Vector4<float> LinearCombination(const Vector4<float> (&vectors)[4], const Vector4<float>& weights) noexcept
+	{
+		const float32x4_t w = vld1q_f32(&weights.x);
+		float32x4_t sum = vmulq_laneq_f32(vld1q_f32(&vectors[0].x), w, 0);
+		sum = vmlaq_laneq_f32(sum, vld1q_f32(&vectors[1].x), w, 1);
+		sum = vmlaq_laneq_f32(sum, vld1q_f32(&vectors[2].x), w, 2);
+		sum = vmlaq_laneq_f32(sum, vld1q_f32(&vectors[3].x), w, 3);
+		Vector4<float> result;
+		vst1q_f32(&result.x, sum);
+		return result;
+	}
+#endif
+} // namespace Detail
+
 template <typename Component, class Storage>
 Matrix4<Component, Storage>::Matrix4(const typename Matrix4<Component, Storage>::VectorType& vec0,
 	const typename Matrix4<Component, Storage>::VectorType& vec1, const typename Matrix4<Component, Storage>::VectorType& vec2,
@@ -557,8 +601,8 @@ struct Matrix4<Component, Storage>::VectorMultiplier<_Component, ColumnMajorStor
 
 	static const VectorType Multiply(const MatrixAType& lhs, const VectorType& rhs) noexcept
 	{
-		typename MatrixAType::ConstRows rows(lhs.vectors);
-		return VectorType(rhs.DotProduct(rows[0]), rhs.DotProduct(rows[1]), rhs.DotProduct(rows[2]), rhs.DotProduct(rows[3]));
+		// The columns weighted by the vector components, instead of dot products with the strided rows.
+		return Detail::LinearCombination(lhs.vectors, rhs);
 	}
 };
 
@@ -588,6 +632,25 @@ struct Matrix4<Component, Storage>::MatrixMultiplier<_Component, RowMajorStorage
 	}
 };
 
+template <typename Component, class Storage>
+template <typename _Component>
+struct Matrix4<Component, Storage>::MatrixMultiplier<_Component, RowMajorStorage<_Component>, RowMajorStorage<_Component>> {
+	typedef _Component ComponentType;
+	typedef RowMajorStorage<ComponentType> StorageAType;
+	typedef RowMajorStorage<ComponentType> StorageBType;
+	typedef Matrix4<ComponentType, StorageAType> MatrixAType;
+	typedef Matrix4<ComponentType, StorageBType> MatrixBType;
+
+	static const MatrixAType Multiply(const MatrixAType& lhs, const MatrixBType& rhs) noexcept
+	{
+		// Each row of the result is the combination of the rows of rhs weighted by the corresponding row of lhs.
+		typename MatrixAType::ThisType result;
+		for (int i = 0; i < 4; ++i)
+			result.vectors[i] = Detail::LinearCombination(rhs.vectors, lhs.vectors[i]);
+		return result;
+	}
+};
+
 template <typename Component, class Storage>
 template <typename _Component>
 struct Matrix4<Component, Storage>::MatrixMultiplier<_Component, ColumnMajorStorage<_Component>, ColumnMajorStorage<_Component>> {
@@ -599,17 +662,10 @@ struct Matrix4<Component, Storage>::MatrixMultiplier<_Component, ColumnMajorStor
 
 	static const MatrixAType Multiply(const MatrixAType& lhs, const MatrixBType& rhs) noexcept
 	{
+		// Each column of the result is the combination of the columns of lhs weighted by the corresponding column of rhs.
 		typename MatrixAType::ThisType result;
-		typename MatrixAType::Rows result_rows(result.vectors);
-		typename MatrixAType::ConstRows lhs_rows(lhs.vectors);
-		typename MatrixBType::ConstColumns rhs_columns(rhs.vectors);
-		for (int i = 0; i < 4; ++i)
-		{
-			for (int j = 0; j < 4; ++j)
-			{
-				result_rows[i][j] = rhs_columns[j].DotProduct(lhs_rows[i]);
-			}
-		}
+		for (int j = 0; j < 4; ++j)
+			result.vectors[j] = Detail::LinearCombination(lhs.vectors, rhs.vectors[j]);
 		return result;
 	}
 };
@@ -627,3 +683,6 @@ struct Matrix4<Component, Storage>::MatrixMultiplier<_Component, ColumnMajorStor
 };
 
 } // namespace Rml
+
+#undef RMLUI_MATRIX4_SSE2
+#undef RMLUI_MATRIX4_NEON
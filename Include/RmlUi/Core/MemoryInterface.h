@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Header.h"
+#include "Traits.h"
+#include <cstddef>
+
+namespace Rml {
+
+/**
+    RmlUi's memory interface lets the application take over the allocations made by the core library.
+
+    When set, the memory of elements, element pools, and other internal memory pools is allocated through this interface.
+    Standard containers and strings are not affected by default, they can be routed through the interface by using
+    MemoryAllocator in a custom configuration file, see RMLUI_CUSTOM_CONFIGURATION_FILE.
+ */
+
+class RMLUICORE_API MemoryInterface : public NonCopyMoveable {
+public:
+	MemoryInterface();
+	virtual ~MemoryInterface();
+
+	/// Allocate a block of memory.
+	/// @param[in] size The size of the block [bytes], never zero.
+	/// @param[in] alignment The required alignment of the block, a power of two.
+	/// @return A pointer to the new block. Must not be null, allocation failures are not handled by the library.
+	virtual void* Allocate(size_t size, size_t alignment) = 0;
+
+	/// Release a block of memory previously returned from Allocate().
+	/// @param[in] pointer The block to release.
+	/// @param[in] size The size of the block, as passed to Allocate().
+	/// @param[in] alignment The alignment of the block, as passed to Allocate().
+	virtual void Deallocate(void* pointer, size_t size, size_t alignment) = 0;
+};
+
+namespace Detail {
+	/// Allocate memory through the memory interface if one is set, otherwise through the global operator new.
+	RMLUICORE_API void* Allocate(size_t size, size_t alignment);
+	/// Release memory returned from Detail::Allocate().
+	RMLUICORE_API void Deallocate(void* pointer, size_t size, size_t alignment);
+} // namespace Detail
+
+/**
+    Standard allocator making its allocations through the memory interface.
+ */
+
+template <typename T>
+class MemoryAllocator {
+public:
+	using value_type = T;
+
+	MemoryAllocator() noexcept = default;
+	template <typename U>
+	MemoryAllocator(const MemoryAllocator<U>&) noexcept
+	{}
+
+	T* allocate(size_t n) { return static_cast<T*>(Detail::Allocate(n * sizeof(T), alignof(T))); }
+	void deallocate(T* pointer, size_t n) noexcept { Detail::Deallocate(pointer, n * sizeof(T), alignof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(const MemoryAllocator<T>&, const MemoryAllocator<U>&) noexcept
+{
+	return true;
+}
+template <typename T, typename U>
+bool operator!=(const MemoryAllocator<T>&, const MemoryAllocator<U>&) noexcept
+{
+	return false;
+}
+
+} // namespace Rml
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "FontEngineInterface.h"
+#include "RenderManager.h"
+#include "Types.h"
+
+namespace Rml {
+
+/**
+    Memory usage of a memory pool.
+ */
+struct MemoryPoolStats {
+	const char* name = "";
+	int num_used_objects = 0;  // Number of objects currently allocated from the pool.
+	int num_objects = 0;       // Number of objects the pool has reserved memory for, used or not.
+	size_t reserved_bytes = 0; // Size of the memory reserved by the pool, zero if unknown [bytes].
+};
+
+/**
+    Approximate memory usage of the documents and data models of a context.
+ */
+struct ContextMemoryStats {
+	String name;
+	int num_documents = 0;
+	int num_elements = 0; // Number of elements in all documents, including text elements.
+	// Size of the attributes, inline style, text, and child lists of the elements [bytes]. The elements themselves are reported by the element
+	// memory pools, unless they were instanced by custom element instancers.
+	size_t element_content_bytes = 0;
+	int num_data_models = 0;
+	int num_data_variables = 0;
+	int num_data_views = 0;
+};
+
+/**
+    Approximate memory usage of RmlUi, broken down by subsystem.
+
+    Sizes are estimated from the contents of each subsystem, and do not include any overhead of the underlying allocator.
+ */
+struct MemoryStatistics {
+	Vector<ContextMemoryStats> contexts;
+	// Memory pools shared by all contexts, such as for elements and layout nodes.
+	Vector<MemoryPoolStats> pools;
+	// Size of the meshes of all geometry held by the render managers [bytes].
+	size_t geometry_bytes = 0;
+	// Textures loaded from files by all render managers.
+	FileTextureStats file_textures;
+	// Resources held by the font engine.
+	FontResourceStats fonts;
+	// Number of style sheets cached after being loaded from files.
+	int num_cached_style_sheets = 0;
+
+	// Sum of the sizes above, including the resident file textures, and the font textures and glyphs.
+	size_t total_bytes = 0;
+};
+
+} // namespace Rml
@@ -6,6 +6,8 @@
 
 namespace Rml {
 
+class CompiledShader;
+
 struct RMLUICORE_API Mesh {
 	Vector<Vertex> vertices;
 	Vector<int> indices;
@@ -18,6 +20,8 @@ struct RMLUICORE_API Mesh {
 struct RMLUICORE_API TexturedMesh {
 	Mesh mesh;
 	Texture texture;
+	// Optional shader to render the mesh with, such as for text rendered from distance fields.
+	SharedPtr<const CompiledShader> shader;
 };
 
 using TexturedMeshList = Vector<TexturedMesh>;
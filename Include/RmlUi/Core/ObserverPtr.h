@@ -6,6 +6,8 @@
 
 namespace Rml {
 
+struct MemoryPoolStats;
+
 namespace Detail {
 	struct RMLUICORE_API ObserverPtrBlock {
 		int num_observers;
@@ -15,6 +17,7 @@ namespace Detail {
 	RMLUICORE_API void DeallocateObserverPtrBlockIfEmpty(ObserverPtrBlock* block);
 	void InitializeObserverPtrPool();
 	void ShutdownObserverPtrPool();
+	MemoryPoolStats GetObserverPtrPoolStats();
 } // namespace Detail
 
 template <typename T>
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Header.h"
+#include "Types.h"
+
+namespace Rml {
+
+class Element;
+
+/**
+    The phases of a frame measured by the built-in profiler.
+ */
+enum class ProfilerPhase { DataModels, Style, Layout, Render, Count };
+
+/**
+    Lightweight built-in profiler, an alternative to Tracy for platforms where it is not available.
+
+    When RmlUi is built with RMLUI_BUILTIN_PROFILING, the existing profiling zones record their timings while the profiler is enabled.
+    Frames are delimited by RMLUI_FrameMark, as placed by the backends, or by calling MarkFrame() directly. The timings of recent frames
+    are kept in a ring buffer, while the detailed breakdown is kept for the most recently completed frame. The debugger plugin presents
+    these results in its profiler panel.
+ */
+namespace Profiler {
+	struct ZoneTiming {
+		const char* name;
+		// Time spent in the zone including and excluding nested zones, in seconds.
+		double total_time;
+		double self_time;
+		int count;
+	};
+	struct DocumentTiming {
+		String name;
+		// Time spent in the elements of the document per phase, in seconds.
+		double phase_times[size_t(ProfilerPhase::Count)];
+	};
+	struct ElementTiming {
+		String address;
+		String document;
+		// Time spent in the element, excluding the time spent in child elements, in seconds.
+		double time;
+	};
+	struct FrameTiming {
+		// Time since the previous frame mark, in seconds.
+		double frame_time;
+		double phase_times[size_t(ProfilerPhase::Count)];
+	};
+
+	/// The breakdown of a single frame, zones and elements are sorted by descending time.
+	struct FrameBreakdown {
+		FrameTiming timing;
+		Vector<ZoneTiming> zones;
+		Vector<DocumentTiming> documents;
+		Vector<ElementTiming> elements;
+	};
+
+	/// Returns true if RmlUi was built with the built-in profiler.
+	RMLUICORE_API bool IsAvailable();
+
+	/// Enables or disables recording, the profiler is disabled by default.
+	RMLUICORE_API void SetEnabled(bool enabled);
+	RMLUICORE_API bool IsEnabled();
+
+	/// Completes the current frame and starts recording the next one. Called by RMLUI_FrameMark.
+	RMLUICORE_API void MarkFrame();
+
+	/// Returns the timings of recently completed frames, from the oldest to the most recent frame.
+	RMLUICORE_API Vector<FrameTiming> GetFrameHistory();
+	/// Returns the breakdown of the most recently completed frame.
+	RMLUICORE_API const FrameBreakdown& GetLastFrame();
+
+	/// Erases all recorded results.
+	RMLUICORE_API void Clear();
+
+	/// Called when an element is destroyed so that no dangling references to it are kept.
+	RMLUICORE_API void OnElementDestroy(Element* element);
+
+	/// Static source location of a profiling zone, registered with the profiler on first use.
+	struct Zone {
+		constexpr Zone(const char* name) : name(name) {}
+		const char* name;
+		int index = -1;
+	};
+
+	/// Times the enclosing scope as a zone.
+	class RMLUICORE_API ZoneScope : NonCopyMoveable {
+	public:
+		ZoneScope(Zone& zone);
+		~ZoneScope();
+
+	private:
+		int zone_index;
+		double start_time;
+		double nested_time;
+		ZoneScope* parent;
+	};
+
+	/// Times the enclosing scope as a phase of the frame.
+	class RMLUICORE_API PhaseScope : NonCopyMoveable {
+	public:
+		PhaseScope(ProfilerPhase phase);
+		~PhaseScope();
+
+	private:
+		ProfilerPhase phase;
+		double start_time;
+	};
+
+	/// Attributes the time spent in the enclosing scope to an element and its document, excluding nested element scopes.
+	class RMLUICORE_API ElementScope : NonCopyMoveable {
+	public:
+		ElementScope(Element* element, ProfilerPhase phase);
+		~ElementScope();
+
+	private:
+		Element* element;
+		Element* document;
+		ProfilerPhase phase;
+		double start_time;
+		double nested_time;
+		ElementScope* parent;
+
+		friend void OnElementDestroy(Element* element);
+	};
+} // namespace Profiler
+
+} // namespace Rml
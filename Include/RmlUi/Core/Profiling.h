@@ -24,6 +24,72 @@
 	#define RMLUI_FrameMarkStart(name) FrameMarkStart(name)
 	#define RMLUI_FrameMarkEnd(name) FrameMarkEnd(name)
 
+	#define RMLUI_ZonePhase(phase)
+	#define RMLUI_ZoneElement(element, phase)
+
+#elif defined(RMLUI_BUILTIN_PROFILING)
+
+	#include "Profiler.h"
+
+	#define RMLUI_PROFILER_CONCAT_IMPL(a, b) a##b
+	#define RMLUI_PROFILER_CONCAT(a, b) RMLUI_PROFILER_CONCAT_IMPL(a, b)
+
+	#define RMLUI_ZoneNamedN(varname, name, active)                             \
+		static ::Rml::Profiler::Zone RMLUI_PROFILER_CONCAT(varname, _zone){name}; \
+		::Rml::Profiler::ZoneScope varname(RMLUI_PROFILER_CONCAT(varname, _zone))
+	#define RMLUI_ZoneNamed(varname, active) RMLUI_ZoneNamedN(varname, __func__, active)
+	#define RMLUI_ZoneNamedC(varname, color, active) RMLUI_ZoneNamedN(varname, __func__, active)
+	#define RMLUI_ZoneNamedNC(varname, name, color, active) RMLUI_ZoneNamedN(varname, name, active)
+
+	#define RMLUI_ZoneScoped RMLUI_ZoneNamedN(RMLUI_PROFILER_CONCAT(rmlui_zone_, __LINE__), __func__, true)
+	#define RMLUI_ZoneScopedN(name) RMLUI_ZoneNamedN(RMLUI_PROFILER_CONCAT(rmlui_zone_, __LINE__), name, true)
+	#define RMLUI_ZoneScopedC(color) RMLUI_ZoneScoped
+	#define RMLUI_ZoneScopedNC(name, color) RMLUI_ZoneScopedN(name)
+
+	#define RMLUI_ZoneText(txt, size)
+	#define RMLUI_ZoneName(txt, size)
+
+	#define RMLUI_TracyPlot(name, val)
+
+	#define RMLUI_FrameMark ::Rml::Profiler::MarkFrame()
+	#define RMLUI_FrameMarkNamed(name)
+	#define RMLUI_FrameMarkStart(name)
+	#define RMLUI_FrameMarkEnd(name)
+
+	// Attributes the enclosing scope to a phase of the frame, or to an element during the given phase.
+	#define RMLUI_ZonePhase(phase) ::Rml::Profiler::PhaseScope RMLUI_PROFILER_CONCAT(rmlui_phase_, __LINE__)(phase)
+	#define RMLUI_ZoneElement(element, phase) ::Rml::Profiler::ElementScope RMLUI_PROFILER_CONCAT(rmlui_element_, __LINE__)(element, phase)
+
+#elif defined(RMLUI_CUSTOM_PROFILING)
+
+	#include "ProfilingInterface.h"
+
+	#define RMLUI_PROFILER_CONCAT_IMPL(a, b) a##b
+	#define RMLUI_PROFILER_CONCAT(a, b) RMLUI_PROFILER_CONCAT_IMPL(a, b)
+
+	#define RMLUI_ZoneNamedN(varname, name, active) ::Rml::ProfilingInterfaceZone varname(name)
+	#define RMLUI_ZoneNamed(varname, active) RMLUI_ZoneNamedN(varname, __func__, active)
+	#define RMLUI_ZoneNamedC(varname, color, active) RMLUI_ZoneNamedN(varname, __func__, active)
+	#define RMLUI_ZoneNamedNC(varname, name, color, active) RMLUI_ZoneNamedN(varname, name, active)
+
+	#define RMLUI_ZoneScoped RMLUI_ZoneNamedN(RMLUI_PROFILER_CONCAT(rmlui_zone_, __LINE__), __func__, true)
+	#define RMLUI_ZoneScopedN(name) RMLUI_ZoneNamedN(RMLUI_PROFILER_CONCAT(rmlui_zone_, __LINE__), name, true)
+	#define RMLUI_ZoneScopedC(color) RMLUI_ZoneScoped
+	#define RMLUI_ZoneScopedNC(name, color) RMLUI_ZoneScopedN(name)
+
+	#define RMLUI_ZoneText(txt, size)
+	#define RMLUI_ZoneName(txt, size)
+
+	#define RMLUI_TracyPlot(name, val) ::Rml::ProfilingInterfaceSetCounter(name, double(val))
+
+	#define RMLUI_FrameMark ::Rml::ProfilingInterfaceMarkFrame(nullptr)
+	#define RMLUI_FrameMarkNamed(name) ::Rml::ProfilingInterfaceMarkFrame(name)
+	#define RMLUI_FrameMarkStart(name)
+	#define RMLUI_FrameMarkEnd(name)
+
+	#define RMLUI_ZonePhase(phase)
+	#define RMLUI_ZoneElement(element, phase)
+
 #else
 
 	#define RMLUI_ZoneNamed(varname, active)
@@ -46,4 +112,7 @@
 	#define RMLUI_FrameMarkStart(name)
 	#define RMLUI_FrameMarkEnd(name)
 
+	#define RMLUI_ZonePhase(phase)
+	#define RMLUI_ZoneElement(element, phase)
+
 #endif
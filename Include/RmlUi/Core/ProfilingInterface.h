@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Header.h"
+#include "Traits.h"
+#include "Types.h"
+
+namespace Rml {
+
+/**
+    RmlUi's profiling interface lets the application forward the profiling zones of the library to its own profiler.
+
+    When RmlUi is built with RMLUI_CUSTOM_PROFILING, the profiling zones, counters, and frame marks otherwise used by Tracy are passed to the
+    installed interface, such as the zones of context updates and rendering, layout, element rendering, style definitions, and data models.
+    Without an installed interface, each zone costs a single branch. Without RMLUI_CUSTOM_PROFILING, the zones are compiled out entirely.
+
+    Zones may be entered on any thread that RmlUi runs work on, such as the layout worker threads, thus the implementation must be thread
+    safe. Zones are always properly nested on each thread.
+
+    @see Rml::SetProfilingInterface()
+ */
+class RMLUICORE_API ProfilingInterface : public NonCopyMoveable {
+public:
+	ProfilingInterface();
+	virtual ~ProfilingInterface();
+
+	/// Called when entering a profiling zone.
+	/// @param[in] name The name of the zone, a string with static storage duration.
+	virtual void BeginZone(const char* name) = 0;
+	/// Called when leaving the most recently entered zone on the calling thread.
+	virtual void EndZone() = 0;
+
+	/// Called when a counter is updated, such as the number of used layout nodes.
+	/// @param[in] name The name of the counter, a string with static storage duration.
+	/// @param[in] value The new value of the counter.
+	virtual void SetCounter(const char* name, double value);
+
+	/// Called at the end of each frame, as marked by the backends.
+	/// @param[in] name The name of a secondary frame set, or nullptr for the main frame.
+	virtual void MarkFrame(const char* name);
+};
+
+/// Calls the installed profiling interface for the enclosing scope, used by the profiling macros with RMLUI_CUSTOM_PROFILING.
+class RMLUICORE_API ProfilingInterfaceZone : NonCopyMoveable {
+public:
+	explicit ProfilingInterfaceZone(const char* name);
+	~ProfilingInterfaceZone();
+
+private:
+	ProfilingInterface* profiling_interface;
+};
+
+/// Passes a counter value to the installed profiling interface, used by the profiling macros with RMLUI_CUSTOM_PROFILING.
+RMLUICORE_API void ProfilingInterfaceSetCounter(const char* name, double value);
+/// Passes a frame mark to the installed profiling interface, used by the profiling macros with RMLUI_CUSTOM_PROFILING.
+RMLUICORE_API void ProfilingInterfaceMarkFrame(const char* name);
+
+} // namespace Rml
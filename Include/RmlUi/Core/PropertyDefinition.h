@@ -45,6 +45,9 @@ public:
 	/// Returns the target for resolving values with percent and possibly number units.
 	RelativeTarget GetRelativeTarget() const;
 
+	/// Returns the units of the values accepted by the parsers of this property, as far as they are known.
+	Units GetUnits() const;
+
 	/// Return the property id
 	PropertyId GetId() const;
 
@@ -61,6 +64,7 @@ private:
 	};
 
 	Vector<ParserState> parsers;
+	Units units = Unit::UNKNOWN;
 
 	RelativeTarget relative_target;
 };
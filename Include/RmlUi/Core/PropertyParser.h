@@ -21,6 +21,10 @@ public:
 	/// @param[in] parameters The list of parameters defined for this property.
 	/// @return True if the value was parsed successfully, false otherwise.
 	virtual bool ParseValue(Property& property, const String& value, const ParameterMap& parameters) const = 0;
+
+	/// Returns the units of the values produced by this parser, used to validate values set without parsing them.
+	/// @return The units OR-ed together, or Unit::UNKNOWN if they are not known.
+	virtual Units GetUnits() const { return Unit::UNKNOWN; }
 };
 
 } // namespace Rml
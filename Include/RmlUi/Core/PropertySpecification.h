@@ -11,6 +11,7 @@ class StyleSheetSpecification;
 class PropertyDefinition;
 class PropertyDictionary;
 class PropertyIdNameMap;
+struct PropertyValueCache;
 class ShorthandIdNameMap;
 struct ShorthandDefinition;
 
@@ -100,6 +101,8 @@ private:
 
 	UniquePtr<PropertyIdNameMap> property_map;
 	UniquePtr<ShorthandIdNameMap> shorthand_map;
+	// Recently parsed values of single properties, used to skip parsing values again, see ParsePropertyDeclaration().
+	UniquePtr<PropertyValueCache> value_cache;
 
 	PropertyIdSet property_ids;
 	PropertyIdSet property_ids_inherited;
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "Dictionary.h"
+#include "Header.h"
+#include "Matrix4.h"
+#include "RenderInterface.h"
+#include "Types.h"
+#include "Vertex.h"
+
+namespace Rml {
+
+/**
+    The type of a recorded render interface call, and the fields of RenderCommand it uses. Handles are placeholders as given out by the
+    recorder, except where noted.
+ */
+enum class RenderCommandType : uint8_t {
+	CompileGeometry,         // handles[0]: new geometry. RenderCommandList::GetVertices() and GetIndices().
+	RenderGeometry,          // handles[0]: geometry, handles[1]: texture, translation.
+	RenderGeometryInstanced, // handles[0]: geometry, handles[1]: texture. RenderCommandList::GetTranslations().
+	ReleaseGeometry,         // handles[0]: geometry.
+	GenerateTexture,         // handles[0]: new texture, region: the texture dimensions. RenderCommandList::GetTextureData().
+	AdoptTexture,            // handles[0]: new texture, handles[1]: the actual handle of a texture loaded during recording.
+	ReleaseTexture,          // handles[0]: texture.
+	EnableScissorRegion,     // value: enable.
+	SetScissorRegion,        // region.
+	EnableClipMask,          // value: enable.
+	RenderToClipMask,        // value: ClipMaskOperation, handles[0]: geometry, translation.
+	RenderShaderToClipMask,  // value: ClipMaskOperation, handles[0]: shader, handles[1]: geometry, translation.
+	SetTransform,            // RenderCommandList::GetTransform().
+	PushLayer,               // handles[0]: new layer, only valid during the list it was pushed in.
+	CompositeLayers,         // value: BlendMode, handles[0]: source layer, handles[1]: destination layer. RenderCommandList::GetFilters().
+	PopLayer,                //
+	SaveLayerAsTexture,      // handles[0]: new texture.
+	SaveLayerAsMaskImage,    // handles[0]: new filter.
+	CompileFilter,           // handles[0]: new filter. RenderCommandList::GetName() and GetParameters().
+	ReleaseFilter,           // handles[0]: filter.
+	CompileShader,           // handles[0]: new shader. RenderCommandList::GetName() and GetParameters().
+	RenderShader,            // handles[0]: shader, handles[1]: geometry, handles[2]: texture, translation.
+	ReleaseShader,           // handles[0]: shader.
+};
+
+struct RenderCommand {
+	RenderCommandType type;
+	int value;
+	uintptr_t handles[3];
+	Vector2f translation;
+	Rectanglei region;
+	// Location of the command's data in the list, only used by the list accessors.
+	int data_offset;
+	int data_size;
+	int index_offset;
+	int index_size;
+};
+
+/**
+    A recorded sequence of calls to a render interface, such as everything rendered by a context during a frame.
+
+    Once recorded, the list does not reference any state of the library, thus it can be replayed on another thread while the library goes
+    on to update the next frame. Handles in the list are placeholders assigned during recording, they are translated to the handles of the
+    actual render interface by the RenderCommandPlayer replaying the list. Backends can also process the commands themselves, for example
+    to reorder them by render state.
+
+    All data is stored in a few flat arrays, which keep their memory when the list is cleared, thus recording into a reused list does not
+    allocate once it has grown to the size of a typical frame.
+ */
+class RMLUICORE_API RenderCommandList {
+public:
+	/// Returns true if no commands are recorded.
+	bool IsEmpty() const { return commands.empty(); }
+	/// Returns the number of recorded commands.
+	int GetNumCommands() const { return (int)commands.size(); }
+	/// Returns the recorded commands, in the order they were called.
+	Span<const RenderCommand> GetCommands() const { return commands; }
+
+	/// Returns the data of the given command, see RenderCommandType for which accessors apply to each command type.
+	Span<const Vertex> GetVertices(const RenderCommand& command) const;
+	Span<const int> GetIndices(const RenderCommand& command) const;
+	Span<const byte> GetTextureData(const RenderCommand& command) const;
+	Span<const Vector2f> GetTranslations(const RenderCommand& command) const;
+	/// Returns nullptr when the transform is reset.
+	const Matrix4f* GetTransform(const RenderCommand& command) const;
+	/// Returns the placeholder handles of the filters.
+	Span<const uintptr_t> GetFilters(const RenderCommand& command) const;
+	const String& GetName(const RenderCommand& command) const;
+	const Dictionary& GetParameters(const RenderCommand& command) const;
+
+	/// Removes all commands, while keeping the allocated memory for reuse.
+	void Clear();
+
+	/// Returns the approximate size of the memory reserved by the list [bytes].
+	size_t GetReservedBytes() const;
+
+private:
+	Vector<RenderCommand> commands;
+	Vector<Vertex> vertices;
+	Vector<int> indices;
+	Vector<byte> texture_data;
+	Vector<Vector2f> translations;
+	Vector<Matrix4f> transforms;
+	Vector<uintptr_t> filter_handles;
+	Vector<String> names;
+	Vector<Dictionary> parameters;
+
+	friend class RenderCommandRecorder;
+};
+
+/**
+    A render interface recording all calls into a command list, to be replayed later into the actual render interface.
+
+    This decouples rendering from the thread owning the element tree: create the context with the recorder as its render interface, and
+    after each call to Context::Render() hand the recorded commands over to a render thread with SwapCommands(). The render thread replays
+    them with a RenderCommandPlayer while the next frame is updated, and then returns the list to be reused for recording.
+
+    Handles returned by the recorder are placeholders, thus failures to compile geometry or generate textures are not reported back to the
+    library. Texture updates are not recorded, instead textures are regenerated. A few calls need an immediate answer, and are forwarded to
+    the target render interface on the recording thread: SupportsShader() and LoadTextureData(). Textures loaded from files are read
+    through LoadTextureData() and generated from their data during replay, thus the target should implement it, as all the included
+    backends do. Otherwise, LoadTexture() is called on the recording thread instead.
+ */
+class RMLUICORE_API RenderCommandRecorder : public RenderInterface {
+public:
+	/// @param[in] target The render interface the commands are eventually replayed into.
+	explicit RenderCommandRecorder(RenderInterface& target);
+	~RenderCommandRecorder();
+
+	/// Hands over the commands recorded since the previous call, and continues recording into the given list after clearing it.
+	/// @param[in,out] list A list to reuse for recording, such as one that has been replayed. Set to the recorded commands on return.
+	void SwapCommands(RenderCommandList& list);
+
+	CompiledGeometryHandle CompileGeometry(Span<const Vertex> vertices, Span<const int> indices) override;
+	void RenderGeometry(CompiledGeometryHandle geometry, Vector2f translation, TextureHandle texture) override;
+	void ReleaseGeometry(CompiledGeometryHandle geometry) override;
+
+	TextureHandle LoadTexture(Vector2i& texture_dimensions, const String& source) override;
+	TextureHandle GenerateTexture(Span<const byte> source, Vector2i source_dimensions) override;
+	void ReleaseTexture(TextureHandle texture) override;
+
+	void EnableScissorRegion(bool enable) override;
+	void SetScissorRegion(Rectanglei region) override;
+
+	bool LoadTextureData(Vector<byte>& out_data, Vector2i& out_dimensions, const String& source) override;
+	bool RenderGeometryInstanced(CompiledGeometryHandle geometry, Span<const Vector2f> translations, TextureHandle texture) override;
+
+	void EnableClipMask(bool enable) override;
+	void RenderToClipMask(ClipMaskOperation operation, CompiledGeometryHandle geometry, Vector2f translation) override;
+	void RenderShaderToClipMask(ClipMaskOperation operation, CompiledShaderHandle shader, CompiledGeometryHandle geometry,
+		Vector2f translation) override;
+
+	void SetTransform(const Matrix4f* transform) override;
+
+	LayerHandle PushLayer() override;
+	void CompositeLayers(LayerHandle source, LayerHandle destination, BlendMode blend_mode, Span<const CompiledFilterHandle> filters) override;
+	void PopLayer() override;
+
+	TextureHandle SaveLayerAsTexture() override;
+	CompiledFilterHandle SaveLayerAsMaskImage() override;
+
+	CompiledFilterHandle CompileFilter(const String& name, const Dictionary& parameters) override;
+	void ReleaseFilter(CompiledFilterHandle filter) override;
+
+	bool SupportsShader(const String& name) override;
+	CompiledShaderHandle CompileShader(const String& name, const Dictionary& parameters) override;
+	void RenderShader(CompiledShaderHandle shader, CompiledGeometryHandle geometry, Vector2f translation, TextureHandle texture) override;
+	void ReleaseShader(CompiledShaderHandle shader) override;
+
+private:
+	RenderCommand& AddCommand(RenderCommandType type);
+	uintptr_t NewHandle();
+
+	RenderInterface& target;
+	RenderCommandList list;
+	uintptr_t next_handle = 1;
+};
+
+/**
+    Replays recorded command lists into a render interface.
+
+    The player keeps the mapping from the placeholder handles of the recorder to the actual handles, thus the same player must be used to
+    replay all lists recorded by a recorder, in the order they were recorded.
+ */
+class RMLUICORE_API RenderCommandPlayer {
+public:
+	/// @param[in] target The render interface to replay the commands into.
+	explicit RenderCommandPlayer(RenderInterface& target);
+
+	/// Calls the render interface with all commands of the given list.
+	void Replay(const RenderCommandList& list);
+
+	/// Returns the number of resources created through the recorded commands and not yet released.
+	int GetNumResources() const { return (int)handles.size(); }
+
+private:
+	uintptr_t Translate(uintptr_t placeholder) const;
+	// Removes the placeholder, and returns the actual handle it was translated to.
+	uintptr_t TakeHandle(uintptr_t placeholder);
+
+	RenderInterface& target;
+	UnorderedMap<uintptr_t, uintptr_t> handles;
+	// Scratch buffers reused between replays.
+	Vector<uintptr_t> layers;
+	Vector<uintptr_t> filters;
+};
+
+} // namespace Rml
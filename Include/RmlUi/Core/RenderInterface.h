@@ -73,6 +73,75 @@ public:
 	    @name Optional functions for advanced rendering features.
 	 */
 
+	/// Called by RmlUi when it wants to replace a region of a previously generated texture.
+	/// @param[in] texture The texture handle to update, as returned by GenerateTexture.
+	/// @param[in] region The region of the texture to replace, in pixels.
+	/// @param[in] source The new texture data for the region, in the same format as GenerateTexture, tightly packed.
+	/// @return True if the texture was updated, false if updates are not supported in which case the texture is regenerated instead.
+	virtual bool UpdateTexture(TextureHandle texture, Rectanglei region, Span<const byte> source);
+
+	/// Called by RmlUi when a texture is required while asynchronous texture loading is enabled, see RenderManager::SetAsyncTextureLoading.
+	/// The application may load and decode the texture on its own worker threads, in which case it should set 'loading' and return zero. RmlUi
+	/// then calls this function again for the same source once every frame, until the texture is no longer loading.
+	/// @param[in-out] texture_dimensions The dimensions of the texture. May be left at zero while the texture is loading when they are not known
+	/// yet, in which case the layout of elements using the texture is updated once it has been loaded.
+	/// @param[in] source The application-defined image source, joined with the path of the referencing document.
+	/// @param[out] loading Set to true while the texture is still being loaded.
+	/// @return An application-specified handle identifying the texture, or zero if it is still loading or could not be loaded.
+	/// @note The default implementation loads the texture synchronously through LoadTexture.
+	virtual TextureHandle LoadTextureAsync(Vector2i& texture_dimensions, const String& source, bool& loading);
+
+	/// Called by RmlUi to read the pixels of a texture while texture atlasing is enabled, see RenderManager::SetTextureAtlasing. Small textures
+	/// are then packed into shared atlas textures instead of being loaded through LoadTexture.
+	/// @param[out] out_data The texture data, in the same format as GenerateTexture, tightly packed.
+	/// @param[out] out_dimensions The dimensions of the texture.
+	/// @param[in] source The application-defined image source, joined with the path of the referencing document.
+	/// @return True if the pixels were read, false to load the texture separately through LoadTexture instead.
+	/// @note The default implementation returns false, thus no textures are packed.
+	virtual bool LoadTextureData(Vector<byte>& out_data, Vector2i& out_dimensions, const String& source);
+
+	/// Called by RmlUi when it wants to render the same geometry several times, while geometry batching is enabled, see
+	/// RenderManager::SetGeometryBatching. This is the case for consecutive draws sharing both geometry and texture.
+	/// @param[in] geometry The geometry to render.
+	/// @param[in] translations The translation to apply to each instance of the geometry, in the order they should be drawn.
+	/// @param[in] texture The texture to be applied to the geometry, or zero if the geometry is untextured.
+	/// @return True if the instances were rendered, false if instancing is not supported in which case the instances are merged into
+	/// a single geometry and rendered through RenderGeometry instead.
+	/// @note The default implementation returns false.
+	virtual bool RenderGeometryInstanced(CompiledGeometryHandle geometry, Span<const Vector2f> translations, TextureHandle texture);
+
+	/// The maximum number of transforms referenced by geometry compiled through CompileTransformedGeometry.
+	static constexpr int MaxBatchTransforms = 32;
+
+	/// Called by RmlUi when it wants to compile geometry merged from elements rendered under different transforms, while transform batching is
+	/// enabled, see RenderManager::SetTransformBatching.
+	/// @param[in] vertices The geometry's vertex data, with any translations already applied.
+	/// @param[in] indices The geometry's index data.
+	/// @param[in] transform_indices For each vertex, the index of the transform to apply to it, less than MaxBatchTransforms.
+	/// @return An application-specified handle to the geometry, or zero if transformed geometry is not supported in which case the geometry is
+	/// rendered in a separate batch for each transform instead. The handle is rendered with RenderTransformedGeometry, and released with
+	/// ReleaseGeometry.
+	/// @lifetime The pointed-to data is only valid during the call.
+	/// @note The default implementation returns zero.
+	virtual CompiledGeometryHandle CompileTransformedGeometry(Span<const Vertex> vertices, Span<const int> indices,
+		Span<const int> transform_indices);
+	/// Called by RmlUi when it wants to render geometry compiled through CompileTransformedGeometry.
+	/// @param[in] geometry The geometry to render.
+	/// @param[in] transforms The transforms referenced by the vertices of the geometry, applied in place of the transform set by SetTransform.
+	/// @param[in] texture The texture to be applied to the geometry, or zero if the geometry is untextured.
+	virtual void RenderTransformedGeometry(CompiledGeometryHandle geometry, Span<const Matrix4f> transforms, TextureHandle texture);
+
+	/// Called by RmlUi when it wants to compile geometry made up entirely of quads, such as text. Each quad is made up of four consecutive
+	/// vertices, which form the triangles (0, 3, 1) and (1, 3, 2). Thus, no index data is needed, and the backend can share a single index buffer
+	/// between all such geometry, or expand the quads in any other way.
+	/// @param[in] vertices The geometry's vertex data, four vertices for each quad.
+	/// @return An application-specified handle to the geometry, or zero if quads are not supported in which case the geometry is compiled through
+	/// CompileGeometry instead. The handle is used and released just like handles returned from CompileGeometry.
+	/// @lifetime The pointed-to vertex data is guaranteed to be valid and immutable until ReleaseGeometry() is called with the geometry handle
+	/// returned here.
+	/// @note The default implementation returns zero.
+	virtual CompiledGeometryHandle CompileQuadGeometry(Span<const Vertex> vertices);
+
 	/// Called by RmlUi when it wants to enable or disable the clip mask.
 	/// @param[in] enable True to enable the clip mask, false to disable it.
 	virtual void EnableClipMask(bool enable);
@@ -84,6 +153,23 @@ public:
 	/// @note The clip mask applies exclusively to all other functions that render with a geometry handle, in addition
 	/// to the `CompositeLayers` function while rendering to its destination.
 	virtual void RenderToClipMask(ClipMaskOperation operation, CompiledGeometryHandle geometry, Vector2f translation);
+	/// Called by RmlUi when it wants to undo the most recent intersection of the clip mask, restoring the clip mask to its contents from before
+	/// the intersection. This lets nested clip masks be removed again without rendering the whole clip mask anew.
+	/// @param[in] geometry The compiled geometry most recently rendered to the clip mask with ClipMaskOperation::Intersect.
+	/// @param[in] translation The translation applied to the geometry during the intersection.
+	/// @return True if the clip mask was restored, false if this is not supported, in which case the whole clip mask is rendered again from
+	/// now on.
+	/// @note The transform set during the intersection is set again before the call.
+	/// @note The default implementation returns false.
+	virtual bool PopClipMask(CompiledGeometryHandle geometry, Vector2f translation);
+	/// Called by RmlUi when it wants to set or modify the contents of the clip mask with the shape evaluated by a shader.
+	/// @param[in] operation Describes how the shape should affect the clip mask.
+	/// @param[in] shader The handle to a previously compiled shader, which determines the shape of the mask within the geometry.
+	/// @param[in] geometry The compiled geometry to render the shader on.
+	/// @param[in] translation The translation to apply to the geometry.
+	/// @note Only called with shaders advertised as clip masks through SupportsShader(). Clip masks rendered this way are never popped.
+	virtual void RenderShaderToClipMask(ClipMaskOperation operation, CompiledShaderHandle shader, CompiledGeometryHandle geometry,
+		Vector2f translation);
 
 	/// Called by RmlUi when it wants the renderer to use a new transform matrix.
 	/// @param[in] transform The new transform to apply, or nullptr if no transform applies to the current element.
@@ -124,6 +210,23 @@ public:
 	/// @param[in] filter The handle to a previously compiled filter.
 	virtual void ReleaseFilter(CompiledFilterHandle filter);
 
+	/// Called by RmlUi to determine whether a built-in shader can be used in place of geometry generated by the library.
+	/// @param[in] name The name of the shader, currently "rounded-box", "rounded-box-clip-mask", and "distance-field-text" are queried.
+	/// @return True if the shader is supported by CompileShader(), otherwise RmlUi generates and renders the equivalent geometry.
+	/// @note The "rounded-box" shader draws the background and border of an element with rounded corners on a quad covering its
+	/// border box. The quad's texture coordinates are given in pixels relative to the top-left corner of the border box. Its
+	/// parameters are "dimensions" (Vector2f) of the border box, "radius" (Vector4f) in the order top-left, top-right, bottom-right,
+	/// bottom-left, "border_widths" (Vector4f) in the order top, right, bottom, left, "background_color" (Colourf), and
+	/// "border_top_color", "border_right_color", "border_bottom_color", "border_left_color" (Colourf). All colors are premultiplied.
+	/// @note When "rounded-box-clip-mask" is also supported, clip masks of elements with rounded corners are rendered by passing a
+	/// "rounded-box" shader without borders to RenderShaderToClipMask(), instead of rendering their tessellated geometry. The mask should
+	/// cover the area inside the rounded box, such as where the shader's coverage is at least one half.
+	/// @note The "distance-field-text" shader is required by SetFontDistanceFieldMode(). It renders textured glyph quads where the texture's
+	/// alpha channel holds a signed distance field: 0.5 at the glyph edge and larger inside, so that the distance in texels is given by
+	/// (alpha * 255/128 - 1) * spread. Its parameters are "spread" (float), and "outline_width" and "blur_width" (float) in texels, which
+	/// grow and soften the edge for font effects. The output is the vertex color multiplied by the coverage of the grown, softened edge.
+	virtual bool SupportsShader(const String& name);
+
 	/// Called by RmlUi when it wants to compile a new shader.
 	/// @param[in] name The name of the shader.
 	/// @param[in] parameters The list of name-value parameters specified for the filter.
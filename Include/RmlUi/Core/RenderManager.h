@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CallbackTexture.h"
+#include "FrameStatistics.h"
 #include "Mesh.h"
 #include "RenderInterface.h"
 #include "StableVector.h"
@@ -20,10 +21,13 @@ struct ClipMaskGeometry {
 	Geometry* geometry;
 	Vector2f absolute_offset;
 	const Matrix4f* transform;
+	// Optional shader evaluating the shape of the mask on the geometry, only set when supported by the render interface.
+	const CompiledShader* shader;
 };
 inline bool operator==(const ClipMaskGeometry& a, const ClipMaskGeometry& b)
 {
-	return a.operation == b.operation && a.geometry == b.geometry && a.absolute_offset == b.absolute_offset && a.transform == b.transform;
+	return a.operation == b.operation && a.geometry == b.geometry && a.absolute_offset == b.absolute_offset && a.transform == b.transform &&
+		a.shader == b.shader;
 }
 inline bool operator!=(const ClipMaskGeometry& a, const ClipMaskGeometry& b)
 {
@@ -31,6 +35,18 @@ inline bool operator!=(const ClipMaskGeometry& a, const ClipMaskGeometry& b)
 }
 using ClipMaskGeometryList = Vector<ClipMaskGeometry>;
 
+struct FileTextureStats {
+	int num_textures = 0;          // Number of textures from files known to the render manager, loaded or not.
+	int num_resident_textures = 0; // Number of textures currently loaded through the render interface.
+	int num_loading_textures = 0;  // Number of textures currently being loaded asynchronously by the render interface.
+	size_t resident_bytes = 0;     // Size of the loaded textures, assuming four bytes per pixel.
+	uint64_t num_hits = 0;         // Number of texture uses served by an already loaded texture.
+	uint64_t num_misses = 0;       // Number of texture loads, including reloads of previously released textures.
+	uint64_t num_evictions = 0;    // Number of textures released to stay within the memory budget.
+	int num_atlased_textures = 0;  // Number of textures packed into atlas pages.
+	int num_atlas_pages = 0;       // Number of atlas pages, each of which is also counted as a texture.
+};
+
 struct RenderState {
 	Rectanglei scissor_region = Rectanglei::MakeInvalid();
 	ClipMaskGeometryList clip_mask_list;
@@ -55,12 +71,86 @@ public:
 	void SetScissorRegion(Rectanglei region);
 	Rectanglei GetScissorRegion() const;
 
+	/// Restricts all rendering to the given region, such as to the dirty region of a context when the framebuffer is preserved between frames.
+	/// The region is intersected with every scissor region submitted to the render interface, while GetScissorRegion() is unaffected.
+	/// @param[in] region The region to render to in window coordinates, or an invalid rectangle to render to the whole viewport (default).
+	void SetRenderRegion(Rectanglei region);
+	Rectanglei GetRenderRegion() const;
+
 	void DisableClipMask();
 	void SetClipMask(ClipMaskGeometryList clip_elements);
 	void SetClipMask(ClipMaskOperation operation, Geometry* geometry, Vector2f translation);
 
 	void SetTransform(const Matrix4f* new_transform);
 
+	/// Enables merging of consecutive geometry sharing the same texture and render state into a single draw call.
+	/// @note Merged geometry is compiled and cached by the render manager, and released when any of its members is released, or if the
+	/// merged geometry was not used during the previous frame.
+	/// @param[in] enable True to enable geometry batching, false to render each geometry separately (default).
+	void SetGeometryBatching(bool enable);
+	bool GetGeometryBatching() const;
+
+	/// Enables geometry batching across transform changes, so that elements with different transforms, such as during transform animations, can
+	/// be rendered together in a single draw call. Each vertex of the merged geometry refers to the transform of its element, which are
+	/// submitted anew every frame, thus changing transforms does not recompile the merged geometry.
+	/// @note Only has an effect while geometry batching is enabled, and requires a render interface implementing
+	/// RenderInterface::CompileTransformedGeometry. Otherwise, geometry is batched separately for each transform.
+	/// @param[in] enable True to batch geometry across transform changes, false to submit each transform change (default).
+	void SetTransformBatching(bool enable);
+	bool GetTransformBatching() const;
+
+	/// Enables sharing of compiled geometry between geometry with identical meshes, such as repeated icons, borders, and words of text.
+	/// @note Meshes are hashed when they are first compiled. Identical meshes share a single compiled geometry handle, which is released together
+	/// with the last geometry using it. Geometry compiled while disabled is not shared.
+	/// @param[in] enable True to share compiled geometry between identical meshes, false to compile each geometry separately (default).
+	void SetGeometryDeduplication(bool enable);
+	bool GetGeometryDeduplication() const;
+
+	/// Sets a memory budget for textures loaded from files. While exceeded, textures which have not been rendered during the given number of most
+	/// recent frames are released, least recently used first. Released textures are loaded again the next time they are used.
+	/// @param[in] budget_bytes The budget in bytes, assuming four bytes per pixel. Zero disables the budget (default).
+	/// @param[in] min_unused_frames The number of frames a texture must have gone unused before it can be released. Each context rendered with
+	/// this render manager counts as a frame.
+	void SetTextureMemoryBudget(size_t budget_bytes, int min_unused_frames = 60);
+	/// Enables asynchronous loading of textures from files through RenderInterface::LoadTextureAsync.
+	/// @param[in] enable True to request new textures asynchronously, false to load them synchronously through RenderInterface::LoadTexture (default).
+	/// @param[in] placeholder_source The texture to render in place of textures which are still loading, such as a loading icon. It is loaded
+	/// synchronously. If empty, geometry using a texture that is still loading is not rendered.
+	/// @note Elements and decorators sized by a texture are laid out again once it has been loaded.
+	void SetAsyncTextureLoading(bool enable, const String& placeholder_source = String());
+	/// Limits the regeneration of callback textures, such as gradients and font textures, after they have been released by ReleaseTextures().
+	/// Once the budget is spent during a frame, larger textures are regenerated during later frames, while their geometry is not rendered.
+	/// @param[in] max_pixels_per_frame The number of pixels to regenerate per frame, zero disables the budget (default).
+	void SetCallbackTextureRegenerationBudget(int max_pixels_per_frame);
+	/// Enables reuse of callback textures generated from pixels, such as gradients and font textures, as they are regenerated. Released textures
+	/// are kept for a couple of frames, to be updated in place by new textures of the same size through RenderInterface::UpdateTexture.
+	/// @param[in] enable True to reuse released textures, false to release them immediately (default).
+	/// @note Reuse is disabled when the render interface does not support texture updates.
+	void SetCallbackTextureReuse(bool enable);
+	/// Enables packing of small textures from files into shared atlas textures, so that geometry using different images can be batched together.
+	/// The pixels of the textures are read through RenderInterface::LoadTextureData, textures are loaded separately if they can not be read.
+	/// @param[in] enable True to pack new textures into atlases, false to load each texture separately (default).
+	/// @param[in] max_image_size The maximum width and height of textures to pack, in pixels.
+	/// @param[in] page_size The width and height of each atlas texture, in pixels.
+	/// @note Only elements which look up the atlas with GetTextureAtlasRegion render from it, such as images and non-repeating image decorators.
+	/// Packed textures remain in the atlas until the render manager is destroyed.
+	void SetTextureAtlasing(bool enable, int max_image_size = 64, int page_size = 1024);
+	/// Looks up the atlas texture a texture is packed into.
+	/// @param[in] texture The texture to look up.
+	/// @param[out] out_atlas_texture The atlas texture to render from instead.
+	/// @param[out] out_region The region of the texture within the atlas, in normalized texture coordinates.
+	/// @return True if the texture is packed into an atlas, otherwise false and the texture should be rendered as is.
+	bool GetTextureAtlasRegion(Texture texture, Texture& out_atlas_texture, Rectanglef& out_region);
+	/// Returns statistics about the textures loaded from files, which can be used to tune the texture memory budget.
+	FileTextureStats GetFileTextureStats() const;
+	/// Returns true while any texture is still loading asynchronously, or its regeneration was deferred, in which case the rendered frame is
+	/// incomplete.
+	bool HasPendingTextures() const;
+	/// Returns the cumulative counters of the work submitted to the render interface, used to report the statistics of each frame.
+	RenderStats GetRenderStats() const;
+	/// Returns the size of the meshes of all geometry held by the render manager, in bytes.
+	size_t GetMeshBytes();
+
 	// Retrieves the cached render state. If setting this state again, ensure the lifetimes of referenced objects are
 	// still valid. Possibly invalidating actions include destroying an element, or altering its transform property.
 	const RenderState& GetState() const { return state; }
@@ -70,10 +160,15 @@ public:
 	Geometry MakeGeometry(Mesh&& mesh);
 
 	Texture LoadTexture(const String& source, const String& document_path = String());
+	/// Loads a texture from file ahead of its first use, so that it is ready by the time it is rendered. The texture is requested asynchronously
+	/// or packed into an atlas when enabled, see SetAsyncTextureLoading() and SetTextureAtlasing().
+	void PreloadTexture(const String& source, const String& document_path = String());
 	CallbackTexture MakeCallbackTexture(CallbackTextureFunction callback);
 
 	CompiledFilter CompileFilter(const String& name, const Dictionary& parameters);
 	CompiledShader CompileShader(const String& name, const Dictionary& parameters);
+	/// Returns true if the render interface supports the given built-in shader.
+	bool SupportsShader(const String& name) const;
 
 	LayerHandle PushLayer();
 	void CompositeLayers(LayerHandle source, LayerHandle destination, BlendMode blend_mode, Span<const CompiledFilterHandle> filters);
@@ -86,15 +181,35 @@ public:
 
 private:
 	void ApplyClipMask(const ClipMaskGeometryList& clip_elements);
+	// Changes the applied clip mask to the given one by only removing and adding its innermost intersections. Returns false if the change
+	// can't be made this way or is not cheaper than applying the whole clip mask.
+	bool UpdateClipMask(const ClipMaskGeometryList& clip_elements);
+	// Renders the geometry of a clip mask element, or its shader when it has one. Returns the compiled geometry handle.
+	CompiledGeometryHandle RenderToClipMask(ClipMaskOperation operation, const ClipMaskGeometry& element_clip);
+	// Submits the scissor region of the current state, restricted to the render region.
+	void ApplyScissorRegion();
+
+	void FlushGeometryBatch();
+	void ReleaseGeometryBatches(StableVectorIndex member);
+	void ReleaseAllGeometryBatches();
 
 	StableVectorIndex InsertGeometry(Mesh&& mesh);
 	CompiledGeometryHandle GetCompiledGeometryHandle(StableVectorIndex index);
+	// Compiles the mesh through the render interface, as quads without indices when possible.
+	CompiledGeometryHandle CompileMesh(const Mesh& mesh);
 
 	void Render(const Geometry& geometry, Vector2f translation, Texture texture, const CompiledShader& shader);
+	// Returns false if geometry using the texture should not be rendered, such as while the texture is loading.
+	bool GetTextureHandle(Texture texture, TextureHandle& out_texture_handle);
 
 	void GetTextureSourceList(StringList& source_list) const;
 	const Mesh& GetMesh(const Geometry& geometry) const;
 
+	// Returns the number of textures from files known to the render manager, loaded or not, new textures are added to the end.
+	size_t GetNumFileTextures() const;
+	// Loads all textures from files starting at the given index.
+	void PreloadFileTextures(size_t first_index);
+
 	bool ReleaseTexture(const String& texture_source);
 	void ReleaseAllTextures();
 	void ReleaseAllCompiledGeometry();
@@ -107,8 +222,45 @@ private:
 	struct GeometryData {
 		Mesh mesh;
 		CompiledGeometryHandle handle = {};
+		bool batched = false;
+		// Set when the compiled handle is shared with other geometry, then the mesh hash locates the shared entry.
+		bool shared = false;
+		size_t mesh_hash = 0;
 	};
 
+	// Compiled geometry shared by identical meshes, looked up by the hash of their mesh.
+	struct SharedGeometry {
+		CompiledGeometryHandle handle = {};
+		int num_references = 0;
+		// The geometry whose mesh is compared against on lookup. If it is released before the other references, its mesh is moved here.
+		StableVectorIndex owner = StableVectorIndex::Invalid;
+		Mesh mesh;
+	};
+	CompiledGeometryHandle AcquireSharedGeometry(StableVectorIndex index, GeometryData& geometry);
+	void ReleaseSharedGeometry(StableVectorIndex index, const GeometryData& geometry);
+
+	struct BatchedGeometry {
+		StableVectorIndex index;
+		Vector2f translation;
+		// Index into the transforms of the pending batch.
+		int transform_index = 0;
+	};
+	struct GeometryBatch {
+		Vector<BatchedGeometry> members;
+		CompiledGeometryHandle handle = {};
+		// The render generation during which the batch was last used.
+		uint64_t last_used = 0;
+	};
+
+	// Renders the members of a batch sharing the same transform, which must be set on the render interface.
+	void RenderGeometryBatch(const Vector<BatchedGeometry>& members);
+	// Renders the members of the pending batch with their own transforms. Returns false if the render interface does not support it.
+	bool RenderTransformedGeometryBatch();
+	// Returns the merged geometry of the members, compiled through the render interface as needed, or nullptr on failure.
+	GeometryBatch* GetMergedGeometry(const Vector<BatchedGeometry>& members, bool transformed);
+	// Continues the pending batch under the new transform, instead of flushing it. Returns false if the batch can not be continued.
+	bool ContinueBatchWithTransform(const Matrix4f& transform);
+
 	RenderInterface* render_interface = nullptr;
 
 	StableVector<GeometryData> geometry_list;
@@ -120,8 +272,45 @@ private:
 	RenderState state;
 	Vector2i viewport_dimensions;
 
+	Rectanglei render_region = Rectanglei::MakeInvalid();
+	// The scissor region last submitted to the render interface.
+	Rectanglei applied_scissor_region = Rectanglei::MakeInvalid();
+
 	Vector<LayerHandle> render_stack;
 
+	// The geometry rendered for each entry of the applied clip mask list, empty if the clip mask can't be updated incrementally.
+	Vector<CompiledGeometryHandle> clip_mask_handles;
+	// Set once the render interface reports that it can't pop intersections off the clip mask.
+	bool clip_mask_pop_unsupported = false;
+
+	bool geometry_batching = false;
+	TextureHandle pending_batch_texture = {};
+	Vector<BatchedGeometry> pending_batch;
+	// Merged geometry keyed by the hash of their members, with a small bucket of batches for each hash so that colliding batches don't
+	// replace each other.
+	UnorderedMap<size_t, Vector<GeometryBatch>> geometry_batches;
+	// Incremented whenever any context sharing this render manager prepares to render.
+	uint64_t render_generation = 0;
+	// The number of contexts sharing this render manager, each of them rendering once per frame.
+	int num_contexts = 0;
+	// The transforms of the members of the pending batch, the first one is the transform set on the render interface when the batch started.
+	Vector<Matrix4f> pending_batch_transforms;
+	Vector<BatchedGeometry> batch_run;
+	Vector<int> vertex_transform_indices;
+	bool transform_batching = false;
+	// Set once the render interface reports that it can't compile transformed geometry.
+	bool transformed_geometry_unsupported = false;
+	bool geometry_deduplication = false;
+	UnorderedMap<size_t, Vector<SharedGeometry>> shared_geometry;
+
+	// Set once the render interface reports that it can't render instanced geometry.
+	bool geometry_instancing_unsupported = false;
+	// Set once the render interface reports that it can't compile quad geometry.
+	bool quad_geometry_unsupported = false;
+	Vector<Vector2f> instance_translations;
+
+	RenderStats render_stats;
+
 	friend class RenderManagerAccess;
 };
 
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Types.h"
+
+namespace Rml {
+
+/**
+    Timing breakdown of the startup of RmlUi, from the call to Rml::Initialise() until the first document is loaded.
+
+    The phases of Rml::Initialise() are always timed, as is the work typically done before the first frame, such as loading fonts, parsing
+    style sheets, and loading documents. The latter is accumulated until shutdown. All times are given in seconds, the statistics are reset
+    on every call to Rml::Initialise().
+ */
+struct StartupStatistics {
+	// Total time spent in Rml::Initialise(), followed by its phases.
+	double initialise_time = 0;
+	double interfaces_time = 0;     // Memory pools, default interfaces, event specification, and render manager.
+	double font_engine_time = 0;    // Initialising the font engine interface.
+	double specification_time = 0;  // Registering the properties and shorthands of the style sheet specification.
+	double parsers_time = 0;        // Initialising the style sheet parser and factory, and the template cache.
+	double factory_time = 0;        // Registering the element instancers, decorators, filters, and XML node handlers.
+	double plugins_time = 0;        // Initialising the integrated plugins and caches, and notifying the registered plugins.
+
+	// Work done after initialisation, accumulated until shutdown.
+	double font_loading_time = 0; // Loading font faces through Rml::LoadFontFace().
+	int num_font_faces = 0;
+	double style_sheet_parsing_time = 0; // Parsing style sheets, including those loaded for documents.
+	int num_style_sheets = 0;
+	double document_loading_time = 0; // Loading documents, including their style sheets and templates.
+	int num_documents = 0;
+
+	// Time spent loading the first document, and the time from the start of initialisation until the first document was loaded.
+	double first_document_time = 0;
+	double time_to_first_document = 0;
+};
+
+} // namespace Rml
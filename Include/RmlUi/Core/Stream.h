@@ -56,6 +56,11 @@ public:
 	virtual size_t Read(String& buffer, size_t bytes) const;
 	/// Read from the stream, without increasing the stream offset.
 	virtual size_t Peek(void* buffer, size_t bytes) const;
+	/// Access the remaining contents of the stream directly, for streams already stored contiguously in memory.
+	/// @param[out] out_size The number of bytes remaining from the current stream position.
+	/// @return A pointer to the contents at the current stream position, or nullptr if direct access is not supported.
+	/// @note The contents are only valid until the stream is modified or destroyed, and the stream position is not changed.
+	virtual const byte* PeekContiguous(size_t& out_size) const;
 
 	/// Write to the stream at the current position.
 	virtual size_t Write(const void* buffer, size_t bytes) = 0;
@@ -40,6 +40,8 @@ public:
 
 	/// Peek into the stream
 	size_t Peek(void* buffer, size_t bytes) const override;
+	/// Access the remaining contents of the stream directly
+	const byte* PeekContiguous(size_t& out_size) const override;
 
 	/// Write to the stream
 	using Stream::Write;
@@ -9,7 +9,9 @@ namespace Rml {
 
 class Element;
 class ElementDefinition;
+class ElementStyle;
 class StyleSheetNode;
+class StyleSheetAncestorFilter;
 class Decorator;
 class RenderManager;
 class SpritesheetList;
@@ -51,7 +53,21 @@ public:
 	const Sprite* GetSprite(const String& name) const;
 
 	/// Returns the compiled element definition for a given element and its hierarchy.
-	SharedPtr<const ElementDefinition> GetElementDefinition(const Element* element) const;
+	/// @param[in] ancestor_filter If set, must be an up-to-date filter of the element's ancestors, used to skip non-matching nodes quickly.
+	/// @param[out] out_position_dependent If set, will be true if the result may depend on the element's position among its siblings, such as with
+	/// structural selectors. Otherwise, the definition also applies to any sibling with the same tag, id, classes, pseudo-classes, and attributes.
+	SharedPtr<const ElementDefinition> GetElementDefinition(const Element* element, const StyleSheetAncestorFilter* ancestor_filter = nullptr,
+		bool* out_position_dependent = nullptr) const;
+
+	/// Returns which elements may change their definition when the given class is added to or removed from an element.
+	SelectorDependency GetClassDependency(const String& class_name) const;
+	/// Returns which elements may change their definition when the given pseudo-class is set or unset on an element.
+	SelectorDependency GetPseudoClassDependency(const String& pseudo_class) const;
+	/// Returns which elements may change their definition when the given attribute is changed on an element.
+	SelectorDependency GetAttributeDependency(const String& attribute_name) const;
+
+	/// Returns the statistics of the cache of element definitions.
+	ElementDefinitionCacheStats GetElementDefinitionCacheStats() const;
 
 	/// Returns a list of instanced decorators from the declarations. The instances are cached for faster future retrieval.
 	const DecoratorPtrList& InstanceDecorators(RenderManager& render_manager, const DecoratorDeclarationList& declaration_list,
@@ -60,6 +76,19 @@ public:
 private:
 	StyleSheet();
 
+	// Finds the nodes applicable to the element sorted by specificity, along with the hash of the nodes. Only reads from the style sheet and the
+	// element hierarchy, thus elements can be matched concurrently as long as neither is modified meanwhile.
+	void FindApplicableNodes(const Element* element, const StyleSheetAncestorFilter* ancestor_filter, StyleSheetIndex::NodeList& applicable_nodes,
+		size_t& out_nodes_hash, bool& out_position_dependent) const;
+	// Returns the element definition of the given applicable nodes, creating and caching it if it does not exist yet.
+	SharedPtr<const ElementDefinition> GetCachedElementDefinition(const StyleSheetIndex::NodeList& applicable_nodes, size_t nodes_hash) const;
+
+	void EvictUnusedElementDefinitions() const;
+
+	// Returns true if any styled node applies to the given element, looked up through the node index.
+	bool IsAnyNodeApplicable(const Element* element) const;
+	bool HasNodeIndex() const { return node_index_built; }
+
 	// Root level node, attributes from special nodes like "body" get added to this node
 	UniquePtr<StyleSheetNode> root;
 
@@ -81,15 +110,27 @@ private:
 
 	// Map of all styled nodes, that is, they have one or more properties.
 	StyleSheetIndex styled_node_index;
+	bool node_index_built = false;
+
+	struct CachedElementDefinition {
+		StyleSheetIndex::NodeList nodes;
+		SharedPtr<const ElementDefinition> definition;
+		uint32_t generation; // The cache generation during which the definition was last looked up.
+	};
 
-	// Index of node sets to element definitions.
-	using ElementDefinitionCache = UnorderedMap<StyleSheetIndex::NodeList, SharedPtr<const ElementDefinition>>;
+	// Element definitions indexed by the hash of their set of applicable nodes. Definitions no longer used by any element are evicted
+	// periodically, whenever the number of definitions exceeds the given limit.
+	using ElementDefinitionCache = UnorderedMap<size_t, Vector<CachedElementDefinition>>;
 	mutable ElementDefinitionCache node_cache;
+	mutable ElementDefinitionCacheStats node_cache_stats;
+	mutable uint32_t node_cache_generation = 0;
+	mutable int node_cache_eviction_limit = 0;
 
 	// Cached decorator instances.
 	using DecoratorCache = UnorderedMap<String, Vector<SharedPtr<const Decorator>>>;
 	mutable DecoratorCache decorator_cache;
 
+	friend Rml::ElementStyle;
 	friend Rml::StyleSheetParser;
 	friend Rml::StyleSheetContainer;
 };
@@ -5,6 +5,7 @@
 
 namespace Rml {
 
+class Element;
 class Stream;
 class StyleSheet;
 
@@ -24,12 +25,23 @@ public:
 	/// Compiles a single style sheet by combining all contained style sheets whose media queries match the current state of the context.
 	/// @param[in] context The current context used for evaluating media query parameters against.
 	/// @returns True when the compiled style sheet was changed, otherwise false.
-	/// @warning This operation invalidates all references to the previously compiled style sheet.
+	/// @note Compiled style sheets are cached, so that returning to a previous state of the media queries does not compile them again. They are
+	/// also shared with other containers combining the same style sheets, such as documents loaded from the same sources in different contexts.
 	bool UpdateCompiledStyleSheet(const Context* context);
+	/// Compiles the style sheet in place of the previous container of a document, such as after reloading its style sheets. Afterwards, only
+	/// the rules of the active style sheets which differ between the two containers are considered changed.
+	/// @param[in] context The current context used for evaluating media query parameters against.
+	/// @param[in] previous The container previously used by the document.
+	/// @returns True when the compiled style sheet differs from the previous one, otherwise false.
+	bool UpdateCompiledStyleSheet(const Context* context, const StyleSheetContainer& previous);
 
 	/// Returns the previously compiled style sheet.
 	StyleSheet* GetCompiledStyleSheet();
 
+	/// Returns true if the definition of the given element may have changed during the last change of the compiled style sheet. That is, if any
+	/// rule in the media blocks that were activated, deactivated, or replaced applies to the element.
+	bool IsDefinitionAffectedByChange(const Element* element) const;
+
 	/// Combines this style sheet container with another one, producing a new sheet container.
 	SharedPtr<StyleSheetContainer> CombineStyleSheetContainer(const StyleSheetContainer& container) const;
 
@@ -37,11 +49,29 @@ public:
 	void MergeStyleSheetContainer(const StyleSheetContainer& container);
 
 private:
+	// Returns true if any of the style sheets define rules that may apply to elements not matched by their selectors, such as decorators.
+	static bool DefinesIndirectRules(const Vector<SharedPtr<StyleSheet>>& style_sheets);
+	// Builds the node index of any changed style sheets, so that elements can be quickly matched against them.
+	void BuildChangedNodeIndices();
+
+	// The maximum number of compiled style sheets kept for different combinations of active media blocks.
+	static constexpr size_t MaxCompiledStyleSheets = 8;
+
+	struct CompiledStyleSheet {
+		Vector<int> media_block_indices;
+		SharedPtr<StyleSheet> style_sheet; // Shared with all other containers combining the same style sheets.
+	};
+
 	MediaBlockList media_blocks;
 
 	StyleSheet* compiled_style_sheet = nullptr;
-	UniquePtr<StyleSheet> combined_compiled_style_sheet;
 	Vector<int> active_media_block_indices;
+	Vector<CompiledStyleSheet> compiled_style_sheet_cache;
+
+	// The style sheets activated, deactivated, or replaced during the last change of the compiled style sheet, unless the whole style sheet may
+	// have changed.
+	Vector<SharedPtr<StyleSheet>> changed_style_sheets;
+	bool all_definitions_affected = true;
 };
 
 } // namespace Rml
@@ -67,6 +67,28 @@ struct MediaBlock {
 };
 using MediaBlockList = Vector<MediaBlock>;
 
+/**
+   Describes which elements may have their definitions changed when a class, pseudo-class, or attribute is toggled on an element, depending on the
+   selectors of the style sheet that refer to the name.
+ */
+enum class SelectorDependency : uint8_t {
+	None = 0,
+	Self = 1 << 0,        // The element itself.
+	Descendants = 1 << 1, // The descendants of the element.
+	Siblings = 1 << 2,    // The following siblings of the element and their descendants.
+	All = Self | Descendants | Siblings,
+};
+inline SelectorDependency operator|(SelectorDependency lhs, SelectorDependency rhs)
+{
+	using underlying_t = std::underlying_type<SelectorDependency>::type;
+	return static_cast<SelectorDependency>(static_cast<underlying_t>(lhs) | static_cast<underlying_t>(rhs));
+}
+inline SelectorDependency operator&(SelectorDependency lhs, SelectorDependency rhs)
+{
+	using underlying_t = std::underlying_type<SelectorDependency>::type;
+	return static_cast<SelectorDependency>(static_cast<underlying_t>(lhs) & static_cast<underlying_t>(rhs));
+}
+
 /**
    StyleSheetIndex contains a cached index of all styled nodes for quick lookup when finding applicable style nodes for the current state of a given
    element.
@@ -78,19 +100,21 @@ struct StyleSheetIndex {
 	// The following objects are given in prioritized order. Any nodes in the first object will not be contained in the next one and so on.
 	NodeIndex ids, classes, tags;
 	NodeList other;
+
+	// The elements affected by toggling a given class, pseudo-class, or attribute name, keyed by the hash of the name. Names not referred to by any
+	// styled selector are not present.
+	using DependencyIndex = UnorderedMap<size_t, SelectorDependency>;
+	DependencyIndex class_dependencies, pseudo_class_dependencies, attribute_dependencies;
 };
-} // namespace Rml
 
-namespace std {
-// Hash specialization for the node list, so it can be used as key in UnorderedMap.
-template <>
-struct hash<::Rml::StyleSheetIndex::NodeList> {
-	size_t operator()(const ::Rml::StyleSheetIndex::NodeList& nodes) const noexcept
-	{
-		size_t seed = 0;
-		for (const ::Rml::StyleSheetNode* node : nodes)
-			::Rml::Utilities::HashCombine(seed, node);
-		return seed;
-	}
+/**
+   Statistics of the element definition cache of a style sheet.
+ */
+struct ElementDefinitionCacheStats {
+	int num_definitions = 0; // Number of definitions currently held by the cache.
+	int num_hits = 0;        // Number of lookups that found an existing definition.
+	int num_misses = 0;      // Number of lookups that created a new definition.
+	int num_evictions = 0;   // Number of definitions removed from the cache after no longer being used by any element.
 };
-} // namespace std
+
+} // namespace Rml
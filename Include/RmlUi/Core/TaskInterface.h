@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Header.h"
+#include "Traits.h"
+#include "Types.h"
+
+namespace Rml {
+
+/**
+    RmlUi's task interface lets the library run its work on the application's own threads, such as a job system or thread pool.
+
+    When a task interface is installed, RmlUi does not start any threads of its own. Instead, the parallel formatting of documents and the
+    background rendering of plugins, such as SVG rasterization and Lottie frames, are submitted through this interface when enabled. Without a
+    task interface, RmlUi uses its own worker threads for this work.
+
+    @see Rml::SetTaskInterface()
+ */
+class RMLUICORE_API TaskInterface : public NonCopyMoveable {
+public:
+	TaskInterface();
+	virtual ~TaskInterface();
+
+	/// Called by RmlUi when it wants to run a task in the background.
+	/// @param[in] task The task to run, it may be called on any thread.
+	/// @return An application-specified handle identifying the task.
+	/// @note Every handle returned from here is passed to Wait() exactly once, after which it can be reused.
+	virtual TaskHandle Submit(Function<void()> task) = 0;
+
+	/// Called by RmlUi to wait until a previously submitted task is complete.
+	/// @param[in] task The handle of the task to wait for.
+	virtual void Wait(TaskHandle task) = 0;
+
+	/// Called by RmlUi to call a task once for every index in [0, count), possibly concurrently, returning only after all calls are complete.
+	/// @param[in] count The number of calls to make.
+	/// @param[in] task The task to call with each index.
+	/// @note The default implementation submits one task for each index through Submit(), and then waits for all of them.
+	virtual void ParallelFor(int count, const Function<void(int)>& task);
+};
+
+} // namespace Rml
@@ -19,6 +19,8 @@ public:
 	Texture() = default;
 
 	Vector2i GetDimensions() const;
+	/// Returns true while the texture is being loaded asynchronously, its dimensions may not be known yet.
+	bool IsLoading() const;
 
 	explicit operator bool() const;
 	bool operator==(const Texture& other) const;
@@ -76,6 +76,7 @@ using TouchId = uintptr_t;
 
 // Types for external interfaces.
 using FileHandle = uintptr_t;
+using FileMappingHandle = uintptr_t;
 using TextureHandle = uintptr_t;
 using CompiledGeometryHandle = uintptr_t;
 using CompiledFilterHandle = uintptr_t;
@@ -84,6 +85,7 @@ using DecoratorDataHandle = uintptr_t;
 using FontFaceHandle = uintptr_t;
 using FontEffectsHandle = uintptr_t;
 using LayerHandle = uintptr_t;
+using TaskHandle = uintptr_t;
 
 using ElementPtr = UniqueReleaserPtr<Element>;
 using ContextPtr = UniqueReleaserPtr<Context>;
@@ -105,7 +107,8 @@ using VariantList = Vector<Variant>;
 using ElementAnimationList = Vector<ElementAnimation>;
 
 using AttributeNameList = SmallUnorderedSet<String>;
-using PropertyMap = UnorderedMap<PropertyId, Property>;
+// Properties sorted by id, stored contiguously in the default configuration.
+using PropertyMap = SmallOrderedMap<PropertyId, Property>;
 
 using Dictionary = SmallUnorderedMap<String, Variant>;
 using ElementAttributes = Dictionary;
@@ -14,7 +14,9 @@ Variant::Variant(T&& t)
 template <typename T, typename>
 Variant& Variant::operator=(T&& t)
 {
-	Clear();
+	// Reuse the existing string storage when assigning a string to a string variant.
+	if (!(type == STRING && std::is_same<std::decay_t<T>, String>::value))
+		Clear();
 	Set(std::forward<T>(t));
 	return *this;
 }
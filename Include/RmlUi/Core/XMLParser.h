@@ -26,6 +26,9 @@ public:
 	///		a tag for all XMLParser instances created after this call.
 	/// @param[in] _tag The tag for contents to be treated as CDATA
 	static void RegisterPersistentCDATATag(const String& _tag);
+	/// Registers the CDATA tags and inner XML attributes of RML on the given parser, so that it tokenizes RML the same way as this parser.
+	/// @param[in] parser The parser to register on, such as one which records the events of a parse to be replayed later.
+	static void RegisterTokenizerSyntax(BaseXMLParser& parser);
 
 	/// Registers a custom node handler to be used to a given tag.
 	/// @param[in] tag The tag the custom parser will handle.
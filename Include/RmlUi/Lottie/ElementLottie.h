@@ -1,16 +1,16 @@
 #pragma once
 
-#include "../Core/CallbackTexture.h"
 #include "../Core/Element.h"
 #include "../Core/Geometry.h"
 #include "../Core/Header.h"
 
-namespace rlottie {
-class Animation;
-}
-
 namespace Rml {
 
+namespace Lottie {
+	struct LottieSource;
+	class LottieFrames;
+} // namespace Lottie
+
 class RMLUICORE_API ElementLottie : public Element {
 public:
 	RMLUI_RTTI_DefineWithParent(ElementLottie, Element)
@@ -47,19 +47,13 @@ private:
 	void GenerateGeometry();
 	// Loads the element's animation, as specified by the 'src' attribute.
 	bool LoadAnimation();
-	// Update the texture for the next animation frame when necessary.
-	void UpdateTexture();
+	// Returns true if the content area of the element is visible inside the given clipping region and viewport.
+	bool IsContentVisible(Rectanglei clip_region, Vector2i viewport);
 
 	bool animation_dirty = false;
 	bool geometry_dirty = false;
 	bool texture_size_dirty = false;
 
-	// The texture this element is rendering from.
-	CallbackTexture texture;
-	// The texture data buffer.
-	size_t texture_data_size = 0;
-	UniquePtr<byte[]> texture_data;
-
 	// The animation's intrinsic dimensions.
 	Vector2f intrinsic_dimensions;
 	// The element's size for rendering.
@@ -68,12 +62,10 @@ private:
 	// The geometry used to render this element.
 	Geometry geometry;
 
-	// The absolute time when the current animation was first displayed.
-	double time_animation_start = -1;
-	// The previous animation frame displayed.
-	size_t prev_animation_frame = size_t(-1);
-
-	UniquePtr<rlottie::Animation> animation;
+	// The animation, shared between all elements displaying the same source.
+	SharedPtr<Lottie::LottieSource> source;
+	// The frames rendered at the element's size, shared between all elements displaying the animation at the same size.
+	SharedPtr<Lottie::LottieFrames> frames;
 };
 
 } // namespace Rml
@@ -120,7 +120,8 @@ namespace Lua {
 		@param obj[in] The object to push to the stack
 		@param gc[in] If the obj should be deleted or decrease reference count upon the garbage collection
 		metamethod being called from the object in Lua
-		@return Position on the stack where the userdata resides   */
+		@return Position on the stack where the userdata resides
+		@note Objects pushed without garbage collection reuse the same userdata while it is referenced from Lua.  */
 		static inline int push(lua_State* L, T* obj, bool gc = false);
 		/** Statically casts the item at the position on the Lua stack
 		@param narg[in] Position of the item to cast on the Lua stack
@@ -164,6 +165,13 @@ namespace Lua {
 	namespace LuaTypeImpl {
 		RMLUILUA_API int index(lua_State* L, const char* class_name);
 		RMLUILUA_API int newindex(lua_State* L, const char* class_name);
+
+		/** Pushes the userdata previously cached for the key in the class, if it is still referenced from Lua.
+		@return True if the userdata was pushed, otherwise nothing is pushed  */
+		RMLUILUA_API bool pushcached(lua_State* L, const char* class_name, void* key);
+		/** Caches the userdata at the top of the stack for the key in the class, leaving the stack unchanged. The userdata is held weakly,
+		so that it can still be garbage collected.  */
+		RMLUILUA_API void cache(lua_State* L, const char* class_name, void* key);
 	} // namespace LuaTypeImpl
 
 } // namespace Lua
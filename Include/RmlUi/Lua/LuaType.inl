@@ -56,6 +56,10 @@ namespace Lua {
 			lua_pushnil(L);
 			return lua_gettop(L);
 		}
+		// Objects which are not garbage collected are referenced by a single userdata, to avoid allocating a new one on every push.
+		if (gc == false && LuaTypeImpl::pushcached(L, GetTClassName<T>(), obj))
+			return lua_gettop(L);
+
 		luaL_getmetatable(L, GetTClassName<T>()); // lookup metatable in Lua registry ->[1] = metatable of <ClassName>
 		if (lua_isnil(L, -1))
 			luaL_error(L, "%s missing metatable", GetTClassName<T>());
@@ -91,6 +95,9 @@ namespace Lua {
 			}
 
 			lua_pop(L, 1); // -> pop [3]
+
+			if (gc == false)
+				LuaTypeImpl::cache(L, GetTClassName<T>(), obj);
 		}
 		lua_settop(L, ud);  //[ud = 2] -> remove everything that is above 2, top = [2]
 		lua_replace(L, mt); //[mt = 1] -> move [2] to pos [1], and pop previous [1]
@@ -0,0 +1,105 @@
+#include <RmlUi/Core/ArchiveBuilder.h>
+#include <RmlUi/Core/Types.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+/*
+    Packs all files in a directory into a resource archive, to be loaded by the ArchiveFileInterface.
+
+    The paths in the archive are relative to the input directory, thus the archive should be mounted at the path where the directory would
+    otherwise be located.
+*/
+
+namespace fs = std::filesystem;
+
+static void PrintUsage()
+{
+	std::printf("Usage: rmlui_archive_tool [--compress] <input directory> <output archive>\n\n"
+				"  --compress  Compress files with LZ4, files are stored uncompressed where that does not reduce their size.\n");
+}
+
+static bool ReadFile(const fs::path& path, Rml::Vector<Rml::byte>& out_data)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+
+	out_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	return !file.bad();
+}
+
+int main(int argc, char** argv)
+{
+	bool compress = false;
+	Rml::Vector<const char*> arguments;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--compress") == 0)
+			compress = true;
+		else
+			arguments.push_back(argv[i]);
+	}
+
+	if (arguments.size() != 2)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	const fs::path input_directory = arguments[0];
+	const fs::path output_path = arguments[1];
+
+	std::error_code error;
+	if (!fs::is_directory(input_directory, error))
+	{
+		std::fprintf(stderr, "Input directory not found: %s\n", input_directory.string().c_str());
+		return 1;
+	}
+
+	// Sort the files so that the archive is reproducible.
+	Rml::Vector<fs::path> file_paths;
+	for (const fs::directory_entry& entry : fs::recursive_directory_iterator(input_directory, error))
+	{
+		if (entry.is_regular_file())
+			file_paths.push_back(entry.path());
+	}
+	std::sort(file_paths.begin(), file_paths.end());
+
+	Rml::ArchiveBuilder builder;
+	Rml::Vector<Rml::byte> file_data;
+	size_t total_size = 0;
+
+	for (const fs::path& file_path : file_paths)
+	{
+		if (!ReadFile(file_path, file_data))
+		{
+			std::fprintf(stderr, "Could not read file: %s\n", file_path.string().c_str());
+			return 1;
+		}
+
+		builder.AddFile(fs::relative(file_path, input_directory).generic_string(), {file_data.data(), file_data.size()}, compress);
+		total_size += file_data.size();
+	}
+
+	Rml::Vector<Rml::byte> archive_data;
+	if (!builder.Build(archive_data))
+	{
+		std::fprintf(stderr, "Could not build archive.\n");
+		return 1;
+	}
+
+	std::ofstream output(output_path, std::ios::binary);
+	output.write(reinterpret_cast<const char*>(archive_data.data()), std::streamsize(archive_data.size()));
+	if (!output)
+	{
+		std::fprintf(stderr, "Could not write archive: %s\n", output_path.string().c_str());
+		return 1;
+	}
+
+	std::printf("Packed %zu files (%zu bytes) into %s (%zu bytes).\n", builder.GetNumFiles(), total_size, output_path.string().c_str(),
+		archive_data.size());
+	return 0;
+}
@@ -0,0 +1,132 @@
+#include "../../Include/RmlUi/Core/ArchiveBuilder.h"
+#include "../../Include/RmlUi/Core/Log.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "ArchiveFormat.h"
+#include <algorithm>
+#include <string.h>
+
+namespace Rml {
+
+ArchiveBuilder::ArchiveBuilder() {}
+
+ArchiveBuilder::~ArchiveBuilder() {}
+
+void ArchiveBuilder::AddFile(const String& path, Span<const byte> data, bool compress)
+{
+	File file;
+	file.path = ArchiveFormat::NormalizePath(path);
+	file.size = data.size();
+	file.compressed = (compress && ArchiveFormat::CompressLZ4(data, file.data));
+	if (!file.compressed)
+		file.data.assign(data.begin(), data.end());
+
+	auto it = std::find_if(files.begin(), files.end(), [&](const File& other) { return other.path == file.path; });
+	if (it != files.end())
+		*it = std::move(file);
+	else
+		files.push_back(std::move(file));
+}
+
+size_t ArchiveBuilder::GetNumFiles() const
+{
+	return files.size();
+}
+
+bool ArchiveBuilder::Build(Vector<byte>& out_data) const
+{
+	using namespace ArchiveFormat;
+
+	out_data.clear();
+
+	uint32_t num_buckets = 1;
+	while (num_buckets < files.size())
+		num_buckets *= 2;
+
+	struct SortedFile {
+		const File* file;
+		uint64_t hash;
+		uint32_t bucket;
+	};
+	Vector<SortedFile> sorted_files;
+	sorted_files.reserve(files.size());
+	for (const File& file : files)
+	{
+		const uint64_t hash = HashPath(file.path);
+		sorted_files.push_back(SortedFile{&file, hash, uint32_t(hash & (num_buckets - 1))});
+	}
+	std::sort(sorted_files.begin(), sorted_files.end(), [](const SortedFile& a, const SortedFile& b) {
+		return a.bucket != b.bucket ? a.bucket < b.bucket : a.file->path < b.file->path;
+	});
+
+	size_t paths_size = 0;
+	for (const File& file : files)
+		paths_size += file.path.size();
+
+	if (files.size() > size_t(UINT32_MAX) || paths_size > size_t(UINT32_MAX))
+	{
+		Log::Message(Log::LT_ERROR, "Could not build archive, too many files.");
+		return false;
+	}
+
+	auto AlignOffset = [](size_t offset) { return (offset + BlobAlignment - 1) & ~(BlobAlignment - 1); };
+
+	const size_t entries_offset = GetEntriesOffset(num_buckets);
+	const size_t paths_offset = entries_offset + files.size() * sizeof(Entry);
+
+	Vector<uint32_t> bucket_starts(size_t(num_buckets) + 1, 0);
+	Vector<Entry> entries(files.size());
+	String paths;
+	paths.reserve(paths_size);
+
+	size_t blob_offset = AlignOffset(paths_offset + paths_size);
+	for (size_t i = 0; i < sorted_files.size(); i++)
+	{
+		const File& file = *sorted_files[i].file;
+		bucket_starts[sorted_files[i].bucket + 1] = uint32_t(i + 1);
+
+		Entry& entry = entries[i];
+		memset(&entry, 0, sizeof(Entry));
+		entry.path_hash = sorted_files[i].hash;
+		entry.offset = blob_offset;
+		entry.stored_size = file.data.size();
+		entry.size = file.size;
+		entry.path_offset = uint32_t(paths.size());
+		entry.path_length = uint32_t(file.path.size());
+		entry.compression = (file.compressed ? Compression::LZ4 : Compression::None);
+
+		paths += file.path;
+		blob_offset = AlignOffset(blob_offset + file.data.size());
+	}
+
+	// Buckets without any files start where the previous bucket ends.
+	for (size_t i = 1; i < bucket_starts.size(); i++)
+		bucket_starts[i] = Math::Max(bucket_starts[i], bucket_starts[i - 1]);
+
+	Header header = {};
+	header.magic = Magic;
+	header.format_version = FormatVersion;
+	header.byte_order_mark = ByteOrderMark;
+	header.num_entries = uint32_t(files.size());
+	header.num_buckets = num_buckets;
+	header.paths_size = uint32_t(paths_size);
+
+	out_data.resize(blob_offset, 0);
+	byte* data = out_data.data();
+	memcpy(data, &header, sizeof(Header));
+	memcpy(data + sizeof(Header), bucket_starts.data(), bucket_starts.size() * sizeof(uint32_t));
+	if (!entries.empty())
+		memcpy(data + entries_offset, entries.data(), entries.size() * sizeof(Entry));
+	if (!paths.empty())
+		memcpy(data + paths_offset, paths.data(), paths.size());
+
+	for (size_t i = 0; i < sorted_files.size(); i++)
+	{
+		const Vector<byte>& file_data = sorted_files[i].file->data;
+		if (!file_data.empty())
+			memcpy(data + entries[i].offset, file_data.data(), file_data.size());
+	}
+
+	return true;
+}
+
+} // namespace Rml
@@ -0,0 +1,334 @@
+#include "../../Include/RmlUi/Core/ArchiveFileInterface.h"
+#include "../../Include/RmlUi/Core/Log.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "ArchiveFormat.h"
+#include "FileInterfaceDefault.h"
+#include "FileMapping.h"
+#include <string.h>
+
+namespace Rml {
+
+using ArchiveFormat::Compression;
+using ArchiveFormat::Entry;
+using ArchiveFormat::Header;
+
+struct ArchiveFileInterface::Archive {
+	// Owns the archive data when loaded from a path.
+	FileMapping file;
+
+	Span<const byte> data;
+	String mount_path; // Empty, or a normalized path ending with a slash.
+
+	Header header;
+	const byte* bucket_starts;
+	const byte* entries;
+	const char* paths;
+
+	// The archive data may not be aligned when provided by the user, thus values are copied out of it.
+	uint32_t GetBucketStart(size_t bucket) const
+	{
+		uint32_t result;
+		memcpy(&result, bucket_starts + bucket * sizeof(uint32_t), sizeof(uint32_t));
+		return result;
+	}
+	Entry GetEntry(size_t index) const
+	{
+		Entry result;
+		memcpy(&result, entries + index * sizeof(Entry), sizeof(Entry));
+		return result;
+	}
+};
+
+struct ArchiveFileInterface::ArchiveFile {
+	Span<const byte> data;
+	size_t position;
+	UniquePtr<byte[]> buffer;  // Only set for decompressed files.
+	FileHandle fallback_handle; // Only set for files opened through the fallback interface.
+};
+
+struct ArchiveFileInterface::ArchiveMapping {
+	UniquePtr<byte[]> buffer;
+	FileMappingHandle fallback_handle;
+	bool fallback;
+};
+
+static bool InitializeArchive(Span<const byte> data, const String& source, Header& out_header, const byte*& out_bucket_starts,
+	const byte*& out_entries, const char*& out_paths)
+{
+	auto Error = [&source](const char* reason) {
+		Log::Message(Log::LT_ERROR, "Could not load archive %s: %s", source.c_str(), reason);
+		return false;
+	};
+
+	if (data.size() < sizeof(Header))
+		return Error("Not a valid archive.");
+
+	Header header;
+	memcpy(&header, data.data(), sizeof(Header));
+	if (header.magic != ArchiveFormat::Magic || header.byte_order_mark != ArchiveFormat::ByteOrderMark)
+		return Error("Not a valid archive, or built for a platform with a different byte order.");
+	if (header.format_version != ArchiveFormat::FormatVersion)
+		return Error("The archive was built with an unsupported format version.");
+	if (header.num_buckets == 0 || (header.num_buckets & (header.num_buckets - 1)) != 0)
+		return Error("Invalid bucket table.");
+
+	const size_t entries_offset = ArchiveFormat::GetEntriesOffset(header.num_buckets);
+	const size_t paths_offset = entries_offset + size_t(header.num_entries) * sizeof(Entry);
+	if (entries_offset > data.size() || size_t(header.num_entries) > (data.size() - entries_offset) / sizeof(Entry) ||
+		size_t(header.paths_size) > data.size() - paths_offset)
+		return Error("The archive is truncated.");
+
+	out_header = header;
+	out_bucket_starts = data.data() + sizeof(Header);
+	out_entries = data.data() + entries_offset;
+	out_paths = reinterpret_cast<const char*>(data.data() + paths_offset);
+
+	// Validate the whole index up front, so that lookups can rely on it.
+	uint32_t previous_bucket_start = 0;
+	for (size_t i = 0; i <= header.num_buckets; i++)
+	{
+		uint32_t bucket_start;
+		memcpy(&bucket_start, out_bucket_starts + i * sizeof(uint32_t), sizeof(uint32_t));
+		if (bucket_start < previous_bucket_start || bucket_start > header.num_entries || (i == 0 && bucket_start != 0) ||
+			(i == header.num_buckets && bucket_start != header.num_entries))
+			return Error("Invalid bucket table.");
+		previous_bucket_start = bucket_start;
+	}
+
+	for (size_t i = 0; i < header.num_entries; i++)
+	{
+		Entry entry;
+		memcpy(&entry, out_entries + i * sizeof(Entry), sizeof(Entry));
+		const bool valid_compression =
+			(entry.compression == Compression::None && entry.stored_size == entry.size) || entry.compression == Compression::LZ4;
+		if (!valid_compression || entry.offset > data.size() || entry.stored_size > data.size() - entry.offset ||
+			entry.path_offset > header.paths_size || entry.path_length > header.paths_size - entry.path_offset)
+			return Error("Invalid file entry.");
+	}
+
+	return true;
+}
+
+ArchiveFileInterface::ArchiveFileInterface(FileInterface* fallback_interface) : fallback_interface(fallback_interface)
+{
+#ifndef RMLUI_NO_FILE_INTERFACE_DEFAULT
+	if (!fallback_interface)
+	{
+		default_interface = MakeUnique<FileInterfaceDefault>();
+		this->fallback_interface = default_interface.get();
+	}
+#endif
+}
+
+ArchiveFileInterface::~ArchiveFileInterface() {}
+
+bool ArchiveFileInterface::AddArchive(const String& archive_path, const String& mount_path)
+{
+	auto archive = MakeUnique<Archive>();
+	if (!fallback_interface || !archive->file.Load(archive_path, fallback_interface))
+	{
+		Log::Message(Log::LT_ERROR, "Could not open archive %s.", archive_path.c_str());
+		return false;
+	}
+
+	archive->data = archive->file.GetData();
+	if (!InitializeArchive(archive->data, archive_path, archive->header, archive->bucket_starts, archive->entries, archive->paths))
+		return false;
+
+	const String normalized_mount_path = ArchiveFormat::NormalizePath(mount_path);
+	archive->mount_path = (normalized_mount_path.empty() ? String() : normalized_mount_path + '/');
+	archives.push_back(std::move(archive));
+	return true;
+}
+
+bool ArchiveFileInterface::AddArchive(Span<const byte> data, const String& mount_path)
+{
+	auto archive = MakeUnique<Archive>();
+	archive->data = data;
+	if (!InitializeArchive(archive->data, "from memory", archive->header, archive->bucket_starts, archive->entries, archive->paths))
+		return false;
+
+	const String normalized_mount_path = ArchiveFormat::NormalizePath(mount_path);
+	archive->mount_path = (normalized_mount_path.empty() ? String() : normalized_mount_path + '/');
+	archives.push_back(std::move(archive));
+	return true;
+}
+
+bool ArchiveFileInterface::Contains(const String& path) const
+{
+	const Archive* archive = nullptr;
+	size_t entry_index = 0;
+	return FindFile(path, archive, entry_index);
+}
+
+FileHandle ArchiveFileInterface::Open(const String& path)
+{
+	const Archive* archive = nullptr;
+	size_t entry_index = 0;
+	if (FindFile(path, archive, entry_index))
+	{
+		auto file = MakeUnique<ArchiveFile>();
+		file->position = 0;
+		file->fallback_handle = 0;
+		if (!GetContents(*archive, entry_index, file->data, file->buffer))
+			return 0;
+		return reinterpret_cast<FileHandle>(file.release());
+	}
+
+	if (!fallback_interface)
+		return 0;
+
+	const FileHandle fallback_handle = fallback_interface->Open(path);
+	if (!fallback_handle)
+		return 0;
+
+	return reinterpret_cast<FileHandle>(new ArchiveFile{{}, 0, nullptr, fallback_handle});
+}
+
+void ArchiveFileInterface::Close(FileHandle file)
+{
+	ArchiveFile* archive_file = reinterpret_cast<ArchiveFile*>(file);
+	if (archive_file->fallback_handle)
+		fallback_interface->Close(archive_file->fallback_handle);
+	delete archive_file;
+}
+
+size_t ArchiveFileInterface::Read(void* buffer, size_t size, FileHandle file)
+{
+	ArchiveFile* archive_file = reinterpret_cast<ArchiveFile*>(file);
+	if (archive_file->fallback_handle)
+		return fallback_interface->Read(buffer, size, archive_file->fallback_handle);
+
+	size = Math::Min(size, archive_file->data.size() - archive_file->position);
+	if (size > 0)
+		memcpy(buffer, archive_file->data.data() + archive_file->position, size);
+	archive_file->position += size;
+	return size;
+}
+
+bool ArchiveFileInterface::Seek(FileHandle file, long offset, int origin)
+{
+	ArchiveFile* archive_file = reinterpret_cast<ArchiveFile*>(file);
+	if (archive_file->fallback_handle)
+		return fallback_interface->Seek(archive_file->fallback_handle, offset, origin);
+
+	long base = 0;
+	if (origin == SEEK_CUR)
+		base = (long)archive_file->position;
+	else if (origin == SEEK_END)
+		base = (long)archive_file->data.size();
+
+	const long position = base + offset;
+	if (position < 0 || position > (long)archive_file->data.size())
+		return false;
+
+	archive_file->position = (size_t)position;
+	return true;
+}
+
+size_t ArchiveFileInterface::Tell(FileHandle file)
+{
+	ArchiveFile* archive_file = reinterpret_cast<ArchiveFile*>(file);
+	if (archive_file->fallback_handle)
+		return fallback_interface->Tell(archive_file->fallback_handle);
+	return archive_file->position;
+}
+
+size_t ArchiveFileInterface::Length(FileHandle file)
+{
+	ArchiveFile* archive_file = reinterpret_cast<ArchiveFile*>(file);
+	if (archive_file->fallback_handle)
+		return fallback_interface->Length(archive_file->fallback_handle);
+	return archive_file->data.size();
+}
+
+bool ArchiveFileInterface::MapFile(const String& path, Span<const byte>& out_data, FileMappingHandle& out_handle)
+{
+	const Archive* archive = nullptr;
+	size_t entry_index = 0;
+	if (FindFile(path, archive, entry_index))
+	{
+		auto mapping = MakeUnique<ArchiveMapping>();
+		mapping->fallback_handle = 0;
+		mapping->fallback = false;
+		if (!GetContents(*archive, entry_index, out_data, mapping->buffer))
+			return false;
+		out_handle = reinterpret_cast<FileMappingHandle>(mapping.release());
+		return true;
+	}
+
+	FileMappingHandle fallback_handle = 0;
+	if (!fallback_interface || !fallback_interface->MapFile(path, out_data, fallback_handle))
+		return false;
+
+	out_handle = reinterpret_cast<FileMappingHandle>(new ArchiveMapping{nullptr, fallback_handle, true});
+	return true;
+}
+
+void ArchiveFileInterface::UnmapFile(FileMappingHandle handle)
+{
+	ArchiveMapping* mapping = reinterpret_cast<ArchiveMapping*>(handle);
+	if (mapping->fallback)
+		fallback_interface->UnmapFile(mapping->fallback_handle);
+	delete mapping;
+}
+
+bool ArchiveFileInterface::FindFile(const String& path, const Archive*& out_archive, size_t& out_entry_index) const
+{
+	if (archives.empty())
+		return false;
+
+	const String normalized_path = ArchiveFormat::NormalizePath(path);
+
+	// Search the most recently added archives first, so that they can override files of previous archives.
+	for (auto it = archives.rbegin(); it != archives.rend(); ++it)
+	{
+		const Archive& archive = **it;
+		if (normalized_path.compare(0, archive.mount_path.size(), archive.mount_path) != 0)
+			continue;
+
+		const String relative_path = normalized_path.substr(archive.mount_path.size());
+		const uint64_t hash = ArchiveFormat::HashPath(relative_path);
+		const size_t bucket = size_t(hash & (archive.header.num_buckets - 1));
+
+		const uint32_t bucket_end = archive.GetBucketStart(bucket + 1);
+		for (uint32_t i = archive.GetBucketStart(bucket); i < bucket_end; i++)
+		{
+			const Entry entry = archive.GetEntry(i);
+			if (entry.path_hash == hash && relative_path.compare(0, String::npos, archive.paths + entry.path_offset, entry.path_length) == 0)
+			{
+				out_archive = &archive;
+				out_entry_index = i;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool ArchiveFileInterface::GetContents(const Archive& archive, size_t entry_index, Span<const byte>& out_data, UniquePtr<byte[]>& out_buffer) const
+{
+	const Entry entry = archive.GetEntry(entry_index);
+	const Span<const byte> stored_data(archive.data.data() + entry.offset, size_t(entry.stored_size));
+
+	if (entry.compression == Compression::None)
+	{
+		out_data = stored_data;
+		return true;
+	}
+
+	const size_t size = size_t(entry.size);
+	out_buffer = UniquePtr<byte[]>(new byte[size]);
+	if (!ArchiveFormat::DecompressLZ4(stored_data, out_buffer.get(), size))
+	{
+		Log::Message(Log::LT_ERROR, "Could not decompress file %.*s from archive.", int(entry.path_length), archive.paths + entry.path_offset);
+		out_buffer.reset();
+		return false;
+	}
+
+	out_data = {out_buffer.get(), size};
+	return true;
+}
+
+} // namespace Rml
@@ -0,0 +1,215 @@
+#include "ArchiveFormat.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
+#include <string.h>
+
+namespace Rml {
+namespace ArchiveFormat {
+
+	namespace {
+		// Parameters of the LZ4 block format, see https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+		constexpr size_t MinMatch = 4;
+		constexpr size_t LastLiterals = 5;  // The last bytes of a block are always literals.
+		constexpr size_t MatchFindLimit = 12; // The last match must start at least this many bytes before the end of the block.
+		constexpr size_t MaxOffset = 65535;
+		constexpr int HashLog = 14;
+
+		inline uint32_t Read32(const byte* p)
+		{
+			uint32_t value;
+			memcpy(&value, p, sizeof(value));
+			return value;
+		}
+
+		inline uint32_t HashSequence(uint32_t sequence)
+		{
+			return (sequence * 2654435761u) >> (32 - HashLog);
+		}
+
+		void WriteLength(Vector<byte>& out_data, size_t length)
+		{
+			for (; length >= 255; length -= 255)
+				out_data.push_back(255);
+			out_data.push_back(byte(length));
+		}
+
+		// Writes a sequence of literals followed by a match, or only literals for the last sequence of a block when 'match_length' is zero.
+		void WriteSequence(Vector<byte>& out_data, const byte* literals, size_t num_literals, size_t offset, size_t match_length)
+		{
+			const size_t match_code = (match_length > 0 ? match_length - MinMatch : 0);
+			out_data.push_back(byte((Math::Min(num_literals, size_t(15)) << 4) | Math::Min(match_code, size_t(15))));
+
+			if (num_literals >= 15)
+				WriteLength(out_data, num_literals - 15);
+			out_data.insert(out_data.end(), literals, literals + num_literals);
+
+			if (match_length > 0)
+			{
+				out_data.push_back(byte(offset & 0xff));
+				out_data.push_back(byte(offset >> 8));
+				if (match_code >= 15)
+					WriteLength(out_data, match_code - 15);
+			}
+		}
+
+		// Reads the continuation bytes of a literal or match length.
+		bool ReadLength(const byte*& in, const byte* in_end, size_t& length)
+		{
+			byte value = 0;
+			do
+			{
+				if (in == in_end)
+					return false;
+				value = *in++;
+				length += value;
+			} while (value == 255);
+			return true;
+		}
+	} // namespace
+
+	String NormalizePath(const String& path)
+	{
+		const String slashed_path = StringUtilities::Replace(path, '\\', '/');
+
+		StringList segments;
+		size_t segment_begin = 0;
+		while (segment_begin <= slashed_path.size())
+		{
+			size_t segment_end = slashed_path.find('/', segment_begin);
+			if (segment_end == String::npos)
+				segment_end = slashed_path.size();
+
+			const String segment = slashed_path.substr(segment_begin, segment_end - segment_begin);
+			segment_begin = segment_end + 1;
+
+			if (segment.empty() || segment == ".")
+				continue;
+			if (segment == ".." && !segments.empty() && segments.back() != "..")
+				segments.pop_back();
+			else
+				segments.push_back(segment);
+		}
+
+		String result = (!slashed_path.empty() && slashed_path[0] == '/' ? "/" : "");
+		for (size_t i = 0; i < segments.size(); i++)
+		{
+			if (i > 0)
+				result += '/';
+			result += segments[i];
+		}
+		return result;
+	}
+
+	uint64_t HashPath(const String& normalized_path)
+	{
+		// 64-bit FNV-1a, the hash must remain stable between builds and platforms.
+		uint64_t hash = 0xcbf29ce484222325ull;
+		for (char c : normalized_path)
+		{
+			hash ^= uint64_t(uint8_t(c));
+			hash *= 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+	bool CompressLZ4(Span<const byte> source, Vector<byte>& out_data)
+	{
+		out_data.clear();
+
+		const byte* src = source.data();
+		const size_t size = source.size();
+		if (size == 0 || size > size_t(UINT32_MAX))
+			return false;
+
+		size_t anchor = 0;
+		if (size > MatchFindLimit)
+		{
+			constexpr uint32_t InvalidPosition = UINT32_MAX;
+			Vector<uint32_t> table(size_t(1) << HashLog, InvalidPosition);
+
+			const size_t match_end_limit = size - LastLiterals;
+			const size_t match_start_limit = size - MatchFindLimit;
+
+			size_t i = 0;
+			while (i <= match_start_limit)
+			{
+				const uint32_t sequence = Read32(src + i);
+				uint32_t& table_entry = table[HashSequence(sequence)];
+				const size_t candidate = table_entry;
+				table_entry = uint32_t(i);
+
+				if (candidate == InvalidPosition || i - candidate > MaxOffset || Read32(src + candidate) != sequence)
+				{
+					i += 1;
+					continue;
+				}
+
+				size_t match_length = MinMatch;
+				while (i + match_length < match_end_limit && src[candidate + match_length] == src[i + match_length])
+					match_length += 1;
+
+				WriteSequence(out_data, src + anchor, i - anchor, i - candidate, match_length);
+				i += match_length;
+				anchor = i;
+
+				if (out_data.size() >= size)
+					return false;
+			}
+		}
+
+		WriteSequence(out_data, src + anchor, size - anchor, 0, 0);
+		return out_data.size() < size;
+	}
+
+	bool DecompressLZ4(Span<const byte> source, byte* destination, size_t destination_size)
+	{
+		const byte* in = source.data();
+		const byte* const in_end = in + source.size();
+		byte* out = destination;
+		byte* const out_end = destination + destination_size;
+
+		while (in < in_end)
+		{
+			const byte token = *in++;
+
+			size_t num_literals = (token >> 4);
+			if (num_literals == 15 && !ReadLength(in, in_end, num_literals))
+				return false;
+			if (num_literals > size_t(in_end - in) || num_literals > size_t(out_end - out))
+				return false;
+
+			if (num_literals > 0)
+				memcpy(out, in, num_literals);
+			in += num_literals;
+			out += num_literals;
+
+			// The last sequence of a block only contains literals.
+			if (in == in_end)
+				break;
+
+			if (in_end - in < 2)
+				return false;
+			const size_t offset = size_t(in[0]) | (size_t(in[1]) << 8);
+			in += 2;
+			if (offset == 0 || offset > size_t(out - destination))
+				return false;
+
+			size_t match_length = (token & 0xf);
+			if (match_length == 15 && !ReadLength(in, in_end, match_length))
+				return false;
+			match_length += MinMatch;
+			if (match_length > size_t(out_end - out))
+				return false;
+
+			// Matches may overlap the bytes being written, so copy them one byte at a time.
+			const byte* match = out - offset;
+			for (size_t i = 0; i < match_length; i++)
+				out[i] = match[i];
+			out += match_length;
+		}
+
+		return out == out_end;
+	}
+
+} // namespace ArchiveFormat
+} // namespace Rml
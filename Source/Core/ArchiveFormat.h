@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+/*
+    The binary layout of resource archives, see ArchiveBuilder and ArchiveFileInterface.
+
+    An archive starts with the header, followed by the bucket table, the entries sorted by bucket, and the entry paths. The file contents
+    follow as blobs aligned to 'BlobAlignment' bytes. Entries are found by hashing their path into a bucket, so that a lookup only compares
+    the few entries of one bucket. All values are written in native byte order, archives are only loaded on platforms of the same endianness.
+*/
+namespace ArchiveFormat {
+
+	constexpr uint32_t Magic = 0x414C4D52; // 'RMLA'
+	constexpr uint32_t FormatVersion = 1;
+	constexpr uint32_t ByteOrderMark = 0x01020304;
+	constexpr size_t BlobAlignment = 16;
+
+	enum class Compression : uint8_t { None, LZ4 };
+
+	struct Header {
+		uint32_t magic;
+		uint32_t format_version;
+		uint32_t byte_order_mark;
+		uint32_t num_entries;
+		uint32_t num_buckets; // A power of two, followed by (num_buckets + 1) entry indices marking the first entry of each bucket.
+		uint32_t paths_size;
+	};
+
+	struct Entry {
+		uint64_t path_hash;
+		uint64_t offset;      // From the start of the archive.
+		uint64_t stored_size; // The size of the blob in the archive, which may be compressed.
+		uint64_t size;        // The size of the file contents.
+		uint32_t path_offset; // From the start of the paths.
+		uint32_t path_length;
+		Compression compression;
+		uint8_t padding[7];
+	};
+
+	static_assert(sizeof(Header) == 24 && sizeof(Entry) == 48, "Archive format structures must not depend on the platform.");
+
+	// Returns the number of bytes from the start of the archive to the entries.
+	inline size_t GetEntriesOffset(uint32_t num_buckets)
+	{
+		const size_t offset = sizeof(Header) + (size_t(num_buckets) + 1) * sizeof(uint32_t);
+		return (offset + alignof(uint64_t) - 1) & ~(alignof(uint64_t) - 1);
+	}
+
+	// Returns the path in the form stored in archives, with forward slashes and without any '.' or '..' segments.
+	String NormalizePath(const String& path);
+	uint64_t HashPath(const String& normalized_path);
+
+	// Compresses the source to the LZ4 block format, returns false if the compressed data would not be smaller than the source.
+	bool CompressLZ4(Span<const byte> source, Vector<byte>& out_data);
+	// Decompresses data in the LZ4 block format, returns false unless the data decompresses to exactly the destination size.
+	bool DecompressLZ4(Span<const byte> source, byte* destination, size_t destination_size);
+
+} // namespace ArchiveFormat
+} // namespace Rml
@@ -0,0 +1,56 @@
+#include "Atom.h"
+#include <atomic>
+#include <mutex>
+
+namespace Rml {
+
+namespace {
+	struct AtomTable {
+		std::mutex mutex;
+		UnorderedMap<String, Atom> atoms;
+		std::atomic<uint32_t> num_atoms{0};
+	};
+} // namespace
+
+static AtomTable& GetAtomTable()
+{
+	static AtomTable atom_table;
+	return atom_table;
+}
+
+Atom MakeAtom(const String& name)
+{
+	if (name.empty())
+		return Atom::Empty;
+
+	AtomTable& table = GetAtomTable();
+	std::lock_guard<std::mutex> lock(table.mutex);
+
+	auto it = table.atoms.find(name);
+	if (it != table.atoms.end())
+		return it->second;
+
+	const Atom atom = Atom(uint32_t(table.atoms.size()) + 1);
+	table.atoms.emplace(name, atom);
+	table.num_atoms.store(uint32_t(table.atoms.size()), std::memory_order_release);
+	return atom;
+}
+
+Atom FindAtom(const String& name)
+{
+	if (name.empty())
+		return Atom::Empty;
+
+	AtomTable& table = GetAtomTable();
+	std::lock_guard<std::mutex> lock(table.mutex);
+
+	auto it = table.atoms.find(name);
+	return it != table.atoms.end() ? it->second : Atom::Empty;
+}
+
+uint32_t GetNumAtoms()
+{
+	return GetAtomTable().num_atoms.load(std::memory_order_acquire);
+}
+
+} // namespace Rml
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+/**
+    Atoms are integer handles to interned names, such as tag and class names.
+
+    A name maps to the same atom for the lifetime of the program, so that names can be compared and indexed as integers. Interned names are never
+    released, thus only names from documents and style sheets should be interned, not arbitrary user data. Names set at runtime, such as the
+    classes of elements, are only looked up with FindAtom().
+ */
+enum class Atom : uint32_t { Empty = 0 };
+
+/// Returns the atom of the given name, interning the name if needed. The empty name always maps to Atom::Empty.
+/// @note Thread-safe.
+Atom MakeAtom(const String& name);
+
+/// Returns the atom of the given name, or Atom::Empty if the name has not been interned.
+/// @note Thread-safe.
+Atom FindAtom(const String& name);
+
+/// Returns the number of interned names, which only changes when a new name is interned.
+/// @note Thread-safe, without locking.
+uint32_t GetNumAtoms();
+
+/// Returns a mask with a single bit set for the given name. The masks of several names can be combined to quickly rule out that one set of names
+/// contains another, without the names having to be interned.
+inline uint64_t GetNameMask(const String& name)
+{
+	return uint64_t(1) << (Hash<String>()(name) % 64);
+}
+
+} // namespace Rml
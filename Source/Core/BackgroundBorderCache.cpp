@@ -0,0 +1,174 @@
+#include "BackgroundBorderCache.h"
+#include "../../Include/RmlUi/Core/ComputedValues.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/MeshUtilities.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/RenderManager.h"
+#include "../Core/ControlledLifetimeResource.h"
+#include "BoxShadowHash.h"
+#include "GeometryBackgroundBorder.h"
+
+namespace std {
+
+template <>
+struct hash<::Rml::BackgroundBorderGeometryInfo> {
+	size_t operator()(const ::Rml::BackgroundBorderGeometryInfo& in) const noexcept
+	{
+		using namespace ::Rml::Utilities;
+		size_t seed = hash<const void*>{}(in.render_manager);
+
+		HashCombine(seed, in.background_color);
+		for (const auto& v : in.border_colors)
+		{
+			HashCombine(seed, v);
+		}
+		for (const auto& v : in.padding_render_boxes)
+		{
+			HashCombine(seed, v);
+		}
+		return seed;
+	}
+};
+
+} // namespace std
+
+namespace Rml {
+
+struct BackgroundBorderCacheData {
+	StableUnorderedMap<BackgroundBorderGeometryInfo, WeakPtr<BackgroundBorderRenderable>> handles;
+};
+
+static void ReleaseHandle(BackgroundBorderRenderable* handle);
+
+BackgroundBorderRenderable::BackgroundBorderRenderable(const BackgroundBorderGeometryInfo& geometry_info) : cache_key(geometry_info) {}
+
+BackgroundBorderRenderable::~BackgroundBorderRenderable()
+{
+	ReleaseHandle(this);
+}
+
+static ControlledLifetimeResource<BackgroundBorderCacheData> background_border_cache_data;
+
+void BackgroundBorderCache::Initialize()
+{
+	background_border_cache_data.Initialize();
+}
+
+void BackgroundBorderCache::Shutdown()
+{
+	background_border_cache_data.Shutdown();
+}
+
+static Vector2f GetBorderSize(const RenderBox& render_box)
+{
+	const EdgeSizes& widths = render_box.GetBorderWidths();
+	return render_box.GetFillSize() + Vector2f(widths[1] + widths[3], widths[0] + widths[2]);
+}
+
+static Colourf ToColourf(ColourbPremultiplied color)
+{
+	return Colourf(float(color.red) / 255.f, float(color.green) / 255.f, float(color.blue) / 255.f, float(color.alpha) / 255.f);
+}
+
+// Compiles the rounded box shader when supported by the render interface, which draws the background and border of a single box on a quad.
+// These are otherwise tessellated into many vertices along their curves, thus the shader is only used for boxes with rounded corners.
+static CompiledShader CompileRoundedBoxShader(RenderManager& render_manager, const BackgroundBorderGeometryInfo& info)
+{
+	if (info.padding_render_boxes.size() != 1)
+		return {};
+
+	const RenderBox& render_box = info.padding_render_boxes[0];
+	const EdgeSizes border_widths = render_box.GetBorderWidths();
+	const BorderMetrics metrics =
+		GeometryBackgroundBorder::ComputeBorderMetrics(Vector2f(0.f), border_widths, render_box.GetFillSize(), render_box.GetBorderRadius());
+	const CornerSizes& radii = metrics.outer_radii;
+	if (radii[0] + radii[1] + radii[2] + radii[3] <= 0.f || !render_manager.SupportsShader("rounded-box"))
+		return {};
+
+	return render_manager.CompileShader("rounded-box",
+		Dictionary{
+			{"dimensions", Variant(GetBorderSize(render_box))},
+			{"radius", Variant(Vector4f(radii[0], radii[1], radii[2], radii[3]))},
+			{"border_widths", Variant(Vector4f(border_widths[0], border_widths[1], border_widths[2], border_widths[3]))},
+			{"background_color", Variant(ToColourf(info.background_color))},
+			{"border_top_color", Variant(ToColourf(info.border_colors[0]))},
+			{"border_right_color", Variant(ToColourf(info.border_colors[1]))},
+			{"border_bottom_color", Variant(ToColourf(info.border_colors[2]))},
+			{"border_left_color", Variant(ToColourf(info.border_colors[3]))},
+		});
+}
+
+static SharedPtr<BackgroundBorderRenderable> GetOrCreateBackgroundBorder(RenderManager& render_manager, BackgroundBorderGeometryInfo&& info)
+{
+	auto it_handle = background_border_cache_data->handles.find(info);
+	if (it_handle != background_border_cache_data->handles.end())
+	{
+		SharedPtr<BackgroundBorderRenderable> result = it_handle->second.lock();
+		RMLUI_ASSERTMSG(result, "Failed to lock handle in background border cache");
+		return result;
+	}
+
+	RMLUI_ZoneScoped;
+	const auto iterator_inserted = background_border_cache_data->handles.emplace(std::move(info), WeakPtr<BackgroundBorderRenderable>());
+	RMLUI_ASSERTMSG(iterator_inserted.second, "Could not insert entry into the background border cache handle map, duplicate key.");
+	const BackgroundBorderGeometryInfo& inserted_key = iterator_inserted.first->first;
+	WeakPtr<BackgroundBorderRenderable>& inserted_weak_data_pointer = iterator_inserted.first->second;
+
+	auto handle = MakeShared<BackgroundBorderRenderable>(inserted_key);
+
+	Mesh mesh;
+	handle->shader = CompileRoundedBoxShader(render_manager, inserted_key);
+	if (handle->shader)
+	{
+		const RenderBox& render_box = inserted_key.padding_render_boxes[0];
+		const Vector2f dimensions = GetBorderSize(render_box);
+		MeshUtilities::GenerateQuad(mesh, render_box.GetBorderOffset(), dimensions, ColourbPremultiplied(255), Vector2f(0.f), dimensions);
+	}
+	else
+	{
+		for (const RenderBox& render_box : inserted_key.padding_render_boxes)
+			MeshUtilities::GenerateBackgroundBorder(mesh, render_box, inserted_key.background_color, inserted_key.border_colors.data());
+	}
+	handle->geometry = render_manager.MakeGeometry(std::move(mesh));
+
+	inserted_weak_data_pointer = handle;
+	return handle;
+}
+
+static void ReleaseHandle(BackgroundBorderRenderable* handle)
+{
+	auto& handles = background_border_cache_data->handles;
+	auto it_handle = handles.find(handle->cache_key);
+	RMLUI_ASSERT(it_handle != handles.cend());
+
+	handles.erase(it_handle);
+}
+
+SharedPtr<BackgroundBorderRenderable> BackgroundBorderCache::GetHandle(Element* element, const ComputedValues& computed)
+{
+	RenderManager* render_manager = element->GetRenderManager();
+	if (!render_manager)
+		return {};
+
+	const float opacity = computed.opacity();
+	BackgroundBorderGeometryInfo info = {
+		render_manager,
+		{},
+		computed.background_color().ToPremultiplied(opacity),
+		{
+			computed.border_top_color().ToPremultiplied(opacity),
+			computed.border_right_color().ToPremultiplied(opacity),
+			computed.border_bottom_color().ToPremultiplied(opacity),
+			computed.border_left_color().ToPremultiplied(opacity),
+		},
+	};
+
+	const int num_boxes = element->GetNumBoxes();
+	info.padding_render_boxes.reserve(num_boxes);
+	for (int i = 0; i < num_boxes; i++)
+		info.padding_render_boxes.push_back(element->GetRenderBox(BoxArea::Padding, i));
+
+	return GetOrCreateBackgroundBorder(*render_manager, std::move(info));
+}
+
+} // namespace Rml
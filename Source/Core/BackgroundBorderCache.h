@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/CompiledFilterShader.h"
+#include "../../Include/RmlUi/Core/Geometry.h"
+#include "../../Include/RmlUi/Core/RenderBox.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+namespace Style {
+	class ComputedValues;
+}
+
+struct BackgroundBorderGeometryInfo {
+	RenderManager* render_manager;
+	Vector<RenderBox> padding_render_boxes;
+	ColourbPremultiplied background_color;
+	Array<ColourbPremultiplied, 4> border_colors;
+};
+inline bool operator==(const BackgroundBorderGeometryInfo& a, const BackgroundBorderGeometryInfo& b)
+{
+	return a.render_manager == b.render_manager && a.padding_render_boxes == b.padding_render_boxes && a.background_color == b.background_color &&
+		a.border_colors == b.border_colors;
+}
+inline bool operator!=(const BackgroundBorderGeometryInfo& a, const BackgroundBorderGeometryInfo& b)
+{
+	return !(a == b);
+}
+
+struct BackgroundBorderRenderable : NonCopyMoveable {
+	BackgroundBorderRenderable(const BackgroundBorderGeometryInfo& geometry_info);
+	~BackgroundBorderRenderable();
+
+	Geometry geometry;
+	// Set when the geometry is a quad to be rendered with the render interface's rounded box shader.
+	CompiledShader shader;
+	const BackgroundBorderGeometryInfo& cache_key;
+};
+
+class BackgroundBorderCache {
+public:
+	static void Initialize();
+	static void Shutdown();
+
+	/// Returns a handle to the background and border geometry matching the element's boxes and style - creates new data if none is found.
+	/// @param[in] element Element for which to generate and cache the geometry.
+	/// @param[in] computed The computed style values of the element.
+	/// @return A handle to the geometry in element-local coordinates, with automatic reference counting.
+	static SharedPtr<BackgroundBorderRenderable> GetHandle(Element* element, const Style::ComputedValues& computed);
+};
+
+} // namespace Rml
@@ -0,0 +1,63 @@
+#include "BackgroundTasks.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/TaskInterface.h"
+#include <algorithm>
+
+namespace Rml {
+
+static bool rendering_enabled = false;
+
+BackgroundTasks::~BackgroundTasks()
+{
+	WaitAll();
+}
+
+bool BackgroundTasks::Submit(Function<void()> task)
+{
+	TaskInterface* task_interface = GetTaskInterface();
+	if (!task_interface)
+		return false;
+
+	// Release the handles of completed tasks, waiting for them returns immediately.
+	auto it_done =
+		std::partition(tasks.begin(), tasks.end(), [](const SubmittedTask& entry) { return !entry.done->load(std::memory_order_acquire); });
+	for (auto it = it_done; it != tasks.end(); ++it)
+		task_interface->Wait(it->handle);
+	tasks.erase(it_done, tasks.end());
+
+	auto done = MakeShared<std::atomic<bool>>(false);
+	const TaskHandle handle = task_interface->Submit([task = std::move(task), done]() {
+		task();
+		done->store(true, std::memory_order_release);
+	});
+	tasks.push_back(SubmittedTask{handle, std::move(done)});
+
+	return true;
+}
+
+void BackgroundTasks::WaitAll()
+{
+	if (tasks.empty())
+		return;
+
+	TaskInterface* task_interface = GetTaskInterface();
+	RMLUI_ASSERTMSG(task_interface, "The task interface was removed while tasks were still running.");
+	if (task_interface)
+	{
+		for (const SubmittedTask& entry : tasks)
+			task_interface->Wait(entry.handle);
+	}
+	tasks.clear();
+}
+
+void BackgroundTasks::SetRenderingEnabled(bool enable)
+{
+	rendering_enabled = enable;
+}
+
+bool BackgroundTasks::IsRenderingEnabled()
+{
+	return rendering_enabled;
+}
+
+} // namespace Rml
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+#include <atomic>
+
+namespace Rml {
+
+/**
+    Runs tasks in the background through the application's task interface, keeping track of them so that each one is waited for exactly once.
+
+    Tasks that have completed are waited for when submitting new tasks, while any remaining tasks are waited for on destruction. Not thread-safe,
+    tasks should be submitted from the same thread.
+ */
+class BackgroundTasks : NonCopyMoveable {
+public:
+	~BackgroundTasks();
+
+	/// Submits the task through the installed task interface.
+	/// @return False if no task interface is installed, in which case the task was not submitted.
+	bool Submit(Function<void()> task);
+
+	/// Waits for all submitted tasks to complete.
+	void WaitAll();
+
+	/// Enables rendering plugin content in the background, see Rml::SetBackgroundRendering().
+	static void SetRenderingEnabled(bool enable);
+	/// Returns true if plugins should render their content in the background, otherwise it is rendered on the calling thread.
+	static bool IsRenderingEnabled();
+
+private:
+	struct SubmittedTask {
+		TaskHandle handle;
+		SharedPtr<std::atomic<bool>> done;
+	};
+
+	Vector<SubmittedTask> tasks;
+};
+
+} // namespace Rml
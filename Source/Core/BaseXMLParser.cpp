@@ -2,6 +2,7 @@
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/Stream.h"
 #include "XMLParseTools.h"
+#include <limits>
 #include <string.h>
 
 namespace Rml {
@@ -28,16 +29,30 @@ void BaseXMLParser::RegisterInnerXMLAttribute(const String& attribute_name)
 
 void BaseXMLParser::Parse(Stream* stream)
 {
-	source_url = &stream->GetSourceURL();
+	ParseBegin(stream);
 
-	xml_source.clear();
+	bool finished = false;
+	while (!finished)
+		finished = ParseNext(std::numeric_limits<int>::max());
+}
 
-	// We read in the whole XML file here.
-	// TODO: It doesn't look like the Stream interface is used for anything useful. We
-	//   might as well just use a span or StringView, and get completely rid of it.
-	// @performance Otherwise, use the temporary allocator.
-	const size_t source_size = stream->Length();
-	stream->Read(xml_source, source_size);
+void BaseXMLParser::ParseBegin(Stream* stream)
+{
+	source_url = &stream->GetSourceURL();
+
+	// Parse memory streams in-place, otherwise we read in the whole XML file here.
+	size_t source_size = 0;
+	if (const byte* source_data = stream->PeekContiguous(source_size))
+	{
+		xml_source = StringView(reinterpret_cast<const char*>(source_data), reinterpret_cast<const char*>(source_data) + source_size);
+		stream->Seek(long(source_size), SEEK_CUR);
+	}
+	else
+	{
+		xml_source_buffer.clear();
+		stream->Read(xml_source_buffer, stream->Length());
+		xml_source = StringView(xml_source_buffer);
+	}
 
 	xml_index = 0;
 	line_number = 1;
@@ -49,10 +64,65 @@ void BaseXMLParser::Parse(Stream* stream)
 
 	// Read (er ... skip) the header, if one exists.
 	ReadHeader();
-	// Read the XML body.
-	ReadBody();
 
-	xml_source.clear();
+	open_tag_depth = 0;
+	line_number_open_tag = 0;
+}
+
+bool BaseXMLParser::ParseNext(int max_tags)
+{
+	RMLUI_ZoneScoped;
+	RMLUI_ASSERTMSG(source_url, "No parse in progress, see ParseBegin().");
+
+	for (int i = 0; i < max_tags; i++)
+	{
+		if (!ReadBodyTag())
+		{
+			ParseEnd();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void BaseXMLParser::ParseEnd()
+{
+	// Check for error conditions
+	if (open_tag_depth > 0)
+	{
+		Log::Message(Log::LT_WARNING, "XML parse error on line %d of %s.", GetLineNumber(), source_url->GetURL().c_str());
+	}
+
+	xml_source = StringView();
+	xml_source_buffer.clear();
+	source_url = nullptr;
+}
+
+void BaseXMLParser::SetRecordEvents(XMLParseEventList* events)
+{
+	record_events = events;
+}
+
+void BaseXMLParser::Replay(const XMLParseEventList& events, const URL& url)
+{
+	RMLUI_ZoneScoped;
+
+	source_url = &url;
+
+	for (const XMLParseEvent& event : events)
+	{
+		line_number = event.line_number;
+		line_number_open_tag = event.line_number_open_tag;
+
+		switch (event.type)
+		{
+		case XMLParseEvent::Type::ElementStart: HandleElementStart(event.value, event.attributes); break;
+		case XMLParseEvent::Type::ElementEnd: HandleElementEnd(event.value); break;
+		case XMLParseEvent::Type::Data: HandleData(event.value, event.data_type); break;
+		}
+	}
+
 	source_url = nullptr;
 }
 
@@ -90,26 +160,38 @@ bool BaseXMLParser::AtEnd() const
 char BaseXMLParser::Look() const
 {
 	RMLUI_ASSERT(!AtEnd());
-	return xml_source[xml_index];
+	return xml_source.begin()[xml_index];
 }
 
 void BaseXMLParser::HandleElementStartInternal(const String& name, const XMLAttributes& attributes)
 {
 	line_number_open_tag = line_number;
 	if (!inner_xml_data)
+	{
+		if (record_events)
+			record_events->push_back(XMLParseEvent{XMLParseEvent::Type::ElementStart, XMLDataType::Text, line_number, line_number_open_tag, name, attributes});
 		HandleElementStart(name, attributes);
+	}
 }
 
 void BaseXMLParser::HandleElementEndInternal(const String& name)
 {
 	if (!inner_xml_data)
+	{
+		if (record_events)
+			record_events->push_back(XMLParseEvent{XMLParseEvent::Type::ElementEnd, XMLDataType::Text, line_number, line_number_open_tag, name, {}});
 		HandleElementEnd(name);
+	}
 }
 
 void BaseXMLParser::HandleDataInternal(const String& data, XMLDataType type)
 {
 	if (!inner_xml_data)
+	{
+		if (record_events)
+			record_events->push_back(XMLParseEvent{XMLParseEvent::Type::Data, type, line_number, line_number_open_tag, data, {}});
 		HandleData(data, type);
+	}
 }
 
 void BaseXMLParser::ReadHeader()
@@ -121,57 +203,45 @@ void BaseXMLParser::ReadHeader()
 	}
 }
 
-void BaseXMLParser::ReadBody()
+bool BaseXMLParser::ReadBodyTag()
 {
-	RMLUI_ZoneScoped;
+	// Find the next open tag.
+	if (!FindString("<", data, true))
+		return false;
 
-	open_tag_depth = 0;
-	line_number_open_tag = 0;
+	const size_t xml_index_tag = xml_index - 1;
 
-	for (;;)
+	// Check what kind of tag this is.
+	if (PeekString("!--"))
 	{
-		// Find the next open tag.
-		if (!FindString("<", data, true))
-			break;
-
-		const size_t xml_index_tag = xml_index - 1;
-
-		// Check what kind of tag this is.
-		if (PeekString("!--"))
-		{
-			// Comment.
-			String temp;
-			if (!FindString("-->", temp))
-				break;
-		}
-		else if (PeekString("![CDATA["))
-		{
-			// CDATA tag; read everything (including markup) until the ending
-			// CDATA tag.
-			if (!ReadCDATA())
-				break;
-		}
-		else if (PeekString("/"))
-		{
-			if (!ReadCloseTag(xml_index_tag))
-				break;
-
-			// Bail if we've hit the end of the XML data.
-			if (open_tag_depth == 0)
-				break;
-		}
-		else
-		{
-			if (!ReadOpenTag())
-				break;
-		}
+		// Comment.
+		String temp;
+		if (!FindString("-->", temp))
+			return false;
+	}
+	else if (PeekString("![CDATA["))
+	{
+		// CDATA tag; read everything (including markup) until the ending
+		// CDATA tag.
+		if (!ReadCDATA())
+			return false;
 	}
+	else if (PeekString("/"))
+	{
+		if (!ReadCloseTag(xml_index_tag))
+			return false;
 
-	// Check for error conditions
-	if (open_tag_depth > 0)
+		// Bail if we've hit the end of the XML data.
+		if (open_tag_depth == 0)
+			return false;
+	}
+	else
 	{
-		Log::Message(Log::LT_WARNING, "XML parse error on line %d of %s.", GetLineNumber(), source_url->GetURL().c_str());
+		if (!ReadOpenTag())
+			return false;
 	}
+
+	return true;
 }
 
 bool BaseXMLParser::ReadOpenTag()
@@ -274,7 +344,7 @@ bool BaseXMLParser::ReadCloseTag(const size_t xml_index_tag)
 		// submitted next, and disable the mode to resume normal parsing behavior.
 		RMLUI_ASSERT(inner_xml_data_index_begin <= xml_index_tag);
 		inner_xml_data = false;
-		data = xml_source.substr(inner_xml_data_index_begin, xml_index_tag - inner_xml_data_index_begin);
+		data.assign(xml_source.begin() + inner_xml_data_index_begin, xml_index_tag - inner_xml_data_index_begin);
 		HandleDataInternal(data, XMLDataType::InnerXML);
 		data.clear();
 	}
@@ -414,8 +484,17 @@ bool BaseXMLParser::FindWord(String& word, const char* terminators)
 			return !word.empty();
 		}
 
-		word += c;
+		// Add the following word characters in one go.
+		const size_t word_begin = xml_index;
 		Next();
+		while (!AtEnd())
+		{
+			const char c_next = Look();
+			if (StringUtilities::IsWhitespace(c_next) || (terminators && strchr(terminators, c_next)))
+				break;
+			Next();
+		}
+		word.append(xml_source.begin() + word_begin, xml_index - word_begin);
 	}
 
 	return false;
@@ -430,6 +509,31 @@ bool BaseXMLParser::FindString(const char* string, String& data, bool escape_bra
 
 	while (!AtEnd())
 	{
+		// Add runs of characters which cannot affect the search in one go, that is, anything but the first character of the search string,
+		// or any curly brackets when we need to track them.
+		if (!in_brackets)
+		{
+			const size_t run_begin = xml_index;
+			while (!AtEnd())
+			{
+				const char c_run = Look();
+				if (c_run == first_char || (escape_brackets && (c_run == '{' || c_run == '}')))
+					break;
+				if (c_run == '\n')
+					line_number++;
+				Next();
+			}
+
+			if (xml_index > run_begin)
+			{
+				data.append(xml_source.begin() + run_begin, xml_index - run_begin);
+				previous = xml_source.begin()[xml_index - 1];
+			}
+
+			if (AtEnd())
+				break;
+		}
+
 		const char c = Look();
 
 		// Count line numbers
@@ -1,21 +1,85 @@
 #include "../../Include/RmlUi/Core/Box.h"
+#include <algorithm>
 #include <string.h>
 
 namespace Rml {
 
+static constexpr int num_box_edges = Box::num_areas * Box::num_edges;
+
+// Shared by all boxes without padding, borders and margins.
+static const float zero_edges[num_box_edges] = {};
+
+static int EdgeIndex(BoxArea area, BoxEdge edge)
+{
+	return (int)area * Box::num_edges + (int)edge;
+}
+
 Box::Box() {}
 Box::Box(Vector2f content) : content(content) {}
 
-Box::~Box() {}
+Box::~Box()
+{
+	delete[] edges;
+}
+
+Box::Box(const Box& other) : content(other.content)
+{
+	if (other.edges)
+	{
+		edges = new float[num_box_edges];
+		std::copy_n(other.edges, num_box_edges, edges);
+	}
+}
+
+Box::Box(Box&& other) noexcept : content(other.content), edges(other.edges)
+{
+	other.edges = nullptr;
+}
+
+Box& Box::operator=(const Box& other)
+{
+	if (this == &other)
+		return *this;
+
+	content = other.content;
+	if (!other.edges)
+	{
+		// Keep any allocated edges for reuse, zero-sized edges compare equal to missing ones.
+		if (edges)
+			std::fill_n(edges, num_box_edges, 0.f);
+	}
+	else
+	{
+		if (!edges)
+			edges = new float[num_box_edges];
+		std::copy_n(other.edges, num_box_edges, edges);
+	}
+	return *this;
+}
+
+Box& Box::operator=(Box&& other) noexcept
+{
+	content = other.content;
+	std::swap(edges, other.edges);
+	return *this;
+}
+
+const float* Box::GetEdges() const
+{
+	return edges ? edges : zero_edges;
+}
 
 Vector2f Box::GetPosition(BoxArea area) const
 {
 	RMLUI_ASSERT(area != BoxArea::Auto);
+	if (!edges)
+		return Vector2f(0);
+
 	Vector2f area_position(-GetEdge(BoxArea::Margin, BoxEdge::Left), -GetEdge(BoxArea::Margin, BoxEdge::Top));
 	for (int i = 0; i < (int)area; i++)
 	{
-		area_position.x += area_edges[i][(int)BoxEdge::Left];
-		area_position.y += area_edges[i][(int)BoxEdge::Top];
+		area_position.x += edges[EdgeIndex(BoxArea(i), BoxEdge::Left)];
+		area_position.y += edges[EdgeIndex(BoxArea(i), BoxEdge::Top)];
 	}
 
 	return area_position;
@@ -30,10 +94,13 @@ Vector2f Box::GetSize(BoxArea area) const
 {
 	RMLUI_ASSERT(area != BoxArea::Auto);
 	Vector2f area_size(content);
+	if (!edges)
+		return area_size;
+
 	for (int i = (int)area; i <= (int)BoxArea::Padding; i++)
 	{
-		area_size.x += (area_edges[i][(int)BoxEdge::Left] + area_edges[i][(int)BoxEdge::Right]);
-		area_size.y += (area_edges[i][(int)BoxEdge::Top] + area_edges[i][(int)BoxEdge::Bottom]);
+		area_size.x += (edges[EdgeIndex(BoxArea(i), BoxEdge::Left)] + edges[EdgeIndex(BoxArea(i), BoxEdge::Right)]);
+		area_size.y += (edges[EdgeIndex(BoxArea(i), BoxEdge::Top)] + edges[EdgeIndex(BoxArea(i), BoxEdge::Bottom)]);
 	}
 
 	return area_size;
@@ -46,23 +113,32 @@ void Box::SetContent(Vector2f _content)
 
 void Box::SetEdge(BoxArea area, BoxEdge edge, float size)
 {
-	RMLUI_ASSERT(area != BoxArea::Auto);
-	area_edges[(int)area][(int)edge] = size;
+	RMLUI_ASSERT(area != BoxArea::Auto && area != BoxArea::Content);
+	if (!edges)
+	{
+		if (size == 0.f)
+			return;
+		edges = new float[num_box_edges]();
+	}
+	edges[EdgeIndex(area, edge)] = size;
 }
 
 float Box::GetEdge(BoxArea area, BoxEdge edge) const
 {
 	RMLUI_ASSERT(area != BoxArea::Auto);
-	return area_edges[(int)area][(int)edge];
+	return GetEdges()[EdgeIndex(area, edge)];
 }
 
 float Box::GetCumulativeEdge(BoxArea area, BoxEdge edge) const
 {
 	RMLUI_ASSERT(area != BoxArea::Auto);
+	if (!edges)
+		return 0.f;
+
 	float size = 0;
 	int max_area = Math::Min((int)area, (int)BoxArea::Padding);
 	for (int i = 0; i <= max_area; i++)
-		size += area_edges[i][(int)edge];
+		size += edges[EdgeIndex(BoxArea(i), edge)];
 
 	return size;
 }
@@ -77,8 +153,11 @@ float Box::GetSizeAcross(BoxDirection direction, BoxArea area_outer, BoxArea are
 	if (area_inner == BoxArea::Content)
 		size = (direction == BoxDirection::Horizontal ? content.x : content.y);
 
+	if (!edges)
+		return size;
+
 	for (int i = (int)area_outer; i <= (int)area_inner && i < (int)BoxArea::Content; i++)
-		size += (area_edges[i][(int)BoxEdge::Top + (int)direction] + area_edges[i][(int)BoxEdge::Bottom + (int)direction]);
+		size += (edges[i * num_edges + (int)BoxEdge::Top + (int)direction] + edges[i * num_edges + (int)BoxEdge::Bottom + (int)direction]);
 
 	return size;
 }
@@ -88,15 +167,20 @@ Vector2f Box::GetFrameSize(BoxArea area) const
 	if (area == BoxArea::Content)
 		return content;
 
+	const float* area_edges = GetEdges() + (int)area * num_edges;
 	return {
-		area_edges[(int)area][(int)BoxEdge::Right] + area_edges[(int)area][(int)BoxEdge::Left],
-		area_edges[(int)area][(int)BoxEdge::Top] + area_edges[(int)area][(int)BoxEdge::Bottom],
+		area_edges[(int)BoxEdge::Right] + area_edges[(int)BoxEdge::Left],
+		area_edges[(int)BoxEdge::Top] + area_edges[(int)BoxEdge::Bottom],
 	};
 }
 
 bool Box::operator==(const Box& rhs) const
 {
-	return content == rhs.content && memcmp(area_edges, rhs.area_edges, sizeof(area_edges)) == 0;
+	if (content != rhs.content)
+		return false;
+	if (edges == rhs.edges)
+		return true;
+	return memcmp(GetEdges(), rhs.GetEdges(), sizeof(float) * num_box_edges) == 0;
 }
 
 bool Box::operator!=(const Box& rhs) const
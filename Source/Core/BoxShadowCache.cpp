@@ -1,6 +1,6 @@
 #include "BoxShadowCache.h"
 #include "../../Include/RmlUi/Core/ComputedValues.h"
-#include "../../Include/RmlUi/Core/MeshUtilities.h"
+#include "../../Include/RmlUi/Core/Mesh.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/RenderManager.h"
 #include "../Core/ControlledLifetimeResource.h"
@@ -54,8 +54,7 @@ static SharedPtr<BoxShadowRenderable> GetOrCreateBoxShadow(RenderManager& render
 	GeometryBoxShadow::GenerateTexture(shadow_handle->texture, shadow_handle->background_border_geometry, render_manager, inserted_key);
 
 	Mesh mesh;
-	const byte alpha = byte(info.opacity * 255.f);
-	MeshUtilities::GenerateQuad(mesh, -info.element_offset_in_texture, Vector2f(info.texture_dimensions), ColourbPremultiplied(alpha, alpha));
+	GeometryBoxShadow::GenerateMesh(mesh, inserted_key, Vector2f(0.f));
 	shadow_handle->geometry = render_manager.MakeGeometry(std::move(mesh));
 
 	inserted_weak_data_pointer = shadow_handle;
@@ -76,7 +75,7 @@ static void ReleaseHandle(BoxShadowRenderable* handle)
 	handles.erase(it_handle);
 }
 
-SharedPtr<BoxShadowRenderable> BoxShadowCache::GetHandle(Element* element, const ComputedValues& computed)
+SharedPtr<BoxShadowRenderable> BoxShadowCache::GetHandle(Element* element, const ComputedValues& computed, Vector2f& out_stretch)
 {
 	RenderManager* render_manager = element->GetRenderManager();
 	if (!render_manager)
@@ -90,7 +89,8 @@ SharedPtr<BoxShadowRenderable> BoxShadowCache::GetHandle(Element* element, const
 		computed.border_left_color().ToPremultiplied(),
 	};
 	const CornerSizes border_radius = computed.border_radius();
-	BoxShadowGeometryInfo geom_info = GeometryBoxShadow::Resolve(element, border_radius, background_color, border_colors, computed.opacity());
+	BoxShadowGeometryInfo geom_info =
+		GeometryBoxShadow::Resolve(element, border_radius, background_color, border_colors, computed.opacity(), out_stretch);
 	return GetOrCreateBoxShadow(*render_manager, geom_info);
 }
 
@@ -28,8 +28,9 @@ public:
 	/// Returns a handle to BoxShadow renderable matching the element's style - creates new data if none is found.
 	/// @param[in] element Element for which to calculate and cache the box shadow.
 	/// @param[in] computed The computed style values of the element.
+	/// @param[out] out_stretch The size to stretch the shared texture by to cover the element, see GeometryBoxShadow::GenerateMesh().
 	/// @return A handle to the BoxShadow data, with automatic reference counting.
-	static SharedPtr<BoxShadowRenderable> GetHandle(Element* element, const Style::ComputedValues& computed);
+	static SharedPtr<BoxShadowRenderable> GetHandle(Element* element, const Style::ComputedValues& computed, Vector2f& out_stretch);
 };
 
 } // namespace Rml
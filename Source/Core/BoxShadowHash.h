@@ -122,6 +122,7 @@ struct hash<::Rml::BoxShadowGeometryInfo> {
 
 		HashCombine(seed, in.texture_dimensions);
 		HashCombine(seed, in.element_offset_in_texture);
+		HashCombine(seed, in.slice_position);
 
 		for (const auto& v : in.padding_render_boxes)
 		{
@@ -18,6 +18,13 @@ Rml::CallbackTexture::operator Texture() const
 	return Texture(render_manager, resource_handle);
 }
 
+bool CallbackTexture::UpdateTexture(Rectanglei region, Span<const byte> source) const
+{
+	if (resource_handle == StableVectorIndex::Invalid)
+		return false;
+	return RenderManagerAccess::UpdateTexture(render_manager, resource_handle, region, source);
+}
+
 CallbackTextureInterface::CallbackTextureInterface(RenderManager& render_manager, RenderInterface& render_interface, TextureHandle& texture_handle,
 	Vector2i& dimensions) : render_manager(render_manager), render_interface(render_interface), texture_handle(texture_handle), dimensions(dimensions)
 {}
@@ -29,7 +36,7 @@ bool CallbackTextureInterface::GenerateTexture(Span<const byte> source, Vector2i
 		RMLUI_ERRORMSG("Texture already set");
 		return false;
 	}
-	texture_handle = render_interface.GenerateTexture(source, new_dimensions);
+	texture_handle = RenderManagerAccess::GenerateCallbackTexture(&render_manager, source, new_dimensions);
 	if (texture_handle)
 		dimensions = new_dimensions;
 	return texture_handle != TextureHandle{};
@@ -50,6 +57,9 @@ void CallbackTextureInterface::SaveLayerAsTexture() const
 		return;
 	}
 
+	// Make sure any batched geometry is rendered to the layer before saving it.
+	RenderManagerAccess::FlushGeometryBatch(&render_manager);
+
 	texture_handle = render_interface.SaveLayerAsTexture();
 	if (texture_handle)
 		dimensions = region.Size();
@@ -93,4 +103,15 @@ Texture CallbackTextureSource::GetTexture(RenderManager& render_manager) const
 	return Texture(texture);
 }
 
+bool CallbackTextureSource::UpdateTexture(Rectanglei region, Span<const byte> source) const
+{
+	bool result = true;
+	for (auto& pair : textures)
+	{
+		if (pair.second && !pair.second.UpdateTexture(region, source))
+			result = false;
+	}
+	return result;
+}
+
 } // namespace Rml
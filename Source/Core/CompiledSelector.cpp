@@ -0,0 +1,20 @@
+#include "../../Include/RmlUi/Core/CompiledSelector.h"
+#include "StyleSheetNode.h"
+#include "StyleSheetParser.h"
+
+namespace Rml {
+
+CompiledSelector::CompiledSelector() = default;
+
+CompiledSelector::CompiledSelector(const String& selectors) : source(selectors), root_node(MakeUnique<StyleSheetNode>())
+{
+	leaf_nodes = StyleSheetParser::ConstructNodes(*root_node, selectors);
+}
+
+CompiledSelector::~CompiledSelector() = default;
+
+CompiledSelector::CompiledSelector(CompiledSelector&& other) noexcept = default;
+
+CompiledSelector& CompiledSelector::operator=(CompiledSelector&& other) noexcept = default;
+
+} // namespace Rml
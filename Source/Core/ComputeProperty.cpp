@@ -7,7 +7,7 @@
 namespace Rml {
 
 struct ComputedPropertyData {
-	const Style::ComputedValues computed{nullptr};
+	const Style::ComputedValues computed;
 };
 static ControlledLifetimeResource<ComputedPropertyData> computed_property_data;
 
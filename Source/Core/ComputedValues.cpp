@@ -4,6 +4,26 @@
 
 namespace Rml {
 
+Style::ComputedValues::ComputedValues(Element* element) :
+	element(element), inherited(DefaultComputedValues().inherited), rare(DefaultComputedValues().rare)
+{}
+
+Style::ComputedValues::ComputedValues() : inherited(MakeShared<InheritedValues>()), rare(MakeShared<RareValues>()) {}
+
+Style::InheritedValues& Style::ComputedValues::MutableInherited()
+{
+	if (inherited.use_count() > 1)
+		inherited = MakeShared<InheritedValues>(*inherited);
+	return *inherited;
+}
+
+Style::RareValues& Style::ComputedValues::MutableRare()
+{
+	if (rare.use_count() > 1)
+		rare = MakeShared<RareValues>(*rare);
+	return *rare;
+}
+
 const AnimationList* Style::ComputedValues::animation() const
 {
 	if (auto p = element->GetLocalProperty(PropertyId::Animation))
@@ -42,7 +62,7 @@ String Style::ComputedValues::cursor() const
 
 float Style::ComputedValues::letter_spacing() const
 {
-	if (inherited.has_letter_spacing)
+	if (inherited->has_letter_spacing)
 	{
 		if (auto p = element->GetProperty(PropertyId::LetterSpacing))
 			return element->ResolveLength(p->GetNumericValue());
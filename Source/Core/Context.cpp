@@ -5,24 +5,59 @@
 #include "../../Include/RmlUi/Core/DataModelHandle.h"
 #include "../../Include/RmlUi/Core/Debug.h"
 #include "../../Include/RmlUi/Core/ElementDocument.h"
+#include "../../Include/RmlUi/Core/ElementText.h"
 #include "../../Include/RmlUi/Core/ElementUtilities.h"
 #include "../../Include/RmlUi/Core/Factory.h"
+#include "../../Include/RmlUi/Core/InputBatch.h"
+#include "../../Include/RmlUi/Core/MemoryStatistics.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/RenderManager.h"
 #include "../../Include/RmlUi/Core/StreamMemory.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
+#include "../../Include/RmlUi/Core/StyleSheetContainer.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "../../Include/RmlUi/Core/TaskInterface.h"
+#include "../../Include/RmlUi/Core/XMLParser.h"
 #include "DataModel.h"
+#include "ElementHitTestIndex.h"
+#include "ElementStyle.h"
 #include "EventDispatcher.h"
+#include "Layout/LayoutEngine.h"
+#include "LogCapture.h"
 #include "PluginRegistry.h"
+#include "RenderManagerAccess.h"
 #include "ScrollController.h"
+#include "StartupTimer.h"
 #include "StreamFile.h"
+#include "StyleSheetFactory.h"
 #include <algorithm>
+#include <atomic>
 #include <clocale>
 #include <iterator>
 #include <limits>
 
 namespace Rml {
 
+struct Context::ParsedDocument {
+	URL source_url;
+	String source;
+	// Configured on the main thread, then only used by the task until it is done.
+	BaseXMLParser tokenizer;
+	XMLParseEventList events;
+	CapturedLogMessageList log_messages;
+	// The style sheets of the document head. The inline sheets are parsed along with the document. The paths of the linked sheets are only
+	// known once the document is parsed, then the sheets not yet cached are read on the main thread and parsed on a second task.
+	Vector<StyleSheetFactory::StyleSheetFile> inline_style_sheets;
+	StringList linked_sheet_paths;
+	Vector<StyleSheetFactory::StyleSheetFile> linked_style_sheets;
+	TaskHandle task = {};
+	// False if the file could not be opened, in which case no task was submitted.
+	bool opened = false;
+	// True while the submitted task is yet to be waited for.
+	bool task_pending = false;
+	std::atomic<bool> done{false};
+};
+
 static constexpr float DOUBLE_CLICK_TIME = 0.5f;    // [s]
 static constexpr float DOUBLE_CLICK_MAX_DIST = 3.f; // [dp]
 static constexpr float UNIT_SCROLL_LENGTH = 80.f;   // [dp]
@@ -32,6 +67,30 @@ static constexpr float SCROLL_INERTIA_DELAY = 0.1f;
 static constexpr float TOUCH_MOVEMENT_DECAY_RATE = 5.0f;
 static constexpr float TOUCH_CLICK_MAX_DISTANCE = DOUBLE_CLICK_MAX_DIST; // [dp]
 
+// Borrows an object from the pool for the current scope, and returns it cleared with its memory retained. Nested events borrow their own objects.
+template <typename T>
+class PooledObject {
+public:
+	explicit PooledObject(Vector<T>& pool) : pool(pool)
+	{
+		if (!pool.empty())
+		{
+			object = std::move(pool.back());
+			pool.pop_back();
+		}
+	}
+	~PooledObject()
+	{
+		object.clear();
+		pool.push_back(std::move(object));
+	}
+	T& operator*() { return object; }
+
+private:
+	Vector<T>& pool;
+	T object;
+};
+
 static void DebugVerifyLocaleSetting()
 {
 #ifdef RMLUI_DEBUG
@@ -60,29 +119,14 @@ Context::Context(const String& name, RenderManager* render_manager, TextInputHan
 	name(name), render_manager(render_manager), text_input_handler(text_input_handler)
 {
 	instancer = nullptr;
+	previous_render_stats = render_manager->GetRenderStats();
+	RenderManagerAccess::AttachContext(render_manager);
 
 	root = Factory::InstanceElement(nullptr, "*", "#root", XMLAttributes());
 	root->SetId(name);
 	root->SetOffset(Vector2f(0, 0), nullptr);
 	root->SetProperty(PropertyId::ZIndex, Property(0, Unit::NUMBER));
 
-	cursor_proxy = Factory::InstanceElement(nullptr, documents_base_tag, documents_base_tag, XMLAttributes());
-	ElementDocument* cursor_proxy_document = rmlui_dynamic_cast<ElementDocument*>(cursor_proxy.get());
-	RMLUI_ASSERT(cursor_proxy_document);
-	cursor_proxy_document->context = this;
-
-	// The cursor proxy takes the style from its cloned element's document. The latter may define style rules for `<body>` which we don't want on the
-	// proxy. Thus, we override some properties here that we in particular don't want to inherit from the client document, especially those that
-	// result in decoration of the body element.
-	cursor_proxy_document->SetProperty(PropertyId::BackgroundColor, Property(Colourb(255, 255, 255, 0), Unit::COLOUR));
-	cursor_proxy_document->SetProperty(PropertyId::BorderTopWidth, Property(0, Unit::PX));
-	cursor_proxy_document->SetProperty(PropertyId::BorderRightWidth, Property(0, Unit::PX));
-	cursor_proxy_document->SetProperty(PropertyId::BorderBottomWidth, Property(0, Unit::PX));
-	cursor_proxy_document->SetProperty(PropertyId::BorderLeftWidth, Property(0, Unit::PX));
-	cursor_proxy_document->SetProperty(PropertyId::Decorator, Property());
-	cursor_proxy_document->SetProperty(PropertyId::OverflowX, Property(Style::Overflow::Visible));
-	cursor_proxy_document->SetProperty(PropertyId::OverflowY, Property(Style::Overflow::Visible));
-
 	document_focus_history.push_back(root.get());
 	focus = root.get();
 	hover = nullptr;
@@ -106,6 +150,21 @@ Context::~Context()
 {
 	PluginRegistry::NotifyContextDestroy(this);
 
+	progressive_documents.clear();
+
+	// Every submitted task must be waited for, even if its document is never loaded.
+	for (const QueuedDocument& queued_document : queued_documents)
+	{
+		if (queued_document.parsed_document && queued_document.parsed_document->task_pending)
+		{
+			TaskInterface* task_interface = GetTaskInterface();
+			RMLUI_ASSERTMSG(task_interface, "The task interface was removed while documents were still being parsed.");
+			if (task_interface)
+				task_interface->Wait(queued_document.parsed_document->task);
+		}
+	}
+	queued_documents.clear();
+
 	UnloadAllDocuments();
 
 	ReleaseUnloadedDocuments();
@@ -115,6 +174,8 @@ Context::~Context()
 	cursor_proxy.reset();
 
 	instancer = nullptr;
+
+	RenderManagerAccess::DetachContext(render_manager);
 }
 
 const String& Context::GetName() const
@@ -128,8 +189,10 @@ void Context::SetDimensions(const Vector2i _dimensions)
 	{
 		dimensions = _dimensions;
 		render_manager->SetViewport(dimensions);
+		DirtyEntireRegion();
 		root->SetBox(Box(Vector2f(dimensions)));
 		root->DirtyLayout();
+		hit_test_generation += 1;
 
 		for (int i = 0; i < root->GetNumChildren(); ++i)
 		{
@@ -138,7 +201,9 @@ void Context::SetDimensions(const Vector2i _dimensions)
 			{
 				document->DirtyMediaQueries();
 				document->DirtyVwAndVhProperties();
-				document->DirtyLayout();
+				// Documents of fixed size only need to be positioned again.
+				if (document->IsLayoutDependentOnViewport())
+					document->DirtyLayout();
 				document->DirtyPosition();
 				document->DispatchEvent(EventId::Resize, Dictionary());
 			}
@@ -177,9 +242,62 @@ float Context::GetDensityIndependentPixelRatio() const
 bool Context::Update()
 {
 	RMLUI_ZoneScoped;
+
+	UpdateBeforeLayout();
+
+	{
+		RMLUI_ZonePhase(ProfilerPhase::Layout);
+		ElementList layout_documents, layout_boundaries;
+		CollectDirtyLayouts(layout_documents, layout_boundaries);
+		FormatDirtyLayouts(layout_documents, layout_boundaries);
+	}
+
+	UpdateAfterLayout();
+
+	return true;
+}
+
+bool Context::UpdateContexts(Span<Context* const> contexts)
+{
+	RMLUI_ZoneScoped;
+
+	for (Context* context : contexts)
+		context->UpdateBeforeLayout();
+
+	{
+		// Documents of different contexts are just as independent as the documents within a context, so they are all formatted together.
+		RMLUI_ZonePhase(ProfilerPhase::Layout);
+		ElementList layout_documents, layout_boundaries;
+		for (Context* context : contexts)
+			context->CollectDirtyLayouts(layout_documents, layout_boundaries);
+		FormatDirtyLayouts(layout_documents, layout_boundaries);
+	}
+
+	for (Context* context : contexts)
+		context->UpdateAfterLayout();
+
+	return true;
+}
+
+bool Context::RenderContexts(Span<Context* const> contexts)
+{
+	RMLUI_ZoneScoped;
+
+	bool result = true;
+	for (Context* context : contexts)
+		result &= context->Render();
+	return result;
+}
+
+void Context::UpdateBeforeLayout()
+{
 	DebugVerifyLocaleSetting();
 
 	next_update_timeout = std::numeric_limits<double>::infinity();
+	if (update_budget > 0)
+		update_deadline = GetSystemInterface()->GetElapsedTime() + update_budget;
+
+	ProcessQueuedInput();
 
 	if (scroll_controller->Update(mouse_position, density_independent_pixel_ratio))
 		RequestNextUpdate(0);
@@ -188,9 +306,40 @@ bool Context::Update()
 	if (mouse_active)
 		UpdateHoverChain(mouse_position);
 
-	// Update all the data models before updating properties and layout.
-	for (auto& data_model : data_models)
-		data_model.second->Update(true);
+	if (!queued_documents.empty() || !progressive_documents.empty())
+		LoadQueuedDocuments();
+
+	// Update all the data models before updating properties and layout. Low-priority models are updated last, and only within the budget.
+	{
+		RMLUI_ZonePhase(ProfilerPhase::DataModels);
+		for (auto& data_model : data_models)
+		{
+			if (!data_model.second->IsLowPriority())
+				data_model.second->Update(true);
+		}
+
+		for (auto& data_model : data_models)
+		{
+			if (!data_model.second->IsLowPriority())
+				continue;
+			// Deferred models keep their dirty variables until the next update.
+			if (IsUpdateBudgetExceeded())
+				RequestNextUpdate(0);
+			else
+				data_model.second->Update(true);
+		}
+	}
+
+	// Recompile the style sheets once for all theme changes since the last update.
+	if (themes_dirty)
+	{
+		themes_dirty = false;
+		for (int i = 0; i < root->GetNumChildren(true); ++i)
+		{
+			if (ElementDocument* document = root->GetChild(i)->GetOwnerDocument())
+				document->DirtyMediaQueries();
+		}
+	}
 
 	// The style definition of each document should be independent of each other. By manually resetting these flags we avoid unnecessary definition
 	// lookups in unrelated documents, such as when adding a new document. Adding an element dirties the parent definition, which in this case is the
@@ -198,42 +347,151 @@ bool Context::Update()
 	root->dirty_definition = false;
 	root->dirty_child_definitions = false;
 
-	root->Update(density_independent_pixel_ratio, Vector2f(dimensions));
+	AdvanceAnimations();
+
+	{
+		RMLUI_ZonePhase(ProfilerPhase::Style);
+		ElementStyle::PrefetchDefinitions(root.get());
+		root->Update(density_independent_pixel_ratio, Vector2f(dimensions));
+		ElementStyle::ReleasePrefetchedDefinitions();
+	}
+
+	PruneAnimatedElements();
+
+	update_deadline = -1;
+}
+
+void Context::AdvanceAnimations()
+{
+	// Animation events may start animations on other elements, which are then appended to the list. Thus, iterate by index.
+	for (size_t i = 0; i < animated_elements.size(); i++)
+	{
+		Element* element = animated_elements[i].get();
+		// Elements skipped by style updates are advanced once they are updated again.
+		if (element && !element->skipped_style && element->GetContext() == this)
+			element->AdvanceAnimations();
+	}
+}
+
+void Context::PruneAnimatedElements()
+{
+	bool any_visible = false;
+	auto it_remove = std::remove_if(animated_elements.begin(), animated_elements.end(), [&](const ObserverPtr<Element>& observer) {
+		Element* element = observer.get();
+		if (!element || element->GetContext() != this)
+			return true;
+		if (element->animations.empty())
+		{
+			element->animations_registered = false;
+			return true;
+		}
+		any_visible |= element->IsVisible(true);
+		return false;
+	});
+	animated_elements.erase(it_remove, animated_elements.end());
 
+	if (any_visible)
+		RequestNextUpdate(0);
+}
+
+void Context::CollectDirtyLayouts(ElementList& layout_documents, ElementList& layout_boundaries)
+{
+	// Documents are independent of each other, thus all documents needing a full layout, and all dirty layout boundaries within the other
+	// documents, are formatted together. This lets the layout engine calculate them concurrently when enabled.
 	for (int i = 0; i < root->GetNumChildren(); ++i)
 	{
 		if (auto doc = root->GetChild(i)->GetOwnerDocument())
 		{
-			doc->UpdateLayout();
-			doc->UpdatePosition();
+			// Hidden documents keep their dirty layout until shown, see ElementDocument::Show().
+			if (defer_hidden_layout && !doc->IsVisible())
+				continue;
+
+			RMLUI_ZoneElement(doc, ProfilerPhase::Layout);
+			if (!doc->layout_dirty)
+				doc->layout_dirty = !LayoutEngine::FindDirtyLayoutBoundaries(doc, layout_boundaries);
+			if (doc->layout_dirty)
+				layout_documents.push_back(doc);
+		}
+	}
+}
+
+void Context::FormatDirtyLayouts(const ElementList& layout_documents, const ElementList& layout_boundaries)
+{
+	RMLUI_ZoneScopedN("UpdateLayout");
+	Vector<LayoutEngine::FormatTarget> format_targets;
+	format_targets.reserve(layout_documents.size());
+	for (Element* document : layout_documents)
+		format_targets.push_back({document, static_cast<ElementDocument*>(document)->GetLayoutContainingBlock()});
+
+	LayoutEngine::FormatElements(format_targets, layout_boundaries);
+
+	for (Element* document : layout_documents)
+	{
+		// Ignore dirtied layout during document formatting, see ElementDocument::UpdateLayout().
+		static_cast<ElementDocument*>(document)->layout_dirty = false;
+	}
+}
+
+void Context::UpdateAfterLayout()
+{
+	{
+		RMLUI_ZonePhase(ProfilerPhase::Layout);
+		for (int i = 0; i < root->GetNumChildren(); ++i)
+		{
+			if (auto doc = root->GetChild(i)->GetOwnerDocument())
+				doc->UpdatePosition();
 		}
 	}
 
+	{
+		// Generate the geometry of visible elements ahead of rendering, so that the render call mostly submits already generated geometry.
+		RMLUI_ZonePhase(ProfilerPhase::Render);
+		RMLUI_ZoneScopedN("PrepareRender");
+		root->PrepareRender(this);
+	}
+
 	// Release any documents that were unloaded during the update.
 	ReleaseUnloadedDocuments();
 
-	return true;
+	UpdateRedrawRegion();
 }
 
 bool Context::Render()
 {
 	RMLUI_ZoneScoped;
+	RMLUI_ZonePhase(ProfilerPhase::Render);
 
 	render_manager->PrepareRender(dimensions);
 
-	root->Render();
+	const Rectanglei region = GetDirtyRegion();
+	if (partial_redraw)
+		render_manager->SetRenderRegion(region);
 
-	// Render the cursor proxy so that any attached drag clone will be rendered below the cursor.
-	if (drag_clone)
+	if (!partial_redraw || HasVisualChanges())
 	{
-		static_cast<ElementDocument&>(*cursor_proxy).UpdateDocument();
-		cursor_proxy->SetOffset(
-			Vector2f((float)Math::Clamp(mouse_position.x, 0, dimensions.x), (float)Math::Clamp(mouse_position.y, 0, dimensions.y)), nullptr);
-		cursor_proxy->Render();
+		root->Render();
+
+		// Render the cursor proxy so that any attached drag clone will be rendered below the cursor.
+		if (drag_clone)
+		{
+			static_cast<ElementDocument&>(*cursor_proxy).UpdateDocument();
+			cursor_proxy->SetOffset(
+				Vector2f((float)Math::Clamp(mouse_position.x, 0, dimensions.x), (float)Math::Clamp(mouse_position.y, 0, dimensions.y)), nullptr);
+			cursor_proxy->Render();
+
+			// The drag clone is not part of the documents, redraw everything once it moves or is released.
+			DirtyEntireRegion();
+		}
 	}
 
+	if (partial_redraw)
+		render_manager->SetRenderRegion(Rectanglei::MakeInvalid());
 	render_manager->ResetState();
 
+	redraw_region = Rectanglei::MakeInvalid();
+
+	EndFrameStatistics();
+
 	return true;
 }
 
@@ -277,6 +535,8 @@ ElementDocument* Context::LoadDocument(const String& document_path)
 
 ElementDocument* Context::LoadDocument(Stream* stream)
 {
+	const double start_time = StartupTimer::Now();
+
 	DebugVerifyLocaleSetting();
 	PluginRegistry::NotifyDocumentOpen(this, stream->GetSourceURL().GetURL());
 
@@ -288,6 +548,15 @@ ElementDocument* Context::LoadDocument(Stream* stream)
 
 	root->AppendChild(std::move(element));
 
+	FinishDocumentLoad(document);
+
+	StartupTimer::AddDocumentLoad(StartupTimer::Now() - start_time);
+
+	return document;
+}
+
+void Context::FinishDocumentLoad(ElementDocument* document)
+{
 	// The 'load' event is fired before updating the document, because the user might
 	// need to initalize things before running an update. The drawback is that computed
 	// values and layouting are not performed yet, resulting in default values when
@@ -302,8 +571,6 @@ ElementDocument* Context::LoadDocument(Stream* stream)
 		data_model.second->Update(false);
 
 	document->UpdateDocument();
-
-	return document;
 }
 
 ElementDocument* Context::LoadDocumentFromMemory(const String& string, const String& source_url)
@@ -319,6 +586,107 @@ ElementDocument* Context::LoadDocumentFromMemory(const String& string, const Str
 	return document;
 }
 
+void Context::LoadDocumentAsync(const String& document_path, Function<void(ElementDocument*)> on_loaded)
+{
+	queued_documents.push_back(QueuedDocument{document_path, std::move(on_loaded), false, nullptr});
+	ParseQueuedDocument(queued_documents.back());
+	RequestNextUpdate(0);
+}
+
+ElementDocument* Context::LoadDocumentProgressive(const String& document_path, Function<void(ElementDocument*)> on_loaded)
+{
+	auto stream = MakeUnique<StreamFile>();
+	if (!stream->Open(document_path))
+		return nullptr;
+
+	DebugVerifyLocaleSetting();
+	PluginRegistry::NotifyDocumentOpen(this, stream->GetSourceURL().GetURL());
+
+	ElementPtr element = Factory::InstanceElement(nullptr, documents_base_tag, documents_base_tag, XMLAttributes());
+	ElementDocument* document = rmlui_dynamic_cast<ElementDocument*>(element.get());
+	if (!document)
+	{
+		Log::Message(Log::LT_ERROR, "Failed to instance document element for '%s', was expecting derivative of ElementDocument.",
+			document_path.c_str());
+		return nullptr;
+	}
+
+	document->context = this;
+	root->AppendChild(std::move(element));
+
+	auto parser = MakeUnique<XMLParser>(document);
+	parser->ParseBegin(stream.get());
+	progressive_documents.push_back(ProgressiveDocument{std::move(stream), std::move(parser), document->GetObserverPtr(), std::move(on_loaded)});
+	RequestNextUpdate(0);
+
+	return document;
+}
+
+bool Context::PreloadDocument(const String& document_path)
+{
+	RMLUI_ZoneScoped;
+
+	// Loading the document caches its templates, style sheets, and font faces. Textures are only loaded once they are first used, so load
+	// the ones which were first referenced by this document.
+	const size_t first_texture_index = RenderManagerAccess::GetNumFileTextures(render_manager);
+
+	ElementDocument* document = LoadDocument(document_path);
+	if (!document)
+		return false;
+
+	RenderManagerAccess::PreloadFileTextures(render_manager, first_texture_index);
+	document->Close();
+
+	return true;
+}
+
+void Context::PreloadDocumentAsync(const String& document_path)
+{
+	queued_documents.push_back(QueuedDocument{document_path, nullptr, true, nullptr});
+	ParseQueuedDocument(queued_documents.back());
+	RequestNextUpdate(0);
+}
+
+void Context::SetDocumentLoadBudget(double budget_seconds)
+{
+	document_load_budget = Math::Max(budget_seconds, 0.0);
+}
+
+void Context::SetDeferHiddenStyles(bool defer)
+{
+	defer_hidden_styles = defer;
+}
+
+bool Context::GetDeferHiddenStyles() const
+{
+	return defer_hidden_styles;
+}
+
+void Context::SetDeferHiddenLayout(bool defer)
+{
+	defer_hidden_layout = defer;
+}
+
+bool Context::GetDeferHiddenLayout() const
+{
+	return defer_hidden_layout;
+}
+
+void Context::SetUpdateBudget(double budget_seconds)
+{
+	update_budget = Math::Max(budget_seconds, 0.0);
+}
+
+bool Context::IsUpdateBudgetExceeded() const
+{
+	return update_deadline >= 0 && GetSystemInterface()->GetElapsedTime() >= update_deadline;
+}
+
+int Context::GetNumQueuedDocuments() const
+{
+	return (int)queued_documents.size();
+}
+
 void Context::UnloadDocument(ElementDocument* _document)
 {
 	// Has this document already been unloaded?
@@ -403,13 +771,7 @@ void Context::ActivateTheme(const String& theme_name, bool activate)
 		theme_changed = (active_themes.erase(theme_name) > 0);
 
 	if (theme_changed)
-	{
-		for (int i = 0; i < root->GetNumChildren(true); ++i)
-		{
-			if (ElementDocument* document = root->GetChild(i)->GetOwnerDocument())
-				document->DirtyMediaQueries();
-		}
-	}
+		themes_dirty = true;
 }
 
 bool Context::IsThemeActive(const String& theme_name) const
@@ -522,8 +884,14 @@ void Context::RemoveEventListener(const String& event, EventListener* listener,
 
 bool Context::ProcessKeyDown(Input::KeyIdentifier key_identifier, int key_modifier_state)
 {
+	if (!input_enabled)
+		return true;
+
+	ProcessQueuedInput();
+
 	// Generate the parameters for the key event.
-	Dictionary parameters;
+	PooledObject<Dictionary> pooled_parameters(event_parameters_pool);
+	Dictionary& parameters = *pooled_parameters;
 	GenerateKeyEventParameters(parameters, key_identifier);
 	GenerateKeyModifierEventParameters(parameters, key_modifier_state);
 
@@ -535,8 +903,14 @@ bool Context::ProcessKeyDown(Input::KeyIdentifier key_identifier, int key_modifi
 
 bool Context::ProcessKeyUp(Input::KeyIdentifier key_identifier, int key_modifier_state)
 {
+	if (!input_enabled)
+		return true;
+
+	ProcessQueuedInput();
+
 	// Generate the parameters for the key event.
-	Dictionary parameters;
+	PooledObject<Dictionary> pooled_parameters(event_parameters_pool);
+	Dictionary& parameters = *pooled_parameters;
 	GenerateKeyEventParameters(parameters, key_identifier);
 	GenerateKeyModifierEventParameters(parameters, key_modifier_state);
 
@@ -563,9 +937,15 @@ bool Context::ProcessTextInput(Character character)
 
 bool Context::ProcessTextInput(const String& string)
 {
+	if (!input_enabled)
+		return true;
+
+	ProcessQueuedInput();
+
 	Element* target = (focus ? focus : root.get());
 
-	Dictionary parameters;
+	PooledObject<Dictionary> pooled_parameters(event_parameters_pool);
+	Dictionary& parameters = *pooled_parameters;
 	parameters["text"] = string;
 
 	bool consumed = target->DispatchEvent(EventId::Textinput, parameters);
@@ -575,6 +955,15 @@ bool Context::ProcessTextInput(const String& string)
 
 bool Context::ProcessMouseMove(int x, int y, int key_modifier_state)
 {
+	if (!input_enabled)
+		return true;
+
+	if (input_coalescing)
+	{
+		QueueInput(QueuedInput{QueuedInput::Type::MouseMove, key_modifier_state, Vector2i(x, y), Vector2f(), TouchList()});
+		return !IsMouseInteracting();
+	}
+
 	// Check whether the mouse moved since the last event came through.
 	Vector2i old_mouse_position = mouse_position;
 	mouse_position = {x, y};
@@ -582,7 +971,9 @@ bool Context::ProcessMouseMove(int x, int y, int key_modifier_state)
 	mouse_active = true;
 
 	// Update the current hover chain. This will send all necessary 'onmouseout', 'onmouseover', 'ondragout' and 'ondragover' messages.
-	Dictionary parameters, drag_parameters;
+	PooledObject<Dictionary> pooled_parameters(event_parameters_pool), pooled_drag_parameters(event_parameters_pool);
+	Dictionary& parameters = *pooled_parameters;
+	Dictionary& drag_parameters = *pooled_drag_parameters;
 	UpdateHoverChain(old_mouse_position, key_modifier_state, &parameters, &drag_parameters);
 
 	// Dispatch any 'onmousemove' events.
@@ -616,7 +1007,13 @@ static Element* FindFocusElement(Element* element)
 
 bool Context::ProcessMouseButtonDown(int button_index, int key_modifier_state)
 {
-	Dictionary parameters;
+	if (!input_enabled)
+		return true;
+
+	ProcessQueuedInput();
+
+	PooledObject<Dictionary> pooled_parameters(event_parameters_pool);
+	Dictionary& parameters = *pooled_parameters;
 	GenerateMouseEventParameters(parameters, button_index);
 	GenerateKeyModifierEventParameters(parameters, key_modifier_state);
 
@@ -705,7 +1102,8 @@ bool Context::ProcessMouseButtonDown(int button_index, int key_modifier_state)
 	}
 	else if (button_index == 2 && hover && propagate)
 	{
-		Dictionary scroll_parameters;
+		PooledObject<Dictionary> pooled_scroll_parameters(event_parameters_pool);
+		Dictionary& scroll_parameters = *pooled_scroll_parameters;
 		GenerateMouseEventParameters(scroll_parameters);
 		GenerateKeyModifierEventParameters(scroll_parameters, key_modifier_state);
 		scroll_parameters["autoscroll"] = true;
@@ -720,7 +1118,13 @@ bool Context::ProcessMouseButtonDown(int button_index, int key_modifier_state)
 
 bool Context::ProcessMouseButtonUp(int button_index, int key_modifier_state)
 {
-	Dictionary parameters;
+	if (!input_enabled)
+		return true;
+
+	ProcessQueuedInput();
+
+	PooledObject<Dictionary> pooled_parameters(event_parameters_pool);
+	Dictionary& parameters = *pooled_parameters;
 	GenerateMouseEventParameters(parameters, button_index);
 	GenerateKeyModifierEventParameters(parameters, key_modifier_state);
 
@@ -748,7 +1152,8 @@ bool Context::ProcessMouseButtonUp(int button_index, int key_modifier_state)
 		{
 			if (drag_started)
 			{
-				Dictionary drag_parameters;
+				PooledObject<Dictionary> pooled_drag_parameters(event_parameters_pool);
+				Dictionary& drag_parameters = *pooled_drag_parameters;
 				GenerateMouseEventParameters(drag_parameters);
 				GenerateDragEventParameters(drag_parameters);
 				GenerateKeyModifierEventParameters(drag_parameters, key_modifier_state);
@@ -799,6 +1204,15 @@ bool Context::ProcessMouseWheel(float wheel_delta, int key_modifier_state)
 
 bool Context::ProcessMouseWheel(Vector2f wheel_delta, int key_modifier_state)
 {
+	if (!input_enabled)
+		return true;
+
+	if (input_coalescing)
+	{
+		QueueInput(QueuedInput{QueuedInput::Type::MouseWheel, key_modifier_state, Vector2i(), wheel_delta, TouchList()});
+		return !IsMouseInteracting();
+	}
+
 	if (scroll_controller->GetMode() == ScrollController::Mode::Autoscroll)
 	{
 		scroll_controller->Reset();
@@ -810,7 +1224,8 @@ bool Context::ProcessMouseWheel(Vector2f wheel_delta, int key_modifier_state)
 		return true;
 	}
 
-	Dictionary scroll_parameters;
+	PooledObject<Dictionary> pooled_scroll_parameters(event_parameters_pool);
+	Dictionary& scroll_parameters = *pooled_scroll_parameters;
 	GenerateMouseEventParameters(scroll_parameters);
 	GenerateKeyModifierEventParameters(scroll_parameters, key_modifier_state);
 	scroll_parameters["wheel_delta_x"] = wheel_delta.x;
@@ -834,6 +1249,8 @@ bool Context::ProcessMouseWheel(Vector2f wheel_delta, int key_modifier_state)
 
 bool Context::ProcessMouseLeave()
 {
+	ProcessQueuedInput();
+
 	mouse_active = false;
 
 	// Update the hover chain. Now that 'mouse_active' is disabled this will remove the hover state from all elements.
@@ -842,56 +1259,215 @@ bool Context::ProcessMouseLeave()
 	return !IsMouseInteracting();
 }
 
-bool Context::IsMouseInteracting() const
+void Context::SetInputCoalescing(bool enable)
 {
-	return (hover && hover != root.get()) || (active && active != root.get()) || scroll_controller->GetMode() == ScrollController::Mode::Autoscroll;
+	if (!enable)
+		ProcessQueuedInput();
+	input_coalescing = enable;
 }
 
-Context::TouchState* Context::LookupTouch(TouchId identifier)
+bool Context::IsInputCoalescing() const
 {
-	auto touch_it = touch_states.find(identifier);
-	return touch_it != touch_states.end() ? &touch_it->second : nullptr;
+	return input_coalescing;
 }
 
-bool Context::ProcessTouchStart(const TouchList& touches, int key_modifier_state)
+void Context::SetInputEnabled(bool enable)
 {
-	bool result = true;
-	for (const auto& touch : touches)
-		result &= ProcessTouchStart(touch, key_modifier_state);
-	return result;
-}
+	if (input_enabled == enable)
+		return;
 
-bool Context::ProcessTouchMove(const TouchList& touches, int key_modifier_state)
-{
-	bool result = true;
-	for (const auto& touch : touches)
-		result &= ProcessTouchMove(touch, key_modifier_state);
-	return result;
-}
+	if (!enable)
+	{
+		// Release any ongoing interaction, so that no element is left in hover or active state.
+		ProcessQueuedInput();
+		touch_states.clear();
+		if (active)
+			ProcessMouseButtonUp(0, 0);
+		ProcessMouseLeave();
+		if (scroll_controller->GetMode() == ScrollController::Mode::Autoscroll)
+			scroll_controller->Reset();
+	}
 
-bool Context::ProcessTouchEnd(const TouchList& touches, int key_modifier_state)
-{
-	bool result = true;
-	for (const auto& touch : touches)
-		result &= ProcessTouchEnd(touch, key_modifier_state);
-	return result;
+	input_enabled = enable;
 }
 
-bool Context::ProcessTouchCancel(const TouchList& touches)
+bool Context::IsInputEnabled() const
 {
-	bool result = true;
-	for (const auto& touch : touches)
-		result &= ProcessTouchCancel(touch);
-	return result;
+	return input_enabled;
 }
 
-bool Context::ProcessTouchStart(const Touch& touch, int key_modifier_state)
+void Context::QueueInput(QueuedInput&& input)
 {
-	TouchState* state = LookupTouch(touch.identifier);
-	RMLUI_ASSERTMSG(state == nullptr, "Receiving touch start event for an already started touch.");
-	if (!state)
+	QueuedInput* last = (queued_input.empty() ? nullptr : &queued_input.back());
+	if (!last || last->type != input.type || last->key_modifier_state != input.key_modifier_state)
 	{
-		auto it_inserted = touch_states.emplace(touch.identifier, TouchState()).first;
+		queued_input.push_back(std::move(input));
+		return;
+	}
+
+	switch (input.type)
+	{
+	case QueuedInput::Type::MouseMove: last->mouse_position = input.mouse_position; break;
+	case QueuedInput::Type::MouseWheel: last->wheel_delta += input.wheel_delta; break;
+	case QueuedInput::Type::TouchMove:
+		// Keep the latest position of each touch point.
+		for (const Touch& touch : input.touches)
+		{
+			auto it = std::find_if(last->touches.begin(), last->touches.end(), [&](const Touch& queued) { return queued.identifier == touch.identifier; });
+			if (it != last->touches.end())
+				it->position = touch.position;
+			else
+				last->touches.push_back(touch);
+		}
+		break;
+	}
+}
+
+void Context::ProcessQueuedInput()
+{
+	if (queued_input.empty())
+		return;
+
+	RMLUI_ZoneScoped;
+
+	// Process the input directly while flushing, including any input submitted by event handlers.
+	Vector<QueuedInput> input_list = std::move(queued_input);
+	queued_input.clear();
+	const bool coalescing = input_coalescing;
+	input_coalescing = false;
+
+	for (const QueuedInput& input : input_list)
+	{
+		switch (input.type)
+		{
+		case QueuedInput::Type::MouseMove: ProcessMouseMove(input.mouse_position.x, input.mouse_position.y, input.key_modifier_state); break;
+		case QueuedInput::Type::MouseWheel: ProcessMouseWheel(input.wheel_delta, input.key_modifier_state); break;
+		case QueuedInput::Type::TouchMove: ProcessTouchMove(input.touches, input.key_modifier_state); break;
+		}
+	}
+
+	input_coalescing = coalescing;
+}
+
+bool Context::IsMouseInteracting() const
+{
+	return (hover && hover != root.get()) || (active && active != root.get()) || scroll_controller->GetMode() == ScrollController::Mode::Autoscroll;
+}
+
+Context::TouchState* Context::LookupTouch(TouchId identifier)
+{
+	auto touch_it = touch_states.find(identifier);
+	return touch_it != touch_states.end() ? &touch_it->second : nullptr;
+}
+
+bool Context::ProcessTouchStart(const TouchList& touches, int key_modifier_state)
+{
+	if (!input_enabled)
+		return true;
+
+	ProcessQueuedInput();
+
+	bool result = true;
+	for (const auto& touch : touches)
+		result &= ProcessTouchStart(touch, key_modifier_state);
+	return result;
+}
+
+bool Context::ProcessTouchMove(const TouchList& touches, int key_modifier_state)
+{
+	if (!input_enabled)
+		return true;
+
+	if (input_coalescing)
+	{
+		QueueInput(QueuedInput{QueuedInput::Type::TouchMove, key_modifier_state, Vector2i(), Vector2f(), touches});
+		return !IsMouseInteracting();
+	}
+
+	bool result = true;
+	for (const auto& touch : touches)
+		result &= ProcessTouchMove(touch, key_modifier_state);
+	return result;
+}
+
+bool Context::ProcessTouchEnd(const TouchList& touches, int key_modifier_state)
+{
+	if (!input_enabled)
+		return true;
+
+	ProcessQueuedInput();
+
+	bool result = true;
+	for (const auto& touch : touches)
+		result &= ProcessTouchEnd(touch, key_modifier_state);
+	return result;
+}
+
+bool Context::ProcessTouchCancel(const TouchList& touches)
+{
+	if (!input_enabled)
+		return true;
+
+	ProcessQueuedInput();
+
+	bool result = true;
+	for (const auto& touch : touches)
+		result &= ProcessTouchCancel(touch);
+	return result;
+}
+
+bool Context::ProcessInputBatch(const InputBatch& batch)
+{
+	if (!input_enabled)
+		return true;
+
+	RMLUI_ZoneScoped;
+
+	// The touches of each event are copied into the same list, so that it is only allocated once per batch.
+	TouchList touch_list;
+	bool result = true;
+	for (const InputBatch::Event& event : batch.GetEvents())
+	{
+		const int key_modifier_state = event.key_modifier_state;
+		switch (event.type)
+		{
+		case InputBatch::Type::KeyDown: result &= ProcessKeyDown(Input::KeyIdentifier(event.index), key_modifier_state); break;
+		case InputBatch::Type::KeyUp: result &= ProcessKeyUp(Input::KeyIdentifier(event.index), key_modifier_state); break;
+		case InputBatch::Type::TextInput: result &= ProcessTextInput(String(batch.GetText(event))); break;
+		case InputBatch::Type::MouseMove: result &= ProcessMouseMove(int(event.value.x), int(event.value.y), key_modifier_state); break;
+		case InputBatch::Type::MouseButtonDown: result &= ProcessMouseButtonDown(event.index, key_modifier_state); break;
+		case InputBatch::Type::MouseButtonUp: result &= ProcessMouseButtonUp(event.index, key_modifier_state); break;
+		case InputBatch::Type::MouseWheel: result &= ProcessMouseWheel(event.value, key_modifier_state); break;
+		case InputBatch::Type::MouseLeave: result &= ProcessMouseLeave(); break;
+		case InputBatch::Type::TouchStart:
+		case InputBatch::Type::TouchMove:
+		case InputBatch::Type::TouchEnd:
+		case InputBatch::Type::TouchCancel:
+		{
+			const Span<const Touch> touches = batch.GetTouches(event);
+			touch_list.assign(touches.begin(), touches.end());
+			if (event.type == InputBatch::Type::TouchStart)
+				result &= ProcessTouchStart(touch_list, key_modifier_state);
+			else if (event.type == InputBatch::Type::TouchMove)
+				result &= ProcessTouchMove(touch_list, key_modifier_state);
+			else if (event.type == InputBatch::Type::TouchEnd)
+				result &= ProcessTouchEnd(touch_list, key_modifier_state);
+			else
+				result &= ProcessTouchCancel(touch_list);
+		}
+		break;
+		}
+	}
+	return result;
+}
+
+bool Context::ProcessTouchStart(const Touch& touch, int key_modifier_state)
+{
+	TouchState* state = LookupTouch(touch.identifier);
+	RMLUI_ASSERTMSG(state == nullptr, "Receiving touch start event for an already started touch.");
+	if (!state)
+	{
+		auto it_inserted = touch_states.emplace(touch.identifier, TouchState()).first;
 		state = &it_inserted->second;
 	}
 
@@ -1034,11 +1610,102 @@ void Context::SetDefaultScrollBehavior(ScrollBehavior scroll_behavior, float spe
 	scroll_controller->SetDefaultScrollBehavior(scroll_behavior, speed_factor);
 }
 
+Rectanglei Context::GetDirtyRegion() const
+{
+	return redraw_region.Valid() ? redraw_region : Rectanglei::FromSize(Vector2i(0));
+}
+
+bool Context::HasVisualChanges() const
+{
+	return redraw_region.Valid() && redraw_region.Width() > 0 && redraw_region.Height() > 0;
+}
+
+void Context::SetPartialRedraw(bool enable)
+{
+	partial_redraw = enable;
+}
+
+bool Context::IsPartialRedraw() const
+{
+	return partial_redraw;
+}
+
 RenderManager& Context::GetRenderManager()
 {
 	return *render_manager;
 }
 
+const FrameStatistics& Context::GetFrameStatistics() const
+{
+	return frame_statistics;
+}
+
+void Context::SetElementInvalidationTracking(bool enable)
+{
+	element_invalidation_tracking = enable;
+	if (!enable)
+		element_invalidations.clear();
+}
+
+bool Context::IsElementInvalidationTracking() const
+{
+	return element_invalidation_tracking;
+}
+
+void Context::SetDataModelProfiling(bool enable)
+{
+	data_model_profiling = enable;
+	for (auto& data_model : data_models)
+		data_model.second->SetProfiling(enable);
+}
+
+bool Context::IsDataModelProfiling() const
+{
+	return data_model_profiling;
+}
+
+static void GetElementMemoryStats(Element* element, ContextMemoryStats& stats)
+{
+	stats.num_elements += 1;
+
+	for (const auto& attribute : element->GetAttributes())
+	{
+		stats.element_content_bytes += sizeof(attribute) + attribute.first.capacity();
+		if (attribute.second.GetType() == Variant::STRING)
+			stats.element_content_bytes += attribute.second.GetReference<String>().capacity();
+	}
+
+	stats.element_content_bytes += element->GetLocalStyleProperties().size() * sizeof(PropertyMap::value_type);
+
+	if (ElementText* text_element = rmlui_dynamic_cast<ElementText*>(element))
+		stats.element_content_bytes += text_element->GetText().capacity();
+
+	const int num_children = element->GetNumChildren(true);
+	stats.element_content_bytes += size_t(num_children) * sizeof(ElementPtr);
+	for (int i = 0; i < num_children; i++)
+		GetElementMemoryStats(element->GetChild(i), stats);
+}
+
+ContextMemoryStats Context::GetMemoryStats() const
+{
+	ContextMemoryStats stats;
+	stats.name = name;
+	stats.num_documents = GetNumDocuments();
+
+	GetElementMemoryStats(root.get(), stats);
+	if (cursor_proxy)
+		GetElementMemoryStats(cursor_proxy.get(), stats);
+
+	stats.num_data_models = (int)data_models.size();
+	for (const auto& data_model : data_models)
+	{
+		stats.num_data_variables += (int)data_model.second->GetAllVariables().size();
+		stats.num_data_views += data_model.second->GetNumViews();
+	}
+
+	return stats;
+}
+
 TextInputHandler* Context::GetTextInputHandler() const
 {
 	return text_input_handler;
@@ -1062,7 +1729,10 @@ DataModelConstructor Context::CreateDataModel(const String& name, DataTypeRegist
 	auto result = data_models.emplace(name, MakeUnique<DataModel>(data_type_register));
 	bool inserted = result.second;
 	if (inserted)
+	{
+		result.first->second->SetProfiling(data_model_profiling);
 		return DataModelConstructor(result.first->second.get());
+	}
 
 	Log::Message(Log::LT_ERROR, "Data model name '%s' already exists.", name.c_str());
 	return DataModelConstructor();
@@ -1105,10 +1775,20 @@ bool Context::RemoveDataModel(const String& name)
 
 void Context::OnElementDetach(Element* element)
 {
-	auto it_hover = hover_chain.find(element);
+	if (element->animations_registered)
+	{
+		// Reset rather than erase the entry, as we may be called while the animations are advanced. Empty entries are pruned later.
+		auto it_animated = std::find(animated_elements.begin(), animated_elements.end(), element);
+		if (it_animated != animated_elements.end())
+			it_animated->reset();
+		element->animations_registered = false;
+	}
+
+	auto it_hover = std::find(hover_chain.begin(), hover_chain.end(), element);
 	if (it_hover != hover_chain.end())
 	{
-		Dictionary parameters;
+		PooledObject<Dictionary> pooled_parameters(event_parameters_pool);
+		Dictionary& parameters = *pooled_parameters;
 		GenerateMouseEventParameters(parameters, -1);
 		element->DispatchEvent(EventId::Mouseout, parameters);
 
@@ -1129,7 +1809,7 @@ void Context::OnElementDetach(Element* element)
 
 	if (drag)
 	{
-		auto it = drag_hover_chain.find(element);
+		auto it = std::find(drag_hover_chain.begin(), drag_hover_chain.end(), element);
 		if (it != drag_hover_chain.end())
 		{
 			drag_hover_chain.erase(it);
@@ -1181,8 +1861,10 @@ bool Context::OnFocusChange(Element* new_focus, bool focus_visible)
 {
 	RMLUI_ASSERT(new_focus);
 
-	ElementSet old_chain;
-	ElementSet new_chain;
+	PooledObject<ElementSet> pooled_old_chain(element_set_pool);
+	ElementSet& old_chain = *pooled_old_chain;
+	PooledObject<ElementSet> pooled_new_chain(element_set_pool);
+	ElementSet& new_chain = *pooled_new_chain;
 
 	Element* old_focus = focus;
 	ElementDocument* old_document = old_focus ? old_focus->GetOwnerDocument() : nullptr;
@@ -1216,7 +1898,8 @@ bool Context::OnFocusChange(Element* new_focus, bool focus_visible)
 	}
 
 	// Send out blur/focus events.
-	Dictionary parameters;
+	PooledObject<Dictionary> pooled_parameters(event_parameters_pool);
+	Dictionary& parameters = *pooled_parameters;
 	SendEvents(old_chain, new_chain, EventId::Blur, parameters);
 
 	if (focus_visible)
@@ -1252,7 +1935,8 @@ bool Context::OnFocusChange(Element* new_focus, bool focus_visible)
 
 void Context::GenerateClickEvent(Element* element)
 {
-	Dictionary parameters;
+	PooledObject<Dictionary> pooled_parameters(event_parameters_pool);
+	Dictionary& parameters = *pooled_parameters;
 	GenerateMouseEventParameters(parameters, 0);
 
 	element->DispatchEvent(EventId::Click, parameters);
@@ -1262,9 +1946,9 @@ void Context::UpdateHoverChain(Vector2i old_mouse_position, int key_modifier_sta
 {
 	const Vector2f position(mouse_position);
 
-	Dictionary local_parameters, local_drag_parameters;
-	Dictionary& parameters = out_parameters ? *out_parameters : local_parameters;
-	Dictionary& drag_parameters = out_drag_parameters ? *out_drag_parameters : local_drag_parameters;
+	PooledObject<Dictionary> local_parameters(event_parameters_pool), local_drag_parameters(event_parameters_pool);
+	Dictionary& parameters = out_parameters ? *out_parameters : *local_parameters;
+	Dictionary& drag_parameters = out_drag_parameters ? *out_drag_parameters : *local_drag_parameters;
 
 	// Generate the parameters for the mouse events (there could be a few!).
 	GenerateMouseEventParameters(parameters);
@@ -1319,36 +2003,36 @@ void Context::UpdateHoverChain(Vector2i old_mouse_position, int key_modifier_sta
 	}
 
 	// Build the new hover chain.
-	ElementSet new_hover_chain;
+	PooledObject<ElementList> pooled_new_hover_chain(element_list_pool);
+	ElementList& new_hover_chain = *pooled_new_hover_chain;
 	Element* element = hover;
 	while (element != nullptr)
 	{
-		new_hover_chain.insert(element);
+		new_hover_chain.push_back(element);
 		element = element->GetParentNode();
 	}
 
 	// Send mouseout / mouseover events.
-	SendEvents(hover_chain, new_hover_chain, EventId::Mouseout, parameters);
-	SendEvents(new_hover_chain, hover_chain, EventId::Mouseover, parameters);
+	SendChainEvents(hover_chain, new_hover_chain, EventId::Mouseout, EventId::Mouseover, parameters);
 
 	// Send out drag events.
 	if (drag && mouse_active)
 	{
 		drag_hover = GetElementAtPoint(position, drag);
 
-		ElementSet new_drag_hover_chain;
+		PooledObject<ElementList> pooled_new_drag_hover_chain(element_list_pool);
+		ElementList& new_drag_hover_chain = *pooled_new_drag_hover_chain;
 		element = drag_hover;
 		while (element != nullptr)
 		{
-			new_drag_hover_chain.insert(element);
+			new_drag_hover_chain.push_back(element);
 			element = element->GetParentNode();
 		}
 
 		if (drag_started && drag_verbose)
 		{
 			// Send out ondragover and ondragout events as appropriate.
-			SendEvents(drag_hover_chain, new_drag_hover_chain, EventId::Dragout, drag_parameters);
-			SendEvents(new_drag_hover_chain, drag_hover_chain, EventId::Dragover, drag_parameters);
+			SendChainEvents(drag_hover_chain, new_drag_hover_chain, EventId::Dragout, EventId::Dragover, drag_parameters);
 		}
 
 		drag_hover_chain.swap(new_drag_hover_chain);
@@ -1394,10 +2078,14 @@ Element* Context::GetElementAtPoint(Vector2f point, const Element* ignore_elemen
 	// that is under the cursor.
 	if (element->local_stacking_context)
 	{
-		if (element->stacking_context_dirty)
-			element->BuildLocalStackingContext();
+		// The index rebuilds the stacking context if needed, and skips any children that cannot contain the point.
+		const ElementHitTestIndex& hit_test_index = ElementHitTestIndex::Get(element, hit_test_generation);
+		if (!hit_test_index.MayContain(point))
+			return nullptr;
 
-		for (int i = (int)element->stacking_context.size() - 1; i >= 0; --i)
+		ElementHitTestIndex::Candidates candidates = hit_test_index.GetCandidates(point);
+		int i = 0;
+		while (candidates.Next(i))
 		{
 			Element* stacking_child = element->stacking_context[i];
 			if (ignore_element)
@@ -1454,10 +2142,31 @@ Element* Context::GetElementAtPoint(Vector2f point, const Element* ignore_elemen
 
 void Context::CreateDragClone(Element* element)
 {
-	RMLUI_ASSERTMSG(cursor_proxy, "Unable to create drag clone, no cursor proxy document.");
-
 	ReleaseDragClone();
 
+	// The cursor proxy is only created once needed, as most contexts never drag any clones.
+	if (!cursor_proxy)
+	{
+		cursor_proxy = Factory::InstanceElement(nullptr, documents_base_tag, documents_base_tag, XMLAttributes());
+		ElementDocument* cursor_proxy_document = rmlui_dynamic_cast<ElementDocument*>(cursor_proxy.get());
+		RMLUI_ASSERTMSG(cursor_proxy_document, "Unable to create drag clone, no cursor proxy document.");
+		if (!cursor_proxy_document)
+			return;
+		cursor_proxy_document->context = this;
+
+		// The cursor proxy takes the style from its cloned element's document. The latter may define style rules for `<body>` which we don't want
+		// on the proxy. Thus, we override some properties here that we in particular don't want to inherit from the client document, especially
+		// those that result in decoration of the body element.
+		cursor_proxy_document->SetProperty(PropertyId::BackgroundColor, Property(Colourb(255, 255, 255, 0), Unit::COLOUR));
+		cursor_proxy_document->SetProperty(PropertyId::BorderTopWidth, Property(0, Unit::PX));
+		cursor_proxy_document->SetProperty(PropertyId::BorderRightWidth, Property(0, Unit::PX));
+		cursor_proxy_document->SetProperty(PropertyId::BorderBottomWidth, Property(0, Unit::PX));
+		cursor_proxy_document->SetProperty(PropertyId::BorderLeftWidth, Property(0, Unit::PX));
+		cursor_proxy_document->SetProperty(PropertyId::Decorator, Property());
+		cursor_proxy_document->SetProperty(PropertyId::OverflowX, Property(Style::Overflow::Visible));
+		cursor_proxy_document->SetProperty(PropertyId::OverflowY, Property(Style::Overflow::Visible));
+	}
+
 	// Instance the drag clone.
 	ElementPtr element_drag_clone = element->Clone();
 	if (!element_drag_clone)
@@ -1544,6 +2253,296 @@ void Context::GenerateDragEventParameters(Dictionary& parameters)
 	parameters["drag_element"] = (void*)drag;
 }
 
+static String AbsolutePath(const String& source, const String& base)
+{
+	String joined_path;
+	GetSystemInterface()->JoinPath(joined_path, StringUtilities::Replace(base, '|', ':'), StringUtilities::Replace(source, '|', ':'));
+	return StringUtilities::Replace(joined_path, ':', '|');
+}
+
+// Collects the style sheets of the document head from its parse events, the same way the head node handler finds them.
+static void CollectHeadStyleSheets(const XMLParseEventList& events, const URL& source_url, StringList& out_linked_sheet_paths,
+	Vector<StyleSheetFactory::StyleSheetFile>& out_inline_style_sheets)
+{
+	StringList open_tags;
+	bool in_head = false;
+
+	for (const XMLParseEvent& event : events)
+	{
+		switch (event.type)
+		{
+		case XMLParseEvent::Type::ElementStart:
+			if (event.value == "head")
+			{
+				in_head = true;
+			}
+			else if (in_head && event.value == "link")
+			{
+				const String type = StringUtilities::ToLower(Get<String>(event.attributes, "type", ""));
+				const String href = Get<String>(event.attributes, "href", "");
+				if ((type == "text/rcss" || type == "text/css") && !href.empty())
+					out_linked_sheet_paths.push_back(href);
+			}
+			open_tags.push_back(event.value);
+			break;
+		case XMLParseEvent::Type::ElementEnd:
+			if (event.value == "head")
+				return;
+			if (!open_tags.empty())
+				open_tags.pop_back();
+			break;
+		case XMLParseEvent::Type::Data:
+			if (in_head && !open_tags.empty() && open_tags.back() == "style" && !event.value.empty())
+				out_inline_style_sheets.push_back(
+					StyleSheetFactory::MakeInlineStyleSheetFile(event.value, source_url.GetURL(), event.line_number_open_tag));
+			break;
+		}
+	}
+}
+
+void Context::ParseQueuedDocument(QueuedDocument& queued_document)
+{
+	TaskInterface* task_interface = GetTaskInterface();
+	if (!task_interface)
+		return;
+
+	auto parsed_document = MakeShared<ParsedDocument>();
+
+	// Files are read here as the file interface may not be thread-safe.
+	StreamFile stream;
+	if (!stream.Open(queued_document.document_path))
+	{
+		parsed_document->done = true;
+		queued_document.parsed_document = std::move(parsed_document);
+		return;
+	}
+
+	parsed_document->source_url = stream.GetSourceURL();
+	stream.Read(parsed_document->source, stream.Length());
+	XMLParser::RegisterTokenizerSyntax(parsed_document->tokenizer);
+
+	// The source is tokenized and its inline style sheets parsed on the task. The elements are instanced on the main thread by replaying the
+	// recorded events.
+	parsed_document->task = task_interface->Submit([parsed_document]() {
+		{
+			LogCapture log_capture(parsed_document->log_messages);
+			StreamMemory source_stream(reinterpret_cast<const byte*>(parsed_document->source.data()), parsed_document->source.size());
+			source_stream.SetSourceURL(parsed_document->source_url);
+
+			parsed_document->tokenizer.SetRecordEvents(&parsed_document->events);
+			parsed_document->tokenizer.Parse(&source_stream);
+			parsed_document->tokenizer.SetRecordEvents(nullptr);
+		}
+
+		CollectHeadStyleSheets(parsed_document->events, parsed_document->source_url, parsed_document->linked_sheet_paths,
+			parsed_document->inline_style_sheets);
+		for (StyleSheetFactory::StyleSheetFile& file : parsed_document->inline_style_sheets)
+			StyleSheetFactory::ParseStyleSheetFile(file);
+
+		parsed_document->done.store(true, std::memory_order_release);
+	});
+	parsed_document->opened = true;
+	parsed_document->task_pending = true;
+
+	queued_document.parsed_document = std::move(parsed_document);
+}
+
+bool Context::ParseLinkedStyleSheets(const SharedPtr<ParsedDocument>& parsed_document)
+{
+	// The paths are resolved and the files read here, as the system and file interfaces may not be thread-safe.
+	Vector<StyleSheetFactory::StyleSheetFile> files;
+	for (const String& href : parsed_document->linked_sheet_paths)
+	{
+		const String sheet = AbsolutePath(href, parsed_document->source_url.GetURL());
+		if (std::any_of(files.begin(), files.end(), [&sheet](const StyleSheetFactory::StyleSheetFile& file) { return file.sheet == sheet; }))
+			continue;
+
+		StyleSheetFactory::StyleSheetFile file;
+		if (StyleSheetFactory::ReadLinkedStyleSheetFile(file, sheet))
+			files.push_back(std::move(file));
+	}
+	parsed_document->linked_sheet_paths.clear();
+
+	TaskInterface* task_interface = GetTaskInterface();
+	if (files.empty() || !task_interface)
+		return false;
+
+	parsed_document->linked_style_sheets = std::move(files);
+	parsed_document->done = false;
+	parsed_document->task = task_interface->Submit([parsed_document]() {
+		for (StyleSheetFactory::StyleSheetFile& file : parsed_document->linked_style_sheets)
+			StyleSheetFactory::ParseStyleSheetFile(file);
+
+		parsed_document->done.store(true, std::memory_order_release);
+	});
+	parsed_document->task_pending = true;
+
+	return true;
+}
+
+ElementDocument* Context::LoadParsedDocument(ParsedDocument& parsed_document)
+{
+	const double start_time = StartupTimer::Now();
+
+	LogCapture::Replay(parsed_document.log_messages);
+
+	// Cache the sheets parsed in the background, so that they are found when the document head is processed.
+	StyleSheetFactory::AddParsedStyleSheetFiles(parsed_document.inline_style_sheets);
+	StyleSheetFactory::AddParsedStyleSheetFiles(parsed_document.linked_style_sheets);
+
+	DebugVerifyLocaleSetting();
+	PluginRegistry::NotifyDocumentOpen(this, parsed_document.source_url.GetURL());
+
+	ElementPtr element = Factory::InstanceElement(nullptr, documents_base_tag, documents_base_tag, XMLAttributes());
+	ElementDocument* document = rmlui_dynamic_cast<ElementDocument*>(element.get());
+	if (!document)
+	{
+		Log::Message(Log::LT_ERROR, "Failed to instance document element for '%s', was expecting derivative of ElementDocument.",
+			parsed_document.source_url.GetURL().c_str());
+		return nullptr;
+	}
+
+	document->context = this;
+
+	XMLParser parser(document);
+	parser.Replay(parsed_document.events, parsed_document.source_url);
+
+	root->AppendChild(std::move(element));
+
+	FinishDocumentLoad(document);
+
+	StartupTimer::AddDocumentLoad(StartupTimer::Now() - start_time);
+
+	return document;
+}
+
+void Context::LoadQueuedDocuments()
+{
+	RMLUI_ZoneScoped;
+
+	SystemInterface* system_interface = GetSystemInterface();
+	const double t_begin = system_interface->GetElapsedTime();
+
+	// Loading shares the update budget when set, at least one queued document or step is still loaded to make progress.
+	double load_budget = document_load_budget;
+	if (update_deadline >= 0)
+		load_budget = Math::Min(load_budget, Math::Max(update_deadline - t_begin, 0.0));
+
+	// Take ownership of the queue, the callbacks may queue new documents which are then loaded during the next update.
+	Vector<QueuedDocument> documents = std::move(queued_documents);
+	queued_documents.clear();
+
+	size_t i = 0;
+	for (; i < documents.size(); i++)
+	{
+		if (i > 0 && system_interface->GetElapsedTime() - t_begin >= load_budget)
+			break;
+
+		QueuedDocument& queued_document = documents[i];
+		if (!queued_document.parsed_document)
+		{
+			if (queued_document.preload)
+			{
+				PreloadDocument(queued_document.document_path);
+				continue;
+			}
+
+			ElementDocument* document = LoadDocument(queued_document.document_path);
+			if (queued_document.on_loaded)
+				queued_document.on_loaded(document);
+			continue;
+		}
+
+		// Documents are loaded in order, so wait for the next update while this one is still being parsed.
+		ParsedDocument& parsed_document = *queued_document.parsed_document;
+		if (!parsed_document.done.load(std::memory_order_acquire))
+			break;
+
+		if (parsed_document.task_pending)
+		{
+			TaskInterface* task_interface = GetTaskInterface();
+			RMLUI_ASSERTMSG(task_interface, "The task interface was removed while documents were still being parsed.");
+			if (task_interface)
+				task_interface->Wait(parsed_document.task);
+			parsed_document.task_pending = false;
+
+			// Wait for the next update while the linked style sheets of the document are being parsed.
+			if (ParseLinkedStyleSheets(queued_document.parsed_document))
+				break;
+		}
+
+		ElementDocument* document = nullptr;
+		const size_t first_texture_index = RenderManagerAccess::GetNumFileTextures(render_manager);
+		if (parsed_document.opened)
+			document = LoadParsedDocument(parsed_document);
+		queued_document.parsed_document.reset();
+
+		if (queued_document.preload)
+		{
+			if (document)
+			{
+				RenderManagerAccess::PreloadFileTextures(render_manager, first_texture_index);
+				document->Close();
+			}
+			continue;
+		}
+
+		if (queued_document.on_loaded)
+			queued_document.on_loaded(document);
+	}
+
+	if (i < documents.size())
+	{
+		queued_documents.insert(queued_documents.begin(), MakeMoveIterator(documents.begin() + i), MakeMoveIterator(documents.end()));
+		RequestNextUpdate(0);
+		return;
+	}
+
+	// Continue loading the progressive documents with the remaining budget. At least one step is taken if no queued document was loaded.
+	constexpr int tags_per_step = 32;
+	bool any_steps = (i > 0);
+
+	Vector<ProgressiveDocument> loading_documents = std::move(progressive_documents);
+	progressive_documents.clear();
+
+	Vector<ProgressiveDocument> unfinished_documents;
+	for (ProgressiveDocument& loading_document : loading_documents)
+	{
+		// Stop loading documents which have been closed in the meantime.
+		Element* element = loading_document.document.get();
+		if (!element || element->GetParentNode() != root.get())
+			continue;
+
+		bool finished = false;
+		{
+			ElementBatchUpdate batch_update;
+			while (!finished && (!any_steps || system_interface->GetElapsedTime() - t_begin < load_budget))
+			{
+				finished = loading_document.parser->ParseNext(tags_per_step);
+				any_steps = true;
+			}
+		}
+
+		if (!finished)
+		{
+			unfinished_documents.push_back(std::move(loading_document));
+			continue;
+		}
+
+		ElementDocument* document = rmlui_static_cast<ElementDocument*>(element);
+		FinishDocumentLoad(document);
+		if (loading_document.on_loaded)
+			loading_document.on_loaded(document);
+	}
+
+	if (!unfinished_documents.empty())
+	{
+		progressive_documents.insert(progressive_documents.begin(), MakeMoveIterator(unfinished_documents.begin()),
+			MakeMoveIterator(unfinished_documents.end()));
+		RequestNextUpdate(0);
+	}
+}
+
 void Context::ReleaseUnloadedDocuments()
 {
 	if (!unloaded_documents.empty())
@@ -1553,11 +2552,112 @@ void Context::ReleaseUnloadedDocuments()
 
 		// Clear the deleted list.
 		for (size_t i = 0; i < documents.size(); ++i)
+		{
+			if (ElementDocument* document = rmlui_dynamic_cast<ElementDocument*>(documents[i].get()))
+				released_document_statistics += document->frame_statistics;
 			documents[i]->GetEventDispatcher()->DetachAllEvents();
+		}
 		documents.clear();
 	}
 }
 
+void Context::AddDirtyRegion(Rectanglef region)
+{
+	dirty_region = (dirty_region.Valid() ? dirty_region.Join(region) : region);
+}
+
+void Context::AddFilterRegion(Rectanglef region)
+{
+	if (region.Valid())
+		filter_regions.push_back(region);
+}
+
+void Context::DirtyEntireRegion()
+{
+	AddDirtyRegion(Rectanglef::FromSize(Vector2f(dimensions)));
+}
+
+void Context::UpdateRedrawRegion()
+{
+	// Textures loading asynchronously or regenerated during later frames are replaced without any change to the elements using them, and the
+	// drag clone is rendered separately from the documents.
+	if (drag_clone || render_manager->HasPendingTextures())
+		DirtyEntireRegion();
+
+	// Filters such as blur spread any change within their bounds to the whole filtered area, which may in turn overlap other filters.
+	if (dirty_region.Valid())
+	{
+		bool expanded = true;
+		while (expanded)
+		{
+			expanded = false;
+			for (Rectanglef& filter_region : filter_regions)
+			{
+				if (filter_region.Valid() && filter_region.Intersects(dirty_region))
+				{
+					dirty_region = dirty_region.Join(filter_region);
+					filter_region = Rectanglef::MakeInvalid();
+					expanded = true;
+				}
+			}
+		}
+	}
+	filter_regions.clear();
+
+	if (!dirty_region.Valid())
+		return;
+
+	Math::ExpandToPixelGrid(dirty_region);
+	const Rectanglei region = Rectanglei(dirty_region).Intersect(Rectanglei::FromSize(dimensions));
+	redraw_region = (redraw_region.Valid() ? redraw_region.Join(region) : region);
+	dirty_region = Rectanglef::MakeInvalid();
+}
+
+void Context::EndFrameStatistics()
+{
+	FrameStatistics& statistics = frame_statistics;
+	statistics.total = released_document_statistics;
+	released_document_statistics = {};
+
+	statistics.documents.clear();
+	for (int i = 0; i < root->GetNumChildren(true); ++i)
+	{
+		ElementDocument* document = root->GetChild(i)->GetOwnerDocument();
+		if (!document)
+			continue;
+
+		statistics.total += document->frame_statistics;
+		statistics.documents.push_back(FrameStatistics::Document{document->GetSourceURL(), document->GetId(), document->frame_statistics});
+		document->frame_statistics = {};
+	}
+
+	// Documents pending release no longer belong to the context, only their totals are reported.
+	for (const ElementPtr& element : unloaded_documents)
+	{
+		if (ElementDocument* document = rmlui_dynamic_cast<ElementDocument*>(element.get()))
+		{
+			statistics.total += document->frame_statistics;
+			document->frame_statistics = {};
+		}
+	}
+
+	statistics.element_invalidations = std::move(element_invalidations);
+	element_invalidations.clear();
+
+	statistics.data_models.clear();
+	if (data_model_profiling)
+	{
+		for (auto& data_model : data_models)
+			statistics.data_models[data_model.first] = data_model.second->TakeStatistics();
+	}
+
+	const RenderStats render_stats = render_manager->GetRenderStats();
+	statistics.num_draw_calls = int(render_stats.num_draw_calls - previous_render_stats.num_draw_calls);
+	statistics.num_texture_uploads = int(render_stats.num_texture_uploads - previous_render_stats.num_texture_uploads);
+	statistics.compiled_geometry_bytes = size_t(render_stats.compiled_geometry_bytes - previous_render_stats.compiled_geometry_bytes);
+	previous_render_stats = render_stats;
+}
+
 using ElementObserverList = Vector<ObserverPtr<Element>>;
 
 class ElementObserverListBackInserter {
@@ -1595,6 +2695,38 @@ void Context::SendEvents(const ElementSet& old_items, const ElementSet& new_item
 	}
 }
 
+void Context::SendChainEvents(const ElementList& old_chain, const ElementList& new_chain, EventId out_id, EventId over_id,
+	const Dictionary& parameters)
+{
+	size_t num_common = 0;
+	while (num_common < old_chain.size() && num_common < new_chain.size() &&
+		old_chain[old_chain.size() - 1 - num_common] == new_chain[new_chain.size() - 1 - num_common])
+		num_common++;
+
+	// Usually the chain is unchanged between mouse moves, then there is nothing to send.
+	const size_t num_old = old_chain.size() - num_common;
+	const size_t num_new = new_chain.size() - num_common;
+	if (num_old == 0 && num_new == 0)
+		return;
+
+	// We put our elements in observer pointers in case some of them are deleted during dispatch. The list is pooled, as dispatching may
+	// lead to new mouse moves being processed recursively.
+	PooledObject<ElementObserverList> pooled_elements(observer_list_pool);
+	ElementObserverList& elements = *pooled_elements;
+
+	// Leave the old elements from the leaf up, then enter the new elements from the common ancestor down.
+	for (size_t i = 0; i < num_old; i++)
+		elements.push_back(old_chain[i]->GetObserverPtr());
+	for (size_t i = num_new; i-- > 0;)
+		elements.push_back(new_chain[i]->GetObserverPtr());
+
+	for (size_t i = 0; i < elements.size(); i++)
+	{
+		if (elements[i])
+			elements[i]->DispatchEvent(i < num_old ? out_id : over_id, parameters);
+	}
+}
+
 void Context::Release()
 {
 	if (instancer)
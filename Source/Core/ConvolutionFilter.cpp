@@ -1,8 +1,17 @@
 #include "../../Include/RmlUi/Core/ConvolutionFilter.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
+#include "Memory.h"
 #include <float.h>
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define RMLUI_CONVOLUTION_FILTER_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+	#include <arm_neon.h>
+	#define RMLUI_CONVOLUTION_FILTER_NEON
+#endif
+
 namespace Rml {
 
 ConvolutionFilter::ConvolutionFilter() {}
@@ -39,52 +48,209 @@ float* ConvolutionFilter::operator[](int kernel_y_index)
 	return kernel.get() + kernel_size.x * kernel_y_index;
 }
 
-void ConvolutionFilter::Run(byte* destination, const Vector2i destination_dimensions, const int destination_stride,
-	const ColorFormat destination_color_format, const byte* source, const Vector2i source_dimensions, const Vector2i source_offset,
-	const ColorFormat source_color_format) const
-{
-	RMLUI_ZoneScopedNC("ConvFilter::Run", 0xd6bf49);
+namespace {
+	struct KernelRowRange {
+		int begin;
+		int end;
+	};
+
+	template <FilterOperation operation>
+	inline float Accumulate(float opacity, float pixel_opacity)
+	{
+		return operation == FilterOperation::Sum ? opacity + pixel_opacity : Math::Max(opacity, pixel_opacity);
+	}
 
-	const int destination_bytes_per_pixel = (destination_color_format == ColorFormat::RGBA8 ? 4 : 1);
-	const int destination_alpha_offset = (destination_color_format == ColorFormat::RGBA8 ? 3 : 0);
-	const int source_bytes_per_pixel = (source_color_format == ColorFormat::RGBA8 ? 4 : 1);
-	const int source_alpha_offset = (source_color_format == ColorFormat::RGBA8 ? 3 : 0);
+#if defined(RMLUI_CONVOLUTION_FILTER_SSE2)
+	using FloatBlock = __m128;
+	inline FloatBlock LoadBlock(const byte* source)
+	{
+		int32_t bytes;
+		memcpy(&bytes, source, sizeof(bytes));
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i words = _mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero);
+		return _mm_cvtepi32_ps(_mm_unpacklo_epi16(words, zero));
+	}
+	inline FloatBlock ZeroBlock()
+	{
+		return _mm_setzero_ps();
+	}
+	template <FilterOperation operation>
+	inline FloatBlock AccumulateBlock(FloatBlock opacity, FloatBlock pixels, float weight)
+	{
+		const __m128 pixel_opacity = _mm_mul_ps(pixels, _mm_set1_ps(weight));
+		return operation == FilterOperation::Sum ? _mm_add_ps(opacity, pixel_opacity) : _mm_max_ps(opacity, pixel_opacity);
+	}
+	inline void StoreBlock(float* destination, FloatBlock block)
+	{
+		_mm_storeu_ps(destination, block);
+	}
+#elif defined(RMLUI_CONVOLUTION_FILTER_NEON)
+	using FloatBlock = float32x4_t;
+	inline FloatBlock LoadBlock(const byte* source)
+	{
+		uint8_t bytes[8] = {source[0], source[1], source[2], source[3]};
+		const uint16x4_t words = vget_low_u16(vmovl_u8(vld1_u8(bytes)));
+		return vcvtq_f32_u32(vmovl_u16(words));
+	}
+	inline FloatBlock ZeroBlock()
+	{
+		return vdupq_n_f32(0.f);
+	}
+	template <FilterOperation operation>
+	inline FloatBlock AccumulateBlock(FloatBlock opacity, FloatBlock pixels, float weight)
+	{
+		const float32x4_t pixel_opacity = vmulq_n_f32(pixels, weight);
+		return operation == FilterOperation::Sum ? vaddq_f32(opacity, pixel_opacity) : vmaxq_f32(opacity, pixel_opacity);
+	}
+	inline void StoreBlock(float* destination, FloatBlock block)
+	{
+		vst1q_f32(destination, block);
+	}
+#endif
 
-	const Vector2i kernel_radius = (kernel_size - Vector2i(1)) / 2;
+	struct FilterParameters {
+		const float* kernel;
+		Vector2i kernel_size;
+		Vector2i kernel_radius;
+		const KernelRowRange* row_ranges;
+		byte* destination;
+		Vector2i destination_dimensions;
+		int destination_stride;
+		int destination_bytes_per_pixel;
+		int destination_alpha_offset;
+		const byte* source;
+		Vector2i source_dimensions;
+		Vector2i source_offset;
+		int source_bytes_per_pixel;
+		int source_alpha_offset;
+	};
 
-	for (int y = 0; y < destination_dimensions.y; ++y)
+	template <FilterOperation operation>
+	inline void FilterPixel(const FilterParameters& p, byte* destination_row, int x, int source_y_begin, int kernel_y_begin, int kernel_y_end)
 	{
-		for (int x = 0; x < destination_dimensions.x; ++x)
+		// The range of kernel columns overlapping the source.
+		const int source_x_begin = x - p.source_offset.x - p.kernel_radius.x;
+		const int kernel_x_begin = Math::Max(0, -source_x_begin);
+		const int kernel_x_end = Math::Min(p.kernel_size.x, p.source_dimensions.x - source_x_begin);
+		const int source_row_stride = p.source_dimensions.x * p.source_bytes_per_pixel;
+
+		float opacity = 0.f;
+
+		for (int kernel_y = kernel_y_begin; kernel_y < kernel_y_end; ++kernel_y)
 		{
-			float opacity = 0.f;
+			const byte* source_row = p.source + (source_y_begin + kernel_y) * source_row_stride + p.source_alpha_offset;
+			const float* kernel_row = p.kernel + kernel_y * p.kernel_size.x;
+			const int begin = Math::Max(kernel_x_begin, p.row_ranges[kernel_y].begin);
+			const int end = Math::Min(kernel_x_end, p.row_ranges[kernel_y].end);
 
-			for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
+			for (int kernel_x = begin; kernel_x < end; ++kernel_x)
 			{
-				const int source_y = y - source_offset.y - kernel_radius.y + kernel_y;
+				const float pixel_opacity = float(source_row[(source_x_begin + kernel_x) * p.source_bytes_per_pixel]) * kernel_row[kernel_x];
+				opacity = Accumulate<operation>(opacity, pixel_opacity);
+			}
+		}
+
+		destination_row[x * p.destination_bytes_per_pixel] = byte(Math::Min(255.f, opacity));
+	}
+
+	template <FilterOperation operation>
+	void RunFilter(const FilterParameters& p)
+	{
+		for (int y = 0; y < p.destination_dimensions.y; ++y)
+		{
+			// The range of kernel rows overlapping the source, the same for every pixel in this row.
+			const int source_y_begin = y - p.source_offset.y - p.kernel_radius.y;
+			const int kernel_y_begin = Math::Max(0, -source_y_begin);
+			const int kernel_y_end = Math::Min(p.kernel_size.y, p.source_dimensions.y - source_y_begin);
+
+			byte* destination_row = p.destination + y * p.destination_stride + p.destination_alpha_offset;
+			int x = 0;
 
-				for (int kernel_x = 0; kernel_x < kernel_size.x; ++kernel_x)
+#if defined(RMLUI_CONVOLUTION_FILTER_SSE2) || defined(RMLUI_CONVOLUTION_FILTER_NEON)
+			// Where the whole kernel width lies inside the source, four neighbouring pixels share the same kernel range and are filtered
+			// together. The weights are applied in the same order as in the scalar path.
+			if (p.source_bytes_per_pixel == 1)
+			{
+				const int source_row_stride = p.source_dimensions.x;
+				const int interior_begin = Math::Clamp(p.source_offset.x + p.kernel_radius.x, 0, p.destination_dimensions.x);
+				const int interior_end = Math::Clamp(p.source_dimensions.x - p.kernel_size.x + 1 + p.source_offset.x + p.kernel_radius.x,
+					interior_begin, p.destination_dimensions.x);
+				const int vector_end = interior_begin + (interior_end - interior_begin) / 4 * 4;
+
+				for (; x < interior_begin; ++x)
+					FilterPixel<operation>(p, destination_row, x, source_y_begin, kernel_y_begin, kernel_y_end);
+
+				for (; x < vector_end; x += 4)
 				{
-					const int source_x = x - source_offset.x - kernel_radius.x + kernel_x;
-					if (source_y >= 0 && source_y < source_dimensions.y && source_x >= 0 && source_x < source_dimensions.x)
+					const int source_x_begin = x - p.source_offset.x - p.kernel_radius.x;
+					FloatBlock opacity = ZeroBlock();
+
+					for (int kernel_y = kernel_y_begin; kernel_y < kernel_y_end; ++kernel_y)
 					{
-						const int source_index = (source_y * source_dimensions.x + source_x) * source_bytes_per_pixel + source_alpha_offset;
-						const float pixel_opacity = float(source[source_index]) * kernel[kernel_y * kernel_size.x + kernel_x];
-
-						switch (operation)
-						{
-						case FilterOperation::Sum: opacity += pixel_opacity; break;
-						case FilterOperation::Dilation: opacity = Math::Max(opacity, pixel_opacity); break;
-						}
+						const byte* source_row = p.source + (source_y_begin + kernel_y) * source_row_stride + source_x_begin;
+						const float* kernel_row = p.kernel + kernel_y * p.kernel_size.x;
+						const KernelRowRange range = p.row_ranges[kernel_y];
+
+						for (int kernel_x = range.begin; kernel_x < range.end; ++kernel_x)
+							opacity = AccumulateBlock<operation>(opacity, LoadBlock(source_row + kernel_x), kernel_row[kernel_x]);
 					}
+
+					float result[4];
+					StoreBlock(result, opacity);
+					for (int i = 0; i < 4; ++i)
+						destination_row[(x + i) * p.destination_bytes_per_pixel] = byte(Math::Min(255.f, result[i]));
 				}
 			}
+#endif
 
-			opacity = Math::Min(255.f, opacity);
-
-			const int destination_index = y * destination_stride + x * destination_bytes_per_pixel + destination_alpha_offset;
-			destination[destination_index] = byte(opacity);
+			for (; x < p.destination_dimensions.x; ++x)
+				FilterPixel<operation>(p, destination_row, x, source_y_begin, kernel_y_begin, kernel_y_end);
 		}
 	}
+} // namespace
+
+void ConvolutionFilter::Run(byte* destination, const Vector2i destination_dimensions, const int destination_stride,
+	const ColorFormat destination_color_format, const byte* source, const Vector2i source_dimensions, const Vector2i source_offset,
+	const ColorFormat source_color_format) const
+{
+	RMLUI_ZoneScopedNC("ConvFilter::Run", 0xd6bf49);
+
+	// Zero weights never contribute to either operation, so each kernel row is trimmed to the range of its non-zero weights. This makes e.g.
+	// the corners of circular kernels free.
+	DynamicArray<KernelRowRange, GlobalStackAllocator<KernelRowRange>> row_ranges(kernel_size.y);
+	for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
+	{
+		const float* kernel_row = kernel.get() + kernel_y * kernel_size.x;
+		int begin = 0;
+		int end = kernel_size.x;
+		while (begin < end && kernel_row[begin] == 0.f)
+			begin++;
+		while (end > begin && kernel_row[end - 1] == 0.f)
+			end--;
+		row_ranges[kernel_y] = KernelRowRange{begin, end};
+	}
+
+	FilterParameters parameters;
+	parameters.kernel = kernel.get();
+	parameters.kernel_size = kernel_size;
+	parameters.kernel_radius = (kernel_size - Vector2i(1)) / 2;
+	parameters.row_ranges = row_ranges.data();
+	parameters.destination = destination;
+	parameters.destination_dimensions = destination_dimensions;
+	parameters.destination_stride = destination_stride;
+	parameters.destination_bytes_per_pixel = (destination_color_format == ColorFormat::RGBA8 ? 4 : 1);
+	parameters.destination_alpha_offset = (destination_color_format == ColorFormat::RGBA8 ? 3 : 0);
+	parameters.source = source;
+	parameters.source_dimensions = source_dimensions;
+	parameters.source_offset = source_offset;
+	parameters.source_bytes_per_pixel = (source_color_format == ColorFormat::RGBA8 ? 4 : 1);
+	parameters.source_alpha_offset = (source_color_format == ColorFormat::RGBA8 ? 3 : 0);
+
+	switch (operation)
+	{
+	case FilterOperation::Sum: RunFilter<FilterOperation::Sum>(parameters); break;
+	case FilterOperation::Dilation: RunFilter<FilterOperation::Dilation>(parameters); break;
+	}
 }
 
 } // namespace Rml
@@ -5,24 +5,38 @@
 #include "../../Include/RmlUi/Core/Factory.h"
 #include "../../Include/RmlUi/Core/FileInterface.h"
 #include "../../Include/RmlUi/Core/FontEngineInterface.h"
+#include "../../Include/RmlUi/Core/MemoryStatistics.h"
 #include "../../Include/RmlUi/Core/Plugin.h"
+#include "../../Include/RmlUi/Core/Profiler.h"
 #include "../../Include/RmlUi/Core/RenderInterface.h"
 #include "../../Include/RmlUi/Core/RenderManager.h"
+#include "../../Include/RmlUi/Core/StartupStatistics.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
 #include "../../Include/RmlUi/Core/StyleSheetSpecification.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
 #include "../../Include/RmlUi/Core/TextInputHandler.h"
+#include "../../Include/RmlUi/Core/TextShapingContext.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "BackgroundBorderCache.h"
+#include "BackgroundTasks.h"
 #include "BoxShadowCache.h"
 #include "ComputeProperty.h"
 #include "ControlledLifetimeResource.h"
+#include "EffectsCache.h"
+#include "ElementEffects.h"
 #include "ElementMeta.h"
+#include "ElementStyle.h"
 #include "EventSpecification.h"
 #include "FileInterfaceDefault.h"
+#include "ImageGeometryCache.h"
+#include "Layout/LayoutEngine.h"
 #include "PluginRegistry.h"
 #include "RenderManagerAccess.h"
+#include "StartupTimer.h"
 #include "StyleSheetFactory.h"
 #include "StyleSheetParser.h"
 #include "TemplateCache.h"
+#include "TranslationCache.h"
 
 #ifdef RMLUI_FONT_ENGINE_FREETYPE
 	#include "FontEngineDefault/FontEngineInterfaceDefault.h"
@@ -42,9 +56,14 @@ namespace Rml {
 
 static RenderInterface* render_interface = nullptr;
 static SystemInterface* system_interface = nullptr;
+static MemoryInterface* memory_interface = nullptr;
 static FileInterface* file_interface = nullptr;
 static FontEngineInterface* font_interface = nullptr;
 static TextInputHandler* text_input_handler = nullptr;
+static TaskInterface* task_interface = nullptr;
+static ProfilingInterface* profiling_interface = nullptr;
+static int element_pool_size = 0;
+static int layout_thread_count = 0;
 
 struct CoreData {
 	// Default interfaces should be created and destroyed on Initialise and Shutdown, respectively.
@@ -61,13 +80,18 @@ static ControlledLifetimeResource<CoreData> core_data;
 
 static bool initialised = false;
 
+static StartupStatistics startup_statistics;
+static double initialise_start_time = 0;
+
 static void InitializeMemoryPools()
 {
-	Detail::InitializeElementInstancerPools();
-	ElementMetaPool::Initialize();
+	Detail::InitializeElementInstancerPools(element_pool_size);
+	ElementMetaPool::Initialize(element_pool_size);
+	LayoutEngine::Initialize(layout_thread_count);
 }
 static void ReleaseMemoryPools()
 {
+	LayoutEngine::Shutdown();
 	ElementMetaPool::Shutdown();
 	Detail::ShutdownElementInstancerPools();
 }
@@ -80,74 +104,105 @@ bool Initialise()
 {
 	RMLUI_ASSERTMSG(!initialised, "Rml::Initialise() called, but RmlUi is already initialised!");
 
-	InitializeMemoryPools();
-	InitializeComputeProperty();
-
-	core_data.Initialize();
+	StartupStatistics& startup = startup_statistics;
+	startup = {};
+	initialise_start_time = StartupTimer::Now();
+	StartupTimer initialise_timer(startup.initialise_time);
 
-	// Install default interfaces as appropriate.
-	if (!system_interface)
 	{
-		core_data->default_system_interface = MakeUnique<SystemInterface>();
-		system_interface = core_data->default_system_interface.get();
-	}
+		StartupTimer timer(startup.interfaces_time);
 
-	if (!file_interface)
-	{
+		InitializeMemoryPools();
+		InitializeComputeProperty();
+
+		core_data.Initialize();
+
+		// Install default interfaces as appropriate.
+		if (!system_interface)
+		{
+			core_data->default_system_interface = MakeUnique<SystemInterface>();
+			system_interface = core_data->default_system_interface.get();
+		}
+
+		if (!file_interface)
+		{
 #ifndef RMLUI_NO_FILE_INTERFACE_DEFAULT
-		core_data->default_file_interface = MakeUnique<FileInterfaceDefault>();
-		file_interface = core_data->default_file_interface.get();
+			core_data->default_file_interface = MakeUnique<FileInterfaceDefault>();
+			file_interface = core_data->default_file_interface.get();
 #else
-		Log::Message(Log::LT_ERROR, "No file interface set!");
-		return false;
+			Log::Message(Log::LT_ERROR, "No file interface set!");
+			return false;
 #endif
-	}
+		}
 
-	if (!font_interface)
-	{
+		if (!font_interface)
+		{
 #ifdef RMLUI_FONT_ENGINE_FREETYPE
-		core_data->default_font_interface = MakeUnique<FontEngineInterfaceDefault>();
-		font_interface = core_data->default_font_interface.get();
+			core_data->default_font_interface = MakeUnique<FontEngineInterfaceDefault>();
+			font_interface = core_data->default_font_interface.get();
 #else
-		Log::Message(Log::LT_ERROR, "No font engine interface set!");
-		return false;
+			Log::Message(Log::LT_ERROR, "No font engine interface set!");
+			return false;
 #endif
-	}
+		}
 
-	if (!text_input_handler)
-	{
-		core_data->default_text_input_handler = MakeUnique<TextInputHandler>();
-		text_input_handler = core_data->default_text_input_handler.get();
-	}
+		if (!text_input_handler)
+		{
+			core_data->default_text_input_handler = MakeUnique<TextInputHandler>();
+			text_input_handler = core_data->default_text_input_handler.get();
+		}
 
-	EventSpecificationInterface::Initialize();
+		EventSpecificationInterface::Initialize();
 
-	Detail::InitializeObserverPtrPool();
+		Detail::InitializeObserverPtrPool();
 
-	if (render_interface)
-		core_data->render_managers[render_interface] = MakeUnique<RenderManager>(render_interface);
+		if (render_interface)
+			core_data->render_managers[render_interface] = MakeUnique<RenderManager>(render_interface);
+	}
+
+	{
+		StartupTimer timer(startup.font_engine_time);
+		font_interface->Initialize();
+	}
 
-	font_interface->Initialize();
+	{
+		StartupTimer timer(startup.specification_time);
+		StyleSheetSpecification::Initialise();
+	}
 
-	StyleSheetSpecification::Initialise();
-	StyleSheetParser::Initialise();
-	StyleSheetFactory::Initialise();
+	{
+		StartupTimer timer(startup.parsers_time);
+		StyleSheetParser::Initialise();
+		StyleSheetFactory::Initialise();
+		TemplateCache::Initialise();
+		TranslationCache::Initialize();
+	}
 
-	TemplateCache::Initialise();
+	{
+		StartupTimer timer(startup.factory_time);
+		Factory::Initialise();
+	}
 
-	Factory::Initialise();
+	{
+		StartupTimer timer(startup.plugins_time);
 
-	// Initialise plugins integrated with Core.
+		// Initialise plugins integrated with Core.
 #ifdef RMLUI_LOTTIE_PLUGIN
-	Lottie::Initialise();
+		Lottie::Initialise();
 #endif
 #ifdef RMLUI_SVG_PLUGIN
-	SVG::Initialise();
+		SVG::Initialise();
 #endif
-	BoxShadowCache::Initialize();
-
-	// Notify all plugins we're starting up.
-	PluginRegistry::NotifyInitialise();
+		BackgroundBorderCache::Initialize();
+		BoxShadowCache::Initialize();
+		ElementEffects::Initialize();
+		ElementStyle::Initialize();
+		EffectsCache::Initialize();
+		ImageGeometryCache::Initialize();
+
+		// Notify all plugins we're starting up.
+		PluginRegistry::NotifyInitialise();
+	}
 
 	initialised = true;
 
@@ -164,10 +219,19 @@ void Shutdown()
 	// Notify all plugins we're being shutdown.
 	PluginRegistry::NotifyShutdown();
 
+	ImageGeometryCache::Shutdown();
+	EffectsCache::Shutdown();
+	ElementStyle::Shutdown();
+	ElementEffects::Shutdown();
 	BoxShadowCache::Shutdown();
+	BackgroundBorderCache::Shutdown();
+
+	Profiler::SetEnabled(false);
+	Profiler::Clear();
 
 	Factory::Shutdown();
 	TemplateCache::Shutdown();
+	TranslationCache::Shutdown();
 	StyleSheetFactory::Shutdown();
 	StyleSheetParser::Shutdown();
 	StyleSheetSpecification::Shutdown();
@@ -181,6 +245,8 @@ void Shutdown()
 	initialised = false;
 
 	text_input_handler = nullptr;
+	task_interface = nullptr;
+	profiling_interface = nullptr;
 	font_interface = nullptr;
 	render_interface = nullptr;
 	file_interface = nullptr;
@@ -209,6 +275,17 @@ SystemInterface* GetSystemInterface()
 	return system_interface;
 }
 
+void SetMemoryInterface(MemoryInterface* _memory_interface)
+{
+	RMLUI_ASSERTMSG(!initialised, "Rml::SetMemoryInterface() must be called before Rml::Initialise().");
+	memory_interface = _memory_interface;
+}
+
+MemoryInterface* GetMemoryInterface()
+{
+	return memory_interface;
+}
+
 void SetRenderInterface(RenderInterface* _render_interface)
 {
 	render_interface = _render_interface;
@@ -244,11 +321,61 @@ void SetTextInputHandler(TextInputHandler* _text_input_handler)
 	text_input_handler = _text_input_handler;
 }
 
+void SetElementPoolSize(int num_elements)
+{
+	RMLUI_ASSERTMSG(!initialised, "Rml::SetElementPoolSize() must be called before Rml::Initialise().");
+	element_pool_size = Math::Max(num_elements, 0);
+}
+
+void SetLayoutThreadCount(int num_threads)
+{
+	RMLUI_ASSERTMSG(!initialised, "Rml::SetLayoutThreadCount() must be called before Rml::Initialise().");
+	layout_thread_count = Math::Max(num_threads, 0);
+}
+
+void SetBackgroundRendering(bool enable)
+{
+	RMLUI_ASSERTMSG(!initialised, "Rml::SetBackgroundRendering() must be called before Rml::Initialise().");
+	BackgroundTasks::SetRenderingEnabled(enable);
+}
+
+void SetTranslationCacheSize(int max_strings)
+{
+	TranslationCache::SetMaxSize(max_strings);
+}
+
+void InvalidateTranslations()
+{
+	TranslationCache::Invalidate();
+}
+
 TextInputHandler* GetTextInputHandler()
 {
 	return text_input_handler;
 }
 
+void SetTaskInterface(TaskInterface* _task_interface)
+{
+	RMLUI_ASSERTMSG(!initialised, "Rml::SetTaskInterface() must be called before Rml::Initialise().");
+	task_interface = _task_interface;
+}
+
+TaskInterface* GetTaskInterface()
+{
+	return task_interface;
+}
+
+void SetProfilingInterface(ProfilingInterface* _profiling_interface)
+{
+	RMLUI_ASSERTMSG(!initialised, "Rml::SetProfilingInterface() must be called before Rml::Initialise().");
+	profiling_interface = _profiling_interface;
+}
+
+ProfilingInterface* GetProfilingInterface()
+{
+	return profiling_interface;
+}
+
 Context* CreateContext(const String& name, const Vector2i dimensions, RenderInterface* render_interface_for_context,
 	TextInputHandler* text_input_handler_for_context)
 {
@@ -331,14 +458,50 @@ int GetNumContexts()
 
 bool LoadFontFace(const String& file_path, bool fallback_face, Style::FontWeight weight, int face_index)
 {
+	StartupTimer timer(startup_statistics.font_loading_time);
+	startup_statistics.num_font_faces += 1;
 	return font_interface->LoadFontFace(file_path, face_index, fallback_face, weight);
 }
 
 bool LoadFontFace(Span<const byte> data, const String& family, Style::FontStyle style, Style::FontWeight weight, bool fallback_face, int face_index)
 {
+	StartupTimer timer(startup_statistics.font_loading_time);
+	startup_statistics.num_font_faces += 1;
 	return font_interface->LoadFontFace(data, face_index, family, style, weight, fallback_face);
 }
 
+bool PreloadStyleSheet(const String& path)
+{
+	return StyleSheetFactory::GetStyleSheetContainer(path) != nullptr;
+}
+
+bool PreloadStyleSheets(const StringList& paths)
+{
+	StyleSheetFactory::LoadStyleSheetContainers(paths);
+
+	bool result = true;
+	for (const String& path : paths)
+		result &= (StyleSheetFactory::GetStyleSheetContainer(path) != nullptr);
+	return result;
+}
+
+bool PreloadTemplate(const String& path)
+{
+	return TemplateCache::LoadTemplate(path) != nullptr;
+}
+
+bool PreloadFontGlyphs(const String& family, Style::FontStyle style, Style::FontWeight weight, int size, const String& characters)
+{
+	const FontFaceHandle handle = font_interface->GetFontFaceHandle(StringUtilities::ToLower(family), style, weight, size);
+	if (!handle)
+		return false;
+
+	// Measuring the characters appends any missing glyphs to the font face.
+	const String language;
+	font_interface->GetStringWidth(handle, characters, TextShapingContext{language});
+	return true;
+}
+
 void RegisterPlugin(Plugin* plugin)
 {
 	if (initialised)
@@ -424,6 +587,70 @@ void ReleaseFontResources()
 		name_context.second->Update();
 }
 
+static void GetUsedFontFaceHandles(Element* element, UnorderedSet<FontFaceHandle>& used_handles)
+{
+	if (FontFaceHandle handle = element->GetFontFaceHandle())
+		used_handles.insert(handle);
+
+	const int num_children = element->GetNumChildren(true);
+	for (int i = 0; i < num_children; ++i)
+		GetUsedFontFaceHandles(element->GetChild(i), used_handles);
+}
+
+void ReleaseUnusedFontResources(size_t budget_bytes)
+{
+	if (!font_interface)
+		return;
+
+	UnorderedSet<FontFaceHandle> used_handles;
+	for (const auto& name_context : core_data->contexts)
+		GetUsedFontFaceHandles(name_context.second->GetRootElement(), used_handles);
+
+	font_interface->ReleaseUnusedFontResources(used_handles, budget_bytes);
+}
+
+bool SetFontDistanceFieldMode(bool enable)
+{
+	if (!font_interface)
+		return false;
+
+	if (enable)
+	{
+		for (const auto& render_manager : core_data->render_managers)
+		{
+			if (!render_manager.second->SupportsShader("distance-field-text"))
+			{
+				Log::Message(Log::LT_WARNING, "Unable to enable font distance fields, the render interface does not support the shader.");
+				return false;
+			}
+		}
+	}
+
+	for (const auto& name_context : core_data->contexts)
+		name_context.second->GetRootElement()->DirtyFontFaceRecursive();
+
+	const bool result = font_interface->SetDistanceFieldMode(enable);
+
+	for (const auto& name_context : core_data->contexts)
+		name_context.second->Update();
+
+	return result;
+}
+
+bool SaveFontCache(Vector<byte>& out_data)
+{
+	if (!font_interface)
+		return false;
+	return font_interface->SaveFontCache(out_data);
+}
+
+bool LoadFontCache(Span<const byte> data)
+{
+	if (!font_interface)
+		return false;
+	return font_interface->LoadFontCache(data);
+}
+
 void ReleaseRenderManagers()
 {
 	auto& contexts = core_data->contexts;
@@ -444,6 +671,86 @@ void ReleaseRenderManagers()
 	}
 }
 
+const StartupStatistics& GetStartupStatistics()
+{
+	return startup_statistics;
+}
+
+StartupStatistics& StartupTimer::GetStatistics()
+{
+	return startup_statistics;
+}
+
+void StartupTimer::AddDocumentLoad(double load_time)
+{
+	StartupStatistics& startup = startup_statistics;
+	startup.document_loading_time += load_time;
+	startup.num_documents += 1;
+
+	if (startup.num_documents == 1)
+	{
+		startup.first_document_time = load_time;
+		startup.time_to_first_document = Now() - initialise_start_time;
+	}
+}
+
+MemoryStatistics GetMemoryStatistics()
+{
+	MemoryStatistics statistics;
+	if (!core_data)
+		return statistics;
+
+	size_t total_bytes = 0;
+
+	for (const auto& name_context : core_data->contexts)
+	{
+		statistics.contexts.push_back(name_context.second->GetMemoryStats());
+		total_bytes += statistics.contexts.back().element_content_bytes;
+	}
+
+	Detail::GetElementInstancerPoolStats(statistics.pools);
+	{
+		const Pool<ElementMeta>& pool = ElementMetaPool::element_meta_pool->pool;
+		statistics.pools.push_back(MemoryPoolStats{"ElementMeta", pool.GetNumAllocatedObjects(), pool.GetSize(), pool.GetReservedBytes()});
+	}
+	statistics.pools.push_back(Detail::GetObserverPtrPoolStats());
+	{
+		// Layout nodes are only in use during layout, and their size is internal to the layout engine.
+		const LayoutEngine::NodePoolStats node_stats = LayoutEngine::GetNodePoolStats();
+		statistics.pools.push_back(MemoryPoolStats{"LayoutNode", 0, node_stats.num_allocated_nodes, 0});
+	}
+	for (const MemoryPoolStats& pool : statistics.pools)
+		total_bytes += pool.reserved_bytes;
+
+	for (auto& render_manager : core_data->render_managers)
+	{
+		statistics.geometry_bytes += render_manager.second->GetMeshBytes();
+
+		const FileTextureStats file_textures = render_manager.second->GetFileTextureStats();
+		statistics.file_textures.num_textures += file_textures.num_textures;
+		statistics.file_textures.num_resident_textures += file_textures.num_resident_textures;
+		statistics.file_textures.num_loading_textures += file_textures.num_loading_textures;
+		statistics.file_textures.resident_bytes += file_textures.resident_bytes;
+		statistics.file_textures.num_hits += file_textures.num_hits;
+		statistics.file_textures.num_misses += file_textures.num_misses;
+		statistics.file_textures.num_evictions += file_textures.num_evictions;
+		statistics.file_textures.num_atlased_textures += file_textures.num_atlased_textures;
+		statistics.file_textures.num_atlas_pages += file_textures.num_atlas_pages;
+	}
+	total_bytes += statistics.geometry_bytes + statistics.file_textures.resident_bytes;
+
+	if (font_interface)
+	{
+		statistics.fonts = font_interface->GetFontResourceStats();
+		total_bytes += statistics.fonts.texture_bytes + statistics.fonts.glyph_bytes;
+	}
+
+	statistics.num_cached_style_sheets = StyleSheetFactory::GetNumCachedStyleSheets();
+	statistics.total_bytes = total_bytes;
+
+	return statistics;
+}
+
 // Functions that need to be accessible within the Core library, but not publicly.
 namespace CoreInternal {
 
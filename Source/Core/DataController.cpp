@@ -1,6 +1,7 @@
 #include "DataController.h"
 #include "../../Include/RmlUi/Core/Element.h"
 #include "EventSpecification.h"
+#include <algorithm>
 
 namespace Rml {
 
@@ -33,8 +34,31 @@ void DataControllers::Add(DataControllerPtr controller)
 	controllers.emplace(element, std::move(controller));
 }
 
+void DataControllers::QueueUpdate(DataController* controller)
+{
+	if (std::find(queued_controllers.begin(), queued_controllers.end(), controller) == queued_controllers.end())
+		queued_controllers.push_back(controller);
+}
+
+void DataControllers::Update(DataModel& model)
+{
+	// Controllers may be queued again while updating, they are then updated during the next call.
+	Vector<DataController*> update_controllers = std::move(queued_controllers);
+	queued_controllers.clear();
+
+	for (DataController* controller : update_controllers)
+		controller->Update(model);
+}
+
 void DataControllers::OnElementRemove(Element* element)
 {
+	auto range = controllers.equal_range(element);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		DataController* controller = it->second.get();
+		queued_controllers.erase(std::remove(queued_controllers.begin(), queued_controllers.end(), controller), queued_controllers.end());
+	}
+
 	controllers.erase(element);
 }
 
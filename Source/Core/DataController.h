@@ -59,6 +59,9 @@ public:
 	// Returns true if the element still exists.
 	bool IsValid() const;
 
+	// Called during the next update of the data model after the controller has been queued, see DataModel::QueueControllerUpdate().
+	virtual void Update(DataModel& /*model*/) {}
+
 protected:
 	DataController(Element* element);
 
@@ -73,11 +76,17 @@ public:
 
 	void Add(DataControllerPtr controller);
 
+	// Queues the controller to be updated during the next call to Update(), at most once.
+	void QueueUpdate(DataController* controller);
+	void Update(DataModel& model);
+
 	void OnElementRemove(Element* element);
 
 private:
 	using ElementControllersMap = UnorderedMultimap<Element*, DataControllerPtr>;
 	ElementControllersMap controllers;
+
+	Vector<DataController*> queued_controllers;
 };
 
 } // namespace Rml
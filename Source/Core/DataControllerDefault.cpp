@@ -1,4 +1,5 @@
 #include "DataControllerDefault.h"
+#include "../../Include/RmlUi/Core/Context.h"
 #include "../../Include/RmlUi/Core/Element.h"
 #include "DataController.h"
 #include "DataExpression.h"
@@ -9,13 +10,22 @@ namespace Rml {
 
 DataControllerValue::DataControllerValue(Element* element) : DataController(element) {}
 
+static constexpr EventId commit_event_ids[] = {EventId::Blur, EventId::Dragend};
+
 DataControllerValue::~DataControllerValue()
 {
 	if (Element* element = GetElement())
+	{
 		element->RemoveEventListener(EventId::Change, this);
+		if (commit_mode)
+		{
+			for (EventId id : commit_event_ids)
+				element->RemoveEventListener(id, this);
+		}
+	}
 }
 
-bool DataControllerValue::Initialize(DataModel& model, Element* element, const String& variable_name, const String& /*modifier*/)
+bool DataControllerValue::Initialize(DataModel& model, Element* element, const String& variable_name, const String& modifier)
 {
 	RMLUI_ASSERT(element);
 
@@ -26,13 +36,44 @@ bool DataControllerValue::Initialize(DataModel& model, Element* element, const S
 	if (model.GetVariable(variable_address))
 		address = std::move(variable_address);
 
+	if (modifier == "commit")
+	{
+		commit_mode = true;
+		for (EventId id : commit_event_ids)
+			element->AddEventListener(id, this);
+	}
+	else if (!modifier.empty())
+	{
+		Log::Message(Log::LT_WARNING, "Unknown modifier '%s' of data controller in %s", modifier.c_str(), element->GetAddress().c_str());
+	}
+
 	element->AddEventListener(EventId::Change, this);
 
 	return true;
 }
 
+void DataControllerValue::Update(DataModel& model)
+{
+	Variant value_to_set = std::move(pending_value);
+	pending_value.Clear();
+
+	if (value_to_set.GetType() == Variant::NONE)
+		return;
+
+	if (DataVariable variable = model.GetVariable(address))
+		if (variable.Set(value_to_set))
+			model.DirtyVariable(address.front().name);
+}
+
 void DataControllerValue::ProcessEvent(Event& event)
 {
+	if (event.GetId() != EventId::Change)
+	{
+		// Commit the value once the user is done interacting with the element, such as when dragging a slider ends.
+		QueuePendingValue();
+		return;
+	}
+
 	if (const Element* element = GetElement())
 	{
 		Variant value_to_set;
@@ -48,16 +89,28 @@ void DataControllerValue::ProcessEvent(Event& event)
 				"A 'change' event was received, but it did not contain the attribute 'value' when processing a data binding in %s",
 				element->GetAddress().c_str());
 
-		DataModel* model = element->GetDataModel();
-		if (value_to_set.GetType() == Variant::NONE || !model)
+		if (value_to_set.GetType() == Variant::NONE)
 			return;
 
-		if (DataVariable variable = model->GetVariable(address))
-			if (variable.Set(value_to_set))
-				model->DirtyVariable(address.front().name);
+		// High-frequency changes, such as from dragging a slider, are coalesced so that the variable is set only once per update.
+		pending_value = std::move(value_to_set);
+		if (!commit_mode || event.GetParameter("linebreak", false))
+			QueuePendingValue();
 	}
 }
 
+void DataControllerValue::QueuePendingValue()
+{
+	Element* element = GetElement();
+	DataModel* model = (element ? element->GetDataModel() : nullptr);
+	if (!model || pending_value.GetType() == Variant::NONE)
+		return;
+
+	model->QueueControllerUpdate(this);
+	if (Context* context = element->GetContext())
+		context->RequestNextUpdate(0);
+}
+
 void DataControllerValue::Release()
 {
 	delete this;
@@ -104,7 +157,12 @@ void DataControllerEvent::ProcessEvent(Event& event)
 
 	if (Element* element = GetElement())
 	{
-		DataExpressionInterface expr_interface(element->GetDataModel(), element, &event);
+		// Set the latest changed values first, so that the expression sees the values of the current event.
+		DataModel* model = element->GetDataModel();
+		if (model)
+			model->UpdateControllers();
+
+		DataExpressionInterface expr_interface(model, element, &event);
 		Variant unused_value_out;
 		expression->Run(expr_interface, unused_value_out);
 	}
@@ -18,16 +18,26 @@ public:
 	DataControllerValue(Element* element);
 	~DataControllerValue();
 
+	// The 'commit' modifier only sets the variable once the user is done editing, otherwise it is set during the next model update.
 	bool Initialize(DataModel& model, Element* element, const String& expression, const String& modifier) override;
 
+	// Sets the variable to the latest changed value.
+	void Update(DataModel& model) override;
+
 private:
-	// Responds to 'Change' events.
+	// Responds to 'Change' events, and to the events committing the value in commit mode.
 	void ProcessEvent(Event& event) override;
 
 	// Delete this.
 	void Release() override;
 
+	// Queues the pending value to be set during the next model update.
+	void QueuePendingValue();
+
 	DataAddress address;
+	// The value of the latest change event which has not yet been set, only the latest value is set when changed repeatedly between updates.
+	Variant pending_value;
+	bool commit_mode = false;
 };
 
 class DataControllerEvent final : public DataController, private EventListener {
@@ -38,6 +38,7 @@ enum class Instruction {
 	// Assignment (register/stack) = Read (register R/L, instruction data D, or stack)
 	Push            = 'P',     //      S+ = R
 	Pop             = 'o',     //   <R/L> = S-  (D determines R/L)
+	MoveToL         = 'M',     //       L = R  (Replaces a push/pop pair around a single literal or variable instruction)
 	Literal         = 'D',     //       R = D
 	Variable        = 'V',     //       R = DataModel.GetVariable(D)  (D is an index into the variable address list)
 	Add             = '+',     //       R = L + R
@@ -79,6 +80,83 @@ struct ProgramState {
 	int stack_size;
 };
 
+// Evaluates the operator instructions, which only depend on the registers. Returns false if the instruction is not an operator.
+static bool EvaluateOperator(const Instruction instruction, const Variant& L, Variant& R)
+{
+	// Fast path for the common case of numeric operands.
+	if (L.GetType() == Variant::DOUBLE && R.GetType() == Variant::DOUBLE)
+	{
+		const double l = L.GetReference<double>();
+		const double r = R.GetReference<double>();
+		switch (instruction)
+		{
+			// clang-format off
+		case Instruction::Add:       R = l + r;  return true;
+		case Instruction::Subtract:  R = l - r;  return true;
+		case Instruction::Multiply:  R = l * r;  return true;
+		case Instruction::Divide:    R = l / r;  return true;
+		case Instruction::Less:      R = l < r;  return true;
+		case Instruction::LessEq:    R = l <= r; return true;
+		case Instruction::Greater:   R = l > r;  return true;
+		case Instruction::GreaterEq: R = l >= r; return true;
+		case Instruction::Equal:     R = l == r; return true;
+		case Instruction::NotEqual:  R = l != r; return true;
+			// clang-format on
+		default: break;
+		}
+	}
+
+	auto AnyString = [](const Variant& v1, const Variant& v2) { return v1.GetType() == Variant::STRING || v2.GetType() == Variant::STRING; };
+
+	switch (instruction)
+	{
+	case Instruction::Add:
+	{
+		if (L.GetType() == Variant::STRING && R.GetType() == Variant::STRING)
+			R = Variant(L.GetReference<String>() + R.GetReference<String>());
+		else if (AnyString(L, R))
+			R = Variant(L.Get<String>() + R.Get<String>());
+		else
+			R = Variant(L.Get<double>() + R.Get<double>());
+	}
+	break;
+		// clang-format off
+	case Instruction::Subtract:  R = Variant(L.Get<double>() - R.Get<double>());  break;
+	case Instruction::Multiply:  R = Variant(L.Get<double>() * R.Get<double>());  break;
+	case Instruction::Divide:    R = Variant(L.Get<double>() / R.Get<double>());  break;
+	case Instruction::Not:       R = Variant(!R.Get<bool>());                     break;
+	case Instruction::And:       R = Variant(L.Get<bool>() && R.Get<bool>());     break;
+	case Instruction::Or:        R = Variant(L.Get<bool>() || R.Get<bool>());     break;
+	case Instruction::Less:      R = Variant(L.Get<double>() < R.Get<double>());  break;
+	case Instruction::LessEq:    R = Variant(L.Get<double>() <= R.Get<double>()); break;
+	case Instruction::Greater:   R = Variant(L.Get<double>() > R.Get<double>());  break;
+	case Instruction::GreaterEq: R = Variant(L.Get<double>() >= R.Get<double>()); break;
+		// clang-format on
+	case Instruction::Equal:
+	{
+		if (L.GetType() == Variant::STRING && R.GetType() == Variant::STRING)
+			R = Variant(L.GetReference<String>() == R.GetReference<String>());
+		else if (AnyString(L, R))
+			R = Variant(L.Get<String>() == R.Get<String>());
+		else
+			R = Variant(L.Get<double>() == R.Get<double>());
+	}
+	break;
+	case Instruction::NotEqual:
+	{
+		if (L.GetType() == Variant::STRING && R.GetType() == Variant::STRING)
+			R = Variant(L.GetReference<String>() != R.GetReference<String>());
+		else if (AnyString(L, R))
+			R = Variant(L.Get<String>() != R.Get<String>());
+		else
+			R = Variant(L.Get<double>() != R.Get<double>());
+	}
+	break;
+	default: return false;
+	}
+	return true;
+}
+
 namespace Parse {
 	static void Assignment(DataParser& parser);
 	static void Expression(DataParser& parser);
@@ -149,6 +227,7 @@ public:
 	{
 		program.clear();
 		variable_addresses.clear();
+		fold_barrier = 0;
 		index = 0;
 		reached_end = false;
 		parse_error = false;
@@ -195,6 +274,7 @@ public:
 			"Use Push(), Pop(), Function(), Variable(), and Assign() procedures for stack manipulation and variable instructions.");
 
 		program.push_back(InstructionData{instruction, std::move(data)});
+		FoldConstants();
 	}
 	void Push()
 	{
@@ -209,6 +289,17 @@ public:
 			return;
 		}
 		program_stack_size -= 1;
+
+		// A single literal or variable instruction between the push and pop leaves the L register and the stack untouched. In this case, move
+		// the value directly into the L register instead of going through the stack.
+		const size_t n = program.size();
+		if (destination == Register::L && n >= 2 && n - 2 >= fold_barrier && program[n - 2].instruction == Instruction::Push &&
+			(program[n - 1].instruction == Instruction::Literal || program[n - 1].instruction == Instruction::Variable))
+		{
+			program[n - 2].instruction = Instruction::MoveToL;
+			return;
+		}
+
 		program.push_back(InstructionData{Instruction::Pop, Variant(int(destination))});
 	}
 	void Function(Instruction instruction, int num_arguments, String&& name)
@@ -227,16 +318,27 @@ public:
 	}
 	void Variable(const String& data_address) { VariableGetSet(data_address, false); }
 	void Assign(const String& data_address) { VariableGetSet(data_address, true); }
-	size_t InstructionIndex() const { return program.size(); }
+	size_t InstructionIndex()
+	{
+		// The index may be used as a jump target, thus no instructions before this point must be folded or moved.
+		fold_barrier = program.size();
+		return program.size();
+	}
 	void PatchInstruction(size_t index, InstructionData data) { program[index] = data; }
 
-	ProgramState GetProgramState() { return ProgramState{program.size(), program_stack_size}; }
+	ProgramState GetProgramState()
+	{
+		// Make sure the program never shrinks below the returned state.
+		fold_barrier = program.size();
+		return ProgramState{program.size(), program_stack_size};
+	}
 
 	void SetProgramState(const ProgramState& state)
 	{
 		RMLUI_ASSERT(state.program_length <= program.size());
 		program.resize(state.program_length);
 		program_stack_size = state.stack_size;
+		fold_barrier = Math::Min(fold_barrier, state.program_length);
 	}
 
 	bool AddVariableAddress(const String& name)
@@ -252,6 +354,48 @@ public:
 	}
 
 private:
+	// Replaces operators acting only on literals by their result, must be called after emitting each operator.
+	void FoldConstants()
+	{
+		const size_t n = program.size();
+		const Instruction instruction = program[n - 1].instruction;
+
+		if (instruction == Instruction::Not || instruction == Instruction::CastToInt)
+		{
+			// Unary: Literal, Operator
+			if (n < 2 || n - 2 < fold_barrier || program[n - 2].instruction != Instruction::Literal)
+				return;
+
+			Variant& value = program[n - 2].data;
+			if (instruction == Instruction::CastToInt)
+			{
+				int tmp = 0;
+				if (!value.GetInto(tmp))
+					return;
+				value = tmp;
+			}
+			else
+			{
+				EvaluateOperator(instruction, Variant(), value);
+			}
+			program.pop_back();
+		}
+		else
+		{
+			// Binary: Literal, MoveToL, Literal, Operator
+			if (n < 4 || n - 4 < fold_barrier || program[n - 4].instruction != Instruction::Literal ||
+				program[n - 3].instruction != Instruction::MoveToL || program[n - 2].instruction != Instruction::Literal)
+				return;
+
+			Variant result = program[n - 2].data;
+			if (!EvaluateOperator(instruction, program[n - 4].data, result))
+				return;
+
+			program[n - 4].data = std::move(result);
+			program.resize(n - 3);
+		}
+	}
+
 	void VariableGetSet(const String& name, bool is_assignment)
 	{
 		DataAddress address = expression_interface.ParseAddress(name);
@@ -273,6 +417,9 @@ private:
 	bool parse_error = true;
 	int program_stack_size = 0;
 
+	// Instructions before this index must not be changed by any optimizations.
+	size_t fold_barrier = 0;
+
 	Program program;
 
 	AddressList variable_addresses;
@@ -934,7 +1081,7 @@ public:
 		return success;
 	}
 
-	Variant Result() const { return R; }
+	Variant& Result() { return R; }
 
 private:
 	Variant R, L;
@@ -946,7 +1093,8 @@ private:
 
 	bool Execute(const Instruction instruction, const Variant& data, size_t& next_instruction)
 	{
-		auto AnyString = [](const Variant& v1, const Variant& v2) { return v1.GetType() == Variant::STRING || v2.GetType() == Variant::STRING; };
+		if (EvaluateOperator(instruction, L, R))
+			return true;
 
 		switch (instruction)
 		{
@@ -965,8 +1113,8 @@ private:
 			switch (reg)
 			{
 				// clang-format off
-			case Register::R:  R = stack.back(); stack.pop_back(); break;
-			case Register::L:  L = stack.back(); stack.pop_back(); break;
+			case Register::R:  R = std::move(stack.back()); stack.pop_back(); break;
+			case Register::L:  L = std::move(stack.back()); stack.pop_back(); break;
 				// clang-format on
 			default: return Error(CreateString("Invalid register %d.", int(reg)));
 			}
@@ -979,56 +1127,25 @@ private:
 		break;
 		case Instruction::DynamicVariable:
 		{
-			auto str = R.Get<String>();
-			auto address = expression_interface.ParseAddress(str);
+			auto address = expression_interface.ParseAddress(R.GetType() == Variant::STRING ? R.GetReference<String>() : R.Get<String>());
 			if (address.empty())
 				return Error("Variable address not found.");
-			R = expression_interface.GetValue(address);
+			expression_interface.GetValue(address, R);
 		}
 		break;
 		case Instruction::Variable:
 		{
 			size_t variable_index = size_t(data.Get<int>(-1));
 			if (variable_index < addresses.size())
-				R = expression_interface.GetValue(addresses[variable_index]);
+				expression_interface.GetValue(addresses[variable_index], R);
 			else
 				return Error("Variable address not found.");
 		}
 		break;
-		case Instruction::Add:
+		case Instruction::MoveToL:
 		{
-			if (AnyString(L, R))
-				R = Variant(L.Get<String>() + R.Get<String>());
-			else
-				R = Variant(L.Get<double>() + R.Get<double>());
-		}
-		break;
-			// clang-format off
-		case Instruction::Subtract:  R = Variant(L.Get<double>() - R.Get<double>());  break;
-		case Instruction::Multiply:  R = Variant(L.Get<double>() * R.Get<double>());  break;
-		case Instruction::Divide:    R = Variant(L.Get<double>() / R.Get<double>());  break;
-		case Instruction::Not:       R = Variant(!R.Get<bool>());                     break;
-		case Instruction::And:       R = Variant(L.Get<bool>() && R.Get<bool>());     break;
-		case Instruction::Or:        R = Variant(L.Get<bool>() || R.Get<bool>());     break;
-		case Instruction::Less:      R = Variant(L.Get<double>() < R.Get<double>());  break;
-		case Instruction::LessEq:    R = Variant(L.Get<double>() <= R.Get<double>()); break;
-		case Instruction::Greater:   R = Variant(L.Get<double>() > R.Get<double>());  break;
-		case Instruction::GreaterEq: R = Variant(L.Get<double>() >= R.Get<double>()); break;
-			// clang-format on
-		case Instruction::Equal:
-		{
-			if (AnyString(L, R))
-				R = Variant(L.Get<String>() == R.Get<String>());
-			else
-				R = Variant(L.Get<double>() == R.Get<double>());
-		}
-		break;
-		case Instruction::NotEqual:
-		{
-			if (AnyString(L, R))
-				R = Variant(L.Get<String>() != R.Get<String>());
-			else
-				R = Variant(L.Get<double>() != R.Get<double>());
+			L = std::move(R);
+			R.Clear();
 		}
 		break;
 		case Instruction::NumArguments:
@@ -1044,7 +1161,8 @@ private:
 			if (!ExtractArgumentsFromStack(arguments))
 				return false;
 
-			const String function_name = data.Get<String>();
+			RMLUI_ASSERT(data.GetType() == Variant::STRING);
+			const String& function_name = data.GetReference<String>();
 			const bool result = (instruction == Instruction::TransformFnc ? expression_interface.CallTransform(function_name, arguments, R)
 																		  : expression_interface.EventCallback(function_name, arguments));
 			if (!result)
@@ -1133,15 +1251,56 @@ bool DataExpression::Parse(const DataExpressionInterface& expression_interface,
 
 bool DataExpression::Run(const DataExpressionInterface& expression_interface, Variant& out_value)
 {
+	DataModelStatistics* statistics = expression_interface.GetStatistics();
+	const double t_begin = (statistics ? DataModel::GetProfilingTime() : 0.0);
+
 	DataInterpreter interpreter(program, addresses, expression_interface);
+	const bool success = interpreter.Run();
 
-	if (!interpreter.Run())
+	if (statistics)
+	{
+		statistics->num_expression_runs += 1;
+		statistics->expression_time += DataModel::GetProfilingTime() - t_begin;
+	}
+
+	if (!success)
 		return false;
 
-	out_value = interpreter.Result();
+	out_value = std::move(interpreter.Result());
 	return true;
 }
 
+bool DataExpression::Run(const DataExpressionInterface& expression_interface, String& out_string)
+{
+	if (program.size() == 1 && program[0].instruction == Instruction::Variable)
+	{
+		const size_t variable_index = size_t(program[0].data.Get<int>(-1));
+		if (variable_index < addresses.size())
+		{
+			if (DataModelStatistics* statistics = expression_interface.GetStatistics())
+				statistics->num_expression_runs += 1;
+			expression_interface.GetString(addresses[variable_index], out_string);
+			return true;
+		}
+	}
+
+	Variant variant;
+	if (!Run(expression_interface, variant))
+		return false;
+
+	out_string = variant.Get<String>();
+	return true;
+}
+
+// The index alias of keyed data-for rows is a literal referring to the row, which changes along with the row's array. Thus, the array name
+// follows the row reference, and the literal depends on the array.
+static const String& GetDependencyName(const DataAddress& address)
+{
+	if (address.size() > 3 && address[0].name == "literal")
+		return address[3].name;
+	return address[0].name;
+}
+
 StringList DataExpression::GetVariableNameList() const
 {
 	StringList list;
@@ -1149,7 +1308,23 @@ StringList DataExpression::GetVariableNameList() const
 	for (const DataAddress& address : addresses)
 	{
 		if (!address.empty())
-			list.push_back(address[0].name);
+			list.push_back(GetDependencyName(address));
+	}
+	return list;
+}
+
+DataVariableDependencyList DataExpression::GetVariableDependencyList() const
+{
+	DataVariableDependencyList list;
+	list.reserve(addresses.size());
+	for (const DataAddress& address : addresses)
+	{
+		if (address.empty())
+			continue;
+
+		// Addresses are resolved through any aliases during parsing, thus eg. 'it.name' inside a data-for loop is seen here as 'array[i].name'.
+		const bool is_array_element = (address.size() >= 2 && address[1].name.empty() && address[1].index >= 0);
+		list.push_back(DataVariableDependency{GetDependencyName(address), is_array_element ? address[1].index : -1});
 	}
 	return list;
 }
@@ -1165,21 +1340,41 @@ DataAddress DataExpressionInterface::ParseAddress(const String& address_str) con
 
 	return data_model ? data_model->ResolveAddress(address_str, element) : DataAddress();
 }
-Variant DataExpressionInterface::GetValue(const DataAddress& address) const
+void DataExpressionInterface::GetValue(const DataAddress& address, Variant& out_value) const
 {
-	Variant result;
 	if (event && address.size() == 2 && address.front().name == "ev")
 	{
 		auto& parameters = event->GetParameters();
 		auto it = parameters.find(address.back().name);
 		if (it != parameters.end())
-			result = it->second;
+		{
+			out_value = it->second;
+			return;
+		}
+	}
+	else if (data_model)
+	{
+		if (data_model->GetVariableInto(address, out_value))
+			return;
+	}
+	out_value.Clear();
+}
+
+void DataExpressionInterface::GetString(const DataAddress& address, String& out_string) const
+{
+	if (event && address.size() == 2 && address.front().name == "ev")
+	{
+		Variant variant;
+		GetValue(address, variant);
+		out_string = variant.Get<String>();
+		return;
 	}
 	else if (data_model)
 	{
-		data_model->GetVariableInto(address, result);
+		if (data_model->GetVariableInto(address, out_string))
+			return;
 	}
-	return result;
+	out_string.clear();
 }
 
 bool DataExpressionInterface::SetValue(const DataAddress& address, const Variant& value) const
@@ -1215,4 +1410,9 @@ bool DataExpressionInterface::EventCallback(const String& name, const VariantLis
 	return true;
 }
 
+DataModelStatistics* DataExpressionInterface::GetStatistics() const
+{
+	return data_model ? data_model->GetStatistics() : nullptr;
+}
+
 } // namespace Rml
@@ -8,6 +8,7 @@ namespace Rml {
 
 class Element;
 class DataModel;
+struct DataModelStatistics;
 struct InstructionData;
 using Program = Vector<InstructionData>;
 using AddressList = Vector<DataAddress>;
@@ -18,10 +19,15 @@ public:
 	DataExpressionInterface(DataModel* data_model, Element* element, Event* event = nullptr);
 
 	DataAddress ParseAddress(const String& address_str) const;
-	Variant GetValue(const DataAddress& address) const;
+	// Retrieves the value at the given address, or clears the output value if it cannot be found.
+	void GetValue(const DataAddress& address, Variant& out_value) const;
+	// Retrieves the value at the given address converted to a string, or clears the output string if it cannot be found.
+	void GetString(const DataAddress& address, String& out_string) const;
 	bool SetValue(const DataAddress& address, const Variant& value) const;
 	bool CallTransform(const String& name, const VariantList& arguments, Variant& out_result);
 	bool EventCallback(const String& name, const VariantList& arguments);
+	// Returns the statistics of the data model while it is being profiled, otherwise nullptr.
+	DataModelStatistics* GetStatistics() const;
 
 private:
 	DataModel* data_model = nullptr;
@@ -37,9 +43,12 @@ public:
 	bool Parse(const DataExpressionInterface& expression_interface, bool is_assignment_expression);
 
 	bool Run(const DataExpressionInterface& expression_interface, Variant& out_value);
+	// Runs the expression and converts the result to a string. Expressions that only read a variable retrieve it as a string directly.
+	bool Run(const DataExpressionInterface& expression_interface, String& out_string);
 
 	// Available after Parse()
 	StringList GetVariableNameList() const;
+	DataVariableDependencyList GetVariableDependencyList() const;
 
 private:
 	String expression;
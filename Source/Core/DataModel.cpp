@@ -1,8 +1,10 @@
 #include "DataModel.h"
 #include "../../Include/RmlUi/Core/DataTypeRegister.h"
 #include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
 #include "DataController.h"
 #include "DataView.h"
+#include <chrono>
 
 namespace Rml {
 
@@ -73,6 +75,12 @@ static const char* LegalVariableName(const String& name)
 	return nullptr;
 }
 
+// Row references are stored in place of an array index, encoded as negative numbers below the index of named entries.
+static bool IsRowReference(const DataAddressEntry& entry)
+{
+	return entry.index < -1;
+}
+
 static String DataAddressToString(const DataAddress& address)
 {
 	String result;
@@ -81,6 +89,8 @@ static String DataAddressToString(const DataAddress& address)
 	{
 		if (entry.index >= 0)
 			result += '[' + ToString(entry.index) + ']';
+		else if (IsRowReference(entry))
+			result += "[row " + ToString(-2 - entry.index) + ']';
 		else
 		{
 			if (!is_first)
@@ -113,6 +123,16 @@ void DataModel::AddController(DataControllerPtr controller)
 	controllers->Add(std::move(controller));
 }
 
+void DataModel::QueueControllerUpdate(DataController* controller)
+{
+	controllers->QueueUpdate(controller);
+}
+
+void DataModel::UpdateControllers()
+{
+	controllers->Update(*this);
+}
+
 bool DataModel::BindVariable(const String& name, DataVariable variable)
 {
 	const char* name_error_str = LegalVariableName(name);
@@ -203,6 +223,21 @@ bool DataModel::InsertAlias(Element* element, const String& alias_name, DataAddr
 
 bool DataModel::EraseAliases(Element* element)
 {
+	auto it = element_row_references.find(element);
+	if (it != element_row_references.end())
+	{
+		ReleaseRowReference(it->second);
+		element_row_references.erase(it);
+	}
+
+	auto it_copied = copied_row_references.find(element);
+	if (it_copied != copied_row_references.end())
+	{
+		for (int reference : it_copied->second)
+			ReleaseRowReference(reference);
+		copied_row_references.erase(it_copied);
+	}
+
 	return aliases.erase(element) == 1;
 }
 
@@ -216,14 +251,102 @@ void DataModel::CopyAliases(Element* from_element, Element* to_element)
 	{
 		// Need to create a copy to prevent errors during concurrent modification for 3rd party containers
 		auto copy = existing_map->second;
+
+		// The copied aliases may refer to the row references of the source element, keep them alive while the target element uses them.
+		AcquireRowReferences(to_element, copy);
+
 		for (auto const& it : copy)
 			aliases[to_element][it.first] = std::move(it.second);
 	}
 }
 
+void DataModel::AcquireRowReferences(Element* element, const SmallUnorderedMap<String, DataAddress>& element_aliases)
+{
+	Vector<int> references;
+	for (const auto& name_address : element_aliases)
+	{
+		for (const DataAddressEntry& entry : name_address.second)
+		{
+			if (IsRowReference(entry))
+			{
+				const int reference = -2 - entry.index;
+				row_reference_counts[reference] += 1;
+				references.push_back(reference);
+			}
+		}
+	}
+
+	// Release any references acquired by earlier copies after acquiring the new ones, as the same references may be copied again.
+	Vector<int>& previous_references = copied_row_references[element];
+	for (int reference : previous_references)
+		ReleaseRowReference(reference);
+	previous_references = std::move(references);
+
+	if (previous_references.empty())
+		copied_row_references.erase(element);
+}
+
+void DataModel::ReleaseRowReference(int reference)
+{
+	RMLUI_ASSERT(reference >= 0 && reference < (int)row_reference_counts.size() && row_reference_counts[reference] > 0);
+
+	row_reference_counts[reference] -= 1;
+	if (row_reference_counts[reference] == 0)
+	{
+		row_indices[reference] = -1;
+		free_row_references.push_back(reference);
+	}
+}
+
+DataAddressEntry DataModel::CreateRowReference(Element* element, int index)
+{
+	RMLUI_ASSERT(element && index >= 0);
+	RMLUI_ASSERTMSG(element_row_references.count(element) == 0, "Only a single row reference can be owned by each element.");
+
+	int reference = 0;
+	if (!free_row_references.empty())
+	{
+		reference = free_row_references.back();
+		free_row_references.pop_back();
+		row_indices[reference] = index;
+		row_reference_counts[reference] = 1;
+	}
+	else
+	{
+		reference = (int)row_indices.size();
+		row_indices.push_back(index);
+		row_reference_counts.push_back(1);
+	}
+
+	element_row_references.emplace(element, reference);
+	return DataAddressEntry(-2 - reference);
+}
+
+void DataModel::SetRowIndex(Element* element, int index)
+{
+	auto it = element_row_references.find(element);
+	RMLUI_ASSERT(it != element_row_references.end() && index >= 0);
+	row_indices[it->second] = index;
+}
+
+const DataAddress& DataModel::ParseAddressCached(const String& address_str) const
+{
+	// Dynamic variables can construct arbitrary address strings during expression evaluation, limit the cache to avoid unbounded growth.
+	static constexpr size_t max_parsed_addresses = 4096;
+
+	auto it = parsed_addresses.find(address_str);
+	if (it != parsed_addresses.end())
+		return it->second;
+
+	if (parsed_addresses.size() >= max_parsed_addresses)
+		parsed_addresses.clear();
+
+	return parsed_addresses.emplace(address_str, ParseAddress(address_str)).first->second;
+}
+
 DataAddress DataModel::ResolveAddress(const String& address_str, Element* element) const
 {
-	DataAddress address = ParseAddress(address_str);
+	DataAddress address = ParseAddressCached(address_str);
 
 	if (address.empty())
 		return address;
@@ -280,7 +403,8 @@ DataVariable DataModel::GetVariable(const DataAddress& address) const
 
 		for (int i = 1; i < (int)address.size() && variable; i++)
 		{
-			variable = variable.Child(address[i]);
+			const DataAddressEntry& entry = address[i];
+			variable = (IsRowReference(entry) ? variable.Child(DataAddressEntry(row_indices[-2 - entry.index])) : variable.Child(entry));
 			if (!variable)
 				return DataVariable();
 		}
@@ -291,7 +415,10 @@ DataVariable DataModel::GetVariable(const DataAddress& address) const
 	if (address[0].name == "literal")
 	{
 		if (address.size() > 2 && address[1].name == "int")
-			return MakeLiteralIntVariable(address[2].index);
+		{
+			const DataAddressEntry& entry = address[2];
+			return MakeLiteralIntVariable(IsRowReference(entry) ? row_indices[-2 - entry.index] : entry.index);
+		}
 	}
 
 	return DataVariable();
@@ -318,6 +445,15 @@ bool DataModel::GetVariableInto(const DataAddress& address, Variant& out_value)
 	return result;
 }
 
+bool DataModel::GetVariableInto(const DataAddress& address, String& out_string) const
+{
+	DataVariable variable = GetVariable(address);
+	bool result = (variable && variable.GetString(out_string));
+	if (!result)
+		Log::Message(Log::LT_WARNING, "Could not get value from data variable '%s'.", DataAddressToString(address).c_str());
+	return result;
+}
+
 void DataModel::DirtyVariable(const String& variable_name)
 {
 	RMLUI_ASSERTMSG(LegalVariableName(variable_name) == nullptr, "Illegal variable name provided. Only top-level variables can be dirtied.");
@@ -325,6 +461,19 @@ void DataModel::DirtyVariable(const String& variable_name)
 	dirty_variables.emplace(variable_name);
 }
 
+void DataModel::DirtyVariable(const String& variable_name, int index)
+{
+	if (index < 0)
+	{
+		DirtyVariable(variable_name);
+		return;
+	}
+
+	RMLUI_ASSERTMSG(LegalVariableName(variable_name) == nullptr, "Illegal variable name provided. Only top-level variables can be dirtied.");
+	RMLUI_ASSERTMSG(variables.count(variable_name) == 1, "In DirtyVariable: Variable name not found among added variables.");
+	dirty_variable_indices[variable_name].emplace(index);
+}
+
 bool DataModel::IsVariableDirty(const String& variable_name) const
 {
 	RMLUI_ASSERTMSG(LegalVariableName(variable_name) == nullptr, "Illegal variable name provided. Only top-level variables can be dirtied.");
@@ -340,6 +489,141 @@ void DataModel::DirtyAllVariables()
 	}
 }
 
+void DataModel::WatchVariable(const String& variable_name)
+{
+	auto it = variables.find(variable_name);
+	if (it == variables.end())
+	{
+		Log::Message(Log::LT_WARNING, "Could not watch data variable '%s', no such variable found.", variable_name.c_str());
+		return;
+	}
+
+	for (const WatchedVariable& watched : watched_variables)
+	{
+		if (watched.name == variable_name)
+			return;
+	}
+
+	// Store the current values, so that the variable is only dirtied once it changes.
+	watched_variables.push_back(WatchedVariable{variable_name, it->second, {}, {}});
+	WatchedVariable& watched = watched_variables.back();
+	if (watched.variable.Type() == DataVariableType::Array)
+	{
+		watched.element_values.resize(watched.variable.Size());
+		for (int i = 0; i < (int)watched.element_values.size(); i++)
+			UpdateWatchedValues(watched.variable.Child(DataAddressEntry(i)), watched.element_values[i]);
+	}
+	else
+	{
+		UpdateWatchedValues(watched.variable, watched.values);
+	}
+}
+
+bool DataModel::UpdateWatchedValues(const DataVariable& variable, Vector<Variant>& values)
+{
+	size_t index = 0;
+	bool changed = false;
+	UpdateWatchedValuesRecursive(variable, values, index, changed);
+
+	if (index != values.size())
+	{
+		values.resize(index);
+		changed = true;
+	}
+	return changed;
+}
+
+void DataModel::UpdateWatchedValuesRecursive(const DataVariable& variable, Vector<Variant>& values, size_t& index, bool& changed)
+{
+	auto UpdateValue = [&](Variant&& value) {
+		if (index >= values.size())
+		{
+			values.push_back(std::move(value));
+			changed = true;
+		}
+		else if (values[index] != value)
+		{
+			values[index] = std::move(value);
+			changed = true;
+		}
+		index++;
+	};
+
+	// Invalid variables, such as members of a null pointer, are compared as empty values.
+	if (!variable)
+	{
+		UpdateValue(Variant());
+		return;
+	}
+
+	switch (variable.Type())
+	{
+	case DataVariableType::Scalar:
+	{
+		Variant value;
+		variable.Get(value);
+		UpdateValue(std::move(value));
+	}
+	break;
+	case DataVariableType::Array:
+	{
+		const int size = variable.Size();
+		UpdateValue(Variant(size));
+		for (int i = 0; i < size; i++)
+			UpdateWatchedValuesRecursive(variable.Child(DataAddressEntry(i)), values, index, changed);
+	}
+	break;
+	case DataVariableType::Struct:
+	{
+		VariableDefinition* definition = Detail::DataVariableAccessor::GetDefinition(variable);
+		auto it = watched_struct_members.find(definition);
+		if (it == watched_struct_members.end())
+		{
+			Vector<DataAddressEntry> members;
+			for (String& name : definition->ReflectMemberNames())
+				members.emplace_back(std::move(name));
+			it = watched_struct_members.emplace(definition, std::move(members)).first;
+		}
+
+		for (const DataAddressEntry& member : it->second)
+			UpdateWatchedValuesRecursive(variable.Child(member), values, index, changed);
+	}
+	break;
+	}
+}
+
+void DataModel::UpdateWatchedVariables()
+{
+	for (WatchedVariable& watched : watched_variables)
+	{
+		if (watched.variable.Type() != DataVariableType::Array)
+		{
+			if (UpdateWatchedValues(watched.variable, watched.values))
+				DirtyVariable(watched.name);
+			continue;
+		}
+
+		// Changes to the size of arrays may shift their elements, thus dirty the whole array then.
+		const int size = watched.variable.Size();
+		const bool size_changed = (size != (int)watched.element_values.size());
+		watched.element_values.resize(size);
+
+		for (int i = 0; i < size; i++)
+		{
+			if (UpdateWatchedValues(watched.variable.Child(DataAddressEntry(i)), watched.element_values[i]) && !size_changed)
+				DirtyVariable(watched.name, i);
+		}
+
+		if (size_changed)
+			DirtyVariable(watched.name);
+	}
+}
+
+void DataModel::DirtyViews(Element* element)
+{
+	views->DirtyViews(element);
+}
+
 bool DataModel::CallTransform(const String& name, const VariantList& arguments, Variant& out_result) const
 {
 	if (const auto transform_register = data_type_register->GetTransformFuncRegister())
@@ -365,14 +649,63 @@ void DataModel::OnElementRemove(Element* element)
 	attached_elements.erase(element);
 }
 
+int DataModel::GetNumViews() const
+{
+	return views->GetNumViews();
+}
+
 bool DataModel::Update(bool clear_dirty_variables)
 {
-	const bool result = views->Update(*this, dirty_variables);
+	RMLUI_ZoneScoped;
+	const double t_begin = (statistics ? GetProfilingTime() : 0.0);
+
+	controllers->Update(*this);
+	UpdateWatchedVariables();
+
+	if (statistics)
+	{
+		statistics->num_updates += 1;
+		statistics->num_dirty_variables += int(dirty_variables.size());
+		for (const auto& name_indices : dirty_variable_indices)
+			statistics->num_dirty_variables += int(name_indices.second.size());
+	}
+
+	const bool result = views->Update(*this, dirty_variables, dirty_variable_indices);
 
 	if (clear_dirty_variables)
+	{
 		dirty_variables.clear();
+		dirty_variable_indices.clear();
+	}
+
+	if (statistics)
+		statistics->update_time += GetProfilingTime() - t_begin;
+
+	return result;
+}
 
+void DataModel::SetProfiling(bool enable)
+{
+	if (!enable)
+		statistics.reset();
+	else if (!statistics)
+		statistics = MakeUnique<DataModelStatistics>();
+}
+
+DataModelStatistics DataModel::TakeStatistics()
+{
+	if (!statistics)
+		return DataModelStatistics();
+
+	DataModelStatistics result = std::move(*statistics);
+	*statistics = DataModelStatistics();
 	return result;
 }
 
+double DataModel::GetProfilingTime()
+{
+	using namespace std::chrono;
+	return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
 } // namespace Rml
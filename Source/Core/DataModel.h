@@ -2,6 +2,7 @@
 
 #include "../../Include/RmlUi/Core/DataModelHandle.h"
 #include "../../Include/RmlUi/Core/DataTypes.h"
+#include "../../Include/RmlUi/Core/FrameStatistics.h"
 #include "../../Include/RmlUi/Core/Header.h"
 #include "../../Include/RmlUi/Core/Traits.h"
 #include "../../Include/RmlUi/Core/Types.h"
@@ -21,6 +22,10 @@ public:
 
 	void AddView(DataViewPtr view);
 	void AddController(DataControllerPtr controller);
+	// Queues the controller to be updated at the start of the next model update, such as to set a variable once to its latest value.
+	void QueueControllerUpdate(DataController* controller);
+	// Updates the queued controllers right away, so that their variables are up to date.
+	void UpdateControllers();
 
 	bool BindVariable(const String& name, DataVariable variable);
 	bool BindFunc(const String& name, DataGetFunc get_func, DataSetFunc set_func);
@@ -31,15 +36,27 @@ public:
 	bool EraseAliases(Element* element);
 	void CopyAliases(Element* source_element, Element* target_element);
 
+	// Creates a reference to the array index of a row owned by the element, which can take the place of the index in addresses. Then the row
+	// can be moved to another index without resolving the addresses again. The reference is released when the element's aliases are erased,
+	// and when the aliases of all elements they were copied to are erased.
+	DataAddressEntry CreateRowReference(Element* element, int index);
+	void SetRowIndex(Element* element, int index);
+
 	DataAddress ResolveAddress(const String& address_str, Element* element) const;
 	const DataEventFunc* GetEventCallback(const String& name);
 
 	DataVariable GetVariable(const DataAddress& address) const;
 	bool GetVariableInto(const DataAddress& address, Variant& out_value) const;
+	bool GetVariableInto(const DataAddress& address, String& out_string) const;
 
 	void DirtyVariable(const String& variable_name);
+	void DirtyVariable(const String& variable_name, int index);
 	bool IsVariableDirty(const String& variable_name) const;
 	void DirtyAllVariables();
+	// Compares the values of the variable during each update, and dirties it when they change.
+	void WatchVariable(const String& variable_name);
+	// Updates the views attached to the element during the next update, even if none of their variables changed.
+	void DirtyViews(Element* element);
 
 	bool CallTransform(const String& name, const VariantList& arguments, Variant& out_result) const;
 
@@ -53,13 +70,44 @@ public:
 
 	DataTypeRegister* GetDataTypeRegister() const { return data_type_register; }
 	const UnorderedMap<String, DataVariable>& GetAllVariables() const { return variables; }
+	int GetNumViews() const;
+
+	// Low-priority models are updated after the other models, and deferred while the update budget of the context is exceeded.
+	void SetLowPriority(bool low_priority) { this->low_priority = low_priority; }
+	bool IsLowPriority() const { return low_priority; }
+
+	// Enables or disables recording the work performed by the model.
+	void SetProfiling(bool enable);
+	// Returns the counters since they were last taken while profiling, otherwise nullptr.
+	DataModelStatistics* GetStatistics() const { return statistics.get(); }
+	// Returns the counters since they were last taken, and resets them.
+	DataModelStatistics TakeStatistics();
+	// Returns a high-resolution time in seconds, used for measuring the duration of updates while profiling.
+	static double GetProfilingTime();
 
 private:
+	// Returns the parsed address of the given string, parsing is done once for each unique address string.
+	const DataAddress& ParseAddressCached(const String& address_str) const;
+
+	struct WatchedVariable {
+		String name;
+		DataVariable variable;
+		// The flattened scalar values and array sizes from the previous update, stored by element for array variables.
+		Vector<Variant> values;
+		Vector<Vector<Variant>> element_values;
+	};
+
+	// Stores the current values of the variable, returns true if they are different from the given values.
+	bool UpdateWatchedValues(const DataVariable& variable, Vector<Variant>& values);
+	void UpdateWatchedValuesRecursive(const DataVariable& variable, Vector<Variant>& values, size_t& index, bool& changed);
+	void UpdateWatchedVariables();
+
 	UniquePtr<DataViews> views;
 	UniquePtr<DataControllers> controllers;
 
 	UnorderedMap<String, DataVariable> variables;
 	DirtyVariables dirty_variables;
+	DirtyVariableIndices dirty_variable_indices;
 
 	UnorderedMap<String, UniquePtr<FuncDefinition>> function_variable_definitions;
 	UnorderedMap<String, DataEventFunc> event_callbacks;
@@ -67,9 +115,31 @@ private:
 	using ScopedAliases = UnorderedMap<Element*, SmallUnorderedMap<String, DataAddress>>;
 	ScopedAliases aliases;
 
+	void AcquireRowReferences(Element* element, const SmallUnorderedMap<String, DataAddress>& element_aliases);
+	void ReleaseRowReference(int reference);
+
+	// The array index of each row reference, or -1 for released references.
+	Vector<int> row_indices;
+	// The number of elements holding each row reference, either as its owner or through copied aliases.
+	Vector<int> row_reference_counts;
+	Vector<int> free_row_references;
+	UnorderedMap<Element*, int> element_row_references;
+	UnorderedMap<Element*, Vector<int>> copied_row_references;
+
+	// Parsed addresses before any alias resolution, which only depends on the address string.
+	mutable UnorderedMap<String, DataAddress> parsed_addresses;
+
+	Vector<WatchedVariable> watched_variables;
+	// Addresses of the members of watched struct types, by their definition.
+	UnorderedMap<VariableDefinition*, Vector<DataAddressEntry>> watched_struct_members;
+
 	DataTypeRegister* data_type_register;
 
 	SmallUnorderedSet<Element*> attached_elements;
+
+	bool low_priority = false;
+
+	UniquePtr<DataModelStatistics> statistics;
 };
 
 } // namespace Rml
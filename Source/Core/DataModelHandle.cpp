@@ -15,11 +15,26 @@ void DataModelHandle::DirtyVariable(const String& variable_name)
 	model->DirtyVariable(variable_name);
 }
 
+void DataModelHandle::DirtyVariable(const String& variable_name, int index)
+{
+	model->DirtyVariable(variable_name, index);
+}
+
 void DataModelHandle::DirtyAllVariables()
 {
 	model->DirtyAllVariables();
 }
 
+void DataModelHandle::WatchVariable(const String& variable_name)
+{
+	model->WatchVariable(variable_name);
+}
+
+void DataModelHandle::SetLowPriority(bool low_priority)
+{
+	model->SetLowPriority(low_priority);
+}
+
 DataModelConstructor::DataModelConstructor() : model(nullptr), type_register(nullptr) {}
 
 DataModelConstructor::DataModelConstructor(DataModel* model) : model(model), type_register(model->GetDataTypeRegister())
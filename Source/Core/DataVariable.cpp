@@ -12,6 +12,11 @@ bool DataVariable::Set(const Variant& variant)
 	return definition->Set(ptr, variant);
 }
 
+bool DataVariable::GetString(String& out_string) const
+{
+	return definition->GetString(ptr, out_string);
+}
+
 int DataVariable::Size() const
 {
 	return definition->Size(ptr);
@@ -37,6 +42,14 @@ bool VariableDefinition::Set(void* /*ptr*/, const Variant& /*variant*/)
 	Log::Message(Log::LT_WARNING, "Values can only be assigned to scalar data types.");
 	return false;
 }
+bool VariableDefinition::GetString(void* ptr, String& out_string)
+{
+	Variant variant;
+	if (!Get(ptr, variant))
+		return false;
+	out_string = variant.Get<String>();
+	return true;
+}
 int VariableDefinition::Size(void* /*ptr*/)
 {
 	Log::Message(Log::LT_WARNING, "Tried to get the size from a non-array data type.");
@@ -149,6 +162,13 @@ bool BasePointerDefinition::Set(void* ptr, const Variant& variant)
 	return underlying_definition->Set(DereferencePointer(ptr), variant);
 }
 
+bool BasePointerDefinition::GetString(void* ptr, String& out_string)
+{
+	if (!ptr)
+		return false;
+	return underlying_definition->GetString(DereferencePointer(ptr), out_string);
+}
+
 int BasePointerDefinition::Size(void* ptr)
 {
 	if (!ptr)
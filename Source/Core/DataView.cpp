@@ -1,5 +1,6 @@
 #include "DataView.h"
 #include "../../Include/RmlUi/Core/Element.h"
+#include "DataModel.h"
 #include <algorithm>
 
 namespace Rml {
@@ -14,6 +15,14 @@ Element* DataView::GetElement() const
 	return result;
 }
 
+DataVariableDependencyList DataView::GetVariableDependencyList() const
+{
+	DataVariableDependencyList list;
+	for (String& name : GetVariableNameList())
+		list.push_back(DataVariableDependency{std::move(name), -1});
+	return list;
+}
+
 int DataView::GetSortOrder() const
 {
 	return sort_order;
@@ -46,89 +55,253 @@ void DataViews::Add(DataViewPtr view)
 
 void DataViews::OnElementRemove(Element* element)
 {
-	for (auto it = views.begin(); it != views.end();)
+	auto pair = element_views.equal_range(element);
+	for (auto it = pair.first; it != pair.second; ++it)
+		RemoveView(it->second);
+	element_views.erase(pair.first, pair.second);
+}
+
+void DataViews::DirtyViews(Element* element)
+{
+	auto pair = element_views.equal_range(element);
+	for (auto it = pair.first; it != pair.second; ++it)
+		next_dirty_views.push_back(it->second);
+}
+
+int DataViews::GetVariableId(const String& variable_name)
+{
+	auto result = variable_ids.emplace(variable_name, (int)variable_subscribers.size());
+	if (result.second)
+		variable_subscribers.emplace_back();
+	return result.first->second;
+}
+
+void DataViews::AddSubscribedView(DataViewPtr view, ViewRefList& dirty_views)
+{
+	uint32_t slot = 0;
+	if (!free_slots.empty())
+	{
+		slot = free_slots.back();
+		free_slots.pop_back();
+	}
+	else
+	{
+		slot = (uint32_t)view_slots.size();
+		view_slots.emplace_back();
+	}
+
+	ViewSlot& view_slot = view_slots[slot];
+	const ViewRef ref = {slot, view_slot.generation};
+
+	uint32_t num_view_subscriptions = 0;
+	for (const DataVariableDependency& dependency : view->GetVariableDependencyList())
+	{
+		VariableSubscribers& subscribers = variable_subscribers[GetVariableId(dependency.name)];
+		if (dependency.index < 0)
+			subscribers.views.push_back(ref);
+		else
+			subscribers.index_views[dependency.index].push_back(ref);
+		num_view_subscriptions += 1;
+	}
+	num_subscriptions += num_view_subscriptions;
+
+	if (Element* element = view->GetElement())
+		element_views.emplace(element, ref);
+
+	// Newly added views are always updated.
+	view_slot.dirty = true;
+	view_slot.num_subscriptions = num_view_subscriptions;
+	view_slot.view = std::move(view);
+	dirty_views.push_back(ref);
+}
+
+void DataViews::RemoveView(ViewRef ref)
+{
+	RMLUI_ASSERT(ref.slot < view_slots.size());
+	ViewSlot& view_slot = view_slots[ref.slot];
+	if (view_slot.generation != ref.generation || !view_slot.view)
+		return;
+
+	// Keep the view alive until the end of the current update, it may already be queued for update.
+	views_to_remove.push_back(std::move(view_slot.view));
+	view_slot.generation += 1;
+	view_slot.dirty = false;
+	free_slots.push_back(ref.slot);
+
+	num_stale_subscriptions += view_slot.num_subscriptions;
+	view_slot.num_subscriptions = 0;
+}
+
+void DataViews::CollectDirtyViews(ViewRefList& refs, ViewRefList& dirty_views)
+{
+	for (size_t i = 0; i < refs.size();)
+	{
+		const ViewRef ref = refs[i];
+		ViewSlot& view_slot = view_slots[ref.slot];
+		if (view_slot.generation != ref.generation)
+		{
+			refs[i] = refs.back();
+			refs.pop_back();
+			num_stale_subscriptions -= 1;
+			num_subscriptions -= 1;
+			continue;
+		}
+
+		if (!view_slot.dirty)
+		{
+			view_slot.dirty = true;
+			dirty_views.push_back(ref);
+		}
+		i += 1;
+	}
+}
+
+void DataViews::PruneSubscriptions()
+{
+	auto IsStale = [this](const ViewRef& ref) { return view_slots[ref.slot].generation != ref.generation; };
+
+	for (VariableSubscribers& subscribers : variable_subscribers)
 	{
-		auto& view = *it;
-		if (view && view->GetElement() == element)
+		subscribers.views.erase(std::remove_if(subscribers.views.begin(), subscribers.views.end(), IsStale), subscribers.views.end());
+
+		for (auto it = subscribers.index_views.begin(); it != subscribers.index_views.end();)
 		{
-			views_to_remove.push_back(std::move(view));
-			it = views.erase(it);
+			ViewRefList& refs = it->second;
+			refs.erase(std::remove_if(refs.begin(), refs.end(), IsStale), refs.end());
+			if (refs.empty())
+				it = subscribers.index_views.erase(it);
+			else
+				++it;
 		}
+	}
+
+	for (auto it = element_views.begin(); it != element_views.end();)
+	{
+		if (IsStale(it->second))
+			it = element_views.erase(it);
 		else
 			++it;
 	}
+
+	num_subscriptions -= num_stale_subscriptions;
+	num_stale_subscriptions = 0;
 }
 
-bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables)
+bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables, const DirtyVariableIndices& dirty_variable_indices)
 {
 	bool result = false;
 	size_t num_dirty_variables_prev = 0;
+	size_t num_dirty_variable_indices_prev = 0;
+
+	auto CountDirtyVariableIndices = [&]() {
+		size_t count = 0;
+		for (const auto& name_indices : dirty_variable_indices)
+			count += name_indices.second.size();
+		return count;
+	};
+
+	ViewRefList dirty_views;
+	ViewRefList explicitly_dirty_views = std::move(next_dirty_views);
+	next_dirty_views.clear();
 
 	// View updates may result in newly added views, or even new dirty variables. Thus, we do the
 	// update recursively but with an upper limit. Without the loop, newly added views won't be
 	// updated until the next Update() call.
-	for (int i = 0; (i == 0 || !views_to_add.empty() || num_dirty_variables_prev != dirty_variables.size()) && i < 10; i++)
+	for (int i = 0; (i == 0 || !views_to_add.empty() || num_dirty_variables_prev != dirty_variables.size() ||
+						num_dirty_variable_indices_prev != CountDirtyVariableIndices()) &&
+		 i < 10;
+		 i++)
 	{
 		num_dirty_variables_prev = dirty_variables.size();
+		num_dirty_variable_indices_prev = CountDirtyVariableIndices();
 
-		Vector<DataView*> dirty_views;
+		dirty_views.clear();
 
 		if (!views_to_add.empty())
 		{
-			views.reserve(views.size() + views_to_add.size());
-			for (auto&& view : views_to_add)
-			{
-				dirty_views.push_back(view.get());
-				for (const String& variable_name : view->GetVariableNameList())
-					name_view_map.emplace(variable_name, view.get());
-
-				views.push_back(std::move(view));
-			}
+			DataViewList adding_views = std::move(views_to_add);
 			views_to_add.clear();
+			for (DataViewPtr& view : adding_views)
+				AddSubscribedView(std::move(view), dirty_views);
 		}
 
-		for (const String& variable_name : dirty_variables)
+		for (const ViewRef& ref : explicitly_dirty_views)
 		{
-			auto pair = name_view_map.equal_range(variable_name);
-			for (auto it = pair.first; it != pair.second; ++it)
-				dirty_views.push_back(it->second);
+			ViewSlot& view_slot = view_slots[ref.slot];
+			if (view_slot.generation == ref.generation && !view_slot.dirty)
+			{
+				view_slot.dirty = true;
+				dirty_views.push_back(ref);
+			}
 		}
+		explicitly_dirty_views.clear();
 
-		// Remove duplicate entries
-		std::sort(dirty_views.begin(), dirty_views.end());
-		auto it_remove = std::unique(dirty_views.begin(), dirty_views.end());
-		dirty_views.erase(it_remove, dirty_views.end());
+		for (const String& variable_name : dirty_variables)
+		{
+			auto it_id = variable_ids.find(variable_name);
+			if (it_id == variable_ids.end())
+				continue;
 
-		// Sort by the element's depth in the document tree so that any structural changes due to a changed variable are reflected in the element's
-		// children. Eg. the 'data-for' view will remove children if any of its data variable array size is reduced.
-		std::sort(dirty_views.begin(), dirty_views.end(), [](auto&& left, auto&& right) { return left->GetSortOrder() < right->GetSortOrder(); });
+			VariableSubscribers& subscribers = variable_subscribers[it_id->second];
+			CollectDirtyViews(subscribers.views, dirty_views);
+			for (auto& index_views : subscribers.index_views)
+				CollectDirtyViews(index_views.second, dirty_views);
+		}
 
-		for (DataView* view : dirty_views)
+		// For dirty array elements, only the views depending on that particular element are updated, in addition to the views depending on
+		// the whole array. The latter includes any 'data-for' views, which will add or remove rows if the array size changed.
+		for (const auto& name_indices : dirty_variable_indices)
 		{
-			RMLUI_ASSERT(view);
-			if (!view)
+			const String& variable_name = name_indices.first;
+			auto it_id = variable_ids.find(variable_name);
+			if (it_id == variable_ids.end() || dirty_variables.count(variable_name))
 				continue;
 
-			if (view->IsValid())
-				result |= view->Update(model);
+			VariableSubscribers& subscribers = variable_subscribers[it_id->second];
+			CollectDirtyViews(subscribers.views, dirty_views);
+			for (int index : name_indices.second)
+			{
+				auto it_index_views = subscribers.index_views.find(index);
+				if (it_index_views != subscribers.index_views.end())
+					CollectDirtyViews(it_index_views->second, dirty_views);
+			}
 		}
 
-		// Destroy views marked for destruction
-		// @performance: Horrible...
-		if (!views_to_remove.empty())
+		// Sort by the element's depth in the document tree so that any structural changes due to a changed variable are reflected in the element's
+		// children. Eg. the 'data-for' view will remove children if any of its data variable array size is reduced. Views are only added once
+		// above thanks to their dirty flag, so this only sorts the changed views.
+		std::sort(dirty_views.begin(), dirty_views.end(), [this](const ViewRef& left, const ViewRef& right) {
+			return view_slots[left.slot].view->GetSortOrder() < view_slots[right.slot].view->GetSortOrder();
+		});
+
+		// New views are only added at the start of each iteration, thus the slots stay in place during the update.
+		for (const ViewRef& ref : dirty_views)
 		{
-			for (const auto& view : views_to_remove)
+			ViewSlot& view_slot = view_slots[ref.slot];
+
+			// Skip views removed by an earlier update in this iteration.
+			if (view_slot.generation != ref.generation)
+				continue;
+
+			view_slot.dirty = false;
+			if (view_slot.view->IsValid())
 			{
-				for (auto it = name_view_map.begin(); it != name_view_map.end();)
+				if (DataModelStatistics* statistics = model.GetStatistics())
 				{
-					if (it->second == view.get())
-						it = name_view_map.erase(it);
-					else
-						++it;
+					statistics->num_view_updates += 1;
+					statistics->view_updates_by_type[view_slot.view->GetTypeName()] += 1;
 				}
+				result |= view_slot.view->Update(model);
 			}
+		}
 
+		// Destroy views marked for destruction
+		if (!views_to_remove.empty())
+		{
 			views_to_remove.clear();
+
+			if (num_stale_subscriptions > 64 && num_stale_subscriptions * 2 > num_subscriptions)
+				PruneSubscriptions();
 		}
 	}
 
@@ -53,6 +53,10 @@ public:
 	// Returns the list of data variable name(s) which can modify this view.
 	virtual StringList GetVariableNameList() const = 0;
 
+	// Returns the list of data variable dependencies, which may be limited to single elements of array variables.
+	// By default, the view depends on each variable in the name list as a whole.
+	virtual DataVariableDependencyList GetVariableDependencyList() const;
+
 	// Returns the attached element if it still exists.
 	Element* GetElement() const;
 
@@ -63,6 +67,9 @@ public:
 	// Returns true if the element still exists.
 	bool IsValid() const;
 
+	// Returns the type name of the view, such as 'if' in 'data-if', when instanced through the factory.
+	const String& GetTypeName() const { return type_name; }
+
 protected:
 	// @param[in] element The element this data view is attached to.
 	// @param[in] sort_offset A number [-1000, 999] specifying the update order of this
@@ -72,6 +79,9 @@ protected:
 private:
 	ObserverPtr<Element> attached_element;
 	int sort_order;
+	String type_name;
+
+	friend class Factory;
 };
 
 class DataViews : NonCopyMoveable {
@@ -83,18 +93,61 @@ public:
 
 	void OnElementRemove(Element* element);
 
-	bool Update(DataModel& model, const DirtyVariables& dirty_variables);
+	// Marks the views attached to the element dirty, they are updated during the next update regardless of their variables.
+	void DirtyViews(Element* element);
+
+	bool Update(DataModel& model, const DirtyVariables& dirty_variables, const DirtyVariableIndices& dirty_variable_indices);
+
+	// Returns the number of views, including views added but not yet initialized by an update.
+	int GetNumViews() const { return int(view_slots.size() - free_slots.size() + views_to_add.size()); }
 
 private:
 	using DataViewList = Vector<DataViewPtr>;
 
-	DataViewList views;
+	// Views are stored in slots which are recycled after removal. References to a slot are invalidated by bumping its generation, thus
+	// views can be removed in constant time while any subscriptions to them are pruned lazily.
+	struct ViewSlot {
+		DataViewPtr view;
+		uint32_t generation = 0;
+		uint32_t num_subscriptions = 0;
+		bool dirty = false;
+	};
+	struct ViewRef {
+		uint32_t slot;
+		uint32_t generation;
+	};
+	using ViewRefList = Vector<ViewRef>;
+
+	struct VariableSubscribers {
+		// Views depending on the variable as a whole.
+		ViewRefList views;
+		// Views depending only on a single element of an array variable, by array index.
+		UnorderedMap<int, ViewRefList> index_views;
+	};
+
+	int GetVariableId(const String& variable_name);
+	void AddSubscribedView(DataViewPtr view, ViewRefList& dirty_views);
+	void RemoveView(ViewRef ref);
+
+	// Adds the referenced views which are still alive to the list of dirty views, pruning any references to removed views.
+	void CollectDirtyViews(ViewRefList& refs, ViewRefList& dirty_views);
+	void PruneSubscriptions();
+
+	Vector<ViewSlot> view_slots;
+	Vector<uint32_t> free_slots;
 
 	DataViewList views_to_add;
 	DataViewList views_to_remove;
+	// Views dirtied explicitly, including ones dirtied during an update which are then updated during the next one.
+	ViewRefList next_dirty_views;
+
+	// Variable names are mapped to dense ids when first subscribed to, which index into the subscriber lists.
+	UnorderedMap<String, int> variable_ids;
+	Vector<VariableSubscribers> variable_subscribers;
+	size_t num_subscriptions = 0;
+	size_t num_stale_subscriptions = 0;
 
-	using NameViewMap = UnorderedMultimap<String, DataView*>;
-	NameViewMap name_view_map;
+	UnorderedMultimap<Element*, ViewRef> element_views;
 };
 
 } // namespace Rml
@@ -1,14 +1,18 @@
 #include "DataViewDefault.h"
+#include "../../Include/RmlUi/Core/Context.h"
 #include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/DataVariable.h"
 #include "../../Include/RmlUi/Core/Element.h"
 #include "../../Include/RmlUi/Core/ElementText.h"
+#include "../../Include/RmlUi/Core/Event.h"
 #include "../../Include/RmlUi/Core/Factory.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
 #include "../../Include/RmlUi/Core/Variant.h"
 #include "DataExpression.h"
 #include "DataModel.h"
+#include "TranslationCache.h"
 #include "XMLParseTools.h"
+#include <algorithm>
 
 namespace Rml {
 
@@ -18,6 +22,14 @@ static constexpr int SortOffset_DataValue = 100;
 //  'data-checked' may need a value attribute already set.
 static constexpr int SortOffset_DataChecked = 110;
 
+// Compares the string representation of the variant to the given string, without copying the variant if it holds a string.
+static bool VariantEqualsString(const Variant& variant, const String& value)
+{
+	if (variant.GetType() == Variant::STRING)
+		return variant.GetReference<String>() == value;
+	return variant.Get<String>() == value;
+}
+
 DataViewCommon::DataViewCommon(Element* element, String override_modifier, int sort_offset) :
 	DataView(element, sort_offset), modifier(std::move(override_modifier))
 {}
@@ -41,6 +53,12 @@ StringList DataViewCommon::GetVariableNameList() const
 	return expression->GetVariableNameList();
 }
 
+DataVariableDependencyList DataViewCommon::GetVariableDependencyList() const
+{
+	RMLUI_ASSERT(expression);
+	return expression->GetVariableDependencyList();
+}
+
 const String& DataViewCommon::GetModifier() const
 {
 	return modifier;
@@ -67,16 +85,15 @@ bool DataViewAttribute::Update(DataModel& model)
 {
 	const String& attribute_name = GetModifier();
 	bool result = false;
-	Variant variant;
+	String value;
 	Element* element = GetElement();
 	DataExpressionInterface expr_interface(&model, element);
 
-	if (element && GetExpression().Run(expr_interface, variant))
+	if (element && GetExpression().Run(expr_interface, value))
 	{
-		const String value = variant.Get<String>();
 		const Variant* attribute = element->GetAttribute(attribute_name);
 
-		if (!attribute || attribute->Get<String>() != value)
+		if (!attribute || !VariantEqualsString(*attribute, value))
 		{
 			element->SetAttribute(attribute_name, value);
 			result = true;
@@ -345,15 +362,15 @@ bool DataViewText::Update(DataModel& model)
 		Element* element = GetElement();
 		DataExpressionInterface expression_interface(&model, element);
 
+		String value;
 		for (DataEntry& entry : data_entries)
 		{
 			RMLUI_ASSERT(entry.data_expression);
-			Variant variant;
-			bool result = entry.data_expression->Run(expression_interface, variant);
-			const String value = variant.Get<String>();
-			if (result && entry.value != value)
+			bool result = entry.data_expression->Run(expression_interface, value);
+			if (result && value != entry.value)
 			{
-				entry.value = value;
+				// Swap so that the string buffers are reused by the following entries and updates.
+				std::swap(entry.value, value);
 				entries_modified = true;
 			}
 		}
@@ -365,8 +382,7 @@ bool DataViewText::Update(DataModel& model)
 		{
 			String new_text = BuildText();
 			String text;
-			if (SystemInterface* system_interface = GetSystemInterface())
-				system_interface->TranslateString(text, new_text);
+			TranslationCache::TranslateString(text, new_text);
 
 			rmlui_static_cast<ElementText*>(element)->SetText(text);
 		}
@@ -395,6 +411,22 @@ StringList DataViewText::GetVariableNameList() const
 	return full_list;
 }
 
+DataVariableDependencyList DataViewText::GetVariableDependencyList() const
+{
+	DataVariableDependencyList full_list;
+	full_list.reserve(data_entries.size());
+
+	for (const DataEntry& entry : data_entries)
+	{
+		RMLUI_ASSERT(entry.data_expression);
+
+		DataVariableDependencyList entry_list = entry.data_expression->GetVariableDependencyList();
+		full_list.insert(full_list.end(), MakeMoveIterator(entry_list.begin()), MakeMoveIterator(entry_list.end()));
+	}
+
+	return full_list;
+}
+
 void DataViewText::Release()
 {
 	delete this;
@@ -485,11 +517,24 @@ bool DataViewFor::Initialize(DataModel& model, Element* element, const String& i
 	attributes.reserve(element_attributes.size() - num_data_for_attributes);
 	for (const auto& attribute : element->GetAttributes())
 	{
-		if (attribute.first == "data-for" || attribute.first == "rmlui-inner-rml")
+		if (attribute.first == "data-for" || attribute.first == "rmlui-inner-rml" || attribute.first == "virtualize" || attribute.first == "key")
 			continue;
 		attributes.emplace(attribute.first, attribute.second);
 	}
 
+	if (const Variant* virtualize_attribute = element->GetAttribute("virtualize"))
+	{
+		constexpr int default_overscan = 4;
+		virtualize = true;
+		overscan = Math::Max(virtualize_attribute->Get<int>(default_overscan), 0);
+	}
+	else if (const Variant* key_attribute = element->GetAttribute("key"))
+	{
+		// Virtualized rows are recreated as they are scrolled into view, thus keys are only used for the rows of non-virtualized views.
+		keyed = true;
+		StringUtilities::ExpandString(key_path, key_attribute->Get<String>(), '.');
+	}
+
 	return true;
 }
 
@@ -501,6 +546,19 @@ bool DataViewFor::Update(DataModel& model)
 
 	bool result = false;
 	const int size = variable.Size();
+
+	if (virtualize)
+	{
+		UpdateVirtualRows(model, size);
+		return result;
+	}
+
+	if (keyed)
+	{
+		UpdateKeyedRows(model, variable, size);
+		return result;
+	}
+
 	const int num_elements = (int)elements.size();
 	Element* element = GetElement();
 
@@ -508,30 +566,12 @@ bool DataViewFor::Update(DataModel& model)
 	{
 		if (i >= num_elements)
 		{
-			ElementPtr new_element_ptr = Factory::InstanceElement(nullptr, element->GetTagName(), element->GetTagName(), attributes);
-
-			DataAddress iterator_address;
-			iterator_address.reserve(container_address.size() + 1);
-			iterator_address = container_address;
-			iterator_address.push_back(DataAddressEntry(i));
-
-			DataAddress iterator_index_address = {{"literal"}, {"int"}, {i}};
-
-			model.InsertAlias(new_element_ptr.get(), iterator_name, std::move(iterator_address));
-			model.InsertAlias(new_element_ptr.get(), iterator_index_name, std::move(iterator_index_address));
-
-			Element* new_element = element->GetParentNode()->InsertBefore(std::move(new_element_ptr), element);
-			elements.push_back(new_element);
-
-			const String* rml_contents = RMLContents();
-			elements[i]->SetInnerRML(rml_contents ? *rml_contents : "");
-
+			elements.push_back(InsertRow(model, i, element));
 			RMLUI_ASSERT(i < (int)elements.size());
 		}
 		if (i >= size)
 		{
-			model.EraseAliases(elements[i]);
-			elements[i]->GetParentNode()->RemoveChild(elements[i]).reset();
+			RemoveRow(model, elements[i]);
 			elements[i] = nullptr;
 		}
 	}
@@ -542,6 +582,254 @@ bool DataViewFor::Update(DataModel& model)
 	return result;
 }
 
+Element* DataViewFor::InsertRow(DataModel& model, int index, Element* before)
+{
+	Element* element = GetElement();
+	ElementPtr new_element_ptr = Factory::InstanceElement(nullptr, element->GetTagName(), element->GetTagName(), attributes);
+
+	const DataAddressEntry index_entry = (keyed ? model.CreateRowReference(new_element_ptr.get(), index) : DataAddressEntry(index));
+
+	DataAddress iterator_address;
+	iterator_address.reserve(container_address.size() + 1);
+	iterator_address = container_address;
+	iterator_address.push_back(index_entry);
+
+	DataAddress iterator_index_address = {{"literal"}, {"int"}, index_entry};
+	if (keyed)
+		iterator_index_address.push_back(container_address.front());
+
+	model.InsertAlias(new_element_ptr.get(), iterator_name, std::move(iterator_address));
+	model.InsertAlias(new_element_ptr.get(), iterator_index_name, std::move(iterator_index_address));
+
+	Element* new_element = before->GetParentNode()->InsertBefore(std::move(new_element_ptr), before);
+
+	if (DataModelStatistics* statistics = model.GetStatistics())
+		statistics->num_for_rows_inserted += 1;
+
+	// All rows share the same contents, parse them once and replay the parse for the following rows.
+	const String* rml_contents = RMLContents();
+	if (rml_contents && !rml_contents->empty())
+		Factory::InstanceElementText(new_element, *rml_contents, row_parse_events);
+
+	return new_element;
+}
+
+void DataViewFor::RemoveRow(DataModel& model, Element* row)
+{
+	model.EraseAliases(row);
+	row->GetParentNode()->RemoveChild(row).reset();
+
+	if (DataModelStatistics* statistics = model.GetStatistics())
+		statistics->num_for_rows_removed += 1;
+}
+
+void DataViewFor::UpdateKeyedRows(DataModel& model, const DataVariable& variable, int size)
+{
+	Element* element = GetElement();
+	Element* parent = element->GetParentNode();
+	const int num_rows = (int)elements.size();
+
+	StringList keys(size);
+	for (int i = 0; i < size; i++)
+		GetRowKey(variable, i, keys[i]);
+
+	// Match the items to the existing rows by key. Each row is matched at most once, any remaining items with the same key get new rows.
+	UnorderedMap<String, int> rows_by_key;
+	rows_by_key.reserve(num_rows);
+	for (int row = 0; row < num_rows; row++)
+		rows_by_key.emplace(row_keys[row], row);
+
+	Vector<int> matched_rows(size, -1);
+	Vector<bool> row_matched(num_rows, false);
+	for (int i = 0; i < size; i++)
+	{
+		auto it = rows_by_key.find(keys[i]);
+		if (it != rows_by_key.end())
+		{
+			matched_rows[i] = it->second;
+			row_matched[it->second] = true;
+			rows_by_key.erase(it);
+		}
+	}
+
+	for (int row = 0; row < num_rows; row++)
+	{
+		if (!row_matched[row])
+			RemoveRow(model, elements[row]);
+	}
+
+	// The rows forming the longest sequence which is already in order stay in place, only the other rows are moved. Find the sequence by
+	// keeping the last item of the best sequence of each length, see patience sorting.
+	Vector<int> sequence_ends;
+	Vector<int> predecessors(size, -1);
+	for (int i = 0; i < size; i++)
+	{
+		const int row = matched_rows[i];
+		if (row < 0)
+			continue;
+
+		auto it = std::lower_bound(sequence_ends.begin(), sequence_ends.end(), row, [&](int item, int value) { return matched_rows[item] < value; });
+		if (it != sequence_ends.begin())
+			predecessors[i] = *(it - 1);
+		if (it == sequence_ends.end())
+			sequence_ends.push_back(i);
+		else
+			*it = i;
+	}
+
+	Vector<bool> in_place(size, false);
+	for (int i = (sequence_ends.empty() ? -1 : sequence_ends.back()); i >= 0; i = predecessors[i])
+		in_place[i] = true;
+
+	// Place the rows from the back, each one in front of the row following it.
+	DataModelStatistics* statistics = model.GetStatistics();
+	ElementList new_elements(size);
+	Element* next = element;
+	for (int i = size - 1; i >= 0; i--)
+	{
+		const int row = matched_rows[i];
+		if (row < 0)
+		{
+			new_elements[i] = InsertRow(model, i, next);
+		}
+		else
+		{
+			Element* row_element = elements[row];
+			if (!in_place[i])
+			{
+				parent->MoveChildBefore(row_element, next);
+				if (statistics)
+					statistics->num_for_rows_moved += 1;
+			}
+
+			// The views of the row depend on the whole array, thus they are already updated along with this view.
+			if (row != i)
+				model.SetRowIndex(row_element, i);
+
+			new_elements[i] = row_element;
+		}
+		next = new_elements[i];
+	}
+
+	elements = std::move(new_elements);
+	row_keys = std::move(keys);
+}
+
+void DataViewFor::GetRowKey(const DataVariable& variable, int index, String& out_key) const
+{
+	DataVariable item = variable.Child(DataAddressEntry(index));
+	for (const String& name : key_path)
+	{
+		if (!item)
+			break;
+		item = item.Child(DataAddressEntry(name));
+	}
+
+	if (!item || !item.GetString(out_key))
+		Log::Message(Log::LT_WARNING, "Could not get the key of row %d in data-for view on element %s", index, GetElement()->GetAddress().c_str());
+}
+
+void DataViewFor::UpdateVirtualRows(DataModel& model, int size)
+{
+	Element* element = GetElement();
+	Element* parent = element->GetParentNode();
+	if (!parent)
+		return;
+
+	if (!top_spacer)
+	{
+		auto InsertSpacer = [&]() {
+			ElementPtr spacer = Factory::InstanceElement(parent, "*", "spacer", XMLAttributes());
+			spacer->SetProperty(PropertyId::Display, Property(Style::Display::Block));
+			spacer->SetProperty(PropertyId::FlexShrink, Property(0.f, Unit::NUMBER));
+			return parent->InsertBefore(std::move(spacer), element);
+		};
+		top_spacer = InsertSpacer();
+		bottom_spacer = InsertSpacer();
+
+		scroll_listener.model = &model;
+		scroll_listener.element = element;
+		parent->AddEventListener(EventId::Scroll, &scroll_listener);
+		scroll_container = parent->GetObserverPtr();
+	}
+
+	// Estimate the row height from the rows laid out so far, new rows are only measured after the next layout.
+	float total_row_height = 0.f;
+	int num_measured_rows = 0;
+	for (Element* row : elements)
+	{
+		const float height = row->GetBox().GetSizeAcross(BoxDirection::Vertical, BoxArea::Margin);
+		if (height > 0.f)
+		{
+			total_row_height += height;
+			num_measured_rows += 1;
+		}
+	}
+	if (num_measured_rows > 0)
+		row_height = total_row_height / float(num_measured_rows);
+
+	const float viewport_height = parent->GetClientHeight();
+	const bool measured = (row_height > 0.f && viewport_height > 0.f);
+
+	// Until the rows and the viewport have been laid out, instantiate a few rows to measure.
+	int new_first_row = 0;
+	int new_last_row = Math::Min(size, 2 * overscan + 1);
+	if (measured)
+	{
+		// The offset of the list from the top of the viewport, negative when scrolled past its start.
+		const float list_offset = top_spacer->GetAbsoluteOffset(BoxArea::Margin).y - parent->GetAbsoluteOffset(BoxArea::Padding).y;
+		const float visible_top = Math::Max(-list_offset, 0.f);
+		const float visible_bottom = Math::Max(viewport_height - list_offset, 0.f);
+
+		new_first_row = Math::Clamp(int(visible_top / row_height) - overscan, 0, size);
+		new_last_row = Math::Clamp(Math::RoundUpToInteger(visible_bottom / row_height) + overscan, new_first_row, size);
+	}
+
+	// Remove the rows which left the range, then add the ones which entered it, keeping the rows in between.
+	while (!elements.empty() && first_row < new_first_row)
+	{
+		RemoveRow(model, elements.front());
+		elements.erase(elements.begin());
+		first_row += 1;
+	}
+	while (!elements.empty() && first_row + (int)elements.size() > new_last_row)
+	{
+		RemoveRow(model, elements.back());
+		elements.pop_back();
+	}
+
+	if (elements.empty())
+		first_row = new_first_row;
+
+	while (first_row > new_first_row)
+	{
+		first_row -= 1;
+		elements.insert(elements.begin(), InsertRow(model, first_row, elements.empty() ? bottom_spacer : elements.front()));
+	}
+	while (first_row + (int)elements.size() < new_last_row)
+		elements.push_back(InsertRow(model, first_row + (int)elements.size(), bottom_spacer));
+
+	// The spacers stand in for the rows outside the range, making the scrollable overflow of the parent cover the whole list.
+	const int num_rows_below = size - first_row - (int)elements.size();
+	top_spacer->SetProperty(PropertyId::Height, Property(float(first_row) * row_height, Unit::PX));
+	bottom_spacer->SetProperty(PropertyId::Height, Property(float(num_rows_below) * row_height, Unit::PX));
+
+	// Measure again after the next layout.
+	if (!measured && size > 0)
+	{
+		model.DirtyViews(element);
+		if (Context* context = element->GetContext())
+			context->RequestNextUpdate(0);
+	}
+}
+
+void DataViewFor::ScrollListener::ProcessEvent(Event& event)
+{
+	// Ignore scroll events bubbling up from scroll containers within the rows.
+	if (event.GetTargetElement() == event.GetCurrentElement())
+		model->DirtyViews(element);
+}
+
 StringList DataViewFor::GetVariableNameList() const
 {
 	RMLUI_ASSERT(!container_address.empty());
@@ -550,6 +838,8 @@ StringList DataViewFor::GetVariableNameList() const
 
 void DataViewFor::Release()
 {
+	if (scroll_container)
+		scroll_container->RemoveEventListener(EventId::Scroll, &scroll_listener);
 	delete this;
 }
 
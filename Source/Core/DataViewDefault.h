@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../../Include/RmlUi/Core/BaseXMLParser.h"
+#include "../../Include/RmlUi/Core/EventListener.h"
 #include "../../Include/RmlUi/Core/Header.h"
 #include "../../Include/RmlUi/Core/Types.h"
 #include "../../Include/RmlUi/Core/Variant.h"
@@ -18,6 +20,7 @@ public:
 	bool Initialize(DataModel& model, Element* element, const String& expression, const String& modifier) override;
 
 	StringList GetVariableNameList() const override;
+	DataVariableDependencyList GetVariableDependencyList() const override;
 
 protected:
 	const String& GetModifier() const;
@@ -104,6 +107,7 @@ public:
 
 	bool Update(DataModel& model) override;
 	StringList GetVariableNameList() const override;
+	DataVariableDependencyList GetVariableDependencyList() const override;
 
 protected:
 	void Release() override;
@@ -121,6 +125,11 @@ private:
 	Vector<DataEntry> data_entries;
 };
 
+/*
+    With the 'virtualize' attribute, only the rows intersecting the viewport of the parent element are instantiated, along with the
+    given number of rows above and below it. The remaining rows are represented by spacer elements, sized by the row height measured
+    from instantiated rows, thus the parent's scrollable overflow covers the full list.
+*/
 class DataViewFor final : public DataView {
 public:
 	DataViewFor(Element* element);
@@ -137,12 +146,45 @@ protected:
 private:
 	const String* RMLContents() const;
 
+	Element* InsertRow(DataModel& model, int index, Element* before);
+	void RemoveRow(DataModel& model, Element* row);
+	void UpdateVirtualRows(DataModel& model, int size);
+	void UpdateKeyedRows(DataModel& model, const DataVariable& variable, int size);
+	void GetRowKey(const DataVariable& variable, int index, String& out_key) const;
+
+	// Updates the virtualized rows when the parent element is scrolled.
+	class ScrollListener final : public EventListener {
+	public:
+		void ProcessEvent(Event& event) override;
+		DataModel* model = nullptr;
+		Element* element = nullptr;
+	};
+
 	DataAddress container_address;
 	String iterator_name;
 	String iterator_index_name;
 	ElementAttributes attributes;
+	// The recorded parse of the row contents, shared by all rows.
+	XMLParseEventList row_parse_events;
 
 	ElementList elements;
+
+	// Keyed rows are identified by the value of the item member given by the key path, or by the item value itself if the path is empty.
+	// They refer to their index through a row reference, thus they can be moved along with their items without resolving any addresses.
+	bool keyed = false;
+	StringList key_path;
+	// The key of each row in 'elements' when keyed.
+	StringList row_keys;
+
+	bool virtualize = false;
+	int overscan = 0;
+	// The index of the row in 'elements.front()' when virtualized.
+	int first_row = 0;
+	float row_height = 0.f;
+	Element* top_spacer = nullptr;
+	Element* bottom_spacer = nullptr;
+	ObserverPtr<Element> scroll_container;
+	ScrollListener scroll_listener;
 };
 
 class DataViewAlias final : public DataView {
@@ -11,6 +11,11 @@ Decorator::Decorator() {}
 
 Decorator::~Decorator() {}
 
+bool Decorator::GetElementDataKey(Element* /*element*/, BoxArea /*paint_area*/, size_t& /*out_key*/) const
+{
+	return false;
+}
+
 int Decorator::AddTexture(Texture texture)
 {
 	if (!texture)
@@ -49,13 +54,28 @@ Texture Decorator::GetTexture(int index) const
 	return additional_textures[index];
 }
 
+bool Decorator::IsTextureLoading() const
+{
+	if (first_texture.IsLoading())
+		return true;
+	for (const Texture& texture : additional_textures)
+	{
+		if (texture.IsLoading())
+			return true;
+	}
+	return false;
+}
+
 DecoratorInstancer::DecoratorInstancer() {}
 
 DecoratorInstancer::~DecoratorInstancer() {}
 
 const Sprite* DecoratorInstancerInterface::GetSprite(const String& name) const
 {
-	return style_sheet.GetSprite(name);
+	const Sprite* sprite = style_sheet.GetSprite(name);
+	if (sprite_lookups)
+		sprite_lookups->emplace_back(name, sprite ? *sprite : Sprite{Rectanglef::MakeInvalid(), nullptr});
+	return sprite;
 }
 
 Texture DecoratorInstancerInterface::GetTexture(const String& filename) const
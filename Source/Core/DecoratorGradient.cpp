@@ -249,7 +249,7 @@ DecoratorDataHandle DecoratorLinearGradient::GenerateElementData(Element* elemen
 
 	ColorStopList resolved_stops = ResolveColorStops(element, gradient_shape.length, soft_spacing, color_stops);
 
-	CompiledShader shader = render_manager->CompileShader("linear-gradient",
+	SharedCompiledShader shader = CompileSharedShader(*render_manager, "linear-gradient",
 		Dictionary{
 			{"p0", Variant(gradient_shape.p0)},
 			{"p1", Variant(gradient_shape.p1)},
@@ -284,7 +284,7 @@ void DecoratorLinearGradient::ReleaseElementData(DecoratorDataHandle handle) con
 void DecoratorLinearGradient::RenderElement(Element* element, DecoratorDataHandle handle) const
 {
 	ShaderElementData* element_data = reinterpret_cast<ShaderElementData*>(handle);
-	element_data->geometry.Render(element->GetAbsoluteOffset(BoxArea::Border), {}, element_data->shader);
+	element_data->geometry.Render(element->GetAbsoluteOffset(BoxArea::Border), {}, *element_data->shader);
 }
 
 DecoratorLinearGradient::LinearGradientShape DecoratorLinearGradient::CalculateShape(Vector2f dim) const
@@ -419,7 +419,7 @@ DecoratorDataHandle DecoratorRadialGradient::GenerateElementData(Element* elemen
 
 	ColorStopList resolved_stops = ResolveColorStops(element, gradient_shape.radius.x, soft_spacing, color_stops);
 
-	CompiledShader shader = render_manager->CompileShader("radial-gradient",
+	SharedCompiledShader shader = CompileSharedShader(*render_manager, "radial-gradient",
 		Dictionary{
 			{"center", Variant(gradient_shape.center)},
 			{"radius", Variant(gradient_shape.radius)},
@@ -452,7 +452,7 @@ void DecoratorRadialGradient::ReleaseElementData(DecoratorDataHandle handle) con
 void DecoratorRadialGradient::RenderElement(Element* element, DecoratorDataHandle handle) const
 {
 	ShaderElementData* element_data = reinterpret_cast<ShaderElementData*>(handle);
-	element_data->geometry.Render(element->GetAbsoluteOffset(BoxArea::Border), {}, element_data->shader);
+	element_data->geometry.Render(element->GetAbsoluteOffset(BoxArea::Border), {}, *element_data->shader);
 }
 
 DecoratorRadialGradient::RadialGradientShape DecoratorRadialGradient::CalculateRadialGradientShape(Element* element, Vector2f dimensions) const
@@ -616,7 +616,7 @@ DecoratorDataHandle DecoratorConicGradient::GenerateElementData(Element* element
 
 	ColorStopList resolved_stops = ResolveColorStops(element, 1.f, 0.f, color_stops);
 
-	CompiledShader shader = render_manager->CompileShader("conic-gradient",
+	SharedCompiledShader shader = CompileSharedShader(*render_manager, "conic-gradient",
 		Dictionary{
 			{"angle", Variant(angle)},
 			{"center", Variant(center)},
@@ -649,7 +649,7 @@ void DecoratorConicGradient::ReleaseElementData(DecoratorDataHandle handle) cons
 void DecoratorConicGradient::RenderElement(Element* element, DecoratorDataHandle handle) const
 {
 	ShaderElementData* element_data = reinterpret_cast<ShaderElementData*>(handle);
-	element_data->geometry.Render(element->GetAbsoluteOffset(BoxArea::Border), {}, element_data->shader);
+	element_data->geometry.Render(element->GetAbsoluteOffset(BoxArea::Border), {}, *element_data->shader);
 }
 
 DecoratorConicGradientInstancer::DecoratorConicGradientInstancer()
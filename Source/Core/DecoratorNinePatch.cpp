@@ -4,6 +4,7 @@
 #include "../../Include/RmlUi/Core/ElementUtilities.h"
 #include "../../Include/RmlUi/Core/Geometry.h"
 #include "../../Include/RmlUi/Core/PropertyDefinition.h"
+#include "../../Include/RmlUi/Core/Utilities.h"
 
 namespace Rml {
 
@@ -142,6 +143,40 @@ DecoratorDataHandle DecoratorNinePatch::GenerateElementData(Element* element, Bo
 	return reinterpret_cast<DecoratorDataHandle>(data);
 }
 
+bool DecoratorNinePatch::GetElementDataKey(Element* element, BoxArea paint_area, size_t& out_key) const
+{
+	using Utilities::HashCombine;
+
+	const auto& computed = element->GetComputedValues();
+	const RenderBox render_box = element->GetRenderBox(paint_area);
+	const Vector2f offset = render_box.GetFillOffset();
+	const Vector2f size = render_box.GetFillSize();
+	const ColourbPremultiplied colour = computed.image_color().ToPremultiplied(computed.opacity());
+	const float scale_raw_to_natural_dimensions = ElementUtilities::GetDensityIndependentPixelRatio(element) * display_scale;
+
+	size_t seed = 0;
+	HashCombine(seed, offset.x);
+	HashCombine(seed, offset.y);
+	HashCombine(seed, size.x);
+	HashCombine(seed, size.y);
+	HashCombine(seed, uint32_t(colour.red) | uint32_t(colour.green) << 8 | uint32_t(colour.blue) << 16 | uint32_t(colour.alpha) << 24);
+	HashCombine(seed, scale_raw_to_natural_dimensions);
+
+	// The edges may be specified relative to the element, such as in 'em' units, use their resolved lengths instead.
+	if (edges)
+	{
+		const Vector2f natural_top_left = (rect_inner.TopLeft() - rect_outer.TopLeft()) * scale_raw_to_natural_dimensions;
+		const Vector2f natural_bottom_right = (rect_outer.BottomRight() - rect_inner.BottomRight()) * scale_raw_to_natural_dimensions;
+		HashCombine(seed, element->ResolveNumericValue((*edges)[0], natural_top_left.y));
+		HashCombine(seed, element->ResolveNumericValue((*edges)[1], natural_bottom_right.x));
+		HashCombine(seed, element->ResolveNumericValue((*edges)[2], natural_bottom_right.y));
+		HashCombine(seed, element->ResolveNumericValue((*edges)[3], natural_top_left.x));
+	}
+
+	out_key = seed;
+	return true;
+}
+
 void DecoratorNinePatch::ReleaseElementData(DecoratorDataHandle element_data) const
 {
 	delete reinterpret_cast<Geometry*>(element_data);
@@ -16,6 +16,7 @@ public:
 
 	DecoratorDataHandle GenerateElementData(Element* element, BoxArea paint_area) const override;
 	void ReleaseElementData(DecoratorDataHandle element_data) const override;
+	bool GetElementDataKey(Element* element, BoxArea paint_area, size_t& out_key) const override;
 
 	void RenderElement(Element* element, DecoratorDataHandle element_data) const override;
 
@@ -1,19 +1,118 @@
 #include "DecoratorShader.h"
 #include "../../Include/RmlUi/Core/ComputedValues.h"
+#include "../../Include/RmlUi/Core/DecorationTypes.h"
 #include "../../Include/RmlUi/Core/Element.h"
 #include "../../Include/RmlUi/Core/Geometry.h"
 #include "../../Include/RmlUi/Core/MeshUtilities.h"
 #include "../../Include/RmlUi/Core/PropertyDefinition.h"
 #include "../../Include/RmlUi/Core/RenderManager.h"
+#include "../../Include/RmlUi/Core/Utilities.h"
 
 namespace Rml {
 
+namespace {
+	struct SharedShaderEntry {
+		RenderManager* render_manager;
+		String name;
+		Dictionary parameters;
+		WeakPtr<const CompiledShader> shader;
+	};
+	using SharedShaderMap = UnorderedMultimap<size_t, SharedShaderEntry>;
+
+	SharedShaderMap& GetSharedShaders()
+	{
+		static SharedShaderMap shared_shaders;
+		return shared_shaders;
+	}
+
+	// Hashes the values commonly used as shader parameters, other values only contribute their type and are fully compared on lookup.
+	size_t HashShaderParameters(RenderManager* render_manager, const String& name, const Dictionary& parameters)
+	{
+		using Utilities::HashCombine;
+
+		size_t seed = Hash<const void*>()(render_manager);
+		HashCombine(seed, name);
+		for (const auto& pair : parameters)
+		{
+			const Variant& value = pair.second;
+			HashCombine(seed, pair.first);
+			HashCombine(seed, int(value.GetType()));
+
+			switch (value.GetType())
+			{
+			case Variant::BOOL: HashCombine(seed, value.GetReference<bool>()); break;
+			case Variant::INT: HashCombine(seed, value.GetReference<int>()); break;
+			case Variant::FLOAT: HashCombine(seed, value.GetReference<float>()); break;
+			case Variant::STRING: HashCombine(seed, value.GetReference<String>()); break;
+			case Variant::VECTOR2:
+			{
+				const Vector2f& vector = value.GetReference<Vector2f>();
+				HashCombine(seed, vector.x);
+				HashCombine(seed, vector.y);
+			}
+			break;
+			case Variant::COLORSTOPLIST:
+			{
+				for (const ColorStop& stop : value.GetReference<ColorStopList>())
+				{
+					HashCombine(seed, stop.color.red | (stop.color.green << 8) | (stop.color.blue << 16) | (stop.color.alpha << 24));
+					HashCombine(seed, stop.position.number);
+				}
+			}
+			break;
+			default: break;
+			}
+		}
+		return seed;
+	}
+} // namespace
+
 Pool<ShaderElementData>& GetShaderElementDataPool()
 {
 	static Pool<ShaderElementData> gradient_element_data_pool(20, true);
 	return gradient_element_data_pool;
 }
 
+SharedCompiledShader CompileSharedShader(RenderManager& render_manager, const String& name, Dictionary&& parameters)
+{
+	SharedShaderMap& shared_shaders = GetSharedShaders();
+	const size_t hash = HashShaderParameters(&render_manager, name, parameters);
+
+	auto range = shared_shaders.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		const SharedShaderEntry& entry = it->second;
+		if (entry.render_manager == &render_manager && entry.name == name && entry.parameters == parameters)
+		{
+			if (SharedCompiledShader shader = entry.shader.lock())
+				return shader;
+		}
+	}
+
+	CompiledShader compiled_shader = render_manager.CompileShader(name, parameters);
+	if (!compiled_shader)
+		return nullptr;
+
+	// Remove the entry when the last user releases the shader, the compiled shader is released together with it.
+	auto it_entry = shared_shaders.emplace(hash, SharedShaderEntry{&render_manager, name, std::move(parameters), {}});
+	SharedCompiledShader shader(new CompiledShader(std::move(compiled_shader)), [hash](const CompiledShader* shader) {
+		SharedShaderMap& shared_shaders = GetSharedShaders();
+		auto range = shared_shaders.equal_range(hash);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second.shader.expired())
+			{
+				shared_shaders.erase(it);
+				break;
+			}
+		}
+		delete shader;
+	});
+	it_entry->second.shader = shader;
+
+	return shader;
+}
+
 DecoratorShader::DecoratorShader() {}
 
 DecoratorShader::~DecoratorShader() {}
@@ -32,7 +131,7 @@ DecoratorDataHandle DecoratorShader::GenerateElementData(Element* element, BoxAr
 
 	const RenderBox render_box = element->GetRenderBox(paint_area);
 	const Vector2f dimensions = render_box.GetFillSize();
-	CompiledShader shader = render_manager->CompileShader("shader", Dictionary{{"value", Variant(value)}, {"dimensions", Variant(dimensions)}});
+	SharedCompiledShader shader = CompileSharedShader(*render_manager, "shader", Dictionary{{"value", Variant(value)}, {"dimensions", Variant(dimensions)}});
 	if (!shader)
 		return INVALID_DECORATORDATAHANDLE;
 
@@ -61,7 +160,7 @@ void DecoratorShader::ReleaseElementData(DecoratorDataHandle handle) const
 void DecoratorShader::RenderElement(Element* element, DecoratorDataHandle handle) const
 {
 	ShaderElementData* element_data = reinterpret_cast<ShaderElementData*>(handle);
-	element_data->geometry.Render(element->GetAbsoluteOffset(BoxArea::Border), {}, element_data->shader);
+	element_data->geometry.Render(element->GetAbsoluteOffset(BoxArea::Border), {}, *element_data->shader);
 }
 
 DecoratorShaderInstancer::DecoratorShaderInstancer()
@@ -39,11 +39,17 @@ private:
 	PropertyIds ids;
 };
 
+using SharedCompiledShader = SharedPtr<const CompiledShader>;
+
 struct ShaderElementData {
-	ShaderElementData(Geometry&& geometry, CompiledShader&& shader) : geometry(std::move(geometry)), shader(std::move(shader)) {}
+	ShaderElementData(Geometry&& geometry, SharedCompiledShader&& shader) : geometry(std::move(geometry)), shader(std::move(shader)) {}
 	Geometry geometry;
-	CompiledShader shader;
+	SharedCompiledShader shader;
 };
 Pool<ShaderElementData>& GetShaderElementDataPool();
 
+// Compiles a shader, or returns an already compiled shader with the same name and parameters. The shader is shared between all users of
+// the same parameters, and released once the last reference to it is released.
+SharedCompiledShader CompileSharedShader(RenderManager& render_manager, const String& name, Dictionary&& parameters);
+
 } // namespace Rml
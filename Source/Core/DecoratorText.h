@@ -23,6 +23,7 @@ private:
 	struct TexturedGeometry {
 		Geometry geometry;
 		Texture texture;
+		SharedPtr<const CompiledShader> shader;
 	};
 	struct ElementData {
 		BoxArea paint_area;
@@ -6,6 +6,7 @@
 #include "../../Include/RmlUi/Core/MeshUtilities.h"
 #include "../../Include/RmlUi/Core/PropertyDefinition.h"
 #include "../../Include/RmlUi/Core/Spritesheet.h"
+#include "../../Include/RmlUi/Core/Utilities.h"
 #include <algorithm>
 
 namespace Rml {
@@ -14,6 +15,28 @@ DecoratorTiled::DecoratorTiled() {}
 
 DecoratorTiled::~DecoratorTiled() {}
 
+bool DecoratorTiled::GetElementDataKey(Element* element, BoxArea paint_area, size_t& out_key) const
+{
+	using Utilities::HashCombine;
+
+	// The tiles are generated relative to the border box, from the size of the paint area and the element's image color.
+	const ComputedValues& computed = element->GetComputedValues();
+	const RenderBox render_box = element->GetRenderBox(paint_area);
+	const Vector2f offset = render_box.GetFillOffset();
+	const Vector2f size = render_box.GetFillSize();
+	const ColourbPremultiplied colour = computed.image_color().ToPremultiplied(computed.opacity());
+
+	size_t seed = 0;
+	HashCombine(seed, offset.x);
+	HashCombine(seed, offset.y);
+	HashCombine(seed, size.x);
+	HashCombine(seed, size.y);
+	HashCombine(seed, uint32_t(colour.red) | uint32_t(colour.green) << 8 | uint32_t(colour.blue) << 16 | uint32_t(colour.alpha) << 24);
+	HashCombine(seed, ElementUtilities::GetDensityIndependentPixelRatio(element));
+	out_key = seed;
+	return true;
+}
+
 static const Vector2f oriented_texcoords[4][2] = {
 	{Vector2f(0, 0), Vector2f(1, 1)}, // ORIENTATION_NONE
 	{Vector2f(1, 0), Vector2f(0, 1)}, // FLIP_HORIZONTAL
@@ -18,6 +18,9 @@ public:
 	DecoratorTiled();
 	virtual ~DecoratorTiled();
 
+	/// Shares the element data of elements with equal paint areas, image colors, opacity, and dp-ratio.
+	bool GetElementDataKey(Element* element, BoxArea paint_area, size_t& out_key) const override;
+
 	/**
 	    Stores the orientation of a tile.
 	 */
@@ -3,9 +3,16 @@
 #include "../../Include/RmlUi/Core/Geometry.h"
 #include "../../Include/RmlUi/Core/MeshUtilities.h"
 #include "../../Include/RmlUi/Core/RenderManager.h"
+#include <algorithm>
 
 namespace Rml {
 
+struct DecoratorTiledImageData {
+	Geometry geometry;
+	// The texture used for rendering, this is the atlas texture if the image is packed into one.
+	Texture texture;
+};
+
 DecoratorTiledImage::DecoratorTiledImage() {}
 
 DecoratorTiledImage::~DecoratorTiledImage() {}
@@ -19,8 +26,10 @@ bool DecoratorTiledImage::Initialise(const Tile& _tile, Texture _texture)
 
 DecoratorDataHandle DecoratorTiledImage::GenerateElementData(Element* element, BoxArea paint_area) const
 {
+	const Texture texture = GetTexture();
+
 	// Calculate the tile's dimensions for this element.
-	tile.CalculateDimensions(GetTexture());
+	tile.CalculateDimensions(texture);
 
 	const ComputedValues& computed = element->GetComputedValues();
 
@@ -32,20 +41,41 @@ DecoratorDataHandle DecoratorTiledImage::GenerateElementData(Element* element, B
 	Mesh mesh;
 	tile.GenerateGeometry(mesh, computed, offset, size, tile.GetNaturalDimensions(element));
 
-	Geometry* data = new Geometry(element->GetRenderManager()->MakeGeometry(std::move(mesh)));
+	RenderManager* render_manager = element->GetRenderManager();
+	DecoratorTiledImageData* data = new DecoratorTiledImageData();
+	data->texture = texture;
+
+	// Render from the atlas if the image is packed into one. Repeating tiles rely on the texture addressing mode, thus they can only be rendered
+	// from the image's own texture.
+	const bool repeat = (tile.fit_mode == REPEAT || tile.fit_mode == REPEAT_X || tile.fit_mode == REPEAT_Y);
+	auto within_image = [](const Vertex& vertex) {
+		return vertex.tex_coord.x >= 0.f && vertex.tex_coord.y >= 0.f && vertex.tex_coord.x <= 1.f && vertex.tex_coord.y <= 1.f;
+	};
+
+	Texture atlas_texture;
+	Rectanglef atlas_region;
+	if (!repeat && std::all_of(mesh.vertices.begin(), mesh.vertices.end(), within_image) &&
+		render_manager->GetTextureAtlasRegion(texture, atlas_texture, atlas_region))
+	{
+		for (Vertex& vertex : mesh.vertices)
+			vertex.tex_coord = atlas_region.Position() + vertex.tex_coord * atlas_region.Size();
+		data->texture = atlas_texture;
+	}
+
+	data->geometry = render_manager->MakeGeometry(std::move(mesh));
 
 	return reinterpret_cast<DecoratorDataHandle>(data);
 }
 
 void DecoratorTiledImage::ReleaseElementData(DecoratorDataHandle element_data) const
 {
-	delete reinterpret_cast<Geometry*>(element_data);
+	delete reinterpret_cast<DecoratorTiledImageData*>(element_data);
 }
 
 void DecoratorTiledImage::RenderElement(Element* element, DecoratorDataHandle element_data) const
 {
-	Geometry* data = reinterpret_cast<Geometry*>(element_data);
-	data->Render(element->GetAbsoluteOffset(BoxArea::Border), GetTexture());
+	DecoratorTiledImageData* data = reinterpret_cast<DecoratorTiledImageData*>(element_data);
+	data->geometry.Render(element->GetAbsoluteOffset(BoxArea::Border), data->texture);
 }
 
 DecoratorTiledImageInstancer::DecoratorTiledImageInstancer() : DecoratorTiledInstancer(1)
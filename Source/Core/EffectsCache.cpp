@@ -0,0 +1,186 @@
+#include "EffectsCache.h"
+#include "../../Include/RmlUi/Core/Decorator.h"
+#include "../../Include/RmlUi/Core/Filter.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/StyleSheet.h"
+#include "../../Include/RmlUi/Core/StyleSheetTypes.h"
+#include "ControlledLifetimeResource.h"
+#include <algorithm>
+
+namespace Rml {
+
+struct EffectsCacheData {
+	struct DecoratorEntry {
+		RenderManager* render_manager;
+		SpriteLookupList sprite_lookups;
+		Vector<WeakPtr<const Decorator>> decorators;
+	};
+
+	// Decorators by their declaration value and source path. Multiple entries of the same key differ by their render manager or sprites.
+	UnorderedMap<String, Vector<DecoratorEntry>> decorators;
+	// Filters by their declaration value.
+	UnorderedMap<String, Vector<WeakPtr<const Filter>>> filters;
+
+	// Number of entries added since the last sweep of expired entries.
+	int num_added_entries = 0;
+};
+
+static ControlledLifetimeResource<EffectsCacheData> effects_cache_data;
+
+template <typename T>
+static bool IsExpired(const Vector<WeakPtr<T>>& pointers)
+{
+	return std::any_of(pointers.begin(), pointers.end(), [](const WeakPtr<T>& pointer) { return pointer.expired(); });
+}
+
+static bool IsExpired(const EffectsCacheData::DecoratorEntry& entry)
+{
+	return IsExpired(entry.decorators);
+}
+
+// Removes the entries which are no longer in use, every so often as entries are added.
+static void SweepExpiredEntries()
+{
+	constexpr int sweep_interval = 256;
+	if (++effects_cache_data->num_added_entries < sweep_interval)
+		return;
+
+	effects_cache_data->num_added_entries = 0;
+
+	auto& decorators = effects_cache_data->decorators;
+	for (auto it = decorators.begin(); it != decorators.end();)
+	{
+		Vector<EffectsCacheData::DecoratorEntry>& entries = it->second;
+		entries.erase(std::remove_if(entries.begin(), entries.end(), [](const EffectsCacheData::DecoratorEntry& entry) { return IsExpired(entry); }),
+			entries.end());
+		if (entries.empty())
+			it = decorators.erase(it);
+		else
+			++it;
+	}
+
+	auto& filters = effects_cache_data->filters;
+	for (auto it = filters.begin(); it != filters.end();)
+	{
+		if (IsExpired(it->second))
+			it = filters.erase(it);
+		else
+			++it;
+	}
+}
+
+void EffectsCache::Initialize()
+{
+	effects_cache_data.Initialize();
+}
+
+void EffectsCache::Shutdown()
+{
+	effects_cache_data.Shutdown();
+}
+
+bool EffectsCache::FindDecorators(const String& key, RenderManager& render_manager, const StyleSheet& style_sheet,
+	Vector<SharedPtr<const Decorator>>& out_decorators)
+{
+	auto it = effects_cache_data->decorators.find(key);
+	if (it == effects_cache_data->decorators.end())
+		return false;
+
+	// Sprites which were not found are recorded without a sprite sheet, they must not be found in this style sheet either.
+	auto SpritesMatch = [&style_sheet](const SpriteLookupList& sprite_lookups) {
+		for (const auto& name_sprite : sprite_lookups)
+		{
+			const Sprite* sprite = style_sheet.GetSprite(name_sprite.first);
+			const Sprite& expected = name_sprite.second;
+			if ((sprite != nullptr) != (expected.sprite_sheet != nullptr))
+				return false;
+			if (sprite && (sprite->sprite_sheet != expected.sprite_sheet || !(sprite->rectangle == expected.rectangle)))
+				return false;
+		}
+		return true;
+	};
+
+	for (const EffectsCacheData::DecoratorEntry& entry : it->second)
+	{
+		if (entry.render_manager != &render_manager || !SpritesMatch(entry.sprite_lookups))
+			continue;
+
+		out_decorators.clear();
+		out_decorators.reserve(entry.decorators.size());
+		for (const WeakPtr<const Decorator>& weak_decorator : entry.decorators)
+		{
+			SharedPtr<const Decorator> decorator = weak_decorator.lock();
+			if (!decorator)
+				break;
+			out_decorators.push_back(std::move(decorator));
+		}
+
+		if (out_decorators.size() == entry.decorators.size())
+			return true;
+	}
+
+	out_decorators.clear();
+	return false;
+}
+
+void EffectsCache::AddDecorators(const String& key, RenderManager& render_manager, SpriteLookupList&& sprite_lookups,
+	const Vector<SharedPtr<const Decorator>>& decorators)
+{
+	EffectsCacheData::DecoratorEntry entry;
+	entry.render_manager = &render_manager;
+	entry.sprite_lookups = std::move(sprite_lookups);
+	entry.decorators.assign(decorators.begin(), decorators.end());
+
+	// Replace any expired entry, so that entries of frequently reinstanced decorators do not pile up between sweeps.
+	Vector<EffectsCacheData::DecoratorEntry>& entries = effects_cache_data->decorators[key];
+	entries.erase(std::remove_if(entries.begin(), entries.end(), [](const EffectsCacheData::DecoratorEntry& entry) { return IsExpired(entry); }),
+		entries.end());
+	entries.push_back(std::move(entry));
+
+	SweepExpiredEntries();
+}
+
+void EffectsCache::InstanceFilters(const FilterDeclarationList& declaration_list, Vector<SharedPtr<const Filter>>& out_filters)
+{
+	out_filters.clear();
+	out_filters.reserve(declaration_list.list.size());
+
+	// Empty declaration values are used for interpolated values which we don't want to cache.
+	const bool enable_cache = !declaration_list.value.empty();
+
+	if (enable_cache)
+	{
+		auto it = effects_cache_data->filters.find(declaration_list.value);
+		if (it != effects_cache_data->filters.end())
+		{
+			for (const WeakPtr<const Filter>& weak_filter : it->second)
+			{
+				SharedPtr<const Filter> filter = weak_filter.lock();
+				if (!filter)
+					break;
+				out_filters.push_back(std::move(filter));
+			}
+
+			if (out_filters.size() == it->second.size())
+				return;
+			out_filters.clear();
+		}
+	}
+
+	bool success = true;
+	for (const FilterDeclaration& declaration : declaration_list.list)
+	{
+		RMLUI_ZoneScopedN("InstanceFilter");
+		SharedPtr<const Filter> filter = declaration.instancer->InstanceFilter(declaration.type, declaration.properties);
+		success &= (filter != nullptr);
+		out_filters.push_back(std::move(filter));
+	}
+
+	if (enable_cache && success)
+	{
+		effects_cache_data->filters[declaration_list.value].assign(out_filters.begin(), out_filters.end());
+		SweepExpiredEntries();
+	}
+}
+
+} // namespace Rml
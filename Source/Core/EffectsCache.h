@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Spritesheet.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class Decorator;
+class Filter;
+class RenderManager;
+class StyleSheet;
+
+using SpriteLookupList = Vector<Pair<String, Sprite>>;
+
+/**
+    Global cache of the decorators and filters in use, shared between all documents and style sheets.
+
+    The cache only holds weak references, entries are released as soon as they are no longer used by any style sheet or element. Sharing the
+    instances also shares their per-element data, such as compiled shaders and geometry, between elements of different documents.
+ */
+class EffectsCache {
+public:
+	static void Initialize();
+	static void Shutdown();
+
+	/// Looks up decorators in use which were instanced from the given declarations by any style sheet.
+	/// @param[in] key The declaration value combined with the path of its source, see StyleSheet::InstanceDecorators().
+	/// @param[in] render_manager The render manager the decorators must be instanced for.
+	/// @param[in] style_sheet The style sheet to verify the sprites against, they must resolve as they did when the decorators were instanced.
+	/// @param[out] out_decorators The found decorators.
+	/// @return True if the decorators were found.
+	static bool FindDecorators(const String& key, RenderManager& render_manager, const StyleSheet& style_sheet,
+		Vector<SharedPtr<const Decorator>>& out_decorators);
+	/// Adds newly instanced decorators, which did not depend on their style sheet other than through the given sprite lookups.
+	static void AddDecorators(const String& key, RenderManager& render_manager, SpriteLookupList&& sprite_lookups,
+		const Vector<SharedPtr<const Decorator>>& decorators);
+
+	/// Returns the filters instanced from the declarations, shared with any other users of equal declarations.
+	/// @param[out] out_filters The filters in declaration order, null for each filter which could not be instanced.
+	static void InstanceFilters(const FilterDeclarationList& declaration_list, Vector<SharedPtr<const Filter>>& out_filters);
+};
+
+} // namespace Rml
@@ -1,10 +1,12 @@
 #include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/CompiledSelector.h"
 #include "../../Include/RmlUi/Core/Context.h"
 #include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/Dictionary.h"
 #include "../../Include/RmlUi/Core/ElementDocument.h"
 #include "../../Include/RmlUi/Core/ElementInstancer.h"
 #include "../../Include/RmlUi/Core/ElementScroll.h"
+#include "../../Include/RmlUi/Core/ElementText.h"
 #include "../../Include/RmlUi/Core/ElementUtilities.h"
 #include "../../Include/RmlUi/Core/Factory.h"
 #include "../../Include/RmlUi/Core/Math.h"
@@ -13,6 +15,7 @@
 #include "../../Include/RmlUi/Core/PropertyDefinition.h"
 #include "../../Include/RmlUi/Core/PropertyIdSet.h"
 #include "../../Include/RmlUi/Core/StyleSheet.h"
+#include "../../Include/RmlUi/Core/StyleSheetContainer.h"
 #include "../../Include/RmlUi/Core/StyleSheetSpecification.h"
 #include "../../Include/RmlUi/Core/TransformPrimitive.h"
 #include "Clock.h"
@@ -23,9 +26,11 @@
 #include "ElementDefinition.h"
 #include "ElementEffects.h"
 #include "ElementMeta.h"
+#include "ElementQueryIndex.h"
 #include "ElementStyle.h"
 #include "EventDispatcher.h"
 #include "EventSpecification.h"
+#include "FrameStatisticsAccess.h"
 #include "Layout/LayoutEngine.h"
 #include "PluginRegistry.h"
 #include "Pool.h"
@@ -43,6 +48,19 @@ namespace Rml {
 // Determines how many levels up in the hierarchy the OnChildAdd and OnChildRemove are called (starting at the child itself)
 static constexpr int ChildNotifyLevels = 2;
 
+// Incremented whenever the absolute offset of any element may have changed. Instead of dirtying all their descendants, elements record the
+// generation of their change, and descendants compare against it when validating their absolute offset once per generation.
+static uint64_t absolute_offset_generation = 1;
+
+// Elements with changes to be propagated to their ancestors at the end of the current batch, see ElementBatchUpdate.
+struct BatchUpdateData {
+	int depth = 0;
+	UnorderedSet<Element*> dirty_layout;
+	UnorderedSet<Element*> dirty_stacking_context;
+	UnorderedSet<Element*> dirty_render_cache;
+};
+static ControlledLifetimeResource<BatchUpdateData> batch_update;
+
 // Helper function to select scroll offset delta
 static float GetScrollOffsetDelta(ScrollAlignment alignment, float begin_offset, float end_offset)
 {
@@ -67,8 +85,10 @@ static float GetScrollOffsetDelta(ScrollAlignment alignment, float begin_offset,
 Element::Element(const String& tag) :
 	local_stacking_context(false), local_stacking_context_forced(false), stacking_context_dirty(false), computed_values_are_default_initialized(true),
 	visible(true), offset_fixed(false), absolute_offset_dirty(true), rounded_main_padding_size_dirty(true), dirty_definition(false),
-	dirty_child_definitions(false), dirty_animation(false), dirty_transition(false), dirty_transform(false), dirty_perspective(false), tag(tag),
-	relative_offset_base(0, 0), relative_offset_position(0, 0), absolute_offset(0, 0), scroll_offset(0, 0)
+	dirty_child_definitions(false), dirty_layout(false), dirty_child_layout(false), dirty_animation(false), dirty_transition(false),
+	dirty_transform(false), dirty_local_transform(false), dirty_perspective(false), dirty_render_bounds(true), lazy_contents(false),
+	skipped_style(false), animations_registered(false), tag(tag), relative_offset_base(0, 0), relative_offset_position(0, 0), absolute_offset(0, 0),
+	absolute_offset_validated_generation(0), absolute_offset_changed_generation(0), scroll_offset(0, 0)
 {
 	RMLUI_ASSERT(tag == StringUtilities::ToLower(tag));
 	parent = nullptr;
@@ -94,6 +114,15 @@ Element::~Element()
 	RMLUI_ASSERT(parent == nullptr);
 
 	PluginRegistry::NotifyElementDestroy(this);
+	if (batch_update)
+	{
+		batch_update->dirty_layout.erase(this);
+		batch_update->dirty_stacking_context.erase(this);
+		batch_update->dirty_render_cache.erase(this);
+	}
+#ifdef RMLUI_BUILTIN_PROFILING
+	Profiler::OnElementDestroy(this);
+#endif
 
 	// A simplified version of RemoveChild() for destruction.
 	for (ElementPtr& child : children)
@@ -118,12 +147,20 @@ void Element::Update(float dp_ratio, Vector2f vp_dimensions)
 	RMLUI_ZoneScoped;
 	RMLUI_ZoneText(name.c_str(), name.size());
 #endif
+	RMLUI_ZoneElement(this, ProfilerPhase::Style);
+
+	// Running animations are advanced by the context before the update. Here, we only advance animations that have been started or changed
+	// since then, and those of elements that the context does not know about yet or whose style updates were skipped.
+	const bool advance_animations = (skipped_style || dirty_animation || dirty_transition || !animations_registered);
+
+	skipped_style = false;
 
 	OnUpdate();
 
 	HandleTransitionProperty();
 	HandleAnimationProperty();
-	AdvanceAnimations();
+	if (advance_animations)
+		AdvanceAnimations();
 
 	meta->scroll.Update();
 
@@ -139,14 +176,27 @@ void Element::Update(float dp_ratio, Vector2f vp_dimensions)
 
 	meta->effects.InstanceEffects();
 
-	for (size_t i = 0; i < children.size(); i++)
-		children[i]->Update(dp_ratio, vp_dimensions);
+	if (lazy_contents)
+		UpdateLazyContents();
 
-	if (!animations.empty() && IsVisible(true))
+	if (meta->computed_values.display() == Style::Display::None)
 	{
-		if (Context* ctx = GetContext())
-			ctx->RequestNextUpdate(0);
+		Context* context = GetContext();
+		if (context && context->GetDeferHiddenStyles())
+		{
+			// Descendants keep their dirty state until we are displayed again, or their computed values are requested.
+			for (const ElementPtr& child : children)
+				child->SkipStyleUpdates();
+			return;
+		}
 	}
+
+	meta->style.BeginChildDefinitionSharing();
+	for (size_t i = 0; i < children.size(); i++)
+		children[i]->Update(dp_ratio, vp_dimensions);
+	meta->style.EndChildDefinitionSharing();
+
+	RegisterAnimations();
 }
 
 void Element::UpdateProperties(const float dp_ratio, const Vector2f vp_dimensions)
@@ -155,8 +205,12 @@ void Element::UpdateProperties(const float dp_ratio, const Vector2f vp_dimension
 
 	if (meta->style.AnyPropertiesDirty())
 	{
-		const ComputedValues* parent_values = parent ? &parent->GetComputedValues() : nullptr;
-		const ComputedValues* document_values = owner_document ? &owner_document->GetComputedValues() : nullptr;
+		if (DocumentFrameStatistics* statistics = FrameStatisticsAccess::Get(this))
+			statistics->num_computed_values += 1;
+
+		// Our ancestors are always resolved first, also when resolving skipped styles.
+		const ComputedValues* parent_values = parent ? &parent->meta->computed_values : nullptr;
+		const ComputedValues* document_values = owner_document ? &owner_document->meta->computed_values : nullptr;
 
 		// Compute values and clear dirty properties
 		PropertyIdSet dirty_properties = meta->style.ComputeValues(meta->computed_values, parent_values, document_values,
@@ -178,9 +232,20 @@ void Element::Render()
 	RMLUI_ZoneScoped;
 	RMLUI_ZoneText(name.c_str(), name.size());
 #endif
+	RMLUI_ZoneElement(this, ProfilerPhase::Render);
 
 	UpdateAbsoluteOffsetAndRenderBoxData();
 
+	if (RenderManager* render_manager = GetRenderManager())
+	{
+		if (IsOutsideRenderRegion(*render_manager))
+		{
+			if (DocumentFrameStatistics* statistics = FrameStatisticsAccess::Get(this))
+				statistics->num_culled_elements += 1;
+			return;
+		}
+	}
+
 	// Rebuild our stacking context if necessary.
 	if (stacking_context_dirty)
 		BuildLocalStackingContext();
@@ -190,10 +255,13 @@ void Element::Render()
 	// Apply our transform
 	ElementUtilities::ApplyTransform(*this);
 
+	if (meta->render_cache && meta->render_cache->Render(this))
+		return;
+
 	meta->effects.RenderEffects(RenderStage::Enter);
 
 	// Set up the clipping region for this element.
-	if (ElementUtilities::SetClippingRegion(this))
+	if (ApplyClippingRegion())
 	{
 		meta->background_border.Render(this);
 		meta->effects.RenderEffects(RenderStage::Decoration);
@@ -206,12 +274,105 @@ void Element::Render()
 	}
 
 	// Render all elements in our local stacking context.
-	for (Element* element : stacking_context)
-		element->Render();
+	if (!meta->scroll_layer || !meta->scroll_layer->Render(this))
+	{
+		for (Element* element : stacking_context)
+			element->Render();
+	}
 
 	meta->effects.RenderEffects(RenderStage::Exit);
 }
 
+void Element::PrepareRender(Context* context)
+{
+	if (meta->computed_values.display() == Style::Display::None)
+	{
+		meta->subtree_render_bounds = Rectanglef::MakeInvalid();
+		return;
+	}
+
+	// The render bounds depend on the transform, resolve it top-down the same way as during rendering.
+	UpdateTransformState();
+
+	if (visible)
+	{
+		meta->background_border.PrepareRender(this);
+		OnPrepareRender();
+	}
+
+	if (dirty_render_bounds)
+	{
+		dirty_render_bounds = false;
+
+		Rectanglef& bounds = meta->render_bounds;
+		if (ElementUtilities::GetBoundingBox(bounds, this, BoxArea::Auto))
+		{
+			// Glyphs and font effects may extend somewhat outside the text box.
+			if (rmlui_dynamic_cast<ElementText*>(this))
+				bounds = bounds.Extend(meta->computed_values.font_size());
+
+			// Inline elements broken across lines have additional boxes, which are only located this way without a transform.
+			const int num_boxes = GetNumBoxes();
+			if (num_boxes > 1 && !(transform_state && transform_state->GetTransform()))
+			{
+				const Vector2f border_offset = GetAbsoluteOffset(BoxArea::Border);
+				for (int i = 1; i < num_boxes; i++)
+				{
+					Vector2f box_offset;
+					const Box& box = GetBox(i, box_offset);
+					bounds = bounds.Join(Rectanglef::FromPositionSize(border_offset + box_offset, box.GetSize(BoxArea::Border)));
+				}
+			}
+			else if (num_boxes > 1)
+			{
+				bounds = Rectanglef::FromSize(Vector2f(context->GetDimensions()));
+			}
+
+			meta->effects.ExtendInkOverflow(bounds);
+		}
+		else
+		{
+			bounds = Rectanglef::FromSize(Vector2f(context->GetDimensions()));
+		}
+
+		context->AddDirtyRegion(bounds);
+	}
+
+	if (meta->computed_values.has_filter() || meta->computed_values.has_backdrop_filter())
+		context->AddFilterRegion(meta->render_bounds);
+
+	Rectanglef subtree_bounds = meta->render_bounds;
+	for (const ElementPtr& child : children)
+	{
+		child->PrepareRender(context);
+
+		const Rectanglef& child_bounds = child->meta->subtree_render_bounds;
+		if (child_bounds.Valid())
+			subtree_bounds = (subtree_bounds.Valid() ? subtree_bounds.Join(child_bounds) : child_bounds);
+	}
+	meta->subtree_render_bounds = subtree_bounds;
+}
+
+bool Element::IsOutsideRenderRegion(RenderManager& render_manager)
+{
+	// Bounds are prepared during the context update, they can't be relied on once dirtied or before being prepared.
+	const Rectanglef& bounds = (local_stacking_context ? meta->subtree_render_bounds : meta->render_bounds);
+	if (dirty_render_bounds || !bounds.Valid())
+		return false;
+
+	Rectanglei region = Rectanglei::FromSize(render_manager.GetViewport()).IntersectIfValid(render_manager.GetRenderRegion());
+
+	// Descendants rendered as part of our stacking context may escape our clipping region, then only the viewport applies.
+	if (!local_stacking_context)
+	{
+		ElementClipCache& cache = GetValidClipCache();
+		if (cache.scissoring_enabled)
+			region = region.IntersectIfValid(cache.clip_region);
+	}
+
+	return !Rectanglef(region).Intersects(bounds);
+}
+
 ElementPtr Element::Clone() const
 {
 	ElementPtr clone;
@@ -252,7 +413,14 @@ ElementPtr Element::Clone() const
 void Element::SetClass(const String& class_name, bool activate)
 {
 	if (meta->style.SetClass(class_name, activate))
-		DirtyDefinition(DirtyNodes::SelfAndSiblings);
+	{
+		if (ElementQueryIndex* query_index = (owner_document ? ElementQueryIndex::Find(owner_document) : nullptr))
+			query_index->OnClassChange(this, class_name, activate);
+
+		// Only dirty the definitions of elements with selectors depending on the class.
+		const StyleSheet* style_sheet = GetStyleSheet();
+		DirtyDefinition(style_sheet ? style_sheet->GetClassDependency(class_name) : SelectorDependency::All);
+	}
 }
 
 bool Element::IsClassSet(const String& class_name) const
@@ -358,10 +526,29 @@ Vector2f Element::GetAbsoluteOffset(BoxArea area)
 
 void Element::UpdateAbsoluteOffsetAndRenderBoxData()
 {
-	if (absolute_offset_dirty || rounded_main_padding_size_dirty)
+	bool offset_dirty = absolute_offset_dirty;
+
+	// Our absolute offset depends on the offsets, relative positions, and scrolling of our ancestors. Validate them first, and update our own
+	// offset if any of them changed since we last did so.
+	if (absolute_offset_validated_generation != absolute_offset_generation)
+	{
+		absolute_offset_validated_generation = absolute_offset_generation;
+		if (parent)
+		{
+			parent->UpdateAbsoluteOffsetAndRenderBoxData();
+			if (parent->absolute_offset_changed_generation > absolute_offset_changed_generation)
+			{
+				absolute_offset_changed_generation = parent->absolute_offset_changed_generation;
+				offset_dirty = true;
+			}
+		}
+	}
+
+	if (offset_dirty || rounded_main_padding_size_dirty)
 	{
 		absolute_offset_dirty = false;
 		rounded_main_padding_size_dirty = false;
+		const Vector2f old_absolute_offset = absolute_offset;
 
 		Vector2f offset_from_ancestors;
 		if (offset_parent)
@@ -381,6 +568,13 @@ void Element::UpdateAbsoluteOffsetAndRenderBoxData()
 		const Vector2f relative_offset = relative_offset_base + relative_offset_position;
 		absolute_offset = relative_offset + offset_from_ancestors;
 
+		if (absolute_offset != old_absolute_offset)
+		{
+			DirtyRenderBounds();
+			if (transform_state)
+				DirtyTransformState(true, true);
+		}
+
 		// Next, we find the rounded size of the box so that elements can be placed border-to-border next to each other
 		// without any gaps. To achieve this, we have to adjust their rounded/rendered sizes based on their position, in
 		// such a way that the bottom-right of this element exactly matches the top-left of the next element. The order
@@ -399,8 +593,63 @@ void Element::UpdateAbsoluteOffsetAndRenderBoxData()
 	}
 }
 
+ElementClipCache& Element::GetValidClipCache()
+{
+	ElementClipCache& cache = meta->clip_cache;
+	if (!cache.valid)
+	{
+		// Our state is only kept valid while our parent's is, so that invalidating an element reaches all descendants with a valid state.
+		if (parent)
+			parent->GetValidClipCache();
+
+		cache.clip_mask_list.clear();
+		cache.scissoring_enabled = ElementUtilities::GetClippingRegion(this, cache.clip_region, &cache.clip_mask_list);
+		cache.valid = true;
+	}
+	return cache;
+}
+
+void Element::DirtyClipCache()
+{
+	ElementClipCache& cache = meta->clip_cache;
+	if (!cache.valid)
+		return;
+
+	cache.valid = false;
+	for (const ElementPtr& child : children)
+		child->DirtyClipCache();
+}
+
+void Element::DirtyHitTestIndices()
+{
+	if (Context* context = GetContext())
+		context->hit_test_generation += 1;
+}
+
+bool Element::ApplyClippingRegion()
+{
+	Context* context = GetContext();
+	if (!context)
+		return false;
+
+	ElementClipCache& cache = GetValidClipCache();
+
+	RenderManager& render_manager = context->GetRenderManager();
+	if (cache.scissoring_enabled)
+		render_manager.SetScissorRegion(cache.clip_region);
+	else
+		render_manager.DisableScissorRegion();
+
+	if (render_manager.GetState().clip_mask_list != cache.clip_mask_list)
+		render_manager.SetClipMask(cache.clip_mask_list);
+
+	return true;
+}
+
 void Element::SetClipArea(BoxArea _clip_area)
 {
+	if (clip_area != _clip_area)
+		DirtyClipCache();
 	clip_area = _clip_area;
 }
 
@@ -414,6 +663,7 @@ void Element::SetScrollableOverflowRectangle(Vector2f _scrollable_overflow_recta
 	if (scrollable_overflow_rectangle != _scrollable_overflow_rectangle)
 	{
 		scrollable_overflow_rectangle = _scrollable_overflow_rectangle;
+		DirtyClipCache();
 		if (clamp_scroll_offset)
 			ClampScrollOffset();
 	}
@@ -432,20 +682,31 @@ void Element::SetBox(const Box& box)
 		}
 #endif
 
+		const bool size_changed = (box.GetSize(BoxArea::Border) != main_box.GetSize(BoxArea::Border));
 		main_box = box;
 		additional_boxes.clear();
+		DirtyClipCache();
+		DirtyHitTestIndices();
+		DirtyRenderCache();
 
 		OnResize();
 		rounded_main_padding_size_dirty = true;
 		meta->background_border.DirtyBackground();
 		meta->background_border.DirtyBorder();
 		meta->effects.DirtyEffectsData();
+
+		// Percentages and origins of the transform and perspective are resolved against the border size.
+		if (size_changed)
+			DirtyTransformState(true, true);
 	}
 }
 
 void Element::AddBox(const Box& box, Vector2f offset)
 {
 	additional_boxes.emplace_back(PositionedBox{box, offset});
+	DirtyClipCache();
+	DirtyHitTestIndices();
+	DirtyRenderCache();
 	OnResize();
 	meta->background_border.DirtyBackground();
 	meta->background_border.DirtyBorder();
@@ -601,6 +862,34 @@ bool Element::SetProperty(PropertyId id, const Property& property)
 	return meta->style.SetProperty(id, property);
 }
 
+// Sets a property value of the given unit, after checking that the unit is accepted by the property.
+static bool SetPropertyOfUnit(ElementStyle& style, PropertyId id, Variant&& value, Unit unit)
+{
+	const PropertyDefinition* definition = StyleSheetSpecification::GetProperty(id);
+	if (!definition || !Any(definition->GetUnits() & unit))
+	{
+		Log::Message(Log::LT_WARNING, "Invalid unit for property '%s'.", StyleSheetSpecification::GetPropertyName(id).c_str());
+		return false;
+	}
+
+	return style.SetProperty(id, Property(std::move(value), unit));
+}
+
+bool Element::SetLength(PropertyId id, float value, Unit unit)
+{
+	return SetPropertyOfUnit(meta->style, id, Variant(value), unit);
+}
+
+bool Element::SetColour(PropertyId id, Colourb colour)
+{
+	return SetPropertyOfUnit(meta->style, id, Variant(colour), Unit::COLOUR);
+}
+
+bool Element::SetTransform(TransformPtr transform)
+{
+	return SetPropertyOfUnit(meta->style, PropertyId::Transform, Variant(std::move(transform)), Unit::TRANSFORM);
+}
+
 void Element::RemoveProperty(const String& name)
 {
 	auto property_id = StyleSheetSpecification::GetPropertyId(name);
@@ -625,11 +914,15 @@ void Element::RemoveProperty(PropertyId id)
 
 const Property* Element::GetProperty(const String& name)
 {
+	if (skipped_style)
+		UpdateSkippedStyle();
 	return meta->style.GetProperty(StyleSheetSpecification::GetPropertyId(name));
 }
 
 const Property* Element::GetProperty(PropertyId id)
 {
+	if (skipped_style)
+		UpdateSkippedStyle();
 	return meta->style.GetProperty(id);
 }
 
@@ -766,8 +1059,8 @@ void Element::SetPseudoClass(const String& pseudo_class, bool activate)
 {
 	if (meta->style.SetPseudoClass(pseudo_class, activate, false))
 	{
-		// Include siblings in case of RCSS presence of sibling combinators '+', '~'.
-		DirtyDefinition(DirtyNodes::SelfAndSiblings);
+		const StyleSheet* style_sheet = GetStyleSheet();
+		DirtyDefinition(style_sheet ? style_sheet->GetPseudoClassDependency(pseudo_class) : SelectorDependency::All);
 		OnPseudoClassChange(pseudo_class, activate);
 	}
 }
@@ -828,11 +1121,36 @@ void Element::RemoveAttribute(const String& name)
 	if (it != attributes.end())
 	{
 		attributes.erase(it);
+		NotifyAttributeChange(name, Variant());
+	}
+}
+
+void Element::SetAttributeVariant(const String& name, Variant&& value)
+{
+	auto it = attributes.find(name);
+	if (it == attributes.end())
+		it = attributes.emplace(name, Variant()).first;
+	it->second = value;
 
-		ElementAttributes changed_attributes;
-		changed_attributes.emplace(name, Variant());
-		OnAttributeChange(changed_attributes);
+	NotifyAttributeChange(name, std::move(value));
+}
+
+void Element::NotifyAttributeChange(const String& name, Variant&& value)
+{
+	// Reuse the storage of earlier notifications, taking it from a list as elements may change attributes while reacting to a change.
+	Vector<ElementAttributes>& free_changed_attributes = ElementMetaPool::element_meta_pool->free_changed_attributes;
+	ElementAttributes changed_attributes;
+	if (!free_changed_attributes.empty())
+	{
+		changed_attributes = std::move(free_changed_attributes.back());
+		free_changed_attributes.pop_back();
 	}
+
+	changed_attributes.emplace(name, std::move(value));
+	OnAttributeChange(changed_attributes);
+
+	changed_attributes.clear();
+	free_changed_attributes.push_back(std::move(changed_attributes));
 }
 
 Element* Element::GetFocusLeafNode()
@@ -1309,6 +1627,7 @@ Element* Element::AppendChild(ElementPtr child, bool dom_element)
 		children.push_back(std::move(child));
 		num_non_dom_children++;
 	}
+	meta->style.OnChildAdd();
 	// Set parent just after inserting into children. This allows us to eg. get our previous sibling in SetParent.
 	child_ptr->SetParent(this);
 
@@ -1360,6 +1679,7 @@ Element* Element::InsertBefore(ElementPtr child, Element* adjacent_element)
 			DirtyLayout();
 
 		children.insert(children.begin() + child_index, std::move(child));
+		meta->style.OnChildAdd();
 		child_ptr->SetParent(this);
 
 		Element* ancestor = child_ptr;
@@ -1395,6 +1715,7 @@ ElementPtr Element::ReplaceChild(ElementPtr inserted_element, Element* replaced_
 	}
 
 	children.insert(insertion_point, std::move(inserted_element));
+	meta->style.OnChildAdd();
 	inserted_element_ptr->SetParent(this);
 
 	ElementPtr result = RemoveChild(replaced_element);
@@ -1406,6 +1727,33 @@ ElementPtr Element::ReplaceChild(ElementPtr inserted_element, Element* replaced_
 	return result;
 }
 
+void Element::MoveChildBefore(Element* child, Element* adjacent_element)
+{
+	auto FindChild = [this](Element* element) {
+		return std::find_if(children.begin(), children.end() - num_non_dom_children,
+			[element](const ElementPtr& ptr) { return ptr.get() == element; });
+	};
+	const auto it_child = FindChild(child);
+	const auto it_adjacent = FindChild(adjacent_element);
+	RMLUI_ASSERT(it_child != children.end() - num_non_dom_children && it_adjacent != children.end() - num_non_dom_children);
+
+	if (it_child == it_adjacent || it_child + 1 == it_adjacent)
+		return;
+
+	// The area previously covered by the child needs to be redrawn.
+	child->DirtyRenderBoundsRecursive();
+
+	if (it_child < it_adjacent)
+		std::rotate(it_child, it_child + 1, it_adjacent);
+	else
+		std::rotate(it_adjacent, it_child, it_child + 1);
+
+	meta->style.OnChildAdd();
+	DirtyLayout();
+	DirtyStackingContext();
+	DirtyDefinition(DirtyNodes::Self);
+}
+
 ElementPtr Element::RemoveChild(Element* child)
 {
 	size_t child_index = 0;
@@ -1422,8 +1770,12 @@ ElementPtr Element::RemoveChild(Element* child)
 			if (child_index >= children.size() - num_non_dom_children)
 				num_non_dom_children--;
 
+			// The area covered by the child and its descendants needs to be redrawn.
+			child->DirtyRenderBoundsRecursive();
+
 			ElementPtr detached_child = std::move(*itr);
 			children.erase(itr);
+			meta->style.OnChildRemove(child);
 
 			// Remove the child element as the focused child of this element.
 			if (child == focus)
@@ -1468,6 +1820,16 @@ bool Element::HasChildNodes() const
 	return (int)children.size() > num_non_dom_children;
 }
 
+// Returns the query index of the element's document, or nullptr if queries on the element must traverse its descendants.
+static ElementQueryIndex* GetUsableQueryIndex(Element* element)
+{
+	ElementDocument* document = element->GetOwnerDocument();
+	if (!document)
+		return nullptr;
+	ElementQueryIndex& query_index = ElementQueryIndex::Get(document);
+	return query_index.IsUsable() ? &query_index : nullptr;
+}
+
 Element* Element::GetElementById(const String& id)
 {
 	// Check for special-case tokens.
@@ -1482,17 +1844,23 @@ Element* Element::GetElementById(const String& id)
 		Element* search_root = GetOwnerDocument();
 		if (search_root == nullptr)
 			search_root = this;
+		else if (ElementQueryIndex* query_index = (id.empty() ? nullptr : GetUsableQueryIndex(this)))
+			return query_index->GetElementById(id);
 		return ElementUtilities::GetElementById(search_root, id);
 	}
 }
 
 void Element::GetElementsByTagName(ElementList& elements, const String& tag)
 {
+	if (ElementQueryIndex* query_index = GetUsableQueryIndex(this))
+		return query_index->GetElementsByTagName(elements, this, tag);
 	return ElementUtilities::GetElementsByTagName(elements, this, tag);
 }
 
 void Element::GetElementsByClassName(ElementList& elements, const String& class_name)
 {
+	if (ElementQueryIndex* query_index = GetUsableQueryIndex(this))
+		return query_index->GetElementsByClassName(elements, this, class_name);
 	return ElementUtilities::GetElementsByClassName(elements, this, class_name);
 }
 
@@ -1545,44 +1913,63 @@ static void QuerySelectorAllMatchRecursive(ElementList& matching_elements, const
 
 Element* Element::QuerySelector(const String& selectors)
 {
-	StyleSheetNode root_node;
-	StyleSheetNodeListRaw leaf_nodes = StyleSheetParser::ConstructNodes(root_node, selectors);
+	return QuerySelector(CompiledSelector(selectors));
+}
 
-	if (leaf_nodes.empty())
+Element* Element::QuerySelector(const CompiledSelector& selector)
+{
+	if (!selector)
 	{
-		Log::Message(Log::LT_WARNING, "Query selector '%s' is empty. In element %s", selectors.c_str(), GetAddress().c_str());
+		Log::Message(Log::LT_WARNING, "Query selector '%s' is empty. In element %s", selector.GetSource().c_str(), GetAddress().c_str());
 		return nullptr;
 	}
 
-	return QuerySelectorMatchRecursive(leaf_nodes, this, this);
+	if (ElementQueryIndex* query_index = GetUsableQueryIndex(this))
+	{
+		ElementList elements;
+		if (query_index->QuerySelector(elements, this, selector.leaf_nodes, true))
+			return elements.empty() ? nullptr : elements.front();
+	}
+
+	return QuerySelectorMatchRecursive(selector.leaf_nodes, this, this);
 }
 
 void Element::QuerySelectorAll(ElementList& elements, const String& selectors)
 {
-	StyleSheetNode root_node;
-	StyleSheetNodeListRaw leaf_nodes = StyleSheetParser::ConstructNodes(root_node, selectors);
+	QuerySelectorAll(elements, CompiledSelector(selectors));
+}
 
-	if (leaf_nodes.empty())
+void Element::QuerySelectorAll(ElementList& elements, const CompiledSelector& selector)
+{
+	if (!selector)
 	{
-		Log::Message(Log::LT_WARNING, "Query selector '%s' is empty. In element %s", selectors.c_str(), GetAddress().c_str());
+		Log::Message(Log::LT_WARNING, "Query selector '%s' is empty. In element %s", selector.GetSource().c_str(), GetAddress().c_str());
 		return;
 	}
 
-	QuerySelectorAllMatchRecursive(elements, leaf_nodes, this, this);
+	if (ElementQueryIndex* query_index = GetUsableQueryIndex(this))
+	{
+		if (query_index->QuerySelector(elements, this, selector.leaf_nodes, false))
+			return;
+	}
+
+	QuerySelectorAllMatchRecursive(elements, selector.leaf_nodes, this, this);
 }
 
 bool Element::Matches(const String& selectors)
 {
-	StyleSheetNode root_node;
-	StyleSheetNodeListRaw leaf_nodes = StyleSheetParser::ConstructNodes(root_node, selectors);
+	return Matches(CompiledSelector(selectors));
+}
 
-	if (leaf_nodes.empty())
+bool Element::Matches(const CompiledSelector& selector)
+{
+	if (!selector)
 	{
-		Log::Message(Log::LT_WARNING, "Query selector '%s' is empty. In element %s", selectors.c_str(), GetAddress().c_str());
+		Log::Message(Log::LT_WARNING, "Query selector '%s' is empty. In element %s", selector.GetSource().c_str(), GetAddress().c_str());
 		return false;
 	}
 
-	for (const StyleSheetNode* node : leaf_nodes)
+	for (const StyleSheetNode* node : selector.leaf_nodes)
 	{
 		if (node->IsApplicable(this, this))
 		{
@@ -1651,6 +2038,8 @@ void Element::OnUpdate() {}
 
 void Element::OnRender() {}
 
+void Element::OnPrepareRender() {}
+
 void Element::OnResize() {}
 
 void Element::OnLayout() {}
@@ -1661,17 +2050,31 @@ void Element::OnStyleSheetChange() {}
 
 void Element::OnAttributeChange(const ElementAttributes& changed_attributes)
 {
+	DirtyRenderCache();
+
 	for (const auto& element_attribute : changed_attributes)
 	{
 		const auto& attribute = element_attribute.first;
 		const auto& value = element_attribute.second;
 		if (attribute == "id")
 		{
-			id = value.Get<String>();
+			String new_id = value.Get<String>();
+			if (ElementQueryIndex* query_index = (owner_document ? ElementQueryIndex::Find(owner_document) : nullptr))
+				query_index->OnIdChange(this, id, new_id);
+			id = std::move(new_id);
 		}
 		else if (attribute == "class")
 		{
+			ElementQueryIndex* query_index = (owner_document ? ElementQueryIndex::Find(owner_document) : nullptr);
+			if (query_index)
+				query_index->RemoveElement(this);
 			meta->style.SetClassNames(value.Get<String>());
+			if (query_index)
+				query_index->AddElement(this);
+		}
+		else if (attribute == "rmlui-lazy-rml")
+		{
+			lazy_contents = !value.Get<String>().empty();
 		}
 		else if (((attribute == "colspan" || attribute == "rowspan") && meta->computed_values.display() == Style::Display::TableCell) ||
 			(attribute == "span" &&
@@ -1753,13 +2156,28 @@ void Element::OnAttributeChange(const ElementAttributes& changed_attributes)
 	}
 
 	// Any change to the attributes may affect which styles apply to the current element, in particular due to attribute selectors, ID selectors, and
-	// class selectors. This can further affect all siblings or descendants due to sibling or descendant combinators.
-	DirtyDefinition(DirtyNodes::SelfAndSiblings);
+	// class selectors. This can further affect all siblings or descendants due to sibling or descendant combinators. Other than for the ID and
+	// class, only dirty the elements with attribute selectors depending on the changed attributes.
+	SelectorDependency dependency = SelectorDependency::None;
+	const StyleSheet* style_sheet = GetStyleSheet();
+	for (const auto& element_attribute : changed_attributes)
+	{
+		const String& attribute = element_attribute.first;
+		if (!style_sheet || attribute == "id" || attribute == "class")
+		{
+			dependency = SelectorDependency::All;
+			break;
+		}
+		dependency = dependency | style_sheet->GetAttributeDependency(attribute);
+	}
+	DirtyDefinition(dependency);
 }
 
 void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 {
 	RMLUI_ZoneScoped;
+	DirtyRenderCache();
+
 	const bool top_right_bottom_left_changed = (           //
 		changed_properties.Contains(PropertyId::Top) ||    //
 		changed_properties.Contains(PropertyId::Right) ||  //
@@ -1767,13 +2185,17 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 		changed_properties.Contains(PropertyId::Left)      //
 	);
 
+	// Force a relayout if any of the changed properties require it.
+	const PropertyIdSet changed_properties_forcing_layout =
+		(changed_properties & StyleSheetSpecification::GetRegisteredPropertiesForcingLayout());
+
+	// Our measured size may change even if the layout is already dirty.
+	if (!changed_properties_forcing_layout.Empty())
+		meta->layout_cache.Clear();
+
 	// See if the document layout needs to be updated.
 	if (!IsLayoutDirty())
 	{
-		// Force a relayout if any of the changed properties require it.
-		const PropertyIdSet changed_properties_forcing_layout =
-			(changed_properties & StyleSheetSpecification::GetRegisteredPropertiesForcingLayout());
-
 		if (!changed_properties_forcing_layout.Empty())
 		{
 			DirtyLayout();
@@ -1830,14 +2252,60 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 	const bool filter_or_mask_changed = (changed_properties.Contains(PropertyId::Filter) || changed_properties.Contains(PropertyId::BackdropFilter) ||
 		changed_properties.Contains(PropertyId::MaskImage));
 
+	// Changes to the display, clipping, stacking, or effects of the element change the rendering of all its descendants.
+	if (border_radius_changed || filter_or_mask_changed ||     //
+		changed_properties.Contains(PropertyId::Display) ||    //
+		changed_properties.Contains(PropertyId::Visibility) || //
+		changed_properties.Contains(PropertyId::OverflowX) ||  //
+		changed_properties.Contains(PropertyId::OverflowY) ||  //
+		changed_properties.Contains(PropertyId::Clip) ||       //
+		changed_properties.Contains(PropertyId::ZIndex))
+	{
+		DirtyRenderBoundsRecursive();
+	}
+
+	// Invalidate retained clipping regions if any properties involved in clipping have changed.
+	if (border_radius_changed ||                               //
+		changed_properties.Contains(PropertyId::OverflowX) ||  //
+		changed_properties.Contains(PropertyId::OverflowY) ||  //
+		changed_properties.Contains(PropertyId::Clip) ||       //
+		changed_properties.Contains(PropertyId::Display) ||    //
+		changed_properties.Contains(PropertyId::Position))
+	{
+		DirtyClipCache();
+	}
+
+	// Cached rendering covers our stacking context, thus it requires a local one.
+	const Style::RenderCache render_cache = meta->computed_values.render_cache();
+	const bool render_cache_changed =
+		(changed_properties.Contains(PropertyId::RenderCache) || (filter_or_mask_changed && render_cache == Style::RenderCache::Auto));
+	if (render_cache_changed)
+	{
+		// Automatic caching only pays off for filters, while backdrop filters depend on the content behind the element.
+		const bool defer_capture = (render_cache == Style::RenderCache::Auto);
+		const bool use_cache = (render_cache == Style::RenderCache::Static ||
+			(defer_capture && meta->computed_values.has_filter() && !meta->computed_values.has_backdrop_filter()));
+
+		if (!use_cache)
+			meta->render_cache.reset();
+		else if (!meta->render_cache || meta->render_cache->IsCaptureDeferred() != defer_capture)
+			meta->render_cache = MakeUnique<ElementRenderCache>(defer_capture);
+
+		if (render_cache != Style::RenderCache::Scroll)
+			meta->scroll_layer.reset();
+		else if (!meta->scroll_layer)
+			meta->scroll_layer = MakeUnique<ElementScrollLayer>();
+	}
+
 	// Update the z-index and stacking context.
-	if (changed_properties.Contains(PropertyId::ZIndex) || filter_or_mask_changed)
+	if (changed_properties.Contains(PropertyId::ZIndex) || filter_or_mask_changed || render_cache_changed)
 	{
 		const Style::ZIndex z_index_property = meta->computed_values.z_index();
 
 		const float new_z_index = (z_index_property.type == Style::ZIndex::Auto ? 0.f : z_index_property.value);
 		const bool enable_local_stacking_context = (z_index_property.type != Style::ZIndex::Auto || local_stacking_context_forced ||
-			meta->computed_values.has_filter() || meta->computed_values.has_backdrop_filter() || meta->computed_values.has_mask_image());
+			meta->computed_values.has_filter() || meta->computed_values.has_backdrop_filter() || meta->computed_values.has_mask_image() ||
+			meta->render_cache || meta->scroll_layer);
 
 		if (z_index != new_z_index || local_stacking_context != enable_local_stacking_context)
 		{
@@ -1860,11 +2328,7 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 	}
 
 	// Dirty the background if it's changed.
-	if (border_radius_changed ||                                    //
-		changed_properties.Contains(PropertyId::BackgroundColor) || //
-		changed_properties.Contains(PropertyId::Opacity) ||         //
-		changed_properties.Contains(PropertyId::ImageColor) ||      //
-		changed_properties.Contains(PropertyId::BoxShadow))         //
+	if (border_radius_changed || changed_properties.Contains(PropertyId::BoxShadow))
 	{
 		meta->background_border.DirtyBackground();
 	}
@@ -1874,14 +2338,22 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 		changed_properties.Contains(PropertyId::BorderTopWidth) ||    //
 		changed_properties.Contains(PropertyId::BorderRightWidth) ||  //
 		changed_properties.Contains(PropertyId::BorderBottomWidth) || //
-		changed_properties.Contains(PropertyId::BorderLeftWidth) ||   //
+		changed_properties.Contains(PropertyId::BorderLeftWidth))
+	{
+		meta->background_border.DirtyBorder();
+	}
+
+	// Color and opacity changes, such as during animations, only need the background and border to be recolored while their shapes are
+	// retained.
+	if (changed_properties.Contains(PropertyId::BackgroundColor) ||   //
+		changed_properties.Contains(PropertyId::Opacity) ||           //
+		changed_properties.Contains(PropertyId::ImageColor) ||        //
 		changed_properties.Contains(PropertyId::BorderTopColor) ||    //
 		changed_properties.Contains(PropertyId::BorderRightColor) ||  //
 		changed_properties.Contains(PropertyId::BorderBottomColor) || //
-		changed_properties.Contains(PropertyId::BorderLeftColor) ||   //
-		changed_properties.Contains(PropertyId::Opacity))
+		changed_properties.Contains(PropertyId::BorderLeftColor))
 	{
-		meta->background_border.DirtyBorder();
+		meta->background_border.DirtyColors();
 	}
 
 	// Dirty the effects if they've changed.
@@ -1912,11 +2384,12 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 		DirtyTransformState(true, false);
 	}
 
-	// Check for `transform' and `transform-origin' changes
+	// Check for `transform' and `transform-origin' changes, transforms may also use 'em' units which are only resolved during their update.
 	if (changed_properties.Contains(PropertyId::Transform) ||        //
 		changed_properties.Contains(PropertyId::TransformOriginX) || //
 		changed_properties.Contains(PropertyId::TransformOriginY) || //
-		changed_properties.Contains(PropertyId::TransformOriginZ))
+		changed_properties.Contains(PropertyId::TransformOriginZ) || //
+		changed_properties.Contains(PropertyId::FontSize))
 	{
 		DirtyTransformState(false, true);
 	}
@@ -1941,8 +2414,26 @@ void Element::OnChildRemove(Element* /*child*/) {}
 
 void Element::DirtyLayout()
 {
-	if (Element* document = GetOwnerDocument())
-		document->DirtyLayout();
+	meta->layout_cache.Clear();
+
+	// Only flag the path from our document down to this element, the document decides during layout which parts need to be formatted again.
+	if (batch_update)
+	{
+		batch_update->dirty_layout.insert(this);
+		return;
+	}
+
+	if (ElementInvalidations* invalidations = FrameStatisticsAccess::GetInvalidations(this))
+		invalidations->num_layout_dirties += 1;
+
+	Element* document = GetOwnerDocument();
+	if (!document)
+		return;
+
+	dirty_layout = true;
+	for (Element* ancestor = parent; ancestor && ancestor != document; ancestor = ancestor->parent)
+		ancestor->dirty_child_layout = true;
+	document->dirty_child_layout = true;
 }
 
 bool Element::IsLayoutDirty()
@@ -2004,6 +2495,8 @@ void Element::ProcessDefaultAction(Event& event)
 
 const Style::ComputedValues& Element::GetComputedValues() const
 {
+	if (skipped_style)
+		const_cast<Element*>(this)->UpdateSkippedStyle();
 	return meta->computed_values;
 }
 
@@ -2078,10 +2571,22 @@ void Element::SetOwnerDocument(ElementDocument* document)
 	// If this element is a document, then never change owner_document.
 	if (owner_document != this && owner_document != document)
 	{
+		if (ElementQueryIndex* query_index = (owner_document ? ElementQueryIndex::Find(owner_document) : nullptr))
+			query_index->RemoveElement(this);
+
 		owner_document = document;
+
+		if (ElementQueryIndex* query_index = (owner_document ? ElementQueryIndex::Find(owner_document) : nullptr))
+			query_index->AddElement(this);
+
 		for (ElementPtr& child : children)
 			child->SetOwnerDocument(document);
 	}
+	else if (owner_document == this && document && document != this)
+	{
+		if (ElementQueryIndex* query_index = ElementQueryIndex::Find(document))
+			query_index->OnNestedDocumentAttach();
+	}
 }
 
 void Element::SetDataModel(DataModel* new_data_model)
@@ -2122,6 +2627,9 @@ void Element::SetParent(Element* _parent)
 
 	parent = _parent;
 
+	// Clipping regions are resolved from our ancestors, any retained state is no longer valid.
+	DirtyClipCache();
+
 	if (parent)
 	{
 		// We need to update our definition and make sure we inherit the properties of our new parent.
@@ -2133,8 +2641,15 @@ void Element::SetParent(Element* _parent)
 	if (transform_state || (parent && parent->transform_state))
 		DirtyTransformState(true, true);
 
+	// The generations of our previous ancestors are unrelated to our new ones, validate our offset and those of our descendants again.
+	absolute_offset_dirty = true;
+	absolute_offset_changed_generation = ++absolute_offset_generation;
+
 	SetOwnerDocument(parent ? parent->GetOwnerDocument() : nullptr);
 
+	if (parent && parent->skipped_style)
+		SkipStyleUpdates();
+
 	if (!parent)
 	{
 		if (data_model)
@@ -2163,23 +2678,20 @@ void Element::SetParent(Element* _parent)
 }
 
 void Element::DirtyAbsoluteOffset()
-{
-	if (!absolute_offset_dirty)
-		DirtyAbsoluteOffsetRecursive();
-}
-
-void Element::DirtyAbsoluteOffsetRecursive()
 {
 	if (!absolute_offset_dirty)
 	{
-		absolute_offset_dirty = true;
+		// Clipping regions only depend on the offsets of ancestors, thus only the states of our descendants are affected.
+		for (const ElementPtr& child : children)
+			child->DirtyClipCache();
+		DirtyHitTestIndices();
+		// Only the retained renders containing us are redrawn, those of our own ancestors.
+		DirtyRenderCache();
 
-		if (transform_state)
-			DirtyTransformState(true, true);
+		// Descendants pick up the change when their absolute offset is next queried, so that changes such as scrolling are constant time.
+		absolute_offset_dirty = true;
+		absolute_offset_changed_generation = ++absolute_offset_generation;
 	}
-
-	for (size_t i = 0; i < children.size(); i++)
-		children[i]->DirtyAbsoluteOffsetRecursive();
 }
 
 void Element::UpdateOffset()
@@ -2218,12 +2730,36 @@ static bool operator<(const StackingContextChild& lhs, const StackingContextChil
 	return int(lhs.order) < int(rhs.order);
 }
 
+// Sorts the range by paint order, keeping the tree order of equal entries. The range is usually already in order, such as when no children
+// set a z-index, which is checked first. Short ranges are insertion sorted, thus the temporary buffer of std::stable_sort is rarely needed.
+static void StackingContext_Sort(Vector<StackingContextChild>::iterator begin, Vector<StackingContextChild>::iterator end)
+{
+	if (std::is_sorted(begin, end))
+		return;
+
+	constexpr ptrdiff_t max_insertion_sort_size = 32;
+	if (end - begin > max_insertion_sort_size)
+	{
+		std::stable_sort(begin, end);
+		return;
+	}
+
+	for (auto it = begin + 1; it != end; ++it)
+	{
+		const StackingContextChild child = *it;
+		auto it_insert = it;
+		for (; it_insert != begin && child < *(it_insert - 1); --it_insert)
+			*it_insert = *(it_insert - 1);
+		*it_insert = child;
+	}
+}
+
 // Treat all children in the range [index_begin, end) as if the parent created a new stacking context, by sorting them
 // separately and then assigning their parent's paint order. However, positioned and descendants which create a new
 // stacking context should be considered part of the parent stacking context. See CSS 2, Appendix E.
 static void StackingContext_MakeAtomicRange(Vector<StackingContextChild>& stacking_children, size_t index_begin, RenderOrder parent_render_order)
 {
-	std::stable_sort(stacking_children.begin() + index_begin, stacking_children.end());
+	StackingContext_Sort(stacking_children.begin() + index_begin, stacking_children.end());
 
 	for (auto it = stacking_children.begin() + index_begin; it != stacking_children.end(); ++it)
 	{
@@ -2237,9 +2773,17 @@ void Element::BuildLocalStackingContext()
 {
 	stacking_context_dirty = false;
 
-	Vector<StackingContextChild> stacking_children;
+	// Scrolled contents may have been added or removed.
+	if (meta->scroll_layer)
+		meta->scroll_layer->Dirty();
+
+	// The children are only collected while building, reuse their memory between builds. Building never recurses into other stacking
+	// contexts, while separate threads may render separate contexts.
+	thread_local Vector<StackingContextChild> stacking_children;
+	stacking_children.clear();
+
 	AddChildrenToStackingContext(stacking_children);
-	std::stable_sort(stacking_children.begin(), stacking_children.end());
+	StackingContext_Sort(stacking_children.begin(), stacking_children.end());
 
 	stacking_context.resize(stacking_children.size());
 	for (size_t i = 0; i < stacking_children.size(); i++)
@@ -2355,6 +2899,15 @@ void Element::AddToStackingContext(Vector<StackingContextChild>& stacking_childr
 
 void Element::DirtyStackingContext()
 {
+	if (batch_update)
+	{
+		batch_update->dirty_stacking_context.insert(this);
+		return;
+	}
+
+	if (ElementInvalidations* invalidations = FrameStatisticsAccess::GetInvalidations(this))
+		invalidations->num_stacking_context_dirties += 1;
+
 	// Find the first ancestor that has a local stacking context, that is our stacking context parent.
 	Element* stacking_context_parent = this;
 	while (stacking_context_parent && !stacking_context_parent->local_stacking_context)
@@ -2364,31 +2917,161 @@ void Element::DirtyStackingContext()
 
 	if (stacking_context_parent)
 		stacking_context_parent->stacking_context_dirty = true;
+
+	// The change may affect the bounds of any ancestor stacking context.
+	DirtyHitTestIndices();
+	DirtyRenderCache();
+}
+
+void Element::DirtyRenderCache()
+{
+	DirtyRenderBounds();
+
+	if (!ElementRenderCache::AnyCaches() && !ElementScrollLayer::AnyLayers())
+		return;
+
+	if (batch_update)
+	{
+		batch_update->dirty_render_cache.insert(this);
+		return;
+	}
+
+	for (Element* element = this; element; element = element->parent)
+	{
+		if (element->meta->render_cache)
+			element->meta->render_cache->Dirty();
+	}
+	ElementScrollLayer::DirtyAncestors(this);
+}
+
+ElementBatchUpdate::ElementBatchUpdate()
+{
+	batch_update.InitializeIfEmpty();
+	batch_update->depth += 1;
+}
+
+ElementBatchUpdate::~ElementBatchUpdate()
+{
+	batch_update->depth -= 1;
+	if (batch_update->depth == 0)
+		Element::FlushBatchUpdate();
+}
+
+void Element::FlushBatchUpdate()
+{
+	// End the batch before propagating the changes, so that any further changes are propagated immediately.
+	const UnorderedSet<Element*> dirty_layout_elements = std::move(batch_update->dirty_layout);
+	const UnorderedSet<Element*> dirty_stacking_context_elements = std::move(batch_update->dirty_stacking_context);
+	const UnorderedSet<Element*> dirty_render_cache_elements = std::move(batch_update->dirty_render_cache);
+	batch_update.Shutdown();
+
+	// Each walk up the tree stops at the first ancestor already flagged by a previous walk, its own ancestors have been flagged as well.
+	UnorderedSet<Element*> visited;
+	for (Element* element : dirty_layout_elements)
+	{
+		Element* document = element->GetOwnerDocument();
+		if (!document)
+			continue;
+
+		element->dirty_layout = true;
+		for (Element* ancestor = element->parent; ancestor && ancestor != document; ancestor = ancestor->parent)
+		{
+			if (!visited.insert(ancestor).second)
+				break;
+			ancestor->dirty_child_layout = true;
+		}
+		document->dirty_child_layout = true;
+	}
+
+	visited.clear();
+	for (Element* element : dirty_stacking_context_elements)
+	{
+		Element* stacking_context_parent = element;
+		while (stacking_context_parent && !stacking_context_parent->local_stacking_context && visited.insert(stacking_context_parent).second)
+			stacking_context_parent = stacking_context_parent->GetParentNode();
+
+		if (stacking_context_parent && stacking_context_parent->local_stacking_context)
+			stacking_context_parent->stacking_context_dirty = true;
+
+		element->DirtyRenderBounds();
+		element->DirtyHitTestIndices();
+	}
+
+	if (!ElementRenderCache::AnyCaches() && !ElementScrollLayer::AnyLayers())
+		return;
+
+	visited.clear();
+	auto DirtyRenderCaches = [&visited](Element* element) {
+		// Whether a scroll layer is affected depends on the dirtied element, thus its ancestors are walked separately.
+		ElementScrollLayer::DirtyAncestors(element);
+		for (; element && visited.insert(element).second; element = element->parent)
+		{
+			if (element->meta->render_cache)
+				element->meta->render_cache->Dirty();
+		}
+	};
+	for (Element* element : dirty_stacking_context_elements)
+		DirtyRenderCaches(element);
+	for (Element* element : dirty_render_cache_elements)
+		DirtyRenderCaches(element);
+}
+
+void Element::DirtyRenderBounds()
+{
+	if (dirty_render_bounds)
+		return;
+
+	dirty_render_bounds = true;
+
+	if (meta->render_bounds.Valid())
+	{
+		if (Context* context = GetContext())
+			context->AddDirtyRegion(meta->render_bounds);
+	}
+}
+
+void Element::DirtyRenderBoundsRecursive()
+{
+	DirtyRenderBounds();
+
+	for (const ElementPtr& child : children)
+		child->DirtyRenderBoundsRecursive();
 }
 
 void Element::DirtyDefinition(DirtyNodes dirty_nodes)
 {
+	// Anything that can change the definition of this element can generally also change the definition of any descendants due to the presence of
+	// RCSS descendant or child combinators, or the definition of its siblings due to sibling combinators.
 	switch (dirty_nodes)
 	{
-	case DirtyNodes::Self: dirty_definition = true; break;
-	case DirtyNodes::SelfAndSiblings:
-		dirty_definition = true;
-		if (parent)
-			parent->dirty_child_definitions = true;
-		break;
+	case DirtyNodes::Self: DirtyDefinition(SelectorDependency::Self | SelectorDependency::Descendants); break;
+	case DirtyNodes::SelfAndSiblings: DirtyDefinition(SelectorDependency::All); break;
 	}
 }
 
+void Element::DirtyDefinition(SelectorDependency dependency)
+{
+	const bool siblings = ((dependency & SelectorDependency::Siblings) != SelectorDependency::None && parent);
+	ElementStyle::OnDefinitionDirtied(siblings ? parent : this);
+
+	if ((dependency & SelectorDependency::Self) != SelectorDependency::None)
+		dirty_definition = true;
+	if ((dependency & SelectorDependency::Descendants) != SelectorDependency::None)
+		dirty_child_definitions = true;
+	if (siblings)
+		parent->dirty_child_definitions = true;
+}
+
 void Element::UpdateDefinition()
 {
 	if (dirty_definition)
 	{
 		dirty_definition = false;
 
-		// Dirty definition implies all our descendent elements. Anything that can change the definition of this element can also change the
-		// definition of any descendants due to the presence of RCSS descendant or child combinators. In principle this also applies to sibling
-		// combinators, but those are handled during the DirtyDefinition call.
-		dirty_child_definitions = true;
+		if (DocumentFrameStatistics* statistics = FrameStatisticsAccess::Get(this))
+			statistics->num_definition_updates += 1;
+		if (ElementInvalidations* invalidations = FrameStatisticsAccess::GetInvalidations(this))
+			invalidations->num_definition_updates += 1;
 
 		GetStyle()->UpdateDefinition();
 	}
@@ -2397,7 +3080,10 @@ void Element::UpdateDefinition()
 	{
 		dirty_child_definitions = false;
 		for (const ElementPtr& child : children)
+		{
 			child->dirty_definition = true;
+			child->dirty_child_definitions = true;
+		}
 	}
 }
 
@@ -2499,6 +3185,8 @@ ElementAnimationList::iterator Element::StartAnimation(PropertyId property_id, c
 		it = animations.end();
 	}
 
+	RegisterAnimations();
+
 	return it;
 }
 
@@ -2560,6 +3248,8 @@ bool Element::StartTransition(const Transition& transition, const Property& star
 	else
 		animations.erase(it);
 
+	RegisterAnimations();
+
 	return result;
 }
 
@@ -2684,12 +3374,19 @@ void Element::AdvanceAnimations()
 	if (!animations.empty())
 	{
 		double time = Clock::GetElapsedTime();
+		const PropertyMap& inline_properties = meta->style.GetLocalStyleProperties();
 
 		for (auto& animation : animations)
 		{
 			Property property = animation.UpdateAndGetProperty(time, *this);
-			if (property.unit != Unit::UNKNOWN)
-				SetProperty(animation.GetPropertyId(), property);
+			if (property.unit == Unit::UNKNOWN)
+				continue;
+
+			// Skip unchanged values, such as during held keys, so that they don't cause the property to be recomputed.
+			const PropertyId id = animation.GetPropertyId();
+			auto it = inline_properties.find(id);
+			if (it == inline_properties.end() || !(it->second == property))
+				SetProperty(id, property);
 		}
 
 		// Move all completed animations to the end of the list
@@ -2723,14 +3420,84 @@ void Element::AdvanceAnimations()
 	}
 }
 
+void Element::RegisterAnimations()
+{
+	if (animations_registered || animations.empty())
+		return;
+
+	if (Context* context = GetContext())
+	{
+		context->animated_elements.push_back(GetObserverPtr());
+		animations_registered = true;
+	}
+}
+
+void Element::SkipStyleUpdates()
+{
+	// Descendants of skipped elements are always skipped as well.
+	if (skipped_style)
+		return;
+
+	skipped_style = true;
+	for (const ElementPtr& child : children)
+		child->SkipStyleUpdates();
+}
+
+void Element::UpdateSkippedStyle()
+{
+	Context* context = GetContext();
+	if (!context)
+		return;
+
+	if (parent && parent->skipped_style)
+		parent->UpdateSkippedStyle();
+
+	// Remain skipped, as we may be dirtied again while hidden. Clear the flag meanwhile so that property change handlers can read our values.
+	skipped_style = false;
+	UpdateProperties(context->GetDensityIndependentPixelRatio(), Vector2f(context->GetDimensions()));
+	skipped_style = true;
+}
+
+void Element::UpdateLazyContents()
+{
+	for (const Element* element = this; element; element = element->parent)
+	{
+		if (element->meta->computed_values.display() == Style::Display::None)
+			return;
+	}
+
+	// Keep the contents lazy until a later update when the update budget has been used up.
+	Context* context = GetContext();
+	if (context && context->IsUpdateBudgetExceeded())
+	{
+		context->RequestNextUpdate(0);
+		return;
+	}
+
+	RMLUI_ZoneScopedN("LazyContents");
+
+	const String rml = GetAttribute<String>("rmlui-lazy-rml", "");
+	RemoveAttribute("rmlui-lazy-rml");
+	Factory::InstanceElementText(this, rml);
+
+	// Construct the data views of the new elements right away, as is done when loading documents, so that their contents are not displayed
+	// before being bound.
+	if (data_model)
+		data_model->Update(false);
+}
+
 void Element::DirtyTransformState(bool perspective_dirty, bool transform_dirty)
 {
 	dirty_perspective |= perspective_dirty;
 	dirty_transform |= transform_dirty;
+	dirty_local_transform |= transform_dirty;
 }
 
 void Element::UpdateTransformState()
 {
+	// The transforms are positioned by our absolute offset, any change to it dirties the transform state.
+	UpdateAbsoluteOffsetAndRenderBoxData();
+
 	if (!dirty_perspective && !dirty_transform)
 		return;
 
@@ -2796,62 +3563,81 @@ void Element::UpdateTransformState()
 		// so that we only need to consider our local transform and combine it with our parent's transform and perspective matrices.
 		bool had_transform = (transform_state && transform_state->GetTransform());
 
-		bool have_transform = false;
-		Matrix4f transform = Matrix4f::Identity();
-
-		if (TransformPtr transform_ptr = computed.transform())
+		// The local transform only depends on our own properties and box. When only our ancestors have changed, the local transform from the
+		// previous update is combined with the new parent transform.
+		if (dirty_local_transform)
 		{
-			// First find the current element's transform
-			const int n = transform_ptr->GetNumPrimitives();
-			for (int i = 0; i < n; ++i)
-			{
-				const TransformPrimitive& primitive = transform_ptr->GetPrimitive(i);
-				Matrix4f matrix = TransformUtilities::ResolveTransform(primitive, *this);
-				transform *= matrix;
-				have_transform = true;
-			}
+			bool have_local_transform = false;
+			Matrix4f transform = Matrix4f::Identity();
 
-			if (have_transform)
+			if (TransformPtr transform_ptr = computed.transform())
 			{
-				// Compute the transform origin
-				Vector3f transform_origin(pos.x + size.x * 0.5f, pos.y + size.y * 0.5f, 0);
+				// First find the current element's transform
+				const int n = transform_ptr->GetNumPrimitives();
+				for (int i = 0; i < n; ++i)
+				{
+					const TransformPrimitive& primitive = transform_ptr->GetPrimitive(i);
+					Matrix4f matrix = TransformUtilities::ResolveTransform(primitive, *this);
+					transform *= matrix;
+					have_local_transform = true;
+				}
 
-				if (computed.transform_origin_x().type == Style::TransformOrigin::Percentage)
-					transform_origin.x = pos.x + computed.transform_origin_x().value * size.x * 0.01f;
-				else
-					transform_origin.x = pos.x + computed.transform_origin_x().value;
+				if (have_local_transform)
+				{
+					// Compute the transform origin
+					Vector3f transform_origin(pos.x + size.x * 0.5f, pos.y + size.y * 0.5f, 0);
 
-				if (computed.transform_origin_y().type == Style::TransformOrigin::Percentage)
-					transform_origin.y = pos.y + computed.transform_origin_y().value * size.y * 0.01f;
-				else
-					transform_origin.y = pos.y + computed.transform_origin_y().value;
+					if (computed.transform_origin_x().type == Style::TransformOrigin::Percentage)
+						transform_origin.x = pos.x + computed.transform_origin_x().value * size.x * 0.01f;
+					else
+						transform_origin.x = pos.x + computed.transform_origin_x().value;
+
+					if (computed.transform_origin_y().type == Style::TransformOrigin::Percentage)
+						transform_origin.y = pos.y + computed.transform_origin_y().value * size.y * 0.01f;
+					else
+						transform_origin.y = pos.y + computed.transform_origin_y().value;
+
+					transform_origin.z = computed.transform_origin_z();
+
+					// Make the transformation apply relative to the transform origin
+					transform = Matrix4f::Translate(transform_origin) * transform * Matrix4f::Translate(-transform_origin);
+				}
 
-				transform_origin.z = computed.transform_origin_z();
+				// We may want to include the local offsets here, as suggested by the CSS specs, so that the local transform is applied after the
+				// offset I believe the motivation is. Then we would need to subtract the absolute zero-offsets during geometry submit whenever we
+				// have transforms.
+			}
 
-				// Make the transformation apply relative to the transform origin
-				transform = Matrix4f::Translate(transform_origin) * transform * Matrix4f::Translate(-transform_origin);
+			if (have_local_transform)
+			{
+				if (!transform_state)
+					transform_state = MakeUnique<TransformState>();
+				transform_state->SetLocalTransform(&transform);
 			}
+			else if (transform_state)
+				transform_state->SetLocalTransform(nullptr);
 
-			// We may want to include the local offsets here, as suggested by the CSS specs, so that the local transform is applied after the offset I
-			// believe the motivation is. Then we would need to subtract the absolute zero-offsets during geometry submit whenever we have transforms.
+			dirty_local_transform = false;
 		}
 
+		const Matrix4f* local_transform = (transform_state ? transform_state->GetLocalTransform() : nullptr);
+		bool have_transform = (local_transform != nullptr);
+		Matrix4f transform = (local_transform ? *local_transform : Matrix4f::Identity());
+
 		if (parent && parent->transform_state)
 		{
-			// Apply the parent's local perspective and transform.
-			// @performance: If we have no local transform and no parent perspective, we can effectively just point to the parent transform instead of
-			// copying it.
+			// Apply the parent's local perspective and transform, skipping the multiplication when we have no transform of our own yet.
 			const TransformState& parent_state = *parent->transform_state;
 
 			if (auto parent_perspective = parent_state.GetLocalPerspective())
 			{
-				transform = *parent_perspective * transform;
+				transform = (have_transform ? *parent_perspective * transform : *parent_perspective);
 				have_transform = true;
 			}
 
 			if (auto parent_transform = parent_state.GetTransform())
 			{
-				transform = *parent_transform * transform;
+				transform = (have_transform ? *parent_transform * transform : *parent_transform);
 				have_transform = true;
 			}
 		}
@@ -2867,13 +3653,18 @@ void Element::UpdateTransformState()
 			transform_state->SetTransform(nullptr);
 
 		perspective_or_transform_changed |= (had_transform != have_transform);
+
+		dirty_transform = false;
 	}
 
 	// A change in perspective or transform will require an update to children transforms as well.
 	if (perspective_or_transform_changed)
 	{
+		DirtyClipCache();
+		DirtyHitTestIndices();
+		DirtyRenderCache();
 		for (size_t i = 0; i < children.size(); i++)
-			children[i]->DirtyTransformState(false, true);
+			children[i]->dirty_transform = true;
 	}
 
 	// No reason to keep the transform state around if transform and perspective have been removed.
@@ -2883,21 +3674,26 @@ void Element::UpdateTransformState()
 	}
 }
 
-void Element::OnStyleSheetChangeRecursive()
+void Element::OnStyleSheetChangeRecursive(const StyleSheetContainer& style_sheet_container)
 {
 	meta->effects.DirtyEffects();
 
+	// Only elements matched by the rules that changed need to look up their definition again. Their ancestor filters are validated against
+	// the latest names of all their ancestors when the definition is updated, thus the descendants of unaffected elements are unaffected.
+	if (style_sheet_container.IsDefinitionAffectedByChange(this))
+		DirtyDefinition(SelectorDependency::Self);
+
 	OnStyleSheetChange();
 
 	// Now dirty all of our descendants.
 	const int num_children = GetNumChildren(true);
 	for (int i = 0; i < num_children; ++i)
-		GetChild(i)->OnStyleSheetChangeRecursive();
+		GetChild(i)->OnStyleSheetChangeRecursive(style_sheet_container);
 }
 
 void Element::OnDpRatioChangeRecursive()
 {
-	meta->effects.DirtyEffects();
+	meta->effects.DirtyEffectsRescale();
 	GetStyle()->DirtyPropertiesWithUnits(Unit::DP_SCALABLE_LENGTH);
 
 	OnDpRatioChange();
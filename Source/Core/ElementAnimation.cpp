@@ -650,6 +650,7 @@ bool ElementAnimation::InternalAddKey(float time, const Property& in_property, E
 	keys.emplace_back(time, in_property, tween);
 	Property& property = keys.back().property;
 	bool result = true;
+	curve_dirty = true;
 
 	if (property.unit == Unit::TRANSFORM)
 	{
@@ -691,6 +692,36 @@ bool ElementAnimation::AddKey(float target_time, const Property& in_property, El
 	return true;
 }
 
+void ElementAnimation::CompileCurve()
+{
+	curve_dirty = false;
+	curve_type = CurveType::Generic;
+	curve_numbers.clear();
+	curve_colours.clear();
+
+	const Unit unit = keys[0].property.unit;
+	const bool all_same_unit =
+		std::all_of(keys.begin(), keys.end(), [unit](const AnimationKey& key) { return key.property.unit == unit; });
+	if (!all_same_unit)
+		return;
+
+	if (Any(unit & Unit::NUMERIC))
+	{
+		curve_type = CurveType::Number;
+		curve_unit = unit;
+		curve_numbers.reserve(keys.size());
+		for (const AnimationKey& key : keys)
+			curve_numbers.push_back(key.property.GetNumericValue().number);
+	}
+	else if (unit == Unit::COLOUR)
+	{
+		curve_type = CurveType::Colour;
+		curve_colours.reserve(keys.size());
+		for (const AnimationKey& key : keys)
+			curve_colours.push_back(ColourToLinearSpace(key.property.value.Get<Colourb>()));
+	}
+}
+
 float ElementAnimation::GetInterpolationFactorAndKeys(int* out_key0, int* out_key1) const
 {
 	float t = time_since_iteration_start;
@@ -777,6 +808,16 @@ Property ElementAnimation::UpdateAndGetProperty(double world_time, Element& elem
 
 	float alpha = GetInterpolationFactorAndKeys(&key0, &key1);
 
+	if (curve_dirty)
+		CompileCurve();
+
+	switch (curve_type)
+	{
+	case CurveType::Number: return Property{Mix(curve_numbers[key0], curve_numbers[key1], alpha), curve_unit};
+	case CurveType::Colour: return Property{ColourFromLinearSpace(Mix(curve_colours[key0], curve_colours[key1], alpha)), Unit::COLOUR};
+	case CurveType::Generic: break;
+	}
+
 	Property result = InterpolateProperties(keys[key0].property, keys[key1].property, alpha, element, keys[0].property.definition);
 
 	return result;
@@ -37,7 +37,17 @@ private:
 	bool animation_complete = false;
 	ElementAnimationOrigin origin = ElementAnimationOrigin::User;
 
+	// Keys which are all numbers of the same unit, or all colours, are compiled into plain values once the keys are complete. Then, they are
+	// interpolated without dispatching on the property types, and colours without converting them to linear space every update.
+	enum class CurveType : uint8_t { Generic, Number, Colour };
+	CurveType curve_type = CurveType::Generic;
+	bool curve_dirty = true;
+	Unit curve_unit = Unit::UNKNOWN;
+	Vector<float> curve_numbers;
+	Vector<Colourf> curve_colours;
+
 	bool InternalAddKey(float time, const Property& property, Element& element, Tween tween);
+	void CompileCurve();
 
 	float GetInterpolationFactorAndKeys(int* out_key0, int* out_key1) const;
 
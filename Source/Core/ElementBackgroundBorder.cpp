@@ -7,38 +7,91 @@
 #include "../../Include/RmlUi/Core/MeshUtilities.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/RenderManager.h"
+#include "BackgroundBorderCache.h"
 #include "BoxShadowCache.h"
+#include "ElementMeta.h"
+#include "FrameStatisticsAccess.h"
+#include "GeometryBackgroundBorder.h"
 #include "GeometryBoxShadow.h"
 
 namespace Rml {
 
+// Compiles the rounded box shader for rendering the fill area of the render box to the clip mask, when supported by the render interface.
+// The shader only supports circular corners, thus elliptic inner corners of unequal adjacent borders use their smaller radius.
+static CompiledShader CompileRoundedBoxClipShader(RenderManager& render_manager, const RenderBox& render_box)
+{
+	const BorderMetrics metrics = GeometryBackgroundBorder::ComputeBorderMetrics(Vector2f(0.f), render_box.GetBorderWidths(),
+		render_box.GetFillSize(), render_box.GetBorderRadius());
+
+	auto CircularRadius = [&](int corner) { return Math::Max(Math::Min(metrics.inner_radii[corner].x, metrics.inner_radii[corner].y), 0.f); };
+	const Vector4f radius(CircularRadius(0), CircularRadius(1), CircularRadius(2), CircularRadius(3));
+
+	if (radius.x + radius.y + radius.z + radius.w <= 0.f || !render_manager.SupportsShader("rounded-box") ||
+		!render_manager.SupportsShader("rounded-box-clip-mask"))
+		return {};
+
+	return render_manager.CompileShader("rounded-box",
+		Dictionary{
+			{"dimensions", Variant(render_box.GetFillSize())},
+			{"radius", Variant(radius)},
+			{"border_widths", Variant(Vector4f(0.f))},
+			{"background_color", Variant(Colourf(1.f))},
+		});
+}
+
 ElementBackgroundBorder::ElementBackgroundBorder() {}
 
-void ElementBackgroundBorder::Render(Element* element)
+void ElementBackgroundBorder::PrepareRender(Element* element)
 {
 	if (background_dirty || border_dirty)
 	{
+		bool released_clip_geometry = false;
 		for (auto& background : backgrounds)
 		{
 			if (background.first != BackgroundType::BackgroundBorder)
+			{
+				released_clip_geometry |= (background.first != BackgroundType::BoxShadowAndBackgroundBorder && background.second.geometry);
 				background.second.geometry.Release();
+				background.second.shader.Release();
+			}
 		}
 
+		// Clip geometry may be referenced by the retained clipping state of descendants, make sure it is regenerated.
+		if (released_clip_geometry)
+			element->DirtyClipCache();
+
 		GenerateGeometry(element);
 
 		background_dirty = false;
 		border_dirty = false;
+		colors_dirty = false;
+	}
+	else if (colors_dirty)
+	{
+		// The clip geometry only depends on the shape of the element, thus it can be kept together with any clipping state referencing it.
+		GenerateGeometry(element);
+		colors_dirty = false;
 	}
+}
+
+void ElementBackgroundBorder::Render(Element* element)
+{
+	PrepareRender(element);
 
 	if (Background* shadow = GetBackground(BackgroundType::BoxShadowAndBackgroundBorder))
 	{
+		// Elements larger than the shared shadow texture draw it with their own stretched geometry.
 		const Vector2f offset = element->GetAbsoluteOffset(BoxArea::Border);
-		shadow->box_shadow_and_background_border->geometry.Render(offset, shadow->box_shadow_and_background_border->texture);
+		const BoxShadowRenderable& renderable = *shadow->box_shadow_and_background_border;
+		(shadow->geometry ? shadow->geometry : renderable.geometry).Render(offset, renderable.texture);
 	}
 	else if (Background* background = GetBackground(BackgroundType::BackgroundBorder))
 	{
-		const Vector2f offset = element->GetAbsoluteOffset(BoxArea::Border);
-		background->geometry.Render(offset);
+		if (background->background_border)
+		{
+			const Vector2f offset = element->GetAbsoluteOffset(BoxArea::Border);
+			background->background_border->geometry.Render(offset, {}, background->background_border->shader);
+		}
 	}
 }
 
@@ -52,7 +105,12 @@ void ElementBackgroundBorder::DirtyBorder()
 	border_dirty = true;
 }
 
-Geometry* ElementBackgroundBorder::GetClipGeometry(Element* element, BoxArea clip_area)
+void ElementBackgroundBorder::DirtyColors()
+{
+	colors_dirty = true;
+}
+
+Geometry* ElementBackgroundBorder::GetClipGeometry(Element* element, BoxArea clip_area, const CompiledShader*& out_shader)
 {
 	BackgroundType type = {};
 	switch (clip_area)
@@ -64,15 +122,27 @@ Geometry* ElementBackgroundBorder::GetClipGeometry(Element* element, BoxArea cli
 	}
 
 	RenderManager* render_manager = element->GetRenderManager();
-	Geometry& geometry = GetOrCreateBackground(type).geometry;
-	if (render_manager && !geometry)
+	Background& background = GetOrCreateBackground(type);
+	if (render_manager && !background.geometry)
 	{
-		Mesh mesh = geometry.Release(Geometry::ReleaseMode::ClearMesh);
-		MeshUtilities::GenerateBackground(mesh, element->GetRenderBox(clip_area), ColourbPremultiplied(255));
-		geometry = render_manager->MakeGeometry(std::move(mesh));
+		const RenderBox render_box = element->GetRenderBox(clip_area);
+		Mesh mesh = background.geometry.Release(Geometry::ReleaseMode::ClearMesh);
+		background.shader = CompileRoundedBoxClipShader(*render_manager, render_box);
+		if (background.shader)
+		{
+			const Vector2f fill_size = render_box.GetFillSize();
+			MeshUtilities::GenerateQuad(mesh, render_box.GetBorderOffset() + render_box.GetFillOffset(), fill_size, ColourbPremultiplied(255),
+				Vector2f(0.f), fill_size);
+		}
+		else
+		{
+			MeshUtilities::GenerateBackground(mesh, render_box, ColourbPremultiplied(255));
+		}
+		background.geometry = render_manager->MakeGeometry(std::move(mesh));
 	}
 
-	return &geometry;
+	out_shader = (background.shader ? &background.shader : nullptr);
+	return &background.geometry;
 }
 
 ElementBackgroundBorder::Background* ElementBackgroundBorder::GetBackground(BackgroundType type)
@@ -105,6 +175,11 @@ void ElementBackgroundBorder::GenerateGeometry(Element* element)
 	if (!render_manager)
 		return;
 
+	if (DocumentFrameStatistics* statistics = FrameStatisticsAccess::Get(element))
+		statistics->num_background_border_rebuilds += 1;
+	if (ElementInvalidations* invalidations = FrameStatisticsAccess::GetInvalidations(element))
+		invalidations->num_geometry_rebuilds += 1;
+
 	const ComputedValues& computed = element->GetComputedValues();
 	const bool has_box_shadow = computed.has_box_shadow();
 
@@ -113,28 +188,23 @@ void ElementBackgroundBorder::GenerateGeometry(Element* element)
 		// The box shadow geometry also includes the element's background and border, thus we can skip the normal background generation.
 		EraseBackground(BackgroundType::BackgroundBorder);
 		Background& shadow_background = GetOrCreateBackground(BackgroundType::BoxShadowAndBackgroundBorder);
-		shadow_background.box_shadow_and_background_border = BoxShadowCache::GetHandle(element, computed);
+		Vector2f stretch;
+		shadow_background.box_shadow_and_background_border = BoxShadowCache::GetHandle(element, computed, stretch);
+
+		Mesh mesh = shadow_background.geometry.Release(Geometry::ReleaseMode::ClearMesh);
+		if (shadow_background.box_shadow_and_background_border && stretch != Vector2f(0.f))
+		{
+			GeometryBoxShadow::GenerateMesh(mesh, shadow_background.box_shadow_and_background_border->cache_key, stretch);
+			shadow_background.geometry = render_manager->MakeGeometry(std::move(mesh));
+		}
 		return;
 	}
 
 	EraseBackground(BackgroundType::BoxShadowAndBackgroundBorder);
 
-	const float opacity = computed.opacity();
-	ColourbPremultiplied background_color = computed.background_color().ToPremultiplied(opacity);
-	Array<ColourbPremultiplied, 4> border_colors = {
-		computed.border_top_color().ToPremultiplied(opacity),
-		computed.border_right_color().ToPremultiplied(opacity),
-		computed.border_bottom_color().ToPremultiplied(opacity),
-		computed.border_left_color().ToPremultiplied(opacity),
-	};
-
-	Geometry& geometry = GetOrCreateBackground(BackgroundType::BackgroundBorder).geometry;
-	Mesh mesh = geometry.Release(Geometry::ReleaseMode::ClearMesh);
-
-	for (int i = 0; i < element->GetNumBoxes(); i++)
-		MeshUtilities::GenerateBackgroundBorder(mesh, element->GetRenderBox(BoxArea::Padding, i), background_color, border_colors.data());
-
-	geometry = render_manager->MakeGeometry(std::move(mesh));
+	// Elements with identical boxes and colors share the same geometry, such as the cells of a grid.
+	Background& background = GetOrCreateBackground(BackgroundType::BackgroundBorder);
+	background.background_border = BackgroundBorderCache::GetHandle(element, computed);
 }
 
 } // namespace Rml
@@ -1,28 +1,38 @@
 #pragma once
 
 #include "../../Include/RmlUi/Core/CallbackTexture.h"
+#include "../../Include/RmlUi/Core/CompiledFilterShader.h"
 #include "../../Include/RmlUi/Core/Geometry.h"
 #include "../../Include/RmlUi/Core/Types.h"
 
 namespace Rml {
 
+struct BackgroundBorderRenderable;
 struct BoxShadowRenderable;
 
 class ElementBackgroundBorder {
 public:
 	ElementBackgroundBorder();
+	// Regenerates the background and border geometry if dirty, this is also done as part of rendering.
+	void PrepareRender(Element* element);
 	void Render(Element* element);
 
 	void DirtyBackground();
 	void DirtyBorder();
+	// Marks the colors of the background and border as changed, while their shapes are unchanged.
+	void DirtyColors();
 
-	Geometry* GetClipGeometry(Element* element, BoxArea clip_area);
+	// Returns the geometry to render to the clip mask for the given area. The shape of the mask is evaluated by the shader set in
+	// 'out_shader' if any, otherwise it is given by the geometry.
+	Geometry* GetClipGeometry(Element* element, BoxArea clip_area, const CompiledShader*& out_shader);
 
 private:
 	enum class BackgroundType { BackgroundBorder, BoxShadowAndBackgroundBorder, ClipBorder, ClipPadding, ClipContent, Count };
 	struct Background {
 		Geometry geometry;
 		Texture texture;
+		CompiledShader shader;
+		SharedPtr<BackgroundBorderRenderable> background_border;
 		SharedPtr<BoxShadowRenderable> box_shadow_and_background_border;
 	};
 
@@ -34,6 +44,7 @@ private:
 
 	bool background_dirty = false;
 	bool border_dirty = false;
+	bool colors_dirty = false;
 
 	StableMap<BackgroundType, Background> backgrounds;
 };
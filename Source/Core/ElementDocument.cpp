@@ -3,7 +3,6 @@
 #include "../../Include/RmlUi/Core/ElementText.h"
 #include "../../Include/RmlUi/Core/Factory.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
-#include "../../Include/RmlUi/Core/StreamMemory.h"
 #include "../../Include/RmlUi/Core/StyleSheet.h"
 #include "../../Include/RmlUi/Core/StyleSheetContainer.h"
 #include "DocumentHeader.h"
@@ -191,24 +190,28 @@ void ElementDocument::ProcessHeader(const DocumentHeader* document_header)
 	// on the element; all of its children will inherit it by default.
 	SharedPtr<StyleSheetContainer> new_style_sheet;
 
-	// Combine any inline sheets.
+	// Parse any linked sheets not yet loaded, concurrently when possible.
+	StringList linked_sheets;
+	for (const DocumentHeader::Resource& rcss : header.rcss)
+	{
+		if (!rcss.is_inline)
+			linked_sheets.push_back(rcss.path);
+	}
+	StyleSheetFactory::LoadStyleSheetContainers(linked_sheets);
+
+	// Combine any inline sheets. Both inline and linked sheets are parsed only once, and their media blocks shared with all documents using
+	// them.
 	for (const DocumentHeader::Resource& rcss : header.rcss)
 	{
 		if (rcss.is_inline)
 		{
-			auto inline_sheet = MakeShared<StyleSheetContainer>();
-			auto stream = MakeUnique<StreamMemory>((const byte*)rcss.content.c_str(), rcss.content.size());
-			stream->SetSourceURL(rcss.path);
-
-			if (inline_sheet->LoadStyleSheetContainer(stream.get(), rcss.line))
+			if (const StyleSheetContainer* inline_sheet = StyleSheetFactory::GetInlineStyleSheetContainer(rcss.content, rcss.path, rcss.line))
 			{
 				if (new_style_sheet)
 					new_style_sheet->MergeStyleSheetContainer(*inline_sheet);
 				else
-					new_style_sheet = std::move(inline_sheet);
+					new_style_sheet = inline_sheet->CombineStyleSheetContainer(StyleSheetContainer());
 			}
-
-			stream.reset();
 		}
 		else
 		{
@@ -308,7 +311,8 @@ void ElementDocument::ReloadStyleSheet()
 		return;
 	}
 
-	Factory::ClearStyleSheetCache();
+	// Only the sheets whose files changed are parsed again, the others are shared with the current style sheet.
+	StyleSheetFactory::ReloadStyleSheetContainers();
 	Factory::ClearTemplateCache();
 	ElementPtr temp_doc = Factory::InstanceDocumentStream(nullptr, stream.get(), context->GetDocumentsBaseTag());
 	if (!temp_doc)
@@ -317,7 +321,22 @@ void ElementDocument::ReloadStyleSheet()
 		return;
 	}
 
-	SetStyleSheetContainer(rmlui_static_cast<ElementDocument*>(temp_doc.get())->style_sheet_container);
+	SharedPtr<StyleSheetContainer> new_style_sheet = rmlui_static_cast<ElementDocument*>(temp_doc.get())->style_sheet_container;
+	if (!style_sheet_container || !new_style_sheet)
+	{
+		SetStyleSheetContainer(std::move(new_style_sheet));
+		return;
+	}
+
+	// Restyle only the elements matched by rules which differ from the current style sheet.
+	const bool changed_style_sheet = new_style_sheet->UpdateCompiledStyleSheet(context, *style_sheet_container);
+	style_sheet_container = std::move(new_style_sheet);
+
+	if (changed_style_sheet)
+	{
+		ElementStyle::DirtyAncestorFilters();
+		OnStyleSheetChangeRecursive(*style_sheet_container);
+	}
 }
 
 void ElementDocument::DirtyMediaQueries()
@@ -328,8 +347,8 @@ void ElementDocument::DirtyMediaQueries()
 
 		if (changed_style_sheet)
 		{
-			DirtyDefinition(Element::DirtyNodes::Self);
-			OnStyleSheetChangeRecursive();
+			ElementStyle::DirtyAncestorFilters();
+			OnStyleSheetChangeRecursive(*style_sheet_container);
 		}
 	}
 }
@@ -422,8 +441,12 @@ void ElementDocument::Hide()
 {
 	SetProperty(PropertyId::Visibility, Property(Style::Visibility::Hidden));
 
-	// We should update the document now, so that the (un)focusing will get the correct visibility
-	UpdateDocument();
+	// We should update the document now, so that the (un)focusing will get the correct visibility. The layout is left as is when deferred, it is
+	// formatted again once we are shown if anything changed meanwhile.
+	if (context && context->GetDeferHiddenLayout())
+		Update(context->GetDensityIndependentPixelRatio(), Vector2f(context->GetDimensions()));
+	else
+		UpdateDocument();
 
 	DispatchEvent(EventId::Hide, Dictionary());
 
@@ -490,16 +513,18 @@ void ElementDocument::UpdateLayout()
 {
 	// Note: Carefully consider when to call this function for performance reasons.
 	// Ideally, only called once per update loop.
+	if (!layout_dirty)
+	{
+		// Changes contained inside layout boundaries can be formatted locally, otherwise we need to format the whole document.
+		layout_dirty = !LayoutEngine::FormatDirtyLayoutBoundaries(this);
+	}
+
 	if (layout_dirty)
 	{
 		RMLUI_ZoneScoped;
 		RMLUI_ZoneText(source_url.c_str(), source_url.size());
 
-		Vector2f containing_block(0, 0);
-		if (GetParentNode() != nullptr)
-			containing_block = GetParentNode()->GetBox().GetSize();
-
-		LayoutEngine::FormatElement(this, containing_block);
+		LayoutEngine::FormatElement(this, GetLayoutContainingBlock());
 
 		// Ignore dirtied layout during document formatting. Layouting must not require re-iteration.
 		// In particular, scrollbars being enabled may set the dirty flag, but this case is already handled within the layout engine.
@@ -507,6 +532,39 @@ void ElementDocument::UpdateLayout()
 	}
 }
 
+Vector2f ElementDocument::GetLayoutContainingBlock()
+{
+	Vector2f containing_block(0, 0);
+	if (GetParentNode() != nullptr)
+		containing_block = GetParentNode()->GetBox().GetSize();
+	return containing_block;
+}
+
+bool ElementDocument::IsLayoutDependentOnViewport() const
+{
+	// Viewport units and media queries are not considered here, they change the computed values when the viewport is resized, which in turn
+	// dirty the layout as needed. Only the sizes and box edges resolved against the containing block are affected directly.
+	using Type = Style::LengthPercentageAuto::Type;
+	using EdgeType = Style::LengthPercentage::Type;
+	const ComputedValues& computed = GetComputedValues();
+
+	const bool stretched_height = (computed.height().type == Type::Auto && computed.top().type != Type::Auto && computed.bottom().type != Type::Auto);
+	if (computed.width().type != Type::Length || computed.height().type == Type::Percentage || stretched_height)
+		return true;
+
+	if (computed.min_width().type == EdgeType::Percentage || computed.max_width().type == EdgeType::Percentage ||
+		computed.min_height().type == EdgeType::Percentage || computed.max_height().type == EdgeType::Percentage)
+		return true;
+
+	// Automatic margins center the document within the viewport, which is part of its layout.
+	if (computed.margin_top().type != Type::Length || computed.margin_right().type != Type::Length || computed.margin_bottom().type != Type::Length ||
+		computed.margin_left().type != Type::Length)
+		return true;
+
+	return computed.padding_top().type == EdgeType::Percentage || computed.padding_right().type == EdgeType::Percentage ||
+		computed.padding_bottom().type == EdgeType::Percentage || computed.padding_left().type == EdgeType::Percentage;
+}
+
 void ElementDocument::UpdatePosition()
 {
 	if (position_dirty)
@@ -1,5 +1,6 @@
 #include "ElementEffects.h"
 #include "../../Include/RmlUi/Core/ComputedValues.h"
+#include "../../Include/RmlUi/Core/Context.h"
 #include "../../Include/RmlUi/Core/Decorator.h"
 #include "../../Include/RmlUi/Core/Element.h"
 #include "../../Include/RmlUi/Core/ElementDocument.h"
@@ -7,9 +8,53 @@
 #include "../../Include/RmlUi/Core/Filter.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/StyleSheet.h"
+#include "../../Include/RmlUi/Core/Utilities.h"
+#include "ControlledLifetimeResource.h"
+#include "EffectsCache.h"
 
 namespace Rml {
 
+struct SharedDecoratorDataKey {
+	const Decorator* decorator;
+	BoxArea paint_area;
+	size_t data_key;
+};
+inline bool operator==(const SharedDecoratorDataKey& a, const SharedDecoratorDataKey& b)
+{
+	return a.decorator == b.decorator && a.paint_area == b.paint_area && a.data_key == b.data_key;
+}
+
+} // namespace Rml
+
+namespace std {
+
+template <>
+struct hash<::Rml::SharedDecoratorDataKey> {
+	size_t operator()(const ::Rml::SharedDecoratorDataKey& key) const noexcept
+	{
+		using namespace ::Rml::Utilities;
+		size_t seed = hash<const void*>{}(key.decorator);
+		HashCombine(seed, int(key.paint_area));
+		HashCombine(seed, key.data_key);
+		return seed;
+	}
+};
+
+} // namespace std
+
+namespace Rml {
+
+struct SharedDecoratorData {
+	DecoratorDataHandle handle;
+	int num_references;
+};
+
+struct ElementEffectsData {
+	UnorderedMap<SharedDecoratorDataKey, SharedDecoratorData> shared_decorator_data;
+};
+
+static ControlledLifetimeResource<ElementEffectsData> effects_data;
+
 ElementEffects::ElementEffects(Element* _element) : element(_element) {}
 
 ElementEffects::~ElementEffects()
@@ -17,13 +62,56 @@ ElementEffects::~ElementEffects()
 	ReleaseEffects();
 }
 
+void ElementEffects::Initialize()
+{
+	effects_data.Initialize();
+}
+
+void ElementEffects::Shutdown()
+{
+	effects_data.Shutdown();
+}
+
 void ElementEffects::InstanceEffects()
+{
+	if (rescale_pending && !effects_dirty)
+	{
+		Context* context = element->GetContext();
+		if (context && context->IsUpdateBudgetExceeded())
+		{
+			context->RequestNextUpdate(0);
+			return;
+		}
+		effects_dirty = true;
+	}
+
+	InstanceDirtyEffects();
+
+	if (effects_textures_loading && !effects_data_dirty)
+	{
+		bool loading = false;
+		for (const DecoratorEntryList* list : {&decorators, &mask_images})
+		{
+			for (const DecoratorEntry& entry : *list)
+				loading |= entry.decorator->IsTextureLoading();
+		}
+
+		if (!loading)
+		{
+			effects_textures_loading = false;
+			DirtyEffectsData();
+		}
+	}
+}
+
+void ElementEffects::InstanceDirtyEffects()
 {
 	if (!effects_dirty)
 		return;
 
 	effects_dirty = false;
 	effects_data_dirty = true;
+	rescale_pending = false;
 
 	RMLUI_ZoneScopedC(0xB22222);
 	ReleaseEffects();
@@ -78,6 +166,8 @@ void ElementEffects::InstanceEffects()
 				{
 					DecoratorEntry entry;
 					entry.decorator_data = 0;
+					entry.shared_data = false;
+					entry.data_key = 0;
 					entry.decorator = decorator;
 					entry.paint_area = decorators_ptr->list[i].paint_area;
 					if (entry.paint_area == BoxArea::Auto)
@@ -105,17 +195,19 @@ void ElementEffects::InstanceEffects()
 			FilterEntryList& list = (id == PropertyId::Filter ? filters : backdrop_filters);
 			list.reserve(filters_ptr->list.size());
 
-			for (const FilterDeclaration& declaration : filters_ptr->list)
+			Vector<SharedPtr<const Filter>> filter_instances;
+			EffectsCache::InstanceFilters(*filters_ptr, filter_instances);
+
+			for (size_t i = 0; i < filter_instances.size(); i++)
 			{
-				SharedPtr<const Filter> filter = declaration.instancer->InstanceFilter(declaration.type, declaration.properties);
-				if (filter)
+				if (filter_instances[i])
 				{
-					list.push_back({std::move(filter), CompiledFilter{}});
+					list.push_back({std::move(filter_instances[i]), CompiledFilter{}});
 				}
 				else
 				{
 					const auto& source = property->source;
-					Log::Message(Log::LT_WARNING, "Filter '%s' in '%s' could not be instanced, declared at %s:%d", declaration.type.c_str(),
+					Log::Message(Log::LT_WARNING, "Filter '%s' in '%s' could not be instanced, declared at %s:%d", filters_ptr->list[i].type.c_str(),
 						filters_ptr->value.c_str(), source ? source->path.c_str() : "", source ? source->line_number : -1);
 				}
 			}
@@ -125,24 +217,29 @@ void ElementEffects::InstanceEffects()
 
 void ElementEffects::ReloadEffectsData()
 {
-	if (effects_data_dirty)
+	// Keep the current data while waiting for a rescale, even if the element has been resized meanwhile.
+	if (effects_data_dirty && !rescale_pending)
 	{
 		effects_data_dirty = false;
+		effects_textures_loading = false;
+		if (Context* context = element->GetContext())
+			data_dp_ratio = context->GetDensityIndependentPixelRatio();
 
 		bool decorator_data_failed = false;
 		for (DecoratorEntryList* list : {&decorators, &mask_images})
 		{
 			for (DecoratorEntry& decorator : *list)
 			{
-				const DecoratorDataHandle old_data = decorator.decorator_data;
+				const DecoratorEntry old_entry = decorator;
 
-				decorator.decorator_data = decorator.decorator->GenerateElementData(element, decorator.paint_area);
+				GenerateDecoratorData(decorator);
 				if (!decorator.decorator_data)
 					decorator_data_failed = true;
+				if (decorator.decorator->IsTextureLoading())
+					effects_textures_loading = true;
 
 				// Release old element data after generating new data, so that the decorator can reuse any cache.
-				if (old_data)
-					decorator.decorator->ReleaseElementData(old_data);
+				ReleaseDecoratorData(old_entry);
 			}
 		}
 
@@ -170,10 +267,7 @@ void ElementEffects::ReleaseEffects()
 	for (DecoratorEntryList* list : {&decorators, &mask_images})
 	{
 		for (DecoratorEntry& decorator : *list)
-		{
-			if (decorator.decorator_data)
-				decorator.decorator->ReleaseElementData(decorator.decorator_data);
-		}
+			ReleaseDecoratorData(decorator);
 		list->clear();
 	}
 
@@ -181,15 +275,73 @@ void ElementEffects::ReleaseEffects()
 	backdrop_filters.clear();
 }
 
+void ElementEffects::GenerateDecoratorData(DecoratorEntry& entry)
+{
+	entry.shared_data = entry.decorator->GetElementDataKey(element, entry.paint_area, entry.data_key);
+	if (!entry.shared_data)
+	{
+		entry.decorator_data = entry.decorator->GenerateElementData(element, entry.paint_area);
+		return;
+	}
+
+	// Data generated while textures are loading must not be shared with data generated after they have been loaded.
+	if (entry.decorator->IsTextureLoading())
+		Utilities::HashCombine(entry.data_key, true);
+
+	SharedDecoratorData& shared = effects_data->shared_decorator_data[{entry.decorator.get(), entry.paint_area, entry.data_key}];
+	if (shared.num_references == 0)
+		shared.handle = entry.decorator->GenerateElementData(element, entry.paint_area);
+
+	shared.num_references += 1;
+	entry.decorator_data = shared.handle;
+}
+
+void ElementEffects::ReleaseDecoratorData(const DecoratorEntry& entry)
+{
+	if (!entry.shared_data)
+	{
+		if (entry.decorator_data)
+			entry.decorator->ReleaseElementData(entry.decorator_data);
+		return;
+	}
+
+	auto& shared_decorator_data = effects_data->shared_decorator_data;
+	auto it = shared_decorator_data.find({entry.decorator.get(), entry.paint_area, entry.data_key});
+	RMLUI_ASSERT(it != shared_decorator_data.end());
+
+	SharedDecoratorData& shared = it->second;
+	shared.num_references -= 1;
+	if (shared.num_references == 0)
+	{
+		if (shared.handle)
+			entry.decorator->ReleaseElementData(shared.handle);
+		shared_decorator_data.erase(it);
+	}
+}
+
 void ElementEffects::RenderEffects(RenderStage render_stage)
 {
-	InstanceEffects();
+	InstanceDirtyEffects();
 	ReloadEffectsData();
 
 	if (!decorators.empty())
 	{
 		if (render_stage == RenderStage::Decoration)
 		{
+			// Decorators waiting for a rescale are scaled about the element's border box, as an approximation of their new look.
+			RenderManager* render_manager = element->GetRenderManager();
+			Context* context = element->GetContext();
+			const float scale = (rescale_pending && context ? context->GetDensityIndependentPixelRatio() / data_dp_ratio : 1.f);
+			const Matrix4f initial_transform = (render_manager ? render_manager->GetState().transform : Matrix4f::Identity());
+			const bool scaled = (render_manager && scale != 1.f);
+			if (scaled)
+			{
+				const Vector2f origin = element->GetAbsoluteOffset(BoxArea::Border);
+				const Matrix4f transform = initial_transform * Matrix4f::Translate(origin.x, origin.y, 0) * Matrix4f::Scale(scale, scale, 1) *
+					Matrix4f::Translate(-origin.x, -origin.y, 0);
+				render_manager->SetTransform(&transform);
+			}
+
 			// Render the decorators attached to this element in its current state.
 			// Render from back to front for correct render order.
 			for (int i = (int)decorators.size() - 1; i >= 0; i--)
@@ -198,6 +350,9 @@ void ElementEffects::RenderEffects(RenderStage render_stage)
 				if (decorator.decorator_data)
 					decorator.decorator->RenderElement(element, decorator.decorator_data);
 			}
+
+			if (scaled)
+				render_manager->SetTransform(initial_transform == Matrix4f::Identity() ? nullptr : &initial_transform);
 		}
 	}
 
@@ -314,6 +469,16 @@ void ElementEffects::RenderEffects(RenderStage render_stage)
 	}
 }
 
+void ElementEffects::ExtendInkOverflow(Rectanglef& region)
+{
+	InstanceEffects();
+
+	for (const auto& filter : filters)
+		filter.filter->ExtendInkOverflow(element, region);
+	for (const auto& filter : backdrop_filters)
+		filter.filter->ExtendInkOverflow(element, region);
+}
+
 void ElementEffects::DirtyEffects()
 {
 	effects_dirty = true;
@@ -324,4 +489,13 @@ void ElementEffects::DirtyEffectsData()
 	effects_data_dirty = true;
 }
 
+void ElementEffects::DirtyEffectsRescale()
+{
+	// Without any current effects there is nothing to show meanwhile, reload them as usual.
+	if (decorators.empty() && mask_images.empty() && filters.empty() && backdrop_filters.empty())
+		effects_dirty = true;
+	else
+		rescale_pending = true;
+}
+
 } // namespace Rml
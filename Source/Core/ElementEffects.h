@@ -20,16 +20,28 @@ public:
 	ElementEffects(Element* element);
 	~ElementEffects();
 
+	static void Initialize();
+	static void Shutdown();
+
+	// Instances dirty effects. Effects waiting for a rescale are instanced here as well, unless the update budget of the context is exceeded.
 	void InstanceEffects();
 
 	void RenderEffects(RenderStage render_stage);
 
+	// Extends the given region by the ink overflow of the filters, and by the area read by the backdrop filters.
+	void ExtendInkOverflow(Rectanglef& region);
+
 	// Mark effects as dirty and force them to reset themselves.
 	void DirtyEffects();
 	// Mark the element data of effects as dirty.
 	void DirtyEffectsData();
+	// Mark effects as dirty after a change of the dp ratio. The current effects are rendered scaled to the new dp ratio until the effects have
+	// been instanced again during an update.
+	void DirtyEffectsRescale();
 
 private:
+	// Releases existing effects and instances them again from the element's properties, if dirty.
+	void InstanceDirtyEffects();
 	// Releases existing element data of effects, and regenerates it.
 	void ReloadEffectsData();
 	// Releases all existing effects and their element data.
@@ -39,9 +51,16 @@ private:
 		SharedPtr<const Decorator> decorator;
 		DecoratorDataHandle decorator_data;
 		BoxArea paint_area;
+		// Set when the element data is shared with other elements, identified by the key from the decorator.
+		bool shared_data;
+		size_t data_key;
 	};
 	using DecoratorEntryList = Vector<DecoratorEntry>;
 
+	// Generates the element data of the decorator, or shares it with other elements when the decorator allows it.
+	void GenerateDecoratorData(DecoratorEntry& entry);
+	static void ReleaseDecoratorData(const DecoratorEntry& entry);
+
 	struct FilterEntry {
 		SharedPtr<const Filter> filter;
 		CompiledFilter compiled;
@@ -60,6 +79,12 @@ private:
 	bool effects_dirty = false;
 	// If set, element data of all decorators need to be regenerated.
 	bool effects_data_dirty = false;
+	// If set, some decorator textures were still loading when the element data was generated, it is regenerated once they have been loaded.
+	bool effects_textures_loading = false;
+	// If set, the effects are to be instanced again during the next update within the budget, meanwhile the current ones are kept.
+	bool rescale_pending = false;
+	// The dp ratio of the context when the element data was last generated.
+	float data_dp_ratio = 1.f;
 };
 
 } // namespace Rml
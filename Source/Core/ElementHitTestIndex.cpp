@@ -0,0 +1,236 @@
+#include "ElementHitTestIndex.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "ElementMeta.h"
+#include "TransformState.h"
+#include <float.h>
+
+namespace Rml {
+
+// The grid is only built for stacking contexts with at least this number of entries, smaller ones are tested linearly.
+static constexpr int GridMinEntries = 32;
+static constexpr int GridMaxCellsPerAxis = 1024;
+
+static Rectanglef GetUnbounded()
+{
+	return Rectanglef::FromCorners(Vector2f(-FLT_MAX), Vector2f(FLT_MAX));
+}
+static bool IsUnbounded(const Rectanglef& rectangle)
+{
+	return rectangle.p1.x == FLT_MAX;
+}
+
+// Points are projected onto the plane of transformed elements during hit testing, thus their boxes do not bound them in window coordinates.
+static bool HasTransform(const Element* element)
+{
+	const TransformState* state = element->GetTransformState();
+	return state && state->GetTransform();
+}
+
+// Returns the union of the border boxes of the element, matching the test in Element::IsPointWithinElement().
+static Rectanglef GetBorderBounds(Element* element)
+{
+	const Vector2f position = element->GetAbsoluteOffset(BoxArea::Border);
+	Rectanglef result = Rectanglef::FromPositionSize(position, element->GetBox().GetSize(BoxArea::Border));
+
+	for (int i = 1; i < element->GetNumBoxes(); i++)
+	{
+		Vector2f box_offset;
+		const Box& box = element->GetBox(i, box_offset);
+		result = result.Join(Rectanglef::FromPositionSize(position + box_offset, box.GetSize(BoxArea::Border)));
+	}
+
+	return result;
+}
+
+static Vector2i GetCell(Vector2f point, Vector2f origin, Vector2f cell_size, Vector2i num_cells)
+{
+	const Vector2f cell = (point - origin) / cell_size;
+	return Vector2i(Math::Clamp(Math::RoundDownToInteger(cell.x), 0, num_cells.x - 1), Math::Clamp(Math::RoundDownToInteger(cell.y), 0, num_cells.y - 1));
+}
+
+const ElementHitTestIndex& ElementHitTestIndex::Get(Element* element, uint64_t context_generation)
+{
+	RMLUI_ASSERT(element->local_stacking_context);
+
+	UniquePtr<ElementHitTestIndex>& index = element->meta->hit_test_index;
+	if (!index)
+		index = MakeUnique<ElementHitTestIndex>();
+
+	if (index->generation != context_generation || element->stacking_context_dirty)
+		index->Build(element, context_generation);
+
+	return *index;
+}
+
+void ElementHitTestIndex::Build(Element* element, uint64_t context_generation)
+{
+	if (element->stacking_context_dirty)
+		element->BuildLocalStackingContext();
+
+	const ElementList& stacking_context = element->stacking_context;
+	const int num_entries = (int)stacking_context.size();
+
+	entry_bounds.resize(num_entries);
+	unbounded_entries.clear();
+	cell_offsets.clear();
+	cell_entries.clear();
+
+	bool bounded = !HasTransform(element);
+	bounds = GetBorderBounds(element);
+	grid_bounds = Rectanglef::MakeInvalid();
+	Vector2f total_entry_size;
+	int num_bounded_entries = 0;
+
+	for (int i = 0; i < num_entries; i++)
+	{
+		Element* child = stacking_context[i];
+
+		bool child_bounded = !HasTransform(child);
+		Rectanglef child_bounds;
+		if (child_bounded)
+		{
+			child_bounds = GetBorderBounds(child);
+
+			// Descendants in the child's own stacking context may overflow it.
+			if (child->local_stacking_context)
+			{
+				const ElementHitTestIndex& child_index = Get(child, context_generation);
+				child_bounded = !IsUnbounded(child_index.bounds);
+				child_bounds = child_index.bounds;
+			}
+		}
+
+		if (!child_bounded)
+		{
+			entry_bounds[i] = GetUnbounded();
+			unbounded_entries.push_back(i);
+			bounded = false;
+			continue;
+		}
+
+		entry_bounds[i] = child_bounds;
+		bounds = bounds.Join(child_bounds);
+		grid_bounds = (num_bounded_entries == 0 ? child_bounds : grid_bounds.Join(child_bounds));
+		total_entry_size += child_bounds.Size();
+		num_bounded_entries += 1;
+	}
+
+	if (!bounded)
+		bounds = GetUnbounded();
+
+	generation = context_generation;
+
+	if (num_entries < GridMinEntries || num_bounded_entries == 0)
+		return;
+
+	// Size the cells after the average entry, so that most entries only cover a few cells, while limiting the number of cells to the
+	// number of entries.
+	const Vector2f extent = grid_bounds.Size();
+	const Vector2f average_size = total_entry_size / float(num_bounded_entries);
+	auto GetNumCells = [](float extent, float average_size) {
+		if (extent <= 0.f)
+			return 1;
+		return Math::Clamp(Math::RoundUpToInteger(extent / Math::Max(average_size, 1.f)), 1, GridMaxCellsPerAxis);
+	};
+
+	num_cells = Vector2i(GetNumCells(extent.x, average_size.x), GetNumCells(extent.y, average_size.y));
+	while (num_cells.x * num_cells.y > num_entries)
+	{
+		int& largest = (num_cells.x > num_cells.y ? num_cells.x : num_cells.y);
+		largest = (largest + 1) / 2;
+	}
+
+	cell_size = Vector2f(extent.x > 0.f ? extent.x / float(num_cells.x) : 1.f, extent.y > 0.f ? extent.y / float(num_cells.y) : 1.f);
+
+	// Count the entries of each cell, then fill them in stacking order.
+	cell_offsets.resize(num_cells.x * num_cells.y + 1, 0);
+	for (int pass = 0; pass < 2; pass++)
+	{
+		for (int i = 0; i < num_entries; i++)
+		{
+			const Rectanglef& rectangle = entry_bounds[i];
+			if (IsUnbounded(rectangle))
+				continue;
+
+			const Vector2i cell_min = GetCell(rectangle.p0, grid_bounds.p0, cell_size, num_cells);
+			const Vector2i cell_max = GetCell(rectangle.p1, grid_bounds.p0, cell_size, num_cells);
+			for (int y = cell_min.y; y <= cell_max.y; y++)
+			{
+				for (int x = cell_min.x; x <= cell_max.x; x++)
+				{
+					const int cell = y * num_cells.x + x;
+					if (pass == 0)
+						cell_offsets[cell + 1] += 1;
+					else
+						cell_entries[cell_offsets[cell]++] = i;
+				}
+			}
+		}
+
+		if (pass == 0)
+		{
+			for (size_t cell = 1; cell < cell_offsets.size(); cell++)
+				cell_offsets[cell] += cell_offsets[cell - 1];
+			cell_entries.resize(cell_offsets.back());
+		}
+	}
+
+	// The fill pass advanced each offset to the start of the following cell, shift them back.
+	for (size_t cell = cell_offsets.size() - 1; cell > 0; cell--)
+		cell_offsets[cell] = cell_offsets[cell - 1];
+	cell_offsets[0] = 0;
+}
+
+ElementHitTestIndex::Candidates::Candidates(const ElementHitTestIndex& index, Vector2f point) : index(index), point(point)
+{
+	if (index.cell_offsets.empty())
+	{
+		next_entry = (int)index.entry_bounds.size() - 1;
+		return;
+	}
+
+	unbounded_begin = index.unbounded_entries.data();
+	unbounded_end = unbounded_begin + index.unbounded_entries.size();
+
+	if (index.grid_bounds.Contains(point))
+	{
+		const Vector2i cell = GetCell(point, index.grid_bounds.p0, index.cell_size, index.num_cells);
+		const int cell_index = cell.y * index.num_cells.x + cell.x;
+		cell_begin = index.cell_entries.data() + index.cell_offsets[cell_index];
+		cell_end = index.cell_entries.data() + index.cell_offsets[cell_index + 1];
+	}
+}
+
+bool ElementHitTestIndex::Candidates::Next(int& out_index)
+{
+	if (index.cell_offsets.empty())
+	{
+		for (; next_entry >= 0; next_entry--)
+		{
+			if (index.entry_bounds[next_entry].Contains(point))
+			{
+				out_index = next_entry--;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	while (cell_begin != cell_end || unbounded_begin != unbounded_end)
+	{
+		// Merge the two lists, taking the entry with the highest stacking order first.
+		const bool take_cell = (unbounded_begin == unbounded_end || (cell_begin != cell_end && *(cell_end - 1) > *(unbounded_end - 1)));
+		const int entry = (take_cell ? *(--cell_end) : *(--unbounded_end));
+
+		if (index.entry_bounds[entry].Contains(point))
+		{
+			out_index = entry;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+} // namespace Rml
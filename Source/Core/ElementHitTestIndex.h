@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Rectangle.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class Element;
+
+/**
+    Spatial index over the stacking context of an element, used to accelerate hit testing.
+
+    Each entry of the stacking context is bounded by its border boxes, joined with the bounds of its own stacking context
+    if it has one. Large stacking contexts additionally bucket their entries in a uniform grid, so that only entries near
+    the point need to be tested. Entries affected by transforms cannot be bounded in window coordinates, they are always
+    tested. The indices of a context are invalidated by any change to the geometry or stacking context of its elements, by
+    bumping the hit test generation of the context, and rebuilt lazily during the next hit test.
+ */
+
+class ElementHitTestIndex {
+public:
+	// Iterates the entries of the stacking context which may contain a point, from the top-most to the bottom-most entry.
+	class Candidates {
+	public:
+		// Returns the next candidate as an index into the stacking context, or false if there are no more candidates.
+		bool Next(int& out_index);
+
+	private:
+		Candidates(const ElementHitTestIndex& index, Vector2f point);
+
+		const ElementHitTestIndex& index;
+		Vector2f point;
+		// The remaining entries of the grid cell and of the unbounded entries, each iterated from the back.
+		const int* cell_begin = nullptr;
+		const int* cell_end = nullptr;
+		const int* unbounded_begin = nullptr;
+		const int* unbounded_end = nullptr;
+		// The next entry to test when iterating all entries, or -1 when using the grid.
+		int next_entry = -1;
+
+		friend class ElementHitTestIndex;
+	};
+
+	// Returns the index of an element with a local stacking context, which is rebuilt first together with the stacking context if
+	// they are out of date. The generation is the current hit test generation of the element's context.
+	static const ElementHitTestIndex& Get(Element* element, uint64_t context_generation);
+
+	// Returns false if the point is definitely outside the element and all of its stacking context descendants.
+	bool MayContain(Vector2f point) const { return bounds.Contains(point); }
+
+	Candidates GetCandidates(Vector2f point) const { return Candidates(*this, point); }
+
+private:
+	void Build(Element* element, uint64_t context_generation);
+
+	uint64_t generation = 0;
+
+	// The bounds of the element and all of its stacking context descendants.
+	Rectanglef bounds;
+	// The bounds of each entry in the stacking context.
+	Vector<Rectanglef> entry_bounds;
+	// Entries without bounds, by ascending stacking order.
+	Vector<int> unbounded_entries;
+
+	// The grid of bounded entries, only used for large stacking contexts.
+	Rectanglef grid_bounds;
+	Vector2i num_cells;
+	Vector2f cell_size;
+	// The entries of cell 'i' are located in the range [cell_offsets[i], cell_offsets[i + 1]) of 'cell_entries', by ascending stacking order.
+	Vector<int> cell_offsets;
+	Vector<int> cell_entries;
+};
+
+} // namespace Rml
@@ -1,5 +1,6 @@
 #include "../../Include/RmlUi/Core/ElementInstancer.h"
 #include "../../Include/RmlUi/Core/ElementText.h"
+#include "../../Include/RmlUi/Core/MemoryStatistics.h"
 #include "ControlledLifetimeResource.h"
 #include "Pool.h"
 #include "XMLParseTools.h"
@@ -9,8 +10,8 @@ namespace Rml {
 ElementInstancer::~ElementInstancer() {}
 
 struct ElementInstancerPools {
-	Pool<Element> pool_element{200, true};
-	Pool<ElementText> pool_text_default{200, true};
+	Pool<Element> pool_element;
+	Pool<ElementText> pool_text_default;
 
 	bool IsEmpty() const { return pool_element.GetNumAllocatedObjects() == 0 && pool_text_default.GetNumAllocatedObjects() == 0; }
 };
@@ -52,9 +53,24 @@ void ElementInstancerText::ReleaseElement(Element* element)
 	element_instancer_pools->pool_text_default.DestroyAndDeallocate(rmlui_static_cast<ElementText*>(element));
 }
 
-void Detail::InitializeElementInstancerPools()
+void Detail::InitializeElementInstancerPools(int pool_size)
 {
+	constexpr int default_pool_size = 200;
 	element_instancer_pools.InitializeIfEmpty();
+	// Does nothing if the pools were leaked during an earlier shutdown, they then keep their previous size.
+	element_instancer_pools->pool_element.Initialise(pool_size > 0 ? pool_size : default_pool_size, true);
+	element_instancer_pools->pool_text_default.Initialise(pool_size > 0 ? pool_size : default_pool_size, true);
+}
+
+void Detail::GetElementInstancerPoolStats(Vector<MemoryPoolStats>& out_pools)
+{
+	if (!element_instancer_pools)
+		return;
+
+	const Pool<Element>& pool_element = element_instancer_pools->pool_element;
+	const Pool<ElementText>& pool_text = element_instancer_pools->pool_text_default;
+	out_pools.push_back(MemoryPoolStats{"Element", pool_element.GetNumAllocatedObjects(), pool_element.GetSize(), pool_element.GetReservedBytes()});
+	out_pools.push_back(MemoryPoolStats{"ElementText", pool_text.GetNumAllocatedObjects(), pool_text.GetSize(), pool_text.GetReservedBytes()});
 }
 
 void Detail::ShutdownElementInstancerPools()
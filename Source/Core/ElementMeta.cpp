@@ -4,9 +4,12 @@ namespace Rml {
 
 ControlledLifetimeResource<ElementMetaPool> ElementMetaPool::element_meta_pool;
 
-void ElementMetaPool::Initialize()
+void ElementMetaPool::Initialize(int pool_size)
 {
+	constexpr int default_pool_size = 50;
 	element_meta_pool.InitializeIfEmpty();
+	// Does nothing if the pool was leaked during an earlier shutdown, it then keeps its previous size.
+	element_meta_pool->pool.Initialise(pool_size > 0 ? pool_size : default_pool_size, true);
 }
 
 void ElementMetaPool::Shutdown()
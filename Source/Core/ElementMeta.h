@@ -3,17 +3,71 @@
 #include "../../Include/RmlUi/Core/ComputedValues.h"
 #include "../../Include/RmlUi/Core/Element.h"
 #include "../../Include/RmlUi/Core/ElementScroll.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/RenderManager.h"
 #include "../../Include/RmlUi/Core/Traits.h"
 #include "../../Include/RmlUi/Core/Types.h"
 #include "ControlledLifetimeResource.h"
 #include "ElementBackgroundBorder.h"
 #include "ElementEffects.h"
+#include "ElementHitTestIndex.h"
+#include "ElementQueryIndex.h"
+#include "ElementRenderCache.h"
+#include "ElementScrollLayer.h"
 #include "ElementStyle.h"
 #include "EventDispatcher.h"
 #include "Pool.h"
 
 namespace Rml {
 
+// Retained clipping state of an element, as last submitted to the render manager during Element::Render(). Changes that may affect
+// clipping invalidate the states of the changed element and its descendants. The state of an element is only valid while the state of its
+// parent is, thus invalidation stops at elements which are already invalid.
+struct ElementClipCache {
+	bool valid = false;
+	bool scissoring_enabled = false;
+	Rectanglei clip_region;
+	ClipMaskGeometryList clip_mask_list;
+};
+
+// Sizes of an element as measured by the layout engine for given constraints, retained between layouts. Modes are the layout engine's own
+// measure modes, where any unconstrained size should be passed as zero. Must be cleared whenever the measured contents may change.
+struct ElementLayoutCache {
+	struct Entry {
+		float width, height;
+		int width_mode, height_mode;
+		Vector2f size;
+	};
+	static constexpr int MaxEntries = 4;
+
+	const Vector2f* Find(float width, int width_mode, float height, int height_mode) const
+	{
+		for (int i = 0; i < num_entries; i++)
+		{
+			const Entry& entry = entries[i];
+			if (entry.width == width && entry.width_mode == width_mode && entry.height == height && entry.height_mode == height_mode)
+				return &entry.size;
+		}
+		return nullptr;
+	}
+	void Insert(float width, int width_mode, float height, int height_mode, Vector2f size)
+	{
+		entries[next_entry] = Entry{width, height, width_mode, height_mode, size};
+		next_entry = (next_entry + 1) % MaxEntries;
+		num_entries = Math::Min(num_entries + 1, MaxEntries);
+	}
+	void Clear()
+	{
+		num_entries = 0;
+		next_entry = 0;
+	}
+
+private:
+	Entry entries[MaxEntries];
+	int num_entries = 0;
+	int next_entry = 0;
+};
+
 // Meta objects for element collected in a single struct to reduce memory allocations
 struct ElementMeta {
 	explicit ElementMeta(Element* el) : event_dispatcher(el), style(el), background_border(), effects(el), scroll(el), computed_values(el) {}
@@ -24,13 +78,27 @@ struct ElementMeta {
 	ElementEffects effects;
 	ElementScroll scroll;
 	Style::ComputedValues computed_values;
+	ElementClipCache clip_cache;
+	ElementLayoutCache layout_cache;
+	UniquePtr<ElementHitTestIndex> hit_test_index;
+	// Only set on documents, once queried.
+	UniquePtr<ElementQueryIndex> query_index;
+	UniquePtr<ElementRenderCache> render_cache;
+	UniquePtr<ElementScrollLayer> scroll_layer;
+	// The window area covered by the element when it was last prepared for rendering, invalid if it was not rendered.
+	Rectanglef render_bounds = Rectanglef::MakeInvalid();
+	// The render bounds joined with those of all displayed descendants, invalid if none of them were rendered.
+	Rectanglef subtree_render_bounds = Rectanglef::MakeInvalid();
 };
 
 struct ElementMetaPool {
-	Pool<ElementMeta> pool{50, true};
+	Pool<ElementMeta> pool;
+	// Emptied maps for notifying elements of single attribute changes, kept to reuse their storage.
+	Vector<ElementAttributes> free_changed_attributes;
 
 	static ControlledLifetimeResource<ElementMetaPool> element_meta_pool;
-	static void Initialize();
+	// Allocates the pool in chunks of the given number of objects, or the default size if zero.
+	static void Initialize(int pool_size);
 	static void Shutdown();
 };
 
@@ -0,0 +1,328 @@
+#include "ElementQueryIndex.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/ElementDocument.h"
+#include "ElementMeta.h"
+#include "ElementStyle.h"
+#include "StyleSheetNode.h"
+#include <algorithm>
+
+namespace Rml {
+
+// Candidates up to this number are ordered by sorting their paths from the root, while larger numbers of candidates are ordered by traversing
+// the elements below the root instead.
+static constexpr size_t MaxSortedCandidates = 64;
+
+// Finds the child indices along the path from the root to the element, returns false if the element is not a DOM descendant of the root.
+static bool FindDomPath(const Element* root, const Element* element, Vector<int>& path)
+{
+	path.clear();
+	for (; element != root; element = element->GetParentNode())
+	{
+		const Element* parent = element->GetParentNode();
+		if (!parent)
+			return false;
+
+		const int num_children = parent->GetNumChildren();
+		int index = 0;
+		while (index < num_children && parent->GetChild(index) != element)
+			index++;
+		if (index == num_children)
+			return false;
+
+		path.push_back(index);
+	}
+	std::reverse(path.begin(), path.end());
+	return true;
+}
+
+static bool IsTextElement(const Element* element)
+{
+	return element->GetTagName() == "#text";
+}
+
+ElementQueryIndex& ElementQueryIndex::Get(Element* document)
+{
+	UniquePtr<ElementQueryIndex>& index = document->meta->query_index;
+	if (!index)
+	{
+		index = MakeUnique<ElementQueryIndex>();
+		index->document = document;
+		index->Build(document);
+	}
+	return *index;
+}
+
+ElementQueryIndex* ElementQueryIndex::Find(Element* document)
+{
+	return document->meta->query_index.get();
+}
+
+void ElementQueryIndex::Build(Element* element)
+{
+	AddElement(element);
+	for (const ElementPtr& child : element->children)
+	{
+		if (child->owner_document == child.get())
+			has_nested_documents = true;
+		else
+			Build(child.get());
+	}
+}
+
+void ElementQueryIndex::AddElement(Element* element)
+{
+	if (!element->GetId().empty())
+		ids[element->GetId()].insert(element);
+
+	const ElementStyle& style = element->meta->style;
+	tags[style.GetTagAtom()].insert(element);
+	for (const String& class_name : style.GetClassNameList())
+		classes[class_name].insert(element);
+}
+
+void ElementQueryIndex::RemoveElement(Element* element)
+{
+	auto Erase = [element](auto& map, const auto& key) {
+		auto it = map.find(key);
+		if (it == map.end())
+			return;
+		it->second.erase(element);
+		if (it->second.empty())
+			map.erase(it);
+	};
+
+	if (!element->GetId().empty())
+		Erase(ids, element->GetId());
+
+	const ElementStyle& style = element->meta->style;
+	Erase(tags, style.GetTagAtom());
+	for (const String& class_name : style.GetClassNameList())
+		Erase(classes, class_name);
+}
+
+void ElementQueryIndex::OnIdChange(Element* element, const String& old_id, const String& new_id)
+{
+	if (old_id == new_id)
+		return;
+
+	auto it = ids.find(old_id);
+	if (it != ids.end())
+	{
+		it->second.erase(element);
+		if (it->second.empty())
+			ids.erase(it);
+	}
+
+	if (!new_id.empty())
+		ids[new_id].insert(element);
+}
+
+void ElementQueryIndex::OnClassChange(Element* element, const String& class_name, bool active)
+{
+	if (active)
+	{
+		classes[class_name].insert(element);
+		return;
+	}
+
+	auto it = classes.find(class_name);
+	if (it != classes.end())
+	{
+		it->second.erase(element);
+		if (it->second.empty())
+			classes.erase(it);
+	}
+}
+
+Element* ElementQueryIndex::GetElementById(const String& id) const
+{
+	auto it = ids.find(id);
+	if (it == ids.end())
+		return nullptr;
+
+	const ElementSet& candidates = it->second;
+	Vector<int> path;
+	if (candidates.size() == 1)
+	{
+		Element* element = *candidates.begin();
+		return FindDomPath(document, element, path) ? element : nullptr;
+	}
+
+	ElementList elements;
+	AppendInTreeOrder(elements, document, true, ElementList(candidates.begin(), candidates.end()), Order::BreadthFirst, 1);
+	return elements.empty() ? nullptr : elements.front();
+}
+
+void ElementQueryIndex::GetElementsByTagName(ElementList& elements, Element* root, const String& tag) const
+{
+	const Atom tag_atom = FindAtom(tag);
+	auto it = tags.find(tag_atom);
+	if (tag_atom == Atom::Empty || it == tags.end())
+		return;
+
+	AppendInTreeOrder(elements, root, false, ElementList(it->second.begin(), it->second.end()), Order::BreadthFirst, size_t(-1));
+}
+
+void ElementQueryIndex::GetElementsByClassName(ElementList& elements, Element* root, const String& class_name) const
+{
+	auto it = classes.find(class_name);
+	if (it == classes.end())
+		return;
+
+	AppendInTreeOrder(elements, root, false, ElementList(it->second.begin(), it->second.end()), Order::BreadthFirst, size_t(-1));
+}
+
+bool ElementQueryIndex::QuerySelector(ElementList& elements, Element* root, const Vector<StyleSheetNode*>& nodes, bool first_only) const
+{
+	ElementList candidates;
+	for (const StyleSheetNode* node : nodes)
+	{
+		const ElementSet* node_candidates = nullptr;
+		if (!FindCandidates(node, node_candidates))
+			return false;
+		if (node_candidates)
+			candidates.insert(candidates.end(), node_candidates->begin(), node_candidates->end());
+	}
+
+	// Elements may be candidates of several selectors.
+	if (nodes.size() > 1)
+	{
+		std::sort(candidates.begin(), candidates.end());
+		candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+	}
+
+	ElementList matching_elements;
+	for (Element* element : candidates)
+	{
+		if (IsTextElement(element))
+			continue;
+
+		for (const StyleSheetNode* node : nodes)
+		{
+			if (node->IsApplicable(element, root))
+			{
+				matching_elements.push_back(element);
+				break;
+			}
+		}
+	}
+
+	AppendInTreeOrder(elements, root, false, matching_elements, Order::DepthFirst, first_only ? 1 : size_t(-1));
+	return true;
+}
+
+bool ElementQueryIndex::FindCandidates(const StyleSheetNode* node, const ElementSet*& out_candidates) const
+{
+	// Use the most selective name required by the node, elements without the name can not match it.
+	const CompoundSelector& selector = node->GetSelector();
+	out_candidates = nullptr;
+
+	if (!selector.id.empty())
+	{
+		auto it = ids.find(selector.id);
+		if (it != ids.end())
+			out_candidates = &it->second;
+		return true;
+	}
+
+	if (!selector.class_names.empty())
+	{
+		for (const String& class_name : selector.class_names)
+		{
+			auto it = classes.find(class_name);
+			if (it == classes.end())
+			{
+				out_candidates = nullptr;
+				return true;
+			}
+			if (!out_candidates || it->second.size() < out_candidates->size())
+				out_candidates = &it->second;
+		}
+		return true;
+	}
+
+	if (!selector.tag.empty())
+	{
+		auto it = tags.find(FindAtom(selector.tag));
+		if (it != tags.end())
+			out_candidates = &it->second;
+		return true;
+	}
+
+	return false;
+}
+
+void ElementQueryIndex::AppendInTreeOrder(ElementList& elements, Element* root, bool include_root, const ElementList& candidates, Order order,
+	size_t max_results)
+{
+	if (candidates.size() <= MaxSortedCandidates)
+	{
+		struct Entry {
+			Vector<int> path;
+			Element* element;
+		};
+		Vector<Entry> entries;
+		entries.reserve(candidates.size());
+
+		Vector<int> path;
+		for (Element* element : candidates)
+		{
+			if ((include_root || element != root) && FindDomPath(root, element, path))
+				entries.push_back(Entry{path, element});
+		}
+
+		// A breadth-first traversal visits all shallower elements first, both traversals visit the elements at the same depth by their paths.
+		std::sort(entries.begin(), entries.end(), [order](const Entry& a, const Entry& b) {
+			if (order == Order::BreadthFirst && a.path.size() != b.path.size())
+				return a.path.size() < b.path.size();
+			return a.path < b.path;
+		});
+
+		for (size_t i = 0; i < entries.size() && i < max_results; i++)
+			elements.push_back(entries[i].element);
+		return;
+	}
+
+	ElementSet candidate_set;
+	for (Element* element : candidates)
+		candidate_set.insert(element);
+
+	const size_t max_size = (max_results == size_t(-1) ? max_results : elements.size() + max_results);
+	if (include_root && candidate_set.count(root))
+		elements.push_back(root);
+
+	if (order == Order::BreadthFirst)
+	{
+		Queue<Element*> search_queue;
+		search_queue.push(root);
+		while (!search_queue.empty() && elements.size() < max_size)
+		{
+			Element* element = search_queue.front();
+			search_queue.pop();
+			for (int i = 0; i < element->GetNumChildren(); i++)
+			{
+				Element* child = element->GetChild(i);
+				if (candidate_set.count(child) && elements.size() < max_size)
+					elements.push_back(child);
+				search_queue.push(child);
+			}
+		}
+	}
+	else
+	{
+		Stack<Element*> search_stack;
+		for (int i = root->GetNumChildren() - 1; i >= 0; i--)
+			search_stack.push(root->GetChild(i));
+		while (!search_stack.empty() && elements.size() < max_size)
+		{
+			Element* element = search_stack.top();
+			search_stack.pop();
+			if (candidate_set.count(element))
+				elements.push_back(element);
+			for (int i = element->GetNumChildren() - 1; i >= 0; i--)
+				search_stack.push(element->GetChild(i));
+		}
+	}
+}
+
+} // namespace Rml
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Types.h"
+#include "Atom.h"
+
+namespace Rml {
+
+class Element;
+class StyleSheetNode;
+
+/**
+    Index of the elements of a document by their id, tag, and class names, used to accelerate element queries.
+
+    The index of a document is built during the first query on the document, and from then on kept up to date as elements are attached to and
+    detached from the document, and as their ids and classes change. It holds all elements owned by the document, including non-DOM children,
+    thus the candidates are filtered to the DOM descendants of the queried element. Results are ordered as if found by traversing the elements.
+ */
+
+class ElementQueryIndex {
+public:
+	// Returns the index of the given document, building it first if needed.
+	static ElementQueryIndex& Get(Element* document);
+	// Returns the index of the given document if it has been built, otherwise nullptr.
+	static ElementQueryIndex* Find(Element* document);
+
+	// Adds or removes a single element owned by the document, its descendants are added and removed separately.
+	void AddElement(Element* element);
+	void RemoveElement(Element* element);
+	// Called before the id of an element owned by the document changes.
+	void OnIdChange(Element* element, const String& old_id, const String& new_id);
+	// Called after a class has been set on or removed from an element owned by the document.
+	void OnClassChange(Element* element, const String& class_name, bool active);
+	// Called when another document is attached within this document, the elements owned by it can not be found through this index.
+	void OnNestedDocumentAttach() { has_nested_documents = true; }
+
+	// Returns false if the index can not be used for queries, which should then traverse the elements instead.
+	bool IsUsable() const { return !has_nested_documents; }
+
+	// Returns the first element with the given id, found by a breadth-first traversal of the document including the document itself.
+	Element* GetElementById(const String& id) const;
+	// Appends the DOM descendants of the root element with the given tag or class, ordered as found by a breadth-first traversal.
+	void GetElementsByTagName(ElementList& elements, Element* root, const String& tag) const;
+	void GetElementsByClassName(ElementList& elements, Element* root, const String& class_name) const;
+	// Appends the DOM descendants of the root element matching any of the selector nodes, ordered as found by a depth-first traversal, or only
+	// the first of them. Returns false if the index can not narrow down the candidates, such as for selectors without any id, tag, or class.
+	bool QuerySelector(ElementList& elements, Element* root, const Vector<StyleSheetNode*>& nodes, bool first_only) const;
+
+private:
+	using ElementSet = UnorderedSet<Element*>;
+	enum class Order { BreadthFirst, DepthFirst };
+
+	void Build(Element* element);
+
+	// Returns the set of candidates for the selector node, or nullptr if there are none. Returns false if the node requires none of the names.
+	bool FindCandidates(const StyleSheetNode* node, const ElementSet*& out_candidates) const;
+
+	// Appends the candidates which are DOM descendants of the root, or the root itself if included, in the order of a traversal.
+	static void AppendInTreeOrder(ElementList& elements, Element* root, bool include_root, const ElementList& candidates, Order order,
+		size_t max_results);
+
+	Element* document = nullptr;
+
+	UnorderedMap<String, ElementSet> ids;
+	UnorderedMap<Atom, ElementSet> tags;
+	// Classes are indexed by name, as the class names of elements are not interned.
+	UnorderedMap<String, ElementSet> classes;
+
+	bool has_nested_documents = false;
+};
+
+} // namespace Rml
@@ -0,0 +1,142 @@
+#include "ElementRenderCache.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/ElementUtilities.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/MeshUtilities.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/Texture.h"
+#include "ElementMeta.h"
+
+namespace Rml {
+
+int ElementRenderCache::num_caches = 0;
+
+ElementRenderCache::ElementRenderCache(bool defer_capture) : defer_capture(defer_capture)
+{
+	num_caches += 1;
+}
+
+ElementRenderCache::~ElementRenderCache()
+{
+	num_caches -= 1;
+}
+
+bool ElementRenderCache::Render(Element* element)
+{
+	if (capturing || unsupported)
+		return false;
+
+	RenderManager* render_manager = element->GetRenderManager();
+	if (!render_manager)
+		return false;
+
+	// Find the area covered by the element and its filters within its clipping region, this is the area we capture.
+	Rectanglef bounds_float;
+	if (!ElementUtilities::GetBoundingBox(bounds_float, element, BoxArea::Auto))
+		return false;
+	element->meta->effects.ExtendInkOverflow(bounds_float);
+	Math::ExpandToPixelGrid(bounds_float);
+	const Rectanglei bounds = Rectanglei(bounds_float);
+
+	const Rectanglei initial_scissor_region = render_manager->GetScissorRegion();
+	ElementUtilities::SetClippingRegion(element);
+	render_manager->SetScissorRegion(bounds.IntersectIfValid(render_manager->GetScissorRegion()));
+
+	const RenderState& state = render_manager->GetState();
+	const Rectanglei region = state.scissor_region;
+	if (!region.Valid() || region.Width() <= 0 || region.Height() <= 0)
+		return true;
+
+	const bool changed = (dirty || bounds != captured_bounds || !IsCapturedState(state));
+	if (changed && defer_capture)
+	{
+		// Render normally until the element stays the same as during this frame.
+		texture.Release();
+		geometry.Release();
+		dirty = false;
+		captured_state = state;
+		captured_bounds = bounds;
+		render_manager->SetScissorRegion(initial_scissor_region);
+		return false;
+	}
+
+	// The texture fails to load if it has been released, such as when the render interface context is lost, capture it again in that case.
+	if (changed || !geometry || Texture(texture).GetDimensions() != region.Size())
+	{
+		if (!Capture(element, *render_manager))
+		{
+			// Without layer support the element was rendered directly during the capture, stop caching it from now on.
+			unsupported = true;
+			return true;
+		}
+		captured_bounds = bounds;
+	}
+
+	// The texture is already transformed and clipped, draw it in window coordinates.
+	const Matrix4f transform = state.transform;
+	render_manager->SetTransform(nullptr);
+	geometry.Render(Vector2f(0), texture);
+	render_manager->SetTransform(&transform);
+
+	return true;
+}
+
+bool ElementRenderCache::Capture(Element* element, RenderManager& render_manager)
+{
+	RMLUI_ZoneScoped;
+
+	const RenderState state = render_manager.GetState();
+	const Rectanglei region = state.scissor_region;
+
+	texture.Release();
+	geometry.Release();
+
+	render_manager.PushLayer();
+
+	// Render the element normally into the new layer. This is done outside the texture callback, since rendering may create other callback
+	// textures, such as for box shadows or nested caches.
+	capturing = true;
+	element->Render();
+	capturing = false;
+
+	render_manager.SetState(state);
+
+	// The layer can only be saved while it is on top. If the texture is requested at any other time, such as after the render interface
+	// context is lost, we fail to load it, and capture it again during the next render.
+	texture = render_manager.MakeCallbackTexture([this](const CallbackTextureInterface& texture_interface) -> bool {
+		if (!saving_layer)
+			return false;
+		texture_interface.SaveLayerAsTexture();
+		return true;
+	});
+
+	saving_layer = true;
+	const Vector2i dimensions = Texture(texture).GetDimensions();
+	saving_layer = false;
+
+	render_manager.PopLayer();
+
+	if (dimensions != region.Size())
+	{
+		texture.Release();
+		return false;
+	}
+
+	Mesh mesh;
+	MeshUtilities::GenerateQuad(mesh, Vector2f(region.TopLeft()), Vector2f(region.Size()), ColourbPremultiplied(255));
+	geometry = render_manager.MakeGeometry(std::move(mesh));
+
+	captured_state = state;
+
+	// Textures which are still loading or regenerating are not yet part of the capture, keep capturing until they have been loaded.
+	dirty = render_manager.HasPendingTextures();
+	return true;
+}
+
+bool ElementRenderCache::IsCapturedState(const RenderState& state) const
+{
+	return state.scissor_region == captured_state.scissor_region && state.transform == captured_state.transform &&
+		state.clip_mask_list == captured_state.clip_mask_list;
+}
+
+} // namespace Rml
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/CallbackTexture.h"
+#include "../../Include/RmlUi/Core/Geometry.h"
+#include "../../Include/RmlUi/Core/RenderManager.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class Element;
+
+/**
+    Retained rendering of an element and its stacking context, enabled by the 'render-cache' property.
+
+    The element is rendered once into a layer which is saved as a texture, later frames draw the texture as a single quad.
+    The texture is captured again whenever the element or any of its descendants is dirtied, or when the render state
+    the element is drawn in changes, such as its clipping region or transform. Like filters, the rendered contents are
+    limited to the element's border box, box shadow, and the ink overflow of its filters.
+
+    With deferred capture, as used for 'render-cache: auto', the element is rendered normally while it keeps changing,
+    and only captured once it has stayed unchanged for a frame. Then animated content doesn't pay for a capture every frame.
+ */
+
+class ElementRenderCache {
+public:
+	explicit ElementRenderCache(bool defer_capture = false);
+	~ElementRenderCache();
+
+	// Renders the element from the cache, capturing it first if necessary. Returns false if the element should render itself
+	// normally, which is also the case while it is being captured.
+	bool Render(Element* element);
+
+	// Captures the element again during the next render.
+	void Dirty() { dirty = true; }
+
+	bool IsCaptureDeferred() const { return defer_capture; }
+
+	// Returns true if any element has its rendering cached.
+	static bool AnyCaches() { return num_caches > 0; }
+
+private:
+	// Renders the element into a new layer and saves it as our texture. Returns false if the render interface can't save layers.
+	bool Capture(Element* element, RenderManager& render_manager);
+	bool IsCapturedState(const RenderState& state) const;
+
+	static int num_caches;
+
+	bool defer_capture = false;
+	bool dirty = true;
+	bool capturing = false;
+	bool saving_layer = false;
+	bool unsupported = false;
+
+	// The render state at the time of capture, its scissor region covers the captured area.
+	RenderState captured_state;
+	// The bounds of the element at the time of capture, which may extend beyond its clipping region.
+	Rectanglei captured_bounds;
+	CallbackTexture texture;
+	Geometry geometry;
+};
+
+} // namespace Rml
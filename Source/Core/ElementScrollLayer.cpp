@@ -0,0 +1,224 @@
+#include "ElementScrollLayer.h"
+#include "../../Include/RmlUi/Core/ComputedValues.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/MeshUtilities.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/RenderBox.h"
+#include "../../Include/RmlUi/Core/Texture.h"
+#include "ElementMeta.h"
+
+namespace Rml {
+
+int ElementScrollLayer::num_layers = 0;
+
+ElementScrollLayer::ElementScrollLayer()
+{
+	num_layers += 1;
+}
+
+ElementScrollLayer::~ElementScrollLayer()
+{
+	num_layers -= 1;
+}
+
+bool ElementScrollLayer::Render(Element* element)
+{
+	if (unsupported)
+		return false;
+
+	RenderManager* render_manager = element->GetRenderManager();
+	if (!render_manager)
+		return false;
+
+	// Only contents clipped to the element's box by scissoring alone can be shifted in window coordinates.
+	const RenderState& state = render_manager->GetState();
+	const ComputedValues& computed = element->GetComputedValues();
+	const bool clip_enabled = (computed.overflow_x() != Style::Overflow::Visible || computed.overflow_y() != Style::Overflow::Visible);
+	const bool has_border_radius = (computed.border_top_left_radius() > 0.f || computed.border_top_right_radius() > 0.f ||
+		computed.border_bottom_right_radius() > 0.f || computed.border_bottom_left_radius() > 0.f);
+	if (!clip_enabled || has_border_radius || state.transform != Matrix4f::Identity() || !state.clip_mask_list.empty())
+	{
+		Release();
+		return false;
+	}
+
+	// Find the visible area of the contents, the same way as the clipping region of the contents is found.
+	const BoxArea clip_area = element->GetClipArea();
+	Rectanglef region_float = Rectanglef::FromPositionSize(element->GetAbsoluteOffset(clip_area).Round(),
+		element->GetRenderBox(clip_area).GetFillSize());
+	Math::ExpandToPixelGrid(region_float);
+
+	Rectanglei region = Rectanglei(region_float).IntersectIfValid(state.scissor_region);
+	if (region.Valid())
+		region = region.IntersectIfValid(Rectanglei::FromSize(render_manager->GetViewport()));
+	if (!region.Valid() || region.Width() <= 0 || region.Height() <= 0)
+	{
+		Release();
+		return false;
+	}
+
+	const Vector2i scroll_offset = Vector2i(int(element->GetScrollLeft()), int(element->GetScrollTop()));
+	const Vector2i shift = captured_scroll_offset - scroll_offset;
+
+	// The texture fails to load if it has been released, such as when the render interface context is lost, capture it fully in that case.
+	const bool full_capture = (dirty || !geometry || region != captured_region || Texture(texture).GetDimensions() != region.Size() ||
+		Math::Absolute(shift.x) >= region.Width() || Math::Absolute(shift.y) >= region.Height());
+
+	if (full_capture || shift != Vector2i(0))
+	{
+		Vector<Rectanglei> exposed_regions;
+		if (full_capture)
+		{
+			exposed_regions.push_back(region);
+		}
+		else
+		{
+			// Find the strips uncovered by the shifted texture, without overlap so that nothing is rendered twice.
+			Vector2i remaining_p0 = region.TopLeft();
+			Vector2i remaining_p1 = region.BottomRight();
+			if (shift.y > 0)
+			{
+				exposed_regions.push_back(Rectanglei::FromCorners(region.TopLeft(), {region.Right(), region.Top() + shift.y}));
+				remaining_p0.y += shift.y;
+			}
+			else if (shift.y < 0)
+			{
+				exposed_regions.push_back(Rectanglei::FromCorners({region.Left(), region.Bottom() + shift.y}, region.BottomRight()));
+				remaining_p1.y += shift.y;
+			}
+
+			if (shift.x > 0)
+				exposed_regions.push_back(Rectanglei::FromCorners(remaining_p0, {remaining_p0.x + shift.x, remaining_p1.y}));
+			else if (shift.x < 0)
+				exposed_regions.push_back(Rectanglei::FromCorners({remaining_p1.x + shift.x, remaining_p0.y}, remaining_p1));
+		}
+
+		if (!Capture(element, *render_manager, region, (full_capture ? Vector2i(0) : shift), exposed_regions))
+		{
+			// Without layer support the contents were rendered directly during the capture, stop retaining them from now on.
+			unsupported = true;
+		}
+		else
+		{
+			captured_region = region;
+			captured_scroll_offset = scroll_offset;
+		}
+	}
+
+	if (geometry)
+	{
+		const Rectanglei initial_scissor_region = state.scissor_region;
+		render_manager->SetScissorRegion(region);
+		geometry.Render(Vector2f(0), texture);
+		render_manager->SetScissorRegion(initial_scissor_region);
+	}
+
+	// Elements which stay in place while scrolling, such as the scrollbars, are drawn on top of the contents.
+	for (Element* child : element->stacking_context)
+	{
+		if (!IsScrolledContent(element, child))
+			child->Render();
+	}
+
+	return true;
+}
+
+bool ElementScrollLayer::IsScrolledContent(Element* element, Element* descendant)
+{
+	Element* it = descendant;
+	for (; it && it != element; it = it->offset_parent)
+	{
+		if (it->offset_fixed)
+			return false;
+	}
+	return it == element;
+}
+
+void ElementScrollLayer::DirtyAncestors(Element* element)
+{
+	if (num_layers == 0)
+		return;
+
+	for (Element* ancestor = element->parent; ancestor; ancestor = ancestor->parent)
+	{
+		if (ancestor->meta->scroll_layer && IsScrolledContent(ancestor, element))
+			ancestor->meta->scroll_layer->Dirty();
+	}
+}
+
+bool ElementScrollLayer::Capture(Element* element, RenderManager& render_manager, Rectanglei region, Vector2i shift,
+	const Vector<Rectanglei>& exposed_regions)
+{
+	RMLUI_ZoneScoped;
+
+	const RenderState state = render_manager.GetState();
+	const Rectanglei initial_render_region = render_manager.GetRenderRegion();
+
+	render_manager.PushLayer();
+
+	// Keep the part of the previous capture which is still visible. The texture is drawn in window coordinates.
+	if (geometry && shift != Vector2i(0))
+	{
+		render_manager.SetRenderRegion(Rectanglei::MakeInvalid());
+		render_manager.SetScissorRegion(region);
+		geometry.Render(Vector2f(shift), texture);
+		render_manager.SetState(state);
+	}
+
+	// Render the scrolled contents within each exposed region. The render region is set to the full exposed region, even outside the
+	// initial render region, since all of the layer may be drawn during later frames. The render region also lets us skip the elements
+	// outside the region.
+	for (const Rectanglei& exposed_region : exposed_regions)
+	{
+		render_manager.SetRenderRegion(exposed_region);
+		for (Element* child : element->stacking_context)
+		{
+			if (IsScrolledContent(element, child))
+				child->Render();
+		}
+		render_manager.SetState(state);
+	}
+
+	render_manager.SetRenderRegion(initial_render_region);
+	render_manager.SetScissorRegion(region);
+
+	// The layer can only be saved while it is on top. If the texture is requested at any other time, such as after the render interface
+	// context is lost, we fail to load it, and capture it fully again during the next render.
+	CallbackTexture new_texture = render_manager.MakeCallbackTexture([this](const CallbackTextureInterface& texture_interface) -> bool {
+		if (!saving_layer)
+			return false;
+		texture_interface.SaveLayerAsTexture();
+		return true;
+	});
+
+	saving_layer = true;
+	const Vector2i dimensions = Texture(new_texture).GetDimensions();
+	saving_layer = false;
+
+	render_manager.PopLayer();
+	render_manager.SetState(state);
+
+	Release();
+
+	if (dimensions != region.Size())
+		return false;
+
+	texture = std::move(new_texture);
+
+	Mesh mesh;
+	MeshUtilities::GenerateQuad(mesh, Vector2f(region.TopLeft()), Vector2f(region.Size()), ColourbPremultiplied(255));
+	geometry = render_manager.MakeGeometry(std::move(mesh));
+
+	// Textures which are still loading or regenerating are not yet part of the capture, keep capturing until they have been loaded.
+	dirty = render_manager.HasPendingTextures();
+	return true;
+}
+
+void ElementScrollLayer::Release()
+{
+	texture.Release();
+	geometry.Release();
+}
+
+} // namespace Rml
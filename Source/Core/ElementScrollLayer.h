@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/CallbackTexture.h"
+#include "../../Include/RmlUi/Core/Geometry.h"
+#include "../../Include/RmlUi/Core/RenderManager.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class Element;
+
+/**
+    Retained rendering of the scrolled contents of an element, enabled by 'render-cache: scroll'.
+
+    The visible part of the contents is rendered into a layer which is saved as a texture, later frames draw the texture as a single quad.
+    When the element is scrolled, the previous texture is drawn shifted by the scroll distance into a new layer, and only the newly exposed
+    strips of the contents are rendered. The contents are captured fully again whenever any of them are dirtied, or when the visible area
+    changes. Elements which don't move when scrolling, such as the scrollbars, are always rendered normally on top of the contents.
+
+    Since the texture is shifted in window coordinates, the contents are rendered normally while the element is transformed or clipped by a
+    clip mask, such as from a border-radius.
+ */
+
+class ElementScrollLayer {
+public:
+	ElementScrollLayer();
+	~ElementScrollLayer();
+
+	// Renders the elements of the stacking context of the scroll container. Returns false if they should be rendered normally.
+	bool Render(Element* element);
+
+	// Captures the contents fully again during the next render.
+	void Dirty() { dirty = true; }
+
+	// Returns true if the given descendant of the scroll container moves along with its scrolled contents.
+	static bool IsScrolledContent(Element* element, Element* descendant);
+
+	// Dirties the layers of all ancestors which scroll the given element along with their contents.
+	static void DirtyAncestors(Element* element);
+
+	// Returns true if any element has its scrolled contents retained.
+	static bool AnyLayers() { return num_layers > 0; }
+
+private:
+	// Renders the exposed regions of the contents into a new layer, on top of the previous texture shifted by the given offset, and saves the
+	// result as our texture. Returns false if the render interface can't save layers.
+	bool Capture(Element* element, RenderManager& render_manager, Rectanglei region, Vector2i shift, const Vector<Rectanglei>& exposed_regions);
+
+	void Release();
+
+	static int num_layers;
+
+	bool dirty = true;
+	bool saving_layer = false;
+	bool unsupported = false;
+
+	// The visible region of the contents and their scroll offset at the time of capture.
+	Rectanglei captured_region;
+	Vector2i captured_scroll_offset;
+	CallbackTexture texture;
+	Geometry geometry;
+};
+
+} // namespace Rml
@@ -14,8 +14,10 @@
 #include "../../Include/RmlUi/Core/PropertyIdSet.h"
 #include "../../Include/RmlUi/Core/StyleSheet.h"
 #include "../../Include/RmlUi/Core/StyleSheetSpecification.h"
+#include "../../Include/RmlUi/Core/TaskInterface.h"
 #include "../../Include/RmlUi/Core/TransformPrimitive.h"
 #include "ComputeProperty.h"
+#include "ControlledLifetimeResource.h"
 #include "ElementDefinition.h"
 #include "PropertiesIterator.h"
 #include <algorithm>
@@ -31,9 +33,50 @@ inline PseudoClassState operator&(PseudoClassState lhs, PseudoClassState rhs)
 	return PseudoClassState(int(lhs) & int(rhs));
 }
 
+// The minimum number of pending definitions for looking them up ahead of time, below this the overhead of the tasks is not worth it.
+static constexpr int MinPrefetchedDefinitions = 128;
+// The maximum number of recorded elements with dirtied definitions, beyond this the whole hierarchy is searched for pending definitions.
+static constexpr int MaxDirtiedRoots = 128;
+// The number of definitions looked up by each task.
+static constexpr int NumDefinitionsPerChunk = 32;
+
+struct PrefetchedDefinition {
+	Element* element;
+	const StyleSheet* style_sheet;
+	StyleSheetIndex::NodeList nodes;
+	size_t nodes_hash;
+	bool position_dependent;
+};
+
+// Definitions looked up ahead of time by ElementStyle::PrefetchDefinitions, in the order of the elements in the hierarchy.
+struct DefinitionPrefetchData {
+	Vector<PrefetchedDefinition> definitions;
+	// The elements below which definitions have been dirtied since the last look-up.
+	Vector<ObserverPtr<Element>> dirtied_roots;
+};
+static ControlledLifetimeResource<DefinitionPrefetchData> definition_prefetch;
+
+bool ElementStyle::definitions_prefetched = false;
+bool ElementStyle::definitions_dirtied = false;
+bool ElementStyle::dirtied_roots_overflow = false;
+
 ElementStyle::ElementStyle(Element* _element)
 {
 	element = _element;
+	tag_atom = MakeAtom(element->GetTagName());
+}
+
+void ElementStyle::Initialize()
+{
+	definition_prefetch.Initialize();
+}
+
+void ElementStyle::Shutdown()
+{
+	definitions_prefetched = false;
+	definitions_dirtied = false;
+	dirtied_roots_overflow = false;
+	definition_prefetch.Shutdown();
 }
 
 const Property* ElementStyle::GetLocalProperty(PropertyId id, const PropertyDictionary& inline_properties, const ElementDefinition* definition)
@@ -139,15 +182,213 @@ void ElementStyle::TransitionPropertyChanges(Element* element, PropertyIdSet& pr
 	}
 }
 
+uint64_t ElementStyle::names_generation = 1;
+
+const StyleSheetAncestorFilter& ElementStyle::GetAncestorFilter()
+{
+	if (ancestor_filter_generation != names_generation)
+	{
+		Element* parent = element->GetParentNode();
+		ancestor_filter.Build(parent ? &parent->GetStyle()->GetAncestorFilter() : nullptr, parent);
+		ancestor_filter_generation = names_generation;
+	}
+	return ancestor_filter;
+}
+
+bool ElementStyle::CanShareDefinition(const Element* element, const Element* sibling)
+{
+	// The sibling's definition must be up-to-date, any change to its names or state would have dirtied it. Siblings can also be documents with
+	// their own style sheets.
+	if (sibling == element || sibling->dirty_definition || sibling->GetStyleSheet() != element->GetStyleSheet())
+		return false;
+
+	const ElementStyle* style = element->GetStyle();
+	const ElementStyle* sibling_style = sibling->GetStyle();
+
+	return style->tag_atom == sibling_style->tag_atom && element->GetId() == sibling->GetId() && style->class_atoms == sibling_style->class_atoms &&
+		style->pseudo_classes == sibling_style->pseudo_classes && element->GetAttributes() == sibling->GetAttributes();
+}
+
+void ElementStyle::PrefetchDefinitions(Element* root)
+{
+	// Avoid walking the hierarchy when no definitions can be pending.
+	TaskInterface* task_interface = GetTaskInterface();
+	if (!task_interface || !definitions_dirtied)
+		return;
+
+	RMLUI_ZoneScoped;
+	definitions_dirtied = false;
+
+	Vector<PrefetchedDefinition>& definitions = definition_prefetch->definitions;
+	Vector<ObserverPtr<Element>>& dirtied_roots = definition_prefetch->dirtied_roots;
+	definitions.clear();
+
+	if (dirtied_roots_overflow)
+	{
+		CollectPendingDefinitions(root, false);
+	}
+	else
+	{
+		// Only search below the recorded elements that are still part of our hierarchy, skipping those already covered by another one.
+		UnorderedSet<Element*> roots;
+		for (const ObserverPtr<Element>& dirtied_root : dirtied_roots)
+		{
+			if (dirtied_root)
+				roots.insert(dirtied_root.get());
+		}
+
+		for (Element* dirtied_root : roots)
+		{
+			bool covered = false;
+			Element* ancestor = dirtied_root;
+			while (ancestor != root && ancestor)
+			{
+				ancestor = ancestor->GetParentNode();
+				covered |= (roots.count(ancestor) != 0);
+			}
+			if (covered || !ancestor)
+				continue;
+
+			// Structural selectors may test the sibling indices of any ancestor, otherwise prepared while searching from the root.
+			for (ancestor = dirtied_root->GetParentNode(); ancestor; ancestor = ancestor->GetParentNode())
+			{
+				ElementStyle* style = ancestor->GetStyle();
+				if (style->child_sibling_indices_dirty)
+					style->UpdateChildSiblingIndices();
+			}
+
+			CollectPendingDefinitions(dirtied_root, false);
+		}
+	}
+
+	dirtied_roots.clear();
+	dirtied_roots_overflow = false;
+
+	const int num_definitions = (int)definitions.size();
+	if (num_definitions < MinPrefetchedDefinitions)
+	{
+		definitions.clear();
+		return;
+	}
+
+	// Matching only reads from the style sheets and the element hierarchy, all state updated lazily during matching has been prepared above.
+	const int num_chunks = (num_definitions + NumDefinitionsPerChunk - 1) / NumDefinitionsPerChunk;
+	task_interface->ParallelFor(num_chunks, [&definitions](int chunk) {
+		const size_t end = Math::Min(size_t(chunk + 1) * NumDefinitionsPerChunk, definitions.size());
+		for (size_t i = size_t(chunk) * NumDefinitionsPerChunk; i < end; i++)
+		{
+			PrefetchedDefinition& prefetched = definitions[i];
+			prefetched.style_sheet->FindApplicableNodes(prefetched.element, &prefetched.element->GetStyle()->ancestor_filter, prefetched.nodes,
+				prefetched.nodes_hash, prefetched.position_dependent);
+		}
+	});
+
+	for (int i = 0; i < num_definitions; i++)
+		definitions[i].element->GetStyle()->prefetched_definition_index = uint32_t(i + 1);
+
+	definitions_prefetched = true;
+}
+
+void ElementStyle::ReleasePrefetchedDefinitions()
+{
+	definitions_prefetched = false;
+	definition_prefetch->definitions.clear();
+}
+
+void ElementStyle::AddDirtiedRoot(Element* dirtied_root)
+{
+	if (!GetTaskInterface() || !definition_prefetch)
+		return;
+
+	Vector<ObserverPtr<Element>>& dirtied_roots = definition_prefetch->dirtied_roots;
+	if (!dirtied_roots.empty() && dirtied_roots.back().get() == dirtied_root)
+		return;
+	if ((int)dirtied_roots.size() >= MaxDirtiedRoots)
+	{
+		dirtied_roots_overflow = true;
+		dirtied_roots.clear();
+		return;
+	}
+	dirtied_roots.push_back(dirtied_root->GetObserverPtr());
+}
+
+void ElementStyle::CollectPendingDefinitions(Element* element, bool dirtied_by_parent)
+{
+	// Mirrors the order and propagation of dirty definitions in Element::UpdateDefinition.
+	if ((dirtied_by_parent || element->dirty_definition) && element->GetTagName() != "#text")
+	{
+		if (const StyleSheet* style_sheet = element->GetStyleSheet())
+		{
+			ElementStyle* style = element->GetStyle();
+			Element* parent = element->GetParentNode();
+			style->ancestor_filter.Build(parent ? &parent->GetStyle()->GetAncestorFilter() : nullptr, parent);
+			style->ancestor_filter_generation = names_generation;
+			definition_prefetch->definitions.push_back(PrefetchedDefinition{element, style_sheet, {}, 0, false});
+		}
+	}
+
+	// Structural selectors may test the sibling indices of any ancestor.
+	ElementStyle* style = element->GetStyle();
+	if (style->child_sibling_indices_dirty)
+		style->UpdateChildSiblingIndices();
+
+	const bool dirty_children = (dirtied_by_parent || element->dirty_child_definitions);
+	for (const ElementPtr& child : element->children)
+		CollectPendingDefinitions(child.get(), dirty_children);
+}
+
+bool ElementStyle::TakePrefetchedDefinition(const StyleSheet* style_sheet, SharedPtr<const ElementDefinition>& out_definition,
+	bool& out_position_dependent)
+{
+	const size_t index = prefetched_definition_index;
+	prefetched_definition_index = 0;
+	if (!definitions_prefetched || index == 0)
+		return false;
+
+	// The index may be left over from an earlier prefetch, in which case it no longer refers to our element.
+	const Vector<PrefetchedDefinition>& definitions = definition_prefetch->definitions;
+	if (index > definitions.size())
+		return false;
+	const PrefetchedDefinition& prefetched = definitions[index - 1];
+	if (prefetched.element != element || prefetched.style_sheet != style_sheet)
+		return false;
+
+	out_definition = style_sheet->GetCachedElementDefinition(prefetched.nodes, prefetched.nodes_hash);
+	out_position_dependent = prefetched.position_dependent;
+	return true;
+}
+
 void ElementStyle::UpdateDefinition()
 {
 	RMLUI_ZoneScoped;
 
 	SharedPtr<const ElementDefinition> new_definition;
 
+	// Definitions are updated parents before children. However, class changes do not update the definitions of all descendants, thus the
+	// filter of our parent is validated against the latest names generation, rebuilding the filters of our ancestors as needed.
+	Element* parent = element->GetParentNode();
+	ancestor_filter.Build(parent ? &parent->GetStyle()->GetAncestorFilter() : nullptr, parent);
+	ancestor_filter_generation = names_generation;
+
+	UpdateClassAtoms();
+
 	if (const StyleSheet* style_sheet = element->GetStyleSheet())
 	{
-		new_definition = style_sheet->GetElementDefinition(element);
+		ElementStyle* parent_style = (parent && parent->GetStyle()->child_definition_sharing ? parent->GetStyle() : nullptr);
+		const Element* sibling = (parent_style ? parent_style->shareable_child : nullptr);
+
+		if (sibling && CanShareDefinition(element, sibling))
+		{
+			new_definition = sibling->GetStyle()->definition;
+		}
+		else
+		{
+			bool position_dependent = true;
+			if (!TakePrefetchedDefinition(style_sheet, new_definition, position_dependent))
+				new_definition = style_sheet->GetElementDefinition(element, &ancestor_filter, &position_dependent);
+			if (parent_style && !position_dependent)
+				parent_style->shareable_child = element;
+		}
 	}
 
 	// Switch the property definitions if the definition has changed.
@@ -209,6 +450,20 @@ bool ElementStyle::SetPseudoClass(const String& pseudo_class, bool activate, boo
 		}
 	}
 
+	if (changed)
+	{
+		if (activate)
+		{
+			pseudo_class_mask |= GetNameMask(pseudo_class);
+		}
+		else
+		{
+			pseudo_class_mask = 0;
+			for (const auto& active_pseudo_class : pseudo_classes)
+				pseudo_class_mask |= GetNameMask(active_pseudo_class.first);
+		}
+	}
+
 	return changed;
 }
 
@@ -231,7 +486,11 @@ bool ElementStyle::SetClass(const String& class_name, bool activate)
 	{
 		if (class_location == classes.end())
 		{
+			if (classes.empty())
+				class_atoms_num_atoms = GetNumAtoms();
 			classes.push_back(class_name);
+			class_atoms.push_back(FindAtom(class_name));
+			class_mask |= GetNameMask(class_name);
 			changed = true;
 		}
 	}
@@ -239,11 +498,18 @@ bool ElementStyle::SetClass(const String& class_name, bool activate)
 	{
 		if (class_location != classes.end())
 		{
+			class_atoms.erase(class_atoms.begin() + (class_location - classes.begin()));
 			classes.erase(class_location);
+			class_mask = 0;
+			for (const String& name : classes)
+				class_mask |= GetNameMask(name);
 			changed = true;
 		}
 	}
 
+	if (changed)
+		names_generation += 1;
+
 	return changed;
 }
 
@@ -256,6 +522,41 @@ void ElementStyle::SetClassNames(const String& class_names)
 {
 	classes.clear();
 	StringUtilities::ExpandString(classes, class_names, ' ');
+
+	class_atoms.clear();
+	class_atoms.reserve(classes.size());
+	class_atoms_num_atoms = GetNumAtoms();
+	class_mask = 0;
+	for (const String& class_name : classes)
+	{
+		class_atoms.push_back(FindAtom(class_name));
+		class_mask |= GetNameMask(class_name);
+	}
+
+	names_generation += 1;
+}
+
+Atom ElementStyle::GetClassAtom(size_t index) const
+{
+	// The name may have been interned by a style sheet since it was looked up.
+	const Atom atom = class_atoms[index];
+	if (atom == Atom::Empty && class_atoms_num_atoms != GetNumAtoms())
+		return FindAtom(classes[index]);
+	return atom;
+}
+
+void ElementStyle::UpdateClassAtoms()
+{
+	const uint32_t num_atoms = GetNumAtoms();
+	if (class_atoms_num_atoms == num_atoms)
+		return;
+
+	for (size_t i = 0; i < class_atoms.size(); i++)
+	{
+		if (class_atoms[i] == Atom::Empty)
+			class_atoms[i] = FindAtom(classes[i]);
+	}
+	class_atoms_num_atoms = num_atoms;
 }
 
 String ElementStyle::GetClassNames() const
@@ -286,6 +587,11 @@ bool ElementStyle::SetProperty(PropertyId id, const Property& property)
 	if (!new_property.definition)
 		return false;
 
+	// Setting the current value again changes nothing, thus nothing needs to be dirtied.
+	const Property* current_property = inline_properties.GetProperty(id);
+	if (current_property && *current_property == new_property)
+		return true;
+
 	inline_properties.SetProperty(id, new_property);
 	DirtyProperty(id);
 
@@ -417,13 +723,16 @@ void ElementStyle::DirtyInheritedProperties()
 
 void ElementStyle::DirtyPropertiesWithUnits(Units units)
 {
+	// Transforms keep the units of their primitives, which are resolved only when the transform state is updated.
+	const bool dirty_transforms = Any(units & Unit::LENGTH);
+
 	// Dirty all the properties of this element that use the unit(s).
 	for (auto it = Iterate(); !it.AtEnd(); ++it)
 	{
 		auto name_property_pair = *it;
 		PropertyId id = name_property_pair.first;
 		const Property& property = name_property_pair.second;
-		if (Any(property.unit & units))
+		if (Any(property.unit & units) || (dirty_transforms && property.unit == Unit::TRANSFORM))
 			DirtyProperty(id);
 	}
 }
@@ -438,6 +747,80 @@ void ElementStyle::DirtyPropertiesWithUnitsRecursive(Units units)
 		element->GetChild(i)->GetStyle()->DirtyPropertiesWithUnitsRecursive(units);
 }
 
+void ElementStyle::BeginChildDefinitionSharing()
+{
+	child_definition_sharing = true;
+	shareable_child = nullptr;
+}
+
+void ElementStyle::EndChildDefinitionSharing()
+{
+	child_definition_sharing = false;
+	shareable_child = nullptr;
+}
+
+void ElementStyle::OnChildRemove(const Element* child)
+{
+	if (shareable_child == child)
+		shareable_child = nullptr;
+	child_sibling_indices_dirty = true;
+}
+
+void ElementStyle::OnChildAdd()
+{
+	child_sibling_indices_dirty = true;
+}
+
+const ElementStyle::SiblingIndices* ElementStyle::GetSiblingIndices() const
+{
+	Element* parent = element->GetParentNode();
+	if (!parent)
+		return nullptr;
+
+	ElementStyle* parent_style = parent->GetStyle();
+	if (parent_style->child_sibling_indices_dirty)
+		parent_style->UpdateChildSiblingIndices();
+
+	return sibling_indices.index > 0 ? &sibling_indices : nullptr;
+}
+
+void ElementStyle::UpdateChildSiblingIndices()
+{
+	RMLUI_ZoneScoped;
+
+	child_sibling_indices_dirty = false;
+
+	const int num_children = element->GetNumChildren(true);
+	const int num_dom_children = element->GetNumChildren();
+
+	UnorderedMap<uint32_t, int> type_counts;
+	int count = 0;
+
+	for (int i = 0; i < num_children; i++)
+	{
+		ElementStyle* child_style = element->GetChild(i)->GetStyle();
+		SiblingIndices& indices = child_style->sibling_indices;
+		indices = {};
+		if (i >= num_dom_children || child_style->element->GetTagName() == "#text")
+			continue;
+
+		count += 1;
+		indices.index = count;
+		indices.type_index = (type_counts[static_cast<uint32_t>(child_style->tag_atom)] += 1);
+	}
+
+	for (int i = 0; i < num_dom_children; i++)
+	{
+		ElementStyle* child_style = element->GetChild(i)->GetStyle();
+		SiblingIndices& indices = child_style->sibling_indices;
+		if (indices.index == 0)
+			continue;
+
+		indices.index_from_end = count - indices.index + 1;
+		indices.type_index_from_end = type_counts[static_cast<uint32_t>(child_style->tag_atom)] - indices.type_index + 1;
+	}
+}
+
 bool ElementStyle::AnyPropertiesDirty() const
 {
 	return !dirty_properties.Empty();
@@ -478,6 +861,95 @@ void ElementStyle::DirtyProperties(const PropertyIdSet& properties)
 	dirty_properties |= properties;
 }
 
+// Properties which can't affect layout, and whose computed values only depend on their own local or inherited value. When these
+// are the only dirty properties, such as during most color, opacity, and transform animations, the rest of the computed values
+// can be left untouched.
+static const PropertyIdSet& GetIndependentProperties()
+{
+	static const PropertyIdSet properties = []() {
+		PropertyIdSet result;
+		for (PropertyId id : {PropertyId::BackgroundColor, PropertyId::BorderTopColor, PropertyId::BorderRightColor, PropertyId::BorderBottomColor,
+				 PropertyId::BorderLeftColor, PropertyId::Color, PropertyId::ImageColor, PropertyId::Opacity, PropertyId::Transform})
+			result.Insert(id);
+		return result;
+	}();
+	return properties;
+}
+
+namespace {
+	// The values of the inherited properties which are fully represented by computed values. Children inherit these through our computed values,
+	// thus they only need to be dirtied when the values actually change.
+	struct InheritedValuesSnapshot {
+		explicit InheritedValuesSnapshot(const Style::ComputedValues& values) :
+			font_size(values.font_size()), line_height(values.line_height()), color(values.color()), opacity(values.opacity()),
+			font_style(values.font_style()), font_weight(values.font_weight()), font_kerning(values.font_kerning()), text_align(values.text_align()),
+			text_decoration(values.text_decoration()), text_transform(values.text_transform()), white_space(values.white_space()),
+			word_break(values.word_break()), focus(values.focus()), pointer_events(values.pointer_events()), direction(values.direction()),
+			language(values.language())
+		{}
+
+		// Returns false if the computed value of the inherited property is unchanged since the snapshot. Inherited properties without computed
+		// values, such as font-family and user-registered properties, are read from the ancestors' properties and always considered changed.
+		bool MayHaveChanged(PropertyId id, const Style::ComputedValues& values) const
+		{
+			switch (id)
+			{
+			case PropertyId::FontSize: return font_size != values.font_size();
+			case PropertyId::LineHeight:
+			{
+				const Style::LineHeight new_line_height = values.line_height();
+				return line_height.value != new_line_height.value || line_height.inherit_type != new_line_height.inherit_type ||
+					line_height.inherit_value != new_line_height.inherit_value;
+			}
+			case PropertyId::Color: return color != values.color();
+			case PropertyId::Opacity: return opacity != values.opacity();
+			case PropertyId::FontStyle: return font_style != values.font_style();
+			case PropertyId::FontWeight: return font_weight != values.font_weight();
+			case PropertyId::FontKerning: return font_kerning != values.font_kerning();
+			case PropertyId::TextAlign: return text_align != values.text_align();
+			case PropertyId::TextDecoration: return text_decoration != values.text_decoration();
+			case PropertyId::TextTransform: return text_transform != values.text_transform();
+			case PropertyId::WhiteSpace: return white_space != values.white_space();
+			case PropertyId::WordBreak: return word_break != values.word_break();
+			case PropertyId::Focus: return focus != values.focus();
+			case PropertyId::PointerEvents: return pointer_events != values.pointer_events();
+			case PropertyId::RmlUi_Direction: return direction != values.direction();
+			case PropertyId::RmlUi_Language: return language != values.language();
+			default: return true;
+			}
+		}
+
+		// Returns the dirty inherited properties whose computed values are unchanged since the snapshot.
+		PropertyIdSet GetUnchangedProperties(const PropertyIdSet& dirty_properties, const Style::ComputedValues& values) const
+		{
+			PropertyIdSet result;
+			for (PropertyId id : dirty_properties & StyleSheetSpecification::GetRegisteredInheritedProperties())
+			{
+				if (!MayHaveChanged(id, values))
+					result.Insert(id);
+			}
+			return result;
+		}
+
+		float font_size;
+		Style::LineHeight line_height;
+		Colourb color;
+		float opacity;
+		Style::FontStyle font_style;
+		Style::FontWeight font_weight;
+		Style::FontKerning font_kerning;
+		Style::TextAlign text_align;
+		Style::TextDecoration text_decoration;
+		Style::TextTransform text_transform;
+		Style::WhiteSpace white_space;
+		Style::WordBreak word_break;
+		Style::Focus focus;
+		Style::PointerEvents pointer_events;
+		Style::Direction direction;
+		String language;
+	};
+} // namespace
+
 PropertyIdSet ElementStyle::ComputeValues(Style::ComputedValues& values, const Style::ComputedValues* parent_values,
 	const Style::ComputedValues* document_values, bool values_are_default_initialized, float dp_ratio, Vector2f vp_dimensions)
 {
@@ -486,6 +958,14 @@ PropertyIdSet ElementStyle::ComputeValues(Style::ComputedValues& values, const S
 
 	RMLUI_ZoneScopedC(0xFF7F50);
 
+	const InheritedValuesSnapshot inherited_before(values);
+
+	if (!values_are_default_initialized && (dirty_properties & GetIndependentProperties()).Size() == dirty_properties.Size())
+	{
+		ComputeIndependentValues(values, parent_values);
+		return PropagateDirtyProperties(inherited_before.GetUnchangedProperties(dirty_properties, values));
+	}
+
 	// Generally, this is how it works:
 	//   1. Assign default values (clears any removed properties)
 	//   2. Inherit inheritable values from parent
@@ -799,6 +1279,9 @@ PropertyIdSet ElementStyle::ComputeValues(Style::ComputedValues& values, const S
 		case PropertyId::PointerEvents:
 			values.pointer_events((PointerEvents)p->Get<int>());
 			break;
+		case PropertyId::RenderCache:
+			values.render_cache((RenderCache)p->Get<int>());
+			break;
 
 		case PropertyId::Perspective:
 			values.perspective(p->unit == Unit::KEYWORD ? 0.f : ComputeLength(p->GetNumericValue(), font_size, document_font_size, dp_ratio, vp_dimensions));
@@ -894,8 +1377,60 @@ PropertyIdSet ElementStyle::ComputeValues(Style::ComputedValues& values, const S
 			GetFontEngineInterface()->GetFontFaceHandle(values.font_family(), values.font_style(), values.font_weight(), (int)values.font_size()));
 	}
 
-	// Next, pass inheritable dirty properties onto our children
+	return PropagateDirtyProperties(inherited_before.GetUnchangedProperties(dirty_properties, values));
+}
+
+void ElementStyle::ComputeIndependentValues(Style::ComputedValues& values, const Style::ComputedValues* parent_values)
+{
+	const Style::ComputedValues& inherited_values = (parent_values ? *parent_values : DefaultComputedValues());
+	const Style::ComputedValues& default_values = DefaultComputedValues();
+
+	for (PropertyId id : dirty_properties)
+	{
+		const Property* p = GetLocalProperty(id);
+
+		switch (id)
+		{
+		case PropertyId::BackgroundColor:
+			values.background_color(p ? p->Get<Colourb>() : default_values.background_color());
+			break;
+		case PropertyId::BorderTopColor:
+			values.border_top_color(p ? p->Get<Colourb>() : default_values.border_top_color());
+			break;
+		case PropertyId::BorderRightColor:
+			values.border_right_color(p ? p->Get<Colourb>() : default_values.border_right_color());
+			break;
+		case PropertyId::BorderBottomColor:
+			values.border_bottom_color(p ? p->Get<Colourb>() : default_values.border_bottom_color());
+			break;
+		case PropertyId::BorderLeftColor:
+			values.border_left_color(p ? p->Get<Colourb>() : default_values.border_left_color());
+			break;
+		case PropertyId::Color:
+			values.color(p ? p->Get<Colourb>() : inherited_values.color());
+			break;
+		case PropertyId::ImageColor:
+			values.image_color(p ? p->Get<Colourb>() : default_values.image_color());
+			break;
+		case PropertyId::Opacity:
+			values.opacity(p ? p->Get<float>() : inherited_values.opacity());
+			break;
+		case PropertyId::Transform:
+			values.has_local_transform(p ? p->Get<TransformPtr>() != nullptr : default_values.has_local_transform());
+			break;
+		default:
+			RMLUI_ERROR;
+			break;
+		}
+	}
+}
+
+PropertyIdSet ElementStyle::PropagateDirtyProperties(const PropertyIdSet& unchanged_inherited_properties)
+{
+	// Next, pass inheritable dirty properties onto our children, skipping those whose computed values did not change.
 	PropertyIdSet dirty_inherited_properties = (dirty_properties & StyleSheetSpecification::GetRegisteredInheritedProperties());
+	for (PropertyId id : unchanged_inherited_properties)
+		dirty_inherited_properties.Erase(id);
 
 	// Special case for text-overflow: It's not really inherited, but the value is used by the element's children. Insert
 	// it here so they are notified of a change.
@@ -4,11 +4,14 @@
 #include "../../Include/RmlUi/Core/PropertyDictionary.h"
 #include "../../Include/RmlUi/Core/PropertyIdSet.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "Atom.h"
+#include "StyleSheetAncestorFilter.h"
 
 namespace Rml {
 
 class ElementDefinition;
 class PropertiesIterator;
+class StyleSheet;
 enum class RelativeTarget;
 
 enum class PseudoClassState : uint8_t { Clear = 0, Set = 1, Override = 2 };
@@ -24,9 +27,27 @@ public:
 	/// @param[in] element The element this structure belongs to.
 	ElementStyle(Element* element);
 
+	static void Initialize();
+	static void Shutdown();
+
 	/// Update this definition if required
 	void UpdateDefinition();
 
+	/// Looks up the definitions of all elements pending a definition update in the given hierarchy ahead of time, in parallel through the task
+	/// interface. The results are used as the elements update their definitions, until released or any definition is dirtied in the meantime.
+	static void PrefetchDefinitions(Element* root);
+	/// Releases the definitions looked up ahead of time, to be called after the hierarchy has been updated.
+	static void ReleasePrefetchedDefinitions();
+	/// Must be called whenever any definition is dirtied, with the element below which all the dirtied definitions are located. Discards the
+	/// definitions looked up ahead of time, as they may no longer be valid.
+	static void OnDefinitionDirtied(Element* dirtied_root)
+	{
+		definitions_prefetched = false;
+		definitions_dirtied = true;
+		if (!dirtied_roots_overflow)
+			AddDirtiedRoot(dirtied_root);
+	}
+
 	/// Sets or removes a pseudo-class on the element.
 	/// @param[in] pseudo_class The pseudo class to activate or deactivate.
 	/// @param[in] activate True if the pseudo class is to be activated, false to be deactivated.
@@ -58,6 +79,18 @@ public:
 	String GetClassNames() const;
 	/// Return the active class list.
 	const StringList& GetClassNameList() const;
+	/// Returns the atom of the class at the given index of the active class list, or Atom::Empty if the name has not been interned by any style
+	/// sheet, in which case it can't be required by any selector.
+	Atom GetClassAtom(size_t index) const;
+	/// Returns the atom of the element's tag name.
+	Atom GetTagAtom() const { return tag_atom; }
+	/// Returns the combined name masks of the active classes.
+	uint64_t GetClassMask() const { return class_mask; }
+	/// Returns the combined name masks of the active pseudo-classes.
+	uint64_t GetPseudoClassMask() const { return pseudo_class_mask; }
+
+	/// Makes all elements rebuild their filter of ancestor names before it is used next, such as after the style sheet changes.
+	static void DirtyAncestorFilters() { names_generation += 1; }
 
 	/// Sets a local property override on the element to a pre-parsed value.
 	/// @param[in] id The ID  of the new property.
@@ -109,6 +142,27 @@ public:
 	PropertyIdSet ComputeValues(Style::ComputedValues& values, const Style::ComputedValues* parent_values,
 		const Style::ComputedValues* document_values, bool values_are_default_initialized, float dp_ratio, Vector2f vp_dimensions);
 
+	/// Enables sharing of definitions between children of this element, must only be called while the children are updated in order.
+	/// While enabled, children with the same tag, id, classes, pseudo-classes, and attributes can reuse the definition of an earlier sibling.
+	void BeginChildDefinitionSharing();
+	/// Disables sharing of definitions between children of this element.
+	void EndChildDefinitionSharing();
+	/// Must be called whenever a child is removed from this element.
+	void OnChildRemove(const Element* child);
+	/// Must be called whenever a child is added to this element.
+	void OnChildAdd();
+
+	/// The position of an element among its siblings, as used by structural selectors. Text elements are not counted.
+	struct SiblingIndices {
+		int index = 0;               // One-based position among the siblings.
+		int index_from_end = 0;      // One-based position among the siblings, counted from the last sibling.
+		int type_index = 0;          // One-based position among the siblings with the same tag.
+		int type_index_from_end = 0; // One-based position among the siblings with the same tag, counted from the last one.
+	};
+	/// Returns the position of the element among its siblings, or nullptr if it is a text element or not part of its parent's document children.
+	/// @note The positions of all siblings are updated together when first needed after a change to the parent's children.
+	const SiblingIndices* GetSiblingIndices() const;
+
 	/// Returns an iterator for iterating the local properties of this element.
 	/// Note: Modifying the element's style invalidates its iterator.
 	PropertiesIterator Iterate() const;
@@ -117,9 +171,23 @@ private:
 	// Sets a list of properties as dirty.
 	void DirtyProperties(const PropertyIdSet& properties);
 
+	// Computes the values of the dirty properties, which must all be independent of other properties, leaving all other values untouched.
+	void ComputeIndependentValues(Style::ComputedValues& values, const Style::ComputedValues* parent_values);
+	// Dirties the inherited properties among the dirty properties in our children, then clears and returns the dirty properties. Inherited
+	// properties known to have kept their computed values are not passed on.
+	PropertyIdSet PropagateDirtyProperties(const PropertyIdSet& unchanged_inherited_properties = PropertyIdSet());
+
 	static const Property* GetLocalProperty(PropertyId id, const PropertyDictionary& inline_properties, const ElementDefinition* definition);
 	static const Property* GetProperty(PropertyId id, const Element* element, const PropertyDictionary& inline_properties,
 		const ElementDefinition* definition);
+	static bool CanShareDefinition(const Element* element, const Element* sibling);
+	// Collects the elements pending a definition update in the hierarchy, parents before children, and prepares any state that is otherwise
+	// updated lazily while matching them against the style sheet.
+	static void CollectPendingDefinitions(Element* element, bool dirtied_by_parent);
+	// Records an element below which definitions have been dirtied, so that only its subtree needs to be searched for pending definitions.
+	static void AddDirtiedRoot(Element* dirtied_root);
+	// Takes the definition of our element looked up ahead of time, returns false if there is no valid one.
+	bool TakePrefetchedDefinition(const StyleSheet* style_sheet, SharedPtr<const ElementDefinition>& out_definition, bool& out_position_dependent);
 	static void TransitionPropertyChanges(Element* element, PropertyIdSet& properties, const PropertyDictionary& inline_properties,
 		const ElementDefinition* old_definition, const ElementDefinition* new_definition);
 
@@ -128,8 +196,17 @@ private:
 
 	// The list of classes applicable to this object.
 	StringList classes;
+	// The atoms of the class names, kept in the same order as the classes above. Class names are not interned by elements, thus names which
+	// have not been interned by a style sheet are left empty, and looked up again once more names have been interned.
+	Vector<Atom> class_atoms;
+	// The number of interned names when the empty class atoms were last looked up.
+	uint32_t class_atoms_num_atoms = 0;
+	Atom tag_atom = Atom::Empty;
 	// This element's current pseudo-classes.
 	PseudoClassMap pseudo_classes;
+	// Combined name masks of the above classes and pseudo-classes, for quickly rejecting selectors.
+	uint64_t class_mask = 0;
+	uint64_t pseudo_class_mask = 0;
 
 	// Any properties that have been overridden in this element.
 	PropertyDictionary inline_properties;
@@ -137,6 +214,40 @@ private:
 	SharedPtr<const ElementDefinition> definition;
 
 	PropertyIdSet dirty_properties;
+
+	// Returns the filter of our ancestors' names, first rebuilding it and the filters of our ancestors if any class names have changed since.
+	const StyleSheetAncestorFilter& GetAncestorFilter();
+
+	// Filter of our ancestors' names, rebuilt whenever our definition is updated, or when it is used after any class names have changed.
+	StyleSheetAncestorFilter ancestor_filter;
+	// The names generation the filter was built during, zero if it has never been built.
+	uint64_t ancestor_filter_generation = 0;
+	// Incremented whenever the class names of any element change. Class changes only dirty the definitions of descendants with selectors
+	// depending on the class, thus the filters of the other descendants are rebuilt lazily when used.
+	static uint64_t names_generation;
+
+	void UpdateChildSiblingIndices();
+	// Looks up the empty class atoms again if more names have been interned since.
+	void UpdateClassAtoms();
+
+	// Our position among our siblings, updated by our parent.
+	SiblingIndices sibling_indices;
+	// True when the sibling indices of our children need to be updated.
+	bool child_sibling_indices_dirty = true;
+
+	// One-based index of the definition of our element looked up ahead of time, or zero if there is none.
+	uint32_t prefetched_definition_index = 0;
+	// True while the definitions looked up ahead of time are valid.
+	static bool definitions_prefetched;
+	// True if any definition has been dirtied since definitions were last looked up ahead of time.
+	static bool definitions_dirtied;
+	// True if too many elements have been dirtied to record them, then the whole hierarchy is searched for pending definitions.
+	static bool dirtied_roots_overflow;
+
+	// True while our children are updated in order, in which case they may share their definitions.
+	bool child_definition_sharing = false;
+	// The last updated child whose definition does not depend on its position among its siblings, or nullptr.
+	const Element* shareable_child = nullptr;
 };
 
 } // namespace Rml
@@ -13,7 +13,9 @@
 #include "ComputeProperty.h"
 #include "ElementDefinition.h"
 #include "ElementStyle.h"
+#include "FrameStatisticsAccess.h"
 #include "TransformState.h"
+#include <algorithm>
 #include <limits>
 
 namespace Rml {
@@ -22,6 +24,54 @@ static bool BuildToken(String& token, const char*& token_begin, const char* stri
 	bool break_at_endline, Style::TextTransform text_transformation, bool decode_escape_characters);
 static bool LastToken(const char* token_begin, const char* string_end, bool collapse_white_space, bool break_at_endline);
 
+// Texts with at least this number of lines only generate geometry for the lines near their visible area.
+static constexpr size_t MIN_NUM_LINES_FOR_CULLING = 64;
+
+struct ElementText::TokenCache {
+	struct Token {
+		int end;            // Offset into the text just past the token, where the next token begins.
+		int content_begin;  // Range of the token's contents in the contents buffer.
+		int content_end;
+		int num_characters; // Number of characters in the token's source text.
+		bool forced_break;  // The token ends with an endline forcing a line break.
+		bool leading_space; // The token starts with collapsed white-space, which is trimmed at the beginning of a line.
+		bool last_token;    // Only collapsed white-space follows the token.
+		Character previous; // The character preceding the token when its width was measured.
+		int width;          // Width of the token's contents, or -1 if not measured yet.
+		int trimmed_width;  // Width of the token's contents without the leading space, or -1 if not measured yet.
+	};
+
+	// Returns the token starting at the given offset into the text, or nullptr if no token starts there.
+	Token* Find(int offset)
+	{
+		if (next_token < tokens.size() && GetBegin(next_token) == offset)
+			return &tokens[next_token++];
+
+		auto it = std::upper_bound(tokens.begin(), tokens.end(), offset, [](int value, const Token& token) { return value < token.end; });
+		if (it == tokens.end() || GetBegin(size_t(it - tokens.begin())) != offset)
+			return nullptr;
+
+		next_token = size_t(it - tokens.begin()) + 1;
+		return &*it;
+	}
+	int GetBegin(size_t index) const { return index == 0 ? 0 : tokens[index - 1].end; }
+
+	// The formatting the tokens were built with.
+	bool collapse_white_space;
+	bool break_at_endline;
+	bool decode_escape_characters;
+	Style::TextTransform text_transform;
+
+	// The font the token widths were measured with.
+	FontFaceHandle font_face_handle;
+	int font_version;
+
+	Vector<Token> tokens;
+	String contents;
+	// Index of the token following the most recently found one, lines are usually generated in order.
+	size_t next_token;
+};
+
 static int RoundDownToIntegerClamped(float value)
 {
 	constexpr int clamp = (1 << std::numeric_limits<float>::digits);
@@ -98,8 +148,8 @@ void LogMissingFontFace(Element* element)
 }
 
 ElementText::ElementText(const String& tag) :
-	Element(tag), colour(255, 255, 255), opacity(1), font_handle_version(0), geometry_dirty(true), dirty_layout_on_change(true),
-	generated_decoration(Style::TextDecoration::None), decoration_property(Style::TextDecoration::None), font_effects_dirty(true),
+	Element(tag), colour(255, 255, 255), opacity(1), font_handle_version(0), geometry_dirty(true), geometry_culled(false), geometry_culling_top(0),
+	geometry_culling_bottom(0), dirty_layout_on_change(true), generated_decoration(Style::TextDecoration::None), decoration_property(Style::TextDecoration::None), font_effects_dirty(true),
 	font_effects_handle(0)
 {}
 
@@ -110,6 +160,7 @@ void ElementText::SetText(const String& _text)
 	if (text != _text)
 	{
 		text = _text;
+		token_cache.reset();
 
 		if (dirty_layout_on_change)
 			DirtyLayout();
@@ -121,16 +172,13 @@ const String& ElementText::GetText() const
 	return text;
 }
 
-void ElementText::OnRender()
+void ElementText::OnPrepareRender()
 {
-	RMLUI_ZoneScoped;
-
 	FontFaceHandle font_face_handle = GetFontFaceHandle();
-	if (font_face_handle == 0)
+	RenderManager* render_manager = GetRenderManager();
+	if (font_face_handle == 0 || !render_manager)
 		return;
 
-	RenderManager& render_manager = GetContext()->GetRenderManager();
-
 	// If our font effects have potentially changed, update it and force a geometry generation if necessary.
 	if (font_effects_dirty && UpdateFontEffects())
 		geometry_dirty = true;
@@ -145,7 +193,7 @@ void ElementText::OnRender()
 
 	// Regenerate the geometry if the colour or font configuration has altered.
 	if (geometry_dirty)
-		GenerateGeometry(render_manager, font_face_handle);
+		GenerateGeometry(*render_manager, font_face_handle);
 
 	// Regenerate text decoration if necessary.
 	if (decoration_property != generated_decoration)
@@ -163,11 +211,33 @@ void ElementText::OnRender()
 				decoration = MakeUnique<Geometry>();
 
 			GenerateDecoration(mesh, font_face_handle);
-			*decoration = GetRenderManager()->MakeGeometry(std::move(mesh));
+			*decoration = render_manager->MakeGeometry(std::move(mesh));
 		}
 
 		generated_decoration = decoration_property;
 	}
+}
+
+void ElementText::OnRender()
+{
+	RMLUI_ZoneScoped;
+
+	FontFaceHandle font_face_handle = GetFontFaceHandle();
+	if (font_face_handle == 0)
+		return;
+
+	RenderManager& render_manager = GetContext()->GetRenderManager();
+
+	// Long texts only generate geometry for the lines near their visible area, regenerate it when scrolled beyond those lines.
+	if (geometry_culled)
+	{
+		float visible_top = 0, visible_bottom = 0;
+		if (!GetVisibleRange(visible_top, visible_bottom) || visible_top < geometry_culling_top || visible_bottom > geometry_culling_bottom)
+			geometry_dirty = true;
+	}
+
+	// The geometry is normally prepared during update already, this only regenerates it if it has been dirtied since.
+	OnPrepareRender();
 
 	const Vector2f translation = GetAbsoluteOffset();
 
@@ -201,8 +271,13 @@ void ElementText::OnRender()
 
 	if (render)
 	{
-		for (size_t i = 0; i < geometry.size(); ++i)
-			geometry[i].geometry.Render(translation, geometry[i].texture);
+		for (const TexturedGeometry& textured_geometry : geometry)
+		{
+			if (textured_geometry.shader)
+				textured_geometry.geometry.Render(translation, textured_geometry.texture, *textured_geometry.shader);
+			else
+				textured_geometry.geometry.Render(translation, textured_geometry.texture);
+		}
 	}
 
 	if (decoration)
@@ -245,30 +320,117 @@ bool ElementText::GenerateLine(String& line, int& line_length, float& line_width
 	WordBreak word_break = computed.word_break();
 
 	FontEngineInterface* font_engine_interface = GetFontEngineInterface();
+	Vector<int> token_prefix_widths;
+
+	// Tokenizing the text only depends on the text and its formatting, build the tokens once and measure them as they are used. Layout
+	// often generates the same lines several times, such as when shrinking to fit its contents.
+	const int font_version = font_engine_interface->GetVersion(font_face_handle);
+	if (!token_cache || token_cache->collapse_white_space != collapse_white_space || token_cache->break_at_endline != break_at_endline ||
+		token_cache->decode_escape_characters != decode_escape_characters || token_cache->text_transform != text_transform_property)
+	{
+		if (!token_cache)
+			token_cache = MakeUnique<TokenCache>();
+		TokenCache& cache = *token_cache;
+		cache.collapse_white_space = collapse_white_space;
+		cache.break_at_endline = break_at_endline;
+		cache.decode_escape_characters = decode_escape_characters;
+		cache.text_transform = text_transform_property;
+		cache.tokens.clear();
+		cache.contents.clear();
+		cache.contents.reserve(text.size() + 1);
+
+		const char* string_end = text.c_str() + text.size();
+		for (const char* token_begin = text.c_str(); token_begin != string_end;)
+		{
+			TokenCache::Token token = {};
+			const char* next_token_begin = token_begin;
+			token.content_begin = int(cache.contents.size());
+			token.forced_break = BuildToken(cache.contents, next_token_begin, string_end, false, collapse_white_space, break_at_endline,
+				text_transform_property, decode_escape_characters);
+			token.content_end = int(cache.contents.size());
+			token.end = int(next_token_begin - text.c_str());
+			token.num_characters = int(StringUtilities::LengthUTF8(StringView(token_begin, next_token_begin)));
+			token.leading_space = collapse_white_space && StringUtilities::IsWhitespace(*token_begin) && token.content_end > token.content_begin &&
+				cache.contents[token.content_begin] == ' ';
+			token.last_token = LastToken(next_token_begin, string_end, collapse_white_space, break_at_endline);
+			token.width = -1;
+			token.trimmed_width = -1;
+			cache.tokens.push_back(token);
+			token_begin = next_token_begin;
+		}
+		cache.font_face_handle = 0;
+	}
+	TokenCache& cache = *token_cache;
+	if (cache.font_face_handle != font_face_handle || cache.font_version != font_version)
+	{
+		for (TokenCache::Token& token : cache.tokens)
+			token.width = token.trimmed_width = -1;
+		cache.font_face_handle = font_face_handle;
+		cache.font_version = font_version;
+	}
+	cache.next_token = 0;
 
 	// Starting at the line_begin character, we generate sections of the text (we'll call them tokens) depending on the
 	// white-space parsing parameters. Each section is then appended to the line if it can fit. If not, or if an
 	// endline is found (and we're processing them), then the line is ended. kthxbai!
 	const char* token_begin = text.c_str() + line_begin;
 	const char* string_end = text.c_str() + text.size();
+	String built_token;
 	while (token_begin != string_end)
 	{
-		String token;
+		StringView token;
 		const char* next_token_begin = token_begin;
 		Character previous_codepoint = Character::Null;
 		if (!line.empty())
 			previous_codepoint =
 				StringUtilities::ToCharacter(StringUtilities::SeekBackwardUTF8(&line.back(), line.data()), line.data() + line.size());
 
-		// Generate the next token and determine its pixel-length.
-		bool break_line = BuildToken(token, next_token_begin, string_end, line.empty() && trim_whitespace_prefix, collapse_white_space,
-			break_at_endline, text_transform_property, decode_escape_characters);
-		int token_width = font_engine_interface->GetStringWidth(font_face_handle, token, text_shaping_context, previous_codepoint);
+		// Look up the next token and determine its pixel-length. Tokens starting within a cached token, after breaking up a word, are built
+		// on the spot.
+		const bool first_token = line.empty() && trim_whitespace_prefix;
+		bool break_line = false;
+		bool is_last_token = false;
+		int token_width = 0;
+		int token_num_characters = -1;
+		if (TokenCache::Token* cached_token = cache.Find(int(token_begin - text.c_str())))
+		{
+			const bool trim_leading_space = (first_token && cached_token->leading_space);
+			token = StringView(cache.contents, size_t(cached_token->content_begin + (trim_leading_space ? 1 : 0)),
+				size_t(cached_token->content_end - cached_token->content_begin - (trim_leading_space ? 1 : 0)));
+			next_token_begin = text.c_str() + cached_token->end;
+			break_line = cached_token->forced_break;
+			is_last_token = cached_token->last_token;
+			token_num_characters = cached_token->num_characters;
+
+			if (trim_leading_space)
+			{
+				if (cached_token->trimmed_width < 0)
+					cached_token->trimmed_width = font_engine_interface->GetStringWidth(font_face_handle, token, text_shaping_context);
+				token_width = cached_token->trimmed_width;
+			}
+			else
+			{
+				if (cached_token->width < 0 || cached_token->previous != previous_codepoint)
+				{
+					cached_token->width = font_engine_interface->GetStringWidth(font_face_handle, token, text_shaping_context, previous_codepoint);
+					cached_token->previous = previous_codepoint;
+				}
+				token_width = cached_token->width;
+			}
+		}
+		else
+		{
+			built_token.clear();
+			break_line = BuildToken(built_token, next_token_begin, string_end, first_token, collapse_white_space, break_at_endline,
+				text_transform_property, decode_escape_characters);
+			is_last_token = LastToken(next_token_begin, string_end, collapse_white_space, break_at_endline);
+			token = built_token;
+			token_width = font_engine_interface->GetStringWidth(font_face_handle, token, text_shaping_context, previous_codepoint);
+		}
 
 		// If we're breaking to fit a line box, check if the token can fit on the line before we add it.
 		if (break_at_line)
 		{
-			const bool is_last_token = LastToken(next_token_begin, string_end, collapse_white_space, break_at_endline);
 			int max_token_width = RoundDownToIntegerClamped(maximum_line_width - (is_last_token ? line_width + right_spacing_width : line_width));
 
 			if (token_width > max_token_width)
@@ -280,7 +442,25 @@ bool ElementText::GenerateLine(String& line, int& line_length, float& line_width
 					const int token_max_size = int(next_token_begin - token_begin);
 					const char* partial_string_end = token_begin + token_max_size;
 
-					// @performance: Can be made much faster. Use string width heuristics and logarithmic search.
+					// Measure all prefixes of the token in one pass. When each source character maps to exactly one token character, the
+					// prefix widths tell us where the token will break, so start the search from there instead of from the end of the token.
+					font_engine_interface->GetStringPrefixWidths(font_face_handle, token, text_shaping_context, previous_codepoint,
+						token_prefix_widths);
+					if (token_num_characters < 0)
+						token_num_characters = int(StringUtilities::LengthUTF8(StringView(token_begin, partial_string_end)));
+					if (size_t(token_num_characters) == token_prefix_widths.size())
+					{
+						int num_fitting_characters = (int)token_prefix_widths.size();
+						while (num_fitting_characters > 0 && token_prefix_widths[num_fitting_characters - 1] > max_token_width)
+							num_fitting_characters--;
+
+						// The search below starts by removing one character, so begin just past the last fitting character.
+						const char* search_begin = token_begin;
+						for (int i = 0; i <= num_fitting_characters && search_begin != partial_string_end; i++)
+							search_begin = StringUtilities::SeekForwardUTF8(search_begin + 1, partial_string_end);
+						partial_string_end = search_begin;
+					}
+
 					while (true)
 					{
 						partial_string_end = StringUtilities::SeekBackwardUTF8(partial_string_end - 1, token_begin);
@@ -297,10 +477,11 @@ bool ElementText::GenerateLine(String& line, int& line_length, float& line_width
 							force_loop_break_at_end = true;
 						}
 
-						token.clear();
+						built_token.clear();
 						next_token_begin = token_begin;
-						BuildToken(token, next_token_begin, partial_string_end, line.empty() && trim_whitespace_prefix, collapse_white_space,
-							break_at_endline, text_transform_property, decode_escape_characters);
+						BuildToken(built_token, next_token_begin, partial_string_end, first_token, collapse_white_space, break_at_endline,
+							text_transform_property, decode_escape_characters);
+						token = built_token;
 						token_width = font_engine_interface->GetStringWidth(font_face_handle, token, text_shaping_context, previous_codepoint);
 
 						if (force_loop_break_at_end || token_width <= max_token_width)
@@ -318,7 +499,7 @@ bool ElementText::GenerateLine(String& line, int& line_length, float& line_width
 		}
 
 		// The token can fit on the end of the line, so add it onto the end and increment our width and length counters.
-		line += token;
+		line.append(token.begin(), token.end());
 		line_length += (int)(next_token_begin - token_begin);
 		line_width += token_width;
 
@@ -339,6 +520,7 @@ void ElementText::ClearLines()
 	lines.clear();
 	generated_decoration = Style::TextDecoration::None;
 	geometry_dirty = true;
+	DirtyRenderCache();
 }
 
 void ElementText::AddLine(Vector2f line_position, String line)
@@ -398,6 +580,7 @@ void ElementText::OnPropertyChange(const PropertyIdSet& changed_properties)
 	{
 		font_face_changed = true;
 		geometry_dirty = true;
+		token_cache.reset();
 
 		font_effects_handle = 0;
 		font_effects_dirty = true;
@@ -481,6 +664,11 @@ void ElementText::GenerateGeometry(RenderManager& render_manager, const FontFace
 {
 	RMLUI_ZoneScopedC(0xD2691E);
 
+	if (DocumentFrameStatistics* statistics = FrameStatisticsAccess::Get(this))
+		statistics->num_text_geometry_rebuilds += 1;
+	if (ElementInvalidations* invalidations = FrameStatisticsAccess::GetInvalidations(this))
+		invalidations->num_geometry_rebuilds += 1;
+
 	const TextOverflowResolved text_overflow = ResolveTextOverflow(GetParentNode(), font_face_handle);
 
 	const auto& computed = GetComputedValues();
@@ -489,8 +677,35 @@ void ElementText::GenerateGeometry(RenderManager& render_manager, const FontFace
 	TexturedMeshList mesh_list;
 	mesh_list.reserve(geometry.size());
 
+	// For long texts, such as logs in a scroll container, only generate geometry for the lines within the clipping region and a margin of the
+	// same size on either side. Geometry for the other lines is generated during rendering once they are scrolled near the visible area.
+	geometry_culled = false;
+	if (lines.size() >= MIN_NUM_LINES_FOR_CULLING)
+	{
+		float visible_top = 0, visible_bottom = 0;
+		if (GetVisibleRange(visible_top, visible_bottom))
+		{
+			const float margin = visible_bottom - visible_top;
+			geometry_culled = true;
+			geometry_culling_top = visible_top - margin;
+			geometry_culling_bottom = visible_bottom + margin;
+		}
+	}
+
+	const FontMetrics& font_metrics = GetFontEngineInterface()->GetFontMetrics(font_face_handle);
+	const auto is_line_culled = [&](const Line& line) {
+		return geometry_culled &&
+			(line.position.y + font_metrics.descent < geometry_culling_top || line.position.y - font_metrics.ascent > geometry_culling_bottom);
+	};
+
 	for (Line& line : lines)
 	{
+		if (is_line_culled(line))
+		{
+			line.width = 0;
+			continue;
+		}
+
 		line.width = GetFontEngineInterface()->GenerateString(render_manager, font_face_handle, font_effects_handle, line.text, line.position, colour,
 			opacity, text_shaping_context, mesh_list);
 	}
@@ -502,7 +717,7 @@ void ElementText::GenerateGeometry(RenderManager& render_manager, const FontFace
 
 		for (Line& line : lines)
 		{
-			if (line.text.empty())
+			if (line.text.empty() || is_line_culled(line))
 				continue;
 
 			String abbreviated_text;
@@ -536,12 +751,37 @@ void ElementText::GenerateGeometry(RenderManager& render_manager, const FontFace
 			geometry[i].geometry = render_manager.MakeGeometry(std::move(mesh_list[i].mesh));
 
 		geometry[i].texture = mesh_list[i].texture;
+		geometry[i].shader = std::move(mesh_list[i].shader);
 	}
 
 	generated_decoration = Style::TextDecoration::None;
 	geometry_dirty = false;
 }
 
+bool ElementText::GetVisibleRange(float& out_top, float& out_bottom)
+{
+	// Skip culling in transformed cases for simplicity, the clipping region is then no longer aligned with the lines.
+	if (GetTransformState() && GetTransformState()->GetTransform())
+		return false;
+
+	Rectanglei clip_region;
+	if (!ElementUtilities::GetClippingRegion(this, clip_region))
+	{
+		RenderManager* render_manager = GetRenderManager();
+		if (!render_manager)
+			return false;
+		clip_region = Rectanglei::FromSize(render_manager->GetViewport());
+	}
+
+	if (!clip_region.Valid())
+		return false;
+
+	const float offset_y = GetAbsoluteOffset().y;
+	out_top = float(clip_region.Top()) - offset_y;
+	out_bottom = float(clip_region.Bottom()) - offset_y;
+	return true;
+}
+
 void ElementText::GenerateDecoration(Mesh& mesh, const FontFaceHandle font_face_handle)
 {
 	RMLUI_ZoneScopedC(0xA52A2A);
@@ -21,6 +21,46 @@
 
 namespace Rml {
 
+// Transforms and projects the corners of a box to window coordinates. Returns false if any corner is outside the depth clip planes.
+static bool ProjectCorners(Context* context, const Matrix4f& transform, Vector2f (&corners)[4])
+{
+	constexpr float z_clip = 10'000.f;
+	const Vector2f window_size = Vector2f(context->GetDimensions());
+	const Matrix4f project = Matrix4f::ProjectOrtho(0.f, window_size.x, 0.f, window_size.y, -z_clip, z_clip);
+	const Matrix4f project_transform = project * transform;
+	bool any_vertex_depth_clipped = false;
+
+	for (Vector2f& corner : corners)
+	{
+		const Vector4f pos_clip_space = project_transform * Vector4f(corner.x, corner.y, 0, 1);
+		const Vector2f pos_ndc = Vector2f(pos_clip_space.x, pos_clip_space.y) / pos_clip_space.w;
+		const Vector2f pos_viewport = 0.5f * window_size * (pos_ndc + Vector2f(1));
+		corner = pos_viewport;
+		any_vertex_depth_clipped |= !(-pos_clip_space.w <= pos_clip_space.z && pos_clip_space.z <= pos_clip_space.w);
+	}
+
+	return !any_vertex_depth_clipped;
+}
+
+// Finds the window region covered by a transformed rectangle, if the transform keeps its edges aligned with the window axes, such as for
+// translations and scaling. The region can then be clipped by scissoring instead of a clip mask.
+static bool GetAxisAlignedRegion(Context* context, const Matrix4f& transform, Rectanglef rectangle, Rectanglef& out_region)
+{
+	Vector2f corners[4] = {rectangle.TopLeft(), rectangle.TopRight(), rectangle.BottomRight(), rectangle.BottomLeft()};
+	if (!ProjectCorners(context, transform, corners))
+		return false;
+
+	constexpr float tolerance = 0.01f;
+	auto Equal = [](float a, float b) { return Math::Absolute(a - b) < tolerance; };
+	const bool rows_aligned = Equal(corners[0].y, corners[1].y) && Equal(corners[2].y, corners[3].y) && Equal(corners[0].x, corners[3].x) &&
+		Equal(corners[1].x, corners[2].x);
+	if (!rows_aligned)
+		return false;
+
+	out_region = Rectanglef::FromCorners(Math::Min(corners[0], corners[2]), Math::Max(corners[0], corners[2]));
+	return true;
+}
+
 Element* ElementUtilities::GetElementById(Element* root_element, const String& id)
 {
 	// Breadth first search on elements for the corresponding id
@@ -156,14 +196,31 @@ bool ElementUtilities::GetClippingRegion(Element* element, Rectanglei& out_clip_
 				const bool has_border_radius = (clip_computed.border_top_left_radius() > 0.f || clip_computed.border_top_right_radius() > 0.f ||
 					clip_computed.border_bottom_right_radius() > 0.f || clip_computed.border_bottom_left_radius() > 0.f);
 
+				// A transformed element without border-radius can be clipped by scissoring if its box stays aligned with the window axes.
+				Rectanglef transformed_region;
+				if (transform && has_clipping_content && !has_border_radius)
+				{
+					const Vector2f element_offset = clipping_element->GetAbsoluteOffset(clip_area).Round();
+					const Vector2f element_size = clipping_element->GetRenderBox(clip_area).GetFillSize();
+					if (GetAxisAlignedRegion(clipping_element->GetContext(), *transform,
+							Rectanglef::FromPositionSize(element_offset, element_size), transformed_region))
+					{
+						clip_region = transformed_region.IntersectIfValid(clip_region);
+						transform = nullptr;
+						disable_scissor_clipping = true;
+					}
+				}
+
 				// If the element has border-radius we always use a clip mask, since we can't easily predict if content is located on the curved
 				// region to be clipped. If the element has a transform we only use a clip mask when the content clips.
 				if (has_border_radius || (transform && has_clipping_content))
 				{
-					Geometry* clip_geometry = clipping_element->GetElementBackgroundBorder()->GetClipGeometry(clipping_element, clip_area);
+					const CompiledShader* clip_shader = nullptr;
+					ElementBackgroundBorder* background_border = clipping_element->GetElementBackgroundBorder();
+					Geometry* clip_geometry = background_border->GetClipGeometry(clipping_element, clip_area, clip_shader);
 					const ClipMaskOperation clip_operation = (out_clip_mask_list->empty() ? ClipMaskOperation::Set : ClipMaskOperation::Intersect);
 					const Vector2f absolute_offset = clipping_element->GetAbsoluteOffset(BoxArea::Border).Round();
-					out_clip_mask_list->push_back(ClipMaskGeometry{clip_operation, clip_geometry, absolute_offset, transform});
+					out_clip_mask_list->push_back(ClipMaskGeometry{clip_operation, clip_geometry, absolute_offset, transform, clip_shader});
 				}
 
 				// If we only have border-radius then we add this element to the scissor region as well as the clip mask. This may help with e.g.
@@ -286,26 +343,10 @@ bool ElementUtilities::GetBoundingBox(Rectanglef& out_rectangle, Element* elemen
 		bounds.BottomLeft(),
 	};
 
-	// Transform and project corners to window coordinates.
-	constexpr float z_clip = 10'000.f;
-	const Vector2f window_size = Vector2f(context->GetDimensions());
-	const Matrix4f project = Matrix4f::ProjectOrtho(0.f, window_size.x, 0.f, window_size.y, -z_clip, z_clip);
-	const Matrix4f project_transform = project * (*transform);
-	bool any_vertex_depth_clipped = false;
-
-	for (int i = 0; i < num_corners; i++)
-	{
-		const Vector4f pos_clip_space = project_transform * Vector4f(corners[i].x, corners[i].y, 0, 1);
-		const Vector2f pos_ndc = Vector2f(pos_clip_space.x, pos_clip_space.y) / pos_clip_space.w;
-		const Vector2f pos_viewport = 0.5f * window_size * (pos_ndc + Vector2f(1));
-		corners[i] = pos_viewport;
-		any_vertex_depth_clipped |= !(-pos_clip_space.w <= pos_clip_space.z && pos_clip_space.z <= pos_clip_space.w);
-	}
-
-	// If any part of the box area is outside the depth clip planes we give up finding the bounding box. In this situation a renderer would normally
-	// clip the underlying triangles against the clip planes. We could in principle do the same, but the added complexity does not seem worthwhile for
-	// our use cases.
-	if (any_vertex_depth_clipped)
+	// Transform and project corners to window coordinates. If any part of the box area is outside the depth clip planes we give up finding the
+	// bounding box. In this situation a renderer would normally clip the underlying triangles against the clip planes. We could in principle do
+	// the same, but the added complexity does not seem worthwhile for our use cases.
+	if (!ProjectCorners(context, *transform, corners))
 		return false;
 
 	// Find the rectangle covering the projected corners.
@@ -7,6 +7,7 @@
 #include "../../../Include/RmlUi/Core/StyleSheet.h"
 #include "../../../Include/RmlUi/Core/Texture.h"
 #include "../../../Include/RmlUi/Core/URL.h"
+#include "../ImageGeometryCache.h"
 #include "../TextureDatabase.h"
 
 namespace Rml {
@@ -16,6 +17,7 @@ ElementImage::ElementImage(const String& tag) : Element(tag), dimensions(-1, -1)
 	dimensions_scale = 1.0f;
 	geometry_dirty = false;
 	texture_dirty = true;
+	texture_loading = false;
 }
 
 ElementImage::~ElementImage() {}
@@ -27,6 +29,7 @@ bool ElementImage::GetIntrinsicDimensions(Vector2f& _dimensions, float& _ratio)
 	if (rect_source == RectSource::None)
 	{
 		dimensions = Vector2f(texture.GetDimensions());
+		texture_loading |= texture.IsLoading();
 	}
 	else
 	{
@@ -73,13 +76,25 @@ void ElementImage::EnsureSourceLoaded()
 		LoadTexture();
 }
 
+void ElementImage::OnUpdate()
+{
+	// The texture dimensions may not be known while it is loading, thus update the layout and texture coordinates once it has been loaded.
+	if (texture_loading && !texture.IsLoading())
+	{
+		texture_loading = false;
+		geometry_dirty = true;
+		DirtyLayout();
+	}
+}
+
 void ElementImage::OnRender()
 {
 	// Regenerate the geometry if required (this will be set if 'rect' changes but does not result in a resize).
 	if (geometry_dirty)
 		GenerateGeometry();
 
-	geometry.Render(GetAbsoluteOffset(BoxArea::Border), texture);
+	if (geometry)
+		geometry->geometry.Render(GetAbsoluteOffset(BoxArea::Border), render_texture);
 }
 
 void ElementImage::OnAttributeChange(const ElementAttributes& changed_attributes)
@@ -157,14 +172,12 @@ void ElementImage::OnStyleSheetChange()
 
 void ElementImage::GenerateGeometry()
 {
-	// Release the old geometry before specifying the new vertices.
-	Mesh mesh = geometry.Release(Geometry::ReleaseMode::ClearMesh);
-
 	// Generate the texture coordinates.
 	Vector2f texcoords[2];
 	if (rect_source != RectSource::None)
 	{
 		Vector2f texture_dimensions = Vector2f(Math::Max(texture.GetDimensions(), Vector2i(1)));
+		texture_loading |= texture.IsLoading();
 		texcoords[0] = rect.TopLeft() / texture_dimensions;
 		texcoords[1] = rect.BottomRight() / texture_dimensions;
 	}
@@ -174,14 +187,30 @@ void ElementImage::GenerateGeometry()
 		texcoords[1] = Vector2f(1, 1);
 	}
 
+	RenderManager* render_manager = GetRenderManager();
+
+	// Render from the atlas if the texture is packed into one, as long as the texture coordinates stay within the image.
+	render_texture = texture;
+	Texture atlas_texture;
+	Rectanglef atlas_region;
+	if (render_manager && texture && texcoords[0].x >= 0.f && texcoords[0].y >= 0.f && texcoords[1].x <= 1.f && texcoords[1].y <= 1.f &&
+		render_manager->GetTextureAtlasRegion(texture, atlas_texture, atlas_region))
+	{
+		for (Vector2f& texcoord : texcoords)
+			texcoord = atlas_region.Position() + texcoord * atlas_region.Size();
+		render_texture = atlas_texture;
+	}
+
 	const ComputedValues& computed = GetComputedValues();
 	const ColourbPremultiplied quad_colour = computed.image_color().ToPremultiplied(computed.opacity());
 	const RenderBox render_box = GetRenderBox(BoxArea::Content);
 
-	MeshUtilities::GenerateQuad(mesh, render_box.GetFillOffset(), render_box.GetFillSize(), quad_colour, texcoords[0], texcoords[1]);
-
-	if (RenderManager* render_manager = GetRenderManager())
-		geometry = render_manager->MakeGeometry(std::move(mesh));
+	// The new geometry is acquired before releasing the old one, thus it is reused if nothing affecting it changed.
+	if (render_manager)
+		geometry =
+			ImageGeometryCache::GetHandle({render_manager, render_box.GetFillOffset(), render_box.GetFillSize(), quad_colour, texcoords[0], texcoords[1]});
+	else
+		geometry.reset();
 
 	geometry_dirty = false;
 }
@@ -189,6 +218,7 @@ void ElementImage::GenerateGeometry()
 bool ElementImage::LoadTexture()
 {
 	texture_dirty = false;
+	texture_loading = false;
 	geometry_dirty = true;
 	dimensions_scale = 1.0f;
 
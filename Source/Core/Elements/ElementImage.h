@@ -8,6 +8,8 @@
 
 namespace Rml {
 
+struct ImageRenderable;
+
 /**
     The 'img' element can render images and sprites.
 
@@ -47,6 +49,9 @@ public:
 	void EnsureSourceLoaded();
 
 protected:
+	/// Lays out the image again once its texture has finished loading asynchronously.
+	void OnUpdate() override;
+
 	/// Renders the image.
 	void OnRender() override;
 
@@ -80,8 +85,12 @@ private:
 
 	// The texture this element is rendering from.
 	Texture texture;
+	// The texture used for rendering, this is the atlas texture if the texture is packed into one.
+	Texture render_texture;
 	// True if we need to refetch the texture's source from the element's attributes.
 	bool texture_dirty;
+	// True if the texture was still loading when the dimensions or geometry were last generated, which then need to be updated once loaded.
+	bool texture_loading;
 	// A factor which scales the intrinsic dimensions based on the dp-ratio and image scale.
 	float dimensions_scale;
 	// The element's computed intrinsic dimensions. If either of these values are set to -1, then
@@ -93,8 +102,8 @@ private:
 	Rectanglef rect;
 	enum class RectSource { None, Attribute, Sprite } rect_source;
 
-	// The geometry used to render this element.
-	Geometry geometry;
+	// The geometry used to render this element, shared with other images of equal dimensions, colour, and texture coordinates.
+	SharedPtr<ImageRenderable> geometry;
 	bool geometry_dirty;
 };
 
@@ -86,6 +86,17 @@ void WidgetDropDown::OnUpdate()
 		if (select_option)
 			SetSelection(select_option);
 
+		// Selecting an option only clears the previous selection, clear any other options given the 'selected' attribute in the meantime.
+		for (int i = 0; i < num_options; i++)
+		{
+			Element* option = selection_element->GetChild(i);
+			if (option != selected_option && option->HasAttribute("selected"))
+			{
+				option->RemoveAttribute("selected");
+				option->SetPseudoClass("checked", false);
+			}
+		}
+
 		selection_dirty = false;
 	}
 
@@ -288,24 +299,26 @@ void WidgetDropDown::SetSelection(Element* select_option, bool force)
 	const String old_value = parent_element->GetAttribute("value", String());
 	const String new_value = select_option ? select_option->GetAttribute("value", String()) : String();
 
+	// Only the previously selected option needs to be cleared, thus the cost is independent of the number of options.
+	if (selected_option && selected_option != select_option)
+	{
+		selected_option->RemoveAttribute("selected");
+		selected_option->SetPseudoClass("checked", false);
+	}
+
 	bool newly_selected = false;
-	const int num_options = selection_element->GetNumChildren();
-	for (int i = 0; i < num_options; i++)
+	if (select_option)
 	{
-		Element* option = selection_element->GetChild(i);
+		if (!select_option->IsPseudoClassSet("checked"))
+			newly_selected = true;
+		select_option->SetAttribute("selected", String());
+		select_option->SetPseudoClass("checked", true);
+	}
 
-		if (select_option == option)
-		{
-			if (!option->IsPseudoClassSet("checked"))
-				newly_selected = true;
-			option->SetAttribute("selected", String());
-			option->SetPseudoClass("checked", true);
-		}
-		else
-		{
-			option->RemoveAttribute("selected");
-			option->SetPseudoClass("checked", false);
-		}
+	if (selected_option != select_option)
+	{
+		selected_option = select_option;
+		selected_option_index = -1;
 	}
 
 	if (force || newly_selected || (old_value != new_value))
@@ -340,14 +353,25 @@ void WidgetDropDown::SeekSelection(bool seek_forward)
 
 int WidgetDropDown::GetSelection() const
 {
-	const int num_options = selection_element->GetNumChildren();
-	for (int i = 0; i < num_options; i++)
+	if (!selected_option)
+		return -1;
+
+	// Only look up the index again when the options have been moved since the last lookup.
+	if (selection_element->GetChild(selected_option_index) != selected_option)
 	{
-		if (selection_element->GetChild(i)->HasAttribute("selected"))
-			return i;
+		selected_option_index = -1;
+		const int num_options = selection_element->GetNumChildren();
+		for (int i = 0; i < num_options; i++)
+		{
+			if (selection_element->GetChild(i) == selected_option)
+			{
+				selected_option_index = i;
+				break;
+			}
+		}
 	}
 
-	return -1;
+	return selected_option_index;
 }
 
 int WidgetDropDown::AddOption(const String& rml, const String& option_value, int before, bool select, bool selectable)
@@ -443,7 +467,7 @@ void WidgetDropDown::OnChildRemove(Element* element)
 
 	element->RemoveEventListener(EventId::Click, this);
 
-	if (element->HasAttribute("selected"))
+	if (element == selected_option)
 		SetSelection(nullptr);
 
 	selection_dirty = true;
@@ -472,24 +496,17 @@ void WidgetDropDown::ProcessEvent(Event& event)
 	{
 	case EventId::Click:
 	{
-		if (event.GetCurrentElement()->GetParentNode() == selection_element)
+		Element* current_element = event.GetCurrentElement();
+		if (current_element->GetParentNode() == selection_element)
 		{
-			const int num_options = selection_element->GetNumChildren();
-			// Find the element in the options and fire the selection event
-			for (int i = 0; i < num_options; i++)
+			// The listener is only attached to options, fire the selection event for the clicked option.
+			if (!current_element->HasAttribute("disabled"))
 			{
-				Element* current_element = event.GetCurrentElement();
-				if (selection_element->GetChild(i) == current_element)
-				{
-					if (!event.GetCurrentElement()->HasAttribute("disabled"))
-					{
-						SetSelection(current_element);
-						event.StopPropagation();
-
-						HideSelectBox();
-						parent_element->Focus();
-					}
-				}
+				SetSelection(current_element);
+				event.StopPropagation();
+
+				HideSelectBox();
+				parent_element->Focus();
 			}
 		}
 		else
@@ -93,6 +93,11 @@ private:
 
 	String selected_value_on_box_open;
 
+	// The option selected through this widget, and its index among the options when last looked up. The index is validated before use, since
+	// options may be added or removed in the meantime.
+	Element* selected_option = nullptr;
+	mutable int selected_option_index = -1;
+
 	bool lock_selection = false;
 	bool selection_dirty = false;
 	bool value_rml_dirty = false;
@@ -15,6 +15,7 @@
 #include "../../../Include/RmlUi/Core/SystemInterface.h"
 #include "../../../Include/RmlUi/Core/TextInputContext.h"
 #include "../../../Include/RmlUi/Core/TextInputHandler.h"
+#include "../../../Include/RmlUi/Core/TextShapingContext.h"
 #include "../Clock.h"
 #include "ElementTextSelection.h"
 #include <algorithm>
@@ -53,6 +54,24 @@ static bool ClampValue(String& value, int max_length)
 	return false;
 }
 
+// Finds the byte range that differs between the two strings, as the length of their common prefix and suffix.
+static void FindChangedRange(const String& previous_value, const String& new_value, int& out_begin, int& out_previous_end, int& out_new_end)
+{
+	const size_t min_size = Math::Min(previous_value.size(), new_value.size());
+
+	size_t prefix = 0;
+	while (prefix < min_size && previous_value[prefix] == new_value[prefix])
+		prefix++;
+
+	size_t suffix = 0;
+	while (suffix < min_size - prefix && previous_value[previous_value.size() - 1 - suffix] == new_value[new_value.size() - 1 - suffix])
+		suffix++;
+
+	out_begin = (int)prefix;
+	out_previous_end = int(previous_value.size() - suffix);
+	out_new_end = int(new_value.size() - suffix);
+}
+
 class WidgetTextInputContext final : public TextInputContext {
 public:
 	WidgetTextInputContext(TextInputHandler* handler, WidgetTextInput* _owner, ElementFormControl* _element);
@@ -174,6 +193,7 @@ WidgetTextInput::WidgetTextInput(ElementFormControl* _parent)
 	parent->AddEventListener(EventId::Mousedown, this, true);
 	parent->AddEventListener(EventId::Dblclick, this, true);
 	parent->AddEventListener(EventId::Drag, this, true);
+	parent->AddEventListener(EventId::Scroll, this, true);
 
 	ElementPtr unique_text = Factory::InstanceElement(parent, "#text", "#text", XMLAttributes());
 	text_element = rmlui_dynamic_cast<ElementText*>(unique_text.get());
@@ -214,6 +234,10 @@ WidgetTextInput::WidgetTextInput(ElementFormControl* _parent)
 	ime_composition_begin_index = 0;
 	ime_composition_end_index = 0;
 
+	text_version = 0;
+	generated_lines_begin = 0;
+	generated_lines_end = 0;
+
 	last_update_time = 0;
 	ink_overflow = false;
 
@@ -229,6 +253,7 @@ WidgetTextInput::~WidgetTextInput()
 	parent->RemoveEventListener(EventId::Mousedown, this, true);
 	parent->RemoveEventListener(EventId::Dblclick, this, true);
 	parent->RemoveEventListener(EventId::Drag, this, true);
+	parent->RemoveEventListener(EventId::Scroll, this, true);
 
 	// This widget might be parented by an input element, which may now be constructing a completely different type.
 	// Thus, remove all properties set by this widget so they don't affect the new type.
@@ -259,6 +284,15 @@ void WidgetTextInput::SetValue(String value)
 	{
 		TransformValue(value);
 
+		// Record the changed range of the text, so that formatting only needs to reflow the affected lines.
+		const String& previous_value = text_element->GetText();
+		if (value != previous_value)
+		{
+			last_text_edit.text_version = text_version;
+			FindChangedRange(previous_value, value, last_text_edit.begin, last_text_edit.previous_end, last_text_edit.new_end);
+			text_version += 1;
+		}
+
 		text_element->SetText(value);
 
 		// Reset the IME composition range when the value changes.
@@ -424,6 +458,7 @@ void WidgetTextInput::OnUpdate()
 		{
 			cursor_timer += CURSOR_BLINK_TIME;
 			cursor_visible = !cursor_visible;
+			parent->DirtyRenderCache();
 		}
 
 		if (parent->IsVisible(true))
@@ -496,6 +531,19 @@ void WidgetTextInput::DispatchChangeEvent(bool linebreak)
 
 void WidgetTextInput::ProcessEvent(Event& event)
 {
+	// Only the lines near the visible area are placed in the text elements, so scrolling may need to place additional lines.
+	if (event == EventId::Scroll)
+	{
+		if (event.GetTargetElement() == parent)
+		{
+			int visible_begin = 0, visible_end = 0;
+			GetVisibleLineRange(visible_begin, visible_end);
+			if (visible_begin < generated_lines_begin || visible_end > generated_lines_end)
+				GenerateVisibleLines();
+		}
+		return;
+	}
+
 	if (parent->IsDisabled())
 		return;
 
@@ -991,34 +1039,31 @@ void WidgetTextInput::GetRelativeCursorIndices(int& out_cursor_line_index, int&
 		return;
 	}
 
-	int line_begin = 0;
+	// Find the first line where the absolute index is located on or before the end of its editable part, otherwise we wrap down to the next line.
+	// We may have additional characters after the editable length, such as the newline character '\n'. We also wrap down if the cursor is located
+	// to the right of any such characters.
+	auto it_line = std::lower_bound(lines.begin(), lines.end(), absolute_cursor_index,
+		[](const Line& line, int index) { return line.value_offset + line.editable_length < index; });
 
-	for (size_t i = 0; i < lines.size(); i++)
+	if (it_line != lines.end())
 	{
-		const int cursor_relative_line_end = absolute_cursor_index - (line_begin + lines[i].editable_length);
+		const int i = int(it_line - lines.begin());
+		const int line_begin = it_line->value_offset;
+		const int cursor_relative_line_end = absolute_cursor_index - (line_begin + it_line->editable_length);
+		const bool soft_wrapped_line = (it_line->editable_length == it_line->size);
 
-		// Test if the absolute index is located on the editable part of this line, otherwise we wrap down to the next line. We may have additional
-		// characters after the editable length, such as the newline character '\n'. We also wrap down if the cursor is located to the right of any
-		// such characters.
-		if (cursor_relative_line_end <= 0)
+		// If we are located exactly on a soft break (due to word wrapping) then the cursor wrap state determines whether or not we wrap down.
+		if (cursor_relative_line_end == 0 && soft_wrapped_line && cursor_wrap_down && i + 1 < (int)lines.size())
 		{
-			const bool soft_wrapped_line = (lines[i].editable_length == lines[i].size);
-
-			// If we are located exactly on a soft break (due to word wrapping) then the cursor wrap state determines whether or not we wrap down.
-			if (cursor_relative_line_end == 0 && soft_wrapped_line && cursor_wrap_down && (int)i + 1 < (int)lines.size())
-			{
-				out_cursor_line_index = (int)i + 1;
-				out_cursor_character_index = 0;
-			}
-			else
-			{
-				out_cursor_line_index = (int)i;
-				out_cursor_character_index = Math::Max(absolute_cursor_index - line_begin, 0);
-			}
-			return;
+			out_cursor_line_index = i + 1;
+			out_cursor_character_index = 0;
 		}
-
-		line_begin += lines[i].size;
+		else
+		{
+			out_cursor_line_index = i;
+			out_cursor_character_index = Math::Max(absolute_cursor_index - line_begin, 0);
+		}
+		return;
 	}
 
 	// We shouldn't ever get here; this means we actually couldn't find where the absolute cursor said it was. So we'll
@@ -1046,10 +1091,7 @@ void WidgetTextInput::SetCursorFromRelativeIndices(int cursor_line_index, int cu
 	// Now this assertion will actually hold true logic-wise
 	RMLUI_ASSERT(cursor_line_index < (int)lines.size())
 
-	absolute_cursor_index = cursor_character_index;
-
-	for (int i = 0; i < cursor_line_index; i++)
-		absolute_cursor_index += lines[i].size;
+	absolute_cursor_index = lines[cursor_line_index].value_offset + cursor_character_index;
 
 	// Only wrap down if we're not located at the end of the line.
 	cursor_wrap_down = (cursor_character_index < lines[cursor_line_index].editable_length);
@@ -1067,13 +1109,14 @@ int WidgetTextInput::CalculateLineIndex(float position) const
 float WidgetTextInput::GetAlignmentSpecificTextOffset(const Line& line) const
 {
 	// Callback to avoid expensive calculation in the cases where it is not needed.
-	auto RemainingWidth = [this](StringView editable_line_string) {
-		const float total_width = (float)ElementUtilities::GetStringWidth(text_element, editable_line_string);
+	auto RemainingWidth = [this, &line](bool exclude_last_character) {
+		const Vector<int>& prefix_widths = GetPrefixWidths(line);
+		const int num_characters = (int)prefix_widths.size() - (exclude_last_character ? 1 : 0);
+		const float total_width = (num_characters > 0 ? (float)prefix_widths[num_characters - 1] : 0.f);
 		return GetAvailableWidth() - total_width;
 	};
 
 	const String& value = GetValue();
-	StringView editable_line_string(value, line.value_offset, line.editable_length);
 
 	switch (parent->GetComputedValues().text_align())
 	{
@@ -1083,13 +1126,10 @@ float WidgetTextInput::GetAlignmentSpecificTextOffset(const Line& line) const
 		// For right alignment with soft-wrapped newlines, remove up to a single space to align the last word to the right edge.
 		const bool is_last_line = (line.value_offset + line.size == (int)value.size());
 		const bool is_soft_wrapped = (!is_last_line && line.editable_length == line.size);
-		if (is_soft_wrapped && !editable_line_string.empty() && *(editable_line_string.end() - 1) == ' ')
-		{
-			editable_line_string = StringView(editable_line_string.begin(), editable_line_string.end() - 1);
-		}
-		return Math::Max(0.0f, RemainingWidth(editable_line_string));
+		const bool ends_with_space = (line.editable_length > 0 && value[line.value_offset + line.editable_length - 1] == ' ');
+		return Math::Max(0.0f, RemainingWidth(is_soft_wrapped && ends_with_space));
 	}
-	case Style::TextAlign::Center: return Math::Max(0.0f, 0.5f * RemainingWidth(editable_line_string));
+	case Style::TextAlign::Center: return Math::Max(0.0f, 0.5f * RemainingWidth(false));
 	case Style::TextAlign::Justify: return 0;
 	}
 	return 0;
@@ -1105,45 +1145,60 @@ int WidgetTextInput::CalculateCharacterIndex(int line_index, float position)
 	else if (line_index >= (int)lines.size())
 		line_index = (int)lines.size() - 1;
 
-	int prev_offset = 0;
-	float prev_line_width = 0;
-
 	ideal_cursor_position_to_the_right_of_cursor = true;
 
 	const Line& line = lines[line_index];
+	const Vector<int>& prefix_widths = GetPrefixWidths(line);
+
+	position -= GetAlignmentSpecificTextOffset(line);
+
+	// Find the first character extending past the position.
+	const auto it_width = std::upper_bound(prefix_widths.begin(), prefix_widths.end(), position, [](float x, int width) { return x < float(width); });
+	if (it_width == prefix_widths.end())
+		return line.editable_length;
+
 	const char* p_begin = GetValue().data() + line.value_offset;
 	const char* p_end = p_begin + line.editable_length;
 
-	position -= GetAlignmentSpecificTextOffset(line);
+	// Returns the byte offset on the line after the given number of characters.
+	auto GetOffset = [p_begin, p_end](int num_characters) {
+		const char* p = p_begin;
+		for (int i = 0; i < num_characters && p != p_end; i++)
+			p = StringUtilities::SeekForwardUTF8(p + 1, p_end);
+		return int(p - p_begin);
+	};
 
-	for (auto it = StringIteratorU8(p_begin, p_begin, p_end); it;)
-	{
-		++it;
-		const int offset = (int)it.offset();
+	const int num_preceding_characters = int(it_width - prefix_widths.begin());
+	const float prev_line_width = (num_preceding_characters > 0 ? float(prefix_widths[num_preceding_characters - 1]) : 0.f);
+	const float line_width = float(*it_width);
 
-		const float line_width = (float)ElementUtilities::GetStringWidth(text_element, StringView(p_begin, p_begin + offset));
-		if (line_width > position)
+	if (position - prev_line_width < line_width - position)
+		return GetOffset(num_preceding_characters);
+
+	ideal_cursor_position_to_the_right_of_cursor = false;
+	return GetOffset(num_preceding_characters + 1);
+}
+
+const Vector<int>& WidgetTextInput::GetPrefixWidths(const Line& line) const
+{
+	if (line.prefix_widths.empty() && line.editable_length > 0)
+	{
+		if (const FontFaceHandle font_handle = text_element->GetFontFaceHandle())
 		{
-			if (position - prev_line_width < line_width - position)
-			{
-				return prev_offset;
-			}
-			else
-			{
-				ideal_cursor_position_to_the_right_of_cursor = false;
-				return offset;
-			}
+			const auto& computed = text_element->GetComputedValues();
+			const TextShapingContext text_shaping_context{computed.language(), computed.direction(), computed.font_kerning(),
+				computed.letter_spacing()};
+			GetFontEngineInterface()->GetStringPrefixWidths(font_handle, StringView(GetValue(), line.value_offset, line.editable_length),
+				text_shaping_context, Character::Null, line.prefix_widths);
 		}
-
-		prev_line_width = line_width;
-		prev_offset = offset;
 	}
-
-	return prev_offset;
+	return line.prefix_widths;
 }
 
 void WidgetTextInput::ShowCursor(bool show, bool move_to_cursor)
 {
+	parent->DirtyRenderCache();
+
 	if (show)
 	{
 		cursor_visible = true;
@@ -1209,7 +1264,7 @@ void WidgetTextInput::FormatElement()
 	const float formatting_height_constraint = (y_overflow_property == Overflow::Auto ? GetAvailableHeight() : FLT_MAX);
 
 	// Format the text and determine its total area.
-	Vector2f content_area = FormatText(formatting_height_constraint);
+	Vector2f content_area = FormatLines(formatting_height_constraint);
 
 	// If we're set to automatically generate horizontal scrollbars, check for that now.
 	if (!word_wrap && x_overflow_property == Overflow::Auto && content_area.x > GetAvailableWidth() + OVERFLOW_TOLERANCE)
@@ -1219,7 +1274,7 @@ void WidgetTextInput::FormatElement()
 	if (y_overflow_property == Overflow::Auto && content_area.y > GetAvailableHeight() + OVERFLOW_TOLERANCE)
 	{
 		scroll->EnableScrollbar(ElementScroll::VERTICAL, width);
-		content_area = FormatText();
+		content_area = FormatLines();
 
 		if (!word_wrap && x_overflow_property == Overflow::Auto && content_area.x > GetAvailableWidth() + OVERFLOW_TOLERANCE)
 			scroll->EnableScrollbar(ElementScroll::HORIZONTAL, width);
@@ -1229,27 +1284,194 @@ void WidgetTextInput::FormatElement()
 	const Vector2f padding_size = parent->GetBox().GetFrameSize(BoxArea::Padding);
 	parent->SetScrollableOverflowRectangle(content_area + padding_size, true);
 	scroll->FormatScrollbars();
+
+	GenerateVisibleLines();
 }
 
-Vector2f WidgetTextInput::FormatText(float height_constraint)
+void WidgetTextInput::FormatText()
 {
-	Vector2f content_area(0, 0);
+	FormatLines();
+	GenerateVisibleLines();
+}
 
+Vector2f WidgetTextInput::FormatLines(float height_constraint)
+{
 	const FontFaceHandle font_handle = parent->GetFontFaceHandle();
-	if (!font_handle)
+	const float maximum_line_width = GetAvailableWidth() - cursor_size.x;
+
+	if (!font_handle || maximum_line_width <= 0.f)
 	{
 		lines.clear();
-		text_element->ClearLines();
-		selected_text_element->ClearLines();
-		return content_area;
+		if (font_handle)
+			lines.push_back(Line{});
+		lines_key = {};
+		absolute_cursor_index = Math::Min(absolute_cursor_index, (int)GetValue().size());
+		return Vector2f(0, 0);
 	}
 
-	const FontMetrics& font_metrics = GetFontEngineInterface()->GetFontMetrics(font_handle);
+	// A layout can be reused if it was formatted in the same way, either from the current text or the text right before the last edit.
+	auto IsReusable = [&](const LineLayoutKey& key) {
+		return key.complete && key.font_handle == font_handle && key.maximum_line_width == maximum_line_width &&
+			(key.text_version == text_version || key.text_version == last_text_edit.text_version);
+	};
+
+	// The alternate layout is typically the one formatted with the other scrollbar configuration.
+	if (!IsReusable(lines_key) && IsReusable(alternate_lines_key))
+	{
+		std::swap(lines, alternate_lines);
+		std::swap(lines_key, alternate_lines_key);
+	}
+
+	if (IsReusable(lines_key))
+	{
+		if (lines_key.text_version != text_version)
+			ReflowEditedLines(maximum_line_width);
+	}
+	else
+	{
+		// Keep the current layout as the alternate one, it may be reused when formatting for its width again.
+		if (lines_key.complete)
+		{
+			std::swap(lines, alternate_lines);
+			std::swap(lines_key, alternate_lines_key);
+		}
+		lines_key.complete = FormatAllLines(maximum_line_width, height_constraint);
+	}
+
+	lines_key.font_handle = font_handle;
+	lines_key.maximum_line_width = maximum_line_width;
+	lines_key.text_version = text_version;
+
+	// Clamp the cursor to a valid range.
+	absolute_cursor_index = Math::Min(absolute_cursor_index, (int)GetValue().size());
+
+	Vector2f content_area(0, float(lines.size()) * GetLineHeight());
+	for (const Line& line : lines)
+		content_area.x = Math::Max(content_area.x, line.width + cursor_size.x);
+
+	return content_area;
+}
+
+bool WidgetTextInput::FormatAllLines(float maximum_line_width, float height_constraint)
+{
+	const float line_height = GetLineHeight();
+	int line_begin = 0;
+	bool last_line = false;
 
-	// Clear the old lines, and all the lines in the text elements.
 	lines.clear();
+
+	// Keep generating lines until all the text content is placed.
+	do
+	{
+		Line line = {};
+		last_line = GenerateLine(line, line_begin, maximum_line_width);
+		line_begin += line.size;
+		lines.push_back(line);
+	} while (!last_line && float(lines.size()) * line_height <= height_constraint + OVERFLOW_TOLERANCE);
+
+	return last_line;
+}
+
+void WidgetTextInput::ReflowEditedLines(float maximum_line_width)
+{
+	RMLUI_ASSERT(!lines.empty());
+
+	const String& text = GetValue();
+	const TextEdit& edit = last_text_edit;
+	const int size_change = edit.new_end - edit.previous_end;
+
+	// Start from the line containing the beginning of the edit, and move back to the beginning of its paragraph. Within a paragraph, words may
+	// wrap back to previous lines, while lines following a hard line break are independent of any text before it.
+	auto it_edit_line =
+		std::upper_bound(lines.begin(), lines.end(), edit.begin, [](int index, const Line& line) { return index < line.value_offset; });
+	int first_line = Math::Max(int(it_edit_line - lines.begin()) - 1, 0);
+	while (first_line > 0 && text[lines[first_line].value_offset - 1] != '\n')
+		first_line -= 1;
+
+	reflowed_lines.clear();
+
+	int line_begin = lines[first_line].value_offset;
+	size_t next_previous_line = (size_t)first_line;
+	bool last_line = false;
+
+	while (!last_line)
+	{
+		Line line = {};
+		last_line = GenerateLine(line, line_begin, maximum_line_width);
+		line_begin += line.size;
+		reflowed_lines.push_back(line);
+
+		if (last_line)
+		{
+			next_previous_line = lines.size();
+			break;
+		}
+
+		// A line is only formatted from the text following its beginning. Thus, once a line begins at the same position as one in the previous
+		// layout, and the text from there on is unchanged, all the following lines are identical to the previous ones apart from their offset.
+		while (next_previous_line < lines.size() && lines[next_previous_line].value_offset + size_change < line_begin)
+			next_previous_line += 1;
+
+		if (next_previous_line < lines.size() && lines[next_previous_line].value_offset + size_change == line_begin &&
+			lines[next_previous_line].value_offset >= edit.previous_end)
+			break;
+	}
+
+	for (size_t i = next_previous_line; i < lines.size(); i++)
+		lines[i].value_offset += size_change;
+
+	lines.erase(lines.begin() + first_line, lines.begin() + next_previous_line);
+	lines.insert(lines.begin() + first_line, reflowed_lines.begin(), reflowed_lines.end());
+}
+
+bool WidgetTextInput::GenerateLine(Line& line, int line_begin, float maximum_line_width)
+{
+	line.value_offset = line_begin;
+
+	// Generate the next line.
+	bool last_line = text_element->GenerateLine(line_content, line.size, line.width, line_begin, maximum_line_width, 0, false, false, false);
+
+	// Check if the editable length needs to be truncated to dodge a trailing endline.
+	line.editable_length = (int)line_content.size();
+	line.content_length = (int)line_content.size();
+	if (!line_content.empty() && line_content.back() == '\n')
+		line.editable_length -= 1;
+
+	// Include all spaces at the end of this line, if they were not included due to soft-wrapping in `GenerateLine`.
+	// This helps prevent sudden shifts when whitespace wraps down to the next line.
+	const String& text = GetValue();
+	size_t i_space_begin = size_t(line_begin + line.editable_length);
+	size_t i_space_end = Math::Min(text.find_first_not_of(' ', i_space_begin), text.size());
+	size_t count = i_space_end - i_space_begin;
+	if (count > 0)
+	{
+		line.width += ElementUtilities::GetStringWidth(text_element, " ") * (int)count;
+		line.content_length += (int)count;
+		line.editable_length += (int)count;
+		line.size += (int)count;
+		// Consume the hard wrap if we have one on this line, so that it doesn't make its own, empty line.
+		if (text[i_space_end] == '\n')
+			line.size += 1;
+		// If the spaces extend all the way to the end, we have consumed all the lines.
+		if (i_space_end == text.size())
+			last_line = true;
+	}
+
+	return last_line;
+}
+
+void WidgetTextInput::GenerateVisibleLines()
+{
 	text_element->ClearLines();
 	selected_text_element->ClearLines();
+	generated_lines_begin = 0;
+	generated_lines_end = 0;
+
+	const FontFaceHandle font_handle = parent->GetFontFaceHandle();
+	if (!font_handle)
+		return;
+
+	const FontMetrics& font_metrics = GetFontEngineInterface()->GetFontMetrics(font_handle);
 
 	// Determine the line-height of the text element.
 	const float line_height = GetLineHeight();
@@ -1261,63 +1483,31 @@ Vector2f WidgetTextInput::FormatText(float height_constraint)
 	const int endline_font_width = int(0.4f * parent->GetComputedValues().font_size());
 
 	const float available_width = GetAvailableWidth();
-	int line_begin = 0;
-	Vector2f line_position = {0, top_to_baseline};
-	bool last_line = false;
-
 	float max_selection_right_edge = 0;
 
 	// Clear the selection background and IME composition geometry, and get the vertices and indices so the new geometry can be generated.
 	Mesh selection_composition_mesh = selection_composition_geometry.Release(Geometry::ReleaseMode::ClearMesh);
 
-	// Keep generating lines until all the text content is placed.
-	do
-	{
-		const float maximum_line_width = available_width - cursor_size.x;
-		if (maximum_line_width <= 0.f)
-		{
-			lines.push_back(Line{});
-			break;
-		}
-
-		Line line = {};
-		line.value_offset = line_begin;
-		float line_width;
-		String line_content;
+	// Only place the lines near the visible area, with an additional page of lines on either side so that scrolling rarely needs to place
+	// new lines. This keeps the cost of generating the text geometry independent of the total number of lines.
+	int visible_begin = 0, visible_end = 0;
+	GetVisibleLineRange(visible_begin, visible_end);
+	const int num_margin_lines = Math::Max(visible_end - visible_begin, 1);
+	generated_lines_begin = Math::Max(visible_begin - num_margin_lines, 0);
+	generated_lines_end = Math::Min(visible_end + num_margin_lines, (int)lines.size());
 
-		// Generate the next line.
-		last_line = text_element->GenerateLine(line_content, line.size, line_width, line_begin, maximum_line_width, 0, false, false, false);
+	const String& text = GetValue();
 
-		// Check if the editable length needs to be truncated to dodge a trailing endline.
-		line.editable_length = (int)line_content.size();
-		if (!line_content.empty() && line_content.back() == '\n')
-			line.editable_length -= 1;
+	for (int line_index = generated_lines_begin; line_index < generated_lines_end; line_index++)
+	{
+		const Line& line = lines[line_index];
+		const int line_begin = line.value_offset;
+		Vector2f line_position = {0, top_to_baseline + float(line_index) * line_height};
 
-		// Include all spaces at the end of this line, if they were not included due to soft-wrapping in `GenerateLine`.
-		// This helps prevent sudden shifts when whitespace wraps down to the next line.
-		{
-			const String& text = GetValue();
-			size_t i_space_begin = size_t(line_begin + line.editable_length);
-			size_t i_space_end = Math::Min(text.find_first_not_of(' ', i_space_begin), text.size());
-			size_t count = i_space_end - i_space_begin;
-			if (count > 0)
-			{
-				line_content.append(count, ' ');
-				line_width += ElementUtilities::GetStringWidth(text_element, " ") * (int)count;
-				line.editable_length += (int)count;
-				line.size += (int)count;
-				// Consume the hard wrap if we have one on this line, so that it doesn't make its own, empty line.
-				if (text[i_space_end] == '\n')
-					line.size += 1;
-				// If the spaces extend all the way to the end, we have consumed all the lines.
-				if (i_space_end == text.size())
-					last_line = true;
-			}
-		}
+		line_content.assign(text, Math::Min((size_t)line_begin, text.size()), (size_t)line.content_length);
 
-		// Now that we have the string of characters appearing on the new line, we split it into
-		// three parts; the unselected text appearing before any selected text on the line, the
-		// selected text on the line, and any unselected text after the selection.
+		// Now that we have the string of characters appearing on the line, we split it into three parts; the unselected text appearing before
+		// any selected text on the line, the selected text on the line, and any unselected text after the selection.
 		StringView pre_selection, selection, post_selection;
 		GetLineSelection(pre_selection, selection, post_selection, line_content, line_begin);
 
@@ -1388,25 +1578,10 @@ Vector2f WidgetTextInput::FormatText(float height_constraint)
 			MeshUtilities::GenerateLine(selection_composition_mesh, composition_position, line_size,
 				parent->GetComputedValues().color().ToPremultiplied());
 		}
-
-		// Update variables for the next line.
-		line_begin += line.size;
-		line_position.x = 0;
-		line_position.y += line_height;
-
-		// Grow the content area width-wise if this line is the longest so far, and push the height out.
-		content_area.x = Math::Max(content_area.x, line_width + cursor_size.x);
-		content_area.y = line_position.y - top_to_baseline;
-
-		// Finally, push the new line into our array of lines.
-		lines.push_back(std::move(line));
-
-	} while (!last_line && content_area.y <= height_constraint + OVERFLOW_TOLERANCE);
-
-	// Clamp the cursor to a valid range.
-	absolute_cursor_index = Math::Min(absolute_cursor_index, (int)GetValue().size());
+	}
 
 	selection_composition_geometry = parent->GetRenderManager()->MakeGeometry(std::move(selection_composition_mesh));
+	parent->DirtyRenderCache();
 
 	// Overflow is automatically caught by any text overflowing the content area. However, sometimes it is possible that
 	// the selection box extends beyond the text and outside the content area. This can even overflow the element
@@ -1421,8 +1596,24 @@ Vector2f WidgetTextInput::FormatText(float height_constraint)
 		ink_overflow = new_ink_overflow;
 		parent->SetProperty(PropertyId::Clip, Property(ink_overflow ? Style::Clip::Type::Always : Style::Clip::Type::Auto));
 	}
+}
+
+void WidgetTextInput::GetVisibleLineRange(int& out_begin, int& out_end) const
+{
+	const int num_lines = (int)lines.size();
+	const float line_height = GetLineHeight();
+	if (line_height <= 0.f)
+	{
+		out_begin = 0;
+		out_end = num_lines;
+		return;
+	}
 
-	return content_area;
+	const float visible_top = parent->GetScrollTop() - parent->GetBox().GetEdge(BoxArea::Padding, BoxEdge::Top);
+	const float visible_bottom = visible_top + parent->GetClientHeight();
+
+	out_begin = Math::Clamp(int(visible_top / line_height), 0, num_lines);
+	out_end = Math::Clamp(int(visible_bottom / line_height) + 1, out_begin, num_lines);
 }
 
 void WidgetTextInput::GenerateCursor()
@@ -1441,11 +1632,16 @@ void WidgetTextInput::GenerateCursor()
 	Mesh mesh = cursor_geometry.Release(Geometry::ReleaseMode::ClearMesh);
 	MeshUtilities::GenerateQuad(mesh, Vector2f(0, 0), cursor_size, color.ToPremultiplied());
 	cursor_geometry = parent->GetRenderManager()->MakeGeometry(std::move(mesh));
+	parent->DirtyRenderCache();
 }
 
 void WidgetTextInput::ForceFormattingOnNextLayout()
 {
 	force_formatting_on_next_layout = true;
+
+	// The formatting properties may have changed, thus the previous line layouts can no longer be reused.
+	lines_key = {};
+	alternate_lines_key = {};
 }
 
 void WidgetTextInput::UpdateCursorPosition(bool update_ideal_cursor_position)
@@ -1457,8 +1653,10 @@ void WidgetTextInput::UpdateCursorPosition(bool update_ideal_cursor_position)
 	GetRelativeCursorIndices(cursor_line_index, cursor_character_index);
 
 	const auto& line = lines[cursor_line_index];
-	const int string_width_pre_cursor =
-		ElementUtilities::GetStringWidth(text_element, StringView(GetValue(), line.value_offset, cursor_character_index));
+	const Vector<int>& prefix_widths = GetPrefixWidths(line);
+	const int num_characters_pre_cursor =
+		Math::Min((int)StringUtilities::LengthUTF8(StringView(GetValue(), line.value_offset, cursor_character_index)), (int)prefix_widths.size());
+	const int string_width_pre_cursor = (num_characters_pre_cursor > 0 ? prefix_widths[num_characters_pre_cursor - 1] : 0);
 	const float alignment_offset = GetAlignmentSpecificTextOffset(line);
 
 	cursor_position = {
@@ -1472,6 +1670,8 @@ void WidgetTextInput::UpdateCursorPosition(bool update_ideal_cursor_position)
 
 	if (update_ideal_cursor_position)
 		ideal_cursor_position = cursor_position.x;
+
+	parent->DirtyRenderCache();
 }
 
 bool WidgetTextInput::UpdateSelection(bool selecting)
@@ -129,6 +129,29 @@ private:
 		int size;
 		// The length of the editable characters on the line (excluding any trailing endline).
 		int editable_length;
+		// The length of the displayed contents of the line.
+		int content_length;
+		// The width of the displayed contents of the line.
+		float width;
+		// The width of the editable characters up to and including each code point, measured on first use. Used for locating the cursor.
+		mutable Vector<int> prefix_widths;
+	};
+
+	// Identifies the text and formatting parameters that a line layout was generated from.
+	struct LineLayoutKey {
+		FontFaceHandle font_handle = 0;
+		float maximum_line_width = -1.f;
+		int text_version = -1;
+		// False if the formatting was aborted before reaching the end of the text.
+		bool complete = false;
+	};
+
+	// The byte range of the displayed value that was replaced during a change to the text of the given version.
+	struct TextEdit {
+		int text_version = -1;
+		int begin = 0;
+		int previous_end = 0;
+		int new_end = 0;
 	};
 
 	/// Returns the displayed value of the text field.
@@ -175,10 +198,27 @@ private:
 
 	/// Formats the element, laying out the text and inserting scrollbars as appropriate.
 	void FormatElement();
-	/// Formats the input element's text field.
+	/// Formats the input element's text field, only reflowing the lines affected by changes to the text since the last formatting.
+	void FormatText();
+	/// Breaks the text into lines, reusing the previous line layout where possible.
 	/// @param[in] height_constraint Abort formatting when the formatted size grows larger than this height.
 	/// @return The content area of the element.
-	Vector2f FormatText(float height_constraint = FLT_MAX);
+	Vector2f FormatLines(float height_constraint = FLT_MAX);
+	/// Breaks all of the text into lines from scratch.
+	/// @return True if the end of the text was reached, false if formatting was aborted due to the height constraint.
+	bool FormatAllLines(float maximum_line_width, float height_constraint);
+	/// Reflows the lines affected by the last edit of the text, from the beginning of its paragraph until the line breaks coincide with the
+	/// previous layout again.
+	void ReflowEditedLines(float maximum_line_width);
+	/// Generates a single line of text.
+	/// @param[out] line The generated line.
+	/// @param[in] line_begin The index of the first character on the line.
+	/// @return True if this is the last line of the text.
+	bool GenerateLine(Line& line, int line_begin, float maximum_line_width);
+	/// Places the lines in and near the visible area in the text elements, and generates their selection and IME composition geometry.
+	void GenerateVisibleLines();
+	/// Returns the range of lines intersecting the visible area of the element.
+	void GetVisibleLineRange(int& out_begin, int& out_end) const;
 
 	/// Updates the position to render the cursor.
 	/// @param[in] update_ideal_cursor_position Generally should be true on horizontal movement and false on vertical movement.
@@ -215,6 +255,8 @@ private:
 
 	/// Returns the offset that aligns the contents of the line according to the 'text-align' property.
 	float GetAlignmentSpecificTextOffset(const Line& line) const;
+	/// Returns the width of every prefix of the line's editable characters, one entry per code point.
+	const Vector<int>& GetPrefixWidths(const Line& line) const;
 
 	/// Returns the used line height.
 	float GetLineHeight() const;
@@ -231,6 +273,22 @@ private:
 
 	using LineList = Vector<Line>;
 	LineList lines;
+	LineLayoutKey lines_key;
+	// The previous line layout for another width, so that formatting both with and without a scrollbar can reuse their layout.
+	LineList alternate_lines;
+	LineLayoutKey alternate_lines_key;
+
+	// Incremented whenever the displayed value changes.
+	int text_version;
+	TextEdit last_text_edit;
+
+	// The range of lines currently placed in the text elements.
+	int generated_lines_begin;
+	int generated_lines_end;
+
+	// Buffers reused during formatting to avoid allocations.
+	String line_content;
+	LineList reflowed_lines;
 
 	// Length in number of characters.
 	int max_length;
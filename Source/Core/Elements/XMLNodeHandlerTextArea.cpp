@@ -4,6 +4,7 @@
 #include "../../../Include/RmlUi/Core/Factory.h"
 #include "../../../Include/RmlUi/Core/SystemInterface.h"
 #include "../../../Include/RmlUi/Core/XMLParser.h"
+#include "../TranslationCache.h"
 
 namespace Rml {
 
@@ -40,7 +41,7 @@ bool XMLNodeHandlerTextArea::ElementData(XMLParser* parser, const String& data,
 	{
 		// Do any necessary translation.
 		String translated_data;
-		GetSystemInterface()->TranslateString(translated_data, data);
+		TranslationCache::TranslateString(translated_data, data);
 
 		text_area->SetValue(translated_data);
 	}
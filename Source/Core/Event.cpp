@@ -8,6 +8,31 @@ Event::Event() {}
 
 Event::Event(Element* _target_element, EventId id, const String& type, const Dictionary& _parameters, bool interruptible) :
 	parameters(_parameters), target_element(_target_element), type(type), id(id), interruptible(interruptible)
+{
+	InitializeMousePosition();
+}
+
+Event::~Event() {}
+
+void Event::Reinitialize(Element* _target_element, EventId _id, const String& _type, const Dictionary& _parameters, bool _interruptible)
+{
+	// Assignment reuses the memory of the previous parameters and type.
+	parameters = _parameters;
+	target_element = _target_element;
+	current_element = nullptr;
+	type = _type;
+	id = _id;
+	interruptible = _interruptible;
+	interrupted = false;
+	interrupted_immediate = false;
+	has_mouse_position = false;
+	mouse_screen_position = Vector2f(0, 0);
+	phase = EventPhase::None;
+	instancer = nullptr;
+	InitializeMousePosition();
+}
+
+void Event::InitializeMousePosition()
 {
 	const Variant* mouse_x = GetIf(parameters, "mouse_x");
 	const Variant* mouse_y = GetIf(parameters, "mouse_y");
@@ -19,8 +44,6 @@ Event::Event(Element* _target_element, EventId id, const String& type, const Dic
 	}
 }
 
-Event::~Event() {}
-
 void Event::SetCurrentElement(Element* element)
 {
 	current_element = element;
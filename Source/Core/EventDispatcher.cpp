@@ -28,13 +28,18 @@ struct CompareIdPhase {
 	}
 };
 
+int EventDispatcher::num_listeners_by_bit[EventDispatcher::NumListenerBits] = {};
+
 EventDispatcher::EventDispatcher(Element* _element) : element(_element) {}
 
 EventDispatcher::~EventDispatcher()
 {
 	// Detach from all event dispatchers
 	for (const auto& event : listeners)
+	{
+		num_listeners_by_bit[GetListenerBit(event.id)] -= 1;
 		event.listener->OnDetach(element);
+	}
 }
 
 void EventDispatcher::AttachEvent(const EventId id, EventListener* listener, const bool in_capture_phase)
@@ -47,6 +52,7 @@ void EventDispatcher::AttachEvent(const EventId id, EventListener* listener, con
 	if (matching_entry_it == range.second)
 	{
 		listeners.emplace(range.second, entry);
+		OnListenerAdded(id);
 		listener->OnAttach(element);
 	}
 }
@@ -57,6 +63,7 @@ void EventDispatcher::DetachEvent(const EventId id, EventListener* listener, con
 	if (listenerIt != listeners.cend())
 	{
 		listeners.erase(listenerIt);
+		OnListenerRemoved(id);
 		listener->OnDetach(element);
 	}
 }
@@ -64,14 +71,35 @@ void EventDispatcher::DetachEvent(const EventId id, EventListener* listener, con
 void EventDispatcher::DetachAllEvents()
 {
 	for (const auto& event : listeners)
+	{
+		num_listeners_by_bit[GetListenerBit(event.id)] -= 1;
 		event.listener->OnDetach(element);
+	}
 
 	listeners.clear();
+	listener_bits = 0;
 
 	for (int i = 0; i < element->GetNumChildren(true); ++i)
 		element->GetChild(i)->GetEventDispatcher()->DetachAllEvents();
 }
 
+void EventDispatcher::OnListenerAdded(EventId id)
+{
+	const int bit = GetListenerBit(id);
+	num_listeners_by_bit[bit] += 1;
+	listener_bits |= (uint64_t(1) << bit);
+}
+
+void EventDispatcher::OnListenerRemoved(EventId id)
+{
+	const int bit = GetListenerBit(id);
+	num_listeners_by_bit[bit] -= 1;
+
+	const bool bit_in_use = std::any_of(listeners.begin(), listeners.end(), [bit](const EventListenerEntry& entry) { return GetListenerBit(entry.id) == bit; });
+	if (!bit_in_use)
+		listener_bits &= ~(uint64_t(1) << bit);
+}
+
 /*
     CollectedListener
 
@@ -104,6 +132,10 @@ bool EventDispatcher::DispatchEvent(Element* target_element, const EventId id, c
 	RMLUI_ASSERTMSG(!((int)default_action_phase & (int)EventPhase::Capture),
 		"We assume here that the default action phases cannot include capture phase.");
 
+	// Skip walking the DOM tree when there is nothing to execute, as is common for high-frequency events such as mouse moves.
+	if (default_action_phase == DefaultActionPhase::None && num_listeners_by_bit[GetListenerBit(id)] == 0)
+		return true;
+
 	Vector<CollectedListener> listeners;
 	Vector<ObserverPtr<Element>> default_action_elements;
 
@@ -192,6 +224,9 @@ bool EventDispatcher::DispatchEvent(Element* target_element, const EventId id, c
 void EventDispatcher::CollectListeners(int dom_distance_from_target, const EventId event_id, const EventPhase event_executes_in_phases,
 	Vector<CollectedListener>& collect_listeners)
 {
+	if (!(listener_bits & (uint64_t(1) << GetListenerBit(event_id))))
+		return;
+
 	// Find all the entries with a matching id, given that listeners are sorted by id first.
 	Listeners::iterator begin, end;
 	std::tie(begin, end) = std::equal_range(listeners.begin(), listeners.end(), EventListenerEntry(event_id, nullptr, false), CompareId());
@@ -72,6 +72,18 @@ private:
 	typedef Vector<EventListenerEntry> Listeners;
 	Listeners listeners;
 
+	// Listeners are also tracked by a bit per event id, where all ids from the last bit and up share that bit.
+	static constexpr int NumListenerBits = 64;
+	static int GetListenerBit(EventId id) { return (int)id < NumListenerBits ? (int)id : NumListenerBits - 1; }
+
+	// The bits of all events with listeners attached to this dispatcher, used to quickly skip elements during dispatch.
+	uint64_t listener_bits = 0;
+	// The number of listeners attached to all dispatchers by bit, used to skip the dispatch of events without any listeners.
+	static int num_listeners_by_bit[NumListenerBits];
+
+	void OnListenerAdded(EventId id);
+	void OnListenerRemoved(EventId id);
+
 	// Collect all the listeners from this dispatcher that are allowed to execute given the input arguments.
 	void CollectListeners(int dom_distance_from_target, EventId event_id, EventPhase phases_to_execute, Vector<CollectedListener>& collect_listeners);
 };
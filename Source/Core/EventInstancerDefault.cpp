@@ -5,16 +5,29 @@ namespace Rml {
 
 EventInstancerDefault::EventInstancerDefault() {}
 
-EventInstancerDefault::~EventInstancerDefault() {}
+EventInstancerDefault::~EventInstancerDefault()
+{
+	for (Event* event : free_events)
+		delete event;
+}
 
 EventPtr EventInstancerDefault::InstanceEvent(Element* target, EventId id, const String& type, const Dictionary& parameters, bool interruptible)
 {
-	return EventPtr(new Event(target, id, type, parameters, interruptible));
+	if (free_events.empty())
+		return EventPtr(new Event(target, id, type, parameters, interruptible));
+
+	Event* event = free_events.back();
+	free_events.pop_back();
+	event->Reinitialize(target, id, type, parameters, interruptible);
+	return EventPtr(event);
 }
 
 void EventInstancerDefault::ReleaseEvent(Event* event)
 {
-	delete event;
+	if (free_events.size() < MaxFreeEvents)
+		free_events.push_back(event);
+	else
+		delete event;
 }
 
 void EventInstancerDefault::Release()
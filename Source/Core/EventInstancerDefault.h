@@ -28,6 +28,12 @@ public:
 
 	/// Releases this event instancer.
 	void Release() override;
+
+private:
+	// Released events retained for reuse. Events are released at the end of their dispatch, thus only a few are needed to cover nested
+	// dispatches.
+	static constexpr size_t MaxFreeEvents = 16;
+	Vector<Event*> free_events;
 };
 
 } // namespace Rml
@@ -48,6 +48,7 @@
 #include "StreamFile.h"
 #include "StyleSheetFactory.h"
 #include "TemplateCache.h"
+#include "TranslationCache.h"
 #include "XMLNodeHandlerBody.h"
 #include "XMLNodeHandlerDefault.h"
 #include "XMLNodeHandlerHead.h"
@@ -327,13 +328,12 @@ ElementPtr Factory::InstanceElement(Element* parent, const String& instancer_nam
 	return nullptr;
 }
 
-bool Factory::InstanceElementText(Element* parent, const String& in_text)
+static bool InstanceElementTextInternal(Element* parent, const String& in_text, XMLParseEventList* record_events)
 {
 	RMLUI_ASSERT(parent);
 
 	String text;
-	if (SystemInterface* system_interface = GetSystemInterface())
-		system_interface->TranslateString(text, in_text);
+	TranslationCache::TranslateString(text, in_text);
 
 	// If this text node only contains white-space we don't want to construct it.
 	const bool only_white_space = std::all_of(text.begin(), text.end(), &StringUtilities::IsWhitespace);
@@ -378,7 +378,10 @@ bool Factory::InstanceElementText(Element* parent, const String& in_text)
 		stream->Write(close_tag.c_str(), close_tag.size());
 		stream->Seek(0, SEEK_SET);
 
-		InstanceElementStream(parent, stream.get());
+		XMLParser parser(parent);
+		parser.SetRecordEvents(record_events);
+		parser.Parse(stream.get());
+		parser.SetRecordEvents(nullptr);
 	}
 	else
 	{
@@ -419,6 +422,28 @@ bool Factory::InstanceElementText(Element* parent, const String& in_text)
 	return true;
 }
 
+bool Factory::InstanceElementText(Element* parent, const String& text)
+{
+	return InstanceElementTextInternal(parent, text, nullptr);
+}
+
+bool Factory::InstanceElementText(Element* parent, const String& text, XMLParseEventList& parse_events)
+{
+	RMLUI_ASSERT(parent);
+
+	// Events are only recorded when the text is parsed as RML, plain text is cheap enough to instance directly every time.
+	if (!parse_events.empty())
+	{
+		RMLUI_ZoneScopedNC("ReplayStream", 0xDC143C);
+		const URL source_url;
+		XMLParser parser(parent);
+		parser.Replay(parse_events, source_url);
+		return true;
+	}
+
+	return InstanceElementTextInternal(parent, text, &parse_events);
+}
+
 bool Factory::InstanceElementStream(Element* parent, Stream* stream)
 {
 	XMLParser parser(parent);
@@ -513,12 +538,16 @@ SharedPtr<StyleSheetContainer> Factory::InstanceStyleSheetFile(const String& fil
 
 SharedPtr<StyleSheetContainer> Factory::InstanceStyleSheetStream(Stream* stream)
 {
-	SharedPtr<StyleSheetContainer> style_sheet_container = MakeShared<StyleSheetContainer>();
-	if (style_sheet_container->LoadStyleSheetContainer(stream))
-	{
-		return style_sheet_container;
-	}
-	return nullptr;
+	// Parsed sheets are cached by their source and contents, so that instancing the same sheet again only reads the stream. The returned
+	// container shares the immutable style sheets of the cached one, and may be merged into or compiled on its own.
+	String content;
+	stream->Read(content, stream->Length() - stream->Tell());
+
+	const StyleSheetContainer* parsed_container = StyleSheetFactory::GetInlineStyleSheetContainer(content, stream->GetSourceURL().GetURL(), 1);
+	if (!parsed_container)
+		return nullptr;
+
+	return parsed_container->CombineStyleSheetContainer(StyleSheetContainer());
 }
 
 void Factory::ClearStyleSheetCache()
@@ -582,7 +611,12 @@ DataViewPtr Factory::InstanceDataView(const String& type_name, Element* element)
 	RMLUI_ASSERT(element);
 	const auto it = factory_data->data_view_instancers.find(type_name);
 	if (it != factory_data->data_view_instancers.end())
-		return it->second->InstanceView(element);
+	{
+		DataViewPtr view = it->second->InstanceView(element);
+		if (view)
+			view->type_name = type_name;
+		return view;
+	}
 	return nullptr;
 }
 
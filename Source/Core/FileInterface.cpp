@@ -38,4 +38,11 @@ bool FileInterface::LoadFile(const String& path, String& out_data)
 	return true;
 }
 
+bool FileInterface::MapFile(const String& /*path*/, Span<const byte>& /*out_data*/, FileMappingHandle& /*out_handle*/)
+{
+	return false;
+}
+
+void FileInterface::UnmapFile(FileMappingHandle /*handle*/) {}
+
 } // namespace Rml
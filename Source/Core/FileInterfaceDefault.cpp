@@ -2,8 +2,26 @@
 
 #ifndef RMLUI_NO_FILE_INTERFACE_DEFAULT
 
+	#if defined(RMLUI_PLATFORM_WIN32_NATIVE)
+		#include <windows.h>
+		#define RMLUI_FILE_MAPPING_WIN32
+	#elif defined(RMLUI_PLATFORM_UNIX) && !defined(RMLUI_PLATFORM_EMSCRIPTEN)
+		#include <fcntl.h>
+		#include <sys/mman.h>
+		#include <sys/stat.h>
+		#include <unistd.h>
+		#define RMLUI_FILE_MAPPING_POSIX
+	#endif
+
 namespace Rml {
 
+	#if defined(RMLUI_FILE_MAPPING_WIN32) || defined(RMLUI_FILE_MAPPING_POSIX)
+struct FileMappingDefault {
+	void* address;
+	size_t size;
+};
+	#endif
+
 FileInterfaceDefault::~FileInterfaceDefault() {}
 
 FileHandle FileInterfaceDefault::Open(const String& path)
@@ -31,5 +49,89 @@ size_t FileInterfaceDefault::Tell(FileHandle file)
 	return ftell((FILE*)file);
 }
 
+	#if defined(RMLUI_FILE_MAPPING_WIN32)
+
+bool FileInterfaceDefault::MapFile(const String& path, Span<const byte>& out_data, FileMappingHandle& out_handle)
+{
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER file_size = {};
+	void* address = nullptr;
+
+	// Empty files cannot be mapped, leave them to the regular file functions.
+	if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+	{
+		// The view keeps the mapping object alive, so both handles can be closed right away.
+		if (HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+		{
+			address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+
+	if (!address)
+		return false;
+
+	const size_t size = (size_t)file_size.QuadPart;
+	out_data = {static_cast<const byte*>(address), size};
+	out_handle = reinterpret_cast<FileMappingHandle>(new FileMappingDefault{address, size});
+	return true;
+}
+
+void FileInterfaceDefault::UnmapFile(FileMappingHandle handle)
+{
+	FileMappingDefault* mapping = reinterpret_cast<FileMappingDefault*>(handle);
+	UnmapViewOfFile(mapping->address);
+	delete mapping;
+}
+
+	#elif defined(RMLUI_FILE_MAPPING_POSIX)
+
+bool FileInterfaceDefault::MapFile(const String& path, Span<const byte>& out_data, FileMappingHandle& out_handle)
+{
+	const int file = open(path.c_str(), O_RDONLY);
+	if (file < 0)
+		return false;
+
+	struct stat file_status = {};
+	void* address = MAP_FAILED;
+
+	// Empty files cannot be mapped, leave them to the regular file functions.
+	if (fstat(file, &file_status) == 0 && S_ISREG(file_status.st_mode) && file_status.st_size > 0)
+		address = mmap(nullptr, (size_t)file_status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+	// The mapping remains valid after closing the file descriptor.
+	close(file);
+
+	if (address == MAP_FAILED)
+		return false;
+
+	const size_t size = (size_t)file_status.st_size;
+	out_data = {static_cast<const byte*>(address), size};
+	out_handle = reinterpret_cast<FileMappingHandle>(new FileMappingDefault{address, size});
+	return true;
+}
+
+void FileInterfaceDefault::UnmapFile(FileMappingHandle handle)
+{
+	FileMappingDefault* mapping = reinterpret_cast<FileMappingDefault*>(handle);
+	munmap(mapping->address, mapping->size);
+	delete mapping;
+}
+
+	#else
+
+bool FileInterfaceDefault::MapFile(const String& /*path*/, Span<const byte>& /*out_data*/, FileMappingHandle& /*out_handle*/)
+{
+	return false;
+}
+
+void FileInterfaceDefault::UnmapFile(FileMappingHandle /*handle*/) {}
+
+	#endif
+
 } // namespace Rml
 #endif /*RMLUI_NO_FILE_INTERFACE_DEFAULT*/
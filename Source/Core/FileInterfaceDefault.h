@@ -39,6 +39,16 @@ public:
 	/// @param file The handle of the file to be queried.
 	/// @return The number of bytes from the origin of the file.
 	size_t Tell(FileHandle file) override;
+
+	/// Maps a file into memory using the memory-mapping functions of the operating system, where available.
+	/// @param path The path to the file to map.
+	/// @param[out] out_data The contents of the file.
+	/// @param[out] out_handle A handle owning the mapping.
+	/// @return True if the file was mapped, false if mapping is not supported on this platform or the file could not be mapped.
+	bool MapFile(const String& path, Span<const byte>& out_data, FileMappingHandle& out_handle) override;
+	/// Releases a mapping previously made through MapFile().
+	/// @param handle The handle of the mapping.
+	void UnmapFile(FileMappingHandle handle) override;
 };
 
 } // namespace Rml
@@ -0,0 +1,63 @@
+#include "FileMapping.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/FileInterface.h"
+#include "../../Include/RmlUi/Core/Log.h"
+
+namespace Rml {
+
+FileMapping::~FileMapping()
+{
+	Close();
+}
+
+bool FileMapping::Map(const String& path, FileInterface* file_interface)
+{
+	Close();
+
+	if (!file_interface)
+		file_interface = GetFileInterface();
+	if (!file_interface->MapFile(path, data, mapping_handle))
+	{
+		data = {};
+		return false;
+	}
+
+	mapping_interface = file_interface;
+	return true;
+}
+
+bool FileMapping::Load(const String& path, FileInterface* file_interface)
+{
+	if (Map(path, file_interface))
+		return true;
+
+	if (!file_interface)
+		file_interface = GetFileInterface();
+	FileHandle handle = file_interface->Open(path);
+	if (!handle)
+		return false;
+
+	const size_t length = file_interface->Length(handle);
+	buffer = UniquePtr<byte[]>(new byte[length]);
+	const size_t read_length = file_interface->Read(buffer.get(), length, handle);
+	file_interface->Close(handle);
+
+	if (read_length != length)
+		Log::Message(Log::LT_WARNING, "Could only read %zu of %zu bytes from file %s", read_length, length, path.c_str());
+
+	data = {buffer.get(), read_length};
+	return true;
+}
+
+void FileMapping::Close()
+{
+	if (mapping_interface)
+		mapping_interface->UnmapFile(mapping_handle);
+
+	mapping_interface = nullptr;
+	mapping_handle = 0;
+	buffer.reset();
+	data = {};
+}
+
+} // namespace Rml
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class FileInterface;
+
+/**
+    Owns the read-only contents of a file.
+
+    The file is mapped into memory through the file interface where supported, otherwise its contents can be read into a heap buffer instead.
+ */
+class FileMapping : NonCopyMoveable {
+public:
+	FileMapping() = default;
+	~FileMapping();
+
+	/// Maps the file into memory, without reading it into a buffer if mapping is not supported.
+	/// @param file_interface The interface to open the file with, or nullptr to use the installed file interface.
+	/// @return True if the file was mapped.
+	bool Map(const String& path, FileInterface* file_interface = nullptr);
+	/// Maps the file into memory, or reads the whole file into a buffer if mapping is not supported.
+	/// @param file_interface The interface to open the file with, or nullptr to use the installed file interface.
+	/// @return True if the file contents are available.
+	bool Load(const String& path, FileInterface* file_interface = nullptr);
+	/// Releases the file contents.
+	void Close();
+
+	Span<const byte> GetData() const { return data; }
+	bool IsMapped() const { return mapping_interface != nullptr; }
+
+private:
+	Span<const byte> data;
+
+	// Set when mapped, the interface must be used to release the mapping.
+	FileInterface* mapping_interface = nullptr;
+	FileMappingHandle mapping_handle = 0;
+
+	UniquePtr<byte[]> buffer;
+};
+
+} // namespace Rml
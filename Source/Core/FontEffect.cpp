@@ -21,6 +21,11 @@ void FontEffect::GenerateGlyphTexture(byte* /*destination_data*/, Vector2i /*des
 	const FontGlyph& /*glyph*/) const
 {}
 
+bool FontEffect::GetDistanceFieldParameters(float& /*outline_width*/, float& /*blur_width*/, Vector2f& /*offset*/) const
+{
+	return false;
+}
+
 void FontEffect::SetColour(const Colourb _colour)
 {
 	colour = _colour;
@@ -86,6 +86,14 @@ void FontEffectBlur::GenerateGlyphTexture(byte* destination_data, const Vector2i
 	FillColorValuesFromAlpha(destination_data, destination_dimensions, destination_stride);
 }
 
+bool FontEffectBlur::GetDistanceFieldParameters(float& outline_width, float& blur_width, Vector2f& out_offset) const
+{
+	outline_width = 0.f;
+	blur_width = float(width);
+	out_offset = Vector2f(0.f);
+	return true;
+}
+
 FontEffectBlurInstancer::FontEffectBlurInstancer() : id_width(PropertyId::Invalid), id_color(PropertyId::Invalid)
 {
 	id_width = RegisterProperty("width", "1px", true).AddParser("length").GetId();
@@ -116,6 +116,14 @@ void FontEffectGlow::GenerateGlyphTexture(byte* destination_data, const Vector2i
 	FillColorValuesFromAlpha(destination_data, destination_dimensions, destination_stride);
 }
 
+bool FontEffectGlow::GetDistanceFieldParameters(float& outline_width, float& blur_width, Vector2f& out_offset) const
+{
+	outline_width = float(width_outline);
+	blur_width = float(width_blur);
+	out_offset = Vector2f(offset);
+	return true;
+}
+
 FontEffectGlowInstancer::FontEffectGlowInstancer() :
 	id_width_outline(PropertyId::Invalid), id_width_blur(PropertyId::Invalid), id_color(PropertyId::Invalid)
 {
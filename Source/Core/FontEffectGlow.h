@@ -25,6 +25,7 @@ public:
 	bool GetGlyphMetrics(Vector2i& origin, Vector2i& dimensions, const FontGlyph& glyph) const override;
 
 	void GenerateGlyphTexture(byte* destination_data, Vector2i destination_dimensions, int destination_stride, const FontGlyph& glyph) const override;
+	bool GetDistanceFieldParameters(float& outline_width, float& blur_width, Vector2f& offset) const override;
 
 private:
 	int width_outline, width_blur, combined_width;
@@ -69,6 +69,14 @@ void FontEffectOutline::GenerateGlyphTexture(byte* destination_data, const Vecto
 	FillColorValuesFromAlpha(destination_data, destination_dimensions, destination_stride);
 }
 
+bool FontEffectOutline::GetDistanceFieldParameters(float& outline_width, float& blur_width, Vector2f& out_offset) const
+{
+	outline_width = float(width);
+	blur_width = 0.f;
+	out_offset = Vector2f(0.f);
+	return true;
+}
+
 FontEffectOutlineInstancer::FontEffectOutlineInstancer() : id_width(PropertyId::Invalid), id_color(PropertyId::Invalid)
 {
 	id_width = RegisterProperty("width", "1px", true).AddParser("length").GetId();
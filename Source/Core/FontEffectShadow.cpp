@@ -30,6 +30,14 @@ bool FontEffectShadow::GetGlyphMetrics(Vector2i& origin, Vector2i& /*dimensions*
 	return true;
 }
 
+bool FontEffectShadow::GetDistanceFieldParameters(float& outline_width, float& blur_width, Vector2f& out_offset) const
+{
+	outline_width = 0.f;
+	blur_width = 0.f;
+	out_offset = Vector2f(offset);
+	return true;
+}
+
 FontEffectShadowInstancer::FontEffectShadowInstancer() :
 	id_offset_x(PropertyId::Invalid), id_offset_y(PropertyId::Invalid), id_color(PropertyId::Invalid)
 {
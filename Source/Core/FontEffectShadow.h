@@ -20,6 +20,8 @@ public:
 
 	bool GetGlyphMetrics(Vector2i& origin, Vector2i& dimensions, const FontGlyph& glyph) const override;
 
+	bool GetDistanceFieldParameters(float& outline_width, float& blur_width, Vector2f& offset) const override;
+
 private:
 	Vector2i offset;
 };
@@ -0,0 +1,319 @@
+#include "FontCache.h"
+#include "../../../Include/RmlUi/Core/Core.h"
+#include "../../../Include/RmlUi/Core/Log.h"
+#include "../../../Include/RmlUi/Core/Math.h"
+#include <string.h>
+#include <type_traits>
+
+namespace Rml {
+
+namespace {
+	constexpr uint32_t CacheMagic = 0x464C4D52; // 'RMLF'
+	constexpr uint32_t CacheFormatVersion = 1;
+	// Written in native byte order, used to reject caches written on a platform with a different endianness.
+	constexpr uint32_t CacheByteOrderMark = 0x01020304;
+
+	inline uint64_t MakeEntryKey(int size, int synthetic_weight_delta)
+	{
+		// Clamped the same way as by the font face handles, so that entries are found regardless of how the weight delta was requested.
+		return (uint64_t(uint32_t(Math::Max(size, 0))) << 32) | uint64_t(uint32_t(Math::Max(synthetic_weight_delta, 0)));
+	}
+
+	inline size_t GetBitmapSize(const FontGlyph& glyph)
+	{
+		const size_t num_bytes_per_pixel = (glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
+		return size_t(glyph.bitmap_dimensions.x) * size_t(glyph.bitmap_dimensions.y) * num_bytes_per_pixel;
+	}
+
+	class CacheWriter {
+	public:
+		CacheWriter(Vector<byte>& data) : data(data) {}
+
+		template <typename T>
+		void Write(T value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly.");
+			WriteBytes(&value, sizeof(T));
+		}
+		void WriteBytes(const void* source, size_t num_bytes)
+		{
+			const size_t offset = data.size();
+			data.resize(offset + num_bytes);
+			if (num_bytes > 0)
+				memcpy(data.data() + offset, source, num_bytes);
+		}
+
+	private:
+		Vector<byte>& data;
+	};
+
+	class CacheReader {
+	public:
+		CacheReader(Span<const byte> data) : data(data) {}
+
+		template <typename T>
+		bool Read(T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read directly.");
+			return ReadBytes(&value, sizeof(T));
+		}
+		bool ReadBytes(void* destination, size_t num_bytes)
+		{
+			if (num_bytes > data.size() - offset)
+				return false;
+			if (num_bytes > 0)
+				memcpy(destination, data.data() + offset, num_bytes);
+			offset += num_bytes;
+			return true;
+		}
+		// Reads an element count, which must not exceed the number of bytes left given the minimum size of each element.
+		bool ReadCount(uint32_t& count, size_t min_element_size)
+		{
+			return Read(count) && size_t(count) <= (data.size() - offset) / min_element_size;
+		}
+		bool IsAtEnd() const { return offset == data.size(); }
+
+	private:
+		Span<const byte> data;
+		size_t offset = 0;
+	};
+
+	void WriteMetrics(CacheWriter& writer, const FontMetrics& metrics)
+	{
+		writer.Write<int32_t>(metrics.size);
+		writer.Write(metrics.ascent);
+		writer.Write(metrics.descent);
+		writer.Write(metrics.line_spacing);
+		writer.Write(metrics.x_height);
+		writer.Write(metrics.underline_position);
+		writer.Write(metrics.underline_thickness);
+		writer.Write<uint8_t>(metrics.has_ellipsis ? 1 : 0);
+	}
+
+	bool ReadMetrics(CacheReader& reader, FontMetrics& metrics)
+	{
+		int32_t size = 0;
+		uint8_t has_ellipsis = 0;
+		if (!reader.Read(size) || !reader.Read(metrics.ascent) || !reader.Read(metrics.descent) || !reader.Read(metrics.line_spacing) ||
+			!reader.Read(metrics.x_height) || !reader.Read(metrics.underline_position) || !reader.Read(metrics.underline_thickness) ||
+			!reader.Read(has_ellipsis))
+			return false;
+
+		metrics.size = size;
+		metrics.has_ellipsis = (has_ellipsis != 0);
+		return true;
+	}
+
+	void WriteGlyph(CacheWriter& writer, Character character, const FontGlyph& glyph)
+	{
+		const size_t bitmap_size = (glyph.bitmap_data ? GetBitmapSize(glyph) : 0);
+
+		writer.Write<uint32_t>(uint32_t(character));
+		writer.Write<int32_t>(glyph.bearing.x);
+		writer.Write<int32_t>(glyph.bearing.y);
+		writer.Write<int32_t>(glyph.advance);
+		writer.Write<int32_t>(glyph.bitmap_dimensions.x);
+		writer.Write<int32_t>(glyph.bitmap_dimensions.y);
+		writer.Write<uint8_t>(uint8_t(glyph.color_format));
+		writer.Write<uint32_t>(uint32_t(bitmap_size));
+		writer.WriteBytes(glyph.bitmap_data, bitmap_size);
+	}
+
+	bool ReadGlyph(CacheReader& reader, Character& character, FontGlyph& glyph)
+	{
+		uint32_t character_code = 0, bitmap_size = 0;
+		int32_t bearing_x = 0, bearing_y = 0, advance = 0, width = 0, height = 0;
+		uint8_t color_format = 0;
+		if (!reader.Read(character_code) || !reader.Read(bearing_x) || !reader.Read(bearing_y) || !reader.Read(advance) || !reader.Read(width) ||
+			!reader.Read(height) || !reader.Read(color_format) || !reader.Read(bitmap_size))
+			return false;
+
+		if (width < 0 || height < 0 || color_format > uint8_t(ColorFormat::A8))
+			return false;
+
+		character = Character(character_code);
+		glyph.bearing = Vector2i(bearing_x, bearing_y);
+		glyph.advance = advance;
+		glyph.bitmap_dimensions = Vector2i(width, height);
+		glyph.color_format = ColorFormat(color_format);
+
+		if (bitmap_size > 0)
+		{
+			if (size_t(bitmap_size) != GetBitmapSize(glyph))
+				return false;
+
+			glyph.bitmap_owned_data.reset(new byte[bitmap_size]);
+			glyph.bitmap_data = glyph.bitmap_owned_data.get();
+			if (!reader.ReadBytes(glyph.bitmap_owned_data.get(), bitmap_size))
+				return false;
+		}
+
+		return true;
+	}
+} // namespace
+
+uint64_t FontCache::GetFaceKey(const FontFaceSource& source)
+{
+	// FNV-1a over the font data and the indices selecting the face within it.
+	uint64_t hash = 0xcbf29ce484222325ull;
+	auto hash_bytes = [&hash](const byte* bytes, size_t num_bytes) {
+		for (size_t i = 0; i < num_bytes; i++)
+			hash = (hash ^ uint64_t(bytes[i])) * 0x100000001b3ull;
+	};
+
+	const uint64_t data_size = source.data.size();
+	const int32_t indices[2] = {source.face_index, source.named_instance_index};
+	hash_bytes(reinterpret_cast<const byte*>(&data_size), sizeof(data_size));
+	hash_bytes(reinterpret_cast<const byte*>(indices), sizeof(indices));
+	hash_bytes(source.data.data(), source.data.size());
+
+	return hash;
+}
+
+FontGlyph FontCache::CopyGlyph(const FontGlyph& glyph)
+{
+	FontGlyph result = glyph.WeakCopy();
+	if (glyph.bitmap_data)
+	{
+		const size_t bitmap_size = GetBitmapSize(glyph);
+		result.bitmap_owned_data.reset(new byte[bitmap_size]);
+		memcpy(result.bitmap_owned_data.get(), glyph.bitmap_data, bitmap_size);
+		result.bitmap_data = result.bitmap_owned_data.get();
+	}
+	return result;
+}
+
+void FontCache::Insert(uint64_t face_key, int size, int synthetic_weight_delta, FontCacheEntry&& entry)
+{
+	faces[face_key][MakeEntryKey(size, synthetic_weight_delta)] = std::move(entry);
+}
+
+const FontCacheEntry* FontCache::Find(uint64_t face_key, int size, int synthetic_weight_delta) const
+{
+	auto it_face = faces.find(face_key);
+	if (it_face == faces.end())
+		return nullptr;
+
+	auto it_entry = it_face->second.find(MakeEntryKey(size, synthetic_weight_delta));
+	if (it_entry == it_face->second.end())
+		return nullptr;
+
+	return &it_entry->second;
+}
+
+bool FontCache::IsEmpty() const
+{
+	return faces.empty();
+}
+
+void FontCache::Clear()
+{
+	FaceMap().swap(faces);
+}
+
+void FontCache::Save(Vector<byte>& out_data) const
+{
+	out_data.clear();
+	CacheWriter writer(out_data);
+
+	const String version = GetVersion();
+	writer.Write(CacheMagic);
+	writer.Write(CacheFormatVersion);
+	writer.Write(CacheByteOrderMark);
+	writer.Write<uint32_t>(uint32_t(version.size()));
+	writer.WriteBytes(version.data(), version.size());
+
+	writer.Write<uint32_t>(uint32_t(faces.size()));
+	for (const auto& face : faces)
+	{
+		writer.Write<uint64_t>(face.first);
+		writer.Write<uint32_t>(uint32_t(face.second.size()));
+
+		for (const auto& key_entry : face.second)
+		{
+			const FontCacheEntry& entry = key_entry.second;
+			writer.Write<uint64_t>(key_entry.first);
+			WriteMetrics(writer, entry.metrics);
+
+			writer.Write<uint32_t>(uint32_t(entry.kerning_pairs.size()));
+			writer.WriteBytes(entry.kerning_pairs.data(), entry.kerning_pairs.size() * sizeof(int16_t));
+
+			writer.Write<uint32_t>(uint32_t(entry.glyphs.size()));
+			for (const auto& character_glyph : entry.glyphs)
+				WriteGlyph(writer, character_glyph.first, character_glyph.second);
+		}
+	}
+}
+
+bool FontCache::Load(Span<const byte> data)
+{
+	CacheReader reader(data);
+
+	uint32_t magic = 0, format_version = 0, byte_order_mark = 0, version_size = 0;
+	if (!reader.Read(magic) || !reader.Read(format_version) || !reader.Read(byte_order_mark) || magic != CacheMagic ||
+		format_version != CacheFormatVersion || byte_order_mark != CacheByteOrderMark || !reader.ReadCount(version_size, 1))
+	{
+		Log::Message(Log::LT_WARNING, "Font cache data is not recognized and will be ignored.");
+		return false;
+	}
+
+	String version(version_size, '\0');
+	if (!reader.ReadBytes(&version[0], version_size) || version != GetVersion())
+	{
+		Log::Message(Log::LT_INFO, "Font cache data was written by a different version of RmlUi and will be ignored.");
+		return false;
+	}
+
+	constexpr size_t min_face_size = sizeof(uint64_t) + sizeof(uint32_t);
+	constexpr size_t min_entry_size = sizeof(uint64_t) + 7 * sizeof(float) + 2 * sizeof(uint32_t);
+	constexpr size_t min_glyph_size = 7 * sizeof(int32_t);
+
+	FaceMap loaded_faces;
+	uint32_t num_faces = 0;
+	bool success = reader.ReadCount(num_faces, min_face_size);
+
+	for (uint32_t i = 0; success && i < num_faces; i++)
+	{
+		uint64_t face_key = 0;
+		uint32_t num_entries = 0;
+		success = reader.Read(face_key) && reader.ReadCount(num_entries, min_entry_size);
+
+		EntryMap& entries = loaded_faces[face_key];
+		for (uint32_t j = 0; success && j < num_entries; j++)
+		{
+			uint64_t entry_key = 0;
+			uint32_t num_kerning_pairs = 0, num_glyphs = 0;
+			FontCacheEntry entry;
+			success = reader.Read(entry_key) && ReadMetrics(reader, entry.metrics) && reader.ReadCount(num_kerning_pairs, sizeof(int16_t));
+			if (!success)
+				break;
+
+			entry.kerning_pairs.resize(num_kerning_pairs);
+			success = reader.ReadBytes(entry.kerning_pairs.data(), num_kerning_pairs * sizeof(int16_t)) && reader.ReadCount(num_glyphs, min_glyph_size);
+
+			entry.glyphs.reserve(num_glyphs);
+			for (uint32_t k = 0; success && k < num_glyphs; k++)
+			{
+				Character character = Character::Null;
+				FontGlyph glyph;
+				success = ReadGlyph(reader, character, glyph);
+				if (success)
+					entry.glyphs[character] = std::move(glyph);
+			}
+
+			if (success)
+				entries[entry_key] = std::move(entry);
+		}
+	}
+
+	if (!success || !reader.IsAtEnd())
+	{
+		Log::Message(Log::LT_WARNING, "Font cache data is malformed and will be ignored.");
+		return false;
+	}
+
+	faces = std::move(loaded_faces);
+	return true;
+}
+
+} // namespace Rml
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../../../Include/RmlUi/Core/FontGlyph.h"
+#include "../../../Include/RmlUi/Core/FontMetrics.h"
+#include "../../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+// The font data and indices a face was loaded from, used to match cached entries against faces loaded during a later run.
+struct FontFaceSource {
+	Span<const byte> data;
+	int face_index = 0;
+	int named_instance_index = 0;
+};
+
+// The glyphs, metrics, and kerning of a sized font face, enough to initialize a font face handle without rasterizing its glyphs again.
+struct FontCacheEntry {
+	FontMetrics metrics = {};
+	Vector<int16_t> kerning_pairs;
+	FontGlyphMap glyphs;
+};
+
+/**
+    Stores font face handle data across runs of the application.
+
+    The cache is exchanged with the application as a binary blob, which is only valid for the same library version and
+    the same font files. Entries are matched against the loaded faces by a hash of their font data.
+ */
+
+class FontCache {
+public:
+	// Returns the key identifying a loaded face in the cache.
+	static uint64_t GetFaceKey(const FontFaceSource& source);
+
+	// Returns a copy of the glyph which owns its bitmap data.
+	static FontGlyph CopyGlyph(const FontGlyph& glyph);
+
+	// Adds the entry of a sized face, replacing any existing entry with the same key.
+	void Insert(uint64_t face_key, int size, int synthetic_weight_delta, FontCacheEntry&& entry);
+	// Returns the entry of a sized face, or nullptr if it is not cached.
+	const FontCacheEntry* Find(uint64_t face_key, int size, int synthetic_weight_delta) const;
+
+	bool IsEmpty() const;
+	void Clear();
+
+	// Serializes all entries.
+	void Save(Vector<byte>& out_data) const;
+	// Replaces all entries by the ones in the serialized data. Returns false and keeps the previous entries if the data is malformed, or if
+	// it was written by a different version of the library.
+	bool Load(Span<const byte> data);
+
+private:
+	using EntryMap = UnorderedMap<uint64_t, FontCacheEntry>;
+	using FaceMap = UnorderedMap<uint64_t, EntryMap>;
+
+	// Entries by face key, then by (size, synthetic weight delta).
+	FaceMap faces;
+};
+
+} // namespace Rml
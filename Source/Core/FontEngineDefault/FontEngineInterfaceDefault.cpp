@@ -64,6 +64,16 @@ int FontEngineInterfaceDefault::GetStringWidth(FontFaceHandle handle, StringView
 	return handle_default->GetStringWidth(string, text_shaping_context, prior_character);
 }
 
+void FontEngineInterfaceDefault::GetStringPrefixWidths(FontFaceHandle handle, StringView string, const TextShapingContext& text_shaping_context,
+	Character prior_character, Vector<int>& out_prefix_widths)
+{
+	out_prefix_widths.clear();
+	auto handle_default = reinterpret_cast<FontFaceHandleDefault*>(handle);
+	if (!handle_default)
+		return;
+	handle_default->GetStringPrefixWidths(string, text_shaping_context, prior_character, out_prefix_widths);
+}
+
 int FontEngineInterfaceDefault::GenerateString(RenderManager& render_manager, FontFaceHandle handle, FontEffectsHandle font_effects_handle,
 	StringView string, Vector2f position, ColourbPremultiplied colour, float opacity, const TextShapingContext& text_shaping_context,
 	TexturedMeshList& mesh_list)
@@ -88,4 +98,29 @@ void FontEngineInterfaceDefault::ReleaseFontResources()
 	FontProvider::ReleaseFontResources();
 }
 
+void FontEngineInterfaceDefault::ReleaseUnusedFontResources(const UnorderedSet<FontFaceHandle>& used_handles, size_t budget_bytes)
+{
+	FontProvider::ReleaseUnusedFontResources(used_handles, budget_bytes);
+}
+
+FontResourceStats FontEngineInterfaceDefault::GetFontResourceStats()
+{
+	return FontProvider::GetFontResourceStats();
+}
+
+bool FontEngineInterfaceDefault::SetDistanceFieldMode(bool enable)
+{
+	return FontProvider::SetDistanceFieldMode(enable);
+}
+
+bool FontEngineInterfaceDefault::SaveFontCache(Vector<byte>& out_data)
+{
+	return FontProvider::SaveFontCache(out_data);
+}
+
+bool FontEngineInterfaceDefault::LoadFontCache(Span<const byte> data)
+{
+	return FontProvider::LoadFontCache(data);
+}
+
 } // namespace Rml
@@ -35,6 +35,10 @@ public:
 	/// Returns the width a string will take up if rendered with this handle.
 	int GetStringWidth(FontFaceHandle handle, StringView string, const TextShapingContext& text_shaping_context, Character prior_character) override;
 
+	/// Returns the width of every prefix of a string, measured in a single pass.
+	void GetStringPrefixWidths(FontFaceHandle handle, StringView string, const TextShapingContext& text_shaping_context, Character prior_character,
+		Vector<int>& out_prefix_widths) override;
+
 	/// Generates the geometry required to render a single line of text.
 	int GenerateString(RenderManager& render_manager, FontFaceHandle face_handle, FontEffectsHandle effects_handle, StringView string,
 		Vector2f position, ColourbPremultiplied colour, float opacity, const TextShapingContext& text_shaping_context,
@@ -45,6 +49,21 @@ public:
 
 	/// Releases resources owned by sized font faces, including their textures and rendered glyphs.
 	void ReleaseFontResources() override;
+
+	/// Releases font face handles not in use, least recently requested first, until the font textures and glyphs fit within the budget.
+	void ReleaseUnusedFontResources(const UnorderedSet<FontFaceHandle>& used_handles, size_t budget_bytes) override;
+
+	/// Returns the number of sized font faces and the size of their textures and glyphs.
+	FontResourceStats GetFontResourceStats() override;
+
+	/// Serializes the glyphs and metrics of all sized font faces currently in use.
+	/// Renders text of all sizes from a shared set of distance field glyphs, when supported by the FreeType library.
+	bool SetDistanceFieldMode(bool enable) override;
+
+	bool SaveFontCache(Vector<byte>& out_data) override;
+
+	/// Loads previously saved glyphs and metrics, used in place of FreeType when initializing matching font faces.
+	bool LoadFontCache(Span<const byte> data) override;
 };
 
 } // namespace Rml
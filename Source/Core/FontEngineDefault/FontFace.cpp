@@ -2,15 +2,18 @@
 #include "../../../Include/RmlUi/Core/Log.h"
 #include "../../../Include/RmlUi/Core/Math.h"
 #include "FontFaceHandleDefault.h"
+#include "FontProvider.h"
 #include "FreeTypeInterface.h"
+#include <algorithm>
 
 namespace Rml {
 
-FontFace::FontFace(FontFaceHandleFreetype _face, Style::FontStyle _style, Style::FontWeight _weight)
+FontFace::FontFace(FontFaceHandleFreetype _face, Style::FontStyle _style, Style::FontWeight _weight, const FontFaceSource& _source)
 {
 	style = _style;
 	weight = _weight;
 	face = _face;
+	source = _source;
 }
 
 FontFace::~FontFace()
@@ -55,9 +58,25 @@ FontFaceHandleDefault* FontFace::GetHandle(int size, bool load_default_glyphs, i
 		return nullptr;
 	}
 
-	// Construct and initialise the new handle.
+	// Construct and initialise the new handle. In distance field mode, all sizes render the glyphs of a shared distance field handle.
 	auto handle = MakeUnique<FontFaceHandleDefault>();
-	if (!handle->Initialize(face, size, load_default_glyphs, synthetic_weight_delta))
+	bool initialized = false;
+	if (FontProvider::IsDistanceFieldMode())
+	{
+		if (FontFaceHandleDefault* distance_field_handle = GetDistanceFieldHandle(synthetic_weight_delta))
+		{
+			handle->InitializeDistanceField(distance_field_handle, size);
+			initialized = true;
+		}
+	}
+	else
+	{
+		// Look up the cache with the clamped weight delta, as used by the handle when its entry is saved.
+		const FontCacheEntry* cache_entry = FontProvider::FindCacheEntry(*this, size, synthetic_weight_delta);
+		initialized = handle->Initialize(face, size, load_default_glyphs, synthetic_weight_delta, cache_entry);
+	}
+
+	if (!initialized)
 	{
 		handles[key] = nullptr;
 		return nullptr;
@@ -71,9 +90,100 @@ FontFaceHandleDefault* FontFace::GetHandle(int size, bool load_default_glyphs, i
 	return result;
 }
 
+FontFaceHandleDefault* FontFace::GetDistanceFieldHandle(int synthetic_weight_delta)
+{
+	synthetic_weight_delta = Math::Max(synthetic_weight_delta, 0);
+
+	auto it = distance_field_handles.find(synthetic_weight_delta);
+	if (it != distance_field_handles.end())
+		return it->second.get();
+
+	if (!face)
+	{
+		Log::Message(Log::LT_WARNING, "Font face has been released, unable to generate new handle.");
+		return nullptr;
+	}
+
+	auto handle = MakeUnique<FontFaceHandleDefault>();
+	if (!handle->Initialize(face, DistanceFieldBaseSize, true, synthetic_weight_delta, nullptr, true))
+	{
+		distance_field_handles[synthetic_weight_delta] = nullptr;
+		return nullptr;
+	}
+
+	FontFaceHandleDefault* result = handle.get();
+	distance_field_handles[synthetic_weight_delta] = std::move(handle);
+
+	return result;
+}
+
 void FontFace::ReleaseFontResources()
 {
+	// Release the sized handles first, as they may refer to the distance field handles.
 	HandleMap().swap(handles);
+	distance_field_handles.clear();
+}
+
+void FontFace::GetHandles(Vector<FontFaceHandleDefault*>& out_handles) const
+{
+	for (const auto& key_handle : handles)
+	{
+		if (key_handle.second)
+			out_handles.push_back(key_handle.second.get());
+	}
+}
+
+void FontFace::GetDistanceFieldHandles(Vector<FontFaceHandleDefault*>& out_handles) const
+{
+	for (const auto& key_handle : distance_field_handles)
+	{
+		if (key_handle.second)
+			out_handles.push_back(key_handle.second.get());
+	}
+}
+
+void FontFace::ReleaseHandle(const FontFaceHandleDefault* handle)
+{
+	auto it = std::find_if(handles.begin(), handles.end(), [handle](const auto& key_handle) { return key_handle.second.get() == handle; });
+	if (it == handles.end())
+		return;
+
+	const FontFaceHandleDefault* distance_field_handle = handle->GetDistanceFieldSource();
+	handles.erase(it);
+
+	if (distance_field_handle &&
+		std::none_of(handles.begin(), handles.end(),
+			[distance_field_handle](const auto& key_handle) {
+				return key_handle.second && key_handle.second->GetDistanceFieldSource() == distance_field_handle;
+			}))
+	{
+		distance_field_handles.erase(distance_field_handle->GetSyntheticWeightDelta());
+	}
+}
+
+uint64_t FontFace::GetCacheKey()
+{
+	if (!has_cache_key)
+	{
+		cache_key = FontCache::GetFaceKey(source);
+		has_cache_key = true;
+	}
+	return cache_key;
+}
+
+void FontFace::SaveToCache(FontCache& cache)
+{
+	for (const auto& key_handle : handles)
+	{
+		// Handles rendering from distance fields don't own any glyphs.
+		const FontFaceHandleDefault* handle = key_handle.second.get();
+		if (!handle || handle->GetDistanceFieldSource())
+			continue;
+
+		FontCacheEntry entry;
+		handle->SaveToCache(entry);
+		cache.Insert(GetCacheKey(), handle->GetFontMetrics().size, handle->GetSyntheticWeightDelta(), std::move(entry));
+	}
 }
 
 } // namespace Rml
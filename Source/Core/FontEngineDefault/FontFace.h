@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../../Include/RmlUi/Core/StyleTypes.h"
+#include "FontCache.h"
 #include "FontTypes.h"
 
 namespace Rml {
@@ -9,7 +10,7 @@ class FontFaceHandleDefault;
 
 class FontFace {
 public:
-	FontFace(FontFaceHandleFreetype face, Style::FontStyle style, Style::FontWeight weight);
+	FontFace(FontFaceHandleFreetype face, Style::FontStyle style, Style::FontWeight weight, const FontFaceSource& source);
 	~FontFace();
 
 	Style::FontStyle GetStyle() const;
@@ -22,10 +23,27 @@ public:
 	/// match the requested weight when that weight is not available.
 	/// @return The font handle.
 	FontFaceHandleDefault* GetHandle(int size, bool load_default_glyphs, int synthetic_weight_delta);
+	/// Returns the handle rasterizing distance field glyphs for all sizes of this face in distance field mode.
+	/// @param[in] synthetic_weight_delta If non-zero and positive, the face will be synthetically emboldened.
+	/// @return The font handle, or nullptr if it could not be initialized.
+	FontFaceHandleDefault* GetDistanceFieldHandle(int synthetic_weight_delta);
 
 	/// Releases resources owned by sized font faces, including their textures and rendered glyphs.
 	void ReleaseFontResources();
 
+	/// Returns all sized handles of this face.
+	void GetHandles(Vector<FontFaceHandleDefault*>& out_handles) const;
+	/// Returns the distance field handles of this face, which provide the glyphs of the sized handles in distance field mode.
+	void GetDistanceFieldHandles(Vector<FontFaceHandleDefault*>& out_handles) const;
+	/// Releases a single sized handle of this face, including its textures and rendered glyphs. The distance field handle it renders from is
+	/// also released once no other sized handles refer to it.
+	void ReleaseHandle(const FontFaceHandleDefault* handle);
+
+	/// Returns the key identifying this face in the font cache, computed from the font data on first use.
+	uint64_t GetCacheKey();
+	/// Adds the glyphs and metrics of all sized handles of this face to the font cache.
+	void SaveToCache(FontCache& cache);
+
 private:
 	Style::FontStyle style;
 	Style::FontWeight weight;
@@ -36,7 +54,14 @@ private:
 	using HandleMap = UnorderedMap<HandleKey, UniquePtr<FontFaceHandleDefault>>;
 	HandleMap handles;
 
+	// Distance field handles, keyed by their synthetic weight delta.
+	UnorderedMap<int, UniquePtr<FontFaceHandleDefault>> distance_field_handles;
+
 	FontFaceHandleFreetype face;
+
+	FontFaceSource source;
+	uint64_t cache_key = 0;
+	bool has_cache_key = false;
 };
 
 } // namespace Rml
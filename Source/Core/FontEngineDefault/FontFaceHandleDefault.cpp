@@ -1,8 +1,11 @@
 #include "FontFaceHandleDefault.h"
 #include "../../../Include/RmlUi/Core/Profiling.h"
+#include "../../../Include/RmlUi/Core/RenderManager.h"
 #include "../../../Include/RmlUi/Core/StringUtilities.h"
 #include "../../../Include/RmlUi/Core/StyleTypes.h"
+#include "../../../Include/RmlUi/Core/Variant.h"
 #include "../TextureLayout.h"
+#include "FontCache.h"
 #include "FontFaceLayer.h"
 #include "FontProvider.h"
 #include "FreeTypeInterface.h"
@@ -13,6 +16,7 @@ namespace Rml {
 
 static constexpr char32_t KerningCache_AsciiSubsetBegin = 32;
 static constexpr char32_t KerningCache_AsciiSubsetLast = 126;
+static constexpr int KerningCache_AsciiSubsetSize = int(KerningCache_AsciiSubsetLast - KerningCache_AsciiSubsetBegin + 1);
 
 FontFaceHandleDefault::FontFaceHandleDefault()
 {
@@ -33,18 +37,36 @@ bool FontFaceHandleDefault::Initialize(FontFaceHandleFreetype face, int font_siz
 	return Initialize(face, font_size, load_default_glyphs, 0);
 }
 
-bool FontFaceHandleDefault::Initialize(FontFaceHandleFreetype face, int font_size, bool load_default_glyphs, int in_synthetic_weight_delta)
+bool FontFaceHandleDefault::Initialize(FontFaceHandleFreetype face, int font_size, bool load_default_glyphs, int in_synthetic_weight_delta,
+	const FontCacheEntry* cache_entry, bool in_distance_field)
 {
 	ft_face = face;
 	synthetic_weight_delta = Math::Max(in_synthetic_weight_delta, 0);
+	distance_field = in_distance_field;
 
 	RMLUI_ASSERTMSG(layer_configurations.empty(), "Initialize must only be called once.");
 
-	if (!FreeType::InitialiseFaceHandle(ft_face, font_size, glyphs, metrics, load_default_glyphs, synthetic_weight_delta))
+	has_kerning = FreeType::HasKerning(ft_face);
+
+	if (cache_entry)
+	{
+		metrics = cache_entry->metrics;
+		glyphs.reserve(cache_entry->glyphs.size());
+		for (const auto& pair : cache_entry->glyphs)
+			glyphs[pair.first] = FontCache::CopyGlyph(pair.second);
+	}
+	else if (!FreeType::InitialiseFaceHandle(ft_face, font_size, glyphs, metrics, load_default_glyphs, synthetic_weight_delta, distance_field))
+	{
 		return false;
+	}
 
-	has_kerning = FreeType::HasKerning(ft_face);
-	FillKerningPairCache();
+	for (const auto& pair : glyphs)
+		CacheGlyphAdvance(pair.first, pair.second);
+
+	if (cache_entry && cache_entry->kerning_pairs.size() == (has_kerning ? size_t(KerningCache_AsciiSubsetSize * KerningCache_AsciiSubsetSize) : 0))
+		kerning_pair_cache = cache_entry->kerning_pairs;
+	else
+		FillKerningPairCache();
 
 	// Generate the default layer and layer configuration.
 	base_layer = GetOrCreateLayer(nullptr);
@@ -53,6 +75,37 @@ bool FontFaceHandleDefault::Initialize(FontFaceHandleFreetype face, int font_siz
 	return true;
 }
 
+void FontFaceHandleDefault::InitializeDistanceField(FontFaceHandleDefault* source, int font_size)
+{
+	RMLUI_ASSERT(source && source->distance_field);
+	RMLUI_ASSERTMSG(distance_field_configurations.empty(), "Initialize must only be called once.");
+
+	distance_field_source = source;
+	distance_field_scale = float(font_size) / float(source->metrics.size);
+	ft_face = source->ft_face;
+	synthetic_weight_delta = source->synthetic_weight_delta;
+
+	const FontMetrics& source_metrics = source->metrics;
+	metrics = source_metrics;
+	metrics.size = font_size;
+	metrics.ascent = source_metrics.ascent * distance_field_scale;
+	metrics.descent = source_metrics.descent * distance_field_scale;
+	metrics.line_spacing = source_metrics.line_spacing * distance_field_scale;
+	metrics.x_height = source_metrics.x_height * distance_field_scale;
+	metrics.underline_position = source_metrics.underline_position * distance_field_scale;
+	metrics.underline_thickness = Math::Max(source_metrics.underline_thickness * distance_field_scale, 1.f);
+
+	// The default configuration only renders the text itself.
+	distance_field_configurations.emplace_back();
+	distance_field_configurations.back().layers.emplace_back();
+	InitializeDistanceFieldLayer(distance_field_configurations.back().layers.back(), nullptr);
+}
+
+FontFaceHandleDefault* FontFaceHandleDefault::GetDistanceFieldSource() const
+{
+	return distance_field_source;
+}
+
 const FontMetrics& FontFaceHandleDefault::GetFontMetrics() const
 {
 	return metrics;
@@ -63,37 +116,133 @@ const FontGlyphMap& FontFaceHandleDefault::GetGlyphs() const
 	return glyphs;
 }
 
+int FontFaceHandleDefault::GetSyntheticWeightDelta() const
+{
+	return synthetic_weight_delta;
+}
+
+void FontFaceHandleDefault::SaveToCache(FontCacheEntry& entry) const
+{
+	entry.metrics = metrics;
+	entry.kerning_pairs = kerning_pair_cache;
+
+	entry.glyphs.clear();
+	entry.glyphs.reserve(glyphs.size());
+	for (const auto& pair : glyphs)
+	{
+		// Skip glyphs borrowed from fallback faces, they are looked up from the fallback faces again when needed.
+		const FontGlyph& glyph = pair.second;
+		if (glyph.bitmap_data && !glyph.bitmap_owned_data)
+			continue;
+
+		entry.glyphs[pair.first] = FontCache::CopyGlyph(glyph);
+	}
+}
+
+size_t FontFaceHandleDefault::GetTextureBytes() const
+{
+	size_t num_bytes = 0;
+	for (const EffectLayerPair& pair : layers)
+		num_bytes += pair.layer->GetTextureBytes();
+	return num_bytes;
+}
+
+size_t FontFaceHandleDefault::GetGlyphBytes() const
+{
+	size_t num_bytes = 0;
+	for (const auto& pair : glyphs)
+	{
+		const FontGlyph& glyph = pair.second;
+		if (!glyph.bitmap_owned_data)
+			continue;
+
+		const size_t num_bytes_per_pixel = (glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
+		num_bytes += size_t(glyph.bitmap_dimensions.x) * size_t(glyph.bitmap_dimensions.y) * num_bytes_per_pixel;
+	}
+	return num_bytes;
+}
+
+uint64_t FontFaceHandleDefault::GetLastUsed() const
+{
+	return last_used;
+}
+
+void FontFaceHandleDefault::SetLastUsed(uint64_t in_last_used)
+{
+	last_used = in_last_used;
+}
+
 int FontFaceHandleDefault::GetStringWidth(StringView string, const TextShapingContext& text_shaping_context, Character prior_character)
 {
 	RMLUI_ZoneScoped;
 
+	if (distance_field_source)
+	{
+		// Letter spacing is applied at our own size, so that it is not rounded at the size of the source.
+		TextShapingContext source_shaping_context = text_shaping_context;
+		source_shaping_context.letter_spacing = 0.f;
+		const ShapedString& shaped_string = distance_field_source->GetShapedString(string, source_shaping_context, prior_character);
+		return GetDistanceFieldWidth(shaped_string.width, (int)shaped_string.glyphs.size(), text_shaping_context.letter_spacing);
+	}
+
+	return Math::Max(GetShapedString(string, text_shaping_context, prior_character).width, 0);
+}
+
+void FontFaceHandleDefault::GetStringPrefixWidths(StringView string, const TextShapingContext& text_shaping_context, Character prior_character,
+	Vector<int>& out_prefix_widths)
+{
+	RMLUI_ZoneScoped;
+
+	if (distance_field_source)
+	{
+		TextShapingContext source_shaping_context = text_shaping_context;
+		source_shaping_context.letter_spacing = 0.f;
+		distance_field_source->GetStringPrefixWidths(string, source_shaping_context, prior_character, out_prefix_widths);
+
+		// Control characters are not rendered, every other character is counted as a glyph with letter spacing, see GetStringWidth.
+		int num_glyphs = 0;
+		size_t index = 0;
+		for (auto it_string = StringIteratorU8(string); it_string && index < out_prefix_widths.size(); ++it_string, ++index)
+		{
+			if (char32_t(*it_string) >= char32_t(' '))
+				num_glyphs += 1;
+			out_prefix_widths[index] = GetDistanceFieldWidth(out_prefix_widths[index], num_glyphs, text_shaping_context.letter_spacing);
+		}
+		return;
+	}
+
+	out_prefix_widths.clear();
+	out_prefix_widths.reserve(string.size());
+
 	bool has_set_size = false;
-	bool is_kerning_enabled = IsKerningEnabled(text_shaping_context);
+	const bool is_kerning_enabled = IsKerningEnabled(text_shaping_context);
+	const int letter_spacing = (int)text_shaping_context.letter_spacing;
 	int width = 0;
+
 	for (auto it_string = StringIteratorU8(string); it_string; ++it_string)
 	{
 		Character character = *it_string;
+		int advance = 0;
+		bool is_color = false;
 
-		const FontGlyph* glyph = GetOrAppendGlyph(character);
-		if (!glyph)
-			continue;
-
-		// Adjust the cursor for the kerning between this character and the previous one.
-		if (is_kerning_enabled)
-			width += GetKerning(prior_character, character, has_set_size);
+		if (GetGlyphAdvance(character, advance, is_color))
+		{
+			if (is_kerning_enabled)
+				width += GetKerning(prior_character, character, has_set_size);
 
-		// Adjust the cursor for this character's advance.
-		width += glyph->advance;
-		width += (int)text_shaping_context.letter_spacing;
+			width += advance + letter_spacing;
+			prior_character = character;
+		}
 
-		prior_character = character;
+		out_prefix_widths.push_back(Math::Max(width, 0));
 	}
-
-	return Math::Max(width, 0);
 }
 
 int FontFaceHandleDefault::GenerateLayerConfiguration(const FontEffectList& font_effects)
 {
+	if (distance_field_source)
+		return GenerateDistanceFieldConfiguration(font_effects);
+
 	if (font_effects.empty())
 		return 0;
 
@@ -156,9 +305,9 @@ int FontFaceHandleDefault::GenerateLayerConfiguration(const FontEffectList& font
 }
 
 bool FontFaceHandleDefault::GenerateLayerTexture(Vector<byte>& texture_data, Vector2i& texture_dimensions, const FontEffect* font_effect,
-	int texture_id, int handle_version) const
+	int texture_id, int in_texture_version) const
 {
-	if (handle_version != version)
+	if (in_texture_version != texture_version)
 	{
 		RMLUI_ERRORMSG("While generating font layer texture: Handle version mismatch in texture vs font-face.");
 		return false;
@@ -178,13 +327,17 @@ bool FontFaceHandleDefault::GenerateLayerTexture(Vector<byte>& texture_data, Vec
 int FontFaceHandleDefault::GenerateString(RenderManager& render_manager, TexturedMeshList& mesh_list, StringView string, const Vector2f position,
 	const ColourbPremultiplied colour, const float opacity, const TextShapingContext& text_shaping_context, const int layer_configuration_index)
 {
+	if (distance_field_source)
+		return GenerateDistanceFieldString(render_manager, mesh_list, string, position, colour, opacity, text_shaping_context,
+			layer_configuration_index);
+
 	RMLUI_ASSERT(layer_configuration_index >= 0);
 	RMLUI_ASSERT(layer_configuration_index < (int)layer_configurations.size());
 
 	int geometry_index = 0;
-	int line_width = 0;
-	bool has_set_size = false;
-	bool is_kerning_enabled = IsKerningEnabled(text_shaping_context);
+
+	// Shape the string once for all layers, this also appends any missing glyphs before the layers are updated.
+	const ShapedString& shaped_string = GetShapedString(string, text_shaping_context, Character::Null);
 
 	UpdateLayersOnDirty();
 
@@ -213,9 +366,6 @@ int FontFaceHandleDefault::GenerateString(RenderManager& render_manager, Texture
 
 		RMLUI_ASSERT(geometry_index + num_textures <= (int)mesh_list.size());
 
-		line_width = 0;
-		Character prior_character = Character::Null;
-
 		// Set the mesh and textures to the geometries.
 		for (int tex_index = 0; tex_index < num_textures; ++tex_index)
 			mesh_list[geometry_index + tex_index].texture = layer->GetTexture(render_manager, tex_index);
@@ -223,52 +373,154 @@ int FontFaceHandleDefault::GenerateString(RenderManager& render_manager, Texture
 		mesh_list[geometry_index].mesh.indices.reserve(string.size() * 6);
 		mesh_list[geometry_index].mesh.vertices.reserve(string.size() * 4);
 
-		for (auto it_string = StringIteratorU8(string); it_string; ++it_string)
+		for (const ShapedGlyph& shaped_glyph : shaped_string.glyphs)
 		{
-			Character character = *it_string;
-
-			const FontGlyph* glyph = GetOrAppendGlyph(character);
-			if (!glyph)
-				continue;
-
-			// Adjust the cursor for the kerning between this character and the previous one.
-			if (is_kerning_enabled)
-				line_width += GetKerning(prior_character, character, has_set_size);
-
 			ColourbPremultiplied glyph_color = layer_colour;
 			// Use white vertex colors on RGB glyphs.
-			if (layer == base_layer && glyph->color_format == ColorFormat::RGBA8)
+			if (layer == base_layer && shaped_glyph.is_color)
 				glyph_color = ColourbPremultiplied(layer_colour.alpha, layer_colour.alpha);
 
-			layer->GenerateGeometry(&mesh_list[geometry_index], character, Vector2f(position.x + line_width, position.y), glyph_color);
-
-			line_width += glyph->advance;
-			line_width += (int)text_shaping_context.letter_spacing;
-			prior_character = character;
+			layer->GenerateGeometry(&mesh_list[geometry_index], shaped_glyph.character, Vector2f(position.x + shaped_glyph.x, position.y),
+				glyph_color);
 		}
 
 		geometry_index += num_textures;
 	}
 
-	return Math::Max(line_width, 0);
+	return Math::Max(shaped_string.width, 0);
+}
+
+auto FontFaceHandleDefault::GetShapedString(StringView string, const TextShapingContext& text_shaping_context, Character prior_character)
+	-> const ShapedString&
+{
+	// Only short strings, such as words, labels, and numbers, are worth caching. Longer strings are shaped into a scratch buffer.
+	constexpr size_t max_cached_string_size = 64;
+	constexpr size_t max_cached_strings = 1024;
+
+	const int letter_spacing = (int)text_shaping_context.letter_spacing;
+	const bool kerning = IsKerningEnabled(text_shaping_context);
+
+	if (string.size() > max_cached_string_size)
+	{
+		shaped_string_scratch.prior_character = prior_character;
+		shaped_string_scratch.letter_spacing = letter_spacing;
+		shaped_string_scratch.kerning = kerning;
+		ShapeString(shaped_string_scratch, string);
+		return shaped_string_scratch;
+	}
+
+	// Glyph advances and kerning never change once a glyph is appended, so cached strings stay valid until they are evicted. Rotating the
+	// generations instead of clearing everything avoids shaping all the strings of a large document again whenever the cache fills up.
+	String key(string.begin(), string.end());
+	auto it_entries = shaped_string_cache.find(key);
+	if (it_entries == shaped_string_cache.end())
+	{
+		if (shaped_string_cache.size() >= max_cached_strings)
+		{
+			previous_shaped_string_cache.swap(shaped_string_cache);
+			shaped_string_cache.clear();
+		}
+		it_entries = shaped_string_cache.emplace(key, Vector<ShapedString>()).first;
+	}
+	else if (ShapedString* entry = FindShapedString(it_entries->second, prior_character, letter_spacing, kerning))
+	{
+		return *entry;
+	}
+
+	Vector<ShapedString>& entries = it_entries->second;
+
+	auto it_previous_entries = previous_shaped_string_cache.find(key);
+	if (it_previous_entries != previous_shaped_string_cache.end())
+	{
+		if (ShapedString* previous_entry = FindShapedString(it_previous_entries->second, prior_character, letter_spacing, kerning))
+		{
+			entries.push_back(std::move(*previous_entry));
+			it_previous_entries->second.erase(it_previous_entries->second.begin() + (previous_entry - it_previous_entries->second.data()));
+			return entries.back();
+		}
+	}
+
+	entries.push_back(ShapedString{prior_character, letter_spacing, kerning, {}, 0});
+	ShapeString(entries.back(), string);
+	return entries.back();
+}
+
+auto FontFaceHandleDefault::FindShapedString(Vector<ShapedString>& entries, Character prior_character, int letter_spacing, bool kerning)
+	-> ShapedString*
+{
+	for (ShapedString& entry : entries)
+	{
+		if (entry.prior_character == prior_character && entry.letter_spacing == letter_spacing && entry.kerning == kerning)
+			return &entry;
+	}
+	return nullptr;
+}
+
+void FontFaceHandleDefault::ShapeString(ShapedString& shaped_string, StringView string)
+{
+	bool has_set_size = false;
+	Character prior_character = shaped_string.prior_character;
+	int width = 0;
+
+	shaped_string.glyphs.clear();
+
+	for (auto it_string = StringIteratorU8(string); it_string; ++it_string)
+	{
+		Character character = *it_string;
+		int advance = 0;
+		bool is_color = false;
+
+		if (!GetGlyphAdvance(character, advance, is_color))
+			continue;
+
+		// Adjust the cursor for the kerning between this character and the previous one.
+		if (shaped_string.kerning)
+			width += GetKerning(prior_character, character, has_set_size);
+
+		shaped_string.glyphs.push_back(ShapedGlyph{character, width, is_color});
+
+		// Adjust the cursor for this character's advance.
+		width += advance;
+		width += shaped_string.letter_spacing;
+
+		prior_character = character;
+	}
+
+	shaped_string.width = width;
 }
 
 bool FontFaceHandleDefault::UpdateLayersOnDirty()
 {
 	bool result = false;
 
-	// If we are dirty, regenerate all the layers and increment the version
+	// If we are dirty, update all the layers and increment the version
 	if (is_layers_dirty && base_layer)
 	{
 		is_layers_dirty = false;
 		++version;
 
-		// Regenerate all the layers.
-		// Note: The layer regeneration needs to happen in the order in which the layers were created,
-		// otherwise we may end up cloning a layer which has not yet been regenerated. This means trouble!
+		// First try to add the new glyphs to the existing layers, only uploading the new glyphs to their textures.
+		// Note: The layers need to be updated in the order in which they were created, otherwise we may end up
+		// cloning a layer which has not yet been updated. This means trouble!
+		bool appended = true;
 		for (auto& pair : layers)
 		{
-			GenerateLayer(pair.layer.get());
+			if (!pair.layer->AppendGlyphs(this, appended_characters))
+			{
+				appended = false;
+				break;
+			}
+		}
+		appended_characters.clear();
+
+		// If the glyphs did not fit into the existing textures, or the render interface can't update textures, regenerate all the layers.
+		if (!appended)
+		{
+			++texture_version;
+			for (auto& pair : layers)
+			{
+				GenerateLayer(pair.layer.get());
+			}
 		}
 
 		result = true;
@@ -279,12 +531,51 @@ bool FontFaceHandleDefault::UpdateLayersOnDirty()
 
 int FontFaceHandleDefault::GetVersion() const
 {
+	// The geometry of distance field handles refers to the glyphs and textures of the source.
+	if (distance_field_source)
+		return distance_field_source->GetVersion();
 	return version;
 }
 
+int FontFaceHandleDefault::GetTextureVersion() const
+{
+	if (distance_field_source)
+		return distance_field_source->GetTextureVersion();
+	return texture_version;
+}
+
+bool FontFaceHandleDefault::GetGlyphAdvance(Character& character, int& advance, bool& is_color)
+{
+	const char32_t code_point = char32_t(character);
+	if (code_point < GlyphAdvanceTableSize && glyph_advances[code_point].is_appended)
+	{
+		advance = glyph_advances[code_point].advance;
+		is_color = glyph_advances[code_point].is_color;
+		return true;
+	}
+
+	const FontGlyph* glyph = GetOrAppendGlyph(character);
+	if (!glyph)
+		return false;
+
+	advance = glyph->advance;
+	is_color = (glyph->color_format == ColorFormat::RGBA8);
+	return true;
+}
+
+void FontFaceHandleDefault::CacheGlyphAdvance(Character character, const FontGlyph& glyph)
+{
+	// Control characters are never rendered, see GetOrAppendGlyph.
+	const char32_t code_point = char32_t(character);
+	if (code_point < (char32_t)' ' || code_point >= GlyphAdvanceTableSize)
+		return;
+
+	glyph_advances[code_point] = GlyphAdvance{glyph.advance, glyph.color_format == ColorFormat::RGBA8, true};
+}
+
 bool FontFaceHandleDefault::AppendGlyph(Character character)
 {
-	bool result = FreeType::AppendGlyph(ft_face, metrics.size, character, glyphs, synthetic_weight_delta);
+	bool result = FreeType::AppendGlyph(ft_face, metrics.size, character, glyphs, synthetic_weight_delta, distance_field);
 	return result;
 }
 
@@ -293,6 +584,8 @@ void FontFaceHandleDefault::FillKerningPairCache()
 	if (!has_kerning)
 		return;
 
+	kerning_pair_cache.assign(KerningCache_AsciiSubsetSize * KerningCache_AsciiSubsetSize, 0);
+
 	for (char32_t i = KerningCache_AsciiSubsetBegin; i <= KerningCache_AsciiSubsetLast; i++)
 	{
 		for (char32_t j = KerningCache_AsciiSubsetBegin; j <= KerningCache_AsciiSubsetLast; j++)
@@ -301,10 +594,8 @@ void FontFaceHandleDefault::FillKerningPairCache()
 
 			// Fetch the kerning from the font face. Submit zero font size on subsequent iterations for performance reasons.
 			const int kerning = FreeType::GetKerning(ft_face, first_iteration ? metrics.size : 0, Character(i), Character(j));
-			if (kerning != 0)
-			{
-				kerning_pair_cache.emplace(AsciiPair((i << 8) | j), KerningIntType(kerning));
-			}
+			const int index = int(i - KerningCache_AsciiSubsetBegin) * KerningCache_AsciiSubsetSize + int(j - KerningCache_AsciiSubsetBegin);
+			kerning_pair_cache[index] = KerningIntType(kerning);
 		}
 	}
 }
@@ -323,14 +614,9 @@ int FontFaceHandleDefault::GetKerning(Character lhs, Character rhs, bool& has_se
 
 	if (lhs_in_cache && rhs_in_cache)
 	{
-		const auto it = kerning_pair_cache.find(AsciiPair((int(lhs) << 8) | int(rhs)));
-
-		if (it != kerning_pair_cache.end())
-		{
-			return it->second;
-		}
-
-		return 0;
+		const int index = int(char32_t(lhs) - KerningCache_AsciiSubsetBegin) * KerningCache_AsciiSubsetSize +
+			int(char32_t(rhs) - KerningCache_AsciiSubsetBegin);
+		return kerning_pair_cache[index];
 	}
 
 	// Fetch it from the font face instead.
@@ -356,7 +642,9 @@ const FontGlyph* FontFaceHandleDefault::GetOrAppendGlyph(Character& character, b
 	auto it_glyph = glyphs.find(character);
 	if (it_glyph == glyphs.end())
 	{
-		bool result = AppendGlyph(character);
+		// Characters missing from the font face are only looked up once, see below.
+		auto it_missing = missing_characters.find(character);
+		const bool result = (it_missing == missing_characters.end() && AppendGlyph(character));
 
 		if (result)
 		{
@@ -368,11 +656,21 @@ const FontGlyph* FontFaceHandleDefault::GetOrAppendGlyph(Character& character, b
 			}
 
 			is_layers_dirty = true;
+			appended_characters.push_back(character);
+			CacheGlyphAdvance(character, it_glyph->second);
 		}
 		else if (look_in_fallback_fonts)
 		{
+			if (it_missing == missing_characters.end())
+				it_missing = missing_characters.emplace(character, 0).first;
+
+			// Only search the fallback font faces which have been added since the character was last looked for. Glyphs found in them are
+			// inserted into our own glyphs, thus the search only repeats for characters not found in any face.
 			const int num_fallback_faces = FontProvider::CountFallbackFontFaces();
-			for (int i = 0; i < num_fallback_faces; i++)
+			const int first_fallback_face = it_missing->second;
+			it_missing->second = num_fallback_faces;
+
+			for (int i = first_fallback_face; i < num_fallback_faces; i++)
 			{
 				FontFaceHandleDefault* fallback_face = FontProvider::GetFallbackFontFace(i, metrics.size);
 				if (!fallback_face || fallback_face == this)
@@ -385,7 +683,11 @@ const FontGlyph* FontFaceHandleDefault::GetOrAppendGlyph(Character& character, b
 					auto pair = glyphs.emplace(character, glyph->WeakCopy());
 					it_glyph = pair.first;
 					if (pair.second)
+					{
 						is_layers_dirty = true;
+						appended_characters.push_back(character);
+						CacheGlyphAdvance(character, it_glyph->second);
+					}
 					break;
 				}
 			}
@@ -401,6 +703,8 @@ const FontGlyph* FontFaceHandleDefault::GetOrAppendGlyph(Character& character, b
 		}
 		else
 		{
+			if (it_missing == missing_characters.end())
+				missing_characters.emplace(character, 0);
 			return nullptr;
 		}
 	}
@@ -470,4 +774,131 @@ bool FontFaceHandleDefault::GenerateLayer(FontFaceLayer* layer)
 	return result;
 }
 
+int FontFaceHandleDefault::GenerateDistanceFieldConfiguration(const FontEffectList& font_effects)
+{
+	if (font_effects.empty())
+		return 0;
+
+	for (int configuration_index = 1; configuration_index < (int)distance_field_configurations.size(); ++configuration_index)
+	{
+		if (distance_field_configurations[configuration_index].font_effects == font_effects)
+			return configuration_index;
+	}
+
+	// Effects are placed behind or in front of the text as with layers. Effects which can't be rendered from the distance field are skipped.
+	distance_field_configurations.emplace_back();
+	DistanceFieldConfiguration& configuration = distance_field_configurations.back();
+	configuration.font_effects = font_effects;
+
+	bool added_text_layer = false;
+	for (const SharedPtr<const FontEffect>& font_effect : font_effects)
+	{
+		if (!added_text_layer && font_effect->GetLayer() == FontEffect::Layer::Front)
+		{
+			configuration.layers.emplace_back();
+			InitializeDistanceFieldLayer(configuration.layers.back(), nullptr);
+			added_text_layer = true;
+		}
+
+		configuration.layers.emplace_back();
+		if (!InitializeDistanceFieldLayer(configuration.layers.back(), font_effect.get()))
+			configuration.layers.pop_back();
+	}
+
+	if (!added_text_layer)
+	{
+		configuration.layers.emplace_back();
+		InitializeDistanceFieldLayer(configuration.layers.back(), nullptr);
+	}
+
+	return (int)distance_field_configurations.size() - 1;
+}
+
+bool FontFaceHandleDefault::InitializeDistanceFieldLayer(DistanceFieldLayer& layer, const FontEffect* font_effect) const
+{
+	float outline_width = 0.f;
+	float blur_width = 0.f;
+	Vector2f offset;
+	if (font_effect && !font_effect->GetDistanceFieldParameters(outline_width, blur_width, offset))
+		return false;
+
+	// The widths are limited by the spread of the distance field, the field must fade out before reaching the edges of the glyph quads.
+	constexpr float max_width = float(DistanceFieldSpread - 1);
+	layer.font_effect = font_effect;
+	layer.offset = offset;
+	layer.outline_width = Math::Clamp(outline_width / distance_field_scale, 0.f, max_width);
+	layer.blur_width = Math::Clamp(blur_width / distance_field_scale, 0.f, max_width - layer.outline_width);
+	return true;
+}
+
+const SharedPtr<const CompiledShader>& FontFaceHandleDefault::GetDistanceFieldShader(RenderManager& render_manager, DistanceFieldLayer& layer) const
+{
+	auto it = layer.shaders.find(&render_manager);
+	if (it == layer.shaders.end())
+	{
+		const Dictionary parameters = {
+			{"spread", Variant(float(DistanceFieldSpread))},
+			{"outline_width", Variant(layer.outline_width)},
+			{"blur_width", Variant(layer.blur_width)},
+		};
+		SharedPtr<const CompiledShader> shader;
+		if (CompiledShader compiled_shader = render_manager.CompileShader("distance-field-text", parameters))
+			shader = MakeShared<const CompiledShader>(std::move(compiled_shader));
+		it = layer.shaders.emplace(&render_manager, std::move(shader)).first;
+	}
+	return it->second;
+}
+
+int FontFaceHandleDefault::GetDistanceFieldWidth(int source_width, int num_glyphs, float letter_spacing) const
+{
+	return Math::Max(Math::RoundToInteger(float(source_width) * distance_field_scale + float(num_glyphs) * letter_spacing), 0);
+}
+
+int FontFaceHandleDefault::GenerateDistanceFieldString(RenderManager& render_manager, TexturedMeshList& mesh_list, StringView string,
+	const Vector2f position, const ColourbPremultiplied colour, const float opacity, const TextShapingContext& text_shaping_context,
+	const int configuration_index)
+{
+	RMLUI_ASSERT(configuration_index >= 0 && configuration_index < (int)distance_field_configurations.size());
+
+	FontFaceHandleDefault& source = *distance_field_source;
+	TextShapingContext source_shaping_context = text_shaping_context;
+	source_shaping_context.letter_spacing = 0.f;
+	const ShapedString& shaped_string = source.GetShapedString(string, source_shaping_context, Character::Null);
+
+	source.UpdateLayersOnDirty();
+
+	// All layers render the glyphs of the source's base layer, each with its own text shader.
+	FontFaceLayer* glyph_layer = source.base_layer;
+	const int num_textures = glyph_layer->GetNumTextures();
+	DistanceFieldConfiguration& configuration = distance_field_configurations[configuration_index];
+
+	mesh_list.resize(configuration.layers.size() * num_textures);
+
+	for (size_t layer_index = 0; layer_index < configuration.layers.size(); ++layer_index)
+	{
+		DistanceFieldLayer& layer = configuration.layers[layer_index];
+		TexturedMesh* layer_meshes = mesh_list.data() + layer_index * num_textures;
+
+		const SharedPtr<const CompiledShader>& shader = GetDistanceFieldShader(render_manager, layer);
+		for (int tex_index = 0; tex_index < num_textures; ++tex_index)
+		{
+			layer_meshes[tex_index].texture = glyph_layer->GetTexture(render_manager, tex_index);
+			layer_meshes[tex_index].shader = shader;
+		}
+
+		const ColourbPremultiplied layer_colour = (layer.font_effect ? layer.font_effect->GetColour().ToPremultiplied(opacity) : colour);
+		const Vector2f layer_position = position + layer.offset;
+
+		for (size_t glyph_index = 0; glyph_index < shaped_string.glyphs.size(); ++glyph_index)
+		{
+			const ShapedGlyph& shaped_glyph = shaped_string.glyphs[glyph_index];
+			const float x = float(shaped_glyph.x) * distance_field_scale + float(glyph_index) * text_shaping_context.letter_spacing;
+			glyph_layer->GenerateScaledGeometry(layer_meshes, shaped_glyph.character, layer_position + Vector2f(x, 0.f), distance_field_scale,
+				layer_colour);
+		}
+	}
+
+	return GetDistanceFieldWidth(shaped_string.width, (int)shaped_string.glyphs.size(), text_shaping_context.letter_spacing);
+}
+
 } // namespace Rml
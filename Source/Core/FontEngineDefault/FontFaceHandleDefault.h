@@ -12,6 +12,7 @@
 namespace Rml {
 
 class FontFaceLayer;
+struct FontCacheEntry;
 
 class FontFaceHandleDefault final : public NonCopyMoveable {
 public:
@@ -19,11 +20,34 @@ public:
 	~FontFaceHandleDefault();
 
 	bool Initialize(FontFaceHandleFreetype face, int font_size, bool load_default_glyphs);
-	// If synthetic_weight_delta is positive, the face will be synthetically emboldened when rendering glyphs.
-	bool Initialize(FontFaceHandleFreetype face, int font_size, bool load_default_glyphs, int synthetic_weight_delta);
+	// If synthetic_weight_delta is positive, the face will be synthetically emboldened when rendering glyphs. If a cache entry is given, the
+	// metrics, glyphs and kerning are initialized from it instead of being generated by FreeType. If distance_field is set, glyphs are
+	// rasterized as signed distance fields to be shared by handles initialized with InitializeDistanceField.
+	bool Initialize(FontFaceHandleFreetype face, int font_size, bool load_default_glyphs, int synthetic_weight_delta,
+		const FontCacheEntry* cache_entry = nullptr, bool distance_field = false);
+	// Initializes the handle to render text from the glyphs of a distance field handle, scaled to the given font size. Font effects are rendered
+	// by the text shader instead of generating their own layers. The source handle must outlive this handle.
+	void InitializeDistanceField(FontFaceHandleDefault* distance_field_source, int font_size);
+
+	// Returns the handle whose distance field glyphs are rendered by this handle, or nullptr if this handle rasterizes its own glyphs.
+	FontFaceHandleDefault* GetDistanceFieldSource() const;
 
 	const FontMetrics& GetFontMetrics() const;
 
+	int GetSyntheticWeightDelta() const;
+
+	// Copies the metrics, kerning, and glyphs owned by this handle into a font cache entry.
+	void SaveToCache(FontCacheEntry& entry) const;
+
+	// Returns the size of the layer textures generated by this handle.
+	size_t GetTextureBytes() const;
+	// Returns the size of the glyph bitmaps owned by this handle.
+	size_t GetGlyphBytes() const;
+
+	// The last time this handle was requested, used to release the least recently used handles first.
+	uint64_t GetLastUsed() const;
+	void SetLastUsed(uint64_t last_used);
+
 	const FontGlyphMap& GetGlyphs() const;
 
 	/// Returns the width a string will take up if rendered with this handle.
@@ -34,6 +58,14 @@ public:
 	/// @return The width, in pixels, this string will occupy if rendered with this handle.
 	int GetStringWidth(StringView string, const TextShapingContext& text_shaping_context, Character prior_character = Character::Null);
 
+	/// Returns the width of every prefix of a string in a single pass.
+	/// @param[in] string The string to measure.
+	/// @param[in] text_shaping_context Extra parameters that provide context for text shaping.
+	/// @param[in] prior_character The optionally-specified character that immediately precedes the string.
+	/// @param[out] out_prefix_widths The width of the string up to and including each of its code points.
+	void GetStringPrefixWidths(StringView string, const TextShapingContext& text_shaping_context, Character prior_character,
+		Vector<int>& out_prefix_widths);
+
 	/// Generates, if required, the layer configuration for a given list of font effects.
 	/// @param[in] font_effects The list of font effects to generate the configuration for.
 	/// @return The index to use when generating geometry using this configuration.
@@ -43,9 +75,9 @@ public:
 	/// @param[out] texture_dimensions The dimensions of the texture.
 	/// @param[in] font_effect The font effect used for the layer.
 	/// @param[in] texture_id The index of the texture within the layer to generate.
-	/// @param[in] handle_version The version of the handle data. Function returns false if out of date.
+	/// @param[in] texture_version The texture version of the handle data. Function returns false if out of date.
 	bool GenerateLayerTexture(Vector<byte>& texture_data, Vector2i& texture_dimensions, const FontEffect* font_effect, int texture_id,
-		int handle_version) const;
+		int texture_version) const;
 
 	/// Generates the geometry required to render a single line of text.
 	/// @param[in] render_manager The render manager responsible for rendering the string.
@@ -62,8 +94,39 @@ public:
 
 	/// Version is changed whenever the layers are dirtied, requiring regeneration of string geometry.
 	int GetVersion() const;
+	/// Texture version is changed whenever the layer textures are regenerated, rather than appended to.
+	int GetTextureVersion() const;
 
 private:
+	// A glyph positioned along a shaped string.
+	struct ShapedGlyph {
+		Character character;
+		int x;
+		bool is_color;
+	};
+	// The glyph positions and width of a string, along with the shaping parameters it was generated with.
+	struct ShapedString {
+		Character prior_character;
+		int letter_spacing;
+		bool kerning;
+		Vector<ShapedGlyph> glyphs;
+		int width;
+	};
+	// Shaped strings are cached by their text, with one entry for each set of shaping parameters the text was seen with.
+	using ShapedStringCache = UnorderedMap<String, Vector<ShapedString>>;
+	// Returns the entry matching the shaping parameters, or nullptr if there is none.
+	static ShapedString* FindShapedString(Vector<ShapedString>& entries, Character prior_character, int letter_spacing, bool kerning);
+
+	// Returns the shaped glyphs of a string, from the cache when the string is short enough to be cached.
+	const ShapedString& GetShapedString(StringView string, const TextShapingContext& text_shaping_context, Character prior_character);
+	// Positions the glyphs of a string, appending any missing glyphs.
+	void ShapeString(ShapedString& shaped_string, StringView string);
+
+	// Looks up the advance of a character's glyph, appending the glyph if needed. Returns false if there is no glyph to render.
+	bool GetGlyphAdvance(Character& character, int& advance, bool& is_color);
+	// Stores the advance of a glyph in the flat advance table if the character is covered by it.
+	void CacheGlyphAdvance(Character character, const FontGlyph& glyph);
+
 	// Build and append glyph to 'glyphs'
 	bool AppendGlyph(Character character);
 
@@ -91,6 +154,32 @@ private:
 	// (Re-)generate a layer in this font face handle.
 	bool GenerateLayer(FontFaceLayer* layer);
 
+	// A layer of text rendered from distance fields, either the text itself or one of its font effects.
+	struct DistanceFieldLayer {
+		const FontEffect* font_effect;
+		Vector2f offset;
+		// Parameters of the text shader, in pixels at the size of the distance field glyphs.
+		float outline_width;
+		float blur_width;
+		SmallUnorderedMap<RenderManager*, SharedPtr<const CompiledShader>> shaders;
+	};
+	struct DistanceFieldConfiguration {
+		FontEffectList font_effects;
+		Vector<DistanceFieldLayer> layers;
+	};
+
+	// Returns a configuration index as in GenerateLayerConfiguration, for handles rendering from distance fields.
+	int GenerateDistanceFieldConfiguration(const FontEffectList& font_effects);
+	// Initializes a layer rendering the text, or the given font effect, returns false if the effect can't be rendered from distance fields.
+	bool InitializeDistanceFieldLayer(DistanceFieldLayer& layer, const FontEffect* font_effect) const;
+	// Returns the text shader of a layer for the given render manager, compiling it on first use.
+	const SharedPtr<const CompiledShader>& GetDistanceFieldShader(RenderManager& render_manager, DistanceFieldLayer& layer) const;
+	// Returns the width of a string shaped by the distance field source, with our letter spacing applied.
+	int GetDistanceFieldWidth(int source_width, int num_glyphs, float letter_spacing) const;
+	// Generates the geometry for a string from the distance field glyphs of the source handle, see GenerateString.
+	int GenerateDistanceFieldString(RenderManager& render_manager, TexturedMeshList& mesh_list, StringView string, Vector2f position,
+		ColourbPremultiplied colour, float opacity, const TextShapingContext& text_shaping_context, int configuration_index);
+
 	FontGlyphMap glyphs;
 
 	struct EffectLayerPair {
@@ -108,15 +197,36 @@ private:
 	// Each font layer that generated geometry or textures, indexed by the font-effect's fingerprint key.
 	FontLayerCache layer_cache;
 
-	// Pre-cache kerning pairs for some ascii subset of all characters.
-	using AsciiPair = uint16_t;
+	// Advances of the glyphs in the most frequently used code point ranges, indexed directly by code point to avoid looking up the glyph map.
+	// Covers Basic Latin through Latin Extended-B.
+	static constexpr char32_t GlyphAdvanceTableSize = 0x250;
+	struct GlyphAdvance {
+		int advance = 0;
+		bool is_color = false;
+		bool is_appended = false;
+	};
+	Array<GlyphAdvance, GlyphAdvanceTableSize> glyph_advances;
+
+	// Pre-cache kerning pairs for some ascii subset of all characters, densely indexed by the pair.
 	using KerningIntType = int16_t;
-	using KerningPairs = UnorderedMap<AsciiPair, KerningIntType>;
+	using KerningPairs = Vector<KerningIntType>;
 	KerningPairs kerning_pair_cache;
 
 	bool has_kerning = false;
 	bool is_layers_dirty = false;
 	int version = 0;
+	int texture_version = 0;
+
+	// Characters whose glyphs were appended since the layers were last updated.
+	Vector<Character> appended_characters;
+	// Characters not found in the font face, mapped to the number of fallback font faces they have been looked for in.
+	UnorderedMap<Character, int> missing_characters;
+
+	// The cache is split into two generations. When the current generation is full it replaces the previous one, strings that are still in use
+	// are moved back from the previous generation instead of being shaped again.
+	ShapedStringCache shaped_string_cache;
+	ShapedStringCache previous_shaped_string_cache;
+	ShapedString shaped_string_scratch;
 
 	// All configurations currently in use on this handle. New configurations will be generated as required.
 	LayerConfigurationList layer_configurations;
@@ -125,6 +235,15 @@ private:
 
 	FontFaceHandleFreetype ft_face;
 	int synthetic_weight_delta = 0;
+
+	// Set on handles rasterizing distance field glyphs, used as sources by handles of all other sizes.
+	bool distance_field = false;
+	// Set on handles rendering from the glyphs of a distance field source, which are scaled by the ratio of the font sizes.
+	FontFaceHandleDefault* distance_field_source = nullptr;
+	float distance_field_scale = 1.f;
+	Vector<DistanceFieldConfiguration> distance_field_configurations;
+
+	uint64_t last_used = 0;
 };
 
 } // namespace Rml
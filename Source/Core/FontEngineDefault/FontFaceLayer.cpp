@@ -1,5 +1,8 @@
 #include "FontFaceLayer.h"
+#include "../../../Include/RmlUi/Core/Core.h"
+#include "../../../Include/RmlUi/Core/Math.h"
 #include "../../../Include/RmlUi/Core/RenderManager.h"
+#include "../../../Include/RmlUi/Core/TaskInterface.h"
 #include "FontFaceHandleDefault.h"
 #include <string.h>
 #include <type_traits>
@@ -19,12 +22,12 @@ bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFace
 {
 	// Clear the old layout if it exists.
 	{
-		// @performance: We could be much smarter about this, e.g. such as adding new glyphs to the existing texture layout and textures.
-		// Right now we re-generate the whole thing, including textures.
 		texture_layout = TextureLayout{};
 		character_boxes.clear();
 		textures_owned.clear();
 		textures_ptr = &textures_owned;
+		clone_layer = clone;
+		keep_clone_glyph_origins = clone_glyph_origins;
 	}
 
 	const FontGlyphMap& glyphs = handle->GetGlyphs();
@@ -54,15 +57,7 @@ bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFace
 					continue;
 				}
 
-				TextureBox& box = it->second;
-
-				Vector2i glyph_origin = Vector2i(box.origin);
-				Vector2i glyph_dimensions = Vector2i(box.dimensions);
-
-				if (effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
-					box.origin = Vector2f(glyph_origin);
-				else
-					box.texture_index = -1;
+				AdjustClonedCharacterBox(glyph, it->second);
 			}
 		}
 	}
@@ -75,21 +70,10 @@ bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFace
 			Character character = pair.first;
 			const FontGlyph& glyph = pair.second;
 
-			Vector2i glyph_origin(0, 0);
-			Vector2i glyph_dimensions = glyph.bitmap_dimensions;
-
-			// Adjust glyph origin / dimensions for the font effect.
-			if (effect)
-			{
-				if (!effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
-					continue;
-			}
-
 			TextureBox box;
-			box.origin = Vector2f(float(glyph_origin.x + glyph.bearing.x), float(glyph_origin.y - glyph.bearing.y));
-			box.dimensions = Vector2f(glyph_dimensions);
-
-			RMLUI_ASSERT(box.dimensions.x >= 0 && box.dimensions.y >= 0);
+			Vector2i glyph_dimensions;
+			if (!InitializeCharacterBox(glyph, box, glyph_dimensions))
+				continue;
 
 			character_boxes[character] = box;
 
@@ -109,34 +93,24 @@ bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFace
 		for (int i = 0; i < texture_layout.GetNumRectangles(); ++i)
 		{
 			TextureLayoutRectangle& rectangle = texture_layout.GetRectangle(i);
-			const TextureLayoutTexture& texture = texture_layout.GetTexture(rectangle.GetTextureIndex());
 			Character character = (Character)rectangle.GetId();
 			RMLUI_ASSERT(character_boxes.find(character) != character_boxes.end());
-			TextureBox& box = character_boxes[character];
-
-			// Set the character's texture index.
-			box.texture_index = rectangle.GetTextureIndex();
-
-			// Generate the character's texture coordinates.
-			box.texcoords[0].x = float(rectangle.GetPosition().x) / float(texture.GetDimensions().x);
-			box.texcoords[0].y = float(rectangle.GetPosition().y) / float(texture.GetDimensions().y);
-			box.texcoords[1].x = float(rectangle.GetPosition().x + rectangle.GetDimensions().x) / float(texture.GetDimensions().x);
-			box.texcoords[1].y = float(rectangle.GetPosition().y + rectangle.GetDimensions().y) / float(texture.GetDimensions().y);
+			SetCharacterTexture(character_boxes[character], rectangle);
 		}
 
 		const FontEffect* effect_ptr = effect.get();
-		const int handle_version = handle->GetVersion();
+		const int texture_version = handle->GetTextureVersion();
 
 		// Generate the textures.
 		for (int i = 0; i < texture_layout.GetNumTextures(); ++i)
 		{
 			const int texture_id = i;
 
-			CallbackTextureFunction texture_callback = [handle, effect_ptr, texture_id, handle_version](
+			CallbackTextureFunction texture_callback = [handle, effect_ptr, texture_id, texture_version](
 														   const CallbackTextureInterface& texture_interface) -> bool {
 				Vector2i dimensions;
 				Vector<byte> data;
-				if (!handle->GenerateLayerTexture(data, dimensions, effect_ptr, texture_id, handle_version) || data.empty())
+				if (!handle->GenerateLayerTexture(data, dimensions, effect_ptr, texture_id, texture_version) || data.empty())
 					return false;
 				if (!texture_interface.GenerateTexture(data, dimensions))
 					return false;
@@ -153,72 +127,216 @@ bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFace
 	return true;
 }
 
+bool FontFaceLayer::AppendGlyphs(const FontFaceHandleDefault* handle, Span<const Character> characters)
+{
+	const FontGlyphMap& glyphs = handle->GetGlyphs();
+	Vector<byte> glyph_data;
+
+	for (Character character : characters)
+	{
+		// The layer may already contain the character if it was generated after the glyph was appended.
+		if (character_boxes.find(character) != character_boxes.end())
+			continue;
+
+		auto it_glyph = glyphs.find(character);
+		if (it_glyph == glyphs.end())
+			continue;
+		const FontGlyph& glyph = it_glyph->second;
+
+		if (clone_layer)
+		{
+			// The cloned layer has already been appended to, and we share its textures.
+			auto it_clone = clone_layer->character_boxes.find(character);
+			if (it_clone == clone_layer->character_boxes.end())
+				continue;
+
+			TextureBox& box = character_boxes[character];
+			box = it_clone->second;
+			AdjustClonedCharacterBox(glyph, box);
+			continue;
+		}
+
+		TextureBox box;
+		Vector2i glyph_dimensions;
+		if (!InitializeCharacterBox(glyph, box, glyph_dimensions))
+			continue;
+
+		const int rectangle_index = texture_layout.InsertRectangle((int)character, glyph_dimensions);
+		if (rectangle_index < 0)
+			return false;
+
+		TextureLayoutRectangle& rectangle = texture_layout.GetRectangle(rectangle_index);
+		SetCharacterTexture(box, rectangle);
+		character_boxes[character] = box;
+
+		if (glyph_dimensions.x <= 0 || glyph_dimensions.y <= 0)
+			continue;
+
+		// Upload only the pixels of the new glyph into its region of the texture.
+		glyph_data.assign(size_t(glyph_dimensions.x * glyph_dimensions.y * 4), 0);
+		WriteGlyphData(glyph, box, glyph_data.data(), glyph_dimensions.x * 4);
+
+		const Rectanglei region = Rectanglei::FromPositionSize(rectangle.GetPosition(), glyph_dimensions);
+		if (!textures_owned[box.texture_index].UpdateTexture(region, glyph_data))
+			return false;
+	}
+
+	return true;
+}
+
 bool FontFaceLayer::GenerateTexture(Vector<byte>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontGlyphMap& glyphs)
 {
-	if (texture_id < 0 || texture_id > texture_layout.GetNumTextures())
+	if (texture_id < 0 || texture_id >= texture_layout.GetNumTextures())
 		return false;
 
 	// Generate the texture data.
-	texture_data = texture_layout.GetTexture(texture_id).AllocateTexture();
+	texture_data = texture_layout.GetTexture(texture_id).AllocateTexture(texture_layout);
 	texture_dimensions = texture_layout.GetTexture(texture_id).GetDimensions();
 
+	// Gather the glyphs placed on this texture up front. All the lookups are done here, so that generating the glyphs below only reads
+	// the glyph and writes to its own rectangle of the texture, independently of any other glyph.
+	struct GlyphJob {
+		const FontGlyph* glyph;
+		const TextureBox* box;
+		byte* destination;
+		int stride;
+	};
+	Vector<GlyphJob> jobs;
+	jobs.reserve(texture_layout.GetNumRectangles());
+
 	for (int i = 0; i < texture_layout.GetNumRectangles(); ++i)
 	{
 		TextureLayoutRectangle& rectangle = texture_layout.GetRectangle(i);
-		Character character = (Character)rectangle.GetId();
-		RMLUI_ASSERT(character_boxes.find(character) != character_boxes.end());
+		if (rectangle.GetTextureIndex() != texture_id)
+			continue;
 
-		TextureBox& box = character_boxes[character];
+		Character character = (Character)rectangle.GetId();
+		auto it_box = character_boxes.find(character);
+		RMLUI_ASSERT(it_box != character_boxes.end());
+		if (it_box == character_boxes.end() || it_box->second.texture_index != texture_id)
+			continue;
 
-		if (box.texture_index != texture_id)
+		auto it_glyph = glyphs.find(character);
+		if (it_glyph == glyphs.end())
 			continue;
 
-		auto it = glyphs.find((Character)rectangle.GetId());
-		if (it == glyphs.end())
+		// Glyphs without a bitmap, such as spaces, leave their rectangle transparent.
+		const FontGlyph& glyph = it_glyph->second;
+		if (!glyph.bitmap_data || glyph.bitmap_dimensions.x <= 0 || glyph.bitmap_dimensions.y <= 0)
 			continue;
 
-		const FontGlyph& glyph = it->second;
+		jobs.push_back(GlyphJob{&glyph, &it_box->second, rectangle.GetTextureData(), rectangle.GetTextureStride()});
+	}
+
+	// Each job writes to its own rectangle and allocates any scratch memory on its own thread, thus the jobs can run concurrently. They are
+	// dispatched in chunks to keep the overhead per glyph small.
+	constexpr int NumGlyphsPerChunk = 32;
+	const int num_chunks = ((int)jobs.size() + NumGlyphsPerChunk - 1) / NumGlyphsPerChunk;
+	auto WriteChunk = [this, &jobs](int chunk) {
+		const size_t end = Math::Min(size_t(chunk + 1) * NumGlyphsPerChunk, jobs.size());
+		for (size_t i = size_t(chunk) * NumGlyphsPerChunk; i < end; i++)
+			WriteGlyphData(*jobs[i].glyph, *jobs[i].box, jobs[i].destination, jobs[i].stride);
+	};
+
+	TaskInterface* task_interface = GetTaskInterface();
+	if (task_interface && num_chunks > 1)
+	{
+		task_interface->ParallelFor(num_chunks, WriteChunk);
+	}
+	else
+	{
+		for (int chunk = 0; chunk < num_chunks; chunk++)
+			WriteChunk(chunk);
+	}
+
+	return true;
+}
+
+void FontFaceLayer::AdjustClonedCharacterBox(const FontGlyph& glyph, TextureBox& box) const
+{
+	if (!effect || keep_clone_glyph_origins)
+		return;
+
+	Vector2i glyph_origin = Vector2i(box.origin);
+	Vector2i glyph_dimensions = Vector2i(box.dimensions);
+
+	if (effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
+		box.origin = Vector2f(glyph_origin);
+	else
+		box.texture_index = -1;
+}
+
+bool FontFaceLayer::InitializeCharacterBox(const FontGlyph& glyph, TextureBox& box, Vector2i& glyph_dimensions) const
+{
+	Vector2i glyph_origin(0, 0);
+	glyph_dimensions = glyph.bitmap_dimensions;
+
+	// Adjust glyph origin / dimensions for the font effect.
+	if (effect)
+	{
+		if (!effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
+			return false;
+	}
+
+	box.origin = Vector2f(float(glyph_origin.x + glyph.bearing.x), float(glyph_origin.y - glyph.bearing.y));
+	box.dimensions = Vector2f(glyph_dimensions);
+
+	RMLUI_ASSERT(box.dimensions.x >= 0 && box.dimensions.y >= 0);
+	return true;
+}
+
+void FontFaceLayer::SetCharacterTexture(TextureBox& box, TextureLayoutRectangle& rectangle)
+{
+	const TextureLayoutTexture& texture = texture_layout.GetTexture(rectangle.GetTextureIndex());
+
+	// Set the character's texture index.
+	box.texture_index = rectangle.GetTextureIndex();
 
-		if (effect == nullptr)
+	// Generate the character's texture coordinates.
+	box.texcoords[0].x = float(rectangle.GetPosition().x) / float(texture.GetDimensions().x);
+	box.texcoords[0].y = float(rectangle.GetPosition().y) / float(texture.GetDimensions().y);
+	box.texcoords[1].x = float(rectangle.GetPosition().x + rectangle.GetDimensions().x) / float(texture.GetDimensions().x);
+	box.texcoords[1].y = float(rectangle.GetPosition().y + rectangle.GetDimensions().y) / float(texture.GetDimensions().y);
+}
+
+void FontFaceLayer::WriteGlyphData(const FontGlyph& glyph, const TextureBox& box, byte* destination, int stride) const
+{
+	if (effect == nullptr)
+	{
+		// Copy the glyph's bitmap data into its allocated texture.
+		if (glyph.bitmap_data)
 		{
-			// Copy the glyph's bitmap data into its allocated texture.
-			if (glyph.bitmap_data)
-			{
-				byte* destination = rectangle.GetTextureData();
-				const byte* source = glyph.bitmap_data;
-				const int num_bytes_per_line = glyph.bitmap_dimensions.x * (glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
+			const byte* source = glyph.bitmap_data;
+			const int num_bytes_per_line = glyph.bitmap_dimensions.x * (glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
 
-				for (int j = 0; j < glyph.bitmap_dimensions.y; ++j)
+			for (int j = 0; j < glyph.bitmap_dimensions.y; ++j)
+			{
+				switch (glyph.color_format)
 				{
-					switch (glyph.color_format)
-					{
-					case ColorFormat::A8:
-					{
-						// We use premultiplied alpha, so copy the alpha into all four channels.
-						for (int k = 0; k < num_bytes_per_line; ++k)
-							for (int c = 0; c < 4; ++c)
-								destination[k * 4 + c] = source[k];
-					}
-					break;
-					case ColorFormat::RGBA8:
-					{
-						memcpy(destination, source, num_bytes_per_line);
-					}
-					break;
-					}
-
-					destination += rectangle.GetTextureStride();
-					source += num_bytes_per_line;
+				case ColorFormat::A8:
+				{
+					// We use premultiplied alpha, so copy the alpha into all four channels.
+					for (int k = 0; k < num_bytes_per_line; ++k)
+						for (int c = 0; c < 4; ++c)
+							destination[k * 4 + c] = source[k];
+				}
+				break;
+				case ColorFormat::RGBA8:
+				{
+					memcpy(destination, source, num_bytes_per_line);
 				}
+				break;
+				}
+
+				destination += stride;
+				source += num_bytes_per_line;
 			}
 		}
-		else
-		{
-			effect->GenerateGlyphTexture(rectangle.GetTextureData(), Vector2i(box.dimensions), rectangle.GetTextureStride(), glyph);
-		}
 	}
-
-	return true;
+	else
+	{
+		effect->GenerateGlyphTexture(destination, Vector2i(box.dimensions), stride, glyph);
+	}
 }
 
 const FontEffect* FontFaceLayer::GetFontEffect() const
@@ -239,6 +357,20 @@ int FontFaceLayer::GetNumTextures() const
 	return (int)textures_ptr->size();
 }
 
+size_t FontFaceLayer::GetTextureBytes() const
+{
+	if (textures_ptr != &textures_owned)
+		return 0;
+
+	size_t num_bytes = 0;
+	for (int i = 0; i < texture_layout.GetNumTextures(); ++i)
+	{
+		const Vector2i dimensions = texture_layout.GetTexture(i).GetDimensions();
+		num_bytes += size_t(dimensions.x) * size_t(dimensions.y) * 4;
+	}
+	return num_bytes;
+}
+
 ColourbPremultiplied FontFaceLayer::GetColour(float opacity) const
 {
 	return colour.ToPremultiplied(opacity);
@@ -28,6 +28,13 @@ public:
 	/// @return True if the layer was generated successfully, false if not.
 	bool Generate(const FontFaceHandleDefault* handle, const FontFaceLayer* clone = nullptr, bool clone_glyph_origins = false);
 
+	/// Adds newly appended glyphs to the existing layout and textures of the layer, without regenerating the glyphs already present.
+	/// @param[in] handle The handle generating this layer.
+	/// @param[in] characters The characters appended to the handle since the layer was generated.
+	/// @return True if all the glyphs were added, false if the layer must be regenerated instead.
+	/// @note Layers cloning another layer must be appended after the layer they clone.
+	bool AppendGlyphs(const FontFaceHandleDefault* handle, Span<const Character> characters);
+
 	/// Generates the texture data for a layer (for the texture database).
 	/// @param[out] texture_data The generated texture data.
 	/// @param[out] texture_dimensions The dimensions of the texture.
@@ -57,6 +64,29 @@ public:
 		MeshUtilities::GenerateQuad(mesh, (position + box.origin).Round(), box.dimensions, colour, box.texcoords[0], box.texcoords[1]);
 	}
 
+	/// Generates the geometry required to render a single character at a different scale than the layer was generated at. The geometry is not
+	/// snapped to the pixel grid, this is intended for layers rendered from distance fields.
+	/// @param[out] mesh_list An array of meshes this layer will write to. It must be at least as big as the number of textures in this layer.
+	/// @param[in] character_code The character to generate geometry for.
+	/// @param[in] position The position of the baseline.
+	/// @param[in] scale The scale of the geometry relative to the size of the layer's glyphs.
+	/// @param[in] colour The colour of the string.
+	inline void GenerateScaledGeometry(TexturedMesh* mesh_list, const Character character_code, const Vector2f position, const float scale,
+		const ColourbPremultiplied colour) const
+	{
+		auto it = character_boxes.find(character_code);
+		if (it == character_boxes.end())
+			return;
+
+		const TextureBox& box = it->second;
+
+		if (box.texture_index < 0)
+			return;
+
+		Mesh& mesh = mesh_list[box.texture_index].mesh;
+		MeshUtilities::GenerateQuad(mesh, position + box.origin * scale, box.dimensions * scale, colour, box.texcoords[0], box.texcoords[1]);
+	}
+
 	/// Returns the effect used to generate the layer.
 	const FontEffect* GetFontEffect() const;
 
@@ -64,6 +94,8 @@ public:
 	Texture GetTexture(RenderManager& render_manager, int index);
 	/// Returns the number of textures employed by this layer.
 	int GetNumTextures() const;
+	/// Returns the size of the texture data generated by this layer, excluding textures shared with a cloned layer.
+	size_t GetTextureBytes() const;
 
 	/// Returns the layer's colour after applying the given opacity.
 	ColourbPremultiplied GetColour(float opacity) const;
@@ -84,11 +116,24 @@ private:
 	using CharacterMap = UnorderedMap<Character, TextureBox>;
 	using TextureList = Vector<CallbackTextureSource>;
 
+	// Adjusts the origin of a box copied from the cloned layer for our effect, unless we keep the cloned origins.
+	void AdjustClonedCharacterBox(const FontGlyph& glyph, TextureBox& box) const;
+	// Initializes the box of a character from its glyph, returns false if the glyph is not rendered by our effect.
+	bool InitializeCharacterBox(const FontGlyph& glyph, TextureBox& box, Vector2i& glyph_dimensions) const;
+	// Sets the texture index and coordinates of a box from its placed rectangle.
+	void SetCharacterTexture(TextureBox& box, TextureLayoutRectangle& rectangle);
+	// Writes the pixels of a glyph into the given texture data.
+	void WriteGlyphData(const FontGlyph& glyph, const TextureBox& box, byte* destination, int stride) const;
+
 	SharedPtr<const FontEffect> effect;
 
 	TextureList textures_owned;
 	TextureList* textures_ptr = &textures_owned;
 
+	// The layer we cloned our geometry and textures from, if any.
+	const FontFaceLayer* clone_layer = nullptr;
+	bool keep_clone_glyph_origins = false;
+
 	TextureLayout texture_layout;
 	CharacterMap character_boxes;
 	Colourb colour;
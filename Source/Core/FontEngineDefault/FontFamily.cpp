@@ -74,9 +74,10 @@ FontFaceHandleDefault* FontFamily::GetFaceHandle(Style::FontStyle style, Style::
 	return matching_face->GetHandle(size, true, weight_delta);
 }
 
-FontFace* FontFamily::AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle style, Style::FontWeight weight, UniquePtr<byte[]> face_memory)
+FontFace* FontFamily::AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle style, Style::FontWeight weight, const FontFaceSource& source,
+	UniquePtr<FileMapping> face_memory)
 {
-	auto face = MakeUnique<FontFace>(ft_face, style, weight);
+	auto face = MakeUnique<FontFace>(ft_face, style, weight, source);
 	FontFace* result = face.get();
 
 	font_faces.push_back(FontFaceEntry{std::move(face), std::move(face_memory)});
@@ -90,4 +91,16 @@ void FontFamily::ReleaseFontResources()
 		entry.face->ReleaseFontResources();
 }
 
+void FontFamily::GetFaces(Vector<FontFace*>& out_faces) const
+{
+	for (const auto& entry : font_faces)
+		out_faces.push_back(entry.face.get());
+}
+
+void FontFamily::SaveToCache(FontCache& cache)
+{
+	for (auto& entry : font_faces)
+		entry.face->SaveToCache(cache);
+}
+
 } // namespace Rml
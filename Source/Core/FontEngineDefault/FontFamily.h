@@ -1,11 +1,14 @@
 #pragma once
 
+#include "../FileMapping.h"
 #include "FontTypes.h"
 
 namespace Rml {
 
+class FontCache;
 class FontFace;
 class FontFaceHandleDefault;
+struct FontFaceSource;
 
 class FontFamily {
 public:
@@ -23,20 +26,28 @@ public:
 	/// @param[in] ft_face The previously loaded FreeType face.
 	/// @param[in] style The style of the new face.
 	/// @param[in] weight The weight of the new face.
+	/// @param[in] source The font data and indices the face was loaded from.
 	/// @param[in] face_memory Optionally pass ownership of the face's memory to the face itself, automatically releasing it on destruction.
 	/// @return True if the face was loaded successfully, false otherwise.
-	FontFace* AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle style, Style::FontWeight weight, UniquePtr<byte[]> face_memory);
+	FontFace* AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle style, Style::FontWeight weight, const FontFaceSource& source,
+		UniquePtr<FileMapping> face_memory);
 
 	/// Releases resources owned by sized font faces, including their textures and rendered glyphs.
 	void ReleaseFontResources();
 
+	/// Adds the glyphs and metrics of all sized handles in the family to the font cache.
+	void SaveToCache(FontCache& cache);
+
+	/// Returns all faces in the family.
+	void GetFaces(Vector<FontFace*>& out_faces) const;
+
 protected:
 	String name;
 
 	struct FontFaceEntry {
 		UniquePtr<FontFace> face;
 		// Only filled if we own the memory used by the face's FreeType handle. May be shared with other faces in this family.
-		UniquePtr<byte[]> face_memory;
+		UniquePtr<FileMapping> face_memory;
 	};
 
 	using FontFaceList = Vector<FontFaceEntry>;
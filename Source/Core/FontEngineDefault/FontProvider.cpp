@@ -1,11 +1,11 @@
 #include "FontProvider.h"
 #include "../../../Include/RmlUi/Core/Core.h"
-#include "../../../Include/RmlUi/Core/FileInterface.h"
 #include "../../../Include/RmlUi/Core/Log.h"
 #include "../../../Include/RmlUi/Core/Math.h"
 #include "../../../Include/RmlUi/Core/StringUtilities.h"
 #include "../ComputeProperty.h"
 #include "FontFace.h"
+#include "FontFaceHandleDefault.h"
 #include "FontFamily.h"
 #include "FreeTypeInterface.h"
 #include <algorithm>
@@ -74,6 +74,9 @@ FontFaceHandleDefault* FontProvider::GetFontFaceHandle(const String& family, Sty
 	if (!handle && !families.empty())
 		handle = families.begin()->second->GetFaceHandle(style, weight, size);
 
+	if (handle)
+		handle->SetLastUsed(++provider.handle_use_counter);
+
 	return handle;
 }
 
@@ -87,7 +90,12 @@ FontFaceHandleDefault* FontProvider::GetFallbackFontFace(int index, int font_siz
 	auto& faces = FontProvider::Get().fallback_font_faces;
 
 	if (index >= 0 && index < (int)faces.size())
+	{
+		// Distance field handles must use glyphs of the same kind from the fallback faces.
+		if (Get().distance_field_mode)
+			return faces[index]->GetDistanceFieldHandle(0);
 		return faces[index]->GetHandle(font_size, false, 0);
+	}
 
 	return nullptr;
 }
@@ -99,25 +107,140 @@ void FontProvider::ReleaseFontResources()
 		name_family.second->ReleaseFontResources();
 }
 
-bool FontProvider::LoadFontFace(const String& file_name, int face_index, bool fallback_face, Style::FontWeight weight)
+bool FontProvider::SetDistanceFieldMode(bool enable)
 {
-	FileInterface* file_interface = GetFileInterface();
-	FileHandle handle = file_interface->Open(file_name);
-
-	if (!handle)
+	if (enable && !FreeType::SupportsDistanceField())
 	{
-		Log::Message(Log::LT_ERROR, "Failed to load font face from %s, could not open file.", file_name.c_str());
+		Log::Message(Log::LT_WARNING, "Font distance fields require FreeType 2.11 or newer.");
 		return false;
 	}
 
-	size_t length = file_interface->Length(handle);
+	FontProvider& provider = Get();
+	if (provider.distance_field_mode != enable)
+	{
+		ReleaseFontResources();
+		provider.distance_field_mode = enable;
+	}
 
-	auto buffer_ptr = UniquePtr<byte[]>(new byte[length]);
-	byte* buffer = buffer_ptr.get();
-	file_interface->Read(buffer, length, handle);
-	file_interface->Close(handle);
+	return true;
+}
+
+bool FontProvider::IsDistanceFieldMode()
+{
+	return Get().distance_field_mode;
+}
+
+void FontProvider::ReleaseUnusedFontResources(const UnorderedSet<FontFaceHandle>& used_handles, size_t budget_bytes)
+{
+	FontProvider& provider = Get();
 
-	bool result = Get().LoadFontFace({buffer, length}, face_index, fallback_face, std::move(buffer_ptr), file_name, {}, Style::FontStyle::Normal, weight);
+	struct Candidate {
+		FontFace* face;
+		FontFaceHandleDefault* handle;
+		size_t num_bytes;
+	};
+	Vector<Candidate> candidates;
+	size_t total_bytes = 0;
+
+	Vector<FontFace*> faces;
+	Vector<FontFaceHandleDefault*> handles;
+	for (auto& name_family : provider.font_families)
+		name_family.second->GetFaces(faces);
+
+	for (FontFace* face : faces)
+	{
+		const bool is_fallback_face =
+			(std::find(provider.fallback_font_faces.begin(), provider.fallback_font_faces.end(), face) != provider.fallback_font_faces.end());
+
+		handles.clear();
+		face->GetHandles(handles);
+		for (FontFaceHandleDefault* handle : handles)
+		{
+			const size_t num_bytes = handle->GetTextureBytes() + handle->GetGlyphBytes();
+			total_bytes += num_bytes;
+
+			if (!is_fallback_face && used_handles.count(reinterpret_cast<FontFaceHandle>(handle)) == 0)
+				candidates.push_back(Candidate{face, handle, num_bytes});
+		}
+	}
+
+	if (total_bytes <= budget_bytes)
+		return;
+
+	std::sort(candidates.begin(), candidates.end(),
+		[](const Candidate& a, const Candidate& b) { return a.handle->GetLastUsed() < b.handle->GetLastUsed(); });
+
+	for (const Candidate& candidate : candidates)
+	{
+		if (total_bytes <= budget_bytes)
+			break;
+
+		total_bytes -= candidate.num_bytes;
+		candidate.face->ReleaseHandle(candidate.handle);
+	}
+}
+
+FontResourceStats FontProvider::GetFontResourceStats()
+{
+	FontResourceStats stats;
+
+	Vector<FontFace*> faces;
+	Vector<FontFaceHandleDefault*> handles;
+	for (auto& name_family : Get().font_families)
+		name_family.second->GetFaces(faces);
+
+	for (FontFace* face : faces)
+	{
+		face->GetHandles(handles);
+		face->GetDistanceFieldHandles(handles);
+	}
+
+	for (FontFaceHandleDefault* handle : handles)
+	{
+		stats.num_face_handles += 1;
+		stats.texture_bytes += handle->GetTextureBytes();
+		stats.glyph_bytes += handle->GetGlyphBytes();
+	}
+
+	return stats;
+}
+
+bool FontProvider::SaveFontCache(Vector<byte>& out_data)
+{
+	FontCache cache;
+	for (auto& name_family : Get().font_families)
+		name_family.second->SaveToCache(cache);
+
+	cache.Save(out_data);
+	return true;
+}
+
+bool FontProvider::LoadFontCache(Span<const byte> data)
+{
+	return Get().font_cache.Load(data);
+}
+
+const FontCacheEntry* FontProvider::FindCacheEntry(FontFace& face, int size, int synthetic_weight_delta)
+{
+	const FontCache& cache = Get().font_cache;
+	if (cache.IsEmpty())
+		return nullptr;
+
+	return cache.Find(face.GetCacheKey(), size, synthetic_weight_delta);
+}
+
+bool FontProvider::LoadFontFace(const String& file_name, int face_index, bool fallback_face, Style::FontWeight weight)
+{
+	// Keep the file mapped into memory where supported, so that its contents are not copied to the heap for the lifetime of the face.
+	auto file = MakeUnique<FileMapping>();
+	if (!file->Load(file_name))
+	{
+		Log::Message(Log::LT_ERROR, "Failed to load font face from %s, could not open file.", file_name.c_str());
+		return false;
+	}
+
+	const Span<const byte> data = file->GetData();
+	bool result = Get().LoadFontFace(data, face_index, fallback_face, std::move(file), file_name, {}, Style::FontStyle::Normal, weight);
 
 	return result;
 }
@@ -132,8 +255,8 @@ bool FontProvider::LoadFontFace(Span<const byte> data, int face_index, const Str
 	return result;
 }
 
-bool FontProvider::LoadFontFace(Span<const byte> data, int face_index, bool fallback_face, UniquePtr<byte[]> face_memory, const String& source, String font_family,
-	Style::FontStyle style, Style::FontWeight weight)
+bool FontProvider::LoadFontFace(Span<const byte> data, int face_index, bool fallback_face, UniquePtr<FileMapping> face_memory, const String& source,
+	String font_family, Style::FontStyle style, Style::FontWeight weight)
 {
 	using Style::FontWeight;
 
@@ -192,11 +315,17 @@ bool FontProvider::LoadFontFace(Span<const byte> data, int face_index, bool fall
 		return false;
 	}
 
+	FontFaceHandleFreetype first_ft_face = 0;
 	for (const FaceVariation& variation : load_variations)
 	{
-		FontFaceHandleFreetype ft_face = FreeType::LoadFace(data, source, face_index, variation.named_instance_index);
+		// The variations of a variable font face share the FreeType face of the first one where possible.
+		FontFaceHandleFreetype ft_face = (first_ft_face ? FreeType::LoadFaceInstance(first_ft_face, variation.named_instance_index) : 0);
+		if (!ft_face)
+			ft_face = FreeType::LoadFace(data, source, face_index, variation.named_instance_index);
 		if (!ft_face)
 			return false;
+		if (!first_ft_face)
+			first_ft_face = ft_face;
 
 		if (font_family.empty())
 			FreeType::GetFaceStyle(ft_face, &font_family, &style, nullptr);
@@ -206,7 +335,8 @@ bool FontProvider::LoadFontFace(Span<const byte> data, int face_index, bool fall
 		const FontWeight variation_weight = (variation.weight == FontWeight::Auto ? weight : variation.weight);
 		const String font_face_description = GetFontFaceDescription(font_family, style, variation_weight);
 
-		if (!AddFace(ft_face, font_family, style, variation_weight, fallback_face, std::move(face_memory)))
+		const FontFaceSource face_source = {data, face_index, variation.named_instance_index};
+		if (!AddFace(ft_face, font_family, style, variation_weight, fallback_face, face_source, std::move(face_memory)))
 		{
 			Log::Message(Log::LT_ERROR, "Failed to load font face %s from '%s'.", font_face_description.c_str(), source.c_str());
 			return false;
@@ -219,7 +349,7 @@ bool FontProvider::LoadFontFace(Span<const byte> data, int face_index, bool fall
 }
 
 bool FontProvider::AddFace(FontFaceHandleFreetype face, const String& family, Style::FontStyle style, Style::FontWeight weight, bool fallback_face,
-	UniquePtr<byte[]> face_memory)
+	const FontFaceSource& source, UniquePtr<FileMapping> face_memory)
 {
 	if (family.empty() || weight == Style::FontWeight::Auto)
 		return false;
@@ -238,7 +368,7 @@ bool FontProvider::AddFace(FontFaceHandleFreetype face, const String& family, St
 		font_families[family_lower] = std::move(font_family_ptr);
 	}
 
-	FontFace* font_face_result = font_family->AddFace(face, style, weight, std::move(face_memory));
+	FontFace* font_face_result = font_family->AddFace(face, style, weight, source, std::move(face_memory));
 
 	// Store the first loaded font family as a last-resort fallback.
 	if (font_face_result && first_loaded_font_family.empty())
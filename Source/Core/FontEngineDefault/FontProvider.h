@@ -1,7 +1,10 @@
 #pragma once
 
+#include "../../../Include/RmlUi/Core/FontEngineInterface.h"
 #include "../../../Include/RmlUi/Core/StyleTypes.h"
 #include "../../../Include/RmlUi/Core/Types.h"
+#include "../FileMapping.h"
+#include "FontCache.h"
 #include "FontTypes.h"
 
 namespace Rml {
@@ -47,17 +50,36 @@ public:
 	/// Releases resources owned by sized font faces, including their textures and rendered glyphs.
 	static void ReleaseFontResources();
 
+	/// Enables or disables rendering text from distance fields, releasing the resources of all sized font faces.
+	/// @return False if distance fields are not supported by the FreeType library, true otherwise.
+	static bool SetDistanceFieldMode(bool enable);
+	/// Returns true if new sized font faces render their text from distance fields.
+	static bool IsDistanceFieldMode();
+
+	/// Releases font face handles not in use, least recently requested first, until the font resources fit within the budget.
+	/// @note Handles of fallback faces are never released, as the glyphs of other handles may refer to them.
+	static void ReleaseUnusedFontResources(const UnorderedSet<FontFaceHandle>& used_handles, size_t budget_bytes);
+	/// Returns the number of sized font faces and the size of their textures and glyphs.
+	static FontResourceStats GetFontResourceStats();
+
+	/// Serializes the glyphs and metrics of all sized font faces currently in use.
+	static bool SaveFontCache(Vector<byte>& out_data);
+	/// Replaces the font cache by previously saved data, used when initializing new sized font faces.
+	static bool LoadFontCache(Span<const byte> data);
+	/// Returns the cached glyphs and metrics for the given face at the given size, or nullptr if not cached.
+	static const FontCacheEntry* FindCacheEntry(FontFace& face, int size, int synthetic_weight_delta);
+
 private:
 	FontProvider();
 	~FontProvider();
 
 	static FontProvider& Get();
 
-	bool LoadFontFace(Span<const byte> data, int face_index, bool fallback_face, UniquePtr<byte[]> face_memory, const String& source,
+	bool LoadFontFace(Span<const byte> data, int face_index, bool fallback_face, UniquePtr<FileMapping> face_memory, const String& source,
 		String font_family, Style::FontStyle style, Style::FontWeight weight);
 
 	bool AddFace(FontFaceHandleFreetype face, const String& family, Style::FontStyle style, Style::FontWeight weight, bool fallback_face,
-		UniquePtr<byte[]> face_memory);
+		const FontFaceSource& source, UniquePtr<FileMapping> face_memory);
 
 	using FontFaceList = Vector<FontFace*>;
 	using FontFamilyMap = UnorderedMap<String, UniquePtr<FontFamily>>;
@@ -69,6 +91,15 @@ private:
 	// text can render even when an element requests an invalid/missing font-family.
 	String first_loaded_font_family;
 
+	// Incremented whenever a handle is requested, to order handles by their last use.
+	uint64_t handle_use_counter = 0;
+
+	// Sized font face data loaded from a previous run.
+	FontCache font_cache;
+
+	// When enabled, all sizes of a font face render from the glyphs of a single distance field handle.
+	bool distance_field_mode = false;
+
 	static const String debugger_font_family_name;
 };
 
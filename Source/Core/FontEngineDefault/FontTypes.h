@@ -8,6 +8,12 @@ namespace Rml {
 
 using FontFaceHandleFreetype = uintptr_t;
 
+// In distance field mode, the glyphs of each font face are rasterized once at this size and scaled to all other font sizes.
+constexpr int DistanceFieldBaseSize = 48;
+// The distance, in pixels at the base size, covered by the distance field on either side of the glyph outlines. This limits the width of
+// outlines and other effects rendered from the distance field.
+constexpr int DistanceFieldSpread = 16;
+
 struct FaceVariation {
 	Style::FontWeight weight;
 	uint16_t width;
@@ -10,14 +10,33 @@
 #include FT_MULTIPLE_MASTERS_H
 #include FT_TRUETYPE_TABLES_H
 #include FT_SYNTHESIS_H
+#include FT_MODULE_H
+
+#if FREETYPE_MAJOR > 2 || (FREETYPE_MAJOR == 2 && FREETYPE_MINOR >= 11)
+	#define RMLUI_FREETYPE_DISTANCE_FIELD
+#endif
 
 namespace Rml {
 
 static FT_Library ft_library = nullptr;
 
-static bool BuildGlyph(FT_Face ft_face, Character character, FontGlyphMap& glyphs, float bitmap_scaling_factor, int synthetic_weight_delta);
+// A FreeType face, shared by all loaded named instances of a variable font face. The face is switched to the instance of each handle as it is
+// used, which only changes its design coordinates, instead of loading and parsing the font face for each instance.
+struct SharedFace {
+	FT_Face face;
+	int num_instances;
+	int active_instance_index;
+};
+// The object behind each FontFaceHandleFreetype.
+struct FaceInstance {
+	SharedFace* shared_face;
+	int named_instance_index;
+};
+
+static bool BuildGlyph(FT_Face ft_face, Character character, FontGlyphMap& glyphs, float bitmap_scaling_factor, int synthetic_weight_delta,
+	bool distance_field);
 static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, float bitmap_scaling_factor, bool load_default_glyphs,
-	int synthetic_weight_delta);
+	int synthetic_weight_delta, bool distance_field);
 static void GenerateMetrics(FT_Face ft_face, FontMetrics& metrics, float bitmap_scaling_factor);
 static bool SetFontSize(FT_Face ft_face, int font_size, float& out_bitmap_scaling_factor);
 static void BitmapDownscale(byte* bitmap_new, int new_width, int new_height, const byte* bitmap_source, int width, int height, int pitch,
@@ -28,6 +47,31 @@ static int ConvertFixed16_16ToInt(int32_t fx)
 	return fx / 0x10000;
 }
 
+static FontFaceHandleFreetype MakeFaceInstance(SharedFace* shared_face, int named_instance_index)
+{
+	shared_face->num_instances += 1;
+	return (FontFaceHandleFreetype) new FaceInstance{shared_face, named_instance_index};
+}
+
+// Returns the FreeType face of the handle, switched to the named instance of the handle.
+static FT_Face GetFace(FontFaceHandleFreetype handle)
+{
+	FaceInstance* instance = (FaceInstance*)handle;
+	SharedFace* shared_face = instance->shared_face;
+
+#if FREETYPE_MAJOR >= 2 && FREETYPE_MINOR >= 9
+	if (shared_face->active_instance_index != instance->named_instance_index)
+	{
+		FT_Set_Named_Instance(shared_face->face, (FT_UInt)instance->named_instance_index);
+		shared_face->active_instance_index = instance->named_instance_index;
+	}
+#else
+	RMLUI_ASSERT(shared_face->active_instance_index == instance->named_instance_index);
+#endif
+
+	return shared_face->face;
+}
+
 bool FreeType::Initialise()
 {
 	RMLUI_ASSERT(!ft_library);
@@ -40,6 +84,13 @@ bool FreeType::Initialise()
 		return false;
 	}
 
+#ifdef RMLUI_FREETYPE_DISTANCE_FIELD
+	// Set the spread of both the outline and the bitmap distance field renderers.
+	FT_Int spread = DistanceFieldSpread;
+	FT_Property_Set(ft_library, "sdf", "spread", &spread);
+	FT_Property_Set(ft_library, "bsdf", "spread", &spread);
+#endif
+
 	return true;
 }
 
@@ -133,20 +184,43 @@ FontFaceHandleFreetype FreeType::LoadFace(Span<const byte> data, const String& s
 		}
 	}
 
-	return (FontFaceHandleFreetype)face;
+	return MakeFaceInstance(new SharedFace{face, 0, named_style_index}, named_style_index);
+}
+
+FontFaceHandleFreetype FreeType::LoadFaceInstance(FontFaceHandleFreetype face, int named_instance_index)
+{
+#if FREETYPE_MAJOR >= 2 && FREETYPE_MINOR >= 9
+	SharedFace* shared_face = ((FaceInstance*)face)->shared_face;
+	if (!FT_HAS_MULTIPLE_MASTERS(shared_face->face))
+		return 0;
+
+	return MakeFaceInstance(shared_face, named_instance_index);
+#else
+	(void)face;
+	(void)named_instance_index;
+	return 0;
+#endif
 }
 
 bool FreeType::ReleaseFace(FontFaceHandleFreetype in_face)
 {
-	FT_Face face = (FT_Face)in_face;
-	FT_Error error = FT_Done_Face(face);
+	FaceInstance* instance = (FaceInstance*)in_face;
+	SharedFace* shared_face = instance->shared_face;
+	delete instance;
+
+	shared_face->num_instances -= 1;
+	if (shared_face->num_instances > 0)
+		return true;
+
+	FT_Error error = FT_Done_Face(shared_face->face);
+	delete shared_face;
 
 	return (error == 0);
 }
 
 void FreeType::GetFaceStyle(FontFaceHandleFreetype in_face, String* font_family, Style::FontStyle* style, Style::FontWeight* weight)
 {
-	FT_Face face = (FT_Face)in_face;
+	FT_Face face = GetFace(in_face);
 
 	if (font_family)
 		*font_family = face->family_name;
@@ -164,9 +238,9 @@ void FreeType::GetFaceStyle(FontFaceHandleFreetype in_face, String* font_family,
 }
 
 bool FreeType::InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size, FontGlyphMap& glyphs, FontMetrics& metrics, bool load_default_glyphs,
-	int synthetic_weight_delta)
+	int synthetic_weight_delta, bool distance_field)
 {
-	FT_Face ft_face = (FT_Face)face;
+	FT_Face ft_face = GetFace(face);
 
 	metrics.size = font_size;
 
@@ -175,7 +249,7 @@ bool FreeType::InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size,
 		return false;
 
 	// Construct the initial list of glyphs.
-	BuildGlyphMap(ft_face, font_size, glyphs, bitmap_scaling_factor, load_default_glyphs, synthetic_weight_delta);
+	BuildGlyphMap(ft_face, font_size, glyphs, bitmap_scaling_factor, load_default_glyphs, synthetic_weight_delta, distance_field);
 
 	// Generate the metrics for the handle.
 	GenerateMetrics(ft_face, metrics, bitmap_scaling_factor);
@@ -183,9 +257,10 @@ bool FreeType::InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size,
 	return true;
 }
 
-bool FreeType::AppendGlyph(FontFaceHandleFreetype face, int font_size, Character character, FontGlyphMap& glyphs, int synthetic_weight_delta)
+bool FreeType::AppendGlyph(FontFaceHandleFreetype face, int font_size, Character character, FontGlyphMap& glyphs, int synthetic_weight_delta,
+	bool distance_field)
 {
-	FT_Face ft_face = (FT_Face)face;
+	FT_Face ft_face = GetFace(face);
 
 	RMLUI_ASSERT(glyphs.find(character) == glyphs.end());
 	RMLUI_ASSERT(ft_face);
@@ -195,15 +270,24 @@ bool FreeType::AppendGlyph(FontFaceHandleFreetype face, int font_size, Character
 	if (!SetFontSize(ft_face, font_size, bitmap_scaling_factor))
 		return false;
 
-	if (!BuildGlyph(ft_face, character, glyphs, bitmap_scaling_factor, synthetic_weight_delta))
+	if (!BuildGlyph(ft_face, character, glyphs, bitmap_scaling_factor, synthetic_weight_delta, distance_field))
 		return false;
 
 	return true;
 }
 
+bool FreeType::SupportsDistanceField()
+{
+#ifdef RMLUI_FREETYPE_DISTANCE_FIELD
+	return true;
+#else
+	return false;
+#endif
+}
+
 int FreeType::GetKerning(FontFaceHandleFreetype face, int font_size, Character lhs, Character rhs)
 {
-	FT_Face ft_face = (FT_Face)face;
+	FT_Face ft_face = GetFace(face);
 
 	RMLUI_ASSERT(FT_HAS_KERNING(ft_face));
 
@@ -230,13 +314,13 @@ int FreeType::GetKerning(FontFaceHandleFreetype face, int font_size, Character l
 
 bool FreeType::HasKerning(FontFaceHandleFreetype face)
 {
-	FT_Face ft_face = (FT_Face)face;
+	FT_Face ft_face = GetFace(face);
 
 	return FT_HAS_KERNING(ft_face);
 }
 
 static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, const float bitmap_scaling_factor, const bool load_default_glyphs,
-	int synthetic_weight_delta)
+	int synthetic_weight_delta, bool distance_field)
 {
 	if (load_default_glyphs)
 	{
@@ -247,7 +331,7 @@ static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, const
 		FT_ULong code_max = 126;
 
 		for (FT_ULong character_code = code_min; character_code <= code_max; ++character_code)
-			BuildGlyph(ft_face, (Character)character_code, glyphs, bitmap_scaling_factor, synthetic_weight_delta);
+			BuildGlyph(ft_face, (Character)character_code, glyphs, bitmap_scaling_factor, synthetic_weight_delta, distance_field);
 	}
 
 	// Add a replacement character for rendering unknown characters.
@@ -256,9 +340,11 @@ static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, const
 	if (it == glyphs.end())
 	{
 		FontGlyph glyph;
-		glyph.bitmap_dimensions = {size / 3, (size * 2) / 3};
-		glyph.advance = glyph.bitmap_dimensions.x + 2;
-		glyph.bearing = {1, glyph.bitmap_dimensions.y};
+		const Vector2i box_dimensions = {size / 3, (size * 2) / 3};
+		const int padding = (distance_field ? DistanceFieldSpread : 0);
+		glyph.bitmap_dimensions = box_dimensions + Vector2i(2 * padding);
+		glyph.advance = box_dimensions.x + 2;
+		glyph.bearing = {1 - padding, box_dimensions.y + padding};
 
 		glyph.bitmap_owned_data.reset(new byte[glyph.bitmap_dimensions.x * glyph.bitmap_dimensions.y]);
 		glyph.bitmap_data = glyph.bitmap_owned_data.get();
@@ -267,10 +353,23 @@ static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, const
 		{
 			for (int x = 0; x < glyph.bitmap_dimensions.x; x++)
 			{
-				constexpr int stroke = 1;
 				int i = y * glyph.bitmap_dimensions.x + x;
-				bool near_edge = (x < stroke || x >= glyph.bitmap_dimensions.x - stroke || y < stroke || y >= glyph.bitmap_dimensions.y - stroke);
-				glyph.bitmap_owned_data[i] = (near_edge ? 0xdd : 0);
+				if (!distance_field)
+				{
+					constexpr int stroke = 1;
+					bool near_edge = (x < stroke || x >= glyph.bitmap_dimensions.x - stroke || y < stroke || y >= glyph.bitmap_dimensions.y - stroke);
+					glyph.bitmap_owned_data[i] = (near_edge ? 0xdd : 0);
+					continue;
+				}
+
+				// Signed distance to the stroke along the inside of the box edges, positive inside the stroke, see FT_RENDER_MODE_SDF.
+				const float stroke = float(Math::Max(size / 24, 1));
+				const Vector2f half_size = 0.5f * Vector2f(box_dimensions);
+				const Vector2f p = Vector2f(float(x - padding) + 0.5f, float(y - padding) + 0.5f) - half_size;
+				const Vector2f q = Vector2f(Math::Absolute(p.x), Math::Absolute(p.y)) - half_size;
+				const float box_distance = Vector2f(Math::Max(q.x, 0.f), Math::Max(q.y, 0.f)).Magnitude() + Math::Min(Math::Max(q.x, q.y), 0.f);
+				const float distance = 0.5f * stroke - Math::Absolute(box_distance + 0.5f * stroke);
+				glyph.bitmap_owned_data[i] = byte(Math::Clamp(128.f + distance * 128.f / float(DistanceFieldSpread), 0.f, 255.f));
 			}
 		}
 
@@ -279,13 +378,14 @@ static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, const
 }
 
 static bool BuildGlyph(FT_Face ft_face, const Character character, FontGlyphMap& glyphs, const float bitmap_scaling_factor,
-	const int synthetic_weight_delta)
+	const int synthetic_weight_delta, const bool distance_field)
 {
 	FT_UInt index = FT_Get_Char_Index(ft_face, (FT_ULong)character);
 	if (index == 0)
 		return false;
 
-	FT_Error error = FT_Load_Glyph(ft_face, index, FT_LOAD_COLOR);
+	// Color glyphs can't be represented by a distance field, load their monochrome outlines instead.
+	FT_Error error = FT_Load_Glyph(ft_face, index, distance_field ? FT_LOAD_DEFAULT : FT_LOAD_COLOR);
 	if (error != 0)
 	{
 		Log::Message(Log::LT_WARNING, "Unable to load glyph for character '%u' on the font face '%s %s'; error code: %d.", (unsigned int)character,
@@ -311,7 +411,17 @@ static bool BuildGlyph(FT_Face ft_face, const Character character, FontGlyphMap&
 			FT_GlyphSlot_AdjustWeight(ft_face->glyph, delta_fixed, delta_fixed);
 	}
 
-	error = FT_Render_Glyph(ft_face->glyph, FT_RENDER_MODE_NORMAL);
+	FT_Render_Mode render_mode = FT_RENDER_MODE_NORMAL;
+#ifdef RMLUI_FREETYPE_DISTANCE_FIELD
+	// The distance field includes the spread on each side of the outline, which is reflected in the bitmap dimensions and bearing. Empty
+	// outlines, such as for whitespace, are rendered normally.
+	if (distance_field && (ft_face->glyph->format != FT_GLYPH_FORMAT_OUTLINE || ft_face->glyph->outline.n_contours > 0))
+		render_mode = FT_RENDER_MODE_SDF;
+#else
+	(void)distance_field;
+#endif
+
+	error = FT_Render_Glyph(ft_face->glyph, render_mode);
 	if (error != 0)
 	{
 		Log::Message(Log::LT_WARNING, "Unable to render glyph for character '%u' on the font face '%s %s'; error code: %d.", (unsigned int)character,
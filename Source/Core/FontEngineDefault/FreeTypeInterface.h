@@ -18,7 +18,11 @@ namespace FreeType {
 	// Loads a FreeType face from memory, 'source' is only used for logging.
 	FontFaceHandleFreetype LoadFace(Span<const byte> data, const String& source, int face_index, int named_instance_index = 0);
 
-	// Releases the FreeType face.
+	// Loads another named instance of a variable font face, sharing the FreeType face of the given face. Returns zero if the face is not a
+	// variable font, or if instances can't be switched with the linked FreeType version, then the instance must be loaded as a separate face.
+	FontFaceHandleFreetype LoadFaceInstance(FontFaceHandleFreetype face, int named_instance_index);
+
+	// Releases the face, the FreeType face is released once all instances sharing it are released.
 	bool ReleaseFace(FontFaceHandleFreetype face);
 
 	// Retrieves the font family, style and weight of the given font face. Use nullptr to ignore a property.
@@ -26,12 +30,17 @@ namespace FreeType {
 
 	// Initializes a face for a given font size. Glyphs are filled with the ASCII subset, and the font face metrics are set.
 	// If synthetic_weight_delta is positive, glyphs will be synthetically emboldened to better match the requested weight.
+	// If distance_field is set, glyph bitmaps contain signed distance fields instead of coverage, see DistanceFieldSpread.
 	bool InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size, FontGlyphMap& glyphs, FontMetrics& metrics, bool load_default_glyphs,
-		int synthetic_weight_delta);
+		int synthetic_weight_delta, bool distance_field = false);
 
 	// Build a new glyph representing the given code point and append to 'glyphs'.
 	// If synthetic_weight_delta is positive, glyphs will be synthetically emboldened to better match the requested weight.
-	bool AppendGlyph(FontFaceHandleFreetype face, int font_size, Character character, FontGlyphMap& glyphs, int synthetic_weight_delta);
+	bool AppendGlyph(FontFaceHandleFreetype face, int font_size, Character character, FontGlyphMap& glyphs, int synthetic_weight_delta,
+		bool distance_field = false);
+
+	// Returns true if the linked FreeType version can render glyphs as signed distance fields.
+	bool SupportsDistanceField();
 
 	// Returns the kerning between two characters.
 	// 'font_size' value of zero assumes the font size is already set on the face, and skips this step for performance reasons.
@@ -45,6 +45,17 @@ int FontEngineInterface::GetStringWidth(FontFaceHandle /*handle*/, StringView /*
 	return 0;
 }
 
+void FontEngineInterface::GetStringPrefixWidths(FontFaceHandle handle, StringView string, const TextShapingContext& text_shaping_context,
+	Character prior_character, Vector<int>& out_prefix_widths)
+{
+	out_prefix_widths.clear();
+	for (auto it_string = StringIteratorU8(string); it_string; ++it_string)
+	{
+		const StringView prefix(string.begin(), StringUtilities::SeekForwardUTF8(it_string.get() + 1, string.end()));
+		out_prefix_widths.push_back(GetStringWidth(handle, prefix, text_shaping_context, prior_character));
+	}
+}
+
 int FontEngineInterface::GenerateString(RenderManager& /*render_manager*/, FontFaceHandle /*face_handle*/, FontEffectsHandle /*font_effects_handle*/,
 	StringView /*string*/, Vector2f /*position*/, ColourbPremultiplied /*colour*/, float /*opacity*/,
 	const TextShapingContext& /*text_shaping_context*/, TexturedMeshList& /*mesh_list*/)
@@ -59,4 +70,26 @@ int FontEngineInterface::GetVersion(FontFaceHandle /*handle*/)
 
 void FontEngineInterface::ReleaseFontResources() {}
 
+void FontEngineInterface::ReleaseUnusedFontResources(const UnorderedSet<FontFaceHandle>& /*used_handles*/, size_t /*budget_bytes*/) {}
+
+FontResourceStats FontEngineInterface::GetFontResourceStats()
+{
+	return {};
+}
+
+bool FontEngineInterface::SetDistanceFieldMode(bool /*enable*/)
+{
+	return false;
+}
+
+bool FontEngineInterface::SaveFontCache(Vector<byte>& /*out_data*/)
+{
+	return false;
+}
+
+bool FontEngineInterface::LoadFontCache(Span<const byte> /*data*/)
+{
+	return false;
+}
+
 } // namespace Rml
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Context.h"
+#include "../../Include/RmlUi/Core/ElementDocument.h"
+#include "../../Include/RmlUi/Core/FrameStatistics.h"
+
+namespace Rml {
+
+class FrameStatisticsAccess {
+public:
+	// Returns the frame counters of the document owning the element, or nullptr if the element is not part of any document.
+	static DocumentFrameStatistics* Get(Element* element)
+	{
+		ElementDocument* document = element->GetOwnerDocument();
+		return document ? &document->frame_statistics : nullptr;
+	}
+
+	// Returns the invalidation counters of the element during the current frame, or nullptr if its context is not tracking invalidations.
+	static ElementInvalidations* GetInvalidations(const Element* element)
+	{
+		ElementDocument* document = element->GetOwnerDocument();
+		Context* context = (document ? document->GetContext() : nullptr);
+		if (!context || !context->element_invalidation_tracking)
+			return nullptr;
+		return &context->element_invalidations[element];
+	}
+};
+
+} // namespace Rml
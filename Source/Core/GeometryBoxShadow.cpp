@@ -12,14 +12,10 @@
 namespace Rml {
 
 BoxShadowGeometryInfo GeometryBoxShadow::Resolve(Element* element, const CornerSizes& border_radius, ColourbPremultiplied background_color,
-	const Array<ColourbPremultiplied, 4>& border_colors, float opacity)
+	const Array<ColourbPremultiplied, 4>& border_colors, float opacity, Vector2f& out_stretch)
 {
 	RMLUI_ZoneScoped;
 
-	// Find the box-shadow texture dimension and offset required to cover all box-shadows and element boxes combined.
-	Vector2f element_offset_in_texture;
-	Vector2i texture_dimensions;
-
 	const Property* p_box_shadow = element->GetLocalProperty(PropertyId::BoxShadow);
 	RMLUI_ASSERT(p_box_shadow->value.GetType() == Variant::BOXSHADOWLIST);
 	BoxShadowList shadow_list = p_box_shadow->value.Get<BoxShadowList>();
@@ -33,6 +29,68 @@ BoxShadowGeometryInfo GeometryBoxShadow::Resolve(Element* element, const CornerS
 		shadow.offset_y = NumericValue(element->ResolveLength(shadow.offset_y), Unit::PX);
 	}
 
+	// Since we can reuse textures across multiple box shadows with the same properties,
+	// we need to copy the element's box shadow list and the background and border geometry.
+	RenderBoxList padding_render_boxes{};
+	RenderBoxList border_render_boxes{};
+
+	for (int i = 0; i < element->GetNumBoxes(); i++)
+	{
+		padding_render_boxes.push_back(element->GetRenderBox(BoxArea::Padding, i));
+		border_render_boxes.push_back(element->GetRenderBox(BoxArea::Border, i));
+	}
+
+	// An element with a single box is shrunk to the smallest box with the same corners and edges, leaving two identical rows and columns
+	// between the corners. Then the texture can be shared between elements of any larger size, and stretched between these rows and columns.
+	out_stretch = {};
+	Vector2f slice_position;
+	if (border_render_boxes.size() == 1)
+	{
+		const Vector2f size = border_render_boxes[0].GetFillSize();
+		const EdgeSizes border_widths = border_render_boxes[0].GetBorderWidths();
+
+		// Overlapping corners are scaled down when generating the box, find the radii as they are drawn.
+		float radius_scale = 1.f;
+		for (int i = 0; i < 4; i++)
+		{
+			const float radius_sum = border_radius[i] + border_radius[(i + 1) % 4];
+			if (radius_sum > 0.f)
+				radius_scale = Math::Min(radius_scale, (i % 2 == 0 ? size.x : size.y) / radius_sum);
+		}
+
+		float shadow_extent = 0.f;
+		for (const BoxShadow& shadow : shadow_list)
+		{
+			const float offset = Math::Max(Math::Absolute(shadow.offset_x.number), Math::Absolute(shadow.offset_y.number));
+			shadow_extent = Math::Max(shadow_extent, 1.5f * shadow.blur_radius.number + Math::Absolute(shadow.spread_distance.number) + offset);
+		}
+
+		// The distance from each edge to the first row or column which is unaffected by the corners and the shadows offset from them.
+		auto GetMargin = [&](int edge) {
+			const float radius = radius_scale * Math::Max(border_radius[edge], border_radius[(edge + 1) % 4]);
+			return Math::RoundUp(radius + border_widths[edge] + shadow_extent);
+		};
+		const Vector2f margin_top_left = {GetMargin(3), GetMargin(0)};
+		const Vector2f margin_bottom_right = {GetMargin(1), GetMargin(2)};
+		const Vector2f min_size = margin_top_left + margin_bottom_right + Vector2f(2.f);
+
+		for (int axis = 0; axis < 2; axis++)
+		{
+			if (size[axis] > min_size[axis])
+			{
+				out_stretch[axis] = size[axis] - min_size[axis];
+				slice_position[axis] = margin_top_left[axis] + 1.f;
+			}
+		}
+
+		padding_render_boxes[0].SetFillSize(padding_render_boxes[0].GetFillSize() - out_stretch);
+		border_render_boxes[0].SetFillSize(size - out_stretch);
+	}
+
+	// Find the box-shadow texture dimension and offset required to cover all box-shadows and element boxes combined.
+	Vector2f element_offset_in_texture;
+	Vector2i texture_dimensions;
+
 	{
 		Vector2f extend_min;
 		Vector2f extend_max;
@@ -52,11 +110,8 @@ BoxShadowGeometryInfo GeometryBoxShadow::Resolve(Element* element, const CornerS
 		Rectanglef texture_region;
 
 		// Extend the render-texture further to cover all the element's boxes.
-		for (int i = 0; i < element->GetNumBoxes(); i++)
-		{
-			const RenderBox box = element->GetRenderBox(BoxArea::Border, i);
+		for (const RenderBox& box : border_render_boxes)
 			texture_region = texture_region.Join(Rectanglef::FromPositionSize(box.GetBorderOffset(), box.GetFillSize()));
-		}
 
 		texture_region = texture_region.Extend(-extend_min, extend_max);
 		Math::ExpandToPixelGrid(texture_region);
@@ -65,17 +120,6 @@ BoxShadowGeometryInfo GeometryBoxShadow::Resolve(Element* element, const CornerS
 		texture_dimensions = Vector2i(texture_region.Size());
 	}
 
-	// Since we can reuse textures across multiple box shadows with the same properties,
-	// we need to copy the element's box shadow list and the background and border geometry.
-	RenderBoxList padding_render_boxes{};
-	RenderBoxList border_render_boxes{};
-
-	for (int i = 0; i < element->GetNumBoxes(); i++)
-	{
-		padding_render_boxes.push_back(element->GetRenderBox(BoxArea::Padding, i));
-		border_render_boxes.push_back(element->GetRenderBox(BoxArea::Border, i));
-	}
-
 	// Finally, create cache information
 	BoxShadowGeometryInfo geometry_info;
 	geometry_info.background_color = background_color;
@@ -83,6 +127,7 @@ BoxShadowGeometryInfo GeometryBoxShadow::Resolve(Element* element, const CornerS
 	geometry_info.border_radius = border_radius;
 	geometry_info.texture_dimensions = texture_dimensions;
 	geometry_info.element_offset_in_texture = element_offset_in_texture;
+	geometry_info.slice_position = slice_position;
 	geometry_info.padding_render_boxes = std::move(padding_render_boxes);
 	geometry_info.border_render_boxes = std::move(border_render_boxes);
 	geometry_info.shadow_list = std::move(shadow_list);
@@ -90,6 +135,48 @@ BoxShadowGeometryInfo GeometryBoxShadow::Resolve(Element* element, const CornerS
 	return geometry_info;
 }
 
+void GeometryBoxShadow::GenerateMesh(Mesh& mesh, const BoxShadowGeometryInfo& info, Vector2f stretch)
+{
+	const byte alpha = byte(info.opacity * 255.f);
+	const ColourbPremultiplied colour(alpha, alpha);
+
+	// On each stretched axis, the texture is split at the slice position which lies between two identical rows or columns of texels. The
+	// middle slice samples the texture exactly at this position, thereby repeating these texels without being affected by texture filtering.
+	Array<float, 4> positions[2];
+	Array<float, 4> tex_coords[2];
+	int num_slices[2];
+	for (int axis = 0; axis < 2; axis++)
+	{
+		const float offset = info.element_offset_in_texture[axis];
+		const float size = float(info.texture_dimensions[axis]);
+		if (stretch[axis] > 0.f)
+		{
+			const float slice = info.slice_position[axis];
+			const float slice_tex_coord = (offset + slice) / size;
+			positions[axis] = {-offset, slice, slice + stretch[axis], size - offset + stretch[axis]};
+			tex_coords[axis] = {0.f, slice_tex_coord, slice_tex_coord, 1.f};
+			num_slices[axis] = 3;
+		}
+		else
+		{
+			positions[axis] = {-offset, size - offset};
+			tex_coords[axis] = {0.f, 1.f};
+			num_slices[axis] = 1;
+		}
+	}
+
+	for (int y = 0; y < num_slices[1]; y++)
+	{
+		for (int x = 0; x < num_slices[0]; x++)
+		{
+			const Vector2f top_left = {positions[0][x], positions[1][y]};
+			const Vector2f bottom_right = {positions[0][x + 1], positions[1][y + 1]};
+			MeshUtilities::GenerateQuad(mesh, top_left, bottom_right - top_left, colour, {tex_coords[0][x], tex_coords[1][y]},
+				{tex_coords[0][x + 1], tex_coords[1][y + 1]});
+		}
+	}
+}
+
 void GeometryBoxShadow::GenerateTexture(CallbackTexture& out_shadow_texture, Geometry& out_background_border_geometry, RenderManager& render_manager,
 	const BoxShadowGeometryInfo& info)
 {
@@ -12,6 +12,8 @@ struct BoxShadowGeometryInfo {
 	CornerSizes border_radius;
 	Vector2i texture_dimensions;
 	Vector2f element_offset_in_texture;
+	// Position relative to the border box where the texture is split when it is stretched to the size of the element.
+	Vector2f slice_position;
 	RenderBoxList padding_render_boxes;
 	RenderBoxList border_render_boxes;
 	BoxShadowList shadow_list;
@@ -21,8 +23,8 @@ inline bool operator==(const BoxShadowGeometryInfo& a, const BoxShadowGeometryIn
 {
 	return a.background_color == b.background_color && a.border_colors == b.border_colors && a.border_radius == b.border_radius &&
 		a.texture_dimensions == b.texture_dimensions && a.element_offset_in_texture == b.element_offset_in_texture &&
-		a.padding_render_boxes == b.padding_render_boxes && a.border_render_boxes == b.border_render_boxes && a.shadow_list == b.shadow_list &&
-		a.opacity == b.opacity;
+		a.slice_position == b.slice_position && a.padding_render_boxes == b.padding_render_boxes &&
+		a.border_render_boxes == b.border_render_boxes && a.shadow_list == b.shadow_list && a.opacity == b.opacity;
 }
 inline bool operator!=(const BoxShadowGeometryInfo& a, const BoxShadowGeometryInfo& b)
 {
@@ -32,6 +34,7 @@ inline bool operator!=(const BoxShadowGeometryInfo& a, const BoxShadowGeometryIn
 class Geometry;
 class CallbackTexture;
 class RenderManager;
+struct Mesh;
 
 class GeometryBoxShadow {
 public:
@@ -41,8 +44,16 @@ public:
 	/// @param[in] background_color The background colour of the element.
 	/// @param[in] border_colors The border colours of the element.
 	/// @param[in] opacity The computed opacity of the element.
+	/// @param[out] out_stretch The size the element's box has been shrunk by in the returned info. Then the texture no longer depends on the
+	/// size of the element, and it is stretched back to the element's size when drawn.
 	static BoxShadowGeometryInfo Resolve(Element* element, const CornerSizes& border_radius, ColourbPremultiplied background_color,
-		const Array<ColourbPremultiplied, 4>& border_colors, float opacity);
+		const Array<ColourbPremultiplied, 4>& border_colors, float opacity, Vector2f& out_stretch);
+
+	/// Generate the mesh drawing the box shadow texture, relative to the element's border box.
+	/// @param[out] out_mesh The mesh to append to, made up of a quad for each slice of the texture.
+	/// @param[in] shadow_geometry_info The resolved box shadow geometry of a given element.
+	/// @param[in] stretch The size to stretch the texture by, as resolved for the element.
+	static void GenerateMesh(Mesh& out_mesh, const BoxShadowGeometryInfo& shadow_geometry_info, Vector2f stretch);
 
 	/// Generate the texture and geometry for a box shadow and including the element's background and border.
 	/// @param[out] out_shadow_texture The target texture, assumes pointer stability during the lifetime of the shadow geometry.
@@ -11,6 +11,11 @@ class IdNameMap {
 	Vector<String> name_map; // IDs are indices into the name_map
 	UnorderedMap<String, ID> reverse_map;
 
+	// Perfect hash table of the names, once built. Each name is hashed into a bucket, whose displacement places all the names of the bucket
+	// into distinct slots. Thus, looking up a name takes a single probe and string comparison.
+	Vector<uint32_t> lookup_displacements;
+	Vector<ID> lookup_slots;
+
 protected:
 	IdNameMap(size_t num_ids_to_reserve)
 	{
@@ -30,6 +35,9 @@ public:
 		bool inserted = reverse_map.emplace(name, id).second;
 		RMLUI_ASSERT(inserted);
 		(void)inserted;
+
+		if (!lookup_slots.empty())
+			BuildLookupTable();
 	}
 
 	bool AssertAllInserted(ID number_of_defined_ids) const
@@ -40,6 +48,13 @@ public:
 
 	ID GetId(const String& name) const
 	{
+		if (!lookup_slots.empty())
+		{
+			const uint64_t hash = HashName(name);
+			const ID id = lookup_slots[GetSlot(hash, lookup_displacements[GetBucket(hash)])];
+			return (id != ID::Invalid && name_map[(size_t)id] == name) ? id : ID::Invalid;
+		}
+
 		auto it = reverse_map.find(name);
 		if (it != reverse_map.end())
 			return it->second;
@@ -65,11 +80,112 @@ public:
 		bool inserted = pair.second;
 
 		if (inserted)
+		{
 			name_map.push_back(name);
+			if (!lookup_slots.empty())
+				BuildLookupTable();
+		}
 
 		// Return the property id that already existed, or the new one if inserted
 		return it->second;
 	}
+
+	// Builds the perfect hash table for looking up the current names, it is rebuilt whenever names are added from then on. Names should only be
+	// added from the main thread, while lookups may be made from any thread.
+	void BuildLookupTable()
+	{
+		const size_t num_names = reverse_map.size();
+
+		size_t num_buckets = 1;
+		while (num_buckets * 2 < num_names)
+			num_buckets *= 2;
+		size_t num_slots = 1;
+		while (num_slots < num_names + num_names / 4 + 1)
+			num_slots *= 2;
+
+		// Any set of distinct hashes can be placed by growing the table, although a couple of attempts should suffice.
+		for (int attempt = 0; attempt < 4; attempt++, num_slots *= 2)
+		{
+			if (TryBuildLookupTable(num_buckets, num_slots))
+				return;
+		}
+
+		lookup_displacements.clear();
+		lookup_slots.clear();
+	}
+
+private:
+	static uint64_t HashName(const String& name)
+	{
+		uint64_t hash = uint64_t(Hash<String>()(name));
+		hash *= 0x9E3779B97F4A7C15ull;
+		return hash ^ (hash >> 29);
+	}
+	size_t GetBucket(uint64_t hash) const { return size_t(hash >> 40) & (lookup_displacements.size() - 1); }
+	size_t GetSlot(uint64_t hash, uint32_t displacement) const
+	{
+		// The step is odd, thus all slots are reached for some displacement.
+		const uint32_t step = uint32_t(hash >> 32) | 1u;
+		return size_t(uint32_t(hash) + displacement * step) & (lookup_slots.size() - 1);
+	}
+
+	bool TryBuildLookupTable(size_t num_buckets, size_t num_slots)
+	{
+		lookup_displacements.assign(num_buckets, 0);
+		lookup_slots.assign(num_slots, ID::Invalid);
+
+		Vector<Vector<std::pair<uint64_t, ID>>> buckets(num_buckets);
+		for (const auto& pair : reverse_map)
+		{
+			if (pair.second == ID::Invalid)
+				continue;
+			const uint64_t hash = HashName(pair.first);
+			buckets[GetBucket(hash)].push_back({hash, pair.second});
+		}
+
+		// Place the largest buckets first, while most slots are still free.
+		Vector<size_t> bucket_order(num_buckets);
+		for (size_t i = 0; i < num_buckets; i++)
+			bucket_order[i] = i;
+		std::stable_sort(bucket_order.begin(), bucket_order.end(), [&](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+		Vector<size_t> bucket_slots;
+		for (size_t bucket_index : bucket_order)
+		{
+			const auto& bucket = buckets[bucket_index];
+			if (bucket.empty())
+				break;
+
+			bool placed = false;
+			for (uint32_t displacement = 0; displacement < uint32_t(num_slots) && !placed; displacement++)
+			{
+				bucket_slots.clear();
+				placed = true;
+				for (const auto& entry : bucket)
+				{
+					const size_t slot = GetSlot(entry.first, displacement);
+					if (lookup_slots[slot] != ID::Invalid || std::find(bucket_slots.begin(), bucket_slots.end(), slot) != bucket_slots.end())
+					{
+						placed = false;
+						break;
+					}
+					bucket_slots.push_back(slot);
+				}
+
+				if (placed)
+				{
+					lookup_displacements[bucket_index] = displacement;
+					for (size_t i = 0; i < bucket.size(); i++)
+						lookup_slots[bucket_slots[i]] = bucket[i].second;
+				}
+			}
+
+			if (!placed)
+				return false;
+		}
+
+		return true;
+	}
 };
 
 class PropertyIdNameMap : public IdNameMap<PropertyId> {
@@ -0,0 +1,93 @@
+#include "ImageGeometryCache.h"
+#include "../../Include/RmlUi/Core/MeshUtilities.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/RenderManager.h"
+#include "../Core/ControlledLifetimeResource.h"
+#include "BoxShadowHash.h"
+
+namespace std {
+
+template <>
+struct hash<::Rml::ImageGeometryInfo> {
+	size_t operator()(const ::Rml::ImageGeometryInfo& in) const noexcept
+	{
+		using namespace ::Rml::Utilities;
+		size_t seed = hash<const void*>{}(in.render_manager);
+
+		HashCombine(seed, in.offset);
+		HashCombine(seed, in.size);
+		HashCombine(seed, in.colour);
+		HashCombine(seed, in.top_left_texcoord);
+		HashCombine(seed, in.bottom_right_texcoord);
+		return seed;
+	}
+};
+
+} // namespace std
+
+namespace Rml {
+
+struct ImageGeometryCacheData {
+	StableUnorderedMap<ImageGeometryInfo, WeakPtr<ImageRenderable>> handles;
+};
+
+static void ReleaseHandle(ImageRenderable* handle);
+
+ImageRenderable::ImageRenderable(const ImageGeometryInfo& geometry_info) : cache_key(geometry_info) {}
+
+ImageRenderable::~ImageRenderable()
+{
+	ReleaseHandle(this);
+}
+
+static ControlledLifetimeResource<ImageGeometryCacheData> image_geometry_cache_data;
+
+void ImageGeometryCache::Initialize()
+{
+	image_geometry_cache_data.Initialize();
+}
+
+void ImageGeometryCache::Shutdown()
+{
+	image_geometry_cache_data.Shutdown();
+}
+
+SharedPtr<ImageRenderable> ImageGeometryCache::GetHandle(ImageGeometryInfo&& info)
+{
+	RMLUI_ASSERT(info.render_manager);
+
+	auto it_handle = image_geometry_cache_data->handles.find(info);
+	if (it_handle != image_geometry_cache_data->handles.end())
+	{
+		SharedPtr<ImageRenderable> result = it_handle->second.lock();
+		RMLUI_ASSERTMSG(result, "Failed to lock handle in image geometry cache");
+		return result;
+	}
+
+	RMLUI_ZoneScoped;
+	const auto iterator_inserted = image_geometry_cache_data->handles.emplace(std::move(info), WeakPtr<ImageRenderable>());
+	RMLUI_ASSERTMSG(iterator_inserted.second, "Could not insert entry into the image geometry cache handle map, duplicate key.");
+	const ImageGeometryInfo& inserted_key = iterator_inserted.first->first;
+	WeakPtr<ImageRenderable>& inserted_weak_data_pointer = iterator_inserted.first->second;
+
+	auto handle = MakeShared<ImageRenderable>(inserted_key);
+
+	Mesh mesh;
+	MeshUtilities::GenerateQuad(mesh, inserted_key.offset, inserted_key.size, inserted_key.colour, inserted_key.top_left_texcoord,
+		inserted_key.bottom_right_texcoord);
+	handle->geometry = inserted_key.render_manager->MakeGeometry(std::move(mesh));
+
+	inserted_weak_data_pointer = handle;
+	return handle;
+}
+
+static void ReleaseHandle(ImageRenderable* handle)
+{
+	auto& handles = image_geometry_cache_data->handles;
+	auto it_handle = handles.find(handle->cache_key);
+	RMLUI_ASSERT(it_handle != handles.cend());
+
+	handles.erase(it_handle);
+}
+
+} // namespace Rml
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Geometry.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+struct ImageGeometryInfo {
+	RenderManager* render_manager;
+	Vector2f offset;
+	Vector2f size;
+	ColourbPremultiplied colour;
+	Vector2f top_left_texcoord;
+	Vector2f bottom_right_texcoord;
+};
+inline bool operator==(const ImageGeometryInfo& a, const ImageGeometryInfo& b)
+{
+	return a.render_manager == b.render_manager && a.offset == b.offset && a.size == b.size && a.colour == b.colour &&
+		a.top_left_texcoord == b.top_left_texcoord && a.bottom_right_texcoord == b.bottom_right_texcoord;
+}
+inline bool operator!=(const ImageGeometryInfo& a, const ImageGeometryInfo& b)
+{
+	return !(a == b);
+}
+
+struct ImageRenderable : NonCopyMoveable {
+	ImageRenderable(const ImageGeometryInfo& geometry_info);
+	~ImageRenderable();
+
+	Geometry geometry;
+	const ImageGeometryInfo& cache_key;
+};
+
+class ImageGeometryCache {
+public:
+	static void Initialize();
+	static void Shutdown();
+
+	/// Returns a handle to the textured quad geometry matching the given info - creates new data if none is found.
+	/// @param[in] info The dimensions, colour, and texture coordinates of the quad, in element-local coordinates.
+	/// @return A handle to the geometry, with automatic reference counting.
+	static SharedPtr<ImageRenderable> GetHandle(ImageGeometryInfo&& info);
+};
+
+} // namespace Rml
@@ -0,0 +1,154 @@
+#include "../../Include/RmlUi/Core/InputBatch.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
+#include <algorithm>
+#include <string.h>
+
+namespace Rml {
+
+void InputBatch::KeyDown(Input::KeyIdentifier key_identifier, int key_modifier_state)
+{
+	AddEvent(Type::KeyDown, key_modifier_state, int(key_identifier));
+}
+
+void InputBatch::KeyUp(Input::KeyIdentifier key_identifier, int key_modifier_state)
+{
+	AddEvent(Type::KeyUp, key_modifier_state, int(key_identifier));
+}
+
+void InputBatch::TextInput(Character character)
+{
+	// A single character fits within the small string buffer, thus no memory is allocated.
+	const String utf8 = StringUtilities::ToUTF8(character);
+	TextInput(utf8.c_str());
+}
+
+void InputBatch::TextInput(const char* utf8_string)
+{
+	const int length = int(strlen(utf8_string));
+	if (length == 0)
+		return;
+
+	// Text is appended to the end of the buffer, thus it can be merged with the text of the last event.
+	if (Event* last = GetMergeableEvent(Type::TextInput, 0))
+		last->count += length;
+	else
+		AddEvent(Type::TextInput, 0, int(text.size()), length);
+
+	text.append(utf8_string, size_t(length));
+}
+
+void InputBatch::MouseMove(int x, int y, int key_modifier_state)
+{
+	if (Event* last = GetMergeableEvent(Type::MouseMove, key_modifier_state))
+		last->value = Vector2f(float(x), float(y));
+	else
+		AddEvent(Type::MouseMove, key_modifier_state, 0, 0, Vector2f(float(x), float(y)));
+}
+
+void InputBatch::MouseButtonDown(int button_index, int key_modifier_state)
+{
+	AddEvent(Type::MouseButtonDown, key_modifier_state, button_index);
+}
+
+void InputBatch::MouseButtonUp(int button_index, int key_modifier_state)
+{
+	AddEvent(Type::MouseButtonUp, key_modifier_state, button_index);
+}
+
+void InputBatch::MouseWheel(Vector2f wheel_delta, int key_modifier_state)
+{
+	if (Event* last = GetMergeableEvent(Type::MouseWheel, key_modifier_state))
+		last->value += wheel_delta;
+	else
+		AddEvent(Type::MouseWheel, key_modifier_state, 0, 0, wheel_delta);
+}
+
+void InputBatch::MouseLeave()
+{
+	AddEvent(Type::MouseLeave, 0, 0);
+}
+
+void InputBatch::TouchStart(const Touch& touch, int key_modifier_state)
+{
+	AddTouch(Type::TouchStart, touch, key_modifier_state);
+}
+
+void InputBatch::TouchMove(const Touch& touch, int key_modifier_state)
+{
+	// Keep the latest position of each touch point moved since the last event of another kind.
+	if (Event* last = GetMergeableEvent(Type::TouchMove, key_modifier_state))
+	{
+		for (int i = last->index; i < last->index + last->count; i++)
+		{
+			if (touches[i].identifier == touch.identifier)
+			{
+				touches[i].position = touch.position;
+				return;
+			}
+		}
+	}
+
+	AddTouch(Type::TouchMove, touch, key_modifier_state);
+}
+
+void InputBatch::TouchEnd(const Touch& touch, int key_modifier_state)
+{
+	AddTouch(Type::TouchEnd, touch, key_modifier_state);
+}
+
+void InputBatch::TouchCancel(const Touch& touch)
+{
+	AddTouch(Type::TouchCancel, touch, 0);
+}
+
+void InputBatch::Clear()
+{
+	events.clear();
+	text.clear();
+	touches.clear();
+}
+
+StringView InputBatch::GetText(const Event& event) const
+{
+	RMLUI_ASSERT(event.type == Type::TextInput);
+	return StringView(text, size_t(event.index), size_t(event.count));
+}
+
+Span<const Touch> InputBatch::GetTouches(const Event& event) const
+{
+	RMLUI_ASSERT(event.type >= Type::TouchStart && event.type <= Type::TouchCancel);
+	return Span<const Touch>(touches.data() + event.index, size_t(event.count));
+}
+
+InputBatch::Event* InputBatch::GetMergeableEvent(Type type, int key_modifier_state)
+{
+	if (events.empty() || events.back().type != type || events.back().key_modifier_state != key_modifier_state)
+		return nullptr;
+	return &events.back();
+}
+
+void InputBatch::AddEvent(Type type, int key_modifier_state, int index, int count, Vector2f value)
+{
+	events.push_back(Event{type, key_modifier_state, index, count, value});
+}
+
+void InputBatch::AddTouch(Type type, const Touch& touch, int key_modifier_state)
+{
+	// Touches of the same kind are grouped into a single event, as long as each touch point occurs only once.
+	if (Event* last = GetMergeableEvent(type, key_modifier_state))
+	{
+		const bool duplicate = std::any_of(touches.begin() + last->index, touches.end(),
+			[&](const Touch& other) { return other.identifier == touch.identifier; });
+		if (!duplicate)
+		{
+			touches.push_back(touch);
+			last->count += 1;
+			return;
+		}
+	}
+
+	AddEvent(type, key_modifier_state, int(touches.size()), 1);
+	touches.push_back(touch);
+}
+
+} // namespace Rml
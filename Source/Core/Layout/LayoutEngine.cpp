@@ -1,21 +1,230 @@
 #include "LayoutEngine.h"
+#include "../ControlledLifetimeResource.h"
+#include "../ElementMeta.h"
+#include "../FrameStatisticsAccess.h"
 #include "../../../Include/RmlUi/Core/ComputedValues.h"
+#include "../../../Include/RmlUi/Core/Core.h"
 #include "../../../Include/RmlUi/Core/Element.h"
 #include "../../../Include/RmlUi/Core/ElementText.h"
 #include "../../../Include/RmlUi/Core/FontEngineInterface.h"
 #include "../../../Include/RmlUi/Core/Log.h"
 #include "../../../Include/RmlUi/Core/Profiling.h"
 #include "../../../Include/RmlUi/Core/StringUtilities.h"
+#include "../../../Include/RmlUi/Core/TaskInterface.h"
 #include "../../../Include/RmlUi/Core/Traits.h"
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
+#include <thread>
 #include <yoga/Yoga.h>
 
 namespace Rml {
 
 namespace {
 
+	// Yoga nodes are reused between layouts, instead of allocating and freeing a node for every element during every layout. All nodes acquired
+	// during a layout are returned to the pool in bulk when the layout is done.
+	class YogaNodePool : NonCopyMoveable {
+	public:
+		YogaNodePool()
+		{
+			config = YGConfigNew();
+			YGConfigSetUseWebDefaults(config, true);
+			YGConfigSetPointScaleFactor(config, 1.0f);
+		}
+		~YogaNodePool()
+		{
+			RMLUI_ASSERTMSG(used_nodes.empty(), "Yoga nodes still in use while destroying the node pool.");
+			for (YGNodeRef node : free_nodes)
+				YGNodeFree(node);
+			YGConfigFree(config);
+		}
+
+		YGNodeRef Acquire()
+		{
+			YGNodeRef node;
+			if (free_nodes.empty())
+			{
+				node = YGNodeNewWithConfig(config);
+			}
+			else
+			{
+				node = free_nodes.back();
+				free_nodes.pop_back();
+			}
+
+			used_nodes.push_back(node);
+			high_water_mark = Math::Max(high_water_mark, (int)used_nodes.size());
+			return node;
+		}
+
+		int GetNumUsedNodes() const { return (int)used_nodes.size(); }
+
+		// Returns all nodes acquired after the given number of nodes were in use to the pool. The nodes must not be used afterwards.
+		void Release(int num_used_nodes_before)
+		{
+			RMLUI_ASSERT(num_used_nodes_before >= 0 && num_used_nodes_before <= (int)used_nodes.size());
+
+			// Nodes can only be reset once detached from both their children and owner.
+			for (int i = num_used_nodes_before; i < (int)used_nodes.size(); i++)
+				YGNodeRemoveAllChildren(used_nodes[i]);
+
+			for (int i = num_used_nodes_before; i < (int)used_nodes.size(); i++)
+			{
+				YGNodeReset(used_nodes[i]);
+				free_nodes.push_back(used_nodes[i]);
+			}
+
+			used_nodes.resize(num_used_nodes_before);
+		}
+
+		// Frees the nodes kept for reuse beyond the retention limit, so that a single large layout does not hold on to its nodes forever.
+		void Trim()
+		{
+			const int num_nodes_to_free = (int)free_nodes.size() - max_retained_free_nodes;
+			if (num_nodes_to_free <= 0)
+				return;
+
+			for (int i = 0; i < num_nodes_to_free; i++)
+			{
+				YGNodeFree(free_nodes.back());
+				free_nodes.pop_back();
+			}
+			free_nodes.shrink_to_fit();
+		}
+
+		LayoutEngine::NodePoolStats GetStats() const
+		{
+			LayoutEngine::NodePoolStats stats;
+			stats.num_allocated_nodes = (int)(used_nodes.size() + free_nodes.size());
+			stats.high_water_mark = high_water_mark;
+			return stats;
+		}
+
+	private:
+		// Enough nodes for repeated layouts of typical documents without allocating.
+		static constexpr int max_retained_free_nodes = 4096;
+
+		YGConfigRef config = nullptr;
+		Vector<YGNodeRef> used_nodes;
+		Vector<YGNodeRef> free_nodes;
+		int high_water_mark = 0;
+	};
+
+	ControlledLifetimeResource<YogaNodePool> yoga_node_pool;
+
+	// Returns the acquired nodes to the pool when leaving the scope.
+	class ScopedYogaNodes : NonCopyMoveable {
+	public:
+		ScopedYogaNodes() : num_used_nodes_before(yoga_node_pool->GetNumUsedNodes()) {}
+		~ScopedYogaNodes()
+		{
+			yoga_node_pool->Release(num_used_nodes_before);
+			if (num_used_nodes_before == 0)
+				yoga_node_pool->Trim();
+		}
+
+	private:
+		int num_used_nodes_before;
+	};
+
+	// Worker threads for calculating the layouts of independent trees of Yoga nodes. The calling thread takes part in the work, and waits for
+	// all tasks to finish before returning.
+	class LayoutWorkers : NonCopyMoveable {
+	public:
+		explicit LayoutWorkers(int num_threads)
+		{
+			threads.reserve(num_threads);
+			for (int i = 0; i < num_threads; i++)
+				threads.emplace_back([this] { WorkerLoop(); });
+		}
+		~LayoutWorkers()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stopping = true;
+			}
+			work_available.notify_all();
+			for (std::thread& thread : threads)
+				thread.join();
+		}
+
+		// Calls the task once for every index in [0, num_tasks), distributed between the calling thread and the workers.
+		void Run(int num_tasks, const Function<void(int)>& task)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			current_task = &task;
+			next_task = 0;
+			task_count = num_tasks;
+			num_remaining_tasks = num_tasks;
+			work_available.notify_all();
+
+			RunTasks(lock);
+
+			work_done.wait(lock, [this] { return num_remaining_tasks == 0; });
+			current_task = nullptr;
+			task_count = 0;
+		}
+
+	private:
+		void WorkerLoop()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			while (true)
+			{
+				work_available.wait(lock, [this] { return stopping || next_task < task_count; });
+				if (stopping)
+					return;
+				RunTasks(lock);
+			}
+		}
+
+		// Claims and runs tasks until none are left, the lock is released while running a task.
+		void RunTasks(std::unique_lock<std::mutex>& lock)
+		{
+			while (next_task < task_count)
+			{
+				const int index = next_task++;
+				const Function<void(int)>& task = *current_task;
+
+				lock.unlock();
+				task(index);
+				lock.lock();
+
+				num_remaining_tasks -= 1;
+				if (num_remaining_tasks == 0)
+					work_done.notify_all();
+			}
+		}
+
+		Vector<std::thread> threads;
+		std::mutex mutex;
+		std::condition_variable work_available;
+		std::condition_variable work_done;
+
+		const Function<void(int)>* current_task = nullptr;
+		int next_task = 0;
+		int task_count = 0;
+		int num_remaining_tasks = 0;
+		bool stopping = false;
+	};
+
+	UniquePtr<LayoutWorkers> layout_workers;
+
+	// Set instead of the workers when the application has installed a task interface for running the layouts.
+	TaskInterface* layout_task_interface = nullptr;
+
+	// Measuring calls into elements and the font engine interface, neither of which are thread-safe. While layouts are calculated
+	// concurrently, this points to the mutex serializing the measure and baseline callbacks.
+	std::mutex* measure_mutex = nullptr;
+
+	static std::unique_lock<std::mutex> LockMeasure()
+	{
+		return measure_mutex ? std::unique_lock<std::mutex>(*measure_mutex) : std::unique_lock<std::mutex>();
+	}
+
 	static YGFlexDirection ToYogaFlexDirection(Style::FlexDirection v)
 	{
 		switch (v)
@@ -255,6 +464,7 @@ namespace {
 
 	static float YogaBaselineFunc(YGNodeConstRef node, float width, float height)
 	{
+		const auto lock = LockMeasure();
 		Element* element = reinterpret_cast<Element*>(YGNodeGetContext(node));
 		if (auto text_element = rmlui_dynamic_cast<ElementText*>(element))
 		{
@@ -281,12 +491,8 @@ namespace {
 		return height;
 	}
 
-	static YGSize YogaMeasureFunc(YGNodeConstRef node, float width, YGMeasureMode width_mode, float height, YGMeasureMode height_mode)
+	static YGSize MeasureElement(Element* element, float width, YGMeasureMode width_mode, float height, YGMeasureMode height_mode)
 	{
-		Element* element = reinterpret_cast<Element*>(YGNodeGetContext(node));
-		if (!element)
-			return {0, 0};
-
 		// Text nodes
 		if (auto text_element = rmlui_dynamic_cast<ElementText*>(element))
 		{
@@ -399,6 +605,32 @@ namespace {
 		return {0, 0};
 	}
 
+	static YGSize YogaMeasureFunc(YGNodeConstRef node, float width, YGMeasureMode width_mode, float height, YGMeasureMode height_mode)
+	{
+		const auto lock = LockMeasure();
+		Element* element = reinterpret_cast<Element*>(YGNodeGetContext(node));
+		if (!element)
+			return {0, 0};
+
+		// The trees of Yoga nodes are rebuilt for every layout, so its own measure cache does not survive between layouts. Instead, retain the
+		// measured sizes on the element. Undefined sizes are passed as NaN, ignore them so that they compare equal.
+		if (width_mode == YGMeasureModeUndefined)
+			width = 0.f;
+		if (height_mode == YGMeasureModeUndefined)
+			height = 0.f;
+
+		ElementLayoutCache& cache = LayoutEngine::GetLayoutCache(element);
+		if (const Vector2f* size = cache.Find(width, (int)width_mode, height, (int)height_mode))
+			return {size->x, size->y};
+
+		const YGSize size = MeasureElement(element, width, width_mode, height, height_mode);
+		if (DocumentFrameStatistics* statistics = FrameStatisticsAccess::Get(element))
+			statistics->num_layout_measures += 1;
+
+		cache.Insert(width, (int)width_mode, height, (int)height_mode, Vector2f(size.width, size.height));
+		return size;
+	}
+
 	static void ApplyYogaStyleToNode(YGNodeRef node, Element* element)
 	{
 		const ComputedValues& c = element->GetComputedValues();
@@ -473,27 +705,31 @@ namespace {
 		YGNodeStyleSetOverflow(node, ToYogaOverflow(combined_overflow));
 	}
 
-	static YGNodeRef BuildYogaTreeRecursive(Element* element, YGConfigRef config)
+	// Returns true if the element's border box size is given by its own style, such that its contents can't affect its size.
+	static bool IsSizeDeterminedByStyle(const ComputedValues& computed)
 	{
-		YGNodeRef node = YGNodeNewWithConfig(config);
+		return computed.width().type == Style::Width::Length && computed.height().type == Style::Height::Length;
+	}
+
+	static YGNodeRef BuildYogaTreeRecursive(Element* element)
+	{
+		YGNodeRef node = yoga_node_pool->Acquire();
 		YGNodeSetContext(node, element);
 		ApplyYogaStyleToNode(node, element);
 
 		const bool is_leaf = (element->GetNumChildren() == 0);
-		const bool is_text = (rmlui_dynamic_cast<ElementText*>(element) != nullptr);
-
-		Vector2f intrinsic_dimensions;
-		float intrinsic_ratio = 0.f;
-		const bool is_replaced = element->GetIntrinsicDimensions(intrinsic_dimensions, intrinsic_ratio);
 
-		if (is_leaf && (is_text || is_replaced))
+		if (is_leaf)
 		{
-			YGNodeSetMeasureFunc(node, YogaMeasureFunc);
+			// Leaves sized entirely by their style never need to be measured, thus avoid querying their intrinsic dimensions.
+			const bool is_text = (rmlui_dynamic_cast<ElementText*>(element) != nullptr);
+			const bool is_measured = is_text || (!IsSizeDeterminedByStyle(element->GetComputedValues()) && element->IsReplaced());
+
+			if (is_measured)
+				YGNodeSetMeasureFunc(node, YogaMeasureFunc);
 
 			if (is_text)
-			{
 				YGNodeSetBaselineFunc(node, YogaBaselineFunc);
-			}
 		}
 		else
 		{
@@ -503,7 +739,7 @@ namespace {
 				Element* child = element->GetChild(i);
 				if (!child)
 					continue;
-				YGNodeInsertChild(node, BuildYogaTreeRecursive(child, config), (uint32_t)YGNodeGetChildCount(node));
+				YGNodeInsertChild(node, BuildYogaTreeRecursive(child), (uint32_t)YGNodeGetChildCount(node));
 			}
 		}
 
@@ -564,6 +800,8 @@ namespace {
 		}
 	}
 
+	static void ApplyContentLayout(Element* element, YGNodeRef node);
+
 	static void ApplyLayoutRecursive(Element* element, YGNodeRef node, Element* offset_parent, const Vector2f& parent_content_position)
 	{
 		RMLUI_ASSERT(element && node);
@@ -613,6 +851,22 @@ namespace {
 		element->SetOffset(border_position, offset_parent, false);
 		element->SetBox(box);
 
+		if (DocumentFrameStatistics* statistics = FrameStatisticsAccess::Get(element))
+			statistics->num_layout_boxes += 1;
+
+		ApplyContentLayout(element, node);
+	}
+
+	static void ApplyContentLayout(Element* element, YGNodeRef node)
+	{
+		const Box& box = element->GetBox();
+		const float content_width = box.GetSize().x;
+		const float content_height = box.GetSize().y;
+		const float padding_left = box.GetEdge(BoxArea::Padding, BoxEdge::Left);
+		const float padding_top = box.GetEdge(BoxArea::Padding, BoxEdge::Top);
+		const float padding_right = box.GetEdge(BoxArea::Padding, BoxEdge::Right);
+		const float padding_bottom = box.GetEdge(BoxArea::Padding, BoxEdge::Bottom);
+
 		// Layout children.
 		const Vector2f element_content_position = box.GetPosition(BoxArea::Content);
 
@@ -656,41 +910,261 @@ namespace {
 		// element->OnLayout();
 	}
 
+	static bool IsLayoutBoundary(Element* element)
+	{
+		// A layout boundary must have a size that doesn't depend on its contents, so that changes to its contents can't affect anything outside
+		// it. Baseline alignment is excluded as well, since then its position depends on its contents.
+		using namespace Style;
+		const ComputedValues& computed = element->GetComputedValues();
+		if (computed.display() == Display::None || computed.width().type != Width::Length || computed.height().type != Height::Length)
+			return false;
+
+		if (computed.align_self() == AlignSelf::Baseline)
+			return false;
+
+		Element* parent = element->GetParentNode();
+		if (computed.align_self() == AlignSelf::Auto && parent && parent->GetComputedValues().align_items() == AlignItems::Baseline)
+			return false;
+
+		return true;
+	}
+
+	// A tree of Yoga nodes to be calculated independently of any other tree. Either a root-level element wrapped in a node representing its
+	// containing block, or the contents of a layout boundary fixed to its current size.
+	struct IndependentLayout {
+		Element* element;
+		Vector2f available_size;
+		YGNodeRef calculate_node;
+		YGNodeRef root_node;
+		YGDirection direction;
+		bool layout_boundary;
+	};
+
+	static YGDirection GetRootDirection(Element* element)
+	{
+		const YGDirection dir = ToYogaDirection(element->GetComputedValues().direction());
+		return dir == YGDirectionInherit ? YGDirectionLTR : dir;
+	}
+
+	static IndependentLayout BuildRootLayout(Element* element, Vector2f containing_block)
+	{
+		// Wrapper node representing the containing block (parent content box).
+		YGNodeRef wrapper = yoga_node_pool->Acquire();
+		YGNodeStyleSetDisplay(wrapper, YGDisplayFlex);
+		YGNodeStyleSetWidth(wrapper, containing_block.x);
+		YGNodeStyleSetHeight(wrapper, containing_block.y);
+
+		YGNodeRef root_node = BuildYogaTreeRecursive(element);
+		YGNodeInsertChild(wrapper, root_node, 0);
+
+		return IndependentLayout{element, containing_block, wrapper, root_node, GetRootDirection(element), false};
+	}
+
+	static IndependentLayout BuildLayoutBoundaryLayout(Element* element)
+	{
+		// The boundary keeps its current box and offset, only its contents are formatted. Fix the root node to its current border size.
+		const Vector2f border_size = element->GetBox().GetSize(BoxArea::Border);
+
+		YGNodeRef root_node = BuildYogaTreeRecursive(element);
+		YGNodeStyleSetBoxSizing(root_node, YGBoxSizingBorderBox);
+		YGNodeStyleSetWidth(root_node, border_size.x);
+		YGNodeStyleSetHeight(root_node, border_size.y);
+		YGNodeStyleSetMinWidth(root_node, YGUndefined);
+		YGNodeStyleSetMinHeight(root_node, YGUndefined);
+		YGNodeStyleSetMaxWidth(root_node, YGUndefined);
+		YGNodeStyleSetMaxHeight(root_node, YGUndefined);
+
+		return IndependentLayout{element, border_size, root_node, root_node, GetRootDirection(element), true};
+	}
+
+	// Only touches the Yoga nodes of the given layout, apart from the measure callbacks, thus independent layouts can be calculated concurrently.
+	static void CalculateLayout(const IndependentLayout& layout)
+	{
+		YGNodeCalculateLayout(layout.calculate_node, layout.available_size.x, layout.available_size.y, layout.direction);
+	}
+
+	static void ApplyLayout(const IndependentLayout& layout)
+	{
+		if (layout.layout_boundary)
+		{
+			ApplyContentLayout(layout.element, layout.root_node);
+			return;
+		}
+
+		// Apply results back to element tree.
+		Element* offset_parent = layout.element->GetParentNode();
+		Vector2f parent_content_position(0.f, 0.f);
+		if (offset_parent)
+			parent_content_position = offset_parent->GetBox().GetPosition(BoxArea::Content);
+
+		ApplyLayoutRecursive(layout.element, layout.root_node, offset_parent, parent_content_position);
+	}
+
+	// Calculates the given layouts, concurrently if worker threads are available, and applies them to their elements.
+	static void CalculateAndApplyLayouts(const Vector<IndependentLayout>& layouts)
+	{
+		if ((layout_workers || layout_task_interface) && layouts.size() >= 2)
+		{
+			RMLUI_ZoneScopedN("CalculateLayouts");
+			std::mutex mutex;
+			measure_mutex = &mutex;
+			auto task = [&layouts](int index) { CalculateLayout(layouts[index]); };
+			if (layout_workers)
+				layout_workers->Run((int)layouts.size(), task);
+			else
+				layout_task_interface->ParallelFor((int)layouts.size(), task);
+			measure_mutex = nullptr;
+		}
+		else
+		{
+			for (const IndependentLayout& layout : layouts)
+				CalculateLayout(layout);
+		}
+
+		// Building the node trees and applying the results reads and writes the elements, which is only done on the calling thread.
+		for (const IndependentLayout& layout : layouts)
+			ApplyLayout(layout);
+	}
+
 } // namespace
 
+void LayoutEngine::Initialize(int num_threads)
+{
+	yoga_node_pool.InitializeIfEmpty();
+	if (num_threads <= 0)
+		return;
+
+	// Prefer the application's own threads when it provides them.
+	if (TaskInterface* task_interface = GetTaskInterface())
+		layout_task_interface = task_interface;
+	else if (!layout_workers)
+		layout_workers = MakeUnique<LayoutWorkers>(num_threads);
+}
+
+void LayoutEngine::Shutdown()
+{
+	layout_workers.reset();
+	layout_task_interface = nullptr;
+	yoga_node_pool.Shutdown();
+}
+
+LayoutEngine::NodePoolStats LayoutEngine::GetNodePoolStats()
+{
+	return yoga_node_pool->GetStats();
+}
+
+ElementLayoutCache& LayoutEngine::GetLayoutCache(Element* element)
+{
+	return element->meta->layout_cache;
+}
+
+bool LayoutEngine::FormatDirtyLayoutBoundaries(Element* element)
+{
+	Vector<Element*> boundaries;
+	if (!FindDirtyLayoutBoundaries(element, boundaries))
+		return false;
+
+	FormatElements({}, boundaries);
+	return true;
+}
+
+bool LayoutEngine::FindDirtyLayoutBoundaries(Element* element, Vector<Element*>& boundaries)
+{
+	RMLUI_ASSERT(element);
+	if (!element->dirty_child_layout)
+		return true;
+
+	const size_t num_boundaries_before = boundaries.size();
+	if (CollectDirtyLayoutBoundaries(element, boundaries))
+	{
+		boundaries.resize(num_boundaries_before);
+		return false;
+	}
+
+	return true;
+}
+
+bool LayoutEngine::CollectDirtyLayoutBoundaries(Element* element, Vector<Element*>& boundaries)
+{
+	const bool dirty_self = element->dirty_layout;
+	bool dirty_contents = false;
+	element->dirty_layout = false;
+
+	if (element->dirty_child_layout)
+	{
+		element->dirty_child_layout = false;
+
+		const size_t num_boundaries_before = boundaries.size();
+		for (const ElementPtr& child : element->children)
+		{
+			if (child->dirty_layout || child->dirty_child_layout)
+				dirty_contents |= CollectDirtyLayoutBoundaries(child.get(), boundaries);
+		}
+
+		if (dirty_contents && IsLayoutBoundary(element))
+		{
+			// Any boundaries found inside this one are formatted as part of it.
+			boundaries.resize(num_boundaries_before);
+			boundaries.push_back(element);
+			dirty_contents = false;
+		}
+	}
+
+	return dirty_self || dirty_contents;
+}
+
+void LayoutEngine::ClearDirtyLayout(Element* element)
+{
+	element->dirty_layout = false;
+	if (element->dirty_child_layout)
+	{
+		element->dirty_child_layout = false;
+		for (const ElementPtr& child : element->children)
+			ClearDirtyLayout(child.get());
+	}
+}
+
 void LayoutEngine::FormatElement(Element* element, Vector2f containing_block)
 {
-	RMLUI_ASSERT(element && containing_block.x >= 0 && containing_block.y >= 0);
+	FormatElements({FormatTarget{element, containing_block}}, {});
+}
 
-	YGConfigRef config = YGConfigNew();
-	YGConfigSetUseWebDefaults(config, true);
-	YGConfigSetPointScaleFactor(config, 1.0f);
+void LayoutEngine::FormatElements(const Vector<FormatTarget>& targets, const Vector<Element*>& layout_boundaries)
+{
+	if (targets.empty() && layout_boundaries.empty())
+		return;
+
+	RMLUI_ZoneScoped;
+
+	{
+		ScopedYogaNodes scoped_nodes;
 
-	// Wrapper node representing the containing block (parent content box).
-	YGNodeRef wrapper = YGNodeNewWithConfig(config);
-	YGNodeStyleSetDisplay(wrapper, YGDisplayFlex);
-	YGNodeStyleSetWidth(wrapper, containing_block.x);
-	YGNodeStyleSetHeight(wrapper, containing_block.y);
+		Vector<IndependentLayout> layouts;
+		layouts.reserve(targets.size() + layout_boundaries.size());
 
-	YGNodeRef root_node = BuildYogaTreeRecursive(element, config);
-	YGNodeInsertChild(wrapper, root_node, 0);
+		for (const FormatTarget& target : targets)
+		{
+			RMLUI_ASSERT(target.element && target.containing_block.x >= 0 && target.containing_block.y >= 0);
 
-	const YGDirection dir = ToYogaDirection(element->GetComputedValues().direction());
-	YGNodeCalculateLayout(wrapper, containing_block.x, containing_block.y, dir == YGDirectionInherit ? YGDirectionLTR : dir);
+			// Everything is formatted, thus any dirty layout within the element is resolved.
+			ClearDirtyLayout(target.element);
 
-	// Apply results back to element tree.
-	Element* offset_parent = element->GetParentNode();
-	Vector2f parent_content_position(0.f, 0.f);
-	if (offset_parent)
-		parent_content_position = offset_parent->GetBox().GetPosition(BoxArea::Content);
+			if (DocumentFrameStatistics* statistics = FrameStatisticsAccess::Get(target.element))
+				statistics->num_layout_formats += 1;
 
-	ApplyLayoutRecursive(element, root_node, offset_parent, parent_content_position);
+			layouts.push_back(BuildRootLayout(target.element, target.containing_block));
+		}
 
-	// Cleanup yoga tree.
-	YGNodeRemoveChild(wrapper, root_node);
-	YGNodeFreeRecursive(root_node);
-	YGNodeFree(wrapper);
-	YGConfigFree(config);
+		for (Element* boundary : layout_boundaries)
+		{
+			if (DocumentFrameStatistics* statistics = FrameStatisticsAccess::Get(boundary))
+				statistics->num_layout_formats += 1;
+
+			layouts.push_back(BuildLayoutBoundaryLayout(boundary));
+		}
+
+		CalculateAndApplyLayouts(layouts);
+	}
 
 	{
 		RMLUI_ZoneScopedN("ClampScrollOffsetRecursive");
@@ -699,8 +1173,11 @@ void LayoutEngine::FormatElement(Element* element, Vector2f containing_block)
 		// times, such as after enabling scrollbars. For this reason, we don't clamp the scroll offset during layouting,
 		// as that could inadvertently clamp it to a temporary size. Now that we know the final layout, including the
 		// size of each element's scrollable area, we can finally clamp the scroll offset.
-		element->ClampScrollOffsetRecursive();
+		for (const FormatTarget& target : targets)
+			target.element->ClampScrollOffsetRecursive();
+		for (Element* boundary : layout_boundaries)
+			boundary->ClampScrollOffsetRecursive();
 	}
 }
 
-} // namespace Rml
\ No newline at end of file
+} // namespace Rml
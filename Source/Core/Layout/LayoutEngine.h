@@ -4,16 +4,64 @@
 
 namespace Rml {
 
+struct ElementLayoutCache;
+
 /**
     See the CSS glossary for terms used in the layout engine:
     https://www.w3.org/TR/css-display-3/#glossary
  */
 class LayoutEngine {
 public:
+	struct NodePoolStats {
+		int num_allocated_nodes = 0; // Number of layout nodes currently allocated, both in use and free.
+		int high_water_mark = 0;     // Maximum number of layout nodes simultaneously in use by any layout so far.
+	};
+
+	struct FormatTarget {
+		Element* element;
+		Vector2f containing_block;
+	};
+
+	/// Initializes the pool of layout nodes reused between layouts.
+	/// @param[in] num_threads The number of worker threads used by FormatElements(), or zero to format everything on the calling thread.
+	/// @note When a task interface is installed, its threads are used instead of starting our own workers.
+	static void Initialize(int num_threads);
+	/// Releases all layout nodes and stops any worker threads, must not be called during layout.
+	static void Shutdown();
+
+	/// Returns statistics of the pool of layout nodes.
+	static NodePoolStats GetNodePoolStats();
+
 	/// Formats the contents for a root-level element, usually a document, or a replaced element with custom formatting.
 	/// @param[in] element The element to lay out.
 	/// @param[in] containing_block The size of the containing block.
 	static void FormatElement(Element* element, Vector2f containing_block);
+
+	/// Formats only the dirty parts of a previously formatted root-level element. Elements with dirty layout are reformatted from their nearest
+	/// layout boundary, that is, an ancestor whose size and position does not depend on its contents, such as one with a fixed width and height.
+	/// @param[in] element The root-level element, usually a document.
+	/// @return False if some dirty layout is not contained by any layout boundary, then nothing is formatted and the whole element must be
+	/// formatted instead.
+	static bool FormatDirtyLayoutBoundaries(Element* element);
+
+	/// Finds the dirty parts of a previously formatted root-level element that can be formatted from their nearest layout boundary.
+	/// @param[in] element The root-level element, usually a document.
+	/// @param[out] boundaries The layout boundaries to format are appended here.
+	/// @return False if some dirty layout is not contained by any layout boundary, then the whole element must be formatted instead.
+	static bool FindDirtyLayoutBoundaries(Element* element, Vector<Element*>& boundaries);
+
+	/// Formats several independent trees at once: root-level elements such as the documents of a context, and layout boundaries as found by
+	/// FindDirtyLayoutBoundaries(). The layouts are calculated concurrently when worker threads are available.
+	/// @param[in] targets The root-level elements to lay out.
+	/// @param[in] layout_boundaries The layout boundaries to format the contents of, none of them may be inside any other target.
+	static void FormatElements(const Vector<FormatTarget>& targets, const Vector<Element*>& layout_boundaries);
+
+	/// Returns the cache of sizes measured for the given element during previous layouts.
+	static ElementLayoutCache& GetLayoutCache(Element* element);
+
+private:
+	static bool CollectDirtyLayoutBoundaries(Element* element, Vector<Element*>& boundaries);
+	static void ClearDirtyLayout(Element* element);
 };
 
 } // namespace Rml
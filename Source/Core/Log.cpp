@@ -2,6 +2,7 @@
 #include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/StringUtilities.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "LogCapture.h"
 #include "LogDefault.h"
 #include <stdarg.h>
 #include <stdio.h>
@@ -24,6 +25,9 @@ void Log::Message(Log::Type type, const char* fmt, ...)
 	buffer[len] = '\0';
 	va_end(argument_list);
 
+	if (LogCapture::Capture(type, buffer))
+		return;
+
 	if (SystemInterface* system_interface = GetSystemInterface())
 		system_interface->LogMessage(type, buffer);
 	else
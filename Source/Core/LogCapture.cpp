@@ -0,0 +1,32 @@
+#include "LogCapture.h"
+
+namespace Rml {
+
+static thread_local CapturedLogMessageList* captured_messages = nullptr;
+
+LogCapture::LogCapture(CapturedLogMessageList& messages) : previous_messages(captured_messages)
+{
+	captured_messages = &messages;
+}
+
+LogCapture::~LogCapture()
+{
+	captured_messages = previous_messages;
+}
+
+bool LogCapture::Capture(Log::Type type, const char* message)
+{
+	if (!captured_messages)
+		return false;
+
+	captured_messages->push_back(CapturedLogMessage{type, message});
+	return true;
+}
+
+void LogCapture::Replay(const CapturedLogMessageList& messages)
+{
+	for (const CapturedLogMessage& captured : messages)
+		Log::Message(captured.type, "%s", captured.message.c_str());
+}
+
+} // namespace Rml
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Log.h"
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+struct CapturedLogMessage {
+	Log::Type type;
+	String message;
+};
+using CapturedLogMessageList = Vector<CapturedLogMessage>;
+
+/**
+    Captures the log messages of the calling thread while in scope, instead of passing them on to the system interface.
+
+    Lets work done on other threads report its messages from the main thread once complete, in a deterministic order.
+ */
+class LogCapture : NonCopyMoveable {
+public:
+	explicit LogCapture(CapturedLogMessageList& messages);
+	~LogCapture();
+
+	/// Stores the message if the calling thread is capturing its messages, otherwise returns false.
+	static bool Capture(Log::Type type, const char* message);
+
+	/// Logs the given captured messages, to be called from the main thread.
+	static void Replay(const CapturedLogMessageList& messages);
+
+private:
+	CapturedLogMessageList* previous_messages;
+};
+
+} // namespace Rml
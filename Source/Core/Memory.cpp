@@ -60,7 +60,8 @@ namespace Detail {
 
 	BasicStackAllocator& GetGlobalBasicStackAllocator()
 	{
-		static BasicStackAllocator stack_allocator(10 * 1024);
+		// One stack per thread, so that font effects and filters can generate their data concurrently.
+		static thread_local BasicStackAllocator stack_allocator(10 * 1024);
 		return stack_allocator;
 	}
 
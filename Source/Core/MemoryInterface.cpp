@@ -0,0 +1,32 @@
+#include "../../Include/RmlUi/Core/MemoryInterface.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/Debug.h"
+#include <new>
+
+namespace Rml {
+
+MemoryInterface::MemoryInterface() {}
+
+MemoryInterface::~MemoryInterface() {}
+
+void* Detail::Allocate(size_t size, size_t alignment)
+{
+	if (MemoryInterface* memory_interface = GetMemoryInterface())
+		return memory_interface->Allocate(size, alignment);
+
+	RMLUI_ASSERTMSG(alignment <= alignof(std::max_align_t), "Over-aligned allocations require a memory interface.");
+	return ::operator new(size);
+}
+
+void Detail::Deallocate(void* pointer, size_t size, size_t alignment)
+{
+	if (!pointer)
+		return;
+
+	if (MemoryInterface* memory_interface = GetMemoryInterface())
+		memory_interface->Deallocate(pointer, size, alignment);
+	else
+		::operator delete(pointer);
+}
+
+} // namespace Rml
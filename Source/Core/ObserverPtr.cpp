@@ -1,4 +1,5 @@
 #include "../../Include/RmlUi/Core/ObserverPtr.h"
+#include "../../Include/RmlUi/Core/MemoryStatistics.h"
 #include "Pool.h"
 
 namespace Rml {
@@ -48,6 +49,15 @@ void Detail::ShutdownObserverPtrPool()
 	}
 }
 
+MemoryPoolStats Detail::GetObserverPtrPoolStats()
+{
+	if (!observer_ptr_data)
+		return MemoryPoolStats{"ObserverPtrBlock"};
+
+	const Pool<ObserverPtrBlock>& pool = observer_ptr_data->block_pool;
+	return MemoryPoolStats{"ObserverPtrBlock", pool.GetNumAllocatedObjects(), pool.GetSize(), pool.GetReservedBytes()};
+}
+
 Detail::ObserverPtrBlock* Detail::AllocateObserverPtrBlock()
 {
 	return observer_ptr_data->block_pool.AllocateAndConstruct();
@@ -2,6 +2,7 @@
 
 #include "../../Include/RmlUi/Core/Debug.h"
 #include "../../Include/RmlUi/Core/Header.h"
+#include "../../Include/RmlUi/Core/MemoryInterface.h"
 #include "../../Include/RmlUi/Core/Traits.h"
 #include "../../Include/RmlUi/Core/Types.h"
 
@@ -87,6 +88,8 @@ public:
 	inline int GetNumChunks() const;
 	/// Returns the number of allocated objects in the pool.
 	inline int GetNumAllocatedObjects() const;
+	/// Returns the size of the memory reserved by all chunks of the pool.
+	inline size_t GetReservedBytes() const;
 
 private:
 	// Creates a new pool chunk and appends its nodes to the beginning of the free list.
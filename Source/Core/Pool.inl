@@ -26,8 +26,8 @@ Pool< PoolType >::~Pool()
 	{
 		PoolChunk* next_chunk = chunk->next;
 
-		delete[] chunk->chunk;
-		delete chunk;
+		Detail::Deallocate(chunk->chunk, sizeof(PoolNode) * chunk_size, alignof(PoolNode));
+		Detail::Deallocate(chunk, sizeof(PoolChunk), alignof(PoolChunk));
 
 		chunk = next_chunk;
 	}
@@ -197,6 +197,13 @@ int Pool< PoolType >::GetNumAllocatedObjects() const
 	return num_allocated_objects;
 }
 
+// Returns the size of the memory reserved by all chunks of the pool.
+template < typename PoolType >
+size_t Pool< PoolType >::GetReservedBytes() const
+{
+	return size_t(GetSize()) * sizeof(PoolNode);
+}
+
 // Creates a new pool chunk and appends its nodes to the beginning of the free list.
 template < typename PoolType >
 void Pool< PoolType >::CreateChunk()
@@ -205,12 +212,14 @@ void Pool< PoolType >::CreateChunk()
 		return;
 
 	// Create the new chunk and mark it as the first chunk.
-	PoolChunk* new_chunk = new PoolChunk();
+	PoolChunk* new_chunk = new (Detail::Allocate(sizeof(PoolChunk), alignof(PoolChunk))) PoolChunk();
 	new_chunk->next = pool;
 	pool = new_chunk;
 
 	// Create chunk's pool nodes.
-	new_chunk->chunk = new PoolNode[chunk_size];
+	new_chunk->chunk = static_cast<PoolNode*>(Detail::Allocate(sizeof(PoolNode) * chunk_size, alignof(PoolNode)));
+	for (int i = 0; i < chunk_size; i++)
+		new (&new_chunk->chunk[i]) PoolNode;
 
 	// Initialise the linked list.
 	for (int i = 0; i < chunk_size; i++)
@@ -0,0 +1,299 @@
+#include "../../Include/RmlUi/Core/Profiler.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/ElementDocument.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
+#include <algorithm>
+#include <chrono>
+
+namespace Rml {
+namespace Profiler {
+
+static constexpr int FrameHistorySize = 120;
+static constexpr int NumTopElements = 10;
+
+namespace {
+	struct ZoneAccumulator {
+		double total_time = 0;
+		double self_time = 0;
+		int count = 0;
+	};
+	struct PhaseTimes {
+		double times[size_t(ProfilerPhase::Count)] = {};
+	};
+
+	struct ProfilerData {
+		bool enabled = false;
+		double previous_mark_time = -1;
+
+		Vector<const Zone*> zones;
+		Vector<ZoneAccumulator> zone_accumulators;
+		ZoneScope* current_zone = nullptr;
+
+		PhaseTimes phase_times;
+		UnorderedMap<Element*, double> element_times;
+		UnorderedMap<ElementDocument*, PhaseTimes> document_times;
+		ElementScope* current_element = nullptr;
+
+		// Ring buffer of frame timings, 'next_frame' is the slot written next.
+		Array<FrameTiming, FrameHistorySize> frames = {};
+		int next_frame = 0;
+		int num_frames = 0;
+
+		FrameBreakdown last_frame = {};
+	};
+
+	ProfilerData& GetData()
+	{
+		static ProfilerData data;
+		return data;
+	}
+
+	double GetTime()
+	{
+		using namespace std::chrono;
+		return duration<double>(steady_clock::now().time_since_epoch()).count();
+	}
+
+	String GetDocumentName(ElementDocument* document)
+	{
+		const String& source_url = document->GetSourceURL();
+		if (!source_url.empty())
+		{
+			const size_t i_slash = source_url.find_last_of("/\\");
+			return (i_slash == String::npos ? source_url : source_url.substr(i_slash + 1));
+		}
+		if (!document->GetId().empty())
+			return "#" + document->GetId();
+		return document->GetTagName();
+	}
+} // namespace
+
+bool IsAvailable()
+{
+#ifdef RMLUI_BUILTIN_PROFILING
+	return true;
+#else
+	return false;
+#endif
+}
+
+void SetEnabled(bool enabled)
+{
+	ProfilerData& data = GetData();
+	if (data.enabled == enabled)
+		return;
+
+	data.enabled = enabled;
+	data.previous_mark_time = -1;
+	data.phase_times = {};
+	data.element_times.clear();
+	data.document_times.clear();
+	for (ZoneAccumulator& accumulator : data.zone_accumulators)
+		accumulator = {};
+}
+
+bool IsEnabled()
+{
+	return GetData().enabled;
+}
+
+void MarkFrame()
+{
+	ProfilerData& data = GetData();
+	if (!data.enabled)
+		return;
+
+	const double time = GetTime();
+	const bool first_mark = (data.previous_mark_time < 0);
+	const double frame_time = (first_mark ? 0.0 : time - data.previous_mark_time);
+	data.previous_mark_time = time;
+
+	// Results before the first mark only cover a partial frame, discard them.
+	if (!first_mark)
+	{
+		FrameBreakdown& breakdown = data.last_frame;
+		breakdown.timing.frame_time = frame_time;
+		std::copy(std::begin(data.phase_times.times), std::end(data.phase_times.times), breakdown.timing.phase_times);
+
+		data.frames[data.next_frame] = breakdown.timing;
+		data.next_frame = (data.next_frame + 1) % FrameHistorySize;
+		data.num_frames = Math::Min(data.num_frames + 1, FrameHistorySize);
+
+		breakdown.zones.clear();
+		for (size_t i = 0; i < data.zones.size(); i++)
+		{
+			const ZoneAccumulator& accumulator = data.zone_accumulators[i];
+			if (accumulator.count > 0)
+				breakdown.zones.push_back(ZoneTiming{data.zones[i]->name, accumulator.total_time, accumulator.self_time, accumulator.count});
+		}
+		std::sort(breakdown.zones.begin(), breakdown.zones.end(), [](const ZoneTiming& a, const ZoneTiming& b) { return a.self_time > b.self_time; });
+
+		breakdown.documents.clear();
+		for (const auto& document_times : data.document_times)
+		{
+			DocumentTiming timing;
+			timing.name = GetDocumentName(document_times.first);
+			std::copy(std::begin(document_times.second.times), std::end(document_times.second.times), timing.phase_times);
+			breakdown.documents.push_back(std::move(timing));
+		}
+		std::sort(breakdown.documents.begin(), breakdown.documents.end(),
+			[](const DocumentTiming& a, const DocumentTiming& b) { return a.name < b.name; });
+
+		// Only the addresses of the most expensive elements are looked up.
+		Vector<std::pair<Element*, double>> elements;
+		elements.reserve(data.element_times.size());
+		for (const auto& element_time : data.element_times)
+			elements.emplace_back(element_time.first, element_time.second);
+		const size_t num_elements = Math::Min(elements.size(), size_t(NumTopElements));
+		std::partial_sort(elements.begin(), elements.begin() + num_elements, elements.end(),
+			[](const std::pair<Element*, double>& a, const std::pair<Element*, double>& b) { return a.second > b.second; });
+
+		breakdown.elements.clear();
+		for (size_t i = 0; i < num_elements; i++)
+		{
+			Element* element = elements[i].first;
+			ElementDocument* document = element->GetOwnerDocument();
+			breakdown.elements.push_back(ElementTiming{element->GetAddress(false, false), document ? GetDocumentName(document) : String(), elements[i].second});
+		}
+	}
+
+	data.phase_times = {};
+	data.element_times.clear();
+	data.document_times.clear();
+	for (ZoneAccumulator& accumulator : data.zone_accumulators)
+		accumulator = {};
+}
+
+Vector<FrameTiming> GetFrameHistory()
+{
+	const ProfilerData& data = GetData();
+	Vector<FrameTiming> result;
+	result.reserve(data.num_frames);
+	for (int i = 0; i < data.num_frames; i++)
+		result.push_back(data.frames[(data.next_frame - data.num_frames + i + FrameHistorySize) % FrameHistorySize]);
+	return result;
+}
+
+const FrameBreakdown& GetLastFrame()
+{
+	return GetData().last_frame;
+}
+
+void Clear()
+{
+	ProfilerData& data = GetData();
+	data.previous_mark_time = -1;
+	data.phase_times = {};
+	data.element_times.clear();
+	data.document_times.clear();
+	for (ZoneAccumulator& accumulator : data.zone_accumulators)
+		accumulator = {};
+	data.next_frame = 0;
+	data.num_frames = 0;
+	data.last_frame = {};
+}
+
+ZoneScope::ZoneScope(Zone& zone) : zone_index(-1), start_time(0), nested_time(0), parent(nullptr)
+{
+	ProfilerData& data = GetData();
+	if (!data.enabled)
+		return;
+
+	if (zone.index < 0)
+	{
+		zone.index = (int)data.zones.size();
+		data.zones.push_back(&zone);
+		data.zone_accumulators.emplace_back();
+	}
+
+	zone_index = zone.index;
+	parent = data.current_zone;
+	data.current_zone = this;
+	start_time = GetTime();
+}
+
+ZoneScope::~ZoneScope()
+{
+	if (zone_index < 0)
+		return;
+
+	ProfilerData& data = GetData();
+	const double time = GetTime() - start_time;
+
+	ZoneAccumulator& accumulator = data.zone_accumulators[zone_index];
+	accumulator.total_time += time;
+	accumulator.self_time += time - nested_time;
+	accumulator.count += 1;
+
+	if (parent)
+		parent->nested_time += time;
+	data.current_zone = parent;
+}
+
+PhaseScope::PhaseScope(ProfilerPhase phase) : phase(phase), start_time(-1)
+{
+	if (GetData().enabled)
+		start_time = GetTime();
+}
+
+PhaseScope::~PhaseScope()
+{
+	if (start_time >= 0)
+		GetData().phase_times.times[size_t(phase)] += GetTime() - start_time;
+}
+
+ElementScope::ElementScope(Element* element, ProfilerPhase phase) :
+	element(nullptr), document(nullptr), phase(phase), start_time(-1), nested_time(0), parent(nullptr)
+{
+	ProfilerData& data = GetData();
+	if (!data.enabled)
+		return;
+
+	this->element = element;
+	document = element->GetOwnerDocument();
+	parent = data.current_element;
+	data.current_element = this;
+	start_time = GetTime();
+}
+
+ElementScope::~ElementScope()
+{
+	if (start_time < 0)
+		return;
+
+	ProfilerData& data = GetData();
+	const double time = GetTime() - start_time;
+	const double self_time = time - nested_time;
+
+	// The element or its document may have been destroyed while in scope.
+	if (element)
+		data.element_times[element] += self_time;
+	if (document)
+		data.document_times[static_cast<ElementDocument*>(document)].times[size_t(phase)] += self_time;
+
+	if (parent)
+		parent->nested_time += time;
+	data.current_element = parent;
+}
+
+void OnElementDestroy(Element* element)
+{
+	ProfilerData& data = GetData();
+	for (ElementScope* scope = data.current_element; scope; scope = scope->parent)
+	{
+		if (scope->element == element)
+			scope->element = nullptr;
+		if (scope->document == element)
+			scope->document = nullptr;
+	}
+
+	if (data.element_times.empty() && data.document_times.empty())
+		return;
+
+	data.element_times.erase(element);
+	if (ElementDocument* document = rmlui_dynamic_cast<ElementDocument*>(element))
+		data.document_times.erase(document);
+}
+
+} // namespace Profiler
+} // namespace Rml
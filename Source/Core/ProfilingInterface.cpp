@@ -0,0 +1,38 @@
+#include "../../Include/RmlUi/Core/ProfilingInterface.h"
+#include "../../Include/RmlUi/Core/Core.h"
+
+namespace Rml {
+
+ProfilingInterface::ProfilingInterface() {}
+
+ProfilingInterface::~ProfilingInterface() {}
+
+void ProfilingInterface::SetCounter(const char* /*name*/, double /*value*/) {}
+
+void ProfilingInterface::MarkFrame(const char* /*name*/) {}
+
+ProfilingInterfaceZone::ProfilingInterfaceZone(const char* name) : profiling_interface(GetProfilingInterface())
+{
+	if (profiling_interface)
+		profiling_interface->BeginZone(name);
+}
+
+ProfilingInterfaceZone::~ProfilingInterfaceZone()
+{
+	if (profiling_interface)
+		profiling_interface->EndZone();
+}
+
+void ProfilingInterfaceSetCounter(const char* name, double value)
+{
+	if (ProfilingInterface* profiling_interface = GetProfilingInterface())
+		profiling_interface->SetCounter(name, value);
+}
+
+void ProfilingInterfaceMarkFrame(const char* name)
+{
+	if (ProfilingInterface* profiling_interface = GetProfilingInterface())
+		profiling_interface->MarkFrame(name);
+}
+
+} // namespace Rml
@@ -53,6 +53,7 @@ PropertyDefinition& PropertyDefinition::AddParser(const String& parser_name, con
 
 	const int parser_index = (int)parsers.size();
 	parsers.push_back(new_parser);
+	units = units | new_parser.parser->GetUnits();
 
 	// If the default value has not been parsed successfully yet, run it through the new parser.
 	if (default_value.unit == Unit::UNKNOWN)
@@ -154,6 +155,11 @@ RelativeTarget PropertyDefinition::GetRelativeTarget() const
 	return relative_target;
 }
 
+Units PropertyDefinition::GetUnits() const
+{
+	return units;
+}
+
 PropertyId PropertyDefinition::GetId() const
 {
 	return id;
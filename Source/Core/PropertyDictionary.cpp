@@ -8,7 +8,12 @@ PropertyDictionary::PropertyDictionary() {}
 void PropertyDictionary::SetProperty(PropertyId id, const Property& property)
 {
 	RMLUI_ASSERT(id != PropertyId::Invalid);
-	properties[id] = property;
+	// Assign or emplace rather than using operator[], as the property may refer to an entry which is moved by the insertion.
+	PropertyMap::iterator iterator = properties.find(id);
+	if (iterator != properties.end())
+		iterator->second = property;
+	else
+		properties.emplace(id, property);
 }
 
 void PropertyDictionary::RemoveProperty(PropertyId id)
@@ -38,6 +43,17 @@ const PropertyMap& PropertyDictionary::GetProperties() const
 
 void PropertyDictionary::Import(const PropertyDictionary& other, int property_specificity)
 {
+	if (properties.empty())
+	{
+		properties = other.properties;
+		if (property_specificity > 0)
+		{
+			for (auto& pair : properties)
+				pair.second.specificity = property_specificity;
+		}
+		return;
+	}
+
 	for (const auto& pair : other.properties)
 	{
 		const PropertyId id = pair.first;
@@ -48,6 +64,17 @@ void PropertyDictionary::Import(const PropertyDictionary& other, int property_sp
 
 void PropertyDictionary::Merge(const PropertyDictionary& other, int specificity_offset)
 {
+	if (properties.empty())
+	{
+		properties = other.properties;
+		if (specificity_offset != 0)
+		{
+			for (auto& pair : properties)
+				pair.second.specificity += specificity_offset;
+		}
+		return;
+	}
+
 	for (const auto& pair : other.properties)
 	{
 		const PropertyId id = pair.first;
@@ -65,11 +92,18 @@ void PropertyDictionary::SetSourceOfAllProperties(const SharedPtr<const Property
 void PropertyDictionary::SetProperty(PropertyId id, const Property& property, int specificity)
 {
 	PropertyMap::iterator iterator = properties.find(id);
-	if (iterator != properties.end() && iterator->second.specificity > specificity)
-		return;
+	if (iterator != properties.end())
+	{
+		if (iterator->second.specificity > specificity)
+			return;
+		iterator->second = property;
+	}
+	else
+	{
+		iterator = properties.emplace(id, property).first;
+	}
 
-	Property& new_property = (properties[id] = property);
-	new_property.specificity = specificity;
+	iterator->second.specificity = specificity;
 }
 
 } // namespace Rml
@@ -147,6 +147,60 @@ void PropertyParserColour::Shutdown()
 	parser_data.Shutdown();
 }
 
+// Parses 'rgb' and 'rgba' colours with plain comma-separated components, such as 'rgba(255, 128, 0, 50%)', without allocating. Returns false
+// for any other form, which is then handled by the general parser.
+static bool ParseSimpleRGBColour(Colourb& colour, const String& value)
+{
+	const size_t begin_values = value.find('(');
+	const size_t end_values = value.rfind(')');
+	if (begin_values == String::npos || end_values == String::npos || end_values < begin_values)
+		return false;
+
+	const int num_components = (value.size() > 3 && value[3] == 'a' ? 4 : 3);
+	const char* p = value.c_str() + begin_values + 1;
+	const char* const p_end = value.c_str() + end_values;
+
+	Colourb result;
+	for (int i = 0; i < num_components; i++)
+	{
+		while (p != p_end && StringUtilities::IsWhitespace(*p))
+			p++;
+
+		const char* const number_begin = p;
+		while (p != p_end && ((*p >= '0' && *p <= '9') || *p == '.'))
+			p++;
+		if (p == number_begin)
+			return false;
+
+		const bool is_percentage = (p != p_end && *p == '%');
+		if (is_percentage)
+			p++;
+
+		while (p != p_end && StringUtilities::IsWhitespace(*p))
+			p++;
+
+		// Every component except the last one is followed by a comma.
+		if (i == num_components - 1)
+		{
+			if (p != p_end)
+				return false;
+		}
+		else
+		{
+			if (p == p_end || *p != ',')
+				return false;
+			p++;
+		}
+
+		// The conversions stop at the end of the number.
+		const int component = (is_percentage ? int((float)atof(number_begin) * (255.0f / 100.0f)) : atoi(number_begin));
+		result[i] = (byte)(Math::Clamp(component, 0, 255));
+	}
+
+	colour = result;
+	return true;
+}
+
 PropertyParserColour::PropertyParserColour() {}
 
 PropertyParserColour::~PropertyParserColour() {}
@@ -163,6 +217,11 @@ bool PropertyParserColour::ParseValue(Property& property, const String& value, c
 	return true;
 }
 
+Units PropertyParserColour::GetUnits() const
+{
+	return Unit::COLOUR;
+}
+
 bool PropertyParserColour::ParseColour(Colourb& colour, const String& value)
 {
 	if (value.empty())
@@ -175,30 +234,31 @@ bool PropertyParserColour::ParseColour(Colourb& colour, const String& value)
 		if (!ParseHexColour(colour, value))
 			return false;
 	}
-	else if (value.substr(0, 3) == "rgb")
+	else if (value.compare(0, 3, "rgb") == 0)
 	{
 		if (!ParseRGBColour(colour, value))
 			return false;
 	}
-	else if (value.substr(0, 3) == "hsl")
+	else if (value.compare(0, 3, "hsl") == 0)
 	{
 		if (!ParseHSLColour(colour, value))
 			return false;
 	}
-	else if (value.substr(0, 3) == "lab" || value.substr(0, 3) == "lch")
+	else if (value.compare(0, 3, "lab") == 0 || value.compare(0, 3, "lch") == 0)
 	{
 		if (!ParseCIELABColour(colour, value))
 			return false;
 	}
-	else if (value.substr(0, 5) == "oklab" || value.substr(0, 5) == "oklch")
+	else if (value.compare(0, 5, "oklab") == 0 || value.compare(0, 5, "oklch") == 0)
 	{
 		if (!ParseOklabColour(colour, value))
 			return false;
 	}
 	else
 	{
-		// Check for the specification of an HTML colour.
-		auto it = parser_data->html_colours.find(StringUtilities::ToLower(value));
+		// Check for the specification of an HTML colour, only making a lowercase copy of the name when needed.
+		const bool is_lowercase = std::none_of(value.begin(), value.end(), [](char c) { return c >= 'A' && c <= 'Z'; });
+		auto it = (is_lowercase ? parser_data->html_colours.find(value) : parser_data->html_colours.find(StringUtilities::ToLower(value)));
 		if (it == parser_data->html_colours.end())
 			return false;
 		else
@@ -252,6 +312,9 @@ bool PropertyParserColour::ParseHexColour(Colourb& colour, const String& value)
 
 bool PropertyParserColour::ParseRGBColour(Colourb& colour, const String& value)
 {
+	if (ParseSimpleRGBColour(colour, value))
+		return true;
+
 	StringList values;
 	values.reserve(4);
 	if (!GetColourFunctionValues(values, value, true))
@@ -21,6 +21,7 @@ public:
 	/// @param[in] parameters The parameters defined for this property; not used for this parser.
 	/// @return True if the value was parsed successfully, false otherwise.
 	bool ParseValue(Property& property, const String& value, const ParameterMap& parameters) const override;
+	Units GetUnits() const override;
 
 	/// Parse a colour directly.
 	static bool ParseColour(Colourb& colour, const String& value);
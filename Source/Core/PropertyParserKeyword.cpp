@@ -1,4 +1,5 @@
 #include "PropertyParserKeyword.h"
+#include <algorithm>
 
 namespace Rml {
 
@@ -8,7 +9,9 @@ PropertyParserKeyword::~PropertyParserKeyword() {}
 
 bool PropertyParserKeyword::ParseValue(Property& property, const String& value, const ParameterMap& parameters) const
 {
-	ParameterMap::const_iterator iterator = parameters.find(StringUtilities::ToLower(value));
+	// Keywords are usually written in lowercase already, then look them up without making a lowercase copy.
+	const bool is_lowercase = std::none_of(value.begin(), value.end(), [](char c) { return c >= 'A' && c <= 'Z'; });
+	ParameterMap::const_iterator iterator = (is_lowercase ? parameters.find(value) : parameters.find(StringUtilities::ToLower(value)));
 	if (iterator == parameters.end())
 		return false;
 
@@ -18,4 +21,9 @@ bool PropertyParserKeyword::ParseValue(Property& property, const String& value,
 	return true;
 }
 
+Units PropertyParserKeyword::GetUnits() const
+{
+	return Unit::KEYWORD;
+}
+
 } // namespace Rml
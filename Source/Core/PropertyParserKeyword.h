@@ -19,6 +19,7 @@ public:
 	/// @param[in] parameters The parameters defined for this property.
 	/// @return True if the value was validated successfully, false otherwise.
 	bool ParseValue(Property& property, const String& value, const ParameterMap& parameters) const override;
+	Units GetUnits() const override;
 };
 
 } // namespace Rml
@@ -1,39 +1,42 @@
 #include "PropertyParserNumber.h"
 #include <stdlib.h>
+#include <string.h>
 
 namespace Rml {
 
-struct PropertyParserNumberData {
-	const UnorderedMap<String, Unit> unit_string_map = {
-		{"", Unit::NUMBER},
-		{"%", Unit::PERCENT},
-		{"px", Unit::PX},
-		{"dp", Unit::DP},
-		{"x", Unit::X},
-		{"vw", Unit::VW},
-		{"vh", Unit::VH},
-		{"em", Unit::EM},
-		{"rem", Unit::REM},
-		{"in", Unit::INCH},
-		{"cm", Unit::CM},
-		{"mm", Unit::MM},
-		{"pt", Unit::PT},
-		{"pc", Unit::PC},
-		{"deg", Unit::DEG},
-		{"rad", Unit::RAD},
-	};
+struct UnitName {
+	const char* name;
+	Unit unit;
 };
 
-ControlledLifetimeResource<PropertyParserNumberData> PropertyParserNumber::parser_data;
-
-void PropertyParserNumber::Initialize()
-{
-	parser_data.Initialize();
-}
+static const UnitName unit_names[] = {
+	{"", Unit::NUMBER},
+	{"%", Unit::PERCENT},
+	{"px", Unit::PX},
+	{"dp", Unit::DP},
+	{"x", Unit::X},
+	{"vw", Unit::VW},
+	{"vh", Unit::VH},
+	{"em", Unit::EM},
+	{"rem", Unit::REM},
+	{"in", Unit::INCH},
+	{"cm", Unit::CM},
+	{"mm", Unit::MM},
+	{"pt", Unit::PT},
+	{"pc", Unit::PC},
+	{"deg", Unit::DEG},
+	{"rad", Unit::RAD},
+};
 
-void PropertyParserNumber::Shutdown()
+// Returns the unit of the given case-insensitive name, or Unit::UNKNOWN if there is no such unit.
+static Unit FindUnit(const StringView name)
 {
-	parser_data.Shutdown();
+	for (const UnitName& unit_name : unit_names)
+	{
+		if (StringUtilities::StringCompareCaseInsensitive(name, StringView(unit_name.name, unit_name.name + strlen(unit_name.name))))
+			return unit_name.unit;
+	}
+	return Unit::UNKNOWN;
 }
 
 PropertyParserNumber::PropertyParserNumber(Units units, Unit zero_unit) : units(units), zero_unit(zero_unit) {}
@@ -54,26 +57,29 @@ bool PropertyParserNumber::ParseValue(Property& property, const String& value, c
 		}
 	}
 
-	String str_number = value.substr(0, unit_pos);
-	String str_unit = StringUtilities::ToLower(value.substr(unit_pos));
-
+	// Convert the number in place, only copying it out in the rare case where the conversion would continue into the unit.
 	char* str_end = nullptr;
-	float float_value = strtof(str_number.c_str(), &str_end);
-	if (str_number.c_str() == str_end)
+	float float_value = strtof(value.c_str(), &str_end);
+	bool converted = (str_end != value.c_str());
+	if (str_end > value.c_str() + unit_pos)
+	{
+		const String str_number = value.substr(0, unit_pos);
+		float_value = strtof(str_number.c_str(), &str_end);
+		converted = (str_end != str_number.c_str());
+	}
+	if (!converted)
 	{
 		// Number conversion failed
 		return false;
 	}
 
-	const auto it = parser_data->unit_string_map.find(str_unit);
-	if (it == parser_data->unit_string_map.end())
+	const Unit unit = FindUnit(StringView(value, unit_pos));
+	if (unit == Unit::UNKNOWN)
 	{
 		// Invalid unit name
 		return false;
 	}
 
-	const Unit unit = it->second;
-
 	if (Any(unit & units))
 	{
 		property.value = float_value;
@@ -96,4 +102,9 @@ bool PropertyParserNumber::ParseValue(Property& property, const String& value, c
 	return false;
 }
 
+Units PropertyParserNumber::GetUnits() const
+{
+	return units | zero_unit;
+}
+
 } // namespace Rml
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "../../Include/RmlUi/Core/PropertyParser.h"
-#include "ControlledLifetimeResource.h"
 
 namespace Rml {
 
@@ -20,13 +19,9 @@ public:
 	/// @param[in] parameters The parameters defined for this property.
 	/// @return True if the value was validated successfully, false otherwise.
 	bool ParseValue(Property& property, const String& value, const ParameterMap& parameters) const override;
-
-	static void Initialize();
-	static void Shutdown();
+	Units GetUnits() const override;
 
 private:
-	static ControlledLifetimeResource<struct PropertyParserNumberData> parser_data;
-
 	// Stores a bit mask of allowed units.
 	Units units;
 
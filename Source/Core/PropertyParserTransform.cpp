@@ -154,6 +154,11 @@ bool PropertyParserTransform::ParseValue(Property& property, const String& value
 	return true;
 }
 
+Units PropertyParserTransform::GetUnits() const
+{
+	return Unit::TRANSFORM;
+}
+
 bool PropertyParserTransform::Scan(int& out_bytes_read, const char* str, const char* keyword, const PropertyParser** parsers, NumericValue* args,
 	int nargs) const
 {
@@ -4,18 +4,52 @@
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/PropertyDefinition.h"
 #include "../../Include/RmlUi/Core/PropertyDictionary.h"
+#include "../../Include/RmlUi/Core/Utilities.h"
 #include "IdNameMap.h"
 #include "PropertyShorthandDefinition.h"
+#include "StyleSheetParser.h"
 #include <algorithm>
 #include <limits.h>
 #include <stdint.h>
 
 namespace Rml {
 
+// Each combination of property and value maps to a single entry, which holds the most recently parsed value among those mapping to it.
+struct PropertyValueCache {
+	struct Entry {
+		PropertyId id = PropertyId::Invalid;
+		String value;
+		Property property;
+	};
+
+	static constexpr size_t NumEntries = 256;
+	// Longer values are rarely repeated, and are not worth storing.
+	static constexpr size_t MaxValueLength = 64;
+
+	// Only plain values are stored, values of other units may hold shared objects such as decorators and transforms.
+	static bool IsStoredUnit(Unit unit) { return Any(unit & (Unit::NUMERIC | Unit::KEYWORD | Unit::STRING | Unit::COLOUR)); }
+
+	Entry& GetEntry(PropertyId id, const String& value)
+	{
+		size_t hash = Hash<String>()(value);
+		Utilities::HashCombine(hash, id);
+		return entries[hash % NumEntries];
+	}
+
+	void Clear()
+	{
+		for (Entry& entry : entries)
+			entry.id = PropertyId::Invalid;
+	}
+
+	Array<Entry, NumEntries> entries;
+};
+
 PropertySpecification::PropertySpecification(size_t reserve_num_properties, size_t reserve_num_shorthands) :
 	// Increment reserve numbers by one because the 'invalid' property occupies the first element
 	properties(reserve_num_properties + 1), shorthands(reserve_num_shorthands + 1),
-	property_map(MakeUnique<PropertyIdNameMap>(reserve_num_properties + 1)), shorthand_map(MakeUnique<ShorthandIdNameMap>(reserve_num_shorthands + 1))
+	property_map(MakeUnique<PropertyIdNameMap>(reserve_num_properties + 1)),
+	shorthand_map(MakeUnique<ShorthandIdNameMap>(reserve_num_shorthands + 1)), value_cache(MakeUnique<PropertyValueCache>())
 {}
 
 PropertySpecification::~PropertySpecification() {}
@@ -23,6 +57,9 @@ PropertySpecification::~PropertySpecification() {}
 PropertyDefinition& PropertySpecification::RegisterProperty(const String& property_name, const String& default_value, bool inherited,
 	bool forces_layout, PropertyId id)
 {
+	// The parsers of the property may change.
+	value_cache->Clear();
+
 	if (id == PropertyId::Invalid)
 		id = property_map->GetOrCreateId(property_name);
 	else
@@ -219,6 +256,16 @@ bool PropertySpecification::ParsePropertyDeclaration(PropertyDictionary& diction
 	if (!property_definition)
 		return false;
 
+	// The same values are often parsed repeatedly, such as from inline styles and properties set every frame. The cache is shared, thus it is
+	// bypassed while parsing concurrently.
+	const bool use_cache = !StyleSheetParser::IsParsingConcurrently();
+	PropertyValueCache::Entry& cache_entry = value_cache->GetEntry(property_id, property_value);
+	if (use_cache && cache_entry.id == property_id && cache_entry.value == property_value)
+	{
+		dictionary.SetProperty(property_id, cache_entry.property);
+		return true;
+	}
+
 	StringList property_values;
 	ParsePropertyValues(property_values, property_value, SplitOption::None);
 	if (property_values.empty())
@@ -228,6 +275,13 @@ bool PropertySpecification::ParsePropertyDeclaration(PropertyDictionary& diction
 	if (!property_definition->ParseValue(new_property, property_values[0]))
 		return false;
 
+	if (use_cache && property_value.size() <= PropertyValueCache::MaxValueLength && PropertyValueCache::IsStoredUnit(new_property.unit))
+	{
+		cache_entry.id = property_id;
+		cache_entry.value = property_value;
+		cache_entry.property = new_property;
+	}
+
 	dictionary.SetProperty(property_id, new_property);
 	return true;
 }
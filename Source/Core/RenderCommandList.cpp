@@ -0,0 +1,431 @@
+#include "../../Include/RmlUi/Core/RenderCommandList.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include <utility>
+
+namespace Rml {
+
+void RenderCommandList::Clear()
+{
+	commands.clear();
+	vertices.clear();
+	indices.clear();
+	texture_data.clear();
+	translations.clear();
+	transforms.clear();
+	filter_handles.clear();
+	names.clear();
+	parameters.clear();
+}
+
+Span<const Vertex> RenderCommandList::GetVertices(const RenderCommand& command) const
+{
+	return {vertices.data() + command.data_offset, (size_t)command.data_size};
+}
+
+Span<const int> RenderCommandList::GetIndices(const RenderCommand& command) const
+{
+	return {indices.data() + command.index_offset, (size_t)command.index_size};
+}
+
+Span<const byte> RenderCommandList::GetTextureData(const RenderCommand& command) const
+{
+	return {texture_data.data() + command.data_offset, (size_t)command.data_size};
+}
+
+Span<const Vector2f> RenderCommandList::GetTranslations(const RenderCommand& command) const
+{
+	return {translations.data() + command.data_offset, (size_t)command.data_size};
+}
+
+const Matrix4f* RenderCommandList::GetTransform(const RenderCommand& command) const
+{
+	return command.value ? &transforms[command.data_offset] : nullptr;
+}
+
+Span<const uintptr_t> RenderCommandList::GetFilters(const RenderCommand& command) const
+{
+	return {filter_handles.data() + command.data_offset, (size_t)command.data_size};
+}
+
+const String& RenderCommandList::GetName(const RenderCommand& command) const
+{
+	return names[command.data_offset];
+}
+
+const Dictionary& RenderCommandList::GetParameters(const RenderCommand& command) const
+{
+	return parameters[command.data_offset];
+}
+
+size_t RenderCommandList::GetReservedBytes() const
+{
+	return commands.capacity() * sizeof(RenderCommand) + vertices.capacity() * sizeof(Vertex) + indices.capacity() * sizeof(int) +
+		texture_data.capacity() + translations.capacity() * sizeof(Vector2f) + transforms.capacity() * sizeof(Matrix4f) +
+		filter_handles.capacity() * sizeof(uintptr_t) + names.capacity() * sizeof(String) + parameters.capacity() * sizeof(Dictionary);
+}
+
+RenderCommandRecorder::RenderCommandRecorder(RenderInterface& target) : target(target) {}
+
+RenderCommandRecorder::~RenderCommandRecorder() {}
+
+void RenderCommandRecorder::SwapCommands(RenderCommandList& in_out_list)
+{
+	in_out_list.Clear();
+	std::swap(list, in_out_list);
+}
+
+RenderCommand& RenderCommandRecorder::AddCommand(RenderCommandType type)
+{
+	list.commands.push_back(RenderCommand{type, 0, {}, {}, {}, 0, 0, 0, 0});
+	return list.commands.back();
+}
+
+uintptr_t RenderCommandRecorder::NewHandle()
+{
+	return next_handle++;
+}
+
+CompiledGeometryHandle RenderCommandRecorder::CompileGeometry(Span<const Vertex> vertices, Span<const int> indices)
+{
+	// The mesh may be released before the list is replayed, thus copy its data.
+	RenderCommand& command = AddCommand(RenderCommandType::CompileGeometry);
+	command.handles[0] = NewHandle();
+	command.data_offset = (int)list.vertices.size();
+	command.data_size = (int)vertices.size();
+	command.index_offset = (int)list.indices.size();
+	command.index_size = (int)indices.size();
+	list.vertices.insert(list.vertices.end(), vertices.begin(), vertices.end());
+	list.indices.insert(list.indices.end(), indices.begin(), indices.end());
+	return command.handles[0];
+}
+
+void RenderCommandRecorder::RenderGeometry(CompiledGeometryHandle geometry, Vector2f translation, TextureHandle texture)
+{
+	RenderCommand& command = AddCommand(RenderCommandType::RenderGeometry);
+	command.handles[0] = geometry;
+	command.handles[1] = texture;
+	command.translation = translation;
+}
+
+void RenderCommandRecorder::ReleaseGeometry(CompiledGeometryHandle geometry)
+{
+	AddCommand(RenderCommandType::ReleaseGeometry).handles[0] = geometry;
+}
+
+TextureHandle RenderCommandRecorder::LoadTexture(Vector2i& texture_dimensions, const String& source)
+{
+	// The dimensions are needed right away, thus the texture is read now and generated from its data during replay.
+	Vector<byte> data;
+	if (target.LoadTextureData(data, texture_dimensions, source))
+		return GenerateTexture(data, texture_dimensions);
+
+	// Only interfaces unable to read the data end up here, the texture is then loaded directly on the recording thread.
+	const TextureHandle texture = target.LoadTexture(texture_dimensions, source);
+	if (!texture)
+		return {};
+
+	RenderCommand& command = AddCommand(RenderCommandType::AdoptTexture);
+	command.handles[0] = NewHandle();
+	command.handles[1] = texture;
+	return command.handles[0];
+}
+
+TextureHandle RenderCommandRecorder::GenerateTexture(Span<const byte> source, Vector2i source_dimensions)
+{
+	RenderCommand& command = AddCommand(RenderCommandType::GenerateTexture);
+	command.handles[0] = NewHandle();
+	command.region = Rectanglei::FromSize(source_dimensions);
+	command.data_offset = (int)list.texture_data.size();
+	command.data_size = (int)source.size();
+	list.texture_data.insert(list.texture_data.end(), source.begin(), source.end());
+	return command.handles[0];
+}
+
+void RenderCommandRecorder::ReleaseTexture(TextureHandle texture)
+{
+	AddCommand(RenderCommandType::ReleaseTexture).handles[0] = texture;
+}
+
+void RenderCommandRecorder::EnableScissorRegion(bool enable)
+{
+	AddCommand(RenderCommandType::EnableScissorRegion).value = (int)enable;
+}
+
+void RenderCommandRecorder::SetScissorRegion(Rectanglei region)
+{
+	AddCommand(RenderCommandType::SetScissorRegion).region = region;
+}
+
+bool RenderCommandRecorder::LoadTextureData(Vector<byte>& out_data, Vector2i& out_dimensions, const String& source)
+{
+	return target.LoadTextureData(out_data, out_dimensions, source);
+}
+
+bool RenderCommandRecorder::RenderGeometryInstanced(CompiledGeometryHandle geometry, Span<const Vector2f> translations, TextureHandle texture)
+{
+	// Always accept the instances, they are rendered one by one during replay if the target does not support instancing.
+	RenderCommand& command = AddCommand(RenderCommandType::RenderGeometryInstanced);
+	command.handles[0] = geometry;
+	command.handles[1] = texture;
+	command.data_offset = (int)list.translations.size();
+	command.data_size = (int)translations.size();
+	list.translations.insert(list.translations.end(), translations.begin(), translations.end());
+	return true;
+}
+
+void RenderCommandRecorder::EnableClipMask(bool enable)
+{
+	AddCommand(RenderCommandType::EnableClipMask).value = (int)enable;
+}
+
+void RenderCommandRecorder::RenderToClipMask(ClipMaskOperation operation, CompiledGeometryHandle geometry, Vector2f translation)
+{
+	RenderCommand& command = AddCommand(RenderCommandType::RenderToClipMask);
+	command.value = (int)operation;
+	command.handles[0] = geometry;
+	command.translation = translation;
+}
+
+void RenderCommandRecorder::RenderShaderToClipMask(ClipMaskOperation operation, CompiledShaderHandle shader, CompiledGeometryHandle geometry,
+	Vector2f translation)
+{
+	RenderCommand& command = AddCommand(RenderCommandType::RenderShaderToClipMask);
+	command.value = (int)operation;
+	command.handles[0] = shader;
+	command.handles[1] = geometry;
+	command.translation = translation;
+}
+
+void RenderCommandRecorder::SetTransform(const Matrix4f* transform)
+{
+	RenderCommand& command = AddCommand(RenderCommandType::SetTransform);
+	if (transform)
+	{
+		command.value = 1;
+		command.data_offset = (int)list.transforms.size();
+		list.transforms.push_back(*transform);
+	}
+}
+
+LayerHandle RenderCommandRecorder::PushLayer()
+{
+	RenderCommand& command = AddCommand(RenderCommandType::PushLayer);
+	command.handles[0] = NewHandle();
+	return command.handles[0];
+}
+
+void RenderCommandRecorder::CompositeLayers(LayerHandle source, LayerHandle destination, BlendMode blend_mode,
+	Span<const CompiledFilterHandle> filters)
+{
+	RenderCommand& command = AddCommand(RenderCommandType::CompositeLayers);
+	command.value = (int)blend_mode;
+	command.handles[0] = source;
+	command.handles[1] = destination;
+	command.data_offset = (int)list.filter_handles.size();
+	command.data_size = (int)filters.size();
+	list.filter_handles.insert(list.filter_handles.end(), filters.begin(), filters.end());
+}
+
+void RenderCommandRecorder::PopLayer()
+{
+	AddCommand(RenderCommandType::PopLayer);
+}
+
+TextureHandle RenderCommandRecorder::SaveLayerAsTexture()
+{
+	RenderCommand& command = AddCommand(RenderCommandType::SaveLayerAsTexture);
+	command.handles[0] = NewHandle();
+	return command.handles[0];
+}
+
+CompiledFilterHandle RenderCommandRecorder::SaveLayerAsMaskImage()
+{
+	RenderCommand& command = AddCommand(RenderCommandType::SaveLayerAsMaskImage);
+	command.handles[0] = NewHandle();
+	return command.handles[0];
+}
+
+CompiledFilterHandle RenderCommandRecorder::CompileFilter(const String& name, const Dictionary& parameters)
+{
+	RenderCommand& command = AddCommand(RenderCommandType::CompileFilter);
+	command.handles[0] = NewHandle();
+	command.data_offset = (int)list.names.size();
+	list.names.push_back(name);
+	list.parameters.push_back(parameters);
+	return command.handles[0];
+}
+
+void RenderCommandRecorder::ReleaseFilter(CompiledFilterHandle filter)
+{
+	AddCommand(RenderCommandType::ReleaseFilter).handles[0] = filter;
+}
+
+bool RenderCommandRecorder::SupportsShader(const String& name)
+{
+	return target.SupportsShader(name);
+}
+
+CompiledShaderHandle RenderCommandRecorder::CompileShader(const String& name, const Dictionary& parameters)
+{
+	RenderCommand& command = AddCommand(RenderCommandType::CompileShader);
+	command.handles[0] = NewHandle();
+	command.data_offset = (int)list.names.size();
+	list.names.push_back(name);
+	list.parameters.push_back(parameters);
+	return command.handles[0];
+}
+
+void RenderCommandRecorder::RenderShader(CompiledShaderHandle shader, CompiledGeometryHandle geometry, Vector2f translation, TextureHandle texture)
+{
+	RenderCommand& command = AddCommand(RenderCommandType::RenderShader);
+	command.handles[0] = shader;
+	command.handles[1] = geometry;
+	command.handles[2] = texture;
+	command.translation = translation;
+}
+
+void RenderCommandRecorder::ReleaseShader(CompiledShaderHandle shader)
+{
+	AddCommand(RenderCommandType::ReleaseShader).handles[0] = shader;
+}
+
+RenderCommandPlayer::RenderCommandPlayer(RenderInterface& target) : target(target) {}
+
+uintptr_t RenderCommandPlayer::Translate(uintptr_t placeholder) const
+{
+	// Zero is reserved for no texture and the base layer.
+	if (!placeholder)
+		return {};
+
+	auto it = handles.find(placeholder);
+	return it != handles.end() ? it->second : uintptr_t{};
+}
+
+uintptr_t RenderCommandPlayer::TakeHandle(uintptr_t placeholder)
+{
+	auto it = handles.find(placeholder);
+	if (it == handles.end())
+		return {};
+
+	const uintptr_t handle = it->second;
+	handles.erase(it);
+	return handle;
+}
+
+void RenderCommandPlayer::Replay(const RenderCommandList& list)
+{
+	RMLUI_ZoneScoped;
+
+	// Layer handles are only valid while rendering a single frame.
+	layers.clear();
+
+	for (const RenderCommand& command : list.GetCommands())
+	{
+		switch (command.type)
+		{
+		case RenderCommandType::CompileGeometry:
+			handles[command.handles[0]] = target.CompileGeometry(list.GetVertices(command), list.GetIndices(command));
+			break;
+		case RenderCommandType::RenderGeometry:
+		{
+			if (const CompiledGeometryHandle geometry = Translate(command.handles[0]))
+				target.RenderGeometry(geometry, command.translation, Translate(command.handles[1]));
+		}
+		break;
+		case RenderCommandType::RenderGeometryInstanced:
+		{
+			const CompiledGeometryHandle geometry = Translate(command.handles[0]);
+			const TextureHandle texture = Translate(command.handles[1]);
+			const Span<const Vector2f> translations = list.GetTranslations(command);
+			if (geometry && !target.RenderGeometryInstanced(geometry, translations, texture))
+			{
+				for (const Vector2f translation : translations)
+					target.RenderGeometry(geometry, translation, texture);
+			}
+		}
+		break;
+		case RenderCommandType::ReleaseGeometry:
+		{
+			if (const uintptr_t handle = TakeHandle(command.handles[0]))
+				target.ReleaseGeometry(handle);
+		}
+		break;
+		case RenderCommandType::GenerateTexture:
+			handles[command.handles[0]] = target.GenerateTexture(list.GetTextureData(command), command.region.Size());
+			break;
+		case RenderCommandType::AdoptTexture: handles[command.handles[0]] = command.handles[1]; break;
+		case RenderCommandType::ReleaseTexture:
+		{
+			if (const uintptr_t handle = TakeHandle(command.handles[0]))
+				target.ReleaseTexture(handle);
+		}
+		break;
+		case RenderCommandType::EnableScissorRegion: target.EnableScissorRegion(command.value != 0); break;
+		case RenderCommandType::SetScissorRegion: target.SetScissorRegion(command.region); break;
+		case RenderCommandType::EnableClipMask: target.EnableClipMask(command.value != 0); break;
+		case RenderCommandType::RenderToClipMask:
+		{
+			if (const CompiledGeometryHandle geometry = Translate(command.handles[0]))
+				target.RenderToClipMask(ClipMaskOperation(command.value), geometry, command.translation);
+		}
+		break;
+		case RenderCommandType::RenderShaderToClipMask:
+		{
+			const CompiledShaderHandle shader = Translate(command.handles[0]);
+			const CompiledGeometryHandle geometry = Translate(command.handles[1]);
+			if (shader && geometry)
+				target.RenderShaderToClipMask(ClipMaskOperation(command.value), shader, geometry, command.translation);
+		}
+		break;
+		case RenderCommandType::SetTransform: target.SetTransform(list.GetTransform(command)); break;
+		case RenderCommandType::PushLayer:
+		{
+			handles[command.handles[0]] = target.PushLayer();
+			layers.push_back(command.handles[0]);
+		}
+		break;
+		case RenderCommandType::CompositeLayers:
+		{
+			filters.clear();
+			for (uintptr_t filter : list.GetFilters(command))
+				filters.push_back(Translate(filter));
+			target.CompositeLayers(Translate(command.handles[0]), Translate(command.handles[1]), BlendMode(command.value), filters);
+		}
+		break;
+		case RenderCommandType::PopLayer: target.PopLayer(); break;
+		case RenderCommandType::SaveLayerAsTexture: handles[command.handles[0]] = target.SaveLayerAsTexture(); break;
+		case RenderCommandType::SaveLayerAsMaskImage: handles[command.handles[0]] = target.SaveLayerAsMaskImage(); break;
+		case RenderCommandType::CompileFilter:
+			handles[command.handles[0]] = target.CompileFilter(list.GetName(command), list.GetParameters(command));
+			break;
+		case RenderCommandType::ReleaseFilter:
+		{
+			if (const uintptr_t handle = TakeHandle(command.handles[0]))
+				target.ReleaseFilter(handle);
+		}
+		break;
+		case RenderCommandType::CompileShader:
+			handles[command.handles[0]] = target.CompileShader(list.GetName(command), list.GetParameters(command));
+			break;
+		case RenderCommandType::RenderShader:
+		{
+			const CompiledShaderHandle shader = Translate(command.handles[0]);
+			const CompiledGeometryHandle geometry = Translate(command.handles[1]);
+			if (shader && geometry)
+				target.RenderShader(shader, geometry, command.translation, Translate(command.handles[2]));
+		}
+		break;
+		case RenderCommandType::ReleaseShader:
+		{
+			if (const uintptr_t handle = TakeHandle(command.handles[0]))
+				target.ReleaseShader(handle);
+		}
+		break;
+		}
+	}
+
+	for (uintptr_t layer : layers)
+		handles.erase(layer);
+}
+
+} // namespace Rml
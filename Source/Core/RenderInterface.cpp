@@ -17,10 +17,53 @@ RenderInterface::~RenderInterface()
 		"or nullptr dereference when releasing render resources. Ensure that the render interface is destroyed *after* the call to Rml::Shutdown.");
 }
 
+bool RenderInterface::UpdateTexture(TextureHandle /*texture*/, Rectanglei /*region*/, Span<const byte> /*source*/)
+{
+	return false;
+}
+
+TextureHandle RenderInterface::LoadTextureAsync(Vector2i& texture_dimensions, const String& source, bool& loading)
+{
+	loading = false;
+	return LoadTexture(texture_dimensions, source);
+}
+
+bool RenderInterface::LoadTextureData(Vector<byte>& /*out_data*/, Vector2i& /*out_dimensions*/, const String& /*source*/)
+{
+	return false;
+}
+
+bool RenderInterface::RenderGeometryInstanced(CompiledGeometryHandle /*geometry*/, Span<const Vector2f> /*translations*/, TextureHandle /*texture*/)
+{
+	return false;
+}
+
+CompiledGeometryHandle RenderInterface::CompileQuadGeometry(Span<const Vertex> /*vertices*/)
+{
+	return {};
+}
+
+CompiledGeometryHandle RenderInterface::CompileTransformedGeometry(Span<const Vertex> /*vertices*/, Span<const int> /*indices*/,
+	Span<const int> /*transform_indices*/)
+{
+	return {};
+}
+
+void RenderInterface::RenderTransformedGeometry(CompiledGeometryHandle /*geometry*/, Span<const Matrix4f> /*transforms*/, TextureHandle /*texture*/) {}
+
 void RenderInterface::EnableClipMask(bool /*enable*/) {}
 
 void RenderInterface::RenderToClipMask(ClipMaskOperation /*operation*/, CompiledGeometryHandle /*geometry*/, Vector2f /*translation*/) {}
 
+bool RenderInterface::PopClipMask(CompiledGeometryHandle /*geometry*/, Vector2f /*translation*/)
+{
+	return false;
+}
+
+void RenderInterface::RenderShaderToClipMask(ClipMaskOperation /*operation*/, CompiledShaderHandle /*shader*/,
+	CompiledGeometryHandle /*geometry*/, Vector2f /*translation*/)
+{}
+
 void RenderInterface::SetTransform(const Matrix4f* /*transform*/) {}
 
 LayerHandle RenderInterface::PushLayer()
@@ -51,6 +94,11 @@ CompiledFilterHandle RenderInterface::CompileFilter(const String& /*name*/, cons
 
 void RenderInterface::ReleaseFilter(CompiledFilterHandle /*filter*/) {}
 
+bool RenderInterface::SupportsShader(const String& /*name*/)
+{
+	return false;
+}
+
 CompiledShaderHandle RenderInterface::CompileShader(const String& /*name*/, const Dictionary& /*parameters*/)
 {
 	return CompiledShaderHandle{};
@@ -4,10 +4,56 @@
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/RenderInterface.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "../../Include/RmlUi/Core/Utilities.h"
 #include "TextureDatabase.h"
 
 namespace Rml {
 
+// Merged geometry is kept while unused for this number of frames, so that geometry only shown intermittently is not recompiled every time.
+static constexpr int MaxUnusedGeometryBatchFrames = 2;
+// The number of merged geometry batches kept for members with the same hash.
+static constexpr size_t MaxGeometryBatchesPerHash = 4;
+
+static uint64_t GetMeshSize(const Mesh& mesh)
+{
+	return uint64_t(mesh.vertices.size() * sizeof(Vertex) + mesh.indices.size() * sizeof(int));
+}
+
+// Returns true if the mesh only consists of quads laid out like MeshUtilities::GenerateQuad, such as text.
+static bool IsQuadMesh(const Mesh& mesh)
+{
+	const size_t num_quads = mesh.vertices.size() / 4;
+	if (num_quads == 0 || mesh.vertices.size() != num_quads * 4 || mesh.indices.size() != num_quads * 6)
+		return false;
+
+	for (size_t i = 0; i < num_quads; i++)
+	{
+		const int v0 = int(i * 4);
+		const int* indices = mesh.indices.data() + i * 6;
+		if (indices[0] != v0 || indices[1] != v0 + 3 || indices[2] != v0 + 1 || indices[3] != v0 + 1 || indices[4] != v0 + 3 ||
+			indices[5] != v0 + 2)
+			return false;
+	}
+	return true;
+}
+
+static size_t HashMesh(const Mesh& mesh)
+{
+	size_t hash = mesh.vertices.size();
+	for (const Vertex& vertex : mesh.vertices)
+	{
+		const ColourbPremultiplied& colour = vertex.colour;
+		Utilities::HashCombine(hash, vertex.position.x);
+		Utilities::HashCombine(hash, vertex.position.y);
+		Utilities::HashCombine(hash, uint32_t(colour.red) | uint32_t(colour.green) << 8 | uint32_t(colour.blue) << 16 | uint32_t(colour.alpha) << 24);
+		Utilities::HashCombine(hash, vertex.tex_coord.x);
+		Utilities::HashCombine(hash, vertex.tex_coord.y);
+	}
+	for (int index : mesh.indices)
+		Utilities::HashCombine(hash, index);
+	return hash;
+}
+
 RenderManager::RenderManager(RenderInterface* render_interface) : render_interface(render_interface), texture_database(MakeUnique<TextureDatabase>())
 {
 	RMLUI_ASSERT(render_interface);
@@ -38,6 +84,7 @@ RenderManager::~RenderManager()
 		}
 	}
 
+	ReleaseAllGeometryBatches();
 	ReleaseAllTextures();
 }
 
@@ -51,6 +98,32 @@ void RenderManager::PrepareRender(Vector2i dimensions)
 	RMLUI_ASSERTMSG(render_stack.empty(), "Unbalanced render stack detected, ensure every PushLayer call has a corresponding call to PopLayer.");
 #endif
 
+	texture_database->file_database.BeginFrame(render_interface);
+	texture_database->callback_database.BeginFrame(render_interface);
+
+	// Release any merged geometry that was not used during the most recent frames. All contexts sharing this render manager prepare to render
+	// once per frame, thus the frames are counted in units of the number of contexts.
+	render_generation += 1;
+	const uint64_t max_unused_generations = uint64_t(MaxUnusedGeometryBatchFrames * Math::Max(num_contexts, 1));
+
+	for (auto it = geometry_batches.begin(); it != geometry_batches.end();)
+	{
+		Vector<GeometryBatch>& bucket = it->second;
+		auto it_unused = std::partition(bucket.begin(), bucket.end(),
+			[&](const GeometryBatch& batch) { return render_generation - batch.last_used <= max_unused_generations; });
+		for (auto it_batch = it_unused; it_batch != bucket.end(); ++it_batch)
+		{
+			if (it_batch->handle)
+				render_interface->ReleaseGeometry(it_batch->handle);
+		}
+		bucket.erase(it_unused, bucket.end());
+
+		if (bucket.empty())
+			it = geometry_batches.erase(it);
+		else
+			++it;
+	}
+
 	SetViewport(dimensions);
 }
 
@@ -80,6 +153,11 @@ Texture RenderManager::LoadTexture(const String& source, const String& document_
 	return Texture(this, texture_database->file_database.InsertTexture(path));
 }
 
+void RenderManager::PreloadTexture(const String& source, const String& document_path)
+{
+	LoadTexture(source, document_path).GetDimensions();
+}
+
 CallbackTexture RenderManager::MakeCallbackTexture(CallbackTextureFunction callback)
 {
 	return CallbackTexture(this, texture_database->callback_database.CreateTexture(std::move(callback)));
@@ -92,21 +170,47 @@ void RenderManager::DisableScissorRegion()
 
 void RenderManager::SetScissorRegion(Rectanglei new_region)
 {
-	const bool old_scissor_enable = state.scissor_region.Valid();
+	if (new_region.Valid())
+		new_region = new_region.Intersect(Rectanglei::FromSize(viewport_dimensions));
+
+	state.scissor_region = new_region;
+	ApplyScissorRegion();
+}
+
+void RenderManager::SetRenderRegion(Rectanglei region)
+{
+	if (region.Valid())
+		region = region.Intersect(Rectanglei::FromSize(viewport_dimensions));
+
+	render_region = region;
+	ApplyScissorRegion();
+}
+
+Rectanglei RenderManager::GetRenderRegion() const
+{
+	return render_region;
+}
+
+void RenderManager::ApplyScissorRegion()
+{
+	Rectanglei new_region = state.scissor_region;
+	if (render_region.Valid())
+		new_region = (new_region.Valid() ? new_region.Intersect(render_region) : render_region);
+
+	const bool old_scissor_enable = applied_scissor_region.Valid();
 	const bool new_scissor_enable = new_region.Valid();
 
+	const bool scissor_region_changed = (new_scissor_enable && new_region != applied_scissor_region);
+	if (new_scissor_enable != old_scissor_enable || scissor_region_changed)
+		FlushGeometryBatch();
+
 	if (new_scissor_enable != old_scissor_enable)
 		render_interface->EnableScissorRegion(new_scissor_enable);
 
-	if (new_scissor_enable)
-	{
-		new_region = new_region.Intersect(Rectanglei::FromSize(viewport_dimensions));
-
-		if (new_region != state.scissor_region)
-			render_interface->SetScissorRegion(new_region);
-	}
+	if (scissor_region_changed)
+		render_interface->SetScissorRegion(new_region);
 
-	state.scissor_region = new_region;
+	applied_scissor_region = new_region;
 }
 
 Rectanglei RenderManager::GetScissorRegion() const
@@ -126,16 +230,20 @@ void RenderManager::DisableClipMask()
 void RenderManager::SetClipMask(ClipMaskOperation operation, Geometry* geometry, Vector2f translation)
 {
 	RMLUI_ASSERT(geometry && geometry->render_manager == this);
-	state.clip_mask_list = {ClipMaskGeometry{operation, geometry, translation, nullptr}};
+	state.clip_mask_list = {ClipMaskGeometry{operation, geometry, translation, nullptr, nullptr}};
 	ApplyClipMask(state.clip_mask_list);
+
+	// The geometry is often only temporary, thus it can't be referred to later for incremental updates.
+	clip_mask_handles.clear();
 }
 
 void RenderManager::SetClipMask(ClipMaskGeometryList in_clip_elements)
 {
 	if (state.clip_mask_list != in_clip_elements)
 	{
+		if (!UpdateClipMask(in_clip_elements))
+			ApplyClipMask(in_clip_elements);
 		state.clip_mask_list = std::move(in_clip_elements);
-		ApplyClipMask(state.clip_mask_list);
 	}
 }
 
@@ -146,15 +254,122 @@ void RenderManager::SetTransform(const Matrix4f* p_new_transform)
 
 	if (state.transform != new_transform)
 	{
-		render_interface->SetTransform(p_new_transform);
+		if (!ContinueBatchWithTransform(new_transform))
+		{
+			FlushGeometryBatch();
+			render_interface->SetTransform(p_new_transform);
+		}
 		state.transform = new_transform;
 	}
 }
 
+void RenderManager::SetGeometryBatching(bool enable)
+{
+	if (geometry_batching == enable)
+		return;
+
+	FlushGeometryBatch();
+	ReleaseAllGeometryBatches();
+	geometry_batching = enable;
+}
+
+bool RenderManager::GetGeometryBatching() const
+{
+	return geometry_batching;
+}
+
+void RenderManager::SetTransformBatching(bool enable)
+{
+	FlushGeometryBatch();
+	transform_batching = enable;
+}
+
+bool RenderManager::GetTransformBatching() const
+{
+	return transform_batching;
+}
+
+void RenderManager::SetGeometryDeduplication(bool enable)
+{
+	geometry_deduplication = enable;
+}
+
+bool RenderManager::GetGeometryDeduplication() const
+{
+	return geometry_deduplication;
+}
+
+void RenderManager::SetTextureMemoryBudget(size_t budget_bytes, int min_unused_frames)
+{
+	texture_database->file_database.SetMemoryBudget(budget_bytes, min_unused_frames);
+}
+
+void RenderManager::SetAsyncTextureLoading(bool enable, const String& placeholder_source)
+{
+	texture_database->file_database.SetAsyncLoading(enable, placeholder_source);
+}
+
+void RenderManager::SetCallbackTextureRegenerationBudget(int max_pixels_per_frame)
+{
+	texture_database->callback_database.SetRegenerationBudget(max_pixels_per_frame);
+}
+
+void RenderManager::SetCallbackTextureReuse(bool enable)
+{
+	texture_database->callback_database.SetPooling(render_interface, enable);
+}
+
+void RenderManager::SetTextureAtlasing(bool enable, int max_image_size, int page_size)
+{
+	texture_database->file_database.SetAtlasing(enable, max_image_size, page_size);
+}
+
+bool RenderManager::GetTextureAtlasRegion(Texture texture, Texture& out_atlas_texture, Rectanglef& out_region)
+{
+	if (texture.render_manager != this || texture.file_index == TextureFileIndex::Invalid)
+		return false;
+
+	TextureFileIndex atlas_index = TextureFileIndex::Invalid;
+	if (!texture_database->file_database.GetAtlasRegion(render_interface, texture.file_index, atlas_index, out_region))
+		return false;
+
+	out_atlas_texture = Texture(this, atlas_index);
+	return true;
+}
+
+FileTextureStats RenderManager::GetFileTextureStats() const
+{
+	return texture_database->file_database.GetStats();
+}
+
+bool RenderManager::HasPendingTextures() const
+{
+	return texture_database->file_database.GetStats().num_loading_textures > 0 || texture_database->callback_database.GetNumDeferredTextures() > 0;
+}
+
+size_t RenderManager::GetMeshBytes()
+{
+	size_t result = 0;
+	geometry_list.for_each([&result](const GeometryData& data) {
+		result += data.mesh.vertices.capacity() * sizeof(Vertex) + data.mesh.indices.capacity() * sizeof(int);
+	});
+	return result;
+}
+
+RenderStats RenderManager::GetRenderStats() const
+{
+	RenderStats stats = render_stats;
+	stats.num_texture_uploads = texture_database->file_database.GetNumUploads() + texture_database->callback_database.GetNumUploads();
+	return stats;
+}
+
 void RenderManager::ApplyClipMask(const ClipMaskGeometryList& clip_elements)
 {
+	FlushGeometryBatch();
+
 	const bool clip_mask_enabled = !clip_elements.empty();
 	render_interface->EnableClipMask(clip_mask_enabled);
+	clip_mask_handles.clear();
 
 	if (clip_mask_enabled)
 	{
@@ -162,10 +377,8 @@ void RenderManager::ApplyClipMask(const ClipMaskGeometryList& clip_elements)
 
 		for (const ClipMaskGeometry& element_clip : clip_elements)
 		{
-			RMLUI_ASSERT(element_clip.geometry->render_manager == this);
 			SetTransform(element_clip.transform);
-			if (CompiledGeometryHandle handle = GetCompiledGeometryHandle(element_clip.geometry->resource_handle))
-				render_interface->RenderToClipMask(element_clip.operation, handle, element_clip.absolute_offset);
+			clip_mask_handles.push_back(RenderToClipMask(element_clip.operation, element_clip));
 		}
 
 		// Apply the initially set transform in case it was changed.
@@ -173,6 +386,74 @@ void RenderManager::ApplyClipMask(const ClipMaskGeometryList& clip_elements)
 	}
 }
 
+bool RenderManager::UpdateClipMask(const ClipMaskGeometryList& clip_elements)
+{
+	const ClipMaskGeometryList& applied_elements = state.clip_mask_list;
+	if (clip_elements.empty() || clip_mask_handles.size() != applied_elements.size())
+		return false;
+
+	// The outer clip masks shared with the applied list are kept, as long as their geometry has not been recompiled since.
+	size_t num_shared = 0;
+	while (num_shared < applied_elements.size() && num_shared < clip_elements.size() && applied_elements[num_shared] == clip_elements[num_shared] &&
+		GetCompiledGeometryHandle(clip_elements[num_shared].geometry->resource_handle) == clip_mask_handles[num_shared])
+	{
+		num_shared += 1;
+	}
+
+	const size_t num_pops = applied_elements.size() - num_shared;
+	const size_t num_pushes = clip_elements.size() - num_shared;
+	if (num_shared == 0 || (num_pops > 0 && clip_mask_pop_unsupported) || num_pops + num_pushes >= clip_elements.size())
+		return false;
+
+	const auto is_intersection = [](const ClipMaskGeometry& element_clip) { return element_clip.operation == ClipMaskOperation::Intersect; };
+	if (!std::all_of(applied_elements.begin() + num_shared, applied_elements.end(), is_intersection) ||
+		!std::all_of(clip_elements.begin() + num_shared, clip_elements.end(), is_intersection))
+		return false;
+
+	// Clip masks rendered with a shader can't be popped, since the render interface only undoes the intersection of geometry.
+	const auto has_shader = [](const ClipMaskGeometry& element_clip) { return element_clip.shader != nullptr; };
+	if (std::any_of(applied_elements.begin() + num_shared, applied_elements.end(), has_shader))
+		return false;
+
+	FlushGeometryBatch();
+	const Matrix4f initial_transform = state.transform;
+	bool result = true;
+
+	for (size_t i = applied_elements.size(); i-- > num_shared;)
+	{
+		SetTransform(applied_elements[i].transform);
+		if (clip_mask_handles[i] && !render_interface->PopClipMask(clip_mask_handles[i], applied_elements[i].absolute_offset))
+		{
+			clip_mask_pop_unsupported = true;
+			result = false;
+			break;
+		}
+		clip_mask_handles.pop_back();
+	}
+
+	for (size_t i = num_shared; result && i < clip_elements.size(); i++)
+	{
+		SetTransform(clip_elements[i].transform);
+		clip_mask_handles.push_back(RenderToClipMask(ClipMaskOperation::Intersect, clip_elements[i]));
+	}
+
+	SetTransform(&initial_transform);
+	return result;
+}
+
+CompiledGeometryHandle RenderManager::RenderToClipMask(ClipMaskOperation operation, const ClipMaskGeometry& element_clip)
+{
+	RMLUI_ASSERT(element_clip.geometry->render_manager == this);
+	RMLUI_ASSERT(!element_clip.shader || element_clip.shader->render_manager == this);
+
+	const CompiledGeometryHandle handle = GetCompiledGeometryHandle(element_clip.geometry->resource_handle);
+	if (handle && element_clip.shader && *element_clip.shader)
+		render_interface->RenderShaderToClipMask(operation, element_clip.shader->resource_handle, handle, element_clip.absolute_offset);
+	else if (handle)
+		render_interface->RenderToClipMask(operation, handle, element_clip.absolute_offset);
+	return handle;
+}
+
 void RenderManager::SetState(const RenderState& next)
 {
 	SetScissorRegion(next.scissor_region);
@@ -184,6 +465,7 @@ void RenderManager::SetState(const RenderState& next)
 
 void RenderManager::ResetState()
 {
+	FlushGeometryBatch();
 	SetState(RenderState{});
 }
 
@@ -198,10 +480,14 @@ CompiledGeometryHandle RenderManager::GetCompiledGeometryHandle(StableVectorInde
 		return {};
 
 	GeometryData& geometry = geometry_list[index];
-	if (!geometry.handle && !geometry.mesh.indices.empty())
+	if (!geometry.handle && !geometry.mesh.indices.empty() && geometry_deduplication)
+	{
+		geometry.handle = AcquireSharedGeometry(index, geometry);
+	}
+	else if (!geometry.handle && !geometry.mesh.indices.empty())
 	{
 		RMLUI_ZoneScopedNC("CompileGeometry", 0x1E60D2);
-		geometry.handle = render_interface->CompileGeometry(geometry.mesh.vertices, geometry.mesh.indices);
+		geometry.handle = CompileMesh(geometry.mesh);
 
 		if (!geometry.handle)
 			Log::Message(Log::LT_ERROR, "Got empty compiled geometry.");
@@ -209,6 +495,85 @@ CompiledGeometryHandle RenderManager::GetCompiledGeometryHandle(StableVectorInde
 	return geometry.handle;
 }
 
+CompiledGeometryHandle RenderManager::CompileMesh(const Mesh& mesh)
+{
+	if (!quad_geometry_unsupported && IsQuadMesh(mesh))
+	{
+		if (CompiledGeometryHandle handle = render_interface->CompileQuadGeometry(mesh.vertices))
+		{
+			render_stats.compiled_geometry_bytes += uint64_t(mesh.vertices.size() * sizeof(Vertex));
+			return handle;
+		}
+		quad_geometry_unsupported = true;
+	}
+
+	render_stats.compiled_geometry_bytes += GetMeshSize(mesh);
+	return render_interface->CompileGeometry(mesh.vertices, mesh.indices);
+}
+
+CompiledGeometryHandle RenderManager::AcquireSharedGeometry(StableVectorIndex index, GeometryData& geometry)
+{
+	const size_t hash = HashMesh(geometry.mesh);
+	Vector<SharedGeometry>& entries = shared_geometry[hash];
+
+	for (SharedGeometry& entry : entries)
+	{
+		const Mesh& mesh = (entry.owner != StableVectorIndex::Invalid ? geometry_list[entry.owner].mesh : entry.mesh);
+		if (mesh == geometry.mesh)
+		{
+			entry.num_references += 1;
+			geometry.shared = true;
+			geometry.mesh_hash = hash;
+			return entry.handle;
+		}
+	}
+
+	RMLUI_ZoneScopedNC("CompileGeometry", 0x1E60D2);
+	const CompiledGeometryHandle handle = CompileMesh(geometry.mesh);
+
+	if (!handle)
+	{
+		Log::Message(Log::LT_ERROR, "Got empty compiled geometry.");
+		if (entries.empty())
+			shared_geometry.erase(hash);
+		return {};
+	}
+
+	entries.push_back(SharedGeometry{handle, 1, index, Mesh()});
+	geometry.shared = true;
+	geometry.mesh_hash = hash;
+	return handle;
+}
+
+void RenderManager::ReleaseSharedGeometry(StableVectorIndex index, const GeometryData& geometry)
+{
+	auto it_entries = shared_geometry.find(geometry.mesh_hash);
+	RMLUI_ASSERT(it_entries != shared_geometry.end());
+	if (it_entries == shared_geometry.end())
+		return;
+
+	Vector<SharedGeometry>& entries = it_entries->second;
+	auto it = std::find_if(entries.begin(), entries.end(), [&](const SharedGeometry& entry) { return entry.handle == geometry.handle; });
+	RMLUI_ASSERT(it != entries.end());
+	if (it == entries.end())
+		return;
+
+	it->num_references -= 1;
+	if (it->num_references == 0)
+	{
+		render_interface->ReleaseGeometry(it->handle);
+		entries.erase(it);
+		if (entries.empty())
+			shared_geometry.erase(it_entries);
+	}
+	else if (it->owner == index)
+	{
+		// Keep a copy of the mesh for comparisons, the released mesh is returned to the owner of the geometry.
+		it->owner = StableVectorIndex::Invalid;
+		it->mesh = geometry.mesh;
+	}
+}
+
 void RenderManager::Render(const Geometry& geometry, Vector2f translation, Texture texture, const CompiledShader& shader)
 {
 	RMLUI_ASSERT(geometry);
@@ -220,20 +585,306 @@ void RenderManager::Render(const Geometry& geometry, Vector2f translation, Textu
 		return;
 	}
 
+	if (geometry_batching && !shader)
+	{
+		if (geometry_list[geometry.resource_handle].mesh.indices.empty())
+			return;
+
+		TextureHandle texture_handle = {};
+		if (!GetTextureHandle(texture, texture_handle))
+			return;
+
+		// Consecutive geometry can only be merged when sharing the same texture, all other render state changes flush the batch.
+		if (!pending_batch.empty() && pending_batch_texture != texture_handle)
+			FlushGeometryBatch();
+
+		if (pending_batch.empty())
+		{
+			pending_batch_transforms.clear();
+			pending_batch_transforms.push_back(state.transform);
+		}
+
+		pending_batch_texture = texture_handle;
+		pending_batch.push_back(BatchedGeometry{geometry.resource_handle, translation, (int)pending_batch_transforms.size() - 1});
+		return;
+	}
+
+	FlushGeometryBatch();
+
 	if (CompiledGeometryHandle geometry_handle = GetCompiledGeometryHandle(geometry.resource_handle))
 	{
 		TextureHandle texture_handle = {};
-		if (texture.file_index != TextureFileIndex::Invalid)
-			texture_handle = texture_database->file_database.GetHandle(render_interface, texture.file_index);
-		else if (texture.callback_index != StableVectorIndex::Invalid)
-			texture_handle = texture_database->callback_database.GetHandle(this, render_interface, texture.callback_index);
+		if (!GetTextureHandle(texture, texture_handle))
+			return;
 
 		RMLUI_ZoneScopedNC("RenderGeometry", 0x3E60B2);
 		if (shader)
 			render_interface->RenderShader(shader.resource_handle, geometry_handle, translation, texture_handle);
 		else
 			render_interface->RenderGeometry(geometry_handle, translation, texture_handle);
+		render_stats.num_draw_calls += 1;
+	}
+}
+
+bool RenderManager::GetTextureHandle(Texture texture, TextureHandle& out_texture_handle)
+{
+	if (texture.file_index != TextureFileIndex::Invalid)
+	{
+		FileTextureDatabase& file_database = texture_database->file_database;
+		out_texture_handle = file_database.GetHandle(render_interface, texture.file_index);
+
+		// Skip the geometry while its texture is still loading, unless we have a placeholder to show instead.
+		if (!out_texture_handle && file_database.IsLoading(texture.file_index))
+			return false;
+	}
+	else if (texture.callback_index != StableVectorIndex::Invalid)
+	{
+		CallbackTextureDatabase& callback_database = texture_database->callback_database;
+		out_texture_handle = callback_database.GetHandle(this, render_interface, texture.callback_index);
+
+		// Skip the geometry until its texture is regenerated during a later frame.
+		if (!out_texture_handle && callback_database.IsDeferred(texture.callback_index))
+			return false;
+	}
+	return true;
+}
+
+void RenderManager::FlushGeometryBatch()
+{
+	if (pending_batch.empty())
+		return;
+
+	if (pending_batch_transforms.size() == 1)
+	{
+		RenderGeometryBatch(pending_batch);
+		pending_batch.clear();
+		return;
+	}
+
+	if (pending_batch.back().transform_index == 0)
+	{
+		RenderGeometryBatch(pending_batch);
+	}
+	else if (transformed_geometry_unsupported || !RenderTransformedGeometryBatch())
+	{
+		// Render each run of members sharing the same transform as a separate batch.
+		for (auto it = pending_batch.begin(); it != pending_batch.end();)
+		{
+			const int transform_index = it->transform_index;
+			batch_run.clear();
+			for (; it != pending_batch.end() && it->transform_index == transform_index; ++it)
+				batch_run.push_back(BatchedGeometry{it->index, it->translation, 0});
+
+			render_interface->SetTransform(&pending_batch_transforms[transform_index]);
+			RenderGeometryBatch(batch_run);
+		}
+	}
+
+	// The transform changes of the batch were deferred, submit the current one now.
+	render_interface->SetTransform(&state.transform);
+	pending_batch.clear();
+}
+
+void RenderManager::RenderGeometryBatch(const Vector<BatchedGeometry>& members)
+{
+	if (members.size() == 1)
+	{
+		const BatchedGeometry& member = members[0];
+		if (CompiledGeometryHandle geometry_handle = GetCompiledGeometryHandle(member.index))
+		{
+			RMLUI_ZoneScopedNC("RenderGeometry", 0x3E60B2);
+			render_interface->RenderGeometry(geometry_handle, member.translation, pending_batch_texture);
+			render_stats.num_draw_calls += 1;
+		}
+		return;
+	}
+
+	// Repeated draws of the same geometry can be instanced, which avoids merging their meshes whenever their translations change.
+	const StableVectorIndex first_index = members[0].index;
+	const auto is_same_geometry = [first_index](const BatchedGeometry& member) { return member.index == first_index; };
+
+	if (!geometry_instancing_unsupported && std::all_of(members.begin(), members.end(), is_same_geometry))
+	{
+		if (CompiledGeometryHandle geometry_handle = GetCompiledGeometryHandle(first_index))
+		{
+			instance_translations.clear();
+			for (const BatchedGeometry& member : members)
+				instance_translations.push_back(member.translation);
+
+			RMLUI_ZoneScopedNC("RenderGeometryInstanced", 0x3E60B2);
+			if (render_interface->RenderGeometryInstanced(geometry_handle, instance_translations, pending_batch_texture))
+			{
+				render_stats.num_draw_calls += 1;
+				return;
+			}
+
+			geometry_instancing_unsupported = true;
+		}
+	}
+
+	if (GeometryBatch* batch = GetMergedGeometry(members, false))
+	{
+		RMLUI_ZoneScopedNC("RenderGeometry", 0x3E60B2);
+		render_interface->RenderGeometry(batch->handle, Vector2f(0.f), pending_batch_texture);
+		render_stats.num_draw_calls += 1;
+	}
+}
+
+bool RenderManager::RenderTransformedGeometryBatch()
+{
+	GeometryBatch* batch = GetMergedGeometry(pending_batch, true);
+	if (!batch)
+	{
+		transformed_geometry_unsupported = true;
+		return false;
 	}
+
+	RMLUI_ZoneScopedNC("RenderTransformedGeometry", 0x3E60B2);
+	render_interface->RenderTransformedGeometry(batch->handle, pending_batch_transforms, pending_batch_texture);
+	render_stats.num_draw_calls += 1;
+	return true;
+}
+
+RenderManager::GeometryBatch* RenderManager::GetMergedGeometry(const Vector<BatchedGeometry>& members, bool transformed)
+{
+	size_t hash = 0;
+	for (const BatchedGeometry& member : members)
+	{
+		Utilities::HashCombine(hash, static_cast<size_t>(member.index));
+		Utilities::HashCombine(hash, member.translation.x);
+		Utilities::HashCombine(hash, member.translation.y);
+		Utilities::HashCombine(hash, member.transform_index);
+	}
+
+	const auto members_equal = [](const BatchedGeometry& a, const BatchedGeometry& b) {
+		return a.index == b.index && a.translation == b.translation && a.transform_index == b.transform_index;
+	};
+
+	Vector<GeometryBatch>& bucket = geometry_batches[hash];
+	auto it_batch = std::find_if(bucket.begin(), bucket.end(), [&](const GeometryBatch& batch) {
+		return batch.members.size() == members.size() && std::equal(batch.members.begin(), batch.members.end(), members.begin(), members_equal);
+	});
+
+	if (it_batch == bucket.end())
+	{
+		// Replace the least recently used batch of a full bucket, otherwise add a new one.
+		if (bucket.size() >= MaxGeometryBatchesPerHash)
+			it_batch = std::min_element(bucket.begin(), bucket.end(),
+				[](const GeometryBatch& a, const GeometryBatch& b) { return a.last_used < b.last_used; });
+		else
+			it_batch = bucket.insert(bucket.end(), GeometryBatch{});
+	}
+
+	GeometryBatch& batch = *it_batch;
+	if (!batch.handle || batch.members.size() != members.size() ||
+		!std::equal(batch.members.begin(), batch.members.end(), members.begin(), members_equal))
+	{
+		RMLUI_ZoneScopedNC("CompileGeometryBatch", 0x1E60D2);
+
+		if (batch.handle)
+			render_interface->ReleaseGeometry(batch.handle);
+		batch.handle = {};
+
+		// Merge the members into a single mesh, with their translations baked into the vertex positions.
+		Mesh mesh;
+		vertex_transform_indices.clear();
+		for (const BatchedGeometry& member : members)
+		{
+			GeometryData& data = geometry_list[member.index];
+			data.batched = true;
+
+			const int index_offset = (int)mesh.vertices.size();
+			for (Vertex vertex : data.mesh.vertices)
+			{
+				vertex.position += member.translation;
+				mesh.vertices.push_back(vertex);
+			}
+			for (int index : data.mesh.indices)
+				mesh.indices.push_back(index + index_offset);
+			if (transformed)
+				vertex_transform_indices.resize(mesh.vertices.size(), member.transform_index);
+		}
+
+		batch.members = members;
+		if (transformed)
+		{
+			batch.handle = render_interface->CompileTransformedGeometry(mesh.vertices, mesh.indices, vertex_transform_indices);
+			if (batch.handle)
+				render_stats.compiled_geometry_bytes += GetMeshSize(mesh) + uint64_t(vertex_transform_indices.size() * sizeof(int));
+		}
+		else
+		{
+			batch.handle = CompileMesh(mesh);
+			if (!batch.handle)
+				Log::Message(Log::LT_ERROR, "Got empty compiled geometry.");
+		}
+	}
+
+	if (!batch.handle)
+	{
+		bucket.erase(it_batch);
+		if (bucket.empty())
+			geometry_batches.erase(hash);
+		return nullptr;
+	}
+
+	batch.last_used = render_generation;
+	return &batch;
+}
+
+bool RenderManager::ContinueBatchWithTransform(const Matrix4f& transform)
+{
+	if (!transform_batching || transformed_geometry_unsupported || pending_batch.empty())
+		return false;
+
+	// Reuse the last transform if no geometry has been added under it yet.
+	if (pending_batch.back().transform_index + 1 < (int)pending_batch_transforms.size())
+	{
+		pending_batch_transforms.back() = transform;
+		return true;
+	}
+
+	if ((int)pending_batch_transforms.size() >= RenderInterface::MaxBatchTransforms)
+		return false;
+
+	pending_batch_transforms.push_back(transform);
+	return true;
+}
+
+void RenderManager::ReleaseGeometryBatches(StableVectorIndex member)
+{
+	for (auto it = geometry_batches.begin(); it != geometry_batches.end();)
+	{
+		Vector<GeometryBatch>& bucket = it->second;
+		auto it_released = std::partition(bucket.begin(), bucket.end(), [member](const GeometryBatch& batch) {
+			return std::none_of(batch.members.begin(), batch.members.end(), [member](const BatchedGeometry& batched) { return batched.index == member; });
+		});
+		for (auto it_batch = it_released; it_batch != bucket.end(); ++it_batch)
+		{
+			if (it_batch->handle)
+				render_interface->ReleaseGeometry(it_batch->handle);
+		}
+		bucket.erase(it_released, bucket.end());
+
+		if (bucket.empty())
+			it = geometry_batches.erase(it);
+		else
+			++it;
+	}
+}
+
+void RenderManager::ReleaseAllGeometryBatches()
+{
+	pending_batch.clear();
+	for (auto& bucket : geometry_batches)
+	{
+		for (GeometryBatch& batch : bucket.second)
+		{
+			if (batch.handle)
+				render_interface->ReleaseGeometry(batch.handle);
+		}
+	}
+	geometry_batches.clear();
 }
 
 void RenderManager::GetTextureSourceList(StringList& source_list) const
@@ -247,6 +898,16 @@ const Mesh& RenderManager::GetMesh(const Geometry& geometry) const
 	return geometry_list[geometry.resource_handle].mesh;
 }
 
+size_t RenderManager::GetNumFileTextures() const
+{
+	return texture_database->file_database.GetNumTextures();
+}
+
+void RenderManager::PreloadFileTextures(size_t first_index)
+{
+	texture_database->file_database.PreloadTextures(render_interface, first_index);
+}
+
 bool RenderManager::ReleaseTexture(const String& texture_source)
 {
 	return texture_database->file_database.ReleaseTexture(render_interface, texture_source);
@@ -260,13 +921,21 @@ void RenderManager::ReleaseAllTextures()
 
 void RenderManager::ReleaseAllCompiledGeometry()
 {
+	ReleaseAllGeometryBatches();
+	clip_mask_handles.clear();
 	geometry_list.for_each([this](GeometryData& data) {
-		if (data.handle)
-		{
+		if (data.handle && !data.shared)
 			render_interface->ReleaseGeometry(data.handle);
-			data.handle = {};
-		}
+		data.handle = {};
+		data.shared = false;
 	});
+
+	for (auto& entries : shared_geometry)
+	{
+		for (SharedGeometry& entry : entries.second)
+			render_interface->ReleaseGeometry(entry.handle);
+	}
+	shared_geometry.clear();
 }
 
 CompiledFilter RenderManager::CompileFilter(const String& name, const Dictionary& parameters)
@@ -291,8 +960,14 @@ CompiledShader RenderManager::CompileShader(const String& name, const Dictionary
 	return CompiledShader();
 }
 
+bool RenderManager::SupportsShader(const String& name) const
+{
+	return render_interface->SupportsShader(name);
+}
+
 LayerHandle RenderManager::PushLayer()
 {
+	FlushGeometryBatch();
 	const LayerHandle layer = render_interface->PushLayer();
 	render_stack.push_back(layer);
 	return layer;
@@ -302,12 +977,14 @@ void RenderManager::CompositeLayers(LayerHandle source, LayerHandle destination,
 {
 	RMLUI_ASSERT(source == 0 || std::find(render_stack.begin(), render_stack.end(), source) != render_stack.end());
 	RMLUI_ASSERT(destination == 0 || std::find(render_stack.begin(), render_stack.end(), destination) != render_stack.end());
+	FlushGeometryBatch();
 	render_interface->CompositeLayers(source, destination, blend_mode, filters);
 }
 
 void RenderManager::PopLayer()
 {
 	RMLUI_ASSERT(!render_stack.empty());
+	FlushGeometryBatch();
 	render_interface->PopLayer();
 	render_stack.pop_back();
 }
@@ -325,6 +1002,7 @@ LayerHandle RenderManager::GetNextLayer() const
 
 CompiledFilter RenderManager::SaveLayerAsMaskImage()
 {
+	FlushGeometryBatch();
 	if (CompiledFilterHandle handle = render_interface->SaveLayerAsMaskImage())
 	{
 		compiled_filter_count += 1;
@@ -345,8 +1023,17 @@ Mesh RenderManager::ReleaseResource(const Geometry& geometry)
 	RMLUI_ASSERT(geometry.render_manager == this && geometry.resource_handle != geometry.InvalidHandle());
 	RMLUI_ZoneScopedNC("ReleaseGeometry", 0x1E60D2);
 
+	// The geometry may still be referenced by the pending batch.
+	FlushGeometryBatch();
+	// The geometry may also be part of the applied clip mask, which then needs to be rendered in full on its next change.
+	clip_mask_handles.clear();
+
 	GeometryData data = geometry_list.erase(geometry.resource_handle);
-	if (data.handle)
+	if (data.batched)
+		ReleaseGeometryBatches(geometry.resource_handle);
+	if (data.shared)
+		ReleaseSharedGeometry(geometry.resource_handle, data);
+	else if (data.handle)
 		render_interface->ReleaseGeometry(data.handle);
 	return std::move(data.mesh);
 }
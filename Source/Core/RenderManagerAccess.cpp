@@ -14,17 +14,48 @@ Vector2i RenderManagerAccess::GetDimensions(RenderManager* render_manager, Stabl
 	return render_manager->texture_database->callback_database.GetDimensions(render_manager, render_manager->render_interface, callback_texture);
 }
 
+bool RenderManagerAccess::IsLoading(RenderManager* render_manager, TextureFileIndex texture)
+{
+	return render_manager->texture_database->file_database.IsLoading(texture);
+}
+
+bool RenderManagerAccess::UpdateTexture(RenderManager* render_manager, StableVectorIndex callback_texture, Rectanglei region,
+	Span<const byte> source)
+{
+	return render_manager->texture_database->callback_database.UpdateTexture(render_manager->render_interface, callback_texture, region, source);
+}
+
+TextureHandle RenderManagerAccess::GenerateCallbackTexture(RenderManager* render_manager, Span<const byte> source, Vector2i dimensions)
+{
+	return render_manager->texture_database->callback_database.GenerateTexture(render_manager->render_interface, source, dimensions);
+}
+
 void RenderManagerAccess::Render(RenderManager* render_manager, const Geometry& geometry, Vector2f translation, Texture texture,
 	const CompiledShader& shader)
 {
 	render_manager->Render(geometry, translation, texture, shader);
 }
 
+void RenderManagerAccess::FlushGeometryBatch(RenderManager* render_manager)
+{
+	render_manager->FlushGeometryBatch();
+}
+
 void RenderManagerAccess::GetTextureSourceList(RenderManager* render_manager, StringList& source_list)
 {
 	render_manager->GetTextureSourceList(source_list);
 }
 
+size_t RenderManagerAccess::GetNumFileTextures(RenderManager* render_manager)
+{
+	return render_manager->GetNumFileTextures();
+}
+
+void RenderManagerAccess::PreloadFileTextures(RenderManager* render_manager, size_t first_index)
+{
+	render_manager->PreloadFileTextures(first_index);
+}
+
 const Mesh& RenderManagerAccess::GetMesh(RenderManager* render_manager, const Geometry& geometry)
 {
 	return render_manager->GetMesh(geometry);
@@ -45,4 +76,15 @@ void RenderManagerAccess::ReleaseAllCompiledGeometry(RenderManager* render_manag
 	render_manager->ReleaseAllCompiledGeometry();
 }
 
+void RenderManagerAccess::AttachContext(RenderManager* render_manager)
+{
+	render_manager->num_contexts += 1;
+}
+
+void RenderManagerAccess::DetachContext(RenderManager* render_manager)
+{
+	RMLUI_ASSERT(render_manager->num_contexts > 0);
+	render_manager->num_contexts -= 1;
+}
+
 } // namespace Rml
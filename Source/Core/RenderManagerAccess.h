@@ -9,6 +9,8 @@ namespace Rml {
 class CompiledFilter;
 class CompiledShader;
 class CallbackTexture;
+class CallbackTextureInterface;
+class Context;
 class Geometry;
 class Texture;
 
@@ -22,21 +24,32 @@ private:
 
 	static Vector2i GetDimensions(RenderManager* render_manager, TextureFileIndex texture);
 	static Vector2i GetDimensions(RenderManager* render_manager, StableVectorIndex callback_texture);
+	static bool IsLoading(RenderManager* render_manager, TextureFileIndex texture);
+	static bool UpdateTexture(RenderManager* render_manager, StableVectorIndex callback_texture, Rectanglei region, Span<const byte> source);
+	static TextureHandle GenerateCallbackTexture(RenderManager* render_manager, Span<const byte> source, Vector2i dimensions);
 
 	static void Render(RenderManager* render_manager, const Geometry& geometry, Vector2f translation, Texture texture, const CompiledShader& shader);
+	static void FlushGeometryBatch(RenderManager* render_manager);
 
 	static void GetTextureSourceList(RenderManager* render_manager, StringList& source_list);
+	static size_t GetNumFileTextures(RenderManager* render_manager);
+	static void PreloadFileTextures(RenderManager* render_manager, size_t first_index);
 	static const Mesh& GetMesh(RenderManager* render_manager, const Geometry& geometry);
 
 	static bool ReleaseTexture(RenderManager* render_manager, const String& texture_source);
 	static void ReleaseAllTextures(RenderManager* render_manager);
 	static void ReleaseAllCompiledGeometry(RenderManager* render_manager);
 
+	static void AttachContext(RenderManager* render_manager);
+	static void DetachContext(RenderManager* render_manager);
+
 	friend class CompiledFilter;
 	friend class CompiledShader;
 	friend class CallbackTexture;
+	friend class CallbackTextureInterface;
 	friend class Geometry;
 	friend class Texture;
+	friend class Context;
 
 	friend StringList Rml::GetTextureSourceList();
 	friend bool Rml::ReleaseTexture(const String&, RenderInterface*);
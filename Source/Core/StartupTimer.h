@@ -0,0 +1,30 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/StartupStatistics.h"
+#include "../../Include/RmlUi/Core/Traits.h"
+#include <chrono>
+
+namespace Rml {
+
+/**
+    Adds the time spent in the enclosing scope to one of the startup statistics.
+ */
+class StartupTimer : NonCopyMoveable {
+public:
+	explicit StartupTimer(double& time) : time(time), start_time(Now()) {}
+	~StartupTimer() { time += Now() - start_time; }
+
+	/// Returns the statistics being recorded, see Rml::GetStartupStatistics().
+	static StartupStatistics& GetStatistics();
+	/// Adds the time spent loading a document, the first document also marks the end of startup.
+	static void AddDocumentLoad(double load_time);
+
+	/// Returns the current time of the clock used by the timers, in seconds.
+	static double Now() { return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+private:
+	double& time;
+	double start_time;
+};
+
+} // namespace Rml
@@ -69,6 +69,12 @@ size_t Stream::Read(String& string, size_t bytes) const
 	return read;
 }
 
+const byte* Stream::PeekContiguous(size_t& out_size) const
+{
+	out_size = 0;
+	return nullptr;
+}
+
 size_t Stream::Write(const Stream* stream, size_t bytes)
 {
 	return stream->Read(this, bytes);
@@ -1,7 +1,9 @@
 #include "StreamFile.h"
 #include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/FileInterface.h"
+#include "../../Include/RmlUi/Core/Math.h"
 #include "../../Include/RmlUi/Core/StringUtilities.h"
+#include <string.h>
 
 namespace Rml {
 
@@ -13,7 +15,7 @@ StreamFile::StreamFile()
 
 StreamFile::~StreamFile()
 {
-	if (file_handle)
+	if (file_handle || mapping.IsMapped())
 		StreamFile::Close();
 }
 
@@ -27,6 +29,13 @@ bool StreamFile::Open(const String& path)
 
 	// Fix the path if a leading colon has been replaced with a pipe.
 	String fixed_path = StringUtilities::Replace(path, '|', ':');
+	if (mapping.Map(fixed_path))
+	{
+		mapping_position = 0;
+		length = mapping.GetData().size();
+		return true;
+	}
+
 	file_handle = GetFileInterface()->Open(fixed_path);
 	if (!file_handle)
 	{
@@ -47,6 +56,8 @@ void StreamFile::Close()
 		file_handle = 0;
 	}
 
+	mapping.Close();
+	mapping_position = 0;
 	length = 0;
 	Stream::Close();
 }
@@ -58,19 +69,55 @@ size_t StreamFile::Length() const
 
 size_t StreamFile::Tell() const
 {
+	if (mapping.IsMapped())
+		return mapping_position;
 	return GetFileInterface()->Tell(file_handle);
 }
 
 bool StreamFile::Seek(long offset, int origin) const
 {
+	if (mapping.IsMapped())
+	{
+		long base = 0;
+		if (origin == SEEK_CUR)
+			base = (long)mapping_position;
+		else if (origin == SEEK_END)
+			base = (long)length;
+
+		const long position = base + offset;
+		if (position < 0 || position > (long)length)
+			return false;
+
+		mapping_position = (size_t)position;
+		return true;
+	}
+
 	return GetFileInterface()->Seek(file_handle, offset, origin);
 }
 
 size_t StreamFile::Read(void* buffer, size_t bytes) const
 {
+	if (mapping.IsMapped())
+	{
+		bytes = Math::Min(bytes, length - mapping_position);
+		if (bytes > 0)
+			memcpy(buffer, mapping.GetData().data() + mapping_position, bytes);
+		mapping_position += bytes;
+		return bytes;
+	}
+
 	return GetFileInterface()->Read(buffer, bytes, file_handle);
 }
 
+const byte* StreamFile::PeekContiguous(size_t& out_size) const
+{
+	if (!mapping.IsMapped())
+		return Stream::PeekContiguous(out_size);
+
+	out_size = length - mapping_position;
+	return mapping.GetData().data() + mapping_position;
+}
+
 size_t StreamFile::Write(const void* /*buffer*/, size_t /*bytes*/)
 {
 	RMLUI_ERROR;
@@ -2,6 +2,7 @@
 
 #include "../../Include/RmlUi/Core/Stream.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "FileMapping.h"
 
 namespace Rml {
 
@@ -26,6 +27,8 @@ public:
 	/// Read from the stream.
 	size_t Read(void* buffer, size_t bytes) const override;
 	using Stream::Read;
+	/// Access the remaining contents directly, only supported when the file is mapped into memory.
+	const byte* PeekContiguous(size_t& out_size) const override;
 
 	/// Write to the stream at the current position.
 	size_t Write(const void* buffer, size_t bytes) override;
@@ -45,6 +48,10 @@ private:
 
 	FileHandle file_handle;
 	size_t length;
+
+	// Files mapped into memory by the file interface are read directly from the mapping, instead of through the file handle.
+	FileMapping mapping;
+	mutable size_t mapping_position = 0;
 };
 
 } // namespace Rml
@@ -107,6 +107,12 @@ size_t StreamMemory::Truncate(size_t bytes)
 	return old_size - buffer_used;
 }
 
+const byte* StreamMemory::PeekContiguous(size_t& out_size) const
+{
+	out_size = (size_t)(buffer + buffer_used - buffer_ptr);
+	return buffer_ptr;
+}
+
 bool StreamMemory::Seek(long offset, int origin) const
 {
 	byte* new_ptr = nullptr;
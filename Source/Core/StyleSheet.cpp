@@ -1,9 +1,11 @@
 #include "../../Include/RmlUi/Core/StyleSheet.h"
 #include "../../Include/RmlUi/Core/Decorator.h"
 #include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/Math.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/PropertyDefinition.h"
 #include "../../Include/RmlUi/Core/StyleSheetSpecification.h"
+#include "EffectsCache.h"
 #include "ElementDefinition.h"
 #include "ElementStyle.h"
 #include "StyleSheetNode.h"
@@ -11,10 +13,52 @@
 
 namespace Rml {
 
+namespace {
+	// Per-thread scratch buffers used during element definition lookups, reused between calls to avoid allocations. Buffers are acquired in a
+	// stack-like fashion so that lookups are reentrant, and separate threads can match elements from separate contexts concurrently.
+	thread_local Vector<UniquePtr<StyleSheetIndex::NodeList>> applicable_nodes_buffers;
+	thread_local size_t applicable_nodes_depth = 0;
+
+	class ScopedApplicableNodes : NonCopyMoveable {
+	public:
+		ScopedApplicableNodes()
+		{
+			if (applicable_nodes_depth == applicable_nodes_buffers.size())
+				applicable_nodes_buffers.push_back(MakeUnique<StyleSheetIndex::NodeList>());
+
+			nodes = applicable_nodes_buffers[applicable_nodes_depth].get();
+			applicable_nodes_depth += 1;
+			nodes->clear();
+		}
+		~ScopedApplicableNodes() { applicable_nodes_depth -= 1; }
+
+		StyleSheetIndex::NodeList& Get() { return *nodes; }
+
+	private:
+		StyleSheetIndex::NodeList* nodes = nullptr;
+	};
+} // namespace
+
+// The minimum number of cached element definitions before unused definitions are evicted.
+static constexpr int MinElementDefinitionEvictionLimit = 256;
+
+// Returns a well-distributed hash of the node, which can be combined by addition to form a hash independent of the order of the nodes.
+static inline size_t HashNode(const StyleSheetNode* node)
+{
+	uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node));
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdull;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ull;
+	hash ^= hash >> 33;
+	return static_cast<size_t>(hash);
+}
+
 StyleSheet::StyleSheet()
 {
 	root = MakeUnique<StyleSheetNode>();
 	specificity_offset = 0;
+	node_cache_eviction_limit = MinElementDefinitionEvictionLimit;
 }
 
 StyleSheet::~StyleSheet() {}
@@ -67,6 +111,30 @@ void StyleSheet::BuildNodeIndex()
 	RMLUI_ZoneScoped;
 	styled_node_index = {};
 	root->BuildIndex(styled_node_index);
+	node_index_built = true;
+}
+
+static SelectorDependency GetDependency(const StyleSheetIndex::DependencyIndex& dependency_index, const String& name)
+{
+	auto it = dependency_index.find(Hash<String>()(name));
+	if (it != dependency_index.end())
+		return it->second;
+	return SelectorDependency::None;
+}
+
+SelectorDependency StyleSheet::GetClassDependency(const String& class_name) const
+{
+	return GetDependency(styled_node_index.class_dependencies, class_name);
+}
+
+SelectorDependency StyleSheet::GetPseudoClassDependency(const String& pseudo_class) const
+{
+	return GetDependency(styled_node_index.pseudo_class_dependencies, pseudo_class);
+}
+
+SelectorDependency StyleSheet::GetAttributeDependency(const String& attribute_name) const
+{
+	return GetDependency(styled_node_index.attribute_dependencies, attribute_name);
 }
 
 const NamedDecorator* StyleSheet::GetNamedDecorator(const String& name) const
@@ -116,8 +184,17 @@ const DecoratorPtrList& StyleSheet::InstanceDecorators(RenderManager& render_man
 	}
 
 	DecoratorPtrList& decorators = enable_cache ? decorator_cache[key] : non_cached_decorator_list;
+
+	// Decorators instanced by other style sheets can be shared, as long as they are still in use and did not depend on the style sheet.
+	if (enable_cache && EffectsCache::FindDecorators(key, render_manager, *this, decorators))
+		return decorators;
+
 	decorators.reserve(declaration_list.list.size());
 
+	// Named decorators depend on the @decorator rules of this style sheet, otherwise the decorators may only depend on its sprites.
+	bool shareable = enable_cache;
+	SpriteLookupList sprite_lookups;
+
 	for (const DecoratorDeclaration& declaration : declaration_list.list)
 	{
 		SharedPtr<Decorator> decorator;
@@ -125,8 +202,9 @@ const DecoratorPtrList& StyleSheet::InstanceDecorators(RenderManager& render_man
 		if (declaration.instancer)
 		{
 			RMLUI_ZoneScopedN("InstanceDecorator");
-			decorator = declaration.instancer->InstanceDecorator(declaration.type, declaration.properties,
-				DecoratorInstancerInterface(render_manager, *this, source));
+			DecoratorInstancerInterface instancer_interface(render_manager, *this, source);
+			instancer_interface.sprite_lookups = &sprite_lookups;
+			decorator = declaration.instancer->InstanceDecorator(declaration.type, declaration.properties, instancer_interface);
 
 			if (!decorator)
 				Log::Message(Log::LT_WARNING, "Decorator '%s' in '%s' could not be instanced, declared at %s:%d", declaration.type.c_str(),
@@ -135,6 +213,7 @@ const DecoratorPtrList& StyleSheet::InstanceDecorators(RenderManager& render_man
 		else
 		{
 			// If we have no instancer, this means the type is the name of an @decorator rule.
+			shareable = false;
 			auto it_map = named_decorator_map.find(declaration.type);
 			if (it_map != named_decorator_map.end())
 				decorator = it_map->second.instancer->InstanceDecorator(it_map->second.type, it_map->second.properties,
@@ -154,6 +233,9 @@ const DecoratorPtrList& StyleSheet::InstanceDecorators(RenderManager& render_man
 		decorators.push_back(std::move(decorator));
 	}
 
+	if (shareable && !decorators.empty())
+		EffectsCache::AddDecorators(key, render_manager, std::move(sprite_lookups), decorators);
+
 	return decorators;
 }
 
@@ -162,16 +244,63 @@ const Sprite* StyleSheet::GetSprite(const String& name) const
 	return spritesheet_list.GetSprite(name);
 }
 
-SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Element* element) const
+bool StyleSheet::IsAnyNodeApplicable(const Element* element) const
+{
+	RMLUI_ASSERT(node_index_built);
+
+	auto IsApplicable = [element](const StyleSheetNode* node) { return node->IsApplicable(element, nullptr); };
+	auto AnyApplicableNode = [&IsApplicable](const StyleSheetIndex::NodeIndex& node_index, size_t key) {
+		auto it_nodes = node_index.find(key);
+		return it_nodes != node_index.end() && std::any_of(it_nodes->second.begin(), it_nodes->second.end(), IsApplicable);
+	};
+
+	const String& id = element->GetId();
+	const ElementStyle* style = element->GetStyle();
+
+	if (!id.empty() && AnyApplicableNode(styled_node_index.ids, Hash<String>()(id)))
+		return true;
+
+	for (size_t i = 0; i < style->GetClassNameList().size(); i++)
+	{
+		if (AnyApplicableNode(styled_node_index.classes, size_t(style->GetClassAtom(i))))
+			return true;
+	}
+
+	if (AnyApplicableNode(styled_node_index.tags, size_t(style->GetTagAtom())))
+		return true;
+
+	return std::any_of(styled_node_index.other.begin(), styled_node_index.other.end(), IsApplicable);
+}
+
+SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Element* element, const StyleSheetAncestorFilter* ancestor_filter,
+	bool* out_position_dependent) const
+{
+	ScopedApplicableNodes scoped_applicable_nodes;
+	StyleSheetIndex::NodeList& applicable_nodes = scoped_applicable_nodes.Get();
+	size_t nodes_hash = 0;
+	bool position_dependent = false;
+
+	FindApplicableNodes(element, ancestor_filter, applicable_nodes, nodes_hash, position_dependent);
+
+	if (out_position_dependent)
+		*out_position_dependent = position_dependent;
+
+	return GetCachedElementDefinition(applicable_nodes, nodes_hash);
+}
+
+void StyleSheet::FindApplicableNodes(const Element* element, const StyleSheetAncestorFilter* ancestor_filter,
+	StyleSheetIndex::NodeList& applicable_nodes, size_t& out_nodes_hash, bool& out_position_dependent) const
 {
-	RMLUI_ASSERT_NONRECURSIVE;
+	bool position_dependent = false;
+	size_t nodes_hash = 0;
 
-	// Using static to avoid allocations. Make sure we don't call this function recursively.
-	static Vector<const StyleSheetNode*> applicable_nodes;
 	applicable_nodes.clear();
+	out_nodes_hash = 0;
+	out_position_dependent = false;
 
-	auto AddApplicableNodes = [element](const StyleSheetIndex::NodeIndex& node_index, const String& key) {
-		auto it_nodes = node_index.find(Hash<String>()(key));
+	auto AddApplicableNodes = [element, ancestor_filter, &applicable_nodes, &position_dependent, &nodes_hash](
+								  const StyleSheetIndex::NodeIndex& node_index, size_t key) {
+		auto it_nodes = node_index.find(key);
 		if (it_nodes != node_index.end())
 		{
 			const StyleSheetIndex::NodeList& nodes = it_nodes->second;
@@ -181,8 +310,12 @@ SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Elemen
 				// We found a node that has at least one requirement matching the element. Now see if we satisfy the remaining requirements of the
 				// node, including all ancestor nodes. What this involves is traversing the style nodes backwards, trying to match nodes in the
 				// element's hierarchy to nodes in the style hierarchy.
-				if (node->IsApplicable(element, nullptr))
+				position_dependent |= node->IsPositionDependent();
+				if (node->IsApplicable(element, nullptr, ancestor_filter))
+				{
 					applicable_nodes.push_back(node);
+					nodes_hash += HashNode(node);
+				}
 			}
 		}
 	};
@@ -190,32 +323,32 @@ SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Elemen
 	// See if there are any styles defined for this element.
 	const String& tag = element->GetTagName();
 	const String& id = element->GetId();
-	const StringList& class_names = element->GetStyle()->GetClassNameList();
+	const ElementStyle* style = element->GetStyle();
 
 	// Text elements are never matched.
 	if (tag == "#text")
-		return nullptr;
+		return;
 
 	// First, look up the indexed requirements.
 	if (!id.empty())
-		AddApplicableNodes(styled_node_index.ids, id);
+		AddApplicableNodes(styled_node_index.ids, Hash<String>()(id));
 
-	for (const String& name : class_names)
-		AddApplicableNodes(styled_node_index.classes, name);
+	for (size_t i = 0; i < style->GetClassNameList().size(); i++)
+		AddApplicableNodes(styled_node_index.classes, size_t(style->GetClassAtom(i)));
 
-	AddApplicableNodes(styled_node_index.tags, tag);
+	AddApplicableNodes(styled_node_index.tags, size_t(style->GetTagAtom()));
 
 	// Also check all remaining nodes that don't contain any indexed requirements.
 	for (const StyleSheetNode* node : styled_node_index.other)
 	{
-		if (node->IsApplicable(element, nullptr))
+		position_dependent |= node->IsPositionDependent();
+		if (node->IsApplicable(element, nullptr, ancestor_filter))
+		{
 			applicable_nodes.push_back(node);
+			nodes_hash += HashNode(node);
+		}
 	}
 
-	// If this element definition won't actually store any information, don't bother with it.
-	if (applicable_nodes.empty())
-		return nullptr;
-
 	// Sort the applicable nodes by specificity first, then by pointer value in case we have duplicate specificities.
 	std::sort(applicable_nodes.begin(), applicable_nodes.end(), [](const StyleSheetNode* a, const StyleSheetNode* b) {
 		const int a_specificity = a->GetSpecificity();
@@ -225,15 +358,73 @@ SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Elemen
 		return a_specificity < b_specificity;
 	});
 
+	out_nodes_hash = nodes_hash;
+	out_position_dependent = position_dependent;
+}
+
+SharedPtr<const ElementDefinition> StyleSheet::GetCachedElementDefinition(const StyleSheetIndex::NodeList& applicable_nodes, size_t nodes_hash) const
+{
+	// If this element definition won't actually store any information, don't bother with it.
+	if (applicable_nodes.empty())
+		return nullptr;
+
 	// Check if this puppy has already been cached in the node index.
-	SharedPtr<const ElementDefinition>& definition = node_cache[applicable_nodes];
-	if (!definition)
+	Vector<CachedElementDefinition>& cached_definitions = node_cache[nodes_hash];
+	for (CachedElementDefinition& cached : cached_definitions)
 	{
-		// Otherwise, create a new definition and add it to our cache.
-		definition = MakeShared<const ElementDefinition>(applicable_nodes);
+		if (cached.nodes == applicable_nodes)
+		{
+			cached.generation = node_cache_generation;
+			node_cache_stats.num_hits += 1;
+			return cached.definition;
+		}
 	}
 
+	// Otherwise, create a new definition and add it to our cache.
+	SharedPtr<const ElementDefinition> definition = MakeShared<const ElementDefinition>(applicable_nodes);
+	cached_definitions.push_back(CachedElementDefinition{applicable_nodes, definition, node_cache_generation});
+	node_cache_stats.num_misses += 1;
+	node_cache_stats.num_definitions += 1;
+
+	if (node_cache_stats.num_definitions > node_cache_eviction_limit)
+		EvictUnusedElementDefinitions();
+
 	return definition;
 }
 
+void StyleSheet::EvictUnusedElementDefinitions() const
+{
+	RMLUI_ZoneScoped;
+
+	// Evict definitions that are only referenced by the cache, unless they have been looked up during the current generation. The latter are likely
+	// to be used again soon, such as when toggling a pseudo-class back and forth.
+	for (auto it = node_cache.begin(); it != node_cache.end();)
+	{
+		Vector<CachedElementDefinition>& cached_definitions = it->second;
+		auto it_remove = std::remove_if(cached_definitions.begin(), cached_definitions.end(), [this](const CachedElementDefinition& cached) {
+			return cached.definition.use_count() == 1 && cached.generation != node_cache_generation;
+		});
+
+		const int num_evicted = int(cached_definitions.end() - it_remove);
+		node_cache_stats.num_evictions += num_evicted;
+		node_cache_stats.num_definitions -= num_evicted;
+		cached_definitions.erase(it_remove, cached_definitions.end());
+
+		if (cached_definitions.empty())
+			it = node_cache.erase(it);
+		else
+			++it;
+	}
+
+	node_cache_generation += 1;
+
+	// Grow the limit with the number of definitions in use, to keep the cost of eviction proportional to the number of lookups.
+	node_cache_eviction_limit = Math::Max(MinElementDefinitionEvictionLimit, 2 * node_cache_stats.num_definitions);
+}
+
+ElementDefinitionCacheStats StyleSheet::GetElementDefinitionCacheStats() const
+{
+	return node_cache_stats;
+}
+
 } // namespace Rml
@@ -0,0 +1,44 @@
+#include "StyleSheetAncestorFilter.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "ElementStyle.h"
+#include <algorithm>
+
+namespace Rml {
+
+size_t StyleSheetAncestorFilter::Hash(NameType type, const String& name)
+{
+	// Mix in the type so that e.g. a tag and a class with the same name occupy different bits, and spread the bits used by the filter.
+	uint64_t hash = uint64_t(Rml::Hash<String>()(name)) ^ (uint64_t(type) << 56);
+	hash *= 0x9E3779B97F4A7C15ull;
+	return size_t(hash ^ (hash >> 29));
+}
+
+size_t StyleSheetAncestorFilter::Hash(NameType type, Atom name)
+{
+	uint64_t hash = uint64_t(name) ^ (uint64_t(type) << 56);
+	hash *= 0x9E3779B97F4A7C15ull;
+	return size_t(hash ^ (hash >> 29));
+}
+
+void StyleSheetAncestorFilter::Build(const StyleSheetAncestorFilter* parent_filter, const Element* parent)
+{
+	if (parent_filter)
+		std::copy(std::begin(parent_filter->bits), std::end(parent_filter->bits), std::begin(bits));
+	else
+		std::fill(std::begin(bits), std::end(bits), uint64_t(0));
+
+	if (!parent)
+		return;
+
+	const ElementStyle* style = parent->GetStyle();
+	Insert(Hash(NameType::Tag, style->GetTagAtom()));
+
+	const String& id = parent->GetId();
+	if (!id.empty())
+		Insert(Hash(NameType::Id, id));
+
+	for (size_t i = 0; i < style->GetClassNameList().size(); i++)
+		Insert(Hash(NameType::Class, style->GetClassAtom(i)));
+}
+
+} // namespace Rml
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Types.h"
+#include "Atom.h"
+
+namespace Rml {
+
+class Element;
+
+/**
+    A bloom filter of the tag, id, and class names of an element's ancestors.
+
+    Used during style sheet matching to reject nodes with ancestor requirements that can't possibly be satisfied by the element's ancestors,
+    before walking the element hierarchy. False positives are possible, false negatives are not.
+ */
+class StyleSheetAncestorFilter {
+public:
+	enum class NameType : uint8_t { Tag = 1, Id, Class };
+
+	/// Returns the hash of a name as used for insertion and lookup.
+	static size_t Hash(NameType type, const String& name);
+	/// Returns the hash of an interned name, used for tag and class names.
+	static size_t Hash(NameType type, Atom name);
+
+	/// Replaces the filter contents with the given element's ancestors, including the given parent (may be nullptr).
+	/// @note The filter of the parent element must already be up-to-date.
+	void Build(const StyleSheetAncestorFilter* parent_filter, const Element* parent);
+
+	/// Returns false if no ancestor has the given name, true if some ancestor may have the name.
+	bool MayContain(size_t hash) const
+	{
+		const size_t bit0 = hash % NumBits;
+		const size_t bit1 = (hash >> 16) % NumBits;
+		return (bits[bit0 / 64] & (uint64_t(1) << (bit0 % 64))) && (bits[bit1 / 64] & (uint64_t(1) << (bit1 % 64)));
+	}
+
+private:
+	void Insert(size_t hash)
+	{
+		const size_t bit0 = hash % NumBits;
+		const size_t bit1 = (hash >> 16) % NumBits;
+		bits[bit0 / 64] |= (uint64_t(1) << (bit0 % 64));
+		bits[bit1 / 64] |= (uint64_t(1) << (bit1 % 64));
+	}
+
+	static constexpr size_t NumBits = 256;
+	uint64_t bits[NumBits / 64] = {};
+};
+
+} // namespace Rml
@@ -1,12 +1,18 @@
 #include "../../Include/RmlUi/Core/StyleSheetContainer.h"
 #include "../../Include/RmlUi/Core/ComputedValues.h"
 #include "../../Include/RmlUi/Core/Context.h"
+#include "../../Include/RmlUi/Core/Element.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/PropertyDictionary.h"
 #include "../../Include/RmlUi/Core/StyleSheet.h"
 #include "../../Include/RmlUi/Core/Utilities.h"
 #include "ComputeProperty.h"
+#include "StartupTimer.h"
+#include "StyleSheetFactory.h"
+#include "StyleSheetNode.h"
 #include "StyleSheetParser.h"
+#include <algorithm>
+#include <iterator>
 
 namespace Rml {
 
@@ -17,6 +23,15 @@ StyleSheetContainer::~StyleSheetContainer() {}
 bool StyleSheetContainer::LoadStyleSheetContainer(Stream* stream, int begin_line_number)
 {
 	StyleSheetParser parser;
+
+	// Sheets parsed concurrently are recorded in the startup statistics by the thread which started the parsing.
+	if (StyleSheetParser::IsParsingConcurrently())
+		return parser.Parse(media_blocks, stream, begin_line_number);
+
+	StartupStatistics& startup = StartupTimer::GetStatistics();
+	StartupTimer timer(startup.style_sheet_parsing_time);
+	startup.num_style_sheets += 1;
+
 	bool result = parser.Parse(media_blocks, stream, begin_line_number);
 	return result;
 }
@@ -124,30 +139,53 @@ bool StyleSheetContainer::UpdateCompiledStyleSheet(const Context* context)
 
 	if (style_sheet_changed)
 	{
-		StyleSheet* first_sheet = nullptr;
-		UniquePtr<StyleSheet> new_sheet;
-
-		for (int index : new_active_media_block_indices)
+		// Find the media blocks that changed state. Any element not matched by their rules retains the same definition, unless they define other
+		// rules that may apply to it indirectly.
+		Vector<int> changed_media_block_indices;
+		std::set_symmetric_difference(active_media_block_indices.begin(), active_media_block_indices.end(), new_active_media_block_indices.begin(),
+			new_active_media_block_indices.end(), std::back_inserter(changed_media_block_indices));
+
+		changed_style_sheets.clear();
+		for (int index : changed_media_block_indices)
+			changed_style_sheets.push_back(media_blocks[index].stylesheet);
+		all_definitions_affected = !compiled_style_sheet || DefinesIndirectRules(changed_style_sheets);
+		BuildChangedNodeIndices();
+
+		auto it_cache = std::find_if(compiled_style_sheet_cache.begin(), compiled_style_sheet_cache.end(),
+			[&](const CompiledStyleSheet& compiled) { return compiled.media_block_indices == new_active_media_block_indices; });
+
+		if (it_cache != compiled_style_sheet_cache.end())
 		{
-			MediaBlock& media_block = media_blocks[index];
-			if (!first_sheet)
-				first_sheet = media_block.stylesheet.get();
-			else if (!new_sheet)
-				new_sheet = first_sheet->CombineStyleSheet(*media_block.stylesheet);
-			else
-				new_sheet->MergeStyleSheet(*media_block.stylesheet);
+			// Keep the cache ordered from least to most recently used.
+			std::rotate(it_cache, it_cache + 1, compiled_style_sheet_cache.end());
+			compiled_style_sheet = compiled_style_sheet_cache.back().style_sheet.get();
 		}
-
-		if (!first_sheet)
+		else
 		{
-			new_sheet.reset(new StyleSheet);
-			first_sheet = new_sheet.get();
-		}
+			Vector<SharedPtr<StyleSheet>> active_sheets;
+			active_sheets.reserve(new_active_media_block_indices.size());
+			for (int index : new_active_media_block_indices)
+				active_sheets.push_back(media_blocks[index].stylesheet);
 
-		compiled_style_sheet = (new_sheet ? new_sheet.get() : first_sheet);
-		combined_compiled_style_sheet = std::move(new_sheet);
+			SharedPtr<StyleSheet> new_sheet;
+			if (active_sheets.empty())
+			{
+				new_sheet.reset(new StyleSheet);
+				new_sheet->BuildNodeIndex();
+			}
+			else
+			{
+				new_sheet = StyleSheetFactory::GetCombinedStyleSheet(active_sheets);
+			}
+
+			compiled_style_sheet = new_sheet.get();
+			compiled_style_sheet_cache.push_back(CompiledStyleSheet{new_active_media_block_indices, std::move(new_sheet)});
 
-		compiled_style_sheet->BuildNodeIndex();
+			// Each combination of active media blocks is compiled separately, such as for every theme or viewport range, release the least
+			// recently used ones once too many have been compiled.
+			if (compiled_style_sheet_cache.size() > MaxCompiledStyleSheets)
+				compiled_style_sheet_cache.erase(compiled_style_sheet_cache.begin());
+		}
 	}
 
 	active_media_block_indices = std::move(new_active_media_block_indices);
@@ -155,11 +193,80 @@ bool StyleSheetContainer::UpdateCompiledStyleSheet(const Context* context)
 	return style_sheet_changed;
 }
 
+bool StyleSheetContainer::UpdateCompiledStyleSheet(const Context* context, const StyleSheetContainer& previous)
+{
+	RMLUI_ZoneScoped;
+
+	UpdateCompiledStyleSheet(context);
+
+	auto GetActiveStyleSheets = [](const StyleSheetContainer& container) {
+		Vector<SharedPtr<StyleSheet>> style_sheets;
+		for (int index : container.active_media_block_indices)
+			style_sheets.push_back(container.media_blocks[index].stylesheet);
+		return style_sheets;
+	};
+	const Vector<SharedPtr<StyleSheet>> active_sheets = GetActiveStyleSheets(*this);
+	const Vector<SharedPtr<StyleSheet>> previous_active_sheets = GetActiveStyleSheets(previous);
+
+	// Sheets are compared by identity, sheets loaded from unchanged sources are shared between the containers.
+	auto Contains = [](const Vector<SharedPtr<StyleSheet>>& style_sheets, const SharedPtr<StyleSheet>& style_sheet) {
+		return std::find(style_sheets.begin(), style_sheets.end(), style_sheet) != style_sheets.end();
+	};
+
+	changed_style_sheets.clear();
+	Vector<SharedPtr<StyleSheet>> retained_sheets, previous_retained_sheets;
+	for (const SharedPtr<StyleSheet>& style_sheet : active_sheets)
+		(Contains(previous_active_sheets, style_sheet) ? retained_sheets : changed_style_sheets).push_back(style_sheet);
+	for (const SharedPtr<StyleSheet>& style_sheet : previous_active_sheets)
+		(Contains(active_sheets, style_sheet) ? previous_retained_sheets : changed_style_sheets).push_back(style_sheet);
+
+	// Rules of equal specificity take precedence by their order, thus reordered sheets may affect any element.
+	all_definitions_affected = (retained_sheets != previous_retained_sheets) || DefinesIndirectRules(changed_style_sheets);
+	BuildChangedNodeIndices();
+
+	return all_definitions_affected || !changed_style_sheets.empty() || compiled_style_sheet != previous.compiled_style_sheet;
+}
+
 StyleSheet* StyleSheetContainer::GetCompiledStyleSheet()
 {
 	return compiled_style_sheet;
 }
 
+bool StyleSheetContainer::IsDefinitionAffectedByChange(const Element* element) const
+{
+	if (all_definitions_affected)
+		return true;
+	if (element->GetTagName() == "#text")
+		return false;
+
+	for (const SharedPtr<StyleSheet>& style_sheet : changed_style_sheets)
+	{
+		if (style_sheet->IsAnyNodeApplicable(element))
+			return true;
+	}
+
+	return false;
+}
+
+void StyleSheetContainer::BuildChangedNodeIndices()
+{
+	// Elements are matched against the changed sheets through their node index, built once for each shared sheet.
+	if (all_definitions_affected)
+		return;
+	for (const SharedPtr<StyleSheet>& style_sheet : changed_style_sheets)
+	{
+		if (!style_sheet->HasNodeIndex())
+			style_sheet->BuildNodeIndex();
+	}
+}
+
+bool StyleSheetContainer::DefinesIndirectRules(const Vector<SharedPtr<StyleSheet>>& style_sheets)
+{
+	return std::any_of(style_sheets.begin(), style_sheets.end(), [](const SharedPtr<StyleSheet>& style_sheet) {
+		return !style_sheet->keyframes.empty() || !style_sheet->named_decorator_map.empty() || style_sheet->spritesheet_list.NumSpriteSheets() > 0;
+	});
+}
+
 SharedPtr<StyleSheetContainer> StyleSheetContainer::CombineStyleSheetContainer(const StyleSheetContainer& container) const
 {
 	RMLUI_ZoneScoped;
@@ -1,15 +1,26 @@
 #include "StyleSheetFactory.h"
+#include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/Log.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/StreamMemory.h"
+#include "../../Include/RmlUi/Core/StyleSheet.h"
 #include "../../Include/RmlUi/Core/StyleSheetContainer.h"
+#include "../../Include/RmlUi/Core/TaskInterface.h"
+#include "../../Include/RmlUi/Core/Utilities.h"
+#include "StartupTimer.h"
 #include "StreamFile.h"
 #include "StyleSheetNode.h"
 #include "StyleSheetParser.h"
 #include "StyleSheetSelector.h"
+#include <algorithm>
 
 namespace Rml {
 
 static UniquePtr<StyleSheetFactory> instance;
 
+// The number of distinct inline style sheets kept parsed for documents loaded later.
+static constexpr size_t MaxCachedInlineStyleSheets = 128;
+
 StyleSheetFactory::StyleSheetFactory() :
 	selectors{
 		{"nth-child", StructuralSelectorType::Nth_Child},
@@ -42,29 +53,305 @@ void StyleSheetFactory::Shutdown()
 	instance.reset();
 }
 
+// Reads the file of the sheet into memory, returns false if it can't be opened.
+static bool ReadStyleSheetFile(String& out_contents, URL& out_url, const String& sheet)
+{
+	StreamFile stream;
+	if (!stream.Open(sheet))
+		return false;
+	out_url = stream.GetSourceURL();
+	stream.Read(out_contents, stream.Length());
+	return true;
+}
+
+static String CreateInlineStyleSheetKey(const String& content, const String& source_path, int line_number)
+{
+	String key = CreateString("%s:%d:", source_path.c_str(), line_number);
+	key += content;
+	return key;
+}
+
+// Parses the contents of the file into its sheet, recording the hash of the contents.
+static void ParseFile(StyleSheetFactory::StyleSheetFile& file)
+{
+	file.contents_hash = Hash<String>()(file.contents);
+	StreamMemory stream((const byte*)file.contents.data(), file.contents.size());
+	stream.SetSourceURL(file.url);
+
+	auto style_sheet = MakeUnique<StyleSheetContainer>();
+	if (style_sheet->LoadStyleSheetContainer(&stream, file.line_number))
+		file.style_sheet = std::move(style_sheet);
+}
+
 const StyleSheetContainer* StyleSheetFactory::GetStyleSheetContainer(const String& sheet_name)
 {
 	// Look up the sheet definition in the cache
 	auto it = instance->stylesheets.find(sheet_name);
 	if (it != instance->stylesheets.end())
-		return it->second.get();
+		return it->second.style_sheet.get();
 
 	// Don't currently have the sheet, attempt to load it
-	UniquePtr<const StyleSheetContainer> sheet = instance->LoadStyleSheetContainer(sheet_name);
-	if (!sheet)
+	Vector<StyleSheetFile> files(1);
+	StyleSheetFile& file = files[0];
+	file.sheet = sheet_name;
+	if (!ReadStyleSheetFile(file.contents, file.url, sheet_name))
 		return nullptr;
 
-	const StyleSheetContainer* result = sheet.get();
+	instance->ParseStyleSheetFiles(files);
+
+	it = instance->stylesheets.find(sheet_name);
+	return it != instance->stylesheets.end() ? it->second.style_sheet.get() : nullptr;
+}
+
+void StyleSheetFactory::LoadStyleSheetContainers(const StringList& sheets)
+{
+	if (!GetTaskInterface())
+		return;
+
+	Vector<StyleSheetFile> files;
+	for (const String& sheet : sheets)
+	{
+		if (instance->stylesheets.count(sheet) ||
+			std::any_of(files.begin(), files.end(), [&sheet](const StyleSheetFile& file) { return file.sheet == sheet; }))
+			continue;
+		files.emplace_back();
+		files.back().sheet = sheet;
+	}
+
+	if (files.size() < 2)
+		return;
+
+	RMLUI_ZoneScoped;
+
+	// Sheets which can't be opened are left to report their errors when loaded on first use.
+	auto ReadFile = [](StyleSheetFile& file) { return ReadStyleSheetFile(file.contents, file.url, file.sheet); };
+	files.erase(std::remove_if(files.begin(), files.end(), [&](StyleSheetFile& file) { return !ReadFile(file); }), files.end());
+
+	instance->ParseStyleSheetFiles(files);
+}
+
+int StyleSheetFactory::ReloadStyleSheetContainers()
+{
+	RMLUI_ZoneScoped;
+
+	Vector<StyleSheetFile> changed_files;
+	for (auto it = instance->stylesheets.begin(); it != instance->stylesheets.end();)
+	{
+		StyleSheetFile file;
+		file.sheet = it->first;
+		if (!ReadStyleSheetFile(file.contents, file.url, file.sheet))
+		{
+			it = instance->stylesheets.erase(it);
+			continue;
+		}
+
+		if (Hash<String>()(file.contents) != it->second.contents_hash)
+			changed_files.push_back(std::move(file));
+		++it;
+	}
+
+	instance->ParseStyleSheetFiles(changed_files);
+
+	return (int)changed_files.size();
+}
+
+void StyleSheetFactory::ParseStyleSheetFiles(Vector<StyleSheetFile>& files)
+{
+	TaskInterface* task_interface = GetTaskInterface();
+	if (task_interface && files.size() >= 2)
+	{
+		// The file interface may not be thread-safe, thus the files have been read up front on the calling thread.
+		StartupStatistics& startup = StartupTimer::GetStatistics();
+		StartupTimer timer(startup.style_sheet_parsing_time);
+		startup.num_style_sheets += (int)files.size();
+
+		task_interface->ParallelFor((int)files.size(), [&files](int index) { ParseStyleSheetFile(files[index]); });
+	}
+	else
+	{
+		for (StyleSheetFile& file : files)
+			ParseFile(file);
+	}
+
+	// Report the messages and add the sheets to the cache in the given order, as if the sheets were loaded one after another.
+	for (StyleSheetFile& file : files)
+	{
+		LogCapture::Replay(file.log_messages);
+		if (file.style_sheet)
+			stylesheets[file.sheet] = LinkedStyleSheet{std::move(file.style_sheet), file.contents_hash};
+		else
+			stylesheets.erase(file.sheet);
+	}
+}
 
-	// Add it to the cache.
-	instance->stylesheets[sheet_name] = std::move(sheet);
+bool StyleSheetFactory::ReadLinkedStyleSheetFile(StyleSheetFile& out_file, const String& sheet)
+{
+	if (instance->stylesheets.count(sheet))
+		return false;
+	out_file.sheet = sheet;
+	return ReadStyleSheetFile(out_file.contents, out_file.url, sheet);
+}
+
+StyleSheetFactory::StyleSheetFile StyleSheetFactory::MakeInlineStyleSheetFile(const String& content, const String& source_path, int line_number)
+{
+	StyleSheetFile file;
+	file.sheet = source_path;
+	file.url = URL(source_path);
+	file.contents = content;
+	file.is_inline = true;
+	file.line_number = line_number;
+	return file;
+}
+
+void StyleSheetFactory::ParseStyleSheetFile(StyleSheetFile& file)
+{
+	StyleSheetParser::ConcurrentScope concurrent_scope(file.log_messages);
+	ParseFile(file);
+}
+
+void StyleSheetFactory::AddParsedStyleSheetFiles(Vector<StyleSheetFile>& files)
+{
+	// The sheets were parsed elsewhere, they are only counted here.
+	StartupTimer::GetStatistics().num_style_sheets += (int)files.size();
+
+	for (StyleSheetFile& file : files)
+	{
+		LogCapture::Replay(file.log_messages);
+		if (!file.style_sheet)
+			continue;
+
+		if (file.is_inline)
+		{
+			String key = CreateInlineStyleSheetKey(file.contents, file.sheet, file.line_number);
+			if (!instance->inline_stylesheets.count(key))
+				instance->AddInlineStyleSheet(std::move(key), std::move(file.style_sheet));
+		}
+		else if (!instance->stylesheets.count(file.sheet))
+		{
+			instance->stylesheets[file.sheet] = LinkedStyleSheet{std::move(file.style_sheet), file.contents_hash};
+		}
+	}
+}
+
+const StyleSheetContainer* StyleSheetFactory::GetInlineStyleSheetContainer(const String& content, const String& source_path, int line_number)
+{
+	String key = CreateInlineStyleSheetKey(content, source_path, line_number);
+
+	auto it = instance->inline_stylesheets.find(key);
+	if (it != instance->inline_stylesheets.end())
+	{
+		it->second.last_used = ++instance->inline_stylesheets_use_counter;
+		return it->second.style_sheet.get();
+	}
+
+	auto sheet = MakeUnique<StyleSheetContainer>();
+	StreamMemory stream((const byte*)content.c_str(), content.size());
+	stream.SetSourceURL(source_path);
+	if (!sheet->LoadStyleSheetContainer(&stream, line_number))
+		return nullptr;
+
+	const StyleSheetContainer* result = sheet.get();
+	instance->AddInlineStyleSheet(std::move(key), std::move(sheet));
 
 	return result;
 }
 
+void StyleSheetFactory::AddInlineStyleSheet(String key, UniquePtr<const StyleSheetContainer> style_sheet)
+{
+	if (inline_stylesheets.size() >= MaxCachedInlineStyleSheets)
+	{
+		auto it_oldest = std::min_element(inline_stylesheets.begin(), inline_stylesheets.end(),
+			[](const auto& a, const auto& b) { return a.second.last_used < b.second.last_used; });
+		inline_stylesheets.erase(it_oldest);
+	}
+
+	inline_stylesheets[std::move(key)] = InlineStyleSheet{std::move(style_sheet), ++inline_stylesheets_use_counter};
+}
+
+SharedPtr<StyleSheet> StyleSheetFactory::GetCombinedStyleSheet(const Vector<SharedPtr<StyleSheet>>& style_sheets)
+{
+	RMLUI_ASSERT(!style_sheets.empty());
+
+	size_t hash = 0;
+	for (const SharedPtr<StyleSheet>& style_sheet : style_sheets)
+		Utilities::HashCombine(hash, style_sheet.get());
+
+	// The source sheets are compared through weak references, so that a new sheet allocated at the address of a destroyed one is not mistaken
+	// for it.
+	auto MatchesSources = [&style_sheets](const CombinedStyleSheet& entry) {
+		if (entry.sources.size() != style_sheets.size())
+			return false;
+		for (size_t i = 0; i < style_sheets.size(); i++)
+		{
+			if (entry.sources[i].lock() != style_sheets[i])
+				return false;
+		}
+		return true;
+	};
+
+	auto it_entries = instance->combined_stylesheets.find(hash);
+	if (it_entries != instance->combined_stylesheets.end())
+	{
+		for (const CombinedStyleSheet& entry : it_entries->second)
+		{
+			if (!MatchesSources(entry))
+				continue;
+			if (SharedPtr<StyleSheet> combined = entry.combined.lock())
+				return combined;
+		}
+	}
+
+	SharedPtr<StyleSheet> combined;
+	if (style_sheets.size() == 1)
+	{
+		combined = style_sheets[0];
+	}
+	else
+	{
+		UniquePtr<StyleSheet> new_sheet = style_sheets[0]->CombineStyleSheet(*style_sheets[1]);
+		for (size_t i = 2; i < style_sheets.size(); i++)
+			new_sheet->MergeStyleSheet(*style_sheets[i]);
+		combined = std::move(new_sheet);
+	}
+	combined->BuildNodeIndex();
+
+	// Remove entries whose sheets have been destroyed in the meantime.
+	auto IsExpired = [](const CombinedStyleSheet& entry) {
+		if (entry.combined.expired())
+			return true;
+		return std::any_of(entry.sources.begin(), entry.sources.end(), [](const WeakPtr<StyleSheet>& source) { return source.expired(); });
+	};
+	for (auto it = instance->combined_stylesheets.begin(); it != instance->combined_stylesheets.end();)
+	{
+		Vector<CombinedStyleSheet>& bucket = it->second;
+		bucket.erase(std::remove_if(bucket.begin(), bucket.end(), IsExpired), bucket.end());
+		if (bucket.empty())
+			it = instance->combined_stylesheets.erase(it);
+		else
+			++it;
+	}
+
+	Vector<WeakPtr<StyleSheet>> sources(style_sheets.begin(), style_sheets.end());
+	instance->combined_stylesheets[hash].push_back(CombinedStyleSheet{std::move(sources), combined});
+
+	return combined;
+}
+
 void StyleSheetFactory::ClearStyleSheetCache()
 {
 	instance->stylesheets.clear();
+	instance->inline_stylesheets.clear();
+	instance->combined_stylesheets.clear();
+}
+
+int StyleSheetFactory::GetNumCachedStyleSheets()
+{
+	return instance ? (int)instance->stylesheets.size() : 0;
+}
+
+int StyleSheetFactory::GetNumCachedInlineStyleSheets()
+{
+	return instance ? (int)instance->inline_stylesheets.size() : 0;
 }
 
 StructuralSelector StyleSheetFactory::GetSelector(const String& name)
@@ -179,22 +466,4 @@ StructuralSelector StyleSheetFactory::GetSelector(const String& name)
 	return StructuralSelector(selector_type, a, b);
 }
 
-UniquePtr<const StyleSheetContainer> StyleSheetFactory::LoadStyleSheetContainer(const String& sheet)
-{
-	UniquePtr<StyleSheetContainer> new_style_sheet;
-
-	// Open stream, construct new sheet and pass the stream into the sheet
-	auto stream = MakeUnique<StreamFile>();
-	if (stream->Open(sheet))
-	{
-		new_style_sheet = MakeUnique<StyleSheetContainer>();
-		if (!new_style_sheet->LoadStyleSheetContainer(stream.get()))
-		{
-			new_style_sheet.reset();
-		}
-	}
-
-	return new_style_sheet;
-}
-
 } // namespace Rml
@@ -1,15 +1,21 @@
 #pragma once
 
 #include "../../Include/RmlUi/Core/Types.h"
+#include "../../Include/RmlUi/Core/URL.h"
+#include "LogCapture.h"
 
 namespace Rml {
 
+class StyleSheet;
 class StyleSheetContainer;
 enum class StructuralSelectorType;
 struct StructuralSelector;
 
 /**
     Creates stylesheets on the fly as needed. The factory keeps a cache of built sheets for optimisation.
+
+    Loaded and combined style sheets are immutable once built, and shared between all documents and contexts using them. Thus, documents loaded
+    from the same sources into many contexts only parse and compile their style sheets once.
  */
 
 class StyleSheetFactory {
@@ -26,9 +32,59 @@ public:
 	/// @lifetime Returned pointer is valid until the next call to ClearStyleSheetCache or Shutdown, it should not be stored around.
 	static const StyleSheetContainer* GetStyleSheetContainer(const String& sheet);
 
+	/// Loads the given sheets into the cache, unless they are already cached. The sheets are parsed concurrently through the task interface when
+	/// one is installed, otherwise they are left to be loaded on first use.
+	static void LoadStyleSheetContainers(const StringList& sheets);
+
+	/// Reads the cached sheets again from their files, and parses only the sheets whose contents changed since they were loaded. Sheets which
+	/// can no longer be loaded are removed from the cache.
+	/// @return The number of sheets parsed again.
+	/// @lifetime Pointers to the replaced sheets are invalidated.
+	static int ReloadStyleSheetContainers();
+
+	/// Gets the sheet parsed from an inline style block, retrieving it from the cache if the same block has already been parsed. Also used for
+	/// sheets instanced through the factory from strings and streams.
+	/// @param content The contents of the style block.
+	/// @param source_path The path of the document containing the block, used for resolving paths and reporting errors.
+	/// @param line_number The line number of the block within its document.
+	/// @lifetime Returned pointer is valid until the next call to ClearStyleSheetCache or Shutdown, it should not be stored around.
+	static const StyleSheetContainer* GetInlineStyleSheetContainer(const String& content, const String& source_path, int line_number);
+
+	/// A style sheet read on the calling thread, to be parsed separately, such as by documents parsed in the background.
+	struct StyleSheetFile {
+		// The path of a linked sheet, or the path of the document containing an inline sheet.
+		String sheet;
+		URL url;
+		String contents;
+		bool is_inline = false;
+		// The line number the sheet begins at, for inline sheets the line of their block within the document.
+		int line_number = 1;
+		size_t contents_hash = 0;
+		UniquePtr<StyleSheetContainer> style_sheet;
+		CapturedLogMessageList log_messages;
+	};
+
+	/// Reads a linked sheet for parsing with ParseStyleSheetFile(), unless it is already cached.
+	/// @return False if the sheet is already cached or its file can't be opened.
+	static bool ReadLinkedStyleSheetFile(StyleSheetFile& out_file, const String& sheet);
+	/// Makes an inline sheet for parsing with ParseStyleSheetFile(), see GetInlineStyleSheetContainer() for the parameters.
+	static StyleSheetFile MakeInlineStyleSheetFile(const String& content, const String& source_path, int line_number);
+	/// Parses the contents of the file into its sheet. The file may be parsed on any thread, concurrently with the main thread, as long as no
+	/// properties or instancers are registered meanwhile. The log messages of the parse are captured in the file.
+	static void ParseStyleSheetFile(StyleSheetFile& file);
+	/// Adds files parsed with ParseStyleSheetFile() to the cache and reports their log messages. Sheets cached in the meantime are kept instead.
+	static void AddParsedStyleSheetFiles(Vector<StyleSheetFile>& files);
+
+	/// Returns the combination of the given style sheets, in order of increasing precedence, with its node index built. The combined sheet is
+	/// shared between all style sheet containers combining the same sheets.
+	static SharedPtr<StyleSheet> GetCombinedStyleSheet(const Vector<SharedPtr<StyleSheet>>& style_sheets);
+
 	/// Clear the style sheet cache.
 	static void ClearStyleSheetCache();
 
+	static int GetNumCachedStyleSheets();
+	static int GetNumCachedInlineStyleSheets();
+
 	/// Returns one of the available node selectors.
 	/// @param name[in] The name of the desired selector.
 	/// @return The selector registered with the given name, or nullptr if none exists.
@@ -37,12 +93,35 @@ public:
 private:
 	StyleSheetFactory();
 
-	// Loads an individual style sheet
-	UniquePtr<const StyleSheetContainer> LoadStyleSheetContainer(const String& sheet);
+	// Parses the read files, concurrently through the task interface when possible, and adds them to the cache in the given order.
+	void ParseStyleSheetFiles(Vector<StyleSheetFile>& files);
+
+	// Individual loaded stylesheets, along with the hash of their file contents to detect changes when reloading.
+	struct LinkedStyleSheet {
+		UniquePtr<const StyleSheetContainer> style_sheet;
+		size_t contents_hash;
+	};
+	UnorderedMap<String, LinkedStyleSheet> stylesheets;
+
+	// Inline stylesheets, keyed by their source path, line number, and contents. Documents with generated style contents could otherwise grow
+	// the cache indefinitely, thus it is bounded by releasing the least recently used sheets first. Documents keep the media blocks they use.
+	struct InlineStyleSheet {
+		UniquePtr<const StyleSheetContainer> style_sheet;
+		uint64_t last_used;
+	};
+	UnorderedMap<String, InlineStyleSheet> inline_stylesheets;
+	uint64_t inline_stylesheets_use_counter = 0;
+
+	// Adds a parsed inline sheet to the cache, releasing the least recently used sheet when full.
+	void AddInlineStyleSheet(String key, UniquePtr<const StyleSheetContainer> style_sheet);
 
-	// Individual loaded stylesheets
-	using StyleSheets = UnorderedMap<String, UniquePtr<const StyleSheetContainer>>;
-	StyleSheets stylesheets;
+	// Combined stylesheets, keyed by the hash of their source sheets. The entries only hold weak references, and are removed once expired.
+	struct CombinedStyleSheet {
+		Vector<WeakPtr<StyleSheet>> sources;
+		WeakPtr<StyleSheet> combined;
+	};
+	using CombinedStyleSheets = UnorderedMap<size_t, Vector<CombinedStyleSheet>>;
+	CombinedStyleSheets combined_stylesheets;
 
 	// Custom complex selectors available for style sheets.
 	using SelectorMap = UnorderedMap<String, StructuralSelectorType>;
@@ -2,6 +2,8 @@
 #include "../../Include/RmlUi/Core/Element.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/StyleSheet.h"
+#include "ElementStyle.h"
+#include "StyleSheetAncestorFilter.h"
 #include "StyleSheetFactory.h"
 #include "StyleSheetSelector.h"
 #include <algorithm>
@@ -14,6 +16,38 @@ static inline bool IsTextElement(const Element* element)
 	return element->GetTagName() == "#text";
 }
 
+// Returns true if all the given classes are set on the element.
+static inline bool HasClasses(const ElementStyle* style, uint64_t class_mask, const Vector<Atom>& class_atoms)
+{
+	if ((style->GetClassMask() & class_mask) != class_mask)
+		return false;
+
+	const size_t num_element_classes = style->GetClassNameList().size();
+	for (Atom class_atom : class_atoms)
+	{
+		size_t i = 0;
+		while (i < num_element_classes && style->GetClassAtom(i) != class_atom)
+			i++;
+		if (i == num_element_classes)
+			return false;
+	}
+	return true;
+}
+
+// Returns true if all the given pseudo-classes are set on the element.
+static inline bool HasPseudoClasses(const ElementStyle* style, uint64_t pseudo_class_mask, const StringList& pseudo_class_names)
+{
+	if ((style->GetPseudoClassMask() & pseudo_class_mask) != pseudo_class_mask)
+		return false;
+
+	for (const String& name : pseudo_class_names)
+	{
+		if (!style->IsPseudoClassSet(name))
+			return false;
+	}
+	return true;
+}
+
 StyleSheetNode::StyleSheetNode()
 {
 	CalculateAndSetSpecificity();
@@ -21,12 +55,18 @@ StyleSheetNode::StyleSheetNode()
 
 StyleSheetNode::StyleSheetNode(StyleSheetNode* parent, const CompoundSelector& selector) : parent(parent), selector(selector)
 {
+	CalculateAtoms();
 	CalculateAndSetSpecificity();
+	CalculateAncestorHashes();
+	CalculatePositionDependence();
 }
 
 StyleSheetNode::StyleSheetNode(StyleSheetNode* parent, CompoundSelector&& selector) : parent(parent), selector(std::move(selector))
 {
+	CalculateAtoms();
 	CalculateAndSetSpecificity();
+	CalculateAncestorHashes();
+	CalculatePositionDependence();
 }
 
 StyleSheetNode* StyleSheetNode::GetOrCreateChildNode(const CompoundSelector& other)
@@ -101,8 +141,8 @@ void StyleSheetNode::BuildIndex(StyleSheetIndex& styled_node_index) const
 	// If this has properties defined, then we insert it into the styled node index.
 	if (properties.GetNumProperties() > 0)
 	{
-		auto IndexInsertNode = [](StyleSheetIndex::NodeIndex& node_index, const String& key, const StyleSheetNode* node) {
-			StyleSheetIndex::NodeList& nodes = node_index[Hash<String>()(key)];
+		auto IndexInsertNode = [](StyleSheetIndex::NodeIndex& node_index, size_t key, const StyleSheetNode* node) {
+			StyleSheetIndex::NodeList& nodes = node_index[key];
 			auto it = std::find(nodes.begin(), nodes.end(), node);
 			if (it == nodes.end())
 				nodes.push_back(node);
@@ -112,28 +152,71 @@ void StyleSheetNode::BuildIndex(StyleSheetIndex& styled_node_index) const
 		// general requirement last. This way we are able to rule out as many nodes as possible as quickly as possible.
 		if (!selector.id.empty())
 		{
-			IndexInsertNode(styled_node_index.ids, selector.id, this);
+			IndexInsertNode(styled_node_index.ids, Hash<String>()(selector.id), this);
 		}
 		else if (!selector.class_names.empty())
 		{
 			// @performance Right now we just use the first class for simplicity. Later we may want to devise a better strategy to try to add the
 			// class with the most unique name. For example by adding the class from this node's list that has the fewest existing matches.
-			IndexInsertNode(styled_node_index.classes, selector.class_names.front(), this);
+			IndexInsertNode(styled_node_index.classes, size_t(class_atoms.front()), this);
 		}
 		else if (!selector.tag.empty())
 		{
-			IndexInsertNode(styled_node_index.tags, selector.tag, this);
+			IndexInsertNode(styled_node_index.tags, size_t(tag_atom), this);
 		}
 		else
 		{
 			styled_node_index.other.push_back(this);
 		}
+
+		// Any name in this node affects the matched element itself. Names further up the selector affect the elements reached through the
+		// combinator that follows them: descendants for the descendant and child combinators, or following siblings otherwise.
+		AddDependencies(styled_node_index, SelectorDependency::Self);
+		for (const StyleSheetNode* node = this; node->parent && node->parent->parent; node = node->parent)
+		{
+			const bool sibling_combinator =
+				(node->selector.combinator == SelectorCombinator::NextSibling || node->selector.combinator == SelectorCombinator::SubsequentSibling);
+			node->parent->AddDependencies(styled_node_index, sibling_combinator ? SelectorDependency::Siblings : SelectorDependency::Descendants);
+		}
 	}
 
 	for (auto& child : children)
 		child->BuildIndex(styled_node_index);
 }
 
+void StyleSheetNode::AddDependencies(StyleSheetIndex& styled_node_index, SelectorDependency dependency) const
+{
+	auto AddDependency = [dependency](StyleSheetIndex::DependencyIndex& dependency_index, const String& name) {
+		SelectorDependency& entry = dependency_index[Hash<String>()(name)];
+		entry = entry | dependency;
+	};
+
+	for (const String& name : selector.class_names)
+		AddDependency(styled_node_index.class_dependencies, name);
+	for (const String& name : selector.pseudo_class_names)
+		AddDependency(styled_node_index.pseudo_class_dependencies, name);
+	for (const AttributeSelector& attribute : selector.attributes)
+		AddDependency(styled_node_index.attribute_dependencies, attribute.name);
+
+	// Nested selectors, such as in ':not()', may match against the element's ancestors and siblings. Rather than tracking their exact relationship,
+	// consider all their names as affecting every related element.
+	for (const StructuralSelector& structural_selector : selector.structural_selectors)
+	{
+		if (!structural_selector.selector_tree)
+			continue;
+
+		Vector<const StyleSheetNode*> nodes = {structural_selector.selector_tree->root.get()};
+		while (!nodes.empty())
+		{
+			const StyleSheetNode* node = nodes.back();
+			nodes.pop_back();
+			node->AddDependencies(styled_node_index, SelectorDependency::All);
+			for (const auto& child : node->children)
+				nodes.push_back(child.get());
+		}
+	}
+}
+
 int StyleSheetNode::GetSpecificity() const
 {
 	return specificity;
@@ -151,23 +234,18 @@ const PropertyDictionary& StyleSheetNode::GetProperties() const
 
 bool StyleSheetNode::Match(const Element* element, const Element* scope) const
 {
-	if (!selector.tag.empty() && selector.tag != element->GetTagName())
+	const ElementStyle* style = element->GetStyle();
+	if (tag_atom != Atom::Empty && tag_atom != style->GetTagAtom())
 		return false;
 
 	if (!selector.id.empty() && selector.id != element->GetId())
 		return false;
 
-	for (auto& name : selector.class_names)
-	{
-		if (!element->IsClassSet(name))
-			return false;
-	}
+	if (!HasClasses(style, class_mask, class_atoms))
+		return false;
 
-	for (auto& name : selector.pseudo_class_names)
-	{
-		if (!element->IsPseudoClassSet(name))
-			return false;
-	}
+	if (!HasPseudoClasses(style, pseudo_class_mask, selector.pseudo_class_names))
+		return false;
 
 	if (!selector.attributes.empty() && !MatchAttributes(element))
 		return false;
@@ -327,31 +405,36 @@ bool StyleSheetNode::TraverseMatch(const Element* element, const Element* scope)
 	return false;
 }
 
-bool StyleSheetNode::IsApplicable(const Element* element, const Element* scope) const
+bool StyleSheetNode::IsApplicable(const Element* element, const Element* scope, const StyleSheetAncestorFilter* ancestor_filter) const
 {
 	// Determine whether the element matches the current node and its entire lineage. The entire hierarchy of the element's document will be
 	// considered during the match as necessary.
 
 	// We could in principle just call Match() here and then go on with the ancestor style nodes. Instead, we test the requirements of this node in a
 	// particular order for performance reasons.
-	for (const String& name : selector.pseudo_class_names)
-	{
-		if (!element->IsPseudoClassSet(name))
-			return false;
-	}
+	const ElementStyle* style = element->GetStyle();
+	if (!HasPseudoClasses(style, pseudo_class_mask, selector.pseudo_class_names))
+		return false;
 
-	if (!selector.tag.empty() && selector.tag != element->GetTagName())
+	if (tag_atom != Atom::Empty && tag_atom != style->GetTagAtom())
 		return false;
 
-	for (const String& name : selector.class_names)
-	{
-		if (!element->IsClassSet(name))
-			return false;
-	}
+	if (!HasClasses(style, class_mask, class_atoms))
+		return false;
 
 	if (!selector.id.empty() && selector.id != element->GetId())
 		return false;
 
+	// Reject any node where some required ancestor name is definitely not present, before doing the more expensive matching below.
+	if (ancestor_filter)
+	{
+		for (size_t hash : ancestor_hashes)
+		{
+			if (!ancestor_filter->MayContain(hash))
+				return false;
+		}
+	}
+
 	if (!selector.attributes.empty() && !MatchAttributes(element))
 		return false;
 
@@ -366,6 +449,23 @@ bool StyleSheetNode::IsApplicable(const Element* element, const Element* scope)
 	return true;
 }
 
+void StyleSheetNode::CalculateAtoms()
+{
+	tag_atom = MakeAtom(selector.tag);
+	class_atoms.clear();
+	class_atoms.reserve(selector.class_names.size());
+	class_mask = 0;
+	for (const String& class_name : selector.class_names)
+	{
+		class_atoms.push_back(MakeAtom(class_name));
+		class_mask |= GetNameMask(class_name);
+	}
+
+	pseudo_class_mask = 0;
+	for (const String& pseudo_class_name : selector.pseudo_class_names)
+		pseudo_class_mask |= GetNameMask(pseudo_class_name);
+}
+
 void StyleSheetNode::CalculateAndSetSpecificity()
 {
 	// First calculate the specificity of this node alone.
@@ -389,4 +489,38 @@ void StyleSheetNode::CalculateAndSetSpecificity()
 		specificity += parent->specificity;
 }
 
+void StyleSheetNode::CalculatePositionDependence()
+{
+	// Any further nodes up the tree are matched against the element's ancestors, or against siblings of those ancestors. In both cases the result
+	// is shared by all children of the element's parent.
+	position_dependent = !selector.structural_selectors.empty() ||
+		(selector.combinator == SelectorCombinator::NextSibling || selector.combinator == SelectorCombinator::SubsequentSibling);
+}
+
+void StyleSheetNode::CalculateAncestorHashes()
+{
+	ancestor_hashes.clear();
+	if (!parent || !parent->parent)
+		return;
+
+	// Any requirements of our parent's ancestors must also be matched by our own ancestors, regardless of combinator. The element matching the
+	// parent node is either an ancestor or a sibling of our element, in both cases its ancestors are shared with our element.
+	ancestor_hashes = parent->ancestor_hashes;
+
+	// With descendant and child combinators the parent node must be matched by an ancestor. With sibling combinators it is matched by a sibling,
+	// which says nothing about our ancestors.
+	if (selector.combinator == SelectorCombinator::Descendant || selector.combinator == SelectorCombinator::Child)
+	{
+		using NameType = StyleSheetAncestorFilter::NameType;
+		const CompoundSelector& parent_selector = parent->selector;
+
+		if (parent->tag_atom != Atom::Empty)
+			ancestor_hashes.push_back(StyleSheetAncestorFilter::Hash(NameType::Tag, parent->tag_atom));
+		if (!parent_selector.id.empty())
+			ancestor_hashes.push_back(StyleSheetAncestorFilter::Hash(NameType::Id, parent_selector.id));
+		for (Atom class_atom : parent->class_atoms)
+			ancestor_hashes.push_back(StyleSheetAncestorFilter::Hash(NameType::Class, class_atom));
+	}
+}
+
 } // namespace Rml
@@ -1,12 +1,15 @@
 #pragma once
 
 #include "../../Include/RmlUi/Core/PropertyDictionary.h"
+#include "../../Include/RmlUi/Core/StyleSheetTypes.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "Atom.h"
 #include "StyleSheetSelector.h"
 
 namespace Rml {
 
 struct StyleSheetIndex;
+class StyleSheetAncestorFilter;
 class StyleSheetNode;
 using StyleSheetNodeList = Vector<UniquePtr<StyleSheetNode>>;
 
@@ -41,15 +44,28 @@ public:
 	const PropertyDictionary& GetProperties() const;
 
 	/// Returns true if this node is applicable to the given element, given its IDs, classes and heritage.
+	/// @param[in] ancestor_filter If set, must be an up-to-date filter of the element's ancestors, used to reject the node early.
 	/// @note For performance reasons this call does not check whether 'element' is a text element. The caller must manually check this condition and
 	/// consider any text element not applicable.
-	bool IsApplicable(const Element* element, const Element* scope) const;
+	bool IsApplicable(const Element* element, const Element* scope, const StyleSheetAncestorFilter* ancestor_filter = nullptr) const;
 
 	/// Returns the specificity of this node.
 	int GetSpecificity() const;
+	/// Returns true if matching this node depends on the element's position among its siblings, and not only on the element itself and its
+	/// ancestors.
+	bool IsPositionDependent() const { return position_dependent; }
+
+	/// Returns the requirements of this node alone.
+	const CompoundSelector& GetSelector() const { return selector; }
 
 private:
+	void CalculateAtoms();
 	void CalculateAndSetSpecificity();
+	void CalculateAncestorHashes();
+	void CalculatePositionDependence();
+
+	// Records the names in this compound selector, including any nested selectors, as dependencies of the given elements.
+	void AddDependencies(StyleSheetIndex& styled_node_index, SelectorDependency dependency) const;
 
 	// Match an element to the local node requirements.
 	inline bool Match(const Element* element, const Element* scope) const;
@@ -64,10 +80,22 @@ private:
 
 	// Node requirements
 	CompoundSelector selector;
+	// The interned tag and class names of the selector, for comparison against the names of elements.
+	Atom tag_atom = Atom::Empty;
+	Vector<Atom> class_atoms;
+	// Combined name masks of the required classes and pseudo-classes, compared against the masks of elements to reject them quickly.
+	uint64_t class_mask = 0;
+	uint64_t pseudo_class_mask = 0;
 
 	// A measure of specificity of this node; the attribute in a node with a higher value will override those of a node with a lower value.
 	int specificity = 0;
 
+	// True if the node has structural selectors or is combined with a sibling combinator.
+	bool position_dependent = false;
+
+	// Hashed tag, id, and class names required to be present on some ancestor of any element matching this node.
+	Vector<size_t> ancestor_hashes;
+
 	PropertyDictionary properties;
 
 	StyleSheetNodeList children;
@@ -14,10 +14,72 @@
 #include "StyleSheetFactory.h"
 #include "StyleSheetNode.h"
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define RMLUI_STYLESHEET_PARSER_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+	#include <arm_neon.h>
+	#define RMLUI_STYLESHEET_PARSER_NEON
+#endif
+
 namespace Rml {
 
+static constexpr int MaxScanCharacters = 8;
+
+// Returns a pointer to the first character in [begin, end) matching any of the given characters, or end if there is no match. Scans 16 bytes at a
+// time where SIMD instructions are available.
+static const char* FindFirstOf(const char* begin, const char* end, const char* characters, int num_characters)
+{
+	RMLUI_ASSERT(num_characters > 0 && num_characters <= MaxScanCharacters);
+	const char* ptr = begin;
+
+#if defined(RMLUI_STYLESHEET_PARSER_SSE2)
+	__m128i needles[MaxScanCharacters];
+	for (int i = 0; i < num_characters; i++)
+		needles[i] = _mm_set1_epi8(characters[i]);
+
+	for (; end - ptr >= 16; ptr += 16)
+	{
+		const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+		__m128i matches = _mm_cmpeq_epi8(block, needles[0]);
+		for (int i = 1; i < num_characters; i++)
+			matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, needles[i]));
+		if (_mm_movemask_epi8(matches) != 0)
+			break;
+	}
+#elif defined(RMLUI_STYLESHEET_PARSER_NEON)
+	uint8x16_t needles[MaxScanCharacters];
+	for (int i = 0; i < num_characters; i++)
+		needles[i] = vdupq_n_u8(static_cast<uint8_t>(characters[i]));
+
+	for (; end - ptr >= 16; ptr += 16)
+	{
+		const uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(ptr));
+		uint8x16_t matches = vceqq_u8(block, needles[0]);
+		for (int i = 1; i < num_characters; i++)
+			matches = vorrq_u8(matches, vceqq_u8(block, needles[i]));
+		if (vmaxvq_u8(matches) != 0)
+			break;
+	}
+#endif
+
+	// Locate the exact match in the remaining bytes, or within the block containing a match.
+	for (; ptr < end; ptr++)
+	{
+		for (int i = 0; i < num_characters; i++)
+		{
+			if (*ptr == characters[i])
+				return ptr;
+		}
+	}
+
+	return end;
+}
+
 class AbstractPropertyParser : NonCopyMoveable {
 protected:
 	~AbstractPropertyParser() = default;
@@ -46,6 +108,11 @@ public:
 	bool Parse(const String& name, const String& value) override { return specification.ParsePropertyDeclaration(properties, name, value); }
 };
 
+struct SpritesheetImageVariant {
+	String source;
+	float resolution_factor; // Zero when not given, in which case the 'resolution' property applies.
+};
+
 /*
  *  Spritesheets need a special parser because its property names are arbitrary keys,
  *    while its values are always rectangles. Thus, it must be parsed with a special "rectangle" parser
@@ -53,7 +120,7 @@ public:
  */
 class SpritesheetPropertyParser final : public AbstractPropertyParser {
 private:
-	String image_source;
+	SpritesheetImageVariantList image_variants;
 	float image_resolution_factor = 1.f;
 	SpriteDefinitionList sprite_definitions;
 
@@ -74,14 +141,14 @@ public:
 		id_resolution = specification.RegisterProperty("resolution", "", false, false).AddParser("resolution").GetId();
 	}
 
-	const String& GetImageSource() const { return image_source; }
+	const SpritesheetImageVariantList& GetImageVariants() const { return image_variants; }
 	const SpriteDefinitionList& GetSpriteDefinitions() const { return sprite_definitions; }
 	float GetImageResolutionFactor() const { return image_resolution_factor; }
 
 	void Clear()
 	{
 		image_resolution_factor = 1.f;
-		image_source.clear();
+		image_variants.clear();
 		sprite_definitions.clear();
 	}
 
@@ -89,13 +156,36 @@ public:
 	{
 		if (name == "src")
 		{
-			if (!specification.ParsePropertyDeclaration(properties, id_src, value))
-				return false;
+			// The source may list several variants of the same image at different resolutions, such as 'icons.png 1x, icons@2x.png 2x'.
+			StringList sources;
+			StringUtilities::ExpandString(sources, value, ',');
 
-			if (const Property* property = properties.GetProperty(id_src))
+			image_variants.clear();
+			for (const String& source : sources)
 			{
-				if (property->unit == Unit::STRING)
-					image_source = property->Get<String>();
+				String source_value = source;
+				float resolution_factor = 0.f;
+
+				const size_t descriptor_begin = source.find_last_of(" \t");
+				if (descriptor_begin != String::npos)
+				{
+					Property descriptor;
+					const PropertyDefinition* definition = specification.GetProperty(id_resolution);
+					if (definition->ParseValue(descriptor, source.substr(descriptor_begin + 1)) && descriptor.unit == Unit::X)
+					{
+						resolution_factor = descriptor.Get<float>();
+						source_value = StringUtilities::StripWhitespace(source.substr(0, descriptor_begin));
+					}
+				}
+
+				if (!specification.ParsePropertyDeclaration(properties, id_src, source_value))
+					return false;
+
+				const Property* property = properties.GetProperty(id_src);
+				if (!property || property->unit != Unit::STRING)
+					return false;
+
+				image_variants.push_back(SpritesheetImageVariant{property->Get<String>(), resolution_factor});
 			}
 		}
 		else if (name == "resolution")
@@ -187,6 +277,16 @@ struct StyleSheetParserData {
 
 static ControlledLifetimeResource<StyleSheetParserData> style_sheet_property_parsers;
 
+// The property parsers of the calling thread while parsing concurrently, they hold state during parsing and can't be shared between threads.
+static thread_local StyleSheetParserData* thread_property_parsers = nullptr;
+
+static StyleSheetParserData* GetPropertyParsers()
+{
+	if (thread_property_parsers)
+		return thread_property_parsers;
+	return style_sheet_property_parsers.operator->();
+}
+
 StyleSheetParser::StyleSheetParser()
 {
 	line_number = 0;
@@ -206,6 +306,22 @@ void StyleSheetParser::Shutdown()
 	style_sheet_property_parsers.Shutdown();
 }
 
+StyleSheetParser::ConcurrentScope::ConcurrentScope(CapturedLogMessageList& log_messages) :
+	property_parsers(MakeUnique<StyleSheetParserData>()), previous_property_parsers(thread_property_parsers), log_capture(log_messages)
+{
+	thread_property_parsers = property_parsers.get();
+}
+
+StyleSheetParser::ConcurrentScope::~ConcurrentScope()
+{
+	thread_property_parsers = previous_property_parsers;
+}
+
+bool StyleSheetParser::IsParsingConcurrently()
+{
+	return thread_property_parsers != nullptr;
+}
+
 static bool IsValidIdentifier(const String& str)
 {
 	if (str.empty())
@@ -248,6 +364,74 @@ static void PostprocessKeyframes(KeyframesMap& keyframes_map)
 	}
 }
 
+// Adds the spritesheet with one entry per image variant. The variant with the lowest resolution at least as large as the dp-ratio is used, so that
+// images are only magnified when no larger variant exists. Thus, each variant but the first applies from just above the resolution of the previous
+// one, by placing it in a media block with the corresponding resolution query.
+void StyleSheetParser::AddSpritesheetVariants(MediaBlock& current_block, MediaBlockList& variant_blocks, const String& name,
+	SpritesheetImageVariantList image_variants, float image_resolution_factor, const SpriteDefinitionList& sprite_definitions)
+{
+	// Variants without a resolution descriptor are given at the resolution of the spritesheet.
+	for (SpritesheetImageVariant& variant : image_variants)
+	{
+		if (variant.resolution_factor <= 0.f)
+			variant.resolution_factor = image_resolution_factor;
+	}
+
+	std::stable_sort(image_variants.begin(), image_variants.end(),
+		[](const SpritesheetImageVariant& a, const SpritesheetImageVariant& b) { return a.resolution_factor < b.resolution_factor; });
+	auto it_duplicates = std::unique(image_variants.begin(), image_variants.end(),
+		[](const SpritesheetImageVariant& a, const SpritesheetImageVariant& b) { return a.resolution_factor == b.resolution_factor; });
+	image_variants.erase(it_duplicates, image_variants.end());
+
+	if (image_variants.size() > 1 && current_block.modifier != MediaQueryModifier::None)
+	{
+		Log::Message(Log::LT_WARNING,
+			"Spritesheet resolution variants are not supported inside media queries with modifiers, only the lowest resolution is used. In "
+			"spritesheet '%s'. At %s:%d",
+			name.c_str(), stream_file_name.c_str(), line_number);
+		image_variants.resize(1);
+	}
+
+	const PropertyId id_min_resolution = static_cast<PropertyId>(MediaQueryId::MinResolution);
+
+	for (size_t i = 0; i < image_variants.size(); i++)
+	{
+		const SpritesheetImageVariant& variant = image_variants[i];
+
+		// Sprite rectangles are given in the coordinates of the image at the spritesheet resolution.
+		const float rectangle_scale = variant.resolution_factor / image_resolution_factor;
+		SpriteDefinitionList variant_sprite_definitions = sprite_definitions;
+		for (auto& sprite_definition : variant_sprite_definitions)
+		{
+			const Rectanglef rectangle = sprite_definition.second;
+			sprite_definition.second = Rectanglef::FromPositionSize(rectangle.Position() * rectangle_scale, rectangle.Size() * rectangle_scale);
+		}
+
+		StyleSheet* style_sheet = current_block.stylesheet.get();
+		if (i > 0)
+		{
+			float min_resolution = std::nextafter(image_variants[i - 1].resolution_factor, FLT_MAX);
+			if (const Property* property = current_block.properties.GetProperty(id_min_resolution))
+				min_resolution = Math::Max(min_resolution, property->Get<float>());
+
+			// Variants of different spritesheets at the same resolution share their media block.
+			auto it_block = std::find_if(variant_blocks.begin(), variant_blocks.end(),
+				[&](const MediaBlock& block) { return block.properties.GetProperty(id_min_resolution)->Get<float>() == min_resolution; });
+			if (it_block == variant_blocks.end())
+			{
+				PropertyDictionary feature_map = current_block.properties;
+				feature_map.SetProperty(id_min_resolution, Property(min_resolution, Unit::X));
+				variant_blocks.push_back(MediaBlock{std::move(feature_map), UniquePtr<StyleSheet>(new StyleSheet()), MediaQueryModifier::None});
+				it_block = variant_blocks.end() - 1;
+			}
+			style_sheet = it_block->stylesheet.get();
+		}
+
+		style_sheet->spritesheet_list.AddSpriteSheet(name, variant.source, stream_file_name, line_number, 1.0f / variant.resolution_factor,
+			variant_sprite_definitions);
+	}
+}
+
 bool StyleSheetParser::ParseKeyframeBlock(KeyframesMap& keyframes_map, const String& identifier, const String& rules,
 	const PropertyDictionary& properties)
 {
@@ -373,7 +557,7 @@ bool StyleSheetParser::ParseDecoratorBlock(const String& at_name, NamedDecorator
 
 bool StyleSheetParser::ParseMediaFeatureMap(const String& rules, PropertyDictionary& properties, MediaQueryModifier& modifier)
 {
-	style_sheet_property_parsers->media_query.SetTargetProperties(&properties);
+	GetPropertyParsers()->media_query.SetTargetProperties(&properties);
 
 	enum ParseState { Global, Name, Value };
 	ParseState state = Global;
@@ -447,7 +631,7 @@ bool StyleSheetParser::ParseMediaFeatureMap(const String& rules, PropertyDiction
 
 			current_string = StringUtilities::StripWhitespace(current_string);
 
-			if (!style_sheet_property_parsers->media_query.Parse(name, current_string))
+			if (!GetPropertyParsers()->media_query.Parse(name, current_string))
 				Log::Message(Log::LT_WARNING, "Syntax error parsing media-query property declaration '%s: %s;' in %s: %d.", name.c_str(),
 					current_string.c_str(), stream_file_name.c_str(), line_number);
 
@@ -512,6 +696,23 @@ bool StyleSheetParser::Parse(MediaBlockList& style_sheets, Stream* _stream, int
 	// At-rules given by the following syntax in global space: @identifier name { block }
 	String at_rule_name;
 
+	// Spritesheet variants at higher resolutions are placed in their own media blocks, following the block they are declared in.
+	MediaBlockList spritesheet_variant_blocks;
+
+	auto CompleteCurrentBlock = [&]() {
+		PostprocessKeyframes(current_block.stylesheet->keyframes);
+		current_block.stylesheet->specificity_offset = rule_count;
+		style_sheets.push_back(std::move(current_block));
+		current_block = {};
+
+		for (MediaBlock& variant_block : spritesheet_variant_blocks)
+		{
+			variant_block.stylesheet->specificity_offset = rule_count;
+			style_sheets.push_back(std::move(variant_block));
+		}
+		spritesheet_variant_blocks.clear();
+	};
+
 	// Look for more styles while data is available
 	while (FillBuffer())
 	{
@@ -561,12 +762,7 @@ bool StyleSheetParser::Parse(MediaBlockList& style_sheets, Stream* _stream, int
 				}
 				else if (inside_media_block && token == '}')
 				{
-					// Complete current block
-					PostprocessKeyframes(current_block.stylesheet->keyframes);
-					current_block.stylesheet->specificity_offset = rule_count;
-					style_sheets.push_back(std::move(current_block));
-					current_block = {};
-
+					CompleteCurrentBlock();
 					inside_media_block = false;
 					break;
 				}
@@ -604,10 +800,10 @@ bool StyleSheetParser::Parse(MediaBlockList& style_sheets, Stream* _stream, int
 					}
 					else if (at_rule_identifier == "spritesheet")
 					{
-						auto& spritesheet_property_parser = style_sheet_property_parsers->spritesheet;
+						auto& spritesheet_property_parser = GetPropertyParsers()->spritesheet;
 						ReadProperties(spritesheet_property_parser);
 
-						const String& image_source = spritesheet_property_parser.GetImageSource();
+						SpritesheetImageVariantList image_variants = spritesheet_property_parser.GetImageVariants();
 						const SpriteDefinitionList& sprite_definitions = spritesheet_property_parser.GetSpriteDefinitions();
 						const float image_resolution_factor = spritesheet_property_parser.GetImageResolutionFactor();
 
@@ -616,7 +812,7 @@ bool StyleSheetParser::Parse(MediaBlockList& style_sheets, Stream* _stream, int
 							Log::Message(Log::LT_WARNING, "Spritesheet '%s' has no sprites defined, ignored. At %s:%d", at_rule_name.c_str(),
 								stream_file_name.c_str(), line_number);
 						}
-						else if (image_source.empty())
+						else if (image_variants.empty())
 						{
 							Log::Message(Log::LT_WARNING, "No image source (property 'src') specified for spritesheet '%s'. At %s:%d",
 								at_rule_name.c_str(), stream_file_name.c_str(), line_number);
@@ -630,9 +826,8 @@ bool StyleSheetParser::Parse(MediaBlockList& style_sheets, Stream* _stream, int
 						}
 						else
 						{
-							const float display_scale = 1.0f / image_resolution_factor;
-							current_block.stylesheet->spritesheet_list.AddSpriteSheet(at_rule_name, image_source, stream_file_name, (int)line_number,
-								display_scale, sprite_definitions);
+							AddSpritesheetVariants(current_block, spritesheet_variant_blocks, at_rule_name, std::move(image_variants),
+								image_resolution_factor, sprite_definitions);
 						}
 
 						spritesheet_property_parser.Clear();
@@ -643,12 +838,7 @@ bool StyleSheetParser::Parse(MediaBlockList& style_sheets, Stream* _stream, int
 					{
 						// complete the current "global" block if present and start a new block
 						if (current_block.stylesheet)
-						{
-							PostprocessKeyframes(current_block.stylesheet->keyframes);
-							current_block.stylesheet->specificity_offset = rule_count;
-							style_sheets.push_back(std::move(current_block));
-							current_block = {};
-						}
+							CompleteCurrentBlock();
 
 						// parse media query list into block
 						PropertyDictionary feature_map;
@@ -723,11 +913,7 @@ bool StyleSheetParser::Parse(MediaBlockList& style_sheets, Stream* _stream, int
 
 	// Complete last block if present
 	if (current_block.stylesheet)
-	{
-		PostprocessKeyframes(current_block.stylesheet->keyframes);
-		current_block.stylesheet->specificity_offset = rule_count;
-		style_sheets.push_back(std::move(current_block));
-	}
+		CompleteCurrentBlock();
 
 	return !style_sheets.empty();
 }
@@ -774,10 +960,35 @@ void StyleSheetParser::ReadProperties(AbstractPropertyParser& property_parser)
 	enum ParseState { NAME, VALUE, QUOTE };
 	ParseState state = NAME;
 
+	// The characters which may change the parse state, in addition to newlines and possible comments which are handled by ReadCharacter().
+	static const char name_stop_characters[] = {'\n', '/', ';', '}', ':'};
+	static const char value_stop_characters[] = {'\n', '/', ';', '}', '"'};
+	static const char quote_stop_characters[] = {'\n', '/', '"'};
+
 	char character;
 	char previous_character = 0;
-	while (ReadCharacter(character))
+	while (true)
 	{
+		// Add runs of characters without any effect on the parse state in one go.
+		if (parse_buffer_pos < parse_buffer.size())
+		{
+			String& target = (state == NAME ? name : value);
+			const char* stop_characters = (state == NAME ? name_stop_characters : (state == VALUE ? value_stop_characters : quote_stop_characters));
+			const int num_stop_characters = (state == QUOTE ? 3 : 5);
+
+			const char* run_begin = parse_buffer.data() + parse_buffer_pos;
+			const char* run_end = FindFirstOf(run_begin, parse_buffer.data() + parse_buffer.size(), stop_characters, num_stop_characters);
+			if (run_end != run_begin)
+			{
+				target.append(run_begin, run_end);
+				previous_character = *(run_end - 1);
+				parse_buffer_pos += size_t(run_end - run_begin);
+			}
+		}
+
+		if (!ReadCharacter(character))
+			break;
+
 		parse_buffer_pos++;
 
 		switch (state)
@@ -1012,10 +1223,34 @@ StyleSheetNode* StyleSheetParser::ImportProperties(StyleSheetNode* node, const S
 
 char StyleSheetParser::FindAnyToken(String& buffer, const char* tokens)
 {
+	// Null characters are matched as well, as they are treated as a token below.
+	char stop_characters[MaxScanCharacters] = {'\n', '/', '\0'};
+	int num_stop_characters = 3;
+
+	// Too many tokens to scan for at once, then every character is handled individually below instead.
+	const bool scan_runs = (strlen(tokens) + num_stop_characters <= MaxScanCharacters);
+	if (scan_runs)
+	{
+		for (const char* token = tokens; *token; token++)
+			stop_characters[num_stop_characters++] = *token;
+	}
+
 	buffer.clear();
 	char character;
-	while (ReadCharacter(character))
+	while (true)
 	{
+		// Copy any run of plain characters in one go, only newlines, possible comments, and tokens need per-character handling below.
+		if (scan_runs && parse_buffer_pos < parse_buffer.size())
+		{
+			const char* run_begin = parse_buffer.data() + parse_buffer_pos;
+			const char* run_end = FindFirstOf(run_begin, parse_buffer.data() + parse_buffer.size(), stop_characters, num_stop_characters);
+			buffer.append(run_begin, run_end);
+			parse_buffer_pos += size_t(run_end - run_begin);
+		}
+
+		if (!ReadCharacter(character))
+			break;
+
 		if (strchr(tokens, character) != nullptr)
 		{
 			parse_buffer_pos++;
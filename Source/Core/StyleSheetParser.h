@@ -1,7 +1,9 @@
 #pragma once
 
+#include "../../Include/RmlUi/Core/Spritesheet.h"
 #include "../../Include/RmlUi/Core/StyleSheetTypes.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "LogCapture.h"
 
 namespace Rml {
 
@@ -10,6 +12,9 @@ class Stream;
 class StyleSheetNode;
 class AbstractPropertyParser;
 struct PropertySource;
+struct StyleSheetParserData;
+struct SpritesheetImageVariant;
+using SpritesheetImageVariantList = Vector<SpritesheetImageVariant>;
 using StyleSheetNodeListRaw = Vector<StyleSheetNode*>;
 
 /**
@@ -45,6 +50,26 @@ public:
 	/// Reset property parsers.
 	static void Shutdown();
 
+	/**
+	    Lets the calling thread parse style sheets concurrently with other threads while in scope.
+
+	    The thread is given its own property parsers, bypasses the shared property value caches, and captures its log messages instead of
+	    passing them on. No other library state may be modified while threads are parsing concurrently.
+	 */
+	class ConcurrentScope : NonCopyMoveable {
+	public:
+		explicit ConcurrentScope(CapturedLogMessageList& log_messages);
+		~ConcurrentScope();
+
+	private:
+		UniquePtr<StyleSheetParserData> property_parsers;
+		StyleSheetParserData* previous_property_parsers;
+		LogCapture log_capture;
+	};
+
+	/// Returns true if the calling thread is parsing within a concurrent scope.
+	static bool IsParsingConcurrently();
+
 private:
 	/// Parses properties from the parse buffer.
 	/// @param[in-out] property_parser An abstract parser which specifies how the properties are parsed and stored.
@@ -64,6 +89,10 @@ private:
 	/// Attempts to parse a @decorator block
 	bool ParseDecoratorBlock(const String& at_name, NamedDecoratorMap& named_decorator_map, const SharedPtr<const PropertySource>& source);
 
+	/// Adds a parsed @spritesheet with one spritesheet for each of its image variants, see the definition for details.
+	void AddSpritesheetVariants(MediaBlock& current_block, MediaBlockList& variant_blocks, const String& name,
+		SpritesheetImageVariantList image_variants, float image_resolution_factor, const SpriteDefinitionList& sprite_definitions);
+
 	/// Attempts to parse the properties of a @media query.
 	/// @param[in] rules The rules to parse.
 	/// @param[out] properties Parsed properties representing all values to be matched.
@@ -1,15 +1,11 @@
 #include "StyleSheetSelector.h"
 #include "../../Include/RmlUi/Core/Element.h"
+#include "ElementStyle.h"
 #include "StyleSheetNode.h"
 #include <tuple>
 
 namespace Rml {
 
-static inline bool IsTextElement(const Element* element)
-{
-	return element->GetTagName() == "#text";
-}
-
 // Returns true if a positive integer can be found for n in the equation an + b = count.
 static bool IsNth(int a, int b, int count)
 {
@@ -66,260 +62,70 @@ bool IsSelectorApplicable(const Element* element, const StructuralSelector& sele
 {
 	RMLUI_ASSERT(element);
 
+	// The positional selectors use the cached position of the element among its siblings.
+	using SiblingIndices = ElementStyle::SiblingIndices;
+	auto GetSiblingIndices = [element]() { return element->GetStyle()->GetSiblingIndices(); };
+
 	switch (selector.type)
 	{
 	case StructuralSelectorType::Nth_Child:
 	{
-		Element* parent = element->GetParentNode();
-		if (!parent)
-			return false;
-
-		// Start counting elements until we find this one.
-		int element_index = 1;
-		for (int i = 0; i < parent->GetNumChildren(); i++)
-		{
-			Element* child = parent->GetChild(i);
-
-			// Skip text nodes.
-			if (IsTextElement(child))
-				continue;
-
-			// If we've found our element, then break; the current index is our element's index.
-			if (child == element)
-				break;
-
-			element_index++;
-		}
-
-		return IsNth(selector.a, selector.b, element_index);
+		const SiblingIndices* indices = GetSiblingIndices();
+		return indices && IsNth(selector.a, selector.b, indices->index);
 	}
 	break;
 	case StructuralSelectorType::Nth_Last_Child:
 	{
-		Element* parent = element->GetParentNode();
-		if (!parent)
-			return false;
-
-		// Start counting elements until we find this one.
-		int element_index = 1;
-		for (int i = parent->GetNumChildren() - 1; i >= 0; --i)
-		{
-			Element* child = parent->GetChild(i);
-
-			// Skip text nodes.
-			if (IsTextElement(child))
-				continue;
-
-			// If we've found our element, then break; the current index is our element's index.
-			if (child == element)
-				break;
-
-			element_index++;
-		}
-
-		return IsNth(selector.a, selector.b, element_index);
+		const SiblingIndices* indices = GetSiblingIndices();
+		return indices && IsNth(selector.a, selector.b, indices->index_from_end);
 	}
 	break;
 	case StructuralSelectorType::Nth_Of_Type:
 	{
-		Element* parent = element->GetParentNode();
-		if (!parent)
-			return false;
-
-		// Start counting elements until we find this one.
-		int element_index = 1;
-		const int num_children = parent->GetNumChildren();
-		for (int i = 0; i < num_children; i++)
-		{
-			Element* child = parent->GetChild(i);
-
-			// If we've found our element, then break; the current index is our element's index.
-			if (child == element)
-				break;
-
-			// Skip nodes that don't share our tag.
-			if (child->GetTagName() != element->GetTagName())
-				continue;
-
-			element_index++;
-		}
-
-		return IsNth(selector.a, selector.b, element_index);
+		const SiblingIndices* indices = GetSiblingIndices();
+		return indices && IsNth(selector.a, selector.b, indices->type_index);
 	}
 	break;
 	case StructuralSelectorType::Nth_Last_Of_Type:
 	{
-		Element* parent = element->GetParentNode();
-		if (!parent)
-			return false;
-
-		// Start counting elements until we find this one.
-		int element_index = 1;
-		for (int i = parent->GetNumChildren() - 1; i >= 0; --i)
-		{
-			Element* child = parent->GetChild(i);
-
-			// If we've found our element, then break; the current index is our element's index.
-			if (child == element)
-				break;
-
-			// Skip nodes that don't share our tag.
-			if (child->GetTagName() != element->GetTagName())
-				continue;
-
-			element_index++;
-		}
-
-		return IsNth(selector.a, selector.b, element_index);
+		const SiblingIndices* indices = GetSiblingIndices();
+		return indices && IsNth(selector.a, selector.b, indices->type_index_from_end);
 	}
 	break;
 	case StructuralSelectorType::First_Child:
 	{
-		Element* parent = element->GetParentNode();
-		if (!parent)
-			return false;
-
-		int child_index = 0;
-		while (child_index < parent->GetNumChildren())
-		{
-			// If this child (the first non-text child) is our element, then the selector succeeds.
-			Element* child = parent->GetChild(child_index);
-			if (child == element)
-				return true;
-
-			// If this child is not a text element, then the selector fails; this element is non-trivial.
-			if (!IsTextElement(child))
-				return false;
-
-			// Otherwise, skip over the text element to find the last non-trivial element.
-			child_index++;
-		}
-
-		return false;
+		const SiblingIndices* indices = GetSiblingIndices();
+		return indices && indices->index == 1;
 	}
 	break;
 	case StructuralSelectorType::Last_Child:
 	{
-		Element* parent = element->GetParentNode();
-		if (!parent)
-			return false;
-
-		int child_index = parent->GetNumChildren() - 1;
-		while (child_index >= 0)
-		{
-			// If this child (the last non-text child) is our element, then the selector succeeds.
-			Element* child = parent->GetChild(child_index);
-			if (child == element)
-				return true;
-
-			// If this child is not a text element, then the selector fails; this element is non-trivial.
-			if (!IsTextElement(child))
-				return false;
-
-			// Otherwise, skip over the text element to find the last non-trivial element.
-			child_index--;
-		}
-
-		return false;
+		const SiblingIndices* indices = GetSiblingIndices();
+		return indices && indices->index_from_end == 1;
 	}
 	break;
 	case StructuralSelectorType::First_Of_Type:
 	{
-		Element* parent = element->GetParentNode();
-		if (!parent)
-			return false;
-
-		int child_index = 0;
-		while (child_index < parent->GetNumChildren())
-		{
-			// If this child is our element, then it's the first one we've found with our tag; the selector succeeds.
-			Element* child = parent->GetChild(child_index);
-			if (child == element)
-				return true;
-
-			// Otherwise, if this child shares our element's tag, then our element is not the first tagged child; the selector fails.
-			if (child->GetTagName() == element->GetTagName())
-				return false;
-
-			child_index++;
-		}
-
-		return false;
+		const SiblingIndices* indices = GetSiblingIndices();
+		return indices && indices->type_index == 1;
 	}
 	break;
 	case StructuralSelectorType::Last_Of_Type:
 	{
-		Element* parent = element->GetParentNode();
-		if (!parent)
-			return false;
-
-		int child_index = parent->GetNumChildren() - 1;
-		while (child_index >= 0)
-		{
-			// If this child is our element, then it's the first one we've found with our tag; the selector succeeds.
-			Element* child = parent->GetChild(child_index);
-			if (child == element)
-				return true;
-
-			// Otherwise, if this child shares our element's tag, then our element is not the first tagged child; the selector fails.
-			if (child->GetTagName() == element->GetTagName())
-				return false;
-
-			child_index--;
-		}
-
-		return false;
+		const SiblingIndices* indices = GetSiblingIndices();
+		return indices && indices->type_index_from_end == 1;
 	}
 	break;
 	case StructuralSelectorType::Only_Child:
 	{
-		Element* parent = element->GetParentNode();
-		if (!parent)
-			return false;
-
-		const int num_children = parent->GetNumChildren();
-		for (int i = 0; i < num_children; i++)
-		{
-			Element* child = parent->GetChild(i);
-
-			// Skip the child if it is our element.
-			if (child == element)
-				continue;
-
-			// Skip the child if it is trivial.
-			if (IsTextElement(child))
-				continue;
-
-			return false;
-		}
-
-		return true;
+		const SiblingIndices* indices = GetSiblingIndices();
+		return indices && indices->index == 1 && indices->index_from_end == 1;
 	}
 	break;
 	case StructuralSelectorType::Only_Of_Type:
 	{
-		Element* parent = element->GetParentNode();
-		if (!parent)
-			return false;
-
-		const int num_children = parent->GetNumChildren();
-		for (int i = 0; i < num_children; i++)
-		{
-			Element* child = parent->GetChild(i);
-
-			// Skip the child if it is our element.
-			if (child == element)
-				continue;
-
-			// Skip the child if it does not share our tag.
-			if (child->GetTagName() != element->GetTagName())
-				continue;
-
-			// We've found a similarly-tagged child to our element; selector fails.
-			return false;
-		}
-
-		return true;
+		const SiblingIndices* indices = GetSiblingIndices();
+		return indices && indices->type_index == 1 && indices->type_index_from_end == 1;
 	}
 	break;
 	case StructuralSelectorType::Empty:
@@ -76,7 +76,6 @@ void StyleSheetSpecification::Initialise()
 	PropertyParserAnimation::Initialize();
 	PropertyParserColour::Initialize();
 	PropertyParserDecorator::Initialize();
-	PropertyParserNumber::Initialize();
 
 	new StyleSheetSpecification();
 
@@ -93,7 +92,6 @@ void StyleSheetSpecification::Shutdown()
 	PropertyParserAnimation::Shutdown();
 	PropertyParserColour::Shutdown();
 	PropertyParserDecorator::Shutdown();
-	PropertyParserNumber::Shutdown();
 }
 
 bool StyleSheetSpecification::RegisterParser(const String& parser_name, PropertyParser* parser)
@@ -385,6 +383,7 @@ void StyleSheetSpecification::RegisterDefaultProperties()
 	RegisterProperty(PropertyId::ScrollbarMargin, "scrollbar-margin", "0", false, false).AddParser("length");
 	RegisterProperty(PropertyId::OverscrollBehavior, "overscroll-behavior", "auto", false, false).AddParser("keyword", "auto, contain");
 	RegisterProperty(PropertyId::PointerEvents, "pointer-events", "auto", true, false).AddParser("keyword", "none, auto");
+	RegisterProperty(PropertyId::RenderCache, "render-cache", "none", false, false).AddParser("keyword", "none, static, auto, scroll");
 
 	// Perspective and Transform specifications
 	RegisterProperty(PropertyId::Perspective, "perspective", "none", false, false).AddParser("keyword", "none").AddParser("length");
@@ -435,6 +434,10 @@ void StyleSheetSpecification::RegisterDefaultProperties()
 
 	RMLUI_ASSERTMSG(instance->properties.shorthand_map->AssertAllInserted(ShorthandId::NumDefinedIds), "Missing specification for one or more Shorthand IDs.");
 	RMLUI_ASSERTMSG(instance->properties.property_map->AssertAllInserted(PropertyId::NumDefinedIds), "Missing specification for one or more Property IDs.");
+
+	// Names are looked up while parsing any property declaration, use perfect hashing for the built-in names and any custom ones added later.
+	instance->properties.property_map->BuildLookupTable();
+	instance->properties.shorthand_map->BuildLookupTable();
 	// clang-format on
 }
 
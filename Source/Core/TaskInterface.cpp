@@ -0,0 +1,20 @@
+#include "../../Include/RmlUi/Core/TaskInterface.h"
+
+namespace Rml {
+
+TaskInterface::TaskInterface() {}
+
+TaskInterface::~TaskInterface() {}
+
+void TaskInterface::ParallelFor(int count, const Function<void(int)>& task)
+{
+	Vector<TaskHandle> handles;
+	handles.reserve(count);
+	for (int i = 0; i < count; i++)
+		handles.push_back(Submit([&task, i]() { task(i); }));
+
+	for (TaskHandle handle : handles)
+		Wait(handle);
+}
+
+} // namespace Rml
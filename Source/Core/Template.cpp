@@ -82,12 +82,21 @@ bool Template::Load(Stream* stream)
 
 Element* Template::ParseTemplate(Element* element)
 {
-	body->Seek(0, SEEK_SET);
-
 	const int num_children_before = element->GetNumChildren();
 
 	XMLParser parser(element);
-	parser.Parse(body.get());
+	if (body_events_recorded)
+	{
+		parser.Replay(body_events, body->GetSourceURL());
+	}
+	else
+	{
+		body->Seek(0, SEEK_SET);
+		parser.SetRecordEvents(&body_events);
+		parser.Parse(body.get());
+		parser.SetRecordEvents(nullptr);
+		body_events_recorded = true;
+	}
 
 	// If there's an inject attribute on the template, attempt to find the required element.
 	if (!content.empty())
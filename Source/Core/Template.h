@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../Include/RmlUi/Core/BaseXMLParser.h"
 #include "../../Include/RmlUi/Core/StreamMemory.h"
 #include "DocumentHeader.h"
 
@@ -8,7 +9,8 @@ namespace Rml {
 class Element;
 
 /**
-    Contains a RML template. The Header is stored in parsed form, body in an unparsed stream.
+    Contains a RML template. The Header is stored in parsed form, body in an unparsed stream. The parse events of the body are recorded
+    during its first use, and replayed for any later uses of the template.
  */
 
 class Template {
@@ -35,6 +37,9 @@ private:
 	String content;
 	DocumentHeader header;
 	UniquePtr<StreamMemory> body;
+
+	bool body_events_recorded = false;
+	XMLParseEventList body_events;
 };
 
 } // namespace Rml
@@ -16,6 +16,13 @@ Vector2i Texture::GetDimensions() const
 	return {};
 }
 
+bool Texture::IsLoading() const
+{
+	if (file_index != TextureFileIndex::Invalid)
+		return RenderManagerAccess::IsLoading(render_manager, file_index);
+	return false;
+}
+
 Texture::operator bool() const
 {
 	return callback_index != StableVectorIndex::Invalid || file_index != TextureFileIndex::Invalid;
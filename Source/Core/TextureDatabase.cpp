@@ -1,6 +1,10 @@
 #include "TextureDatabase.h"
 #include "../../Include/RmlUi/Core/Log.h"
+#include "../../Include/RmlUi/Core/Math.h"
 #include "../../Include/RmlUi/Core/RenderInterface.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
+#include <algorithm>
+#include <string.h>
 
 namespace Rml {
 
@@ -29,32 +33,131 @@ void CallbackTextureDatabase::ReleaseTexture(RenderInterface* render_interface,
 {
 	CallbackTextureEntry& data = texture_list[callback_index];
 	if (data.texture_handle)
-		render_interface->ReleaseTexture(data.texture_handle);
+		ReleaseTextureHandle(render_interface, data);
 	texture_list.erase(callback_index);
 }
 
+void CallbackTextureDatabase::ReleaseTextureHandle(RenderInterface* render_interface, const CallbackTextureEntry& entry)
+{
+	constexpr size_t max_pooled_textures = 16;
+
+	if (!entry.generated || !pooling)
+	{
+		render_interface->ReleaseTexture(entry.texture_handle);
+		return;
+	}
+
+	if (texture_pool.size() >= max_pooled_textures)
+	{
+		render_interface->ReleaseTexture(texture_pool.front().texture_handle);
+		texture_pool.erase(texture_pool.begin());
+	}
+	texture_pool.push_back(PooledTexture{entry.texture_handle, entry.dimensions, frame});
+}
+
+void CallbackTextureDatabase::ReleasePool(RenderInterface* render_interface)
+{
+	for (const PooledTexture& pooled : texture_pool)
+		render_interface->ReleaseTexture(pooled.texture_handle);
+	texture_pool.clear();
+}
+
 Vector2i CallbackTextureDatabase::GetDimensions(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index)
 {
-	return EnsureLoaded(render_manager, render_interface, callback_index).dimensions;
+	return EnsureLoaded(render_manager, render_interface, callback_index, false).dimensions;
 }
 
 TextureHandle CallbackTextureDatabase::GetHandle(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index)
 {
-	return EnsureLoaded(render_manager, render_interface, callback_index).texture_handle;
+	return EnsureLoaded(render_manager, render_interface, callback_index, true).texture_handle;
+}
+
+bool CallbackTextureDatabase::IsDeferred(StableVectorIndex callback_index) const
+{
+	const CallbackTextureEntry& data = texture_list[callback_index];
+	return !data.texture_handle && !data.load_failed && data.regenerate_pixels > 0;
 }
 
-auto CallbackTextureDatabase::EnsureLoaded(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index)
-	-> CallbackTextureEntry&
+TextureHandle CallbackTextureDatabase::GenerateTexture(RenderInterface* render_interface, Span<const byte> source, Vector2i dimensions)
 {
+	generated_handle = {};
+
+	auto it = std::find_if(texture_pool.begin(), texture_pool.end(),
+		[dimensions](const PooledTexture& pooled) { return pooled.dimensions == dimensions; });
+	if (it != texture_pool.end())
+	{
+		const TextureHandle handle = it->texture_handle;
+		texture_pool.erase(it);
+
+		if (render_interface->UpdateTexture(handle, Rectanglei::FromSize(dimensions), source))
+		{
+			generated_handle = handle;
+			return handle;
+		}
+
+		// Without texture updates pooled textures can not be reused, stop pooling them from now on.
+		render_interface->ReleaseTexture(handle);
+		SetPooling(render_interface, false);
+	}
+
+	generated_handle = render_interface->GenerateTexture(source, dimensions);
+	return generated_handle;
+}
+
+bool CallbackTextureDatabase::UpdateTexture(RenderInterface* render_interface, StableVectorIndex callback_index, Rectanglei region,
+	Span<const byte> source)
+{
+	const CallbackTextureEntry& data = texture_list[callback_index];
+
+	// Nothing to update if the texture has not been generated yet, the callback will produce the complete texture when it is first used.
+	if (!data.texture_handle)
+		return true;
+
+	if (!render_interface->UpdateTexture(data.texture_handle, region, source))
+		return false;
+
+	num_uploads += 1;
+	return true;
+}
+
+auto CallbackTextureDatabase::EnsureLoaded(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index,
+	bool allow_defer) -> CallbackTextureEntry&
+{
+	constexpr int max_small_texture_pixels = 64 * 64;
+
 	CallbackTextureEntry& data = texture_list[callback_index];
 	if (!data.texture_handle && !data.load_failed)
 	{
+		// Small textures are cheap to regenerate and always take priority, larger ones are regenerated in order of use until the budget is spent.
+		// The first texture is always regenerated so that we make progress every frame.
+		const int pixels = data.regenerate_pixels;
+		if (allow_defer && regeneration_budget > 0 && pixels > max_small_texture_pixels && num_regenerated_textures > 0 &&
+			regenerated_pixels + pixels > regeneration_budget)
+		{
+			num_deferred_textures += 1;
+			return data;
+		}
+
+		generated_handle = {};
 		if (!data.callback(CallbackTextureInterface(*render_manager, *render_interface, data.texture_handle, data.dimensions)))
 		{
 			data.load_failed = true;
 			data.texture_handle = {};
 			data.dimensions = {};
 		}
+		else if (data.texture_handle)
+		{
+			num_uploads += 1;
+			data.generated = (data.texture_handle == generated_handle);
+		}
+
+		if (pixels > 0)
+		{
+			regenerated_pixels += pixels;
+			num_regenerated_textures += 1;
+		}
+		data.regenerate_pixels = 0;
+		generated_handle = {};
 	}
 	return data;
 }
@@ -66,16 +169,51 @@ size_t CallbackTextureDatabase::size() const
 
 void CallbackTextureDatabase::ReleaseAllTextures(RenderInterface* render_interface)
 {
+	ReleasePool(render_interface);
+
 	texture_list.for_each([render_interface](CallbackTextureEntry& texture) {
 		if (texture.texture_handle)
 		{
 			render_interface->ReleaseTexture(texture.texture_handle);
+			// Only textures generated from pixels can be regenerated at any time, others such as saved layers must be generated when requested.
+			texture.regenerate_pixels = (texture.generated ? std::max(texture.dimensions.x * texture.dimensions.y, 1) : 0);
 			texture.texture_handle = {};
 			texture.dimensions = {};
+			texture.generated = false;
 		}
 	});
 }
 
+void CallbackTextureDatabase::SetRegenerationBudget(int max_pixels_per_frame)
+{
+	regeneration_budget = std::max(max_pixels_per_frame, 0);
+}
+
+void CallbackTextureDatabase::SetPooling(RenderInterface* render_interface, bool enable)
+{
+	pooling = enable;
+	if (!pooling)
+		ReleasePool(render_interface);
+}
+
+void CallbackTextureDatabase::BeginFrame(RenderInterface* render_interface)
+{
+	constexpr int max_pooled_frames = 2;
+
+	frame += 1;
+	regenerated_pixels = 0;
+	num_regenerated_textures = 0;
+	num_deferred_textures = 0;
+
+	const auto it_end = std::remove_if(texture_pool.begin(), texture_pool.end(), [&](const PooledTexture& pooled) {
+		if (frame - pooled.frame < max_pooled_frames)
+			return false;
+		render_interface->ReleaseTexture(pooled.texture_handle);
+		return true;
+	});
+	texture_pool.erase(it_end, texture_pool.end());
+}
+
 FileTextureDatabase::FileTextureDatabase() {}
 
 FileTextureDatabase::~FileTextureDatabase()
@@ -99,46 +237,241 @@ TextureFileIndex FileTextureDatabase::InsertTexture(const String& source)
 	const auto index = TextureFileIndex(texture_list.size());
 	texture_map[source] = index;
 	texture_list.push_back({});
+	texture_list.back().source = source;
 
 	return index;
 }
 
-FileTextureDatabase::FileTextureEntry FileTextureDatabase::LoadTextureEntry(RenderInterface* render_interface, const String& source)
+void FileTextureDatabase::LoadTextureEntry(RenderInterface* render_interface, FileTextureEntry& entry)
 {
-	FileTextureEntry result = {};
-	result.texture_handle = render_interface->LoadTexture(result.dimensions, source);
-	if (!result.texture_handle)
+	const bool is_placeholder = (placeholder_index != TextureFileIndex::Invalid && &entry == &texture_list[size_t(placeholder_index)]);
+	const bool load_async = (async_loading && !is_placeholder);
+
+	entry.dimensions = {};
+	num_misses += 1;
+
+	if (entry.atlas_state == AtlasState::Page)
 	{
-		result.load_texture_failed = true;
-		Rml::Log::Message(Rml::Log::LT_WARNING, "Could not load texture: %s", source.c_str());
+		entry.dimensions = atlas_layout.GetTexture(entry.atlas_page).GetDimensions();
+		entry.texture_handle = render_interface->GenerateTexture(atlas_pages[entry.atlas_page].data, entry.dimensions);
 	}
-	return result;
+	else if (load_async)
+	{
+		bool loading = false;
+		entry.texture_handle = render_interface->LoadTextureAsync(entry.dimensions, entry.source, loading);
+		if (loading)
+		{
+			entry.texture_handle = {};
+			entry.loading = true;
+			entry.last_poll_frame = frame;
+			num_loading_textures += 1;
+			return;
+		}
+	}
+	else
+	{
+		entry.texture_handle = render_interface->LoadTexture(entry.dimensions, entry.source);
+	}
+
+	OnTextureEntryLoaded(entry);
 }
 
-FileTextureDatabase::FileTextureEntry& FileTextureDatabase::EnsureLoaded(RenderInterface* render_interface, TextureFileIndex index)
+void FileTextureDatabase::PollTextureEntry(RenderInterface* render_interface, FileTextureEntry& entry)
+{
+	RMLUI_ASSERT(entry.loading);
+	if (entry.last_poll_frame == frame)
+		return;
+	entry.last_poll_frame = frame;
+
+	Vector2i dimensions = entry.dimensions;
+	bool loading = false;
+	const TextureHandle texture_handle = render_interface->LoadTextureAsync(dimensions, entry.source, loading);
+	if (loading)
+		return;
+
+	entry.loading = false;
+	num_loading_textures -= 1;
+
+	if (entry.release_when_loaded)
+	{
+		if (texture_handle)
+			render_interface->ReleaseTexture(texture_handle);
+		entry.release_when_loaded = false;
+		entry.dimensions = {};
+		return;
+	}
+
+	entry.texture_handle = texture_handle;
+	entry.dimensions = dimensions;
+	OnTextureEntryLoaded(entry);
+}
+
+void FileTextureDatabase::OnTextureEntryLoaded(FileTextureEntry& entry)
 {
-	FileTextureEntry& entry = texture_list[size_t(index)];
 	if (!entry.texture_handle)
 	{
-		auto it = std::find_if(texture_map.begin(), texture_map.end(), [index](const auto& pair) { return pair.second == index; });
-		RMLUI_ASSERT(it != texture_map.end());
-		const String& source = it->first;
-		if (!entry.load_texture_failed)
-			entry = LoadTextureEntry(render_interface, source);
+		entry.dimensions = {};
+		entry.load_texture_failed = true;
+		Rml::Log::Message(Rml::Log::LT_WARNING, "Could not load texture: %s", entry.source.c_str());
+		return;
+	}
+
+	resident_bytes += GetTextureBytes(entry);
+	num_resident_textures += 1;
+	num_uploads += 1;
+}
+
+void FileTextureDatabase::ReleaseTextureEntry(RenderInterface* render_interface, FileTextureEntry& entry)
+{
+	if (entry.loading)
+	{
+		// The render interface still owns the texture, release it once it has been handed over to us.
+		entry.release_when_loaded = true;
+		return;
+	}
+
+	if (entry.texture_handle)
+	{
+		render_interface->ReleaseTexture(entry.texture_handle);
+		resident_bytes -= GetTextureBytes(entry);
+		num_resident_textures -= 1;
 	}
-	return entry;
+
+	entry.texture_handle = {};
+	if (entry.atlas_state != AtlasState::Packed)
+		entry.dimensions = {};
+	entry.load_texture_failed = false;
+}
+
+bool FileTextureDatabase::PackTextureEntry(RenderInterface* render_interface, TextureFileIndex index)
+{
+	Vector<byte> data;
+	Vector2i dimensions;
+
+	texture_list[size_t(index)].atlas_state = AtlasState::Unpacked;
+	if (!render_interface->LoadTextureData(data, dimensions, texture_list[size_t(index)].source))
+		return false;
+
+	if (dimensions.x <= 0 || dimensions.y <= 0 || dimensions.x > atlas_max_image_size || dimensions.y > atlas_max_image_size ||
+		data.size() != size_t(dimensions.x) * size_t(dimensions.y) * 4)
+		return false;
+
+	int rectangle_index = atlas_layout.InsertRectangle(int(index), dimensions);
+	if (rectangle_index < 0)
+	{
+		const int page = atlas_layout.GetNumTextures();
+		atlas_layout.AddTexture(Vector2i(atlas_page_size));
+		rectangle_index = atlas_layout.InsertRectangle(int(index), dimensions);
+		if (rectangle_index < 0)
+			return false;
+
+		AtlasPage atlas_page;
+		atlas_page.index = TextureFileIndex(texture_list.size());
+		atlas_page.data.resize(size_t(atlas_page_size) * size_t(atlas_page_size) * 4, 0);
+		atlas_pages.push_back(std::move(atlas_page));
+
+		texture_list.push_back({});
+		texture_list.back().source = CreateString("[texture atlas %d]", page);
+		texture_list.back().atlas_state = AtlasState::Page;
+		texture_list.back().atlas_page = page;
+	}
+
+	TextureLayoutRectangle& rectangle = atlas_layout.GetRectangle(rectangle_index);
+	const int page = rectangle.GetTextureIndex();
+	const int page_width = atlas_layout.GetTexture(page).GetDimensions().x;
+	const Rectanglei region = Rectanglei::FromPositionSize(rectangle.GetPosition(), dimensions);
+	AtlasPage& atlas_page = atlas_pages[page];
+
+	const size_t row_size = size_t(dimensions.x) * 4;
+	for (int y = 0; y < dimensions.y; y++)
+	{
+		const size_t page_offset = (size_t(region.Top() + y) * size_t(page_width) + size_t(region.Left())) * 4;
+		memcpy(atlas_page.data.data() + page_offset, data.data() + size_t(y) * row_size, row_size);
+	}
+
+	// Pages which are not generated yet will include the new pixels once they are first used. Otherwise, don't regenerate the page right away as
+	// its handle may already be submitted for rendering during this frame.
+	const FileTextureEntry& page_entry = texture_list[size_t(atlas_page.index)];
+	if (page_entry.texture_handle)
+	{
+		if (render_interface->UpdateTexture(page_entry.texture_handle, region, data))
+			num_uploads += 1;
+		else
+			atlas_page.regenerate = true;
+	}
+
+	FileTextureEntry& entry = texture_list[size_t(index)];
+	entry.atlas_state = AtlasState::Packed;
+	entry.atlas_page = page;
+	entry.atlas_rectangle = region;
+	entry.dimensions = dimensions;
+	num_atlased_textures += 1;
+	num_misses += 1;
+
+	return true;
+}
+
+FileTextureDatabase::FileTextureEntry& FileTextureDatabase::EnsureLoaded(RenderInterface* render_interface, TextureFileIndex index, bool need_handle)
+{
+	FileTextureEntry& entry = texture_list[size_t(index)];
+	if (entry.texture_handle || (!need_handle && entry.atlas_state == AtlasState::Packed))
+		num_hits += 1;
+	else if (entry.loading)
+		PollTextureEntry(render_interface, entry);
+	else if (!entry.load_texture_failed)
+	{
+		const bool try_pack = (!need_handle && atlasing && entry.atlas_state == AtlasState::Unknown && index != placeholder_index);
+		if (!try_pack || !PackTextureEntry(render_interface, index))
+			LoadTextureEntry(render_interface, texture_list[size_t(index)]);
+	}
+
+	// Packing may have added an atlas page to the list, thereby invalidating the entry reference.
+	FileTextureEntry& result = texture_list[size_t(index)];
+	result.release_when_loaded = false;
+	result.last_used_frame = frame;
+	return result;
+}
+
+size_t FileTextureDatabase::GetTextureBytes(const FileTextureEntry& entry)
+{
+	// Assume four bytes per pixel, the actual format is only known by the render interface.
+	return size_t(entry.dimensions.x) * size_t(entry.dimensions.y) * 4;
 }
 
 TextureHandle FileTextureDatabase::GetHandle(RenderInterface* render_interface, TextureFileIndex index)
 {
 	RMLUI_ASSERT(size_t(index) < texture_list.size());
-	return EnsureLoaded(render_interface, index).texture_handle;
+	const FileTextureEntry& entry = EnsureLoaded(render_interface, index);
+	if (entry.loading && placeholder_index != TextureFileIndex::Invalid)
+		return EnsureLoaded(render_interface, placeholder_index).texture_handle;
+	return entry.texture_handle;
 }
 
 Vector2i FileTextureDatabase::GetDimensions(RenderInterface* render_interface, TextureFileIndex index)
 {
 	RMLUI_ASSERT(size_t(index) < texture_list.size());
-	return EnsureLoaded(render_interface, index).dimensions;
+	return EnsureLoaded(render_interface, index, false).dimensions;
+}
+
+bool FileTextureDatabase::IsLoading(TextureFileIndex index) const
+{
+	RMLUI_ASSERT(size_t(index) < texture_list.size());
+	return texture_list[size_t(index)].loading;
+}
+
+bool FileTextureDatabase::GetAtlasRegion(RenderInterface* render_interface, TextureFileIndex index, TextureFileIndex& out_atlas_index,
+	Rectanglef& out_region)
+{
+	RMLUI_ASSERT(size_t(index) < texture_list.size());
+	const FileTextureEntry& entry = EnsureLoaded(render_interface, index, false);
+	if (entry.atlas_state != AtlasState::Packed)
+		return false;
+
+	const Vector2f page_dimensions = Vector2f(atlas_layout.GetTexture(entry.atlas_page).GetDimensions());
+	out_atlas_index = atlas_pages[entry.atlas_page].index;
+	out_region = Rectanglef::FromPositionSize(Vector2f(entry.atlas_rectangle.Position()) / page_dimensions,
+		Vector2f(entry.atlas_rectangle.Size()) / page_dimensions);
+	return true;
 }
 
 void FileTextureDatabase::GetSourceList(StringList& source_list) const
@@ -148,6 +481,17 @@ void FileTextureDatabase::GetSourceList(StringList& source_list) const
 		source_list.push_back(texture.first);
 }
 
+void FileTextureDatabase::PreloadTextures(RenderInterface* render_interface, size_t first_index)
+{
+	// Loading may add atlas pages to the list, those are generated by themselves when first used.
+	const size_t end_index = texture_list.size();
+	for (size_t i = first_index; i < end_index; i++)
+	{
+		if (texture_list[i].atlas_state != AtlasState::Page)
+			EnsureLoaded(render_interface, TextureFileIndex(i), false);
+	}
+}
+
 bool FileTextureDatabase::ReleaseTexture(RenderInterface* render_interface, const String& source)
 {
 	auto it = texture_map.find(source);
@@ -157,8 +501,7 @@ bool FileTextureDatabase::ReleaseTexture(RenderInterface* render_interface, cons
 	FileTextureEntry& texture = texture_list[size_t(it->second)];
 	if (texture.texture_handle)
 	{
-		render_interface->ReleaseTexture(texture.texture_handle);
-		texture = {};
+		ReleaseTextureEntry(render_interface, texture);
 		return true;
 	}
 
@@ -169,12 +512,90 @@ void FileTextureDatabase::ReleaseAllTextures(RenderInterface* render_interface)
 {
 	for (FileTextureEntry& texture : texture_list)
 	{
-		if (texture.texture_handle)
+		if (texture.texture_handle || texture.loading)
+			ReleaseTextureEntry(render_interface, texture);
+	}
+}
+
+void FileTextureDatabase::SetMemoryBudget(size_t in_budget_bytes, int in_min_unused_frames)
+{
+	budget_bytes = in_budget_bytes;
+	min_unused_frames = Math::Max(in_min_unused_frames, 1);
+}
+
+void FileTextureDatabase::SetAsyncLoading(bool enable, const String& placeholder_source)
+{
+	async_loading = enable;
+	placeholder_index = (placeholder_source.empty() ? TextureFileIndex::Invalid : InsertTexture(placeholder_source));
+}
+
+void FileTextureDatabase::SetAtlasing(bool enable, int max_image_size, int page_size)
+{
+	atlasing = enable;
+	atlas_page_size = Math::Max(page_size, 4);
+	// Leave room for the one pixel gutter kept by the texture layout on either side of each rectangle.
+	atlas_max_image_size = Math::Clamp(max_image_size, 1, atlas_page_size - 2);
+}
+
+void FileTextureDatabase::BeginFrame(RenderInterface* render_interface)
+{
+	frame += 1;
+
+	for (AtlasPage& page : atlas_pages)
+	{
+		if (page.regenerate)
 		{
-			render_interface->ReleaseTexture(texture.texture_handle);
-			texture = {};
+			ReleaseTextureEntry(render_interface, texture_list[size_t(page.index)]);
+			page.regenerate = false;
 		}
 	}
+
+	// Keep polling textures that are loading, even when not currently used, so that the render interface can hand them over to us.
+	if (num_loading_textures > 0)
+	{
+		for (FileTextureEntry& texture : texture_list)
+		{
+			if (texture.loading)
+				PollTextureEntry(render_interface, texture);
+		}
+	}
+
+	if (budget_bytes == 0 || resident_bytes <= budget_bytes)
+		return;
+
+	Vector<FileTextureEntry*> candidates;
+	for (FileTextureEntry& texture : texture_list)
+	{
+		if (texture.texture_handle && frame - texture.last_used_frame > min_unused_frames)
+			candidates.push_back(&texture);
+	}
+
+	std::sort(candidates.begin(), candidates.end(),
+		[](const FileTextureEntry* a, const FileTextureEntry* b) { return a->last_used_frame < b->last_used_frame; });
+
+	for (FileTextureEntry* texture : candidates)
+	{
+		if (resident_bytes <= budget_bytes)
+			break;
+
+		ReleaseTextureEntry(render_interface, *texture);
+		num_evictions += 1;
+	}
+}
+
+FileTextureStats FileTextureDatabase::GetStats() const
+{
+	FileTextureStats stats;
+	stats.num_textures = int(texture_list.size());
+	stats.num_resident_textures = num_resident_textures;
+	stats.num_loading_textures = num_loading_textures;
+	stats.resident_bytes = resident_bytes;
+	stats.num_hits = num_hits;
+	stats.num_misses = num_misses;
+	stats.num_evictions = num_evictions;
+	stats.num_atlased_textures = num_atlased_textures;
+	stats.num_atlas_pages = int(atlas_pages.size());
+	return stats;
 }
 
 } // namespace Rml
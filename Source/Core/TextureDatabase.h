@@ -1,8 +1,10 @@
 #pragma once
 
 #include "../../Include/RmlUi/Core/CallbackTexture.h"
+#include "../../Include/RmlUi/Core/RenderManager.h"
 #include "../../Include/RmlUi/Core/StableVector.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "TextureLayout.h"
 
 namespace Rml {
 
@@ -17,23 +19,72 @@ public:
 	void ReleaseTexture(RenderInterface* render_interface, StableVectorIndex callback_index);
 
 	Vector2i GetDimensions(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index);
+	// Returns the texture handle, or an empty handle if the texture failed to load or its regeneration was deferred to a later frame.
 	TextureHandle GetHandle(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index);
+	// Returns true if the regeneration of the texture was deferred to a later frame due to the regeneration budget.
+	bool IsDeferred(StableVectorIndex callback_index) const;
+
+	// Generates a texture from pixels on behalf of a texture callback, reusing a pooled texture of the same size if possible.
+	TextureHandle GenerateTexture(RenderInterface* render_interface, Span<const byte> source, Vector2i dimensions);
+
+	// Replaces a region of the texture if it has already been generated. Returns false if the render interface does not support texture updates, in
+	// which case the texture must be regenerated.
+	bool UpdateTexture(RenderInterface* render_interface, StableVectorIndex callback_index, Rectanglei region, Span<const byte> source);
 
 	size_t size() const;
 
 	void ReleaseAllTextures(RenderInterface* render_interface);
 
+	// Textures released by the render interface, such as after a lost context, are regenerated as they are rendered. Beyond the first one, large
+	// textures are deferred to later frames once the given number of pixels has been regenerated during a frame. Zero disables the budget.
+	void SetRegenerationBudget(int max_pixels_per_frame);
+	// Textures generated from pixels are pooled when released while enabled, and updated in place by new textures of the same size.
+	void SetPooling(RenderInterface* render_interface, bool enable);
+	// Starts a new frame, resetting the regeneration budget and releasing pooled textures which were not reused.
+	void BeginFrame(RenderInterface* render_interface);
+
+	// Returns the number of textures whose regeneration was deferred during the current frame.
+	int GetNumDeferredTextures() const { return num_deferred_textures; }
+	// Returns the number of textures generated or updated through the render interface so far.
+	uint64_t GetNumUploads() const { return num_uploads; }
+
 private:
 	struct CallbackTextureEntry {
 		CallbackTextureFunction callback;
 		TextureHandle texture_handle = {};
 		Vector2i dimensions;
 		bool load_failed = false;
+		// Set when the texture was generated from pixels, in which case its handle can be pooled and its regeneration deferred.
+		bool generated = false;
+		// The size in pixels of the texture released by ReleaseAllTextures(), while waiting to be regenerated.
+		int regenerate_pixels = 0;
 	};
 
-	CallbackTextureEntry& EnsureLoaded(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index);
+	// Textures generated from pixels are kept for a few frames after being released, to be updated in place by new textures of the same size.
+	struct PooledTexture {
+		TextureHandle texture_handle;
+		Vector2i dimensions;
+		int frame;
+	};
+
+	CallbackTextureEntry& EnsureLoaded(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index,
+		bool allow_defer);
+	void ReleaseTextureHandle(RenderInterface* render_interface, const CallbackTextureEntry& entry);
+	void ReleasePool(RenderInterface* render_interface);
 
 	StableVector<CallbackTextureEntry> texture_list;
+	uint64_t num_uploads = 0;
+
+	int regeneration_budget = 0;
+	int regenerated_pixels = 0;
+	int num_regenerated_textures = 0;
+	int num_deferred_textures = 0;
+
+	Vector<PooledTexture> texture_pool;
+	bool pooling = false;
+	// The last handle generated from pixels, used to tell whether the callback kept it as its texture.
+	TextureHandle generated_handle = {};
+	int frame = 0;
 };
 
 class FileTextureDatabase : NonCopyMoveable {
@@ -43,26 +94,104 @@ public:
 
 	TextureFileIndex InsertTexture(const String& source);
 
+	// Returns the texture handle, or the placeholder handle while the texture is loading asynchronously.
 	TextureHandle GetHandle(RenderInterface* render_interface, TextureFileIndex index);
 	Vector2i GetDimensions(RenderInterface* render_interface, TextureFileIndex index);
+	// Returns true while the texture is being loaded asynchronously.
+	bool IsLoading(TextureFileIndex index) const;
+	// Returns true if the texture is packed into an atlas, along with the atlas texture and the texture's region within it in normalized
+	// coordinates.
+	bool GetAtlasRegion(RenderInterface* render_interface, TextureFileIndex index, TextureFileIndex& out_atlas_index, Rectanglef& out_region);
 
 	void GetSourceList(StringList& source_list) const;
 
+	size_t GetNumTextures() const { return texture_list.size(); }
+	// Loads the textures starting at the given index ahead of their use, the same way as when their dimensions are first requested.
+	void PreloadTextures(RenderInterface* render_interface, size_t first_index);
+
 	bool ReleaseTexture(RenderInterface* render_interface, const String& source);
 	void ReleaseAllTextures(RenderInterface* render_interface);
 
+	// Textures not used during the given number of most recent frames are released, least recently used first, while the loaded textures exceed
+	// the budget. A budget of zero disables releasing textures.
+	void SetMemoryBudget(size_t budget_bytes, int min_unused_frames);
+	// New textures are requested asynchronously from the render interface while enabled. Textures still loading are replaced by the placeholder,
+	// if any.
+	void SetAsyncLoading(bool enable, const String& placeholder_source);
+	// New textures up to the given size are packed into shared atlas pages while enabled, if the render interface provides their pixels.
+	void SetAtlasing(bool enable, int max_image_size, int page_size);
+
+	// Starts a new frame, regenerating changed atlas pages, polling textures which are loading, and releasing textures as needed to fit within the memory budget.
+	void BeginFrame(RenderInterface* render_interface);
+
+	FileTextureStats GetStats() const;
+	// Returns the number of textures loaded, generated or updated through the render interface so far.
+	uint64_t GetNumUploads() const { return num_uploads; }
+
 private:
+	enum class AtlasState : uint8_t { Unknown, Unpacked, Packed, Page };
+
 	struct FileTextureEntry {
+		String source;
 		TextureHandle texture_handle = {};
 		Vector2i dimensions;
 		bool load_texture_failed = false;
+		int last_used_frame = 0;
+
+		// Set while loading asynchronously, the texture is released as soon as it is loaded if no longer needed by then.
+		bool loading = false;
+		bool release_when_loaded = false;
+		int last_poll_frame = 0;
+
+		// Packed textures keep their dimensions while their pixels live on an atlas page. Atlas pages are entries of their own, generated from
+		// the page pixels, so that they can be rendered and released like any other texture.
+		AtlasState atlas_state = AtlasState::Unknown;
+		int atlas_page = -1;
+		Rectanglei atlas_rectangle;
 	};
 
-	FileTextureEntry LoadTextureEntry(RenderInterface* render_interface, const String& source);
-	FileTextureEntry& EnsureLoaded(RenderInterface* render_interface, TextureFileIndex index);
+	struct AtlasPage {
+		TextureFileIndex index = TextureFileIndex::Invalid;
+		Vector<byte> data;
+		// Set when the page texture could not be updated in place, it is then regenerated at the start of the next frame.
+		bool regenerate = false;
+	};
+
+	void LoadTextureEntry(RenderInterface* render_interface, FileTextureEntry& entry);
+	void PollTextureEntry(RenderInterface* render_interface, FileTextureEntry& entry);
+	void OnTextureEntryLoaded(FileTextureEntry& entry);
+	void ReleaseTextureEntry(RenderInterface* render_interface, FileTextureEntry& entry);
+	// Packs the texture into an atlas page, returns false if it should be loaded separately instead. May add entries to the texture list.
+	bool PackTextureEntry(RenderInterface* render_interface, TextureFileIndex index);
+	// Packed textures are only loaded separately when a handle is needed, such as when they are rendered with repeating texture coordinates.
+	FileTextureEntry& EnsureLoaded(RenderInterface* render_interface, TextureFileIndex index, bool need_handle = true);
+
+	static size_t GetTextureBytes(const FileTextureEntry& entry);
 
 	Vector<FileTextureEntry> texture_list;
 	UnorderedMap<String, TextureFileIndex> texture_map; // key: source, value: index into 'texture_list'
+
+	bool async_loading = false;
+	TextureFileIndex placeholder_index = TextureFileIndex::Invalid;
+	int num_loading_textures = 0;
+
+	bool atlasing = false;
+	int atlas_max_image_size = 0;
+	int atlas_page_size = 0;
+	TextureLayout atlas_layout; // Rectangle ids are indices into 'texture_list', textures correspond to 'atlas_pages'.
+	Vector<AtlasPage> atlas_pages;
+	int num_atlased_textures = 0;
+
+	size_t budget_bytes = 0;
+	int min_unused_frames = 1;
+	int frame = 0;
+
+	size_t resident_bytes = 0;
+	int num_resident_textures = 0;
+	uint64_t num_hits = 0;
+	uint64_t num_misses = 0;
+	uint64_t num_evictions = 0;
+	uint64_t num_uploads = 0;
 };
 
 class TextureDatabase {
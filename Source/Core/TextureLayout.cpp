@@ -42,6 +42,14 @@ TextureLayoutTexture& TextureLayout::GetTexture(int index)
 	return textures[index];
 }
 
+const TextureLayoutTexture& TextureLayout::GetTexture(int index) const
+{
+	RMLUI_ASSERT(index >= 0);
+	RMLUI_ASSERT(index < GetNumTextures());
+
+	return textures[index];
+}
+
 int TextureLayout::GetNumTextures() const
 {
 	return (int)textures.size();
@@ -67,4 +75,25 @@ bool TextureLayout::GenerateLayout(int max_texture_dimensions)
 	return true;
 }
 
+int TextureLayout::InsertRectangle(int id, Vector2i dimensions)
+{
+	const int rectangle_index = GetNumRectangles();
+	rectangles.push_back(TextureLayoutRectangle(id, dimensions));
+
+	for (int i = 0; i < GetNumTextures(); ++i)
+	{
+		if (textures[i].Insert(*this, rectangle_index, i))
+			return rectangle_index;
+	}
+
+	rectangles.pop_back();
+	return -1;
+}
+
+void TextureLayout::AddTexture(Vector2i dimensions)
+{
+	textures.emplace_back();
+	textures.back().Initialize(dimensions);
+}
+
 } // namespace Rml
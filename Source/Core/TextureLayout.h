@@ -33,6 +33,7 @@ public:
 	/// @param[in] index The index of the desired texture.
 	/// @return The desired texture.
 	TextureLayoutTexture& GetTexture(int index);
+	const TextureLayoutTexture& GetTexture(int index) const;
 	/// Returns the number of textures in the layout.
 	/// @return The layout's texture count.
 	int GetNumTextures() const;
@@ -42,6 +43,15 @@ public:
 	/// @return True if the layout was generated successfully, false if not.
 	bool GenerateLayout(int max_texture_dimensions);
 
+	/// Adds a rectangle to an already generated layout, placing it in the free space of the existing textures.
+	/// @param[in] id The id of the rectangle.
+	/// @param[in] dimensions The dimensions of the rectangle.
+	/// @return The index of the new rectangle, or -1 if it did not fit on any of the textures.
+	int InsertRectangle(int id, Vector2i dimensions);
+	/// Adds an empty texture of fixed dimensions to the layout, for rectangles to be inserted into later.
+	/// @param[in] dimensions The dimensions of the new texture.
+	void AddTexture(Vector2i dimensions);
+
 private:
 	using RectangleList = Vector<TextureLayoutRectangle>;
 	using TextureList = Vector<TextureLayoutTexture>;
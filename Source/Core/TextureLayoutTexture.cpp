@@ -1,6 +1,7 @@
 #include "TextureLayoutTexture.h"
 #include "TextureDatabase.h"
 #include "TextureLayout.h"
+#include <climits>
 
 namespace Rml {
 
@@ -46,65 +47,167 @@ int TextureLayoutTexture::Generate(TextureLayout& layout, int maximum_dimensions
 	dimensions.x = Math::Min(dimensions.x, maximum_dimensions);
 	dimensions.y = Math::Min(dimensions.y, maximum_dimensions);
 
-	// Now we're layout out the rectangles in the texture. If we don't fit all the rectangles on
+	// Now we're laying out the rectangles in the texture. If we don't fit all the rectangles on
 	// and have room to grow (ie, haven't hit the maximum texture size in both dimensions) then
 	// we'll have another go with a bigger texture.
-	int num_placed_rectangles = 0;
 	for (;;)
 	{
+		const bool can_grow = (dimensions.y < dimensions.x || (dimensions.y << 1) <= maximum_dimensions);
+
+		// A single pixel is kept between rectangles, and along the top and left borders, to avoid filtering artifacts. This is achieved by extending
+		// each rectangle by one pixel and starting the skyline at one pixel from the top-left corner.
+		skyline = {SkylineNode{1, 1, dimensions.x - 1}};
+		int used_height = 1;
 		bool success = true;
-		int height = 1;
 
-		while (num_placed_rectangles != unplaced_rectangles)
+		for (int i = 0; i < layout.GetNumRectangles(); ++i)
 		{
-			TextureLayoutRow row;
-			int row_size = row.Generate(layout, dimensions.x, height);
-			if (row_size == 0)
+			TextureLayoutRectangle& rectangle = layout.GetRectangle(i);
+			if (rectangle.IsPlaced())
+				continue;
+
+			const Vector2i size = rectangle.GetDimensions() + Vector2i(1);
+			Vector2i position;
+			int node_index = 0;
+			if (!FindPosition(skyline, size, dimensions, position, node_index))
 			{
 				success = false;
-				break;
-			}
 
-			height += row.GetHeight() + 1;
-			if (height > dimensions.y)
-			{
-				// D'oh! We've exceeded our height boundaries. This row should be unplaced.
-				row.Unplace();
-				success = false;
-				break;
+				// If we can still grow there is no point in placing any more rectangles, otherwise we fit as many of the remaining ones as
+				// possible, they are sorted by height so smaller ones may still fit.
+				if (can_grow)
+					break;
+				continue;
 			}
 
-			rows.push_back(row);
-			num_placed_rectangles += row_size;
+			AddToSkyline(skyline, node_index, position, size);
+			rectangle.Place(layout.GetNumTextures(), position);
+			rectangles.push_back(i);
+			used_height = Math::Max(used_height, position.y + size.y);
 		}
 
-		// If the rectangles were successfully laid out within the texture limits, we're done.
-		if (success)
-			return num_placed_rectangles;
+		if (success || !can_grow)
+		{
+			// Trim the unused area at the bottom of the texture.
+			if (!rectangles.empty())
+				dimensions.y = Math::Min(dimensions.y, used_height);
+			return (int)rectangles.size();
+		}
 
-		// Couldn't do it! Increase the texture size, clear the rectangles and try again - unless
-		// we've hit the maximum texture size, in which case return true if we've placed any
-		// rectangles (ie, the layout isn't empty).
+		// Couldn't do it! Increase the texture size, clear the rectangles and try again.
 		if (dimensions.y > dimensions.x)
 			dimensions.x = dimensions.y;
 		else
+			dimensions.y <<= 1;
+
+		// Unplace all of the glyphs we tried to place and have another crack.
+		for (int rectangle_index : rectangles)
+			layout.GetRectangle(rectangle_index).Unplace();
+		rectangles.clear();
+	}
+}
+
+void TextureLayoutTexture::Initialize(Vector2i in_dimensions)
+{
+	dimensions = in_dimensions;
+	skyline = {SkylineNode{1, 1, dimensions.x - 1}};
+	rectangles.clear();
+}
+
+bool TextureLayoutTexture::Insert(TextureLayout& layout, int rectangle_index, int texture_index)
+{
+	TextureLayoutRectangle& rectangle = layout.GetRectangle(rectangle_index);
+	RMLUI_ASSERT(!rectangle.IsPlaced());
+
+	const Vector2i size = rectangle.GetDimensions() + Vector2i(1);
+	Vector2i position;
+	int node_index = 0;
+	if (skyline.empty() || !FindPosition(skyline, size, dimensions, position, node_index))
+		return false;
+
+	AddToSkyline(skyline, node_index, position, size);
+	rectangle.Place(texture_index, position);
+	rectangles.push_back(rectangle_index);
+	return true;
+}
+
+bool TextureLayoutTexture::FindPosition(const Skyline& skyline, Vector2i size, Vector2i texture_dimensions, Vector2i& out_position,
+	int& out_node_index)
+{
+	int best_y = INT_MAX;
+	int best_x = 0;
+	int best_index = -1;
+
+	for (int i = 0; i < (int)skyline.size(); i++)
+	{
+		const int x = skyline[i].x;
+		if (x + size.x > texture_dimensions.x)
+			break;
+
+		// The rectangle rests on the highest skyline segment it spans.
+		int y = 0;
+		int width_left = size.x;
+		for (int j = i; width_left > 0; j++)
 		{
-			if (dimensions.y << 1 > maximum_dimensions)
-				return num_placed_rectangles;
+			RMLUI_ASSERT(j < (int)skyline.size());
+			y = Math::Max(y, skyline[j].y);
+			width_left -= skyline[j].width;
+		}
 
-			dimensions.y <<= 1;
+		if (y + size.y <= texture_dimensions.y && y < best_y)
+		{
+			best_y = y;
+			best_x = x;
+			best_index = i;
 		}
+	}
+
+	if (best_index < 0)
+		return false;
 
-		// Unplace all of the glyphs we tried to place and have an other crack.
-		for (size_t i = 0; i < rows.size(); i++)
-			rows[i].Unplace();
+	out_position = Vector2i(best_x, best_y);
+	out_node_index = best_index;
+	return true;
+}
+
+void TextureLayoutTexture::AddToSkyline(Skyline& skyline, int node_index, Vector2i position, Vector2i size)
+{
+	skyline.insert(skyline.begin() + node_index, SkylineNode{position.x, position.y + size.y, size.x});
+
+	// Shrink or remove the following segments now covered by the new one.
+	const int right = position.x + size.x;
+	for (size_t i = node_index + 1; i < skyline.size();)
+	{
+		SkylineNode& node = skyline[i];
+		if (node.x >= right)
+			break;
 
-		rows.clear();
-		num_placed_rectangles = 0;
+		const int overlap = right - node.x;
+		if (overlap >= node.width)
+		{
+			skyline.erase(skyline.begin() + i);
+			continue;
+		}
+
+		node.x += overlap;
+		node.width -= overlap;
+		break;
+	}
+
+	// Merge neighbouring segments at the same height.
+	for (size_t i = 0; i + 1 < skyline.size();)
+	{
+		if (skyline[i].y == skyline[i + 1].y)
+		{
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else
+			i++;
 	}
 }
 
-Vector<byte> TextureLayoutTexture::AllocateTexture()
+Vector<byte> TextureLayoutTexture::AllocateTexture(TextureLayout& layout)
 {
 	Vector<byte> texture_data;
 
@@ -113,8 +216,8 @@ Vector<byte> TextureLayoutTexture::AllocateTexture()
 		// Set the texture to transparent black.
 		texture_data.resize(dimensions.x * dimensions.y * 4, 0);
 
-		for (size_t i = 0; i < rows.size(); ++i)
-			rows[i].Allocate(texture_data.data(), dimensions.x * 4);
+		for (int rectangle_index : rectangles)
+			layout.GetRectangle(rectangle_index).Allocate(texture_data.data(), dimensions.x * 4);
 	}
 
 	return texture_data;
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "../../Include/RmlUi/Core/Texture.h"
-#include "TextureLayoutRow.h"
+#include "TextureLayoutRectangle.h"
 
 namespace Rml {
 
@@ -9,7 +9,8 @@ class TextureLayout;
 
 /**
     A texture layout texture is a single rectangular area which sub-rectangles are placed on within
-    a complete texture layout.
+    a complete texture layout. Rectangles are packed using a bottom-left skyline, and the texture
+    height is trimmed to the area actually used.
  */
 
 class TextureLayoutTexture {
@@ -29,15 +30,41 @@ public:
 	/// @return The number of placed rectangles.
 	int Generate(TextureLayout& layout, int maximum_dimensions);
 
+	/// Initializes an empty texture of fixed dimensions, for rectangles to be inserted into later.
+	/// @param[in] dimensions The dimensions of the texture.
+	void Initialize(Vector2i dimensions);
+
+	/// Attempts to place one more rectangle from the layout into the free space of this texture, without changing its dimensions.
+	/// @param[in] layout The layout the rectangle belongs to.
+	/// @param[in] rectangle_index The index of the rectangle within the layout.
+	/// @param[in] texture_index The index of this texture within the layout.
+	/// @return True if the rectangle was placed, false if there is no room left for it.
+	bool Insert(TextureLayout& layout, int rectangle_index, int texture_index);
+
 	/// Allocates the texture.
+	/// @param[in] layout The layout this texture belongs to.
 	/// @return The allocated texture data.
-	Vector<byte> AllocateTexture();
+	Vector<byte> AllocateTexture(TextureLayout& layout);
 
 private:
-	using RowList = Vector<TextureLayoutRow>;
+	// A horizontal segment of the skyline, the top edge of the area covered so far.
+	struct SkylineNode {
+		int x;
+		int y;
+		int width;
+	};
+	using Skyline = Vector<SkylineNode>;
+
+	// Finds the lowest position for a rectangle of the given size on the skyline, returns false if it does not fit.
+	static bool FindPosition(const Skyline& skyline, Vector2i size, Vector2i texture_dimensions, Vector2i& out_position, int& out_node_index);
+	// Raises the skyline to cover the given rectangle.
+	static void AddToSkyline(Skyline& skyline, int node_index, Vector2i position, Vector2i size);
 
 	Vector2i dimensions;
-	RowList rows;
+	// The skyline is kept after generation so that new rectangles can be inserted into the remaining space.
+	Skyline skyline;
+	// Indices of the layout rectangles placed on this texture.
+	Vector<int> rectangles;
 };
 
 } // namespace Rml
@@ -19,6 +19,13 @@ bool TransformState::SetTransform(const Matrix4f* in_transform)
 
 	return is_changed;
 }
+void TransformState::SetLocalTransform(const Matrix4f* in_local_transform)
+{
+	if (in_local_transform)
+		local_transform = *in_local_transform;
+	have_local_transform = (in_local_transform != nullptr);
+}
+
 bool TransformState::SetLocalPerspective(const Matrix4f* in_perspective)
 {
 	bool is_changed = (have_perspective != (bool)in_perspective);
@@ -45,6 +52,11 @@ const Matrix4f* TransformState::GetLocalPerspective() const
 	return have_perspective ? &local_perspective : nullptr;
 }
 
+const Matrix4f* TransformState::GetLocalTransform() const
+{
+	return have_local_transform ? &local_transform : nullptr;
+}
+
 const Matrix4f* TransformState::GetInverseTransform() const
 {
 	if (!have_transform)
@@ -10,11 +10,15 @@ public:
 	// Returns true if transform was changed.
 	bool SetTransform(const Matrix4f* in_transform);
 
+	// Stores the transform resolved from the owning element's own properties, so that it can be reused while only ancestors change.
+	void SetLocalTransform(const Matrix4f* in_local_transform);
+
 	// Returns true if local perspecitve was changed.
 	bool SetLocalPerspective(const Matrix4f* in_perspective);
 
 	const Matrix4f* GetTransform() const;
 	const Matrix4f* GetLocalPerspective() const;
+	const Matrix4f* GetLocalTransform() const;
 
 	// Returns a nullptr if there is no transform set, or the transform is singular.
 	const Matrix4f* GetInverseTransform() const;
@@ -22,6 +26,7 @@ public:
 private:
 	bool have_transform = false;
 	bool have_perspective = false;
+	bool have_local_transform = false;
 	mutable bool have_inverse_transform = false;
 	mutable bool dirty_inverse_transform = false;
 
@@ -31,6 +36,9 @@ private:
 	// Local perspective which applies to children of the owning element.
 	Matrix4f local_perspective;
 
+	// The transform of the owning element alone, including its transform origin, before combining it with the ancestors.
+	Matrix4f local_transform;
+
 	// The inverse of the transform matrix for projecting points from screen space to the current element's space, such as used for picking elements.
 	mutable Matrix4f inverse_transform;
 };
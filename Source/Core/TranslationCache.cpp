@@ -0,0 +1,79 @@
+#include "TranslationCache.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "ControlledLifetimeResource.h"
+
+namespace Rml {
+
+struct TranslationCacheData {
+	struct Translation {
+		String translated;
+		int num_translations = 0;
+		uint32_t generation = 0;
+	};
+	UnorderedMap<String, Translation> translations;
+};
+
+static ControlledLifetimeResource<TranslationCacheData> translation_cache_data;
+
+// The cache size may be set before initialization, and the translations invalidated at any time.
+static size_t max_size = 0;
+static uint32_t generation = 0;
+
+void TranslationCache::Initialize()
+{
+	translation_cache_data.Initialize();
+}
+
+void TranslationCache::Shutdown()
+{
+	translation_cache_data.Shutdown();
+}
+
+int TranslationCache::TranslateString(String& translated, const String& input)
+{
+	SystemInterface* system_interface = GetSystemInterface();
+	if (!system_interface)
+		return 0;
+
+	if (max_size == 0)
+		return system_interface->TranslateString(translated, input);
+
+	auto& translations = translation_cache_data->translations;
+	auto it = translations.find(input);
+	if (it == translations.end())
+	{
+		// Strings translated once, such as the text of bound data views, may fill the cache over time. Start over when it is full.
+		if (translations.size() >= max_size)
+			translations.clear();
+		it = translations.emplace(input, TranslationCacheData::Translation{}).first;
+	}
+	else if (it->second.generation == generation)
+	{
+		translated = it->second.translated;
+		return it->second.num_translations;
+	}
+
+	TranslationCacheData::Translation& translation = it->second;
+	translation.translated.clear();
+	translation.num_translations = system_interface->TranslateString(translation.translated, input);
+	translation.generation = generation;
+
+	translated = translation.translated;
+	return translation.num_translations;
+}
+
+void TranslationCache::SetMaxSize(int max_strings)
+{
+	max_size = size_t(Math::Max(max_strings, 0));
+	if (translation_cache_data && translation_cache_data->translations.size() > max_size)
+		translation_cache_data->translations.clear();
+}
+
+void TranslationCache::Invalidate()
+{
+	generation += 1;
+}
+
+} // namespace Rml
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+/**
+    Caches the strings translated through the system interface, when enabled by Rml::SetTranslationCacheSize().
+
+    Each translation is stored along with the generation of the translations at the time, which is advanced by Rml::InvalidateTranslations().
+    Thus, outdated translations are replaced when next requested.
+ */
+class TranslationCache {
+public:
+	static void Initialize();
+	static void Shutdown();
+
+	/// Translates the input string through the system interface, or returns its cached translation.
+	/// @return The number of translations that occurred.
+	static int TranslateString(String& translated, const String& input);
+
+	static void SetMaxSize(int max_strings);
+	static void Invalidate();
+};
+
+} // namespace Rml
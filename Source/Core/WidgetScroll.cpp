@@ -363,7 +363,9 @@ void WidgetScroll::ProcessEvent(Event& event)
 				}
 			}
 
-			SetBarPosition(new_bar_position);
+			// Only the scroll offset is set here, the bar is then positioned once as the scroll offset is applied. Since the bar is moved by its
+			// offset alone, dragging neither restyles nor formats the scrollbar.
+			bar_position = Math::Clamp(new_bar_position, 0.0f, 1.0f);
 			Scroll(0.f, ScrollBehavior::Instant);
 		}
 		else if (event == EventId::Dragstart)
@@ -6,6 +6,7 @@
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/XMLParser.h"
 #include "XMLParseTools.h"
+#include <algorithm>
 
 namespace Rml {
 
@@ -50,7 +51,12 @@ bool XMLNodeHandlerDefault::ElementData(XMLParser* parser, const String& data, X
 	if (type == XMLDataType::InnerXML)
 	{
 		// Structural data views use the raw inner xml contents of the node, store them as an attribute to be processed by the data view.
-		parent->SetAttribute("rmlui-inner-rml", data);
+		const SmallUnorderedSet<String>& structural_names = Factory::GetStructuralDataViewAttributeNames();
+		const bool is_structural = std::any_of(structural_names.begin(), structural_names.end(),
+			[parent](const String& name) { return parent->HasAttribute(name); });
+
+		// Otherwise the node is lazy, its contents are instanced by the element once it is displayed.
+		parent->SetAttribute(is_structural ? "rmlui-inner-rml" : "rmlui-lazy-rml", data);
 		return true;
 	}
 
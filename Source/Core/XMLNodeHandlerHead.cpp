@@ -8,6 +8,7 @@
 #include "../../Include/RmlUi/Core/XMLParser.h"
 #include "DocumentHeader.h"
 #include "TemplateCache.h"
+#include "TranslationCache.h"
 
 namespace Rml {
 
@@ -118,9 +119,7 @@ bool XMLNodeHandlerHead::ElementData(XMLParser* parser, const String& data, XMLD
 	// Store the title
 	if (tag == "title")
 	{
-		SystemInterface* system_interface = GetSystemInterface();
-		if (system_interface != nullptr)
-			system_interface->TranslateString(parser->GetDocumentHeader()->title, data);
+		TranslationCache::TranslateString(parser->GetDocumentHeader()->title, data);
 	}
 
 	// Store an inline script
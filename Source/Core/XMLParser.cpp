@@ -22,11 +22,7 @@ static ControlledLifetimeResource<XmlParserData> xml_parser_data;
 
 XMLParser::XMLParser(Element* root)
 {
-	for (const String& cdata_tag : xml_parser_data->cdata_tags)
-		RegisterCDATATag(cdata_tag);
-
-	for (const String& name : Factory::GetStructuralDataViewAttributeNames())
-		RegisterInnerXMLAttribute(name);
+	RegisterTokenizerSyntax(*this);
 
 	// Add the first frame.
 	ParseFrame frame;
@@ -66,6 +62,18 @@ void XMLParser::RegisterPersistentCDATATag(const String& _tag)
 	xml_parser_data->cdata_tags.insert(tag);
 }
 
+void XMLParser::RegisterTokenizerSyntax(BaseXMLParser& parser)
+{
+	for (const String& cdata_tag : xml_parser_data->cdata_tags)
+		parser.RegisterCDATATag(cdata_tag);
+
+	for (const String& name : Factory::GetStructuralDataViewAttributeNames())
+		parser.RegisterInnerXMLAttribute(name);
+
+	// The contents of lazy elements are kept as RML until the element is first displayed.
+	parser.RegisterInnerXMLAttribute("lazy");
+}
+
 XMLNodeHandler* XMLParser::RegisterNodeHandler(const String& _tag, SharedPtr<XMLNodeHandler> handler)
 {
 	if (!xml_parser_data)
@@ -22,6 +22,23 @@ div#content div div
 div#content .name {
 	color: #610;
 }
+div#content div.profile {
+	margin-top: 5dp;
+	padding-left: 0;
+}
+div#content div.history {
+	display: flex;
+	align-items: flex-end;
+	height: 26dp;
+	padding-left: 0;
+	margin-top: 3dp;
+}
+div#content div.history div.bar {
+	width: 4dp;
+	padding-left: 0;
+	margin-right: 1dp;
+	background-color: #c63;
+}
 scrollbarvertical {
 	scrollbar-margin: 0px;
 }
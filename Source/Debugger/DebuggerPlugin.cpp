@@ -11,6 +11,7 @@
 #include "ElementDebugDocument.h"
 #include "ElementInfo.h"
 #include "ElementLog.h"
+#include "ElementProfiler.h"
 #include "FontSource.h"
 #include "Geometry.h"
 #include "MenuSource.h"
@@ -33,9 +34,11 @@ DebuggerPlugin::DebuggerPlugin()
 	info_element = nullptr;
 	log_element = nullptr;
 	data_explorer_element = nullptr;
+	profiler_element = nullptr;
 	hook_element = nullptr;
 
 	render_outlines = false;
+	render_invalidations = false;
 
 	application_interface = nullptr;
 }
@@ -56,7 +59,7 @@ bool DebuggerPlugin::Initialise(Context* context)
 		return false;
 	}
 
-	if (!LoadMenuElement() || !LoadInfoElement() || !LoadLogElement() || !LoadDataExplorerElement())
+	if (!LoadMenuElement() || !LoadInfoElement() || !LoadLogElement() || !LoadDataExplorerElement() || !LoadProfilerElement())
 	{
 		Log::Message(Log::LT_ERROR, "Failed to initialise debugger, error while load debugger elements.");
 		return false;
@@ -70,34 +73,10 @@ bool DebuggerPlugin::Initialise(Context* context)
 
 bool DebuggerPlugin::SetContext(Context* context)
 {
-	if (debug_context && hook_element)
-	{
-		debug_context->UnloadDocument(hook_element);
-		hook_element = nullptr;
-	}
-
-	if (context)
-	{
-		ElementDocument* element = context->CreateDocument("debug-hook");
-		if (!element)
-			return false;
-
-		RMLUI_ASSERT(!hook_element);
-		hook_element = rmlui_dynamic_cast<ElementContextHook*>(element);
-		if (!hook_element)
-		{
-			context->UnloadDocument(element);
-			return false;
-		}
-
-		hook_element->Initialise(this);
-	}
+	DetachHooks();
 
 	if (info_element)
-	{
-		SetupInfoListeners(context);
 		info_element->Reset();
-	}
 
 	if (data_explorer_element)
 	{
@@ -105,6 +84,10 @@ bool DebuggerPlugin::SetContext(Context* context)
 	}
 
 	debug_context = context;
+
+	if (menu_element && IsVisible())
+		return AttachHooks();
+
 	return true;
 }
 
@@ -114,6 +97,12 @@ void DebuggerPlugin::SetVisible(bool visibility)
 		menu_element->SetProperty(PropertyId::Visibility, Property(Style::Visibility::Visible));
 	else
 		menu_element->SetProperty(PropertyId::Visibility, Property(Style::Visibility::Hidden));
+
+	// Stay out of the way of the debug context while we are hidden.
+	if (visibility)
+		AttachHooks();
+	else
+		DetachHooks();
 }
 
 bool DebuggerPlugin::IsVisible()
@@ -156,6 +145,13 @@ void DebuggerPlugin::Render()
 		}
 	}
 
+	if (render_invalidations && debug_context)
+		RenderInvalidations();
+
+	// We are rendered as part of the debug context, thus each frame of its statistics is recorded once.
+	if (data_explorer_element && data_explorer_element->IsVisible() && debug_context)
+		data_explorer_element->RecordFrame(debug_context->GetFrameStatistics());
+
 	// Render the info element's boxes.
 	if (info_element && info_element->IsVisible())
 	{
@@ -198,7 +194,8 @@ void DebuggerPlugin::OnElementDestroy(Element* element)
 {
 	// Detect external destruction of the debugger documents. This can happen for example if the user calls
 	// `Context::UnloadAllDocuments()` on the host context.
-	if (element == menu_element || element == info_element || element == log_element || element == data_explorer_element)
+	if (element == menu_element || element == info_element || element == log_element || element == data_explorer_element ||
+		element == profiler_element)
 	{
 		ReleaseElements();
 		Log::Message(Log::LT_ERROR,
@@ -219,6 +216,7 @@ void DebuggerPlugin::ProcessEvent(Event& event)
 		{"event-log-button", log_element},
 		{"debug-info-button", info_element},
 		{"data-models-button", data_explorer_element},
+		{"profiler-button", profiler_element},
 	};
 
 	if (event == EventId::Click)
@@ -239,6 +237,12 @@ void DebuggerPlugin::ProcessEvent(Event& event)
 			render_outlines = !render_outlines;
 			event.GetTargetElement()->SetClass("open", render_outlines);
 		}
+
+		if (event.GetTargetElement()->GetId() == "invalidations-button")
+		{
+			SetRenderInvalidations(!render_invalidations);
+			event.GetTargetElement()->SetClass("open", render_invalidations);
+		}
 	}
 	else if (event == EventId::Hide || event == EventId::Show)
 	{
@@ -259,6 +263,95 @@ DebuggerPlugin* DebuggerPlugin::GetInstance()
 	return instance;
 }
 
+void DebuggerPlugin::SetRenderInvalidations(bool enable)
+{
+	render_invalidations = enable;
+	invalidation_history.clear();
+	invalidation_totals.clear();
+
+	if (debug_context)
+		debug_context->SetElementInvalidationTracking(enable && hook_element);
+}
+
+void DebuggerPlugin::RenderInvalidations()
+{
+	// The number of frames to accumulate, elements invalidated during every one of these frames are shown with full intensity.
+	constexpr size_t num_frames = 30;
+
+	auto Accumulate = [this](const InvalidationMap& frame, int sign) {
+		for (const auto& pair : frame)
+		{
+			ElementInvalidations& total = invalidation_totals[pair.first];
+			total.num_definition_updates += sign * pair.second.num_definition_updates;
+			total.num_layout_dirties += sign * pair.second.num_layout_dirties;
+			total.num_geometry_rebuilds += sign * pair.second.num_geometry_rebuilds;
+			total.num_stacking_context_dirties += sign * pair.second.num_stacking_context_dirties;
+
+			if (sign < 0 && total.num_definition_updates == 0 && total.num_layout_dirties == 0 && total.num_geometry_rebuilds == 0 &&
+				total.num_stacking_context_dirties == 0)
+				invalidation_totals.erase(pair.first);
+		}
+	};
+
+	// We are rendered as part of the debug context, thus its statistics contain the invalidations of the previous frame.
+	invalidation_history.push_back(debug_context->GetFrameStatistics().element_invalidations);
+	Accumulate(invalidation_history.back(), 1);
+	if (invalidation_history.size() > num_frames)
+	{
+		Accumulate(invalidation_history.front(), -1);
+		invalidation_history.erase(invalidation_history.begin());
+	}
+
+	if (invalidation_totals.empty())
+		return;
+
+	auto RenderTint = [](Element* element, int count, Colourb colour) {
+		if (count <= 0)
+			return;
+
+		const float intensity = Math::Min(float(count) / float(num_frames), 1.f);
+		colour.alpha = byte(32.f + 160.f * intensity);
+		for (int i = 0; i < element->GetNumBoxes(); ++i)
+		{
+			const RenderBox box = element->GetRenderBox(BoxArea::Border, i);
+			Geometry::RenderBox(element->GetAbsoluteOffset(BoxArea::Border) + box.GetBorderOffset(), box.GetFillSize(), colour);
+		}
+	};
+
+	// Tint the elements of the debug context by the kind and frequency of their invalidations. Destroyed elements are simply never found.
+	for (int i = 0; i < debug_context->GetNumDocuments(); ++i)
+	{
+		ElementDocument* document = debug_context->GetDocument(i);
+		if (document->GetId().find("rmlui-debug-") == 0)
+			continue;
+
+		Stack<Element*> element_stack;
+		element_stack.push(document);
+
+		while (!element_stack.empty())
+		{
+			Element* element = element_stack.top();
+			element_stack.pop();
+			if (!element->IsVisible())
+				continue;
+
+			auto it = invalidation_totals.find(element);
+			if (it != invalidation_totals.end())
+			{
+				const ElementInvalidations& total = it->second;
+				ElementUtilities::ApplyTransform(*element);
+				RenderTint(element, total.num_definition_updates, Colourb(0, 96, 255));
+				RenderTint(element, total.num_layout_dirties, Colourb(255, 0, 0));
+				RenderTint(element, total.num_geometry_rebuilds, Colourb(0, 200, 0));
+				RenderTint(element, total.num_stacking_context_dirties, Colourb(255, 220, 0));
+			}
+
+			for (int j = 0; j < element->GetNumChildren(); ++j)
+				element_stack.push(element->GetChild(j));
+		}
+	}
+}
+
 bool DebuggerPlugin::LoadFont()
 {
 	const String font_family_name = "rmlui-debugger-font";
@@ -292,7 +385,7 @@ bool DebuggerPlugin::LoadMenuElement()
 
 	menu_element->GetElementById("version-number")->SetInnerRML(Rml::GetVersion());
 
-	for (auto* id : {"event-log-button", "debug-info-button", "outlines-button", "data-models-button"})
+	for (auto* id : {"event-log-button", "debug-info-button", "outlines-button", "invalidations-button", "data-models-button", "profiler-button"})
 	{
 		Element* button = menu_element->GetElementById(id);
 		button->AddEventListener(EventId::Click, this);
@@ -375,6 +468,75 @@ bool DebuggerPlugin::LoadDataExplorerElement()
 	return true;
 }
 
+bool DebuggerPlugin::LoadProfilerElement()
+{
+	profiler_element_instancer = MakeUnique<ElementInstancerGeneric<ElementProfiler>>();
+	Factory::RegisterElementInstancer("debug-profiler", profiler_element_instancer.get());
+	profiler_element = rmlui_dynamic_cast<ElementProfiler*>(host_context->CreateDocument("debug-profiler"));
+	if (!profiler_element)
+		return false;
+
+	profiler_element->SetProperty(PropertyId::Visibility, Property(Style::Visibility::Hidden));
+
+	if (!profiler_element->Initialise())
+	{
+		host_context->UnloadDocument(profiler_element);
+		profiler_element = nullptr;
+		return false;
+	}
+
+	profiler_element->AddEventListener(EventId::Hide, this);
+	profiler_element->AddEventListener(EventId::Show, this);
+
+	return true;
+}
+
+bool DebuggerPlugin::AttachHooks()
+{
+	if (!debug_context || hook_element)
+		return true;
+
+	ElementDocument* element = debug_context->CreateDocument("debug-hook");
+	if (!element)
+		return false;
+
+	hook_element = rmlui_dynamic_cast<ElementContextHook*>(element);
+	if (!hook_element)
+	{
+		debug_context->UnloadDocument(element);
+		return false;
+	}
+
+	hook_element->Initialise(this);
+
+	if (info_element)
+		SetupInfoListeners(debug_context);
+
+	if (render_invalidations)
+		debug_context->SetElementInvalidationTracking(true);
+
+	return true;
+}
+
+void DebuggerPlugin::DetachHooks()
+{
+	if (!debug_context || !hook_element)
+		return;
+
+	debug_context->UnloadDocument(hook_element);
+	hook_element = nullptr;
+
+	if (info_element)
+		SetupInfoListeners(nullptr);
+
+	if (render_invalidations)
+	{
+		debug_context->SetElementInvalidationTracking(false);
+		invalidation_history.clear();
+		invalidation_totals.clear();
+	}
+}
+
 void DebuggerPlugin::SetupInfoListeners(Rml::Context* new_context)
 {
 	RMLUI_ASSERT(info_element);
@@ -397,8 +559,7 @@ void DebuggerPlugin::SetupInfoListeners(Rml::Context* new_context)
 void DebuggerPlugin::ReleaseElements()
 {
 	// Erase event listeners to prevent crashes.
-	if (info_element)
-		SetupInfoListeners(nullptr);
+	DetachHooks();
 
 	if (host_context)
 	{
@@ -424,9 +585,15 @@ void DebuggerPlugin::ReleaseElements()
 		}
 		if (data_explorer_element)
 		{
+			data_explorer_element->SetDebugContext(nullptr);
 			host_context->UnloadDocument(data_explorer_element);
 			data_explorer_element = nullptr;
 		}
+		if (profiler_element)
+		{
+			host_context->UnloadDocument(profiler_element);
+			profiler_element = nullptr;
+		}
 
 		// Update to release documents before the plugin gets deleted.
 		// Helps avoid cleanup crashes.
@@ -435,12 +602,6 @@ void DebuggerPlugin::ReleaseElements()
 
 	if (debug_context)
 	{
-		if (hook_element)
-		{
-			debug_context->UnloadDocument(hook_element);
-			hook_element = nullptr;
-		}
-
 		// Update to release documents before the plugin gets deleted.
 		// Helps avoid cleanup crashes.
 		debug_context->Update();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../Include/RmlUi/Core/EventListener.h"
+#include "../../Include/RmlUi/Core/FrameStatistics.h"
 #include "../../Include/RmlUi/Core/Plugin.h"
 
 namespace Rml {
@@ -14,6 +15,7 @@ class ElementLog;
 class ElementInfo;
 class ElementContextHook;
 class ElementDataModels;
+class ElementProfiler;
 class DebuggerSystemInterface;
 
 /**
@@ -70,9 +72,19 @@ private:
 	bool LoadInfoElement();
 	bool LoadLogElement();
 	bool LoadDataExplorerElement();
+	bool LoadProfilerElement();
 
+	// Adds the hook document and the event listeners to the debug context, they are only attached while the debugger is visible.
+	bool AttachHooks();
+	void DetachHooks();
+	// Moves the info element's event listeners from the debug context to the new context.
 	void SetupInfoListeners(Rml::Context* new_context);
 
+	// Enables or disables the invalidation heatmap, and the tracking of element invalidations by the debug context.
+	void SetRenderInvalidations(bool enable);
+	// Adds the invalidations during the most recent frame of the debug context to the history, and renders the heatmap.
+	void RenderInvalidations();
+
 	// Release all loaded elements
 	void ReleaseElements();
 
@@ -86,15 +98,22 @@ private:
 	ElementInfo* info_element;
 	ElementLog* log_element;
 	ElementDataModels* data_explorer_element;
+	ElementProfiler* profiler_element;
 	ElementContextHook* hook_element;
 
 	Rml::SystemInterface* application_interface;
 	UniquePtr<DebuggerSystemInterface> log_interface;
 
 	UniquePtr<ElementInstancer> hook_element_instancer, debug_document_instancer, info_element_instancer, log_element_instancer,
-		data_explorer_element_instancer;
+		data_explorer_element_instancer, profiler_element_instancer;
 
 	bool render_outlines;
+	bool render_invalidations;
+
+	using InvalidationMap = UnorderedMap<const Element*, ElementInvalidations>;
+	// The element invalidations of the most recent frames ordered from oldest to newest, and their sum over these frames.
+	Vector<InvalidationMap> invalidation_history;
+	InvalidationMap invalidation_totals;
 
 	// Singleton instance
 	static DebuggerPlugin* instance;
@@ -108,11 +108,40 @@ void ElementDataModels::Reset()
 
 void ElementDataModels::SetDebugContext(Context* new_debug_context)
 {
+	if (debug_context && enabled_profiling)
+		debug_context->SetDataModelProfiling(false);
+
+	enabled_profiling = false;
+	model_history.clear();
 	debug_context = new_debug_context;
 }
 
+void ElementDataModels::RecordFrame(const FrameStatistics& statistics)
+{
+	constexpr size_t max_num_frames = 60;
+
+	// Models without statistics were removed or are not profiled, forget their history.
+	for (auto it = model_history.begin(); it != model_history.end();)
+	{
+		if (statistics.data_models.count(it->first) == 0)
+			it = model_history.erase(it);
+		else
+			++it;
+	}
+
+	for (const auto& name_statistics_pair : statistics.data_models)
+	{
+		Vector<DataModelStatistics>& history = model_history[name_statistics_pair.first];
+		history.push_back(name_statistics_pair.second);
+		if (history.size() > max_num_frames)
+			history.erase(history.begin());
+	}
+}
+
 void ElementDataModels::OnUpdate()
 {
+	UpdateProfiling();
+
 	if (!IsVisible() || !debug_context)
 		return;
 
@@ -128,6 +157,88 @@ void ElementDataModels::OnUpdate()
 	}
 }
 
+void ElementDataModels::UpdateProfiling()
+{
+	if (!debug_context)
+		return;
+
+	if (IsVisible() && !debug_context->IsDataModelProfiling())
+	{
+		debug_context->SetDataModelProfiling(true);
+		enabled_profiling = true;
+	}
+	else if (!IsVisible() && enabled_profiling)
+	{
+		debug_context->SetDataModelProfiling(false);
+		enabled_profiling = false;
+		model_history.clear();
+	}
+}
+
+String ElementDataModels::GetProfileRml(const String& model_name) const
+{
+	auto it = model_history.find(model_name);
+	if (it == model_history.end() || it->second.empty())
+		return String();
+
+	const Vector<DataModelStatistics>& history = it->second;
+	const float num_frames = float(history.size());
+
+	DataModelStatistics total;
+	SmallOrderedMap<String, int> total_views_by_type;
+	double max_update_time = 0;
+	for (const DataModelStatistics& frame : history)
+	{
+		total.update_time += frame.update_time;
+		total.num_dirty_variables += frame.num_dirty_variables;
+		total.num_view_updates += frame.num_view_updates;
+		total.num_expression_runs += frame.num_expression_runs;
+		total.expression_time += frame.expression_time;
+		total.num_for_rows_inserted += frame.num_for_rows_inserted;
+		total.num_for_rows_removed += frame.num_for_rows_removed;
+		total.num_for_rows_moved += frame.num_for_rows_moved;
+		for (const auto& type_count_pair : frame.view_updates_by_type)
+			total_views_by_type[type_count_pair.first.empty() ? String("(custom)") : type_count_pair.first] += type_count_pair.second;
+		max_update_time = Math::Max(max_update_time, frame.update_time);
+	}
+
+	auto PerFrame = [num_frames](int count) { return CreateString("%.1f", float(count) / num_frames); };
+	auto Milliseconds = [](double seconds) { return CreateString("%.3f ms", seconds * 1000.0); };
+
+	String rml = "<div class='profile'>";
+	rml += "<em>Average per frame over the last " + ToString(history.size()) + " frames.</em><br/>";
+	rml += "<span class='name'>Update time</span>: " + Milliseconds(total.update_time / double(num_frames)) + " (max " +
+		Milliseconds(max_update_time) + ")<br/>";
+	rml += "<span class='name'>Dirty variables</span>: " + PerFrame(total.num_dirty_variables) + "<br/>";
+	rml += "<span class='name'>View updates</span>: " + PerFrame(total.num_view_updates);
+	if (!total_views_by_type.empty())
+	{
+		String separator = " (";
+		for (const auto& type_count_pair : total_views_by_type)
+		{
+			rml += separator + type_count_pair.first + ": " + PerFrame(type_count_pair.second);
+			separator = ", ";
+		}
+		rml += ")";
+	}
+	rml += "<br/>";
+	rml += "<span class='name'>Expressions</span>: " + PerFrame(total.num_expression_runs) + " in " +
+		Milliseconds(total.expression_time / double(num_frames)) + "<br/>";
+	rml += "<span class='name'>For rows</span>: +" + PerFrame(total.num_for_rows_inserted) + " / -" + PerFrame(total.num_for_rows_removed) +
+		" / moved " + PerFrame(total.num_for_rows_moved) + "<br/>";
+
+	// The update time of every frame in the history, relative to the slowest frame.
+	rml += "<div class='history'>";
+	for (const DataModelStatistics& frame : history)
+	{
+		const double height = (max_update_time > 0 ? 1.0 + 23.0 * frame.update_time / max_update_time : 1.0);
+		rml += CreateString("<div class='bar' style='height: %.0fdp'/>", height);
+	}
+	rml += "</div>";
+	rml += "</div>";
+	return rml;
+}
+
 void ElementDataModels::ProcessEvent(Event& event)
 {
 	if (!IsVisible())
@@ -178,6 +289,8 @@ void ElementDataModels::UpdateContent()
 		if (variables.empty())
 			model_rml += "<em>No data variables in data model.</em><br/>";
 
+		model_rml += GetProfileRml(model_name);
+
 		model_rml += "</div>";
 		model_rml += "</div>";
 	}
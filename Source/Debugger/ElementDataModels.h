@@ -2,6 +2,7 @@
 
 #include "../../Include/RmlUi/Core/ElementDocument.h"
 #include "../../Include/RmlUi/Core/EventListener.h"
+#include "../../Include/RmlUi/Core/FrameStatistics.h"
 #include "ElementDebugDocument.h"
 
 namespace Rml {
@@ -19,18 +20,29 @@ public:
 
 	void SetDebugContext(Context* debug_context);
 
+	// Adds the data model statistics of the most recent frame of the debug context to the history.
+	void RecordFrame(const FrameStatistics& statistics);
+
 protected:
 	void ProcessEvent(Event& event) override;
 	void OnUpdate() override;
 
 private:
 	void UpdateContent();
+	// Enables data model profiling on the debug context while we are visible, unless it was already enabled by the application.
+	void UpdateProfiling();
+	// Generates the profile of the given model from its history.
+	String GetProfileRml(const String& model_name) const;
 
 	Context* debug_context = nullptr;
 
 	double previous_update_time = {};
 
 	SmallOrderedMap<String, String> model_rml_map;
+
+	bool enabled_profiling = false;
+	// The statistics of each data model during the most recent frames, ordered from oldest to newest.
+	UnorderedMap<String, Vector<DataModelStatistics>> model_history;
 };
 
 } // namespace Debugger
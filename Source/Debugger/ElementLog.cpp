@@ -112,26 +112,37 @@ bool ElementLog::Initialise()
 	return true;
 }
 
-void ElementLog::AddLogMessage(Log::Type type, const String& message)
+void ElementLog::LogMessageBuffer::Push(LogMessage&& message)
 {
-	LogMessageList& log_message_list = log_types[type].log_messages;
-	if (log_message_list.size() >= MAX_LOG_MESSAGES)
+	if (messages.size() < MAX_LOG_MESSAGES)
 	{
-		log_message_list.erase(log_message_list.begin());
+		messages.push_back(std::move(message));
 	}
+	else
+	{
+		messages[first] = std::move(message);
+		first = (first + 1) % messages.size();
+	}
+}
 
+void ElementLog::LogMessageBuffer::Clear()
+{
+	messages.clear();
+	first = 0;
+}
+
+void ElementLog::AddLogMessage(Log::Type type, const String& message)
+{
 	// Add the message to the list of messages for the specified log type.
-	LogMessage log_message;
-	log_message.index = current_index++;
-	log_message.message = StringUtilities::EncodeRml(message);
-	log_message_list.push_back(log_message);
+	log_types[type].log_messages.Push(LogMessage{current_index++, message});
 
 	// If this log type is invisible, and there is a button for this log type, then change its text from
 	// "Off" to "Off*" to signal that there are unread logs.
 	if (!log_types[type].visible)
 	{
-		if (!log_types[type].button_name.empty())
+		if (!log_types[type].unread && !log_types[type].button_name.empty())
 		{
+			log_types[type].unread = true;
 			Element* button = GetElementById(log_types[type].button_name);
 			if (button)
 			{
@@ -170,7 +181,8 @@ void ElementLog::OnUpdate()
 {
 	ElementDocument::OnUpdate();
 
-	if (dirty_logs)
+	// The messages are only formatted while visible, and then only once after any new messages.
+	if (dirty_logs && IsVisible())
 	{
 		// Set the log content:
 		String messages;
@@ -185,7 +197,7 @@ void ElementLog::OnUpdate()
 			{
 				messages += CreateString("<div class=\"log-entry\"><div class=\"icon %s\">%s</div><p class=\"message\">",
 					log_types[next_type].class_name.c_str(), log_types[next_type].alert_contents.c_str());
-				messages += log_types[next_type].log_messages[log_pointers[next_type]].message;
+				messages += StringUtilities::EncodeRml(log_types[next_type].log_messages[log_pointers[next_type]].message);
 				messages += "</p></div>";
 
 				log_pointers[next_type]++;
@@ -229,7 +241,8 @@ void ElementLog::ProcessEvent(Event& event)
 			{
 				for (int i = 0; i < Log::LT_MAX; i++)
 				{
-					log_types[i].log_messages.clear();
+					log_types[i].log_messages.Clear();
+					log_types[i].unread = false;
 					if (!log_types[i].visible)
 					{
 						if (Element* button = GetElementById(log_types[i].button_name))
@@ -245,6 +258,7 @@ void ElementLog::ProcessEvent(Event& event)
 					if (!log_types[i].button_name.empty() && event.GetTargetElement()->GetId() == log_types[i].button_name)
 					{
 						log_types[i].visible = !log_types[i].visible;
+						log_types[i].unread = false;
 						if (log_types[i].visible)
 							event.GetTargetElement()->SetInnerRML("On");
 						else
@@ -272,7 +286,7 @@ int ElementLog::FindNextEarliestLogType(unsigned int log_pointers[Log::LT_MAX])
 	{
 		if (log_types[i].visible)
 		{
-			if (log_pointers[i] < log_types[i].log_messages.size())
+			if (log_pointers[i] < log_types[i].log_messages.Size())
 			{
 				if (log_types[i].log_messages[log_pointers[i]].index < index)
 				{
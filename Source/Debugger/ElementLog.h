@@ -33,14 +33,28 @@ private:
 		unsigned int index;
 		String message;
 	};
-	using LogMessageList = Vector<LogMessage>;
+
+	// Ring buffer of the most recent messages of a log type. Messages are stored as logged, and only formatted while the log is visible.
+	class LogMessageBuffer {
+	public:
+		void Push(LogMessage&& message);
+		void Clear();
+		size_t Size() const { return messages.size(); }
+		// Returns the message at the given position, ordered from oldest to newest.
+		const LogMessage& operator[](size_t i) const { return messages[(first + i) % messages.size()]; }
+
+	private:
+		Vector<LogMessage> messages;
+		size_t first = 0;
+	};
 
 	struct LogType {
 		bool visible;
+		bool unread = false;
 		String class_name;
 		String alert_contents;
 		String button_name;
-		LogMessageList log_messages;
+		LogMessageBuffer log_messages;
 	};
 	LogType log_types[Log::LT_MAX];
 
@@ -0,0 +1,173 @@
+#include "ElementProfiler.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/Factory.h"
+#include "../../Include/RmlUi/Core/Profiler.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
+#include "../../Include/RmlUi/Core/StyleSheet.h"
+#include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "CommonSource.h"
+#include "ProfilerSource.h"
+
+namespace Rml {
+namespace Debugger {
+
+static constexpr int max_num_zones = 15;
+
+static String FormatMilliseconds(double seconds)
+{
+	return CreateString("%.3f", seconds * 1000.0);
+}
+
+static void AddRow(String& out_rml, const String& name, std::initializer_list<String> values)
+{
+	out_rml += "<div class='row'><span class='name'>" + StringUtilities::EncodeRml(name) + "</span>";
+	for (const String& value : values)
+		out_rml += "<span class='value'>" + value + "</span>";
+	out_rml += "</div>";
+}
+
+ElementProfiler::ElementProfiler(const String& tag) : ElementDebugDocument(tag) {}
+
+ElementProfiler::~ElementProfiler()
+{
+	RemoveEventListener(EventId::Click, this);
+	if (recording)
+		Profiler::SetEnabled(false);
+}
+
+bool ElementProfiler::Initialise()
+{
+	SetInnerRML(profiler_rml);
+	SetId("rmlui-debug-profiler");
+
+	AddEventListener(EventId::Click, this);
+
+	SharedPtr<StyleSheetContainer> style_sheet = Factory::InstanceStyleSheetString(String(common_rcss) + String(profiler_rcss));
+	if (!style_sheet)
+		return false;
+
+	SetStyleSheetContainer(std::move(style_sheet));
+
+	return true;
+}
+
+void ElementProfiler::OnUpdate()
+{
+	// Only record while the results are presented, so that the profiler has no overhead otherwise.
+	const bool visible = IsVisible();
+	if (visible != recording)
+	{
+		recording = visible;
+		Profiler::SetEnabled(recording);
+	}
+	if (!visible)
+		return;
+
+	const double t = GetSystemInterface()->GetElapsedTime();
+	const float dt = (float)(t - previous_update_time);
+
+	constexpr float update_interval = 0.5f;
+
+	if (dt > update_interval)
+	{
+		previous_update_time = t;
+		UpdateContent();
+	}
+}
+
+void ElementProfiler::ProcessEvent(Event& event)
+{
+	if (!IsVisible())
+		return;
+
+	Element* target_element = event.GetTargetElement();
+	if (target_element->GetOwnerDocument() != this)
+		return;
+
+	if (event == EventId::Click)
+	{
+		const String& id = event.GetTargetElement()->GetId();
+
+		if (id == "close_button")
+			Hide();
+
+		event.StopPropagation();
+	}
+}
+
+void ElementProfiler::UpdateContent()
+{
+	String rml;
+
+	const Vector<Profiler::FrameTiming> frames = Profiler::GetFrameHistory();
+
+	if (!Profiler::IsAvailable())
+	{
+		rml = "<div class='note'><em>The built-in profiler is not available, build RmlUi with RMLUI_BUILTIN_PROFILING to enable it.</em></div>";
+	}
+	else if (frames.empty())
+	{
+		rml = "<div class='note'><em>No frames recorded yet. Frames are delimited by RMLUI_FrameMark or by calling "
+			  "Rml::Profiler::MarkFrame().</em></div>";
+	}
+	else
+	{
+		const Profiler::FrameBreakdown& last_frame = Profiler::GetLastFrame();
+		constexpr size_t num_phases = size_t(ProfilerPhase::Count);
+		const char* phase_names[num_phases] = {"Data models", "Style", "Layout", "Render"};
+
+		double sum_frame_time = 0;
+		double max_frame_time = 0;
+		double sum_phase_times[num_phases] = {};
+		double max_phase_times[num_phases] = {};
+		for (const Profiler::FrameTiming& frame : frames)
+		{
+			sum_frame_time += frame.frame_time;
+			max_frame_time = Math::Max(max_frame_time, frame.frame_time);
+			for (size_t i = 0; i < num_phases; i++)
+			{
+				sum_phase_times[i] += frame.phase_times[i];
+				max_phase_times[i] = Math::Max(max_phase_times[i], frame.phase_times[i]);
+			}
+		}
+		const double num_frames = double(frames.size());
+
+		rml += "<h2>Frame (ms, " + ToString(frames.size()) + " frames)</h2>";
+		AddRow(rml, "", {"avg", "max"});
+		AddRow(rml, "Frame time", {FormatMilliseconds(sum_frame_time / num_frames), FormatMilliseconds(max_frame_time)});
+		for (size_t i = 0; i < num_phases; i++)
+			AddRow(rml, phase_names[i], {FormatMilliseconds(sum_phase_times[i] / num_frames), FormatMilliseconds(max_phase_times[i])});
+
+		rml += "<h2>Documents (ms, last frame)</h2>";
+		AddRow(rml, "", {"style", "layout", "render"});
+		for (const Profiler::DocumentTiming& document : last_frame.documents)
+		{
+			AddRow(rml, document.name,
+				{FormatMilliseconds(document.phase_times[size_t(ProfilerPhase::Style)]),
+					FormatMilliseconds(document.phase_times[size_t(ProfilerPhase::Layout)]),
+					FormatMilliseconds(document.phase_times[size_t(ProfilerPhase::Render)])});
+		}
+
+		rml += "<h2>Elements (ms, last frame)</h2>";
+		for (const Profiler::ElementTiming& element : last_frame.elements)
+			AddRow(rml, element.address + " [" + element.document + "]", {FormatMilliseconds(element.time)});
+
+		rml += "<h2>Zones (ms, last frame)</h2>";
+		AddRow(rml, "", {"self", "total", "calls"});
+		const size_t num_zones = Math::Min(last_frame.zones.size(), size_t(max_num_zones));
+		for (size_t i = 0; i < num_zones; i++)
+		{
+			const Profiler::ZoneTiming& zone = last_frame.zones[i];
+			AddRow(rml, zone.name, {FormatMilliseconds(zone.self_time), FormatMilliseconds(zone.total_time), ToString(zone.count)});
+		}
+	}
+
+	if (rml != content_rml)
+	{
+		content_rml = std::move(rml);
+		GetElementById("content")->SetInnerRML(content_rml);
+	}
+}
+
+} // namespace Debugger
+} // namespace Rml
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/EventListener.h"
+#include "ElementDebugDocument.h"
+
+namespace Rml {
+namespace Debugger {
+
+class ElementProfiler : public ElementDebugDocument, public EventListener {
+public:
+	RMLUI_RTTI_DefineWithParent(ElementProfiler, ElementDebugDocument)
+
+	ElementProfiler(const String& tag);
+	~ElementProfiler();
+
+	bool Initialise();
+
+protected:
+	void ProcessEvent(Event& event) override;
+	void OnUpdate() override;
+
+private:
+	void UpdateContent();
+
+	double previous_update_time = {};
+	bool recording = false;
+
+	String content_rml;
+};
+
+} // namespace Debugger
+} // namespace Rml
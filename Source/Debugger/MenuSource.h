@@ -61,6 +61,8 @@ static const char* menu_rml = R"RML(
 	<button id="event-log-button">Event Log</button>
 	<button id="debug-info-button">Element Info</button>
 	<button id="outlines-button">Outlines</button>
+	<button id="invalidations-button">Invalidations</button>
 	<button id="data-models-button">Data Models</button>
+	<button id="profiler-button">Profiler</button>
 </div>
 )RML";
@@ -0,0 +1,48 @@
+static const char* profiler_rcss = R"RCSS(
+body {
+	width: 360dp;
+	min-width: 250dp;
+	top: 42dp;
+	left: 440dp;
+}
+div#content {
+	height: auto;
+	min-height: 150dp;
+	max-height: 650dp;
+}
+div#content h2 {
+	padding-left: 5dp;
+}
+div.row {
+	display: flex;
+	font-size: 12dp;
+	padding: 0 5dp 0 10dp;
+}
+div.row .name {
+	flex: 1;
+	color: #610;
+	white-space: nowrap;
+	overflow: hidden;
+}
+div.row .value {
+	width: 70dp;
+	text-align: right;
+}
+div.note {
+	font-size: 12dp;
+	padding: 5dp 10dp;
+}
+scrollbarvertical {
+	scrollbar-margin: 0px;
+}
+)RCSS";
+
+static const char* profiler_rml = R"RML(
+<h1>
+	<handle id="position_handle" move_target="#document"/>
+	<div id="close_button">X</div>
+	<div id="title-content">Profiler</div>
+</h1>
+<div id="content">
+</div>
+)RML";
@@ -4,11 +4,11 @@
 #include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/ElementDocument.h"
 #include "../../Include/RmlUi/Core/ElementUtilities.h"
-#include "../../Include/RmlUi/Core/FileInterface.h"
 #include "../../Include/RmlUi/Core/MeshUtilities.h"
 #include "../../Include/RmlUi/Core/PropertyIdSet.h"
 #include "../../Include/RmlUi/Core/RenderManager.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "LottieCache.h"
 #include <cmath>
 #include <rlottie.h>
 
@@ -41,33 +41,64 @@ void ElementLottie::OnUpdate()
 {
 	EnsureSourceLoaded();
 
-	if (!animation)
+	if (!source)
 		return;
 
 	const auto t = GetSystemInterface()->GetElapsedTime();
 
-	if (time_animation_start < 0.0)
-		time_animation_start = t;
+	if (source->time_start < 0.0)
+		source->time_start = t;
 
 	double _unused;
-	const double frame_duration = 1.0 / animation->frameRate();
-	const double delay = std::modf((t - time_animation_start) / frame_duration, &_unused) * frame_duration;
-	if (IsVisible(true))
-	{
-		if (Context* ctx = GetContext())
-			ctx->RequestNextUpdate(delay);
-	}
+	const double frame_duration = 1.0 / source->animation->frameRate();
+	const double delay = std::modf((t - source->time_start) / frame_duration, &_unused) * frame_duration;
+
+	Context* context = GetContext();
+	if (!context || !IsVisible(true))
+		return;
+
+	// Pause while the element is scrolled out of view or clipped away, moving it back into view dirties its rendering again.
+	Rectanglei clip_region;
+	if (!ElementUtilities::GetClippingRegion(this, clip_region))
+		clip_region = Rectanglei::MakeInvalid();
+	if (!IsContentVisible(clip_region, context->GetDimensions()))
+		return;
+
+	// The animation is rendered at the current time, thus it renders something different on every update.
+	DirtyRenderCache();
+	context->RequestNextUpdate(delay);
 }
 
 void ElementLottie::OnRender()
 {
-	if (animation)
+	if (!source)
+		return;
+
+	RenderManager* render_manager = GetRenderManager();
+	if (!render_manager)
+		return;
+
+	// Skip rendering new frames while the element is off-screen or clipped away.
+	if (!IsContentVisible(render_manager->GetState().scissor_region, render_manager->GetViewport()))
+		return;
+
+	if (geometry_dirty)
+		GenerateGeometry();
+
+	if (texture_size_dirty)
 	{
-		if (geometry_dirty)
-			GenerateGeometry();
+		// Look up the new frames before releasing the previous ones, in case they are the same.
+		SharedPtr<Lottie::LottieFrames> new_frames;
+		if (render_dimensions.x > 0 && render_dimensions.y > 0)
+			new_frames = Lottie::LottieCache::GetFrames(source, *render_manager, render_dimensions);
+		frames = std::move(new_frames);
+		texture_size_dirty = false;
+	}
 
-		UpdateTexture();
-		geometry.Render(GetAbsoluteOffset(BoxArea::Content).Round(), texture);
+	if (frames)
+	{
+		frames->Update(GetSystemInterface()->GetElapsedTime());
+		geometry.Render(GetAbsoluteOffset(BoxArea::Content).Round(), frames->GetTexture());
 	}
 }
 
@@ -116,11 +147,10 @@ void ElementLottie::GenerateGeometry()
 bool ElementLottie::LoadAnimation()
 {
 	animation_dirty = false;
+	texture_size_dirty = true;
 	intrinsic_dimensions = Vector2f{};
-	texture = {};
-	animation.reset();
-	prev_animation_frame = size_t(-1);
-	time_animation_start = -1;
+	frames.reset();
+	source.reset();
 
 	const String attribute_src = GetAttribute<String>("src", "");
 
@@ -137,98 +167,27 @@ bool ElementLottie::LoadAnimation()
 		GetSystemInterface()->JoinPath(directory, document_source_url, "");
 	}
 
-	String json_data;
-
-	if (path.empty() || !GetFileInterface()->LoadFile(path, json_data))
-	{
-		Log::Message(Rml::Log::Type::LT_WARNING, "Could not load lottie file %s", path.c_str());
+	// Elements displaying the same animation share its source, and the rendered frames when displayed at the same size.
+	source = Lottie::LottieCache::GetSource(path, directory);
+	if (!source)
 		return false;
-	}
 
-	animation = rlottie::Animation::loadFromData(std::move(json_data), path, directory);
-
-	if (!animation)
-	{
-		Log::Message(Rml::Log::Type::LT_WARNING, "Could not construct the lottie animation %s", path.c_str());
-		return false;
-	}
-
-	size_t width = 0, height = 0;
-	animation->size(width, height);
-	intrinsic_dimensions.x = float(width);
-	intrinsic_dimensions.y = float(height);
+	intrinsic_dimensions = source->intrinsic_dimensions;
 
 	return true;
 }
 
-void ElementLottie::UpdateTexture()
+bool ElementLottie::IsContentVisible(Rectanglei clip_region, Vector2i viewport)
 {
-	if (!animation)
-		return;
-
-	RenderManager* render_manager = GetRenderManager();
-	if (!render_manager)
-		return;
-
-	const double t = GetSystemInterface()->GetElapsedTime();
-
-	// Find the next animation frame to display.
-	// Here it is possible to add more logic to control playback speed, pause/resume, and more.
-	double _unused;
-	// Find the normalized animation progress [0, 1].
-	const double pos = std::modf((t - time_animation_start) / animation->duration(), &_unused);
-
-	const size_t next_frame = animation->frameAtPos(pos);
-	if (!texture_size_dirty && next_frame == prev_animation_frame)
-	{
-		// No need to update the texture if we are drawing the same frame at the same size.
-		return;
-	}
-
-	// Resize the texture buffer if necessary.
-	const size_t new_texture_data_size = 4 * render_dimensions.x * render_dimensions.y;
-	if (new_texture_data_size > texture_data_size)
-	{
-		texture_data.reset(new byte[new_texture_data_size]);
-		texture_data_size = new_texture_data_size;
-	}
-
-	// Callback for generating texture.
-	auto texture_callback = [this, next_frame](const CallbackTextureInterface& texture_interface) -> bool {
-		RMLUI_ASSERT(animation);
-
-		const size_t bytes_per_line = 4 * render_dimensions.x;
-		const size_t total_bytes = bytes_per_line * render_dimensions.y;
-		byte* p_data = texture_data.get();
-
-		rlottie::Surface surface(reinterpret_cast<uint32_t*>(p_data), render_dimensions.x, render_dimensions.y, bytes_per_line);
-		animation->renderSync(next_frame, surface);
-
-		// Swizzle the channel order from rlottie's BGRA to RmlUi's RGBA.
-		for (size_t i = 0; i < total_bytes; i += 4)
-		{
-			// Swap the RB order for correct color channels.
-			std::swap(p_data[i], p_data[i + 2]);
-
-#ifdef RMLUI_DEBUG
-			const byte alpha = p_data[i + 3];
-			for (int c = 0; c < 3; c++)
-				RMLUI_ASSERTMSG(p_data[i + c] <= alpha, "Glyph data is assumed to be encoded in premultiplied alpha, but that is not the case.");
-#endif
-		}
-
-		if (!texture_interface.GenerateTexture({p_data, total_bytes}, render_dimensions))
-		{
-			Log::Message(Rml::Log::Type::LT_WARNING, "Could not generate texture for lottie animation: %s", GetAttribute<String>("src", "").c_str());
-			return false;
-		}
+	Rectanglef bounds;
+	if (!ElementUtilities::GetBoundingBox(bounds, this, BoxArea::Content))
 		return true;
-	};
 
-	texture = render_manager->MakeCallbackTexture(std::move(texture_callback));
+	Rectanglei visible_region = Rectanglei::FromSize(viewport);
+	if (clip_region.Valid())
+		visible_region = visible_region.Intersect(clip_region);
 
-	prev_animation_frame = next_frame;
-	texture_size_dirty = false;
+	return visible_region.Valid() && bounds.Intersects(Rectanglef(visible_region));
 }
 
 } // namespace Rml
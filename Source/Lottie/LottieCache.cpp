@@ -0,0 +1,177 @@
+#include "LottieCache.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/FileInterface.h"
+#include "../../Include/RmlUi/Core/Log.h"
+#include "../../Include/RmlUi/Core/RenderManager.h"
+#include "../Core/ControlledLifetimeResource.h"
+#include "LottieFrameRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <rlottie.h>
+
+namespace Rml {
+namespace Lottie {
+
+	struct LottieCacheData {
+		StableUnorderedMap<String, WeakPtr<LottieSource>> sources;
+	};
+
+	static ControlledLifetimeResource<LottieCacheData> lottie_cache_data;
+
+	LottieSource::LottieSource(const String& path, SharedPtr<rlottie::Animation> animation) : path(path), animation(std::move(animation)) {}
+
+	LottieSource::~LottieSource()
+	{
+		RMLUI_ASSERT(frames.empty());
+		if (lottie_cache_data)
+			lottie_cache_data->sources.erase(path);
+	}
+
+	size_t LottieSource::GetFrameAtTime(double t) const
+	{
+		// Find the normalized animation progress [0, 1].
+		// Here it is possible to add more logic to control playback speed, pause/resume, and more.
+		double _unused;
+		const double pos = std::modf((t - time_start) / animation->duration(), &_unused);
+		return animation->frameAtPos(pos);
+	}
+
+	LottieFrames::LottieFrames(SharedPtr<LottieSource> source, RenderManager* render_manager, Vector2i dimensions) :
+		source(std::move(source)), render_manager(render_manager), dimensions(dimensions)
+	{}
+
+	LottieFrames::~LottieFrames()
+	{
+		// A frame still being rendered in the background keeps its job alive, so the frames can be released right away.
+		auto& frames = source->frames;
+		frames.erase(std::remove_if(frames.begin(), frames.end(), [](const WeakPtr<LottieFrames>& entry) { return entry.expired(); }), frames.end());
+	}
+
+	void LottieFrames::Update(double t)
+	{
+		if (!frame_job)
+		{
+			frame_job = MakeShared<LottieFrameJob>();
+			frame_job->animation = source->animation;
+			frame_job->dimensions = dimensions;
+		}
+
+		const size_t current_frame = source->GetFrameAtTime(t);
+
+		if (displayed_frame == size_t(-1))
+		{
+			// There is no frame to display yet, so render the current frame right away.
+			frame_job->frame = current_frame;
+			LottieFrameRenderer::Render(*frame_job);
+			frame_job_submitted = true;
+		}
+
+		// Only display the finished frame once the displayed frame is out of date, so that all elements sharing the frames display the same
+		// frame during a render.
+		if (frame_job_submitted && current_frame != displayed_frame && frame_job->done.load(std::memory_order_acquire))
+		{
+			// Swap buffers with the job, the previous buffer is reused for rendering the following frame.
+			std::swap(texture_data, frame_job->pixels);
+			std::swap(texture_data_size, frame_job->pixels_size);
+			displayed_frame = frame_job->frame;
+			frame_job_submitted = false;
+
+			UploadTexture();
+		}
+
+		// Render the frame following the displayed one in the background, so that it is ready by the time it should be displayed.
+		if (!frame_job_submitted)
+		{
+			const size_t next_frame = source->GetFrameAtTime(t + 1.0 / source->animation->frameRate());
+			if (next_frame != displayed_frame)
+			{
+				frame_job->frame = next_frame;
+				LottieFrameRenderer::Submit(frame_job);
+				frame_job_submitted = true;
+			}
+		}
+	}
+
+	void LottieFrames::UploadTexture()
+	{
+		const size_t total_bytes = 4 * dimensions.x * dimensions.y;
+
+		// Replace the pixels of the existing texture when the render interface supports it, instead of generating a new texture every frame.
+		if (texture && texture.UpdateTexture(Rectanglei::FromSize(dimensions), {texture_data.get(), total_bytes}))
+			return;
+
+		// Callback for generating texture.
+		texture = render_manager->MakeCallbackTexture([this](const CallbackTextureInterface& texture_interface) -> bool {
+			const size_t total_bytes = 4 * dimensions.x * dimensions.y;
+			if (!texture_interface.GenerateTexture({texture_data.get(), total_bytes}, dimensions))
+			{
+				Log::Message(Rml::Log::Type::LT_WARNING, "Could not generate texture for lottie animation: %s", source->path.c_str());
+				return false;
+			}
+			return true;
+		});
+	}
+
+	void LottieCache::Initialize()
+	{
+		lottie_cache_data.Initialize();
+	}
+
+	void LottieCache::Shutdown()
+	{
+		lottie_cache_data.Shutdown();
+	}
+
+	SharedPtr<LottieSource> LottieCache::GetSource(const String& path, const String& directory)
+	{
+		auto it_source = lottie_cache_data->sources.find(path);
+		if (it_source != lottie_cache_data->sources.end())
+		{
+			SharedPtr<LottieSource> result = it_source->second.lock();
+			RMLUI_ASSERTMSG(result, "Failed to lock handle in Lottie cache");
+			return result;
+		}
+
+		String json_data;
+
+		if (path.empty() || !GetFileInterface()->LoadFile(path, json_data))
+		{
+			Log::Message(Rml::Log::Type::LT_WARNING, "Could not load lottie file %s", path.c_str());
+			return nullptr;
+		}
+
+		SharedPtr<rlottie::Animation> animation = rlottie::Animation::loadFromData(std::move(json_data), path, directory);
+
+		if (!animation)
+		{
+			Log::Message(Rml::Log::Type::LT_WARNING, "Could not construct the lottie animation %s", path.c_str());
+			return nullptr;
+		}
+
+		auto source = MakeShared<LottieSource>(path, std::move(animation));
+
+		size_t width = 0, height = 0;
+		source->animation->size(width, height);
+		source->intrinsic_dimensions = Vector2f(float(width), float(height));
+
+		lottie_cache_data->sources.emplace(path, source);
+		return source;
+	}
+
+	SharedPtr<LottieFrames> LottieCache::GetFrames(const SharedPtr<LottieSource>& source, RenderManager& render_manager, Vector2i dimensions)
+	{
+		for (const WeakPtr<LottieFrames>& entry : source->frames)
+		{
+			SharedPtr<LottieFrames> frames = entry.lock();
+			RMLUI_ASSERTMSG(frames, "Failed to lock handle in Lottie cache");
+			if (frames && frames->GetRenderManager() == &render_manager && frames->GetDimensions() == dimensions)
+				return frames;
+		}
+
+		auto frames = MakeShared<LottieFrames>(source, &render_manager, dimensions);
+		source->frames.push_back(frames);
+		return frames;
+	}
+
+} // namespace Lottie
+} // namespace Rml
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/CallbackTexture.h"
+#include "../../Include/RmlUi/Core/Texture.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace rlottie {
+class Animation;
+}
+
+namespace Rml {
+
+class RenderManager;
+
+namespace Lottie {
+
+	struct LottieFrameJob;
+	class LottieFrames;
+
+	/**
+	    A loaded animation, shared between all elements displaying the same source.
+	 */
+	struct LottieSource : NonCopyMoveable {
+		LottieSource(const String& path, SharedPtr<rlottie::Animation> animation);
+		~LottieSource();
+
+		/// Returns the animation frame to display at the given time.
+		size_t GetFrameAtTime(double t) const;
+
+		const String path;
+		const SharedPtr<rlottie::Animation> animation;
+		Vector2f intrinsic_dimensions;
+
+		// The absolute time when the animation was first displayed, all elements displaying the animation play it in sync.
+		double time_start = -1;
+
+		// The frames rendered from this animation, one entry for every render manager and size in use.
+		Vector<WeakPtr<LottieFrames>> frames;
+	};
+
+	/**
+	    The frames of an animation rendered to a texture at a given size, shared between all elements displaying them.
+
+	    The current frame is displayed while the following frame is rendered in the background, the two frame buffers are swapped once it is done.
+	 */
+	class LottieFrames : NonCopyMoveable {
+	public:
+		LottieFrames(SharedPtr<LottieSource> source, RenderManager* render_manager, Vector2i dimensions);
+		~LottieFrames();
+
+		/// Displays the frame rendered in the background once it is due, and starts rendering the following frame.
+		/// @param[in] t The current elapsed time.
+		/// @note Every element sharing the frames may call this during the same render, the texture is then updated only once.
+		void Update(double t);
+
+		Texture GetTexture() const { return texture; }
+		RenderManager* GetRenderManager() const { return render_manager; }
+		Vector2i GetDimensions() const { return dimensions; }
+
+	private:
+		// Uploads the displayed frame to the texture.
+		void UploadTexture();
+
+		const SharedPtr<LottieSource> source;
+		RenderManager* const render_manager;
+		const Vector2i dimensions;
+
+		CallbackTexture texture;
+		// The texture data of the displayed frame, swapped with the buffer of the frame job when it is done.
+		UniquePtr<byte[]> texture_data;
+		size_t texture_data_size = 0;
+		size_t displayed_frame = size_t(-1);
+
+		SharedPtr<LottieFrameJob> frame_job;
+		bool frame_job_submitted = false;
+	};
+
+	class LottieCache {
+	public:
+		static void Initialize();
+		static void Shutdown();
+
+		/// Returns the animation loaded from the given path, loading it unless it is already in use.
+		/// @param[in] path The path of the animation file.
+		/// @param[in] directory The directory used to resolve external resources of the animation.
+		/// @return A handle to the animation with automatic reference counting, or null if the animation could not be loaded.
+		static SharedPtr<LottieSource> GetSource(const String& path, const String& directory);
+
+		/// Returns the frames of the animation rendered at the given size, creating them unless they are already in use.
+		/// @param[in] source The animation to render.
+		/// @param[in] render_manager The render manager used to render the frames.
+		/// @param[in] dimensions The size to render the frames at, in pixels.
+		/// @return A handle to the frames, with automatic reference counting.
+		static SharedPtr<LottieFrames> GetFrames(const SharedPtr<LottieSource>& source, RenderManager& render_manager, Vector2i dimensions);
+	};
+
+} // namespace Lottie
+} // namespace Rml
@@ -0,0 +1,139 @@
+#include "LottieFrameRenderer.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/Log.h"
+#include "../Core/BackgroundTasks.h"
+#include "../Core/ControlledLifetimeResource.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <rlottie.h>
+#include <thread>
+
+namespace Rml {
+namespace Lottie {
+
+	class LottieFrameWorker : NonCopyMoveable {
+	public:
+		LottieFrameWorker() : thread(&LottieFrameWorker::Run, this) {}
+		~LottieFrameWorker()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stop = true;
+			}
+			condition.notify_one();
+			thread.join();
+		}
+
+		void Push(const SharedPtr<LottieFrameJob>& job)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				queue.push_back(job);
+			}
+			condition.notify_one();
+		}
+
+	private:
+		void Run()
+		{
+			while (true)
+			{
+				SharedPtr<LottieFrameJob> job;
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					condition.wait(lock, [this] { return stop || !queue.empty(); });
+					if (stop)
+						break;
+					job = std::move(queue.front());
+					queue.pop_front();
+				}
+
+				LottieFrameRenderer::Render(*job);
+			}
+
+			// Mark any remaining jobs as done, so that their owners don't wait for them.
+			for (const SharedPtr<LottieFrameJob>& job : queue)
+				job->done.store(true, std::memory_order_release);
+		}
+
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<SharedPtr<LottieFrameJob>> queue;
+		bool stop = false;
+
+		// Started last, after the other members are constructed.
+		std::thread thread;
+	};
+
+	static ControlledLifetimeResource<LottieFrameWorker> frame_worker;
+	static ControlledLifetimeResource<BackgroundTasks> frame_tasks;
+
+	void LottieFrameRenderer::Initialize()
+	{
+		// Unless background rendering is enabled, frames are rendered on the calling thread when submitted. Otherwise, they are rendered
+		// through the application's task interface when installed, or else on our own worker thread.
+		if (!BackgroundTasks::IsRenderingEnabled())
+			return;
+
+		if (GetTaskInterface())
+			frame_tasks.Initialize();
+		else
+			frame_worker.Initialize();
+	}
+
+	void LottieFrameRenderer::Shutdown()
+	{
+		if (frame_tasks)
+			frame_tasks.Shutdown();
+		if (frame_worker)
+			frame_worker.Shutdown();
+	}
+
+	void LottieFrameRenderer::Submit(const SharedPtr<LottieFrameJob>& job)
+	{
+		RMLUI_ASSERT(job && job->animation);
+		job->done.store(false, std::memory_order_relaxed);
+
+		if (frame_tasks && frame_tasks->Submit([job]() { Render(*job); }))
+			return;
+
+		if (frame_worker)
+			frame_worker->Push(job);
+		else
+			Render(*job);
+	}
+
+	void LottieFrameRenderer::Render(LottieFrameJob& job)
+	{
+		const size_t bytes_per_line = 4 * job.dimensions.x;
+		const size_t total_bytes = bytes_per_line * job.dimensions.y;
+
+		if (total_bytes > job.pixels_size)
+		{
+			job.pixels.reset(new byte[total_bytes]);
+			job.pixels_size = total_bytes;
+		}
+
+		byte* p_data = job.pixels.get();
+		rlottie::Surface surface(reinterpret_cast<uint32_t*>(p_data), job.dimensions.x, job.dimensions.y, bytes_per_line);
+		job.animation->renderSync(job.frame, surface);
+
+		// Swizzle the channel order from rlottie's BGRA to RmlUi's RGBA.
+		for (size_t i = 0; i < total_bytes; i += 4)
+		{
+			// Swap the RB order for correct color channels.
+			std::swap(p_data[i], p_data[i + 2]);
+
+#ifdef RMLUI_DEBUG
+			const byte alpha = p_data[i + 3];
+			for (int c = 0; c < 3; c++)
+				RMLUI_ASSERTMSG(p_data[i + c] <= alpha, "Glyph data is assumed to be encoded in premultiplied alpha, but that is not the case.");
+#endif
+		}
+
+		job.done.store(true, std::memory_order_release);
+	}
+
+} // namespace Lottie
+} // namespace Rml
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Types.h"
+#include <atomic>
+
+namespace rlottie {
+class Animation;
+}
+
+namespace Rml {
+namespace Lottie {
+
+	/**
+	    A single frame of an animation to be rendered into its own pixel buffer, possibly on a worker thread.
+
+	    The fields may only be changed while the job is done. The worker thread keeps the job and its animation alive until it is done.
+	 */
+	struct LottieFrameJob {
+		SharedPtr<rlottie::Animation> animation;
+		size_t frame = 0;
+		Vector2i dimensions;
+
+		// Texture data in 8-bit RGBA (premultiplied) format, resized as needed when rendering.
+		UniquePtr<byte[]> pixels;
+		size_t pixels_size = 0;
+
+		std::atomic<bool> done{true};
+	};
+
+	/**
+	    Renders the frames of lottie animations in the background when enabled, on a worker thread shared between all lottie elements, or
+	    through the task interface when installed by the application.
+	 */
+	class LottieFrameRenderer {
+	public:
+		static void Initialize();
+		static void Shutdown();
+
+		/// Queues the job to be rendered in the background, the job is marked as done afterward.
+		/// @note The job is rendered immediately on the calling thread unless background rendering is enabled.
+		static void Submit(const SharedPtr<LottieFrameJob>& job);
+
+		/// Renders the job on the calling thread, and marks it as done.
+		static void Render(LottieFrameJob& job);
+
+	private:
+		LottieFrameRenderer() = delete;
+	};
+
+} // namespace Lottie
+} // namespace Rml
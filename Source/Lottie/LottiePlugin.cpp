@@ -4,6 +4,8 @@
 #include "../../Include/RmlUi/Core/Log.h"
 #include "../../Include/RmlUi/Core/Plugin.h"
 #include "../../Include/RmlUi/Lottie/ElementLottie.h"
+#include "LottieCache.h"
+#include "LottieFrameRenderer.h"
 
 namespace Rml {
 namespace Lottie {
@@ -12,6 +14,9 @@ namespace Lottie {
 	public:
 		void OnInitialise() override
 		{
+			LottieCache::Initialize();
+			LottieFrameRenderer::Initialize();
+
 			instancer = MakeUnique<ElementInstancerGeneric<ElementLottie>>();
 
 			Factory::RegisterElementInstancer("lottie", instancer.get());
@@ -19,7 +24,12 @@ namespace Lottie {
 			Log::Message(Log::LT_INFO, "Lottie plugin initialised.");
 		}
 
-		void OnShutdown() override { delete this; }
+		void OnShutdown() override
+		{
+			LottieFrameRenderer::Shutdown();
+			LottieCache::Shutdown();
+			delete this;
+		}
 
 		int GetEventClasses() override { return Plugin::EVT_BASIC; }
 
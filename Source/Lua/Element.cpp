@@ -9,6 +9,20 @@ namespace Rml {
 namespace Lua {
 typedef ElementDocument Document;
 
+// Pushes the proxy of the given type for the element. The proxy is reused for as long as it is referenced from Lua, instead of allocating
+// a new one on every access.
+template <typename Proxy>
+static void PushElementProxy(lua_State* L, Element* element)
+{
+	if (LuaTypeImpl::pushcached(L, GetTClassName<Proxy>(), element))
+		return;
+
+	Proxy* proxy = new Proxy();
+	proxy->owner = element;
+	LuaType<Proxy>::push(L, proxy, true);
+	LuaTypeImpl::cache(L, GetTClassName<Proxy>(), element);
+}
+
 template <>
 void ExtraInit<Element>(lua_State* L, int metatable_index)
 {
@@ -269,6 +283,32 @@ int ElementSetAttribute(lua_State* L, Element* obj)
 	return 0;
 }
 
+int ElementSetAttributes(lua_State* L, Element* obj)
+{
+	// Sets every attribute in the table, or removes it when set to false.
+	luaL_checktype(L, 1, LUA_TTABLE);
+	lua_pushnil(L);
+	while (lua_next(L, 1) != 0)
+	{
+		// [2] = key, [3] = value
+		luaL_argcheck(L, lua_type(L, 2) == LUA_TSTRING, 1, "attribute names must be strings");
+		size_t name_length = 0;
+		const char* name = lua_tolstring(L, 2, &name_length);
+		if (lua_type(L, 3) == LUA_TBOOLEAN && !lua_toboolean(L, 3))
+		{
+			obj->RemoveAttribute(String(name, name_length));
+		}
+		else
+		{
+			size_t value_length = 0;
+			const char* value = luaL_checklstring(L, 3, &value_length);
+			obj->SetAttribute(String(name, name_length), String(value, value_length));
+		}
+		lua_pop(L, 1);
+	}
+	return 0;
+}
+
 int ElementSetClass(lua_State* L, Element* obj)
 {
 	const char* name = luaL_checkstring(L, 1);
@@ -277,14 +317,40 @@ int ElementSetClass(lua_State* L, Element* obj)
 	return 0;
 }
 
+int ElementSetProperties(lua_State* L, Element* obj)
+{
+	// Sets every property in the table, or removes it when set to false. Returns true if all the properties were set successfully.
+	luaL_checktype(L, 1, LUA_TTABLE);
+	bool result = true;
+	lua_pushnil(L);
+	while (lua_next(L, 1) != 0)
+	{
+		// [2] = key, [3] = value
+		luaL_argcheck(L, lua_type(L, 2) == LUA_TSTRING, 1, "property names must be strings");
+		size_t name_length = 0;
+		const char* name = lua_tolstring(L, 2, &name_length);
+		if (lua_type(L, 3) == LUA_TBOOLEAN && !lua_toboolean(L, 3))
+		{
+			obj->RemoveProperty(String(name, name_length));
+		}
+		else
+		{
+			size_t value_length = 0;
+			const char* value = luaL_checklstring(L, 3, &value_length);
+			result &= obj->SetProperty(String(name, name_length), String(value, value_length));
+		}
+		lua_pop(L, 1);
+	}
+	lua_pushboolean(L, result);
+	return 1;
+}
+
 // getters
 int ElementGetAttrattributes(lua_State* L)
 {
 	Element* ele = LuaType<Element>::check(L, 1);
 	RMLUI_CHECK_OBJ(ele);
-	ElementAttributesProxy* proxy = new ElementAttributesProxy();
-	proxy->owner = ele;
-	LuaType<ElementAttributesProxy>::push(L, proxy, true);
+	PushElementProxy<ElementAttributesProxy>(L, ele);
 	return 1;
 }
 
@@ -292,9 +358,7 @@ int ElementGetAttrchild_nodes(lua_State* L)
 {
 	Element* ele = LuaType<Element>::check(L, 1);
 	RMLUI_CHECK_OBJ(ele);
-	ElementChildNodesProxy* ecnp = new ElementChildNodesProxy();
-	ecnp->owner = ele;
-	LuaType<ElementChildNodesProxy>::push(L, ecnp, true);
+	PushElementProxy<ElementChildNodesProxy>(L, ele);
 	return 1;
 }
 
@@ -501,9 +565,7 @@ int ElementGetAttrstyle(lua_State* L)
 {
 	Element* ele = LuaType<Element>::check(L, 1);
 	RMLUI_CHECK_OBJ(ele);
-	ElementStyleProxy* prox = new ElementStyleProxy();
-	prox->owner = ele;
-	LuaType<ElementStyleProxy>::push(L, prox, true);
+	PushElementProxy<ElementStyleProxy>(L, ele);
 	return 1;
 }
 
@@ -583,7 +645,9 @@ RegType<Element> ElementMethods[] = {
 	RMLUI_LUAMETHOD(Element, ReplaceChild),
 	RMLUI_LUAMETHOD(Element, ScrollIntoView),
 	RMLUI_LUAMETHOD(Element, SetAttribute),
+	RMLUI_LUAMETHOD(Element, SetAttributes),
 	RMLUI_LUAMETHOD(Element, SetClass),
+	RMLUI_LUAMETHOD(Element, SetProperties),
 	{nullptr, nullptr},
 };
 
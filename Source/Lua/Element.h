@@ -32,7 +32,9 @@ int ElementRemoveChild(lua_State* L, Element* obj);
 int ElementReplaceChild(lua_State* L, Element* obj);
 int ElementScrollIntoView(lua_State* L, Element* obj);
 int ElementSetAttribute(lua_State* L, Element* obj);
+int ElementSetAttributes(lua_State* L, Element* obj);
 int ElementSetClass(lua_State* L, Element* obj);
+int ElementSetProperties(lua_State* L, Element* obj);
 
 // getters
 int ElementGetAttrattributes(lua_State* L);
@@ -29,9 +29,12 @@ int ElementStyleProxy__index(lua_State* L)
 	{
 		ElementStyleProxy* es = LuaType<ElementStyleProxy>::check(L, 1);
 		RMLUI_CHECK_OBJ(es);
-		const Property* prop = es->owner->GetProperty(lua_tostring(L, 2));
+		size_t key_length = 0;
+		const char* key = lua_tolstring(L, 2, &key_length);
+		const Property* prop = es->owner->GetProperty(String(key, key_length));
 		RMLUI_CHECK_OBJ(prop)
-		lua_pushstring(L, prop->ToString().c_str());
+		const String value = prop->ToString();
+		lua_pushlstring(L, value.c_str(), value.size());
 		return 1;
 	}
 	else // if it wasn't trying to get a string
@@ -50,16 +53,18 @@ int ElementStyleProxy__newindex(lua_State* L)
 	int valuetype = lua_type(L, 3);
 	if (keytype == LUA_TSTRING)
 	{
-		const char* key = lua_tostring(L, 2);
+		size_t key_length = 0;
+		const char* key = lua_tolstring(L, 2, &key_length);
 		if (valuetype == LUA_TSTRING)
 		{
-			const char* value = lua_tostring(L, 3);
-			lua_pushboolean(L, es->owner->SetProperty(key, value));
+			size_t value_length = 0;
+			const char* value = lua_tolstring(L, 3, &value_length);
+			lua_pushboolean(L, es->owner->SetProperty(String(key, key_length), String(value, value_length)));
 			return 1;
 		}
 		else if (valuetype == LUA_TNIL)
 		{
-			es->owner->RemoveProperty(key);
+			es->owner->RemoveProperty(String(key, key_length));
 			return 0;
 		}
 	}
@@ -3,9 +3,14 @@
 #include <RmlUi/Core/DataModelHandle.h>
 #include <RmlUi/Core/DataVariable.h>
 #include <RmlUi/Lua/Utilities.h>
+#include <string.h>
 
 #define RMLDATAMODEL "RMLDATAMODEL"
 
+#if LUA_VERSION_NUM < 502
+	#define lua_rawlen lua_objlen
+#endif
+
 namespace Rml {
 namespace Lua {
 
@@ -99,6 +104,9 @@ struct LuaDataModel {
 	int top;
 };
 
+// Variables are represented by their index on the stack of the data thread. Top-level variables are stored at fixed indices, while
+// children are pushed above them on lookup, as the triple [index of the parent table, key, value], with the index of the value identifying
+// the child. Plain tables are accessed directly, only tables with a metatable are accessed through protected calls.
 class LuaTableDef : public VariableDefinition {
 public:
 	LuaTableDef(const struct LuaDataModel* model);
@@ -107,16 +115,32 @@ public:
 	int Size(void* ptr) override;
 	DataVariable Child(void* ptr, const DataAddressEntry& address) override;
 
+	// Clears the cached table lengths, to be called whenever the tables may have changed.
+	void ClearLengthCache() { length_cache.clear(); }
+
 protected:
 	const struct LuaDataModel* model;
+
+private:
+	// The lengths of the tables by their address, cached until the model is dirtied or set through a data binding.
+	UnorderedMap<const void*, int> length_cache;
 };
 
 class LuaScalarDef final : public LuaTableDef {
 public:
 	LuaScalarDef(const struct LuaDataModel* model);
+	bool Set(void* ptr, const Variant& variant) override;
 	DataVariable Child(void* ptr, const DataAddressEntry& address) override;
 };
 
+static void ClearLengthCaches(const struct LuaDataModel* D)
+{
+	if (D->scalarDef)
+		D->scalarDef->ClearLengthCache();
+	if (D->tableDef)
+		D->tableDef->ClearLengthCache();
+}
+
 LuaTableDef::LuaTableDef(const struct LuaDataModel* model) : VariableDefinition(DataVariableType::Scalar), model(model) {}
 
 bool LuaTableDef::Get(void* ptr, Variant& variant)
@@ -129,14 +153,42 @@ bool LuaTableDef::Get(void* ptr, Variant& variant)
 	return true;
 }
 
+static int lLuaTableDefSetChild(lua_State* L)
+{
+	lua_settable(L, 1);
+	return 0;
+}
+
 bool LuaTableDef::Set(void* ptr, const Variant& variant)
 {
 	int id = (int)(intptr_t)ptr;
 	lua_State* L = model->dataL;
-	if (!L)
+	if (!L || !lua_checkstack(L, 4))
 		return false;
+
+	ClearLengthCaches(model);
+
+	// Write the value to the parent table, and update the value on the stack in case it is read again.
+	const int parent = (int)lua_tointeger(L, id - 2);
 	PushVariant(L, &variant);
+	lua_pushvalue(L, -1);
 	lua_replace(L, id);
+
+	if (lua_getmetatable(L, parent))
+	{
+		lua_pop(L, 1);
+		lua_pushcfunction(L, lLuaTableDefSetChild);
+		lua_pushvalue(L, parent);
+		lua_pushvalue(L, id - 1);
+		lua_pushvalue(L, -4);
+		const bool result = (lua_pcall(L, 3, 0, 0) == LUA_OK);
+		lua_pop(L, result ? 1 : 2);
+		return result;
+	}
+
+	lua_pushvalue(L, id - 1);
+	lua_insert(L, -2);
+	lua_rawset(L, parent);
 	return true;
 }
 
@@ -166,15 +218,33 @@ int LuaTableDef::Size(void* ptr)
 	{
 		return 0;
 	}
-	lua_pushcfunction(L, lLuaTableDefSize);
-	lua_pushvalue(L, id);
-	if (LUA_OK != lua_pcall(L, 1, 1, 0))
+
+	const void* table = lua_topointer(L, id);
+	auto it = length_cache.find(table);
+	if (it != length_cache.end())
+		return it->second;
+
+	int size = 0;
+	if (lua_getmetatable(L, id))
 	{
+		// The table may define __len, find its length in protected mode.
+		lua_pop(L, 1);
+		lua_pushcfunction(L, lLuaTableDefSize);
+		lua_pushvalue(L, id);
+		if (LUA_OK != lua_pcall(L, 1, 1, 0))
+		{
+			lua_pop(L, 1);
+			return 0;
+		}
+		size = (int)lua_tointeger(L, -1);
 		lua_pop(L, 1);
-		return 0;
 	}
-	int size = (int)lua_tointeger(L, -1);
-	lua_pop(L, 1);
+	else
+	{
+		size = (int)lua_rawlen(L, id);
+	}
+
+	length_cache[table] = size;
 	return size;
 }
 
@@ -188,12 +258,12 @@ DataVariable LuaTableDef::Child(void* ptr, const DataAddressEntry& address)
 	{
 		return DataVariable{};
 	}
-	if (!lua_checkstack(L, 4))
+	if (!lua_checkstack(L, 6))
 	{
 		return DataVariable{};
 	}
-	lua_pushcfunction(L, lLuaTableDefChild);
-	lua_pushvalue(L, id);
+
+	lua_pushinteger(L, id);
 	if (address.index == -1)
 	{
 		lua_pushlstring(L, address.name.data(), address.name.size());
@@ -202,16 +272,43 @@ DataVariable LuaTableDef::Child(void* ptr, const DataAddressEntry& address)
 	{
 		lua_pushinteger(L, (lua_Integer)address.index + 1);
 	}
-	if (LUA_OK != lua_pcall(L, 2, 1, 0))
+
+	if (lua_getmetatable(L, id))
 	{
+		// The table may define __index, look up the value in protected mode.
 		lua_pop(L, 1);
-		return DataVariable{};
+		lua_pushcfunction(L, lLuaTableDefChild);
+		lua_pushvalue(L, id);
+		lua_pushvalue(L, -3);
+		if (LUA_OK != lua_pcall(L, 2, 1, 0))
+		{
+			lua_pop(L, 3);
+			return DataVariable{};
+		}
+	}
+	else
+	{
+		lua_pushvalue(L, -1);
+		lua_rawget(L, id);
 	}
 	return DataVariable(model->tableDef, (void*)(intptr_t)lua_gettop(L));
 }
 
 LuaScalarDef::LuaScalarDef(const struct LuaDataModel* model) : LuaTableDef(model) {}
 
+bool LuaScalarDef::Set(void* ptr, const Variant& variant)
+{
+	// Top-level variables are stored directly on the stack.
+	int id = (int)(intptr_t)ptr;
+	lua_State* L = model->dataL;
+	if (!L)
+		return false;
+	ClearLengthCaches(model);
+	PushVariant(L, &variant);
+	lua_replace(L, id);
+	return true;
+}
+
 DataVariable LuaScalarDef::Child(void* ptr, const DataAddressEntry& address)
 {
 	lua_State* L = model->dataL;
@@ -261,21 +358,34 @@ static void BindVariable(struct LuaDataModel* D, lua_State* L)
 	}
 }
 
+// Returns the stack index of the variable named by the key at [2], or zero if there is no such variable.
 static int getId(lua_State* L, lua_State* dataL)
 {
 	lua_pushvalue(dataL, 1);
 	lua_xmove(dataL, L, 1);
 	lua_pushvalue(L, 2);
 	lua_rawget(L, -2);
-	if (lua_type(L, -1) != LUA_TNUMBER)
-	{
-		luaL_error(L, "DataModel has no key : %s", lua_tostring(L, 2));
-	}
-	int id = (int)lua_tointeger(L, -1);
+	int id = (lua_type(L, -1) == LUA_TNUMBER ? (int)lua_tointeger(L, -1) : 0);
 	lua_pop(L, 2);
 	return id;
 }
 
+// model:DirtyVariable(name [, index])
+// Dirties the variable, or only the element at the given index of an array variable. Call this after modifying a table bound to the model.
+static int lDataModelDirtyVariable(lua_State* L)
+{
+	struct LuaDataModel* D = (struct LuaDataModel*)luaL_checkudata(L, 1, RMLDATAMODEL);
+	if (D->dataL == nullptr)
+		luaL_error(L, "DataModel closed");
+	const String name = luaL_checkstring(L, 2);
+	ClearLengthCaches(D);
+	if (lua_isnoneornil(L, 3))
+		D->handle.DirtyVariable(name);
+	else
+		D->handle.DirtyVariable(name, GetIndex(L, 3));
+	return 0;
+}
+
 static int lDataModelGet(lua_State* L)
 {
 	struct LuaDataModel* D = (struct LuaDataModel*)lua_touserdata(L, 1);
@@ -283,6 +393,17 @@ static int lDataModelGet(lua_State* L)
 	if (dataL == nullptr)
 		luaL_error(L, "DataModel closed");
 	int id = getId(L, dataL);
+	if (id == 0)
+	{
+		const char* key = lua_tostring(L, 2);
+		// Variables take precedence over the methods of the model.
+		if (key && strcmp(key, "DirtyVariable") == 0)
+		{
+			lua_pushcfunction(L, lDataModelDirtyVariable);
+			return 1;
+		}
+		luaL_error(L, "DataModel has no key : %s", key);
+	}
 	lua_pushvalue(dataL, id);
 	lua_xmove(dataL, L, 1);
 	return 1;
@@ -305,6 +426,7 @@ static int lDataModelSet(lua_State* L)
 		lua_pop(dataL, 1);
 		lua_xmove(L, dataL, 1);
 		lua_replace(dataL, id);
+		ClearLengthCaches(D);
 		D->handle.DirtyVariable(lua_tostring(L, 2));
 		return 0;
 	}
@@ -8,6 +8,16 @@ namespace Rml {
 namespace Lua {
 typedef ElementDocument Document;
 
+namespace {
+	// Functions compiled from inline code, such as 'onclick' attributes, by their owner document and source. The function only depends on the
+	// code, since the event, element, and document are passed as arguments, thus listeners of e.g. 'data-for' rows can share it.
+	struct CompiledFunction {
+		int ref;
+		int num_listeners;
+	};
+	UnorderedMap<const ElementDocument*, UnorderedMap<String, CompiledFunction>> compiled_functions;
+} // namespace
+
 LuaEventListener::LuaEventListener(const String& code, Element* element) : EventListener()
 {
 	// compose function
@@ -15,6 +25,25 @@ LuaEventListener::LuaEventListener(const String& code, Element* element) : Event
 	function.append(code);
 	function.append(" end");
 
+	attached = element;
+	owner_document = (element ? element->GetOwnerDocument() : nullptr);
+	strFunc = function;
+
+	// Reuse the function if it has already been compiled for the document.
+	auto it_document = compiled_functions.find(owner_document);
+	if (it_document != compiled_functions.end())
+	{
+		auto it_function = it_document->second.find(function);
+		if (it_function != it_document->second.end())
+		{
+			it_function->second.num_listeners += 1;
+			luaFuncRef = it_function->second.ref;
+			compiled_function_shared = true;
+			compiled_function_document = owner_document;
+			return;
+		}
+	}
+
 	// make sure there is an area to save the function
 	lua_State* L = Interpreter::GetLuaState();
 	int top = lua_gettop(L);
@@ -37,12 +66,9 @@ LuaEventListener::LuaEventListener(const String& code, Element* element) : Event
 	luaFuncRef = luaL_ref(L, tbl); // creates a reference to the item at the top of the stack in to the table we just created
 	lua_pop(L, 1);                 // pop the EVENTLISTENERFUNCTIONS table
 
-	attached = element;
-	if (element)
-		owner_document = element->GetOwnerDocument();
-	else
-		owner_document = nullptr;
-	strFunc = function;
+	compiled_functions[owner_document][function] = CompiledFunction{luaFuncRef, 1};
+	compiled_function_shared = true;
+	compiled_function_document = owner_document;
 	lua_settop(L, top);
 }
 
@@ -72,6 +98,12 @@ LuaEventListener::LuaEventListener(lua_State* L, int narg, Element* element)
 
 LuaEventListener::~LuaEventListener()
 {
+	if (compiled_function_shared)
+	{
+		ReleaseCompiledFunction();
+		return;
+	}
+
 	// Remove the Lua function from its table
 	lua_State* L = Interpreter::GetLuaState();
 	lua_getglobal(L, "EVENTLISTENERFUNCTIONS");
@@ -79,6 +111,31 @@ LuaEventListener::~LuaEventListener()
 	lua_pop(L, 1); // pop table
 }
 
+void LuaEventListener::ReleaseCompiledFunction()
+{
+	auto it_document = compiled_functions.find(compiled_function_document);
+	if (it_document == compiled_functions.end())
+		return;
+
+	UnorderedMap<String, CompiledFunction>& functions = it_document->second;
+	auto it_function = functions.find(strFunc);
+	if (it_function == functions.end())
+		return;
+
+	it_function->second.num_listeners -= 1;
+	if (it_function->second.num_listeners > 0)
+		return;
+
+	lua_State* L = Interpreter::GetLuaState();
+	lua_getglobal(L, "EVENTLISTENERFUNCTIONS");
+	luaL_unref(L, -1, luaFuncRef);
+	lua_pop(L, 1); // pop table
+
+	functions.erase(it_function);
+	if (functions.empty())
+		compiled_functions.erase(it_document);
+}
+
 void LuaEventListener::OnDetach(Element* /*element*/)
 {
 	// We consider this listener owned by its element, so we must delete ourselves when
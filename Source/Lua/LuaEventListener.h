@@ -30,8 +30,14 @@ public:
 	void ProcessEvent(Event& event) override;
 
 private:
+	// Releases our use of a function compiled from inline code, shared by all listeners with the same code in the same document.
+	void ReleaseCompiledFunction();
+
 	// the lua-side function to call when ProcessEvent is called
 	int luaFuncRef = -1;
+	// True if the function is shared through the cache of compiled functions, keyed by the source and the document at construction.
+	bool compiled_function_shared = false;
+	ElementDocument* compiled_function_document = nullptr;
 
 	Element* attached = nullptr;
 	ElementDocument* owner_document = nullptr;
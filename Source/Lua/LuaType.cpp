@@ -86,5 +86,56 @@ int LuaTypeImpl::newindex(lua_State* L, const char* class_name)
 	return 0;
 }
 
+// Pushes the table of cached userdata for the class, creating it if necessary. The table is stored in the registry with weak values.
+static void PushUserdataCache(lua_State* L, const char* class_name)
+{
+	lua_getfield(L, LUA_REGISTRYINDEX, "RmlUi::Lua::UserdataCache"); //[1] = table of caches by class name
+	if (!lua_istable(L, -1))
+	{
+		lua_pop(L, 1);
+		lua_newtable(L);
+		lua_pushvalue(L, -1);
+		lua_setfield(L, LUA_REGISTRYINDEX, "RmlUi::Lua::UserdataCache");
+	}
+
+	lua_getfield(L, -1, class_name); //[2] = cache of the class
+	if (!lua_istable(L, -1))
+	{
+		lua_pop(L, 1);
+		lua_newtable(L);                //[2] = new cache
+		lua_newtable(L);                //[3] = metatable of the cache
+		lua_pushstring(L, "v");
+		lua_setfield(L, -2, "__mode");  // weak values
+		lua_setmetatable(L, -2);        // pop [3]
+		lua_pushvalue(L, -1);
+		lua_setfield(L, -3, class_name);
+	}
+
+	lua_remove(L, -2); // remove [1], leaving the cache at the top
+}
+
+bool LuaTypeImpl::pushcached(lua_State* L, const char* class_name, void* key)
+{
+	PushUserdataCache(L, class_name); //[1] = cache
+	lua_pushlightuserdata(L, key);
+	lua_rawget(L, -2);                //[2] = cache[key]
+	lua_remove(L, -2);                // remove [1]
+	if (lua_isuserdata(L, -1))
+		return true;
+
+	lua_pop(L, 1);
+	return false;
+}
+
+void LuaTypeImpl::cache(lua_State* L, const char* class_name, void* key)
+{
+	const int userdata = lua_gettop(L);
+	PushUserdataCache(L, class_name);
+	lua_pushlightuserdata(L, key);
+	lua_pushvalue(L, userdata);
+	lua_rawset(L, -3); // cache[key] = userdata
+	lua_pop(L, 1);
+}
+
 } // namespace Lua
 } // namespace Rml
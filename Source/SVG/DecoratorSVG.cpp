@@ -8,7 +8,8 @@
 namespace Rml {
 namespace SVG {
 
-	DecoratorSVG::DecoratorSVG(const String& source, const bool crop_to_content) : source_path(source), crop_to_content(crop_to_content)
+	DecoratorSVG::DecoratorSVG(const String& source, const bool crop_to_content, const bool vector) :
+		source_path(source), crop_to_content(crop_to_content), vector(vector)
 	{
 		RMLUI_ASSERT(!source_path.empty());
 	}
@@ -17,7 +18,8 @@ namespace SVG {
 
 	DecoratorDataHandle DecoratorSVG::GenerateElementData(Element* element, BoxArea paint_area) const
 	{
-		SharedPtr<SVGData> handle = SVGCache::GetHandle(source_path, source_path, SVGCache::File, element, crop_to_content, paint_area);
+		SharedPtr<SVGData> handle = SVGCache::GetHandle(source_path, source_path, SVGCache::File, element, crop_to_content, paint_area,
+			vector ? SVGCache::RenderMode::Vector : SVGCache::RenderMode::Raster);
 		if (!handle)
 			return {};
 
@@ -39,14 +41,15 @@ namespace SVG {
 	{
 		Data* data = reinterpret_cast<Data*>(element_data);
 		RMLUI_ASSERT(data && data->handle);
-		data->handle->geometry.Render(element->GetAbsoluteOffset(data->paint_area), data->handle->texture);
+		data->handle->Render(element, element->GetAbsoluteOffset(data->paint_area));
 	}
 
 	DecoratorSVGInstancer::DecoratorSVGInstancer()
 	{
 		source_id = RegisterProperty("source", "").AddParser("string").GetId();
 		crop_id = RegisterProperty("crop", "crop-none").AddParser("keyword", "crop-none, crop-to-content").GetId();
-		RegisterShorthand("decorator", "source, crop", ShorthandType::FallThrough);
+		render_mode_id = RegisterProperty("render-mode", "raster").AddParser("keyword", "raster, vector").GetId();
+		RegisterShorthand("decorator", "source, crop, render-mode", ShorthandType::FallThrough);
 	}
 
 	DecoratorSVGInstancer::~DecoratorSVGInstancer() {}
@@ -59,8 +62,9 @@ namespace SVG {
 			return nullptr;
 
 		const bool crop_to_content = properties.GetProperty(crop_id)->Get<int>() != 0;
+		const bool vector = properties.GetProperty(render_mode_id)->Get<int>() != 0;
 
-		return MakeShared<DecoratorSVG>(source, crop_to_content);
+		return MakeShared<DecoratorSVG>(source, crop_to_content, vector);
 	}
 
 } // namespace SVG
@@ -9,7 +9,7 @@ namespace SVG {
 
 	class DecoratorSVG : public Decorator {
 	public:
-		DecoratorSVG(const String& source, const bool crop_to_content);
+		DecoratorSVG(const String& source, const bool crop_to_content, const bool vector);
 		virtual ~DecoratorSVG();
 
 		DecoratorDataHandle GenerateElementData(Element* element, BoxArea paint_area) const override;
@@ -25,6 +25,7 @@ namespace SVG {
 
 		String source_path;
 		bool crop_to_content;
+		bool vector;
 	};
 
 	class DecoratorSVGInstancer : public DecoratorInstancer {
@@ -37,6 +38,7 @@ namespace SVG {
 	private:
 		PropertyId source_id;
 		PropertyId crop_id;
+		PropertyId render_mode_id;
 	};
 
 } // namespace SVG
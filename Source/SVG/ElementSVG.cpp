@@ -41,7 +41,7 @@ void ElementSVG::OnRender()
 {
 	EnsureSourceLoaded();
 	if (handle)
-		handle->geometry.Render(GetAbsoluteOffset(BoxArea::Content), handle->texture);
+		handle->Render(this, GetAbsoluteOffset(BoxArea::Content));
 }
 
 void ElementSVG::OnResize()
@@ -53,7 +53,7 @@ void ElementSVG::OnAttributeChange(const ElementAttributes& changed_attributes)
 {
 	Element::OnAttributeChange(changed_attributes);
 
-	if (changed_attributes.count("src") || changed_attributes.count("crop-to-content"))
+	if (changed_attributes.count("src") || changed_attributes.count("crop-to-content") || changed_attributes.count("render-mode"))
 	{
 		svg_dirty = true;
 		DirtyLayout();
@@ -110,13 +110,11 @@ void ElementSVG::EnsureSourceLoaded()
 	svg_dirty = false;
 
 	const bool crop_to_content = HasAttribute("crop-to-content");
+	const auto render_mode =
+		(GetAttribute<String>("render-mode", "") == "vector" ? SVG::SVGCache::RenderMode::Vector : SVG::SVGCache::RenderMode::Raster);
 	const auto source = GetAttribute<String>("src", "");
 	if (source.empty())
 	{
-		const auto source_id = GetAttribute<String>("rmlui-svgdata-id", "svgdata:undefined");
-		if (handle)
-			handle.reset(); // The old handle won't be re-used so clear it.
-
 		// Build an svg wrapper tag, copying all but src attribute (expected attributes could be width, height, viewBox, etc.)
 		String svg_element_source = "<svg ";
 		ElementAttributes attrs = GetAttributes();
@@ -133,11 +131,16 @@ void ElementSVG::EnsureSourceLoaded()
 		svg_element_source.append(svg_data);
 		svg_element_source.append("</svg>");
 
-		handle = SVG::SVGCache::GetHandle(source_id, svg_element_source, SVG::SVGCache::Data, this, crop_to_content, BoxArea::Content);
+		// Include a hash of the source in its key, as the cache may keep textures of previous contents for reuse.
+		const String source_id = GetAttribute<String>("rmlui-svgdata-id", "svgdata:undefined") +
+			CreateString(":%zx", Hash<String>()(svg_element_source));
+
+		handle =
+			SVG::SVGCache::GetHandle(source_id, svg_element_source, SVG::SVGCache::Data, this, crop_to_content, BoxArea::Content, render_mode);
 	}
 	else
 	{
-		handle = SVG::SVGCache::GetHandle(source, source, SVG::SVGCache::File, this, crop_to_content, BoxArea::Content);
+		handle = SVG::SVGCache::GetHandle(source, source, SVG::SVGCache::File, this, crop_to_content, BoxArea::Content, render_mode);
 	}
 }
 } // namespace Rml
@@ -1,19 +1,29 @@
 #include "SVGCache.h"
 #include "../../Include/RmlUi/Core/CallbackTexture.h"
 #include "../../Include/RmlUi/Core/ComputedValues.h"
+#include "../../Include/RmlUi/Core/Context.h"
 #include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/Element.h"
 #include "../../Include/RmlUi/Core/ElementDocument.h"
+#include "../../Include/RmlUi/Core/ElementUtilities.h"
 #include "../../Include/RmlUi/Core/FileInterface.h"
 #include "../../Include/RmlUi/Core/Geometry.h"
+#include "../../Include/RmlUi/Core/Mesh.h"
 #include "../../Include/RmlUi/Core/MeshUtilities.h"
 #include "../../Include/RmlUi/Core/RenderManager.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
 #include "../../Include/RmlUi/Core/Texture.h"
 #include "../../Include/RmlUi/Core/Utilities.h"
+#include "../Core/BackgroundTasks.h"
 #include "../Core/ControlledLifetimeResource.h"
+#include "SVGTessellator.h"
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <lunasvg.h>
+#include <mutex>
+#include <thread>
 
 #ifdef RMLUI_SVG_DEBUG
 	#define RMLUI_SVG_DEBUG_LOG(...) Rml::Log::Message(Rml::Log::LT_DEBUG, __VA_ARGS__)
@@ -24,15 +34,17 @@
 namespace Rml {
 namespace SVG {
 	struct SVGKey {
+		RenderManager* render_manager;
 		String source_id;
 		Vector2i dimensions;
 		bool crop_to_content;
 		ColourbPremultiplied colour;
+		bool vector;
 
 		friend bool operator==(const SVGKey& lhs, const SVGKey& rhs)
 		{
-			return lhs.source_id == rhs.source_id && lhs.dimensions == rhs.dimensions && lhs.crop_to_content == rhs.crop_to_content &&
-				lhs.colour == rhs.colour;
+			return lhs.render_manager == rhs.render_manager && lhs.source_id == rhs.source_id && lhs.dimensions == rhs.dimensions &&
+				lhs.crop_to_content == rhs.crop_to_content && lhs.colour == rhs.colour && lhs.vector == rhs.vector;
 		}
 	};
 } // namespace SVG
@@ -44,12 +56,14 @@ struct hash<::Rml::SVG::SVGKey> {
 	size_t operator()(const ::Rml::SVG::SVGKey& key) const noexcept
 	{
 		size_t hash = 0;
+		Rml::Utilities::HashCombine(hash, key.render_manager);
 		Rml::Utilities::HashCombine(hash, key.source_id);
 		Rml::Utilities::HashCombine(hash, key.dimensions.x);
 		Rml::Utilities::HashCombine(hash, key.dimensions.y);
 		Rml::Utilities::HashCombine(hash, key.crop_to_content);
 		static_assert(sizeof(uint32_t) == sizeof(key.colour), "Expecting color to be 4 bytes");
 		Rml::Utilities::HashCombine(hash, *reinterpret_cast<const uint32_t*>(&key.colour[0]));
+		Rml::Utilities::HashCombine(hash, key.vector);
 		return hash;
 	}
 };
@@ -59,27 +73,174 @@ namespace Rml {
 namespace SVG {
 
 	static SharedPtr<SVGData> GetHandle(RenderManager& render_manager, String source_id, const String& source, SVGCache::SourceType source_type,
-		Vector2i dimensions, bool crop_to_content, ColourbPremultiplied colour);
+		Vector2i dimensions, bool crop_to_content, ColourbPremultiplied colour, bool vector);
 	static void ReleaseHandle(SVGData* handle);
 
+	// Textures without any users are kept up to this total size [bytes], so that they can be reused when the SVG is shown at the same size
+	// again. The least recently used textures are released first.
+	static constexpr size_t unused_texture_budget = 16 * 1024 * 1024;
+
+	// A loaded SVG document, shared with the rasterization jobs. Once shared, the document is only accessed while holding its mutex.
+	struct SVGSource : NonCopyMoveable {
+		UniquePtr<lunasvg::Document> svg_document;
+		std::mutex mutex;
+	};
+
+	struct SVGRasterJob : NonCopyMoveable {
+		SharedPtr<SVGSource> source;
+		Vector2i dimensions;
+		bool crop_to_content = false;
+
+		// Guarded by the source mutex. The pixels are released after generating the texture, and rasterized again if it is regenerated.
+		bool rasterized = false;
+		Vector<byte> pixels;
+
+		// Set once the job has been rasterized, after which the texture can be generated without waiting for the rasterizer.
+		std::atomic<bool> done{false};
+	};
+
+	// Rasterizes the SVG document of the job into its pixels, in RmlUi's expected RGBA-ordering. The source mutex must be held.
+	static void Rasterize(SVGRasterJob& job)
+	{
+		if (job.rasterized)
+			return;
+
+		job.rasterized = true;
+		job.pixels.clear();
+
+		const Vector2i dimensions = job.dimensions;
+		lunasvg::Document* svg_document = job.source->svg_document.get();
+		if (dimensions.x > 0 && dimensions.y > 0)
+		{
+			lunasvg::Bitmap bitmap;
+			if (job.crop_to_content)
+			{
+				const lunasvg::Box smallest_fit = svg_document->boundingBox();
+
+				lunasvg::Matrix matrix(dimensions.x / svg_document->width(), 0, 0, dimensions.y / svg_document->height(), 0, 0);
+				matrix.scale(svg_document->width() / smallest_fit.w, svg_document->height() / smallest_fit.h);
+				matrix.translate(-smallest_fit.x, -smallest_fit.y);
+
+				bitmap = lunasvg::Bitmap(dimensions.x, dimensions.y);
+				bitmap.clear(0x00000000);
+				svg_document->render(bitmap, matrix);
+			}
+			else
+			{
+				bitmap = svg_document->renderToBitmap(dimensions.x, dimensions.y);
+			}
+
+			if (bitmap.valid() && bitmap.data())
+			{
+				const size_t bitmap_byte_size = bitmap.width() * bitmap.height() * 4;
+				const byte* bitmap_data = reinterpret_cast<const byte*>(bitmap.data());
+				job.pixels.assign(bitmap_data, bitmap_data + bitmap_byte_size);
+
+				// Swap red and blue channels, assuming LunaSVG v2.3.2 or newer, to convert to RmlUi's expected RGBA-ordering.
+				for (size_t i = 0; i < bitmap_byte_size; i += 4)
+					std::swap(job.pixels[i], job.pixels[i + 2]);
+			}
+		}
+
+		job.done.store(true, std::memory_order_release);
+	}
+
+	// Runs the rasterization jobs on a background thread, in the order they were queued. Jobs whose textures are released before the
+	// worker gets to them are skipped.
+	class SVGRasterWorker : NonCopyMoveable {
+	public:
+		SVGRasterWorker() : thread(&SVGRasterWorker::Run, this) {}
+		~SVGRasterWorker()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stop = true;
+			}
+			condition.notify_one();
+			thread.join();
+		}
+
+		void Push(const SharedPtr<SVGRasterJob>& job)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				queue.push_back(job);
+			}
+			condition.notify_one();
+		}
+
+	private:
+		void Run()
+		{
+			while (true)
+			{
+				WeakPtr<SVGRasterJob> next_job;
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					condition.wait(lock, [this] { return stop || !queue.empty(); });
+					if (stop)
+						return;
+					next_job = std::move(queue.front());
+					queue.pop_front();
+				}
+
+				if (SharedPtr<SVGRasterJob> job = next_job.lock())
+				{
+					std::lock_guard<std::mutex> lock(job->source->mutex);
+					Rasterize(*job);
+				}
+			}
+		}
+
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<WeakPtr<SVGRasterJob>> queue;
+		bool stop = false;
+
+		// Started last, after the other members are constructed.
+		std::thread thread;
+	};
+
 	struct SVGGeometry {
+		Vector2i dimensions;
 		ColourbPremultiplied colour;
 		UniquePtr<Geometry> geometry;
 	};
 
 	struct SVGTexture {
+		RenderManager* render_manager;
 		Vector2i render_dimensions;
 		bool crop_to_content;
 		CallbackTexture texture;
-		// List of geometries using this texture, one entry for each unique color.
+		SharedPtr<SVGRasterJob> raster_job;
+		// List of geometries using this texture, one entry for each unique element dimension and color. Empty while the texture is unused.
 		Vector<SVGGeometry> geometries;
+		// Incremented each time a texture becomes unused, for releasing the least recently used textures first.
+		uint64_t unused_order = 0;
+	};
+
+	struct SVGVectorGeometry {
+		RenderManager* render_manager;
+		ColourbPremultiplied colour;
+		UniquePtr<Geometry> geometry;
+		// Number of handles using the geometry, one for each unique element dimension.
+		int num_handles = 0;
 	};
 
 	struct SVGDocument {
 		Vector2f intrinsic_dimensions;
-		UniquePtr<lunasvg::Document> svg_document;
+		Vector2f content_dimensions;
+		SharedPtr<SVGSource> source;
 		// List of textures using this document, one entry for each unique render dimension plus meta-data.
 		Vector<SVGTexture> textures;
+
+		// The tessellated shapes of the document, generated when first rendered as vector geometry.
+		bool tessellated = false;
+		Mesh mesh;
+		Vector2f mesh_dimensions;
+		Rectanglef mesh_bounds = Rectanglef::MakeInvalid();
+		// List of geometries using the mesh, one entry for each unique color.
+		Vector<SVGVectorGeometry> vector_geometries;
 	};
 
 	struct SVGCacheData {
@@ -90,45 +251,237 @@ namespace SVG {
 		// for cleaning up the resources in the documents, when nothing refers to them any longer. When a handle is
 		// destroyed, it also removes itself from the handle map.
 		StableUnorderedMap<SVGKey, WeakPtr<SVGData>> handles;
+
+		// Total size of the textures without any users [bytes].
+		size_t unused_texture_bytes = 0;
+		uint64_t unused_counter = 0;
+		// Render managers of destroyed contexts, for which unused textures are released immediately.
+		Vector<RenderManager*> released_render_managers;
+
+		// Destroyed first, so that no jobs are running while the documents are released. When background rendering is enabled, jobs are
+		// submitted through the application's task interface when installed, otherwise they are run by our own worker.
+		BackgroundTasks raster_tasks;
+		UniquePtr<SVGRasterWorker> raster_worker;
 	};
 
 	static ControlledLifetimeResource<SVGCacheData> svg_cache_data;
 
-	SVGData::SVGData(Geometry& geometry, Texture texture, Vector2f intrinsic_dimensions, const SVGKey& cache_key) :
-		geometry(geometry), texture(texture), intrinsic_dimensions(intrinsic_dimensions), cache_key(cache_key)
+	SVGData::SVGData(Geometry& geometry, Texture texture, Vector2f intrinsic_dimensions, const SVGKey& cache_key, SharedPtr<SVGRasterJob> raster_job,
+		SharedPtr<SVGData> fallback) :
+		geometry(geometry), texture(texture), intrinsic_dimensions(intrinsic_dimensions), cache_key(cache_key), raster_job(std::move(raster_job)),
+		fallback(std::move(fallback))
+	{}
+
+	SVGData::SVGData(Geometry& geometry, Vector2f intrinsic_dimensions, const SVGKey& cache_key, Vector2f geometry_scale, Vector2f geometry_offset) :
+		geometry(geometry), intrinsic_dimensions(intrinsic_dimensions), cache_key(cache_key), vector(true), geometry_scale(geometry_scale),
+		geometry_offset(geometry_offset)
 	{}
 
 	SVGData::~SVGData()
 	{
+		fallback.reset();
 		ReleaseHandle(this);
 	}
 
-	static Vector<SVGTexture>::iterator FindSVGTexture(SVGDocument& doc, Vector2i dimensions, bool crop_to_content)
+	bool SVGData::IsReady() const
+	{
+		return !raster_job || raster_job->done.load(std::memory_order_acquire);
+	}
+
+	void SVGData::Render(Element* element, Vector2f translation)
 	{
-		return std::find_if(doc.textures.begin(), doc.textures.end(),
-			[&](const auto& entry) { return entry.render_dimensions == dimensions && entry.crop_to_content == crop_to_content; });
+		if (vector)
+		{
+			RenderManager* render_manager = element->GetRenderManager();
+			if (!render_manager)
+				return;
+
+			const Vector2f offset = translation + geometry_offset;
+			const Matrix4f transform = render_manager->GetState().transform * Matrix4f::Translate(offset.x, offset.y, 0.f) *
+				Matrix4f::Scale(geometry_scale.x, geometry_scale.y, 1.f);
+			render_manager->SetTransform(&transform);
+			geometry.Render(Vector2f(0.f));
+			ElementUtilities::ApplyTransform(*element);
+			return;
+		}
+
+		if (IsReady())
+		{
+			fallback.reset();
+			geometry.Render(translation, texture);
+			return;
+		}
+
+		// Render the element again on the next frame to check whether the texture is ready.
+		element->DirtyRenderCache();
+		if (Context* context = element->GetContext())
+			context->RequestNextUpdate(0);
+
+		if (fallback)
+			fallback->Render(element, translation);
 	}
 
-	static Vector<SVGGeometry>::iterator FindSVGGeometry(SVGTexture& per_size_data, const ColourbPremultiplied colour)
+	static size_t GetTextureByteSize(const SVGTexture& svg_texture)
 	{
-		return std::find_if(per_size_data.geometries.begin(), per_size_data.geometries.end(),
-			[&](const SVGGeometry& data) { return data.colour == colour; });
+		return size_t(svg_texture.render_dimensions.x) * size_t(svg_texture.render_dimensions.y) * 4;
 	}
 
-	static const String& GetSourceOr(const lunasvg::Document* svg_document, const String& default_value)
+	// Rounds the dimension up to a step which grows with the dimension, so that an SVG shown at many different sizes, such as during an
+	// animation, shares a limited number of textures.
+	static int QuantizeDimension(int value)
+	{
+		int step = 1;
+		while (step * 16 <= value)
+			step *= 2;
+		return (value + step - 1) / step * step;
+	}
+
+	// Finds a texture which can be used for the given dimensions. Textures up to a third larger are reused and scaled down when rendered,
+	// thus shrinking an SVG slightly does not rasterize it again. The smallest such texture is returned.
+	static Vector<SVGTexture>::iterator FindSVGTexture(SVGDocument& doc, RenderManager* render_manager, Vector2i dimensions, bool crop_to_content)
+	{
+		auto result = doc.textures.end();
+		for (auto it = doc.textures.begin(); it != doc.textures.end(); ++it)
+		{
+			const Vector2i texture_dimensions = it->render_dimensions;
+			if (it->render_manager != render_manager || it->crop_to_content != crop_to_content || texture_dimensions.x < dimensions.x ||
+				texture_dimensions.y < dimensions.y || 3 * texture_dimensions.x > 4 * dimensions.x || 3 * texture_dimensions.y > 4 * dimensions.y)
+				continue;
+
+			if (result == doc.textures.end() ||
+				texture_dimensions.x * texture_dimensions.y < result->render_dimensions.x * result->render_dimensions.y)
+				result = it;
+		}
+		return result;
+	}
+
+	static Vector<SVGGeometry>::iterator FindSVGGeometry(SVGTexture& svg_texture, Vector2i dimensions, const ColourbPremultiplied colour)
+	{
+		return std::find_if(svg_texture.geometries.begin(), svg_texture.geometries.end(),
+			[&](const SVGGeometry& data) { return data.dimensions == dimensions && data.colour == colour; });
+	}
+
+	static const String& GetSourceOr(const SVGSource* source, const String& default_value)
 	{
 		const auto& documents = svg_cache_data->documents;
-		auto it = std::find_if(documents.begin(), documents.end(),
-			[svg_document](const auto& pair) { return pair.second.svg_document.get() == svg_document; });
+		auto it = std::find_if(documents.begin(), documents.end(), [source](const auto& pair) { return pair.second.source.get() == source; });
 		if (it != documents.end())
 			return it->first;
 		return default_value;
 	}
 
+	// Finds the most similar handle of the same SVG that has already been rasterized, to be rendered while a new handle is rasterized.
+	static SharedPtr<SVGData> FindFallback(const SVGKey& key)
+	{
+		SharedPtr<SVGData> result;
+		int result_distance = 0;
+		for (auto& pair : svg_cache_data->handles)
+		{
+			const SVGKey& other = pair.first;
+			if (other.render_manager != key.render_manager || other.source_id != key.source_id || other.crop_to_content != key.crop_to_content ||
+				other.colour != key.colour || other.vector)
+				continue;
+
+			SharedPtr<SVGData> handle = pair.second.lock();
+			if (!handle || !handle->IsReady())
+				continue;
+
+			const int distance = Math::Absolute(other.dimensions.x - key.dimensions.x) + Math::Absolute(other.dimensions.y - key.dimensions.y);
+			if (!result || distance < result_distance)
+			{
+				result = std::move(handle);
+				result_distance = distance;
+			}
+		}
+		return result;
+	}
+
+	// Releases the texture, and the document when it has no textures left.
+	static void EraseSVGTexture(UnorderedMap<String, SVGDocument>::iterator it_document, Vector<SVGTexture>::iterator it_texture)
+	{
+		SVGDocument& svg_document = it_document->second;
+		if (it_texture->geometries.empty())
+			svg_cache_data->unused_texture_bytes -= GetTextureByteSize(*it_texture);
+
+		if (svg_document.textures.size() > 1 || !svg_document.vector_geometries.empty())
+		{
+			RMLUI_SVG_DEBUG_LOG("Releasing texture, size: %zu", svg_document.textures.size());
+			std::iter_swap(it_texture, std::prev(svg_document.textures.end()));
+			svg_document.textures.pop_back();
+		}
+		else
+		{
+			RMLUI_SVG_DEBUG_LOG("Releasing document");
+			svg_cache_data->documents.erase(it_document);
+		}
+	}
+
+	// Releases the least recently used textures without any users, until their total size is within the budget.
+	static void ReleaseLeastRecentlyUsedTextures(size_t budget)
+	{
+		auto& documents = svg_cache_data->documents;
+		while (svg_cache_data->unused_texture_bytes > budget)
+		{
+			auto it_oldest_document = documents.end();
+			Vector<SVGTexture>::iterator it_oldest_texture;
+			for (auto it_document = documents.begin(); it_document != documents.end(); ++it_document)
+			{
+				auto& textures = it_document->second.textures;
+				for (auto it_texture = textures.begin(); it_texture != textures.end(); ++it_texture)
+				{
+					if (it_texture->geometries.empty() &&
+						(it_oldest_document == documents.end() || it_texture->unused_order < it_oldest_texture->unused_order))
+					{
+						it_oldest_document = it_document;
+						it_oldest_texture = it_texture;
+					}
+				}
+			}
+
+			RMLUI_ASSERT(it_oldest_document != documents.end());
+			if (it_oldest_document == documents.end())
+				break;
+
+			EraseSVGTexture(it_oldest_document, it_oldest_texture);
+		}
+	}
+
+	// Returns the SVG source data, either the source itself or the contents of the file it refers to. Returns nullptr on failure.
+	static const String* LoadSourceData(const String& source, SVGCache::SourceType source_type, String& file_data)
+	{
+		if (source_type != SVGCache::SourceType::File)
+			return &source;
+
+		RMLUI_SVG_DEBUG_LOG("Loading SVG document from file %s", source.c_str());
+		if (source.empty() || !GetFileInterface()->LoadFile(source, file_data))
+		{
+			Log::Message(Rml::Log::Type::LT_WARNING, "Could not load SVG file %s", source.c_str());
+			return nullptr;
+		}
+		return &file_data;
+	}
+
+	static void Tessellate(SVGDocument& doc, const String& source_id, const String* svg_data)
+	{
+		RMLUI_SVG_DEBUG_LOG("Tessellating SVG document %s", source_id.c_str());
+		doc.tessellated = true;
+		if (!svg_data)
+			return;
+
+		if (!SVGTessellator::Tessellate(doc.mesh, doc.mesh_dimensions, *svg_data))
+		{
+			Log::Message(Rml::Log::Type::LT_WARNING, "Could not tessellate SVG data for item %s", source_id.c_str());
+			return;
+		}
+
+		for (const Vertex& vertex : doc.mesh.vertices)
+			doc.mesh_bounds = (doc.mesh_bounds.Valid() ? doc.mesh_bounds.Join(vertex.position) : Rectanglef::FromPosition(vertex.position));
+	}
+
 	static SharedPtr<SVGData> GetHandle(RenderManager& render_manager, String move_from_id, const String& source, SVGCache::SourceType source_type,
-		const Vector2i dimensions, const bool crop_to_content, const ColourbPremultiplied colour)
+		const Vector2i dimensions, const bool crop_to_content, const ColourbPremultiplied colour, const bool vector)
 	{
-		SVGKey key{std::move(move_from_id), dimensions, crop_to_content, colour};
+		SVGKey key{&render_manager, std::move(move_from_id), dimensions, crop_to_content, colour, vector};
 		const String& source_id = key.source_id;
 		auto& documents = svg_cache_data->documents;
 		auto& handles = svg_cache_data->handles;
@@ -147,40 +500,33 @@ namespace SVG {
 			crop_to_content ? "crop_to_content" : "crop_none", *reinterpret_cast<const uint32_t*>(&colour[0]));
 
 		// Find or create a document
+		String file_data;
+		const String* svg_data = nullptr;
 		auto it_svg_document = documents.find(source_id);
 		if (it_svg_document == documents.cend())
 		{
-			SVGDocument doc;
-			if (source_type == SVGCache::SourceType::File)
-			{
-				RMLUI_SVG_DEBUG_LOG("Loading SVG document from file %s", source.c_str());
-				String svg_data;
-				if (source.empty() || !GetFileInterface()->LoadFile(source, svg_data))
-				{
-					Log::Message(Rml::Log::Type::LT_WARNING, "Could not load SVG file %s", source.c_str());
-					return {};
-				}
+			svg_data = LoadSourceData(source, source_type, file_data);
+			if (!svg_data)
+				return {};
 
-				// We use a reset-release approach here in case clients use a non-std unique_ptr (lunasvg uses std::unique_ptr). We also use
-				// loadFromData(char*, size_t) instead of loadFromData(std::string) in case clients use a non-std string.
-				doc.svg_document.reset(lunasvg::Document::loadFromData(svg_data.data(), svg_data.size()).release());
-			}
-			else
-			{
-				RMLUI_SVG_DEBUG_LOG("Loading SVG document from element %s contents", source_id.c_str());
-				// We use a reset-release approach here in case clients use a non-std unique_ptr (lunasvg uses std::unique_ptr). We also use
-				// loadFromData(char*, size_t) instead of loadFromData(std::string) in case clients use a non-std string.
-				doc.svg_document.reset(lunasvg::Document::loadFromData(source.data(), source.size()).release());
-			}
+			// We use a reset-release approach here in case clients use a non-std unique_ptr (lunasvg uses std::unique_ptr). We also use
+			// loadFromData(char*, size_t) instead of loadFromData(std::string) in case clients use a non-std string.
+			SVGDocument doc;
+			doc.source = MakeShared<SVGSource>();
+			doc.source->svg_document.reset(lunasvg::Document::loadFromData(svg_data->data(), svg_data->size()).release());
 
-			if (!doc.svg_document)
+			if (!doc.source->svg_document)
 			{
 				Log::Message(Rml::Log::Type::LT_WARNING, "Could not load SVG data for item %s", source_id.c_str());
 				return {};
 			}
 
-			doc.intrinsic_dimensions.x = Math::Max(float(doc.svg_document->width()), 1.0f);
-			doc.intrinsic_dimensions.y = Math::Max(float(doc.svg_document->height()), 1.0f);
+			// The document is not accessed by this thread after being shared with the rasterizer, thus store its dimensions here.
+			const lunasvg::Document& svg_document = *doc.source->svg_document;
+			doc.intrinsic_dimensions.x = Math::Max(float(svg_document.width()), 1.0f);
+			doc.intrinsic_dimensions.y = Math::Max(float(svg_document.height()), 1.0f);
+			const lunasvg::Box smallest_fit = svg_document.boundingBox();
+			doc.content_dimensions = Vector2f(float(smallest_fit.w), float(smallest_fit.h));
 
 			const auto it_inserted = documents.insert_or_assign(source_id, std::move(doc));
 			RMLUI_ASSERT(it_inserted.second);
@@ -189,70 +535,107 @@ namespace SVG {
 		}
 
 		SVGDocument& doc = it_svg_document->second;
+		const Vector2f intrinsic_dimensions = (crop_to_content ? doc.content_dimensions : doc.intrinsic_dimensions);
+
+		// The render manager is in use, thus keep its unused textures again.
+		auto& released_render_managers = svg_cache_data->released_render_managers;
+		released_render_managers.erase(std::remove(released_render_managers.begin(), released_render_managers.end(), &render_manager),
+			released_render_managers.end());
 
-		Vector2f intrinsic_dimensions = doc.intrinsic_dimensions;
-		if (crop_to_content)
+		if (vector)
 		{
-			const lunasvg::Box smallest_fit = doc.svg_document->boundingBox();
-			intrinsic_dimensions.x = static_cast<float>(smallest_fit.w);
-			intrinsic_dimensions.y = static_cast<float>(smallest_fit.h);
+			if (!doc.tessellated)
+				Tessellate(doc, source_id, svg_data ? svg_data : LoadSourceData(source, source_type, file_data));
+
+			// Find or create per-color geometry, shared by all dimensions
+			auto it_geometry = std::find_if(doc.vector_geometries.begin(), doc.vector_geometries.end(),
+				[&](const SVGVectorGeometry& data) { return data.render_manager == &render_manager && data.colour == colour; });
+			if (it_geometry == doc.vector_geometries.end())
+			{
+				Mesh mesh = doc.mesh;
+				for (Vertex& vertex : mesh.vertices)
+				{
+					for (int i = 0; i < 4; i++)
+						vertex.colour[i] = byte((int(vertex.colour[i]) * int(colour[i]) + 127) / 255);
+				}
+
+				SVGVectorGeometry geometry_data;
+				geometry_data.render_manager = &render_manager;
+				geometry_data.colour = colour;
+				geometry_data.geometry = MakeUnique<Geometry>(render_manager.MakeGeometry(std::move(mesh)));
+				doc.vector_geometries.push_back(std::move(geometry_data));
+				it_geometry = std::prev(doc.vector_geometries.end());
+			}
+			it_geometry->num_handles += 1;
+
+			// Map the viewport, or the bounds of the geometry when cropping, to the dimensions.
+			Rectanglef bounds = Rectanglef::FromSize(doc.mesh_dimensions);
+			if (crop_to_content && doc.mesh_bounds.Width() > 0.f && doc.mesh_bounds.Height() > 0.f)
+				bounds = doc.mesh_bounds;
+			const Vector2f scale = (bounds.Width() > 0.f && bounds.Height() > 0.f ? Vector2f(dimensions) / bounds.Size() : Vector2f(0.f));
+
+			const auto iterator_inserted = handles.emplace(std::move(key), WeakPtr<SVGData>());
+			RMLUI_ASSERTMSG(iterator_inserted.second, "Could not insert entry into the SVG cache handle map, duplicate key.");
+			auto svg_handle =
+				MakeShared<SVGData>(*it_geometry->geometry, intrinsic_dimensions, iterator_inserted.first->first, scale, -bounds.TopLeft() * scale);
+			iterator_inserted.first->second = svg_handle;
+
+			return svg_handle;
 		}
 
 		// Find or create texture
-		auto it_size = FindSVGTexture(doc, dimensions, crop_to_content);
-		if (it_size == doc.textures.cend())
+		auto it_texture = FindSVGTexture(doc, &render_manager, dimensions, crop_to_content);
+		if (it_texture == doc.textures.cend())
 		{
-			RMLUI_SVG_DEBUG_LOG("Creating per-size data for (%d, %d), %s", dimensions.x, dimensions.y,
+			// Use the exact dimensions for the first texture, otherwise the SVG is likely being resized, then round them up to share textures
+			// between similar sizes.
+			const bool has_other_sizes = std::any_of(doc.textures.begin(), doc.textures.end(), [&](const SVGTexture& svg_texture) {
+				return svg_texture.render_manager == &render_manager && svg_texture.crop_to_content == crop_to_content;
+			});
+			const Vector2i render_dimensions =
+				(has_other_sizes ? Vector2i(QuantizeDimension(dimensions.x), QuantizeDimension(dimensions.y)) : dimensions);
+
+			RMLUI_SVG_DEBUG_LOG("Creating per-size data for (%d, %d), %s", render_dimensions.x, render_dimensions.y,
 				crop_to_content ? "crop_to_content" : "crop_none");
+
+			auto raster_job = MakeShared<SVGRasterJob>();
+			raster_job->source = doc.source;
+			raster_job->dimensions = render_dimensions;
+			raster_job->crop_to_content = crop_to_content;
+
 			SVGTexture svg_texture;
-			svg_texture.render_dimensions = dimensions;
+			svg_texture.render_manager = &render_manager;
+			svg_texture.render_dimensions = render_dimensions;
 			svg_texture.crop_to_content = crop_to_content;
-			svg_texture.texture = {};
+			svg_texture.raster_job = raster_job;
 
-			// Callback for generating texture.
-			auto texture_callback = [svg_document = doc.svg_document.get(), dimensions, crop_to_content](
-										const CallbackTextureInterface& texture_interface) -> bool {
-				RMLUI_ASSERT(svg_document);
-				RMLUI_SVG_DEBUG_LOG("Generating texture: %s, (%d, %d), %s", GetSourceOr(svg_document, "").c_str(), dimensions.x, dimensions.y,
-					crop_to_content ? "crop_to_content" : "crop_none");
+			// Callback for generating texture. Usually the job has already been rasterized by the worker at this point.
+			auto texture_callback = [raster_job](const CallbackTextureInterface& texture_interface) -> bool {
+				SVGRasterJob& job = *raster_job;
+				std::lock_guard<std::mutex> lock(job.source->mutex);
+				RMLUI_SVG_DEBUG_LOG("Generating texture: %s, (%d, %d), %s", GetSourceOr(job.source.get(), "").c_str(), job.dimensions.x,
+					job.dimensions.y, job.crop_to_content ? "crop_to_content" : "crop_none");
 
-				if (dimensions.x == 0 || dimensions.y == 0)
+				if (job.dimensions.x == 0 || job.dimensions.y == 0)
 					return false;
 
-				lunasvg::Bitmap bitmap;
-				if (crop_to_content)
-				{
-					const lunasvg::Box smallest_fit = svg_document->boundingBox();
-
-					lunasvg::Matrix matrix(dimensions.x / svg_document->width(), 0, 0, dimensions.y / svg_document->height(), 0, 0);
-					matrix.scale(svg_document->width() / smallest_fit.w, svg_document->height() / smallest_fit.h);
-					matrix.translate(-smallest_fit.x, -smallest_fit.y);
+				Rasterize(job);
 
-					bitmap = lunasvg::Bitmap(dimensions.x, dimensions.y);
-					bitmap.clear(0x00000000);
-					svg_document->render(bitmap, matrix);
-				}
-				else
-				{
-					bitmap = svg_document->renderToBitmap(dimensions.x, dimensions.y);
-				}
-
-				if (!bitmap.valid() || !bitmap.data())
+				if (job.pixels.empty())
 				{
-					Log::Message(Rml::Log::Type::LT_WARNING, "Could not render SVG to bitmap: %s", GetSourceOr(svg_document, "").c_str());
+					Log::Message(Rml::Log::Type::LT_WARNING, "Could not render SVG to bitmap: %s", GetSourceOr(job.source.get(), "").c_str());
 					return false;
 				}
 
-				// Swap red and blue channels, assuming LunaSVG v2.3.2 or newer, to convert to RmlUi's expected RGBA-ordering.
-				const size_t bitmap_byte_size = bitmap.width() * bitmap.height() * 4;
-				uint8_t* bitmap_data = bitmap.data();
-				for (size_t i = 0; i < bitmap_byte_size; i += 4)
-					std::swap(bitmap_data[i], bitmap_data[i + 2]);
+				const bool result = texture_interface.GenerateTexture(job.pixels, job.dimensions);
+
+				job.pixels.clear();
+				job.pixels.shrink_to_fit();
+				job.rasterized = false;
 
-				if (!texture_interface.GenerateTexture({reinterpret_cast<const Rml::byte*>(bitmap.data()), bitmap_byte_size},
-						Vector2i{bitmap.width(), bitmap.height()}))
+				if (!result)
 				{
-					Log::Message(Rml::Log::Type::LT_WARNING, "Could not generate texture for SVG: %s", GetSourceOr(svg_document, "").c_str());
+					Log::Message(Rml::Log::Type::LT_WARNING, "Could not generate texture for SVG: %s", GetSourceOr(job.source.get(), "").c_str());
 					return false;
 				}
 
@@ -261,20 +644,45 @@ namespace SVG {
 
 			svg_texture.texture = render_manager.MakeCallbackTexture(std::move(texture_callback));
 
+			// Unless rasterized in the background, the job is rasterized by the texture callback when the texture is first rendered.
+			if (BackgroundTasks::IsRenderingEnabled())
+			{
+				const WeakPtr<SVGRasterJob> weak_raster_job = raster_job;
+				const bool submitted = svg_cache_data->raster_tasks.Submit([weak_raster_job]() {
+					if (SharedPtr<SVGRasterJob> job = weak_raster_job.lock())
+					{
+						std::lock_guard<std::mutex> lock(job->source->mutex);
+						Rasterize(*job);
+					}
+				});
+				if (!submitted && svg_cache_data->raster_worker)
+					svg_cache_data->raster_worker->Push(raster_job);
+			}
+
 			doc.textures.push_back(std::move(svg_texture));
-			it_size = std::prev(doc.textures.end());
+			it_texture = std::prev(doc.textures.end());
+		}
+		else if (it_texture->geometries.empty())
+		{
+			RMLUI_SVG_DEBUG_LOG("Reusing unused texture (%d, %d)", it_texture->render_dimensions.x, it_texture->render_dimensions.y);
+			svg_cache_data->unused_texture_bytes -= GetTextureByteSize(*it_texture);
 		}
 
-		// Construct and insert per-color geometry
-		SVGTexture& size_data = *it_size;
-		RMLUI_ASSERTMSG(FindSVGGeometry(size_data, colour) == size_data.geometries.end(),
-			"We found an existing color entry in the SVG document cache, this should have been found as a cache key map entry instead.");
-		SVGGeometry colour_data;
-		colour_data.colour = colour;
+		// Construct and insert per-size and per-color geometry
+		SVGTexture& svg_texture = *it_texture;
+		RMLUI_ASSERTMSG(FindSVGGeometry(svg_texture, dimensions, colour) == svg_texture.geometries.end(),
+			"We found an existing geometry entry in the SVG document cache, this should have been found as a cache key map entry instead.");
+		SVGGeometry geometry_data;
+		geometry_data.dimensions = dimensions;
+		geometry_data.colour = colour;
 		Mesh mesh;
-		MeshUtilities::GenerateQuad(mesh, Vector2f(0), Vector2f(size_data.render_dimensions), colour, Vector2f(0), Vector2f(1));
-		colour_data.geometry = MakeUnique<Geometry>(render_manager.MakeGeometry(std::move(mesh)));
-		size_data.geometries.push_back(std::move(colour_data));
+		MeshUtilities::GenerateQuad(mesh, Vector2f(0), Vector2f(dimensions), colour, Vector2f(0), Vector2f(1));
+		geometry_data.geometry = MakeUnique<Geometry>(render_manager.MakeGeometry(std::move(mesh)));
+		svg_texture.geometries.push_back(std::move(geometry_data));
+
+		SharedPtr<SVGData> fallback;
+		if (!svg_texture.raster_job->done.load(std::memory_order_acquire))
+			fallback = FindFallback(key);
 
 		// Create and insert the handle
 		const auto iterator_inserted = handles.emplace(std::move(key), WeakPtr<SVGData>());
@@ -282,7 +690,8 @@ namespace SVG {
 		const SVGKey& inserted_key = iterator_inserted.first->first;
 		WeakPtr<SVGData>& inserted_weak_data_pointer = iterator_inserted.first->second;
 
-		auto svg_handle = MakeShared<SVGData>(*size_data.geometries.back().geometry.get(), size_data.texture, intrinsic_dimensions, inserted_key);
+		auto svg_handle = MakeShared<SVGData>(*svg_texture.geometries.back().geometry.get(), svg_texture.texture, intrinsic_dimensions, inserted_key,
+			svg_texture.raster_job, std::move(fallback));
 		inserted_weak_data_pointer = svg_handle;
 
 		return svg_handle;
@@ -291,8 +700,8 @@ namespace SVG {
 	static void ReleaseHandle(SVGData* handle)
 	{
 		// There are no longer any users of the cache entry uniquely identified by the handle address. Start from the
-		// tip (i.e. per-color data) and remove that entry from its parent. Move up the cache ancestry and erase any
-		// entries that no longer have any children.
+		// tip (i.e. per-color data) and remove that entry from its parent. Textures without any users are kept for
+		// reuse within a limited budget, the least recently used ones are released along with their documents.
 		auto& documents = svg_cache_data->documents;
 		auto& handles = svg_cache_data->handles;
 		const SVGKey& key = handle->cache_key;
@@ -304,54 +713,92 @@ namespace SVG {
 		RMLUI_ASSERT(it_document != documents.cend());
 		SVGDocument& svg_document = it_document->second;
 
-		RMLUI_SVG_DEBUG_LOG("Releasing handle: %s, (%d, %d), %s, %#x", key.path.c_str(), key.dimensions.x, key.dimensions.y,
+		RMLUI_SVG_DEBUG_LOG("Releasing handle: %s, (%d, %d), %s, %#x", key.source_id.c_str(), key.dimensions.x, key.dimensions.y,
 			key.crop_to_content ? "crop_to_content" : "crop_none", *reinterpret_cast<const uint32_t*>(&key.colour[0]));
 
-		auto it_texture = FindSVGTexture(svg_document, key.dimensions, key.crop_to_content);
-		RMLUI_ASSERT(it_texture != svg_document.textures.cend());
-		SVGTexture& svg_texture = *it_texture;
+		if (key.vector)
+		{
+			auto it_geometry = std::find_if(svg_document.vector_geometries.begin(), svg_document.vector_geometries.end(),
+				[&](const SVGVectorGeometry& data) { return data.render_manager == key.render_manager && data.colour == key.colour; });
+			RMLUI_ASSERT(it_geometry != svg_document.vector_geometries.cend());
 
-		auto it_geometry = FindSVGGeometry(svg_texture, key.colour);
-		RMLUI_ASSERT(it_geometry != svg_texture.geometries.cend());
+			handles.erase(it_handle);
 
-		if (svg_texture.geometries.size() > 1)
+			it_geometry->num_handles -= 1;
+			if (it_geometry->num_handles == 0)
+			{
+				std::iter_swap(it_geometry, std::prev(svg_document.vector_geometries.end()));
+				svg_document.vector_geometries.pop_back();
+
+				if (svg_document.textures.empty() && svg_document.vector_geometries.empty())
+				{
+					RMLUI_SVG_DEBUG_LOG("Releasing document");
+					documents.erase(it_document);
+				}
+			}
+		}
+		else
 		{
+			Vector<SVGGeometry>::iterator it_geometry;
+			auto it_texture = std::find_if(svg_document.textures.begin(), svg_document.textures.end(), [&](SVGTexture& svg_texture) {
+				if (svg_texture.render_manager != key.render_manager || svg_texture.crop_to_content != key.crop_to_content)
+					return false;
+				it_geometry = FindSVGGeometry(svg_texture, key.dimensions, key.colour);
+				return it_geometry != svg_texture.geometries.end();
+			});
+			RMLUI_ASSERT(it_texture != svg_document.textures.cend());
+			SVGTexture& svg_texture = *it_texture;
+
 			RMLUI_SVG_DEBUG_LOG("Releasing handle from geometries, size: %zu", svg_texture.geometries.size());
 			std::iter_swap(it_geometry, std::prev(svg_texture.geometries.end()));
 			svg_texture.geometries.pop_back();
-		}
-		else if (svg_document.textures.size() > 1)
-		{
-			RMLUI_SVG_DEBUG_LOG("Releasing handle from textures, size: %zu", svg_document.textures.size());
-			std::iter_swap(it_texture, std::prev(svg_document.textures.end()));
-			svg_document.textures.pop_back();
-		}
-		else
-		{
-			RMLUI_SVG_DEBUG_LOG("Releasing document");
-			documents.erase(it_document);
-		}
 
-		handles.erase(it_handle);
+			handles.erase(it_handle);
+
+			if (svg_texture.geometries.empty())
+			{
+				const auto& released_render_managers = svg_cache_data->released_render_managers;
+				const bool render_manager_released = std::find(released_render_managers.begin(), released_render_managers.end(),
+															 svg_texture.render_manager) != released_render_managers.end();
+
+				svg_cache_data->unused_texture_bytes += GetTextureByteSize(svg_texture);
+				svg_texture.unused_order = ++svg_cache_data->unused_counter;
+
+				if (render_manager_released)
+					EraseSVGTexture(it_document, it_texture);
+				else
+					ReleaseLeastRecentlyUsedTextures(unused_texture_budget);
+			}
+		}
 
 #ifdef RMLUI_DEBUG
 		size_t count_unique_entries = 0;
+		size_t count_unused_bytes = 0;
 		for (auto& document : documents)
 		{
-			RMLUI_ASSERT(!document.second.textures.empty());
+			RMLUI_ASSERT(!document.second.textures.empty() || !document.second.vector_geometries.empty());
 			for (auto& size_data : document.second.textures)
 			{
-				RMLUI_ASSERT(!size_data.geometries.empty());
 				count_unique_entries += size_data.geometries.size();
+				if (size_data.geometries.empty())
+					count_unused_bytes += GetTextureByteSize(size_data);
+			}
+			for (auto& vector_geometry : document.second.vector_geometries)
+			{
+				RMLUI_ASSERT(vector_geometry.num_handles > 0);
+				count_unique_entries += size_t(vector_geometry.num_handles);
 			}
 		}
 		RMLUI_ASSERT(count_unique_entries == handles.size());
+		RMLUI_ASSERT(count_unused_bytes == svg_cache_data->unused_texture_bytes);
 #endif
 	}
 
 	void SVGCache::Initialize()
 	{
 		svg_cache_data.Initialize();
+		if (BackgroundTasks::IsRenderingEnabled() && !GetTaskInterface())
+			svg_cache_data->raster_worker = MakeUnique<SVGRasterWorker>();
 	}
 
 	void SVGCache::Shutdown()
@@ -360,7 +807,7 @@ namespace SVG {
 	}
 
 	SharedPtr<SVGData> SVGCache::GetHandle(const String& source_id, const String& source, SourceType source_type, Element* element,
-		const bool crop_to_content, const BoxArea area)
+		const bool crop_to_content, const BoxArea area, const RenderMode render_mode)
 	{
 		RenderManager* render_manager = element->GetRenderManager();
 		if (!render_manager)
@@ -372,6 +819,8 @@ namespace SVG {
 		if (dimensions.x == 0 || dimensions.y == 0)
 			dimensions = {0, 0};
 
+		const bool vector = (render_mode == RenderMode::Vector);
+
 		if (source_type == File)
 		{
 			String path;
@@ -380,10 +829,41 @@ namespace SVG {
 				const String document_source_url = StringUtilities::Replace(document->GetSourceURL(), '|', ':');
 				GetSystemInterface()->JoinPath(path, document_source_url, source_id);
 			}
-			return Rml::SVG::GetHandle(*render_manager, path, path, source_type, dimensions, crop_to_content, colour);
+			return Rml::SVG::GetHandle(*render_manager, path, path, source_type, dimensions, crop_to_content, colour, vector);
 		}
 
-		return Rml::SVG::GetHandle(*render_manager, source_id, source, source_type, dimensions, crop_to_content, colour);
+		return Rml::SVG::GetHandle(*render_manager, source_id, source, source_type, dimensions, crop_to_content, colour, vector);
+	}
+
+	void SVGCache::ReleaseUnusedTextures(RenderManager& render_manager)
+	{
+		auto& released_render_managers = svg_cache_data->released_render_managers;
+		if (std::find(released_render_managers.begin(), released_render_managers.end(), &render_manager) == released_render_managers.end())
+			released_render_managers.push_back(&render_manager);
+
+		auto& documents = svg_cache_data->documents;
+		for (auto it_document = documents.begin(); it_document != documents.end();)
+		{
+			auto& textures = it_document->second.textures;
+			for (size_t i = 0; i < textures.size();)
+			{
+				if (textures[i].render_manager == &render_manager && textures[i].geometries.empty())
+				{
+					svg_cache_data->unused_texture_bytes -= GetTextureByteSize(textures[i]);
+					std::swap(textures[i], textures.back());
+					textures.pop_back();
+				}
+				else
+				{
+					i++;
+				}
+			}
+
+			if (textures.empty() && it_document->second.vector_geometries.empty())
+				it_document = documents.erase(it_document);
+			else
+				++it_document;
+		}
 	}
 
 } // namespace SVG
@@ -7,19 +7,43 @@ namespace Rml {
 
 class Element;
 class Geometry;
+class RenderManager;
 
 namespace SVG {
 
 	struct SVGKey;
+	struct SVGRasterJob;
 
 	struct SVGData : NonCopyMoveable {
-		SVGData(Geometry& geometry, Texture texture, Vector2f intrinsic_dimensions, const SVGKey& cache_key);
+		SVGData(Geometry& geometry, Texture texture, Vector2f intrinsic_dimensions, const SVGKey& cache_key, SharedPtr<SVGRasterJob> raster_job,
+			SharedPtr<SVGData> fallback);
+		/// Constructs a handle to tessellated geometry, rendered with the given scale and offset applied to the element's transform.
+		SVGData(Geometry& geometry, Vector2f intrinsic_dimensions, const SVGKey& cache_key, Vector2f geometry_scale, Vector2f geometry_offset);
 		~SVGData();
 
+		/// Renders the SVG geometry. While the texture is still being rasterized, the fallback is rendered instead, if any, and the element
+		/// is rendered again on the next frame.
+		/// @param[in] element The element to render the SVG for.
+		/// @param[in] translation The translation of the geometry.
+		void Render(Element* element, Vector2f translation);
+
+		/// Returns true once the texture has been rasterized, or always for tessellated geometry.
+		bool IsReady() const;
+
 		Geometry& geometry;
 		Texture texture;
 		Vector2f intrinsic_dimensions;
 		const SVGKey& cache_key;
+
+	private:
+		SharedPtr<SVGRasterJob> raster_job;
+		// A previously rasterized handle of the same SVG, rendered until this one is ready.
+		SharedPtr<SVGData> fallback;
+
+		// Maps tessellated geometry from the SVG viewport into the rendered dimensions.
+		bool vector = false;
+		Vector2f geometry_scale = Vector2f(1.f);
+		Vector2f geometry_offset;
 	};
 
 	class SVGCache {
@@ -28,6 +52,10 @@ namespace SVG {
 			File = 1, /// The source is a file path.
 			Data = 2  /// The source is raw SVG data.
 		};
+		enum class RenderMode {
+			Raster, /// The SVG is rasterized into a texture at the rendered dimensions.
+			Vector  /// The shapes of the SVG are tessellated into geometry once, and scaled while rendering.
+		};
 		static void Initialize();
 		static void Shutdown();
 
@@ -38,11 +66,17 @@ namespace SVG {
 		/// @param[in] element Element for which to calculate the dimensions and color.
 		/// @param[in] crop_to_content Crop the rendered SVG to its contents.
 		/// @param[in] area The area of the element used to determine the SVG dimensions.
+		/// @param[in] render_mode Whether to render the SVG as a rasterized texture or as tessellated geometry.
 		/// @return A handle to the SVG data, with automatic reference counting.
 		///	@note When changing color or dimensions of an SVG without changing the source file, it's best to get a
-		/// new handle before releasing the old one, to avoid unnecessarily reloading data.
+		/// new handle before releasing the old one, to avoid unnecessarily reloading data. The old handle is then also
+		/// rendered while the new one is being rasterized.
 		static SharedPtr<SVGData> GetHandle(const String& source_id, const String& source, SourceType source_type, Element* element,
-			const bool crop_to_content, const BoxArea area);
+			const bool crop_to_content, const BoxArea area, RenderMode render_mode = RenderMode::Raster);
+
+		/// Releases the unused textures kept for the given render manager, and stops keeping them until it is used again.
+		/// @note Called when a context is destroyed, as its render manager may be released afterward.
+		static void ReleaseUnusedTextures(RenderManager& render_manager);
 	};
 
 } // namespace SVG
@@ -1,3 +1,4 @@
+#include "../../Include/RmlUi/Core/Context.h"
 #include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/ElementInstancer.h"
 #include "../../Include/RmlUi/Core/Factory.h"
@@ -35,6 +36,8 @@ namespace SVG {
 			SVGCache::Shutdown();
 		}
 
+		void OnContextDestroy(Context* context) override { SVGCache::ReleaseUnusedTextures(context->GetRenderManager()); }
+
 		int GetEventClasses() override { return Plugin::EVT_BASIC; }
 
 	private:
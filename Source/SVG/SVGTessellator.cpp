@@ -0,0 +1,1042 @@
+#include "SVGTessellator.h"
+#include "../../Include/RmlUi/Core/BaseXMLParser.h"
+#include "../../Include/RmlUi/Core/Dictionary.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/Mesh.h"
+#include "../../Include/RmlUi/Core/StreamMemory.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
+#include "../Core/PropertyParserColour.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace Rml {
+namespace SVG {
+
+namespace {
+
+	// The maximum distance between curves and their flattened segments, relative to the largest viewport dimension.
+	constexpr float curve_tolerance_factor = 1.f / 2048.f;
+	constexpr int max_curve_segments = 1024;
+
+	// An affine transform mapping (x, y) to (a*x + c*y + e, b*x + d*y + f), as in the SVG matrix() notation.
+	struct Transform2D {
+		float a = 1, b = 0, c = 0, d = 1, e = 0, f = 0;
+
+		Vector2f Apply(Vector2f p) const { return {a * p.x + c * p.y + e, b * p.x + d * p.y + f}; }
+		// Returns the average scale factor, used to transform lengths such as the stroke width.
+		float Scale() const { return Math::SquareRoot(Math::Absolute(a * d - b * c)); }
+
+		// Returns the transform which applies the given transform first, then this one.
+		Transform2D operator*(const Transform2D& rhs) const
+		{
+			return {a * rhs.a + c * rhs.b, b * rhs.a + d * rhs.b, a * rhs.c + c * rhs.d, b * rhs.c + d * rhs.d, a * rhs.e + c * rhs.f + e,
+				b * rhs.e + d * rhs.f + f};
+		}
+	};
+
+	struct Contour {
+		Vector<Vector2f> points;
+		bool closed = false;
+	};
+	using ContourList = Vector<Contour>;
+
+	enum class LineJoin { Miter, Round, Bevel };
+	enum class LineCap { Butt, Round, Square };
+
+	struct Paint {
+		bool enabled = false;
+		bool current_color = false;
+		Colourb colour;
+	};
+
+	struct Style {
+		// Transforms from the element's user space into the viewport.
+		Transform2D transform;
+		bool skip = false;
+		bool hidden = false;
+		Colourb color = Colourb(0, 0, 0, 255);
+
+		Paint fill = {true, false, Colourb(0, 0, 0, 255)};
+		float fill_opacity = 1.f;
+		bool fill_even_odd = false;
+
+		Paint stroke;
+		float stroke_opacity = 1.f;
+		float stroke_width = 1.f;
+		LineJoin stroke_join = LineJoin::Miter;
+		LineCap stroke_cap = LineCap::Butt;
+		float stroke_miter_limit = 4.f;
+
+		// The opacity of the element itself, and the product of its ancestors' opacities. Group opacity is approximated by applying it to
+		// each shape individually.
+		float opacity = 1.f;
+		float inherited_opacity = 1.f;
+	};
+
+	// Reads numbers and flags from attribute values such as path data, where numbers may be separated by whitespace and commas, or only by
+	// their signs and decimal points.
+	class NumberReader {
+	public:
+		explicit NumberReader(const String& value) : p(value.c_str()) {}
+
+		bool AtEnd()
+		{
+			SkipSeparators();
+			return *p == '\0';
+		}
+		char Peek()
+		{
+			SkipSeparators();
+			return *p;
+		}
+		void Skip() { p++; }
+
+		bool ReadNumber(float& out)
+		{
+			SkipSeparators();
+			char* end = nullptr;
+			out = std::strtof(p, &end);
+			if (end == p)
+				return false;
+			p = end;
+			return true;
+		}
+		bool ReadFlag(bool& out)
+		{
+			SkipSeparators();
+			if (*p != '0' && *p != '1')
+				return false;
+			out = (*p == '1');
+			p++;
+			return true;
+		}
+
+	private:
+		void SkipSeparators()
+		{
+			while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r' || *p == ',')
+				p++;
+		}
+
+		const char* p;
+	};
+
+	// Returns the angle of each segment needed to flatten an arc of the given radius within the tolerance.
+	float GetArcSegmentAngle(float radius, float tolerance)
+	{
+		if (radius <= tolerance)
+			return 0.5f * Math::RMLUI_PI;
+		return 2.f * Math::ACos(1.f - tolerance / radius);
+	}
+
+	int GetArcSegmentCount(float angle, float radius, float tolerance)
+	{
+		return Math::Clamp(int(Math::RoundUp(Math::Absolute(angle) / GetArcSegmentAngle(radius, tolerance))), 1, max_curve_segments);
+	}
+
+	// Builds flattened contours from path commands, in the user space of the shape.
+	class PathBuilder {
+	public:
+		PathBuilder(ContourList& contours, float tolerance) : contours(contours), tolerance(tolerance) {}
+
+		Vector2f GetCurrentPoint() const { return current; }
+
+		void MoveTo(Vector2f p)
+		{
+			contours.emplace_back();
+			contours.back().points.push_back(p);
+			start = current = p;
+		}
+		void LineTo(Vector2f p)
+		{
+			// Drawing after closing a contour starts a new one from the same point.
+			if (contours.empty() || contours.back().closed)
+				MoveTo(current);
+			contours.back().points.push_back(p);
+			current = p;
+		}
+		void QuadraticTo(Vector2f c, Vector2f p)
+		{
+			const Vector2f p0 = current;
+			const float deviation = (p0 - c * 2.f + p).Magnitude();
+			const int num_segments = GetCurveSegmentCount(0.25f * deviation);
+			for (int i = 1; i < num_segments; i++)
+			{
+				const float t = float(i) / float(num_segments);
+				const float s = 1.f - t;
+				LineTo(p0 * (s * s) + c * (2.f * s * t) + p * (t * t));
+			}
+			LineTo(p);
+		}
+		void CubicTo(Vector2f c1, Vector2f c2, Vector2f p)
+		{
+			const Vector2f p0 = current;
+			const float deviation = Math::Max((p0 - c1 * 2.f + c2).Magnitude(), (c1 - c2 * 2.f + p).Magnitude());
+			const int num_segments = GetCurveSegmentCount(0.75f * deviation);
+			for (int i = 1; i < num_segments; i++)
+			{
+				const float t = float(i) / float(num_segments);
+				const float s = 1.f - t;
+				LineTo(p0 * (s * s * s) + c1 * (3.f * s * s * t) + c2 * (3.f * s * t * t) + p * (t * t * t));
+			}
+			LineTo(p);
+		}
+		// Adds an elliptical arc in the endpoint parameterization of SVG paths.
+		void ArcTo(float rx, float ry, float x_axis_rotation, bool large_arc, bool sweep, Vector2f p)
+		{
+			const Vector2f p0 = current;
+			if (p0 == p)
+				return;
+
+			rx = Math::Absolute(rx);
+			ry = Math::Absolute(ry);
+			if (rx == 0.f || ry == 0.f)
+			{
+				LineTo(p);
+				return;
+			}
+
+			// Convert to the center parameterization, see the implementation notes of the SVG specification.
+			const float phi = Math::DegreesToRadians(x_axis_rotation);
+			const float cos_phi = Math::Cos(phi);
+			const float sin_phi = Math::Sin(phi);
+			const Vector2f half_delta = (p0 - p) * 0.5f;
+			const Vector2f q = {cos_phi * half_delta.x + sin_phi * half_delta.y, -sin_phi * half_delta.x + cos_phi * half_delta.y};
+
+			const float lambda = (q.x * q.x) / (rx * rx) + (q.y * q.y) / (ry * ry);
+			if (lambda > 1.f)
+			{
+				rx *= Math::SquareRoot(lambda);
+				ry *= Math::SquareRoot(lambda);
+			}
+
+			const float numerator = rx * rx * ry * ry - rx * rx * q.y * q.y - ry * ry * q.x * q.x;
+			const float denominator = rx * rx * q.y * q.y + ry * ry * q.x * q.x;
+			float coefficient = (denominator > 0.f ? Math::SquareRoot(Math::Max(numerator / denominator, 0.f)) : 0.f);
+			if (large_arc == sweep)
+				coefficient = -coefficient;
+
+			const Vector2f center_q = {coefficient * rx * q.y / ry, -coefficient * ry * q.x / rx};
+			const Vector2f mid = (p0 + p) * 0.5f;
+			const Vector2f center = {cos_phi * center_q.x - sin_phi * center_q.y + mid.x, sin_phi * center_q.x + cos_phi * center_q.y + mid.y};
+
+			const float theta_start = Math::ATan2((q.y - center_q.y) / ry, (q.x - center_q.x) / rx);
+			const float theta_end = Math::ATan2((-q.y - center_q.y) / ry, (-q.x - center_q.x) / rx);
+			float theta_delta = theta_end - theta_start;
+			if (sweep && theta_delta < 0.f)
+				theta_delta += 2.f * Math::RMLUI_PI;
+			else if (!sweep && theta_delta > 0.f)
+				theta_delta -= 2.f * Math::RMLUI_PI;
+
+			const int num_segments = GetArcSegmentCount(theta_delta, Math::Max(rx, ry), tolerance);
+			for (int i = 1; i < num_segments; i++)
+			{
+				const float theta = theta_start + theta_delta * float(i) / float(num_segments);
+				const Vector2f r = {rx * Math::Cos(theta), ry * Math::Sin(theta)};
+				LineTo({cos_phi * r.x - sin_phi * r.y + center.x, sin_phi * r.x + cos_phi * r.y + center.y});
+			}
+			LineTo(p);
+		}
+		void Ellipse(Vector2f center, float rx, float ry)
+		{
+			const int num_segments = GetArcSegmentCount(2.f * Math::RMLUI_PI, Math::Max(rx, ry), tolerance);
+			MoveTo(center + Vector2f(rx, 0.f));
+			for (int i = 1; i < num_segments; i++)
+			{
+				const float theta = 2.f * Math::RMLUI_PI * float(i) / float(num_segments);
+				LineTo(center + Vector2f(rx * Math::Cos(theta), ry * Math::Sin(theta)));
+			}
+			Close();
+		}
+		void Close()
+		{
+			if (contours.empty() || contours.back().closed)
+				return;
+			contours.back().closed = true;
+			current = start;
+		}
+
+	private:
+		// Returns the number of segments needed to flatten a curve, given the maximum magnitude of its second derivative (Wang's formula).
+		int GetCurveSegmentCount(float deviation) const
+		{
+			return Math::Clamp(int(Math::RoundUp(Math::SquareRoot(deviation / tolerance))), 1, max_curve_segments);
+		}
+
+		ContourList& contours;
+		float tolerance;
+		Vector2f start, current;
+	};
+
+	bool IsCommand(char c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+	}
+
+	// Parses SVG path data. Parsing stops at the first error, keeping the path up to that point, as the SVG specification requires.
+	void ParsePath(PathBuilder& path, const String& data)
+	{
+		NumberReader reader(data);
+		char command = 0;
+		char previous_command = 0;
+		Vector2f previous_control;
+
+		while (!reader.AtEnd())
+		{
+			if (IsCommand(reader.Peek()))
+			{
+				command = reader.Peek();
+				reader.Skip();
+			}
+			else if (command == 0)
+			{
+				return;
+			}
+
+			const bool relative = (command >= 'a' && command <= 'z');
+			const Vector2f origin = (relative ? path.GetCurrentPoint() : Vector2f(0.f));
+			const char upper_command = (relative ? char(command - 'a' + 'A') : command);
+
+			float v[7] = {};
+			auto read = [&reader, &v](int count) {
+				for (int i = 0; i < count; i++)
+				{
+					if (!reader.ReadNumber(v[i]))
+						return false;
+				}
+				return true;
+			};
+
+			switch (upper_command)
+			{
+			case 'M':
+				if (!read(2))
+					return;
+				path.MoveTo(origin + Vector2f(v[0], v[1]));
+				// Further coordinate pairs are implicit line commands.
+				command = (relative ? 'l' : 'L');
+				break;
+			case 'L':
+				if (!read(2))
+					return;
+				path.LineTo(origin + Vector2f(v[0], v[1]));
+				break;
+			case 'H':
+				if (!read(1))
+					return;
+				path.LineTo({origin.x + v[0], path.GetCurrentPoint().y});
+				break;
+			case 'V':
+				if (!read(1))
+					return;
+				path.LineTo({path.GetCurrentPoint().x, origin.y + v[0]});
+				break;
+			case 'C':
+				if (!read(6))
+					return;
+				previous_control = origin + Vector2f(v[2], v[3]);
+				path.CubicTo(origin + Vector2f(v[0], v[1]), previous_control, origin + Vector2f(v[4], v[5]));
+				break;
+			case 'S':
+			{
+				if (!read(4))
+					return;
+				const Vector2f current = path.GetCurrentPoint();
+				const Vector2f control = (previous_command == 'C' || previous_command == 'S' ? current * 2.f - previous_control : current);
+				previous_control = origin + Vector2f(v[0], v[1]);
+				path.CubicTo(control, previous_control, origin + Vector2f(v[2], v[3]));
+			}
+			break;
+			case 'Q':
+				if (!read(4))
+					return;
+				previous_control = origin + Vector2f(v[0], v[1]);
+				path.QuadraticTo(previous_control, origin + Vector2f(v[2], v[3]));
+				break;
+			case 'T':
+			{
+				if (!read(2))
+					return;
+				const Vector2f current = path.GetCurrentPoint();
+				previous_control = (previous_command == 'Q' || previous_command == 'T' ? current * 2.f - previous_control : current);
+				path.QuadraticTo(previous_control, origin + Vector2f(v[0], v[1]));
+			}
+			break;
+			case 'A':
+			{
+				bool large_arc = false, sweep = false;
+				if (!read(3) || !reader.ReadFlag(large_arc) || !reader.ReadFlag(sweep) || !reader.ReadNumber(v[3]) || !reader.ReadNumber(v[4]))
+					return;
+				path.ArcTo(v[0], v[1], v[2], large_arc, sweep, origin + Vector2f(v[3], v[4]));
+			}
+			break;
+			case 'Z':
+				path.Close();
+				// Only a new command may follow.
+				command = 0;
+				break;
+			default: return;
+			}
+
+			previous_command = upper_command;
+		}
+	}
+
+	void ParsePoints(PathBuilder& path, const String& data, bool close)
+	{
+		NumberReader reader(data);
+		Vector2f p;
+		for (bool first = true; reader.ReadNumber(p.x) && reader.ReadNumber(p.y); first = false)
+		{
+			if (first)
+				path.MoveTo(p);
+			else
+				path.LineTo(p);
+		}
+		if (close)
+			path.Close();
+	}
+
+	// Parses a transform list, such as "translate(10, 20) rotate(45)".
+	Transform2D ParseTransform(const String& value)
+	{
+		Transform2D result;
+		size_t i = 0;
+		while (i < value.size())
+		{
+			const size_t open = value.find('(', i);
+			const size_t close = value.find(')', open);
+			if (open == String::npos || close == String::npos)
+				break;
+
+			const String name = StringUtilities::StripWhitespace(StringView(value, i, open - i));
+			const String arguments = value.substr(open + 1, close - open - 1);
+			i = close + 1;
+			while (i < value.size() && (value[i] == ',' || StringUtilities::IsWhitespace(value[i])))
+				i++;
+
+			float v[6] = {};
+			int count = 0;
+			NumberReader reader(arguments);
+			while (count < 6 && reader.ReadNumber(v[count]))
+				count++;
+
+			Transform2D transform;
+			if (name == "matrix" && count == 6)
+			{
+				transform = {v[0], v[1], v[2], v[3], v[4], v[5]};
+			}
+			else if (name == "translate" && count >= 1)
+			{
+				transform.e = v[0];
+				transform.f = (count >= 2 ? v[1] : 0.f);
+			}
+			else if (name == "scale" && count >= 1)
+			{
+				transform.a = v[0];
+				transform.d = (count >= 2 ? v[1] : v[0]);
+			}
+			else if (name == "rotate" && count >= 1)
+			{
+				const float angle = Math::DegreesToRadians(v[0]);
+				const Transform2D rotation = {Math::Cos(angle), Math::Sin(angle), -Math::Sin(angle), Math::Cos(angle), 0.f, 0.f};
+				if (count >= 3)
+					transform = Transform2D{1, 0, 0, 1, v[1], v[2]} * rotation * Transform2D{1, 0, 0, 1, -v[1], -v[2]};
+				else
+					transform = rotation;
+			}
+			else if (name == "skewX" && count >= 1)
+			{
+				transform.c = Math::Tan(Math::DegreesToRadians(v[0]));
+			}
+			else if (name == "skewY" && count >= 1)
+			{
+				transform.b = Math::Tan(Math::DegreesToRadians(v[0]));
+			}
+			else
+			{
+				break;
+			}
+
+			result = result * transform;
+		}
+		return result;
+	}
+
+	// Parses a length or number, ignoring any units.
+	float ParseLength(const String& value, float default_value)
+	{
+		NumberReader reader(value);
+		float result = 0.f;
+		return reader.ReadNumber(result) ? result : default_value;
+	}
+
+	float ParseOpacity(const String& value)
+	{
+		float result = ParseLength(value, 1.f);
+		if (!value.empty() && value.back() == '%')
+			result *= 0.01f;
+		return Math::Clamp(result, 0.f, 1.f);
+	}
+
+	Paint ParsePaint(const String& value, const Paint& default_value)
+	{
+		Paint paint;
+		String colour = value;
+		if (StringUtilities::StartsWith(colour, "url("))
+		{
+			// Paint servers are not supported, use the fallback color if any.
+			const size_t close = colour.find(')');
+			colour = (close == String::npos ? String() : StringUtilities::StripWhitespace(colour.substr(close + 1)));
+			if (colour.empty())
+				return paint;
+		}
+
+		if (colour == "none" || colour == "transparent")
+			return paint;
+
+		paint.enabled = true;
+		if (colour == "currentColor" || colour == "currentcolor")
+			paint.current_color = true;
+		else if (!PropertyParserColour::ParseColour(paint.colour, colour))
+			return default_value;
+
+		return paint;
+	}
+
+	void ApplyProperty(Style& style, const String& name, const String& value)
+	{
+		if (value == "inherit")
+			return;
+
+		if (name == "fill")
+			style.fill = ParsePaint(value, style.fill);
+		else if (name == "fill-opacity")
+			style.fill_opacity = ParseOpacity(value);
+		else if (name == "fill-rule")
+			style.fill_even_odd = (value == "evenodd");
+		else if (name == "stroke")
+			style.stroke = ParsePaint(value, style.stroke);
+		else if (name == "stroke-opacity")
+			style.stroke_opacity = ParseOpacity(value);
+		else if (name == "stroke-width")
+			style.stroke_width = Math::Max(ParseLength(value, 1.f), 0.f);
+		else if (name == "stroke-linejoin")
+			style.stroke_join = (value == "round" ? LineJoin::Round : (value == "bevel" ? LineJoin::Bevel : LineJoin::Miter));
+		else if (name == "stroke-linecap")
+			style.stroke_cap = (value == "round" ? LineCap::Round : (value == "square" ? LineCap::Square : LineCap::Butt));
+		else if (name == "stroke-miterlimit")
+			style.stroke_miter_limit = Math::Max(ParseLength(value, 4.f), 1.f);
+		else if (name == "opacity")
+			style.opacity = ParseOpacity(value);
+		else if (name == "color")
+			PropertyParserColour::ParseColour(style.color, value);
+		else if (name == "display")
+			style.skip |= (value == "none");
+		else if (name == "visibility")
+			style.hidden = (value == "hidden" || value == "collapse");
+	}
+
+	void ApplyStyleAttribute(Style& style, const String& value)
+	{
+		StringList declarations;
+		StringUtilities::ExpandString(declarations, value, ';');
+		for (const String& declaration : declarations)
+		{
+			const size_t colon = declaration.find(':');
+			if (colon == String::npos)
+				continue;
+			ApplyProperty(style, StringUtilities::StripWhitespace(declaration.substr(0, colon)),
+				StringUtilities::StripWhitespace(declaration.substr(colon + 1)));
+		}
+	}
+
+	ColourbPremultiplied GetPaintColour(const Style& style, const Paint& paint, float opacity)
+	{
+		const Colourb colour = (paint.current_color ? style.color : paint.colour);
+		return colour.ToPremultiplied(opacity * style.opacity * style.inherited_opacity);
+	}
+
+	void AddTriangle(Mesh& mesh, Vector2f a, Vector2f b, Vector2f c, ColourbPremultiplied colour)
+	{
+		const int index = int(mesh.vertices.size());
+		mesh.vertices.push_back(Vertex{a, colour, Vector2f(0.f)});
+		mesh.vertices.push_back(Vertex{b, colour, Vector2f(0.f)});
+		mesh.vertices.push_back(Vertex{c, colour, Vector2f(0.f)});
+		mesh.indices.insert(mesh.indices.end(), {index, index + 1, index + 2});
+	}
+
+	void AddQuad(Mesh& mesh, Vector2f a, Vector2f b, Vector2f c, Vector2f d, ColourbPremultiplied colour)
+	{
+		const int index = int(mesh.vertices.size());
+		mesh.vertices.push_back(Vertex{a, colour, Vector2f(0.f)});
+		mesh.vertices.push_back(Vertex{b, colour, Vector2f(0.f)});
+		mesh.vertices.push_back(Vertex{c, colour, Vector2f(0.f)});
+		mesh.vertices.push_back(Vertex{d, colour, Vector2f(0.f)});
+		mesh.indices.insert(mesh.indices.end(), {index, index + 1, index + 2, index, index + 2, index + 3});
+	}
+
+	// Adds a triangle fan around the center, from the offset rotated by the given angle.
+	void AddArcFan(Mesh& mesh, Vector2f center, Vector2f offset, float angle, float tolerance, ColourbPremultiplied colour)
+	{
+		const int num_segments = GetArcSegmentCount(angle, offset.Magnitude(), tolerance);
+		Vector2f previous = center + offset;
+		for (int i = 1; i <= num_segments; i++)
+		{
+			const Vector2f next = center + offset.Rotate(angle * float(i) / float(num_segments));
+			AddTriangle(mesh, center, previous, next, colour);
+			previous = next;
+		}
+	}
+
+	struct Edge {
+		Vector2f top, bottom;
+		int winding;
+	};
+
+	float GetEdgeX(const Edge& edge, float y)
+	{
+		return edge.top.x + (edge.bottom.x - edge.top.x) * (y - edge.top.y) / (edge.bottom.y - edge.top.y);
+	}
+
+	bool IntersectEdges(const Edge& a, const Edge& b, float& out_y)
+	{
+		const Vector2f r = a.bottom - a.top;
+		const Vector2f s = b.bottom - b.top;
+		const float denominator = r.x * s.y - r.y * s.x;
+		if (denominator == 0.f)
+			return false;
+
+		const Vector2f d = b.top - a.top;
+		const float t = (d.x * s.y - d.y * s.x) / denominator;
+		const float u = (d.x * r.y - d.y * r.x) / denominator;
+		if (t <= 0.f || t >= 1.f || u <= 0.f || u >= 1.f)
+			return false;
+
+		out_y = a.top.y + t * r.y;
+		return true;
+	}
+
+	// Fills the contours by splitting them into horizontal bands at every vertex and edge intersection. The edges do not cross within a
+	// band, thus the filled spans between them, as determined by the fill rule, are trapezoids.
+	void FillContours(Mesh& mesh, const ContourList& contours, bool even_odd, ColourbPremultiplied colour)
+	{
+		Vector<Edge> edges;
+		Vector<float> band_limits;
+		for (const Contour& contour : contours)
+		{
+			const Vector<Vector2f>& points = contour.points;
+			for (size_t i = 0; i < points.size(); i++)
+			{
+				const Vector2f a = points[i];
+				const Vector2f b = points[(i + 1) % points.size()];
+				if (a.y == b.y)
+					continue;
+				edges.push_back(a.y < b.y ? Edge{a, b, 1} : Edge{b, a, -1});
+				band_limits.push_back(a.y);
+			}
+		}
+		if (edges.empty())
+			return;
+
+		std::sort(edges.begin(), edges.end(), [](const Edge& lhs, const Edge& rhs) { return lhs.top.y < rhs.top.y; });
+
+		for (size_t i = 0; i < edges.size(); i++)
+		{
+			for (size_t j = i + 1; j < edges.size() && edges[j].top.y < edges[i].bottom.y; j++)
+			{
+				float y = 0.f;
+				if (IntersectEdges(edges[i], edges[j], y))
+					band_limits.push_back(y);
+			}
+		}
+
+		std::sort(band_limits.begin(), band_limits.end());
+		band_limits.erase(std::unique(band_limits.begin(), band_limits.end()), band_limits.end());
+
+		struct Crossing {
+			float x_top, x_bottom, x_mid;
+			int winding;
+		};
+		Vector<Crossing> crossings;
+
+		for (size_t band = 0; band + 1 < band_limits.size(); band++)
+		{
+			const float y_top = band_limits[band];
+			const float y_bottom = band_limits[band + 1];
+			const float y_mid = 0.5f * (y_top + y_bottom);
+
+			crossings.clear();
+			for (const Edge& edge : edges)
+			{
+				if (edge.top.y >= y_bottom)
+					break;
+				if (edge.bottom.y > y_top)
+					crossings.push_back(Crossing{GetEdgeX(edge, y_top), GetEdgeX(edge, y_bottom), GetEdgeX(edge, y_mid), edge.winding});
+			}
+
+			std::sort(crossings.begin(), crossings.end(), [](const Crossing& lhs, const Crossing& rhs) { return lhs.x_mid < rhs.x_mid; });
+
+			int winding = 0;
+			const Crossing* left = nullptr;
+			for (const Crossing& crossing : crossings)
+			{
+				winding += crossing.winding;
+				const bool inside = (even_odd ? (winding & 1) != 0 : winding != 0);
+				if (inside && !left)
+				{
+					left = &crossing;
+				}
+				else if (!inside && left)
+				{
+					AddQuad(mesh, {left->x_top, y_top}, {crossing.x_top, y_top}, {crossing.x_bottom, y_bottom}, {left->x_bottom, y_bottom}, colour);
+					left = nullptr;
+				}
+			}
+		}
+	}
+
+	void StrokeJoin(Mesh& mesh, Vector2f p, Vector2f direction_in, Vector2f direction_out, float half_width, const Style& style, float tolerance,
+		ColourbPremultiplied colour)
+	{
+		const float cross = direction_in.x * direction_out.y - direction_in.y * direction_out.x;
+		const float dot = direction_in.DotProduct(direction_out);
+		if (Math::Absolute(cross) < 1e-6f && dot > 0.f)
+			return;
+
+		// Offset to the outer side of the corner, where the segments leave a gap.
+		const float side = (cross > 0.f ? -1.f : 1.f);
+		const Vector2f offset_in = Vector2f(-direction_in.y, direction_in.x) * (half_width * side);
+		const Vector2f offset_out = Vector2f(-direction_out.y, direction_out.x) * (half_width * side);
+
+		switch (style.stroke_join)
+		{
+		case LineJoin::Miter:
+		{
+			const float half_angle_sin = Math::SquareRoot(Math::Max(0.5f * (1.f + dot), 0.f));
+			if (half_angle_sin > 0.f && 1.f / half_angle_sin <= style.stroke_miter_limit)
+			{
+				const Vector2f miter = p + (offset_in + offset_out).Normalise() * (half_width / half_angle_sin);
+				AddQuad(mesh, p, p + offset_in, miter, p + offset_out, colour);
+				break;
+			}
+			AddTriangle(mesh, p, p + offset_in, p + offset_out, colour);
+		}
+		break;
+		case LineJoin::Round:
+		{
+			const float angle = Math::ATan2(cross, dot);
+			AddArcFan(mesh, p, offset_in, angle, tolerance, colour);
+		}
+		break;
+		case LineJoin::Bevel: AddTriangle(mesh, p, p + offset_in, p + offset_out, colour); break;
+		}
+	}
+
+	void StrokeContour(Mesh& mesh, const Contour& contour, float width, const Style& style, float tolerance, ColourbPremultiplied colour)
+	{
+		Vector<Vector2f> points;
+		points.reserve(contour.points.size());
+		for (const Vector2f p : contour.points)
+		{
+			if (points.empty() || (p - points.back()).SquaredMagnitude() > 1e-12f)
+				points.push_back(p);
+		}
+
+		const bool closed = contour.closed && points.size() > 2;
+		if (closed && (points.front() - points.back()).SquaredMagnitude() <= 1e-12f)
+			points.pop_back();
+
+		const float half_width = 0.5f * width;
+		if (points.size() < 2)
+		{
+			// Zero-length subpaths are only drawn with round and square caps.
+			if (points.size() == 1 && style.stroke_cap == LineCap::Round)
+				AddArcFan(mesh, points[0], Vector2f(half_width, 0.f), 2.f * Math::RMLUI_PI, tolerance, colour);
+			else if (points.size() == 1 && style.stroke_cap == LineCap::Square)
+				AddQuad(mesh, points[0] + Vector2f(-half_width, -half_width), points[0] + Vector2f(half_width, -half_width),
+					points[0] + Vector2f(half_width, half_width), points[0] + Vector2f(-half_width, half_width), colour);
+			return;
+		}
+
+		const size_t num_points = points.size();
+		const size_t num_segments = (closed ? num_points : num_points - 1);
+		for (size_t i = 0; i < num_segments; i++)
+		{
+			Vector2f a = points[i];
+			Vector2f b = points[(i + 1) % num_points];
+			const Vector2f direction = (b - a).Normalise();
+			const Vector2f normal = Vector2f(-direction.y, direction.x) * half_width;
+
+			if (!closed && style.stroke_cap == LineCap::Square)
+			{
+				if (i == 0)
+					a = a - direction * half_width;
+				if (i == num_segments - 1)
+					b = b + direction * half_width;
+			}
+
+			AddQuad(mesh, a + normal, b + normal, b - normal, a - normal, colour);
+		}
+
+		for (size_t i = (closed ? 0 : 1); i < (closed ? num_points : num_points - 1); i++)
+		{
+			const Vector2f previous = points[(i + num_points - 1) % num_points];
+			const Vector2f next = points[(i + 1) % num_points];
+			StrokeJoin(mesh, points[i], (points[i] - previous).Normalise(), (next - points[i]).Normalise(), half_width, style, tolerance, colour);
+		}
+
+		if (!closed && style.stroke_cap == LineCap::Round)
+		{
+			const Vector2f direction_start = (points[1] - points[0]).Normalise();
+			const Vector2f direction_end = (points[num_points - 1] - points[num_points - 2]).Normalise();
+			AddArcFan(mesh, points[0], Vector2f(-direction_start.y, direction_start.x) * half_width, Math::RMLUI_PI, tolerance, colour);
+			AddArcFan(mesh, points[num_points - 1], Vector2f(direction_end.y, -direction_end.x) * half_width, Math::RMLUI_PI, tolerance, colour);
+		}
+	}
+
+	class SVGShapeParser : public BaseXMLParser {
+	public:
+		explicit SVGShapeParser(Mesh& mesh) : mesh(mesh) {}
+
+		bool HasRoot() const { return has_root; }
+		Vector2f GetDimensions() const { return dimensions; }
+
+		void HandleElementStart(const String& name, const XMLAttributes& attributes) override
+		{
+			Style style;
+			if (!styles.empty())
+			{
+				style = styles.back();
+				style.inherited_opacity *= style.opacity;
+				style.opacity = 1.f;
+			}
+
+			if (!has_root)
+			{
+				if (name == "svg")
+				{
+					has_root = true;
+					InitializeViewport(style, attributes);
+				}
+				else
+				{
+					style.skip = true;
+				}
+			}
+
+			static const StringList skipped_elements = {"clipPath", "defs", "desc", "filter", "foreignObject", "image", "linearGradient", "marker",
+				"mask", "metadata", "pattern", "radialGradient", "style", "switch", "symbol", "text", "title", "use"};
+			if (std::find(skipped_elements.begin(), skipped_elements.end(), name) != skipped_elements.end())
+				style.skip = true;
+
+			if (!style.skip)
+			{
+				static const StringList properties = {"fill", "fill-opacity", "fill-rule", "stroke", "stroke-opacity", "stroke-width",
+					"stroke-linejoin", "stroke-linecap", "stroke-miterlimit", "opacity", "color", "display", "visibility"};
+				for (const String& property : properties)
+				{
+					if (const Variant* value = GetIf(attributes, property))
+						ApplyProperty(style, property, StringUtilities::StripWhitespace(value->Get<String>()));
+				}
+				if (const Variant* value = GetIf(attributes, "style"))
+					ApplyStyleAttribute(style, value->Get<String>());
+				if (const Variant* value = GetIf(attributes, "transform"))
+					style.transform = style.transform * ParseTransform(value->Get<String>());
+			}
+
+			styles.push_back(style);
+
+			if (!style.skip && !style.hidden)
+				AddShape(name, attributes, style);
+		}
+
+		void HandleElementEnd(const String& /*name*/) override
+		{
+			if (!styles.empty())
+				styles.pop_back();
+		}
+
+	private:
+		static float GetNumber(const XMLAttributes& attributes, const String& name, float default_value = 0.f)
+		{
+			const Variant* value = GetIf(attributes, name);
+			return value ? ParseLength(value->Get<String>(), default_value) : default_value;
+		}
+
+		void InitializeViewport(Style& style, const XMLAttributes& attributes)
+		{
+			float view_box[4] = {};
+			bool has_view_box = false;
+			if (const Variant* value = GetIf(attributes, "viewBox"))
+			{
+				NumberReader reader(value->Get<String>());
+				has_view_box =
+					reader.ReadNumber(view_box[0]) && reader.ReadNumber(view_box[1]) && reader.ReadNumber(view_box[2]) && reader.ReadNumber(view_box[3]);
+				has_view_box &= (view_box[2] > 0.f && view_box[3] > 0.f);
+			}
+
+			// Relative dimensions are resolved against the view box, or the default size of replaced elements.
+			auto get_dimension = [&](const String& name, float default_value) {
+				const Variant* value = GetIf(attributes, name);
+				const String dimension = (value ? value->Get<String>() : String());
+				if (dimension.empty() || dimension.back() == '%' || dimension == "auto")
+					return default_value;
+				return ParseLength(dimension, default_value);
+			};
+			dimensions.x = Math::Max(get_dimension("width", has_view_box ? view_box[2] : 300.f), 1.f);
+			dimensions.y = Math::Max(get_dimension("height", has_view_box ? view_box[3] : 150.f), 1.f);
+
+			tolerance = Math::Max(dimensions.x, dimensions.y) * curve_tolerance_factor;
+
+			if (!has_view_box)
+				return;
+
+			// Map the view box into the viewport according to the preserveAspectRatio attribute, by default centered and scaled to fit.
+			const Variant* aspect_ratio_value = GetIf(attributes, "preserveAspectRatio");
+			const String aspect_ratio = (aspect_ratio_value ? aspect_ratio_value->Get<String>() : String());
+
+			Vector2f scale = {dimensions.x / view_box[2], dimensions.y / view_box[3]};
+			Vector2f align = {0.5f, 0.5f};
+			if (aspect_ratio.find("none") == String::npos)
+			{
+				const bool slice = (aspect_ratio.find("slice") != String::npos);
+				scale.x = scale.y = (slice ? Math::Max(scale.x, scale.y) : Math::Min(scale.x, scale.y));
+				if (aspect_ratio.find("xMin") != String::npos)
+					align.x = 0.f;
+				else if (aspect_ratio.find("xMax") != String::npos)
+					align.x = 1.f;
+				if (aspect_ratio.find("YMin") != String::npos)
+					align.y = 0.f;
+				else if (aspect_ratio.find("YMax") != String::npos)
+					align.y = 1.f;
+			}
+
+			const Vector2f offset = (dimensions - Vector2f(view_box[2], view_box[3]) * scale) * align;
+			style.transform = {scale.x, 0.f, 0.f, scale.y, offset.x - view_box[0] * scale.x, offset.y - view_box[1] * scale.y};
+		}
+
+		void AddShape(const String& name, const XMLAttributes& attributes, const Style& style)
+		{
+			const float scale = style.transform.Scale();
+			if (scale <= 0.f)
+				return;
+
+			ContourList contours;
+			PathBuilder path(contours, tolerance / scale);
+
+			if (name == "path")
+			{
+				if (const Variant* value = GetIf(attributes, "d"))
+					ParsePath(path, value->Get<String>());
+			}
+			else if (name == "rect")
+			{
+				const Vector2f p = {GetNumber(attributes, "x"), GetNumber(attributes, "y")};
+				const Vector2f size = {GetNumber(attributes, "width"), GetNumber(attributes, "height")};
+				if (size.x <= 0.f || size.y <= 0.f)
+					return;
+
+				const bool has_rx = (GetIf(attributes, "rx") != nullptr);
+				const bool has_ry = (GetIf(attributes, "ry") != nullptr);
+				float rx = GetNumber(attributes, "rx");
+				float ry = GetNumber(attributes, "ry");
+				if (has_rx && !has_ry)
+					ry = rx;
+				else if (has_ry && !has_rx)
+					rx = ry;
+				rx = Math::Clamp(rx, 0.f, 0.5f * size.x);
+				ry = Math::Clamp(ry, 0.f, 0.5f * size.y);
+
+				path.MoveTo({p.x + rx, p.y});
+				path.LineTo({p.x + size.x - rx, p.y});
+				path.ArcTo(rx, ry, 0.f, false, true, {p.x + size.x, p.y + ry});
+				path.LineTo({p.x + size.x, p.y + size.y - ry});
+				path.ArcTo(rx, ry, 0.f, false, true, {p.x + size.x - rx, p.y + size.y});
+				path.LineTo({p.x + rx, p.y + size.y});
+				path.ArcTo(rx, ry, 0.f, false, true, {p.x, p.y + size.y - ry});
+				path.LineTo({p.x, p.y + ry});
+				path.ArcTo(rx, ry, 0.f, false, true, {p.x + rx, p.y});
+				path.Close();
+			}
+			else if (name == "circle" || name == "ellipse")
+			{
+				const Vector2f center = {GetNumber(attributes, "cx"), GetNumber(attributes, "cy")};
+				const float rx = GetNumber(attributes, name == "circle" ? "r" : "rx");
+				const float ry = GetNumber(attributes, name == "circle" ? "r" : "ry");
+				if (rx <= 0.f || ry <= 0.f)
+					return;
+				path.Ellipse(center, rx, ry);
+			}
+			else if (name == "line")
+			{
+				path.MoveTo({GetNumber(attributes, "x1"), GetNumber(attributes, "y1")});
+				path.LineTo({GetNumber(attributes, "x2"), GetNumber(attributes, "y2")});
+			}
+			else if (name == "polyline" || name == "polygon")
+			{
+				if (const Variant* value = GetIf(attributes, "points"))
+					ParsePoints(path, value->Get<String>(), name == "polygon");
+			}
+			else
+			{
+				return;
+			}
+
+			for (Contour& contour : contours)
+			{
+				for (Vector2f& point : contour.points)
+					point = style.transform.Apply(point);
+			}
+
+			if (style.fill.enabled)
+				FillContours(mesh, contours, style.fill_even_odd, GetPaintColour(style, style.fill, style.fill_opacity));
+
+			if (style.stroke.enabled && style.stroke_width > 0.f)
+			{
+				const ColourbPremultiplied colour = GetPaintColour(style, style.stroke, style.stroke_opacity);
+				for (const Contour& contour : contours)
+					StrokeContour(mesh, contour, style.stroke_width * scale, style, tolerance, colour);
+			}
+		}
+
+		Mesh& mesh;
+		bool has_root = false;
+		Vector2f dimensions;
+		float tolerance = 1.f;
+		Vector<Style> styles;
+	};
+
+} // namespace
+
+bool SVGTessellator::Tessellate(Mesh& mesh, Vector2f& dimensions, const String& svg_source)
+{
+	// The XML parser does not support document type declarations, thus remove any such declaration including its internal subset.
+	String source_without_doctype;
+	const size_t doctype_begin = svg_source.find("<!DOCTYPE");
+	if (doctype_begin != String::npos)
+	{
+		size_t doctype_end = svg_source.find('>', doctype_begin);
+		const size_t subset_begin = svg_source.find('[', doctype_begin);
+		if (subset_begin < doctype_end)
+			doctype_end = svg_source.find('>', svg_source.find(']', subset_begin));
+		if (doctype_end == String::npos)
+			return false;
+
+		source_without_doctype = svg_source.substr(0, doctype_begin) + svg_source.substr(doctype_end + 1);
+	}
+	const String& source = (doctype_begin != String::npos ? source_without_doctype : svg_source);
+
+	StreamMemory stream(reinterpret_cast<const byte*>(source.data()), source.size());
+	SVGShapeParser parser(mesh);
+	parser.Parse(&stream);
+
+	if (!parser.HasRoot())
+		return false;
+
+	dimensions = parser.GetDimensions();
+	return true;
+}
+
+} // namespace SVG
+} // namespace Rml
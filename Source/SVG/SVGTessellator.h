@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+struct Mesh;
+
+namespace SVG {
+
+	/**
+	    Tessellates the shapes of an SVG document into triangles, for rendering the document as geometry instead of a rasterized texture.
+
+	    Paths and basic shapes are supported, with solid fills and strokes, inside groups with transforms and opacity. Gradients, patterns,
+	    text, images, masks, clipping paths, and references are skipped. Edges are not anti-aliased, and overlapping parts of translucent
+	    strokes are blended twice.
+	 */
+	class SVGTessellator {
+	public:
+		/// Tessellates the SVG document in the given source.
+		/// @param[out] mesh A mesh to append the triangles into, positioned in the viewport of the document, with premultiplied vertex colors.
+		/// @param[out] dimensions The dimensions of the viewport of the document.
+		/// @param[in] svg_source The SVG source data.
+		/// @return False if the source does not contain an SVG document.
+		static bool Tessellate(Mesh& mesh, Vector2f& dimensions, const String& svg_source);
+
+	private:
+		SVGTessellator() = delete;
+	};
+
+} // namespace SVG
+} // namespace Rml
@@ -0,0 +1,76 @@
+#include "AllocationCounter.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+
+namespace AllocationCounter {
+
+static thread_local Counters* active_counters = nullptr;
+
+static void CountAllocation(size_t size)
+{
+	if (Counters* counters = active_counters)
+	{
+		counters->num_allocations += 1;
+		counters->num_bytes += size;
+	}
+}
+
+static void* AllocateCounted(size_t size)
+{
+	CountAllocation(size);
+	if (void* pointer = std::malloc(size == 0 ? 1 : size))
+		return pointer;
+	throw std::bad_alloc();
+}
+
+Scope::Scope(Counters& counters) : previous_counters(active_counters)
+{
+	active_counters = &counters;
+}
+
+Scope::~Scope()
+{
+	active_counters = previous_counters;
+}
+
+void Report(ankerl::nanobench::Bench& bench, const std::string& name, const Counters& counters, size_t num_iterations)
+{
+	std::ostream* output = bench.output();
+	if (!output || num_iterations == 0)
+		return;
+
+	char buffer[128];
+	std::snprintf(buffer, sizeof(buffer), "|%18.2f allocs/op |%18.1f bytes/op | ", double(counters.num_allocations) / double(num_iterations),
+		double(counters.num_bytes) / double(num_iterations));
+	*output << buffer << '`' << name << "`\n";
+}
+
+} // namespace AllocationCounter
+
+// Replace the global allocation functions to count the allocations of the benchmarked operations.
+void* operator new(std::size_t size)
+{
+	return AllocationCounter::AllocateCounted(size);
+}
+void* operator new[](std::size_t size)
+{
+	return AllocationCounter::AllocateCounted(size);
+}
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+void operator delete[](void* pointer) noexcept
+{
+	std::free(pointer);
+}
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "BenchmarkBaseline.h"
+#include <cstddef>
+#include <nanobench.h>
+#include <string>
+
+/*
+    Counts the allocations made through the global operator new while benchmarking, which is replaced in the benchmarks target.
+
+    Only allocations made on the calling thread during the benchmarked operation are counted. Over-aligned allocations are not counted.
+*/
+namespace AllocationCounter {
+
+struct Counters {
+	size_t num_allocations = 0;
+	size_t num_bytes = 0;
+};
+
+// Counts all allocations made on the calling thread into the given counters during its lifetime.
+class Scope {
+public:
+	explicit Scope(Counters& counters);
+	~Scope();
+
+	Scope(const Scope&) = delete;
+	Scope& operator=(const Scope&) = delete;
+
+private:
+	Counters* previous_counters;
+};
+
+// Prints the allocations per iteration to the output of the benchmark, below the timing of the latest run.
+void Report(ankerl::nanobench::Bench& bench, const std::string& name, const Counters& counters, size_t num_iterations);
+
+// Runs the benchmark operation like nanobench's Bench::run(), additionally reporting the allocations per iteration, and recording the result
+// for comparison against the benchmark baseline.
+template <typename Op>
+ankerl::nanobench::Bench& Run(ankerl::nanobench::Bench& bench, const std::string& name, Op&& op)
+{
+	Counters counters;
+	size_t num_iterations = 0;
+
+	bench.run(name, [&] {
+		Scope scope(counters);
+		op();
+		num_iterations += 1;
+	});
+
+	Report(bench, name, counters, num_iterations);
+	BenchmarkBaseline::Record(bench, num_iterations == 0 ? 0.0 : double(counters.num_allocations) / double(num_iterations));
+	return bench;
+}
+
+} // namespace AllocationCounter
@@ -1,4 +1,5 @@
 #include "../Common/TestsShell.h"
+#include "AllocationCounter.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
@@ -69,7 +70,7 @@ TEST_CASE("background_border")
 
 	TestsShell::RenderLoop();
 
-	bench.run("Reference (update + render)", [&] {
+	AllocationCounter::Run(bench, "Reference (update + render)", [&] {
 		context->Update();
 		context->Render();
 	});
@@ -79,7 +80,7 @@ TEST_CASE("background_border")
 		document->QuerySelectorAll(elements, "div > div");
 		REQUIRE(!elements.empty());
 
-		bench.run("Background all", [&] {
+		AllocationCounter::Run(bench, "Background all", [&] {
 			// Force regeneration of backgrounds without changing layout
 			for (auto& element : elements)
 				element->SetProperty(Rml::PropertyId::BackgroundColor, Rml::Property(Colourb(), Unit::COLOUR));
@@ -87,7 +88,7 @@ TEST_CASE("background_border")
 			context->Render();
 		});
 
-		bench.run("Border all", [&] {
+		AllocationCounter::Run(bench, "Border all", [&] {
 			// Force regeneration of borders without changing layout
 			for (auto& element : elements)
 				element->SetProperty(Rml::PropertyId::BorderLeftColor, Rml::Property(Colourb(), Unit::COLOUR));
@@ -102,7 +103,7 @@ TEST_CASE("background_border")
 		document->QuerySelectorAll(elements, "#" + id + " > div");
 		REQUIRE(!elements.empty());
 
-		bench.run(("Border " + id).c_str(), [&] {
+		AllocationCounter::Run(bench, ("Border " + id).c_str(), [&] {
 			for (auto& element : elements)
 				element->SetProperty(Rml::PropertyId::BorderLeftColor, Rml::Property(Colourb(), Unit::COLOUR));
 			context->Update();
@@ -168,10 +169,10 @@ TEST_CASE("box_shadow")
 	ElementList elements;
 	document->QuerySelectorAll(elements, "#boxshadow > div");
 	REQUIRE(!elements.empty());
-	bench.run("Reference (update + render)", [&] { TestsShell::RenderLoop(false); });
+	AllocationCounter::Run(bench, "Reference (update + render)", [&] { TestsShell::RenderLoop(false); });
 
 	element_boxshadow->SetClass("blur", true);
-	bench.run("Box-shadow (repeated)", [&] {
+	AllocationCounter::Run(bench, "Box-shadow (repeated)", [&] {
 		// Force regeneration of backgrounds without changing layout
 		for (auto& element : elements)
 			element->SetProperty(Rml::PropertyId::BackgroundColor, Rml::Property(Colourb(), Unit::COLOUR));
@@ -180,7 +181,7 @@ TEST_CASE("box_shadow")
 
 	unsigned int unique_id = 0;
 	element_boxshadow->SetClass("blur", false);
-	bench.run("Box-shadow (unique)", [&] {
+	AllocationCounter::Run(bench, "Box-shadow (unique)", [&] {
 		for (Element* element : elements)
 		{
 			unique_id += 1;
@@ -0,0 +1,186 @@
+#include "BenchmarkBaseline.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace BenchmarkBaseline {
+
+struct Entry {
+	std::string title;
+	std::string name;
+	double ns_per_op = 0;
+	double allocations_per_op = 0;
+	double threshold_percent = -1; // Negative to use the default threshold.
+};
+
+using Key = std::pair<std::string, std::string>;
+
+static std::vector<Entry> recorded_entries;
+
+// Tabs and line breaks would break the columns of the file format.
+static std::string SanitizeColumn(std::string column)
+{
+	for (char& c : column)
+	{
+		if (c == '\t' || c == '\n' || c == '\r')
+			c = ' ';
+	}
+	return column;
+}
+
+void Record(const ankerl::nanobench::Bench& bench, double allocations_per_op)
+{
+	if (bench.results().empty())
+		return;
+
+	const ankerl::nanobench::Result& result = bench.results().back();
+	const ankerl::nanobench::Config& config = result.config();
+
+	Entry entry;
+	entry.title = SanitizeColumn(config.mBenchmarkTitle);
+	entry.name = SanitizeColumn(config.mBenchmarkName);
+
+	// The same benchmark may be run for several problem sizes, keep them apart.
+	if (config.mComplexityN >= 0)
+		entry.name += " (N=" + std::to_string((long long)config.mComplexityN) + ")";
+
+	entry.ns_per_op = result.median(ankerl::nanobench::Result::Measure::elapsed) * 1e9;
+	entry.allocations_per_op = allocations_per_op;
+	recorded_entries.push_back(std::move(entry));
+}
+
+static bool ReadEntries(const char* path, std::map<Key, Entry>& entries)
+{
+	std::ifstream file(path);
+	if (!file)
+		return false;
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		std::vector<std::string> columns;
+		std::istringstream stream(line);
+		std::string column;
+		while (std::getline(stream, column, '\t'))
+			columns.push_back(column);
+
+		if (columns.size() < 4)
+		{
+			std::cerr << "Skipping malformed line in benchmark baseline: " << line << '\n';
+			continue;
+		}
+
+		Entry entry;
+		entry.title = columns[0];
+		entry.name = columns[1];
+		entry.ns_per_op = std::atof(columns[2].c_str());
+		entry.allocations_per_op = std::atof(columns[3].c_str());
+		if (columns.size() >= 5 && !columns[4].empty())
+			entry.threshold_percent = std::atof(columns[4].c_str());
+
+		entries[Key(entry.title, entry.name)] = std::move(entry);
+	}
+
+	return true;
+}
+
+static bool WriteEntries(const char* path, const std::map<Key, Entry>& baseline)
+{
+	std::ofstream file(path);
+	if (!file)
+		return false;
+
+	file << "# title\tname\tns/op\tallocs/op\tthreshold %\n";
+	for (const Entry& entry : recorded_entries)
+	{
+		char buffer[128];
+		std::snprintf(buffer, sizeof(buffer), "%.3f\t%.2f", entry.ns_per_op, entry.allocations_per_op);
+		file << entry.title << '\t' << entry.name << '\t' << buffer;
+
+		// Keep the thresholds of the baseline, so that the results can replace it directly.
+		auto it = baseline.find(Key(entry.title, entry.name));
+		if (it != baseline.end() && it->second.threshold_percent >= 0)
+			file << '\t' << it->second.threshold_percent;
+		file << '\n';
+	}
+
+	return true;
+}
+
+static bool IsRegression(double value, double baseline_value, double threshold_percent)
+{
+	return value > baseline_value * (1.0 + threshold_percent / 100.0);
+}
+
+int Finish()
+{
+	const char* results_path = std::getenv("RMLUI_BENCHMARKS_RESULTS_FILE");
+	const char* baseline_path = std::getenv("RMLUI_BENCHMARKS_BASELINE_FILE");
+	const char* threshold_string = std::getenv("RMLUI_BENCHMARKS_REGRESSION_THRESHOLD");
+	const double default_threshold_percent = (threshold_string ? std::atof(threshold_string) : 10.0);
+
+	int result = 0;
+	std::map<Key, Entry> baseline;
+
+	if (baseline_path && !ReadEntries(baseline_path, baseline))
+	{
+		std::cerr << "Could not read benchmark baseline from " << baseline_path << '\n';
+		result = 1;
+	}
+
+	if (results_path && !WriteEntries(results_path, baseline))
+	{
+		std::cerr << "Could not write benchmark results to " << results_path << '\n';
+		result = 1;
+	}
+
+	if (!baseline_path || baseline.empty())
+		return result;
+
+	int num_regressions = 0;
+	int num_missing = 0;
+	std::cout << "\nComparison against the benchmark baseline " << baseline_path << ":\n";
+
+	for (const Entry& entry : recorded_entries)
+	{
+		auto it = baseline.find(Key(entry.title, entry.name));
+		if (it == baseline.end())
+		{
+			num_missing += 1;
+			std::cout << "  [no baseline] " << entry.title << " / " << entry.name << '\n';
+			continue;
+		}
+
+		const Entry& base = it->second;
+		const double threshold_percent = (base.threshold_percent >= 0 ? base.threshold_percent : default_threshold_percent);
+		const bool time_regressed = IsRegression(entry.ns_per_op, base.ns_per_op, threshold_percent);
+		const bool allocations_regressed = IsRegression(entry.allocations_per_op, base.allocations_per_op, threshold_percent);
+		if (!time_regressed && !allocations_regressed)
+			continue;
+
+		num_regressions += 1;
+		char buffer[256];
+		std::snprintf(buffer, sizeof(buffer), "%.1f ns/op (baseline %.1f), %.2f allocs/op (baseline %.2f), threshold %.1f%%", entry.ns_per_op,
+			base.ns_per_op, entry.allocations_per_op, base.allocations_per_op, threshold_percent);
+		std::cout << "  [regression] " << entry.title << " / " << entry.name << ": " << buffer << '\n';
+	}
+
+	std::cout << "  " << recorded_entries.size() << " benchmarks compared, " << num_regressions << " regressions, " << num_missing
+			  << " without baseline.\n";
+
+	if (num_regressions > 0)
+		result = 1;
+
+	return result;
+}
+
+} // namespace BenchmarkBaseline
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <nanobench.h>
+
+/*
+    Collects the results of all benchmarks run through AllocationCounter::Run(), to write them to a machine-readable file and compare them
+    against a stored baseline after all benchmarks have run.
+
+    Set the environment variable 'RMLUI_BENCHMARKS_RESULTS_FILE' to write the results to the given file. Set 'RMLUI_BENCHMARKS_BASELINE_FILE'
+    to compare the results against a previously written results file, such as 'Tests/Data/benchmark_baseline.tsv'. A benchmark is flagged as
+    a regression when its median time or its allocations per operation exceed the baseline by more than the threshold. The threshold is
+    given in percent by 'RMLUI_BENCHMARKS_REGRESSION_THRESHOLD', 10 by default, and can be overridden for single benchmarks in the optional
+    last column of the baseline file.
+
+    The files contain one benchmark per line, with the columns separated by tabs: title, name, nanoseconds per operation, allocations per
+    operation, and optionally the regression threshold in percent. Lines starting with '#' are ignored.
+*/
+namespace BenchmarkBaseline {
+
+// Records the result of the latest run of the benchmark.
+void Record(const ankerl::nanobench::Bench& bench, double allocations_per_op);
+
+// Writes and compares the recorded results as configured by the environment variables.
+// @return Non-zero if any benchmark regressed compared to the baseline, or if a file could not be read or written.
+int Finish();
+
+} // namespace BenchmarkBaseline
@@ -1,4 +1,5 @@
 #include "../Common/TestsShell.h"
+#include "AllocationCounter.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/DataModelHandle.h>
 #include <RmlUi/Core/Element.h>
@@ -153,16 +154,16 @@ TEST_CASE("data_binding")
 		bench.title("Data bindings: Dirty variables");
 		bench.relative(true);
 
-		bench.run("Reference (Update)", [&] { context->Update(); });
-		bench.run("Dirty one variable", [&] {
+		AllocationCounter::Run(bench, "Reference (Update)", [&] { context->Update(); });
+		AllocationCounter::Run(bench, "Dirty one variable", [&] {
 			model_handle.DirtyVariable("i0");
 			context->Update();
 		});
-		bench.run("Dirty big variable", [&] {
+		AllocationCounter::Run(bench, "Dirty big variable", [&] {
 			model_handle.DirtyVariable("arrays");
 			context->Update();
 		});
-		bench.run("Dirty all variables", [&] {
+		AllocationCounter::Run(bench, "Dirty all variables", [&] {
 			model_handle.DirtyAllVariables();
 			context->Update();
 		});
@@ -178,18 +179,18 @@ TEST_CASE("data_binding")
 		bench.title("Data bindings: Update");
 		bench.relative(true);
 
-		bench.run("Reference (Integer)", [&] {
+		AllocationCounter::Run(bench, "Reference (Integer)", [&] {
 			element_i->SetInnerRML(Rml::ToString(rng.bounded(1000)));
 			context->Update();
 		});
 
-		bench.run("Integer", [&] {
+		AllocationCounter::Run(bench, "Integer", [&] {
 			globals.i0 = rng.bounded(1000);
 			model_handle.DirtyVariable("i0");
 			context->Update();
 		});
 
-		bench.run("Basic", [&] {
+		AllocationCounter::Run(bench, "Basic", [&] {
 			basic->a = rng.bounded(2000);
 			*basic->b = rng.bounded(3000);
 			basic->c->val = String("abc") + String(5, char('a' + rng.bounded('z' - 'a')));
@@ -197,13 +198,13 @@ TEST_CASE("data_binding")
 			context->Update();
 		});
 
-		bench.run("Reference (Arrays)", [&] {
+		AllocationCounter::Run(bench, "Reference (Arrays)", [&] {
 			element_array->SetInnerRML(
 				Rml::CreateString("<span>%d </span><span>%d </span><span>%d </span>", rng.bounded(5000), rng.bounded(5000), rng.bounded(5000)));
 			context->Update();
 		});
 
-		bench.run("Arrays", [&] {
+		AllocationCounter::Run(bench, "Arrays", [&] {
 			for (auto& v : arrays->a)
 				v = rng.bounded(5000);
 			model_handle.DirtyVariable("arrays");
@@ -211,6 +212,30 @@ TEST_CASE("data_binding")
 		});
 	}
 
+	SUBCASE("watch")
+	{
+		for (const char* name : {"i0", "i1", "i2", "i3", "basic", "arrays"})
+			model_handle.WatchVariable(name);
+
+		nanobench::Rng rng;
+		nanobench::Bench bench;
+		bench.title("Data bindings: Watched variables");
+		bench.relative(true);
+
+		AllocationCounter::Run(bench, "Update (unchanged)", [&] { context->Update(); });
+
+		AllocationCounter::Run(bench, "Integer", [&] {
+			globals.i0 = rng.bounded(1000);
+			context->Update();
+		});
+
+		AllocationCounter::Run(bench, "Arrays", [&] {
+			for (auto& v : arrays->a)
+				v = rng.bounded(5000);
+			context->Update();
+		});
+	}
+
 	TestsShell::RenderLoop();
 
 	document->Close();
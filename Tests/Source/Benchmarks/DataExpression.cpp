@@ -1,4 +1,5 @@
 #include "../../../Source/Core/DataExpression.cpp"
+#include "AllocationCounter.h"
 #include <RmlUi/Core/DataModelHandle.h>
 #include <doctest.h>
 #include <nanobench.h>
@@ -29,7 +30,7 @@ TEST_CASE("data_expressions")
 		DataParser parser(expression, interface);
 
 		bool result = true;
-		bench.run(parse_name, [&] { result &= parser.Parse(false); });
+		AllocationCounter::Run(bench, parse_name, [&] { result &= parser.Parse(false); });
 
 		REQUIRE(result);
 
@@ -37,7 +38,7 @@ TEST_CASE("data_expressions")
 		AddressList addresses = parser.ReleaseAddresses();
 		DataInterpreter interpreter(program, addresses, interface);
 
-		bench.run(execute_name, [&] { result &= interpreter.Run(); });
+		AllocationCounter::Run(bench, execute_name, [&] { result &= interpreter.Run(); });
 
 		REQUIRE(result);
 	};
@@ -50,7 +51,7 @@ TEST_CASE("data_expressions")
 		DataParser parser(expression, interface);
 
 		bool result = true;
-		bench.run(parse_name, [&] { result &= parser.Parse(true); });
+		AllocationCounter::Run(bench, parse_name, [&] { result &= parser.Parse(true); });
 
 		REQUIRE(result);
 
@@ -58,7 +59,7 @@ TEST_CASE("data_expressions")
 		AddressList addresses = parser.ReleaseAddresses();
 		DataInterpreter interpreter(program, addresses, interface);
 
-		bench.run(execute_name, [&] { result &= interpreter.Run(); });
+		AllocationCounter::Run(bench, execute_name, [&] { result &= interpreter.Run(); });
 
 		REQUIRE(result);
 	};
@@ -1,7 +1,9 @@
 #include "../Common/TestsShell.h"
+#include "AllocationCounter.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/Transform.h>
 #include <RmlUi/Core/Types.h>
 #include <doctest.h>
 #include <nanobench.h>
@@ -129,33 +131,33 @@ TEST_CASE("element.creation_and_destruction")
 	bench.timeUnit(std::chrono::microseconds(1), "us");
 	bench.relative(true);
 
-	bench.run("Update (unmodified)", [&] { context->Update(); });
+	AllocationCounter::Run(bench, "Update (unmodified)", [&] { context->Update(); });
 
 	bool hover_toggle = true;
 	auto child = el->GetChild(num_rows / 2);
 
-	bench.run("Update (hover child)", [&] {
+	AllocationCounter::Run(bench, "Update (hover child)", [&] {
 		static nanobench::Rng rng;
 		child->SetPseudoClass(":hover", hover_toggle);
 		hover_toggle = !hover_toggle;
 		context->Update();
 	});
-	bench.run("Update (hover)", [&] {
+	AllocationCounter::Run(bench, "Update (hover)", [&] {
 		el->SetPseudoClass(":hover", hover_toggle);
 		hover_toggle = !hover_toggle;
 		context->Update();
 	});
 
-	bench.run("Render", [&] { context->Render(); });
+	AllocationCounter::Run(bench, "Render", [&] { context->Render(); });
 
-	bench.run("SetInnerRML", [&] { el->SetInnerRML(rml); });
+	AllocationCounter::Run(bench, "SetInnerRML", [&] { el->SetInnerRML(rml); });
 
-	bench.run("SetInnerRML + Update", [&] {
+	AllocationCounter::Run(bench, "SetInnerRML + Update", [&] {
 		el->SetInnerRML(rml);
 		context->Update();
 	});
 
-	bench.run("SetInnerRML + Update + Render", [&] {
+	AllocationCounter::Run(bench, "SetInnerRML + Update + Render", [&] {
 		el->SetInnerRML(rml);
 		context->Update();
 		context->Render();
@@ -192,33 +194,33 @@ TEST_CASE("element.long_texts")
 	bench.timeUnit(std::chrono::microseconds(1), "us");
 	bench.relative(true);
 
-	bench.run("Update (unmodified)", [&] { context->Update(); });
+	AllocationCounter::Run(bench, "Update (unmodified)", [&] { context->Update(); });
 
 	bool hover_toggle = true;
 	auto child = el->GetChild(num_rows / 2);
 
-	bench.run("Update (hover child)", [&] {
+	AllocationCounter::Run(bench, "Update (hover child)", [&] {
 		static nanobench::Rng rng;
 		child->SetPseudoClass(":hover", hover_toggle);
 		hover_toggle = !hover_toggle;
 		context->Update();
 	});
-	bench.run("Update (hover)", [&] {
+	AllocationCounter::Run(bench, "Update (hover)", [&] {
 		el->SetPseudoClass(":hover", hover_toggle);
 		hover_toggle = !hover_toggle;
 		context->Update();
 	});
 
-	bench.run("Render", [&] { context->Render(); });
+	AllocationCounter::Run(bench, "Render", [&] { context->Render(); });
 
-	bench.run("SetInnerRML", [&] { el->SetInnerRML(rml); });
+	AllocationCounter::Run(bench, "SetInnerRML", [&] { el->SetInnerRML(rml); });
 
-	bench.run("SetInnerRML + Update", [&] {
+	AllocationCounter::Run(bench, "SetInnerRML + Update", [&] {
 		el->SetInnerRML(rml);
 		context->Update();
 	});
 
-	bench.run("SetInnerRML + Update + Render", [&] {
+	AllocationCounter::Run(bench, "SetInnerRML + Update + Render", [&] {
 		el->SetInnerRML(rml);
 		context->Update();
 		context->Render();
@@ -227,6 +229,56 @@ TEST_CASE("element.long_texts")
 	document->Close();
 }
 
+TEST_CASE("element.long_log")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+
+	// A single text element with many lines in a scroll container, only the lines near the visible area should generate geometry.
+	Element* el = document->GetElementById("performance");
+	REQUIRE(el);
+	el->SetProperty("overflow-y", "auto");
+	el->SetProperty("white-space", "pre");
+
+	String rml;
+	for (int i = 0; i < 5000; i++)
+		rml += CreateString("[%05d] Frame time 16.6 ms, 1234 draw calls, 56789 vertices, 42 textures.\n", i);
+
+	el->SetInnerRML(rml);
+	context->Update();
+	context->Render();
+
+	const float max_scroll_top = el->GetScrollHeight() - el->GetClientHeight();
+	REQUIRE(max_scroll_top > 0);
+
+	nanobench::Bench bench;
+	bench.title("Element long log");
+	bench.timeUnit(std::chrono::microseconds(1), "us");
+	bench.relative(true);
+
+	AllocationCounter::Run(bench, "Render", [&] { context->Render(); });
+
+	float scroll_top = 0;
+	AllocationCounter::Run(bench, "Scroll by line + Update + Render", [&] {
+		scroll_top = (scroll_top + 20.f > max_scroll_top ? 0.f : scroll_top + 20.f);
+		el->SetScrollTop(scroll_top);
+		context->Update();
+		context->Render();
+	});
+	AllocationCounter::Run(bench, "Scroll by page + Update + Render", [&] {
+		scroll_top = (scroll_top + 300.f > max_scroll_top ? 0.f : scroll_top + 300.f);
+		el->SetScrollTop(scroll_top);
+		context->Update();
+		context->Render();
+	});
+
+	document->Close();
+}
+
 TEST_CASE("element.asymptotic_complexity")
 {
 	Context* context = TestsShell::GetContext();
@@ -277,7 +329,7 @@ TEST_CASE("element.asymptotic_complexity")
 			context->Update();
 			context->Render();
 
-			bench.complexityN(num_rows).run(bench_def.title, [&]() { bench_def.run(rml); });
+			AllocationCounter::Run(bench.complexityN(num_rows), bench_def.title, [&]() { bench_def.run(rml); });
 		}
 
 #if defined(RMLUI_BENCHMARKS_SHOW_COMPLEXITY) || 0
@@ -287,3 +339,194 @@ TEST_CASE("element.asymptotic_complexity")
 
 	document->Close();
 }
+
+TEST_CASE("element.transformed_hierarchy")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* el = document->GetElementById("performance");
+	REQUIRE(el);
+
+	// Chains of nested elements which are all transformed, so that transforming the root affects every element below it.
+	constexpr int num_chains = 50;
+	constexpr int depth = 10;
+	String rml;
+	for (int i = 0; i < num_chains; i++)
+	{
+		for (int j = 0; j < depth; j++)
+			rml += "<div style=\"position: absolute; width: 10px; height: 10px; transform: translateX(5px) rotate(2deg);\">";
+		for (int j = 0; j < depth; j++)
+			rml += "</div>";
+	}
+
+	el->SetInnerRML(rml);
+	context->Update();
+	context->Render();
+
+	nanobench::Bench bench;
+	bench.title("Transformed hierarchy");
+	bench.timeUnit(std::chrono::microseconds(1), "us");
+	bench.relative(true);
+
+	AllocationCounter::Run(bench, "Update + Render (unmodified)", [&] {
+		context->Update();
+		context->Render();
+	});
+
+	int counter = 0;
+	AllocationCounter::Run(bench, "Rotate root + Update + Render", [&] {
+		counter = (counter + 1) % 360;
+		el->SetProperty(PropertyId::Transform, Transform::MakeProperty({Transforms::Rotate2D(float(counter))}));
+		context->Update();
+		context->Render();
+	});
+
+	AllocationCounter::Run(bench, "Rotate leaves + Update + Render", [&] {
+		counter = (counter + 1) % 360;
+		for (int i = 0; i < num_chains; i++)
+		{
+			Element* leaf = el->GetChild(i);
+			while (leaf->GetNumChildren() > 0)
+				leaf = leaf->GetFirstChild();
+			leaf->SetProperty("transform", CreateString("rotate(%ddeg)", counter));
+		}
+		context->Update();
+		context->Render();
+	});
+
+	el->RemoveProperty(PropertyId::Transform);
+	document->Close();
+}
+
+TEST_CASE("element.scroll_long_list")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* el = document->GetElementById("performance");
+	REQUIRE(el);
+
+	constexpr int num_items = 5000;
+	String rml;
+	for (int i = 0; i < num_items; i++)
+		rml += CreateString("<div style=\"height: 20px;\">Item %d</div>", i);
+
+	el->SetProperty("overflow-y", "scroll");
+	el->SetInnerRML(rml);
+	context->Update();
+	context->Render();
+
+	nanobench::Bench bench;
+	bench.title("Scroll long list");
+	bench.timeUnit(std::chrono::microseconds(1), "us");
+	bench.relative(true);
+
+	int counter = 0;
+	AllocationCounter::Run(bench, "SetScrollTop", [&] {
+		counter = (counter + 1) % 1000;
+		el->SetScrollTop(float(counter));
+	});
+
+	AllocationCounter::Run(bench, "SetScrollTop + Update", [&] {
+		counter = (counter + 1) % 1000;
+		el->SetScrollTop(float(counter));
+		context->Update();
+	});
+
+	AllocationCounter::Run(bench, "SetScrollTop + Update + Render", [&] {
+		counter = (counter + 1) % 1000;
+		el->SetScrollTop(float(counter));
+		context->Update();
+		context->Render();
+	});
+
+	el->RemoveProperty("overflow-y");
+	document->Close();
+}
+
+TEST_CASE("element.stacking_context")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* el = document->GetElementById("performance");
+	REQUIRE(el);
+
+	// Every append, removal, or change of z-index rebuilds the stacking context of the document.
+	constexpr int num_items = 500;
+	String rml;
+	for (int i = 0; i < num_items; i++)
+		rml += CreateString("<div style=\"height: 2px;\"><span>Item %d</span></div>", i);
+
+	el->SetInnerRML(rml);
+	Element* overlay = el->AppendChild(document->CreateElement("div"));
+	overlay->SetProperty("position", "absolute");
+	context->Update();
+	context->Render();
+
+	nanobench::Bench bench;
+	bench.title("Stacking context");
+	bench.timeUnit(std::chrono::microseconds(1), "us");
+	bench.relative(true);
+
+	AllocationCounter::Run(bench, "Append + Remove child + Update + Render", [&] {
+		el->RemoveChild(el->AppendChild(document->CreateElement("div")));
+		context->Update();
+		context->Render();
+	});
+
+	int counter = 0;
+	AllocationCounter::Run(bench, "Change z-index + Update + Render", [&] {
+		counter = (counter + 1) % 3;
+		overlay->SetProperty("z-index", ToString(counter - 1));
+		context->Update();
+		context->Render();
+	});
+
+	document->Close();
+}
+
+TEST_CASE("element.attributes")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* el = document->GetElementById("performance");
+	REQUIRE(el);
+	el->SetAttribute("data-value", "0");
+	context->Update();
+
+	nanobench::Bench bench;
+	bench.title("Attributes");
+	bench.timeUnit(std::chrono::nanoseconds(1), "ns");
+	bench.relative(true);
+
+	int counter = 0;
+	AllocationCounter::Run(bench, "SetAttribute (existing)", [&] {
+		counter = (counter + 1) % 10;
+		el->SetAttribute("data-value", counter);
+	});
+	AllocationCounter::Run(bench, "SetAttribute + RemoveAttribute", [&] {
+		el->SetAttribute("data-other", counter);
+		el->RemoveAttribute("data-other");
+	});
+
+	document->Close();
+}
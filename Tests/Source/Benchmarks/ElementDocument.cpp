@@ -1,5 +1,6 @@
 #include "../Common/TestsInterface.h"
 #include "../Common/TestsShell.h"
+#include "AllocationCounter.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
@@ -76,20 +77,20 @@ TEST_CASE("elementdocument")
 		bench.timeUnit(std::chrono::microseconds(1), "us");
 		bench.relative(true);
 
-		bench.run("LoadDocument", [&] {
+		AllocationCounter::Run(bench, "LoadDocument", [&] {
 			ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
 			document->Close();
 			context->Update();
 		});
 
-		bench.run("LoadDocument + Show", [&] {
+		AllocationCounter::Run(bench, "LoadDocument + Show", [&] {
 			ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
 			document->Show();
 			document->Close();
 			context->Update();
 		});
 
-		bench.run("LoadDocument + Show + Update", [&] {
+		AllocationCounter::Run(bench, "LoadDocument + Show + Update", [&] {
 			ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
 			document->Show();
 			context->Update();
@@ -97,7 +98,7 @@ TEST_CASE("elementdocument")
 			context->Update();
 		});
 
-		bench.run("LoadDocument + Show + Update + Render", [&] {
+		AllocationCounter::Run(bench, "LoadDocument + Show + Update + Render", [&] {
 			ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
 			document->Show();
 			context->Update();
@@ -115,14 +116,14 @@ TEST_CASE("elementdocument")
 		bench.timeUnit(std::chrono::microseconds(1), "us");
 		bench.relative(true);
 
-		bench.run("Clear + LoadDocument", [&] {
+		AllocationCounter::Run(bench, "Clear + LoadDocument", [&] {
 			Factory::ClearStyleSheetCache();
 			ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
 			document->Close();
 			context->Update();
 		});
 
-		bench.run("Clear + LoadDocument + Show", [&] {
+		AllocationCounter::Run(bench, "Clear + LoadDocument + Show", [&] {
 			Factory::ClearStyleSheetCache();
 			ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
 			document->Show();
@@ -130,7 +131,7 @@ TEST_CASE("elementdocument")
 			context->Update();
 		});
 
-		bench.run("Clear + LoadDocument + Show + Update", [&] {
+		AllocationCounter::Run(bench, "Clear + LoadDocument + Show + Update", [&] {
 			Factory::ClearStyleSheetCache();
 			ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
 			document->Show();
@@ -139,7 +140,7 @@ TEST_CASE("elementdocument")
 			context->Update();
 		});
 
-		bench.run("Clear + LoadDocument + Show + Update + Render", [&] {
+		AllocationCounter::Run(bench, "Clear + LoadDocument + Show + Update + Render", [&] {
 			Factory::ClearStyleSheetCache();
 			ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
 			document->Show();
@@ -152,3 +153,41 @@ TEST_CASE("elementdocument")
 		});
 	}
 }
+
+TEST_CASE("elementdocument.update_allocations")
+{
+	REQUIRE(TestsShell::GetContext());
+
+	// Use a separate context, so that the state of the mouse is not carried over from other benchmarks.
+	Context* context = CreateContext("update_allocations", {1000, 800});
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+
+	// The first frames format the document and generate all geometry, as well as filling any scratch buffers.
+	for (int i = 0; i < 3; i++)
+	{
+		context->Update();
+		context->Render();
+	}
+
+	AllocationCounter::Counters counters;
+	{
+		AllocationCounter::Scope scope(counters);
+		for (int i = 0; i < 10; i++)
+			context->Update();
+	}
+
+	// Updating an unchanged context should not allocate any memory.
+	CHECK(counters.num_allocations == 0);
+	CHECK(counters.num_bytes == 0);
+
+	nanobench::Bench bench;
+	bench.title("ElementDocument steady state");
+	bench.timeUnit(std::chrono::microseconds(1), "us");
+	AllocationCounter::Run(bench, "Update (unmodified)", [&] { context->Update(); });
+
+	RemoveContext(context->GetName());
+}
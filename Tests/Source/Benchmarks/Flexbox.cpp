@@ -1,4 +1,5 @@
 #include "../Common/TestsShell.h"
+#include "AllocationCounter.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
@@ -354,36 +355,36 @@ TEST_CASE("flexbox")
 
 		TestsShell::RenderLoop();
 
-		bench.run("Update (unmodified)", [&] { context->Update(); });
+		AllocationCounter::Run(bench, "Update (unmodified)", [&] { context->Update(); });
 
-		bench.run("Render", [&] { context->Render(); });
+		AllocationCounter::Run(bench, "Render", [&] { context->Render(); });
 
-		bench.run("SetInnerRML", [&] { document->SetInnerRML(rml_flexbox_scroll_body); });
+		AllocationCounter::Run(bench, "SetInnerRML", [&] { document->SetInnerRML(rml_flexbox_scroll_body); });
 
-		bench.run("SetInnerRML + Update (float reference)", [&] {
+		AllocationCounter::Run(bench, "SetInnerRML + Update (float reference)", [&] {
 			document_float_reference->SetInnerRML(rml_flexbox_basic_body);
 			context->Update();
 		});
-		bench.run("SetInnerRML + Update (fast version)", [&] {
+		AllocationCounter::Run(bench, "SetInnerRML + Update (fast version)", [&] {
 			document_fast->SetInnerRML(rml_flexbox_basic_body);
 			context->Update();
 		});
-		bench.run("SetInnerRML + Update", [&] {
+		AllocationCounter::Run(bench, "SetInnerRML + Update", [&] {
 			document->SetInnerRML(rml_flexbox_basic_body);
 			context->Update();
 		});
 
-		bench.run("SetInnerRML + Update + Render (float reference)", [&] {
+		AllocationCounter::Run(bench, "SetInnerRML + Update + Render (float reference)", [&] {
 			document_float_reference->SetInnerRML(rml_flexbox_basic_body);
 			context->Update();
 			context->Render();
 		});
-		bench.run("SetInnerRML + Update + Render (fast version)", [&] {
+		AllocationCounter::Run(bench, "SetInnerRML + Update + Render (fast version)", [&] {
 			document_fast->SetInnerRML(rml_flexbox_basic_body);
 			context->Update();
 			context->Render();
 		});
-		bench.run("SetInnerRML + Update + Render", [&] {
+		AllocationCounter::Run(bench, "SetInnerRML + Update + Render", [&] {
 			document->SetInnerRML(rml_flexbox_basic_body);
 			context->Update();
 			context->Render();
@@ -409,18 +410,18 @@ TEST_CASE("flexbox")
 
 		TestsShell::RenderLoop();
 
-		bench.run("Update (unmodified)", [&] { context->Update(); });
+		AllocationCounter::Run(bench, "Update (unmodified)", [&] { context->Update(); });
 
-		bench.run("Render", [&] { context->Render(); });
+		AllocationCounter::Run(bench, "Render", [&] { context->Render(); });
 
-		bench.run("SetInnerRML", [&] { document->SetInnerRML(rml_flexbox_scroll_body); });
+		AllocationCounter::Run(bench, "SetInnerRML", [&] { document->SetInnerRML(rml_flexbox_scroll_body); });
 
-		bench.run("SetInnerRML + Update", [&] {
+		AllocationCounter::Run(bench, "SetInnerRML + Update", [&] {
 			document->SetInnerRML(rml_flexbox_mixed_body);
 			context->Update();
 		});
 
-		bench.run("SetInnerRML + Update + Render", [&] {
+		AllocationCounter::Run(bench, "SetInnerRML + Update + Render", [&] {
 			document->SetInnerRML(rml_flexbox_mixed_body);
 			context->Update();
 			context->Render();
@@ -444,18 +445,18 @@ TEST_CASE("flexbox")
 
 		TestsShell::RenderLoop();
 
-		bench.run("Update (unmodified)", [&] { context->Update(); });
+		AllocationCounter::Run(bench, "Update (unmodified)", [&] { context->Update(); });
 
-		bench.run("Render", [&] { context->Render(); });
+		AllocationCounter::Run(bench, "Render", [&] { context->Render(); });
 
-		bench.run("SetInnerRML", [&] { document->SetInnerRML(rml_flexbox_scroll_body); });
+		AllocationCounter::Run(bench, "SetInnerRML", [&] { document->SetInnerRML(rml_flexbox_scroll_body); });
 
-		bench.run("SetInnerRML + Update", [&] {
+		AllocationCounter::Run(bench, "SetInnerRML + Update", [&] {
 			document->SetInnerRML(rml_flexbox_scroll_body);
 			context->Update();
 		});
 
-		bench.run("SetInnerRML + Update + Render", [&] {
+		AllocationCounter::Run(bench, "SetInnerRML + Update + Render", [&] {
 			document->SetInnerRML(rml_flexbox_scroll_body);
 			context->Update();
 			context->Render();
@@ -528,13 +529,13 @@ TEST_CASE("flexbox.chat")
 	document->Show();
 	TestsShell::RenderLoop();
 
-	bench.run("Short words", [&] {
+	AllocationCounter::Run(bench, "Short words", [&] {
 		chat->SetInnerRML(short_words);
 		context->Update();
 		context->Render();
 		RMLUI_FrameMark;
 	});
-	bench.run("Long words", [&] {
+	AllocationCounter::Run(bench, "Long words", [&] {
 		chat->SetInnerRML(long_words);
 		context->Update();
 		context->Render();
@@ -619,19 +620,19 @@ TEST_CASE("flexbox.shrink-to-fit")
 	basic->SetProperty(PropertyId::Display, Style::Display::None);
 	nested->SetProperty(PropertyId::Display, Style::Display::None);
 
-	bench.run("Reference", [&] {
+	AllocationCounter::Run(bench, "Reference", [&] {
 		document->SetProperty(PropertyId::Display, Style::Display::None);
 		document->RemoveProperty(PropertyId::Display);
 		context->Update();
 		context->Render();
 	});
-	bench.run("Basic shrink-to-fit", [&] {
+	AllocationCounter::Run(bench, "Basic shrink-to-fit", [&] {
 		basic->RemoveProperty(PropertyId::Display);
 		nested->SetProperty(PropertyId::Display, Style::Display::None);
 		context->Update();
 		context->Render();
 	});
-	bench.run("Nested shrink-to-fit", [&] {
+	AllocationCounter::Run(bench, "Nested shrink-to-fit", [&] {
 		basic->SetProperty(PropertyId::Display, Style::Display::None);
 		nested->RemoveProperty(PropertyId::Display);
 		context->Update();
@@ -640,3 +641,81 @@ TEST_CASE("flexbox.shrink-to-fit")
 
 	document->Close();
 }
+
+static const String rml_flexbox_toolbar = R"(
+<rml>
+<head>
+    <title>Flexbox toolbar</title>
+    <link type="text/rcss" href="/../Tests/Data/style.rcss"/>
+	<style>
+		#toolbar {
+			display: flex;
+			flex-wrap: wrap;
+			width: 1000px;
+		}
+		#toolbar img {
+			width: 32px;
+			height: 32px;
+			margin: 2px;
+			padding: 2px;
+		}
+		#toolbar img:hover {
+			margin: 0px;
+			padding: 4px;
+		}
+	</style>
+</head>
+<body>
+<div id="toolbar"/>
+</body>
+</rml>
+)";
+
+TEST_CASE("flexbox.toolbar")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(rml_flexbox_toolbar);
+	REQUIRE(document);
+	Element* toolbar = document->GetElementById("toolbar");
+	REQUIRE(toolbar);
+
+	// A toolbar of 200 icons sized by their style, where hovering an icon changes its layout.
+	String rml;
+	for (int i = 0; i < 200; i++)
+		rml += "<img src=\"/assets/high_scores_alien_1.tga\"/>";
+	toolbar->SetInnerRML(rml);
+
+	document->Show();
+	TestsShell::RenderLoop();
+
+	nanobench::Bench bench;
+	bench.title("Flexbox toolbar");
+	bench.relative(true);
+
+	AllocationCounter::Run(bench, "Update (unmodified)", [&] { context->Update(); });
+
+	int counter = 0;
+	auto HoverNextIcon = [&] {
+		Element* icon = toolbar->GetChild(counter % 200);
+		counter += 1;
+		const Vector2f position = icon->GetAbsoluteOffset(BoxArea::Border) + Vector2f(8.f);
+		context->ProcessMouseMove(int(position.x), int(position.y), 0);
+		context->Update();
+	};
+
+	AllocationCounter::Run(bench, "Hover + Update", HoverNextIcon);
+
+	AllocationCounter::Run(bench, "Hover + Update + Render", [&] {
+		HoverNextIcon();
+		context->Render();
+	});
+
+	// Icons sized by their style are never measured.
+	HoverNextIcon();
+	context->Render();
+	CHECK(context->GetFrameStatistics().total.num_layout_measures == 0);
+
+	document->Close();
+}
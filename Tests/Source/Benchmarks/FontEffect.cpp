@@ -1,4 +1,5 @@
 ﻿#include "../Common/TestsShell.h"
+#include "AllocationCounter.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
@@ -16,7 +17,7 @@ static const String rml_font_effect_document = R"(
     <link type="text/rcss" href="/../Tests/Data/style.rcss"/>
 	<style>
 		body {
-			font-size: 25px;
+			font-size: %dpx;
 			font-effect: %s(%dpx #ff6);
 		}
 	</style>
@@ -40,14 +41,47 @@ TEST_CASE("font_effect")
 	{
 		constexpr int effect_size = 8;
 
-		const String rml_document = CreateString(rml_font_effect_document.c_str(), effect_name, effect_size);
+		const String rml_document = CreateString(rml_font_effect_document.c_str(), 25, effect_name, effect_size);
 
 		ElementDocument* document = context->LoadDocumentFromMemory(rml_document);
 		document->Show();
 		context->Update();
 		context->Render();
 
-		bench.run(effect_name, [&]() {
+		AllocationCounter::Run(bench, effect_name, [&]() {
+			Rml::ReleaseFontResources();
+			context->Render();
+		});
+
+		document->Close();
+	}
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("font_effect.large_title")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	nanobench::Bench bench;
+	bench.title("Font effect (64px title)");
+	bench.relative(true);
+
+	// Large effect kernels on a big font size, the worst case for generating the layer textures of every glyph.
+	for (const char* effect_name : {"blur", "glow"})
+	{
+		constexpr int font_size = 64;
+		constexpr int effect_size = 16;
+
+		const String rml_document = CreateString(rml_font_effect_document.c_str(), font_size, effect_name, effect_size);
+
+		ElementDocument* document = context->LoadDocumentFromMemory(rml_document);
+		document->Show();
+		context->Update();
+		context->Render();
+
+		AllocationCounter::Run(bench, effect_name, [&]() {
 			Rml::ReleaseFontResources();
 			context->Render();
 		});
@@ -0,0 +1,95 @@
+#include "../Common/TestsShell.h"
+#include "AllocationCounter.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/RenderCommandList.h>
+#include <RmlUi/Core/Types.h>
+#include <doctest.h>
+#include <nanobench.h>
+
+using namespace ankerl;
+using namespace Rml;
+
+static const String document_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/../Tests/Data/style.rcss"/>
+	<style>
+		body { width: 800px; height: 600px; }
+		div {
+			display: inline-block;
+			width: 60px;
+			height: 20px;
+			margin: 2px;
+			border: 2px #55f;
+			background: #c3c3c3;
+		}
+		div:nth-child(3n) { border-radius: 5px; }
+	</style>
+</head>
+<body>
+</body>
+</rml>
+)";
+
+TEST_CASE("render_command_list")
+{
+	Context* shell_context = TestsShell::GetContext();
+	REQUIRE(shell_context);
+
+	RenderInterface* target = GetRenderInterface();
+	REQUIRE(target);
+
+	// Record the frames of a separate context, as a render thread would receive them. The recorder must outlive the render manager made for
+	// it, which is only released during shutdown.
+	static RenderCommandRecorder recorder(*target);
+	RenderCommandPlayer player(*target);
+	RenderCommandList list;
+
+	Context* context = CreateContext("render_command_list", shell_context->GetDimensions(), &recorder);
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+
+	String rml;
+	for (int i = 0; i < 400; i++)
+		rml += "<div>" + ToString(i) + "</div>";
+	document->SetInnerRML(rml);
+	document->Show();
+
+	// The first frame compiles all geometry, the following ones only render it.
+	context->Update();
+	context->Render();
+	recorder.SwapCommands(list);
+	player.Replay(list);
+
+	context->Update();
+	context->Render();
+	recorder.SwapCommands(list);
+	MESSAGE("Commands per frame: ", list.GetNumCommands(), ", reserved bytes: ", list.GetReservedBytes());
+
+	nanobench::Bench bench;
+	bench.title("Render command list");
+	bench.relative(true);
+	bench.minEpochIterations(100);
+	bench.warmup(50);
+
+	RenderCommandList recorded;
+	AllocationCounter::Run(bench, "Update + render (recording)", [&] {
+		context->Update();
+		context->Render();
+		recorder.SwapCommands(recorded);
+	});
+
+	AllocationCounter::Run(bench, "Replay captured frame", [&] { player.Replay(list); });
+
+	RemoveContext(context->GetName());
+	ReleaseTextures(&recorder);
+	ReleaseCompiledGeometry(&recorder);
+
+	// Release the resources of the removed context.
+	recorder.SwapCommands(list);
+	player.Replay(list);
+}
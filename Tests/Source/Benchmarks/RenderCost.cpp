@@ -0,0 +1,198 @@
+#include "../Common/CountingRenderInterface.h"
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/RenderManager.h>
+#include <RmlUi/Core/Types.h>
+#include <PlatformExtensions.h>
+#include <cstdio>
+#include <cstdlib>
+#include <doctest.h>
+#include <fstream>
+#include <iostream>
+
+using namespace Rml;
+
+/*
+    Counts the backend-level costs of rendering the visual tests documents, such as draw calls, state changes, and vertices.
+
+    The counts do not depend on the hardware, thus they can be compared exactly between runs to validate batching and caching features. Each
+    document is rendered with geometry batching disabled and enabled. Set the environment variable 'RMLUI_BENCHMARKS_JSON_DIRECTORY' to write
+    all counts to a JSON file in that directory.
+*/
+
+using Statistics = CountingRenderInterface::Statistics;
+
+struct StatisticField {
+	const char* name;
+	size_t Statistics::*member;
+};
+
+static const StatisticField statistic_fields[] = {
+	{"draw_calls", &Statistics::draw_calls},
+	{"instanced_draw_calls", &Statistics::instanced_draw_calls},
+	{"shader_draw_calls", &Statistics::shader_draw_calls},
+	{"vertices", &Statistics::vertices},
+	{"indices", &Statistics::indices},
+	{"texture_switches", &Statistics::texture_switches},
+	{"scissor_changes", &Statistics::scissor_changes},
+	{"transform_changes", &Statistics::transform_changes},
+	{"clip_mask_changes", &Statistics::clip_mask_changes},
+	{"clip_mask_renders", &Statistics::clip_mask_renders},
+	{"layer_pushes", &Statistics::layer_pushes},
+	{"layer_composites", &Statistics::layer_composites},
+	{"layer_textures", &Statistics::layer_textures},
+	{"compiled_geometries", &Statistics::compiled_geometries},
+	{"released_geometries", &Statistics::released_geometries},
+	{"loaded_textures", &Statistics::loaded_textures},
+	{"generated_textures", &Statistics::generated_textures},
+	{"updated_textures", &Statistics::updated_textures},
+	{"released_textures", &Statistics::released_textures},
+	{"compiled_filters", &Statistics::compiled_filters},
+	{"compiled_shaders", &Statistics::compiled_shaders},
+};
+
+struct RenderCostResult {
+	String document;
+	bool batching;
+	// The first frame after showing the document, and a following frame without any changes.
+	Statistics first_frame;
+	Statistics next_frame;
+};
+
+static void PrintResults(const Vector<RenderCostResult>& results, bool batching)
+{
+	std::cout << "\n| Render cost of the next frame, geometry batching " << (batching ? "enabled" : "disabled") << "\n";
+	std::cout << "|      draws |  instanced |     vertices | tex switch |    scissor |  transform |  clip mask |     layers | document\n";
+	std::cout << "|-----------:|-----------:|-------------:|-----------:|-----------:|-----------:|-----------:|-----------:|:---------\n";
+
+	Statistics total = {};
+	auto PrintRow = [](const Statistics& s, const String& name) {
+		char buffer[256];
+		std::snprintf(buffer, sizeof(buffer), "| %10zu | %10zu | %12zu | %10zu | %10zu | %10zu | %10zu | %10zu | ", s.draw_calls, s.instanced_draw_calls,
+			s.vertices, s.texture_switches, s.scissor_changes, s.transform_changes, s.clip_mask_renders, s.layer_pushes);
+		std::cout << buffer << '`' << name << "`\n";
+	};
+
+	for (const RenderCostResult& result : results)
+	{
+		if (result.batching != batching)
+			continue;
+
+		PrintRow(result.next_frame, result.document);
+		for (const StatisticField& field : statistic_fields)
+			total.*field.member += result.next_frame.*field.member;
+	}
+
+	PrintRow(total, "Total");
+}
+
+static void WriteResults(const Vector<RenderCostResult>& results, const String& path)
+{
+	std::ofstream file(path);
+	if (!file)
+	{
+		MESSAGE("Could not write render cost results to ", path);
+		return;
+	}
+
+	auto WriteStatistics = [&file](const Statistics& statistics) {
+		file << "{";
+		for (const StatisticField& field : statistic_fields)
+			file << (&field == statistic_fields ? "" : ", ") << '"' << field.name << "\": " << statistics.*field.member;
+		file << "}";
+	};
+
+	file << "{\n  \"results\": [\n";
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const RenderCostResult& result = results[i];
+		file << "    {\"document\": \"" << result.document << "\", \"batching\": " << (result.batching ? "true" : "false") << ",\n";
+		file << "     \"first_frame\": ";
+		WriteStatistics(result.first_frame);
+		file << ",\n     \"next_frame\": ";
+		WriteStatistics(result.next_frame);
+		file << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	file << "  ]\n}\n";
+}
+
+TEST_CASE("render_cost.visual_tests")
+{
+	REQUIRE(TestsShell::GetContext());
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+
+	const String directory = PlatformExtensions::FindSamplesRoot() + "../Tests/Data/VisualTests";
+	const StringList files = PlatformExtensions::ListFiles(directory, "rml");
+	REQUIRE_MESSAGE(!files.empty(), "Could not find any *.rml files in directory ", directory);
+
+	// The render interface must outlive the render manager made for it, which is only released during shutdown.
+	static CountingRenderInterface render_interface;
+
+	Context* context = CreateContext("render_cost", Vector2i(1500, 800), &render_interface);
+	REQUIRE(context);
+	RenderManager& render_manager = context->GetRenderManager();
+
+	Vector<RenderCostResult> results;
+
+	for (const String& file : files)
+	{
+		for (bool batching : {false, true})
+		{
+			// The visual tests are not written for the tests shell, they may for example link to their references or use unknown properties.
+			if (system_interface)
+				system_interface->SetIgnoreWarnings(true);
+
+			render_manager.SetGeometryBatching(batching);
+
+			ElementDocument* document = context->LoadDocument(directory + '/' + file);
+			if (!document)
+				continue;
+			document->Show();
+
+			RenderCostResult result = {file, batching, {}, {}};
+
+			render_interface.ResetStatistics();
+			context->Update();
+			context->Render();
+			result.first_frame = render_interface.GetStatistics();
+
+			render_interface.ResetStatistics();
+			context->Update();
+			context->Render();
+			result.next_frame = render_interface.GetStatistics();
+
+			document->Close();
+			context->Update();
+
+			if (system_interface)
+				system_interface->SetIgnoreWarnings(false);
+
+			results.push_back(std::move(result));
+		}
+	}
+
+	// Batching merges consecutive draws, it should never need more of them.
+	for (size_t i = 0; i + 1 < results.size(); i++)
+	{
+		const RenderCostResult& unbatched = results[i];
+		const RenderCostResult& batched = results[i + 1];
+		if (unbatched.batching || !batched.batching || unbatched.document != batched.document)
+			continue;
+
+		CHECK_MESSAGE(batched.next_frame.draw_calls <= unbatched.next_frame.draw_calls, unbatched.document);
+	}
+
+	PrintResults(results, false);
+	PrintResults(results, true);
+
+	if (const char* output_directory = std::getenv("RMLUI_BENCHMARKS_JSON_DIRECTORY"))
+		WriteResults(results, String(output_directory) + "/render_cost.json");
+
+	render_manager.SetGeometryBatching(false);
+	RemoveContext(context->GetName());
+	ReleaseTextures(&render_interface);
+	ReleaseCompiledGeometry(&render_interface);
+}
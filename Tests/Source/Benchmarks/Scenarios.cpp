@@ -0,0 +1,425 @@
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
+#include "AllocationCounter.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/DataModelHandle.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/RenderCommandList.h>
+#include <RmlUi/Core/Types.h>
+#include <cstdlib>
+#include <doctest.h>
+#include <fstream>
+#include <nanobench.h>
+
+using namespace ankerl;
+using namespace Rml;
+
+/*
+    Full-frame scenarios on large, representative documents.
+
+    Every scenario advances its state once per frame, such as moving the mouse or advancing the time. The update and render phases of a frame
+    are measured separately: 'Update' advances the state and updates the context, 'Render' renders the latest state into a recording render
+    interface and replays the commands, and 'Frame' does both.
+
+    Set the environment variable 'RMLUI_BENCHMARKS_JSON_DIRECTORY' to write the results of each scenario to a JSON file in that directory,
+    for comparing runs across releases.
+*/
+
+static const String document_head = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/../Tests/Data/style.rcss"/>
+	<style>
+)";
+
+static const String table_rcss = R"(
+		body { width: 1000px; height: 700px; overflow: auto; }
+		table { width: 100%; border: 1px #666; }
+		td { padding: 2px 5px; border-bottom: 1px #ccc; }
+		td:first-child { width: 80px; text-align: right; }
+		tr:nth-child(even) { background: #eee; }
+		tr.selected { background: #bdf; }
+)";
+
+static const String dashboard_rcss = R"(
+		body { display: flex; flex-direction: column; width: 100%; height: 100%; }
+		.row { display: flex; flex: 1 1 auto; gap: 8px; padding: 4px; }
+		.column { display: flex; flex-direction: column; flex: 1 1 0; gap: 6px; }
+		.panel { display: flex; flex-wrap: wrap; flex: 1 1 auto; gap: 4px; padding: 6px; border: 1px #889; border-radius: 4px; background: #f4f4f8; }
+		.card { flex: 1 1 60px; min-width: 40px; padding: 3px; border: 1px #ccd; background: #fff; }
+		.card span { display: block; }
+		.value { font-size: 18px; color: #336; }
+)";
+
+static const String hud_rcss = R"(
+		body { width: 100%; height: 100%; }
+		@keyframes pulse {
+			from { opacity: 0.4; transform: scale(0.9); }
+			to { opacity: 1.0; transform: scale(1.1); }
+		}
+		@keyframes spin {
+			from { transform: rotate(0deg); }
+			to { transform: rotate(360deg); }
+		}
+		@keyframes fill {
+			from { width: 0%; }
+			to { width: 100%; }
+		}
+		.marker { position: absolute; width: 24px; height: 24px; border: 2px #f80; border-radius: 12px; animation: 1s pulse infinite alternate; }
+		.radar { position: absolute; right: 20px; bottom: 20px; width: 120px; height: 120px; border: 3px #3c3; border-radius: 60px; }
+		.sweep { width: 60px; height: 2px; margin: 59px 0 0 60px; background: #3c3; transform-origin: left; animation: 2s spin infinite linear; }
+		.bar { position: absolute; left: 20px; width: 200px; height: 10px; border: 1px #fff; background: #0008; }
+		.bar div { height: 100%; background: #e33; animation: 3s fill infinite alternate cubic-in-out; }
+)";
+
+static const String chat_rcss = R"(
+		body { width: 500px; height: 100%; overflow: auto; }
+		.message { display: block; margin: 2px 4px; padding: 3px 6px; border-radius: 3px; background: #eef; }
+		.message.own { background: #efe; text-align: right; }
+		.author { font-weight: bold; }
+		.time { color: #888; font-size: 12px; }
+)";
+
+static const String theme_rcss = R"(
+		body { width: 100%; height: 100%; background: #fff; color: #222; }
+		.item { display: inline-block; width: 110px; margin: 3px; padding: 4px; border: 1px #ccc; border-radius: 3px; background: #f6f6f6; }
+		.item h2 { color: #225; border-bottom: 1px #aac; }
+		.item p { color: #444; }
+		body.dark { background: #1b1b20; color: #ddd; }
+		body.dark .item { border-color: #444; background: #2a2a30; box-shadow: #0008 0 2px 4px; }
+		body.dark .item h2 { color: #aaf; border-bottom-color: #446; }
+		body.dark .item p { color: #bbb; }
+)";
+
+static const String hover_rcss = R"(
+		body { width: 100%; height: 100%; }
+		button { display: inline-block; width: 38px; height: 20px; margin: 1px; border: 1px #999; background: #ddd; text-align: center; }
+		button:hover { border-color: #36f; background: #cdf; }
+		button:hover span { color: #036; }
+)";
+
+static const String document_tail = R"(
+	</style>
+</head>
+<body>
+</body>
+</rml>
+)";
+
+// Records the frames of a context into a command list, and replays it into the tests render interface.
+class ScenarioRenderer {
+public:
+	ScenarioRenderer(const String& name, Vector2i dimensions)
+	{
+		// The library is initialized together with the shell context.
+		if (TestsShell::GetContext())
+			context = CreateContext(name, dimensions, &GetRecorder());
+	}
+	~ScenarioRenderer()
+	{
+		if (!context)
+			return;
+
+		RemoveContext(context->GetName());
+		ReleaseTextures(&GetRecorder());
+		ReleaseCompiledGeometry(&GetRecorder());
+
+		// Release the resources of the removed context.
+		GetRecorder().SwapCommands(list);
+		GetPlayer().Replay(list);
+	}
+
+	Context* GetContext() const { return context; }
+
+	void Render()
+	{
+		context->Render();
+		GetRecorder().SwapCommands(list);
+		GetPlayer().Replay(list);
+	}
+
+	size_t GetNumCommands() const { return list.GetNumCommands(); }
+
+private:
+	// The recorder must outlive the render managers made for it, which are only released during shutdown. The same player must replay all
+	// lists of the recorder.
+	static RenderCommandRecorder& GetRecorder()
+	{
+		static RenderCommandRecorder recorder(*GetRenderInterface());
+		return recorder;
+	}
+	static RenderCommandPlayer& GetPlayer()
+	{
+		static RenderCommandPlayer player(*GetRenderInterface());
+		return player;
+	}
+
+	Context* context = nullptr;
+	RenderCommandList list;
+};
+
+template <typename Step>
+static void RunScenario(const String& name, ScenarioRenderer& renderer, int min_epoch_iterations, Step&& step)
+{
+	Context* context = renderer.GetContext();
+
+	// The first frames load all resources and compile the geometry.
+	for (int i = 0; i < 2; i++)
+	{
+		step();
+		context->Update();
+		renderer.Render();
+	}
+	MESSAGE(name, ": ", renderer.GetNumCommands(), " commands per frame");
+
+	nanobench::Bench bench;
+	bench.title("Scenario: " + name);
+	bench.timeUnit(std::chrono::microseconds(1), "us");
+	bench.relative(true);
+	bench.minEpochIterations(min_epoch_iterations);
+
+	AllocationCounter::Run(bench, "Frame", [&] {
+		step();
+		context->Update();
+		renderer.Render();
+	});
+
+	AllocationCounter::Run(bench, "Update", [&] {
+		step();
+		context->Update();
+	});
+
+	AllocationCounter::Run(bench, "Render", [&] { renderer.Render(); });
+
+	if (const char* directory = std::getenv("RMLUI_BENCHMARKS_JSON_DIRECTORY"))
+	{
+		String file_name = name;
+		for (char& c : file_name)
+		{
+			if (c == ' ')
+				c = '_';
+		}
+
+		std::ofstream file(String(directory) + "/" + file_name + ".json");
+		if (file)
+			nanobench::render(nanobench::templates::json(), bench, file);
+		else
+			MESSAGE("Could not write benchmark results to directory ", directory);
+	}
+}
+
+static ElementDocument* LoadScenarioDocument(Context* context, const String& rcss, const String& body_rml)
+{
+	ElementDocument* document = context->LoadDocumentFromMemory(document_head + rcss + document_tail);
+	if (!document)
+		return nullptr;
+
+	document->SetInnerRML(body_rml);
+	document->Show();
+	return document;
+}
+
+TEST_SUITE("scenarios")
+{
+	TEST_CASE("scenarios.table")
+	{
+		ScenarioRenderer renderer("scenario_table", {1000, 700});
+		Context* context = renderer.GetContext();
+		REQUIRE(context);
+
+		constexpr int num_rows = 10'000;
+		String rml = "<table><col/><col/><col/><col/>";
+		for (int i = 0; i < num_rows; i++)
+			rml += CreateString("<tr><td>%d</td><td>Item %d</td><td>Category %d</td><td>%d.%02d</td></tr>", i, i, i % 17, i * 7 % 1000, i % 100);
+		rml += "</table>";
+
+		ElementDocument* document = LoadScenarioDocument(context, table_rcss, rml);
+		REQUIRE(document);
+		Element* table = document->GetFirstChild();
+		REQUIRE(table);
+
+		// Move the selection between rows, and keep scrolling it into view.
+		nanobench::Rng rng;
+		Element* selected_row = nullptr;
+		RunScenario("Table 10k rows", renderer, 1, [&] {
+			if (selected_row)
+				selected_row->SetClass("selected", false);
+			selected_row = table->GetChild(4 + (int)rng.bounded(num_rows));
+			selected_row->SetClass("selected", true);
+			selected_row->ScrollIntoView(ScrollIntoViewOptions(ScrollAlignment::Nearest));
+		});
+	}
+
+	TEST_CASE("scenarios.dashboard")
+	{
+		ScenarioRenderer renderer("scenario_dashboard", {1200, 800});
+		Context* context = renderer.GetContext();
+		REQUIRE(context);
+
+		String rml;
+		for (int row = 0; row < 3; row++)
+		{
+			rml += "<div class='row'>";
+			for (int column = 0; column < 4; column++)
+			{
+				rml += "<div class='column'>";
+				for (int panel = 0; panel < 3; panel++)
+				{
+					rml += "<div class='panel'>";
+					for (int card = 0; card < 8; card++)
+						rml += CreateString("<div class='card'><span>Metric %d</span><span class='value'>%d</span></div>", card, row * 1000 + column * 100 + card);
+					rml += "</div>";
+				}
+				rml += "</div>";
+			}
+			rml += "</div>";
+		}
+
+		ElementDocument* document = LoadScenarioDocument(context, dashboard_rcss, rml);
+		REQUIRE(document);
+
+		// Resize the window back and forth, so that the whole dashboard is laid out again every frame.
+		int frame = 0;
+		RunScenario("Nested flex dashboard", renderer, 5, [&] {
+			frame += 1;
+			context->SetDimensions(frame % 2 ? Vector2i(1200, 800) : Vector2i(1100, 760));
+		});
+	}
+
+	TEST_CASE("scenarios.hud")
+	{
+		ScenarioRenderer renderer("scenario_hud", {1280, 720});
+		Context* context = renderer.GetContext();
+		REQUIRE(context);
+
+		String rml;
+		for (int i = 0; i < 200; i++)
+			rml += CreateString("<div class='marker' style='left: %dpx; top: %dpx; animation-delay: %.2fs;'/>", (i * 97) % 1240, (i * 53) % 680, (i % 10) * 0.1f);
+		for (int i = 0; i < 8; i++)
+			rml += CreateString("<div class='bar' style='top: %dpx;'><div style='animation-delay: %.1fs;'/></div>", 20 + i * 18, i * 0.4f);
+		rml += "<div class='radar'><div class='sweep'/></div>";
+
+		ElementDocument* document = LoadScenarioDocument(context, hud_rcss, rml);
+		REQUIRE(document);
+
+		// Advance the animations by one frame at 60 Hz.
+		TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+		double t = 0.0;
+		RunScenario("Animated HUD", renderer, 20, [&] {
+			t += 1.0 / 60.0;
+			if (system_interface)
+				system_interface->SetManualTime(t);
+		});
+	}
+
+	TEST_CASE("scenarios.chat")
+	{
+		ScenarioRenderer renderer("scenario_chat", {500, 800});
+		Context* context = renderer.GetContext();
+		REQUIRE(context);
+
+		struct ChatMessage {
+			String author;
+			String time;
+			String text;
+			bool own;
+		};
+		Vector<ChatMessage> messages;
+
+		DataModelConstructor constructor = context->CreateDataModel("chat");
+		REQUIRE(constructor);
+		if (auto handle = constructor.RegisterStruct<ChatMessage>())
+		{
+			handle.RegisterMember("author", &ChatMessage::author);
+			handle.RegisterMember("time", &ChatMessage::time);
+			handle.RegisterMember("text", &ChatMessage::text);
+			handle.RegisterMember("own", &ChatMessage::own);
+		}
+		constructor.RegisterArray<Vector<ChatMessage>>();
+		constructor.Bind("messages", &messages);
+		DataModelHandle model_handle = constructor.GetModelHandle();
+
+		const String rml = R"(
+<div data-model="chat">
+	<div class="message" data-for="message : messages" data-class-own="message.own">
+		<span class="author">{{ message.author }}</span> <span class="time">{{ message.time }}</span>
+		<p>{{ message.text }}</p>
+	</div>
+</div>)";
+
+		int num_messages = 0;
+		auto AddMessage = [&] {
+			const int i = num_messages++;
+			messages.push_back(ChatMessage{
+				CreateString("User %d", i % 7),
+				CreateString("%02d:%02d", (i / 60) % 24, i % 60),
+				CreateString("Message number %d, with a bit of text that needs to be wrapped over a couple of lines in the chat log.", i),
+				i % 3 == 0,
+			});
+		};
+		for (int i = 0; i < 500; i++)
+			AddMessage();
+
+		ElementDocument* document = LoadScenarioDocument(context, chat_rcss, rml);
+		REQUIRE(document);
+
+		// Receive a new message and drop the oldest one, keeping the log scrolled to the bottom.
+		RunScenario("Chat log", renderer, 5, [&] {
+			messages.erase(messages.begin());
+			AddMessage();
+			model_handle.DirtyVariable("messages");
+			document->SetScrollTop(document->GetScrollHeight());
+		});
+	}
+
+	TEST_CASE("scenarios.theme")
+	{
+		ScenarioRenderer renderer("scenario_theme", {1280, 720});
+		Context* context = renderer.GetContext();
+		REQUIRE(context);
+
+		String rml;
+		for (int i = 0; i < 300; i++)
+			rml += CreateString("<div class='item'><h2>Item %d</h2><p>Some description of item %d.</p></div>", i, i);
+
+		ElementDocument* document = LoadScenarioDocument(context, theme_rcss, rml);
+		REQUIRE(document);
+
+		// Switch between the light and dark themes, restyling every element.
+		bool dark = false;
+		RunScenario("Theme switch", renderer, 5, [&] {
+			dark = !dark;
+			document->SetClass("dark", dark);
+		});
+	}
+
+	TEST_CASE("scenarios.hover")
+	{
+		ScenarioRenderer renderer("scenario_hover", {1280, 720});
+		Context* context = renderer.GetContext();
+		REQUIRE(context);
+
+		String rml;
+		for (int i = 0; i < 1000; i++)
+			rml += CreateString("<button><span>%d</span></button>", i);
+
+		ElementDocument* document = LoadScenarioDocument(context, hover_rcss, rml);
+		REQUIRE(document);
+
+		// Sweep the mouse over the grid of buttons, row by row.
+		const Vector2i dimensions = context->GetDimensions();
+		constexpr int step_size = 7;
+		Vector2i position;
+		RunScenario("Hover sweep", renderer, 20, [&] {
+			position.x += step_size;
+			if (position.x >= dimensions.x)
+			{
+				position.x = 0;
+				position.y = (position.y + 11) % dimensions.y;
+			}
+			context->ProcessMouseMove(position.x, position.y, 0);
+		});
+	}
+}
@@ -1,4 +1,5 @@
 #include "../Common/TestsShell.h"
+#include "AllocationCounter.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
@@ -38,6 +39,11 @@ static constexpr const char* document_rml_template = R"(
 			width: 800px;
 			height: 300px;
 		}
+		/* Make the descendants depend on the hover state, so that toggling it requires a definition lookup on all of them. */
+		#performance:hover div
+		{
+			scrollbar-margin: 0px;
+		}
 
 /* Insert generated style rules below */
 %s
@@ -214,6 +220,11 @@ TEST_CASE("Selectors")
 		"[class^=col] div",
 		"[class$=col] div",
 		"[class*=col] div",
+		".col.col4 div",
+		"div.row:focus div",
+		".row:hover .col:active",
+		":not(.col) div",
+		":not(.row):not(:hover) div",
 	};
 
 	for (int i = 0; i < NUM_COMBINATIONS + (int)complex_selectors.size(); i++)
@@ -244,17 +255,17 @@ TEST_CASE("Selectors")
 				GetNumDescendentElements(el), num_rule_iterations * 26);
 			MESSAGE(msg);
 
-			bench.run("Reference (load document)", [&] {
+			AllocationCounter::Run(bench, "Reference (load document)", [&] {
 				ElementDocument* new_document = context->LoadDocumentFromMemory(compiled_document_rml);
 				new_document->Close();
 				context->Update();
 			});
-			bench.run("Reference (update unmodified)", [&] { context->Update(); });
+			AllocationCounter::Run(bench, "Reference (update unmodified)", [&] { context->Update(); });
 		}
 
 		bool hover_active = false;
 
-		bench.run(name.c_str(), [&] {
+		AllocationCounter::Run(bench, name.c_str(), [&] {
 			hover_active = !hover_active;
 			// Toggle some arbitrary pseudo class on the element to dirty the definition on this and all descendent elements.
 			el->SetPseudoClass("hover", hover_active);
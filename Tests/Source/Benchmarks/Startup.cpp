@@ -0,0 +1,97 @@
+#include "../Common/CountingRenderInterface.h"
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
+#include "AllocationCounter.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/StartupStatistics.h>
+#include <RmlUi/Core/Types.h>
+#include <Shell.h>
+#include <doctest.h>
+#include <nanobench.h>
+
+using namespace ankerl;
+using namespace Rml;
+
+static String FormatStartupStatistics(const StartupStatistics& s)
+{
+	auto ms = [](double seconds) { return seconds * 1000.0; };
+	return CreateString("Startup statistics:\n"
+						"  Rml::Initialise:          %8.3f ms\n"
+						"    Interfaces:             %8.3f ms\n"
+						"    Font engine:            %8.3f ms\n"
+						"    Style specification:    %8.3f ms\n"
+						"    Parsers:                %8.3f ms\n"
+						"    Factory:                %8.3f ms\n"
+						"    Plugins:                %8.3f ms\n"
+						"  Font loading:             %8.3f ms (%d faces)\n"
+						"  Style sheet parsing:      %8.3f ms (%d style sheets)\n"
+						"  Document loading:         %8.3f ms (%d documents)\n"
+						"  First document:           %8.3f ms\n"
+						"  Time to first document:   %8.3f ms",
+		ms(s.initialise_time), ms(s.interfaces_time), ms(s.font_engine_time), ms(s.specification_time), ms(s.parsers_time), ms(s.factory_time),
+		ms(s.plugins_time), ms(s.font_loading_time), s.num_font_faces, ms(s.style_sheet_parsing_time), s.num_style_sheets,
+		ms(s.document_loading_time), s.num_documents, ms(s.first_document_time), ms(s.time_to_first_document));
+}
+
+TEST_CASE("startup")
+{
+	// Start from an uninitialized library, the shell is initialized again on next use.
+	TestsShell::ShutdownShell();
+
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	static CountingRenderInterface render_interface;
+
+	REQUIRE(Shell::Initialize());
+	SetSystemInterface(system_interface);
+	SetRenderInterface(&render_interface);
+
+	enum class Stage { Initialise, LoadFonts, LoadDocument, FirstFrame };
+
+	// Runs the startup sequence from initialization until the given stage, then shuts down the library.
+	auto RunStartup = [&](Stage last_stage) {
+		REQUIRE(Initialise());
+
+		Context* context = CreateContext("startup", Vector2i(1500, 800));
+		if (last_stage >= Stage::LoadFonts)
+			Shell::LoadFonts();
+
+		if (last_stage >= Stage::LoadDocument)
+		{
+			ElementDocument* document = context->LoadDocument("basic/benchmark/data/benchmark.rml");
+			if (document)
+				document->Show();
+		}
+
+		if (last_stage >= Stage::FirstFrame)
+		{
+			context->Update();
+			context->Render();
+		}
+
+		const StartupStatistics statistics = GetStartupStatistics();
+		Shutdown();
+		return statistics;
+	};
+
+	const StartupStatistics statistics = RunStartup(Stage::FirstFrame);
+	CHECK(statistics.initialise_time > 0);
+	CHECK(statistics.num_font_faces > 0);
+	CHECK(statistics.num_documents == 1);
+	MESSAGE(FormatStartupStatistics(statistics));
+
+	nanobench::Bench bench;
+	bench.title("Startup");
+	bench.timeUnit(std::chrono::milliseconds(1), "ms");
+	bench.relative(true);
+	bench.epochs(10);
+
+	AllocationCounter::Run(bench, "Initialise + Shutdown", [&] { RunStartup(Stage::Initialise); });
+	AllocationCounter::Run(bench, "Initialise + LoadFonts + Shutdown", [&] { RunStartup(Stage::LoadFonts); });
+	AllocationCounter::Run(bench, "Initialise + LoadFonts + LoadDocument + Shutdown", [&] { RunStartup(Stage::LoadDocument); });
+	AllocationCounter::Run(bench, "Initialise + LoadFonts + LoadDocument + Update + Render + Shutdown", [&] { RunStartup(Stage::FirstFrame); });
+
+	Shell::Shutdown();
+	system_interface->Reset();
+}
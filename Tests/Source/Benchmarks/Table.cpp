@@ -1,4 +1,5 @@
 #include "../Common/TestsShell.h"
+#include "AllocationCounter.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
@@ -227,18 +228,18 @@ TEST_CASE("table_basic")
 	const String msg = TestsShell::GetRenderStats();
 	MESSAGE(msg);
 
-	bench.run("Update (unmodified)", [&] { context->Update(); });
+	AllocationCounter::Run(bench, "Update (unmodified)", [&] { context->Update(); });
 
-	bench.run("Render", [&] { context->Render(); });
+	AllocationCounter::Run(bench, "Render", [&] { context->Render(); });
 
-	bench.run("SetInnerRML", [&] { document->SetInnerRML(rml_table_element); });
+	AllocationCounter::Run(bench, "SetInnerRML", [&] { document->SetInnerRML(rml_table_element); });
 
-	bench.run("SetInnerRML + Update", [&] {
+	AllocationCounter::Run(bench, "SetInnerRML + Update", [&] {
 		document->SetInnerRML(rml_table_element);
 		context->Update();
 	});
 
-	bench.run("SetInnerRML + Update + Render", [&] {
+	AllocationCounter::Run(bench, "SetInnerRML + Update + Render", [&] {
 		document->SetInnerRML(rml_table_element);
 		context->Update();
 		context->Render();
@@ -268,18 +269,18 @@ TEST_CASE("table_inline-block")
 	const String msg = TestsShell::GetRenderStats();
 	MESSAGE(msg);
 
-	bench.run("Update (unmodified)", [&] { context->Update(); });
+	AllocationCounter::Run(bench, "Update (unmodified)", [&] { context->Update(); });
 
-	bench.run("Render", [&] { context->Render(); });
+	AllocationCounter::Run(bench, "Render", [&] { context->Render(); });
 
-	bench.run("SetInnerRML", [&] { document->SetInnerRML(rml_inline_block_element); });
+	AllocationCounter::Run(bench, "SetInnerRML", [&] { document->SetInnerRML(rml_inline_block_element); });
 
-	bench.run("SetInnerRML + Update", [&] {
+	AllocationCounter::Run(bench, "SetInnerRML + Update", [&] {
 		document->SetInnerRML(rml_inline_block_element);
 		context->Update();
 	});
 
-	bench.run("SetInnerRML + Update + Render", [&] {
+	AllocationCounter::Run(bench, "SetInnerRML + Update + Render", [&] {
 		document->SetInnerRML(rml_inline_block_element);
 		context->Update();
 		context->Render();
@@ -287,3 +288,63 @@ TEST_CASE("table_inline-block")
 
 	document->Close();
 }
+
+TEST_CASE("table_data_grid")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(rml_table_document);
+	REQUIRE(document);
+	document->Show();
+
+	// A data grid of 10k cells, where a single cell is updated every frame.
+	constexpr int num_rows = 1000;
+	constexpr int num_columns = 10;
+	String rml = "<table>";
+	for (int row = 0; row < num_rows; row++)
+	{
+		rml += "<tr>";
+		for (int column = 0; column < num_columns; column++)
+			rml += CreateString("<td>%d</td>", row * num_columns + column);
+		rml += "</tr>";
+	}
+	rml += "</table>";
+	document->SetInnerRML(rml);
+
+	context->Update();
+	context->Render();
+
+	ElementList cells;
+	document->GetElementsByTagName(cells, "td");
+	REQUIRE((int)cells.size() == num_rows * num_columns);
+
+	nanobench::Bench bench;
+	bench.title("Table data grid");
+	bench.relative(true);
+
+	AllocationCounter::Run(bench, "Update (unmodified)", [&] { context->Update(); });
+
+	int counter = 0;
+	auto UpdateCell = [&] {
+		counter += 1;
+		cells[size_t(counter) * 7919 % cells.size()]->SetInnerRML(CreateString("%d", counter));
+		context->Update();
+	};
+
+	AllocationCounter::Run(bench, "Set one cell + Update", UpdateCell);
+
+	AllocationCounter::Run(bench, "Set one cell + Update + Render", [&] {
+		UpdateCell();
+		context->Render();
+	});
+
+	// Sizes measured by previous layouts are retained for all cells except the modified one.
+	UpdateCell();
+	context->Render();
+	const DocumentFrameStatistics& statistics = context->GetFrameStatistics().total;
+	MESSAGE("Measured elements after updating a single cell: ", statistics.num_layout_measures);
+	CHECK(statistics.num_layout_measures < num_rows * num_columns);
+
+	document->Close();
+}
@@ -1,5 +1,6 @@
 #include "../Common/TestsInterface.h"
 #include "../Common/TestsShell.h"
+#include "AllocationCounter.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
@@ -80,7 +81,8 @@ TEST_CASE("WidgetTextInput")
 				for (int i = 0; i < num_character_repeats; i++)
 					value += test_case.base;
 
-				bench.complexityN(num_character_repeats).epochs(1).epochIterations(num_character_repeats >= 100 ? 1 : 0).run(test_case.name, [&] {
+				bench.complexityN(num_character_repeats).epochs(1).epochIterations(num_character_repeats >= 100 ? 1 : 0);
+				AllocationCounter::Run(bench, test_case.name, [&] {
 					el->SetValue(value);
 					context->Update();
 				});
@@ -109,7 +111,8 @@ TEST_CASE("WidgetTextInput")
 				context->ProcessKeyUp(Input::KI_END, 0);
 				context->Update();
 
-				bench.complexityN(num_character_repeats).epochs(1).epochIterations(num_character_repeats >= 100 ? 1 : 0).run(test_case.name, [&] {
+				bench.complexityN(num_character_repeats).epochs(1).epochIterations(num_character_repeats >= 100 ? 1 : 0);
+				AllocationCounter::Run(bench, test_case.name, [&] {
 					context->ProcessMouseMove(250, 50, 0);
 					context->ProcessMouseButtonDown(0, 0);
 					context->ProcessMouseMove(350, 50, 0);
@@ -126,6 +129,87 @@ TEST_CASE("WidgetTextInput")
 		}
 	}
 
+	SUBCASE("LargeText")
+	{
+		bench.title("WidgetTextInput.LargeText");
+
+		// Wrapped lines of text, typed into in the middle of the text.
+		String value;
+		for (int i = 0; i < 5000; i++)
+			value += CreateString("%d: The quick brown fox jumps over the lazy dog, then the lazy dog jumps over the quick brown fox.\n", i);
+
+		el->SetValue(value);
+		el->Focus();
+		context->Update();
+
+		const int cursor_index = (int)value.size() / 2;
+		el->SetSelectionRange(cursor_index, cursor_index);
+		context->Update();
+
+		bench.epochs(1).epochIterations(100);
+		AllocationCounter::Run(bench, "type", [&] {
+			context->ProcessTextInput('a');
+			IncrementTime();
+			context->Update();
+		});
+		AllocationCounter::Run(bench, "type and delete", [&] {
+			context->ProcessTextInput('a');
+			context->ProcessKeyDown(Input::KI_BACK, 0);
+			context->ProcessKeyUp(Input::KI_BACK, 0);
+			IncrementTime();
+			context->Update();
+		});
+		AllocationCounter::Run(bench, "line break", [&] {
+			context->ProcessKeyDown(Input::KI_RETURN, 0);
+			context->ProcessTextInput('\n');
+			context->ProcessKeyUp(Input::KI_RETURN, 0);
+			IncrementTime();
+			context->Update();
+		});
+
+		// The lines reflowed after each edit should match the lines formatted from scratch.
+		const String typed_value = el->GetValue();
+		const float scroll_height = el->GetScrollHeight();
+		el->SetValue("");
+		context->Update();
+		el->SetValue(typed_value);
+		context->Update();
+		CHECK(el->GetScrollHeight() == scroll_height);
+
+		el->Blur();
+	}
+
+	SUBCASE("LargeTextScroll")
+	{
+		bench.title("WidgetTextInput.LargeTextScroll");
+
+		String value;
+		for (int i = 0; i < 5000; i++)
+			value += CreateString("%d: The quick brown fox jumps over the lazy dog, then the lazy dog jumps over the quick brown fox.\n", i);
+
+		el->SetValue(value);
+		context->Update();
+		context->Render();
+
+		const float max_scroll_top = el->GetScrollHeight() - el->GetClientHeight();
+		REQUIRE(max_scroll_top > 0);
+
+		float scroll_top = 0;
+		bench.epochs(1).epochIterations(100);
+		AllocationCounter::Run(bench, "scroll by line", [&] {
+			scroll_top = (scroll_top + 20.f > max_scroll_top ? 0.f : scroll_top + 20.f);
+			el->SetScrollTop(scroll_top);
+			context->Update();
+			context->Render();
+		});
+		AllocationCounter::Run(bench, "scroll by page", [&] {
+			scroll_top = (scroll_top + 300.f > max_scroll_top ? 0.f : scroll_top + 300.f);
+			el->SetScrollTop(scroll_top);
+			context->Update();
+			context->Render();
+		});
+	}
+
 	TestsShell::RenderLoop();
 
 	document->Close();
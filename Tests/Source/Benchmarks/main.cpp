@@ -1,4 +1,5 @@
 #include "../Common/TestsShell.h"
+#include "BenchmarkBaseline.h"
 
 #define ANKERL_NANOBENCH_IMPLEMENT
 #include <nanobench.h>
@@ -22,5 +23,7 @@ int main(int argc, char** argv)
 	// Clean everything up here.
 	TestsShell::ShutdownShell();
 
-	return doctest_result;
+	const int baseline_result = BenchmarkBaseline::Finish();
+
+	return doctest_result != 0 ? doctest_result : baseline_result;
 }
@@ -0,0 +1,191 @@
+#include "CountingRenderInterface.h"
+
+CountingRenderInterface::CountingRenderInterface() {}
+
+CountingRenderInterface::CountingRenderInterface(Features features) : features(features) {}
+
+Rml::CompiledGeometryHandle CountingRenderInterface::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
+{
+	statistics.compiled_geometries += 1;
+	const Rml::CompiledGeometryHandle handle = next_handle++;
+	geometries[handle] = GeometrySize{vertices.size(), indices.size()};
+	return handle;
+}
+
+void CountingRenderInterface::RenderGeometry(Rml::CompiledGeometryHandle geometry, Rml::Vector2f /*translation*/, Rml::TextureHandle texture)
+{
+	CountDraw(geometry, texture, 1);
+}
+
+void CountingRenderInterface::ReleaseGeometry(Rml::CompiledGeometryHandle geometry)
+{
+	statistics.released_geometries += 1;
+	geometries.erase(geometry);
+}
+
+Rml::TextureHandle CountingRenderInterface::LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& /*source*/)
+{
+	statistics.loaded_textures += 1;
+	num_textures += 1;
+	texture_dimensions = {64, 64};
+	return next_handle++;
+}
+
+Rml::TextureHandle CountingRenderInterface::GenerateTexture(Rml::Span<const Rml::byte> /*source*/, Rml::Vector2i /*source_dimensions*/)
+{
+	statistics.generated_textures += 1;
+	num_textures += 1;
+	return next_handle++;
+}
+
+void CountingRenderInterface::ReleaseTexture(Rml::TextureHandle /*texture*/)
+{
+	statistics.released_textures += 1;
+	num_textures -= 1;
+}
+
+void CountingRenderInterface::EnableScissorRegion(bool enable)
+{
+	if (enable != scissor_enabled)
+	{
+		statistics.scissor_changes += 1;
+		scissor_enabled = enable;
+	}
+}
+
+void CountingRenderInterface::SetScissorRegion(Rml::Rectanglei region)
+{
+	if (region != scissor_region)
+	{
+		statistics.scissor_changes += 1;
+		scissor_region = region;
+	}
+}
+
+bool CountingRenderInterface::UpdateTexture(Rml::TextureHandle /*texture*/, Rml::Rectanglei /*region*/, Rml::Span<const Rml::byte> /*source*/)
+{
+	statistics.updated_textures += 1;
+	return true;
+}
+
+bool CountingRenderInterface::RenderGeometryInstanced(Rml::CompiledGeometryHandle geometry, Rml::Span<const Rml::Vector2f> translations,
+	Rml::TextureHandle texture)
+{
+	if (!features.instancing)
+		return false;
+
+	statistics.instanced_draw_calls += 1;
+	CountDraw(geometry, texture, translations.size());
+	return true;
+}
+
+void CountingRenderInterface::EnableClipMask(bool enable)
+{
+	if (enable != clip_mask_enabled)
+	{
+		statistics.clip_mask_changes += 1;
+		clip_mask_enabled = enable;
+	}
+}
+
+void CountingRenderInterface::RenderToClipMask(Rml::ClipMaskOperation /*operation*/, Rml::CompiledGeometryHandle /*geometry*/,
+	Rml::Vector2f /*translation*/)
+{
+	statistics.clip_mask_renders += 1;
+}
+
+void CountingRenderInterface::RenderShaderToClipMask(Rml::ClipMaskOperation /*operation*/, Rml::CompiledShaderHandle /*shader*/,
+	Rml::CompiledGeometryHandle /*geometry*/, Rml::Vector2f /*translation*/)
+{
+	statistics.clip_mask_renders += 1;
+}
+
+void CountingRenderInterface::SetTransform(const Rml::Matrix4f* new_transform)
+{
+	const bool enable = (new_transform != nullptr);
+	if (enable != transform_enabled || (enable && *new_transform != transform))
+	{
+		statistics.transform_changes += 1;
+		transform_enabled = enable;
+		if (enable)
+			transform = *new_transform;
+	}
+}
+
+Rml::LayerHandle CountingRenderInterface::PushLayer()
+{
+	statistics.layer_pushes += 1;
+	return next_handle++;
+}
+
+void CountingRenderInterface::CompositeLayers(Rml::LayerHandle /*source*/, Rml::LayerHandle /*destination*/, Rml::BlendMode /*blend_mode*/,
+	Rml::Span<const Rml::CompiledFilterHandle> /*filters*/)
+{
+	statistics.layer_composites += 1;
+}
+
+void CountingRenderInterface::PopLayer() {}
+
+Rml::TextureHandle CountingRenderInterface::SaveLayerAsTexture()
+{
+	statistics.layer_textures += 1;
+	num_textures += 1;
+	return next_handle++;
+}
+
+Rml::CompiledFilterHandle CountingRenderInterface::SaveLayerAsMaskImage()
+{
+	statistics.layer_textures += 1;
+	return next_handle++;
+}
+
+Rml::CompiledFilterHandle CountingRenderInterface::CompileFilter(const Rml::String& /*name*/, const Rml::Dictionary& /*parameters*/)
+{
+	statistics.compiled_filters += 1;
+	return next_handle++;
+}
+
+void CountingRenderInterface::ReleaseFilter(Rml::CompiledFilterHandle /*filter*/) {}
+
+bool CountingRenderInterface::SupportsShader(const Rml::String& name)
+{
+	return features.rounded_box_shader && (name == "rounded-box" || name == "rounded-box-clip-mask");
+}
+
+Rml::CompiledShaderHandle CountingRenderInterface::CompileShader(const Rml::String& /*name*/, const Rml::Dictionary& /*parameters*/)
+{
+	statistics.compiled_shaders += 1;
+	return next_handle++;
+}
+
+void CountingRenderInterface::RenderShader(Rml::CompiledShaderHandle /*shader*/, Rml::CompiledGeometryHandle geometry, Rml::Vector2f /*translation*/,
+	Rml::TextureHandle texture)
+{
+	statistics.shader_draw_calls += 1;
+	CountDraw(geometry, texture, 1);
+}
+
+void CountingRenderInterface::ReleaseShader(Rml::CompiledShaderHandle /*shader*/) {}
+
+void CountingRenderInterface::ResetStatistics()
+{
+	statistics = {};
+}
+
+void CountingRenderInterface::CountDraw(Rml::CompiledGeometryHandle geometry, Rml::TextureHandle texture, size_t num_instances)
+{
+	statistics.draw_calls += 1;
+
+	auto it = geometries.find(geometry);
+	if (it != geometries.end())
+	{
+		statistics.vertices += it->second.num_vertices * num_instances;
+		statistics.indices += it->second.num_indices * num_instances;
+	}
+
+	if (texture != current_texture)
+	{
+		statistics.texture_switches += 1;
+		current_texture = texture;
+	}
+}
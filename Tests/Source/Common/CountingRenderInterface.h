@@ -0,0 +1,117 @@
+#pragma once
+
+#include <RmlUi/Core/RenderInterface.h>
+#include <RmlUi/Core/Types.h>
+
+/*
+    A headless render interface counting the backend-level costs of rendering, such as draw calls, state changes, and vertices.
+
+    Nothing is rendered, and images are not decoded, all loaded textures are given the same fixed size. State changes are only counted when
+    they change the current state, so that redundant calls show up as the difference to the number of calls.
+*/
+class CountingRenderInterface : public Rml::RenderInterface {
+public:
+	struct Features {
+		bool instancing = true;
+		bool rounded_box_shader = true;
+	};
+
+	struct Statistics {
+		size_t draw_calls;           // Calls rendering geometry, including instanced and shader draws.
+		size_t instanced_draw_calls; // Draw calls rendering several instances of the same geometry.
+		size_t shader_draw_calls;    // Draw calls using a compiled shader.
+		size_t vertices;             // Vertices rendered by the draw calls, counted for every instance.
+		size_t indices;              // Indices rendered by the draw calls, counted for every instance.
+
+		size_t texture_switches;  // Draw calls using a different texture than the previous draw call.
+		size_t scissor_changes;   // Changes to the enabled state or region of the scissor.
+		size_t transform_changes; // Changes to the transform.
+		size_t clip_mask_changes; // Changes to the enabled state of the clip mask.
+		size_t clip_mask_renders; // Geometry rendered to the clip mask.
+
+		size_t layer_pushes;
+		size_t layer_composites;
+		size_t layer_textures; // Layers saved as textures or mask images.
+
+		size_t compiled_geometries;
+		size_t released_geometries;
+		size_t loaded_textures;
+		size_t generated_textures;
+		size_t updated_textures;
+		size_t released_textures;
+		size_t compiled_filters;
+		size_t compiled_shaders;
+	};
+
+	CountingRenderInterface();
+	explicit CountingRenderInterface(Features features);
+
+	Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices) override;
+	void RenderGeometry(Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation, Rml::TextureHandle texture) override;
+	void ReleaseGeometry(Rml::CompiledGeometryHandle geometry) override;
+
+	Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source, Rml::Vector2i source_dimensions) override;
+	void ReleaseTexture(Rml::TextureHandle texture) override;
+
+	void EnableScissorRegion(bool enable) override;
+	void SetScissorRegion(Rml::Rectanglei region) override;
+
+	bool UpdateTexture(Rml::TextureHandle texture, Rml::Rectanglei region, Rml::Span<const Rml::byte> source) override;
+	bool RenderGeometryInstanced(Rml::CompiledGeometryHandle geometry, Rml::Span<const Rml::Vector2f> translations,
+		Rml::TextureHandle texture) override;
+
+	void EnableClipMask(bool enable) override;
+	void RenderToClipMask(Rml::ClipMaskOperation operation, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation) override;
+	void RenderShaderToClipMask(Rml::ClipMaskOperation operation, Rml::CompiledShaderHandle shader, Rml::CompiledGeometryHandle geometry,
+		Rml::Vector2f translation) override;
+
+	void SetTransform(const Rml::Matrix4f* transform) override;
+
+	Rml::LayerHandle PushLayer() override;
+	void CompositeLayers(Rml::LayerHandle source, Rml::LayerHandle destination, Rml::BlendMode blend_mode,
+		Rml::Span<const Rml::CompiledFilterHandle> filters) override;
+	void PopLayer() override;
+
+	Rml::TextureHandle SaveLayerAsTexture() override;
+	Rml::CompiledFilterHandle SaveLayerAsMaskImage() override;
+
+	Rml::CompiledFilterHandle CompileFilter(const Rml::String& name, const Rml::Dictionary& parameters) override;
+	void ReleaseFilter(Rml::CompiledFilterHandle filter) override;
+
+	bool SupportsShader(const Rml::String& name) override;
+	Rml::CompiledShaderHandle CompileShader(const Rml::String& name, const Rml::Dictionary& parameters) override;
+	void RenderShader(Rml::CompiledShaderHandle shader, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation,
+		Rml::TextureHandle texture) override;
+	void ReleaseShader(Rml::CompiledShaderHandle shader) override;
+
+	const Statistics& GetStatistics() const { return statistics; }
+	void ResetStatistics();
+
+	// Returns the number of geometries and textures currently allocated.
+	size_t GetNumGeometries() const { return geometries.size(); }
+	size_t GetNumTextures() const { return num_textures; }
+
+private:
+	struct GeometrySize {
+		size_t num_vertices;
+		size_t num_indices;
+	};
+
+	void CountDraw(Rml::CompiledGeometryHandle geometry, Rml::TextureHandle texture, size_t num_instances);
+
+	Features features;
+	Statistics statistics = {};
+
+	Rml::UnorderedMap<Rml::CompiledGeometryHandle, GeometrySize> geometries;
+	size_t num_textures = 0;
+	uintptr_t next_handle = 1;
+
+	// The current render state, used to count actual state changes.
+	Rml::TextureHandle current_texture = 0;
+	bool scissor_enabled = false;
+	Rml::Rectanglei scissor_region = Rml::Rectanglei::MakeInvalid();
+	bool clip_mask_enabled = false;
+	bool transform_enabled = false;
+	Rml::Matrix4f transform;
+};
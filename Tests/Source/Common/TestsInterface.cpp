@@ -22,7 +22,7 @@ bool TestsSystemInterface::LogMessage(Rml::Log::Type type, const Rml::String& me
 	static const char* message_type_str[Rml::Log::Type::LT_MAX] = {"Always", "Error", "Assert", "Warning", "Info", "Debug"};
 	const bool result = Rml::SystemInterface::LogMessage(type, message);
 
-	if (type <= Rml::Log::Type::LT_WARNING)
+	if (type <= Rml::Log::Type::LT_WARNING && !ignore_warnings)
 	{
 		const Rml::String warning = "RmlUi " + Rml::String(message_type_str[type]) + ": " + message;
 
@@ -61,6 +61,11 @@ void TestsSystemInterface::SetNumExpectedWarnings(int in_num_expected_warnings)
 	num_expected_warnings = in_num_expected_warnings;
 }
 
+void TestsSystemInterface::SetIgnoreWarnings(bool ignore)
+{
+	ignore_warnings = ignore;
+}
+
 void TestsSystemInterface::SetManualTime(double t)
 {
 	manual_time = true;
@@ -71,6 +76,7 @@ void TestsSystemInterface::Reset()
 {
 	SetManualTime(0);
 	manual_time = false;
+	ignore_warnings = false;
 
 	SetNumExpectedWarnings(0);
 }
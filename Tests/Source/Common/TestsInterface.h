@@ -17,6 +17,9 @@ public:
 	// warnings and errors until the next call.
 	void SetNumExpectedWarnings(int num_expected_warnings);
 
+	// Accept any number of warnings and errors until disabled, such as when loading documents not written for the tests.
+	void SetIgnoreWarnings(bool ignore);
+
 	void SetManualTime(double t);
 
 	void Reset();
@@ -25,6 +28,8 @@ private:
 	bool manual_time = false;
 	double elapsed_time = 0.0;
 
+	bool ignore_warnings = false;
+
 	int num_logged_warnings = 0;
 	int num_expected_warnings = 0;
 
@@ -31,6 +31,9 @@ TestsSystemInterface tests_system_interface;
 // The tests renderer only collects statistics, does not render anything.
 Rml::UniquePtr<TestsRenderInterface> tests_render_interface;
 
+// Render interfaces of contexts created next to the shell context.
+Rml::Vector<Rml::UniquePtr<Rml::RenderInterface>> kept_render_interfaces;
+
 class TestsShellEventListener : public Rml::EventListener {
 public:
 	void ProcessEvent(Rml::Event& event) override
@@ -101,6 +104,19 @@ Rml::Context* TestsShell::GetContext(bool allow_debugger, Rml::RenderInterface*
 	return shell_context;
 }
 
+Rml::Context* TestsShell::CreateContext(const Rml::String& name, Rml::RenderInterface* render_interface)
+{
+	REQUIRE(GetContext());
+	Rml::Context* context = Rml::CreateContext(name, window_size, render_interface);
+	REQUIRE(context);
+	return context;
+}
+
+void TestsShell::KeepRenderInterface(Rml::UniquePtr<Rml::RenderInterface> render_interface)
+{
+	kept_render_interfaces.push_back(std::move(render_interface));
+}
+
 void TestsShell::BeginFrame()
 {
 	if (use_backend_shell)
@@ -150,6 +166,7 @@ void TestsShell::ShutdownShell(bool reset_tests_render_interface)
 	Rml::Shutdown();
 
 	tests_system_interface.Reset();
+	kept_render_interfaces.clear();
 
 	if (use_backend_shell)
 		Backend::Shutdown();
@@ -12,6 +12,15 @@ namespace TestsShell {
 // Will initialize the shell and create a context on first use.
 Rml::Context* GetContext(bool allow_debugger = true, Rml::RenderInterface* override_render_interface = nullptr);
 
+// Creates a context next to the shell context, which renders through the given render interface. Remove it with 'Rml::RemoveContext()' at the
+// end of the test.
+Rml::Context* CreateContext(const Rml::String& name, Rml::RenderInterface* render_interface);
+
+// Creates a render interface for use with 'CreateContext()', which is kept alive until 'ShutdownShell()'. Render managers are only released
+// during shutdown, thus render interfaces must outlive the contexts using them.
+template <typename T>
+T& CreateRenderInterface();
+
 void BeginFrame();
 void PresentFrame();
 
@@ -34,4 +43,15 @@ TestsRenderInterface* GetTestsRenderInterface();
 void ResetTestsRenderInterface();
 TestsSystemInterface* GetTestsSystemInterface();
 
+void KeepRenderInterface(Rml::UniquePtr<Rml::RenderInterface> render_interface);
+
+template <typename T>
+T& CreateRenderInterface()
+{
+	Rml::UniquePtr<T> render_interface = Rml::MakeUnique<T>();
+	T& result = *render_interface;
+	KeepRenderInterface(std::move(render_interface));
+	return result;
+}
+
 } // namespace TestsShell
@@ -1,6 +1,7 @@
 #include "../Common/TestsInterface.h"
 #include "../Common/TestsShell.h"
 #include "../Common/TypesToString.h"
+#include <RmlUi/Core/ComputedValues.h>
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
@@ -904,3 +905,114 @@ TEST_CASE("transition.display_and_visibility")
 
 	TestsShell::ShutdownShell();
 }
+
+TEST_CASE("animation.paint_properties")
+{
+	// Animations of properties that can't affect layout update only their own computed values, make sure these stay correct, and are
+	// inherited by children.
+	static const String document_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		@keyframes fade {
+			from { opacity: 0; background-color: #000; color: #000; }
+			to   { opacity: 1; background-color: #fff; color: #fff; }
+		}
+		div {
+			width: 100px;
+			height: 100px;
+			animation: 2s fade;
+		}
+	</style>
+</head>
+<body>
+<div><p>Hello</p></div>
+</body>
+</rml>
+)";
+
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	Context* context = TestsShell::GetContext();
+
+	system_interface->SetManualTime(0.0);
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml, "assets/");
+	Element* element = document->GetChild(0);
+	Element* child = element->GetChild(0);
+	document->Show();
+	TestsShell::RenderLoop(false);
+
+	const float width_before = element->GetBox().GetSize().x;
+
+	system_interface->SetManualTime(1.0);
+	TestsShell::RenderLoop(false);
+
+	CHECK(element->GetComputedValues().opacity() == doctest::Approx(0.5f));
+	CHECK(child->GetComputedValues().opacity() == doctest::Approx(0.5f));
+	CHECK(element->GetComputedValues().background_color().red > 0);
+	CHECK(element->GetComputedValues().background_color().red < 255);
+	CHECK(child->GetComputedValues().color() == element->GetComputedValues().color());
+	CHECK(child->GetComputedValues().background_color() == Colourb(0, 0, 0, 0));
+	CHECK(element->GetBox().GetSize().x == width_before);
+
+	// Once completed, the animated properties are removed and their values must return to the defaults.
+	system_interface->SetManualTime(3.0);
+	TestsShell::RenderLoop(false);
+
+	CHECK(element->GetComputedValues().opacity() == 1.f);
+	CHECK(child->GetComputedValues().opacity() == 1.f);
+	CHECK(element->GetComputedValues().background_color() == Colourb(0, 0, 0, 0));
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("animation.detached_element")
+{
+	static const String document_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+</head>
+<body>
+<div id="parent"><div id="animated"/></div>
+</body>
+</rml>
+)";
+
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	Context* context = TestsShell::GetContext();
+
+	system_interface->SetManualTime(0.0);
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml, "assets/");
+	Element* parent = document->GetElementById("parent");
+	Element* element = document->GetElementById("animated");
+	document->Show();
+	TestsShell::RenderLoop(false);
+
+	element->SetProperty(PropertyId::Opacity, Property(0.f, Unit::NUMBER));
+	element->Animate("opacity", Property(1.f, Unit::NUMBER), 2.f);
+	TestsShell::RenderLoop(false);
+	CHECK(context->GetNextUpdateDelay() == 0);
+
+	system_interface->SetManualTime(0.5);
+	TestsShell::RenderLoop(false);
+	CHECK(element->GetComputedValues().opacity() == doctest::Approx(0.25f));
+
+	// Animations of detached elements are not advanced, and continue once attached again.
+	ElementPtr detached = parent->RemoveChild(element);
+	system_interface->SetManualTime(1.0);
+	TestsShell::RenderLoop(false);
+	CHECK(detached->GetComputedValues().opacity() == doctest::Approx(0.25f));
+
+	element = parent->AppendChild(std::move(detached));
+	TestsShell::RenderLoop(false);
+	CHECK(element->GetComputedValues().opacity() == doctest::Approx(0.5f));
+
+	system_interface->SetManualTime(3.0);
+	TestsShell::RenderLoop(false);
+	CHECK(element->GetComputedValues().opacity() == 1.f);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
@@ -0,0 +1,174 @@
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/ArchiveBuilder.h>
+#include <RmlUi/Core/ArchiveFileInterface.h>
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/Types.h>
+#include <doctest.h>
+
+using namespace Rml;
+
+static Span<const byte> ToSpan(const String& string)
+{
+	return {reinterpret_cast<const byte*>(string.data()), string.size()};
+}
+
+static String ReadAll(FileInterface& file_interface, const String& path)
+{
+	String result;
+	if (!file_interface.LoadFile(path, result))
+		return "<not found>";
+	return result;
+}
+
+TEST_CASE("archive.files")
+{
+	String large_file;
+	for (int i = 0; i < 500; i++)
+		large_file += "<div class=\"item\">" + ToString(i % 10) + "</div>\n";
+
+	ArchiveBuilder builder;
+	builder.AddFile("style.rcss", ToSpan("div { color: red; }"), false);
+	builder.AddFile("sub\\large.rml", ToSpan(large_file), true);
+	builder.AddFile("./empty.txt", ToSpan(""), true);
+	builder.AddFile("replaced.txt", ToSpan("old"), false);
+	builder.AddFile("replaced.txt", ToSpan("new"), false);
+	for (int i = 0; i < 100; i++)
+		builder.AddFile("many/" + ToString(i) + ".txt", ToSpan(ToString(i)), false);
+	CHECK(builder.GetNumFiles() == 104);
+
+	Vector<byte> archive_data;
+	REQUIRE(builder.Build(archive_data));
+
+	// The large file is compressed well below its size.
+	CHECK(archive_data.size() < large_file.size());
+
+	ArchiveFileInterface archive;
+	REQUIRE(archive.AddArchive({archive_data.data(), archive_data.size()}, "assets/"));
+
+	SUBCASE("Lookup")
+	{
+		CHECK(archive.Contains("assets/style.rcss"));
+		CHECK(archive.Contains("assets/sub/large.rml"));
+		CHECK(archive.Contains("assets\\sub\\large.rml"));
+		CHECK(archive.Contains("assets/other/../sub/./large.rml"));
+		CHECK(archive.Contains("assets/many/42.txt"));
+		CHECK_FALSE(archive.Contains("style.rcss"));
+		CHECK_FALSE(archive.Contains("assets/sub/missing.rml"));
+		CHECK_FALSE(archive.Contains("assets/many/100.txt"));
+	}
+
+	SUBCASE("Read")
+	{
+		CHECK(ReadAll(archive, "assets/style.rcss") == "div { color: red; }");
+		CHECK(ReadAll(archive, "assets/sub/large.rml") == large_file);
+		CHECK(ReadAll(archive, "assets/empty.txt") == "");
+		CHECK(ReadAll(archive, "assets/replaced.txt") == "new");
+		for (int i = 0; i < 100; i++)
+			CHECK(ReadAll(archive, "assets/many/" + ToString(i) + ".txt") == ToString(i));
+	}
+
+	SUBCASE("Seek")
+	{
+		FileHandle handle = archive.Open("assets/style.rcss");
+		REQUIRE(handle);
+		CHECK(archive.Length(handle) == 19);
+
+		char buffer[8] = {};
+		CHECK(archive.Seek(handle, -5, SEEK_END));
+		CHECK(archive.Tell(handle) == 14);
+		CHECK(archive.Read(buffer, sizeof(buffer), handle) == 5);
+		CHECK(String(buffer) == "red; ");
+
+		CHECK(archive.Seek(handle, 4, SEEK_SET));
+		CHECK(archive.Seek(handle, 2, SEEK_CUR));
+		CHECK(archive.Read(buffer, 5, handle) == 5);
+		CHECK(String(buffer, 5) == "color");
+		CHECK_FALSE(archive.Seek(handle, 1, SEEK_END));
+
+		archive.Close(handle);
+	}
+
+	SUBCASE("Map")
+	{
+		Span<const byte> data;
+		FileMappingHandle handle = 0;
+
+		// Uncompressed files are used in place.
+		REQUIRE(archive.MapFile("assets/style.rcss", data, handle));
+		CHECK(data.data() >= archive_data.data());
+		CHECK(data.data() + data.size() <= archive_data.data() + archive_data.size());
+		CHECK(String(reinterpret_cast<const char*>(data.data()), data.size()) == "div { color: red; }");
+		archive.UnmapFile(handle);
+
+		REQUIRE(archive.MapFile("assets/sub/large.rml", data, handle));
+		CHECK(String(reinterpret_cast<const char*>(data.data()), data.size()) == large_file);
+		archive.UnmapFile(handle);
+	}
+
+	SUBCASE("Override")
+	{
+		ArchiveBuilder patch_builder;
+		patch_builder.AddFile("style.rcss", ToSpan("div { color: blue; }"), false);
+		Vector<byte> patch_data;
+		REQUIRE(patch_builder.Build(patch_data));
+
+		// Archives added later take precedence.
+		REQUIRE(archive.AddArchive({patch_data.data(), patch_data.size()}, "assets"));
+		CHECK(ReadAll(archive, "assets/style.rcss") == "div { color: blue; }");
+		CHECK(ReadAll(archive, "assets/sub/large.rml") == large_file);
+	}
+
+	SUBCASE("Invalid")
+	{
+		TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+
+		Vector<byte> invalid_data = archive_data;
+		invalid_data[0] ^= 0xff;
+		system_interface->SetNumExpectedWarnings(1);
+		CHECK_FALSE(archive.AddArchive({invalid_data.data(), invalid_data.size()}));
+
+		Vector<byte> truncated_data(archive_data.begin(), archive_data.begin() + 100);
+		system_interface->SetNumExpectedWarnings(1);
+		CHECK_FALSE(archive.AddArchive({truncated_data.data(), truncated_data.size()}));
+		system_interface->SetNumExpectedWarnings(0);
+	}
+}
+
+TEST_CASE("archive.document")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ArchiveBuilder builder;
+	const String document_rml = R"(<rml><head><link type="text/rcss" href="style.rcss"/></head><body><div id="div"/></body></rml>)";
+	builder.AddFile("document.rml", ToSpan(document_rml), true);
+	builder.AddFile("style.rcss", ToSpan("div { width: 123px; }"), false);
+
+	Vector<byte> archive_data;
+	REQUIRE(builder.Build(archive_data));
+
+	ArchiveFileInterface archive;
+	REQUIRE(archive.AddArchive({archive_data.data(), archive_data.size()}, "archive"));
+
+	FileInterface* previous_file_interface = GetFileInterface();
+	SetFileInterface(&archive);
+
+	ElementDocument* document = context->LoadDocument("archive/document.rml");
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	Element* div = document->GetElementById("div");
+	REQUIRE(div);
+	CHECK(div->GetClientWidth() == 123.f);
+
+	document->Close();
+	context->Update();
+
+	SetFileInterface(previous_file_interface);
+	TestsShell::ShutdownShell();
+}
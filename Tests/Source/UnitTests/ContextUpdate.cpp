@@ -0,0 +1,300 @@
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/DataModelHandle.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <doctest.h>
+
+using namespace Rml;
+
+TEST_CASE("context_update.update_contexts")
+{
+	static const String document_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { width: 200px; height: 100px; }
+		div { width: 100px; height: 50px; background-color: #f00; }
+	</style>
+</head>
+<body>
+<div id="label"/>
+</body>
+</rml>
+)";
+
+	REQUIRE(TestsShell::GetContext());
+
+	// Display-only contexts, such as widgets placed in the game world, ignore all input and are updated together.
+	Vector<Context*> contexts;
+	Vector<Element*> labels;
+	for (int i = 0; i < 8; i++)
+	{
+		Context* context = Rml::CreateContext(CreateString("widget%d", i), Vector2i(200, 100));
+		REQUIRE(context);
+		context->SetInputEnabled(false);
+		CHECK(!context->IsInputEnabled());
+
+		ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+		REQUIRE(document);
+		document->Show();
+
+		contexts.push_back(context);
+		labels.push_back(document->GetElementById("label"));
+	}
+
+	CHECK(Context::UpdateContexts(contexts));
+	CHECK(Context::RenderContexts(contexts));
+
+	for (size_t i = 0; i < contexts.size(); i++)
+	{
+		CHECK(labels[i]->GetBox().GetSize() == Vector2f(100, 50));
+		CHECK(contexts[i]->ProcessMouseMove(50, 20, 0));
+		CHECK(contexts[i]->ProcessMouseButtonDown(0, 0));
+		CHECK(contexts[i]->ProcessKeyDown(Input::KI_A, 0));
+		CHECK(!contexts[i]->IsMouseInteracting());
+	}
+
+	// Enabling input lets the mouse interact with the elements again.
+	contexts[0]->SetInputEnabled(true);
+	contexts[0]->ProcessMouseMove(50, 20, 0);
+	CHECK(contexts[0]->GetHoverElement() == labels[0]);
+	CHECK(contexts[0]->IsMouseInteracting());
+
+	// Disabling input releases the hover state.
+	contexts[0]->SetInputEnabled(false);
+	CHECK(contexts[0]->GetHoverElement() == nullptr);
+	CHECK(!contexts[0]->IsMouseInteracting());
+
+	// Changes to a single context are laid out by the batch update.
+	labels[3]->SetProperty(PropertyId::Width, Property(150.f, Unit::PX));
+	Context::UpdateContexts(contexts);
+	CHECK(labels[3]->GetBox().GetSize() == Vector2f(150, 50));
+	CHECK(labels[2]->GetBox().GetSize() == Vector2f(100, 50));
+
+	for (Context* context : contexts)
+		REQUIRE(Rml::RemoveContext(context->GetName()));
+
+	TestsShell::ShutdownShell();
+}
+
+static const String document_dirty_region_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { width: 400px; height: 400px; }
+		div { position: absolute; width: 20px; height: 10px; background-color: #f00; }
+		#first { left: 100px; top: 50px; }
+		#second { left: 300px; top: 200px; }
+	</style>
+</head>
+<body>
+<div id="first"/>
+<div id="second"/>
+</body>
+</rml>
+)";
+
+TEST_CASE("context_update.dirty_region")
+{
+	class ScissorRenderInterface : public TestsRenderInterface {
+	public:
+		void EnableScissorRegion(bool enable) override { scissor_enabled = enable; }
+		void SetScissorRegion(Rectanglei region) override { scissor_region = region; }
+		bool scissor_enabled = false;
+		Rectanglei scissor_region;
+	};
+	ScissorRenderInterface& render_interface = TestsShell::CreateRenderInterface<ScissorRenderInterface>();
+	Context* context = TestsShell::CreateContext("dirty_region", &render_interface);
+
+	auto Covers = [](Rectanglei region, Rectanglei area) { return region.Valid() && region.Join(area) == region; };
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_dirty_region_rml);
+	REQUIRE(document);
+	document->Show();
+
+	// Everything is redrawn in the first frame.
+	context->Update();
+	CHECK(context->GetDirtyRegion() == Rectanglei::FromSize(context->GetDimensions()));
+	context->Render();
+
+	context->Update();
+	CHECK(context->GetDirtyRegion().Size() == Vector2i(0, 0));
+	context->Render();
+
+	const Rectanglei first_area = Rectanglei::FromPositionSize({100, 50}, {20, 10});
+	const Rectanglei moved_area = Rectanglei::FromPositionSize({150, 50}, {20, 10});
+	const Rectanglei second_area = Rectanglei::FromPositionSize({300, 200}, {20, 10});
+
+	// Only the changed element is dirty.
+	Element* first = document->GetElementById("first");
+	first->SetProperty(PropertyId::BackgroundColor, Property(Colourb(0, 0, 255), Unit::COLOUR));
+	context->Update();
+	CHECK(context->GetDirtyRegion() == first_area);
+	context->Render();
+
+	// Moving an element dirties both its previous and new area.
+	first->SetProperty(PropertyId::Left, Property(150.f, Unit::PX));
+	context->Update();
+	const Rectanglei dirty_region = context->GetDirtyRegion();
+	CHECK(Covers(dirty_region, first_area));
+	CHECK(Covers(dirty_region, moved_area));
+	CHECK(!Covers(dirty_region, second_area));
+
+	// With partial redraws, rendering is restricted to the dirty region.
+	context->SetPartialRedraw(true);
+	const size_t render_geometry_before = render_interface.GetCounters().render_geometry;
+	context->Render();
+	CHECK(render_interface.GetCounters().render_geometry > render_geometry_before);
+	CHECK(render_interface.scissor_region == dirty_region);
+	CHECK(!render_interface.scissor_enabled);
+
+	// Nothing is rendered when nothing has changed.
+	context->Update();
+	const size_t render_geometry_unchanged = render_interface.GetCounters().render_geometry;
+	context->Render();
+	CHECK(render_interface.GetCounters().render_geometry == render_geometry_unchanged);
+
+	// Hiding an element dirties the area it covered.
+	document->GetElementById("second")->SetProperty(PropertyId::Display, Property(Style::Display::None));
+	context->Update();
+	CHECK(Covers(context->GetDirtyRegion(), second_area));
+	CHECK(!Covers(context->GetDirtyRegion(), first_area));
+	context->Render();
+
+	document->Close();
+	Rml::RemoveContext(context->GetName());
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("context_update.idle_frames")
+{
+	static const String document_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { width: 400px; height: 400px; }
+		div { width: 100px; height: 100px; background-color: #f00; transition: background-color 1s linear-in-out; }
+		div.blue { background-color: #00f; }
+	</style>
+</head>
+<body>
+<div/>
+</body>
+</rml>
+)";
+
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	system_interface->SetManualTime(0.0);
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+
+	context->Update();
+	CHECK(context->HasVisualChanges());
+	context->Render();
+
+	context->Update();
+	CHECK(!context->HasVisualChanges());
+	context->Render();
+
+	// Every frame of the transition is a visual change, and the frames are idle again once it completes.
+	document->GetChild(0)->SetClass("blue", true);
+	for (double t : {0.0, 0.5, 1.0})
+	{
+		system_interface->SetManualTime(t);
+		context->Update();
+		CHECK(context->HasVisualChanges());
+		context->Render();
+	}
+
+	system_interface->SetManualTime(2.0);
+	context->Update();
+	context->Render();
+	context->Update();
+	CHECK(!context->HasVisualChanges());
+	CHECK(context->GetNextUpdateDelay() > 1.0);
+
+	// Skipping the render keeps the frame idle.
+	context->Update();
+	CHECK(!context->HasVisualChanges());
+
+	system_interface->SetManualTime(0.0);
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("context_update.update_budget")
+{
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	// Advance the time whenever the urgent model is updated, to use up the budget.
+	DataModelConstructor urgent_constructor = context->CreateDataModel("urgent");
+	REQUIRE(urgent_constructor);
+	urgent_constructor.BindFunc("tick", [system_interface](Variant& variant) {
+		system_interface->SetManualTime(system_interface->GetElapsedTime() + 1.0);
+		variant = "tick";
+	});
+
+	String value = "A";
+	DataModelConstructor background_constructor = context->CreateDataModel("background");
+	REQUIRE(background_constructor);
+	background_constructor.Bind("value", &value);
+	DataModelHandle background_handle = background_constructor.GetModelHandle();
+	background_handle.SetLowPriority(true);
+
+	system_interface->SetManualTime(0.0);
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<style>
+		.hidden { display: none; }
+	</style>
+</head>
+<body>
+	<div data-model="urgent">{{ tick }}</div>
+	<div data-model="background" id="background">{{ value }}</div>
+	<div id="lazy" class="hidden" lazy><p id="lazy_child"/></div>
+</body>
+</rml>
+)");
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	Element* background = document->GetElementById("background");
+	CHECK(background->GetInnerRML() == "A");
+
+	// Once the urgent model uses up the budget, the low-priority model and the lazy contents are deferred to the next update.
+	context->SetUpdateBudget(0.5);
+	value = "B";
+	background_handle.DirtyVariable("value");
+	context->GetDataModel("urgent").GetModelHandle().DirtyVariable("tick");
+	document->GetElementById("lazy")->SetClass("hidden", false);
+	context->Update();
+
+	CHECK(background->GetInnerRML() == "A");
+	CHECK_FALSE(document->GetElementById("lazy_child"));
+	CHECK(context->GetNextUpdateDelay() == 0);
+
+	context->Update();
+	CHECK(background->GetInnerRML() == "B");
+	CHECK(document->GetElementById("lazy_child"));
+
+	context->SetUpdateBudget(0);
+	system_interface->SetManualTime(0.0);
+	document->Close();
+	context->RemoveDataModel("urgent");
+	context->RemoveDataModel("background");
+	TestsShell::ShutdownShell();
+}
@@ -4,6 +4,13 @@
 #include <RmlUi/Core/Core.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/Factory.h>
+#include <RmlUi/Core/FontEngineInterface.h>
+#include <RmlUi/Core/Geometry.h>
+#include <RmlUi/Core/MeshUtilities.h>
+#include <RmlUi/Core/RenderManager.h>
+#include <RmlUi/Core/StartupStatistics.h>
+#include <RmlUi/Core/StyleSheetContainer.h>
 #include <Shell.h>
 #include <algorithm>
 #include <doctest.h>
@@ -197,6 +204,183 @@ TEST_CASE("core.load_texture_only_when_visible")
 	TestsShell::ShutdownShell();
 }
 
+TEST_CASE("core.texture_memory_budget")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	const auto& counters = render_interface->GetCounters();
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+	RenderManager& render_manager = context->GetRenderManager();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_textures_rml);
+	Element* child_div = document->GetFirstChild();
+	child_div->SetProperty(PropertyId::Display, Style::Display::Block);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	FileTextureStats stats = render_manager.GetFileTextureStats();
+	REQUIRE(stats.num_resident_textures == 4);
+	CHECK(stats.num_misses == 4);
+	CHECK(stats.resident_bytes == 4 * 512 * 256 * 4);
+
+	// Textures in use should not be released, even when over budget.
+	render_manager.SetTextureMemoryBudget(1, 2);
+	TestsShell::RenderLoop();
+	TestsShell::RenderLoop();
+	TestsShell::RenderLoop();
+	CHECK(counters.release_texture == 0);
+	CHECK(render_manager.GetFileTextureStats().num_hits > stats.num_hits);
+
+	// Once hidden for long enough, the textures should be released.
+	child_div->SetProperty(PropertyId::Display, Style::Display::None);
+	TestsShell::RenderLoop();
+	TestsShell::RenderLoop();
+	CHECK(counters.release_texture == 0);
+	TestsShell::RenderLoop();
+	TestsShell::RenderLoop();
+	stats = render_manager.GetFileTextureStats();
+	CHECK(counters.release_texture == 4);
+	CHECK(stats.num_resident_textures == 0);
+	CHECK(stats.resident_bytes == 0);
+	CHECK(stats.num_evictions == 4);
+
+	// And loaded again when shown.
+	child_div->SetProperty(PropertyId::Display, Style::Display::Block);
+	TestsShell::RenderLoop();
+	stats = render_manager.GetFileTextureStats();
+	CHECK(stats.num_resident_textures == 4);
+	CHECK(stats.num_misses == 8);
+
+	render_manager.SetTextureMemoryBudget(0);
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("core.async_texture_loading")
+{
+	class AsyncRenderInterface : public TestsRenderInterface {
+	public:
+		TextureHandle LoadTextureAsync(Vector2i& texture_dimensions, const String& source, bool& loading) override
+		{
+			// The dimensions are left unknown until the texture has been loaded.
+			loading = !ready;
+			if (loading)
+				return {};
+			return LoadTexture(texture_dimensions, source);
+		}
+		bool ready = false;
+	};
+	AsyncRenderInterface& render_interface = TestsShell::CreateRenderInterface<AsyncRenderInterface>();
+	Context* context = TestsShell::CreateContext("async", &render_interface);
+
+	RenderManager& render_manager = context->GetRenderManager();
+	render_manager.SetAsyncTextureLoading(true);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_textures_rml);
+	document->GetFirstChild()->SetProperty(PropertyId::Display, Style::Display::Block);
+	document->Show();
+
+	const auto& counters = render_interface.GetCounters();
+	const size_t render_geometry_while_loading = [&] {
+		context->Update();
+		context->Render();
+		const size_t render_geometry_before = counters.render_geometry;
+		context->Update();
+		context->Render();
+		return counters.render_geometry - render_geometry_before;
+	}();
+
+	// Geometry using the textures is skipped while they are loading.
+	CHECK(render_manager.GetFileTextureStats().num_loading_textures == 4);
+	CHECK(counters.load_texture == 0);
+
+	// The image is sized by its texture, which is laid out again once the texture has been loaded.
+	Element* image = document->QuerySelector("img");
+	REQUIRE(image);
+	CHECK(image->GetBox().GetSize() == Vector2f(0, 0));
+
+	render_interface.ready = true;
+	context->Update();
+	context->Render();
+	const size_t render_geometry_before = counters.render_geometry;
+	context->Update();
+	context->Render();
+
+	const FileTextureStats stats = render_manager.GetFileTextureStats();
+	CHECK(stats.num_loading_textures == 0);
+	CHECK(stats.num_resident_textures == 4);
+	CHECK(counters.load_texture == 4);
+	CHECK(counters.render_geometry - render_geometry_before > render_geometry_while_loading);
+	CHECK(image->GetBox().GetSize() == Vector2f(512, 256));
+
+	document->Close();
+	Rml::RemoveContext(context->GetName());
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("core.texture_atlasing")
+{
+	class AtlasRenderInterface : public TestsRenderInterface {
+	public:
+		bool LoadTextureData(Vector<byte>& out_data, Vector2i& out_dimensions, const String& source) override
+		{
+			if (source.find("icon") == String::npos)
+				return false;
+			out_dimensions = {32, 32};
+			out_data.assign(32 * 32 * 4, 255);
+			return true;
+		}
+	};
+	AtlasRenderInterface& render_interface = TestsShell::CreateRenderInterface<AtlasRenderInterface>();
+
+	static const String document_icons_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		div { height: 32px; }
+		div.fill { decorator: image(/assets/icon_c.tga); }
+		div.repeat { decorator: image(/assets/icon_d.tga repeat); }
+	</style>
+</head>
+<body>
+	<img src="/assets/icon_a.tga"/>
+	<img src="/assets/icon_b.tga"/>
+	<img src="/assets/high_scores_alien_1.tga"/>
+	<div class="fill"/>
+	<div class="repeat"/>
+</body>
+</rml>
+)";
+
+	Context* context = TestsShell::CreateContext("atlas", &render_interface);
+
+	RenderManager& render_manager = context->GetRenderManager();
+	render_manager.SetTextureAtlasing(true);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_icons_rml);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	// The icons share a single atlas page, while the large image and the repeating icon are loaded separately.
+	const auto& counters = render_interface.GetCounters();
+	const FileTextureStats stats = render_manager.GetFileTextureStats();
+	CHECK(stats.num_atlased_textures == 4);
+	CHECK(stats.num_atlas_pages == 1);
+	CHECK(counters.generate_texture == 1);
+	CHECK(counters.load_texture == 2);
+
+	document->Close();
+	Rml::RemoveContext(context->GetName());
+	TestsShell::ShutdownShell();
+}
+
 TEST_CASE("core.warn_missing_texture_once_when_visible")
 {
 	Context* context = TestsShell::GetContext();
@@ -290,6 +474,32 @@ TEST_CASE("core.release_resources")
 		CHECK(counters.generate_texture > counter_generate_before);
 	}
 
+	SUBCASE("ReleaseUnusedFontResources")
+	{
+		FontEngineInterface* font_interface = Rml::GetFontEngineInterface();
+		const FontResourceStats stats_before = font_interface->GetFontResourceStats();
+		REQUIRE(stats_before.num_face_handles > 0);
+		CHECK(stats_before.texture_bytes > 0);
+		CHECK(stats_before.glyph_bytes > 0);
+
+		// A face handle not used by any element should be released, while the ones used by the document stay valid.
+		REQUIRE(font_interface->GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 97));
+		CHECK(font_interface->GetFontResourceStats().num_face_handles == stats_before.num_face_handles + 1);
+
+		// Nothing should be released while within the budget.
+		Rml::ReleaseUnusedFontResources(size_t(-1));
+		CHECK(font_interface->GetFontResourceStats().num_face_handles == stats_before.num_face_handles + 1);
+
+		const auto counter_generate_before = counters.generate_texture;
+		Rml::ReleaseUnusedFontResources();
+		const FontResourceStats stats_after = font_interface->GetFontResourceStats();
+		CHECK(stats_after.num_face_handles <= stats_before.num_face_handles);
+		CHECK(stats_after.num_face_handles > 0);
+
+		TestsShell::RenderLoop();
+		CHECK(counters.generate_texture == counter_generate_before);
+	}
+
 	SUBCASE("FontGlyphCache")
 	{
 		const auto counter_generate_before = counters.generate_texture;
@@ -334,6 +544,103 @@ TEST_CASE("core.release_resources")
 	TestsShell::ResetTestsRenderInterface();
 }
 
+TEST_CASE("core.callback_texture_regeneration")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+	RenderManager& render_manager = context->GetRenderManager();
+	const auto& counters = render_interface->GetCounters();
+
+	constexpr int size = 128;
+	auto MakeTexture = [&]() {
+		return render_manager.MakeCallbackTexture([](const CallbackTextureInterface& texture_interface) {
+			const Vector<byte> data(size * size * 4, byte(255));
+			return texture_interface.GenerateTexture(data, Vector2i(size));
+		});
+	};
+
+	Vector<CallbackTexture> textures;
+	for (int i = 0; i < 4; i++)
+		textures.push_back(MakeTexture());
+
+	Mesh mesh;
+	MeshUtilities::GenerateQuad(mesh, Vector2f(0), Vector2f(float(size)), ColourbPremultiplied(255));
+	Geometry geometry = render_manager.MakeGeometry(std::move(mesh));
+
+	auto RenderFrame = [&]() {
+		render_interface->ResetCounters();
+		render_manager.PrepareRender(context->GetDimensions());
+		for (const CallbackTexture& texture : textures)
+			geometry.Render(Vector2f(0), texture);
+		render_manager.ResetState();
+	};
+
+	RenderFrame();
+	CHECK(counters.generate_texture == 4);
+	CHECK(counters.render_geometry == 4);
+
+	SUBCASE("Budget")
+	{
+		render_manager.SetCallbackTextureRegenerationBudget(size * size);
+
+		// Once released, the textures are regenerated one per frame, while the geometry using the other textures is skipped.
+		Rml::ReleaseTextures();
+		for (int i = 1; i <= 4; i++)
+		{
+			RenderFrame();
+			CHECK(counters.generate_texture == 1);
+			CHECK(counters.render_geometry == size_t(i));
+			CHECK(render_manager.HasPendingTextures() == (i < 4));
+		}
+
+		RenderFrame();
+		CHECK(counters.generate_texture == 0);
+		CHECK(counters.render_geometry == 4);
+
+		// Without a budget all textures are regenerated at once.
+		render_manager.SetCallbackTextureRegenerationBudget(0);
+		Rml::ReleaseTextures();
+		RenderFrame();
+		CHECK(counters.generate_texture == 4);
+		CHECK(counters.render_geometry == 4);
+		CHECK(!render_manager.HasPendingTextures());
+	}
+
+	SUBCASE("Reuse")
+	{
+		render_manager.SetCallbackTextureReuse(true);
+
+		// Released textures are kept in the pool for a couple of frames.
+		textures.pop_back();
+		CHECK(counters.release_texture == 0);
+		RenderFrame();
+		CHECK(counters.release_texture == 0);
+		RenderFrame();
+		CHECK(counters.release_texture == 1);
+
+		// The dummy renderer does not support texture updates, thus a pooled texture can not be reused and pooling is disabled.
+		textures.pop_back();
+		textures.push_back(MakeTexture());
+		RenderFrame();
+		CHECK(counters.generate_texture == 1);
+		CHECK(counters.release_texture == 1);
+
+		textures.pop_back();
+		CHECK(counters.release_texture == 2);
+
+		render_manager.SetCallbackTextureReuse(false);
+	}
+
+	textures.clear();
+	geometry.Release();
+	TestsShell::ShutdownShell();
+}
+
 TEST_CASE("core.initialize")
 {
 	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
@@ -382,6 +689,65 @@ TEST_CASE("core.observer_ptr")
 	observer_ptr.reset();
 }
 
+TEST_CASE("core.shared_style_sheets")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+	Context* other_context = Rml::CreateContext("other", context->GetDimensions());
+	REQUIRE(other_context);
+
+	// Documents loaded from the same sources share their compiled style sheet, even between contexts, while each keeps its own container with
+	// the state of its media queries.
+	ElementDocument* document = context->LoadDocumentFromMemory(document_basic_rml);
+	ElementDocument* other_document = other_context->LoadDocumentFromMemory(document_basic_rml);
+	ElementDocument* same_context_document = context->LoadDocumentFromMemory(document_basic_rml);
+	REQUIRE(document);
+	REQUIRE(other_document);
+	REQUIRE(same_context_document);
+
+	CHECK(document->GetStyleSheetContainer() != other_document->GetStyleSheetContainer());
+	CHECK(document->GetStyleSheet() != nullptr);
+	CHECK(document->GetStyleSheet() == other_document->GetStyleSheet());
+	CHECK(document->GetStyleSheet() == same_context_document->GetStyleSheet());
+
+	document->Close();
+	same_context_document->Close();
+	other_document->Close();
+	context->Update();
+	REQUIRE(Rml::RemoveContext("other"));
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("core.instanced_style_sheet_cache")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	const String rcss = "div { width: 100px; } @media (min-width: 100px) { div { height: 50px; } }";
+
+	// Instancing the same contents again reuses the parsed sheet, while each call returns its own container.
+	const int num_style_sheets_initial = Rml::GetStartupStatistics().num_style_sheets;
+	SharedPtr<StyleSheetContainer> container = Factory::InstanceStyleSheetString(rcss);
+	SharedPtr<StyleSheetContainer> other_container = Factory::InstanceStyleSheetString(rcss);
+	REQUIRE(container.get() != nullptr);
+	REQUIRE(other_container.get() != nullptr);
+	CHECK(container.get() != other_container.get());
+	CHECK(Rml::GetStartupStatistics().num_style_sheets == num_style_sheets_initial + 1);
+
+	container->UpdateCompiledStyleSheet(context);
+	other_container->UpdateCompiledStyleSheet(context);
+	CHECK(container->GetCompiledStyleSheet() != nullptr);
+	CHECK(container->GetCompiledStyleSheet() == other_container->GetCompiledStyleSheet());
+
+	// Clearing the style sheet cache parses the contents again.
+	Factory::ClearStyleSheetCache();
+	REQUIRE(Factory::InstanceStyleSheetString(rcss).get() != nullptr);
+	CHECK(Rml::GetStartupStatistics().num_style_sheets == num_style_sheets_initial + 2);
+
+	TestsShell::ShutdownShell();
+}
+
 TEST_CASE("core.RemoveContext")
 {
 	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
@@ -1,8 +1,10 @@
 #include "../Common/TestsShell.h"
+#include <RmlUi/Core/ComputedValues.h>
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/DataModelHandle.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <algorithm>
 #include <cmath>
 #include <doctest.h>
 
@@ -763,3 +765,525 @@ TEST_CASE("data_binding.data_model_on_body")
 	document->Close();
 	TestsShell::ShutdownShell();
 }
+
+static const String dirty_index_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/template" href="/assets/window.rml"/>
+	<style>
+		body.window {
+			width: 500px;
+			height: 400px;
+		}
+	</style>
+</head>
+<body template="window">
+<div data-model="dirty_index">
+	<p id="size">{{ items.size }}</p>
+	<p class="item" data-for="item : items">{{ item }}</p>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.dirty_index")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	Vector<String> items = {"a", "b"};
+
+	DataModelConstructor constructor = context->CreateDataModel("dirty_index");
+	REQUIRE(constructor);
+	REQUIRE(constructor.RegisterArray<Vector<String>>());
+	REQUIRE(constructor.Bind("items", &items));
+	DataModelHandle handle = constructor.GetModelHandle();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(dirty_index_rml);
+	REQUIRE(document);
+	document->Show();
+
+	TestsShell::RenderLoop();
+
+	auto GetItemsText = [&]() {
+		ElementList elements;
+		document->QuerySelectorAll(elements, ".item");
+		String result;
+		for (Element* element : elements)
+			result += element->GetInnerRML();
+		return result;
+	};
+
+	CHECK(GetItemsText() == "ab");
+
+	// Only the views of the dirtied element should be updated, leaving the other row stale.
+	items[0] = "x";
+	items[1] = "y";
+	handle.DirtyVariable("items", 1);
+	TestsShell::RenderLoop();
+	CHECK(GetItemsText() == "ay");
+
+	// Appending an element dirties the array size and adds the new row.
+	items.push_back("z");
+	handle.DirtyVariable("items", 2);
+	TestsShell::RenderLoop();
+	CHECK(GetItemsText() == "ayz");
+	CHECK(document->GetElementById("size")->GetInnerRML() == "3");
+
+	// Shrinking the array removes the trailing rows.
+	items.pop_back();
+	handle.DirtyVariable("items", 2);
+	TestsShell::RenderLoop();
+	CHECK(GetItemsText() == "ay");
+	CHECK(document->GetElementById("size")->GetInnerRML() == "2");
+
+	handle.DirtyVariable("items");
+	TestsShell::RenderLoop();
+	CHECK(GetItemsText() == "xy");
+
+	document->Close();
+	context->RemoveDataModel("dirty_index");
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("data_binding.watch_variable")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	Vector<String> items = {"a", "b"};
+
+	DataModelConstructor constructor = context->CreateDataModel("dirty_index");
+	REQUIRE(constructor);
+	REQUIRE(constructor.RegisterArray<Vector<String>>());
+	REQUIRE(constructor.Bind("items", &items));
+	DataModelHandle handle = constructor.GetModelHandle();
+	handle.WatchVariable("items");
+
+	ElementDocument* document = context->LoadDocumentFromMemory(dirty_index_rml);
+	REQUIRE(document);
+	document->Show();
+
+	TestsShell::RenderLoop();
+
+	auto GetItemsText = [&]() {
+		ElementList elements;
+		document->QuerySelectorAll(elements, ".item");
+		String result;
+		for (Element* element : elements)
+			result += element->GetInnerRML();
+		return result;
+	};
+
+	CHECK(GetItemsText() == "ab");
+
+	// Changes are picked up without dirtying the variable.
+	items[1] = "y";
+	TestsShell::RenderLoop();
+	CHECK(GetItemsText() == "ay");
+
+	items.push_back("z");
+	TestsShell::RenderLoop();
+	CHECK(GetItemsText() == "ayz");
+	CHECK(document->GetElementById("size")->GetInnerRML() == "3");
+
+	items.erase(items.begin());
+	TestsShell::RenderLoop();
+	CHECK(GetItemsText() == "yz");
+	CHECK(document->GetElementById("size")->GetInnerRML() == "2");
+
+	document->Close();
+	context->RemoveDataModel("dirty_index");
+
+	TestsShell::ShutdownShell();
+}
+
+static const String virtualize_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<style>
+		body {
+			width: 500px;
+			height: 400px;
+		}
+		#list {
+			height: 200px;
+			overflow: auto;
+		}
+		.row {
+			height: 20px;
+		}
+	</style>
+</head>
+<body>
+<div id="list" data-model="virtualize">
+	<div class="row" data-for="line : lines" virtualize="2">{{ line }}</div>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.virtualize")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	Vector<String> lines;
+	for (int i = 0; i < 10000; i++)
+		lines.push_back(ToString(i));
+
+	DataModelConstructor constructor = context->CreateDataModel("virtualize");
+	REQUIRE(constructor);
+	REQUIRE(constructor.RegisterArray<Vector<String>>());
+	REQUIRE(constructor.Bind("lines", &lines));
+
+	ElementDocument* document = context->LoadDocumentFromMemory(virtualize_rml);
+	REQUIRE(document);
+	document->Show();
+
+	// The rows are measured after the first layout, then only the visible rows and the overscan are instantiated.
+	TestsShell::RenderLoop();
+	TestsShell::RenderLoop();
+
+	auto GetRows = [&]() {
+		ElementList rows;
+		document->QuerySelectorAll(rows, ".row");
+		// Skip the display:none element declaring the data-for view.
+		rows.pop_back();
+		return rows;
+	};
+
+	Element* list = document->GetElementById("list");
+	ElementList rows = GetRows();
+	REQUIRE(rows.size() == 12);
+	CHECK(rows.front()->GetInnerRML() == "0");
+	CHECK(list->GetScrollHeight() == doctest::Approx(10000 * 20));
+
+	// Scrolling replaces the rows with the ones around the new viewport.
+	list->SetScrollTop(1000);
+	TestsShell::RenderLoop();
+	rows = GetRows();
+	REQUIRE(rows.size() == 14);
+	CHECK(rows.front()->GetInnerRML() == "48");
+	CHECK(rows.back()->GetInnerRML() == "61");
+	CHECK(list->GetScrollHeight() == doctest::Approx(10000 * 20));
+
+	// Shrinking the list below the viewport removes the trailing rows.
+	lines.resize(5);
+	list->SetScrollTop(0);
+	context->GetDataModel("virtualize").GetModelHandle().DirtyVariable("lines");
+	TestsShell::RenderLoop();
+	TestsShell::RenderLoop();
+	CHECK(GetRows().size() == 5);
+
+	document->Close();
+	context->RemoveDataModel("virtualize");
+
+	TestsShell::ShutdownShell();
+}
+
+static const String row_prototype_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+</head>
+<body>
+<div id="list" data-model="row_prototype">
+	<div class="row" data-for="line, i : lines"><span class="index">{{ i }}</span><p data-if="i % 2 == 0">{{ line }}</p></div>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.row_prototype")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	Vector<String> lines = {"a", "b", "c", "d"};
+
+	DataModelConstructor constructor = context->CreateDataModel("row_prototype");
+	REQUIRE(constructor);
+	REQUIRE(constructor.RegisterArray<Vector<String>>());
+	REQUIRE(constructor.Bind("lines", &lines));
+
+	ElementDocument* document = context->LoadDocumentFromMemory(row_prototype_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	// The first row is parsed, the following rows replay its parse, and all rows get their own data views.
+	auto CheckRows = [&]() {
+		ElementList rows;
+		document->QuerySelectorAll(rows, ".row");
+		rows.pop_back();
+		REQUIRE(rows.size() == lines.size());
+		for (int i = 0; i < (int)rows.size(); i++)
+		{
+			Element* index = rows[i]->QuerySelector(".index");
+			REQUIRE(index);
+			CHECK(index->GetInnerRML() == ToString(i));
+			Element* paragraph = rows[i]->QuerySelector("p");
+			REQUIRE(paragraph);
+			CHECK((paragraph->GetComputedValues().display() != Style::Display::None) == (i % 2 == 0));
+			CHECK(paragraph->GetInnerRML() == lines[i]);
+		}
+	};
+	CheckRows();
+
+	lines.push_back("e");
+	lines.push_back("f");
+	context->GetDataModel("row_prototype").GetModelHandle().DirtyVariable("lines");
+	TestsShell::RenderLoop();
+	CheckRows();
+
+	document->Close();
+	context->RemoveDataModel("row_prototype");
+
+	TestsShell::ShutdownShell();
+}
+
+static const String value_controller_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+</head>
+<body data-model="value_controller">
+	<div id="slider" data-value="slider"/>
+	<div id="committed" data-value-commit="committed"/>
+	<div id="copy" data-event-click="copy = slider"/>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.value_controller")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	int slider = 0;
+	int committed = 0;
+	int copy = 0;
+
+	DataModelConstructor constructor = context->CreateDataModel("value_controller");
+	REQUIRE(constructor);
+	REQUIRE(constructor.Bind("slider", &slider));
+	REQUIRE(constructor.Bind("committed", &committed));
+	REQUIRE(constructor.Bind("copy", &copy));
+
+	ElementDocument* document = context->LoadDocumentFromMemory(value_controller_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	auto DispatchChange = [](Element* element, int value) {
+		Dictionary parameters;
+		parameters["value"] = value;
+		element->DispatchEvent(EventId::Change, parameters);
+	};
+
+	// Repeated changes are coalesced, only the latest value is set during the next update.
+	Element* slider_element = document->GetElementById("slider");
+	for (int value : {10, 20, 30})
+		DispatchChange(slider_element, value);
+	CHECK(slider == 0);
+	CHECK(context->GetNextUpdateDelay() == 0);
+	context->Update();
+	CHECK(slider == 30);
+
+	// Data events see the latest values.
+	DispatchChange(slider_element, 40);
+	document->GetElementById("copy")->DispatchEvent(EventId::Click, Dictionary());
+	CHECK(slider == 40);
+	CHECK(copy == 40);
+
+	// Values in commit mode are only set after the value has been committed, such as when the element loses focus.
+	Element* committed_element = document->GetElementById("committed");
+	DispatchChange(committed_element, 50);
+	context->Update();
+	CHECK(committed == 0);
+	committed_element->DispatchEvent(EventId::Blur, Dictionary());
+	context->Update();
+	CHECK(committed == 50);
+
+	document->Close();
+	context->RemoveDataModel("value_controller");
+
+	TestsShell::ShutdownShell();
+}
+
+static const String profiling_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+</head>
+<body data-model="profiling">
+	<p data-if="show">{{ title }}</p>
+	<p data-for="item : items">{{ item * 2 }}</p>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.profiling")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	bool show = true;
+	String title = "Title";
+	Vector<int> items = {1, 2, 3};
+
+	DataModelConstructor constructor = context->CreateDataModel("profiling");
+	REQUIRE(constructor);
+	REQUIRE(constructor.Bind("show", &show));
+	REQUIRE(constructor.Bind("title", &title));
+	REQUIRE(constructor.Bind("items", &items));
+	DataModelHandle handle = constructor.GetModelHandle();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(profiling_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	// Nothing is recorded unless enabled.
+	CHECK(context->GetFrameStatistics().data_models.empty());
+
+	context->SetDataModelProfiling(true);
+	CHECK(context->IsDataModelProfiling());
+
+	items.push_back(4);
+	handle.DirtyVariable("items");
+	context->Update();
+	context->Render();
+
+	{
+		const auto& data_models = context->GetFrameStatistics().data_models;
+		auto it = data_models.find("profiling");
+		REQUIRE(it != data_models.end());
+		const DataModelStatistics& statistics = it->second;
+		CHECK(statistics.num_updates == 1);
+		CHECK(statistics.num_dirty_variables == 1);
+		CHECK(statistics.num_for_rows_inserted == 1);
+		CHECK(statistics.num_for_rows_removed == 0);
+		CHECK(statistics.num_view_updates >= 2);
+		CHECK(statistics.num_expression_runs >= 1);
+		CHECK(statistics.view_updates_by_type.count("for") == 1);
+		CHECK(statistics.view_updates_by_type.count("if") == 0);
+	}
+
+	// Idle frames update the model without any work.
+	context->Update();
+	context->Render();
+	{
+		const DataModelStatistics& statistics = context->GetFrameStatistics().data_models.at("profiling");
+		CHECK(statistics.num_dirty_variables == 0);
+		CHECK(statistics.num_view_updates == 0);
+		CHECK(statistics.num_expression_runs == 0);
+	}
+
+	context->SetDataModelProfiling(false);
+	context->Update();
+	context->Render();
+	CHECK(context->GetFrameStatistics().data_models.empty());
+
+	document->Close();
+	context->RemoveDataModel("profiling");
+
+	TestsShell::ShutdownShell();
+}
+
+static const String keyed_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+</head>
+<body data-model="keyed">
+	<p class="item" data-for="item, i : items" key="">{{ i }}:{{ item }}</p>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.keyed")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	Vector<String> items = {"a", "b", "c", "d"};
+
+	DataModelConstructor constructor = context->CreateDataModel("keyed");
+	REQUIRE(constructor);
+	REQUIRE(constructor.RegisterArray<Vector<String>>());
+	REQUIRE(constructor.Bind("items", &items));
+	DataModelHandle handle = constructor.GetModelHandle();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(keyed_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	auto GetRows = [&]() {
+		ElementList elements;
+		document->QuerySelectorAll(elements, ".item");
+		return elements;
+	};
+	auto GetItemsText = [&]() {
+		String result;
+		for (Element* element : GetRows())
+			result += element->GetInnerRML() + " ";
+		return result;
+	};
+	auto GetStatistics = [&]() -> const DataModelStatistics& { return context->GetFrameStatistics().data_models.at("keyed"); };
+
+	CHECK(GetItemsText() == "0:a 1:b 2:c 3:d ");
+	const ElementList initial_rows = GetRows();
+
+	context->SetDataModelProfiling(true);
+
+	// Reversing the items moves the existing rows, all but one of them.
+	std::reverse(items.begin(), items.end());
+	handle.DirtyVariable("items");
+	context->Update();
+	context->Render();
+
+	CHECK(GetItemsText() == "0:d 1:c 2:b 3:a ");
+	CHECK(GetRows() == ElementList(initial_rows.rbegin(), initial_rows.rend()));
+	CHECK(GetStatistics().num_for_rows_inserted == 0);
+	CHECK(GetStatistics().num_for_rows_removed == 0);
+	CHECK(GetStatistics().num_for_rows_moved == 3);
+
+	// Replacing an item only replaces its row, while the rows after it are kept in place.
+	items = {"e", "d", "b", "a"};
+	handle.DirtyVariable("items");
+	context->Update();
+	context->Render();
+
+	CHECK(GetItemsText() == "0:e 1:d 2:b 3:a ");
+	CHECK(GetRows()[1] == initial_rows[3]);
+	CHECK(GetRows()[3] == initial_rows[0]);
+	CHECK(GetStatistics().num_for_rows_inserted == 1);
+	CHECK(GetStatistics().num_for_rows_removed == 1);
+	CHECK(GetStatistics().num_for_rows_moved == 0);
+
+	// Removing an item shifts the index of the following rows without moving them.
+	items.erase(items.begin() + 1);
+	handle.DirtyVariable("items");
+	context->Update();
+	context->Render();
+
+	CHECK(GetItemsText() == "0:e 1:b 2:a ");
+	CHECK(GetStatistics().num_for_rows_inserted == 0);
+	CHECK(GetStatistics().num_for_rows_removed == 1);
+	CHECK(GetStatistics().num_for_rows_moved == 0);
+
+	context->SetDataModelProfiling(false);
+
+	document->Close();
+	context->RemoveDataModel("keyed");
+
+	TestsShell::ShutdownShell();
+}
@@ -173,3 +173,32 @@ TEST_CASE("Data expressions")
 	CHECK(TestExpression("true ? num_multi[0] : num_multi[999]") == "left");
 	CHECK(TestExpression("false ? num_multi[999] : num_multi[1]") == "right");
 }
+
+static Program ParseProgram(const String& expression)
+{
+	DataParser parser(expression, interface);
+	REQUIRE(parser.Parse(false));
+	return parser.ReleaseProgram();
+}
+
+TEST_CASE("Data expressions optimizations")
+{
+	// Constant subexpressions are folded into a single literal.
+	CHECK(ParseProgram("5*(1+2) + 'px'").size() == 1);
+	CHECK(ParseProgram("!!('fa' + 'lse')").size() == 1);
+	CHECK(TestExpression("5*(1+2) + 'px'") == "15px");
+	CHECK(TestExpression("2 + 3 > 4 ? 'a' : 'b'") == "a");
+
+	// Jump targets must not be folded away.
+	CHECK(TestExpression("(true ? 1 : 2) + 3") == "4");
+	CHECK(TestExpression("(false ? 1 : 2) + 3") == "5");
+	CHECK(TestExpression("1 + (false ? 1 : 2 + 3) * 2") == "11");
+	CHECK(TestExpression("'a' + (true ? 'b' : 'c') + 'd'") == "abd");
+
+	// Single literal or variable right-hand operands don't go through the stack.
+	for (const InstructionData& data : ParseProgram("(true ? 1 : 2) + 3 - 2"))
+	{
+		CHECK(data.instruction != Instruction::Push);
+		CHECK(data.instruction != Instruction::Pop);
+	}
+}
@@ -88,4 +88,92 @@ TEST_CASE("Data variables")
 		REQUIRE(model.GetVariable(ParseAddress("data.fun.magic[8]")).Get(get_result));
 		CHECK(get_result.Get<String>() == "90");
 	}
+
+	// Test resolving addresses, repeated lookups are served from the parsed address cache
+	{
+		const String str_address = "data.more_fun[2].magic[4]";
+		const DataAddress address = model.ResolveAddress(str_address, nullptr);
+		REQUIRE(address.size() == 5);
+		CHECK(address[0].name == "data");
+		CHECK(address[2].index == 2);
+		CHECK(address[4].index == 4);
+
+		const DataAddress address_repeated = model.ResolveAddress(str_address, nullptr);
+		REQUIRE(address_repeated.size() == address.size());
+		for (size_t i = 0; i < address.size(); i++)
+		{
+			CHECK(address_repeated[i].name == address[i].name);
+			CHECK(address_repeated[i].index == address[i].index);
+		}
+
+		Variant result;
+		REQUIRE(model.GetVariableInto(address_repeated, result));
+		CHECK(result.Get<int>() == data.more_fun[2].magic[4]);
+	}
+
+	// Test retrieving values as strings, they should match the values retrieved as variants and then converted
+	{
+		for (const char* str_address : {"data.more_fun[1].magic[3]", "data.more_fun[1].magic.size", "data.fun.x", "data.fun.i", "data.valid"})
+		{
+			const DataAddress address = ParseAddress(str_address);
+			Variant variant;
+			String string;
+			REQUIRE(model.GetVariableInto(address, variant));
+			REQUIRE(model.GetVariableInto(address, string));
+			CHECK(string == variant.Get<String>());
+		}
+
+		// Struct members of scalar types are read and written directly.
+		DataVariable member = model.GetVariable(ParseAddress("data.fun.i"));
+		REQUIRE(member.Set(Variant(42)));
+		CHECK(data.fun.i == 42);
+
+		String string;
+		REQUIRE(member.GetString(string));
+		CHECK(string == "42");
+	}
+}
+
+TEST_CASE("Data row references")
+{
+	DataTypeRegister types;
+	DataModel model(&types);
+	DataModelConstructor handle(&model);
+
+	Vector<int> items = {10, 20, 30};
+	handle.RegisterArray<Vector<int>>();
+	handle.Bind("items", &items);
+
+	// The elements are only used as keys by the data model.
+	int dummy_elements[4] = {};
+	Element* option = reinterpret_cast<Element*>(&dummy_elements[0]);
+	Element* value_element = reinterpret_cast<Element*>(&dummy_elements[1]);
+	Element* other_row = reinterpret_cast<Element*>(&dummy_elements[2]);
+	Element* new_row = reinterpret_cast<Element*>(&dummy_elements[3]);
+
+	auto GetItem = [&](DataAddressEntry row_reference) {
+		Variant result;
+		REQUIRE(model.GetVariableInto(DataAddress{DataAddressEntry("items"), row_reference}, result));
+		return result.Get<int>();
+	};
+
+	const DataAddressEntry reference = model.CreateRowReference(option, 1);
+	REQUIRE(model.InsertAlias(option, "item", DataAddress{DataAddressEntry("items"), reference}));
+	CHECK(GetItem(reference) == 20);
+
+	// Aliases copied to another element keep the row reference alive after the owner's aliases are erased.
+	model.CopyAliases(option, value_element);
+	model.CopyAliases(option, value_element);
+	CHECK(model.EraseAliases(option));
+
+	const DataAddressEntry other_reference = model.CreateRowReference(other_row, 2);
+	CHECK(other_reference.index != reference.index);
+	CHECK(GetItem(reference) == 20);
+	CHECK(GetItem(other_reference) == 30);
+
+	// Once the last copy is erased, the reference is released for reuse.
+	CHECK(model.EraseAliases(value_element));
+	const DataAddressEntry new_reference = model.CreateRowReference(new_row, 0);
+	CHECK(new_reference.index == reference.index);
+	CHECK(GetItem(new_reference) == 10);
 }
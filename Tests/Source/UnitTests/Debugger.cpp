@@ -129,3 +129,27 @@ TEST_CASE("debugger.focus")
 	document->Close();
 	TestsShell::ShutdownShell();
 }
+
+TEST_CASE("debugger.hidden")
+{
+	Context* context = TestsShell::GetContext(false);
+	Rml::Debugger::Initialise(context);
+
+	ElementDocument* document = context->LoadDocument("assets/demo.rml");
+	document->Show();
+	TestsShell::RenderLoop();
+
+	// The debugged context is left untouched while the debugger is hidden.
+	CHECK(!context->GetDocument("rmlui-debug-hook"));
+
+	Rml::Debugger::SetVisible(true);
+	TestsShell::RenderLoop();
+	CHECK(context->GetDocument("rmlui-debug-hook"));
+
+	Rml::Debugger::SetVisible(false);
+	TestsShell::RenderLoop();
+	CHECK(!context->GetDocument("rmlui-debug-hook"));
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
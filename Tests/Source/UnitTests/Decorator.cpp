@@ -4,6 +4,7 @@
 #include "../Common/TypesToString.h"
 #include "RmlUi/Core/DecorationTypes.h"
 #include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/DataModelHandle.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
 #include <doctest.h>
@@ -198,6 +199,227 @@ TEST_CASE("decorator.paint-area")
 	TestsShell::ShutdownShell();
 }
 
+static const String document_shared_gradients_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/../Tests/Data/style.rcss"/>
+	<style>
+		div {
+			width: 100px;
+			height: 50px;
+			decorator: linear-gradient(to right, #f00, #00f);
+		}
+		div.wide {
+			width: 200px;
+		}
+	</style>
+</head>
+
+<body>
+	<div/>
+	<div/>
+	<div/>
+</body>
+</rml>
+)";
+
+TEST_CASE("decorator.shared_gradient_shaders")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	const auto& counters = render_interface->GetCounters();
+	const size_t compile_shader_initial = counters.compile_shader;
+	const size_t release_shader_initial = counters.release_shader;
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_shared_gradients_rml, "assets/");
+	document->Show();
+	context->Update();
+	context->Render();
+
+	// Elements with identical gradients and sizes share a single compiled shader.
+	CHECK(counters.compile_shader - compile_shader_initial == 1);
+
+	// Resizing one of them compiles a new shader, while the original one is kept for the others.
+	document->GetFirstChild()->SetClass("wide", true);
+	context->Update();
+	context->Render();
+	CHECK(counters.compile_shader - compile_shader_initial == 2);
+	CHECK(counters.release_shader - release_shader_initial == 0);
+
+	document->Close();
+	context->Update();
+	CHECK(counters.release_shader - release_shader_initial == 2);
+
+	TestsShell::ShutdownShell();
+}
+
+static const String document_dp_ratio_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/../Tests/Data/style.rcss"/>
+	<style>
+		#gradient {
+			width: 100dp;
+			height: 50dp;
+			decorator: linear-gradient(to right, #f00, #00f);
+		}
+	</style>
+</head>
+
+<body>
+	<div data-model="tick">{{ tick }}</div>
+	<div id="gradient"/>
+</body>
+</rml>
+)";
+
+TEST_CASE("decorator.dp_ratio_rescale")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	if (!render_interface)
+		return;
+
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	Context* context = TestsShell::GetContext();
+	const auto& counters = render_interface->GetCounters();
+
+	// Advance the time whenever the model is updated, to use up the update budget.
+	DataModelConstructor constructor = context->CreateDataModel("tick");
+	REQUIRE(constructor);
+	constructor.BindFunc("tick", [system_interface](Variant& variant) {
+		system_interface->SetManualTime(system_interface->GetElapsedTime() + 1.0);
+		variant = "tick";
+	});
+	DataModelHandle handle = constructor.GetModelHandle();
+
+	system_interface->SetManualTime(0.0);
+	ElementDocument* document = context->LoadDocumentFromMemory(document_dp_ratio_rml, "assets/");
+	document->Show();
+	context->Update();
+	context->Render();
+	const size_t compile_shader_initial = counters.compile_shader;
+
+	// The gradient is regenerated at the new dp ratio during a later update once the budget is used up, the current one is shown meanwhile.
+	context->SetUpdateBudget(0.5);
+	context->SetDensityIndependentPixelRatio(2.f);
+	handle.DirtyVariable("tick");
+	context->Update();
+	context->Render();
+	CHECK(document->GetElementById("gradient")->GetBox().GetSize() == Vector2f(200, 100));
+	CHECK(counters.compile_shader == compile_shader_initial);
+	CHECK(context->GetNextUpdateDelay() == 0);
+
+	context->Update();
+	context->Render();
+	CHECK(counters.compile_shader == compile_shader_initial + 1);
+
+	// Without a budget the effects are regenerated immediately.
+	context->SetUpdateBudget(0);
+	context->SetDensityIndependentPixelRatio(1.f);
+	context->Update();
+	context->Render();
+	CHECK(counters.compile_shader == compile_shader_initial + 2);
+
+	system_interface->SetManualTime(0.0);
+	document->Close();
+	context->RemoveDataModel("tick");
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("decorator.shared_between_documents")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	const auto& counters = render_interface->GetCounters();
+	const size_t compile_shader_initial = counters.compile_shader;
+	const size_t release_shader_initial = counters.release_shader;
+
+	// The documents have different style sheets, yet their identical decorators are instanced once and share their compiled shaders.
+	String document_b_rml = document_shared_gradients_rml;
+	document_b_rml.replace(document_b_rml.find("div.wide"), 0, "p { color: #f00; }\n");
+	ElementDocument* document_a = context->LoadDocumentFromMemory(document_shared_gradients_rml, "assets/");
+	ElementDocument* document_b = context->LoadDocumentFromMemory(document_b_rml, "assets/");
+	REQUIRE(document_a->GetStyleSheet() != document_b->GetStyleSheet());
+	document_a->Show();
+	document_b->Show();
+	context->Update();
+	context->Render();
+	CHECK(counters.compile_shader - compile_shader_initial == 1);
+
+	// The instance is kept as long as any document uses it.
+	document_a->Close();
+	context->Update();
+	CHECK(counters.release_shader - release_shader_initial == 0);
+
+	document_b->Close();
+	context->Update();
+	CHECK(counters.release_shader - release_shader_initial == 1);
+
+	TestsShell::ShutdownShell();
+}
+
+static const String document_shared_element_data_rml = R"(
+<rml>
+<head>
+	<style>
+		div {
+			width: 100px;
+			height: 50px;
+			decorator: image(/assets/high_scores_alien_1.tga);
+		}
+		div.wide {
+			width: 200px;
+		}
+	</style>
+</head>
+
+<body>
+	<div/>
+	<div/>
+	<div/>
+</body>
+</rml>
+)";
+
+TEST_CASE("decorator.shared_element_data")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	const auto& counters = render_interface->GetCounters();
+	const size_t compile_geometry_initial = counters.compile_geometry;
+	const size_t release_geometry_initial = counters.release_geometry;
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_shared_element_data_rml);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	// Elements with identical sizes share the geometry generated by the image decorator.
+	CHECK(counters.compile_geometry - compile_geometry_initial == 1);
+
+	// Resizing one of them generates new data, while the original data is kept for the others.
+	document->GetFirstChild()->SetClass("wide", true);
+	context->Update();
+	context->Render();
+	CHECK(counters.compile_geometry - compile_geometry_initial == 2);
+	CHECK(counters.release_geometry - release_geometry_initial == 0);
+
+	document->Close();
+	context->Update();
+	CHECK(counters.release_geometry - release_geometry_initial == 2);
+
+	TestsShell::ShutdownShell();
+}
+
 TEST_CASE("decorator.gradients_and_shader")
 {
 	namespace tl = trompeloeil;
@@ -3,9 +3,15 @@
 #include "../Common/TestsShell.h"
 #include "../Common/TypesToString.h"
 #include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/DataModelHandle.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
 #include <RmlUi/Core/Factory.h>
+#include <RmlUi/Core/FrameStatistics.h>
+#include <RmlUi/Core/PropertyDictionary.h>
+#include <RmlUi/Core/StyleSheetSpecification.h>
+#include <RmlUi/Core/Transform.h>
+#include <RmlUi/Core/TransformPrimitive.h>
 #include <doctest.h>
 
 using namespace Rml;
@@ -313,6 +319,43 @@ TEST_CASE("Element")
 	TestsShell::ShutdownShell();
 }
 
+TEST_CASE("Element.ScrollOffset")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_scroll_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Run(context);
+
+	Element* scrollable = document->GetElementById("scrollable");
+	Element* cell = document->GetElementById("cell22");
+	REQUIRE(scrollable);
+	REQUIRE(cell);
+	REQUIRE(cell->GetAbsoluteOffset(Rml::BoxArea::Border) == Vector2f(100, 100));
+
+	// Descendants should see the scrolled offset right away, without any update in-between.
+	scrollable->SetScrollLeft(50);
+	scrollable->SetScrollTop(25);
+	CHECK(cell->GetAbsoluteOffset(Rml::BoxArea::Border) == Vector2f(50, 75));
+
+	scrollable->SetScrollTop(50);
+	CHECK(cell->GetAbsoluteOffset(Rml::BoxArea::Border) == Vector2f(50, 50));
+
+	Run(context);
+	CHECK(cell->GetAbsoluteOffset(Rml::BoxArea::Border) == Vector2f(50, 50));
+
+	scrollable->SetScrollLeft(0);
+	scrollable->SetScrollTop(0);
+	Run(context);
+	CHECK(cell->GetAbsoluteOffset(Rml::BoxArea::Border) == Vector2f(100, 100));
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
 TEST_CASE("Element.ScrollIntoView")
 {
 	Context* context = TestsShell::GetContext();
@@ -438,3 +481,556 @@ TEST_CASE("Element.ScrollIntoView")
 	document->Close();
 	TestsShell::ShutdownShell();
 }
+
+static const String document_clip_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body {
+			width: 400px;
+			height: 400px;
+		}
+		#clip {
+			width: 200px;
+			height: 200px;
+			overflow: hidden;
+			border-radius: 10px;
+		}
+		#clip div {
+			height: 100px;
+			background-color: #f00;
+		}
+	</style>
+</head>
+<body>
+<div id="clip"><div/><div/><div/></div>
+</body>
+</rml>
+)";
+
+TEST_CASE("Element.ClippingRegionRetained")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	if (!render_interface)
+		return;
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_clip_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* clip = document->GetElementById("clip");
+	REQUIRE(clip);
+
+	auto RenderAndCountClipMasks = [&]() {
+		context->Update();
+		render_interface->ResetCounters();
+		context->Render();
+		return render_interface->GetCounters().render_to_clip_mask;
+	};
+
+	const size_t num_clip_masks = RenderAndCountClipMasks();
+	CHECK(num_clip_masks > 0);
+
+	// Unchanged frames should submit the same clipping state.
+	CHECK(RenderAndCountClipMasks() == num_clip_masks);
+
+	// Changes to an ancestor's clipping properties must be picked up by the retained state of its descendants.
+	clip->SetProperty(PropertyId::BorderTopLeftRadius, Property(0.f, Unit::PX));
+	clip->SetProperty(PropertyId::BorderTopRightRadius, Property(0.f, Unit::PX));
+	clip->SetProperty(PropertyId::BorderBottomRightRadius, Property(0.f, Unit::PX));
+	clip->SetProperty(PropertyId::BorderBottomLeftRadius, Property(0.f, Unit::PX));
+	CHECK(RenderAndCountClipMasks() == 0);
+
+	clip->RemoveProperty(PropertyId::BorderTopLeftRadius);
+	clip->RemoveProperty(PropertyId::BorderTopRightRadius);
+	clip->RemoveProperty(PropertyId::BorderBottomRightRadius);
+	clip->RemoveProperty(PropertyId::BorderBottomLeftRadius);
+	CHECK(RenderAndCountClipMasks() == num_clip_masks);
+
+	clip->SetScrollTop(50.f);
+	CHECK(RenderAndCountClipMasks() == num_clip_masks);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Element.TransformedClippingRegion")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	if (!render_interface)
+		return;
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_clip_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* clip = document->GetElementById("clip");
+	REQUIRE(clip);
+	clip->SetProperty(PropertyId::BorderTopLeftRadius, Property(0.f, Unit::PX));
+	clip->SetProperty(PropertyId::BorderTopRightRadius, Property(0.f, Unit::PX));
+	clip->SetProperty(PropertyId::BorderBottomRightRadius, Property(0.f, Unit::PX));
+	clip->SetProperty(PropertyId::BorderBottomLeftRadius, Property(0.f, Unit::PX));
+
+	auto RenderAndCountClipMasks = [&]() {
+		context->Update();
+		render_interface->ResetCounters();
+		context->Render();
+		return render_interface->GetCounters().render_to_clip_mask;
+	};
+
+	// Transforms which keep the element aligned with the window axes are clipped by scissoring.
+	clip->SetProperty("transform", "translate(10px, 20px) scale(1.5, 0.5)");
+	CHECK(RenderAndCountClipMasks() == 0);
+
+	clip->SetProperty("transform", "rotate(180deg)");
+	CHECK(RenderAndCountClipMasks() == 0);
+
+	// Other transforms need a clip mask.
+	clip->SetProperty("transform", "rotate(30deg)");
+	CHECK(RenderAndCountClipMasks() > 0);
+
+	clip->SetProperty("transform", "translate(10px, 20px)");
+	CHECK(RenderAndCountClipMasks() == 0);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Element.TransformUpdates")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { left: 0; top: 0; right: 0; bottom: 0; }
+		#parent { width: 100px; height: 100px; font-size: 10px; transform: translateX(50%); }
+		#child { height: 10px; transform: translate(5dp, 2em); }
+	</style>
+</head>
+<body><div id="parent"><div id="child"/></div></body>
+</rml>
+)");
+	REQUIRE(document);
+	document->Show();
+
+	Element* parent = document->GetElementById("parent");
+	Element* child = document->GetElementById("child");
+	REQUIRE(parent);
+	REQUIRE(child);
+
+	auto ProjectIntoChild = [&]() {
+		context->Update();
+		context->Render();
+		Vector2f point(200, 200);
+		CHECK(child->Project(point));
+		return point;
+	};
+
+	CHECK(ProjectIntoChild() == Vector2f(145, 180));
+
+	// Unchanged frames should keep the retained transforms.
+	CHECK(ProjectIntoChild() == Vector2f(145, 180));
+
+	// The local transforms are resolved against the border box, and the transforms of descendants follow their ancestors.
+	parent->SetProperty("width", "200px");
+	CHECK(ProjectIntoChild() == Vector2f(95, 180));
+
+	// Relative units are resolved when updating the transform state, changes to them must be picked up as well.
+	parent->SetProperty("font-size", "20px");
+	CHECK(ProjectIntoChild() == Vector2f(95, 160));
+
+	context->SetDensityIndependentPixelRatio(2.f);
+	CHECK(ProjectIntoChild() == Vector2f(90, 160));
+	context->SetDensityIndependentPixelRatio(1.f);
+
+	parent->RemoveProperty("transform");
+	CHECK(ProjectIntoChild() == Vector2f(195, 160));
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Element.GenericInstancerReuse")
+{
+	REQUIRE(TestsShell::GetContext());
+
+	// Elements of specialized types are released to the free list of their instancer, and their memory reused by the next element.
+	ElementPtr image = Factory::InstanceElement(nullptr, "img", "img", XMLAttributes());
+	REQUIRE(image);
+	const Element* image_address = image.get();
+	image.reset();
+
+	ElementPtr next_image = Factory::InstanceElement(nullptr, "img", "img", XMLAttributes());
+	REQUIRE(next_image);
+	CHECK(next_image.get() == image_address);
+	CHECK(next_image->GetTagName() == "img");
+	CHECK(next_image->GetNumChildren() == 0);
+
+	next_image.reset();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Element.ClassNames")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<style>
+		div.red { color: #f00; }
+		div.red.bold { font-weight: bold; }
+		p.red { color: #00f; }
+	</style>
+</head>
+<body><div id="target"/></body>
+</rml>
+)");
+	REQUIRE(document);
+	Element* element = document->GetElementById("target");
+
+	CHECK_FALSE(element->IsClassSet("red"));
+	CHECK_FALSE(element->IsClassSet("never-used-class-name"));
+
+	element->SetClass("bold", true);
+	element->SetClass("red", true);
+	CHECK(element->IsClassSet("red"));
+	CHECK(element->GetClassNames() == "bold red");
+	context->Update();
+	CHECK(element->GetProperty<String>("color") == "#ff0000");
+	CHECK(element->GetProperty<String>("font-weight") == "bold");
+
+	element->SetClass("bold", false);
+	CHECK_FALSE(element->IsClassSet("bold"));
+	CHECK(element->GetClassNames() == "red");
+	context->Update();
+	CHECK(element->GetProperty<String>("font-weight") == "normal");
+
+	element->SetClassNames("blue red");
+	CHECK(element->IsClassSet("blue"));
+	CHECK(element->IsClassSet("red"));
+	context->Update();
+	CHECK(element->GetProperty<String>("color") == "#ff0000");
+
+	// Class names are not interned by elements, they still match selectors interned after the class was set.
+	element->SetClass("class-name-first-used-after-set", true);
+	context->Update();
+	CHECK(element->GetProperty<String>("color") == "#ff0000");
+
+	document->SetStyleSheetContainer(Factory::InstanceStyleSheetString(".class-name-first-used-after-set { color: #0f0; }"));
+	context->Update();
+	CHECK(element->GetProperty<String>("color") == "#00ff00");
+	CHECK(document->QuerySelector(".class-name-first-used-after-set") == element);
+	CHECK(document->QuerySelector(".red.class-name-first-used-after-set") == element);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Element.LazyContents")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	String title = "Lazy";
+	DataModelConstructor constructor = context->CreateDataModel("lazy");
+	REQUIRE(constructor);
+	constructor.Bind("title", &title);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<style>
+		.hidden { display: none; }
+	</style>
+</head>
+<body data-model="lazy">
+	<div id="shown" lazy><p id="shown_child">Shown</p></div>
+	<div id="hidden" class="hidden" lazy><p id="hidden_child">{{ title }}</p></div>
+	<div id="ancestor" class="hidden"><div lazy><p id="nested_child"/></div></div>
+</body>
+</rml>
+)");
+	REQUIRE(document);
+
+	// Lazy contents are instanced during the first update where they are displayed.
+	CHECK(document->GetElementById("shown_child"));
+	CHECK_FALSE(document->GetElementById("hidden_child"));
+	CHECK_FALSE(document->GetElementById("nested_child"));
+
+	Element* hidden = document->GetElementById("hidden");
+	CHECK(hidden->GetNumChildren() == 0);
+	hidden->SetClass("hidden", false);
+	context->Update();
+
+	Element* hidden_child = document->GetElementById("hidden_child");
+	REQUIRE(hidden_child);
+	CHECK(hidden_child->GetInnerRML() == "Lazy");
+	CHECK_FALSE(hidden->HasAttribute("rmlui-lazy-rml"));
+
+	title = "Bound";
+	context->GetDataModel("lazy").GetModelHandle().DirtyVariable("title");
+	context->Update();
+	CHECK(hidden_child->GetInnerRML() == "Bound");
+
+	CHECK_FALSE(document->GetElementById("nested_child"));
+	document->GetElementById("ancestor")->SetClass("hidden", false);
+	context->Update();
+	CHECK(document->GetElementById("nested_child"));
+
+	document->Close();
+	context->RemoveDataModel("lazy");
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Element.RenderCulling")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { width: 400px; height: 400px; }
+		#rows { height: 100px; overflow: hidden auto; }
+		#rows div { height: 20px; background: #333; }
+		#offscreen { position: absolute; top: 2000px; transform: rotate(10deg); }
+	</style>
+</head>
+<body>
+	<div id="rows"/>
+	<div id="offscreen"><p>A</p><p>B</p></div>
+</body>
+</rml>
+)");
+	REQUIRE(document);
+
+	Element* rows = document->GetElementById("rows");
+	for (int i = 0; i < 100; i++)
+		rows->AppendChild(document->CreateElement("div"));
+	document->Show();
+
+	const FrameStatistics& statistics = context->GetFrameStatistics();
+	context->Update();
+	context->Render();
+
+	// Rows scrolled out of view are skipped individually, the offscreen stacking context is skipped along with its descendants.
+	CHECK(statistics.total.num_culled_elements >= 95 + 1);
+	CHECK(statistics.total.num_culled_elements <= 100);
+
+	// Rows scrolled into view are rendered again, while those scrolled out of view are skipped instead.
+	rows->SetScrollTop(1000.f);
+	context->Update();
+	context->Render();
+	CHECK(statistics.total.num_culled_elements >= 95 + 1);
+	CHECK(statistics.total.num_culled_elements <= 100);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Element.ScrollbarDrag")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { width: 400px; height: 400px; }
+		#rows { width: 200px; height: 100px; overflow-y: scroll; }
+		#rows div { height: 20px; background: #333; }
+		scrollbarvertical { width: 10px; }
+		scrollbarvertical sliderbar { background: #999; }
+		scrollbarvertical sliderbar:active { background: #fff; }
+	</style>
+</head>
+<body>
+	<div id="rows"/>
+</body>
+</rml>
+)");
+	REQUIRE(document);
+
+	Element* rows = document->GetElementById("rows");
+	for (int i = 0; i < 50; i++)
+		rows->AppendChild(document->CreateElement("div"));
+	document->Show();
+	context->Update();
+	context->Render();
+
+	Element* bar = nullptr;
+	for (int i = 0; i < rows->GetNumChildren(true); i++)
+	{
+		Element* scrollbar = rows->GetChild(i);
+		if (scrollbar->GetTagName() != "scrollbarvertical")
+			continue;
+		for (int j = 0; j < scrollbar->GetNumChildren(true); j++)
+		{
+			if (scrollbar->GetChild(j)->GetTagName() == "sliderbar")
+				bar = scrollbar->GetChild(j);
+		}
+	}
+	REQUIRE(bar);
+
+	const Vector2f bar_center = bar->GetAbsoluteOffset(BoxArea::Border) + 0.5f * bar->GetBox().GetSize(BoxArea::Border);
+	Vector2i mouse_position = Vector2i(bar_center);
+	context->ProcessMouseMove(mouse_position.x, mouse_position.y, 0);
+	context->ProcessMouseButtonDown(0, 0);
+	mouse_position.y += 2;
+	context->ProcessMouseMove(mouse_position.x, mouse_position.y, 0);
+	context->Update();
+	context->Render();
+
+	// While dragging, the bar is only moved by its offset, without restyling, formatting, or regenerating the geometry of any element.
+	const FrameStatistics& statistics = context->GetFrameStatistics();
+	float scroll_top = rows->GetScrollTop();
+	for (int i = 0; i < 5; i++)
+	{
+		mouse_position.y += 5;
+		context->ProcessMouseMove(mouse_position.x, mouse_position.y, 0);
+		context->Update();
+		context->Render();
+
+		CHECK(rows->GetScrollTop() > scroll_top);
+		scroll_top = rows->GetScrollTop();
+
+		CHECK(statistics.total.num_definition_updates == 0);
+		CHECK(statistics.total.num_layout_formats == 0);
+		CHECK(statistics.total.num_background_border_rebuilds == 0);
+	}
+
+	context->ProcessMouseButtonUp(0, 0);
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Element.BatchUpdate")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<style>
+		body { width: 400px; }
+		div.row { height: 10px; }
+	</style>
+</head>
+<body>
+	<div id="list"/>
+</body>
+</rml>
+)");
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	Element* list = document->GetElementById("list");
+	{
+		ElementBatchUpdate batch;
+		for (int i = 0; i < 50; i++)
+		{
+			ElementPtr row = document->CreateElement("div");
+			row->SetClass("row", true);
+			list->AppendChild(std::move(row));
+		}
+
+		{
+			// Nested batches are propagated at the end of the outermost batch.
+			ElementBatchUpdate nested_batch;
+			list->RemoveChild(list->GetLastChild());
+		}
+		CHECK(list->GetNumChildren() == 49);
+	}
+
+	context->Update();
+	CHECK(list->GetBox().GetSize().y == doctest::Approx(490.f));
+
+	// Elements destroyed during the batch are forgotten.
+	{
+		ElementBatchUpdate batch;
+		list->GetFirstChild()->SetClass("row", false);
+		list->RemoveChild(list->GetFirstChild());
+		list->GetFirstChild()->SetProperty("height", "20px");
+	}
+
+	context->Update();
+	CHECK(list->GetBox().GetSize().y == doctest::Approx(490.f));
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Element.TypedProperties")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<style>
+		div { position: absolute; width: 100px; height: 100px; }
+	</style>
+</head>
+<body><div id="target"/></body>
+</rml>
+)");
+	REQUIRE(document);
+	document->Show();
+	Element* element = document->GetElementById("target");
+
+	CHECK(element->SetLength(PropertyId::Left, 12.f));
+	CHECK(element->SetLength(PropertyId::Width, 50.f, Unit::PERCENT));
+	CHECK(element->SetColour(PropertyId::Color, Colourb(255, 0, 0)));
+	CHECK(element->SetTransform(MakeShared<Transform>(Transform::PrimitiveList{Transforms::Rotate2D(10.f)})));
+	context->Update();
+
+	CHECK(element->GetProperty<String>("left") == "12px");
+	CHECK(element->GetProperty<String>("width") == "50%");
+	CHECK(element->GetProperty<String>("color") == "#ff0000");
+	CHECK(element->GetTransformState());
+
+	// The values are equivalent to parsed ones.
+	PropertyDictionary parsed_properties;
+	REQUIRE(StyleSheetSpecification::ParsePropertyDeclaration(parsed_properties, "left", "12px"));
+	CHECK(*element->GetLocalProperty(PropertyId::Left) == *parsed_properties.GetProperty(PropertyId::Left));
+
+	// Units not accepted by the property are rejected.
+	TestsShell::SetNumExpectedWarnings(2);
+	CHECK_FALSE(element->SetLength(PropertyId::Left, 1.f, Unit::DEG));
+	CHECK_FALSE(element->SetColour(PropertyId::Left, Colourb(0, 0, 0)));
+	CHECK(element->GetProperty<String>("left") == "12px");
+
+	// Setting the current values again leaves the element clean.
+	context->Update();
+	context->Render();
+	CHECK(element->SetLength(PropertyId::Left, 12.f));
+	CHECK(element->SetColour(PropertyId::Color, Colourb(255, 0, 0)));
+	context->Update();
+	context->Render();
+	const FrameStatistics& statistics = context->GetFrameStatistics();
+	CHECK(statistics.total.num_computed_values == 0);
+	CHECK(statistics.total.num_layout_formats == 0);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
@@ -97,6 +97,68 @@ TEST_CASE("ElementBackgroundBorder.render_stats")
 	TestsShell::ShutdownShell();
 }
 
+static const String document_grid_rml = R"(
+<rml>
+<head>
+<title>Demo</title>
+<link type="text/rcss" href="/assets/rml.rcss" />
+<link type="text/rcss" href="/../Tests/Data/style.rcss" />
+<style>
+	#wrapper > div {
+		display: inline-block;
+		width: 20px;
+		height: 20px;
+		border: 1px #fff;
+		border-radius: 3px;
+		background-color: #c33;
+	}
+</style>
+</head>
+<body>
+	<div id="wrapper">
+	</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("ElementBackgroundBorder.shared_geometry")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_grid_rml);
+	REQUIRE(document);
+	document->Show();
+
+	constexpr int num_cells = 100;
+	Element* wrapper = document->GetElementById("wrapper");
+	REQUIRE(wrapper);
+	wrapper->SetInnerRML(GenerateRowsRml(num_cells, "<div/>"));
+
+	render_interface->Reset();
+	context->Update();
+	context->Render();
+
+	// All cells have identical boxes and colors, thus they should share a single background-border geometry.
+	const auto& counters = render_interface->GetCounters();
+	CHECK(counters.render_geometry >= num_cells);
+	CHECK(counters.compile_geometry < 10);
+
+	// Changing the color of a single cell only generates new geometry for that cell.
+	render_interface->Reset();
+	wrapper->GetFirstChild()->SetProperty("background-color", "#3c3");
+	context->Update();
+	context->Render();
+	CHECK(counters.compile_geometry == 1);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
 static const String document_relative_offset_rml = R"(
 <rml>
 <head>
@@ -185,3 +247,142 @@ TEST_CASE("ElementBackgroundBorder.background_edges_line_up_with_relative_offset
 	document->Close();
 	TestsShell::ShutdownShell();
 }
+
+static const String document_rounded_box_rml = R"(
+<rml>
+<head>
+<title>Demo</title>
+<link type="text/rcss" href="/assets/rml.rcss" />
+<link type="text/rcss" href="/../Tests/Data/style.rcss" />
+<style>
+	div {
+		width: 100px;
+		height: 50px;
+		border: 2px #fff;
+		background-color: #c33;
+	}
+	#rounded {
+		border-radius: 10px;
+	}
+</style>
+</head>
+<body>
+	<div id="rounded"/>
+	<div id="square"/>
+</body>
+</rml>
+)";
+
+TEST_CASE("ElementBackgroundBorder.rounded_box_shader")
+{
+	class RoundedBoxRenderInterface : public TestsRenderInterface {
+	public:
+		bool SupportsShader(const String& name) override { return name == "rounded-box"; }
+		CompiledShaderHandle CompileShader(const String& name, const Dictionary& parameters) override
+		{
+			if (name == "rounded-box")
+				rounded_box_parameters = parameters;
+			return TestsRenderInterface::CompileShader(name, parameters);
+		}
+		Dictionary rounded_box_parameters;
+	};
+	RoundedBoxRenderInterface& render_interface = TestsShell::CreateRenderInterface<RoundedBoxRenderInterface>();
+	Context* context = TestsShell::CreateContext("rounded_box", &render_interface);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rounded_box_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	// Only the element with rounded corners is drawn using the shader, the square one is cheap to tessellate.
+	const auto& counters = render_interface.GetCounters();
+	CHECK(counters.compile_shader == 1);
+	CHECK(counters.render_shader == 1);
+
+	const Dictionary& parameters = render_interface.rounded_box_parameters;
+	CHECK(Get(parameters, "dimensions", Vector2f()) == Vector2f(104.f, 54.f));
+	CHECK(Get(parameters, "radius", Vector4f()) == Vector4f(10.f));
+	CHECK(Get(parameters, "border_widths", Vector4f()) == Vector4f(2.f));
+
+	document->Close();
+	Rml::RemoveContext(context->GetName());
+	TestsShell::ShutdownShell();
+}
+
+static const String document_rounded_clip_rml = R"(
+<rml>
+<head>
+<title>Demo</title>
+<link type="text/rcss" href="/assets/rml.rcss" />
+<link type="text/rcss" href="/../Tests/Data/style.rcss" />
+<style>
+	#card {
+		width: 100px;
+		height: 50px;
+		border: 2px #fff;
+		border-radius: 10px;
+		overflow: hidden;
+	}
+	#card div {
+		height: 100px;
+		background-color: #c33;
+	}
+</style>
+</head>
+<body>
+	<div id="card"><div/></div>
+</body>
+</rml>
+)";
+
+TEST_CASE("ElementBackgroundBorder.rounded_box_clip_mask")
+{
+	class RoundedClipRenderInterface : public TestsRenderInterface {
+	public:
+		bool SupportsShader(const String& name) override { return name == "rounded-box" || (name == "rounded-box-clip-mask" && clip_supported); }
+		CompiledShaderHandle CompileShader(const String& name, const Dictionary& parameters) override
+		{
+			if (name == "rounded-box" && Get(parameters, "border_widths", Vector4f()) == Vector4f(0.f))
+				clip_parameters = parameters;
+			return TestsRenderInterface::CompileShader(name, parameters);
+		}
+		void RenderShaderToClipMask(ClipMaskOperation /*operation*/, CompiledShaderHandle /*shader*/, CompiledGeometryHandle /*geometry*/,
+			Vector2f /*translation*/) override
+		{
+			num_shader_clip_masks += 1;
+		}
+		bool clip_supported = true;
+		Dictionary clip_parameters;
+		size_t num_shader_clip_masks = 0;
+	};
+	RoundedClipRenderInterface& render_interface = TestsShell::CreateRenderInterface<RoundedClipRenderInterface>();
+	Context* context = TestsShell::CreateContext("rounded_clip", &render_interface);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rounded_clip_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	// The overflowing content is clipped to the rounded padding box by the shader, instead of rendering its geometry to the clip mask.
+	const auto& counters = render_interface.GetCounters();
+	CHECK(render_interface.num_shader_clip_masks > 0);
+	CHECK(counters.render_to_clip_mask == 0);
+
+	const Dictionary& parameters = render_interface.clip_parameters;
+	CHECK(Get(parameters, "dimensions", Vector2f()) == Vector2f(100.f, 50.f));
+	CHECK(Get(parameters, "radius", Vector4f()) == Vector4f(8.f));
+
+	// Render interfaces without support for the shader clip mask receive the tessellated geometry.
+	render_interface.clip_supported = false;
+	document->GetElementById("card")->SetProperty("border-radius", "12px");
+	render_interface.ResetCounters();
+	context->Update();
+	context->Render();
+	CHECK(counters.render_to_clip_mask > 0);
+
+	document->Close();
+	Rml::RemoveContext(context->GetName());
+	TestsShell::ShutdownShell();
+}
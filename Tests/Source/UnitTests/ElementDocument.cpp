@@ -1,9 +1,15 @@
+#include "../../../Source/Core/StyleSheetFactory.h"
 #include "../Common/Mocks.h"
 #include "../Common/TestsShell.h"
+#include <RmlUi/Core/ArchiveBuilder.h>
+#include <RmlUi/Core/ArchiveFileInterface.h>
 #include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
 #include <RmlUi/Core/Factory.h>
+#include <RmlUi/Core/FontEngineInterface.h>
+#include <RmlUi/Core/StartupStatistics.h>
 #include <algorithm>
 #include <doctest.h>
 
@@ -258,6 +264,29 @@ TEST_CASE("Load")
 	TestsShell::ShutdownShell();
 }
 
+TEST_CASE("InlineStyleSheetCache")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	// Documents with generated style contents must not grow the inline style sheet cache indefinitely.
+	for (int i = 0; i < 300; i++)
+	{
+		const String rml = CreateString(R"(<rml><head><style>body { width: %dpx; }</style></head><body/></rml>)", i + 1);
+		ElementDocument* document = context->LoadDocumentFromMemory(rml);
+		REQUIRE(document);
+		CHECK(document->GetProperty<float>("width") == float(i + 1));
+		document->Close();
+		context->Update();
+	}
+
+	const int num_cached = StyleSheetFactory::GetNumCachedInlineStyleSheets();
+	CHECK(num_cached > 0);
+	CHECK(num_cached < 300);
+
+	TestsShell::ShutdownShell();
+}
+
 TEST_CASE("ReloadStyleSheet")
 {
 	Context* context = TestsShell::GetContext();
@@ -270,6 +299,80 @@ TEST_CASE("ReloadStyleSheet")
 	TestsShell::ShutdownShell();
 }
 
+TEST_CASE("ReloadStyleSheet.changed_files")
+{
+	Context* context = TestsShell::GetContext();
+
+	auto BuildArchive = [](const Vector<Pair<String, String>>& files) {
+		ArchiveBuilder builder;
+		for (const auto& file : files)
+			builder.AddFile(file.first, {reinterpret_cast<const byte*>(file.second.data()), file.second.size()}, false);
+		Vector<byte> data;
+		REQUIRE(builder.Build(data));
+		return data;
+	};
+
+	const Vector<byte> archive_data = BuildArchive({
+		{"document.rml",
+			R"(<rml><head><link type="text/rcss" href="a.rcss"/><link type="text/rcss" href="b.rcss"/></head>)"
+			R"(<body><div id="a"/><div><p id="b"/></div></body></rml>)"},
+		{"a.rcss", "div { width: 100px; }"},
+		{"b.rcss", "p { width: 200px; }"},
+	});
+
+	ArchiveFileInterface archive;
+	REQUIRE(archive.AddArchive({archive_data.data(), archive_data.size()}, "reload"));
+
+	FileInterface* previous_file_interface = GetFileInterface();
+	SetFileInterface(&archive);
+
+	ElementDocument* document = context->LoadDocument("reload/document.rml");
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	Element* a = document->GetElementById("a");
+	Element* b = document->GetElementById("b");
+	CHECK(a->GetClientWidth() == 100.f);
+	CHECK(b->GetClientWidth() == 200.f);
+
+	// Reloading unchanged files does not parse any sheets again.
+	const int num_style_sheets_initial = GetStartupStatistics().num_style_sheets;
+	document->ReloadStyleSheet();
+	context->Update();
+	CHECK(GetStartupStatistics().num_style_sheets == num_style_sheets_initial);
+
+	// Only the changed file is parsed again, and its changes are applied to the document.
+	const Vector<byte> patch_data = BuildArchive({{"a.rcss", "div { width: 150px; }"}});
+	REQUIRE(archive.AddArchive({patch_data.data(), patch_data.size()}, "reload"));
+
+	document->ReloadStyleSheet();
+	context->Update();
+	CHECK(GetStartupStatistics().num_style_sheets == num_style_sheets_initial + 1);
+	CHECK(a->GetClientWidth() == 150.f);
+	CHECK(b->GetClientWidth() == 200.f);
+
+	// Toggle a class which no rule depends on yet, then add a descendant rule depending on it. The paragraph is restyled by the reloaded rule
+	// even though its ancestors were not restyled when the class changed.
+	document->SetClass("a", true);
+	context->Update();
+	CHECK(b->GetClientWidth() == 200.f);
+
+	const Vector<byte> descendant_patch_data = BuildArchive({{"b.rcss", "p { width: 200px; } .a p { width: 50px; }"}});
+	REQUIRE(archive.AddArchive({descendant_patch_data.data(), descendant_patch_data.size()}, "reload"));
+
+	document->ReloadStyleSheet();
+	context->Update();
+	CHECK(a->GetClientWidth() == 150.f);
+	CHECK(b->GetClientWidth() == 50.f);
+
+	document->Close();
+	context->Update();
+
+	SetFileInterface(previous_file_interface);
+	TestsShell::ShutdownShell();
+}
+
 TEST_CASE("Modal.MultipleDocuments")
 {
 	Context* context = TestsShell::GetContext();
@@ -353,4 +456,328 @@ TEST_CASE("Modal.FocusWithin")
 	TestsShell::ShutdownShell();
 }
 
+TEST_CASE("HideShow.DeferHiddenLayout")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+	context->SetDeferHiddenLayout(true);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_focus_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	const FrameStatistics& statistics = context->GetFrameStatistics();
+	auto UpdateAndCountLayoutFormats = [&]() {
+		context->Update();
+		context->Render();
+		return statistics.total.num_layout_formats;
+	};
+
+	// Hiding and showing an unchanged document retains its layout.
+	document->Hide();
+	CHECK(UpdateAndCountLayoutFormats() == 0);
+	document->Show();
+	CHECK(UpdateAndCountLayoutFormats() == 0);
+
+	// Resizing the viewport while hidden formats the document only once it is shown again.
+	const Vector2i dimensions = context->GetDimensions();
+	document->Hide();
+	context->SetDimensions(dimensions + Vector2i(100));
+	CHECK(UpdateAndCountLayoutFormats() == 0);
+	context->SetDimensions(dimensions + Vector2i(200));
+	CHECK(UpdateAndCountLayoutFormats() == 0);
+	document->Show();
+	CHECK(UpdateAndCountLayoutFormats() == 1);
+	CHECK(UpdateAndCountLayoutFormats() == 0);
+
+	context->SetDimensions(dimensions);
+	context->SetDeferHiddenLayout(false);
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String document_viewport_rml = R"(
+<rml>
+<head>
+	<style>
+		body { display: block; width: 300px; height: 200px; left: 10%; }
+		div { display: block; height: 20px; }
+	</style>
+</head>
+<body><div/><div/></body>
+</rml>
+)";
+
+TEST_CASE("Resize.ViewportIndependentLayout")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_viewport_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	const FrameStatistics& statistics = context->GetFrameStatistics();
+	auto ResizeAndCountLayoutFormats = [&](Vector2i new_dimensions) {
+		context->SetDimensions(new_dimensions);
+		context->Update();
+		context->Render();
+		return statistics.total.num_layout_formats;
+	};
+
+	const Vector2i dimensions = context->GetDimensions();
+
+	// A document of fixed size is only positioned again.
+	CHECK(ResizeAndCountLayoutFormats(Vector2i(1000, 800)) == 0);
+	CHECK(document->GetAbsoluteLeft() == 100.f);
+	CHECK(document->GetBox().GetSize() == Vector2f(300, 200));
+
+	// Sizes relative to the viewport require formatting the document again.
+	document->SetProperty(PropertyId::Width, Property(50.f, Unit::PERCENT));
+	TestsShell::RenderLoop();
+	CHECK(ResizeAndCountLayoutFormats(Vector2i(800, 800)) == 1);
+	CHECK(document->GetBox().GetSize().x == 400.f);
+
+	document->SetProperty(PropertyId::Width, Property(50.f, Unit::VW));
+	TestsShell::RenderLoop();
+	CHECK(ResizeAndCountLayoutFormats(Vector2i(600, 800)) == 1);
+	CHECK(document->GetBox().GetSize().x == 300.f);
+
+	context->SetDimensions(dimensions);
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("LoadDocumentAsync")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	const int num_documents_initial = context->GetNumDocuments();
+
+	// With a zero budget, exactly one queued document is loaded during each update.
+	context->SetDocumentLoadBudget(0.0);
+
+	Vector<ElementDocument*> loaded_documents;
+	auto on_loaded = [&](ElementDocument* document) { loaded_documents.push_back(document); };
+
+	context->LoadDocumentAsync("assets/demo.rml", on_loaded);
+	context->LoadDocumentAsync("assets/demo.rml", on_loaded);
+	context->LoadDocumentAsync("assets/does_not_exist.rml", on_loaded);
+	CHECK(context->GetNumQueuedDocuments() == 3);
+	CHECK(context->GetNumDocuments() == num_documents_initial);
+
+	context->Update();
+	CHECK(context->GetNumQueuedDocuments() == 2);
+	REQUIRE(loaded_documents.size() == 1);
+	REQUIRE(loaded_documents[0]);
+	CHECK(loaded_documents[0]->GetElementById("title"));
+
+	context->Update();
+	CHECK(context->GetNumQueuedDocuments() == 1);
+	REQUIRE(loaded_documents.size() == 2);
+	CHECK(loaded_documents[1]);
+
+	TestsShell::SetNumExpectedWarnings(1);
+	context->Update();
+	CHECK(context->GetNumQueuedDocuments() == 0);
+	REQUIRE(loaded_documents.size() == 3);
+	CHECK(loaded_documents[2] == nullptr);
+	CHECK(context->GetNumDocuments() == num_documents_initial + 2);
+
+	context->SetDocumentLoadBudget(0.005);
+	loaded_documents[0]->Close();
+	loaded_documents[1]->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("LoadDocumentProgressive")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	// With a zero budget, a single step is taken during each update.
+	context->SetDocumentLoadBudget(0.0);
+
+	ElementDocument* loaded_document = nullptr;
+	ElementDocument* document = context->LoadDocumentProgressive("assets/demo.rml", [&](ElementDocument* d) { loaded_document = d; });
+	REQUIRE(document);
+	CHECK(context->GetDocument(context->GetNumDocuments() - 1) == document);
+	CHECK_FALSE(document->GetElementById("title"));
+
+	// Partially loaded documents can be shown while their elements are added.
+	document->Show();
+
+	int num_updates = 0;
+	int num_elements_previous = 0;
+	while (!loaded_document && num_updates < 1000)
+	{
+		context->Update();
+		num_updates += 1;
+
+		ElementList elements;
+		document->QuerySelectorAll(elements, "*");
+		const int num_elements = (int)elements.size();
+		CHECK(num_elements >= num_elements_previous);
+		num_elements_previous = num_elements;
+	}
+
+	CHECK(loaded_document == document);
+	CHECK(num_updates > 1);
+	CHECK(document->GetElementById("title"));
+
+	// The fully loaded document matches one loaded all at once.
+	ElementDocument* reference_document = context->LoadDocument("assets/demo.rml");
+	REQUIRE(reference_document);
+	ElementList elements, reference_elements;
+	document->QuerySelectorAll(elements, "*");
+	reference_document->QuerySelectorAll(reference_elements, "*");
+	CHECK(elements.size() == reference_elements.size());
+
+	// Documents closed while loading are no longer continued.
+	ElementDocument* closed_document = context->LoadDocumentProgressive("assets/demo.rml", [&](ElementDocument* d) { loaded_document = d; });
+	REQUIRE(closed_document);
+	loaded_document = nullptr;
+	closed_document->Close();
+	context->Update();
+	context->Update();
+	CHECK(loaded_document == nullptr);
+
+	context->SetDocumentLoadBudget(0.005);
+	document->Close();
+	reference_document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("PreloadDocument")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	const int num_documents_initial = context->GetNumDocuments();
+
+	// Preloaded documents are closed again right away.
+	CHECK(context->PreloadDocument("assets/demo.rml"));
+	context->Update();
+	CHECK(context->GetNumDocuments() == num_documents_initial);
+
+	TestsShell::SetNumExpectedWarnings(1);
+	CHECK_FALSE(context->PreloadDocument("assets/does_not_exist.rml"));
+
+	context->PreloadDocumentAsync("assets/demo.rml");
+	CHECK(context->GetNumQueuedDocuments() == 1);
+	context->Update();
+	CHECK(context->GetNumQueuedDocuments() == 0);
+	context->Update();
+	CHECK(context->GetNumDocuments() == num_documents_initial);
+
+	CHECK(PreloadStyleSheet("/assets/rml.rcss"));
+
+	// Glyphs are rasterized when they are added to the font face.
+	FontEngineInterface* font_interface = GetFontEngineInterface();
+	const size_t glyph_bytes_initial = font_interface->GetFontResourceStats().glyph_bytes;
+	CHECK(PreloadFontGlyphs("LatoLatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 53, "0123456789"));
+	CHECK(font_interface->GetFontResourceStats().glyph_bytes > glyph_bytes_initial);
+
+	TestsShell::ShutdownShell();
+}
+
+static const String hit_test_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<style>
+		body {
+			left: 0;
+			top: 0;
+			width: 400px;
+			height: 400px;
+		}
+		#tiles {
+			display: flex;
+			flex-wrap: wrap;
+			width: 200px;
+		}
+		#tiles div {
+			width: 20px;
+			height: 20px;
+			flex-shrink: 0;
+		}
+		#overlay {
+			position: absolute;
+			left: 50px;
+			top: 50px;
+			width: 30px;
+			height: 30px;
+			z-index: 1;
+		}
+		#rotated {
+			position: absolute;
+			left: 300px;
+			top: 0;
+			width: 40px;
+			height: 40px;
+			transform: rotate(45deg);
+		}
+	</style>
+</head>
+<body>
+<div id="tiles"/>
+<div id="overlay"/>
+<div id="rotated"/>
+</body>
+</rml>
+)";
+
+TEST_CASE("HitTest")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(hit_test_rml);
+	REQUIRE(document);
+
+	// Enough elements for the stacking context to be indexed in a grid.
+	Element* tiles = document->GetElementById("tiles");
+	for (int i = 0; i < 100; i++)
+	{
+		ElementPtr tile = document->CreateElement("div");
+		tile->SetId("t" + ToString(i));
+		tiles->AppendChild(std::move(tile));
+	}
+
+	document->Show();
+	TestsShell::RenderLoop();
+
+	auto GetIdAtPoint = [&](float x, float y) -> String {
+		Element* element = context->GetElementAtPoint(Vector2f(x, y));
+		return element ? element->GetId() : String("(none)");
+	};
+
+	CHECK(GetIdAtPoint(5, 5) == "t0");
+	CHECK(GetIdAtPoint(25, 5) == "t1");
+	CHECK(GetIdAtPoint(5, 25) == "t10");
+	CHECK(GetIdAtPoint(195, 195) == "t99");
+	CHECK(GetIdAtPoint(60, 60) == "overlay");
+	CHECK(GetIdAtPoint(320, 20) == "rotated");
+	CHECK(GetIdAtPoint(300.5f, 0.5f) != "rotated");
+
+	// Moving an element invalidates the index.
+	document->GetElementById("overlay")->SetProperty("left", "100px");
+	TestsShell::RenderLoop();
+	CHECK(GetIdAtPoint(60, 60) == "t33");
+	CHECK(GetIdAtPoint(110, 60) == "overlay");
+
+	// So does removing one.
+	tiles->RemoveChild(tiles->GetChild(0));
+	CHECK(GetIdAtPoint(5, 5) != "t0");
+	TestsShell::RenderLoop();
+	CHECK(GetIdAtPoint(5, 5) == "t1");
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
 TEST_SUITE_END();
@@ -543,3 +543,70 @@ TEST_CASE("form.select.event.change")
 
 	TestsShell::ShutdownShell();
 }
+
+TEST_CASE("form.select.many_options")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+</head>
+<body>
+<select id="sel"/>
+</body>
+</rml>
+)");
+	REQUIRE(document);
+	document->Show();
+
+	ElementFormControlSelect* select_element = rmlui_dynamic_cast<ElementFormControlSelect*>(document->GetElementById("sel"));
+	REQUIRE(select_element);
+
+	const int num_options = 1000;
+	for (int i = 0; i < num_options; i++)
+		select_element->Add(CreateString("%d", i), CreateString("%d", i));
+	context->Update();
+	context->Render();
+
+	select_element->SetSelection(500);
+	CHECK(select_element->GetSelection() == 500);
+	CHECK(select_element->GetValue() == "500");
+	CHECK(select_element->GetOption(500)->IsPseudoClassSet("checked"));
+
+	// Selecting another option clears the previous one.
+	select_element->SetSelection(600);
+	CHECK(select_element->GetSelection() == 600);
+	CHECK(!select_element->GetOption(500)->IsPseudoClassSet("checked"));
+	CHECK(!select_element->GetOption(500)->HasAttribute("selected"));
+
+	// The index of the selection follows options removed before it.
+	select_element->Remove(0);
+	CHECK(select_element->GetSelection() == 599);
+	CHECK(select_element->GetValue() == "600");
+
+	// Seeking skips options which are disabled or not displayed.
+	select_element->GetOption(600)->SetAttribute("disabled", String());
+	select_element->GetOption(601)->SetProperty(PropertyId::Display, Property(Style::Display::None));
+	context->Update();
+	context->Render();
+
+	select_element->Focus();
+	context->ProcessKeyDown(Input::KI_DOWN, 0);
+	context->Update();
+	CHECK(select_element->GetSelection() == 602);
+	CHECK(select_element->GetValue() == "603");
+
+	context->ProcessKeyDown(Input::KI_UP, 0);
+	context->Update();
+	CHECK(select_element->GetSelection() == 599);
+
+	// Removing the selected option leaves no selection until the options are updated.
+	select_element->Remove(599);
+	CHECK(select_element->GetSelection() == -1);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
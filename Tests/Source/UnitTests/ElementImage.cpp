@@ -1,3 +1,4 @@
+#include "../Common/TestsInterface.h"
 #include "../Common/TestsShell.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
@@ -162,3 +163,43 @@ TEST_CASE("elementimage.preserve_ratio")
 	document->Close();
 	TestsShell::ShutdownShell();
 }
+
+TEST_CASE("elementimage.shared_geometry")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	ElementDocument* document = context->LoadDocumentFromMemory(document_wrapped_image_rml, "assets/");
+	REQUIRE(document);
+	document->Show();
+
+	constexpr int num_images = 50;
+	String inner_rml;
+	for (int i = 0; i < num_images; i++)
+		inner_rml += (i % 2 == 0 ? "<img src=\"/assets/high_scores_alien_1.tga\" width=\"32\" height=\"32\"/>"
+								 : "<img src=\"/assets/high_scores_alien_2.tga\" width=\"32\" height=\"32\"/>");
+	Element* wrapper = document->GetFirstChild();
+	REQUIRE(wrapper);
+	wrapper->SetInnerRML(inner_rml);
+
+	render_interface->Reset();
+	context->Update();
+	context->Render();
+
+	// Images of equal size share their quad geometry, even when they use different textures.
+	const auto& counters = render_interface->GetCounters();
+	CHECK(counters.render_geometry >= num_images);
+	CHECK(counters.compile_geometry < 10);
+
+	// Resizing a single image only generates new geometry for that image.
+	render_interface->Reset();
+	wrapper->GetFirstChild()->SetAttribute("width", 40);
+	context->Update();
+	context->Render();
+	CHECK(counters.compile_geometry == 1);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
@@ -1,7 +1,10 @@
 #include "../Common/TestsShell.h"
+#include <RmlUi/Core/ComputedValues.h>
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/FrameStatistics.h>
+#include <RmlUi/Core/StyleSheet.h>
 #include <doctest.h>
 
 using namespace Rml;
@@ -56,3 +59,263 @@ TEST_CASE("elementstyle.inline_decorator_images")
 
 	TestsShell::ShutdownShell();
 }
+
+static const String document_sibling_definitions_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<style>
+		p { width: 10px; }
+		p:first-child { width: 20px; }
+		div p.x + p.x { width: 30px; }
+		p[data-a] { width: 40px; }
+		p.y { width: 50px; }
+		p.y:hover { width: 60px; }
+	</style>
+</head>
+
+<body>
+<div>
+	<p/>
+	<p/>
+	<p class="x"/>
+	<p class="x"/>
+	<p/>
+	<p data-a/>
+	<p/>
+	<p class="y"/>
+	<p class="y"/>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("elementstyle.shared_sibling_definitions")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_sibling_definitions_rml);
+	REQUIRE(document);
+	document->Show();
+
+	ElementList paragraphs;
+	document->GetElementsByTagName(paragraphs, "p");
+	REQUIRE(paragraphs.size() == 9);
+
+	auto CheckWidths = [&](const Vector<float>& expected_widths) {
+		context->Update();
+		for (size_t i = 0; i < paragraphs.size(); i++)
+		{
+			CAPTURE(i);
+			CHECK(paragraphs[i]->GetProperty<float>("width") == expected_widths[i]);
+		}
+	};
+
+	CheckWidths({20, 10, 10, 30, 10, 40, 10, 50, 50});
+
+	paragraphs[6]->SetAttribute("data-a", "");
+	paragraphs[4]->SetClass("x", true);
+	paragraphs[8]->SetPseudoClass("hover", true);
+	CheckWidths({20, 10, 10, 30, 30, 40, 40, 50, 60});
+
+	paragraphs[0]->SetClass("x", true);
+	paragraphs[1]->SetClass("x", true);
+	CheckWidths({20, 30, 30, 30, 30, 40, 40, 50, 60});
+
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
+
+static const String document_inherited_changes_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { color: #fff; }
+		.same { color: #fff; }
+		.red { color: #f00; }
+	</style>
+</head>
+<body>
+<div id="parent"><p/><p/><p/><p/><p/></div>
+</body>
+</rml>
+)";
+
+TEST_CASE("elementstyle.inherited_changes")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_inherited_changes_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	Element* parent = document->GetElementById("parent");
+	const FrameStatistics& statistics = context->GetFrameStatistics();
+
+	// Children are not recomputed when the computed values of the inherited properties stay the same.
+	parent->SetClass("same", true);
+	context->Update();
+	context->Render();
+	CHECK(statistics.total.num_computed_values == 1);
+
+	parent->SetClass("red", true);
+	context->Update();
+	context->Render();
+	CHECK(statistics.total.num_computed_values == 6);
+	CHECK(parent->GetFirstChild()->GetProperty<String>("color") == "#ff0000");
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("elementstyle.deferred_hidden_styles")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+	context->SetDeferHiddenStyles(true);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_inherited_changes_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* parent = document->GetElementById("parent");
+	parent->SetProperty(PropertyId::Display, Style::Display::None);
+	context->Update();
+	context->Render();
+
+	const FrameStatistics& statistics = context->GetFrameStatistics();
+
+	// Only the hidden element itself is updated, its children are left dirty.
+	parent->SetClass("red", true);
+	context->Update();
+	context->Render();
+	CHECK(statistics.total.num_computed_values == 1);
+
+	// Computed values are resolved on demand.
+	Element* child = parent->GetFirstChild();
+	CHECK(child->GetComputedValues().color() == Colourb(255, 0, 0));
+	CHECK(child->GetProperty<String>("color") == "#ff0000");
+
+	parent->SetClass("red", false);
+	context->Update();
+	CHECK(child->GetComputedValues().color() == Colourb(255, 255, 255));
+
+	// The remaining children are updated once the parent is displayed again.
+	Element* last_child = parent->GetLastChild();
+	parent->RemoveProperty(PropertyId::Display);
+	context->Update();
+	context->Render();
+	CHECK(statistics.total.num_computed_values >= 5);
+	CHECK(last_child->GetComputedValues().color() == Colourb(255, 255, 255));
+
+	context->SetDeferHiddenStyles(false);
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("elementstyle.definition_cache")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	constexpr int num_classes = 1000;
+	String rml = "<rml><head><style>";
+	for (int i = 0; i < num_classes; i++)
+		rml += CreateString(".c%d { width: %dpx; }\n", i, i);
+	rml += "</style></head><body><div id=\"div\"/></body></rml>";
+
+	ElementDocument* document = context->LoadDocumentFromMemory(rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	Element* div = document->GetElementById("div");
+	const StyleSheet* style_sheet = document->GetStyleSheet();
+	REQUIRE(style_sheet);
+	const int num_definitions_initial = style_sheet->GetElementDefinitionCacheStats().num_definitions;
+
+	// Each class yields a new definition, those no longer in use should be evicted.
+	for (int i = 0; i < num_classes; i++)
+	{
+		div->SetClassNames(CreateString("c%d", i));
+		context->Update();
+	}
+
+	ElementDefinitionCacheStats stats = style_sheet->GetElementDefinitionCacheStats();
+	CHECK(stats.num_misses >= num_classes);
+	CHECK(stats.num_evictions > 0);
+	CHECK(stats.num_definitions < num_definitions_initial + num_classes);
+	CHECK(stats.num_definitions + stats.num_evictions == stats.num_misses);
+	CHECK(div->GetProperty<float>("width") == float(num_classes - 1));
+
+	// Recently used definitions are not evicted.
+	const int num_hits = stats.num_hits;
+	div->SetClassNames(CreateString("c%d", num_classes - 2));
+	context->Update();
+	CHECK(style_sheet->GetElementDefinitionCacheStats().num_hits == num_hits + 1);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String document_shared_values_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { color: #0f0; }
+		.red { color: #f00; }
+	</style>
+</head>
+<body>
+	<div id="parent"><p id="child">Child</p><p id="red" class="red">Red</p></div>
+</body>
+</rml>
+)";
+
+TEST_CASE("elementstyle.shared_inherited_values")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_shared_values_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	Element* parent = document->GetElementById("parent");
+	Element* child = document->GetElementById("child");
+	Element* red = document->GetElementById("red");
+
+	// Children without any local inherited properties share the values of their parent.
+	CHECK(child->GetComputedValues().SharesInheritedValues(parent->GetComputedValues()));
+	CHECK(!red->GetComputedValues().SharesInheritedValues(parent->GetComputedValues()));
+	CHECK(red->GetComputedValues().color() == Colourb(255, 0, 0));
+
+	// Changing the parent must not modify the values of its children, until they are inherited again.
+	parent->SetProperty(PropertyId::Color, Property(Colourb(0, 0, 255), Unit::COLOUR));
+	context->Update();
+	CHECK(parent->GetComputedValues().color() == Colourb(0, 0, 255));
+	CHECK(child->GetComputedValues().color() == Colourb(0, 0, 255));
+	CHECK(red->GetComputedValues().color() == Colourb(255, 0, 0));
+
+	child->SetClass("red", true);
+	context->Update();
+	CHECK(child->GetComputedValues().color() == Colourb(255, 0, 0));
+	CHECK(parent->GetComputedValues().color() == Colourb(0, 0, 255));
+
+	child->SetClass("red", false);
+	parent->SetProperty(PropertyId::FontSize, Property(20.f, Unit::PX));
+	context->Update();
+	CHECK(child->GetComputedValues().font_size() == 20.f);
+	CHECK(child->GetComputedValues().SharesInheritedValues(parent->GetComputedValues()));
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
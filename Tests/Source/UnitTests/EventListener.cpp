@@ -5,6 +5,7 @@
 #include <RmlUi/Core/EventListener.h>
 #include <RmlUi/Core/EventListenerInstancer.h>
 #include <RmlUi/Core/Factory.h>
+#include <RmlUi/Core/InputBatch.h>
 #include <doctest.h>
 
 using namespace Rml;
@@ -134,3 +135,292 @@ TEST_CASE("event_listener.replace_current_element")
 	Rml::Factory::RegisterEventListenerInstancer(nullptr);
 	TestsShell::ShutdownShell();
 }
+
+TEST_CASE("event_listener.input_coalescing")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_decorator_rml, "assets/");
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	struct RecordingListener : EventListener {
+		void ProcessEvent(Event& event) override
+		{
+			String entry = event.GetType();
+			if (event.GetId() == EventId::Mousescroll)
+				entry += " " + ToString(int(event.GetParameter("wheel_delta_y", 0.f)));
+			else
+				entry += " " + ToString(event.GetParameter("mouse_x", 0));
+			events.push_back(entry);
+		}
+		Vector<String> events;
+	};
+	RecordingListener listener;
+	for (const char* event : {"mousemove", "mousedown", "mousescroll"})
+		document->AddEventListener(event, &listener);
+
+	context->SetInputCoalescing(true);
+	CHECK(context->IsInputCoalescing());
+
+	// Consecutive moves are merged into a single move to the latest position during the next update.
+	for (int x = 10; x <= 30; x += 5)
+		context->ProcessMouseMove(x, 32, 0);
+	CHECK(listener.events.empty());
+	context->Update();
+	REQUIRE(listener.events.size() == 1);
+	CHECK(listener.events[0] == "mousemove 30");
+	listener.events.clear();
+
+	// Other input processes the queue first.
+	context->ProcessMouseMove(40, 32, 0);
+	context->ProcessMouseMove(45, 32, 0);
+	context->ProcessMouseButtonDown(0, 0);
+	context->ProcessMouseButtonUp(0, 0);
+	REQUIRE(listener.events.size() == 2);
+	CHECK(listener.events[0] == "mousemove 45");
+	CHECK(listener.events[1] == "mousedown 45");
+	listener.events.clear();
+
+	// Wheel deltas are accumulated.
+	context->ProcessMouseWheel(Vector2f(0.f, 1.f), 0);
+	context->ProcessMouseWheel(Vector2f(0.f, 2.f), 0);
+	context->SetInputCoalescing(false);
+	REQUIRE(listener.events.size() == 1);
+	CHECK(listener.events[0] == "mousescroll 3");
+
+	for (const char* event : {"mousemove", "mousedown", "mousescroll"})
+		document->RemoveEventListener(event, &listener);
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("event_listener.input_batch")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_decorator_rml, "assets/");
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	struct RecordingListener : EventListener {
+		void ProcessEvent(Event& event) override
+		{
+			String entry = event.GetType();
+			if (event.GetId() == EventId::Textinput)
+				entry += " " + event.GetParameter("text", String());
+			else if (event.GetId() == EventId::Mousescroll)
+				entry += " " + ToString(int(event.GetParameter("wheel_delta_y", 0.f)));
+			else
+				entry += " " + ToString(event.GetParameter("mouse_x", 0));
+			events.push_back(entry);
+		}
+		Vector<String> events;
+	};
+	RecordingListener listener;
+	for (const char* event : {"mousemove", "mousedown", "mousescroll", "textinput"})
+		document->AddEventListener(event, &listener);
+
+	InputBatch batch;
+	for (int x = 10; x <= 30; x += 5)
+		batch.MouseMove(x, 32, 0);
+	batch.MouseButtonDown(0, 0);
+	batch.MouseButtonUp(0, 0);
+	batch.MouseWheel(Vector2f(0.f, 1.f), 0);
+	batch.MouseWheel(Vector2f(0.f, 2.f), 0);
+	batch.TextInput("ab");
+	batch.TextInput(Character('c'));
+
+	// Directly following input of the same kind is merged as it is added.
+	REQUIRE(batch.GetEvents().size() == 5);
+	CHECK(batch.GetEvents()[0].value == Vector2f(30.f, 32.f));
+	CHECK(batch.GetEvents()[3].value == Vector2f(0.f, 3.f));
+	CHECK(String(batch.GetText(batch.GetEvents()[4])) == "abc");
+
+	// The events are processed in order.
+	context->ProcessInputBatch(batch);
+	REQUIRE(listener.events.size() == 4);
+	CHECK(listener.events[0] == "mousemove 30");
+	CHECK(listener.events[1] == "mousedown 30");
+	CHECK(listener.events[2] == "mousescroll 3");
+	CHECK(listener.events[3] == "textinput abc");
+
+	batch.Clear();
+	CHECK(batch.IsEmpty());
+
+	batch.TouchMove(Touch{1, Vector2f(10.f, 10.f)}, 0);
+	batch.TouchMove(Touch{2, Vector2f(20.f, 20.f)}, 0);
+	batch.TouchMove(Touch{1, Vector2f(15.f, 15.f)}, 0);
+	REQUIRE(batch.GetEvents().size() == 1);
+	const Span<const Touch> touches = batch.GetTouches(batch.GetEvents()[0]);
+	REQUIRE(touches.size() == 2);
+	CHECK(touches[0].position == Vector2f(15.f, 15.f));
+	CHECK(touches[1].position == Vector2f(20.f, 20.f));
+
+	for (const char* event : {"mousemove", "mousedown", "mousescroll", "textinput"})
+		document->RemoveEventListener(event, &listener);
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("event_listener.hover_chain")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		div { display: block; height: 20px; }
+		#outer { height: 40px; }
+	</style>
+</head>
+<body>
+<div id="outer">
+	<div id="inner"><div id="a"/></div>
+	<div id="b"/>
+</div>
+</body>
+</rml>)");
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	struct RecordingListener : EventListener {
+		void ProcessEvent(Event& event) override { events.push_back(event.GetType() + " " + event.GetTargetElement()->GetId()); }
+		Vector<String> events;
+	};
+	RecordingListener listener;
+	document->AddEventListener("mouseover", &listener, true);
+	document->AddEventListener("mouseout", &listener, true);
+
+	Element* outer = document->GetElementById("outer");
+	Element* inner = document->GetElementById("inner");
+	Element* a = document->GetElementById("a");
+	Element* b = document->GetElementById("b");
+
+	context->ProcessMouseMove(10, 10, 0);
+	CHECK(context->GetHoverElement() == a);
+	CHECK(a->IsPseudoClassSet("hover"));
+	CHECK(outer->IsPseudoClassSet("hover"));
+	listener.events.clear();
+
+	// Moving within the same element does not send any events.
+	context->ProcessMouseMove(12, 10, 0);
+	CHECK(listener.events.empty());
+
+	// Only the elements below the common ancestor are left and entered, from the leaf up and then down to the new leaf.
+	context->ProcessMouseMove(10, 30, 0);
+	CHECK(context->GetHoverElement() == b);
+	CHECK(listener.events == Vector<String>{"mouseout a", "mouseout inner", "mouseover b"});
+	CHECK(!a->IsPseudoClassSet("hover"));
+	CHECK(!inner->IsPseudoClassSet("hover"));
+	CHECK(b->IsPseudoClassSet("hover"));
+	CHECK(outer->IsPseudoClassSet("hover"));
+	listener.events.clear();
+
+	context->ProcessMouseMove(10, 10, 0);
+	CHECK(listener.events == Vector<String>{"mouseout b", "mouseover inner", "mouseover a"});
+
+	// Removing hovered elements leaves a valid chain behind.
+	outer->RemoveChild(inner);
+	listener.events.clear();
+	TestsShell::RenderLoop();
+	context->ProcessMouseMove(10, 12, 0);
+	CHECK(context->GetHoverElement() == b);
+	CHECK(listener.events == Vector<String>{"mouseover b"});
+	CHECK(outer->IsPseudoClassSet("hover"));
+
+	document->RemoveEventListener("mouseover", &listener, true);
+	document->RemoveEventListener("mouseout", &listener, true);
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("event_listener.attach_detach")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_decorator_rml, "assets/");
+	REQUIRE(document);
+	Element* button = document->GetElementById("exit");
+	REQUIRE(button);
+
+	struct CountingListener : EventListener {
+		void ProcessEvent(Event& /*event*/) override { num_events += 1; }
+		int num_events = 0;
+	};
+	CountingListener document_listener, button_listener;
+
+	// Events without any listeners are skipped entirely, make sure they are delivered again once listeners are attached.
+	CHECK(button->DispatchEvent("scroll", Dictionary()));
+
+	document->AddEventListener("scroll", &document_listener);
+	button->AddEventListener("scroll", &button_listener);
+	button->AddEventListener("animationend", &button_listener);
+	button->DispatchEvent("scroll", Dictionary());
+	CHECK(document_listener.num_events == 1);
+	CHECK(button_listener.num_events == 1);
+
+	// Detaching one of the events leaves the other ones working.
+	button->RemoveEventListener("scroll", &button_listener);
+	button->DispatchEvent("scroll", Dictionary());
+	button->DispatchEvent("animationend", Dictionary());
+	CHECK(document_listener.num_events == 2);
+	CHECK(button_listener.num_events == 2);
+
+	document->RemoveEventListener("scroll", &document_listener);
+	button->RemoveEventListener("animationend", &button_listener);
+	button->DispatchEvent("scroll", Dictionary());
+	button->DispatchEvent("animationend", Dictionary());
+	CHECK(document_listener.num_events == 2);
+	CHECK(button_listener.num_events == 2);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("event_listener.reused_events")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_decorator_rml, "assets/");
+	REQUIRE(document);
+	Element* button = document->GetElementById("exit");
+	REQUIRE(button);
+
+	struct ParameterListener : EventListener {
+		void ProcessEvent(Event& event) override
+		{
+			values.push_back(event.GetParameter("value", -1));
+			phases.push_back(event.GetPhase());
+			if (event.GetParameter("stop", false))
+				event.StopPropagation();
+		}
+		Vector<int> values;
+		Vector<EventPhase> phases;
+	};
+	ParameterListener listener;
+	button->AddEventListener("reusedevent", &listener);
+	document->AddEventListener("reusedevent", &listener);
+
+	// Events are recycled between dispatches, make sure no state carries over from the previous event.
+	button->DispatchEvent("reusedevent", Dictionary{{"value", Variant(1)}, {"stop", Variant(true)}});
+	button->DispatchEvent("reusedevent", Dictionary());
+
+	CHECK(listener.values == Vector<int>{1, -1, -1});
+	CHECK(listener.phases == Vector<EventPhase>{EventPhase::Target, EventPhase::Target, EventPhase::Bubble});
+
+	button->RemoveEventListener("reusedevent", &listener);
+	document->RemoveEventListener("reusedevent", &listener);
+	document->Close();
+	TestsShell::ShutdownShell();
+}
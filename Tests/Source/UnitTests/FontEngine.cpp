@@ -0,0 +1,104 @@
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/FontEngineInterface.h>
+#include <RmlUi/Core/RenderManager.h>
+#include <doctest.h>
+
+using namespace Rml;
+
+TEST_CASE("font_engine.cache")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	FontEngineInterface* font_interface = Rml::GetFontEngineInterface();
+	const String language;
+	const TextShapingContext text_shaping_context{language};
+	const String text = "The quick brown fox jumps over the lazy dog.";
+
+	auto get_handle = [&]() { return font_interface->GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 16); };
+
+	FontFaceHandle handle = get_handle();
+	REQUIRE(handle);
+	const FontMetrics metrics = font_interface->GetFontMetrics(handle);
+	const int width = font_interface->GetStringWidth(handle, text, text_shaping_context);
+
+	Vector<byte> cache_data;
+	REQUIRE(Rml::SaveFontCache(cache_data));
+	CHECK(!cache_data.empty());
+
+	// New font faces should be initialized from the cache, producing the same metrics and glyphs.
+	REQUIRE(Rml::LoadFontCache(cache_data));
+	Rml::ReleaseFontResources();
+
+	handle = get_handle();
+	REQUIRE(handle);
+	CHECK(font_interface->GetFontMetrics(handle).line_spacing == metrics.line_spacing);
+	CHECK(font_interface->GetFontMetrics(handle).ascent == metrics.ascent);
+	CHECK(font_interface->GetStringWidth(handle, text, text_shaping_context) == width);
+
+	Vector<byte> cache_data_reloaded;
+	REQUIRE(Rml::SaveFontCache(cache_data_reloaded));
+	CHECK(cache_data_reloaded.size() == cache_data.size());
+
+	// Truncated data should be rejected, while keeping the previously accepted data.
+	TestsShell::SetNumExpectedWarnings(1);
+	CHECK_FALSE(Rml::LoadFontCache({cache_data.data(), cache_data.size() / 2}));
+	TestsShell::SetNumExpectedWarnings(0);
+
+	Rml::ReleaseFontResources();
+	handle = get_handle();
+	REQUIRE(handle);
+	CHECK(font_interface->GetStringWidth(handle, text, text_shaping_context) == width);
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("font_engine.distance_field")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	// The render interface of the shell doesn't support the distance field shader.
+	TestsShell::SetNumExpectedWarnings(1);
+	CHECK_FALSE(Rml::SetFontDistanceFieldMode(true));
+	TestsShell::SetNumExpectedWarnings(0);
+
+	FontEngineInterface* font_interface = Rml::GetFontEngineInterface();
+	REQUIRE(font_interface->SetDistanceFieldMode(true));
+
+	const String language;
+	const TextShapingContext text_shaping_context{language};
+	const String text = "The quick brown fox";
+
+	auto generate = [&](int size, TexturedMeshList& mesh_list) {
+		FontFaceHandle handle = font_interface->GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, size);
+		REQUIRE(handle);
+		return font_interface->GenerateString(context->GetRenderManager(), handle, {}, text, Vector2f(0.f), ColourbPremultiplied(255), 1.f,
+			text_shaping_context, mesh_list);
+	};
+
+	// All sizes render the same distance field glyphs, scaled to their size.
+	TexturedMeshList mesh_list_small, mesh_list_large;
+	const int width_small = generate(16, mesh_list_small);
+	const int width_large = generate(32, mesh_list_large);
+	CHECK(width_small > 0);
+	CHECK(std::abs(width_large - 2 * width_small) <= 1);
+
+	REQUIRE(mesh_list_small.size() == 1);
+	REQUIRE(mesh_list_large.size() == 1);
+	CHECK(mesh_list_small[0].texture == mesh_list_large[0].texture);
+	CHECK(mesh_list_small[0].shader.get() != nullptr);
+	CHECK(mesh_list_small[0].shader.get() == mesh_list_large[0].shader.get());
+	CHECK(mesh_list_small[0].mesh.vertices.size() == mesh_list_large[0].mesh.vertices.size());
+
+	REQUIRE(font_interface->SetDistanceFieldMode(false));
+
+	TexturedMeshList mesh_list_rasterized;
+	generate(16, mesh_list_rasterized);
+	REQUIRE(mesh_list_rasterized.size() == 1);
+	CHECK(mesh_list_rasterized[0].shader.get() == nullptr);
+
+	TestsShell::ShutdownShell();
+}
@@ -1,9 +1,16 @@
+#include "../../../Source/Core/Layout/LayoutEngine.h"
 #include "../Common/TestsShell.h"
+#include <RmlUi/Core/Box.h>
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Core.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/ElementText.h>
+#include <RmlUi/Core/FontEngineInterface.h>
+#include <RmlUi/Core/StringUtilities.h>
+#include <RmlUi/Core/TextShapingContext.h>
 #include <doctest.h>
+#include <limits>
 
 using namespace Rml;
 
@@ -110,3 +117,491 @@ TEST_CASE("Layout.Position.Relative")
 
 	TestsShell::ShutdownShell();
 }
+
+static const String document_layout_boundary_rml = R"(
+<rml>
+<head>
+	<style>
+		body {
+			width: 500px;
+			height: 300px;
+			flex-direction: column;
+		}
+		div {
+			flex-direction: column;
+			flex-shrink: 0;
+		}
+		#boundary {
+			width: 200px;
+			height: 100px;
+			padding: 5px;
+		}
+		.item {
+			height: 20px;
+		}
+	</style>
+</head>
+
+<body>
+	<div id="boundary">
+		<div class="item"/>
+	</div>
+	<div id="auto">
+		<div class="item"/>
+	</div>
+	<div id="after" class="item"/>
+</body>
+</rml>
+)";
+
+TEST_CASE("Layout.DirtyLayoutBoundary")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_layout_boundary_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* boundary = document->GetElementById("boundary");
+	Element* auto_sized = document->GetElementById("auto");
+	Element* after = document->GetElementById("after");
+	REQUIRE(boundary);
+	REQUIRE(auto_sized);
+	REQUIRE(after);
+
+	TestsShell::RenderLoop();
+
+	const float boundary_top = boundary->GetAbsoluteTop();
+	CHECK(after->GetAbsoluteTop() == boundary_top + 110.f + 20.f);
+
+	// Changes inside a fixed-size element are contained, but any new elements must still be formatted.
+	Element* new_item = boundary->AppendChild(document->CreateElement("div"));
+	new_item->SetClass("item", true);
+	TestsShell::RenderLoop();
+
+	CHECK(boundary->GetAbsoluteTop() == boundary_top);
+	CHECK(boundary->GetBox().GetSize().y == 100.f);
+	CHECK(new_item->GetBox().GetSize().y == 20.f);
+	CHECK(new_item->GetAbsoluteTop() == boundary_top + 5.f + 20.f);
+	CHECK(after->GetAbsoluteTop() == boundary_top + 110.f + 20.f);
+
+	// Changes inside an auto-sized element affect the layout of its siblings.
+	auto_sized->AppendChild(document->CreateElement("div"))->SetClass("item", true);
+	TestsShell::RenderLoop();
+
+	CHECK(auto_sized->GetBox().GetSize().y == 40.f);
+	CHECK(after->GetAbsoluteTop() == boundary_top + 110.f + 40.f);
+
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
+
+static const String document_layout_measure_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body {
+			width: 500px;
+			height: 300px;
+			align-items: flex-start;
+		}
+		#text {
+			font-size: 16px;
+		}
+	</style>
+</head>
+
+<body>
+	<span id="text">Hello</span>
+</body>
+</rml>
+)";
+
+TEST_CASE("Layout.MeasureCache")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_layout_measure_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* element = document->GetElementById("text");
+	REQUIRE(element);
+
+	TestsShell::RenderLoop();
+	const float initial_width = element->GetBox().GetSize().x;
+	CHECK(initial_width > 0.f);
+
+	// Measured sizes are retained between layouts, make sure they are invalidated whenever the contents change.
+	element->SetInnerRML("Hello world");
+	TestsShell::RenderLoop();
+	const float text_width = element->GetBox().GetSize().x;
+	CHECK(text_width > initial_width);
+
+	element->SetProperty("font-size", "32px");
+	TestsShell::RenderLoop();
+	CHECK(element->GetBox().GetSize().x > text_width);
+
+	element->SetProperty("font-size", "16px");
+	TestsShell::RenderLoop();
+	CHECK(element->GetBox().GetSize().x == text_width);
+
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Layout.MeasureCache.Table")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_layout_measure_rml);
+	REQUIRE(document);
+	document->Show();
+
+	constexpr int num_rows = 20;
+	constexpr int num_columns = 4;
+	String rml = "<table>";
+	for (int row = 0; row < num_rows; row++)
+	{
+		rml += "<tr>";
+		for (int column = 0; column < num_columns; column++)
+			rml += CreateString("<td>Cell %d-%d</td>", row, column);
+		rml += "</tr>";
+	}
+	rml += "</table>";
+	document->SetInnerRML(rml);
+
+	context->Update();
+	context->Render();
+	const FrameStatistics& statistics = context->GetFrameStatistics();
+	CHECK(statistics.total.num_layout_measures >= num_rows * num_columns);
+
+	// Measured sizes are retained for all unmodified cells. Only the modified cell, and possibly its neighbors in the same row when they are
+	// given new constraints, should be measured again.
+	ElementList cells;
+	document->GetElementsByTagName(cells, "td");
+	REQUIRE((int)cells.size() == num_rows * num_columns);
+	cells[5]->SetInnerRML("A somewhat longer cell");
+	context->Update();
+	context->Render();
+	CHECK(statistics.total.num_layout_formats == 1);
+	CHECK(statistics.total.num_layout_measures > 0);
+	CHECK(statistics.total.num_layout_measures < num_rows);
+
+	context->Update();
+	context->Render();
+	CHECK(statistics.total.num_layout_measures == 0);
+
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
+
+static const String document_layout_toolbar_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body {
+			width: 500px;
+			height: 300px;
+			align-items: flex-start;
+		}
+		img {
+			width: 32px;
+			height: 32px;
+		}
+		img.unsized {
+			width: auto;
+			height: auto;
+		}
+	</style>
+</head>
+
+<body>
+	<img src="/assets/high_scores_alien_1.tga"/>
+	<img src="/assets/high_scores_alien_1.tga"/>
+	<img src="/assets/high_scores_alien_1.tga"/>
+	<img src="/assets/high_scores_alien_1.tga"/>
+	<img class="unsized" src="/assets/high_scores_alien_1.tga"/>
+</body>
+</rml>
+)";
+
+TEST_CASE("Layout.MeasureCache.SizedByStyle")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_layout_toolbar_rml);
+	REQUIRE(document);
+	document->Show();
+
+	// Only the image without a fixed size needs to be measured.
+	context->Update();
+	context->Render();
+	const FrameStatistics& statistics = context->GetFrameStatistics();
+	CHECK(statistics.total.num_layout_measures > 0);
+	CHECK(statistics.total.num_layout_measures < 4);
+
+	Element* icon = document->GetChild(1);
+	CHECK(icon->GetBox().GetSize() == Vector2f(32.f, 32.f));
+	CHECK(document->GetChild(4)->GetBox().GetSize().x > 0.f);
+
+	// Changing the padding of an image relayouts the document, but nothing is measured again.
+	icon->SetProperty("padding", "4px");
+	context->Update();
+	context->Render();
+	CHECK(statistics.total.num_layout_formats == 1);
+	CHECK(statistics.total.num_layout_measures == 0);
+	CHECK(icon->GetBox().GetSize() == Vector2f(32.f, 32.f));
+	CHECK(icon->GetBox().GetSize(BoxArea::Border) == Vector2f(40.f, 40.f));
+
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Layout.StringPrefixWidths")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_layout_measure_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* element = document->GetElementById("text");
+	REQUIRE(element);
+	TestsShell::RenderLoop();
+
+	const FontFaceHandle font_face_handle = element->GetFontFaceHandle();
+	REQUIRE(font_face_handle);
+
+	FontEngineInterface* font_engine_interface = GetFontEngineInterface();
+	const String language;
+	const TextShapingContext text_shaping_context{language};
+	const String text = "Wavy T\xc3\xa4xt";
+
+	// Every prefix width measured in one pass should match measuring the prefix on its own.
+	Vector<int> prefix_widths;
+	font_engine_interface->GetStringPrefixWidths(font_face_handle, text, text_shaping_context, Character::Null, prefix_widths);
+	REQUIRE(prefix_widths.size() == 9);
+
+	size_t num_characters = 0;
+	for (auto it = StringIteratorU8(text); it; ++it)
+	{
+		const StringView prefix(text.data(), StringUtilities::SeekForwardUTF8(it.get() + 1, text.data() + text.size()));
+		CHECK(prefix_widths[num_characters] == font_engine_interface->GetStringWidth(font_face_handle, prefix, text_shaping_context));
+		num_characters++;
+	}
+	CHECK(prefix_widths.back() == font_engine_interface->GetStringWidth(font_face_handle, text, text_shaping_context));
+
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Layout.ShapedStringCache")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_layout_measure_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* element = document->GetElementById("text");
+	REQUIRE(element);
+	TestsShell::RenderLoop();
+
+	const FontFaceHandle font_face_handle = element->GetFontFaceHandle();
+	REQUIRE(font_face_handle);
+
+	FontEngineInterface* font_engine_interface = GetFontEngineInterface();
+	const String language;
+	const TextShapingContext text_shaping_context{language};
+
+	// Measure more strings than fit in the cache, while measuring a frequently used string in between. Widths must stay the same whether they
+	// are shaped, cached, or moved back from an older cache generation.
+	const String frequent_string = "Wavy";
+	const int frequent_width = font_engine_interface->GetStringWidth(font_face_handle, frequent_string, text_shaping_context);
+	Vector<int> widths;
+	for (int pass = 0; pass < 2; pass++)
+	{
+		for (int i = 0; i < 3000; i++)
+		{
+			const String string = "Text" + ToString(i);
+			const int width = font_engine_interface->GetStringWidth(font_face_handle, string, text_shaping_context);
+			if (pass == 0)
+				widths.push_back(width);
+			else
+				CHECK(widths[i] == width);
+
+			if (i % 100 == 0)
+				CHECK(font_engine_interface->GetStringWidth(font_face_handle, frequent_string, text_shaping_context) == frequent_width);
+		}
+	}
+
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Layout.TextTokenCache")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+</head>
+<body><p id="p"> Wavy   text &amp; more</p></body>
+</rml>)");
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	Element* p = document->GetElementById("p");
+	REQUIRE(p);
+	ElementText* text_element = rmlui_dynamic_cast<ElementText*>(p->GetFirstChild());
+	REQUIRE(text_element);
+	const int text_length = (int)text_element->GetText().size();
+
+	String line;
+	int line_length = 0;
+	float line_width = 0;
+	auto GenerateFullLine = [&](bool trim_whitespace_prefix) {
+		const bool reached_end = text_element->GenerateLine(line, line_length, line_width, 0, std::numeric_limits<float>::infinity(), 0.f,
+			trim_whitespace_prefix, true, true);
+		CHECK(reached_end);
+		CHECK(line_length == text_length);
+	};
+
+	// The tokens are built once, then reused for any following lines, both with and without trimming the leading white-space.
+	GenerateFullLine(true);
+	CHECK(line == "Wavy text & more");
+	const float trimmed_width = line_width;
+	GenerateFullLine(false);
+	CHECK(line == " Wavy text & more");
+	CHECK(line_width > trimmed_width);
+	GenerateFullLine(true);
+	CHECK(line == "Wavy text & more");
+	CHECK(line_width == trimmed_width);
+
+	// Lines can start at a token boundary or within a token, such as after a word was broken up.
+	for (int line_begin : {5, 6})
+	{
+		const bool reached_end = text_element->GenerateLine(line, line_length, line_width, line_begin, 1.f, 0.f, true, true, false);
+		CHECK(!reached_end);
+		CHECK(line == "text");
+		CHECK(line_length == 12 - line_begin);
+	}
+
+	// Changes to the formatting or the text rebuild the tokens.
+	p->SetProperty("white-space", "pre");
+	p->SetProperty("text-transform", "uppercase");
+	context->Update();
+	GenerateFullLine(true);
+	CHECK(line == " WAVY   TEXT & MORE");
+
+	text_element->SetText("Other text");
+	GenerateFullLine(true);
+	CHECK(line == "OTHER TEXT");
+	CHECK(line_length == 10);
+
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Layout.NodePool")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_layout_boundary_rml);
+	REQUIRE(document);
+	document->Show();
+
+	TestsShell::RenderLoop();
+	const LayoutEngine::NodePoolStats stats = LayoutEngine::GetNodePoolStats();
+	CHECK(stats.high_water_mark > 0);
+	CHECK(stats.num_allocated_nodes >= stats.high_water_mark);
+
+	// Formatting the same document again should reuse the nodes of the previous layout.
+	document->SetProperty("width", "400px");
+	TestsShell::RenderLoop();
+
+	const LayoutEngine::NodePoolStats new_stats = LayoutEngine::GetNodePoolStats();
+	CHECK(new_stats.num_allocated_nodes == stats.num_allocated_nodes);
+	CHECK(new_stats.high_water_mark == stats.high_water_mark);
+
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Layout.NodePool.Trim")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	String rml = "<rml><head><link type='text/rcss' href='/assets/rml.rcss'/></head><body>";
+	for (int i = 0; i < 6000; i++)
+		rml += "<div/>";
+	rml += "</body></rml>";
+
+	ElementDocument* document = context->LoadDocumentFromMemory(rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	// Only some of the nodes used by a large layout are kept for reuse after formatting.
+	const LayoutEngine::NodePoolStats stats = LayoutEngine::GetNodePoolStats();
+	CHECK(stats.high_water_mark > 6000);
+	CHECK(stats.num_allocated_nodes < stats.high_water_mark);
+
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Layout.BoxEdges")
+{
+	Box box(Vector2f(100, 50));
+	CHECK(!box.HasEdges());
+	CHECK(box.GetSize(BoxArea::Margin) == Vector2f(100, 50));
+	CHECK(box.GetPosition(BoxArea::Content) == Vector2f(0, 0));
+
+	// Zero-sized edges do not need any storage.
+	box.SetEdge(BoxArea::Margin, BoxEdge::Left, 0.f);
+	CHECK(!box.HasEdges());
+	CHECK(box == Box(Vector2f(100, 50)));
+
+	box.SetEdge(BoxArea::Padding, BoxEdge::Left, 5.f);
+	box.SetEdge(BoxArea::Border, BoxEdge::Top, 2.f);
+	CHECK(box.HasEdges());
+	CHECK(box.GetSize(BoxArea::Border) == Vector2f(105, 52));
+	CHECK(box.GetPosition(BoxArea::Content) == Vector2f(5, 2));
+	CHECK(box != Box(Vector2f(100, 50)));
+
+	Box copy = box;
+	CHECK(copy == box);
+
+	box.SetEdge(BoxArea::Padding, BoxEdge::Left, 0.f);
+	box.SetEdge(BoxArea::Border, BoxEdge::Top, 0.f);
+	CHECK(box == Box(Vector2f(100, 50)));
+
+	copy = Box(Vector2f(100, 50));
+	CHECK(copy == box);
+	CHECK(copy.GetSize(BoxArea::Margin) == Vector2f(100, 50));
+}
@@ -6,6 +6,7 @@
 #include <RmlUi/Core/ElementDocument.h>
 #include <RmlUi/Core/StringUtilities.h>
 #include <RmlUi/Core/StyleTypes.h>
+#include <RmlUi/Core/SystemInterface.h>
 #include <doctest.h>
 
 using namespace Rml;
@@ -111,3 +112,74 @@ TEST_CASE("Localization")
 	document->Close();
 	TestsShell::ShutdownShell();
 }
+
+static const String document_translation_rml = R"(
+<rml>
+<head>
+</head>
+
+<body>
+	<p>hello</p>
+	<p>hello</p>
+	<p>hello</p>
+</body>
+</rml>
+)";
+
+class TranslatingSystemInterface : public SystemInterface {
+public:
+	explicit TranslatingSystemInterface(SystemInterface* base) : base(base) {}
+
+	double GetElapsedTime() override { return base->GetElapsedTime(); }
+	bool LogMessage(Log::Type type, const String& message) override { return base->LogMessage(type, message); }
+
+	int TranslateString(String& translated, const String& input) override
+	{
+		num_calls += 1;
+		translated = (input == "hello" && language == "nl" ? "hallo" : input);
+		return translated == input ? 0 : 1;
+	}
+
+	SystemInterface* base;
+	String language = "en";
+	int num_calls = 0;
+};
+
+TEST_CASE("Localization.TranslationCache")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	SystemInterface* tests_system_interface = GetSystemInterface();
+	TranslatingSystemInterface system_interface(tests_system_interface);
+	SetSystemInterface(&system_interface);
+	SetTranslationCacheSize(100);
+
+	auto LoadDocument = [&]() {
+		ElementDocument* document = context->LoadDocumentFromMemory(document_translation_rml);
+		REQUIRE(document);
+		String result = document->GetChild(0)->GetInnerRML();
+		document->Close();
+		context->Update();
+		return result;
+	};
+
+	CHECK(LoadDocument() == "hello");
+	const int num_distinct_strings = system_interface.num_calls;
+	CHECK(num_distinct_strings > 0);
+
+	// Repeated strings are only translated once.
+	CHECK(LoadDocument() == "hello");
+	CHECK(system_interface.num_calls == num_distinct_strings);
+
+	// The cached strings are translated again after they are invalidated.
+	system_interface.language = "nl";
+	InvalidateTranslations();
+	CHECK(LoadDocument() == "hallo");
+	CHECK(system_interface.num_calls == 2 * num_distinct_strings);
+
+	SetTranslationCacheSize(0);
+	SetSystemInterface(tests_system_interface);
+
+	TestsShell::ShutdownShell();
+}
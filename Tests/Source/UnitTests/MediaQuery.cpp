@@ -2,6 +2,7 @@
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/FrameStatistics.h>
 #include <doctest.h>
 
 using namespace Rml;
@@ -543,3 +544,132 @@ TEST_CASE("mediaquery.theme.condition_checks")
 
 	TestsShell::ShutdownShell();
 }
+
+TEST_CASE("mediaquery.theme.deferred")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_media_query4_rml);
+	REQUIRE(document);
+	document->Show();
+
+	context->Update();
+	context->Render();
+
+	ElementList elems;
+	document->GetElementsByTagName(elems, "div");
+	REQUIRE(elems.size() == 1);
+
+	CHECK(elems[0]->GetBox().GetSize().x == 48.0f);
+
+	// Theme changes are applied during the next update, several changes at once should only yield the final state.
+	context->ActivateTheme("big", true);
+	CHECK(context->IsThemeActive("big"));
+	context->ActivateTheme("big", false);
+	context->ActivateTheme("tiny", true);
+	context->Update();
+	context->Render();
+
+	CHECK(elems[0]->GetBox().GetSize().x == 32.0f);
+
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
+
+static const String document_media_query_incremental_rml = R"(
+<rml>
+<head>
+	<style>
+		p { color: #fff; }
+		@media (max-width: 640px) {
+			.small { color: #f00; }
+		}
+	</style>
+</head>
+<body><p/><p/><p class="small" id="small"/><p/></body>
+</rml>
+)";
+
+TEST_CASE("mediaquery.incremental")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_media_query_incremental_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	Element* small = document->GetElementById("small");
+	const FrameStatistics& statistics = context->GetFrameStatistics();
+	const Vector2i dimensions = context->GetDimensions();
+
+	// Only the element matched by the rules in the changed media block should be restyled, in both directions.
+	context->SetDimensions(Vector2i(480, 320));
+	context->Update();
+	context->Render();
+	CHECK(statistics.total.num_definition_updates == 1);
+	CHECK(small->GetProperty<String>("color") == "#ff0000");
+
+	context->SetDimensions(dimensions);
+	context->Update();
+	context->Render();
+	CHECK(statistics.total.num_definition_updates == 1);
+	CHECK(small->GetProperty<String>("color") == "#ffffff");
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String document_media_query_descendant_rml = R"(
+<rml>
+<head>
+	<style>
+		p { color: #fff; }
+		@media (max-width: 640px) {
+			.a .b { color: #f00; }
+		}
+	</style>
+</head>
+<body><div id="outer"><div><p class="b" id="inner"/></div></div></body>
+</rml>
+)";
+
+TEST_CASE("mediaquery.incremental.descendant_rule")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_media_query_descendant_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	Element* outer = document->GetElementById("outer");
+	Element* inner = document->GetElementById("inner");
+	const Vector2i dimensions = context->GetDimensions();
+
+	// No active rule depends on the class, thus the descendants are not restyled now. Their ancestor filters must still see the class once the
+	// media block with the descendant rule is activated.
+	outer->SetClass("a", true);
+	context->Update();
+	context->Render();
+	CHECK(inner->GetProperty<String>("color") == "#ffffff");
+
+	context->SetDimensions(Vector2i(480, 320));
+	context->Update();
+	context->Render();
+	CHECK(inner->GetProperty<String>("color") == "#ff0000");
+
+	context->SetDimensions(dimensions);
+	context->Update();
+	context->Render();
+	CHECK(inner->GetProperty<String>("color") == "#ffffff");
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
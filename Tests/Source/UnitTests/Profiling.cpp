@@ -0,0 +1,368 @@
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/MemoryInterface.h>
+#include <RmlUi/Core/MemoryStatistics.h>
+#include <RmlUi/Core/Profiler.h>
+#include <RmlUi/Core/Profiling.h>
+#include <RmlUi/Core/ProfilingInterface.h>
+#include <RmlUi/Core/StartupStatistics.h>
+#include <algorithm>
+#include <doctest.h>
+
+using namespace Rml;
+
+static const String document_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body {
+			width: 400px;
+			height: 400px;
+		}
+		div {
+			height: 10px;
+			margin-bottom: 2px;
+			background-color: #3a3;
+		}
+	</style>
+</head>
+<body>
+<div/><div/><div/><div/><div/><div/><div/><div/><div/><div/>
+</body>
+</rml>
+)";
+
+TEST_CASE("profiling.profiler")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+
+	// Nothing is recorded while disabled.
+	Profiler::MarkFrame();
+	Profiler::MarkFrame();
+	CHECK(Profiler::GetFrameHistory().empty());
+
+	Profiler::SetEnabled(true);
+	for (int i = 0; i < 3; i++)
+	{
+		context->Update();
+		context->Render();
+		Profiler::MarkFrame();
+	}
+
+	// The first mark only starts the first frame.
+	CHECK(Profiler::GetFrameHistory().size() == 2);
+
+	const Profiler::FrameBreakdown& last_frame = Profiler::GetLastFrame();
+	if (Profiler::IsAvailable())
+	{
+		CHECK(last_frame.timing.phase_times[size_t(ProfilerPhase::Render)] > 0.0);
+		CHECK(!last_frame.zones.empty());
+		CHECK(!last_frame.documents.empty());
+		CHECK(!last_frame.elements.empty());
+	}
+	else
+	{
+		CHECK(last_frame.zones.empty());
+		CHECK(last_frame.elements.empty());
+	}
+
+	// Destroyed elements must not be referenced by the results of the current frame.
+	document->Close();
+	context->Update();
+	Profiler::MarkFrame();
+	CHECK(Profiler::GetFrameHistory().size() == 3);
+
+	Profiler::SetEnabled(false);
+	Profiler::Clear();
+	CHECK(Profiler::GetFrameHistory().empty());
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("profiling.frame_statistics")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+
+	context->Update();
+	context->Render();
+
+	const FrameStatistics& statistics = context->GetFrameStatistics();
+	REQUIRE(statistics.documents.size() == 1);
+	CHECK(statistics.documents[0].statistics.num_definition_updates > 10);
+	CHECK(statistics.documents[0].statistics.num_computed_values > 10);
+	CHECK(statistics.documents[0].statistics.num_layout_formats == 1);
+	CHECK(statistics.documents[0].statistics.num_layout_boxes >= 11);
+	CHECK(statistics.documents[0].statistics.num_background_border_rebuilds >= 10);
+	CHECK(statistics.total.num_computed_values == statistics.documents[0].statistics.num_computed_values);
+	CHECK(statistics.compiled_geometry_bytes > 0);
+	const int num_draw_calls = statistics.num_draw_calls;
+	if (TestsShell::GetTestsRenderInterface())
+		CHECK(num_draw_calls >= 10);
+
+	// Nothing changes in the next frame, except for rendering the same geometry again.
+	context->Update();
+	context->Render();
+	CHECK(statistics.total.num_definition_updates == 0);
+	CHECK(statistics.total.num_computed_values == 0);
+	CHECK(statistics.total.num_layout_formats == 0);
+	CHECK(statistics.total.num_background_border_rebuilds == 0);
+	CHECK(statistics.compiled_geometry_bytes == 0);
+	CHECK(statistics.num_draw_calls == num_draw_calls);
+
+	// Unloaded documents still count towards the totals.
+	document->GetChild(0)->SetProperty(PropertyId::BackgroundColor, Property(Colourb(255, 0, 0), Unit::COLOUR));
+	document->UpdateDocument();
+	document->Close();
+	context->Update();
+	context->Render();
+	CHECK(statistics.documents.empty());
+	CHECK(statistics.total.num_computed_values >= 1);
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("profiling.memory_statistics")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	const MemoryStatistics statistics_before = GetMemoryStatistics();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	const MemoryStatistics statistics = GetMemoryStatistics();
+	REQUIRE(statistics.contexts.size() == 1);
+	CHECK(statistics.contexts[0].name == context->GetName());
+	CHECK(statistics.contexts[0].num_documents == statistics_before.contexts[0].num_documents + 1);
+	CHECK(statistics.contexts[0].num_elements >= statistics_before.contexts[0].num_elements + 11);
+	CHECK(statistics.contexts[0].element_content_bytes > statistics_before.contexts[0].element_content_bytes);
+	CHECK(statistics.geometry_bytes > statistics_before.geometry_bytes);
+	CHECK(statistics.total_bytes > statistics_before.total_bytes);
+
+	auto it_element_pool = std::find_if(statistics.pools.begin(), statistics.pools.end(),
+		[](const MemoryPoolStats& pool) { return String(pool.name) == "Element"; });
+	REQUIRE(it_element_pool != statistics.pools.end());
+	CHECK(it_element_pool->num_used_objects >= 10);
+	CHECK(it_element_pool->num_objects >= it_element_pool->num_used_objects);
+	CHECK(it_element_pool->reserved_bytes >= size_t(it_element_pool->num_objects) * sizeof(Element));
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("profiling.startup_statistics")
+{
+	TestsShell::ShutdownShell();
+
+	// The shell initializes the library and loads its fonts.
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	const StartupStatistics statistics_before = GetStartupStatistics();
+	CHECK(statistics_before.initialise_time > 0);
+	CHECK(statistics_before.specification_time > 0);
+	CHECK(statistics_before.factory_time > 0);
+	CHECK(statistics_before.initialise_time >= statistics_before.specification_time + statistics_before.factory_time);
+	CHECK(statistics_before.num_font_faces > 0);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+
+	const StartupStatistics& statistics = GetStartupStatistics();
+	CHECK(statistics.num_documents == statistics_before.num_documents + 1);
+	CHECK(statistics.num_style_sheets > statistics_before.num_style_sheets);
+	CHECK(statistics.document_loading_time > statistics_before.document_loading_time);
+	CHECK(statistics.first_document_time > 0);
+	CHECK(statistics.time_to_first_document >= statistics.first_document_time);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("profiling.memory_interface")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	// Forward to the global allocator, so that memory is compatible with allocations made before or after the interface is set.
+	struct CountingMemoryInterface : MemoryInterface {
+		void* Allocate(size_t size, size_t /*alignment*/) override
+		{
+			num_allocations += 1;
+			return ::operator new(size);
+		}
+		void Deallocate(void* pointer, size_t /*size*/, size_t /*alignment*/) override
+		{
+			num_deallocations += 1;
+			::operator delete(pointer);
+		}
+		int num_allocations = 0;
+		int num_deallocations = 0;
+	};
+	// Static pools may be released during static destruction, so keep the interface alive until then.
+	static CountingMemoryInterface memory_interface;
+
+	Rml::SetMemoryInterface(&memory_interface);
+	CHECK(Rml::GetMemoryInterface() == &memory_interface);
+
+	Rml::SetRenderInterface(render_interface);
+	REQUIRE(Rml::Initialise());
+	Context* context = Rml::CreateContext("main", {1280, 720});
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+	context->Render();
+	CHECK(memory_interface.num_allocations > 0);
+
+	{
+		const int num_allocations = memory_interface.num_allocations;
+		std::vector<int, MemoryAllocator<int>> numbers = {1, 2, 3};
+		CHECK(memory_interface.num_allocations == num_allocations + 1);
+	}
+
+	Rml::Shutdown();
+	CHECK(memory_interface.num_deallocations > 0);
+
+	Rml::SetMemoryInterface(nullptr);
+}
+
+TEST_CASE("profiling.profiling_interface")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	// Records the names of the zones, layout is formatted on the calling thread only.
+	struct RecordingProfilingInterface : ProfilingInterface {
+		void BeginZone(const char* name) override
+		{
+			zones.push_back(name);
+			depth += 1;
+		}
+		void EndZone() override
+		{
+			REQUIRE(depth > 0);
+			depth -= 1;
+		}
+		void MarkFrame(const char* /*name*/) override { num_frames += 1; }
+		Vector<String> zones;
+		int depth = 0;
+		int num_frames = 0;
+	};
+	RecordingProfilingInterface profiling_interface;
+
+	Rml::SetProfilingInterface(&profiling_interface);
+	CHECK(Rml::GetProfilingInterface() == &profiling_interface);
+
+	Rml::SetRenderInterface(render_interface);
+	REQUIRE(Rml::Initialise());
+	Context* context = Rml::CreateContext("main", {1280, 720});
+	REQUIRE(context);
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+
+	context->Update();
+	context->Render();
+	RMLUI_FrameMark;
+
+	CHECK(profiling_interface.depth == 0);
+#ifdef RMLUI_CUSTOM_PROFILING
+	const auto HasZone = [&](const String& name) {
+		return std::find(profiling_interface.zones.begin(), profiling_interface.zones.end(), name) != profiling_interface.zones.end();
+	};
+	CHECK(HasZone("Update"));
+	CHECK(HasZone("Render"));
+	CHECK(HasZone("UpdateLayout"));
+	CHECK(profiling_interface.num_frames == 1);
+#else
+	// The zones are compiled out.
+	CHECK(profiling_interface.zones.empty());
+	CHECK(profiling_interface.num_frames == 0);
+#endif
+
+	Rml::Shutdown();
+	CHECK(Rml::GetProfilingInterface() == nullptr);
+	CHECK(profiling_interface.depth == 0);
+}
+
+TEST_CASE("profiling.element_invalidations")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<style>
+		div { width: 100px; height: 100px; background-color: #f00; }
+		div.wide { width: 200px; }
+	</style>
+</head>
+<body>
+	<div id="target"/>
+</body>
+</rml>
+)");
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	Element* target = document->GetElementById("target");
+
+	// Nothing is recorded unless enabled.
+	target->SetClass("wide", true);
+	context->Update();
+	context->Render();
+	CHECK(context->GetFrameStatistics().element_invalidations.empty());
+
+	context->SetElementInvalidationTracking(true);
+	CHECK(context->IsElementInvalidationTracking());
+
+	target->SetClass("wide", false);
+	context->Update();
+	context->Render();
+	{
+		const auto& invalidations = context->GetFrameStatistics().element_invalidations;
+		const auto it = invalidations.find(target);
+		REQUIRE(it != invalidations.end());
+		CHECK(it->second.num_definition_updates == 1);
+		CHECK(it->second.num_layout_dirties >= 1);
+		CHECK(it->second.num_geometry_rebuilds >= 1);
+	}
+
+	// Idle frames have no invalidations.
+	context->Update();
+	context->Render();
+	CHECK(context->GetFrameStatistics().element_invalidations.empty());
+
+	context->SetElementInvalidationTracking(false);
+	document->Close();
+	TestsShell::ShutdownShell();
+}
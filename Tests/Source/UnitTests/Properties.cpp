@@ -4,6 +4,7 @@
 #include <RmlUi/Core/DecorationTypes.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/PropertyDefinition.h>
 #include <RmlUi/Core/PropertyDictionary.h>
 #include <RmlUi/Core/StyleSheetSpecification.h>
 #include <RmlUi/Core/StyleSheetTypes.h>
@@ -260,3 +261,77 @@ TEST_CASE("Property.ToString")
 
 	Rml::Shutdown();
 }
+
+TEST_CASE("Property.NameLookup")
+{
+	TestsSystemInterface system_interface;
+	TestsRenderInterface render_interface;
+
+	SetRenderInterface(&render_interface);
+	SetSystemInterface(&system_interface);
+
+	Rml::Initialise();
+
+	for (int i = 1; i < int(PropertyId::NumDefinedIds); i++)
+	{
+		const PropertyId id = PropertyId(i);
+		CHECK(StyleSheetSpecification::GetPropertyId(StyleSheetSpecification::GetPropertyName(id)) == id);
+	}
+	for (int i = 1; i < int(ShorthandId::NumDefinedIds); i++)
+	{
+		const ShorthandId id = ShorthandId(i);
+		CHECK(StyleSheetSpecification::GetShorthandId(StyleSheetSpecification::GetShorthandName(id)) == id);
+	}
+
+	CHECK(StyleSheetSpecification::GetPropertyId("") == PropertyId::Invalid);
+	CHECK(StyleSheetSpecification::GetPropertyId("widthx") == PropertyId::Invalid);
+	CHECK(StyleSheetSpecification::GetPropertyId("margin") == PropertyId::Invalid);
+	CHECK(StyleSheetSpecification::GetShorthandId("margin-top") == ShorthandId::Invalid);
+
+	// Names registered after initialization can be looked up as well.
+	StyleSheetSpecification::RegisterProperty("name-lookup-test", "0", false).AddParser("number");
+	const PropertyId custom_id = StyleSheetSpecification::GetPropertyId("name-lookup-test");
+	CHECK(custom_id >= PropertyId::FirstCustomId);
+	CHECK(StyleSheetSpecification::GetPropertyName(custom_id) == "name-lookup-test");
+	CHECK(StyleSheetSpecification::GetPropertyId("width") == PropertyId::Width);
+
+	Rml::Shutdown();
+}
+
+TEST_CASE("PropertyDictionary")
+{
+	PropertyDictionary properties;
+	properties.SetProperty(PropertyId::Width, Property(10.f, Unit::PX));
+	properties.SetProperty(PropertyId::Color, Property(Colourb(255, 0, 0), Unit::COLOUR));
+	properties.SetProperty(PropertyId::Height, Property(20.f, Unit::PX));
+	REQUIRE(properties.GetNumProperties() == 3);
+
+	// Properties are iterated in order of their ids.
+	PropertyId previous_id = PropertyId::Invalid;
+	for (const auto& pair : properties.GetProperties())
+	{
+		CHECK(previous_id < pair.first);
+		previous_id = pair.first;
+	}
+
+	// Setting a property from a reference to another property of the same dictionary.
+	properties.SetProperty(PropertyId::Top, *properties.GetProperty(PropertyId::Width));
+	REQUIRE(properties.GetProperty(PropertyId::Top));
+	CHECK(properties.GetProperty(PropertyId::Top)->Get<float>() == 10.f);
+
+	properties.RemoveProperty(PropertyId::Width);
+	CHECK(properties.GetProperty(PropertyId::Width) == nullptr);
+	CHECK(properties.GetNumProperties() == 3);
+
+	PropertyDictionary merged;
+	merged.Merge(properties, 5);
+	CHECK(merged.GetNumProperties() == 3);
+	CHECK(merged.GetProperty(PropertyId::Height)->specificity == properties.GetProperty(PropertyId::Height)->specificity + 5);
+
+	PropertyDictionary imported;
+	imported.SetProperty(PropertyId::Height, Property(30.f, Unit::PX));
+	imported.Import(properties, 10);
+	CHECK(imported.GetNumProperties() == 3);
+	CHECK(imported.GetProperty(PropertyId::Height)->Get<float>() == 20.f);
+	CHECK(imported.GetProperty(PropertyId::Color)->specificity == 10);
+}
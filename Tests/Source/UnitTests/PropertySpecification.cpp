@@ -308,6 +308,72 @@ TEST_CASE("PropertyParser.Keyword")
 	Rml::Shutdown();
 }
 
+TEST_CASE("PropertyParser.NumberAndColour")
+{
+	TestsSystemInterface system_interface;
+	TestsRenderInterface render_interface;
+	SetRenderInterface(&render_interface);
+	SetSystemInterface(&system_interface);
+	Rml::Initialise();
+
+	PropertySpecification specification(2, 0);
+	const PropertyId length = specification.RegisterProperty("length", "", false, false).AddParser("length_percent").GetId();
+	const PropertyId colour = specification.RegisterProperty("colour", "", false, false).AddParser("color").GetId();
+
+	auto ParseLength = [&](const String& test_value, float expected_value, Unit expected_unit) {
+		PropertyDictionary properties;
+		const bool parse_success = specification.ParsePropertyDeclaration(properties, length, test_value);
+		if (expected_unit == Unit::UNKNOWN)
+		{
+			CHECK_MESSAGE(!parse_success, "Test value: ", test_value);
+			return;
+		}
+		REQUIRE_MESSAGE(parse_success, "Test value: ", test_value);
+		const Property* property = properties.GetProperty(length);
+		CHECK_MESSAGE(property->Get<float>() == expected_value, "Test value: ", test_value);
+		CHECK_MESSAGE(property->unit == expected_unit, "Test value: ", test_value);
+	};
+
+	auto ParseColour = [&](const String& test_value, Colourb expected_value, bool expected_success = true) {
+		PropertyDictionary properties;
+		const bool parse_success = specification.ParsePropertyDeclaration(properties, colour, test_value);
+		CHECK_MESSAGE(parse_success == expected_success, "Test value: ", test_value);
+		if (parse_success && expected_success)
+			CHECK_MESSAGE(properties.GetProperty(colour)->Get<Colourb>() == expected_value, "Test value: ", test_value);
+	};
+
+	// Repeat each parse to also test the values stored from the first parse.
+	for (int i = 0; i < 2; i++)
+	{
+		ParseLength("10px", 10.f, Unit::PX);
+		ParseLength("10PX", 10.f, Unit::PX);
+		ParseLength("-1.5em", -1.5f, Unit::EM);
+		ParseLength(" 2rem ", 2.f, Unit::REM);
+		ParseLength("50%", 50.f, Unit::PERCENT);
+		ParseLength("1e2px", 100.f, Unit::PX);
+		ParseLength("0", 0.f, Unit::PX);
+		ParseLength("5", 0.f, Unit::UNKNOWN);
+		ParseLength("10deg", 0.f, Unit::UNKNOWN);
+		ParseLength("px", 0.f, Unit::UNKNOWN);
+		ParseLength("inf", 0.f, Unit::UNKNOWN);
+
+		ParseColour("#f00", Colourb(255, 0, 0));
+		ParseColour("#00ff0080", Colourb(0, 255, 0, 128));
+		ParseColour("red", Colourb(255, 0, 0));
+		ParseColour("Blue", Colourb(0, 0, 255));
+		ParseColour("rgb(10, 20, 30)", Colourb(10, 20, 30));
+		ParseColour("rgb(10,20,30)", Colourb(10, 20, 30));
+		ParseColour("rgba(10, 20, 30, 40)", Colourb(10, 20, 30, 40));
+		ParseColour("rgba(100%, 0%, 50%, 100%)", Colourb(255, 0, 127, 255));
+		ParseColour("rgb(300, -5, 20.7)", Colourb(255, 0, 20));
+		ParseColour("rgb(10, 20)", Colourb(), false);
+		ParseColour("rgba(10, 20, 30)", Colourb(), false);
+		ParseColour("not-a-colour", Colourb(), false);
+	}
+
+	Rml::Shutdown();
+}
+
 TEST_CASE("PropertyParser.InvalidShorthands")
 {
 	TestsSystemInterface system_interface;
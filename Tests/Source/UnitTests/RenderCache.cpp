@@ -0,0 +1,265 @@
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <doctest.h>
+
+using namespace Rml;
+
+static const String document_render_cache_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { width: 400px; height: 400px; }
+		#panel { width: 200px; height: 200px; render-cache: static; }
+		#panel div { width: 20px; height: 10px; background-color: #f00; }
+		#panel div.second { background-color: #0f0; }
+	</style>
+</head>
+<body>
+<div id="panel">
+<div/><div class="second"/><div/><div class="second"/><div/><div class="second"/><div/><div class="second"/><div/><div class="second"/>
+</div>
+</body>
+</rml>
+)";
+
+// Counts the layers saved as textures, such as by retained renders.
+class LayerRenderInterface : public TestsRenderInterface {
+public:
+	LayerHandle PushLayer() override { return LayerHandle(++num_layers); }
+	void PopLayer() override { num_layers -= 1; }
+	TextureHandle SaveLayerAsTexture() override
+	{
+		num_saved_layers += 1;
+		return TextureHandle(1);
+	}
+	int num_layers = 0;
+	int num_saved_layers = 0;
+};
+
+TEST_CASE("render_cache")
+{
+	LayerRenderInterface& render_interface = TestsShell::CreateRenderInterface<LayerRenderInterface>();
+	Context* context = TestsShell::CreateContext("render_cache", &render_interface);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_render_cache_rml);
+	REQUIRE(document);
+	document->Show();
+
+	auto RenderAndCountDrawCalls = [&]() {
+		context->Update();
+		const size_t render_geometry_before = render_interface.GetCounters().render_geometry;
+		context->Render();
+		CHECK(render_interface.num_layers == 0);
+		return render_interface.GetCounters().render_geometry - render_geometry_before;
+	};
+
+	// The first frame renders the panel into a layer, later frames only draw the saved layer.
+	const size_t num_draws_capture = RenderAndCountDrawCalls();
+	CHECK(render_interface.num_saved_layers == 1);
+	const size_t num_draws_cached = RenderAndCountDrawCalls();
+	CHECK(render_interface.num_saved_layers == 1);
+	CHECK(num_draws_cached < num_draws_capture);
+
+	// Changes inside the panel capture it again.
+	Element* panel = document->GetElementById("panel");
+	panel->GetChild(2)->SetProperty(PropertyId::BackgroundColor, Property(Colourb(0, 0, 255), Unit::COLOUR));
+	RenderAndCountDrawCalls();
+	CHECK(render_interface.num_saved_layers == 2);
+	CHECK(RenderAndCountDrawCalls() == num_draws_cached);
+	CHECK(render_interface.num_saved_layers == 2);
+
+	// Disabling the cache renders the panel normally again.
+	panel->SetProperty(PropertyId::RenderCache, Property(Style::RenderCache::None));
+	CHECK(RenderAndCountDrawCalls() > num_draws_cached);
+	CHECK(render_interface.num_saved_layers == 2);
+
+	document->Close();
+	Rml::RemoveContext(context->GetName());
+	TestsShell::ShutdownShell();
+}
+
+static const String document_render_cache_scroll_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { width: 400px; height: 400px; }
+		#list { width: 200px; height: 100px; overflow: auto; render-cache: scroll; }
+		#list div { height: 20px; background-color: #f00; }
+	</style>
+</head>
+<body>
+<div id="list"><div/><div/><div/><div/><div/><div/><div/><div/><div/><div/><div/><div/><div/><div/><div/><div/><div/><div/><div/><div/></div>
+</body>
+</rml>
+)";
+
+TEST_CASE("render_cache.scroll")
+{
+	LayerRenderInterface& render_interface = TestsShell::CreateRenderInterface<LayerRenderInterface>();
+	Context* context = TestsShell::CreateContext("render_cache_scroll", &render_interface);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_render_cache_scroll_rml);
+	REQUIRE(document);
+	document->Show();
+
+	auto RenderAndCountDrawCalls = [&]() {
+		context->Update();
+		const size_t render_geometry_before = render_interface.GetCounters().render_geometry;
+		context->Render();
+		CHECK(render_interface.num_layers == 0);
+		return render_interface.GetCounters().render_geometry - render_geometry_before;
+	};
+
+	// The first frame renders all the visible rows into a layer, later frames only draw the saved layer.
+	const size_t num_draws_capture = RenderAndCountDrawCalls();
+	CHECK(render_interface.num_saved_layers == 1);
+	const size_t num_draws_retained = RenderAndCountDrawCalls();
+	CHECK(render_interface.num_saved_layers == 1);
+	CHECK(num_draws_retained < num_draws_capture);
+
+	// Scrolling shifts the previous layer, and only renders the rows scrolled into view.
+	Element* list = document->GetElementById("list");
+	list->SetScrollTop(20.f);
+	const size_t num_draws_scrolled = RenderAndCountDrawCalls();
+	CHECK(render_interface.num_saved_layers == 2);
+	CHECK(num_draws_scrolled < num_draws_capture);
+	CHECK(RenderAndCountDrawCalls() == num_draws_retained);
+	CHECK(render_interface.num_saved_layers == 2);
+
+	// Changes to the contents capture the layer fully again.
+	list->GetChild(2)->SetProperty(PropertyId::BackgroundColor, Property(Colourb(0, 0, 255), Unit::COLOUR));
+	CHECK(RenderAndCountDrawCalls() > num_draws_scrolled);
+	CHECK(render_interface.num_saved_layers == 3);
+
+	// Disabling the layer renders the contents normally again.
+	list->SetProperty(PropertyId::RenderCache, Property(Style::RenderCache::None));
+	CHECK(RenderAndCountDrawCalls() > num_draws_retained);
+	CHECK(render_interface.num_saved_layers == 3);
+
+	document->Close();
+	Rml::RemoveContext(context->GetName());
+	TestsShell::ShutdownShell();
+}
+
+static const String document_render_cache_filter_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { width: 400px; height: 400px; }
+		#panel { width: 200px; height: 200px; filter: blur(5px); render-cache: auto; }
+		#panel div { width: 20px; height: 10px; background-color: #f00; }
+	</style>
+</head>
+<body>
+<div id="panel"><div/><div/><div/></div>
+</body>
+</rml>
+)";
+
+TEST_CASE("render_cache.filter")
+{
+	class FilterRenderInterface : public LayerRenderInterface {
+	public:
+		void CompositeLayers(LayerHandle /*source*/, LayerHandle /*destination*/, BlendMode /*blend_mode*/,
+			Span<const CompiledFilterHandle> /*filters*/) override
+		{
+			num_composites += 1;
+		}
+		int num_composites = 0;
+	};
+	FilterRenderInterface& render_interface = TestsShell::CreateRenderInterface<FilterRenderInterface>();
+	Context* context = TestsShell::CreateContext("render_cache_filter", &render_interface);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_render_cache_filter_rml);
+	REQUIRE(document);
+	document->Show();
+
+	// Returns the number of filter composites during the frame.
+	auto RenderAndCountComposites = [&]() {
+		context->Update();
+		const int composites_before = render_interface.num_composites;
+		context->Render();
+		CHECK(render_interface.num_layers == 0);
+		return render_interface.num_composites - composites_before;
+	};
+
+	// The filtered panel is rendered normally while it changes, then captured once it has stayed the same for a frame.
+	CHECK(RenderAndCountComposites() == 1);
+	CHECK(render_interface.num_saved_layers == 0);
+	CHECK(RenderAndCountComposites() == 1);
+	CHECK(render_interface.num_saved_layers == 1);
+	CHECK(RenderAndCountComposites() == 0);
+	CHECK(render_interface.num_saved_layers == 1);
+
+	// Changes inside the panel render it normally again, until it settles.
+	Element* panel = document->GetElementById("panel");
+	panel->GetChild(1)->SetProperty(PropertyId::BackgroundColor, Property(Colourb(0, 0, 255), Unit::COLOUR));
+	CHECK(RenderAndCountComposites() == 1);
+	CHECK(render_interface.num_saved_layers == 1);
+	CHECK(RenderAndCountComposites() == 1);
+	CHECK(render_interface.num_saved_layers == 2);
+	CHECK(RenderAndCountComposites() == 0);
+
+	// Without filters, the panel is not worth caching.
+	panel->SetProperty(PropertyId::Filter, Property(FiltersPtr(), Unit::FILTER));
+	RenderAndCountComposites();
+	RenderAndCountComposites();
+	CHECK(render_interface.num_saved_layers == 2);
+
+	document->Close();
+	Rml::RemoveContext(context->GetName());
+	TestsShell::ShutdownShell();
+}
+
+static const String document_box_shadow_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { width: 800px; height: 800px; }
+		div { width: 100px; height: 50px; margin: 30px; border-radius: 5px; box-shadow: #000 2px 2px 5px; }
+		#large { width: 300px; height: 80px; }
+		#small { width: 10px; }
+	</style>
+</head>
+<body>
+<div id="first"/>
+<div id="large"/>
+<div id="small"/>
+</body>
+</rml>
+)";
+
+TEST_CASE("render_cache.box_shadow_nine_slice")
+{
+	LayerRenderInterface& render_interface = TestsShell::CreateRenderInterface<LayerRenderInterface>();
+	Context* context = TestsShell::CreateContext("box_shadow", &render_interface);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_box_shadow_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	// Elements large enough to be stretched share the same shadow texture, while the small element needs its own.
+	CHECK(render_interface.num_saved_layers == 2);
+
+	// Resizing does not render the shadow again.
+	document->GetElementById("first")->SetProperty(PropertyId::Width, Property(200.f, Unit::PX));
+	document->GetElementById("large")->SetProperty(PropertyId::Height, Property(120.f, Unit::PX));
+	context->Update();
+	context->Render();
+	CHECK(render_interface.num_saved_layers == 2);
+	CHECK(render_interface.num_layers == 0);
+
+	document->Close();
+	Rml::RemoveContext(context->GetName());
+	TestsShell::ShutdownShell();
+}
@@ -0,0 +1,140 @@
+#include <RmlUi/Core/RenderCommandList.h>
+#include <doctest.h>
+
+using namespace Rml;
+
+namespace {
+class CountingRenderInterface : public RenderInterface {
+public:
+	CompiledGeometryHandle CompileGeometry(Span<const Vertex> vertices, Span<const int> indices) override
+	{
+		num_compiled_vertices += (int)vertices.size();
+		num_compiled_indices += (int)indices.size();
+		return 100 + num_geometries++;
+	}
+	void RenderGeometry(CompiledGeometryHandle geometry, Vector2f /*translation*/, TextureHandle texture) override
+	{
+		rendered_geometry.push_back(geometry);
+		rendered_textures.push_back(texture);
+	}
+	void ReleaseGeometry(CompiledGeometryHandle geometry) override { released_geometry.push_back(geometry); }
+
+	TextureHandle LoadTexture(Vector2i& texture_dimensions, const String& /*source*/) override
+	{
+		texture_dimensions = {4, 4};
+		return 200;
+	}
+	TextureHandle GenerateTexture(Span<const byte> source, Vector2i /*source_dimensions*/) override
+	{
+		num_generated_texture_bytes += (int)source.size();
+		return 300;
+	}
+	void ReleaseTexture(TextureHandle texture) override { released_textures.push_back(texture); }
+
+	void EnableScissorRegion(bool enable) override { scissor_enabled = enable; }
+	void SetScissorRegion(Rectanglei region) override { scissor_region = region; }
+
+	int num_geometries = 0;
+	int num_compiled_vertices = 0;
+	int num_compiled_indices = 0;
+	int num_generated_texture_bytes = 0;
+	Vector<CompiledGeometryHandle> rendered_geometry;
+	Vector<TextureHandle> rendered_textures;
+	Vector<CompiledGeometryHandle> released_geometry;
+	Vector<TextureHandle> released_textures;
+	bool scissor_enabled = false;
+	Rectanglei scissor_region;
+};
+} // namespace
+
+TEST_CASE("RenderCommandList")
+{
+	CountingRenderInterface target;
+	RenderCommandRecorder recorder(target);
+	RenderCommandPlayer player(target);
+	RenderCommandList list;
+
+	const Vector<Vertex> vertices(3);
+	const Vector<int> indices = {0, 1, 2};
+	const Vector<byte> texture_data(4 * 4 * 4);
+
+	// Nothing reaches the target while recording, apart from loading textures which needs the dimensions right away.
+	const CompiledGeometryHandle geometry = recorder.CompileGeometry(vertices, indices);
+	const TextureHandle generated_texture = recorder.GenerateTexture(texture_data, {4, 4});
+	Vector2i dimensions;
+	const TextureHandle loaded_texture = recorder.LoadTexture(dimensions, "image.png");
+	recorder.EnableScissorRegion(true);
+	recorder.SetScissorRegion(Rectanglei::FromSize({10, 10}));
+	recorder.RenderGeometry(geometry, {}, generated_texture);
+	recorder.RenderGeometry(geometry, {}, loaded_texture);
+
+	CHECK(geometry != 0);
+	CHECK(dimensions == Vector2i(4, 4));
+	CHECK(target.num_geometries == 0);
+	CHECK(target.rendered_geometry.empty());
+
+	recorder.SwapCommands(list);
+	REQUIRE(list.GetNumCommands() == 7);
+
+	// The commands can be inspected, such as by backends processing the list themselves.
+	const RenderCommand& compile_command = list.GetCommands()[0];
+	CHECK(compile_command.type == RenderCommandType::CompileGeometry);
+	CHECK(compile_command.handles[0] == geometry);
+	CHECK(list.GetVertices(compile_command).size() == 3);
+	CHECK(list.GetIndices(compile_command).size() == 3);
+	CHECK(list.GetCommands()[2].type == RenderCommandType::AdoptTexture);
+	CHECK(list.GetCommands()[6].type == RenderCommandType::RenderGeometry);
+
+	// The placeholder handles are translated to the handles of the target during replay.
+	player.Replay(list);
+	CHECK(target.num_compiled_vertices == 3);
+	CHECK(target.num_compiled_indices == 3);
+	CHECK(target.num_generated_texture_bytes == 4 * 4 * 4);
+	CHECK(target.scissor_enabled);
+	CHECK(target.scissor_region == Rectanglei::FromSize({10, 10}));
+	REQUIRE(target.rendered_geometry.size() == 2);
+	CHECK(target.rendered_geometry[0] == 100);
+	CHECK(target.rendered_textures[0] == 300);
+	CHECK(target.rendered_geometry[1] == 100);
+	CHECK(target.rendered_textures[1] == 200);
+	CHECK(player.GetNumResources() == 3);
+
+	// Resources persist between frames, until released.
+	recorder.RenderGeometry(geometry, {}, {});
+	recorder.ReleaseGeometry(geometry);
+	recorder.ReleaseTexture(generated_texture);
+	recorder.ReleaseTexture(loaded_texture);
+	recorder.SwapCommands(list);
+	CHECK(list.GetNumCommands() == 4);
+
+	player.Replay(list);
+	REQUIRE(target.rendered_geometry.size() == 3);
+	CHECK(target.rendered_geometry[2] == 100);
+	CHECK(target.rendered_textures[2] == 0);
+	CHECK(target.released_geometry == Vector<CompiledGeometryHandle>{100});
+	CHECK(target.released_textures == Vector<TextureHandle>{300, 200});
+	CHECK(player.GetNumResources() == 0);
+
+	recorder.SwapCommands(list);
+	CHECK(list.IsEmpty());
+
+	// Swapping two lists back and forth, the recorded frames reuse their memory once both lists have grown.
+	RenderCommandRecorder frame_recorder(target);
+	RenderCommandList frame_list;
+	const auto record_frame = [&]() {
+		frame_recorder.RenderGeometry(1, {}, {});
+		frame_recorder.SetTransform(nullptr);
+		frame_recorder.SwapCommands(frame_list);
+	};
+	record_frame();
+	record_frame();
+	const size_t reserved_bytes = frame_list.GetReservedBytes();
+	CHECK(reserved_bytes > 0);
+
+	for (int i = 0; i < 3; i++)
+	{
+		record_frame();
+		CHECK(frame_list.GetNumCommands() == 2);
+		CHECK(frame_list.GetReservedBytes() == reserved_bytes);
+	}
+}
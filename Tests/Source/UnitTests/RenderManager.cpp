@@ -0,0 +1,396 @@
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/Geometry.h>
+#include <RmlUi/Core/MeshUtilities.h>
+#include <RmlUi/Core/RenderManager.h>
+#include <doctest.h>
+
+using namespace Rml;
+
+static const String document_batching_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body {
+			width: 400px;
+			height: 400px;
+		}
+		div {
+			height: 10px;
+			margin-bottom: 2px;
+			background-color: #3a3;
+		}
+	</style>
+</head>
+<body>
+<div/><div/><div/><div/><div/><div/><div/><div/><div/><div/>
+</body>
+</rml>
+)";
+
+TEST_CASE("render_manager.geometry_batching")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+	RenderManager& render_manager = context->GetRenderManager();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_batching_rml);
+	REQUIRE(document);
+	document->Show();
+
+	auto RenderAndCountDrawCalls = [&]() {
+		context->Update();
+		render_interface->ResetCounters();
+		context->Render();
+		return render_interface->GetCounters().render_geometry;
+	};
+
+	REQUIRE(!render_manager.GetGeometryBatching());
+	const size_t num_unbatched = RenderAndCountDrawCalls();
+	CHECK(num_unbatched >= 10);
+
+	render_manager.SetGeometryBatching(true);
+
+	const size_t num_batched = RenderAndCountDrawCalls();
+	CHECK(num_batched < num_unbatched);
+	CHECK(render_interface->GetCounters().compile_geometry > 0);
+
+	// The merged geometry should be reused on unchanged frames.
+	CHECK(RenderAndCountDrawCalls() == num_batched);
+	CHECK(render_interface->GetCounters().compile_geometry == 0);
+
+	// Changing a member geometry invalidates the merged geometry.
+	document->GetChild(3)->SetProperty(PropertyId::BackgroundColor, Property(Colourb(255, 0, 0), Unit::COLOUR));
+	CHECK(RenderAndCountDrawCalls() == num_batched);
+	CHECK(render_interface->GetCounters().compile_geometry > 0);
+	CHECK(render_interface->GetCounters().release_geometry > 0);
+
+	render_manager.SetGeometryBatching(false);
+	CHECK(RenderAndCountDrawCalls() == num_unbatched);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("render_manager.geometry_batching.shared_render_manager")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+	Context* other_context = Rml::CreateContext("batching_shared", Vector2i(1280, 720));
+	REQUIRE(other_context);
+
+	RenderManager& render_manager = context->GetRenderManager();
+	REQUIRE(&other_context->GetRenderManager() == &render_manager);
+	render_manager.SetGeometryBatching(true);
+
+	for (Context* c : {context, other_context})
+	{
+		ElementDocument* document = c->LoadDocumentFromMemory(document_batching_rml);
+		REQUIRE(document);
+		document->Show();
+	}
+
+	auto RenderFrame = [&]() {
+		render_interface->ResetCounters();
+		for (Context* c : {context, other_context})
+		{
+			c->Update();
+			c->Render();
+		}
+	};
+
+	RenderFrame();
+	CHECK(render_interface->GetCounters().compile_geometry > 0);
+
+	// The merged geometry of each context should be kept while the other context renders.
+	RenderFrame();
+	CHECK(render_interface->GetCounters().compile_geometry == 0);
+	RenderFrame();
+	CHECK(render_interface->GetCounters().compile_geometry == 0);
+
+	render_manager.SetGeometryBatching(false);
+	Rml::RemoveContext("batching_shared");
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("render_manager.geometry_deduplication")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+	RenderManager& render_manager = context->GetRenderManager();
+	render_manager.SetGeometryDeduplication(true);
+	CHECK(render_manager.GetGeometryDeduplication());
+
+	Mesh mesh, other_mesh;
+	MeshUtilities::GenerateQuad(mesh, Vector2f(0.f), Vector2f(10.f), ColourbPremultiplied(255));
+	MeshUtilities::GenerateQuad(other_mesh, Vector2f(0.f), Vector2f(10.f), ColourbPremultiplied(128));
+
+	render_interface->ResetCounters();
+	const auto& counters = render_interface->GetCounters();
+
+	Geometry first = render_manager.MakeGeometry(Mesh(mesh));
+	Geometry second = render_manager.MakeGeometry(Mesh(mesh));
+	Geometry other = render_manager.MakeGeometry(Mesh(other_mesh));
+	first.Render(Vector2f(0.f));
+	second.Render(Vector2f(20.f));
+	other.Render(Vector2f(40.f));
+	CHECK(counters.compile_geometry == 2);
+	CHECK(counters.render_geometry == 3);
+
+	// The shared handle stays alive while any geometry uses it, even after the geometry that compiled it is released.
+	CHECK(first.Release() == mesh);
+	CHECK(counters.release_geometry == 0);
+	Geometry third = render_manager.MakeGeometry(Mesh(mesh));
+	third.Render(Vector2f(0.f));
+	CHECK(counters.compile_geometry == 2);
+
+	second.Release();
+	third.Release();
+	CHECK(counters.release_geometry == 1);
+	other.Release();
+	CHECK(counters.release_geometry == 2);
+
+	// Geometry is compiled separately when disabled.
+	render_manager.SetGeometryDeduplication(false);
+	Geometry fourth = render_manager.MakeGeometry(Mesh(mesh));
+	Geometry fifth = render_manager.MakeGeometry(Mesh(mesh));
+	fourth.Render(Vector2f(0.f));
+	fifth.Render(Vector2f(0.f));
+	CHECK(counters.compile_geometry == 4);
+	fourth.Release();
+	fifth.Release();
+	CHECK(counters.release_geometry == 4);
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("render_manager.geometry_instancing")
+{
+	class InstancingRenderInterface : public TestsRenderInterface {
+	public:
+		bool RenderGeometryInstanced(CompiledGeometryHandle /*geometry*/, Span<const Vector2f> translations, TextureHandle /*texture*/) override
+		{
+			num_instanced_draws += 1;
+			max_instances = Math::Max(max_instances, translations.size());
+			return true;
+		}
+		size_t num_instanced_draws = 0;
+		size_t max_instances = 0;
+	};
+	InstancingRenderInterface& render_interface = TestsShell::CreateRenderInterface<InstancingRenderInterface>();
+	Context* context = TestsShell::CreateContext("instancing", &render_interface);
+	context->GetRenderManager().SetGeometryBatching(true);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_batching_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	// The identical backgrounds share their geometry, thus they are drawn as instances instead of being merged.
+	CHECK(render_interface.num_instanced_draws == 1);
+	CHECK(render_interface.max_instances == 10);
+
+	document->Close();
+	Rml::RemoveContext(context->GetName());
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("render_manager.transform_batching")
+{
+	class TransformRenderInterface : public TestsRenderInterface {
+	public:
+		CompiledGeometryHandle CompileTransformedGeometry(Span<const Vertex> vertices, Span<const int> indices,
+			Span<const int> transform_indices) override
+		{
+			CHECK(transform_indices.size() == vertices.size());
+			return CompileGeometry(vertices, indices);
+		}
+		void RenderTransformedGeometry(CompiledGeometryHandle /*geometry*/, Span<const Matrix4f> transforms, TextureHandle /*texture*/) override
+		{
+			num_transformed_draws += 1;
+			max_transforms = Math::Max(max_transforms, transforms.size());
+		}
+		size_t num_transformed_draws = 0;
+		size_t max_transforms = 0;
+	};
+	TransformRenderInterface& render_interface = TestsShell::CreateRenderInterface<TransformRenderInterface>();
+	Context* context = TestsShell::CreateContext("transform_batching", &render_interface);
+	RenderManager& render_manager = context->GetRenderManager();
+	render_manager.SetGeometryBatching(true);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_batching_rml);
+	REQUIRE(document);
+	for (int i = 0; i < document->GetNumChildren(); i++)
+		document->GetChild(i)->SetProperty("transform", CreateString("rotate(%ddeg)", i + 1));
+	document->Show();
+
+	auto RenderAndCountDrawCalls = [&]() {
+		context->Update();
+		render_interface.ResetCounters();
+		render_interface.num_transformed_draws = 0;
+		context->Render();
+		return render_interface.GetCounters().render_geometry + render_interface.num_transformed_draws;
+	};
+
+	// Each transform change flushes the batch when transform batching is disabled.
+	REQUIRE(!render_manager.GetTransformBatching());
+	const size_t num_unbatched = RenderAndCountDrawCalls();
+	CHECK(num_unbatched >= 10);
+	CHECK(render_interface.num_transformed_draws == 0);
+
+	render_manager.SetTransformBatching(true);
+	CHECK(RenderAndCountDrawCalls() < num_unbatched);
+	CHECK(render_interface.num_transformed_draws == 1);
+	CHECK(render_interface.max_transforms >= 10);
+
+	document->Close();
+	Rml::RemoveContext(context->GetName());
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("render_manager.clip_mask_stack")
+{
+	class ClipMaskRenderInterface : public TestsRenderInterface {
+	public:
+		bool PopClipMask(CompiledGeometryHandle /*geometry*/, Vector2f /*translation*/) override
+		{
+			num_pops += 1;
+			return supported;
+		}
+		bool supported = true;
+		size_t num_pops = 0;
+	};
+	ClipMaskRenderInterface& render_interface = TestsShell::CreateRenderInterface<ClipMaskRenderInterface>();
+	Context* context = TestsShell::CreateContext("clip_mask_stack", &render_interface);
+	RenderManager& render_manager = context->GetRenderManager();
+
+	Geometry geometry[4];
+	for (int i = 0; i < 4; i++)
+	{
+		Mesh mesh;
+		MeshUtilities::GenerateQuad(mesh, Vector2f(float(i)), Vector2f(100.f), ColourbPremultiplied(255));
+		geometry[i] = render_manager.MakeGeometry(std::move(mesh));
+	}
+	auto Clip = [&](int index) {
+		const ClipMaskOperation operation = (index == 0 ? ClipMaskOperation::Set : ClipMaskOperation::Intersect);
+		return ClipMaskGeometry{operation, &geometry[index], Vector2f(0.f), nullptr, nullptr};
+	};
+
+	const auto& counters = render_interface.GetCounters();
+	render_interface.ResetCounters();
+
+	render_manager.SetClipMask({Clip(0), Clip(1)});
+	CHECK(counters.render_to_clip_mask == 2);
+
+	// Nested clip masks only render their own geometry.
+	render_manager.SetClipMask({Clip(0), Clip(1), Clip(2)});
+	CHECK(counters.render_to_clip_mask == 3);
+	render_manager.SetClipMask({Clip(0), Clip(1), Clip(2), Clip(3)});
+	CHECK(counters.render_to_clip_mask == 4);
+
+	// Returning to an outer clip mask pops the nested ones.
+	render_manager.SetClipMask({Clip(0), Clip(1), Clip(2)});
+	CHECK(counters.render_to_clip_mask == 4);
+	CHECK(render_interface.num_pops == 1);
+	render_manager.SetClipMask({Clip(0), Clip(1), Clip(3)});
+	CHECK(counters.render_to_clip_mask == 5);
+	CHECK(render_interface.num_pops == 2);
+
+	// Changes which are not cheaper than rendering the clip mask anew are rendered in full.
+	render_manager.SetClipMask({Clip(0), Clip(2)});
+	CHECK(counters.render_to_clip_mask == 7);
+	CHECK(render_interface.num_pops == 2);
+
+	// Without support for popping, the clip mask is rendered in full when returning to an outer clip mask.
+	render_interface.supported = false;
+	render_manager.SetClipMask({Clip(0), Clip(2), Clip(3)});
+	CHECK(counters.render_to_clip_mask == 8);
+	render_manager.SetClipMask({Clip(0), Clip(2)});
+	CHECK(counters.render_to_clip_mask == 10);
+	CHECK(render_interface.num_pops == 3);
+	render_manager.SetClipMask({Clip(0), Clip(2), Clip(3)});
+	render_manager.SetClipMask({Clip(0), Clip(2)});
+	CHECK(counters.render_to_clip_mask == 13);
+	CHECK(render_interface.num_pops == 3);
+
+	render_manager.DisableClipMask();
+	for (Geometry& entry : geometry)
+		entry.Release();
+
+	Rml::RemoveContext(context->GetName());
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("render_manager.quad_geometry")
+{
+	class QuadRenderInterface : public TestsRenderInterface {
+	public:
+		CompiledGeometryHandle CompileQuadGeometry(Span<const Vertex> vertices) override
+		{
+			if (!supported)
+				return {};
+			num_quad_geometries += 1;
+			num_quad_vertices += vertices.size();
+			return CompileGeometry(vertices, {});
+		}
+		bool supported = true;
+		size_t num_quad_geometries = 0;
+		size_t num_quad_vertices = 0;
+	};
+	QuadRenderInterface& render_interface = TestsShell::CreateRenderInterface<QuadRenderInterface>();
+	Context* context = TestsShell::CreateContext("quads", &render_interface);
+	RenderManager& render_manager = context->GetRenderManager();
+	const auto& counters = render_interface.GetCounters();
+
+	Mesh quads;
+	MeshUtilities::GenerateQuad(quads, Vector2f(0.f), Vector2f(10.f), ColourbPremultiplied(255));
+	MeshUtilities::GenerateQuad(quads, Vector2f(20.f), Vector2f(10.f), ColourbPremultiplied(255));
+
+	Mesh triangle;
+	triangle.vertices.resize(3);
+	triangle.indices = {0, 1, 2};
+
+	Geometry quad_geometry = render_manager.MakeGeometry(Mesh(quads));
+	quad_geometry.Render(Vector2f(0.f));
+	CHECK(render_interface.num_quad_geometries == 1);
+	CHECK(render_interface.num_quad_vertices == 8);
+
+	// Other meshes are compiled with their indices.
+	Geometry triangle_geometry = render_manager.MakeGeometry(Mesh(triangle));
+	triangle_geometry.Render(Vector2f(0.f));
+	CHECK(render_interface.num_quad_geometries == 1);
+	CHECK(counters.compile_geometry == 2);
+
+	// Falls back to indexed geometry when the render interface does not compile quads.
+	render_interface.supported = false;
+	Geometry fallback_geometry = render_manager.MakeGeometry(Mesh(quads));
+	fallback_geometry.Render(Vector2f(0.f));
+	CHECK(render_interface.num_quad_geometries == 1);
+	CHECK(counters.compile_geometry == 3);
+
+	quad_geometry.Release();
+	triangle_geometry.Release();
+	fallback_geometry.Release();
+	Rml::RemoveContext(context->GetName());
+	TestsShell::ShutdownShell();
+}
@@ -1,8 +1,10 @@
 #include "../Common/TestsShell.h"
+#include <RmlUi/Core/CompiledSelector.h>
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Core.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/FrameStatistics.h>
 #include <RmlUi/Core/Types.h>
 #include <doctest.h>
 
@@ -79,6 +81,11 @@ static const Vector<QuerySelector> query_selectors =
 	{ "body > .hello",               "X Z" },
 	{ ".parent *",                   "A B C D D0 D1 E F F0 G H" },
 	{ ".parent > *",                 "A B C D E F G H" },
+	{ "div span",                    "D0 D1 F0",        SelectorOp::RemoveClasses,        "parent", "D0 D1 F0" },
+	{ ".parent p span",              "D0 D1 F0",        SelectorOp::RemoveClasses,        "parent", "" },
+	{ "#X ~ .parent span",           "D0 D1 F0",        SelectorOp::RemoveClasses,        "parent", "" },
+	{ "h1 ~ p > span",               "D0 D1 F0" },
+	{ "h3 + p span",                 "F0" },
 	{ ":checked",                    "I",               SelectorOp::RemoveChecked,        "I", "" },
 
 	{ "*",                           "X Y Z P A B C D D0 D1 E F F0 G H I" },
@@ -511,3 +518,217 @@ TEST_CASE("Selectors")
 
 	TestsShell::ShutdownShell();
 }
+
+static const String doc_dependencies = R"(
+<rml>
+<head>
+	<style>
+		.item:hover { color: #f00; }
+		.open p { color: #0f0; }
+		.first + .item { color: #00f; }
+	</style>
+</head>
+<body>
+<div><div class="item" id="a"><p/><p/></div><div class="item" id="b"><p/><p/></div><div class="item" id="c"><p/><p/></div></div>
+</body>
+</rml>
+)";
+
+TEST_CASE("Selectors.dependencies")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(doc_dependencies);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+	context->Render();
+
+	Element* a = document->GetElementById("a");
+	Element* b = document->GetElementById("b");
+	const FrameStatistics& statistics = context->GetFrameStatistics();
+
+	auto NumDefinitionUpdates = [&]() {
+		context->Update();
+		context->Render();
+		return statistics.total.num_definition_updates;
+	};
+
+	// Only the element itself depends on its hover state.
+	a->SetPseudoClass("hover", true);
+	CHECK(NumDefinitionUpdates() == 1);
+	CHECK(a->GetProperty<String>("color") == "#ff0000");
+
+	// No selector refers to these names.
+	a->SetClass("unused", true);
+	a->SetAttribute("data-unused", 1);
+	CHECK(NumDefinitionUpdates() == 0);
+
+	// Only the descendants depend on the 'open' class.
+	a->SetClass("open", true);
+	CHECK(NumDefinitionUpdates() == 2);
+	CHECK(a->GetFirstChild()->GetProperty<String>("color") == "#00ff00");
+
+	// The siblings, and implicitly their descendants, depend on the 'first' class.
+	a->SetClass("first", true);
+	CHECK(NumDefinitionUpdates() == 9);
+	CHECK(b->GetProperty<String>("color") == "#0000ff");
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String doc_sibling_indices = R"(
+<rml>
+<head>
+	<style>
+		p { color: #fff; }
+		p:nth-child(2) { color: #f00; }
+		p:last-of-type { color: #00f; }
+	</style>
+</head>
+<body>
+<div id="list"><p id="a"/><p id="b"/><p id="c"/></div>
+</body>
+</rml>
+)";
+
+TEST_CASE("Selectors.sibling_indices")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(doc_sibling_indices);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	Element* list = document->GetElementById("list");
+	Element* a = document->GetElementById("a");
+	Element* b = document->GetElementById("b");
+	Element* c = document->GetElementById("c");
+
+	CHECK(a->GetProperty<String>("color") == "#ffffff");
+	CHECK(b->GetProperty<String>("color") == "#ff0000");
+	CHECK(c->GetProperty<String>("color") == "#0000ff");
+
+	// The positions of the siblings must follow changes to the children.
+	list->InsertBefore(document->CreateElement("p"), a);
+	context->Update();
+	CHECK(a->GetProperty<String>("color") == "#ff0000");
+	CHECK(b->GetProperty<String>("color") == "#ffffff");
+
+	list->RemoveChild(list->GetFirstChild());
+	list->AppendChild(document->CreateTextNode("text"));
+	list->AppendChild(document->CreateElement("span"));
+	context->Update();
+	CHECK(b->GetProperty<String>("color") == "#ff0000");
+	CHECK(c->GetProperty<String>("color") == "#0000ff");
+
+	list->RemoveChild(c);
+	context->Update();
+	CHECK(b->GetProperty<String>("color") == "#0000ff");
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String doc_query_index = R"(
+<rml>
+<head>
+	<title>Demo</title>
+</head>
+<body>
+	<div id="a" class="item">
+		<p id="b" class="item first"/>
+		<p id="c"/>
+	</div>
+	<div id="d">
+		<span id="e" class="item"/>
+	</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("Selectors.query_index")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(doc_query_index);
+	REQUIRE(document);
+
+	// Queries are answered from the index of the document, which must follow changes to the elements and keep the order of a traversal.
+	auto QueryIds = [&](Element* root, const String& selector) {
+		ElementList elements;
+		root->QuerySelectorAll(elements, selector);
+		return ElementListToIds(elements);
+	};
+	auto ClassIds = [&](Element* root, const String& class_name) {
+		ElementList elements;
+		root->GetElementsByClassName(elements, class_name);
+		return ElementListToIds(elements);
+	};
+
+	Element* a = document->GetElementById("a");
+	Element* d = document->GetElementById("d");
+	REQUIRE(a);
+	REQUIRE(d);
+	CHECK(document->GetElementById("e")->GetParentNode() == d);
+	CHECK(document->GetElementById("missing") == nullptr);
+
+	CHECK(ClassIds(document, "item") == "a b e");
+	CHECK(QueryIds(document, ".item") == "a b e");
+	CHECK(QueryIds(a, ".item") == "b");
+	CHECK(QueryIds(document, "div > p, #e") == "b c e");
+	CHECK(document->QuerySelector("p")->GetId() == "b");
+
+	a->SetClass("item", false);
+	d->SetClass("item", true);
+	CHECK(QueryIds(document, ".item") == "b d e");
+
+	document->GetElementById("c")->SetId("f");
+	CHECK(document->GetElementById("c") == nullptr);
+	CHECK(document->GetElementById("f"));
+
+	d->SetClassNames("first");
+	CHECK(QueryIds(document, ".first") == "b d");
+
+	// Elements follow their insertion into and removal from the document.
+	ElementPtr removed = a->RemoveChild(document->GetElementById("b"));
+	CHECK(document->GetElementById("b") == nullptr);
+	CHECK(QueryIds(document, ".first") == "d");
+
+	Element* inserted = d->InsertBefore(std::move(removed), d->GetFirstChild());
+	CHECK(document->GetElementById("b") == inserted);
+	CHECK(QueryIds(document, ".first") == "d b");
+
+	// Duplicate ids resolve to the first element found breadth-first.
+	d->GetElementById("e")->SetId("a");
+	CHECK(document->GetElementById("a") == a);
+	a->SetId("");
+	CHECK(document->GetElementById("a")->GetParentNode() == d);
+
+	// Many candidates are ordered by traversal instead.
+	Element* list = a->AppendChild(document->CreateElement("div"));
+	for (int i = 0; i < 100; i++)
+		list->AppendChild(document->CreateElement("p"))->SetClass(i % 2 ? "odd" : "even", true);
+	ElementList elements;
+	document->QuerySelectorAll(elements, "p.odd");
+	REQUIRE(elements.size() == 50);
+	for (size_t i = 0; i < elements.size(); i++)
+		CHECK(elements[i] == list->GetChild(2 * int(i) + 1));
+
+	// Compiled selectors give the same results.
+	const CompiledSelector compiled_selector("div > p.even");
+	CHECK(compiled_selector);
+	ElementList compiled_elements;
+	document->QuerySelectorAll(compiled_elements, compiled_selector);
+	CHECK(compiled_elements.size() == 50);
+	CHECK(document->QuerySelector(compiled_selector) == list->GetChild(0));
+	CHECK(list->GetChild(0)->Matches(compiled_selector));
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
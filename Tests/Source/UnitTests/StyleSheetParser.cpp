@@ -1,6 +1,7 @@
 #include "../Common/TestsShell.h"
 #include <RmlUi/Core/Core.h>
 #include <RmlUi/Core/Spritesheet.h>
+#include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/StreamMemory.h>
 #include <RmlUi/Core/StyleSheet.h>
 #include <RmlUi/Core/StyleSheetContainer.h>
@@ -28,6 +29,14 @@ static const char spritesheet_with_path_string_encoding[] = R"(
 }
 )";
 
+static const char spritesheet_with_variants[] = R"(
+@spritesheet test_sheet_with_variants {
+	src: /assets/icons.tga, /assets/icons@2x.tga 2x, "/assets/icons@1.5x.tga" 1.5x;
+	test00: 0px 0px 64px 64px;
+	test01: 64px 0px 64px 64px;
+}
+)";
+
 using namespace Rml;
 
 TEST_CASE("style_sheet_parser.spritesheet")
@@ -128,3 +137,52 @@ TEST_CASE("style_sheet_parser.spritesheet_with_path_string_encoding")
 
 	TestsShell::ShutdownShell();
 }
+
+TEST_CASE("style_sheet_parser.spritesheet_with_variants")
+{
+	Context* context = TestsShell::GetContext();
+
+	{
+		StyleSheetContainer style_sheet_container;
+		StreamMemory spritesheet_stream{reinterpret_cast<const byte*>(spritesheet_with_variants), sizeof(spritesheet_with_variants) - 1};
+		style_sheet_container.LoadStyleSheetContainer(&spritesheet_stream, 0);
+
+		struct TestCase {
+			float dp_ratio;
+			const char* source;
+			float resolution;
+		};
+		// The variant with the lowest resolution at least as large as the dp-ratio is used, or the largest one when there is none.
+		const TestCase test_cases[] = {
+			{0.5f, "/assets/icons.tga", 1.f},
+			{1.f, "/assets/icons.tga", 1.f},
+			{1.25f, "/assets/icons@1.5x.tga", 1.5f},
+			{1.5f, "/assets/icons@1.5x.tga", 1.5f},
+			{2.f, "/assets/icons@2x.tga", 2.f},
+			{3.f, "/assets/icons@2x.tga", 2.f},
+		};
+
+		for (const TestCase& test_case : test_cases)
+		{
+			CAPTURE(test_case.dp_ratio);
+			context->SetDensityIndependentPixelRatio(test_case.dp_ratio);
+			style_sheet_container.UpdateCompiledStyleSheet(context);
+			const auto* style_sheet = style_sheet_container.GetCompiledStyleSheet();
+			REQUIRE(style_sheet != nullptr);
+
+			const auto* sprite01 = style_sheet->GetSprite("test01");
+			REQUIRE(sprite01 != nullptr);
+			CHECK(sprite01->sprite_sheet->name == "test_sheet_with_variants");
+			CHECK(sprite01->sprite_sheet->texture_source.GetSource() == test_case.source);
+			CHECK(sprite01->sprite_sheet->display_scale == 1.f / test_case.resolution);
+
+			// Rectangles are given at the spritesheet resolution, and scaled to the resolution of the variant.
+			CHECK(sprite01->rectangle.TopLeft() == Vector2f(64.f, 0.f) * test_case.resolution);
+			CHECK(sprite01->rectangle.Size() == Vector2f(64.f, 64.f) * test_case.resolution);
+		}
+
+		context->SetDensityIndependentPixelRatio(1.f);
+	}
+
+	TestsShell::ShutdownShell();
+}
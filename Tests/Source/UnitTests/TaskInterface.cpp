@@ -0,0 +1,371 @@
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/ComputedValues.h>
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/StartupStatistics.h>
+#include <RmlUi/Core/TaskInterface.h>
+#include <Shell.h>
+#include <algorithm>
+#include <chrono>
+#include <doctest.h>
+#include <thread>
+
+using namespace Rml;
+
+static const String document_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body {
+			width: 400px;
+			height: 400px;
+		}
+		div {
+			height: 10px;
+			margin-bottom: 2px;
+			background-color: #3a3;
+		}
+	</style>
+</head>
+<body>
+<div/><div/><div/><div/><div/><div/><div/><div/><div/><div/>
+</body>
+</rml>
+)";
+
+// Runs every task on its own thread.
+struct ThreadTaskInterface : TaskInterface {
+	TaskHandle Submit(Function<void()> task) override
+	{
+		threads.emplace_back(std::move(task));
+		return TaskHandle(threads.size());
+	}
+	void Wait(TaskHandle task) override { threads[size_t(task) - 1].join(); }
+	std::vector<std::thread> threads;
+};
+
+TEST_CASE("task_interface")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	// Runs the tasks right away, while checking that every task is waited for exactly once.
+	struct SerialTaskInterface : TaskInterface {
+		TaskHandle Submit(Function<void()> task) override
+		{
+			task();
+			num_submitted += 1;
+			pending.push_back(num_submitted);
+			return TaskHandle(num_submitted);
+		}
+		void Wait(TaskHandle task) override
+		{
+			auto it = std::find(pending.begin(), pending.end(), int(task));
+			REQUIRE(it != pending.end());
+			pending.erase(it);
+		}
+		int num_submitted = 0;
+		Vector<int> pending;
+	};
+	SerialTaskInterface task_interface;
+
+	Rml::SetTaskInterface(&task_interface);
+	Rml::SetLayoutThreadCount(2);
+	CHECK(Rml::GetTaskInterface() == &task_interface);
+
+	Rml::SetRenderInterface(render_interface);
+	REQUIRE(Rml::Initialise());
+	Context* context = Rml::CreateContext("main", {1280, 720});
+	REQUIRE(context);
+
+	// Documents formatted in the same update are laid out in parallel through the task interface.
+	for (int i = 0; i < 2; i++)
+	{
+		ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+		REQUIRE(document);
+		document->Show();
+	}
+	context->Update();
+	context->Render();
+
+	CHECK(task_interface.num_submitted >= 2);
+	CHECK(task_interface.pending.empty());
+
+	Rml::Shutdown();
+	CHECK(Rml::GetTaskInterface() == nullptr);
+	CHECK(task_interface.pending.empty());
+
+	Rml::SetLayoutThreadCount(0);
+}
+
+TEST_CASE("task_interface.style_sheets")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	ThreadTaskInterface task_interface;
+
+	Rml::SetTaskInterface(&task_interface);
+	Rml::SetRenderInterface(render_interface);
+	REQUIRE(Rml::Initialise());
+
+	// Style sheets loaded together are parsed concurrently.
+	const StringList style_sheets = {"/assets/rml.rcss", "/../Tests/Data/style.rcss", "/../Tests/Data/UnitTests/Specificity_Basic.rcss"};
+	const int num_style_sheets_initial = Rml::GetStartupStatistics().num_style_sheets;
+	CHECK(Rml::PreloadStyleSheets(style_sheets));
+	CHECK(task_interface.threads.size() == style_sheets.size());
+	CHECK(Rml::GetStartupStatistics().num_style_sheets == num_style_sheets_initial + (int)style_sheets.size());
+
+	// Documents linking to the sheets use the cached sheets, without parsing them again.
+	Context* context = Rml::CreateContext("main", {1280, 720});
+	REQUIRE(context);
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<link type="text/rcss" href="/../Tests/Data/style.rcss"/>
+</head>
+<body><div id="div"/></body>
+</rml>)");
+	REQUIRE(document);
+	context->Update();
+
+	CHECK(task_interface.threads.size() == style_sheets.size());
+	CHECK(document->GetElementById("div")->GetComputedValues().display() == Style::Display::Block);
+
+	Rml::Shutdown();
+}
+
+TEST_CASE("task_interface.definitions")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	ThreadTaskInterface task_interface;
+
+	Rml::SetTaskInterface(&task_interface);
+	Rml::SetRenderInterface(render_interface);
+	REQUIRE(Rml::Initialise());
+
+	Context* context = Rml::CreateContext("main", {1280, 720});
+	REQUIRE(context);
+
+	constexpr int num_items = 400;
+	String document_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		.item { display: block; width: 10px; height: 1px; }
+		.item:nth-child(2n) { width: 20px; }
+		@media (theme: big) {
+			.item { width: 30px; }
+			.item:nth-child(2n) { width: 40px; }
+		}
+	</style>
+</head>
+<body>)";
+	for (int i = 0; i < num_items; i++)
+		document_rml += "<div class='item'/>";
+	document_rml += "</body></rml>";
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+
+	auto CheckWidths = [&](float odd_width, float even_width) {
+		int num_mismatches = 0;
+		for (int i = 0; i < num_items; i++)
+		{
+			const float expected_width = ((i + 1) % 2 == 0 ? even_width : odd_width);
+			if (document->GetChild(i)->GetBox().GetSize().x != expected_width)
+				num_mismatches += 1;
+		}
+		CHECK(num_mismatches == 0);
+	};
+
+	// The definitions of the new elements are looked up in parallel through the task interface.
+	context->Update();
+	const size_t num_tasks_initial = task_interface.threads.size();
+	CHECK(num_tasks_initial > 0);
+	CheckWidths(10.f, 20.f);
+
+	// As are the definitions affected by a theme change.
+	context->ActivateTheme("big", true);
+	context->Update();
+	CHECK(task_interface.threads.size() > num_tasks_initial);
+	CheckWidths(30.f, 40.f);
+
+	// Elements changed along with the theme are matched against their latest classes.
+	context->ActivateTheme("big", false);
+	document->GetChild(0)->SetClass("item", false);
+	context->Update();
+	CHECK(document->GetChild(0)->GetBox().GetSize().x != 10.f);
+	document->GetChild(0)->SetClass("item", true);
+	context->Update();
+	CheckWidths(10.f, 20.f);
+
+	// Changes to a few elements are too small to be worth any tasks.
+	const size_t num_tasks_before_change = task_interface.threads.size();
+	document->GetChild(1)->SetPseudoClass("hover", true);
+	context->Update();
+	CHECK(task_interface.threads.size() == num_tasks_before_change);
+
+	Rml::Shutdown();
+}
+
+TEST_CASE("task_interface.documents")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	ThreadTaskInterface task_interface;
+
+	Rml::SetTaskInterface(&task_interface);
+	Rml::SetRenderInterface(render_interface);
+	REQUIRE(Rml::Initialise());
+
+	Context* context = Rml::CreateContext("main", {1280, 720});
+	REQUIRE(context);
+
+	Vector<ElementDocument*> loaded_documents;
+	auto on_loaded = [&](ElementDocument* document) { loaded_documents.push_back(document); };
+
+	// Queued documents are read and then parsed through the task interface right away.
+	TestsShell::SetNumExpectedWarnings(1);
+	context->LoadDocumentAsync("assets/demo.rml", on_loaded);
+	context->LoadDocumentAsync("assets/does_not_exist.rml", on_loaded);
+	context->LoadDocumentAsync("assets/demo.rml", on_loaded);
+	CHECK(task_interface.threads.size() == 2);
+	CHECK(context->GetNumQueuedDocuments() == 3);
+
+	// Their elements are instanced in order on the main thread once parsed.
+	for (int i = 0; i < 1000 && context->GetNumQueuedDocuments() > 0; i++)
+	{
+		context->Update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	CHECK(context->GetNumQueuedDocuments() == 0);
+	REQUIRE(loaded_documents.size() == 3);
+	REQUIRE(loaded_documents[0]);
+	CHECK(loaded_documents[1] == nullptr);
+	REQUIRE(loaded_documents[2]);
+	CHECK(loaded_documents[0]->GetElementById("title"));
+	CHECK(loaded_documents[2]->GetElementById("title"));
+	CHECK(loaded_documents[0]->GetContext() == context);
+
+	// Documents still being parsed are waited for when the context is destroyed.
+	context->LoadDocumentAsync("assets/demo.rml", on_loaded);
+	CHECK(task_interface.threads.size() == 3);
+
+	Rml::Shutdown();
+	CHECK(loaded_documents.size() == 3);
+}
+
+TEST_CASE("task_interface.document_style_sheets")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	ThreadTaskInterface task_interface;
+
+	Rml::SetTaskInterface(&task_interface);
+	Rml::SetRenderInterface(render_interface);
+	REQUIRE(Rml::Initialise());
+
+	Context* context = Rml::CreateContext("main", {1280, 720});
+	REQUIRE(context);
+
+	ElementDocument* document = nullptr;
+	const int num_style_sheets_initial = Rml::GetStartupStatistics().num_style_sheets;
+	context->LoadDocumentAsync("/../Tests/Data/description.rml", [&](ElementDocument* loaded_document) { document = loaded_document; });
+	CHECK(task_interface.threads.size() == 1);
+
+	for (int i = 0; i < 1000 && context->GetNumQueuedDocuments() > 0; i++)
+	{
+		context->Update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	REQUIRE(document);
+
+	// The inline sheet is parsed along with the document, and the linked sheet on a second task. Neither is parsed again on the main thread.
+	CHECK(task_interface.threads.size() == 2);
+	CHECK(Rml::GetStartupStatistics().num_style_sheets == num_style_sheets_initial + 2);
+	CHECK(document->GetComputedValues().position() == Style::Position::Absolute);
+
+	Rml::Shutdown();
+}
+
+TEST_CASE("task_interface.font_effects")
+{
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	// This test only works with the dummy renderer.
+	if (!TestsShell::GetTestsRenderInterface())
+		return;
+
+	// Keeps the data of all generated textures.
+	struct TextureDataRenderInterface : TestsRenderInterface {
+		TextureHandle GenerateTexture(Span<const byte> source, Vector2i source_dimensions) override
+		{
+			textures.emplace_back(source.begin(), source.end());
+			return TestsRenderInterface::GenerateTexture(source, source_dimensions);
+		}
+		Vector<Vector<byte>> textures;
+	};
+
+	static const String document_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { font-family: LatoLatin; font-size: 20px; font-effect: glow(2px 3px 1px 1px #f00) outline(1px #0f0); }
+	</style>
+</head>
+<body>The quick brown fox jumps over the lazy dog. THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG! 0123456789</body>
+</rml>)";
+
+	auto GenerateFontTextures = [&](TaskInterface* task_interface) {
+		TextureDataRenderInterface render_interface;
+		Rml::SetTaskInterface(task_interface);
+		Rml::SetSystemInterface(system_interface);
+		REQUIRE(Rml::Initialise());
+		Shell::LoadFonts();
+
+		Context* context = Rml::CreateContext("main", {1280, 720}, &render_interface);
+		REQUIRE(context);
+		ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+		REQUIRE(document);
+		document->Show();
+		context->Update();
+		context->Render();
+
+		Rml::Shutdown();
+		return std::move(render_interface.textures);
+	};
+
+	Shell::Initialize();
+
+	// The glyphs of the font effects are generated concurrently, and the result must be the same as when generated serially.
+	const Vector<Vector<byte>> textures_serial = GenerateFontTextures(nullptr);
+	ThreadTaskInterface task_interface;
+	const Vector<Vector<byte>> textures_parallel = GenerateFontTextures(&task_interface);
+
+	CHECK(!task_interface.threads.empty());
+	CHECK(!textures_serial.empty());
+	CHECK(textures_parallel == textures_serial);
+
+	Shell::Shutdown();
+}
@@ -83,3 +83,23 @@ TEST_CASE("Variant.UnscopedEnum")
 	CHECK(v3.Get<uint64_t>() == UINT64_MAX);
 	CHECK(v3.Get<int64_t>() == static_cast<int64_t>(UINT64_MAX));
 }
+
+TEST_CASE("Variant.AssignString")
+{
+	Variant v(String(100, 'a'));
+	const char* data = v.GetReference<String>().data();
+
+	// Assigning a string to a string variant reuses its storage.
+	const String value(50, 'b');
+	v = value;
+	CHECK(v.GetReference<String>() == value);
+	CHECK(v.GetReference<String>().data() == data);
+
+	v = 10.0;
+	CHECK(v.GetType() == Variant::DOUBLE);
+	CHECK(v.Get<double>() == 10.0);
+
+	v = value;
+	CHECK(v.GetType() == Variant::STRING);
+	CHECK(v.Get<String>() == value);
+}
@@ -5,6 +5,7 @@
 #include <RmlUi/Core/ElementDocument.h>
 #include <RmlUi/Core/ElementText.h>
 #include <RmlUi/Core/Factory.h>
+#include <RmlUi/Core/StreamMemory.h>
 #include <doctest.h>
 
 using namespace Rml;
@@ -168,3 +169,45 @@ TEST_CASE("XMLParser.comments_and_cdata")
 	}
 	TestsShell::ShutdownShell();
 }
+
+namespace {
+class XMLParserEventLog : public BaseXMLParser {
+public:
+	XMLParserEventLog() { RegisterInnerXMLAttribute("data-for"); }
+
+	void HandleElementStart(const String& name, const XMLAttributes& attributes) override
+	{
+		log += CreateString("<%s:%d", name.c_str(), GetLineNumberOpenTag());
+		for (const auto& attribute : attributes)
+			log += " " + attribute.first + "=" + attribute.second.Get<String>();
+		log += ">";
+	}
+	void HandleElementEnd(const String& name) override { log += "</" + name + ">"; }
+	void HandleData(const String& data, XMLDataType type) override { log += CreateString("[%d:%s]", (int)type, data.c_str()); }
+
+	String log;
+};
+} // namespace
+
+TEST_CASE("XMLParser.replay")
+{
+	const String source = R"(<div id="a" class="b">hello
+<p>world</p>
+<ul data-for="it : list"><li>{{ it }}</li></ul>
+<![CDATA[<raw>]]></div>)";
+
+	StreamMemory stream((const byte*)source.data(), source.size());
+
+	XMLParseEventList events;
+	XMLParserEventLog parser;
+	parser.SetRecordEvents(&events);
+	parser.Parse(&stream);
+	parser.SetRecordEvents(nullptr);
+
+	CHECK(!events.empty());
+	CHECK(parser.log.find("<li>") == String::npos);
+
+	XMLParserEventLog replay_parser;
+	replay_parser.Replay(events, stream.GetSourceURL());
+	CHECK(replay_parser.log == parser.log);
+}